@@ -33,7 +33,7 @@ import android.util.Log;
 class InputThread extends Thread {
   private static final String TAG = "XCSoar";
 
-  static final int BUFFER_SIZE = 256;
+  static final int BUFFER_SIZE = 1024;
 
   final String name;
 
@@ -104,6 +104,20 @@ class InputThread extends Thread {
       if (n < 0)
         break;
 
+      /* collect the data which has already arrived, to pass it to
+         the listener in one call */
+      try {
+        while (n < buffer.length && is2.available() > 0) {
+          int n2 = is2.read(buffer, n, buffer.length - n);
+          if (n2 <= 0)
+            break;
+
+          n += n2;
+        }
+      } catch (IOException e) {
+        /* this will be reported by the next read() call */
+      }
+
       is2 = is;
       if (is2 == null)
         // close() was called
@@ -23,19 +23,42 @@ Copyright_License {
 
 package org.xcsoar;
 
+import java.nio.ByteBuffer;
+
 /**
  * An #InputListener implementation that passes method calls to native
  * code.
  */
 final class NativeInputListener implements InputListener {
+  static final int BUFFER_SIZE = 4096;
+
   /**
    * A native pointer.
    */
   private final long ptr;
 
+  /**
+   * A direct buffer which is shared with native code.  Received data
+   * is copied into it and then read by native code in place, which
+   * avoids the JNI array copy and the allocation of a new Java array
+   * for each call.
+   */
+  private final ByteBuffer buffer = ByteBuffer.allocateDirect(BUFFER_SIZE);
+
   NativeInputListener(long _ptr) {
     ptr = _ptr;
   }
 
-  @Override public native void dataReceived(byte[] data, int length);
+  @Override public synchronized void dataReceived(byte[] data, int length) {
+    int offset = 0;
+    while (offset < length) {
+      final int n = Math.min(length - offset, BUFFER_SIZE);
+      buffer.clear();
+      buffer.put(data, offset, n);
+      directDataReceived(buffer, n);
+      offset += n;
+    }
+  }
+
+  private native void directDataReceived(ByteBuffer buffer, int length);
 }
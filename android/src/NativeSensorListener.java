@@ -66,6 +66,11 @@ final class NativeSensorListener implements SensorListener {
   public native void onBarometricPressureSensor(float pressure,
                                                 float sensor_noise_variance);
 
+  @Override
+  public native void onBarometricPressureSensorBatch(long[] timestamps,
+                                                     float[] pressures, int n,
+                                                     float sensor_noise_variance);
+
   @Override
   public native void onPressureAltitudeSensor(float altitude);
 
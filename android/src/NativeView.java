@@ -385,6 +385,8 @@ class NativeView extends SurfaceView
   protected native void pauseNative();
   protected native void resumeNative();
 
+  protected native void trimMemoryNative(int level);
+
   protected native void setBatteryPercent(int level, int plugged);
 
   protected native void setHapticFeedback(boolean on);
@@ -546,6 +548,10 @@ class NativeView extends SurfaceView
     pauseNative();
   }
 
+  public void onTrimMemory(int level) {
+    trimMemoryNative(level);
+  }
+
   private final int translateKeyCode(int keyCode) {
     if (!hasKeyboard) {
       /* map the volume keys to cursor up/down if the device has no
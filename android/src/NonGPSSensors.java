@@ -33,6 +33,7 @@ import java.io.Closeable;
 
 import android.content.Context;
 import android.os.Handler;
+import android.os.SystemClock;
 import android.hardware.Sensor;
 import android.hardware.SensorEvent;
 import android.hardware.SensorEventListener;
@@ -86,6 +87,23 @@ public class NonGPSSensors
   // A fallback pressure sensor noise variance constant for unfamiliar sensors.
   private static final float KF_PRESSURE_SENSOR_NOISE_VARIANCE_FALLBACK = 0.05f;
 
+  // Allow the sensor hardware to buffer events for up to this long
+  // [us] before waking up the application processor.
+  private static final int MAX_REPORT_LATENCY_US = 500000;
+
+  // Sensor events younger than this [ns] are considered the newest
+  // of a buffered batch.
+  private static final long RECENT_EVENT_NS = 250000000L;
+
+  // Events which appear to be older than this [ns] use a time base
+  // other than SystemClock.elapsedRealtimeNanos(); their age cannot be
+  // determined.
+  private static final long UNKNOWN_TIME_BASE_NS = 10000000000L;
+
+  // The maximum number of pressure samples passed to native code at
+  // once.  Must not be larger than MAX_BATCH in NativeSensorListener.cpp.
+  private static final int MAX_PRESSURE_BATCH = 64;
+
   // Non-inclusive upper bound on the largest sensor numerical type ID. As of
   // API 14, the largest sensor numerical type ID appears to be 13. Used only
   // for proportioning the following two arrays and for index checking.
@@ -118,6 +136,11 @@ public class NonGPSSensors
 
   private final SafeDestruct safeDestruct = new SafeDestruct();
 
+  // Pressure samples which have not yet been passed to the listener.
+  private final long[] pressure_timestamps_ = new long[MAX_PRESSURE_BATCH];
+  private final float[] pressure_values_ = new float[MAX_PRESSURE_BATCH];
+  private int n_pressure_ = 0;
+
   NonGPSSensors(Context context, SensorListener listener) {
     handler_ = new Handler(context.getMainLooper());
     this.listener = listener;
@@ -236,12 +259,14 @@ public class NonGPSSensors
     // again) to all desired sensors.
     Log.d(TAG, "Updating non-GPS sensor subscriptions...");
     sensor_manager_.unregisterListener(this);
+    n_pressure_ = 0;
 
     for (int id : SUPPORTED_SENSORS) {
       if (enabled_sensors_[id] && default_sensors_[id] != null) {
         Log.d(TAG, "Subscribing to sensor ID " + id + " (" + default_sensors_[id].getName() + ")");
         sensor_manager_.registerListener(this, default_sensors_[id],
-                                         sensor_manager_.SENSOR_DELAY_NORMAL);
+                                         sensor_manager_.SENSOR_DELAY_NORMAL,
+                                         MAX_REPORT_LATENCY_US);
       }
     }
     Log.d(TAG, "Done updating non-GPS sensor subscriptions...");
@@ -251,13 +276,46 @@ public class NonGPSSensors
   public void onAccuracyChanged(Sensor sensor, int accuracy) {
   }
 
+  /**
+   * Is this the newest event of a batch buffered by the sensor
+   * hardware?
+   */
+  private static boolean isRecent(SensorEvent event) {
+    final long age = SystemClock.elapsedRealtimeNanos() - event.timestamp;
+    return age < RECENT_EVENT_NS || age > UNKNOWN_TIME_BASE_NS;
+  }
+
+  /**
+   * Buffer a pressure sample, and pass all buffered samples to the
+   * listener at the end of a batch.
+   */
+  private void addPressureSample(SensorEvent event) {
+    pressure_timestamps_[n_pressure_] = event.timestamp;
+    pressure_values_[n_pressure_] = event.values[0];
+    ++n_pressure_;
+
+    if (n_pressure_ < MAX_PRESSURE_BATCH && !isRecent(event))
+      return;
+
+    listener.onBarometricPressureSensorBatch(pressure_timestamps_,
+                                             pressure_values_, n_pressure_,
+                                             kf_sensor_noise_variance_);
+    n_pressure_ = 0;
+  }
+
   /** from SensorEventListener; report new sensor values to XCSoar. */
   public void onSensorChanged(SensorEvent event) {
     if (!safeDestruct.increment())
       return;
 
     try {
-      switch (event.sensor.getType()) {
+      final int type = event.sensor.getType();
+      if (type != Sensor.TYPE_PRESSURE && !isRecent(event))
+        /* these are current values only; skip the older events of a
+           buffered batch */
+        return;
+
+      switch (type) {
       case Sensor.TYPE_ACCELEROMETER:
         double acceleration;
         acceleration = Math.sqrt((double) event.values[0]*event.values[0] +
@@ -294,8 +352,7 @@ public class NonGPSSensors
                                        event.values[2]);
         break;
       case Sensor.TYPE_PRESSURE:
-        listener.onBarometricPressureSensor(event.values[0],
-                                            kf_sensor_noise_variance_);
+        addPressureSample(event);
         break;
       }
     } finally {
@@ -45,6 +45,16 @@ public interface SensorListener {
   void onRotationSensor(float dtheta_x, float dtheta_y, float dtheta_z);
   void onMagneticFieldSensor(float h_x, float h_y, float h_z);
   void onBarometricPressureSensor(float pressure, float sensor_noise_variance);
+
+  /**
+   * A batch of pressure samples buffered by the sensor.
+   *
+   * @param timestamps the time of each sample [ns]
+   * @param n the number of valid array elements
+   */
+  void onBarometricPressureSensorBatch(long[] timestamps, float[] pressures,
+                                       int n, float sensor_noise_variance);
+
   void onPressureAltitudeSensor(float altitude);
   void onI2CbaroSensor(int index, int sensorType, int pressure);
   void onVarioSensor(float vario);
@@ -230,6 +230,12 @@ public class XCSoar extends Activity {
     super.onPause();
   }
 
+  @Override public void onTrimMemory(int level) {
+    if (nativeView != null)
+      nativeView.onTrimMemory(level);
+    super.onTrimMemory(level);
+  }
+
   private void getHapticFeedbackSettings() {
     boolean hapticFeedbackEnabled;
     try {
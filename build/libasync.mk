@@ -13,7 +13,7 @@ ASYNC_SOURCES = \
 	$(SRC)/event/SocketEvent.cxx \
 	$(SRC)/event/SignalMonitor.cxx \
 	$(SRC)/event/TimerWheel.cxx \
-	$(SRC)/event/TimerList.cxx \
+	$(SRC)/event/FineTimerWheel.cxx \
 	$(SRC)/event/CoarseTimerEvent.cxx \
 	$(SRC)/event/FineTimerEvent.cxx \
 	$(SRC)/event/net/ConnectSocket.cxx \
@@ -22,7 +22,8 @@ ASYNC_SOURCES = \
 	$(SRC)/event/net/cares/Channel.cxx \
 	$(SRC)/event/net/cares/SimpleResolver.cxx \
 	$(SRC)/io/async/AsioThread.cpp \
-	$(SRC)/io/async/GlobalAsioThread.cpp
+	$(SRC)/io/async/GlobalAsioThread.cpp \
+	$(SRC)/io/async/CoReadFile.cpp
 
 ifeq ($(HAVE_WIN32),y)
 ASYNC_SOURCES += \
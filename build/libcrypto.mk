@@ -1,3 +1,12 @@
 # Build rules for the crypto library
 
 $(eval $(call pkg-config-library,LIBSODIUM,libsodium))
+
+CRYPTO_SOURCES = \
+	$(SRC)/Crypto/SHA256.cxx
+
+CRYPTO_DEPENDS = LIBSODIUM
+
+$(eval $(call link-library,crypto,CRYPTO))
+
+CRYPTO_LDLIBS += $(LIBSODIUM_LDLIBS)
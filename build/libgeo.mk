@@ -21,6 +21,7 @@ GEO_SOURCES := \
 	$(GEO_SRC_DIR)/Flat/FlatLine.cpp \
 	$(GEO_SRC_DIR)/Math.cpp \
 	$(GEO_SRC_DIR)/SimplifiedMath.cpp \
+	$(GEO_SRC_DIR)/FastDistance.cpp \
 	$(GEO_SRC_DIR)/Quadrilateral.cpp \
 	$(GEO_SRC_DIR)/GeoPoint.cpp \
 	$(GEO_SRC_DIR)/GeoVector.cpp \
@@ -29,6 +30,7 @@ GEO_SOURCES := \
 	$(GEO_SRC_DIR)/Quadrilateral.cpp \
 	$(GEO_SRC_DIR)/SearchPoint.cpp \
 	$(GEO_SRC_DIR)/SearchPointVector.cpp \
+	$(GEO_SRC_DIR)/PolygonIntersections.cpp \
 	$(GEO_SRC_DIR)/GeoEllipse.cpp \
 	$(GEO_SRC_DIR)/UTM.cpp
 
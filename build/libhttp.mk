@@ -14,6 +14,8 @@ LIBHTTP_SOURCES = \
 	$(SRC)/net/http/CoRequest.cxx \
 	$(SRC)/net/http/CoStreamRequest.cxx \
 	$(SRC)/net/http/CoDownloadToFile.cpp \
+	$(SRC)/net/http/ChunkManifest.cpp \
+	$(SRC)/net/http/CoDownloadDelta.cpp \
 	$(SRC)/net/http/Global.cxx \
 	$(SRC)/net/http/Init.cpp
 
@@ -35,6 +37,7 @@ LIBHTTP_LDADD = $(ZLIB_LDADD)
 LIBHTTP_LDLIBS = $(CURL_LDLIBS) $(ZLIB_LDLIBS)
 endif
 
-LIBHTTP_LDLIBS += $(LIBSODIUM_LDLIBS)
-
 $(eval $(call link-library,libhttp,LIBHTTP))
+
+LIBHTTP_LDADD += $(CRYPTO_LDADD)
+LIBHTTP_LDLIBS += $(CRYPTO_LDLIBS)
@@ -4,6 +4,7 @@ OPERATION_SOURCES := \
 	$(SRC)/Operation/ProxyOperationEnvironment.cpp \
 	$(SRC)/Operation/NoCancelOperationEnvironment.cpp \
 	$(SRC)/Operation/SubOperationEnvironment.cpp \
+	$(SRC)/Operation/JobOperationEnvironment.cpp \
 	$(SRC)/Operation/ThreadedOperationEnvironment.cpp
 
 # This is necessary because ThreadedOperationEnvironment depends on
@@ -11,7 +11,8 @@ OS_SOURCES := \
 	$(OS_SRC_DIR)/Path.cpp \
 	$(OS_SRC_DIR)/PathName.cpp \
 	$(OS_SRC_DIR)/Process.cpp \
-	$(OS_SRC_DIR)/SystemLoad.cpp
+	$(OS_SRC_DIR)/SystemLoad.cpp \
+	$(OS_SRC_DIR)/SystemMemory.cpp
 
 ifeq ($(TARGET_IS_LINUX),y)
 OS_SOURCES += \
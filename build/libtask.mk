@@ -45,6 +45,7 @@ TASK_SOURCES = \
 	$(TASK_SRC_DIR)/Points/TaskLeg.cpp \
 	$(TASK_SRC_DIR)/ObservationZones/Boundary.cpp \
 	$(TASK_SRC_DIR)/ObservationZones/ObservationZoneClient.cpp \
+	$(TASK_SRC_DIR)/ObservationZones/CompiledZone.cpp \
 	$(TASK_SRC_DIR)/ObservationZones/ObservationZonePoint.cpp \
 	$(TASK_SRC_DIR)/ObservationZones/CylinderZone.cpp \
 	$(TASK_SRC_DIR)/ObservationZones/SectorZone.cpp \
@@ -56,6 +57,7 @@ TASK_SOURCES = \
 	$(TASK_SRC_DIR)/PathSolvers/TaskDijkstraMin.cpp \
 	$(TASK_SRC_DIR)/PathSolvers/TaskDijkstraMax.cpp \
 	$(TASK_SRC_DIR)/PathSolvers/IsolineCrossingFinder.cpp \
+	$(TASK_SRC_DIR)/Solvers/LegSolutionCache.cpp \
 	$(TASK_SRC_DIR)/Solvers/TaskMacCready.cpp \
 	$(TASK_SRC_DIR)/Solvers/TaskMacCreadyTravelled.cpp \
 	$(TASK_SRC_DIR)/Solvers/TaskMacCreadyRemaining.cpp \
@@ -80,6 +80,10 @@ DIALOG_SOURCES = \
 	$(SRC)/Dialogs/StatusPanels/TaskStatusPanel.cpp \
 	$(SRC)/Dialogs/StatusPanels/RulesStatusPanel.cpp \
 	$(SRC)/Dialogs/StatusPanels/TimesStatusPanel.cpp \
+	$(SRC)/Dialogs/StatusPanels/RenderStatusPanel.cpp \
+	$(SRC)/Dialogs/StatusPanels/ThreadStatusPanel.cpp \
+	$(SRC)/Dialogs/StatusPanels/ComputerStatusPanel.cpp \
+	$(SRC)/Dialogs/StatusPanels/MemoryStatusPanel.cpp \
 	\
 	$(SRC)/Dialogs/Waypoint/WaypointInfoWidget.cpp \
 	$(SRC)/Dialogs/Waypoint/WaypointCommandsWidget.cpp \
@@ -214,6 +218,7 @@ XCSOAR_SOURCES := \
 	$(SRC)/Renderer/ClimbPercentRenderer.cpp \
 	\
 	$(SRC)/Airspace/AirspaceGlue.cpp \
+	$(SRC)/Airspace/AirspaceCache.cpp \
 	$(SRC)/Airspace/AirspaceParser.cpp \
 	$(SRC)/Airspace/AirspaceVisibility.cpp \
 	$(SRC)/Airspace/AirspaceComputerSettings.cpp \
@@ -240,6 +245,7 @@ XCSOAR_SOURCES := \
 	$(SRC)/FLARM/FlarmCalculations.cpp \
 	$(SRC)/FLARM/Friends.cpp \
 	$(SRC)/FLARM/FlarmComputer.cpp \
+	$(SRC)/Computer/TrafficFusion.cpp \
 	$(SRC)/FLARM/Global.cpp \
 	$(SRC)/FLARM/Glue.cpp \
 	$(SRC)/BallastDumpManager.cpp \
@@ -249,6 +255,7 @@ XCSOAR_SOURCES := \
 	$(SRC)/Logger/GRecord.cpp \
 	$(SRC)/Logger/LoggerEPE.cpp \
 	$(SRC)/Logger/LoggerImpl.cpp \
+	$(SRC)/Logger/LoggerOutputThread.cpp \
 	$(SRC)/IGC/IGCFix.cpp \
 	$(SRC)/IGC/IGCWriter.cpp \
 	$(SRC)/IGC/IGCString.cpp \
@@ -261,6 +268,7 @@ XCSOAR_SOURCES := \
 	$(SRC)/Replay/Replay.cpp \
 	$(SRC)/IGC/IGCParser.cpp \
 	$(SRC)/Replay/IgcReplay.cpp \
+	$(SRC)/Replay/IgcReplayIndex.cpp \
 	$(SRC)/Replay/NmeaReplay.cpp \
 	$(SRC)/Replay/DemoReplay.cpp \
 	$(SRC)/Replay/DemoReplayGlue.cpp \
@@ -273,6 +281,7 @@ XCSOAR_SOURCES := \
 	$(SRC)/Waypoint/WaypointListBuilder.cpp \
 	$(SRC)/Waypoint/WaypointFilter.cpp \
 	$(SRC)/Waypoint/WaypointGlue.cpp \
+	$(SRC)/Waypoint/WaypointCache.cpp \
 	$(SRC)/Waypoint/SaveGlue.cpp \
 	$(SRC)/Waypoint/LastUsed.cpp \
 	$(SRC)/Waypoint/HomeGlue.cpp \
@@ -290,6 +299,7 @@ XCSOAR_SOURCES := \
 	\
 	$(SRC)/CrossSection/AirspaceXSRenderer.cpp \
 	$(SRC)/CrossSection/TerrainXSRenderer.cpp \
+	$(SRC)/CrossSection/CrossSectionCache.cpp \
 	$(SRC)/CrossSection/CrossSectionRenderer.cpp \
 	$(SRC)/CrossSection/CrossSectionWindow.cpp \
 	$(SRC)/CrossSection/CrossSectionWidget.cpp \
@@ -342,6 +352,7 @@ XCSOAR_SOURCES := \
 	$(SRC)/PopupMessage.cpp \
 	$(SRC)/Message.cpp \
 	$(SRC)/LogFile.cpp \
+	$(SRC)/TraceFile.cpp \
 	\
 	$(SRC)/Geo/Geoid.cpp \
 	$(SRC)/Projection/Projection.cpp \
@@ -356,6 +367,7 @@ XCSOAR_SOURCES := \
 	$(SRC)/Renderer/AircraftRenderer.cpp \
 	$(SRC)/Renderer/AirspaceRenderer.cpp \
 	$(SRC)/Renderer/AirspaceRendererGL.cpp \
+	$(SRC)/Renderer/AirspaceVertexCache.cpp \
 	$(SRC)/Renderer/AirspaceRendererOther.cpp \
 	$(SRC)/Renderer/AirspaceLabelList.cpp \
 	$(SRC)/Renderer/AirspaceLabelRenderer.cpp \
@@ -382,6 +394,7 @@ XCSOAR_SOURCES := \
 	$(SRC)/Projection/ChartProjection.cpp \
 	$(SRC)/UIUtil/GestureManager.cpp \
 	$(SRC)/UIUtil/TrackingGestureManager.cpp \
+	$(SRC)/UIUtil/MotionPredictor.cpp \
 	$(SRC)/DrawThread.cpp \
 	\
 	$(SRC)/Weather/Rasp/RaspStore.cpp \
@@ -395,6 +408,7 @@ XCSOAR_SOURCES := \
 	$(SRC)/Blackboard/RateLimitedBlackboardListener.cpp \
 	$(SRC)/Blackboard/LiveBlackboard.cpp \
 	$(SRC)/Blackboard/InterfaceBlackboard.cpp \
+	$(SRC)/Blackboard/DerivedSerials.cpp \
 	$(SRC)/Blackboard/ScopeGPSListener.cpp \
 	$(SRC)/Blackboard/ScopeCalculatedListener.cpp \
 	\
@@ -537,6 +551,7 @@ XCSOAR_SOURCES := \
 	\
 	$(SRC)/Protection.cpp \
 	$(SRC)/BatteryTimer.cpp \
+	$(SRC)/PowerPolicy.cpp \
 	$(SRC)/ProcessTimer.cpp \
 	$(SRC)/ApplyExternalSettings.cpp \
 	$(SRC)/ApplyVegaSwitches.cpp \
@@ -555,6 +570,7 @@ XCSOAR_SOURCES := \
 	$(SRC)/Device/Parser.cpp \
 	$(SRC)/Device/Simulator.cpp \
 	$(SRC)/Device/Util/LineSplitter.cpp \
+	$(SRC)/Device/Util/PortOutputThread.cpp \
 	$(SRC)/Device/Util/NMEAWriter.cpp \
 	$(SRC)/Device/Util/NMEAReader.cpp \
 	$(SRC)/Device/Config.cpp \
@@ -571,12 +587,18 @@ XCSOAR_SOURCES := \
 	$(SRC)/Hardware/Battery.cpp
 
 $(call SRC_TO_OBJ,$(SRC)/Dialogs/Inflate.cpp): CPPFLAGS += $(ZLIB_CPPFLAGS)
+$(call SRC_TO_OBJ,$(SRC)/Logger/NMEALogger.cpp): CPPFLAGS += $(ZLIB_CPPFLAGS)
 
 ifeq ($(OPENGL),y)
 XCSOAR_SOURCES += \
 	$(SRC)/Dialogs/Weather/MapOverlayWidget.cpp
 endif
 
+ifeq ($(MEMORY_ACCOUNTING),y)
+XCSOAR_SOURCES += \
+	$(SRC)/system/AllocationHook.cpp
+endif
+
 ifeq ($(TARGET_IS_DARWIN),y)
 XCSOAR_SOURCES += \
 	$(SRC)/Device/AndroidSensors.cpp \
@@ -27,9 +27,22 @@ ifeq ($(STOP_WATCH),y)
   TARGET_CPPFLAGS += -DSTOP_WATCH
 endif
 
+# count the memory owned by subsystems, and the allocations of the
+# calculation thread?
+MEMORY_ACCOUNTING ?= n
+ifeq ($(MEMORY_ACCOUNTING),y)
+  TARGET_CPPFLAGS += -DMEMORY_ACCOUNTING
+endif
+
 # compile without UI?
 HEADLESS ?= n
 
+# thin the trace with a binary heap instead of a balanced tree?
+TRACE_HEAP ?= y
+ifeq ($(TRACE_HEAP),y)
+  TARGET_CPPFLAGS += -DTRACE_HEAP
+endif
+
 ifeq ($(TARGET_IS_KOBO),y)
   DITHER ?= y
 else
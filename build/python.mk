@@ -50,9 +50,9 @@ PYTHON_SOURCES = \
 	$(ENGINE_SRC_DIR)/Airspace/AirspaceSorter.cpp \
 	$(ENGINE_SRC_DIR)/Airspace/AirspaceAircraftPerformance.cpp \
 	$(SRC)/NMEA/Aircraft.cpp
-PYTHON_LDADD = $(DEBUG_REPLAY_LDADD)
+PYTHON_LDADD = $(CONTEST_LDADD) $(DEBUG_REPLAY_LDADD)
 PYTHON_LDLIBS = $(shell python3-config --ldflags)
-PYTHON_DEPENDS = CONTEST WAYPOINT UTIL ZZIP GEO MATH TIME
+PYTHON_DEPENDS = CONTEST THREAD WAYPOINT UTIL ZZIP GEO MATH TIME
 PYTHON_CPPFLAGS = $(shell python3-config --includes) \
 	-I$(TEST_SRC_DIR) -Wno-write-strings
 PYTHON_NO_LIB_PREFIX = y
@@ -110,6 +110,7 @@ SCREEN_SOURCES += \
 	$(CANVAS_SRC_DIR)/opengl/TopCanvas.cpp \
 	$(CANVAS_SRC_DIR)/opengl/SubCanvas.cpp \
 	$(CANVAS_SRC_DIR)/opengl/Texture.cpp \
+	$(CANVAS_SRC_DIR)/opengl/TextureAtlas.cpp \
 	$(CANVAS_SRC_DIR)/opengl/UncompressedImage.cpp \
 	$(CANVAS_SRC_DIR)/opengl/Buffer.cpp \
 	$(CANVAS_SRC_DIR)/opengl/Shapes.cpp \
@@ -125,6 +126,7 @@ SCREEN_SOURCES += \
 	$(CANVAS_SRC_DIR)/custom/Files.cpp \
 	$(CANVAS_SRC_DIR)/custom/Bitmap.cpp \
 	$(CANVAS_SRC_DIR)/custom/ResourceBitmap.cpp \
+	$(CANVAS_SRC_DIR)/custom/ResourceImageCache.cpp \
 	$(CANVAS_SRC_DIR)/sdl/TopCanvas.cpp \
 	$(WINDOW_SRC_DIR)/sdl/Window.cpp \
 	$(WINDOW_SRC_DIR)/sdl/TopWindow.cpp \
@@ -140,6 +142,7 @@ SCREEN_SOURCES += \
 	$(CANVAS_SRC_DIR)/custom/Files.cpp \
 	$(CANVAS_SRC_DIR)/custom/Bitmap.cpp \
 	$(CANVAS_SRC_DIR)/custom/ResourceBitmap.cpp \
+	$(CANVAS_SRC_DIR)/custom/ResourceImageCache.cpp \
 	$(CANVAS_SRC_DIR)/tty/TopCanvas.cpp \
 	$(WINDOW_SRC_DIR)/egl/Init.cpp \
 	$(CANVAS_SRC_DIR)/egl/TopCanvas.cpp \
@@ -153,6 +156,7 @@ SCREEN_SOURCES += \
 	$(CANVAS_SRC_DIR)/custom/Files.cpp \
 	$(CANVAS_SRC_DIR)/custom/Bitmap.cpp \
 	$(CANVAS_SRC_DIR)/custom/ResourceBitmap.cpp \
+	$(CANVAS_SRC_DIR)/custom/ResourceImageCache.cpp \
 	$(WINDOW_SRC_DIR)/glx/Init.cpp \
 	$(CANVAS_SRC_DIR)/glx/TopCanvas.cpp \
 	$(WINDOW_SRC_DIR)/fb/Window.cpp \
@@ -165,6 +169,7 @@ SCREEN_SOURCES += \
 	$(CANVAS_SRC_DIR)/custom/Files.cpp \
 	$(CANVAS_SRC_DIR)/custom/Bitmap.cpp \
 	$(CANVAS_SRC_DIR)/custom/ResourceBitmap.cpp \
+	$(CANVAS_SRC_DIR)/custom/ResourceImageCache.cpp \
 	$(CANVAS_SRC_DIR)/fb/TopCanvas.cpp \
 	$(WINDOW_SRC_DIR)/fb/Window.cpp \
 	$(WINDOW_SRC_DIR)/fb/TopWindow.cpp \
@@ -178,6 +183,7 @@ SCREEN_SOURCES += \
 	$(CANVAS_SRC_DIR)/custom/Files.cpp \
 	$(CANVAS_SRC_DIR)/custom/Bitmap.cpp \
 	$(CANVAS_SRC_DIR)/custom/ResourceBitmap.cpp \
+	$(CANVAS_SRC_DIR)/custom/ResourceImageCache.cpp \
 	$(CANVAS_SRC_DIR)/memory/Export.cpp \
 	$(CANVAS_SRC_DIR)/tty/TopCanvas.cpp \
 	$(WINDOW_SRC_DIR)/fb/TopWindow.cpp \
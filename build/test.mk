@@ -93,6 +93,8 @@ TEST_NAMES = \
 	test_pressure \
 	test_task \
 	TestOverwritingRingBuffer \
+	TestLockFreeRingBuffer \
+	TestRadixHeap \
 	TestDateTime TestRoughTime TestWrapClock \
 	TestMath \
 	TestMathTables \
@@ -101,22 +103,33 @@ TEST_NAMES = \
 	TestUnits TestEarth TestSunEphemeris \
 	TestValidity TestUTM \
 	TestAllocatedGrid \
-	TestRadixTree TestGeoBounds TestGeoClip \
+	TestRadixTree TestGeoBounds TestGeoClip TestWindEKF \
 	TestLogger TestGRecord TestClimbAvCalc \
-	TestWaypointReader TestThermalBase \
+	TestWaypointReader TestThermalBase TestThermalLocator \
 	TestFlarmNet \
-	TestColorRamp TestGeoPoint TestDiffFilter \
+	TestCoReadFile \
+	TestTrafficList \
+	TestTrafficFusion \
+	TestPortOutputThread \
+	TestSendQueue \
+	TestTraceEvents \
+	TestFlightIndex \
+	TestColorRamp TestSlopeShading TestContourLines TestGeoPoint TestDiffFilter \
+	TestSampledWindowFilter \
+	TestKalmanFilter1d \
 	TestFileUtil TestPolars TestCSVLine TestGlidePolar \
 	test_replay_task TestProjection TestFlatPoint TestFlatLine TestFlatGeoPoint \
 	TestMacCready TestOrderedTask TestAATPoint \
 	TestPlanes \
 	TestTaskPoint \
+	TestCompiledZone \
 	TestTaskWaypoint \
 	TestTeamCode \
 	TestZeroFinder \
 	TestAirspaceParser \
 	TestMETARParser \
 	TestIGCParser \
+	TestCatmullRomInterpolator \
 	TestStrings TestUTF8 \
 	TestCRC \
 	TestUnitsFormatter \
@@ -128,6 +141,7 @@ TEST_NAMES = \
 	TestLXNToIGC \
 	TestLeastSquares \
 	TestHexString \
+	TestJSONWriter \
 	TestThermalBand
 
 ifeq ($(TARGET_IS_ANDROID),n)
@@ -144,6 +158,12 @@ TEST_HEX_STRING_SOURCES = \
 	$(TEST_SRC_DIR)/TestHexString.cpp
 $(eval $(call link-program,TestHexString,TEST_HEX_STRING))
 
+TEST_JSON_WRITER_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestJSONWriter.cpp
+TEST_JSON_WRITER_DEPENDS = JSON IO UTIL
+$(eval $(call link-program,TestJSONWriter,TEST_JSON_WRITER))
+
 TEST_CRC_SOURCES = \
 	$(SRC)/util/CRC.cpp \
 	$(TEST_SRC_DIR)/tap.c \
@@ -152,6 +172,7 @@ $(eval $(call link-program,TestCRC,TEST_CRC))
 
 TEST_LEASTSQUARES_SOURCES = \
 	$(SRC)/Math/LeastSquares.cpp \
+	$(SRC)/Math/ConvexFilter.cpp \
 	$(SRC)/Math/XYDataStore.cpp \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestLeastSquares.cpp
@@ -172,13 +193,31 @@ TEST_OVERWRITING_RING_BUFFER_SOURCES = \
 TEST_OVERWRITING_RING_BUFFER_DEPENDS = MATH
 $(eval $(call link-program,TestOverwritingRingBuffer,TEST_OVERWRITING_RING_BUFFER))
 
+TEST_LOCK_FREE_RING_BUFFER_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestLockFreeRingBuffer.cpp
+$(eval $(call link-program,TestLockFreeRingBuffer,TEST_LOCK_FREE_RING_BUFFER))
+
+TEST_RADIX_HEAP_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestRadixHeap.cpp
+TEST_RADIX_HEAP_DEPENDS = MATH
+$(eval $(call link-program,TestRadixHeap,TEST_RADIX_HEAP))
+
 TEST_IGC_PARSER_SOURCES = \
 	$(SRC)/IGC/IGCParser.cpp \
+	$(SRC)/IGC/IGCFileParser.cpp \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestIGCParser.cpp
-TEST_IGC_PARSER_DEPENDS = MATH UTIL
+TEST_IGC_PARSER_DEPENDS = OS IO MATH UTIL
 $(eval $(call link-program,TestIGCParser,TEST_IGC_PARSER))
 
+TEST_CATMULL_ROM_INTERPOLATOR_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestCatmullRomInterpolator.cpp
+TEST_CATMULL_ROM_INTERPOLATOR_DEPENDS = GEO MATH UTIL
+$(eval $(call link-program,TestCatmullRomInterpolator,TEST_CATMULL_ROM_INTERPOLATOR))
+
 TEST_METAR_PARSER_SOURCES = \
 	$(SRC)/Weather/METARParser.cpp \
 	$(SRC)/Units/Descriptor.cpp \
@@ -227,7 +266,7 @@ TEST_PROFILE_SOURCES = \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/FakeLogFile.cpp \
 	$(TEST_SRC_DIR)/TestProfile.cpp
-TEST_PROFILE_DEPENDS = PROFILE MATH IO OS UTIL
+TEST_PROFILE_DEPENDS = PROFILE MATH IO OS THREAD UTIL
 $(eval $(call link-program,TestProfile,TEST_PROFILE))
 
 TEST_MAC_CREADY_SOURCES = \
@@ -244,7 +283,7 @@ TEST_ORDERED_TASK_SOURCES = \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestOrderedTask.cpp
 TEST_ORDERED_TASK_OBJS = $(call SRC_TO_OBJ,$(TEST_ORDERED_TASK_SOURCES))
-TEST_ORDERED_TASK_DEPENDS = TASK ROUTE GLIDE WAYPOINT GEO TIME MATH UTIL
+TEST_ORDERED_TASK_DEPENDS = TASK ROUTE THREAD GLIDE WAYPOINT GEO TIME MATH UTIL
 $(eval $(call link-program,TestOrderedTask,TEST_ORDERED_TASK))
 
 TEST_AAT_POINT_SOURCES = \
@@ -253,7 +292,7 @@ TEST_AAT_POINT_SOURCES = \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestAATPoint.cpp
 TEST_AAT_POINT_OBJS = $(call SRC_TO_OBJ,$(TEST_AAT_POINT_SOURCES))
-TEST_AAT_POINT_DEPENDS = TASK ROUTE GLIDE WAYPOINT GEO TIME MATH UTIL
+TEST_AAT_POINT_DEPENDS = TASK ROUTE THREAD GLIDE WAYPOINT GEO TIME MATH UTIL
 $(eval $(call link-program,TestAATPoint,TEST_AAT_POINT))
 
 TEST_PLANES_SOURCES = \
@@ -279,6 +318,12 @@ TEST_TASKPOINT_SOURCES = \
 TEST_TASKPOINT_DEPENDS = IO OS TASK GEO MATH
 $(eval $(call link-program,TestTaskPoint,TEST_TASKPOINT))
 
+TEST_COMPILED_ZONE_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestCompiledZone.cpp
+TEST_COMPILED_ZONE_DEPENDS = IO OS TASK GEO MATH
+$(eval $(call link-program,TestCompiledZone,TEST_COMPILED_ZONE))
+
 TEST_TASKWAYPOINT_SOURCES = \
 	$(ENGINE_SRC_DIR)/Waypoint/Waypoint.cpp \
 	$(TEST_SRC_DIR)/tap.c \
@@ -298,7 +343,7 @@ TEST_TROUTE_SOURCES = \
 	$(TEST_SRC_DIR)/Printing.cpp \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/test_troute.cpp
-TEST_TROUTE_DEPENDS = TERRAIN OPERATION IO ZZIP OS ROUTE GLIDE GEO MATH UTIL
+TEST_TROUTE_DEPENDS = TERRAIN OPERATION OS IO ZZIP ROUTE THREAD GLIDE GEO MATH UTIL
 $(eval $(call link-program,test_troute,TEST_TROUTE))
 
 TEST_REACH_SOURCES = \
@@ -306,7 +351,7 @@ TEST_REACH_SOURCES = \
 	$(TEST_SRC_DIR)/Printing.cpp \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/test_reach.cpp
-TEST_REACH_DEPENDS = TERRAIN OPERATION IO ZZIP OS ROUTE GLIDE GEO MATH UTIL
+TEST_REACH_DEPENDS = TERRAIN OPERATION OS IO ZZIP ROUTE THREAD GLIDE GEO MATH UTIL
 $(eval $(call link-program,test_reach,TEST_REACH))
 
 TEST_ROUTE_SOURCES = \
@@ -321,7 +366,7 @@ TEST_ROUTE_SOURCES = \
 	$(TEST_SRC_DIR)/harness_airspace.cpp \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/test_route.cpp
-TEST_ROUTE_DEPENDS = TERRAIN OPERATION IO ZZIP OS ROUTE AIRSPACE GLIDE GEO MATH UTIL
+TEST_ROUTE_DEPENDS = TERRAIN OPERATION OS IO ZZIP ROUTE AIRSPACE THREAD GLIDE GEO MATH UTIL
 $(eval $(call link-program,test_route,TEST_ROUTE))
 
 TEST_REPLAY_TASK_SOURCES = \
@@ -350,7 +395,7 @@ TEST_REPLAY_TASK_SOURCES = \
 	$(TEST_SRC_DIR)/harness_task.cpp \
 	$(TEST_SRC_DIR)/test_debug.cpp \
 	$(TEST_SRC_DIR)/test_replay_task.cpp
-TEST_REPLAY_TASK_DEPENDS = TASK ROUTE WAYPOINT GLIDE LIBNMEA GEO MATH IO OS UTIL TIME
+TEST_REPLAY_TASK_DEPENDS = TASK ROUTE THREAD WAYPOINT GLIDE LIBNMEA GEO MATH IO OS UTIL TIME
 $(eval $(call link-program,test_replay_task,TEST_REPLAY_TASK))
 
 TEST_MATH_TABLES_SOURCES = \
@@ -408,12 +453,63 @@ TEST_FLARM_NET_SOURCES = \
 TEST_FLARM_NET_DEPENDS = IO OS MATH UTIL
 $(eval $(call link-program,TestFlarmNet,TEST_FLARM_NET))
 
+TEST_CO_READ_FILE_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestCoReadFile.cpp
+TEST_CO_READ_FILE_DEPENDS = ASYNC CO IO OS THREAD UTIL
+$(eval $(call link-program,TestCoReadFile,TEST_CO_READ_FILE))
+
+TEST_TRAFFIC_LIST_SOURCES = \
+	$(SRC)/FLARM/List.cpp \
+	$(SRC)/FLARM/FlarmId.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestTrafficList.cpp
+TEST_TRAFFIC_LIST_DEPENDS = MATH UTIL
+$(eval $(call link-program,TestTrafficList,TEST_TRAFFIC_LIST))
+
+TEST_TRAFFIC_FUSION_SOURCES = \
+	$(SRC)/Computer/TrafficFusion.cpp \
+	$(SRC)/FLARM/List.cpp \
+	$(SRC)/FLARM/FlarmId.cpp \
+	$(SRC)/Atmosphere/AirDensity.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestTrafficFusion.cpp
+TEST_TRAFFIC_FUSION_DEPENDS = LIBNMEA GEO MATH UTIL TIME
+$(eval $(call link-program,TestTrafficFusion,TEST_TRAFFIC_FUSION))
+
+TEST_PORT_OUTPUT_THREAD_SOURCES = \
+	$(SRC)/Device/Util/PortOutputThread.cpp \
+	$(SRC)/Device/Port/Port.cpp \
+	$(SRC)/Device/Port/NullPort.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestPortOutputThread.cpp
+TEST_PORT_OUTPUT_THREAD_DEPENDS = OPERATION THREAD OS IO TIME UTIL
+$(eval $(call link-program,TestPortOutputThread,TEST_PORT_OUTPUT_THREAD))
+
+TEST_SEND_QUEUE_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestSendQueue.cpp
+$(eval $(call link-program,TestSendQueue,TEST_SEND_QUEUE))
+
+TEST_TRACE_EVENTS_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestTraceEvents.cpp
+TEST_TRACE_EVENTS_DEPENDS = THREAD
+$(eval $(call link-program,TestTraceEvents,TEST_TRACE_EVENTS))
+
 TEST_GEO_CLIP_SOURCES = \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestGeoClip.cpp
 TEST_GEO_CLIP_DEPENDS = GEO MATH
 $(eval $(call link-program,TestGeoClip,TEST_GEO_CLIP))
 
+TEST_WIND_EKF_SOURCES = \
+	$(SRC)/Computer/Wind/WindEKF.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestWindEKF.cpp
+TEST_WIND_EKF_DEPENDS = MATH
+$(eval $(call link-program,TestWindEKF,TEST_WIND_EKF))
+
 TEST_CLIMB_AV_CALC_SOURCES = \
 	$(SRC)/Computer/ClimbAverageCalculator.cpp \
 	$(TEST_SRC_DIR)/tap.c \
@@ -545,6 +641,18 @@ TEST_DIFF_FILTER_SOURCES = \
 TEST_DIFF_FILTER_DEPENDS = MATH
 $(eval $(call link-program,TestDiffFilter,TEST_DIFF_FILTER))
 
+TEST_SAMPLED_WINDOW_FILTER_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestSampledWindowFilter.cpp
+TEST_SAMPLED_WINDOW_FILTER_DEPENDS = MATH
+$(eval $(call link-program,TestSampledWindowFilter,TEST_SAMPLED_WINDOW_FILTER))
+
+TEST_KALMAN_FILTER_1D_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestKalmanFilter1d.cpp
+TEST_KALMAN_FILTER_1D_DEPENDS = MATH
+$(eval $(call link-program,TestKalmanFilter1d,TEST_KALMAN_FILTER_1D))
+
 TEST_FLAT_POINT_SOURCES = \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestFlatPoint.cpp
@@ -571,6 +679,13 @@ TEST_THERMALBASE_SOURCES = \
 TEST_THERMALBASE_DEPENDS = GEO MATH THREAD
 $(eval $(call link-program,TestThermalBase,TEST_THERMALBASE))
 
+TEST_THERMAL_LOCATOR_SOURCES = \
+	$(SRC)/Computer/ThermalLocator.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestThermalLocator.cpp
+TEST_THERMAL_LOCATOR_DEPENDS = GEO MATH
+$(eval $(call link-program,TestThermalLocator,TEST_THERMAL_LOCATOR))
+
 TEST_EARTH_SOURCES = \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestEarth.cpp
@@ -584,6 +699,18 @@ TEST_COLOR_RAMP_SOURCES = \
 TEST_COLOR_RAMP_CPPFLAGS = $(SCREEN_CPPFLAGS)
 $(eval $(call link-program,TestColorRamp,TEST_COLOR_RAMP))
 
+TEST_SLOPE_SHADING_SOURCES = \
+	$(SRC)/Terrain/SlopeShading.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestSlopeShading.cpp
+$(eval $(call link-program,TestSlopeShading,TEST_SLOPE_SHADING))
+
+TEST_CONTOUR_LINES_SOURCES = \
+	$(SRC)/Terrain/ContourLines.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestContourLines.cpp
+$(eval $(call link-program,TestContourLines,TEST_CONTOUR_LINES))
+
 TEST_SUN_EPHEMERIS_SOURCES = \
 	$(SRC)/Math/SunEphemeris.cpp \
 	$(TEST_SRC_DIR)/tap.c \
@@ -624,12 +751,13 @@ TEST_LOGGER_SOURCES = \
 	$(SRC)/Logger/LoggerFRecord.cpp \
 	$(SRC)/Logger/GRecord.cpp \
 	$(SRC)/Logger/LoggerEPE.cpp \
+	$(SRC)/Logger/LoggerOutputThread.cpp \
 	$(SRC)/util/MD5.cpp \
 	$(SRC)/Version.cpp \
 	$(SRC)/Atmosphere/Pressure.cpp \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestLogger.cpp
-TEST_LOGGER_DEPENDS = IO OS GEO MATH UTIL
+TEST_LOGGER_DEPENDS = IO OS THREAD GEO MATH UTIL
 $(eval $(call link-program,TestLogger,TEST_LOGGER))
 
 TEST_GRECORD_SOURCES = \
@@ -720,6 +848,19 @@ DEBUG_PROGRAM_NAMES = \
 	FlightTable \
 	BenchmarkProjection \
 	BenchmarkFAITriangleSector \
+	BenchmarkGlideComputer \
+	BenchmarkContest \
+	BenchmarkSlopeShading \
+	BenchmarkTerrainHeights \
+	BenchmarkAirspacePolygon \
+	BenchmarkLineReader \
+	BenchmarkLabelBlock \
+	BenchmarkCanvas \
+	BenchmarkCloudClients \
+	BenchmarkJSONWriter \
+	BenchmarkFineTimers \
+	BenchmarkFastTrig \
+	BenchmarkRingBuffer \
 	DumpTextFile DumpTextZip DumpTextInflate WriteTextFile RunTextWriter \
 	DumpHexColor \
 	RunXMLParser \
@@ -729,6 +870,7 @@ DEBUG_PROGRAM_NAMES = \
 	AddChecksum \
 	LoadTopography LoadTerrain \
 	RunHeightMatrix \
+	RunReachFan \
 	RunInputParser \
 	RunWaypointParser RunAirspaceParser \
 	RunFlightParser \
@@ -757,6 +899,7 @@ DEBUG_PROGRAM_NAMES += \
 	CAI302Tool \
 	RunIGCWriter \
 	RunFlightLogger RunFlyingComputer \
+	ExportTelemetryJSON \
 	RunCirclingWind RunWindEKF RunWindComputer \
 	RunExternalWind \
 	RunTask \
@@ -781,6 +924,7 @@ DEBUG_PROGRAM_NAMES += \
 	TestNotify \
 	FeedNMEA \
 	FeedVega EmulateDevice \
+	LoadTestNMEA \
 	RunVegaSettings \
 	RunFlarmUtils \
 	RunLX1600Utils \
@@ -790,6 +934,7 @@ endif
 ifeq ($(TARGET),UNIX)
 DEBUG_PROGRAM_NAMES += \
 	AnalyseFlight \
+	RunFlightPhaseBatch \
 	FeedFlyNetData
 endif
 
@@ -801,10 +946,11 @@ endif
 ifeq ($(HAVE_HTTP)$(TARGET_IS_ANDROID),yn)
 DEBUG_PROGRAM_NAMES += DownloadFile \
 	RunDownloadToFile \
+	RunDownloadDelta \
 	UploadFile \
 	RunWeGlideUploadFlight \
 	RunTimClient \
-	RunNOAADownloader RunSkyLinesTracking RunLiveTrack24
+	RunNOAADownloader RunSkyLinesTracking RunSkyLinesLoad RunFleetSimulation RunLiveTrack24
 endif
 
 ifeq ($(TARGET_IS_LINUX),y)
@@ -869,6 +1015,7 @@ DEBUG_REPLAY_SOURCES = \
 	$(TEST_SRC_DIR)/FakeGeoid.cpp \
 	$(TEST_SRC_DIR)/DebugReplayIGC.cpp \
 	$(TEST_SRC_DIR)/DebugReplayNMEA.cpp \
+	$(SRC)/TraceFile.cpp \
 	$(TEST_SRC_DIR)/DebugReplay.cpp
 DEBUG_REPLAY_LDADD = \
 	$(DRIVER_LDADD) \
@@ -884,7 +1031,7 @@ DEBUG_REPLAY_LDADD = \
 BENCHMARK_PROJECTION_SOURCES = \
 	$(SRC)/Projection/Projection.cpp \
 	$(TEST_SRC_DIR)/BenchmarkProjection.cpp
-BENCHMARK_PROJECTION_DEPENDS = MATH
+BENCHMARK_PROJECTION_DEPENDS = GEO MATH
 BENCHMARK_PROJECTION_CPPFLAGS = $(SCREEN_CPPFLAGS)
 $(eval $(call link-program,BenchmarkProjection,BENCHMARK_PROJECTION))
 
@@ -895,6 +1042,129 @@ BENCHMARK_FAI_TRIANGLE_SECTOR_SOURCES = \
 BENCHMARK_FAI_TRIANGLE_SECTOR_DEPENDS = GEO MATH
 $(eval $(call link-program,BenchmarkFAITriangleSector,BENCHMARK_FAI_TRIANGLE_SECTOR))
 
+BENCHMARK_GLIDE_COMPUTER_SOURCES = \
+	$(DEBUG_REPLAY_SOURCES) \
+	$(SRC)/Engine/Trace/Point.cpp \
+	$(SRC)/Engine/Trace/Trace.cpp \
+	$(SRC)/Engine/Trace/Vector.cpp \
+	$(SRC)/Engine/Util/Gradient.cpp \
+	$(SRC)/Task/ProtectedTaskManager.cpp \
+	$(SRC)/Task/ProtectedRoutePlanner.cpp \
+	$(SRC)/Task/RoutePlannerGlue.cpp \
+	$(SRC)/Atmosphere/CuSonde.cpp \
+	$(SRC)/Airspace/ActivePredicate.cpp \
+	$(SRC)/Airspace/ProtectedAirspaceWarningManager.cpp \
+	$(SRC)/Airspace/AirspaceParser.cpp \
+	$(SRC)/Airspace/AirspaceComputerSettings.cpp \
+	$(SRC)/Math/SunEphemeris.cpp \
+	$(SRC)/TeamCode/TeamCode.cpp \
+	$(SRC)/TeamCode/Settings.cpp \
+	$(SRC)/Logger/Settings.cpp \
+	$(SRC)/Cloud/weglide/WeGlideSettings.cpp \
+	$(SRC)/FlightStatistics.cpp \
+	$(SRC)/LocalPath.cpp \
+	$(SRC)/Profile/Profile.cpp \
+	$(SRC)/Operation/ConsoleOperationEnvironment.cpp \
+	$(TEST_SRC_DIR)/FakeLogFile.cpp \
+	$(TEST_SRC_DIR)/AllocationCounter.cpp \
+	$(TEST_SRC_DIR)/BenchmarkGlideComputer.cpp
+BENCHMARK_GLIDE_COMPUTER_DEPENDS = \
+	TERRAIN DRIVER PROFILE OPERATION LIBCOMPUTER LIBNMEA ASYNC IO OS THREAD \
+	CONTEST TASK ROUTE GLIDE WAYPOINT AIRSPACE ZZIP UTIL GEO MATH TIME
+$(eval $(call link-program,BenchmarkGlideComputer,BENCHMARK_GLIDE_COMPUTER))
+
+BENCHMARK_SLOPE_SHADING_SOURCES = \
+	$(SRC)/Projection/Projection.cpp \
+	$(SRC)/Projection/WindowProjection.cpp \
+	$(SRC)/Operation/ConsoleOperationEnvironment.cpp \
+	$(TEST_SRC_DIR)/BenchmarkSlopeShading.cpp
+BENCHMARK_SLOPE_SHADING_CPPFLAGS = $(SCREEN_CPPFLAGS)
+BENCHMARK_SLOPE_SHADING_DEPENDS = TERRAIN OPERATION GEO MATH THREAD OS IO ZZIP UTIL
+$(eval $(call link-program,BenchmarkSlopeShading,BENCHMARK_SLOPE_SHADING))
+
+BENCHMARK_TERRAIN_HEIGHTS_SOURCES = \
+	$(SRC)/Operation/ConsoleOperationEnvironment.cpp \
+	$(TEST_SRC_DIR)/BenchmarkTerrainHeights.cpp
+BENCHMARK_TERRAIN_HEIGHTS_DEPENDS = TERRAIN OPERATION GEO MATH OS IO ZZIP UTIL
+$(eval $(call link-program,BenchmarkTerrainHeights,BENCHMARK_TERRAIN_HEIGHTS))
+
+BENCHMARK_LABEL_BLOCK_SOURCES = \
+	$(SRC)/Renderer/LabelBlock.cpp \
+	$(TEST_SRC_DIR)/BenchmarkLabelBlock.cpp
+$(eval $(call link-program,BenchmarkLabelBlock,BENCHMARK_LABEL_BLOCK))
+
+BENCHMARK_CLOUD_CLIENTS_SOURCES = \
+	$(SRC)/Tracking/SkyLines/Assemble.cpp \
+	$(SRC)/Cloud/Serialiser.cpp \
+	$(SRC)/Cloud/Client.cpp \
+	$(TEST_SRC_DIR)/BenchmarkCloudClients.cpp
+BENCHMARK_CLOUD_CLIENTS_DEPENDS = LIBNET IO OS GEO MATH UTIL
+$(eval $(call link-program,BenchmarkCloudClients,BENCHMARK_CLOUD_CLIENTS))
+
+BENCHMARK_JSON_WRITER_SOURCES = \
+	$(DEBUG_REPLAY_SOURCES) \
+	$(SRC)/Formatter/TimeFormatter.cpp \
+	$(TEST_SRC_DIR)/TelemetryJSON.cpp \
+	$(TEST_SRC_DIR)/BenchmarkJSONWriter.cpp
+BENCHMARK_JSON_WRITER_LDADD = $(DEBUG_REPLAY_LDADD)
+BENCHMARK_JSON_WRITER_DEPENDS = JSON GEO MATH UTIL ZLIB
+$(eval $(call link-program,BenchmarkJSONWriter,BENCHMARK_JSON_WRITER))
+
+BENCHMARK_FINE_TIMERS_SOURCES = \
+	$(TEST_SRC_DIR)/BenchmarkFineTimers.cpp
+BENCHMARK_FINE_TIMERS_DEPENDS = ASYNC OS IO UTIL
+$(eval $(call link-program,BenchmarkFineTimers,BENCHMARK_FINE_TIMERS))
+
+BENCHMARK_FAST_TRIG_SOURCES = \
+	$(TEST_SRC_DIR)/BenchmarkFastTrig.cpp
+BENCHMARK_FAST_TRIG_DEPENDS = MATH
+$(eval $(call link-program,BenchmarkFastTrig,BENCHMARK_FAST_TRIG))
+
+BENCHMARK_RING_BUFFER_SOURCES = \
+	$(TEST_SRC_DIR)/BenchmarkRingBuffer.cpp
+$(eval $(call link-program,BenchmarkRingBuffer,BENCHMARK_RING_BUFFER))
+
+BENCHMARK_CANVAS_SOURCES = \
+	$(SRC)/ui/canvas/memory/Dither.cpp \
+	$(TEST_SRC_DIR)/BenchmarkCanvas.cpp
+BENCHMARK_CANVAS_CPPFLAGS = $(SCREEN_CPPFLAGS)
+$(eval $(call link-program,BenchmarkCanvas,BENCHMARK_CANVAS))
+
+BENCHMARK_AIRSPACE_POLYGON_SOURCES = \
+	$(SRC)/Airspace/AirspaceParser.cpp \
+	$(SRC)/Units/Descriptor.cpp \
+	$(SRC)/Units/System.cpp \
+	$(SRC)/Atmosphere/Pressure.cpp \
+	$(TEST_SRC_DIR)/FakeTerrain.cpp \
+	$(TEST_SRC_DIR)/FakeLanguage.cpp \
+	$(TEST_SRC_DIR)/BenchmarkAirspacePolygon.cpp
+BENCHMARK_AIRSPACE_POLYGON_LDADD = $(FAKE_LIBS)
+BENCHMARK_AIRSPACE_POLYGON_DEPENDS = AIRSPACE OPERATION IO OS ZZIP GEO MATH UTIL
+$(eval $(call link-program,BenchmarkAirspacePolygon,BENCHMARK_AIRSPACE_POLYGON))
+
+BENCHMARK_LINE_READER_SOURCES = \
+	$(SRC)/Waypoint/WaypointFileType.cpp \
+	$(SRC)/Waypoint/WaypointReaderBase.cpp \
+	$(SRC)/Waypoint/WaypointReader.cpp \
+	$(SRC)/Waypoint/WaypointReaderWinPilot.cpp \
+	$(SRC)/Waypoint/WaypointReaderFS.cpp \
+	$(SRC)/Waypoint/WaypointReaderOzi.cpp \
+	$(SRC)/Waypoint/WaypointReaderSeeYou.cpp \
+	$(SRC)/Waypoint/WaypointReaderZander.cpp \
+	$(SRC)/Waypoint/WaypointReaderCompeGPS.cpp \
+	$(SRC)/Waypoint/Factory.cpp \
+	$(SRC)/Airspace/AirspaceParser.cpp \
+	$(SRC)/Units/Descriptor.cpp \
+	$(SRC)/Units/System.cpp \
+	$(SRC)/Atmosphere/Pressure.cpp \
+	$(SRC)/RadioFrequency.cpp \
+	$(TEST_SRC_DIR)/FakeTerrain.cpp \
+	$(TEST_SRC_DIR)/FakeLanguage.cpp \
+	$(TEST_SRC_DIR)/BenchmarkLineReader.cpp
+BENCHMARK_LINE_READER_LDADD = $(FAKE_LIBS)
+BENCHMARK_LINE_READER_DEPENDS = WAYPOINT AIRSPACE OPERATION IO OS THREAD ZZIP GEO MATH UTIL
+$(eval $(call link-program,BenchmarkLineReader,BENCHMARK_LINE_READER))
+
 DUMP_TEXT_FILE_SOURCES = \
 	$(TEST_SRC_DIR)/DumpTextFile.cpp
 DUMP_TEXT_FILE_DEPENDS = IO OS ZZIP UTIL
@@ -912,6 +1182,7 @@ ARC_APPROX_DEPENDS = UTIL GEO MATH
 $(eval $(call link-program,ArcApprox,ARC_APPROX))
 
 DUMP_TEXT_ZIP_SOURCES = \
+	$(SRC)/system/FileMapping.cpp \
 	$(TEST_SRC_DIR)/DumpTextZip.cpp
 DUMP_TEXT_ZIP_DEPENDS = IO ZZIP UTIL
 $(eval $(call link-program,DumpTextZip,DUMP_TEXT_ZIP))
@@ -961,6 +1232,14 @@ RUN_DOWNLOAD_TO_FILE_SOURCES = \
 RUN_DOWNLOAD_TO_FILE_DEPENDS = LIBHTTP ASYNC LIBNET OPERATION IO OS THREAD UTIL
 $(eval $(call link-program,RunDownloadToFile,RUN_DOWNLOAD_TO_FILE))
 
+RUN_DOWNLOAD_DELTA_SOURCES = \
+	$(SRC)/net/SocketError.cxx \
+	$(SRC)/Version.cpp \
+	$(SRC)/Operation/ConsoleOperationEnvironment.cpp \
+	$(TEST_SRC_DIR)/RunDownloadDelta.cpp
+RUN_DOWNLOAD_DELTA_DEPENDS = LIBHTTP ASYNC LIBNET OPERATION IO OS THREAD UTIL
+$(eval $(call link-program,RunDownloadDelta,RUN_DOWNLOAD_DELTA))
+
 UPLOAD_FILE_SOURCES = \
 	$(SRC)/Version.cpp \
 	$(TEST_SRC_DIR)/UploadFile.cpp
@@ -1019,9 +1298,95 @@ RUN_SL_TRACKING_SOURCES = \
 	$(SRC)/Tracking/SkyLines/Assemble.cpp \
 	$(TEST_SRC_DIR)/RunSkyLinesTracking.cpp
 RUN_SL_TRACKING_LDADD = $(DEBUG_REPLAY_LDADD)
-RUN_SL_TRACKING_DEPENDS = ASYNC GEO MATH UTIL
+RUN_SL_TRACKING_DEPENDS = ASYNC GEO MATH UTIL ZLIB
 $(eval $(call link-program,RunSkyLinesTracking,RUN_SL_TRACKING))
 
+RUN_SL_LOAD_SOURCES = \
+	$(SRC)/net/SocketError.cxx \
+	$(SRC)/Tracking/SkyLines/Assemble.cpp \
+	$(SRC)/Replay/TaskAutoPilot.cpp \
+	$(SRC)/Replay/AircraftSim.cpp \
+	$(SRC)/Engine/Navigation/Aircraft.cpp \
+	$(SRC)/Units/Descriptor.cpp \
+	$(SRC)/Units/System.cpp \
+	$(SRC)/IGC/IGCParser.cpp \
+	$(SRC)/Task/TaskFile.cpp \
+	$(SRC)/Task/TaskFileXCSoar.cpp \
+	$(SRC)/Task/TaskFileSeeYou.cpp \
+	$(SRC)/Task/TaskFileIGC.cpp \
+	$(SRC)/Task/Deserialiser.cpp \
+	$(SRC)/Task/LoadFile.cpp \
+	$(SRC)/Waypoint/WaypointReaderBase.cpp \
+	$(SRC)/Waypoint/WaypointReaderSeeYou.cpp \
+	$(SRC)/Waypoint/Factory.cpp \
+	$(SRC)/RadioFrequency.cpp \
+	$(SRC)/XML/Node.cpp \
+	$(SRC)/XML/Parser.cpp \
+	$(SRC)/XML/Writer.cpp \
+	$(SRC)/XML/DataNode.cpp \
+	$(SRC)/XML/DataNodeXML.cpp \
+	$(SRC)/Engine/Util/Gradient.cpp \
+	$(TEST_SRC_DIR)/FakeTerrain.cpp \
+	$(TEST_SRC_DIR)/RunSkyLinesLoad.cpp
+RUN_SL_LOAD_DEPENDS = TASK ROUTE GLIDE WAYPOINT OPERATION LIBNET ASYNC IO OS THREAD GEO MATH UTIL TIME ZLIB
+$(eval $(call link-program,RunSkyLinesLoad,RUN_SL_LOAD))
+
+RUN_FLEET_SIMULATION_SOURCES = \
+	$(DEBUG_REPLAY_SOURCES) \
+	$(SRC)/Replay/DemoReplay.cpp \
+	$(SRC)/Replay/TaskAutoPilot.cpp \
+	$(SRC)/Replay/AircraftSim.cpp \
+	$(SRC)/Engine/Trace/Point.cpp \
+	$(SRC)/Engine/Trace/Trace.cpp \
+	$(SRC)/Engine/Trace/Vector.cpp \
+	$(SRC)/Engine/Util/Gradient.cpp \
+	$(SRC)/Task/ProtectedTaskManager.cpp \
+	$(SRC)/Task/ProtectedRoutePlanner.cpp \
+	$(SRC)/Task/RoutePlannerGlue.cpp \
+	$(SRC)/Task/TaskFile.cpp \
+	$(SRC)/Task/TaskFileXCSoar.cpp \
+	$(SRC)/Task/TaskFileSeeYou.cpp \
+	$(SRC)/Task/TaskFileIGC.cpp \
+	$(SRC)/Task/Deserialiser.cpp \
+	$(SRC)/Task/LoadFile.cpp \
+	$(SRC)/Waypoint/WaypointFileType.cpp \
+	$(SRC)/Waypoint/WaypointReaderBase.cpp \
+	$(SRC)/Waypoint/WaypointReader.cpp \
+	$(SRC)/Waypoint/WaypointReaderWinPilot.cpp \
+	$(SRC)/Waypoint/WaypointReaderFS.cpp \
+	$(SRC)/Waypoint/WaypointReaderOzi.cpp \
+	$(SRC)/Waypoint/WaypointReaderSeeYou.cpp \
+	$(SRC)/Waypoint/WaypointReaderZander.cpp \
+	$(SRC)/Waypoint/WaypointReaderCompeGPS.cpp \
+	$(SRC)/Waypoint/WaypointCache.cpp \
+	$(SRC)/Waypoint/Factory.cpp \
+	$(SRC)/RadioFrequency.cpp \
+	$(SRC)/XML/Node.cpp \
+	$(SRC)/XML/Parser.cpp \
+	$(SRC)/XML/Writer.cpp \
+	$(SRC)/XML/DataNode.cpp \
+	$(SRC)/XML/DataNodeXML.cpp \
+	$(SRC)/Atmosphere/CuSonde.cpp \
+	$(SRC)/Airspace/ActivePredicate.cpp \
+	$(SRC)/Airspace/ProtectedAirspaceWarningManager.cpp \
+	$(SRC)/Airspace/AirspaceParser.cpp \
+	$(SRC)/Airspace/AirspaceComputerSettings.cpp \
+	$(SRC)/Math/SunEphemeris.cpp \
+	$(SRC)/TeamCode/TeamCode.cpp \
+	$(SRC)/TeamCode/Settings.cpp \
+	$(SRC)/Logger/Settings.cpp \
+	$(SRC)/Cloud/weglide/WeGlideSettings.cpp \
+	$(SRC)/FlightStatistics.cpp \
+	$(SRC)/LocalPath.cpp \
+	$(SRC)/Profile/Profile.cpp \
+	$(SRC)/Operation/ConsoleOperationEnvironment.cpp \
+	$(TEST_SRC_DIR)/FakeLogFile.cpp \
+	$(TEST_SRC_DIR)/RunFleetSimulation.cpp
+RUN_FLEET_SIMULATION_DEPENDS = \
+	TERRAIN DRIVER PROFILE OPERATION LIBCOMPUTER LIBNMEA ASYNC IO OS THREAD \
+	CONTEST TASK ROUTE GLIDE WAYPOINT AIRSPACE ZZIP UTIL GEO MATH TIME ZLIB
+$(eval $(call link-program,RunFleetSimulation,RUN_FLEET_SIMULATION))
+
 RUN_LIVETRACK24_SOURCES = \
 	$(DEBUG_REPLAY_SOURCES) \
 	$(SRC)/net/SocketError.cxx \
@@ -1034,7 +1399,7 @@ RUN_LIVETRACK24_SOURCES = \
 	$(SRC)/Operation/ConsoleOperationEnvironment.cpp \
 	$(TEST_SRC_DIR)/RunLiveTrack24.cpp
 RUN_LIVETRACK24_LDADD = $(LIBHTTP_LDADD) $(DEBUG_REPLAY_LDADD)
-RUN_LIVETRACK24_DEPENDS = LIBHTTP CO ASYNC LIBNET OS IO THREAD GEO MATH UTIL
+RUN_LIVETRACK24_DEPENDS = LIBHTTP CO ASYNC LIBNET OS IO THREAD GEO MATH UTIL ZLIB
 $(eval $(call link-program,RunLiveTrack24,RUN_LIVETRACK24))
 
 RUN_REPOSITORY_PARSER_SOURCES = \
@@ -1064,7 +1429,7 @@ READ_PROFILE_STRING_SOURCES = \
 	$(SRC)/Profile/Profile.cpp \
 	$(TEST_SRC_DIR)/FakeLogFile.cpp \
 	$(TEST_SRC_DIR)/ReadProfileString.cpp
-READ_PROFILE_STRING_DEPENDS = PROFILE IO OS UTIL
+READ_PROFILE_STRING_DEPENDS = PROFILE IO OS THREAD UTIL
 $(eval $(call link-program,ReadProfileString,READ_PROFILE_STRING))
 
 READ_PROFILE_INT_SOURCES = \
@@ -1072,7 +1437,7 @@ READ_PROFILE_INT_SOURCES = \
 	$(SRC)/Profile/Profile.cpp \
 	$(TEST_SRC_DIR)/FakeLogFile.cpp \
 	$(TEST_SRC_DIR)/ReadProfileInt.cpp
-READ_PROFILE_INT_DEPENDS = PROFILE IO OS UTIL
+READ_PROFILE_INT_DEPENDS = PROFILE IO OS THREAD UTIL
 $(eval $(call link-program,ReadProfileInt,READ_PROFILE_INT))
 
 RUN_MD5_SOURCES = \
@@ -1083,7 +1448,7 @@ $(eval $(call link-program,RunMD5,RUN_MD5))
 
 RUN_SHA256_SOURCES = \
 	$(TEST_SRC_DIR)/RunSHA256.cpp
-RUN_SHA256_DEPENDS = LIBSODIUM IO OS UTIL
+RUN_SHA256_DEPENDS = CRYPTO IO OS UTIL
 $(eval $(call link-program,RunSHA256,RUN_SHA256))
 
 READ_GRECORD_SOURCES = \
@@ -1159,9 +1524,15 @@ RUN_HEIGHT_MATRIX_SOURCES = \
 	$(SRC)/Operation/ConsoleOperationEnvironment.cpp \
 	$(TEST_SRC_DIR)/RunHeightMatrix.cpp
 RUN_HEIGHT_MATRIX_CPPFLAGS = $(SCREEN_CPPFLAGS)
-RUN_HEIGHT_MATRIX_DEPENDS = TERRAIN OPERATION GEO MATH IO OS ZZIP UTIL
+RUN_HEIGHT_MATRIX_DEPENDS = TERRAIN OPERATION GEO MATH THREAD OS IO ZZIP UTIL
 $(eval $(call link-program,RunHeightMatrix,RUN_HEIGHT_MATRIX))
 
+RUN_REACH_FAN_SOURCES = \
+	$(SRC)/Operation/ConsoleOperationEnvironment.cpp \
+	$(TEST_SRC_DIR)/RunReachFan.cpp
+RUN_REACH_FAN_DEPENDS = TERRAIN OPERATION ROUTE GLIDE GEO MATH THREAD OS IO ZZIP UTIL
+$(eval $(call link-program,RunReachFan,RUN_REACH_FAN))
+
 RUN_INPUT_PARSER_SOURCES = \
 	$(SRC)/Input/InputKeys.cpp \
 	$(SRC)/Input/InputConfig.cpp \
@@ -1183,6 +1554,7 @@ RUN_WAY_POINT_PARSER_SOURCES = \
 	$(SRC)/Waypoint/WaypointReaderSeeYou.cpp \
 	$(SRC)/Waypoint/WaypointReaderZander.cpp \
 	$(SRC)/Waypoint/WaypointReaderCompeGPS.cpp \
+	$(SRC)/Waypoint/WaypointCache.cpp \
 	$(SRC)/Waypoint/Factory.cpp \
 	$(SRC)/Units/Descriptor.cpp \
 	$(SRC)/Units/System.cpp \
@@ -1217,6 +1589,14 @@ NEAREST_WAYPOINTS_LDADD = $(FAKE_LIBS)
 NEAREST_WAYPOINTS_DEPENDS = WAYPOINT OPERATION IO OS THREAD ZZIP GEO MATH UTIL
 $(eval $(call link-program,NearestWaypoints,NEAREST_WAYPOINTS))
 
+TEST_FLIGHT_INDEX_SOURCES = \
+	$(SRC)/Logger/FlightParser.cpp \
+	$(SRC)/Logger/FlightIndex.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestFlightIndex.cpp
+TEST_FLIGHT_INDEX_DEPENDS = IO OS TIME UTIL
+$(eval $(call link-program,TestFlightIndex,TEST_FLIGHT_INDEX))
+
 RUN_FLIGHT_PARSER_SOURCES = \
 	$(SRC)/Logger/FlightParser.cpp \
 	$(TEST_SRC_DIR)/RunFlightParser.cpp
@@ -1226,6 +1606,10 @@ $(eval $(call link-program,RunFlightParser,RUN_FLIGHT_PARSER))
 
 RUN_AIRSPACE_PARSER_SOURCES = \
 	$(SRC)/Airspace/AirspaceParser.cpp \
+	$(SRC)/Airspace/AirspaceCache.cpp \
+	$(SRC)/Airspace/AirspaceVisibility.cpp \
+	$(SRC)/Airspace/AirspaceComputerSettings.cpp \
+	$(SRC)/Renderer/AirspaceRendererSettings.cpp \
 	$(SRC)/Units/Descriptor.cpp \
 	$(SRC)/Units/System.cpp \
 	$(SRC)/Atmosphere/Pressure.cpp \
@@ -1481,7 +1865,7 @@ RUN_IGC_WRITER_SOURCES = \
 	$(SRC)/util/MD5.cpp \
 	$(TEST_SRC_DIR)/RunIGCWriter.cpp
 RUN_IGC_WRITER_LDADD = $(DEBUG_REPLAY_LDADD)
-RUN_IGC_WRITER_DEPENDS = GEO MATH UTIL
+RUN_IGC_WRITER_DEPENDS = GEO MATH UTIL ZLIB
 $(eval $(call link-program,RunIGCWriter,RUN_IGC_WRITER))
 
 RUN_FLIGHT_LOGGER_SOURCES = \
@@ -1491,7 +1875,7 @@ RUN_FLIGHT_LOGGER_SOURCES = \
 	$(TEST_SRC_DIR)/FakeLogFile.cpp \
 	$(TEST_SRC_DIR)/RunFlightLogger.cpp
 RUN_FLIGHT_LOGGER_LDADD = $(DEBUG_REPLAY_LDADD)
-RUN_FLIGHT_LOGGER_DEPENDS = GEO MATH UTIL TIME
+RUN_FLIGHT_LOGGER_DEPENDS = GEO MATH UTIL TIME ZLIB
 $(eval $(call link-program,RunFlightLogger,RUN_FLIGHT_LOGGER))
 
 RUN_FLYING_COMPUTER_SOURCES = \
@@ -1500,9 +1884,18 @@ RUN_FLYING_COMPUTER_SOURCES = \
 	$(SRC)/Formatter/GeoPointFormatter.cpp \
 	$(TEST_SRC_DIR)/RunFlyingComputer.cpp
 RUN_FLYING_COMPUTER_LDADD = $(DEBUG_REPLAY_LDADD)
-RUN_FLYING_COMPUTER_DEPENDS = GEO MATH UTIL
+RUN_FLYING_COMPUTER_DEPENDS = GEO MATH UTIL ZLIB
 $(eval $(call link-program,RunFlyingComputer,RUN_FLYING_COMPUTER))
 
+EXPORT_TELEMETRY_JSON_SOURCES = \
+	$(DEBUG_REPLAY_SOURCES) \
+	$(SRC)/Formatter/TimeFormatter.cpp \
+	$(TEST_SRC_DIR)/TelemetryJSON.cpp \
+	$(TEST_SRC_DIR)/ExportTelemetryJSON.cpp
+EXPORT_TELEMETRY_JSON_LDADD = $(DEBUG_REPLAY_LDADD)
+EXPORT_TELEMETRY_JSON_DEPENDS = JSON GEO MATH UTIL ZLIB
+$(eval $(call link-program,ExportTelemetryJSON,EXPORT_TELEMETRY_JSON))
+
 RUN_CIRCLING_WIND_SOURCES = \
 	$(DEBUG_REPLAY_SOURCES) \
 	$(SRC)/Formatter/TimeFormatter.cpp \
@@ -1510,7 +1903,7 @@ RUN_CIRCLING_WIND_SOURCES = \
 	$(SRC)/Computer/Wind/CirclingWind.cpp \
 	$(TEST_SRC_DIR)/RunCirclingWind.cpp
 RUN_CIRCLING_WIND_LDADD = $(DEBUG_REPLAY_LDADD)
-RUN_CIRCLING_WIND_DEPENDS = GEO MATH UTIL
+RUN_CIRCLING_WIND_DEPENDS = GEO MATH UTIL ZLIB
 $(eval $(call link-program,RunCirclingWind,RUN_CIRCLING_WIND))
 
 RUN_WIND_EKF_SOURCES = \
@@ -1521,7 +1914,7 @@ RUN_WIND_EKF_SOURCES = \
 	$(SRC)/Formatter/TimeFormatter.cpp \
 	$(TEST_SRC_DIR)/RunWindEKF.cpp
 RUN_WIND_EKF_LDADD = $(DEBUG_REPLAY_LDADD)
-RUN_WIND_EKF_DEPENDS = GEO MATH UTIL TIME
+RUN_WIND_EKF_DEPENDS = GEO MATH UTIL TIME ZLIB
 $(eval $(call link-program,RunWindEKF,RUN_WIND_EKF))
 
 RUN_WIND_COMPUTER_SOURCES = \
@@ -1537,7 +1930,7 @@ RUN_WIND_COMPUTER_SOURCES = \
 	$(SRC)/Formatter/TimeFormatter.cpp \
 	$(TEST_SRC_DIR)/RunWindComputer.cpp
 RUN_WIND_COMPUTER_LDADD = $(DEBUG_REPLAY_LDADD)
-RUN_WIND_COMPUTER_DEPENDS = GEO MATH UTIL TIME
+RUN_WIND_COMPUTER_DEPENDS = GEO MATH UTIL TIME ZLIB
 $(eval $(call link-program,RunWindComputer,RUN_WIND_COMPUTER))
 
 RUN_EXTERNAL_WIND_SOURCES = \
@@ -1545,7 +1938,7 @@ RUN_EXTERNAL_WIND_SOURCES = \
 	$(SRC)/Formatter/TimeFormatter.cpp \
 	$(TEST_SRC_DIR)/RunExternalWind.cpp
 RUN_EXTERNAL_WIND_LDADD = $(DEBUG_REPLAY_LDADD)
-RUN_EXTERNAL_WIND_DEPENDS = GEO MATH UTIL TIME
+RUN_EXTERNAL_WIND_DEPENDS = GEO MATH UTIL TIME ZLIB
 $(eval $(call link-program,RunExternalWind,RUN_EXTERNAL_WIND))
 
 RUN_TASK_SOURCES = \
@@ -1571,7 +1964,7 @@ RUN_TASK_SOURCES = \
 	$(TEST_SRC_DIR)/FakeTerrain.cpp \
 	$(TEST_SRC_DIR)/RunTask.cpp
 RUN_TASK_LDADD = $(DEBUG_REPLAY_LDADD)
-RUN_TASK_DEPENDS = TASK WAYPOINT GLIDE GEO MATH UTIL IO TIME
+RUN_TASK_DEPENDS = TASK WAYPOINT GLIDE GEO MATH UTIL IO TIME ZLIB
 $(eval $(call link-program,RunTask,RUN_TASK))
 
 RUN_TRACE_SOURCES = \
@@ -1581,9 +1974,10 @@ RUN_TRACE_SOURCES = \
 	$(ENGINE_SRC_DIR)/Trace/Point.cpp \
 	$(ENGINE_SRC_DIR)/Trace/Trace.cpp \
 	$(TEST_SRC_DIR)/Printing.cpp \
+	$(TEST_SRC_DIR)/AllocationCounter.cpp \
 	$(TEST_SRC_DIR)/RunTrace.cpp
 RUN_TRACE_LDADD = $(DEBUG_REPLAY_LDADD)
-RUN_TRACE_DEPENDS = UTIL LIBNMEA GEO MATH TIME
+RUN_TRACE_DEPENDS = UTIL LIBNMEA GEO MATH TIME ZLIB
 $(eval $(call link-program,RunTrace,RUN_TRACE))
 
 RUN_CONTEST_SOURCES = \
@@ -1595,10 +1989,21 @@ RUN_CONTEST_SOURCES = \
 	$(TEST_SRC_DIR)/Printing.cpp \
 	$(TEST_SRC_DIR)/ContestPrinting.cpp \
 	$(TEST_SRC_DIR)/RunContestAnalysis.cpp
-RUN_CONTEST_LDADD = $(DEBUG_REPLAY_LDADD)
-RUN_CONTEST_DEPENDS = CONTEST UTIL GEO MATH TIME
+RUN_CONTEST_LDADD = $(CONTEST_LDADD) $(DEBUG_REPLAY_LDADD)
+RUN_CONTEST_DEPENDS = CONTEST THREAD UTIL GEO MATH TIME ZLIB
 $(eval $(call link-program,RunContestAnalysis,RUN_CONTEST))
 
+BENCHMARK_CONTEST_SOURCES = \
+	$(DEBUG_REPLAY_SOURCES) \
+	$(SRC)/IGC/IGCParser.cpp \
+	$(ENGINE_SRC_DIR)/Trace/Point.cpp \
+	$(ENGINE_SRC_DIR)/Trace/Trace.cpp \
+	$(TEST_SRC_DIR)/AllocationCounter.cpp \
+	$(TEST_SRC_DIR)/BenchmarkContest.cpp
+BENCHMARK_CONTEST_LDADD = $(CONTEST_LDADD) $(DEBUG_REPLAY_LDADD)
+BENCHMARK_CONTEST_DEPENDS = CONTEST UTIL GEO MATH TIME ZLIB
+$(eval $(call link-program,BenchmarkContest,BENCHMARK_CONTEST))
+
 RUN_WAVE_COMPUTER_SOURCES = \
 	$(DEBUG_REPLAY_SOURCES) \
 	$(SRC)/Computer/WaveComputer.cpp \
@@ -1608,7 +2013,7 @@ RUN_WAVE_COMPUTER_SOURCES = \
 	$(ENGINE_SRC_DIR)/Trace/Trace.cpp \
 	$(TEST_SRC_DIR)/RunWaveComputer.cpp
 RUN_WAVE_COMPUTER_LDADD = $(DEBUG_REPLAY_LDADD)
-RUN_WAVE_COMPUTER_DEPENDS = UTIL GEO MATH TIME
+RUN_WAVE_COMPUTER_DEPENDS = UTIL GEO MATH TIME ZLIB
 $(eval $(call link-program,RunWaveComputer,RUN_WAVE_COMPUTER))
 
 ANALYSE_FLIGHT_SOURCES = \
@@ -1628,10 +2033,23 @@ ANALYSE_FLIGHT_SOURCES = \
 	$(TEST_SRC_DIR)/FlightPhaseJSON.cpp \
 	$(TEST_SRC_DIR)/FlightPhaseDetector.cpp \
 	$(TEST_SRC_DIR)/AnalyseFlight.cpp
-ANALYSE_FLIGHT_LDADD = $(DEBUG_REPLAY_LDADD)
-ANALYSE_FLIGHT_DEPENDS = CONTEST JSON UTIL GEO MATH TIME
+ANALYSE_FLIGHT_LDADD = $(CONTEST_LDADD) $(DEBUG_REPLAY_LDADD)
+ANALYSE_FLIGHT_DEPENDS = CONTEST THREAD JSON UTIL GEO MATH TIME ZLIB
 $(eval $(call link-program,AnalyseFlight,ANALYSE_FLIGHT))
 
+RUN_FLIGHT_PHASE_BATCH_SOURCES = \
+	$(DEBUG_REPLAY_SOURCES) \
+	$(SRC)/NMEA/Aircraft.cpp \
+	$(SRC)/Formatter/TimeFormatter.cpp \
+	$(SRC)/Computer/CirclingComputer.cpp \
+	$(TEST_SRC_DIR)/FakeTerrain.cpp \
+	$(TEST_SRC_DIR)/FlightPhaseJSON.cpp \
+	$(TEST_SRC_DIR)/FlightPhaseDetector.cpp \
+	$(TEST_SRC_DIR)/RunFlightPhaseBatch.cpp
+RUN_FLIGHT_PHASE_BATCH_LDADD = $(DEBUG_REPLAY_LDADD)
+RUN_FLIGHT_PHASE_BATCH_DEPENDS = THREAD JSON UTIL GEO MATH TIME ZLIB
+$(eval $(call link-program,RunFlightPhaseBatch,RUN_FLIGHT_PHASE_BATCH))
+
 FLIGHT_PATH_SOURCES = \
 	$(DEBUG_REPLAY_SOURCES) \
 	$(SRC)/IGC/IGCParser.cpp \
@@ -1642,7 +2060,7 @@ FLIGHT_PATH_SOURCES = \
 	$(TEST_SRC_DIR)/Printing.cpp \
 	$(TEST_SRC_DIR)/FlightPath.cpp
 FLIGHT_PATH_LDADD = $(DEBUG_REPLAY_LDADD)
-FLIGHT_PATH_DEPENDS = UTIL GEO MATH TIME
+FLIGHT_PATH_DEPENDS = UTIL GEO MATH TIME ZLIB
 $(eval $(call link-program,FlightPath,FLIGHT_PATH))
 
 LOAD_IMAGE_SOURCES = \
@@ -1717,6 +2135,7 @@ RUN_MAP_WINDOW_SOURCES = \
 	$(SRC)/Renderer/AircraftRenderer.cpp \
 	$(SRC)/Renderer/AirspaceRenderer.cpp \
 	$(SRC)/Renderer/AirspaceRendererGL.cpp \
+	$(SRC)/Renderer/AirspaceVertexCache.cpp \
 	$(SRC)/Renderer/AirspaceRendererOther.cpp \
 	$(SRC)/Renderer/AirspaceLabelList.cpp \
 	$(SRC)/Renderer/AirspaceLabelRenderer.cpp \
@@ -1787,6 +2206,7 @@ RUN_MAP_WINDOW_SOURCES = \
 	$(SRC)/Waypoint/LastUsed.cpp \
 	$(SRC)/Waypoint/WaypointFileType.cpp \
 	$(SRC)/Waypoint/WaypointGlue.cpp \
+	$(SRC)/Waypoint/WaypointCache.cpp \
 	$(SRC)/Waypoint/WaypointReader.cpp \
 	$(SRC)/Waypoint/WaypointReaderBase.cpp \
 	$(SRC)/Waypoint/WaypointReaderOzi.cpp \
@@ -2182,6 +2602,7 @@ RUN_ANALYSIS_SOURCES = \
 	$(SRC)/Dialogs/DialogSettings.cpp \
 	$(SRC)/CrossSection/AirspaceXSRenderer.cpp \
 	$(SRC)/CrossSection/TerrainXSRenderer.cpp \
+	$(SRC)/CrossSection/CrossSectionCache.cpp \
 	$(SRC)/CrossSection/CrossSectionRenderer.cpp \
 	$(SRC)/CrossSection/CrossSectionWindow.cpp \
 	$(SRC)/FlightStatistics.cpp \
@@ -2214,11 +2635,13 @@ RUN_ANALYSIS_SOURCES = \
 	$(SRC)/IGC/IGCParser.cpp \
 	$(SRC)/MapSettings.cpp \
 	$(SRC)/Blackboard/InterfaceBlackboard.cpp \
+	$(SRC)/Blackboard/DerivedSerials.cpp \
 	$(SRC)/Engine/Navigation/TraceHistory.cpp \
 	$(SRC)/Airspace/ActivePredicate.cpp \
 	$(SRC)/Airspace/ProtectedAirspaceWarningManager.cpp \
 	$(SRC)/Airspace/AirspaceParser.cpp \
 	$(SRC)/Airspace/AirspaceGlue.cpp \
+	$(SRC)/Airspace/AirspaceCache.cpp \
 	$(SRC)/Airspace/AirspaceVisibility.cpp \
 	$(SRC)/Airspace/AirspaceComputerSettings.cpp \
 	$(SRC)/Renderer/AirspaceRendererSettings.cpp \
@@ -2329,14 +2752,14 @@ PLAY_VARIO_SOURCES = \
 	$(TEST_SRC_DIR)/FakeLogFile.cpp \
 	$(TEST_SRC_DIR)/PlayVario.cpp
 PLAY_VARIO_LDADD = $(AUDIO_LDADD) $(SCREEN_LDADD) $(EVENT_LDADD) $(filter-out $(THREAD_LIBS),$(filter-out $(OS_LIBS),$(DEBUG_REPLAY_LDADD)))
-PLAY_VARIO_DEPENDS = AUDIO GEO MATH SCREEN EVENT ASYNC THREAD OS TIME UTIL
+PLAY_VARIO_DEPENDS = AUDIO GEO MATH SCREEN EVENT ASYNC THREAD OS TIME UTIL ZLIB
 $(eval $(call link-program,PlayVario,PLAY_VARIO))
 
 DUMP_VARIO_SOURCES = \
 	$(DEBUG_REPLAY_SOURCES) \
 	$(TEST_SRC_DIR)/DumpVario.cpp
 DUMP_VARIO_LDADD = $(DEBUG_REPLAY_LDADD)
-DUMP_VARIO_DEPENDS = AUDIO GEO MATH SCREEN EVENT UTIL OS TIME
+DUMP_VARIO_DEPENDS = AUDIO GEO MATH SCREEN EVENT UTIL OS TIME ZLIB
 $(eval $(call link-program,DumpVario,DUMP_VARIO))
 
 RUN_TASK_EDITOR_DIALOG_SOURCES = \
@@ -2366,6 +2789,7 @@ RUN_TASK_EDITOR_DIALOG_SOURCES = \
 	$(SRC)/Formatter/Units.cpp \
 	$(SRC)/Waypoint/WaypointFileType.cpp \
 	$(SRC)/Waypoint/WaypointGlue.cpp \
+	$(SRC)/Waypoint/WaypointCache.cpp \
 	$(SRC)/Waypoint/WaypointReaderBase.cpp \
 	$(SRC)/Waypoint/WaypointReader.cpp \
 	$(SRC)/Waypoint/WaypointReaderOzi.cpp \
@@ -2434,6 +2858,23 @@ EMULATE_DEVICE_SOURCES = \
 EMULATE_DEVICE_DEPENDS = PORT ASYNC LIBNET OPERATION IO OS THREAD LIBNMEA GEO MATH TIME UTIL
 $(eval $(call link-program,EmulateDevice,EMULATE_DEVICE))
 
+LOAD_TEST_NMEA_SOURCES = \
+	$(SRC)/Device/Parser.cpp \
+	$(SRC)/Device/Util/LineSplitter.cpp \
+	$(SRC)/Device/Driver/FLARM/StaticParser.cpp \
+	$(SRC)/FLARM/FlarmId.cpp \
+	$(SRC)/FLARM/Traffic.cpp \
+	$(SRC)/FLARM/List.cpp \
+	$(SRC)/Units/Descriptor.cpp \
+	$(SRC)/Units/System.cpp \
+	$(SRC)/Atmosphere/AirDensity.cpp \
+	$(SRC)/Atmosphere/Pressure.cpp \
+	$(TEST_SRC_DIR)/FakeLogFile.cpp \
+	$(TEST_SRC_DIR)/FakeGeoid.cpp \
+	$(TEST_SRC_DIR)/LoadTestNMEA.cpp
+LOAD_TEST_NMEA_DEPENDS = PORT ASYNC LIBNET OS IO THREAD LIBNMEA GEO MATH TIME UTIL
+$(eval $(call link-program,LoadTestNMEA,LOAD_TEST_NMEA))
+
 FEED_FLYNET_DATA_SOURCES = \
 	$(SRC)/Device/Port/ConfiguredPort.cpp \
 	$(SRC)/Device/Config.cpp \
@@ -2458,7 +2899,7 @@ TASK_INFO_SOURCES = \
 	$(SRC)/XML/DataNodeXML.cpp \
 	$(TEST_SRC_DIR)/FakeLanguage.cpp \
 	$(TEST_SRC_DIR)/TaskInfo.cpp
-TASK_INFO_DEPENDS = TASK ROUTE GLIDE WAYPOINT IO OS GEO TIME MATH UTIL
+TASK_INFO_DEPENDS = TASK ROUTE THREAD GLIDE WAYPOINT IO OS GEO TIME MATH UTIL
 $(eval $(call link-program,TaskInfo,TASK_INFO))
 
 DUMP_TASK_FILE_SOURCES = \
@@ -2499,7 +2940,7 @@ $(eval $(call link-program,DumpFlarmNet,DUMP_FLARM_NET))
 IGC2NMEA_SOURCES = \
 	$(DEBUG_REPLAY_SOURCES) \
 	$(TEST_SRC_DIR)/IGC2NMEA.cpp
-IGC2NMEA_DEPENDS = GEO MATH UTIL TIME
+IGC2NMEA_DEPENDS = GEO MATH UTIL TIME ZLIB
 IGC2NMEA_LDADD = $(DEBUG_REPLAY_LDADD)
 
 $(eval $(call link-program,IGC2NMEA,IGC2NMEA))
@@ -49,6 +49,8 @@ void
 DebugReplayVector::Compute(const int elevation)
 {
   computed_basic.Reset();
+  /* the sample history must survive the reset */
+  computed_basic.speed_samples = last_basic.speed_samples;
   (NMEAInfo &)computed_basic = raw_basic;
   wrap_clock.Normalise(computed_basic);
 
@@ -47,7 +47,8 @@ void
 XCSoarInterface::ReceiveGPS()
 {
   {
-    std::lock_guard<Mutex> lock(device_blackboard->mutex);
+    const StatisticsLockGuard<Mutex> lock(device_blackboard->mutex,
+                                          device_blackboard->lock_statistics.ui);
 
     ReadBlackboardBasic(device_blackboard->Basic());
 
@@ -67,7 +68,8 @@ void
 XCSoarInterface::ReceiveCalculated()
 {
   {
-    std::lock_guard<Mutex> lock(device_blackboard->mutex);
+    const StatisticsLockGuard<Mutex> lock(device_blackboard->mutex,
+                                          device_blackboard->lock_statistics.ui);
 
     ReadBlackboardCalculated(device_blackboard->Calculated());
     device_blackboard->ReadComputerSettings(GetComputerSettings());
@@ -87,7 +89,8 @@ XCSoarInterface::ExchangeBlackboard()
 void
 XCSoarInterface::ExchangeDeviceBlackboard()
 {
-  std::lock_guard<Mutex> lock(device_blackboard->mutex);
+  const StatisticsLockGuard<Mutex> lock(device_blackboard->mutex,
+                                        device_blackboard->lock_statistics.ui);
 
   device_blackboard->ReadComputerSettings(GetComputerSettings());
 }
@@ -284,9 +287,11 @@ ActionInterface::UpdateDisplayMode()
 void
 ActionInterface::SendUIState()
 {
-  /* force-update all InfoBoxes just in case the display mode has
-     changed */
-  InfoBoxManager::SetDirty();
+  /* update all InfoBoxes which show sensor or calculated data; if
+     the display mode has changed, the InfoBoxManager replaces the
+     contents of the new panel and updates them anyway */
+  InfoBoxManager::SetDirty(InfoBoxContent::DEPENDS_BASIC |
+                           InfoBoxContent::DEPENDS_CALCULATED);
   InfoBoxManager::ProcessTimer();
 
   main_window->SetUIState(GetUIState());
@@ -0,0 +1,226 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "AirspaceCache.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "Engine/Airspace/AirspacePolygon.hpp"
+#include "Engine/Airspace/AirspaceCircle.hpp"
+#include "io/FileCache.hpp"
+#include "io/CacheFile.hpp"
+#include "io/FileOutputStream.hxx"
+#include "io/BufferedOutputStream.hxx"
+#include "system/FileMapping.hpp"
+#include "system/Path.hpp"
+#include "util/StringAPI.hxx"
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <string.h>
+
+/**
+ * The payload header, written after the #FileCache header.  It is
+ * followed by the original path (without null terminator) and
+ * #n_airspaces records.  A CRC16 of everything after the #FileCache
+ * header concludes the file.
+ */
+struct AirspaceCacheHeader {
+  static constexpr uint32_t VERSION = 1;
+
+  uint32_t version;
+  uint32_t path_length;
+  uint32_t n_airspaces;
+};
+
+/**
+ * One airspace.  It is followed by the name and the radio text
+ * (without null terminators) and then either the circle's center and
+ * radius or #n_points polygon vertices.
+ */
+struct AirspaceCacheRecord {
+  AirspaceAltitude base, top;
+
+  /** the number of polygon vertices; zero for circles */
+  uint32_t n_points;
+
+  uint32_t name_length, radio_length;
+
+  AbstractAirspace::Shape shape;
+  AirspaceClass type;
+  AirspaceActivity days;
+};
+
+static_assert(std::is_trivially_copyable_v<AirspaceCacheRecord>);
+static_assert(std::is_trivially_copyable_v<GeoPoint>);
+
+static void
+WriteAirspace(CacheFileWriter &w, const AbstractAirspace &airspace)
+{
+  const TCHAR *name = airspace.GetName();
+  const tstring &radio = airspace.GetRadioText();
+
+  AirspaceCacheRecord record;
+
+  /* zero-fill all implicit padding bytes, they are part of the
+     checksum */
+  memset(static_cast<void *>(&record), 0, sizeof(record));
+
+  record.base = airspace.GetBase();
+  record.top = airspace.GetTop();
+  record.name_length = StringLength(name);
+  record.radio_length = radio.length();
+  record.shape = airspace.GetShape();
+  record.type = airspace.GetType();
+  record.days = airspace.GetDays();
+
+  if (record.shape == AbstractAirspace::Shape::POLYGON)
+    record.n_points = airspace.GetPoints().size();
+
+  w.WriteT(record);
+  w.WriteString(name, record.name_length);
+  w.WriteString(radio.data(), record.radio_length);
+
+  switch (record.shape) {
+  case AbstractAirspace::Shape::CIRCLE: {
+    const auto &circle = (const AirspaceCircle &)airspace;
+    w.WriteT(circle.GetReferenceLocation());
+    w.WriteT(circle.GetRadius());
+    break;
+  }
+
+  case AbstractAirspace::Shape::POLYGON:
+    for (const auto &i : airspace.GetPoints())
+      w.WriteT(i.GetLocation());
+    break;
+  }
+}
+
+static AirspacePtr
+ReadAirspace(CacheFileReader &r)
+{
+  const auto record = r.ReadT<AirspaceCacheRecord>();
+  tstring name = r.ReadString(record.name_length);
+  tstring radio = r.ReadString(record.radio_length);
+
+  AirspacePtr airspace;
+
+  switch (record.shape) {
+  case AbstractAirspace::Shape::CIRCLE: {
+    const auto center = r.ReadT<GeoPoint>();
+    const auto radius = r.ReadT<double>();
+    if (!center.IsValid() || !(radius >= 0))
+      throw std::runtime_error("Malformed airspace cache");
+
+    airspace = std::make_shared<AirspaceCircle>(center, radius);
+    break;
+  }
+
+  case AbstractAirspace::Shape::POLYGON: {
+    if (record.n_points < 3 ||
+        record.n_points > r.GetRemaining() / sizeof(GeoPoint))
+      throw std::runtime_error("Malformed airspace cache");
+
+    std::vector<GeoPoint> points(record.n_points);
+    memcpy(points.data(), r.Read(points.size() * sizeof(GeoPoint)),
+           points.size() * sizeof(GeoPoint));
+
+    airspace = std::make_shared<AirspacePolygon>(points);
+    break;
+  }
+
+  default:
+    throw std::runtime_error("Malformed airspace cache");
+  }
+
+  airspace->SetProperties(std::move(name), record.type,
+                          record.base, record.top);
+  airspace->SetRadio(radio);
+  airspace->SetDays(record.days);
+  return airspace;
+}
+
+bool
+LoadAirspaceCache(Airspaces &airspaces, FileCache &cache,
+                  const TCHAR *name, Path path)
+{
+  const auto mapping = cache.Map(name, path);
+  if (!mapping)
+    return false;
+
+  auto r = CacheFileReader::FromMapping(*mapping);
+
+  const auto header = r.ReadT<AirspaceCacheHeader>();
+  if (header.version != AirspaceCacheHeader::VERSION)
+    return false;
+
+  /* the cache entry may have been written for a different file which
+     happens to have the same modification time and size */
+  if (r.ReadString(header.path_length) != path.c_str())
+    return false;
+
+  if (header.n_airspaces > r.GetRemaining() / sizeof(AirspaceCacheRecord))
+    throw std::runtime_error("Malformed airspace cache");
+
+  std::vector<AirspacePtr> loaded;
+  loaded.reserve(header.n_airspaces);
+  for (unsigned i = 0; i < header.n_airspaces; ++i)
+    loaded.emplace_back(ReadAirspace(r));
+
+  if (r.GetRemaining() > 0)
+    throw std::runtime_error("Malformed airspace cache");
+
+  for (auto &i : loaded)
+    airspaces.Add(std::move(i));
+
+  return true;
+}
+
+void
+SaveAirspaceCache(const Airspaces &airspaces, FileCache &cache,
+                  const TCHAR *name, Path path)
+{
+  const TCHAR *path_string = path.c_str();
+
+  AirspaceCacheHeader header;
+  header.version = AirspaceCacheHeader::VERSION;
+  header.path_length = StringLength(path_string);
+  header.n_airspaces = airspaces.GetSize();
+
+  auto os = cache.Save(name, path);
+  BufferedOutputStream bos(*os);
+  CacheFileWriter w(bos);
+
+  w.WriteT(header);
+  w.WriteString(path_string, header.path_length);
+
+  for (const auto &i : airspaces.QueryAll())
+    WriteAirspace(w, i.GetAirspace());
+
+  w.WriteChecksum();
+
+  bos.Flush();
+  os->Commit();
+}
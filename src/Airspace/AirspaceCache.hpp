@@ -0,0 +1,60 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_AIRSPACE_CACHE_HPP
+#define XCSOAR_AIRSPACE_CACHE_HPP
+
+#include <tchar.h>
+
+class Path;
+class FileCache;
+class Airspaces;
+
+/**
+ * Load the airspaces which were parsed from the specified file from
+ * the cache.  They are added to #airspaces, but Airspaces::Optimise()
+ * is not called.  Nothing is added if the cache entry is incomplete
+ * or corrupt.
+ *
+ * Throws on error.
+ *
+ * @param name the name of the cache entry
+ * @param path the original airspace file; the cache entry is only
+ * used if it still matches this file's modification time and size
+ * @return false if there is no valid cache entry
+ */
+bool
+LoadAirspaceCache(Airspaces &airspaces, FileCache &cache,
+                  const TCHAR *name, Path path);
+
+/**
+ * Save all (optimised) airspaces of #airspaces to the cache, keyed on
+ * the original airspace file.
+ *
+ * Throws on error.
+ */
+void
+SaveAirspaceCache(const Airspaces &airspaces, FileCache &cache,
+                  const TCHAR *name, Path path);
+
+#endif
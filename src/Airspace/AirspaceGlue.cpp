@@ -23,17 +23,22 @@ Copyright_License {
 
 #include "Airspace/AirspaceGlue.hpp"
 #include "Airspace/AirspaceParser.hpp"
+#include "Airspace/AirspaceCache.hpp"
 #include "Engine/Airspace/Airspaces.hpp"
 #include "Profile/ProfileKeys.hpp"
-#include "Operation/Operation.hpp"
+#include "Operation/JobOperationEnvironment.hpp"
 #include "Language/Language.hpp"
 #include "LogFile.hpp"
 #include "system/Path.hpp"
 #include "io/FileLineReader.hpp"
 #include "io/ZipArchive.hpp"
 #include "io/ZipLineReader.hpp"
-#include "io/MapFile.hpp"
 #include "Profile/Profile.hpp"
+#include "thread/ThreadPool.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <thread>
 
 #include <string.h>
 
@@ -57,10 +62,10 @@ try {
 
 static bool
 ParseAirspaceFile(Airspaces &airspaces,
-                  struct zzip_dir *dir, const char *path,
+                  ZipArchive &archive, const char *path,
                   OperationEnvironment &operation)
 {
-  ZipLineReader reader(dir, path, Charset::AUTO);
+  ZipLineReader reader(archive, path, Charset::AUTO);
 
   if (!ParseAirspaceFile(airspaces, reader, operation)) {
     LogFormat("Failed to parse airspace file: %s", path);
@@ -70,33 +75,185 @@ ParseAirspaceFile(Airspaces &airspaces,
   return true;
 }
 
+/**
+ * Move the airspaces from #parsed to #airspaces.  If parsing was
+ * successful, save them to the cache.
+ */
+static bool
+AddParsed(Airspaces &airspaces, Airspaces &parsed, bool success,
+          FileCache &cache, const TCHAR *cache_name, Path path)
+{
+  parsed.Optimise();
+
+  if (success) {
+    try {
+      SaveAirspaceCache(parsed, cache, cache_name, path);
+    } catch (...) {
+      LogError(std::current_exception(), "Failed to save airspace cache");
+    }
+  }
+
+  for (const auto &i : parsed.QueryAll())
+    airspaces.Add(i.GetAirspacePtr());
+
+  return success;
+}
+
+static bool
+LoadCache(Airspaces &airspaces, FileCache *cache, const TCHAR *cache_name,
+          Path path) noexcept
+try {
+  return cache != nullptr &&
+    LoadAirspaceCache(airspaces, *cache, cache_name, path);
+} catch (...) {
+  LogError(std::current_exception(), "Failed to load airspace cache");
+  return false;
+}
+
+/**
+ * Load the airspace file from the cache; if that fails, parse it and
+ * update the cache.
+ */
+static bool
+ReadAirspaceFile(Airspaces &airspaces, Path path,
+                 FileCache *cache, const TCHAR *cache_name,
+                 OperationEnvironment &operation)
+{
+  if (LoadCache(airspaces, cache, cache_name, path))
+    return true;
+
+  if (cache == nullptr)
+    return ParseAirspaceFile(airspaces, path, operation);
+
+  Airspaces parsed;
+  const bool success = ParseAirspaceFile(parsed, path, operation);
+  return AddParsed(airspaces, parsed, success, *cache, cache_name, path);
+}
+
+/**
+ * Load "airspace.txt" from the map file, using a cache entry keyed on
+ * the map file.
+ *
+ * Throws on error.
+ */
+static bool
+ReadMapAirspace(Airspaces &airspaces, Path path, FileCache *cache,
+                OperationEnvironment &operation)
+{
+  const TCHAR *const cache_name = _T("airspace-map");
+
+  if (LoadCache(airspaces, cache, cache_name, path))
+    return true;
+
+  ZipArchive archive(path);
+
+  if (cache == nullptr)
+    return ParseAirspaceFile(airspaces, archive, "airspace.txt",
+                             operation);
+
+  Airspaces parsed;
+  const bool success = ParseAirspaceFile(parsed, archive,
+                                         "airspace.txt", operation);
+  return AddParsed(airspaces, parsed, success, *cache, cache_name, path);
+}
+
+namespace {
+
+/**
+ * One configured airspace source, loaded into its own staging
+ * container.
+ */
+struct AirspaceSource {
+  AllocatedPath path = nullptr;
+  const TCHAR *cache_name;
+
+  /**
+   * Is this "airspace.txt" inside a map file?
+   */
+  bool map;
+
+  bool ok = false;
+
+  Airspaces airspaces;
+
+  void Load(FileCache *cache, OperationEnvironment &operation) noexcept {
+    if (map) {
+      try {
+        ok = ReadMapAirspace(airspaces, path, cache, operation);
+      } catch (...) {
+        LogError(std::current_exception(),
+                 "Failed to load airspaces from map file");
+      }
+    } else
+      ok = ReadAirspaceFile(airspaces, path, cache, cache_name, operation);
+  }
+};
+
+} // anonymous namespace
+
 void
 ReadAirspace(Airspaces &airspaces,
-             RasterTerrain *terrain,
+             RasterTerrain *terrain, FileCache *cache,
              const AtmosphericPressure &press,
              OperationEnvironment &operation)
 {
   LogFormat("ReadAirspace");
   operation.SetText(_("Loading Airspace File..."));
 
-  bool airspace_ok = false;
+  AirspaceSource sources[3];
+  unsigned n_sources = 0;
 
   // Read the airspace filenames from the registry
-  if (const auto path = Profile::GetPath(ProfileKeys::AirspaceFile);
-      path != nullptr)
-    airspace_ok |= ParseAirspaceFile(airspaces, path, operation);
-
-  if (const auto path = Profile::GetPath(ProfileKeys::AdditionalAirspaceFile);
-      path != nullptr)
-    airspace_ok |= ParseAirspaceFile(airspaces, path, operation);
-
-  try {
-    if (auto archive = OpenMapFile())
-      airspace_ok |= ParseAirspaceFile(airspaces, archive->get(),
-                                       "airspace.txt", operation);
-  } catch (...) {
-    LogError(std::current_exception(),
-             "Failed to load airspaces from map file");
+  if (auto path = Profile::GetPath(ProfileKeys::AirspaceFile);
+      path != nullptr) {
+    auto &source = sources[n_sources++];
+    source.path = std::move(path);
+    source.cache_name = _T("airspace");
+    source.map = false;
+  }
+
+  if (auto path = Profile::GetPath(ProfileKeys::AdditionalAirspaceFile);
+      path != nullptr) {
+    auto &source = sources[n_sources++];
+    source.path = std::move(path);
+    source.cache_name = _T("airspace-additional");
+    source.map = false;
+  }
+
+  if (auto path = Profile::GetPath(ProfileKeys::MapFile);
+      path != nullptr) {
+    auto &source = sources[n_sources++];
+    source.path = std::move(path);
+    source.cache_name = _T("airspace-map");
+    source.map = true;
+  }
+
+  const unsigned n_threads = std::min(std::thread::hardware_concurrency(),
+                                      n_sources);
+  if (n_threads > 1) {
+    /* parse the files in parallel, each into its own container */
+    JobOperationEnvironment job_operation[std::size(sources)] = {
+      JobOperationEnvironment(operation),
+      JobOperationEnvironment(operation),
+      JobOperationEnvironment(operation),
+    };
+
+    ThreadPool pool(n_threads);
+    pool.ForEach(n_sources, [&](unsigned i) noexcept {
+      sources[i].Load(cache, job_operation[i]);
+    });
+
+    for (unsigned i = 0; i < n_sources; ++i)
+      job_operation[i].ForwardError();
+  } else {
+    for (unsigned i = 0; i < n_sources; ++i)
+      sources[i].Load(cache, operation);
+  }
+
+  bool airspace_ok = false;
+  for (unsigned i = 0; i < n_sources; ++i) {
+    airspace_ok |= sources[i].ok;
+    airspaces.Merge(std::move(sources[i].airspaces));
   }
 
   if (airspace_ok) {
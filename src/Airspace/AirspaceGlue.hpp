@@ -28,13 +28,17 @@ class RasterTerrain;
 class AtmosphericPressure;
 class Airspaces;
 class OperationEnvironment;
+class FileCache;
 
 /**
  * Reads the airspace files into the memory
+ *
+ * @param cache an optional #FileCache which stores the parsed
+ * airspace files, to avoid parsing them again on the next startup
  */
 void
 ReadAirspace(Airspaces &airspaces,
-             RasterTerrain *terrain,
+             RasterTerrain *terrain, FileCache *cache,
              const AtmosphericPressure &press,
              OperationEnvironment &operation);
 
@@ -23,6 +23,7 @@ Copyright_License {
 
 #include "NearestAirspace.hpp"
 #include "ProtectedAirspaceWarningManager.hpp"
+#include "Engine/Airspace/AirspaceWarningManager.hpp"
 #include "Airspace/ActivePredicate.hpp"
 #include "Engine/Airspace/Airspaces.hpp"
 #include "Engine/Airspace/AbstractAirspace.hpp"
@@ -33,6 +34,20 @@ Copyright_License {
 #include "NMEA/MoreData.hpp"
 #include "NMEA/Derived.hpp"
 
+#include <algorithm>
+
+/**
+ * Only airspaces within this distance [m] are considered by
+ * FindHorizontal().
+ */
+static constexpr double HORIZONTAL_RANGE = 30000;
+
+/**
+ * NearestAirspaceTracker collects its candidates again after the
+ * aircraft has moved this distance [m].
+ */
+static constexpr double TRACKER_SLACK = 5000;
+
 gcc_pure
 __attribute__((always_inline))
 static inline NearestAirspace
@@ -61,7 +76,7 @@ FindHorizontal(const GeoPoint &location,
                Predicate &&predicate)
 {
   const auto &projection = airspace_database.GetProjection();
-  return FindMinimum(airspace_database, location, 30000,
+  return FindMinimum(airspace_database, location, HORIZONTAL_RANGE,
                      std::forward<Predicate>(predicate),
                      [&location, &projection](ConstAirspacePtr &&airspace){
                        return CalculateNearestAirspaceHorizontal(location, projection, *airspace);
@@ -69,16 +84,16 @@ FindHorizontal(const GeoPoint &location,
                      CompareNearestAirspace());
 }
 
-gcc_pure
-NearestAirspace
-NearestAirspace::FindHorizontal(const MoreData &basic,
-                                const ProtectedAirspaceWarningManager &airspace_warnings,
-                                const Airspaces &airspace_database)
+/**
+ * Invoke the given function with the predicate which selects the
+ * airspaces considered by FindHorizontal().
+ */
+template<typename F>
+static NearestAirspace
+WithHorizontalPredicate(const MoreData &basic,
+                        const ProtectedAirspaceWarningManager &airspace_warnings,
+                        F &&f)
 {
-  if (!basic.location_available)
-    /* can't check for airspaces without a GPS fix */
-    return NearestAirspace();
-
   /* find the nearest airspace */
   //consider only active airspaces
   auto outside_and_active =
@@ -92,13 +107,103 @@ NearestAirspace::FindHorizontal(const MoreData &basic,
       MakeAndPredicate(outside_and_active,
                        AirspacePredicateHeightRange(basic.nav_altitude - 50,
                                                     basic.nav_altitude + 50));
-    return ::FindHorizontal(basic.location, airspace_database,
-                            std::move(outside_and_active_and_height));
+    return f(std::move(outside_and_active_and_height));
   } else {
     /* only filter outside and active */
-    return ::FindHorizontal(basic.location, airspace_database,
-                            std::move(outside_and_active));
+    return f(std::move(outside_and_active));
+  }
+}
+
+gcc_pure
+NearestAirspace
+NearestAirspace::FindHorizontal(const MoreData &basic,
+                                const ProtectedAirspaceWarningManager &airspace_warnings,
+                                const Airspaces &airspace_database)
+{
+  if (!basic.location_available)
+    /* can't check for airspaces without a GPS fix */
+    return NearestAirspace();
+
+  return WithHorizontalPredicate(basic, airspace_warnings,
+                                 [&](auto &&predicate){
+                                   return ::FindHorizontal(basic.location,
+                                                           airspace_database,
+                                                           predicate);
+                                 });
+}
+
+void
+NearestAirspaceTracker::Collect(const GeoPoint &location,
+                                const Airspaces &airspace_database) noexcept
+{
+  const auto &projection = airspace_database.GetProjection();
+
+  candidates.clear();
+  for (const auto &i : airspace_database.QueryWithinRange(location,
+                                                          HORIZONTAL_RANGE + TRACKER_SLACK)) {
+    const AbstractAirspace &airspace = i.GetAirspace();
+    const auto closest = airspace.ClosestPoint(location, projection);
+    candidates.push_back({i.GetAirspacePtr(), closest.DistanceS(location)});
+  }
+
+  std::sort(candidates.begin(), candidates.end(),
+            [](const Candidate &a, const Candidate &b){
+              return a.distance < b.distance;
+            });
+
+  origin = location;
+  serial = airspace_database.GetSerial();
+}
+
+template<typename Predicate>
+inline NearestAirspace
+NearestAirspaceTracker::Find(const GeoPoint &location,
+                             const Airspaces &airspace_database,
+                             Predicate &&predicate) const noexcept
+{
+  const auto &projection = airspace_database.GetProjection();
+  const double moved = origin.DistanceS(location);
+
+  NearestAirspace nearest;
+  for (const auto &i : candidates) {
+    /* the distance to this (and all following) candidates has
+       shrunk by no more than the distance flown since #origin */
+    const double lower_bound = i.distance - moved;
+    if (lower_bound > HORIZONTAL_RANGE ||
+        (nearest.IsDefined() && lower_bound >= nearest.distance))
+      break;
+
+    if (!predicate(*i.airspace))
+      continue;
+
+    auto result = CalculateNearestAirspaceHorizontal(location, projection,
+                                                     *i.airspace);
+    if (CompareNearestAirspace()(result, nearest))
+      nearest = result;
   }
+
+  return nearest;
+}
+
+NearestAirspace
+NearestAirspaceTracker::FindHorizontal(const MoreData &basic,
+                                       const ProtectedAirspaceWarningManager &airspace_warnings,
+                                       const Airspaces &airspace_database) noexcept
+{
+  if (!basic.location_available)
+    /* can't check for airspaces without a GPS fix */
+    return NearestAirspace();
+
+  if (!origin.IsValid() || serial != airspace_database.GetSerial() ||
+      origin.DistanceS(basic.location) > TRACKER_SLACK)
+    Collect(basic.location, airspace_database);
+
+  return WithHorizontalPredicate(basic, airspace_warnings,
+                                 [&](auto &&predicate){
+                                   return Find(basic.location,
+                                               airspace_database,
+                                               predicate);
+                                 });
 }
 
 gcc_pure
@@ -124,8 +229,17 @@ NearestAirspace::FindVertical(const MoreData &basic,
   double nearest_delta = 100000;
   const ActiveAirspacePredicate active_predicate(&airspace_warnings);
 
-  for (const auto &i : airspace_database.QueryInside(basic.location)) {
-    const AbstractAirspace &airspace = i.GetAirspace();
+  /* the warning manager has already determined which airspaces
+     contain the aircraft; query the database only if its result is
+     not for this location */
+  std::vector<ConstAirspacePtr> inside;
+  if (!ProtectedAirspaceWarningManager::Lease(airspace_warnings)
+      ->GetInside(basic.location, inside))
+    for (const auto &i : airspace_database.QueryInside(basic.location))
+      inside.push_back(i.GetAirspacePtr());
+
+  for (const auto &i : inside) {
+    const AbstractAirspace &airspace = *i;
 
     if (!active_predicate(airspace))
       continue;
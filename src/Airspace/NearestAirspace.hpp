@@ -24,8 +24,13 @@ Copyright_License {
 #ifndef NEAREST_AIRSPACE_HPP
 #define NEAREST_AIRSPACE_HPP
 
+#include "Engine/Airspace/Ptr.hpp"
+#include "Geo/GeoPoint.hpp"
+#include "util/Serial.hpp"
 #include "util/Compiler.h"
 
+#include <vector>
+
 struct MoreData;
 struct DerivedInfo;
 class Airspaces;
@@ -64,4 +69,61 @@ public:
                const Airspaces &airspace_database);
 };
 
+/**
+ * Maintains the candidates of NearestAirspace::FindHorizontal() while
+ * the aircraft moves.  The distance to an airspace changes by at most
+ * the distance flown, therefore the candidates (sorted by their
+ * distance from where they were collected) need to be collected
+ * again only after the aircraft has moved a few kilometers, and each
+ * lookup evaluates only the few candidates which may be the nearest
+ * one.
+ */
+class NearestAirspaceTracker {
+  struct Candidate {
+    ConstAirspacePtr airspace;
+
+    /**
+     * The distance from #origin [m].
+     */
+    double distance;
+  };
+
+  /**
+   * All airspaces within range of #origin, sorted by distance.
+   */
+  std::vector<Candidate> candidates;
+
+  /**
+   * The location where #candidates were collected.
+   */
+  GeoPoint origin = GeoPoint::Invalid();
+
+  /**
+   * The Airspaces::GetSerial() value #candidates was obtained from.
+   */
+  Serial serial;
+
+public:
+  void Clear() noexcept {
+    candidates.clear();
+    origin.SetInvalid();
+  }
+
+  /**
+   * The equivalent of NearestAirspace::FindHorizontal().
+   */
+  NearestAirspace FindHorizontal(const MoreData &basic,
+                                 const ProtectedAirspaceWarningManager &airspace_warnings,
+                                 const Airspaces &airspace_database) noexcept;
+
+private:
+  void Collect(const GeoPoint &location,
+               const Airspaces &airspace_database) noexcept;
+
+  template<typename Predicate>
+  NearestAirspace Find(const GeoPoint &location,
+                       const Airspaces &airspace_database,
+                       Predicate &&predicate) const noexcept;
+};
+
 #endif
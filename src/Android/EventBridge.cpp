@@ -134,7 +134,7 @@ Java_org_xcsoar_EventBridge_onMouseMove(JNIEnv *env, jclass cls,
     /* XCSoar not yet initialised */
     return;
 
-  event_queue->Purge(Event::MOUSE_MOTION);
+  /* EventQueue::Push() replaces a pending motion event */
   event_queue->Push(Event(Event::MOUSE_MOTION, PixelPoint(x, y)));
   ResetUserIdle();
 }
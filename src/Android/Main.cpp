@@ -53,6 +53,7 @@ Copyright_License {
 #include "ui/event/Queue.hpp"
 #include "ui/canvas/opengl/Init.hpp"
 #include "Dialogs/Message.hpp"
+#include "system/SystemMemory.hpp"
 #include "Profile/Profile.hpp"
 #include "MainWindow.hpp"
 #include "Startup.hpp"
@@ -326,6 +327,33 @@ Java_org_xcsoar_NativeView_resumeNative(JNIEnv *env, jobject obj)
   CommonInterface::main_window->Resume();
 }
 
+gcc_visibility_default
+JNIEXPORT void JNICALL
+Java_org_xcsoar_NativeView_trimMemoryNative(JNIEnv *env, jobject obj,
+                                            jint level)
+{
+  /* see android.content.ComponentCallbacks2 */
+  constexpr jint TRIM_MEMORY_RUNNING_MODERATE = 5;
+  constexpr jint TRIM_MEMORY_RUNNING_CRITICAL = 15;
+  constexpr jint TRIM_MEMORY_UI_HIDDEN = 20;
+  constexpr jint TRIM_MEMORY_COMPLETE = 80;
+
+  MemoryPressure pressure;
+  if (level >= TRIM_MEMORY_COMPLETE)
+    pressure = MemoryPressure::CRITICAL;
+  else if (level >= TRIM_MEMORY_UI_HIDDEN)
+    /* we're in the background */
+    pressure = MemoryPressure::MODERATE;
+  else if (level >= TRIM_MEMORY_RUNNING_CRITICAL)
+    pressure = MemoryPressure::CRITICAL;
+  else if (level >= TRIM_MEMORY_RUNNING_MODERATE)
+    pressure = MemoryPressure::MODERATE;
+  else
+    pressure = MemoryPressure::NONE;
+
+  ReportMemoryPressure(pressure);
+}
+
 gcc_visibility_default
 JNIEXPORT void JNICALL
 Java_org_xcsoar_NativeView_setHapticFeedback(JNIEnv *env, jobject obj,
@@ -35,8 +35,9 @@ static jfieldID ptr_field;
 } // namespace NativeInputListener
 
 JNIEXPORT void JNICALL
-Java_org_xcsoar_NativeInputListener_dataReceived(JNIEnv *env, jobject obj,
-                                                 jbyteArray data, jint length)
+Java_org_xcsoar_NativeInputListener_directDataReceived(JNIEnv *env, jobject obj,
+                                                       jobject buffer,
+                                                       jint length)
 {
   jlong ptr = env->GetLongField(obj, NativeInputListener::ptr_field);
   if (ptr == 0)
@@ -45,9 +46,13 @@ Java_org_xcsoar_NativeInputListener_dataReceived(JNIEnv *env, jobject obj,
 
   DataHandler &handler = *(DataHandler *)(void *)ptr;
 
-  jbyte *data2 = env->GetByteArrayElements(data, nullptr);
-  handler.DataReceived(data2, length);
-  env->ReleaseByteArrayElements(data, data2, 0);
+  /* the buffer is a direct ByteBuffer, therefore the data can be
+     read in place without copying it */
+  const void *data = env->GetDirectBufferAddress(buffer);
+  if (data == nullptr)
+    return;
+
+  handler.DataReceived(data, length);
 }
 
 void
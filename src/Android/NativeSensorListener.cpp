@@ -32,6 +32,9 @@ Copyright_License {
 #include "time/SystemClock.hxx"
 #include "org_xcsoar_NativeSensorListener.h"
 
+#include <algorithm>
+#include <array>
+
 namespace NativeSensorListener {
 static Java::TrivialClass cls;
 static jmethodID ctor;
@@ -169,6 +172,36 @@ Java_org_xcsoar_NativeSensorListener_onBarometricPressureSensor(JNIEnv *env,
   listener.OnBarometricPressureSensor(pressure, sensor_noise_variance);
 }
 
+gcc_visibility_default
+JNIEXPORT void JNICALL
+Java_org_xcsoar_NativeSensorListener_onBarometricPressureSensorBatch(JNIEnv *env,
+                                                                     jobject obj,
+                                                                     jlongArray timestamps,
+                                                                     jfloatArray pressures,
+                                                                     jint n,
+                                                                     jfloat sensor_noise_variance)
+{
+  jlong ptr = env->GetLongField(obj, NativeSensorListener::ptr_field);
+  if (ptr == 0)
+    return;
+
+  /* copy the batch to the stack; the Java side never sends more than
+     this */
+  static constexpr std::size_t MAX_BATCH = 64;
+  std::array<int64_t, MAX_BATCH> timestamps2;
+  std::array<float, MAX_BATCH> pressures2;
+
+  const std::size_t size = std::min<std::size_t>(std::max<jint>(n, 0),
+                                                 MAX_BATCH);
+  env->GetLongArrayRegion(timestamps, 0, size, (jlong *)timestamps2.data());
+  env->GetFloatArrayRegion(pressures, 0, size, pressures2.data());
+
+  auto &listener = *(SensorListener *)ptr;
+  listener.OnBarometricPressureSensor({timestamps2.data(), size},
+                                      {pressures2.data(), size},
+                                      sensor_noise_variance);
+}
+
 gcc_visibility_default
 JNIEXPORT void JNICALL
 Java_org_xcsoar_NativeSensorListener_onPressureAltitudeSensor(JNIEnv *env,
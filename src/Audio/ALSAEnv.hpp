@@ -46,6 +46,9 @@ namespace ALSAEnv
    * buffer size, more frequent interrupts, and a higher risk for buffer
    * underruns.
    *
+   * A buffer time set with PCMPlayer::SetBufferTime() takes
+   * precedence.
+   *
    * @return Value of the environment variable "ALSA_LATENCY", parsed as
    * unsigned, or 10000 if not set, or unparsable. The unit is μs.
    */
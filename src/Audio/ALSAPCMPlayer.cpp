@@ -420,9 +420,15 @@ ALSAPCMPlayer::Start(PCMDataSource &_source)
 {
   const unsigned new_sample_rate = _source.GetSampleRate();
 
+  /* the setting overrides the environment variable */
+  const unsigned latency = buffer_time_ms > 0
+    ? buffer_time_ms * 1000
+    : ALSAEnv::GetALSALatency();
+
   if ((nullptr != source) &&
       alsa_handle &&
-      (source->GetSampleRate() == new_sample_rate)) {
+      (source->GetSampleRate() == new_sample_rate) &&
+      latency == opened_latency) {
     /* just change the source / resume playback */
     bool success = false;
     BlockingCall(event_loop, [this, &_source, &success]() {
@@ -484,14 +490,14 @@ ALSAPCMPlayer::Start(PCMDataSource &_source)
     assert(new_alsa_handle);
   }
 
-  unsigned latency = ALSAEnv::GetALSALatency();
-
   channels = 1;
   bool big_endian_source = _source.IsBigEndian();
   if (!SetParameters(*new_alsa_handle, new_sample_rate, big_endian_source,
                      latency, channels))
     return false;
 
+  opened_latency = latency;
+
   snd_pcm_sframes_t n_available = snd_pcm_avail(new_alsa_handle.get());
   if (n_available <= 0) {
     LogFormat("snd_pcm_avail(0x%p) failed: %ld - %s",
@@ -59,6 +59,12 @@ class ALSAPCMPlayer : public PCMPlayer {
   EventLoop &event_loop;
 
   snd_pcm_uframes_t buffer_size;
+
+  /**
+   * The latency [μs] the device was opened with.  Start() reopens it
+   * if a different one is requested.
+   */
+  unsigned opened_latency = 0;
   std::unique_ptr<int16_t[]> buffer;
 
   std::forward_list<SocketEvent> poll_events;
@@ -28,11 +28,13 @@ Copyright_License {
 #include "SLES/Init.hpp"
 #include "SLES/Engine.hpp"
 
+#include "thread/Statistics.hpp"
 #include "util/Macros.hpp"
 #include "LogFile.hpp"
 
 #include <SLES/OpenSLES_Android.h>
 
+#include <algorithm>
 #include <cassert>
 
 AndroidPCMPlayer::~AndroidPCMPlayer()
@@ -90,6 +92,14 @@ AndroidPCMPlayer::Start(PCMSynthesiser &_source)
     return false;
   }
 
+  /* the buffer time covers all enqueued buffers */
+  constexpr unsigned n_enqueued = ARRAY_SIZE(buffers) - 1;
+  buffer_size = buffer_time_ms > 0
+    ? std::clamp(_source.GetSampleRate() * buffer_time_ms
+                 / (1000 * n_enqueued),
+                 64u, unsigned(ARRAY_SIZE(buffers[0])))
+    : 1024;
+
   SLDataLocator_AndroidSimpleBufferQueue loc_bufq = {
     SL_DATALOCATOR_ANDROIDSIMPLEBUFFERQUEUE,
     ARRAY_SIZE(buffers) - 1,
@@ -233,11 +243,18 @@ AndroidPCMPlayer::Enqueue()
   std::lock_guard<Mutex> lock(mutex);
 
   if (!filled) {
+    /* the duration of audio callbacks is shown in the status
+       dialog */
+    static ThreadStatistics *const statistics =
+      ThreadStatistics::Register("Audio");
+    const ScopeThreadStatistics measure(statistics);
+
     filled = true;
-    source->Synthesise(buffers[next], ARRAY_SIZE(buffers[next]));
+    source->Synthesise(buffers[next], buffer_size);
   }
 
-  SLresult result = queue.Enqueue(buffers[next], sizeof(buffers[next]));
+  SLresult result = queue.Enqueue(buffers[next],
+                                  buffer_size * sizeof(buffers[next][0]));
   if (result == SL_RESULT_SUCCESS) {
     next = (next + 1) % ARRAY_SIZE(buffers);
     filled = false;
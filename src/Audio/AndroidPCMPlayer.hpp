@@ -68,9 +68,19 @@ class AndroidPCMPlayer : public PCMPlayer {
    * An array of buffers.  It's one more than being managed by
    * OpenSL/ES, and the one not enqueued (see attribute #next) will be
    * written to.
+   *
+   * The buffer size determines the latency: two enqueued buffers of
+   * 1024 samples (the default) are 46 ms at 44.1 kHz.  Only the
+   * first #buffer_size samples of each buffer are used.
    */
   int16_t buffers[3][4096];
 
+  /**
+   * The number of samples per buffer, calculated by Start() from the
+   * buffer time.
+   */
+  unsigned buffer_size;
+
   void Enqueue();
 
 public:
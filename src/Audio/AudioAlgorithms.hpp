@@ -35,6 +35,14 @@ Copyright_License {
 #include <cstddef>
 #include <cstdint>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define HAVE_AUDIO_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define HAVE_AUDIO_NEON
+#endif
+
 /* Algorithms for processing audio data */
 
 /**
@@ -69,6 +77,129 @@ inline int16_t Clip(int32_t value) {
           static_cast<int32_t>(std::numeric_limits<int16_t>::max())));
 }
 
+/**
+ * Convert a volume percentage to a 16.16 fixed-point factor for
+ * ApplyVolume().  Multiplying and shifting instead of dividing by 100
+ * allows the compiler to vectorise the sample loops below.
+ */
+constexpr int32_t VolumeToFactor(unsigned vol_percent) {
+  return static_cast<int32_t>((vol_percent << 16) / 100);
+}
+
+constexpr int32_t ApplyVolume(int32_t value, int32_t factor) {
+  return (value * factor) >> 16;
+}
+
+#if defined(HAVE_AUDIO_SSE2) || defined(HAVE_AUDIO_NEON)
+
+/**
+ * The volume and mixing loops below are compiled with -Os, which
+ * disables the auto-vectoriser, therefore they process eight samples
+ * at a time with SSE2 or NEON intrinsics.
+ *
+ * The 16.16 factor (at most 65536) does not fit in a signed 16 bit
+ * lane.  Its lower 16 bits are used as a signed multiplier instead,
+ * and if that is negative, the sample is added to the upper half of
+ * the product: (x * (f - 65536)) >> 16 == ((x * f) >> 16) - x.  The
+ * result is bit-identical to ApplyVolume().
+ */
+struct VectorVolume {
+  int16_t factor;
+  int16_t add_mask;
+
+  explicit constexpr VectorVolume(int32_t _factor)
+    :factor(static_cast<int16_t>(static_cast<uint16_t>(_factor))),
+     add_mask(static_cast<int16_t>(_factor >= 0x8000 ? -1 : 0)) {
+    assert(_factor >= 0 && _factor <= 0x10000);
+  }
+};
+
+#ifdef HAVE_AUDIO_SSE2
+
+inline __m128i ByteSwap16(__m128i x) {
+  return _mm_or_si128(_mm_slli_epi16(x, 8), _mm_srli_epi16(x, 8));
+}
+
+inline __m128i ApplyVolume(__m128i x, __m128i factor, __m128i add_mask) {
+  return _mm_add_epi16(_mm_mulhi_epi16(x, factor),
+                       _mm_and_si128(x, add_mask));
+}
+
+#else
+
+inline int16x8_t ByteSwap16(int16x8_t x) {
+  return vreinterpretq_s16_u8(vrev16q_u8(vreinterpretq_u8_s16(x)));
+}
+
+inline int16x8_t ApplyVolume(int16x8_t x, int16_t factor,
+                             int16x8_t add_mask) {
+  /* the upper halves of the 32 bit products */
+  const int16x8_t high =
+    vcombine_s16(vshrn_n_s32(vmull_n_s16(vget_low_s16(x), factor), 16),
+                 vshrn_n_s32(vmull_n_s16(vget_high_s16(x), factor), 16));
+  return vaddq_s16(high, vandq_s16(x, add_mask));
+}
+
+#endif
+
+/**
+ * Apply the volume to the samples of #src and store them in #dest,
+ * or (if #mix is true) add them to #dest with saturation.  #dest may
+ * be equal to #src.
+ *
+ * Only whole vectors are processed; the caller is responsible for
+ * the remaining samples.
+ *
+ * @param byte_swap swap the bytes of the source samples first
+ * @return the number of samples processed
+ */
+template<bool byte_swap, bool mix>
+inline size_t VectorApplyVolume(int16_t *dest, const int16_t *src,
+                                size_t num_frames, int32_t factor) {
+  const VectorVolume volume(factor);
+  const size_t n = num_frames & ~size_t(7);
+
+#ifdef HAVE_AUDIO_SSE2
+  const __m128i f = _mm_set1_epi16(volume.factor);
+  const __m128i add_mask = _mm_set1_epi16(volume.add_mask);
+
+  for (size_t i = 0; i < n; i += 8) {
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    if constexpr (byte_swap)
+      x = ByteSwap16(x);
+
+    x = ApplyVolume(x, f, add_mask);
+
+    __m128i *d = reinterpret_cast<__m128i *>(dest + i);
+    if constexpr (mix)
+      x = _mm_adds_epi16(_mm_loadu_si128(d), x);
+
+    _mm_storeu_si128(d, x);
+  }
+#else
+  const int16x8_t add_mask = vdupq_n_s16(volume.add_mask);
+
+  for (size_t i = 0; i < n; i += 8) {
+    int16x8_t x = vld1q_s16(src + i);
+    if constexpr (byte_swap)
+      x = ByteSwap16(x);
+
+    x = ApplyVolume(x, volume.factor, add_mask);
+
+    if constexpr (mix)
+      x = vqaddq_s16(vld1q_s16(dest + i), x);
+
+    vst1q_s16(dest + i, x);
+  }
+#endif
+
+  return n;
+}
+
+#define HAVE_AUDIO_SIMD
+
+#endif
+
 /**
  * Mix PCM data from a data source (which is read using the provided source
  * reader function) to a destination buffer (which already contains PCM data).
@@ -85,8 +216,10 @@ inline void MixPCM(int16_t *dest, size_t num_frames,
     return;
   }
 
+  const int32_t factor = VolumeToFactor(vol_percent);
   for (size_t i = 0; i < num_frames; ++i) {
-    dest[i] += Clip(src_reader(i) * static_cast<int32_t>(vol_percent) / 100);
+    dest[i] = Clip(static_cast<int32_t>(dest[i]) +
+                   ApplyVolume(src_reader(i), factor));
   }
 }
 
@@ -98,6 +231,16 @@ inline void MixPCM(int16_t *dest, size_t num_frames,
  */
 inline void MixPCM(int16_t *dest, const int16_t *src, size_t num_frames,
                    unsigned vol_percent) {
+#ifdef HAVE_AUDIO_SIMD
+  if (0 != vol_percent) {
+    const size_t n = VectorApplyVolume<false, true>(dest, src, num_frames,
+                                                    VolumeToFactor(vol_percent));
+    dest += n;
+    src += n;
+    num_frames -= n;
+  }
+#endif
+
   MixPCM(dest, num_frames, vol_percent, [&src](size_t i) { return src[i]; });
 }
 
@@ -113,9 +256,20 @@ inline void MixPCM(int16_t *dest, const int16_t *src, size_t num_frames,
  */
 inline void ByteSwapAndMixPCM(int16_t *dest, const int16_t *src,
                               size_t num_frames, unsigned vol_percent) {
+#ifdef HAVE_AUDIO_SIMD
+  if (0 != vol_percent) {
+    const size_t n = VectorApplyVolume<true, true>(dest, src, num_frames,
+                                                   VolumeToFactor(vol_percent));
+    dest += n;
+    src += n;
+    num_frames -= n;
+  }
+#endif
+
   MixPCM(dest, num_frames, vol_percent,
          [&src](size_t i) {
-           return static_cast<int32_t>(GenericByteSwap16(src[i]));
+           return static_cast<int32_t>(
+               static_cast<int16_t>(GenericByteSwap16(src[i])));
          });
 }
 
@@ -129,10 +283,16 @@ inline void LowerVolume(int16_t *buffer, size_t num_frames,
     return;
   }
 
-  for (size_t i = 0; i < num_frames; ++i) {
-    buffer[i] =
-        static_cast<int16_t>(
-            (static_cast<int32_t>(vol_percent) * buffer[i]) / 100);
+  if (100 == vol_percent)
+    return;
+
+  const int32_t factor = VolumeToFactor(vol_percent);
+  size_t i = 0;
+#ifdef HAVE_AUDIO_SIMD
+  i = VectorApplyVolume<false, false>(buffer, buffer, num_frames, factor);
+#endif
+  for (; i < num_frames; ++i) {
+    buffer[i] = static_cast<int16_t>(ApplyVolume(buffer[i], factor));
   }
 }
 
@@ -147,12 +307,16 @@ inline void ByteSwapAndLowerVolume(int16_t *buffer, size_t num_frames,
     return;
   }
 
-  for (size_t i = 0; i < num_frames; ++i) {
+  const int32_t factor = VolumeToFactor(vol_percent);
+  size_t i = 0;
+#ifdef HAVE_AUDIO_SIMD
+  i = VectorApplyVolume<true, false>(buffer, buffer, num_frames, factor);
+#endif
+  for (; i < num_frames; ++i) {
     buffer[i] =
         static_cast<int16_t>(
-            static_cast<int32_t>(vol_percent) *
-                static_cast<int32_t>(GenericByteSwap16(buffer[i])) /
-                100);
+            ApplyVolume(static_cast<int16_t>(GenericByteSwap16(buffer[i])),
+                        factor));
   }
 }
 
@@ -46,6 +46,12 @@ MixerPCMPlayer::Start(PCMDataSource &_source)
   }
 }
 
+void
+MixerPCMPlayer::SetBufferTime(unsigned ms) noexcept
+{
+  pcm_mixer->SetBufferTime(ms);
+}
+
 void
 MixerPCMPlayer::Stop()
 {
@@ -37,6 +37,12 @@ public:
   /* virtual methods from class PCMPlayer */
   bool Start(PCMDataSource &source) override;
   void Stop() override;
+
+  /**
+   * Applies to the player of the global #PCMMixer, i.e. to all
+   * sounds.
+   */
+  void SetBufferTime(unsigned ms) noexcept override;
 };
 
 #endif
@@ -62,6 +62,14 @@ public:
    */
   void Stop(PCMDataSource &source);
 
+  /**
+   * @see PCMPlayer::SetBufferTime()
+   */
+  void SetBufferTime(unsigned ms) noexcept {
+    const std::lock_guard<Mutex> protect(lock);
+    player->SetBufferTime(ms);
+  }
+
   void SetVolume(unsigned vol_percent) {
     mixer_data_source.SetVolume(vol_percent);
   }
@@ -27,6 +27,7 @@ Copyright_License {
 
 #include "PCMDataSource.hpp"
 #include "AudioAlgorithms.hpp"
+#include "thread/Statistics.hpp"
 
 #include <cassert>
 
@@ -37,6 +38,12 @@ PCMPlayer::FillPCMBuffer(int16_t *buffer, size_t n)
 {
   assert(n > 0);
   assert(nullptr != source);
+
+  /* the duration of audio callbacks is shown in the status dialog */
+  static ThreadStatistics *const statistics =
+    ThreadStatistics::Register("Audio");
+  const ScopeThreadStatistics measure(statistics);
+
   const size_t n_read = source->GetData(buffer, n);
   if (n_read > 0)
     UpmixMonoPCM(buffer, n_read, channels);
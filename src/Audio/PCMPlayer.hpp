@@ -69,9 +69,23 @@ public:
    */
   virtual void Stop() = 0;
 
+  /**
+   * Set the duration of the audio buffer, which determines the
+   * latency.  It takes effect the next time the audio device is
+   * opened by Start().
+   *
+   * @param ms the duration in milliseconds; 0 selects the default of
+   * the implementation
+   */
+  virtual void SetBufferTime(unsigned ms) noexcept {
+    buffer_time_ms = ms;
+  }
+
   virtual ~PCMPlayer() {}
 
 protected:
+  unsigned buffer_time_ms = 0;
+
 #ifdef PCMPLAYER_SYNTHESISER_ONLY
   PCMSynthesiser *source = nullptr;
 #else
@@ -27,6 +27,22 @@ Copyright_License {
 
 #include <cassert>
 
+/**
+ * Convert a buffer duration to a number of samples.  SDL wants a
+ * power of two, so round down to the next one.
+ */
+static Uint16
+BufferTimeToSamples(unsigned sample_rate, unsigned ms) noexcept
+{
+  const unsigned n = sample_rate * ms / 1000;
+
+  Uint16 samples = 64;
+  while (samples < 32768 && samples * 2u <= n)
+    samples *= 2;
+
+  return samples;
+}
+
 SDLPCMPlayer::~SDLPCMPlayer()
 {
   Stop();
@@ -53,7 +69,11 @@ SDLPCMPlayer::Start(PCMDataSource &_source)
   wanted.freq = static_cast<int>(new_sample_rate);
   wanted.format = AUDIO_S16SYS;
   wanted.channels = 1;
-  wanted.samples = 4096;
+  /* the default is 23 ms at 44.1 kHz; larger buffers make the vario
+     tone lag */
+  wanted.samples = buffer_time_ms > 0
+    ? BufferTimeToSamples(new_sample_rate, buffer_time_ms)
+    : 1024;
   wanted.callback = [](void *ud, Uint8 *stream, int len_bytes) {
     assert(nullptr != ud);
     assert(nullptr != stream);
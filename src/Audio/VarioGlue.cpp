@@ -26,11 +26,13 @@ Copyright_License {
 #include "PCMPlayerFactory.hpp"
 #include "VarioSynthesiser.hpp"
 #include "VarioSettings.hpp"
+#include "thread/Mutex.hxx"
 
 #ifdef ANDROID
 #include "SLES/Init.hpp"
 #endif
 
+#include <atomic>
 #include <cassert>
 
 static constexpr unsigned sample_rate = 44100;
@@ -42,6 +44,20 @@ static bool have_sles;
 static PCMPlayer *player;
 static VarioSynthesiser *synthesiser;
 
+static std::atomic_bool direct_feed_enabled;
+
+/**
+ * The device selected by SetDirectSource(), or -1.
+ */
+static std::atomic_int direct_source{-1};
+
+/**
+ * Protects #synthesiser against Deinitialise() while a device thread
+ * is inside FeedDirect(); the devices are closed only after the
+ * audio vario has been shut down.
+ */
+static Mutex direct_mutex;
+
 bool
 AudioVarioGlue::HaveAudioVario()
 {
@@ -71,8 +87,13 @@ AudioVarioGlue::Initialise()
 void
 AudioVarioGlue::Deinitialise()
 {
+  direct_feed_enabled = false;
+  direct_source = -1;
+
   delete player;
   player = nullptr;
+
+  const std::lock_guard<Mutex> lock(direct_mutex);
   delete synthesiser;
   synthesiser = nullptr;
 }
@@ -89,15 +110,13 @@ AudioVarioGlue::Configure(const VarioSoundSettings &settings)
   assert(synthesiser != nullptr);
 
   if (settings.enabled) {
-    synthesiser->SetVolume(settings.volume);
-    synthesiser->SetDeadBand(settings.dead_band_enabled);
-    synthesiser->SetFrequencies(settings.min_frequency, settings.zero_frequency,
-                                settings.max_frequency);
-    synthesiser->SetPeriods(settings.min_period_ms, settings.max_period_ms);
-    synthesiser->SetDeadBandRange(settings.min_dead, settings.max_dead);
+    synthesiser->Configure(settings);
+    player->SetBufferTime(settings.buffer_time_ms);
     player->Start(*synthesiser);
   } else
     player->Stop();
+
+  direct_feed_enabled = settings.enabled && settings.direct_feed;
 }
 
 void
@@ -127,3 +146,24 @@ AudioVarioGlue::NoValue()
 
   synthesiser->SetSilence();
 }
+
+bool
+AudioVarioGlue::SetDirectSource(int device)
+{
+  if (!direct_feed_enabled)
+    device = -1;
+
+  direct_source = device;
+  return device >= 0;
+}
+
+void
+AudioVarioGlue::FeedDirect(unsigned device, double vario)
+{
+  if (direct_source != int(device))
+    return;
+
+  const std::lock_guard<Mutex> lock(direct_mutex);
+  if (synthesiser != nullptr)
+    synthesiser->SetVario(vario);
+}
@@ -61,6 +61,28 @@ namespace AudioVarioGlue {
    */
   void NoValue();
 
+  /**
+   * Select the device whose vario values are passed directly to the
+   * synthesiser by FeedDirect().  Called by the #MergeThread after
+   * each merge.
+   *
+   * @param device the device index or -1 if no device provides a
+   * total energy vario
+   * @return true if the direct feed is active, i.e. the caller shall
+   * not call SetValue() with the merged value
+   */
+  bool SetDirectSource(int device);
+
+  /**
+   * A device has received a new total energy vario value.  If it is
+   * the device selected by SetDirectSource() and the direct feed is
+   * enabled, the value is passed to the synthesiser immediately.
+   * May be called from any thread.
+   *
+   * @param vario the new vario value [m/s]
+   */
+  void FeedDirect(unsigned device, double vario);
+
   /**
    * Is the audio vario platform available on this platform?
    * Must only be called after Initialise() has been called once before.
@@ -73,6 +95,8 @@ namespace AudioVarioGlue {
   static inline void Configure(const VarioSoundSettings &settings) {}
   static inline void SetValue(double vario) {}
   static inline void NoValue() {}
+  static inline bool SetDirectSource(int device) { return false; }
+  static inline void FeedDirect(unsigned device, double vario) {}
   static inline bool HaveAudioVario() { return false; }
 #endif
 };
@@ -29,6 +29,8 @@ VarioSoundSettings::SetDefaults()
   enabled = false;
   volume = 80;
   dead_band_enabled = false;
+  direct_feed = false;
+  buffer_time_ms = 0;
 
   min_frequency = 200;
   zero_frequency = 500;
@@ -32,6 +32,20 @@ struct VarioSoundSettings {
   uint8_t volume;
   bool dead_band_enabled;
 
+  /**
+   * Feed the total energy vario of the device driver directly to
+   * the synthesiser, instead of waiting for the #MergeThread?
+   */
+  bool direct_feed;
+
+  /**
+   * The duration of the audio output buffer [ms], see
+   * PCMPlayer::SetBufferTime().  Shorter buffers reduce the delay of
+   * the tone, but may cause dropouts.  0 selects the default of the
+   * audio system.
+   */
+  unsigned buffer_time_ms;
+
   unsigned min_frequency;
   unsigned zero_frequency;
   unsigned max_frequency;
@@ -44,15 +44,32 @@ VarioSynthesiser::VarioToFrequency(int ivario)
 }
 
 void
-VarioSynthesiser::SetVario(double vario)
+VarioSynthesiser::SetVario(double vario) noexcept
 {
-  const std::lock_guard<Mutex> lock(mutex);
+  next_vario.store(Clamp((int)(vario * 100), min_vario, max_vario),
+                   std::memory_order_release);
+}
 
-  const int ivario = Clamp((int)(vario * 100), min_vario, max_vario);
+void
+VarioSynthesiser::ApplySettings(const VarioSoundSettings &settings) noexcept
+{
+  SetVolume(settings.volume);
+  dead_band_enabled = settings.dead_band_enabled;
+  min_frequency = settings.min_frequency;
+  zero_frequency = settings.zero_frequency;
+  max_frequency = settings.max_frequency;
+  min_period_ms = settings.min_period_ms;
+  max_period_ms = settings.max_period_ms;
+  min_dead = (int)(settings.min_dead * 100);
+  max_dead = (int)(settings.max_dead * 100);
+}
 
+void
+VarioSynthesiser::ApplyVario(int ivario) noexcept
+{
   if (dead_band_enabled && InDeadBand(ivario)) {
     /* inside the "dead band" */
-    UnsafeSetSilence();
+    ApplySilence();
     return;
   }
 
@@ -87,14 +104,7 @@ VarioSynthesiser::SetVario(double vario)
 }
 
 void
-VarioSynthesiser::SetSilence()
-{
-  const std::lock_guard<Mutex> lock(mutex);
-  UnsafeSetSilence();
-}
-
-void
-VarioSynthesiser::UnsafeSetSilence()
+VarioSynthesiser::ApplySilence() noexcept
 {
   audible_count = 0;
   silence_count = 1;
@@ -112,7 +122,16 @@ VarioSynthesiser::UnsafeSetSilence()
 void
 VarioSynthesiser::Synthesise(int16_t *buffer, size_t n)
 {
-  const std::lock_guard<Mutex> lock(mutex);
+  if (VarioSoundSettings settings; next_settings.shift_latest(settings))
+    /* the new settings take effect with the next vario value */
+    ApplySettings(settings);
+
+  if (const int ivario = next_vario.exchange(NO_CHANGE,
+                                             std::memory_order_acquire);
+      ivario == SILENCE)
+    ApplySilence();
+  else if (ivario != NO_CHANGE)
+    ApplyVario(ivario);
 
   assert(audible_count > 0 || silence_count > 0);
 
@@ -25,18 +25,46 @@ Copyright_License {
 #define XCSOAR_AUDIO_VARIO_SYNTHESISER_HPP
 
 #include "ToneSynthesiser.hpp"
-#include "thread/Mutex.hxx"
+#include "VarioSettings.hpp"
+#include "util/LockFreeRingBuffer.hpp"
 #include "util/Compiler.h"
 
+#include <atomic>
+#include <climits>
+
 /**
  * This class generates vario sound.
  */
 class VarioSynthesiser final : public ToneSynthesiser {
   /**
-   * This mutex protects all atttributes below.  It is locked
-   * automatically by all public methods.
+   * Special value for #next_vario: SetVario() has not been called
+   * since the last Synthesise() call.
+   */
+  static constexpr int NO_CHANGE = INT_MIN;
+
+  /**
+   * Special value for #next_vario: SetSilence() was called.
+   */
+  static constexpr int SILENCE = INT_MIN + 1;
+
+  /**
+   * The vario value [cm/s] passed to the most recent SetVario() call
+   * which has not yet been seen by Synthesise(), or one of the
+   * special values #NO_CHANGE and #SILENCE.  This is the only
+   * attribute shared between the caller and the audio thread, so
+   * the audio thread never has to wait for a lock.
+   */
+  std::atomic<int> next_vario{NO_CHANGE};
+
+  /**
+   * Settings passed to Configure() which have not yet been applied
+   * by Synthesise().  Only the newest one matters, so the
+   * overwriting variant is used and Configure() never waits for the
+   * audio thread.
    */
-  Mutex mutex;
+  LockFreeOverwritingRingBuffer<VarioSoundSettings, 4> next_settings;
+
+  /* the following attributes are only used by Synthesise() */
 
   /**
    * The number of audible samples in each period.
@@ -100,58 +128,48 @@ public:
      min_dead(-30), max_dead(10) {}
 
   /**
-   * Update the vario value.  This calculates a new tone frequency and
-   * a new "silence" rate (for positive vario values).
+   * Update the vario value.  The new tone frequency and "silence"
+   * rate (for positive vario values) will be calculated by the next
+   * Synthesise() call.
    *
    * @param vario the current vario value [m/s]
    */
-  void SetVario(double vario);
+  void SetVario(double vario) noexcept;
 
   /**
    * Produce silence from now on.
    */
-  void SetSilence();
-
-  /**
-   * Enable/disable the dead band silence
-   */
-  void SetDeadBand(bool enabled) {
-    dead_band_enabled = enabled;
+  void SetSilence() noexcept {
+    next_vario.store(SILENCE, std::memory_order_release);
   }
 
   /**
-   * Set the base frequencies for minimum, zero and maximum lift
+   * Update the volume, frequencies, periods and dead band.  The
+   * settings will be applied by the next Synthesise() call; this
+   * method may be called while the audio thread is running.
    */
-  void SetFrequencies(unsigned min, unsigned zero, unsigned max) {
-    min_frequency = min;
-    zero_frequency = zero;
-    max_frequency = max;
+  void Configure(const VarioSoundSettings &settings) noexcept {
+    next_settings.push(settings);
   }
 
+  /* methods from class PCMSynthesiser */
+  virtual void Synthesise(int16_t *buffer, size_t n);
+
+private:
   /**
-   * Set the time periods for minimum and maximum lift
+   * Implementation of Configure().  Called by Synthesise().
    */
-  void SetPeriods(unsigned min, unsigned max) {
-    min_period_ms = min;
-    max_period_ms = max;
-  }
+  void ApplySettings(const VarioSoundSettings &settings) noexcept;
 
   /**
-   * Set the vario range of the "dead band" during which no sound is emitted
+   * Apply a new vario value [cm/s].  Called by Synthesise().
    */
-  void SetDeadBandRange(double min, double max) {
-    min_dead = (int)(min * 100);
-    max_dead = (int)(max * 100);
-  }
-
-  /* methods from class PCMSynthesiser */
-  virtual void Synthesise(int16_t *buffer, size_t n);
+  void ApplyVario(int ivario) noexcept;
 
-private:
   /**
-   * Same as SetSilence(), but doesn't lock the mutex.
+   * Implementation of SetSilence().  Called by Synthesise().
    */
-  void UnsafeSetSilence();
+  void ApplySilence() noexcept;
 
   /**
    * Convert a vario value to a tone frequency.
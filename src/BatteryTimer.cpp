@@ -22,6 +22,7 @@ Copyright_License {
 */
 
 #include "BatteryTimer.hpp"
+#include "PowerPolicy.hpp"
 #include "Hardware/Battery.hpp"
 #include "Hardware/PowerInfo.hpp"
 #include "Hardware/PowerGlobal.hpp"
@@ -32,7 +33,7 @@ Copyright_License {
 #include "Message.hpp"
 
 void
-BatteryTimer::Process()
+BatteryTimer::Process([[maybe_unused]] PowerPolicy &policy)
 {
 #ifdef HAVE_BATTERY
   // TODO feature: Trigger a GCE (Glide Computer Event) when
@@ -48,6 +49,8 @@ BatteryTimer::Process()
   const auto &battery = info.battery;
   const auto &external = info.external;
 
+  policy.Update(info);
+
   /* Battery status - simulator only - for safety of battery data
      note: Simulator only - more important to keep running in your plane
   */
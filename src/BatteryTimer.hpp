@@ -26,6 +26,8 @@ Copyright_License {
 
 #include "time/PeriodClock.hpp"
 
+class PowerPolicy;
+
 class BatteryTimer {
   // Battery status for SIMULATOR mode
   // 10% reminder, 5% exit, 5 minute reminders on warnings
@@ -37,7 +39,10 @@ class BatteryTimer {
   PeriodClock last_warning;
 
 public:
-  void Process();
+  /**
+   * @param policy receives the battery state
+   */
+  void Process(PowerPolicy &policy);
 };
 
 #endif
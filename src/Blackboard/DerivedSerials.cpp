@@ -0,0 +1,91 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "DerivedSerials.hpp"
+#include "NMEA/Derived.hpp"
+
+#include <cstring>
+#include <type_traits>
+
+/**
+ * Compare the object representation.  This is conservative: padding
+ * bytes may cause a change to be reported when there is none, but a
+ * real change will never be missed.
+ */
+template<typename T>
+[[gnu::pure]]
+static bool
+Differs(const T &a, const T &b) noexcept
+{
+  static_assert(std::is_trivially_copyable_v<T>);
+  return std::memcmp(&a, &b, sizeof(T)) != 0;
+}
+
+[[gnu::pure]]
+static bool
+WindDiffers(const DerivedInfo &a, const DerivedInfo &b) noexcept
+{
+  /* compare only the values, not the Validity time stamps, which get
+     refreshed even if the wind estimate didn't change */
+  return a.wind_available.IsValid() != b.wind_available.IsValid() ||
+    a.wind_source != b.wind_source ||
+    Differs(a.wind, b.wind) ||
+    a.estimated_wind_available.IsValid() != b.estimated_wind_available.IsValid() ||
+    Differs(a.estimated_wind, b.estimated_wind) ||
+    a.head_wind_available.IsValid() != b.head_wind_available.IsValid() ||
+    a.head_wind != b.head_wind;
+}
+
+void
+DerivedSerials::Update(const DerivedInfo &old_info,
+                       const DerivedInfo &new_info) noexcept
+{
+  if (WindDiffers(old_info, new_info))
+    Increment(Section::WIND);
+
+  if (Differs<CirclingInfo>(old_info, new_info))
+    Increment(Section::CIRCLING);
+
+  if (Differs(old_info.thermal_encounter_band,
+              new_info.thermal_encounter_band) ||
+      Differs(old_info.thermal_encounter_collection,
+              new_info.thermal_encounter_collection) ||
+      Differs(old_info.thermal_locator, new_info.thermal_locator))
+    Increment(Section::THERMAL_BAND);
+
+  if (Differs(old_info.task_stats, new_info.task_stats) ||
+      Differs(old_info.ordered_task_stats, new_info.ordered_task_stats))
+    Increment(Section::TASK_STATS);
+
+  if (Differs(old_info.common_stats, new_info.common_stats))
+    Increment(Section::COMMON_STATS);
+
+  if (Differs(old_info.contest_stats, new_info.contest_stats))
+    Increment(Section::CONTEST);
+
+  if (old_info.airspace_warnings.latest != new_info.airspace_warnings.latest)
+    Increment(Section::AIRSPACE_WARNINGS);
+
+  if (Differs<TeamInfo>(old_info, new_info))
+    Increment(Section::TEAM);
+}
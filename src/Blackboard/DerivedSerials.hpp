@@ -0,0 +1,110 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_DERIVED_SERIALS_HPP
+#define XCSOAR_DERIVED_SERIALS_HPP
+
+#include <array>
+#include <cstdint>
+
+struct DerivedInfo;
+
+/**
+ * Per-section change counters for a #DerivedInfo copy.  Each time a
+ * new #DerivedInfo is received, the sections which differ from the
+ * previous copy get their serial incremented.
+ *
+ * Consumers remember the serial they have last seen and skip their
+ * work if it has not changed.  Unlike a "dirty" flag, this works for
+ * any number of consumers and across skipped updates (e.g. in
+ * #RateLimitedBlackboardListener).  Serials start at 1, so a
+ * consumer may initialise its copy with 0 to force the first update.
+ */
+class DerivedSerials {
+public:
+  enum class Section : uint8_t {
+    /** DerivedInfo::wind and related attributes */
+    WIND,
+
+    /** the #CirclingInfo base class */
+    CIRCLING,
+
+    /** thermal encounter band/collection and thermal locator */
+    THERMAL_BAND,
+
+    /** DerivedInfo::task_stats and DerivedInfo::ordered_task_stats */
+    TASK_STATS,
+
+    /** DerivedInfo::common_stats */
+    COMMON_STATS,
+
+    /** DerivedInfo::contest_stats */
+    CONTEST,
+
+    /** DerivedInfo::airspace_warnings */
+    AIRSPACE_WARNINGS,
+
+    /** the #TeamInfo base class */
+    TEAM,
+
+    COUNT
+  };
+
+private:
+  std::array<uint32_t, unsigned(Section::COUNT)> serials;
+
+public:
+  DerivedSerials() noexcept {
+    serials.fill(1);
+  }
+
+  constexpr uint32_t Get(Section section) const noexcept {
+    return serials[unsigned(section)];
+  }
+
+  /**
+   * Check whether the given section has changed since the caller has
+   * last seen it, and update the caller's serial.
+   */
+  bool CheckModified(Section section, uint32_t &last) const noexcept {
+    const uint32_t current = Get(section);
+    if (current == last)
+      return false;
+
+    last = current;
+    return true;
+  }
+
+  void Increment(Section section) noexcept {
+    ++serials[unsigned(section)];
+  }
+
+  /**
+   * Compare the two #DerivedInfo objects section by section and
+   * increment the serial of each section which differs.
+   */
+  void Update(const DerivedInfo &old_info,
+              const DerivedInfo &new_info) noexcept;
+};
+
+#endif
@@ -218,9 +218,9 @@ DeviceBlackboard::ExpireWallClock()
 }
 
 void
-DeviceBlackboard::ScheduleMerge()
+DeviceBlackboard::ScheduleMerge(bool new_fix)
 {
-  TriggerMergeThread();
+  TriggerMergeThread(new_fix);
 }
 
 void
@@ -257,6 +257,20 @@ DeviceBlackboard::Merge()
   }
 }
 
+int
+DeviceBlackboard::FindTotalEnergyVarioDevice() const noexcept
+{
+  if (replay_data.alive || simulator_data.alive)
+    return -1;
+
+  for (unsigned i = 0; i < unsigned(NUMDEV); ++i)
+    if (per_device_data[i].alive &&
+        per_device_data[i].total_energy_vario_available)
+      return i;
+
+  return -1;
+}
+
 void
 DeviceBlackboard::SetBallast(double fraction, double overload,
                              OperationEnvironment &env)
@@ -29,9 +29,11 @@ Copyright_License {
 #include "Device/Simulator.hpp"
 #include "Device/Features.hpp"
 #include "thread/Mutex.hxx"
+#include "thread/LockStatistics.hpp"
 #include "time/WrapClock.hpp"
 
 #include <cassert>
+#include <chrono>
 
 class MultipleDevices;
 class AtmosphericPressure;
@@ -59,6 +61,13 @@ class DeviceBlackboard
    */
   NMEAInfo per_device_data[NUMDEV];
 
+  /**
+   * The time of the oldest update of each device which has not yet
+   * been merged, or a default-constructed value if there is none.
+   * The #MergeThread uses this to measure the update latency.
+   */
+  std::chrono::steady_clock::time_point update_time[NUMDEV];
+
   /**
    * Merged data from the physical devices.
    */
@@ -82,6 +91,25 @@ class DeviceBlackboard
 public:
   Mutex mutex;
 
+  /**
+   * How long #mutex was held, by each group of users.
+   */
+  struct {
+    /**
+     * Device drivers writing parsed data (#DeviceDataEditor).
+     */
+    LockStatistics device;
+
+    LockStatistics merge;
+
+    LockStatistics calculation;
+
+    /**
+     * The main thread copying the blackboards.
+     */
+    LockStatistics ui;
+  } lock_statistics;
+
 public:
   DeviceBlackboard();
 
@@ -109,6 +137,18 @@ public:
     return per_device_data[i];
   }
 
+  /**
+   * Remember that the data of the specified device has been
+   * modified, for the #MergeThread statistics.  Caller must lock the
+   * blackboard.
+   */
+  void DeviceUpdated(unsigned i) noexcept {
+    assert(i < NUMDEV);
+
+    if (update_time[i] == std::chrono::steady_clock::time_point{})
+      update_time[i] = std::chrono::steady_clock::now();
+  }
+
   /**
    * Return a copy of a device's data after updating its clock via
    * NMEAInfo::UpdateClock().  The method takes care for locking and
@@ -129,12 +169,16 @@ public:
   void LockSetDeviceDataScheuduleMerge(unsigned i, const NMEAInfo &src) noexcept {
     assert(i < NUMDEV);
 
+    bool new_fix;
+
     {
       const std::lock_guard<Mutex> lock(mutex);
+      new_fix = src.location_available.Modified(per_device_data[i].location_available);
       per_device_data[i] = src;
+      DeviceUpdated(i);
     }
 
-    ScheduleMerge();
+    ScheduleMerge(new_fix);
   }
 
   NMEAInfo &SetSimulatorState() { return simulator_data; }
@@ -143,6 +187,17 @@ public:
 public:
   const NMEAInfo &RealState() const { return real_data; }
 
+  /**
+   * Find the device whose total energy vario was picked by the last
+   * Merge() (the first one providing it, see NMEAInfo::Complement()).
+   * Caller must lock the blackboard.
+   *
+   * @return the device index or -1 if there is none, or if replay or
+   * simulator data override the devices
+   */
+  [[gnu::pure]]
+  int FindTotalEnergyVarioDevice() const noexcept;
+
   /**
    * Is the specified device a FLARM?
    *
@@ -190,8 +245,11 @@ public:
   /**
    * Trigger the MergeThread, which will call Merge().  Call this
    * after a modification.  The caller doesn't need to hold the lock.
+   *
+   * @param new_fix true if a new GPS fix has arrived, which will be
+   * merged without the usual delay
    */
-  void ScheduleMerge();
+  void ScheduleMerge(bool new_fix=false);
 
   /**
    * Copy real_data or simulator_data or replay_data to gps_info.
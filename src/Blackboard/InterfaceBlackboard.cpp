@@ -26,6 +26,7 @@ Copyright_License {
 void
 InterfaceBlackboard::ReadBlackboardCalculated(const DerivedInfo &derived_info) noexcept
 {
+  calculated_serials.Update(calculated_info, derived_info);
   calculated_info = derived_info;
 }
 
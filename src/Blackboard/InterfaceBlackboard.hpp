@@ -25,14 +25,25 @@ Copyright_License {
 #define INTERFACE_BLACKBOARD_H
 
 #include "LiveBlackboard.hpp"
+#include "DerivedSerials.hpp"
 #include "util/Compiler.h"
 
 class InterfaceBlackboard : public LiveBlackboard
 {
+  DerivedSerials calculated_serials;
+
 public:
   void ReadBlackboardBasic(const MoreData &nmea_info) noexcept;
   void ReadBlackboardCalculated(const DerivedInfo &derived_info) noexcept;
 
+  /**
+   * Per-section change counters of Calculated(), which allow
+   * consumers to skip work when the relevant part has not changed.
+   */
+  const DerivedSerials &GetCalculatedSerials() const noexcept {
+    return calculated_serials;
+  }
+
   gcc_const
   SystemSettings &SetSystemSettings() noexcept {
     return system_settings;
@@ -50,6 +61,7 @@ public:
 
   inline void ReadCommonStats(const CommonStats &common_stats) noexcept {
     calculated_info.common_stats = common_stats;
+    calculated_serials.Increment(DerivedSerials::Section::COMMON_STATS);
   }
 
   void ReadComputerSettings(const ComputerSettings &settings) noexcept;
@@ -23,10 +23,92 @@ Copyright_License {
 
 #include "CalculationThread.hpp"
 #include "Computer/GlideComputer.hpp"
+#include "Computer/ContestJob.hpp"
+#include "Computer/FlightSnapshot.hpp"
+#include "Job/Thread.hpp"
+#include "LogFile.hpp"
 #include "Protection.hpp"
 #include "Blackboard/DeviceBlackboard.hpp"
 #include "Components.hpp"
 #include "Hardware/CPU.hpp"
+#include "thread/TraceEvents.hpp"
+#include "thread/StandbyThread.hpp"
+
+#include <thread>
+
+class CalculationThread::ContestJobThread final : public JobThread {
+  CalculationThread &calculation_thread;
+
+  std::atomic<bool> complete{false};
+
+public:
+  ContestJobThread(OperationEnvironment &_env, Job &_job,
+                   CalculationThread &_calculation_thread)
+    :JobThread(_env, _job), calculation_thread(_calculation_thread) {}
+
+  /**
+   * Has the job finished since the last call?
+   */
+  bool CheckComplete() noexcept {
+    return complete.exchange(false, std::memory_order_relaxed);
+  }
+
+protected:
+  /* virtual methods from class JobThread */
+  void OnComplete() override {
+    complete.store(true, std::memory_order_relaxed);
+    calculation_thread.Trigger();
+  }
+};
+
+/**
+ * Writes #FlightSnapshot copies to a file.  Snapshots which arrive
+ * while the thread is still writing are coalesced: only the most
+ * recent one gets written afterwards.
+ */
+class CalculationThread::SnapshotSaveThread final : public StandbyThread {
+  const Path path;
+
+  /**
+   * The snapshot which has not been written yet.  Protected by
+   * StandbyThread::mutex.
+   */
+  std::unique_ptr<FlightSnapshot> snapshot;
+
+public:
+  explicit SnapshotSaveThread(Path _path) noexcept
+    :StandbyThread("SaveSnapshot"), path(_path) {}
+
+  ~SnapshotSaveThread() noexcept {
+    std::unique_lock<Mutex> lock(mutex);
+    WaitDone(lock);
+    Stop();
+  }
+
+  /**
+   * Throws if the thread could not be started.
+   */
+  void Save(std::unique_ptr<FlightSnapshot> &&_snapshot) {
+    const std::lock_guard<Mutex> lock(mutex);
+    snapshot = std::move(_snapshot);
+    Trigger();
+  }
+
+private:
+  /* virtual methods from class StandbyThread */
+  void Tick() noexcept override {
+    while (snapshot) {
+      const auto s = std::move(snapshot);
+
+      const ScopeUnlock unlock(mutex);
+      try {
+        s->Save(path);
+      } catch (...) {
+        LogError(std::current_exception(), "Failed to save flight snapshot");
+      }
+    }
+  }
+};
 
 /**
  * Constructor of the CalculationThread class
@@ -44,7 +126,43 @@ CalculationThread::CalculationThread(GlideComputer &_glide_computer)
                 std::chrono::milliseconds{100},
                 std::chrono::milliseconds{50}),
    force(false),
-   glide_computer(_glide_computer) {
+   glide_computer(_glide_computer),
+   contest_job(std::make_unique<ContestJob>(glide_computer.GetTraceComputer())),
+   contest_job_thread(std::make_unique<ContestJobThread>(contest_job_env,
+                                                         *contest_job,
+                                                         *this)) {
+  /* defer the route planner and the contest optimisation when a
+     cycle takes longer than this, to keep the latency of the
+     critical calculations low */
+  glide_computer.SetCycleBudget(std::chrono::milliseconds{200});
+
+  /* with more than one CPU core, move the route and contest searches
+     off the critical path */
+  if (std::thread::hardware_concurrency() > 1)
+    glide_computer.SetThreaded(true);
+}
+
+CalculationThread::~CalculationThread() noexcept
+{
+  if (contest_job_running) {
+    contest_job_thread->Cancel();
+
+    try {
+      contest_job_thread->Join();
+    } catch (...) {
+      LogError(std::current_exception());
+    }
+  }
+}
+
+void
+CalculationThread::Suspend() noexcept
+{
+  WorkerThread::Suspend();
+
+  /* the route thread does not get new work while this thread is
+     suspended; wait for it to finish the current one */
+  glide_computer.WaitBackgroundIdle();
 }
 
 void
@@ -61,6 +179,57 @@ CalculationThread::SetScreenDistanceMeters(double new_value)
   screen_distance_meters = new_value;
 }
 
+void
+CalculationThread::SetPowerSaving(bool new_value) noexcept
+{
+  std::lock_guard<Mutex> lock(mutex);
+  power_saving = new_value;
+}
+
+inline void
+CalculationThread::UpdateContestJob() noexcept
+{
+  if (contest_job_running) {
+    if (!contest_job_thread->CheckComplete())
+      return;
+
+    contest_job_running = false;
+
+    try {
+      contest_job_thread->Join();
+      glide_computer.SetContestJobResult(*contest_job);
+    } catch (...) {
+      LogError(std::current_exception(), "Contest search failed");
+    }
+  }
+
+  if (glide_computer.PrepareContestJob(*contest_job)) {
+    try {
+      contest_job_thread->Start();
+      contest_job_running = true;
+    } catch (...) {
+      LogError(std::current_exception(), "Failed to start contest search");
+    }
+  }
+}
+
+inline void
+CalculationThread::SaveSnapshot() noexcept
+try {
+  /* copy the state here; serialising and writing it is left to the
+     #SnapshotSaveThread */
+  auto snapshot = std::make_unique<FlightSnapshot>();
+  glide_computer.SaveSnapshot(*snapshot);
+
+  if (!snapshot_save_thread)
+    snapshot_save_thread =
+      std::make_unique<SnapshotSaveThread>(snapshot_path);
+
+  snapshot_save_thread->Save(std::move(snapshot));
+} catch (...) {
+  LogError(std::current_exception(), "Failed to save flight snapshot");
+}
+
 /**
  * Main loop of the CalculationThread
  */
@@ -75,7 +244,8 @@ CalculationThread::Tick() noexcept
 
   // update and transfer master info to glide computer
   {
-    std::lock_guard<Mutex> lock(device_blackboard->mutex);
+    const StatisticsLockGuard<Mutex> lock(device_blackboard->mutex,
+                                          device_blackboard->lock_statistics.calculation);
 
     gps_updated = device_blackboard->Basic().location_available.Modified(glide_computer.Basic().location_available);
 
@@ -88,6 +258,7 @@ CalculationThread::Tick() noexcept
     std::lock_guard<Mutex> lock(mutex);
     // Copy settings from ComputerSettingsBlackboard to GlideComputerBlackboard
     glide_computer.ReadComputerSettings(settings_computer);
+    glide_computer.SetPowerSaving(power_saving);
 
     force = this->force;
     if (force) {
@@ -100,15 +271,20 @@ CalculationThread::Tick() noexcept
 
   bool do_idle = false;
 
-  if (gps_updated || force)
+  if (gps_updated || force) {
     // perform idle call if time advanced and slow calculations need to be updated
+    const ScopeTraceEvent trace("ProcessGPS");
     do_idle |= glide_computer.ProcessGPS(force);
+  }
+
+  UpdateContestJob();
 
   // values changed, so copy them back now: ONLY CALCULATED INFO
   // should be changed in DoCalculations, so we only need to write
   // that one back (otherwise we may write over new data)
   {
-    std::lock_guard<Mutex> lock(device_blackboard->mutex);
+    const StatisticsLockGuard<Mutex> lock(device_blackboard->mutex,
+                                          device_blackboard->lock_statistics.calculation);
     device_blackboard->ReadBlackboard(glide_computer.Calculated());
   }
 
@@ -119,8 +295,14 @@ CalculationThread::Tick() noexcept
 
   if (do_idle) {
     // do slow calculations last, to minimise latency
+    const ScopeTraceEvent trace("ProcessIdle");
     glide_computer.ProcessIdle();
   }
+
+  if (snapshot_path != nullptr &&
+      glide_computer.Calculated().flight.flying &&
+      snapshot_clock.CheckUpdate(std::chrono::minutes(1)))
+    SaveSnapshot();
 }
 
 void
@@ -27,8 +27,14 @@ Copyright_License {
 #include "thread/WorkerThread.hpp"
 #include "thread/Mutex.hxx"
 #include "Computer/Settings.hpp"
+#include "Operation/Operation.hpp"
+#include "system/Path.hpp"
+#include "time/PeriodClock.hpp"
+
+#include <memory>
 
 class GlideComputer;
+class ContestJob;
 
 /**
  * The CalculationThread handles all expensive calculations
@@ -37,8 +43,8 @@ class GlideComputer;
  */
 class CalculationThread final : public WorkerThread {
   /**
-   * This mutex protects #settings_computer and
-   * #screen_distance_meters.
+   * This mutex protects #settings_computer,
+   * #screen_distance_meters and #power_saving.
    */
   Mutex mutex;
 
@@ -53,15 +59,65 @@ class CalculationThread final : public WorkerThread {
 
   double screen_distance_meters;
 
+  /**
+   * Defer expensive non-critical calculations to save power?
+   */
+  bool power_saving = false;
+
   /** Pointer to the GlideComputer that should be used */
   GlideComputer &glide_computer;
 
+  class ContestJobThread;
+
+  /**
+   * Runs the exhaustive contest search after landing, so it does not
+   * block the other calculations.
+   */
+  std::unique_ptr<ContestJob> contest_job;
+  QuietOperationEnvironment contest_job_env;
+  std::unique_ptr<ContestJobThread> contest_job_thread;
+
+  /**
+   * Is #contest_job_thread running?  Only accessed by this thread.
+   */
+  bool contest_job_running = false;
+
+  /**
+   * During the flight, a #FlightSnapshot is saved to this file
+   * periodically.  Null disables this.
+   */
+  AllocatedPath snapshot_path;
+
+  PeriodClock snapshot_clock;
+
+  class SnapshotSaveThread;
+
+  /**
+   * Writes the #FlightSnapshot copies, so this thread does not wait
+   * for the storage device.
+   */
+  std::unique_ptr<SnapshotSaveThread> snapshot_save_thread;
+
 public:
   CalculationThread(GlideComputer &_glide_computer);
+  ~CalculationThread() noexcept;
 
   void SetComputerSettings(const ComputerSettings &new_value);
   void SetScreenDistanceMeters(double new_value);
 
+  /**
+   * @see PowerPolicy
+   */
+  void SetPowerSaving(bool new_value) noexcept;
+
+  /**
+   * Enable saving a #FlightSnapshot periodically during the flight.
+   * Must be called before Start().
+   */
+  void SetSnapshotPath(AllocatedPath &&path) noexcept {
+    snapshot_path = std::move(path);
+  }
+
   /**
    * Throws on error.
    */
@@ -70,8 +126,22 @@ public:
     SetLowPriority();
   }
 
+  /**
+   * Suspend this thread and wait until its background searches are
+   * idle, so shared data (e.g. airspaces) may be modified.
+   */
+  void Suspend() noexcept;
+
   void ForceTrigger();
 
+private:
+  /**
+   * Collect the result of a finished #ContestJob, and start a new one
+   * if the #GlideComputer requests it.
+   */
+  void UpdateContestJob() noexcept;
+  void SaveSnapshot() noexcept;
+
 protected:
   void Tick() noexcept override;
 };
@@ -23,16 +23,15 @@ Copyright_License {
 
 #include "Client.hpp"
 #include "Serialiser.hpp"
-#include "Geo/Boost/RangeBox.hpp"
+#include "Geo/FAISphere.hpp"
 #include "Tracking/SkyLines/Protocol.hpp"
 #include "Tracking/SkyLines/Assemble.hpp"
 #include "Tracking/SkyLines/Import.hpp"
 #include "net/AddressInfo.hxx"
 #include "net/Resolver.hxx"
 
-#include <boost/geometry/algorithms/distance.hpp>
-#include <boost/geometry/algorithms/intersection.hpp>
-#include <boost/geometry/strategies/strategies.hpp>
+#include <algorithm>
+#include <cmath>
 
 CloudClientContainer::CloudClientContainer()
   :key_set(typename KeySet::bucket_traits(key_buckets, N_KEY_BUCKETS)) {}
@@ -69,8 +68,9 @@ CloudClientContainer::Make(SocketAddress address,
   if (result.second) {
     auto client = std::make_shared<CloudClient>(address, key, next_id++,
                                                 location, altitude);
-    Insert(*client);
-    return *client;
+    auto &result = *client;
+    Insert(std::move(client));
+    return result;
   } else {
     auto &client = *result.first;
     Refresh(client, address, location, altitude);
@@ -95,23 +95,70 @@ CloudClientContainer::Refresh(CloudClient &client,
 {
   Refresh(client, address);
 
-  if (location != client.location) {
-    auto ptr = client.shared_from_this();
-    rtree.remove(ptr);
-    client.location = location;
-    rtree.insert(ptr);
-  }
+  client.location = location;
+
+  if (GetGridCell(location) != client.grid_cell)
+    GridInsert(GridRemove(client));
 
   client.altitude = altitude;
 }
 
+unsigned
+CloudClientContainer::GetGridRow(Angle latitude) noexcept
+{
+  int row = (int)std::floor((latitude.Degrees() + 90) / GRID_CELL_DEGREES);
+  return std::clamp(row, 0, int(GRID_ROWS) - 1);
+}
+
+unsigned
+CloudClientContainer::GetGridColumn(Angle longitude) noexcept
+{
+  int column = (int)std::floor((longitude.AsDelta().Degrees() + 180)
+                               / GRID_CELL_DEGREES);
+  return std::clamp(column, 0, int(GRID_COLUMNS) - 1);
+}
+
 void
-CloudClientContainer::Insert(CloudClient &client)
+CloudClientContainer::GridInsert(CloudClientPtr &&client)
 {
-  list.push_front(client);
-  key_set.insert(client);
-  id_set.push_back(client);
-  rtree.insert(client.shared_from_this());
+  client->grid_cell = GetGridCell(client->location);
+
+  auto &cell = grid[client->grid_cell];
+  client->grid_index = cell.size();
+  cell.push_back(std::move(client));
+}
+
+CloudClientPtr
+CloudClientContainer::GridRemove(CloudClient &client) noexcept
+{
+  auto i = grid.find(client.grid_cell);
+  assert(i != grid.end());
+
+  auto &cell = i->second;
+  assert(client.grid_index < cell.size());
+  assert(cell[client.grid_index].get() == &client);
+
+  /* move the last item into the gap */
+  CloudClientPtr result = std::move(cell[client.grid_index]);
+  if (client.grid_index + 1 < cell.size()) {
+    cell[client.grid_index] = std::move(cell.back());
+    cell[client.grid_index]->grid_index = client.grid_index;
+  }
+
+  cell.pop_back();
+  if (cell.empty())
+    grid.erase(i);
+
+  return result;
+}
+
+void
+CloudClientContainer::Insert(CloudClientPtr client)
+{
+  list.push_front(*client);
+  key_set.insert(*client);
+  id_set.push_back(*client);
+  GridInsert(std::move(client));
 }
 
 void
@@ -120,7 +167,9 @@ CloudClientContainer::Remove(CloudClient &client)
   list.erase(list.iterator_to(client));
   key_set.erase(key_set.iterator_to(client));
   id_set.erase(id_set.iterator_to(client));
-  rtree.remove(client.shared_from_this());
+
+  /* this may free the client */
+  GridRemove(client);
 }
 
 void
@@ -130,11 +179,52 @@ CloudClientContainer::Expire(std::chrono::steady_clock::time_point before)
     Remove(list.back());
 }
 
-CloudClientContainer::query_iterator_range
-CloudClientContainer::QueryWithinRange(GeoPoint location, double range) const
+std::vector<CloudClient *>
+CloudClientContainer::QueryWithinRange(GeoPoint location,
+                                       double range) const noexcept
 {
-  const auto q = boost::geometry::index::intersects(BoostRangeBox(location, range));
-  return {rtree.qbegin(q), rtree.qend()};
+  /* the same bounding box as BoostRangeBox() */
+  const Angle latitude_delta = FAISphere::EarthDistanceToAngle(range);
+  const Angle north = std::min(location.latitude + latitude_delta,
+                               Angle::QuarterCircle());
+  const Angle south = std::max(location.latitude - latitude_delta,
+                               -Angle::QuarterCircle());
+
+  const auto c = std::max(location.latitude.cos(), 0.01);
+  const Angle longitude_delta = std::min(latitude_delta / c,
+                                         Angle::QuarterCircle());
+
+  const unsigned first_row = GetGridRow(south), last_row = GetGridRow(north);
+
+  /* the column range may wrap around the antimeridian, therefore
+     it is measured relative to the western column */
+  const unsigned west_column =
+    GetGridColumn(location.longitude - longitude_delta);
+  const unsigned east_column =
+    GetGridColumn(location.longitude + longitude_delta);
+  const unsigned n_columns =
+    (east_column + GRID_COLUMNS - west_column) % GRID_COLUMNS + 1;
+
+  std::vector<CloudClient *> result;
+
+  for (unsigned row = first_row; row <= last_row; ++row) {
+    for (unsigned i = 0; i < n_columns; ++i) {
+      const unsigned column = (west_column + i) % GRID_COLUMNS;
+      auto cell = grid.find(row * GRID_COLUMNS + column);
+      if (cell == grid.end())
+        continue;
+
+      for (const auto &client : cell->second) {
+        const GeoPoint &p = client->location;
+        if (p.latitude >= south && p.latitude <= north &&
+            (p.longitude - location.longitude).AsDelta().Absolute()
+            <= longitude_delta)
+          result.push_back(client.get());
+      }
+    }
+  }
+
+  return result;
 }
 
 inline Serialiser &
@@ -229,8 +319,7 @@ CloudClientContainer::Load(Deserialiser &s)
   next_id = s.Read32();
 
   while (s.Read8() != 0) {
-    auto client = std::make_shared<CloudClient>(CloudClient::Load(s));
-    Insert(*client);
+    Insert(std::make_shared<CloudClient>(CloudClient::Load(s)));
   }
 
   s.Read8();
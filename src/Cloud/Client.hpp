@@ -24,17 +24,19 @@ Copyright_License {
 #ifndef XCSOAR_CLOUD_CLIENT_HPP
 #define XCSOAR_CLOUD_CLIENT_HPP
 
-#include "Geo/Boost/GeoPoint.hpp"
+#include "Geo/GeoPoint.hpp"
 #include "net/AllocatedSocketAddress.hxx"
 
 #include <boost/intrusive/list.hpp>
 #include <boost/intrusive/set.hpp>
 #include <boost/intrusive/unordered_set.hpp>
-#include <boost/geometry/index/rtree.hpp>
-#include <boost/range/iterator_range_core.hpp>
 
 #include <memory>
 #include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
 
 class Serialiser;
 class Deserialiser;
@@ -43,8 +45,7 @@ class Deserialiser;
  * A client which has submitted data to us recently.
  */
 struct CloudClient
-  : std::enable_shared_from_this<CloudClient>,
-    boost::intrusive::list_base_hook<boost::intrusive::link_mode<boost::intrusive::normal_link>>,
+  : boost::intrusive::list_base_hook<boost::intrusive::link_mode<boost::intrusive::normal_link>>,
     boost::intrusive::set_base_hook<boost::intrusive::link_mode<boost::intrusive::normal_link>>,
     boost::intrusive::unordered_set_base_hook<boost::intrusive::link_mode<boost::intrusive::normal_link>>
 {
@@ -91,11 +92,79 @@ struct CloudClient
    */
   GeoPoint location;
 
+  /**
+   * The CloudClientContainer grid cell containing #location, and this
+   * client's index in that cell's vector.
+   */
+  uint32_t grid_cell, grid_index;
+
   /**
    * Last known altitude.
    */
   int altitude;
 
+  /**
+   * The client understands #TRAFFIC_DELTA_RESPONSE (see
+   * #SkyLinesTracking::TrafficRequestPacket::FLAG_DELTA).
+   */
+  bool traffic_delta = false;
+
+  /**
+   * The most recent traffic location sent to a #traffic_delta
+   * client, quantised to about one metre, for omitting traffic which
+   * has not changed.
+   */
+  struct SentTraffic {
+    int32_t latitude, longitude;
+    int altitude;
+
+    static SentTraffic From(const CloudClient &client) noexcept {
+      return {
+        int32_t(std::lround(client.location.latitude.Degrees() * 100000)),
+        int32_t(std::lround(client.location.longitude.Degrees() * 100000)),
+        client.altitude,
+      };
+    }
+
+    constexpr bool operator==(const SentTraffic &other) const noexcept {
+      return latitude == other.latitude && longitude == other.longitude &&
+        altitude == other.altitude;
+    }
+  };
+
+  /**
+   * Maps the public id of other clients to what this
+   * #traffic_delta client has most recently received about them.
+   * This is not persisted.
+   */
+  std::unordered_map<unsigned, SentTraffic> sent_traffic;
+
+  /**
+   * When was #sent_traffic last cleared?  It is cleared periodically
+   * so the client gets a full update even if datagrams were lost.
+   */
+  std::chrono::steady_clock::time_point sent_traffic_reset =
+    std::chrono::steady_clock::time_point::min();
+
+  /**
+   * Check whether the given traffic has changed since it was last
+   * sent to this client, and remember it as sent.
+   *
+   * @return true if the traffic needs to be sent
+   */
+  bool UpdateSentTraffic(const CloudClient &traffic) noexcept {
+    const auto value = SentTraffic::From(traffic);
+    auto [i, inserted] = sent_traffic.try_emplace(traffic.id, value);
+    if (inserted)
+      return true;
+
+    if (i->second == value)
+      return false;
+
+    i->second = value;
+    return true;
+  }
+
   struct KeyHash {
     constexpr std::size_t operator()(uint64_t key) const {
       return key;
@@ -150,22 +219,7 @@ struct CloudClient
 
 using CloudClientPtr = std::shared_ptr<CloudClient>;
 
-/**
- * Helper for boost::geometry::index::rtree.
- */
-struct CloudClientIndexable {
-  typedef GeoPoint result_type;
-
-  [[gnu::pure]]
-  result_type operator()(const CloudClientPtr &client) const {
-    return client->location;
-  }
-};
-
 class CloudClientContainer {
-  typedef boost::geometry::index::rtree<CloudClientPtr, boost::geometry::index::rstar<16>,
-                                        CloudClientIndexable> Tree;
-
   typedef boost::intrusive::list<CloudClient,
                                  boost::intrusive::constant_time_size<false>> List;
 
@@ -179,10 +233,22 @@ class CloudClientContainer {
                                 boost::intrusive::constant_time_size<false>> IdSet;
 
   /**
-   * A geospatial container of all clients, for fast geographic
-   * lookups.
+   * The size of a #grid cell in degrees.  A query with the traffic
+   * range (50 km) scans a few dozen cells.
+   */
+  static constexpr double GRID_CELL_DEGREES = 0.25;
+
+  static constexpr unsigned GRID_ROWS = 180 / GRID_CELL_DEGREES;
+  static constexpr unsigned GRID_COLUMNS = 360 / GRID_CELL_DEGREES;
+
+  /**
+   * A geospatial index of all clients, for fast geographic lookups.
+   * It is a uniform grid of latitude/longitude cells (see
+   * GetGridCell()), i.e. a moving client costs nothing until it
+   * crosses a cell border, and then only two vector updates.  Only
+   * non-empty cells are stored.  This container owns the clients.
    */
-  Tree rtree;
+  std::unordered_map<uint32_t, std::vector<CloudClientPtr>> grid;
 
   /**
    * A linked list of clients, sorted by last fix, with fresh items at
@@ -250,7 +316,7 @@ public:
                SocketAddress address,
                const GeoPoint &location, int altitude);
 
-  void Insert(CloudClient &client);
+  void Insert(CloudClientPtr client);
 
   /**
    * Remove a #CloudClient and its data.  Be careful - the given reference
@@ -260,14 +326,37 @@ public:
 
   void Expire(std::chrono::steady_clock::time_point before);
 
-  typedef Tree::const_query_iterator query_iterator;
-  typedef boost::iterator_range<query_iterator> query_iterator_range;
-
+  /**
+   * Query all clients inside the bounding box of the given circle.
+   */
   [[gnu::pure]]
-  query_iterator_range QueryWithinRange(GeoPoint location, double range) const;
+  std::vector<CloudClient *> QueryWithinRange(GeoPoint location,
+                                              double range) const noexcept;
 
   void Save(Serialiser &s) const;
   void Load(Deserialiser &s);
+
+private:
+  [[gnu::const]]
+  static unsigned GetGridRow(Angle latitude) noexcept;
+
+  [[gnu::const]]
+  static unsigned GetGridColumn(Angle longitude) noexcept;
+
+  [[gnu::const]]
+  static uint32_t GetGridCell(GeoPoint location) noexcept {
+    return GetGridRow(location.latitude) * GRID_COLUMNS +
+      GetGridColumn(location.longitude);
+  }
+
+  void GridInsert(CloudClientPtr &&client);
+
+  /**
+   * Remove the client from its #grid cell.
+   *
+   * @return the pointer which was owned by the cell
+   */
+  CloudClientPtr GridRemove(CloudClient &client) noexcept;
 };
 
 #endif
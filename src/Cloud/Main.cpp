@@ -39,9 +39,15 @@ Copyright_License {
 #include "util/Compiler.h"
 #include "util/ScopeExit.hxx"
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <cassert>
 #include <iostream>
 #include <iomanip>
+#include <optional>
+#include <string>
+#include <thread>
 
 // TODO: review these settings
 static constexpr double TRAFFIC_RANGE = 50000;
@@ -50,8 +56,19 @@ static constexpr double THERMAL_RANGE = 50000;
 static constexpr std::chrono::steady_clock::duration MAX_TRAFFIC_AGE = std::chrono::minutes(15);
 static constexpr std::chrono::steady_clock::duration MAX_THERMAL_AGE = std::chrono::minutes(30);
 
+/**
+ * The maximum number of hotspots in one thermal response.
+ */
+static constexpr std::size_t MAX_THERMAL_RESPONSE = 256;
+
 static constexpr std::chrono::steady_clock::duration REQUEST_EXPIRY = std::chrono::minutes(5);
 
+/**
+ * How often is the full traffic list sent to a client which has
+ * requested delta responses?
+ */
+static constexpr std::chrono::steady_clock::duration TRAFFIC_DELTA_REFRESH = std::chrono::minutes(5);
+
 using std::cout;
 using std::cerr;
 using std::endl;
@@ -61,7 +78,28 @@ class CloudServer final
 {
   const AllocatedPath db_path;
 
-  CoarseTimerEvent save_timer, expire_timer;
+  CoarseTimerEvent save_timer, expire_timer, flush_timer;
+
+  /**
+   * Writes the serialised database to #db_path, so the event loop
+   * does not wait for the disk.
+   */
+  std::thread save_thread;
+
+  /**
+   * Is #save_thread still writing?
+   */
+  std::atomic_bool saving{false};
+
+#ifndef _WIN32
+  /**
+   * The socket statistics at the time of the previous
+   * DumpStatistics() call, for calculating rates.
+   */
+  Statistics last_statistics;
+  std::chrono::steady_clock::time_point last_statistics_time =
+    std::chrono::steady_clock::now();
+#endif
 
 public:
   CloudServer(AllocatedPath &&_db_path, EventLoop &event_loop,
@@ -69,7 +107,8 @@ public:
     :SkyLinesTracking::Server(event_loop, bind_address),
      db_path(std::move(_db_path)),
      save_timer(event_loop, BIND_THIS_METHOD(OnSaveTimer)),
-     expire_timer(event_loop, BIND_THIS_METHOD(OnExpireTimer))
+     expire_timer(event_loop, BIND_THIS_METHOD(OnExpireTimer)),
+     flush_timer(event_loop, BIND_THIS_METHOD(OnFlushTimer))
   {
 #ifndef _WIN32
     SignalMonitorRegister(SIGINT, BIND_THIS_METHOD(OnQuitSignal));
@@ -83,8 +122,29 @@ public:
     ScheduleSave();
   }
 
+  ~CloudServer() noexcept {
+    WaitSave();
+  }
+
   void Load();
-  void Save();
+
+  /**
+   * Serialise all data into a memory buffer and write it to the
+   * database file in #save_thread.  If the previous save is still
+   * being written, this one is skipped.
+   *
+   * @param wait_previous wait for the previous save to finish
+   * instead of skipping this one (for the final save at exit)
+   */
+  void Save(bool wait_previous=false);
+
+  /**
+   * Wait for the #save_thread to finish.
+   */
+  void WaitSave() noexcept {
+    if (save_thread.joinable())
+      save_thread.join();
+  }
 
 private:
   void OnSaveTimer() noexcept {
@@ -97,7 +157,9 @@ private:
   }
 
   void OnExpireTimer() noexcept {
-    clients.Expire(GetEventLoop().SteadyNow() - std::chrono::minutes(10));
+    const auto now = GetEventLoop().SteadyNow();
+    clients.Expire(now - std::chrono::minutes(10));
+    thermals.ExpireHotspots(now - MAX_THERMAL_AGE);
     if (!clients.empty())
       ScheduleExpire();
   }
@@ -106,14 +168,33 @@ private:
     expire_timer.Schedule(std::chrono::minutes(5));
   }
 
+  void OnFlushTimer() noexcept {
+    cout.flush();
+  }
+
+  /**
+   * Flush the log lines to stdout soon.  Flushing after each line
+   * (with std::endl) would cost one system call per packet.
+   */
+  void ScheduleFlush() noexcept {
+    if (!flush_timer.IsPending())
+      flush_timer.Schedule(std::chrono::seconds(1));
+  }
+
 protected:
   /* virtual methods from class SkyLinesTracking::Server */
   void OnFix(const Client &client,
              std::chrono::milliseconds time_of_day,
              const ::GeoPoint &location, int altitude) override;
 
+  /**
+   * Send one client's location to another client which is
+   * interested in traffic.
+   */
+  void PushTraffic(CloudClient &dest, const CloudClient &traffic) noexcept;
+
   void OnTrafficRequest(const Client &client,
-                        bool near) override;
+                        bool near, bool delta) override;
 
   void OnWaveSubmit(const Client &client,
                     std::chrono::milliseconds time_of_day,
@@ -155,7 +236,10 @@ protected:
 
   void OnDumpSignal() noexcept {
     DumpClients();
+    DumpStatistics();
   }
+
+  void DumpStatistics() noexcept;
 #endif
 };
 
@@ -177,8 +261,8 @@ CloudServer::OnFix(const Client &c,
          << std::hex << client->key << std::dec << '\t'
          << client->id << '\t'
          << client->location << '\t'
-         << client->altitude << 'm'
-         << endl;
+         << client->altitude << "m\n";
+    ScheduleFlush();
 
     if (was_empty)
       ScheduleExpire();
@@ -201,15 +285,35 @@ CloudServer::OnFix(const Client &c,
       /* not interested (anymore) */
       continue;
 
-    TrafficResponseSender s(*this, i->address, i->key);
-    s.Add(client->id, 0, //TODO: time?
-          client->location, client->altitude);
-    s.Flush();
+    PushTraffic(*i, *client);
   }
 }
 
 void
-CloudServer::OnTrafficRequest(const Client &c, bool near)
+CloudServer::PushTraffic(CloudClient &dest,
+                         const CloudClient &traffic) noexcept
+{
+  if (dest.traffic_delta) {
+    if (!dest.UpdateSentTraffic(traffic))
+      /* the client knows this already */
+      return;
+
+    TrafficDeltaResponseSender s(*this, dest.address, dest.key,
+                                 dest.location);
+    if (s.Add(traffic.id, traffic.location, traffic.altitude)) {
+      s.Flush();
+      return;
+    }
+  }
+
+  TrafficResponseSender s(*this, dest.address, dest.key);
+  s.Add(traffic.id, 0, //TODO: time?
+        traffic.location, traffic.altitude);
+  s.Flush();
+}
+
+void
+CloudServer::OnTrafficRequest(const Client &c, bool near, bool delta)
 {
   if (!near)
     /* "near" is the only selection flag we know */
@@ -224,28 +328,57 @@ CloudServer::OnTrafficRequest(const Client &c, bool near)
   const auto now = std::chrono::steady_clock::now();
 
   client->wants_traffic = now + REQUEST_EXPIRY;
+  client->traffic_delta = delta;
+
+  /* forget what was sent to this client from time to time (and
+     always for clients which don't support deltas), to repair lost
+     datagrams and to drop traffic which is out of range now */
+  decltype(client->sent_traffic) old_sent;
+  if (delta && now < client->sent_traffic_reset + TRAFFIC_DELTA_REFRESH)
+    old_sent = std::move(client->sent_traffic);
+  else
+    client->sent_traffic_reset = now;
+  client->sent_traffic.clear();
 
   const auto min_stamp = now - MAX_TRAFFIC_AGE;
 
   TrafficResponseSender s(*this, c.address, c.key);
+  std::optional<TrafficDeltaResponseSender> ds;
+  if (delta)
+    ds.emplace(*this, c.address, c.key, client->location);
 
   unsigned n = 0;
   for (const auto &traffic : clients.QueryWithinRange(client->location,
                                                       TRAFFIC_RANGE)) {
-    if (traffic.get() == client)
+    if (traffic == client)
       continue;
 
     if (traffic->stamp < min_stamp)
       /* don't send stale traffic, it's probably not there anymore */
       continue;
 
-    s.Add(traffic->id, 0, //TODO: time?
-          traffic->location, traffic->altitude);
+    if (delta) {
+      const auto value = CloudClient::SentTraffic::From(*traffic);
+      client->sent_traffic.emplace(traffic->id, value);
+
+      if (auto i = old_sent.find(traffic->id);
+          i != old_sent.end() && i->second == value)
+        /* unchanged since the last response or push */
+        continue;
+
+      if (!ds->Add(traffic->id, traffic->location, traffic->altitude))
+        s.Add(traffic->id, 0, //TODO: time?
+              traffic->location, traffic->altitude);
+    } else
+      s.Add(traffic->id, 0, //TODO: time?
+            traffic->location, traffic->altitude);
 
     if (++n > 64)
       break;
   }
 
+  if (ds)
+    ds->Flush();
   s.Flush();
 }
 
@@ -270,8 +403,8 @@ CloudServer::OnWaveSubmit(const Client &c,
        << a << '\t'
        << b << '\t'
        << bottom_altitude << '-' << top_altitude << "m\t"
-       << lift << "m/s"
-       << endl;
+       << lift << "m/s\n";
+  ScheduleFlush();
 }
 
 void
@@ -295,8 +428,8 @@ CloudServer::OnThermalSubmit(const Client &c,
        << client->id << '\t'
        << top_location << '\t'
        << bottom_altitude << '-' << top_altitude << "m\t"
-       << lift << "m/s"
-       << endl;
+       << lift << "m/s\n";
+  ScheduleFlush();
 
   const auto &thermal =
     thermals.Make(c.key,
@@ -304,7 +437,11 @@ CloudServer::OnThermalSubmit(const Client &c,
                   AGeoPoint(top_location, top_altitude),
                   lift);
 
-  /* send this new thermal to all interested clients immediately */
+  /* send the updated hotspot to all interested clients
+     immediately */
+  const auto *hotspot = thermals.FindHotspot(thermal);
+  assert(hotspot != nullptr);
+
   const auto now = std::chrono::steady_clock::now();
   for (const auto &i : clients.QueryWithinRange(bottom_location,
                                                 THERMAL_RANGE)) {
@@ -318,7 +455,7 @@ CloudServer::OnThermalSubmit(const Client &c,
       continue;
 
     ThermalResponseSender s(*this, i->address, i->key);
-    s.Add(thermal.Pack());
+    s.Add(hotspot->Pack());
     s.Flush();
   }
 }
@@ -338,29 +475,78 @@ CloudServer::OnThermalRequest(const Client &c)
 
   const auto min_time = now - MAX_THERMAL_AGE;
 
+  auto hotspots = thermals.QueryHotspots(client->location, THERMAL_RANGE);
+  hotspots.erase(std::remove_if(hotspots.begin(), hotspots.end(),
+                                [&c, min_time](const CloudHotspot *h){
+                                  /* ignore this client's own
+                                     submissions - he knows them
+                                     already; and don't send old
+                                     thermals, they're useless */
+                                  return h->client_key == c.key ||
+                                    h->time < min_time;
+                                }),
+                 hotspots.end());
+
+  if (hotspots.size() > MAX_THERMAL_RESPONSE)
+    /* send only the strongest hotspots */
+    std::nth_element(hotspots.begin(),
+                     std::next(hotspots.begin(), MAX_THERMAL_RESPONSE),
+                     hotspots.end(),
+                     [now](const CloudHotspot *a, const CloudHotspot *b){
+                       return a->GetWeight(now) > b->GetWeight(now);
+                     });
+
   ThermalResponseSender s(*this, c.address, c.key);
 
   unsigned n = 0;
-  for (const auto &thermal : thermals.QueryWithinRange(client->location,
-                                                       THERMAL_RANGE)) {
-    if (thermal->client_key == c.key)
-      /* ignore this client's own submissions - he knows them
-         already */
-      continue;
-
-    if (thermal->time < min_time)
-      /* don't send old thermals, they're useless */
-      continue;
-
-    s.Add(thermal->Pack());
+  for (const auto *hotspot : hotspots) {
+    s.Add(hotspot->Pack());
 
-    if (++n > 256)
+    if (++n >= MAX_THERMAL_RESPONSE)
       break;
   }
 
   s.Flush();
 }
 
+#ifndef _WIN32
+
+static double
+PerCall(uint64_t datagrams, uint64_t calls) noexcept
+{
+  return calls > 0 ? double(datagrams) / calls : 0.;
+}
+
+void
+CloudServer::DumpStatistics() noexcept
+{
+  const auto &statistics = GetStatistics();
+  const auto now = std::chrono::steady_clock::now();
+  const double seconds =
+    std::chrono::duration<double>(now - last_statistics_time).count();
+
+  const auto received = statistics.received_datagrams -
+    last_statistics.received_datagrams;
+  const auto sent = statistics.sent_datagrams -
+    last_statistics.sent_datagrams;
+
+  cout << "STATS\t"
+       << "received " << statistics.received_datagrams
+       << " (" << (seconds > 0 ? received / seconds : 0.) << "/s, "
+       << PerCall(statistics.received_datagrams, statistics.receive_calls)
+       << " per call)\t"
+       << "sent " << statistics.sent_datagrams
+       << " (" << (seconds > 0 ? sent / seconds : 0.) << "/s, "
+       << PerCall(statistics.sent_datagrams, statistics.send_calls)
+       << " per call)"
+       << endl;
+
+  last_statistics = statistics;
+  last_statistics_time = now;
+}
+
+#endif
+
 void
 CloudServer::Load()
 {
@@ -369,20 +555,71 @@ CloudServer::Load()
   CloudData::Load(s);
 }
 
+/**
+ * An #OutputStream which collects all data in a std::string.
+ */
+class StringOutputStream final : public OutputStream {
+  std::string value;
+
+public:
+  std::string &&Steal() noexcept {
+    return std::move(value);
+  }
+
+  /* virtual methods from class OutputStream */
+  void Write(const void *data, size_t size) override {
+    value.append((const char *)data, size);
+  }
+};
+
+static void
+WriteFile(Path path, const std::string &data)
+{
+  FileOutputStream fos(path);
+  fos.Write(data.data(), data.size());
+  fos.Commit();
+}
+
 void
-CloudServer::Save()
+CloudServer::Save(bool wait_previous)
 {
-  cout << "Saving data to " << db_path.c_str() << endl;
+  if (saving && !wait_previous) {
+    cout << "Previous save still running, skipping" << endl;
+    return;
+  }
+
+  WaitSave();
 
-  FileOutputStream fos(db_path);
+  /* serialising into memory is fast; the slow part (the disk) is
+     left to the save thread */
+  StringOutputStream sos;
 
   {
-    Serialiser s(fos);
+    Serialiser s(sos);
     CloudData::Save(s);
     s.Flush();
   }
 
-  fos.Commit();
+  cout << "Saving data to " << db_path.c_str() << endl;
+
+  saving = true;
+
+  try {
+    save_thread = std::thread([this, data = sos.Steal()]{
+      try {
+        WriteFile(db_path, data);
+      } catch (...) {
+        cerr << "Failed to save database: "
+             << GetFullMessage(std::current_exception()) << endl;
+      }
+
+      saving = false;
+    });
+  } catch (...) {
+    saving = false;
+    cerr << "Failed to start save thread: "
+         << GetFullMessage(std::current_exception()) << endl;
+  }
 }
 
 int
@@ -411,7 +648,8 @@ try {
 
   event_loop.Run();
 
-  server.Save();
+  server.Save(true);
+  server.WaitSave();
 
   return EXIT_SUCCESS;
 } catch (const std::exception &exception) {
@@ -60,6 +60,94 @@ TrafficResponseSender::Flush()
   server.SendBuffer(address, {&data, size});
 }
 
+TrafficDeltaResponseSender::TrafficDeltaResponseSender(SkyLinesTracking::Server &_server,
+                                                       SocketAddress client_address,
+                                                       uint64_t key,
+                                                       GeoPoint reference) noexcept
+  :server(_server), address(client_address)
+{
+  data.header.header.magic = ToBE32(SkyLinesTracking::MAGIC);
+  data.header.header.type = ToBE16(SkyLinesTracking::Type::TRAFFIC_DELTA_RESPONSE);
+  data.header.header.key = ToBE64(key);
+
+  data.header.reserved = 0;
+  data.header.reserved2 = 0;
+  data.header.time = 0; // TODO: time?
+  data.header.reference = SkyLinesTracking::ExportGeoPoint(reference);
+}
+
+/**
+ * Convert an angle difference to
+ * #SkyLinesTracking::TrafficDeltaResponsePacket::UNIT.
+ *
+ * @return false if the result does not fit into 16 bits
+ */
+static bool
+QuantiseDelta(int32_t delta_micro_degrees, int16_t &result) noexcept
+{
+  constexpr int32_t unit = SkyLinesTracking::TrafficDeltaResponsePacket::UNIT;
+
+  /* round to nearest */
+  const int32_t value = delta_micro_degrees >= 0
+    ? (delta_micro_degrees + unit / 2) / unit
+    : -((-delta_micro_degrees + unit / 2) / unit);
+
+  if (value < INT16_MIN || value > INT16_MAX)
+    return false;
+
+  result = ToBE16(int16_t(value));
+  return true;
+}
+
+bool
+TrafficDeltaResponseSender::Add(uint32_t pilot_id, GeoPoint location,
+                                int altitude) noexcept
+{
+  assert(n_traffic < MAX_TRAFFIC);
+
+  const auto p = SkyLinesTracking::ExportGeoPoint(location);
+  const int32_t delta_latitude = int32_t(FromBE32(p.latitude)) -
+    int32_t(FromBE32(data.header.reference.latitude));
+
+  /* wrap around the antimeridian */
+  int32_t delta_longitude = int32_t(FromBE32(p.longitude)) -
+    int32_t(FromBE32(data.header.reference.longitude));
+  if (delta_longitude > 180000000)
+    delta_longitude -= 360000000;
+  else if (delta_longitude < -180000000)
+    delta_longitude += 360000000;
+
+  auto &traffic = data.traffic[n_traffic];
+  if (!QuantiseDelta(delta_latitude, traffic.latitude) ||
+      !QuantiseDelta(delta_longitude, traffic.longitude))
+    return false;
+
+  traffic.pilot_id = ToBE32(pilot_id);
+  traffic.altitude = ToBE16(altitude);
+  traffic.age = 0;
+
+  if (++n_traffic == MAX_TRAFFIC)
+    Flush();
+
+  return true;
+}
+
+void
+TrafficDeltaResponseSender::Flush() noexcept
+{
+  if (n_traffic == 0)
+    return;
+
+  size_t size = sizeof(data.header) + sizeof(data.traffic[0]) * n_traffic;
+
+  data.header.traffic_count = n_traffic;
+  n_traffic = 0;
+
+  data.header.header.crc = 0;
+  data.header.header.crc = ToBE16(UpdateCRC16CCITT(&data, size, 0));
+  server.SendBuffer(address, {&data, size});
+}
+
 void
 ThermalResponseSender::Add(SkyLinesTracking::Thermal t)
 {
@@ -66,6 +66,43 @@ public:
   void Flush();
 };
 
+/**
+ * Sends #SkyLinesTracking::TrafficDeltaResponsePacket to a client
+ * which has set #SkyLinesTracking::TrafficRequestPacket::FLAG_DELTA.
+ */
+class TrafficDeltaResponseSender {
+  SkyLinesTracking::Server &server;
+  const SocketAddress address;
+
+  static constexpr size_t MAX_TRAFFIC_SIZE = 1024;
+  static constexpr size_t MAX_TRAFFIC =
+    MAX_TRAFFIC_SIZE / sizeof(SkyLinesTracking::TrafficDeltaResponsePacket::Traffic);
+
+  struct Packet {
+    SkyLinesTracking::TrafficDeltaResponsePacket header;
+    std::array<SkyLinesTracking::TrafficDeltaResponsePacket::Traffic, MAX_TRAFFIC> traffic;
+  } data;
+
+  unsigned n_traffic = 0;
+
+public:
+  /**
+   * @param reference the location which all traffic locations are
+   * relative to; usually the client's own location
+   */
+  TrafficDeltaResponseSender(SkyLinesTracking::Server &_server,
+                             SocketAddress client_address, uint64_t key,
+                             GeoPoint reference) noexcept;
+
+  /**
+   * @return false if the location is too far away from the
+   * reference; the caller should then use #TrafficResponseSender
+   */
+  bool Add(uint32_t pilot_id, GeoPoint location, int altitude) noexcept;
+
+  void Flush() noexcept;
+};
+
 class ThermalResponseSender {
   SkyLinesTracking::Server &server;
   const SocketAddress address;
@@ -23,14 +23,39 @@ Copyright_License {
 
 #include "Thermal.hpp"
 #include "Serialiser.hpp"
-#include "Geo/Boost/RangeBox.hpp"
+#include "Geo/FAISphere.hpp"
 #include "Tracking/SkyLines/Protocol.hpp"
 #include "Tracking/SkyLines/Assemble.hpp"
 #include "Tracking/SkyLines/Import.hpp"
+#include "util/DeleteDisposer.hxx"
 
-#include <boost/geometry/algorithms/distance.hpp>
-#include <boost/geometry/algorithms/intersection.hpp>
-#include <boost/geometry/strategies/strategies.hpp>
+#include <algorithm>
+#include <cmath>
+
+/**
+ * The weight of a thermal in its #CloudHotspot is halved after this
+ * duration.
+ */
+static constexpr std::chrono::steady_clock::duration HOTSPOT_HALF_LIFE =
+  std::chrono::minutes(10);
+
+/**
+ * Thermals with less (or negative) lift get this weight.
+ */
+static constexpr double MIN_HOTSPOT_WEIGHT = 0.1;
+
+/**
+ * Calculate the factor by which a weight decays during the given
+ * duration.
+ */
+[[gnu::const]]
+static double
+DecayFactor(std::chrono::steady_clock::duration d) noexcept
+{
+  using Seconds = std::chrono::duration<double>;
+  return std::exp2(-std::chrono::duration_cast<Seconds>(d).count() /
+                   std::chrono::duration_cast<Seconds>(HOTSPOT_HALF_LIFE).count());
+}
 
 CloudThermalContainer::CloudThermalContainer()
 {
@@ -54,8 +79,8 @@ CloudThermalContainer::Make(uint64_t client_key,
                             const AGeoPoint &top_location,
                             double lift)
 {
-  auto thermal = std::make_shared<CloudThermal>(client_key, bottom_location,
-                                                top_location, lift);
+  auto *thermal = new CloudThermal(client_key, bottom_location,
+                                   top_location, lift);
   Insert(*thermal);
   return *thermal;
 }
@@ -64,14 +89,16 @@ void
 CloudThermalContainer::Insert(CloudThermal &thermal)
 {
   list.push_front(thermal);
-  rtree.insert(thermal.shared_from_this());
+
+  auto i = hotspots.try_emplace(GetGridCell(thermal.top_location),
+                                thermal.client_key).first;
+  i->second.Add(thermal);
 }
 
 void
 CloudThermalContainer::Remove(CloudThermal &thermal)
 {
-  list.erase(list.iterator_to(thermal));
-  rtree.remove(thermal.shared_from_this());
+  list.erase_and_dispose(list.iterator_to(thermal), DeleteDisposer());
 }
 
 void
@@ -81,11 +108,146 @@ CloudThermalContainer::Expire(std::chrono::steady_clock::time_point before)
     Remove(list.back());
 }
 
-CloudThermalContainer::query_iterator_range
-CloudThermalContainer::QueryWithinRange(GeoPoint location, double range) const
+void
+CloudThermalContainer::ExpireHotspots(std::chrono::steady_clock::time_point before) noexcept
+{
+  for (auto i = hotspots.begin(); i != hotspots.end();) {
+    if (i->second.time < before)
+      i = hotspots.erase(i);
+    else
+      ++i;
+  }
+}
+
+const CloudHotspot *
+CloudThermalContainer::FindHotspot(const CloudThermal &thermal) const noexcept
 {
-  const auto q = boost::geometry::index::intersects(BoostRangeBox(location, range));
-  return {rtree.qbegin(q), rtree.qend()};
+  auto i = hotspots.find(GetGridCell(thermal.top_location));
+  return i != hotspots.end()
+    ? &i->second
+    : nullptr;
+}
+
+unsigned
+CloudThermalContainer::GetGridRow(Angle latitude) noexcept
+{
+  int row = (int)std::floor((latitude.Degrees() + 90) / GRID_CELL_DEGREES);
+  return std::clamp(row, 0, int(GRID_ROWS) - 1);
+}
+
+unsigned
+CloudThermalContainer::GetGridColumn(Angle longitude) noexcept
+{
+  int column = (int)std::floor((longitude.AsDelta().Degrees() + 180)
+                               / GRID_CELL_DEGREES);
+  return std::clamp(column, 0, int(GRID_COLUMNS) - 1);
+}
+
+std::vector<const CloudHotspot *>
+CloudThermalContainer::QueryHotspots(GeoPoint location,
+                                     double range) const noexcept
+{
+  /* the same bounding box as CloudClientContainer::QueryWithinRange();
+     hotspots are selected by grid cell, i.e. the box is rounded up to
+     cell borders */
+  const Angle latitude_delta = FAISphere::EarthDistanceToAngle(range);
+  const Angle north = std::min(location.latitude + latitude_delta,
+                               Angle::QuarterCircle());
+  const Angle south = std::max(location.latitude - latitude_delta,
+                               -Angle::QuarterCircle());
+
+  const auto c = std::max(location.latitude.cos(), 0.01);
+  const Angle longitude_delta = std::min(latitude_delta / c,
+                                         Angle::QuarterCircle());
+
+  const unsigned first_row = GetGridRow(south), last_row = GetGridRow(north);
+  const unsigned west_column =
+    GetGridColumn(location.longitude - longitude_delta);
+  const unsigned east_column =
+    GetGridColumn(location.longitude + longitude_delta);
+
+  std::vector<const CloudHotspot *> result;
+
+  const auto AddColumns = [this, &result](unsigned row,
+                                          unsigned first, unsigned last){
+    const auto end = hotspots.upper_bound(row * GRID_COLUMNS + last);
+    for (auto i = hotspots.lower_bound(row * GRID_COLUMNS + first);
+         i != end; ++i)
+      result.push_back(&i->second);
+  };
+
+  for (unsigned row = first_row; row <= last_row; ++row) {
+    if (west_column <= east_column) {
+      AddColumns(row, west_column, east_column);
+    } else {
+      /* wraps around the antimeridian */
+      AddColumns(row, west_column, GRID_COLUMNS - 1);
+      AddColumns(row, 0, east_column);
+    }
+  }
+
+  return result;
+}
+
+void
+CloudHotspot::Add(const CloudThermal &thermal) noexcept
+{
+  double w = std::max(thermal.lift, MIN_HOTSPOT_WEIGHT);
+
+  if (weight <= 0) {
+    time = thermal.time;
+  } else if (thermal.time > time) {
+    /* decay the old sums to the new time stamp */
+    const double f = DecayFactor(thermal.time - time);
+    weight *= f;
+    bottom_latitude *= f;
+    bottom_longitude *= f;
+    bottom_altitude *= f;
+    top_latitude *= f;
+    top_longitude *= f;
+    top_altitude *= f;
+    lift *= f;
+    time = thermal.time;
+  } else {
+    /* an older thermal (e.g. while loading the database): decay
+       only its own weight */
+    w *= DecayFactor(time - thermal.time);
+  }
+
+  weight += w;
+  bottom_latitude += w * thermal.bottom_location.latitude.Degrees();
+  bottom_longitude += w * thermal.bottom_location.longitude.Degrees();
+  bottom_altitude += w * thermal.bottom_location.altitude;
+  top_latitude += w * thermal.top_location.latitude.Degrees();
+  top_longitude += w * thermal.top_location.longitude.Degrees();
+  top_altitude += w * thermal.top_location.altitude;
+  lift += w * thermal.lift;
+
+  if (client_key != thermal.client_key)
+    client_key = 0;
+}
+
+double
+CloudHotspot::GetWeight(std::chrono::steady_clock::time_point now) const noexcept
+{
+  return now > time
+    ? weight * DecayFactor(now - time)
+    : weight;
+}
+
+SkyLinesTracking::Thermal
+CloudHotspot::Pack() const noexcept
+{
+  const GeoPoint bottom(Angle::Degrees(bottom_longitude / weight),
+                        Angle::Degrees(bottom_latitude / weight));
+  const GeoPoint top(Angle::Degrees(top_longitude / weight),
+                     Angle::Degrees(top_latitude / weight));
+
+  return SkyLinesTracking::MakeThermal(0, bottom,
+                                       std::lround(bottom_altitude / weight),
+                                       top,
+                                       std::lround(top_altitude / weight),
+                                       lift / weight);
 }
 
 SkyLinesTracking::Thermal
@@ -150,7 +312,7 @@ CloudThermalContainer::Load(Deserialiser &s)
   s.Read8();
 
   while (s.Read8() != 0) {
-    auto thermal = std::make_shared<CloudThermal>(CloudThermal::Load(s));
+    auto *thermal = new CloudThermal(CloudThermal::Load(s));
     Insert(*thermal);
   }
 
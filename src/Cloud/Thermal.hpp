@@ -24,14 +24,15 @@ Copyright_License {
 #ifndef XCSOAR_CLOUD_THERMAL_HPP
 #define XCSOAR_CLOUD_THERMAL_HPP
 
-#include "Geo/Boost/GeoPoint.hpp"
+#include "Geo/GeoPoint.hpp"
 
 #include <boost/intrusive/list.hpp>
-#include <boost/geometry/index/rtree.hpp>
-#include <boost/range/iterator_range_core.hpp>
 
+#include <map>
 #include <memory>
 #include <chrono>
+#include <cstdint>
+#include <vector>
 
 class Serialiser;
 class Deserialiser;
@@ -41,8 +42,7 @@ namespace SkyLinesTracking { struct Thermal; }
  * A client which has submitted data to us recently.
  */
 struct CloudThermal
-  : std::enable_shared_from_this<CloudThermal>,
-    boost::intrusive::list_base_hook<boost::intrusive::link_mode<boost::intrusive::normal_link>>
+  : boost::intrusive::list_base_hook<boost::intrusive::link_mode<boost::intrusive::normal_link>>
 {
   const uint64_t client_key;
 
@@ -72,39 +72,79 @@ struct CloudThermal
   static CloudThermal Load(Deserialiser &s);
 };
 
-using CloudThermalPtr = std::shared_ptr<CloudThermal>;
-
 /**
- * Helper for boost::geometry::index::rtree.
+ * An aggregation of all recent thermals whose top is inside one
+ * #CloudThermalContainer grid cell.  Each thermal is weighted by its
+ * lift, and the weights of older thermals decay exponentially, so the
+ * averages follow the most recent and strongest submissions.
  */
-struct CloudThermalIndexable {
-  typedef GeoPoint result_type;
+struct CloudHotspot {
+  /**
+   * Time of the most recent thermal.  All weighted sums are relative
+   * to this time.
+   */
+  std::chrono::steady_clock::time_point time;
+
+  /**
+   * The sum of all (decayed) weights.
+   */
+  double weight = 0;
+
+  /**
+   * Weighted sums of the thermal attributes; divide by #weight to
+   * obtain the average.
+   */
+  double bottom_latitude = 0, bottom_longitude = 0, bottom_altitude = 0;
+  double top_latitude = 0, top_longitude = 0, top_altitude = 0;
+  double lift = 0;
 
+  /**
+   * The key of the client which submitted all thermals of this
+   * hotspot, or 0 if there were several clients.
+   */
+  uint64_t client_key;
+
+  explicit CloudHotspot(uint64_t _client_key) noexcept
+    :client_key(_client_key) {}
+
+  void Add(const CloudThermal &thermal) noexcept;
+
+  /**
+   * Returns the weight decayed to the given time.
+   */
   [[gnu::pure]]
-  result_type operator()(const CloudThermalPtr &client) const {
-    return client->top_location;
-  }
+  double GetWeight(std::chrono::steady_clock::time_point now) const noexcept;
+
+  [[gnu::pure]]
+  SkyLinesTracking::Thermal Pack() const noexcept;
 };
 
 class CloudThermalContainer {
-  typedef boost::geometry::index::rtree<CloudThermalPtr, boost::geometry::index::rstar<16>,
-                                        CloudThermalIndexable> Tree;
-
   typedef boost::intrusive::list<CloudThermal,
                                  boost::intrusive::constant_time_size<false>> List;
 
   /**
-   * A geospatial container of all thermals, for fast geographic
-   * lookups.
+   * The size of a #hotspots cell in degrees (about 2 km).
    */
-  Tree rtree;
+  static constexpr double GRID_CELL_DEGREES = 0.02;
+
+  static constexpr unsigned GRID_ROWS = 180 / GRID_CELL_DEGREES;
+  static constexpr unsigned GRID_COLUMNS = 360 / GRID_CELL_DEGREES;
 
   /**
    * A linked list of thermals, sorted by time, with newer items at
-   * the front.
+   * the front.  This container owns the thermals.
    */
   List list;
 
+  /**
+   * The thermals aggregated in a uniform latitude/longitude grid,
+   * maintained incrementally by Insert().  Only non-empty cells are
+   * stored.  The map is ordered by row and then by column, so a
+   * geographic query needs one range lookup per grid row.
+   */
+  std::map<uint32_t, CloudHotspot> hotspots;
+
 public:
   CloudThermalContainer();
   ~CloudThermalContainer();
@@ -135,24 +175,58 @@ public:
                      const AGeoPoint &top_location,
                      double lift);
 
+  /**
+   * Add a #CloudThermal and aggregate it into its hotspot.  The
+   * container takes ownership of the object, which must have been
+   * allocated with "new".
+   */
   void Insert(CloudThermal &client);
 
   /**
-   * Remove a #CloudThermal and its data.  Be careful - the given reference
-   * is invalidated, unless the caller holds another #CloudThermalPtr.
+   * Remove and delete a #CloudThermal.  The given reference is
+   * invalidated.  This does not affect the hotspots, which expire on
+   * their own.
    */
   void Remove(CloudThermal &client);
 
   void Expire(std::chrono::steady_clock::time_point before);
 
-  typedef Tree::const_query_iterator query_iterator;
-  typedef boost::iterator_range<query_iterator> query_iterator_range;
+  /**
+   * Remove all hotspots which have not received a thermal since the
+   * given time.
+   */
+  void ExpireHotspots(std::chrono::steady_clock::time_point before) noexcept;
 
+  /**
+   * Look up the hotspot which contains the given thermal.
+   */
+  [[gnu::pure]]
+  const CloudHotspot *FindHotspot(const CloudThermal &thermal) const noexcept;
+
+  /**
+   * Query all hotspots inside the bounding box of the given circle.
+   * The cost depends on the number of grid rows and hotspots, not on
+   * the number of thermals.
+   */
   [[gnu::pure]]
-  query_iterator_range QueryWithinRange(GeoPoint location, double range) const;
+  std::vector<const CloudHotspot *> QueryHotspots(GeoPoint location,
+                                                  double range) const noexcept;
 
   void Save(Serialiser &s) const;
   void Load(Deserialiser &s);
+
+private:
+  [[gnu::const]]
+  static unsigned GetGridRow(Angle latitude) noexcept;
+
+  [[gnu::const]]
+  static unsigned GetGridColumn(Angle longitude) noexcept;
+
+  [[gnu::const]]
+  static uint32_t GetGridCell(GeoPoint location) noexcept {
+    return GetGridRow(location.latitude) * GRID_COLUMNS +
+      GetGridColumn(location.longitude);
+  }
 };
 
 #endif
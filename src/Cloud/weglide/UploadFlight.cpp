@@ -23,21 +23,53 @@
 
 #include "UploadFlight.hpp"
 #include "WeGlideSettings.hpp"
-#include "net/http/CoStreamRequest.hxx"
+#include "net/http/CoRequest.hxx"
 #include "net/http/Easy.hxx"
+#include "net/http/Global.hxx"
 #include "net/http/Mime.hxx"
 #include "net/http/Progress.hpp"
 #include "net/http/Setup.hxx"
+#include "co/Sleep.hxx"
 #include "Formatter/TimeFormatter.hpp"
 #include "json/ParserOutputStream.hxx"
 #include "system/ConvertPathName.hpp"
 #include "system/Path.hpp"
+#include "util/RuntimeError.hxx"
 #include "util/StaticString.hxx"
 
 #include <cinttypes>
+#include <cstdio>
+#include <stdexcept>
 
 namespace WeGlide {
 
+/**
+ * The number of upload attempts before giving up.
+ */
+static constexpr unsigned MAX_ATTEMPTS = 4;
+
+/**
+ * The delay before the first retry; it doubles with each further
+ * attempt.
+ */
+static constexpr std::chrono::seconds FIRST_RETRY_DELAY{15};
+
+/**
+ * Abort an attempt if the transfer rate stays below this number of
+ * bytes per second for #LOW_SPEED_TIME seconds.  A stalled connection
+ * then fails (and is retried) instead of hanging forever.
+ */
+static constexpr long LOW_SPEED_LIMIT = 64;
+static constexpr long LOW_SPEED_TIME = 60;
+
+/**
+ * The server has rejected the upload; retrying will not help.
+ */
+class RejectedError : public std::runtime_error {
+public:
+  using std::runtime_error::runtime_error;
+};
+
 static CurlMime
 MakeUploadFlightMime(CURL *easy, const WeGlideSettings &settings,
                      uint_least32_t glider_type,
@@ -57,11 +89,17 @@ MakeUploadFlightMime(CURL *easy, const WeGlideSettings &settings,
   return mime;
 }
 
-Co::Task<boost::json::value>
-UploadFlight(CurlGlobal &curl, const WeGlideSettings &settings,
-             uint_least32_t glider_type,
-             Path igc_path,
-             ProgressListener &progress)
+/**
+ * Make one upload attempt.
+ *
+ * Throws #RejectedError if the server has rejected the upload with
+ * a 4xx status, and other exceptions on transient errors.
+ */
+static Co::Task<boost::json::value>
+UploadFlightOnce(CurlGlobal &curl, const WeGlideSettings &settings,
+                 uint_least32_t glider_type,
+                 Path igc_path,
+                 ProgressListener &progress)
 {
   NarrowString<0x200> url(settings.default_url);
   url += "/igcfile";
@@ -69,16 +107,56 @@ UploadFlight(CurlGlobal &curl, const WeGlideSettings &settings,
   CurlEasy easy{url};
   Curl::Setup(easy);
   const Net::ProgressAdapter progress_adapter{easy, progress};
-  easy.SetFailOnError();
+  easy.SetOption(CURLOPT_LOW_SPEED_LIMIT, LOW_SPEED_LIMIT);
+  easy.SetOption(CURLOPT_LOW_SPEED_TIME, LOW_SPEED_TIME);
 
   const auto mime = MakeUploadFlightMime(easy.Get(), settings,
                                          glider_type, igc_path);
   easy.SetMimePost(mime.get());
 
-  Json::ParserOutputStream parser;
   const auto response =
-    co_await Curl::CoStreamRequest(curl, std::move(easy), parser);
+    co_await Curl::CoRequest(curl, std::move(easy));
+
+  if (response.status >= 400 && response.status < 500) {
+    char msg[64];
+    snprintf(msg, sizeof(msg), "WeGlide has rejected the flight: HTTP %u",
+             response.status);
+    throw RejectedError(msg);
+  }
+
+  if (response.status < 200 || response.status >= 300)
+    throw FormatRuntimeError("WeGlide upload failed: HTTP %u",
+                             response.status);
+
+  Json::ParserOutputStream parser;
+  parser.Write(response.body.data(), response.body.size());
   co_return parser.Finish();
 }
 
+Co::Task<boost::json::value>
+UploadFlight(CurlGlobal &curl, const WeGlideSettings &settings,
+             uint_least32_t glider_type,
+             Path igc_path,
+             ProgressListener &progress)
+{
+  auto delay = std::chrono::duration_cast<Event::Duration>(FIRST_RETRY_DELAY);
+
+  for (unsigned attempt = 1;; ++attempt) {
+    try {
+      co_return co_await UploadFlightOnce(curl, settings, glider_type,
+                                          igc_path, progress);
+    } catch (const RejectedError &) {
+      throw;
+    } catch (...) {
+      if (attempt >= MAX_ATTEMPTS)
+        throw;
+    }
+
+    /* a transient error (network failure, stalled transfer, server
+       error): wait and try again */
+    co_await Co::Sleep{curl.GetEventLoop(), delay};
+    delay *= 2;
+  }
+}
+
 } // namespace WeGlide
@@ -48,6 +48,10 @@ namespace CommandLine {
 #ifdef HAVE_CMDLINE_REPLAY
   const char *replay_path;
 #endif
+
+#ifdef HAVE_CMDLINE_TRACE
+  const char *trace_path;
+#endif
 }
 
 void
@@ -84,6 +88,10 @@ CommandLine::Parse(Args &args)
     } else if (StringIsEqual(s, "-replay=", 8)) {
       replay_path = s + 8;
 #endif
+#ifdef HAVE_CMDLINE_TRACE
+    } else if (StringIsEqual(s, "-trace=", 7)) {
+      trace_path = s + 7;
+#endif
 #ifdef SIMULATOR_AVAILABLE
     } else if (StringIsEqual(s, "-simulator")) {
       global_simulator_flag = true;
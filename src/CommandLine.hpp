@@ -43,6 +43,15 @@ namespace CommandLine {
   extern const char *replay_path;
 #endif
 
+#ifndef ANDROID
+#define HAVE_CMDLINE_TRACE
+  /**
+   * Record trace events and write them to this file on exit (see
+   * WriteTraceFile()).
+   */
+  extern const char *trace_path;
+#endif
+
 /**
  * Reads and parses arguments/options from the command line
  * @param CommandLine command line argument string
@@ -28,11 +28,24 @@ Copyright_License {
 #include "Atmosphere/AirDensity.hpp"
 #include "Geo/Gravity.hpp"
 #include "Math/Util.hpp"
+#include "Math/LowPassFilter.hpp"
+#include "util/Clamp.hpp"
 #include "time/Cast.hxx"
 
 static constexpr double INVERSE_G = 1. / GRAVITY;
 static constexpr double INVERSE_2G = INVERSE_G / 2.;
 
+/**
+ * The time constant of the compass turn rate filter [s].
+ */
+static constexpr double HEADING_TURN_RATE_TAU = 1;
+
+/**
+ * Compass headings which are further apart than this [s] are not
+ * used to calculate a turn rate.
+ */
+static constexpr double MAX_HEADING_INTERVAL = 2;
+
 /**
  * Fill vario values when they are provided by the external vario.
  * This is a short path that works even when no GPS (providing GPS
@@ -230,6 +243,89 @@ ComputeAirspeed(NMEAInfo &basic, const DerivedInfo &calculated)
   basic.airspeed_real = false;
 }
 
+/**
+ * Record the current ground velocity and true airspeed in
+ * MoreData::speed_samples if both were updated since the previous
+ * sample.
+ */
+static void
+ComputeSpeedSamples(MoreData &basic)
+{
+  auto &samples = basic.speed_samples;
+
+  if (!basic.track_available || !basic.ground_speed_available ||
+      !basic.airspeed_available || !basic.airspeed_real)
+    return;
+
+  if (samples.last_ground_speed_available.FixTimeWarp(basic.ground_speed_available) ||
+      samples.last_airspeed_available.FixTimeWarp(basic.airspeed_available))
+    /* time warp: start from scratch */
+    samples.Clear();
+
+  if (!basic.ground_speed_available.Modified(samples.last_ground_speed_available) ||
+      !basic.airspeed_available.Modified(samples.last_airspeed_available))
+    return;
+
+  samples.last_ground_speed_available = basic.ground_speed_available;
+  samples.last_airspeed_available = basic.airspeed_available;
+
+  const auto sc = basic.track.SinCos();
+  auto &sample = samples.Append();
+  sample.time = basic.clock;
+  sample.ground_velocity[0] = (float)(sc.first * basic.ground_speed);
+  sample.ground_velocity[1] = (float)(sc.second * basic.ground_speed);
+  sample.true_airspeed = (float)basic.true_airspeed;
+}
+
+/**
+ * Calculate the turn rate from the compass heading each time a
+ * device provides a new one, instead of waiting for the next GPS
+ * fix.
+ */
+static void
+ComputeHeadingTurnRate(MoreData &basic, const MoreData &last)
+{
+  const auto &heading_available = basic.attitude.heading_available;
+  const auto &last_heading_available = last.attitude.heading_available;
+
+  if (!heading_available || !last_heading_available) {
+    basic.heading_turn_rate_available.Clear();
+    return;
+  }
+
+  if (!heading_available.Modified(last_heading_available)) {
+    /* no new heading since the last merge */
+    basic.heading_turn_rate = last.heading_turn_rate;
+    basic.heading_turn_rate_available = last.heading_turn_rate_available;
+    return;
+  }
+
+  const auto dt =
+    heading_available.GetTimeDifference(last_heading_available).count();
+  if (dt <= 0 || dt > MAX_HEADING_INTERVAL) {
+    basic.heading_turn_rate_available.Clear();
+    return;
+  }
+
+  /* limit the rate to 50 degrees per second like
+     CirclingComputer::TurnRate() does */
+  const Angle turn_rate =
+    Clamp((basic.attitude.heading - last.attitude.heading).AsDelta() / dt,
+          Angle::Degrees(-50), Angle::Degrees(50));
+
+  if (last.heading_turn_rate_available) {
+    /* the smoothing factor depends on the sample interval, so the
+       filter behaves the same at any device rate */
+    const double fact = dt / (HEADING_TURN_RATE_TAU + dt);
+    basic.heading_turn_rate =
+      Angle::Native(LowPassFilter(last.heading_turn_rate.Native(),
+                                  turn_rate.Native(), fact));
+  } else
+    basic.heading_turn_rate = turn_rate;
+
+  basic.heading_turn_rate_available.Update(basic.clock);
+}
+
 /**
  * Calculates energy height on TAS basis
  *
@@ -375,8 +471,14 @@ ComputeDynamics(MoreData &basic, const DerivedInfo &calculated)
   if (!basic.airspeed_available)
     return;
 
+  /* prefer the compass turn rate, which is more recent than the one
+     calculated by CirclingComputer */
+  const Angle turn_rate = basic.heading_turn_rate_available
+    ? basic.heading_turn_rate
+    : calculated.turn_rate_heading;
+
   // estimate bank angle (assuming balanced turn)
-  const auto angle = atan((calculated.turn_rate_heading
+  const auto angle = atan((turn_rate
       * basic.true_airspeed * INVERSE_G).Radians());
 
   if (!basic.attitude.bank_angle_available) {
@@ -423,8 +525,10 @@ BasicComputer::Compute(MoreData &data,
   ground_speed.Compute(data);
 
   ComputeAirspeed(data, calculated);
+  ComputeSpeedSamples(data);
 
   ComputeHeading(data.attitude, data, calculated);
+  ComputeHeadingTurnRate(data, last);
 
   ComputeEnergyHeight(data);
   ComputeGPSVario(data, last, last_gps);
@@ -49,7 +49,7 @@ CirclingComputer::ResetStats()
 
 void
 CirclingComputer::TurnRate(CirclingInfo &circling_info,
-                           const NMEAInfo &basic,
+                           const MoreData &basic,
                            const FlyingState &flight)
 {
   if (!basic.time_available || !flight.flying || !turn_rate_delta_time.IsDefined()) {
@@ -95,13 +95,20 @@ CirclingComputer::TurnRate(CirclingInfo &circling_info,
                                   turn_rate.Native(), 0.3);
     circling_info.turn_rate_smoothed = Angle::Native(smoothed);
 
-    // Makes smoothing of heading turn rate
-    turn_rate = Clamp(circling_info.turn_rate_heading,
-                      Angle::Degrees(-50), Angle::Degrees(50));
-    // Make the heading turn rate more smooth using the LowPassFilter
-    smoothed = LowPassFilter(circling_info.turn_rate_heading_smoothed.Native(),
-                             turn_rate.Native(), 0.3);
-    circling_info.turn_rate_heading_smoothed = Angle::Native(smoothed);
+    if (basic.heading_turn_rate_available) {
+      /* the compass turn rate has been calculated (and smoothed) by
+         BasicComputer at the rate of the device */
+      circling_info.turn_rate_heading = basic.heading_turn_rate;
+      circling_info.turn_rate_heading_smoothed = basic.heading_turn_rate;
+    } else {
+      // Makes smoothing of heading turn rate
+      turn_rate = Clamp(circling_info.turn_rate_heading,
+                        Angle::Degrees(-50), Angle::Degrees(50));
+      // Make the heading turn rate more smooth using the LowPassFilter
+      smoothed = LowPassFilter(circling_info.turn_rate_heading_smoothed.Native(),
+                               turn_rate.Native(), 0.3);
+      circling_info.turn_rate_heading_smoothed = Angle::Native(smoothed);
+    }
 
     last_track = basic.track;
     last_heading = basic.attitude.heading;
@@ -122,8 +129,14 @@ CirclingComputer::Turning(CirclingInfo &circling_info,
   if (dt.count() <= 0)
     return;
 
-  circling_info.turning =
-    circling_info.turn_rate_smoothed.Absolute() >= MIN_TURN_RATE;
+  /* the compass turn rate reacts much faster than the one derived
+     from the GPS track, because it is updated at the rate of the
+     device */
+  const Angle turn_rate = basic.heading_turn_rate_available
+    ? basic.heading_turn_rate
+    : circling_info.turn_rate_smoothed;
+
+  circling_info.turning = turn_rate.Absolute() >= MIN_TURN_RATE;
 
   // Force cruise or climb mode if external device says so
   bool force_cruise = false;
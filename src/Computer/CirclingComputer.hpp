@@ -29,7 +29,6 @@ Copyright_License {
 #include "time/Stamp.hpp"
 
 struct CirclingInfo;
-struct NMEAInfo;
 struct MoreData;
 struct CirclingSettings;
 struct FlyingState;
@@ -87,10 +86,11 @@ public:
   void ResetStats();
 
   /**
-   * Calculates the turn rate
+   * Calculates the turn rate.  If a compass provides the heading,
+   * MoreData::heading_turn_rate is used for the heading turn rate.
    */
   void TurnRate(CirclingInfo &circling_info,
-                const NMEAInfo &basic,
+                const MoreData &basic,
                 const FlyingState &flight);
 
   /**
@@ -0,0 +1,125 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "ComputerScheduler.hpp"
+
+#include <algorithm>
+
+using namespace std::chrono;
+
+struct JobInfo {
+  /**
+   * The job will not run again before this time has passed since it
+   * was last run.
+   */
+  ComputerScheduler::Clock::duration min_interval;
+
+  /**
+   * Critical jobs are never deferred.
+   */
+  bool critical;
+};
+
+/**
+ * The static job declarations, indexed by #ComputerScheduler::Job.
+ * The intervals match the rate at which GlideComputer calls the
+ * respective stage (every fix / every idle cycle); a job which does
+ * not need to run that often may declare a longer one.
+ */
+static constexpr JobInfo job_info[] = {
+  { {}, true }, /* AIR_DATA */
+  { {}, true }, /* VERTICAL */
+  { {}, true }, /* TASK */
+  { {}, false }, /* ROUTE */
+  { {}, true }, /* LOG */
+  { {}, false }, /* TASK_IDLE */
+  { {}, false }, /* CONTEST */
+  { {}, true }, /* WARNING */
+};
+
+static_assert(std::size(job_info) == ComputerScheduler::N_JOBS);
+
+bool
+ComputerScheduler::ShouldRun(Job job, Clock::time_point now) noexcept
+{
+  const JobInfo &info = job_info[unsigned(job)];
+  JobState &state = jobs[unsigned(job)];
+
+  if (info.min_interval > Clock::duration::zero() &&
+      now - state.last_run < info.min_interval)
+    return false;
+
+  if (info.critical)
+    return true;
+
+  if (power_saving && now - state.last_run < POWER_SAVING_INTERVAL) {
+    /* this does not count as a pending deferral, because
+       #MAX_DEFERRALS would soon override it */
+    const std::lock_guard<Mutex> lock(mutex);
+    ++timings[unsigned(job)].deferred;
+    return false;
+  }
+
+  if (budget <= Clock::duration::zero() ||
+      state.pending_deferrals >= MAX_DEFERRALS)
+    return true;
+
+  /* defer if the expected cost (the job's average) does not fit into
+     what is left of this cycle's budget
+     (no lock needed for reading, this thread is the only writer) */
+  const Clock::duration expected = timings[unsigned(job)].average;
+
+  if (now - cycle_start + expected <= budget)
+    return true;
+
+  ++state.pending_deferrals;
+
+  const std::lock_guard<Mutex> lock(mutex);
+  ++timings[unsigned(job)].deferred;
+  return false;
+}
+
+void
+ComputerScheduler::Finished(Job job, Clock::time_point start,
+                            Clock::time_point end,
+                            std::size_t allocations) noexcept
+{
+  JobState &state = jobs[unsigned(job)];
+  state.last_run = start;
+  state.pending_deferrals = 0;
+
+  const auto duration = duration_cast<microseconds>(end - start);
+
+  const std::lock_guard<Mutex> lock(mutex);
+  Timing &t = timings[unsigned(job)];
+  t.last = duration;
+  t.allocations = allocations;
+  t.max = std::max(t.max, duration);
+
+  /* exponential moving average over roughly the last 8 runs */
+  t.average = t.runs == 0
+    ? duration
+    : t.average + (duration - t.average) / 8;
+
+  ++t.runs;
+}
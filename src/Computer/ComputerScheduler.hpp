@@ -0,0 +1,203 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_COMPUTER_SCHEDULER_HPP
+#define XCSOAR_COMPUTER_SCHEDULER_HPP
+
+#include "thread/Mutex.hxx"
+#include "system/MemoryAccounting.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+/**
+ * Decides which of the #GlideComputer's sub-computers run in the
+ * current calculation cycle, and measures how long each of them
+ * takes.
+ *
+ * Each job declares a minimum interval and whether it is critical.
+ * Critical jobs (e.g. airspace warnings, final glide) always run.
+ * The others are deferred when the cycle has already used up its
+ * budget, but never more than #MAX_DEFERRALS times in a row.
+ *
+ * The timings may be read by any thread with GetTimings().
+ */
+class ComputerScheduler {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  enum class Job : uint8_t {
+    /** GlideComputerAirData::ProcessBasic() */
+    AIR_DATA,
+
+    /** GlideComputerAirData::ProcessVertical() (climb, wind, circling) */
+    VERTICAL,
+
+    /** per-fix task update, including final glide */
+    TASK,
+
+    /** route planner and reach */
+    ROUTE,
+
+    /** flight statistics and the IGC logger */
+    LOG,
+
+    /** TaskManager::UpdateIdle() (alternates, AAT optimisation) */
+    TASK_IDLE,
+
+    /** incremental contest optimisation */
+    CONTEST,
+
+    /** airspace warnings */
+    WARNING,
+
+    COUNT
+  };
+
+  static constexpr unsigned N_JOBS = unsigned(Job::COUNT);
+
+  /**
+   * A deferrable job runs anyway after it has been deferred this
+   * number of times in a row.
+   */
+  static constexpr unsigned MAX_DEFERRALS = 4;
+
+  /**
+   * While saving power, deferrable jobs run at most once per this
+   * interval, regardless of the budget.
+   */
+  static constexpr std::chrono::seconds POWER_SAVING_INTERVAL{5};
+
+  struct Timing {
+    std::chrono::microseconds last, average, max;
+
+    /**
+     * How many times has this job been run / deferred?
+     */
+    uint32_t runs, deferred;
+
+    /**
+     * The number of heap allocations done by the last run; always
+     * zero unless built with MEMORY_ACCOUNTING.
+     */
+    uint32_t allocations;
+  };
+
+  using Timings = std::array<Timing, N_JOBS>;
+
+private:
+  struct JobState {
+    Clock::time_point last_run;
+
+    /**
+     * The number of consecutive deferrals.
+     */
+    unsigned pending_deferrals = 0;
+  };
+
+  std::array<JobState, N_JOBS> jobs;
+
+  /**
+   * The time budget of one cycle; zero means unlimited, i.e. nothing
+   * is ever deferred.
+   */
+  Clock::duration budget = Clock::duration::zero();
+
+  /**
+   * @see SetPowerSaving()
+   */
+  bool power_saving = false;
+
+  Clock::time_point cycle_start;
+
+  /**
+   * Protects #timings.
+   */
+  mutable Mutex mutex;
+
+  Timings timings{};
+
+public:
+  void SetBudget(Clock::duration _budget) noexcept {
+    budget = _budget;
+  }
+
+  /**
+   * Enable or disable power saving: deferrable jobs are then run
+   * only every #POWER_SAVING_INTERVAL; these deferrals are counted
+   * like the others.
+   */
+  void SetPowerSaving(bool _power_saving) noexcept {
+    power_saving = _power_saving;
+  }
+
+  bool IsPowerSaving() const noexcept {
+    return power_saving;
+  }
+
+  /**
+   * A new calculation cycle begins.  Its budget is shared by all
+   * jobs until the next call.
+   */
+  void BeginCycle() noexcept {
+    cycle_start = Clock::now();
+  }
+
+  /**
+   * Run the job (a callable) if it is due, and measure it.
+   *
+   * @param force run even if the job would be deferred
+   * @return true if the job was run
+   */
+  template<typename F>
+  bool Run(Job job, F &&f, bool force=false) noexcept {
+    const auto start = Clock::now();
+    if (!force && !ShouldRun(job, start))
+      return false;
+
+    const std::size_t allocations = MemoryAccounting::GetThreadAllocations();
+
+    f();
+
+    Finished(job, start, Clock::now(),
+             MemoryAccounting::GetThreadAllocations() - allocations);
+    return true;
+  }
+
+  /**
+   * Returns a copy of the timings for displaying them.
+   */
+  Timings GetTimings() const noexcept {
+    const std::lock_guard<Mutex> lock(mutex);
+    return timings;
+  }
+
+private:
+  bool ShouldRun(Job job, Clock::time_point now) noexcept;
+  void Finished(Job job, Clock::time_point start,
+                Clock::time_point end, std::size_t allocations) noexcept;
+};
+
+#endif
@@ -48,6 +48,16 @@ public:
     :Interval_Notification(_interval_notification),
      Interval_Check(_interval_check) {}
 
+  /**
+   * Returns the time when Update() will check the condition next;
+   * undefined if it will check on the next call.
+   */
+  TimeStamp GetNextCheck() const noexcept {
+    return LastTime_Check.IsDefined()
+      ? LastTime_Check + Interval_Check
+      : TimeStamp::Undefined();
+  }
+
   void Update(const NMEAInfo &basic, const DerivedInfo &calculated,
               const ComputerSettings &settings);
 
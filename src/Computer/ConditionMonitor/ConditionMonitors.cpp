@@ -29,6 +29,11 @@ Copyright_License {
 #include "ConditionMonitorLandableReachable.hpp"
 #include "ConditionMonitorSunset.hpp"
 #include "ConditionMonitorWind.hpp"
+#include "NMEA/Info.hpp"
+#include "NMEA/Derived.hpp"
+
+#include <algorithm>
+#include <array>
 
 static ConditionMonitorWind cm_wind;
 static ConditionMonitorFinalGlide cm_finalglide;
@@ -37,14 +42,67 @@ static ConditionMonitorAATTime cm_aattime;
 static ConditionMonitorGlideTerrain cm_glideterrain;
 static ConditionMonitorLandableReachable cm_landablereachable;
 
+/**
+ * A monitor and the time of its next check.
+ */
+struct ScheduledMonitor {
+  TimeStamp deadline;
+  ConditionMonitor *monitor;
+};
+
+/**
+ * Inverted comparison, which makes the std::*_heap() functions
+ * maintain a min-heap of deadlines.  Undefined deadlines (negative)
+ * come first.
+ */
+static constexpr bool
+CompareDeadline(const ScheduledMonitor &a, const ScheduledMonitor &b) noexcept
+{
+  return a.deadline > b.deadline;
+}
+
+/**
+ * All monitors, ordered as a min-heap of deadlines; all of them are
+ * due initially.
+ */
+static std::array<ScheduledMonitor, 6> schedule{{
+  {TimeStamp::Undefined(), &cm_wind},
+  {TimeStamp::Undefined(), &cm_finalglide},
+  {TimeStamp::Undefined(), &cm_sunset},
+  {TimeStamp::Undefined(), &cm_aattime},
+  {TimeStamp::Undefined(), &cm_glideterrain},
+  {TimeStamp::Undefined(), &cm_landablereachable},
+}};
+
+static TimeStamp last_time = TimeStamp::Undefined();
+
 void
 ConditionMonitorsUpdate(const NMEAInfo &basic, const DerivedInfo &calculated,
                         const ComputerSettings &settings)
 {
-  cm_wind.Update(basic, calculated, settings);
-  cm_finalglide.Update(basic, calculated, settings);
-  cm_sunset.Update(basic, calculated, settings);
-  cm_aattime.Update(basic, calculated, settings);
-  cm_glideterrain.Update(basic, calculated, settings);
-  cm_landablereachable.Update(basic, calculated, settings);
+  /* ConditionMonitor::Update() would ignore these */
+  const auto time = basic.time;
+  if (!calculated.flight.flying || !time.IsDefined())
+    return;
+
+  if (time < last_time) {
+    /* time warp: all monitors need to restart */
+    for (auto &i : schedule)
+      i.deadline = TimeStamp::Undefined();
+  }
+
+  last_time = time;
+
+  /* only the monitors whose deadline has passed are visited; each one
+     at most once per call */
+  for (std::size_t n = schedule.size();
+       n > 0 && schedule.front().deadline <= time; --n) {
+    std::pop_heap(schedule.begin(), schedule.end(), CompareDeadline);
+
+    auto &due = schedule.back();
+    due.monitor->Update(basic, calculated, settings);
+    due.deadline = due.monitor->GetNextCheck();
+
+    std::push_heap(schedule.begin(), schedule.end(), CompareDeadline);
+  }
 }
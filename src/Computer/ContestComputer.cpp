@@ -23,6 +23,23 @@ Copyright_License {
 
 #include "ContestComputer.hpp"
 #include "Engine/Contest/Settings.hpp"
+#include "thread/ThreadPool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+/**
+ * Not more than the number of solvers of one contest which can run
+ * in parallel.
+ */
+static constexpr unsigned MAX_CONTEST_THREADS = 3;
+
+/**
+ * The time each Dijkstra solver may spend in one ProcessIdle() call.
+ * A search which takes longer is continued in the next call.
+ */
+static constexpr std::chrono::milliseconds CONTEST_TIME_BUDGET{20};
 
 ContestComputer::ContestComputer(const Trace &trace_full,
                                  const Trace &trace_triangle,
@@ -30,8 +47,18 @@ ContestComputer::ContestComputer(const Trace &trace_full,
   :contest_manager(Contest::OLC_SPRINT, trace_full, trace_triangle, trace_sprint, true)
 {
   contest_manager.SetIncremental(true);
+  contest_manager.SetTimeBudget(CONTEST_TIME_BUDGET);
+
+  const unsigned n_threads = std::min(std::thread::hardware_concurrency(),
+                                      MAX_CONTEST_THREADS);
+  if (n_threads > 1) {
+    thread_pool = std::make_unique<ThreadPool>(n_threads);
+    contest_manager.SetThreadPool(thread_pool.get());
+  }
 }
 
+ContestComputer::~ContestComputer() noexcept = default;
+
 void
 ContestComputer::Solve(const ContestSettings &settings,
                        ContestStatistics &contest_stats)
@@ -39,6 +66,11 @@ ContestComputer::Solve(const ContestSettings &settings,
   if (!settings.enable)
     return;
 
+  if (final_stats) {
+    contest_stats = *final_stats;
+    return;
+  }
+
   contest_manager.SetHandicap(settings.handicap);
   contest_manager.SetContest(settings.contest);
 
@@ -26,17 +26,34 @@ Copyright_License {
 
 #include "Engine/Contest/ContestManager.hpp"
 
+#include <memory>
+#include <optional>
+
 struct ContestSettings;
 struct ContestStatistics;
 class Trace;
 
 class ContestComputer {
+  /**
+   * Runs the independent solvers of the selected contest in
+   * parallel; nullptr on single-core machines.
+   */
+  std::unique_ptr<ThreadPool> thread_pool;
+
   ContestManager contest_manager;
 
+  /**
+   * The result of an exhaustive search (see #ContestJob).  While
+   * this is set, Solve() publishes it instead of the incremental
+   * result.
+   */
+  std::optional<ContestStatistics> final_stats;
+
 public:
   ContestComputer(const Trace &trace_full,
                   const Trace &trace_triangle,
                   const Trace &trace_sprint);
+  ~ContestComputer() noexcept;
 
   void SetIncremental(bool incremental) {
     contest_manager.SetIncremental(incremental);
@@ -44,6 +61,15 @@ public:
 
   void Reset() {
     contest_manager.Reset();
+    final_stats.reset();
+  }
+
+  void SetFinal(const ContestStatistics &stats) {
+    final_stats = stats;
+  }
+
+  void ClearFinal() {
+    final_stats.reset();
   }
 
   /**
@@ -0,0 +1,143 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "ContestJob.hpp"
+#include "TraceComputer.hpp"
+#include "Engine/Contest/Settings.hpp"
+#include "Engine/Trace/Vector.hpp"
+#include "Operation/Operation.hpp"
+
+#include <chrono>
+
+/**
+ * The time each Dijkstra solver may spend in one intermediate run;
+ * the same as in #ContestComputer.
+ */
+static constexpr std::chrono::milliseconds CONTEST_TIME_BUDGET{20};
+
+ContestJob::ContestJob(const TraceComputer &_source) noexcept
+  :source(_source),
+   full({}, Trace::null_time, source.GetFull().GetMaxSize()),
+   triangle({}, Trace::null_time, source.GetContest().GetMaxSize()),
+   sprint({}, Trace::null_time, source.GetSprint().GetMaxSize()),
+   manager(Contest::OLC_SPRINT, full, triangle, sprint)
+{
+  /* ignored by the exhaustive search */
+  manager.SetTimeBudget(CONTEST_TIME_BUDGET);
+}
+
+/**
+ * Replace the contents of #dest with the points of #src.  The
+ * destination must be able to hold all of them without thinning.
+ */
+static void
+CopyTrace(Trace &dest, const Trace &src) noexcept
+{
+  assert(dest.GetMaxSize() >= src.size());
+
+  TracePointVector v;
+  src.GetPoints(v);
+
+  dest.clear();
+  for (const auto &i : v)
+    dest.push_back(i);
+}
+
+/**
+ * Bring #dest up to date with #src.  If #src has only been appended
+ * to since the last call, only the new points are copied, which
+ * keeps the incremental solver state valid.  Otherwise, the whole
+ * trace is copied.
+ *
+ * @param serial the #Trace::GetModifySerial() of #src after the last
+ * call; updated by this function
+ */
+static void
+SyncTrace(Trace &dest, Serial &serial, const Trace &src) noexcept
+{
+  if (dest.empty() || serial != src.GetModifySerial() ||
+      dest.size() > src.size() ||
+      dest.back().GetTime() > src.back().GetTime()) {
+    CopyTrace(dest, src);
+    serial = src.GetModifySerial();
+    return;
+  }
+
+  assert(dest.GetMaxSize() >= src.size());
+
+  for (auto i = std::prev(src.end(), src.size() - dest.size());
+       i != src.end(); ++i)
+    dest.push_back(*i);
+}
+
+void
+ContestJob::Prepare(const ContestSettings &settings,
+                    const TracePoint &predicted, bool final) noexcept
+{
+  exhaustive = final;
+
+  if (final || !incremental) {
+    /* start from scratch */
+    {
+      const std::lock_guard<Mutex> lock(source);
+      CopyTrace(full, source.GetFull());
+      full_serial = source.GetFull().GetModifySerial();
+    }
+
+    CopyTrace(triangle, source.GetContest());
+    triangle_serial = source.GetContest().GetModifySerial();
+    CopyTrace(sprint, source.GetSprint());
+    sprint_serial = source.GetSprint().GetModifySerial();
+
+    manager.SetIncremental(!final);
+    manager.Reset();
+    incremental = !final;
+  } else {
+    {
+      const std::lock_guard<Mutex> lock(source);
+      SyncTrace(full, full_serial, source.GetFull());
+    }
+
+    SyncTrace(triangle, triangle_serial, source.GetContest());
+    SyncTrace(sprint, sprint_serial, source.GetSprint());
+  }
+
+  manager.SetContest(settings.contest);
+  manager.SetHandicap(settings.handicap);
+  manager.SetPredicted(predicted);
+}
+
+void
+ContestJob::Run(OperationEnvironment &env)
+{
+  env.SetProgressRange(1);
+  env.SetProgressPosition(0);
+
+  if (env.IsCancelled())
+    return;
+
+  manager.UpdateIdle(exhaustive);
+  stats = manager.GetStats();
+
+  env.SetProgressPosition(1);
+}
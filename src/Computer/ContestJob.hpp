@@ -0,0 +1,102 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_CONTEST_JOB_HPP
+#define XCSOAR_CONTEST_JOB_HPP
+
+#include "Job/Job.hpp"
+#include "Engine/Contest/ContestManager.hpp"
+#include "Engine/Trace/Trace.hpp"
+
+struct ContestSettings;
+struct TracePoint;
+class TraceComputer;
+
+/**
+ * Runs the contest search on a private copy of the flight traces, so
+ * it can be moved to a background thread while the
+ * #CalculationThread continues.
+ *
+ * During the flight, it runs the incremental search with the same
+ * time budget as #ContestComputer, and the copies are only extended
+ * by the new points, so the search state survives from one run to
+ * the next.  After landing, it runs the exhaustive search from
+ * scratch.
+ *
+ * The object is reusable: Prepare() must be called in the
+ * #CalculationThread before each Run().
+ */
+class ContestJob final : public Job {
+  const TraceComputer &source;
+
+  Trace full, triangle, sprint;
+
+  /**
+   * The #Trace::GetModifySerial() values of the source traces when
+   * they were last copied.  If one of them changes, the copy is
+   * rebuilt from scratch.
+   */
+  Serial full_serial, triangle_serial, sprint_serial;
+
+  ContestManager manager;
+
+  /**
+   * Is the search state in #manager an incremental one which the
+   * next intermediate run may continue?
+   */
+  bool incremental = false;
+
+  /**
+   * Shall Run() do the exhaustive search?
+   */
+  bool exhaustive;
+
+  ContestStatistics stats;
+
+public:
+  explicit ContestJob(const TraceComputer &_source) noexcept;
+
+  /**
+   * Copy the traces and the settings.  This must be called in the
+   * #CalculationThread, because the contest traces are not
+   * protected.
+   *
+   * @param predicted see ContestManager::SetPredicted()
+   * @param final true for the exhaustive search after landing, false
+   * for an intermediate incremental search during the flight
+   */
+  void Prepare(const ContestSettings &settings,
+               const TracePoint &predicted, bool final) noexcept;
+
+  /**
+   * Obtain the result after Run() has returned.
+   */
+  const ContestStatistics &GetStats() const noexcept {
+    return stats;
+  }
+
+  /* virtual methods from class Job */
+  void Run(OperationEnvironment &env) override;
+};
+
+#endif
@@ -0,0 +1,241 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "FlightSnapshot.hpp"
+#include "io/CacheFile.hpp"
+#include "io/FileOutputStream.hxx"
+#include "io/BufferedOutputStream.hxx"
+#include "system/FileMapping.hpp"
+#include "system/FileUtil.hpp"
+#include "system/Path.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+#include <string.h>
+
+/**
+ * The file header.  It is followed by the raw structures in the
+ * order of their declaration in #FlightSnapshot, then
+ * #n_trace_points #TracePoint objects, then #n_task_points
+ * #FlightSnapshotTaskPoint records (each followed by its samples).
+ * A CRC16 of everything concludes the file.
+ */
+struct FlightSnapshotHeader {
+  static constexpr uint32_t MAGIC = 0x58534e50;
+  static constexpr uint32_t VERSION = 2;
+
+  uint32_t magic, version;
+
+  /**
+   * The size of all structures which are stored raw.  If it does not
+   * match, the file was written by a different build.
+   */
+  uint32_t layout;
+
+  uint32_t n_trace_points;
+
+  uint32_t n_task_points, active_task_point;
+
+  /** the time this file was written, see std::time_t */
+  int64_t time;
+};
+
+struct FlightSnapshotTaskPoint {
+  GeoPoint location;
+  AircraftState entered;
+  uint32_t n_samples;
+  bool has_exited;
+};
+
+static constexpr uint32_t layout =
+  sizeof(FlyingState) + sizeof(CirclingInfo) + sizeof(ClimbHistory) +
+  sizeof(ThermalEncounterBand) + sizeof(ThermalEncounterCollection) +
+  sizeof(ContestStatistics) +
+  sizeof(FlyingComputer) + sizeof(CirclingComputer) +
+  sizeof(WindMeasurementList) +
+  4 * sizeof(LeastSquares) + 2 * sizeof(ConvexFilter) +
+  2 * sizeof(Histogram) +
+  sizeof(TracePoint) + sizeof(FlightSnapshotTaskPoint);
+
+static_assert(std::is_trivially_copyable_v<FlyingState>);
+static_assert(std::is_trivially_copyable_v<CirclingInfo>);
+static_assert(std::is_trivially_copyable_v<ClimbHistory>);
+static_assert(std::is_trivially_copyable_v<ThermalEncounterBand>);
+static_assert(std::is_trivially_copyable_v<ThermalEncounterCollection>);
+static_assert(std::is_trivially_copyable_v<ContestStatistics>);
+static_assert(std::is_trivially_copyable_v<FlyingComputer>);
+static_assert(std::is_trivially_copyable_v<CirclingComputer>);
+static_assert(std::is_trivially_copyable_v<WindMeasurementList>);
+static_assert(std::is_trivially_copyable_v<TracePoint>);
+static_assert(std::is_trivially_copyable_v<FlightSnapshotTaskPoint>);
+
+static void
+WriteFlightStatistics(CacheFileWriter &w, const FlightStatistics &fs)
+{
+  w.WriteT(fs.thermal_average);
+  w.WriteT(fs.altitude);
+  w.WriteT(fs.altitude_base);
+  w.WriteT(fs.altitude_ceiling);
+  w.WriteT(fs.task_speed);
+  w.WriteT(fs.altitude_terrain);
+  w.WriteT(fs.vario_circling_histogram);
+  w.WriteT(fs.vario_cruise_histogram);
+}
+
+static void
+ReadFlightStatistics(CacheFileReader &r, FlightStatistics &fs)
+{
+  fs.thermal_average = r.ReadT<LeastSquares>();
+  fs.altitude = r.ReadT<LeastSquares>();
+  fs.altitude_base = r.ReadT<ConvexFilter>();
+  fs.altitude_ceiling = r.ReadT<ConvexFilter>();
+  fs.task_speed = r.ReadT<LeastSquares>();
+  fs.altitude_terrain = r.ReadT<LeastSquares>();
+  fs.vario_circling_histogram = r.ReadT<Histogram>();
+  fs.vario_cruise_histogram = r.ReadT<Histogram>();
+}
+
+void
+FlightSnapshot::Save(Path path) const
+{
+  FlightSnapshotHeader header;
+
+  /* zero-fill all implicit padding bytes, they are part of the
+     checksum */
+  memset(static_cast<void *>(&header), 0, sizeof(header));
+
+  header.magic = FlightSnapshotHeader::MAGIC;
+  header.version = FlightSnapshotHeader::VERSION;
+  header.layout = layout;
+  header.n_trace_points = trace.size();
+  header.n_task_points = task.points.size();
+  header.active_task_point = task.active_task_point;
+  header.time =
+    std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+
+  FileOutputStream fos(path);
+  BufferedOutputStream bos(fos);
+  CacheFileWriter w(bos);
+
+  w.WriteT(header);
+
+  w.WriteT(flight);
+  w.WriteT(circling);
+  w.WriteT(climb_history);
+  w.WriteT(thermal_encounter_band);
+  w.WriteT(thermal_encounter_collection);
+  w.WriteT(contest_stats);
+
+  w.WriteT(flying_computer);
+  w.WriteT(circling_computer);
+  w.WriteT(wind_measurements);
+  WriteFlightStatistics(w, flight_statistics);
+
+  w.Write(trace.data(), trace.size() * sizeof(TracePoint));
+
+  for (const auto &i : task.points) {
+    FlightSnapshotTaskPoint record;
+    memset(static_cast<void *>(&record), 0, sizeof(record));
+    record.location = i.location;
+    record.entered = i.entered;
+    record.n_samples = i.samples.size();
+    record.has_exited = i.has_exited;
+
+    w.WriteT(record);
+    w.Write(i.samples.data(), i.samples.size() * sizeof(GeoPoint));
+  }
+
+  w.WriteChecksum();
+
+  bos.Flush();
+  fos.Commit();
+}
+
+bool
+FlightSnapshot::Load(Path path, std::chrono::system_clock::duration max_age)
+{
+  if (!File::Exists(path))
+    return false;
+
+  const FileMapping mapping(path);
+  auto r = CacheFileReader::FromChecksummed((const std::byte *)mapping.data(),
+                                            mapping.size());
+
+  const auto header = r.ReadT<FlightSnapshotHeader>();
+  if (header.magic != FlightSnapshotHeader::MAGIC ||
+      header.version != FlightSnapshotHeader::VERSION ||
+      header.layout != layout)
+    return false;
+
+  const auto now = std::chrono::system_clock::now();
+  const auto time = std::chrono::system_clock::from_time_t(header.time);
+  if (time > now || now - time > max_age)
+    return false;
+
+  flight = r.ReadT<FlyingState>();
+  circling = r.ReadT<CirclingInfo>();
+  climb_history = r.ReadT<ClimbHistory>();
+  thermal_encounter_band = r.ReadT<ThermalEncounterBand>();
+  thermal_encounter_collection = r.ReadT<ThermalEncounterCollection>();
+  contest_stats = r.ReadT<ContestStatistics>();
+
+  flying_computer = r.ReadT<FlyingComputer>();
+  circling_computer = r.ReadT<CirclingComputer>();
+  wind_measurements = r.ReadT<WindMeasurementList>();
+  ReadFlightStatistics(r, flight_statistics);
+
+  if (header.n_trace_points > r.GetRemaining() / sizeof(TracePoint))
+    throw std::runtime_error("Malformed flight snapshot");
+
+  trace.resize(header.n_trace_points);
+  memcpy(trace.data(), r.Read(trace.size() * sizeof(TracePoint)),
+         trace.size() * sizeof(TracePoint));
+
+  if (header.n_task_points >
+      r.GetRemaining() / sizeof(FlightSnapshotTaskPoint))
+    throw std::runtime_error("Malformed flight snapshot");
+
+  task.active_task_point = header.active_task_point;
+  task.points.resize(header.n_task_points);
+
+  for (auto &i : task.points) {
+    const auto record = r.ReadT<FlightSnapshotTaskPoint>();
+    if (record.n_samples > r.GetRemaining() / sizeof(GeoPoint))
+      throw std::runtime_error("Malformed flight snapshot");
+
+    i.location = record.location;
+    i.entered = record.entered;
+    i.has_exited = record.has_exited;
+    i.samples.resize(record.n_samples);
+    memcpy(i.samples.data(), r.Read(i.samples.size() * sizeof(GeoPoint)),
+           i.samples.size() * sizeof(GeoPoint));
+  }
+
+  if (r.GetRemaining() > 0)
+    throw std::runtime_error("Malformed flight snapshot");
+
+  return true;
+}
@@ -0,0 +1,96 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_FLIGHT_SNAPSHOT_HPP
+#define XCSOAR_FLIGHT_SNAPSHOT_HPP
+
+#include "NMEA/FlyingState.hpp"
+#include "NMEA/CirclingInfo.hpp"
+#include "NMEA/ClimbHistory.hpp"
+#include "Engine/ThermalBand/ThermalEncounterBand.hpp"
+#include "Engine/ThermalBand/ThermalEncounterCollection.hpp"
+#include "Engine/Contest/ContestStatistics.hpp"
+#include "Engine/Trace/Vector.hpp"
+#include "Engine/Task/Ordered/Progress.hpp"
+#include "FlyingComputer.hpp"
+#include "CirclingComputer.hpp"
+#include "Wind/MeasurementList.hpp"
+#include "FlightStatistics.hpp"
+
+#include <chrono>
+
+class Path;
+
+/**
+ * The state of the #GlideComputer which is expensive or impossible
+ * to rebuild during the flight: the trace, the wind measurements,
+ * the thermal band, the flight statistics and the progress along the
+ * ordered task.  It is saved periodically, and restored when the
+ * program is restarted in the middle of a flight (e.g. after a crash
+ * or a power glitch), so scoring and statistics continue where they
+ * were.
+ *
+ * The file format is a raw dump of these structures; it can only be
+ * read by the same build of XCSoar.
+ */
+struct FlightSnapshot {
+  /* copies of DerivedInfo attributes */
+  FlyingState flight;
+  CirclingInfo circling;
+  ClimbHistory climb_history;
+  ThermalEncounterBand thermal_encounter_band;
+  ThermalEncounterCollection thermal_encounter_collection;
+  ContestStatistics contest_stats;
+
+  /* the state of sub-computers */
+  FlyingComputer flying_computer;
+  CirclingComputer circling_computer;
+  WindMeasurementList wind_measurements;
+  FlightStatistics flight_statistics;
+
+  /** the full trace, see TraceComputer::GetFull() */
+  TracePointVector trace;
+
+  OrderedTaskProgress task;
+
+  /**
+   * Write the snapshot to a file, replacing it atomically.
+   *
+   * Throws on error.
+   */
+  void Save(Path path) const;
+
+  /**
+   * Load a snapshot written by Save().
+   *
+   * Throws on error.
+   *
+   * @param max_age ignore snapshots which were written longer ago
+   * than this
+   * @return false if the file does not exist, is too old or was
+   * written by a different build
+   */
+  bool Load(Path path, std::chrono::system_clock::duration max_age);
+};
+
+#endif
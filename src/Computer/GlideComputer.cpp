@@ -26,12 +26,12 @@ Copyright_License {
 #include "NMEA/Derived.hpp"
 #include "ConditionMonitor/ConditionMonitors.hpp"
 #include "GlideComputerInterface.hpp"
+#include "ContestJob.hpp"
+#include "FlightSnapshot.hpp"
 #include "Engine/Waypoint/Waypoints.hpp"
 
 using namespace std::chrono;
 
-static PeriodClock last_team_code_update;
-
 GlideComputer::GlideComputer(const ComputerSettings &_settings,
                              const Waypoints &_way_points,
                              Airspaces &_airspace_database,
@@ -39,7 +39,8 @@ GlideComputer::GlideComputer(const ComputerSettings &_settings,
                              GlideComputerTaskEvents& events)
   :air_data_computer(_way_points),
    warning_computer(_settings.airspace.warnings, _airspace_database),
-   task_computer(task, _airspace_database, &warning_computer.GetManager()),
+   task_computer(task, _way_points, _airspace_database,
+                 &warning_computer.GetManager()),
    waypoints(_way_points),
    retrospective(_way_points),
    team_code_ref_id(-1)
@@ -65,6 +66,40 @@ GlideComputer::ResetFlight(const bool full)
   trace_history_time.Reset();
 }
 
+void
+GlideComputer::SaveSnapshot(FlightSnapshot &snapshot) const
+{
+  const DerivedInfo &calculated = Calculated();
+  snapshot.flight = calculated.flight;
+  snapshot.circling = calculated;
+  snapshot.climb_history = calculated.climb_history;
+  snapshot.thermal_encounter_band = calculated.thermal_encounter_band;
+  snapshot.thermal_encounter_collection =
+    calculated.thermal_encounter_collection;
+  snapshot.contest_stats = calculated.contest_stats;
+
+  air_data_computer.SaveSnapshot(snapshot);
+  snapshot.flight_statistics.CopyFrom(stats_computer.GetFlightStats());
+  task_computer.SaveSnapshot(snapshot);
+}
+
+void
+GlideComputer::LoadSnapshot(const FlightSnapshot &snapshot)
+{
+  DerivedInfo &calculated = SetCalculated();
+  calculated.flight = snapshot.flight;
+  (CirclingInfo &)calculated = snapshot.circling;
+  calculated.climb_history = snapshot.climb_history;
+  calculated.thermal_encounter_band = snapshot.thermal_encounter_band;
+  calculated.thermal_encounter_collection =
+    snapshot.thermal_encounter_collection;
+  calculated.contest_stats = snapshot.contest_stats;
+
+  air_data_computer.LoadSnapshot(snapshot);
+  stats_computer.GetFlightStats().CopyFrom(snapshot.flight_statistics);
+  task_computer.LoadSnapshot(snapshot, GetComputerSettings());
+}
+
 void
 GlideComputer::Initialise()
 {
@@ -80,6 +115,8 @@ GlideComputer::ProcessGPS(bool force)
 
   const bool last_flying = calculated.flight.flying;
 
+  scheduler.BeginCycle();
+
   if (basic.time_available) {
     /* use UTC offset to calculate local time */
     const auto utc_offset = settings.utc_offset.ToDuration();
@@ -98,21 +135,25 @@ GlideComputer::ProcessGPS(bool force)
   calculated.Expire(basic.clock);
 
   // Process basic information
-  air_data_computer.ProcessBasic(Basic(), SetCalculated(),
-                                 settings);
+  scheduler.Run(ComputerScheduler::Job::AIR_DATA, [&]{
+    air_data_computer.ProcessBasic(basic, calculated, settings);
+  });
 
   // Process basic task information
   const bool last_finished = calculated.ordered_task_stats.task_finished;
 
-  task_computer.ProcessBasicTask(basic,
-                                 calculated,
-                                 settings,
-                                 force);
+  scheduler.Run(ComputerScheduler::Job::TASK, [&]{
+    task_computer.ProcessBasicTask(basic, calculated, settings, force);
+  });
 
   CalculateWorkingBand();
 
   task_computer.ProcessMoreTask(basic, calculated, settings);
 
+  scheduler.Run(ComputerScheduler::Job::ROUTE, [&]{
+    task_computer.ProcessRoute(basic, calculated, settings);
+  }, force);
+
   if (!last_finished && calculated.ordered_task_stats.task_finished)
     OnFinishTask();
 
@@ -125,9 +166,9 @@ GlideComputer::ProcessGPS(bool force)
   task_computer.ProcessAutoTask(basic, calculated);
 
   // Process extended information
-  air_data_computer.ProcessVertical(Basic(),
-                                    SetCalculated(),
-                                    settings);
+  scheduler.Run(ComputerScheduler::Job::VERTICAL, [&]{
+    air_data_computer.ProcessVertical(basic, calculated, settings);
+  });
 
   stats_computer.ProcessClimbEvents(calculated);
 
@@ -163,23 +204,78 @@ GlideComputer::ProcessIdle(bool exhaustive)
 {
   const MoreData &basic = Basic();
   DerivedInfo &calculated = SetCalculated();
+  const ComputerSettings &settings = GetComputerSettings();
 
   // Log GPS fixes for internal usage
   // (snail trail, stats, contest, ...)
-  stats_computer.DoLogging(basic, calculated);
-  log_computer.Run(basic, calculated, GetComputerSettings().logger);
-
-  task_computer.ProcessIdle(basic, calculated, GetComputerSettings(),
-                            exhaustive);
-
-  warning_computer.Update(GetComputerSettings(), basic,
-                          calculated, calculated.airspace_warnings);
+  scheduler.Run(ComputerScheduler::Job::LOG, [&]{
+    stats_computer.DoLogging(basic, calculated);
+    log_computer.Run(basic, calculated, settings.logger);
+  });
+
+  /* in threaded mode, the contest is solved by a #ContestJob during
+     the flight */
+  if (!threaded || !calculated.flight.flying || exhaustive)
+    scheduler.Run(ComputerScheduler::Job::CONTEST, [&]{
+      task_computer.ProcessContest(basic, calculated, settings, exhaustive);
+    }, exhaustive);
+
+  scheduler.Run(ComputerScheduler::Job::TASK_IDLE, [&]{
+    task_computer.ProcessIdle(basic, calculated);
+  }, exhaustive);
+
+  scheduler.Run(ComputerScheduler::Job::WARNING, [&]{
+    warning_computer.Update(settings, basic,
+                            calculated, calculated.airspace_warnings);
+  });
 
   // Calculate summary of flight
   if (basic.location_available)
     retrospective.UpdateSample(basic.location);
 }
 
+bool
+GlideComputer::PrepareContestJob(ContestJob &job)
+{
+  const ContestSettings &settings = GetComputerSettings().contest;
+
+  if (contest_job_pending) {
+    contest_job_pending = false;
+    contest_job_final = true;
+    job.Prepare(settings, TracePoint::Invalid(), true);
+    return true;
+  }
+
+  /* while saving power, throttle the intermediate searches like the
+     deferrable ComputerScheduler jobs */
+  if (threaded && settings.enable && Calculated().flight.flying &&
+      (!scheduler.IsPowerSaving() ||
+       contest_job_clock.CheckUpdate(ComputerScheduler::POWER_SAVING_INTERVAL))) {
+    contest_job_final = false;
+    job.Prepare(settings,
+                task_computer.GetContestPrediction(settings, Basic(),
+                                                   Calculated()),
+                false);
+    return true;
+  }
+
+  return false;
+}
+
+void
+GlideComputer::SetContestJobResult(const ContestJob &job)
+{
+  /* discard a final result if the aircraft has taken off again, and
+     an intermediate one if it has landed meanwhile */
+  if (Calculated().flight.flying == contest_job_final)
+    return;
+
+  if (contest_job_final)
+    task_computer.SetContestFinal(job.GetStats());
+
+  SetCalculated().contest_stats = job.GetStats();
+}
+
 bool
 GlideComputer::DetermineTeamCodeRefLocation()
 {
@@ -208,7 +304,7 @@ GlideComputer::CalculateOwnTeamCode()
     return;
 
   // Only calculate every 10sec otherwise cancel calculation
-  if (!last_team_code_update.CheckUpdate(seconds(10)))
+  if (!team_code_clock.CheckUpdate(seconds(10)))
     return;
 
   // Get bearing and distance to the reference waypoint
@@ -290,6 +386,11 @@ GlideComputer::OnTakeoff()
 
   // save stats in case we never finish
   SaveFinish();
+
+  // resume the incremental contest search
+  contest_job_pending = false;
+  task_computer.ClearContestFinal();
+  contest_job_clock.Reset();
 }
 
 inline void
@@ -300,6 +401,8 @@ GlideComputer::OnLanding()
 
   if (Calculated().ordered_task_stats.task_finished)
     RestoreFinish();
+
+  contest_job_pending = GetComputerSettings().contest.enable;
 }
 
 inline void
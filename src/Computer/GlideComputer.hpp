@@ -33,6 +33,7 @@ Copyright_License {
 #include "LogComputer.hpp"
 #include "WarningComputer.hpp"
 #include "CuComputer.hpp"
+#include "ComputerScheduler.hpp"
 #include "util/Compiler.h"
 #include "Engine/Contest/Solvers/Retrospective.hpp"
 
@@ -40,6 +41,9 @@ class Waypoints;
 class ProtectedTaskManager;
 class GlideComputerTaskEvents;
 class RasterTerrain;
+class ContestJob;
+class ThreadPool;
+struct FlightSnapshot;
 
 // TODO: replace copy constructors so copies of these structures
 // do not replicate the large items or items that should be singletons
@@ -54,6 +58,8 @@ class GlideComputer : public GlideComputerBlackboard
   LogComputer log_computer;
   CuComputer cu_computer;
 
+  ComputerScheduler scheduler;
+
   const Waypoints &waypoints;
 
   Retrospective retrospective;
@@ -61,8 +67,36 @@ class GlideComputer : public GlideComputerBlackboard
   bool team_code_ref_found;
   GeoPoint team_code_ref_location;
 
+  /**
+   * Limits the rate of team code updates.
+   */
+  PeriodClock team_code_clock;
+
   PeriodClock idle_clock;
 
+  /**
+   * Set on landing: the exhaustive contest search shall be run by a
+   * #ContestJob.
+   */
+  bool contest_job_pending = false;
+
+  /**
+   * Run the route search and (during the flight) the contest search
+   * in background threads, see SetThreaded().
+   */
+  bool threaded = false;
+
+  /**
+   * Is the #ContestJob which was last prepared the final one (after
+   * landing), as opposed to an intermediate one during the flight?
+   */
+  bool contest_job_final;
+
+  /**
+   * Limits the rate of intermediate contest jobs while saving power.
+   */
+  PeriodClock contest_job_clock;
+
   /**
    * This object is used to check whether to update
    * DerivedInfo::trace_history.
@@ -88,6 +122,20 @@ public:
    */
   void ResetFlight(const bool full=true);
 
+  /**
+   * Copy the state which shall survive a restart of the program into
+   * the given #FlightSnapshot.  Must be called by the calculation
+   * thread (or while it is suspended).
+   */
+  void SaveSnapshot(FlightSnapshot &snapshot) const;
+
+  /**
+   * Restore the state from a #FlightSnapshot saved by an earlier
+   * instance of this program.  Must not be called while the
+   * calculation thread is running.
+   */
+  void LoadSnapshot(const FlightSnapshot &snapshot);
+
   /**
    * Initializes the GlideComputer
    */
@@ -110,14 +158,91 @@ public:
    */
   void ProcessIdle(bool exhaustive=false);
 
+  /**
+   * Run the exhaustive contest search in the calling thread.  The
+   * #CalculationThread uses a #ContestJob instead, see
+   * PrepareContestJob().
+   */
   void ProcessExhaustive() {
     ProcessIdle(true);
   }
 
+  /**
+   * Run the expensive searches which do not need to be synchronous
+   * in background threads: the route search gets its own thread, and
+   * during the flight, the incremental contest search in
+   * ProcessIdle() is moved to a #ContestJob which is fed the new
+   * trace points whenever its previous run has finished.
+   *
+   * Must not be called while the calculation thread is running.
+   */
+  void SetThreaded(bool _threaded) noexcept {
+    threaded = _threaded;
+    task_computer.SetRouteThreaded(threaded);
+  }
+
+  /**
+   * Expand the reach fans in the given (shared) #ThreadPool instead
+   * of a private one.  Must not be called while the calculation
+   * thread is running.
+   */
+  void SetReachThreadPool(ThreadPool *pool) noexcept {
+    task_computer.SetReachThreadPool(pool);
+  }
+
+  /**
+   * Wait until the background route search (if any) is idle.  Call
+   * this after suspending the calculation thread, before modifying
+   * data which the route search reads (e.g. airspaces).
+   */
+  void WaitBackgroundIdle() noexcept {
+    task_computer.WaitRouteIdle();
+  }
+
+  /**
+   * If the aircraft has landed since the last call, or if the next
+   * intermediate search is due during the flight (see
+   * SetThreaded()), copy the flight into the given #ContestJob and
+   * return true.  The caller shall then run the job and pass the
+   * result to SetContestJobResult().
+   */
+  bool PrepareContestJob(ContestJob &job);
+
+  /**
+   * Publish the result of a #ContestJob.  It is discarded if the
+   * aircraft has taken off (or landed) again meanwhile.
+   */
+  void SetContestJobResult(const ContestJob &job);
+
   void OnStartTask();
   void OnFinishTask();
   void OnTransitionEnter();
 
+  /**
+   * Set the time budget of one calculation cycle (ProcessGPS() plus
+   * ProcessIdle()); expensive sub-computers are deferred when it is
+   * exceeded.  Zero (the default) disables deferring.
+   */
+  void SetCycleBudget(ComputerScheduler::Clock::duration budget) {
+    scheduler.SetBudget(budget);
+  }
+
+  /**
+   * Run expensive non-critical sub-computers (route, reach, task
+   * idle, contest) less often to save power.
+   */
+  void SetPowerSaving(bool power_saving) {
+    scheduler.SetPowerSaving(power_saving);
+  }
+
+  /**
+   * Returns a copy of the sub-computer timings.  May be called from
+   * any thread.
+   */
+  ComputerScheduler::Timings GetTimings() const {
+    return scheduler.GetTimings();
+  }
+
   const WindStore &GetWindStore() const {
     return air_data_computer.GetWindStore();
   }
@@ -24,6 +24,7 @@ Copyright_License {
 
 #include "GlideComputerAirData.hpp"
 #include "Settings.hpp"
+#include "FlightSnapshot.hpp"
 #include "Math/LowPassFilter.hpp"
 #include "Terrain/RasterTerrain.hpp"
 #include "ThermalBase.hpp"
@@ -77,6 +78,22 @@ GlideComputerAirData::ResetFlight(DerivedInfo &calculated,
   delta_time.Reset();
 }
 
+void
+GlideComputerAirData::SaveSnapshot(FlightSnapshot &snapshot) const
+{
+  snapshot.flying_computer = flying_computer;
+  snapshot.circling_computer = circling_computer;
+  snapshot.wind_measurements = wind_computer.GetWindStore().GetMeasurements();
+}
+
+void
+GlideComputerAirData::LoadSnapshot(const FlightSnapshot &snapshot)
+{
+  flying_computer = snapshot.flying_computer;
+  circling_computer = snapshot.circling_computer;
+  wind_computer.GetWindStore().RestoreMeasurements(snapshot.wind_measurements);
+}
+
 void
 GlideComputerAirData::ProcessBasic(const MoreData &basic,
                                    DerivedInfo &calculated,
@@ -42,6 +42,7 @@ struct ThermalLocatorInfo;
 class Waypoints;
 class RasterTerrain;
 class GlidePolar;
+struct FlightSnapshot;
 
 // TODO: replace copy constructors so copies of these structures
 // do not replicate the large items or items that should be singletons
@@ -84,6 +85,9 @@ public:
 
   void ResetFlight(DerivedInfo &calculated, const bool full=true);
 
+  void SaveSnapshot(FlightSnapshot &snapshot) const;
+  void LoadSnapshot(const FlightSnapshot &snapshot);
+
   void ResetStats() {
     circling_computer.ResetStats();
   }
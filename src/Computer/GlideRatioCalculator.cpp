@@ -69,13 +69,12 @@ GlideRatioCalculator::Initialize(const ComputerSettings &settings)
   start = -1;
   size = bsize;
   valid = false;
+  errs = 0;
 }
 
 void
 GlideRatioCalculator::Add(unsigned distance, int altitude)
 {
-  static short errs = 0;
-
   if (distance < 3 || distance > 150) { // just ignore, no need to reset rotary
     if (errs > 2) {
       errs = 0;
@@ -55,6 +55,11 @@ class GlideRatioCalculator {
 
   bool valid;
 
+  /**
+   * The number of consecutive implausible distances passed to Add().
+   */
+  short errs;
+
 public:
   void Initialize(const ComputerSettings &settings);
   void Add(unsigned distance, int altitude);
@@ -0,0 +1,102 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_LANDABLE_REACH_HPP
+#define XCSOAR_LANDABLE_REACH_HPP
+
+#include "Engine/Route/ReachResult.hpp"
+#include "Engine/Waypoint/Waypoint.hpp"
+#include "Geo/GeoPoint.hpp"
+#include "util/TrivialArray.hxx"
+
+#include <algorithm>
+
+/**
+ * The terrain reach of one landable (or watched) waypoint.
+ */
+struct LandableReachItem {
+  /** the Waypoint::id */
+  unsigned waypoint_id;
+
+  /**
+   * The location and elevation the reach was calculated for.  They
+   * detect a waypoint which was replaced or reloaded since then.
+   */
+  GeoPoint location;
+  double elevation;
+
+  /**
+   * The arrival altitudes above the waypoint elevation plus the
+   * arrival safety height.
+   */
+  ReachResult reach;
+};
+
+/**
+ * The terrain reach of the landable waypoints nearest to the
+ * aircraft, calculated by the #RouteComputer each time it solves the
+ * reach.  Waypoints which are not in this table must be looked up in
+ * the route planner.
+ */
+struct LandableReach {
+  static constexpr unsigned MAX_ITEMS = 64;
+
+  /** sorted by waypoint id */
+  TrivialArray<LandableReachItem, MAX_ITEMS> items;
+
+  void Clear() noexcept {
+    items.clear();
+  }
+
+  bool IsEmpty() const noexcept {
+    return items.empty();
+  }
+
+  /**
+   * Sort the items by waypoint id, which is required by Find().
+   */
+  void Sort() noexcept {
+    std::sort(items.begin(), items.end(), [](const auto &a, const auto &b){
+      return a.waypoint_id < b.waypoint_id;
+    });
+  }
+
+  /**
+   * Look up the reach of the specified waypoint.
+   *
+   * @return nullptr if the waypoint is not in the table
+   */
+  [[gnu::pure]]
+  const ReachResult *Find(const Waypoint &waypoint) const noexcept {
+    const auto i = std::lower_bound(items.begin(), items.end(), waypoint.id,
+                                    [](const auto &item, unsigned id){
+                                      return item.waypoint_id < id;
+                                    });
+    return i != items.end() && i->waypoint_id == waypoint.id &&
+      i->location == waypoint.location && i->elevation == waypoint.elevation
+      ? &i->reach
+      : nullptr;
+  }
+};
+
+#endif
@@ -23,19 +23,82 @@ Copyright_License {
 */
 
 #include "RouteComputer.hpp"
+#include "RouteThread.hpp"
 #include "Task/ProtectedRoutePlanner.hpp"
 #include "NMEA/MoreData.hpp"
 #include "NMEA/Derived.hpp"
 #include "NMEA/Aircraft.hpp"
 #include "Navigation/Aircraft.hpp"
+#include "Engine/Waypoint/Waypoints.hpp"
+#include "thread/ThreadPool.hpp"
 
 #include <algorithm>
+#include <thread>
 
-RouteComputer::RouteComputer(const Airspaces &airspace_database,
-                             const ProtectedAirspaceWarningManager *warnings)
-  :protected_route_planner(route_planner, airspace_database, warnings),
-   terrain(NULL)
-{}
+/**
+ * More threads do not help much: the fan usually has only a handful
+ * of top-level sectors.
+ */
+static constexpr unsigned MAX_REACH_THREADS = 4;
+
+RouteComputer::RouteComputer(const Waypoints &_waypoints,
+                             const Airspaces &_airspace_database,
+                             const ProtectedAirspaceWarningManager *_warnings)
+  :protected_route_planner(route_planner, _airspace_database, _warnings),
+   waypoints(_waypoints),
+   terrain(NULL),
+   airspace_database(_airspace_database), warnings(_warnings)
+{
+  const unsigned n_threads = std::min(std::thread::hardware_concurrency(),
+                                      MAX_REACH_THREADS);
+  if (n_threads > 1) {
+    reach_thread_pool = std::make_unique<ThreadPool>(n_threads);
+    route_planner.SetThreadPool(reach_thread_pool.get());
+  }
+}
+
+RouteComputer::~RouteComputer() noexcept
+{
+  SetThreaded(false);
+}
+
+void
+RouteComputer::SetThreaded(bool threaded) noexcept
+{
+  if (threaded == (thread != nullptr))
+    return;
+
+  if (threaded) {
+    thread = std::make_unique<RouteThread>(airspace_database, warnings);
+    thread->SetTerrain(terrain);
+  } else {
+    thread->LockStop();
+    thread.reset();
+  }
+}
+
+void
+RouteComputer::SetReachThreadPool(ThreadPool *pool) noexcept
+{
+  route_planner.SetThreadPool(pool);
+  reach_thread_pool.reset();
+}
+
+void
+RouteComputer::WaitIdle() noexcept
+{
+  if (thread != nullptr)
+    thread->LockWaitDone();
+}
+
+void
+RouteComputer::ClearAirspaces()
+{
+  route_planner.Reset();
+
+  if (thread != nullptr)
+    thread->Reset();
+}
 
 void
 RouteComputer::ResetFlight()
@@ -44,6 +107,9 @@ RouteComputer::ResetFlight()
   reach_clock.Reset();
   protected_route_planner.Reset();
 
+  if (thread != nullptr)
+    thread->Reset();
+
   last_task_type = TaskType::NONE;
   last_active_tp = 0;
 }
@@ -53,7 +119,8 @@ RouteComputer::ProcessRoute(const MoreData &basic, DerivedInfo &calculated,
                             const GlideSettings &settings,
                             const RoutePlannerConfig &config,
                             const GlidePolar &glide_polar,
-                            const GlidePolar &safety_polar)
+                            const GlidePolar &safety_polar,
+                            const double safety_height_arrival)
 {
   if (!basic.location_available || !basic.NavAltitudeAvailable())
     return;
@@ -63,8 +130,13 @@ RouteComputer::ProcessRoute(const MoreData &basic, DerivedInfo &calculated,
                                     calculated.GetWindOrZero(),
                                     calculated.common_stats.height_min_working);
 
-  Reach(basic, calculated, config);
-  TerrainWarning(basic, calculated, config);
+  Reach(basic, calculated, config, safety_polar, safety_height_arrival);
+
+  if (thread != nullptr)
+    TerrainWarningThreaded(basic, calculated, settings, config,
+                           glide_polar, safety_polar);
+  else
+    TerrainWarning(basic, calculated, config);
 }
 
 inline void
@@ -125,14 +197,57 @@ RouteComputer::TerrainWarning(const MoreData &basic,
   calculated.terrain_warning_location.SetInvalid();
 }
 
+[[gnu::pure]]
+static bool
+IsLandableOrWatched(const Waypoint &waypoint) noexcept
+{
+  return waypoint.IsLandable() || waypoint.flags.watched;
+}
+
+void
+RouteComputer::UpdateLandableReach(const AircraftState &state,
+                                   DerivedInfo &calculated,
+                                   const GlidePolar &safety_polar,
+                                   const double safety_height_arrival)
+{
+  auto &table = calculated.landable_reach;
+  table.Clear();
+
+  if (route_planner.IsTerrainReachEmpty())
+    return;
+
+  /* landables beyond the still-air glide range cannot be reached;
+     the renderer looks them up in the route planner if necessary */
+  const double range = std::max(state.altitude * safety_polar.GetBestLD(),
+                                10000.);
+
+  waypoints.VisitNearestIf(state.location, range, LandableReach::MAX_ITEMS,
+                           IsLandableOrWatched,
+                           [this, &table, safety_height_arrival](const auto &wp){
+    const double elevation = wp->elevation + safety_height_arrival;
+    auto reach = route_planner.FindPositiveArrival(AGeoPoint(wp->location,
+                                                             elevation));
+    if (!reach)
+      return;
+
+    reach->Subtract(elevation);
+    table.items.push_back({wp->id, wp->location, wp->elevation, *reach});
+  });
+
+  table.Sort();
+}
+
 inline void
 RouteComputer::Reach(const MoreData &basic, DerivedInfo &calculated,
-                     const RoutePlannerConfig &config)
+                     const RoutePlannerConfig &config,
+                     const GlidePolar &safety_polar,
+                     const double safety_height_arrival)
 {
   if (!calculated.terrain_valid) {
     /* without valid terrain information, we cannot calculate
        reachabilty, so let's skip that step completely */
     calculated.terrain_base_valid = false;
+    calculated.landable_reach.Clear();
     protected_route_planner.ClearReach();
     return;
   }
@@ -151,6 +266,9 @@ RouteComputer::Reach(const MoreData &basic, DerivedInfo &calculated,
       calculated.terrain_base = route_planner.GetTerrainBase();
       calculated.terrain_base_valid = true;
     }
+
+    UpdateLandableReach(state, calculated, safety_polar,
+                        safety_height_arrival);
   }
 }
 
@@ -158,4 +276,83 @@ void
 RouteComputer::set_terrain(const RasterTerrain* _terrain) {
   terrain = _terrain;
   protected_route_planner.SetTerrain(terrain);
+
+  if (thread != nullptr)
+    thread->SetTerrain(terrain);
+}
+
+void
+RouteComputer::TerrainWarningThreaded(const MoreData &basic,
+                                      DerivedInfo &calculated,
+                                      const GlideSettings &settings,
+                                      const RoutePlannerConfig &config,
+                                      const GlidePolar &glide_polar,
+                                      const GlidePolar &safety_polar)
+{
+  assert(thread != nullptr);
+
+  /* apply the result which was calculated since the last cycle */
+  if (const auto result = thread->Collect()) {
+    calculated.planned_route = result->planned_route;
+    calculated.terrain_warning_location = result->terrain_warning_location;
+  }
+
+  const GlideResult &sol =
+    calculated.task_stats.current_leg.solution_remaining;
+  if (!sol.IsDefined() || terrain == nullptr) {
+    calculated.terrain_warning_location.SetInvalid();
+    return;
+  }
+
+  if (!thread->IsIdle())
+    /* still busy with the previous request; try again in the next
+       cycle */
+    return;
+
+  /* this is the same logic as in TerrainWarning() */
+
+  bool dirty = route_clock.CheckAdvance(basic.time, PERIOD);
+  if (!dirty) {
+    dirty =
+      calculated.task_stats.active_index != last_active_tp ||
+      calculated.common_stats.task_type != last_task_type;
+    if (dirty)
+      // restart clock
+      route_clock.Reset();
+  }
+
+  last_task_type = calculated.common_stats.task_type;
+  last_active_tp = calculated.task_stats.active_index;
+
+  if (!dirty)
+    return;
+
+  const AircraftState as = ToAircraftState(basic, calculated);
+
+  RouteThread::Request r;
+  r.settings = settings;
+  r.config = config;
+  r.glide_polar = glide_polar;
+  r.safety_polar = safety_polar;
+  r.wind = calculated.GetWindOrZero();
+  r.height_min_working = calculated.common_stats.height_min_working;
+  r.start = AGeoPoint(as.location, as.altitude);
+  r.ceiling = std::max((int)basic.nav_altitude + 500,
+                       (int)calculated.common_stats.height_max_working);
+
+  GeoVector v = sol.vector;
+  if (v.distance > 200000)
+    /* limit to reasonable distances (200km max.) to avoid overflow in
+       GeoVector::EndPoint() */
+    v.distance = 200000;
+
+  r.dest = AGeoPoint(v.EndPoint(r.start), sol.min_arrival_altitude);
+
+  try {
+    thread->Submit(r);
+  } catch (...) {
+    /* failed to launch the thread: calculate synchronously from now
+       on */
+    SetThreaded(false);
+  }
 }
@@ -29,6 +29,8 @@ Copyright_License {
 #include "Engine/Route/RoutePlanner.hpp"
 #include "time/GPSClock.hpp"
 
+#include <memory>
+
 struct MoreData;
 struct DerivedInfo;
 struct GlideSettings;
@@ -36,24 +38,69 @@ struct RoutePlannerConfig;
 class ProtectedAirspaceWarningManager;
 class RasterTerrain;
 class GlidePolar;
+class Waypoints;
+class RouteThread;
+class ThreadPool;
 
 class RouteComputer {
   static constexpr std::chrono::steady_clock::duration PERIOD = std::chrono::seconds(5);
 
+  /**
+   * Expands the reach fans on several cores.  Declared before
+   * #route_planner, which uses it.
+   */
+  std::unique_ptr<ThreadPool> reach_thread_pool;
+
   RoutePlannerGlue route_planner;
   ProtectedRoutePlanner protected_route_planner;
 
   GPSClock route_clock;
   GPSClock reach_clock;
 
+  const Waypoints &waypoints;
+
   const RasterTerrain *terrain;
 
   TaskType last_task_type;
   unsigned last_active_tp;
 
+  const Airspaces &airspace_database;
+  const ProtectedAirspaceWarningManager *const warnings;
+
+  /**
+   * If set, the route search runs in this thread, see SetThreaded().
+   */
+  std::unique_ptr<RouteThread> thread;
+
 public:
-  RouteComputer(const Airspaces &airspace_database,
-                const ProtectedAirspaceWarningManager *warnings);
+  RouteComputer(const Waypoints &_waypoints,
+                const Airspaces &_airspace_database,
+                const ProtectedAirspaceWarningManager *_warnings);
+  ~RouteComputer() noexcept;
+
+  /**
+   * Move the route search to a separate thread.  Its result is then
+   * applied in a later calculation cycle.  The reach is still
+   * calculated synchronously, because the task manager needs it.
+   */
+  void SetThreaded(bool threaded) noexcept;
+
+  /**
+   * Expand the reach fans in the given #ThreadPool instead of the
+   * private one, which is then stopped.  This allows many instances
+   * in one process to share one pool.  Must not be called while a
+   * calculation is running.
+   *
+   * @param pool the pool, or nullptr to expand the fans in the
+   * calling thread
+   */
+  void SetReachThreadPool(ThreadPool *pool) noexcept;
+
+  /**
+   * Wait until the route thread (if any) is idle.  It stays idle
+   * until the next ProcessRoute() call.
+   */
+  void WaitIdle() noexcept;
 
   /**
    * Returns a reference to the unprotected route planner object,
@@ -71,16 +118,15 @@ public:
    * Release all references to airspace objects from the "master"
    * container.  Call this before modifying the container.
    */
-  void ClearAirspaces() {
-    route_planner.Reset();
-  }
+  void ClearAirspaces();
 
   void ResetFlight();
   void ProcessRoute(const MoreData &basic, DerivedInfo &calculated,
                     const GlideSettings &settings,
                     const RoutePlannerConfig &config,
                     const GlidePolar &glide_polar,
-                    const GlidePolar &safety_polar);
+                    const GlidePolar &safety_polar,
+                    double safety_height_arrival);
 
   void set_terrain(const RasterTerrain* _terrain);
 
@@ -89,8 +135,31 @@ private:
                       DerivedInfo &calculated,
                       const RoutePlannerConfig &config);
 
+  /**
+   * The #RouteThread counterpart of TerrainWarning(): apply the
+   * result of the previous request, and submit a new one if
+   * necessary.
+   */
+  void TerrainWarningThreaded(const MoreData &basic,
+                              DerivedInfo &calculated,
+                              const GlideSettings &settings,
+                              const RoutePlannerConfig &config,
+                              const GlidePolar &glide_polar,
+                              const GlidePolar &safety_polar);
+
   void Reach(const MoreData &basic, DerivedInfo &calculated,
-             const RoutePlannerConfig &config);
+             const RoutePlannerConfig &config,
+             const GlidePolar &safety_polar,
+             double safety_height_arrival);
+
+  /**
+   * Look up the nearest landables in the reach which has just been
+   * solved and store them in DerivedInfo::landable_reach.
+   */
+  void UpdateLandableReach(const AircraftState &state,
+                           DerivedInfo &calculated,
+                           const GlidePolar &safety_polar,
+                           double safety_height_arrival);
 };
 
 #endif
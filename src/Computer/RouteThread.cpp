@@ -0,0 +1,94 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "RouteThread.hpp"
+
+#include <cassert>
+#include <utility>
+
+void
+RouteThread::SetTerrain(const RasterTerrain *terrain) noexcept
+{
+  std::unique_lock<Mutex> lock(mutex);
+  WaitDone(lock);
+  planner.SetTerrain(terrain);
+}
+
+void
+RouteThread::Reset() noexcept
+{
+  std::unique_lock<Mutex> lock(mutex);
+  WaitDone(lock);
+  planner.Reset();
+  result.reset();
+}
+
+void
+RouteThread::Submit(const Request &_request)
+{
+  const std::lock_guard<Mutex> lock(mutex);
+  assert(!IsBusy());
+
+  request = _request;
+  result.reset();
+  Trigger();
+}
+
+std::optional<RouteThread::Result>
+RouteThread::Collect() noexcept
+{
+  const std::lock_guard<Mutex> lock(mutex);
+  if (IsBusy())
+    return std::nullopt;
+
+  return std::exchange(result, std::nullopt);
+}
+
+void
+RouteThread::Tick() noexcept
+{
+  if (!low_priority) {
+    SetLowPriority();
+    low_priority = true;
+  }
+
+  const Request r = request;
+
+  Result new_result;
+
+  {
+    const ScopeUnlock unlock(mutex);
+
+    planner.UpdatePolar(r.settings, r.config, r.glide_polar, r.safety_polar,
+                        r.wind, r.height_min_working);
+    if (r.config.IsAirspaceEnabled())
+      planner.Synchronise(airspaces, warnings, r.dest, r.start);
+    planner.Solve(r.dest, r.start, r.config, r.ceiling);
+
+    new_result.planned_route = planner.GetSolution();
+    new_result.terrain_warning_location =
+      planner.Intersection(r.start, r.dest);
+  }
+
+  result = new_result;
+}
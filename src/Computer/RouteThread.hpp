@@ -0,0 +1,138 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_ROUTE_THREAD_HPP
+#define XCSOAR_ROUTE_THREAD_HPP
+
+#include "thread/StandbyThread.hpp"
+#include "Task/RoutePlannerGlue.hpp"
+#include "Engine/GlideSolvers/GlideSettings.hpp"
+#include "Engine/GlideSolvers/GlidePolar.hpp"
+#include "Engine/Route/Config.hpp"
+#include "Engine/Route/Route.hpp"
+#include "Geo/SpeedVector.hpp"
+
+#include <optional>
+
+class Airspaces;
+class ProtectedAirspaceWarningManager;
+class RasterTerrain;
+
+/**
+ * Runs the route search of the #RouteComputer in a separate thread,
+ * so it does not delay the other calculations.
+ *
+ * It has its own #RoutePlannerGlue instance: the shared one is also
+ * used by the task manager (abort task) and the map, and its reach
+ * must remain available to them synchronously.
+ *
+ * The #RouteComputer submits a #Request (a snapshot of all inputs)
+ * with Submit(), and picks up the #Result with Collect() in a later
+ * calculation cycle.
+ */
+class RouteThread final : private StandbyThread {
+public:
+  struct Request {
+    GlideSettings settings;
+    RoutePlannerConfig config;
+    GlidePolar glide_polar, safety_polar;
+    SpeedVector wind;
+    int height_min_working;
+
+    AGeoPoint start, dest;
+    int ceiling;
+  };
+
+  struct Result {
+    StaticRoute planned_route;
+    GeoPoint terrain_warning_location;
+  };
+
+private:
+  const Airspaces &airspaces;
+  const ProtectedAirspaceWarningManager *const warnings;
+
+  /**
+   * Only used by this thread while it is busy, and by the client
+   * while it is idle.
+   */
+  RoutePlannerGlue planner;
+
+  Request request;
+
+  std::optional<Result> result;
+
+  /**
+   * Has the priority of this thread been lowered already?  Only
+   * accessed by the thread itself.
+   */
+  bool low_priority = false;
+
+public:
+  RouteThread(const Airspaces &_airspaces,
+              const ProtectedAirspaceWarningManager *_warnings) noexcept
+    :StandbyThread("Route"), airspaces(_airspaces), warnings(_warnings) {}
+
+  using StandbyThread::LockStop;
+  using StandbyThread::LockWaitDone;
+
+  /**
+   * Is the thread idle, i.e. may Submit() be called?
+   */
+  [[gnu::pure]]
+  bool IsIdle() noexcept {
+    const std::lock_guard<Mutex> lock(mutex);
+    return !IsBusy();
+  }
+
+  /**
+   * Wait until the thread is idle, and then change the terrain.
+   */
+  void SetTerrain(const RasterTerrain *terrain) noexcept;
+
+  /**
+   * Wait until the thread is idle, and then forget the route and all
+   * references to airspace objects of the "master" container.
+   */
+  void Reset() noexcept;
+
+  /**
+   * Start working on the given request.  Must not be called while
+   * the thread is busy.
+   *
+   * Throws on error.
+   */
+  void Submit(const Request &_request);
+
+  /**
+   * Returns the result of the last request if it has been finished
+   * since the last call.
+   */
+  std::optional<Result> Collect() noexcept;
+
+private:
+  /* virtual methods from class StandbyThread */
+  void Tick() noexcept override;
+};
+
+#endif
@@ -30,6 +30,7 @@ Copyright_License {
 #include "NMEA/MoreData.hpp"
 #include "NMEA/Derived.hpp"
 #include "Settings.hpp"
+#include "FlightSnapshot.hpp"
 
 #include <algorithm>
 
@@ -40,10 +41,11 @@ using namespace std::chrono;
 // call any event
 
 TaskComputer::TaskComputer(ProtectedTaskManager &_task,
+                           const Waypoints &waypoints,
                            const Airspaces &airspace_database,
                            const ProtectedAirspaceWarningManager *warnings)
   :task(_task),
-   route(airspace_database, warnings),
+   route(waypoints, airspace_database, warnings),
    contest(trace.GetFull(), trace.GetContest(), trace.GetSprint())
 {
   task.SetRoutePlanner(&route.GetRoutePlanner());
@@ -63,6 +65,25 @@ TaskComputer::ResetFlight(const bool full)
   last_location_available.Clear();
 }
 
+void
+TaskComputer::SaveSnapshot(FlightSnapshot &snapshot) const
+{
+  trace.LockedCopyTo(snapshot.trace);
+
+  ProtectedTaskManager::Lease _task(task);
+  snapshot.task = _task->GetOrderedTask().GetProgress();
+}
+
+void
+TaskComputer::LoadSnapshot(const FlightSnapshot &snapshot,
+                           const ComputerSettings &settings_computer)
+{
+  trace.Restore(settings_computer, snapshot.trace);
+
+  ProtectedTaskManager::ExclusiveLease _task(task);
+  _task->RestoreOrderedTaskProgress(snapshot.task);
+}
+
 void
 TaskComputer::ProcessBasicTask(const MoreData &basic,
                                DerivedInfo &calculated,
@@ -107,14 +128,6 @@ TaskComputer::ProcessMoreTask(const MoreData &basic,
                               DerivedInfo &calculated,
                               const ComputerSettings &settings_computer)
 {
-  const GlidePolar &glide_polar = settings_computer.polar.glide_polar_task;
-  const GlidePolar &safety_polar = calculated.glide_polar_safety;
-
-  route.ProcessRoute(basic, calculated,
-                     settings_computer.task.glide,
-                     settings_computer.task.route_planner,
-                     glide_polar, safety_polar);
-
   if (settings_computer.features.block_stf_enabled)
     calculated.V_stf = calculated.common_stats.V_block;
   else
@@ -126,6 +139,20 @@ TaskComputer::ProcessMoreTask(const MoreData &basic,
   }
 }
 
+void
+TaskComputer::ProcessRoute(const MoreData &basic, DerivedInfo &calculated,
+                           const ComputerSettings &settings_computer)
+{
+  const GlidePolar &glide_polar = settings_computer.polar.glide_polar_task;
+  const GlidePolar &safety_polar = calculated.glide_polar_safety;
+
+  route.ProcessRoute(basic, calculated,
+                     settings_computer.task.glide,
+                     settings_computer.task.route_planner,
+                     glide_polar, safety_polar,
+                     settings_computer.task.safety_height_arrival);
+}
+
 gcc_pure
 static TracePoint
 Predicted(const ContestSettings &settings,
@@ -146,20 +173,32 @@ Predicted(const ContestSettings &settings,
                     0, 0);
 }
 
+TracePoint
+TaskComputer::GetContestPrediction(const ContestSettings &settings,
+                                   const MoreData &basic,
+                                   const DerivedInfo &calculated) const noexcept
+{
+  return Predicted(settings, basic, calculated.task_stats.current_leg);
+}
+
 void
-TaskComputer::ProcessIdle(const MoreData &basic, DerivedInfo &calculated,
-                          const ComputerSettings &settings_computer,
-                          bool exhaustive)
+TaskComputer::ProcessContest(const MoreData &basic, DerivedInfo &calculated,
+                             const ComputerSettings &settings_computer,
+                             bool exhaustive)
 {
-  contest.SetPredicted(Predicted(settings_computer.contest, basic,
-                                 calculated.task_stats.current_leg));
+  contest.SetPredicted(GetContestPrediction(settings_computer.contest,
+                                            basic, calculated));
 
   if (exhaustive)
     contest.SolveExhaustive(settings_computer.contest,
                             calculated.contest_stats);
   else
     contest.Solve(settings_computer.contest, calculated.contest_stats);
+}
 
+void
+TaskComputer::ProcessIdle(const MoreData &basic, const DerivedInfo &calculated)
+{
   const AircraftState as = ToAircraftState(basic, calculated);
 
   ProtectedTaskManager::ExclusiveLease _task(task);
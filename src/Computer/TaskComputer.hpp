@@ -33,6 +33,7 @@ Copyright_License {
 struct NMEAInfo;
 class ProtectedTaskManager;
 class ProtectedAirspaceWarningManager;
+struct FlightSnapshot;
 
 class TaskComputer
 {
@@ -53,6 +54,7 @@ class TaskComputer
 
 public:
   TaskComputer(ProtectedTaskManager &_task,
+               const Waypoints &waypoints,
                const Airspaces &airspace_database,
                const ProtectedAirspaceWarningManager *warnings);
 
@@ -89,22 +91,81 @@ public:
   void ProcessMoreTask(const MoreData &basic, DerivedInfo &calculated,
                        const ComputerSettings &settings_computer);
 
+  /**
+   * Update the route and the reach.  This is the expensive part of
+   * the per-fix task processing, and may be deferred by the caller.
+   */
+  void ProcessRoute(const MoreData &basic, DerivedInfo &calculated,
+                    const ComputerSettings &settings_computer);
+
   void ResetFlight(const bool full=true);
 
+  void SaveSnapshot(FlightSnapshot &snapshot) const;
+  void LoadSnapshot(const FlightSnapshot &snapshot,
+                    const ComputerSettings &settings_computer);
+
   void SetTerrain(const RasterTerrain* _terrain);
 
   void SetContestIncremental(bool incremental) {
     contest.SetIncremental(incremental);
   }
 
+  /**
+   * @see ContestComputer::SetFinal()
+   */
+  void SetContestFinal(const ContestStatistics &stats) {
+    contest.SetFinal(stats);
+  }
+
+  void ClearContestFinal() {
+    contest.ClearFinal();
+  }
+
+  /**
+   * Move the route search to a separate thread.
+   *
+   * @see RouteComputer::SetThreaded()
+   */
+  void SetRouteThreaded(bool threaded) noexcept {
+    route.SetThreaded(threaded);
+  }
+
+  /**
+   * @see RouteComputer::SetReachThreadPool()
+   */
+  void SetReachThreadPool(ThreadPool *pool) noexcept {
+    route.SetReachThreadPool(pool);
+  }
+
+  /**
+   * @see RouteComputer::WaitIdle()
+   */
+  void WaitRouteIdle() noexcept {
+    route.WaitIdle();
+  }
+
+  /**
+   * Returns the predicted contest point, i.e. the next task point at
+   * the calculated arrival time and altitude (or an invalid point).
+   */
+  [[gnu::pure]]
+  TracePoint GetContestPrediction(const ContestSettings &settings,
+                                  const MoreData &basic,
+                                  const DerivedInfo &calculated) const noexcept;
+
   /**
    * Auto-create a task on takeoff that leads back home.
    */
   void ProcessAutoTask(const NMEAInfo &basic, const DerivedInfo &calculated);
 
-  void ProcessIdle(const MoreData &basic, DerivedInfo &calculated,
-                   const ComputerSettings &settings_computer,
-                   bool exhaustive=false);
+  void ProcessIdle(const MoreData &basic, const DerivedInfo &calculated);
+
+  /**
+   * Continue the contest optimisation.
+   */
+  void ProcessContest(const MoreData &basic, DerivedInfo &calculated,
+                      const ComputerSettings &settings_computer,
+                      bool exhaustive=false);
 };
 
 #endif
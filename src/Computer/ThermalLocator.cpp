@@ -24,36 +24,15 @@ Copyright_License {
 #include "ThermalLocator.hpp"
 #include "Geo/Math.hpp"
 #include "Geo/SpeedVector.hpp"
-#include "Geo/Flat/FlatProjection.hpp"
-#include "Math/FastMath.hpp"
 #include "NMEA/ThermalLocator.hpp"
 
 #include <algorithm>
 
-#include <cassert>
-
-using namespace std::chrono;
-
-inline void
-ThermalLocator::Point::Drift(TimeStamp t, const FlatProjection &projection,
-                             const GeoPoint& wind_drift)
-{
-  const auto dt = t - t_0;
-
-  // thermal decay function is located in GenerateSineTables.cpp
-  recency_weight = thermal_recency_fn(duration_cast<duration<unsigned>>(abs(dt)).count());
-  lift_weight = w*recency_weight;
-
-  GeoPoint p = location + wind_drift * dt.count();
-
-  // convert to flat earth coordinates
-  loc_drift = projection.ProjectFloat(p);
-}
+#include <cmath>
 
 void
 ThermalLocator::Reset()
 {
-  n_index = 0;
   n_points = 0;
 }
 
@@ -61,14 +40,30 @@ inline void
 ThermalLocator::AddPoint(const TimeStamp t, const GeoPoint &location,
                          const double w) noexcept
 {
-  points[n_index].location = location;
-  points[n_index].t_0 = t;
-  points[n_index].w = std::max(w, -0.1);
-  // lift_weight and recency_weight are set by Drift()
+  if (n_points > 0 && t < t_last)
+    /* time warp */
+    Reset();
 
-  n_index = (n_index + 1) % TLOCATOR_NMAX;
+  if (n_points == 0) {
+    projection.SetCenter(location);
+    t_start = t_last = t;
+    sum_w = sum_wt = 0;
+    sum_wp = FlatPoint(0, 0);
+  } else {
+    /* apply the recency weighting to all older samples */
+    const double decay = std::exp(-((t - t_last) / RECENCY_TIME));
+    sum_w *= decay;
+    sum_wp = sum_wp * decay;
+    sum_wt *= decay;
+    t_last = t;
+  }
 
-  if (n_points < TLOCATOR_NMAX)
+  const double lift_weight = std::max(w, -0.1);
+  sum_w += lift_weight;
+  sum_wp += projection.ProjectFloat(location) * lift_weight;
+  sum_wt += (t - t_start).count() * lift_weight;
+
+  if (n_points < TLOCATOR_NMIN)
     n_points++;
 }
 
@@ -78,71 +73,26 @@ ThermalLocator::Update(const TimeStamp t_0,
                        const SpeedVector wind, 
                        ThermalLocatorInfo &therm)
 {
-  if (n_points < TLOCATOR_NMIN) {
+  if (n_points < TLOCATOR_NMIN || sum_w <= 0) {
     therm.estimate_valid = false;
-    return; // nothing to do.
+    return;
   }
 
+  /* the distance the air mass drifts in one second */
   GeoPoint dloc = FindLatitudeLongitude(location_0, wind.bearing, wind.norm);
+  const FlatPoint drift = projection.ProjectFloat(location_0) -
+    projection.ProjectFloat(dloc);
 
-  const FlatProjection projection(location_0);
-
-  // drift points 
-  Drift(t_0, projection, location_0 - dloc);
-
-  FlatPoint av = glider_average();
-  // find thermal center relative to glider's average position
-
-  FlatPoint f0(0, 0);
-  double acc = 0;
-  for (unsigned i = 0; i < n_points; ++i) {
-    f0 += (points[i].loc_drift-av)*points[i].lift_weight;
-    acc += points[i].lift_weight;
-  }
-
-  // if sufficient data, estimate location
-
-  if (acc <= 0) {
-    therm.estimate_valid = false;
-    return;
-  }
-  f0 = f0 * (1. / acc) + av;
+  /* each sample drifts with the wind for its age; for the weighted
+     centroid, this amounts to drifting the centroid for the weighted
+     average age */
+  const double age = (t_0 - t_start).count() - sum_wt / sum_w;
+  const FlatPoint f0 = sum_wp * (1. / sum_w) + drift * age;
 
   therm.estimate_location = projection.Unproject(f0);
   therm.estimate_valid = true;
 }
 
-inline FlatPoint
-ThermalLocator::glider_average()
-{
-  FlatPoint result(0, 0);
-  assert(n_points>0);
-  if (n_points == 0)
-    return result;
-
-  // find glider's average position
-  double acc = 0;
-  for (unsigned i = 0; i < n_points; ++i) {
-    result += points[i].loc_drift*points[i].recency_weight;
-    acc += points[i].recency_weight;
-  }
-
-  if (acc > 0) {
-    result.x /= acc;
-    result.y /= acc;
-  }
-
-  return result;
-}
-
-inline void
-ThermalLocator::Drift(const TimeStamp t_0, const FlatProjection &projection,
-                      const GeoPoint& traildrift)
-{
-  for (unsigned i = 0; i < n_points; ++i)
-    points[i].Drift(t_0, projection, traildrift);
-}
-
 void
 ThermalLocator::Process(const bool circling, const TimeStamp time,
                         const GeoPoint &location, const double w,
@@ -26,56 +26,57 @@ Copyright_License {
 
 #include "Geo/GeoPoint.hpp"
 #include "Geo/Flat/FlatPoint.hpp"
+#include "Geo/Flat/FlatProjection.hpp"
 #include "time/Stamp.hpp"
 
 struct SpeedVector;
-class FlatProjection;
 struct ThermalLocatorInfo;
 
 /**
  * Class to estimate the location of the center of a thermal
  * when circling.
+ *
+ * The estimate is the lift-weighted centroid of all samples, drifted
+ * with the wind.  Samples are weighted by an exponential recency
+ * function, which allows maintaining running sums instead of a
+ * sample buffer: each sample is O(1), and the wind drift is applied
+ * to the sums when the estimate is calculated.
  */
 class ThermalLocator {
 public:
   static constexpr unsigned TLOCATOR_NMIN = 5;
-  static constexpr unsigned TLOCATOR_NMAX = 60;
+
+  /**
+   * The time constant of the recency weighting.
+   */
+  static constexpr FloatDuration RECENCY_TIME = std::chrono::seconds{30};
 
 private:
-  /** Class used to hold thermal estimate samples */
-  struct Point 
-  {
-    /** 
-     * Calculate drifted, weighted values of point
-     * 
-     * @param t Current time
-     * @param location_0 Initial location
-     * @param wind_drift Wind drift offset
-     * @param decay decay factor for weighting
-     */
-    void Drift(TimeStamp t, const FlatProjection &projection,
-               const GeoPoint& wind_drift);
-
-    /** Actual location of sample */
-    GeoPoint location;
-    /** Projected/drifted sample */
-    FlatPoint loc_drift;
-    /** Time of sample (s) */
-    TimeStamp t_0;
-    /** Scaled updraft value of sample */
-    double w;
-    /** Lift weighting used for this point */
-    double lift_weight;
-    /** Recency weighting used for this point */
-    double recency_weight;
-  };
-
-  /** Circular buffer of points */
-  Point points[TLOCATOR_NMAX];
-
-  /** Index of next point to add */
-  unsigned n_index;
-  /** Number of points in buffer */
+  /**
+   * The projection of all samples.  Its center is the first sample
+   * after Reset().
+   */
+  FlatProjection projection;
+
+  /**
+   * Time of the first sample; sample times in #sum_wt are relative
+   * to this.
+   */
+  TimeStamp t_start;
+
+  /**
+   * Time of the newest sample; the sums are decayed to this time.
+   */
+  TimeStamp t_last;
+
+  /** Sum of the lift weights */
+  double sum_w;
+  /** Sum of the lift weighted projected sample locations */
+  FlatPoint sum_wp;
+  /** Sum of the lift weighted sample times (s since #t_start) */
+  double sum_wt;
+
+  /** Number of samples since Reset() */
   unsigned n_points;
 
 public:
@@ -100,14 +101,9 @@ public:
   void Reset();
 
 private:
-  FlatPoint glider_average();
-
   void AddPoint(TimeStamp t, const GeoPoint &location, double w) noexcept;
   void Update(TimeStamp t_0, const GeoPoint &location_0,
               SpeedVector wind, ThermalLocatorInfo &therm);
-
-  void Drift(TimeStamp t_0, const FlatProjection &projection,
-             const GeoPoint &traildrift);
 };
 
 #endif
@@ -99,3 +99,23 @@ TraceComputer::Update(const ComputerSettings &settings_computer,
     contest.push_back(point);
   }
 }
+
+void
+TraceComputer::Restore(const ComputerSettings &settings_computer,
+                       const TracePointVector &points)
+{
+  Reset();
+
+  {
+    const std::lock_guard<Mutex> lock(mutex);
+    for (const auto &i : points)
+      full.push_back(i);
+  }
+
+  if (settings_computer.contest.enable) {
+    for (const auto &i : points) {
+      sprint.push_back(i);
+      contest.push_back(i);
+    }
+  }
+}
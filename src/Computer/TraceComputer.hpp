@@ -93,6 +93,13 @@ public:
 
   void Update(const ComputerSettings &settings_computer,
               const MoreData &basic, const DerivedInfo &calculated);
+
+  /**
+   * Replace all traces with the given points, e.g. the ones saved by
+   * an earlier instance of this program.
+   */
+  void Restore(const ComputerSettings &settings_computer,
+               const TracePointVector &points);
 };
 
 #endif
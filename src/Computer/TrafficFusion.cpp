@@ -0,0 +1,305 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "TrafficFusion.hpp"
+#include "NMEA/Info.hpp"
+#include "Geo/GeoVector.hpp"
+
+#include <algorithm>
+
+#include <math.h>
+
+/**
+ * Reports from two different sources which are closer than this are
+ * considered the same aircraft [m].
+ */
+static constexpr double DUPLICATE_DISTANCE = 500;
+
+/**
+ * ... unless their altitudes differ by more than this [m].
+ */
+static constexpr double DUPLICATE_ALTITUDE = 200;
+
+/**
+ * Positions are not extrapolated beyond this age [s].
+ */
+static constexpr double MAX_EXTRAPOLATION = 30;
+
+/**
+ * Two SkyLines fixes which are further apart than this are not used
+ * to calculate the velocity [s].
+ */
+static constexpr double MAX_VELOCITY_INTERVAL = 300;
+
+static FusedTraffic
+MakeTraffic(FusedTraffic::Source source) noexcept
+{
+  FusedTraffic traffic;
+  traffic.source = source;
+  traffic.sources = FusedTraffic::ToMask(source);
+  traffic.altitude_available = false;
+  traffic.velocity_available = false;
+  traffic.altitude = 0;
+  traffic.track = Angle::Zero();
+  traffic.speed = 0;
+  traffic.age = 0;
+  traffic.name.clear();
+  return traffic;
+}
+
+static double
+GetAge(const Validity &now, const Validity &valid) noexcept
+{
+  if (!now.IsValid() || !valid.IsValid())
+    return 0;
+
+  return std::max(now.GetTimeDifference(valid).count(), 0.);
+}
+
+/**
+ * Normalise a difference of two times of day to [-12h, 12h].
+ */
+[[gnu::const]]
+static double
+NormalizeTimeOfDay(double delta) noexcept
+{
+  constexpr double DAY = 24 * 3600;
+  if (delta < -DAY / 2)
+    delta += DAY;
+  else if (delta > DAY / 2)
+    delta -= DAY;
+  return delta;
+}
+
+/**
+ * Move the target along its track to the time of the merge.
+ */
+static void
+Extrapolate(FusedTraffic &traffic) noexcept
+{
+  if (!traffic.velocity_available || traffic.age <= 0)
+    return;
+
+  const double t = std::min(traffic.age, MAX_EXTRAPOLATION);
+  traffic.location = GeoVector(traffic.speed * t, traffic.track)
+    .EndPoint(traffic.location);
+}
+
+/**
+ * Add a target from a secondary source, or merge it into the nearest
+ * matching target which has not yet been reported by this source.
+ */
+static void
+Merge(FusedTrafficList &fused, const FusedTraffic &traffic) noexcept
+{
+  const uint8_t mask = FusedTraffic::ToMask(traffic.source);
+
+  FusedTraffic *match = nullptr;
+  double match_distance = DUPLICATE_DISTANCE;
+
+  for (auto &i : fused.list) {
+    if (i.sources & mask)
+      continue;
+
+    if (i.altitude_available && traffic.altitude_available &&
+        fabs(i.altitude - traffic.altitude) > DUPLICATE_ALTITUDE)
+      continue;
+
+    const double distance = i.location.DistanceS(traffic.location);
+    if (distance < match_distance) {
+      match = &i;
+      match_distance = distance;
+    }
+  }
+
+  if (match == nullptr) {
+    if (!fused.list.full())
+      fused.list.append(traffic);
+    return;
+  }
+
+  match->sources |= mask;
+
+  switch (traffic.source) {
+  case FusedTraffic::Source::FLARM:
+    match->flarm_id = traffic.flarm_id;
+    break;
+
+  case FusedTraffic::Source::GLIDER_LINK:
+    match->glider_link_id = traffic.glider_link_id;
+    break;
+
+  case FusedTraffic::Source::SKYLINES:
+    match->skylines_id = traffic.skylines_id;
+    break;
+  }
+
+  /* fill in what the primary source does not know */
+
+  if (!match->altitude_available && traffic.altitude_available) {
+    match->altitude_available = true;
+    match->altitude = traffic.altitude;
+  }
+
+  if (!match->velocity_available && traffic.velocity_available) {
+    match->velocity_available = true;
+    match->track = traffic.track;
+    match->speed = traffic.speed;
+  }
+
+  if (match->name.empty())
+    match->name = traffic.name;
+}
+
+void
+TrafficFusion::Process(FusedTrafficList &fused, const NMEAInfo &basic,
+                       const SkyLinesTracking::Data *skylines) noexcept
+{
+  fused.list.clear();
+  fused.modified.Update(basic.clock);
+
+  const Validity now(basic.clock);
+
+  /* FLARM is the most accurate source; its targets are added
+     first and are never merged with each other */
+  for (const auto &t : basic.flarm.traffic.list) {
+    if (!t.location_available)
+      continue;
+
+    if (fused.list.full())
+      break;
+
+    FusedTraffic &traffic = fused.list.append();
+    traffic = MakeTraffic(FusedTraffic::Source::FLARM);
+    traffic.flarm_id = t.id;
+    traffic.location = t.location;
+    traffic.altitude_available = t.altitude_available;
+    traffic.altitude = (double)t.altitude;
+    traffic.velocity_available = true;
+    traffic.track = t.track;
+    traffic.speed = (double)t.speed;
+    traffic.age = GetAge(now, t.valid);
+    traffic.name = t.name.c_str();
+    Extrapolate(traffic);
+  }
+
+#ifdef ANDROID
+  for (const auto &t : basic.glink_data.traffic.list) {
+    if (!t.IsDefined())
+      continue;
+
+    FusedTraffic traffic = MakeTraffic(FusedTraffic::Source::GLIDER_LINK);
+    traffic.glider_link_id = t.id;
+    traffic.location = t.location;
+    traffic.altitude_available = t.altitude_received;
+    traffic.altitude = (double)t.altitude;
+    traffic.velocity_available = t.track_received && t.speed_received;
+    traffic.track = t.track;
+    traffic.speed = (double)t.speed;
+    traffic.age = GetAge(now, t.valid);
+    traffic.name = t.name.c_str();
+    Extrapolate(traffic);
+    Merge(fused, traffic);
+  }
+#endif
+
+#ifdef HAVE_SKYLINES_TRACKING
+  if (skylines != nullptr)
+    ProcessSkyLines(fused, basic, *skylines);
+#else
+  (void)skylines;
+#endif
+}
+
+#ifdef HAVE_SKYLINES_TRACKING
+
+void
+TrafficFusion::ProcessSkyLines(FusedTrafficList &fused, const NMEAInfo &basic,
+                               const SkyLinesTracking::Data &skylines) noexcept
+{
+  const std::lock_guard<Mutex> lock(skylines.mutex);
+
+  new_skylines_tracks.clear();
+
+  for (const auto &[id, t] : skylines.traffic) {
+    if (!t.location.IsValid())
+      continue;
+
+    if (new_skylines_tracks.full())
+      break;
+
+    SkyLinesTrack &track = new_skylines_tracks.append();
+    track.id = id;
+    track.time_of_day = t.time_of_day;
+    track.location = t.location;
+    track.velocity_available = false;
+
+    const auto old = std::find_if(skylines_tracks.begin(),
+                                  skylines_tracks.end(),
+                                  [id = id](const SkyLinesTrack &i){
+                                    return i.id == id;
+                                  });
+    if (old != skylines_tracks.end()) {
+      const double dt =
+        NormalizeTimeOfDay((double(t.time_of_day.count()) -
+                            double(old->time_of_day.count())) / 1000);
+
+      if (dt == 0) {
+        /* no new fix */
+        track.track = old->track;
+        track.speed = old->speed;
+        track.velocity_available = old->velocity_available;
+      } else if (dt > 0 && dt <= MAX_VELOCITY_INTERVAL) {
+        const GeoVector vec = old->location.DistanceBearing(t.location);
+        track.track = vec.bearing;
+        track.speed = vec.distance / dt;
+        track.velocity_available = true;
+      }
+    }
+
+    FusedTraffic traffic = MakeTraffic(FusedTraffic::Source::SKYLINES);
+    traffic.skylines_id = id;
+    traffic.location = t.location;
+    traffic.altitude_available = true;
+    traffic.altitude = t.altitude;
+    traffic.velocity_available = track.velocity_available;
+    traffic.track = track.track;
+    traffic.speed = track.speed;
+
+    if (basic.time_available)
+      traffic.age =
+        std::max(NormalizeTimeOfDay(basic.time.ToDuration().count() -
+                                    t.time_of_day.count() / 1000.), 0.);
+
+    if (const auto name = skylines.user_names.find(id);
+        name != skylines.user_names.end())
+      traffic.name = name->second.c_str();
+
+    Extrapolate(traffic);
+    Merge(fused, traffic);
+  }
+
+  std::swap(skylines_tracks, new_skylines_tracks);
+}
+
+#endif
@@ -0,0 +1,80 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_TRAFFIC_FUSION_HPP
+#define XCSOAR_TRAFFIC_FUSION_HPP
+
+#include "NMEA/FusedTraffic.hpp"
+#include "Tracking/SkyLines/Features.hpp"
+
+#ifdef HAVE_SKYLINES_TRACKING
+#include "Tracking/SkyLines/Data.hpp"
+#endif
+
+struct NMEAInfo;
+namespace SkyLinesTracking { struct Data; }
+
+/**
+ * Merges the traffic from all sources (FLARM, GliderLink, SkyLines)
+ * into one #FusedTrafficList.  Targets reported by more than one
+ * source are detected by their position and merged.  All positions
+ * are extrapolated to the time of the merge.
+ */
+class TrafficFusion {
+#ifdef HAVE_SKYLINES_TRACKING
+  /**
+   * The last known SkyLines fix of a target.  SkyLines does not
+   * report track and speed; they are calculated from two
+   * consecutive fixes.
+   */
+  struct SkyLinesTrack {
+    uint32_t id;
+    SkyLinesTracking::Data::Time time_of_day;
+    GeoPoint location;
+    Angle track;
+    double speed;
+    bool velocity_available;
+  };
+
+  using SkyLinesTrackArray =
+    TrivialArray<SkyLinesTrack, FusedTrafficList::MAX_COUNT>;
+
+  SkyLinesTrackArray skylines_tracks, new_skylines_tracks;
+#endif
+
+public:
+  /**
+   * @param skylines the SkyLines traffic, or nullptr if SkyLines
+   * tracking is not available; its mutex is locked by this method
+   */
+  void Process(FusedTrafficList &fused, const NMEAInfo &basic,
+               const SkyLinesTracking::Data *skylines) noexcept;
+
+private:
+#ifdef HAVE_SKYLINES_TRACKING
+  void ProcessSkyLines(FusedTrafficList &fused, const NMEAInfo &basic,
+                       const SkyLinesTracking::Data &skylines) noexcept;
+#endif
+};
+
+#endif
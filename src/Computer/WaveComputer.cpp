@@ -106,7 +106,7 @@ GetWaveInfo(const LeastSquares &ls, const FlatProjection &projection,
 void
 WaveComputer::Decay(TimeStamp min_time) noexcept
 {
-  waves.remove_if([min_time](const auto &i){ return i.time < min_time; });
+  waves.RemoveIf([min_time](const auto &i){ return i.time < min_time; });
 }
 
 /**
@@ -229,7 +229,7 @@ MergeLines(WaveInfo &i, const WaveInfo &new_wave, double new_length,
   if (i.a.DistanceS(new_wave.a) > max_distance &&
       i.b.DistanceS(new_wave.a) > max_distance &&
       i.a.DistanceS(new_wave.b) > max_distance &&
-      i.a.DistanceS(new_wave.b) > max_distance)
+      i.b.DistanceS(new_wave.b) > max_distance)
     return false;
 
   FlatLine other_line(projection.ProjectFloat(i.a),
@@ -265,11 +265,12 @@ WaveComputer::FoundWave(const WaveInfo &new_wave) noexcept
     /* rearrange a and b to get well-defined order */
     std::swap(new_line.a, new_line.b);
 
-  for (auto &i : waves)
-    if (MergeLines(i, new_wave, new_length, new_line, projection))
-      return;
+  if (waves.FindNear(new_wave.a, new_wave.b, [&](WaveInfo &i){
+        return MergeLines(i, new_wave, new_length, new_line, projection);
+      }))
+    return;
 
-  waves.push_front(new_wave);
+  waves.Add(new_wave);
 }
 
 void
@@ -375,12 +376,9 @@ WaveComputer::Compute(const NMEAInfo &basic,
   if (wave.IsDefined())
     result.waves.push_back(wave);
 
-  /* now copy the rest */
-  for (const auto &i : waves) {
-    if (result.waves.full())
-      break;
-    result.waves.push_back(i);
-  }
+  /* now copy the rest, newest first */
+  for (std::size_t i = waves.size(); i-- > 0 && !result.waves.full();)
+    result.waves.push_back(waves[i]);
 
   /* remember some data for the next iteration */
   last_location_available = basic.location_available;
@@ -25,14 +25,13 @@ Copyright_License {
 #define XCSOAR_WAVE_COMPUTER_HPP
 
 #include "WaveResult.hpp"
+#include "WaveStore.hpp"
 #include "StateClock.hpp"
 #include "time/DeltaTime.hpp"
 #include "Math/LeastSquares.hpp"
 #include "NMEA/Validity.hpp"
 #include "Geo/Flat/FlatProjection.hpp"
 
-#include <list>
-
 struct NMEAInfo;
 struct FlyingState;
 struct WaveSettings;
@@ -71,10 +70,8 @@ class WaveComputer {
 
   /**
    * List of all detected waves.  To be copied to #WaveResult.
-   *
-   * TODO: cleanup, prune old ones.
    */
-  std::list<WaveInfo> waves;
+  WaveStore<WaveInfo, 64> waves;
 
 public:
   void Reset() noexcept {
@@ -0,0 +1,172 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_WAVE_STORE_HPP
+#define XCSOAR_WAVE_STORE_HPP
+
+#include "Geo/GeoBounds.hpp"
+#include "Geo/FAISphere.hpp"
+#include "util/TrivialArray.hxx"
+
+#include <algorithm>
+#include <cmath>
+
+/**
+ * Calculate the area which may contain a line endpoint that is
+ * within one line length of the given line's endpoints: its bounding
+ * box, grown by its length.
+ */
+[[gnu::pure]]
+static inline GeoBounds
+MakeWaveSearchBounds(const GeoPoint a, const GeoPoint b) noexcept
+{
+  GeoBounds bounds(a);
+  bounds.Extend(b);
+
+  const Angle d_latitude = FAISphere::EarthDistanceToAngle(a.DistanceS(b));
+  const Angle max_latitude = std::max(bounds.GetNorth().Absolute(),
+                                      bounds.GetSouth().Absolute());
+  const Angle d_longitude = d_latitude /
+    std::max((max_latitude + d_latitude).cos(), 0.01);
+
+  return GeoBounds(GeoPoint(bounds.GetWest() - d_longitude,
+                            std::min(bounds.GetNorth() + d_latitude,
+                                     Angle::QuarterCircle())),
+                   GeoPoint(bounds.GetEast() + d_longitude,
+                            std::max(bounds.GetSouth() - d_latitude,
+                                     -Angle::QuarterCircle())));
+}
+
+/**
+ * A fixed-capacity list of wave lines, oldest first.  When it is
+ * full, adding a new wave discards the oldest one.
+ *
+ * The search area of each wave (see MakeWaveSearchBounds()) is kept
+ * in a parallel array, which allows FindNear() to skip far-away
+ * waves without calculating distances.
+ *
+ * @param T a type with the #GeoPoint attributes "a" and "b"
+ */
+template<typename T, std::size_t N>
+class WaveStore {
+  TrivialArray<T, N> items;
+  TrivialArray<GeoBounds, N> search_bounds;
+
+public:
+  using const_iterator = typename TrivialArray<T, N>::const_iterator;
+
+  static constexpr std::size_t capacity() noexcept {
+    return N;
+  }
+
+  std::size_t size() const noexcept {
+    return items.size();
+  }
+
+  bool empty() const noexcept {
+    return items.empty();
+  }
+
+  const_iterator begin() const noexcept {
+    return items.begin();
+  }
+
+  const_iterator end() const noexcept {
+    return items.end();
+  }
+
+  /**
+   * Returns the item at the given index (0 is the oldest).
+   */
+  const T &operator[](std::size_t i) const noexcept {
+    return items[i];
+  }
+
+  void clear() noexcept {
+    items.clear();
+    search_bounds.clear();
+  }
+
+  /**
+   * Append a new wave.  If the list is full, the oldest one is
+   * discarded.
+   */
+  void Add(const T &item) noexcept {
+    if (items.full()) {
+      items.remove(0);
+      search_bounds.remove(0);
+    }
+
+    items.append(item);
+    search_bounds.append(MakeWaveSearchBounds(item.a, item.b));
+  }
+
+  /**
+   * Invoke the function with each wave (newest first) that may have
+   * an endpoint within max(length of the wave, length of the given
+   * line) of the given line's endpoints, until it returns true.
+   * The function may modify the wave.
+   *
+   * @return true if the function has returned true
+   */
+  template<typename F>
+  bool FindNear(const GeoPoint a, const GeoPoint b, F &&f) noexcept {
+    const GeoBounds bounds = MakeWaveSearchBounds(a, b);
+
+    for (std::size_t i = items.size(); i-- > 0;) {
+      if (!search_bounds[i].Overlaps(bounds))
+        continue;
+
+      if (f(items[i])) {
+        search_bounds[i] = MakeWaveSearchBounds(items[i].a, items[i].b);
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  /**
+   * Remove all waves matching the given predicate.
+   */
+  template<typename P>
+  void RemoveIf(P &&p) noexcept {
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < items.size(); ++i) {
+      if (p(items[i]))
+        continue;
+
+      if (n != i) {
+        items[n] = items[i];
+        search_bounds[n] = search_bounds[i];
+      }
+
+      ++n;
+    }
+
+    items.shrink(n);
+    search_bounds.shrink(n);
+  }
+};
+
+#endif
@@ -56,13 +56,21 @@ WindComputer::Compute(const WindSettings &settings,
     return;
   }
 
-  if (!calculated.flight.flying)
+  if (!calculated.flight.flying) {
+    wind_ekf.SkipSamples(basic);
     return;
+  }
 
   if (settings.CirclingWindEnabled()) {
     CirclingWind::Result result = circling_wind.NewSample(basic, calculated);
-    if (result.IsValid())
+    if (result.IsValid()) {
       wind_store.SlotMeasurement(basic, result.wind, result.quality);
+
+      /* the circling wind is an independent measurement for the
+         EKF; this lets it converge quickly after a thermal */
+      if (settings.ZigZagWindEnabled())
+        wind_ekf.AddCirclingWind(result.wind, result.quality);
+    }
   }
 
   if (settings.ZigZagWindEnabled() &&
@@ -81,7 +89,10 @@ WindComputer::Compute(const WindSettings &settings,
         calculated.estimated_wind_available.Update(basic.clock);
         ekf_active = true;
       }
-    }
+    } else
+      /* don't feed the samples recorded at low speed into the EKF
+         later */
+      wind_ekf.SkipSamples(basic);
   } else
     /* EKF cannot be used without airspeed */
     ekf_active = false;
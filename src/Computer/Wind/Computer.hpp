@@ -57,6 +57,10 @@ public:
     return wind_store;
   }
 
+  WindStore &GetWindStore() {
+    return wind_store;
+  }
+
   void Reset();
 
   void Compute(const WindSettings &settings,
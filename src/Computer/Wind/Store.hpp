@@ -66,6 +66,19 @@ public:
    */
   void SlotAltitude(const MoreData &info, DerivedInfo &derived);
 
+  const WindMeasurementList &GetMeasurements() const {
+    return windlist;
+  }
+
+  /**
+   * Replace all measurements, e.g. with the ones saved by an earlier
+   * instance of this program.
+   */
+  void RestoreMeasurements(const WindMeasurementList &list) {
+    windlist = list;
+    updated = true;
+  }
+
   [[gnu::pure]]
   const Vector GetWind(TimeStamp time, double h,
                        bool &found) const noexcept;
@@ -63,6 +63,18 @@ WindEKF::Update(const double airspeed, const float gps_vel[2])
   }
 }
 
+void
+WindEKF::FuseWind(const float wind[2], const float gain)
+{
+  assert(!std::isnan(wind[0]));
+  assert(!std::isnan(wind[1]));
+  assert(gain >= 0 && gain <= 1);
+
+  // direct measurement of the first two state components
+  X[0] += gain * (wind[0] - X[0]);
+  X[1] += gain * (wind[1] - X[1]);
+}
+
 void
 WindEKF::Init()
 {
@@ -31,6 +31,17 @@ class WindEKF {
 public:
   void Init();
   void Update(double airspeed, const float gps_vel[2]);
+
+  /**
+   * Fuse an independent measurement of the wind vector (e.g. from
+   * circling drift) into the state.
+   *
+   * @param wind the measured wind velocity east and north (the
+   * direction the air moves to) [m/s]
+   * @param gain the weight of the measurement (0..1); 1 replaces the
+   * wind estimate
+   */
+  void FuseWind(const float wind[2], float gain);
   const float* get_state() const { return X; };
 };
 
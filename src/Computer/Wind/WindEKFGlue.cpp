@@ -24,15 +24,16 @@ Copyright_License {
 
 #include "WindEKFGlue.hpp"
 #include "Math/Angle.hpp"
-#include "NMEA/Info.hpp"
+#include "NMEA/MoreData.hpp"
 #include "NMEA/Derived.hpp"
 
+#include <algorithm>
+
 void
 WindEKFGlue::Reset()
 {
   reset_pending = true;
-  last_ground_speed_available.Clear();
-  last_airspeed_available.Clear();
+  last_sample_time = TimeStamp::Undefined();
   i = 0;
 
   ResetBlackout();
@@ -50,14 +51,23 @@ CounterToQuality(unsigned i)
           : 1u));
 }
 
+void
+WindEKFGlue::SkipSamples(const MoreData &basic) noexcept
+{
+  const auto &samples = basic.speed_samples;
+  if (!samples.empty())
+    last_sample_time = std::max(last_sample_time, samples.back().time);
+}
+
 WindEKFGlue::Result
-WindEKFGlue::Update(const NMEAInfo &basic, const DerivedInfo &derived)
+WindEKFGlue::Update(const MoreData &basic, const DerivedInfo &derived)
 {
   // @todo accuracy: correct TAS for vertical speed if dynamic pullup
 
   // reset if flight hasnt started or airspeed instrument not available
   if (!derived.flight.flying) {
     Reset();
+    SkipSamples(basic);
     return Result(0);
   }
 
@@ -65,22 +75,22 @@ WindEKFGlue::Update(const NMEAInfo &basic, const DerivedInfo &derived)
       !basic.airspeed_available || !basic.airspeed_real ||
       basic.true_airspeed < 1) {
     ResetBlackout();
+    SkipSamples(basic);
     return Result(0);
   }
 
-  if (last_ground_speed_available.FixTimeWarp(basic.ground_speed_available) ||
-      last_airspeed_available.FixTimeWarp(basic.airspeed_available))
+  const auto &samples = basic.speed_samples;
+  if (samples.empty())
+    return Result(0);
+
+  if (samples.back().time < last_sample_time)
     /* time warp: start from scratch */
     Reset();
 
-  if (!basic.ground_speed_available.Modified(last_ground_speed_available) ||
-      !basic.airspeed_available.Modified(last_airspeed_available))
+  if (samples.back().time == last_sample_time)
     /* no updated speed values from instrument, don't invoke WindEKF */
     return Result(0);
 
-  last_ground_speed_available = basic.ground_speed_available;
-  last_airspeed_available = basic.airspeed_available;
-
   // temporary manoeuvering, dont append this point
   if (derived.circling)
     /* reset the counter so the first wind estimate after circling
@@ -93,32 +103,42 @@ WindEKFGlue::Update(const NMEAInfo &basic, const DerivedInfo &derived)
        fabs(basic.acceleration.g_load - 1) > 0.3)) {
 
     SetBlackout(basic.clock);
+    SkipSamples(basic);
     return Result(0);
   }
 
-  if (InBlackout(basic.clock))
+  if (InBlackout(basic.clock)) {
+    SkipSamples(basic);
     return Result(0);
+  }
 
   // clear blackout
   ResetBlackout();
 
-  auto V = basic.true_airspeed;
-  float gps_vel[2];
-  const auto sc = basic.track.SinCos();
-  const auto gps_east = sc.first, gps_north = sc.second;
-  gps_vel[0] = (float)(gps_east * basic.ground_speed);
-  gps_vel[1] = (float)(gps_north * basic.ground_speed);
-
   if (reset_pending) {
     /* do the postponed WindEKF reset */
     reset_pending = false;
     ekf.Init();
   }
 
-  ekf.Update(V, gps_vel);
+  /* feed all samples which have arrived since the last call, oldest
+     first */
+  const auto min_time = std::max(last_sample_time,
+                                 basic.clock - MAX_SAMPLE_AGE);
+  const unsigned old_i = i;
+  for (unsigned j = 0; j < samples.size; ++j) {
+    const auto &sample = samples[j];
+    if (sample.time <= min_time || sample.true_airspeed < 1)
+      continue;
+
+    ekf.Update(sample.true_airspeed, sample.ground_velocity);
+    ++i;
+  }
+
+  last_sample_time = samples.back().time;
 
-  ++i;
-  if (i % 10 != 0)
+  /* emit a result every 10 samples */
+  if (i / 10 == old_i / 10)
     return Result(0);
 
   const float* x = ekf.get_state();
@@ -129,3 +149,23 @@ WindEKFGlue::Update(const NMEAInfo &basic, const DerivedInfo &derived)
 
   return res;
 }
+
+void
+WindEKFGlue::AddCirclingWind(SpeedVector wind, unsigned quality)
+{
+  /* the EKF state is the velocity of the air mass, the opposite of
+     the "wind from" bearing */
+  const auto sc = wind.bearing.SinCos();
+  const float x[2] = {
+    (float)(-sc.first * wind.norm),
+    (float)(-sc.second * wind.norm),
+  };
+
+  if (reset_pending) {
+    /* seed the postponed WindEKF reset with this estimate */
+    reset_pending = false;
+    ekf.Init();
+    ekf.FuseWind(x, 1);
+  } else
+    ekf.FuseWind(x, std::min(quality, 5u) * CIRCLING_WIND_GAIN);
+}
@@ -25,11 +25,10 @@ Copyright_License {
 #define WINDEKF_GLUE_HPP
 
 #include "WindEKF.hpp"
-#include "NMEA/Validity.hpp"
 #include "Geo/SpeedVector.hpp"
 #include "time/Stamp.hpp"
 
-struct NMEAInfo;
+struct MoreData;
 struct DerivedInfo;
 
 class WindEKFGlue
@@ -39,6 +38,17 @@ class WindEKFGlue
    */
   static constexpr FloatDuration BLACKOUT_TIME = std::chrono::seconds{3};
 
+  /**
+   * Speed samples older than this are not fed into the #WindEKF;
+   * they have accumulated while this class was not being called.
+   */
+  static constexpr FloatDuration MAX_SAMPLE_AGE = std::chrono::seconds{2};
+
+  /**
+   * The gain of a circling wind measurement per quality point.
+   */
+  static constexpr float CIRCLING_WIND_GAIN = 0.05f;
+
   WindEKF ekf;
 
   /**
@@ -51,10 +61,10 @@ class WindEKFGlue
   bool reset_pending;
 
   /**
-   * These attributes are used to check if updated values are
-   * available since the last call.
+   * The time of the newest MoreData::speed_samples entry which was
+   * consumed (or discarded) by the previous call.
    */
-  Validity last_ground_speed_available, last_airspeed_available;
+  TimeStamp last_sample_time;
 
   /**
    * The number of samples we have fed into the #WindEKF.  This is
@@ -76,7 +86,25 @@ public:
 
   void Reset();
 
-  Result Update(const NMEAInfo &basic, const DerivedInfo &derived);
+  /**
+   * Feed all MoreData::speed_samples which have arrived since the
+   * previous call into the #WindEKF.
+   */
+  Result Update(const MoreData &basic, const DerivedInfo &derived);
+
+  /**
+   * Fuse a wind estimate obtained by #CirclingWind into the
+   * #WindEKF.  If the #WindEKF has not been initialised yet, the
+   * estimate is used as its initial state, which speeds up
+   * convergence after the first thermal.
+   */
+  void AddCirclingWind(SpeedVector wind, unsigned quality);
+
+  /**
+   * Mark all speed samples as consumed without feeding them into
+   * the #WindEKF.
+   */
+  void SkipSamples(const MoreData &basic) noexcept;
 
 private:
   void ResetBlackout() {
@@ -26,20 +26,18 @@
 #include "ui/canvas/Canvas.hpp"
 #include "Screen/Layout.hpp"
 #include "Look/AirspaceLook.hpp"
-#include "Airspace/AirspaceIntersectionVisitor.hpp"
 #include "Airspace/AbstractAirspace.hpp"
 #include "Airspace/AirspaceVisibility.hpp"
 #include "Renderer/AirspacePreviewRenderer.hpp"
-#include "Engine/Airspace/Airspaces.hpp"
 #include "Navigation/Aircraft.hpp"
-#include "Geo/GeoVector.hpp"
 #include "util/StringCompare.hxx"
 
+#include <algorithm>
+
 /**
- * Local visitor class used for rendering airspaces in the CrossSectionRenderer
+ * Local helper class used for rendering airspaces in the CrossSectionRenderer
  */
-class AirspaceIntersectionVisitorSlice final
-  : public AirspaceIntersectionVisitor
+class AirspaceSliceRenderer
 {
   /** Canvas to draw on */
   Canvas &canvas;
@@ -50,29 +48,31 @@ class AirspaceIntersectionVisitorSlice final
 
   const AirspaceLook &airspace_look;
 
-  /** GeoPoint at the left of the CrossSection */
-  const GeoPoint start;
+  /** distance of the left edge of the CrossSection along the
+      reference line */
+  const double offset;
   /** AltitudeState instance used for AGL-based airspaces */
   const AltitudeState& state;
 
 public:
   /**
-   * Constructor of the AirspaceIntersectionVisitorSlice class
+   * Constructor of the AirspaceSliceRenderer class
    * @param _canvas The canvas to draw to
    * @param _chart ChartRenderer instance for scaling coordinates
    * @param _settings settings for colors, pens and brushes
-   * @param _start GeoPoint at the left of the CrossSection
+   * @param _offset distance of the left edge of the CrossSection
+   * along the reference line
    * @param _state AltitudeState instance used for AGL-based airspaces
    */
-  AirspaceIntersectionVisitorSlice(Canvas &_canvas,
-                                   const ChartRenderer &_chart,
-                                   const AirspaceRendererSettings &_settings,
-                                   const AirspaceLook &_airspace_look,
-                                   const GeoPoint _start,
-                                   const AltitudeState& _state) :
+  AirspaceSliceRenderer(Canvas &_canvas,
+                        const ChartRenderer &_chart,
+                        const AirspaceRendererSettings &_settings,
+                        const AirspaceLook &_airspace_look,
+                        double _offset,
+                        const AltitudeState& _state) :
     canvas(_canvas), chart(_chart), settings(_settings),
     airspace_look(_airspace_look),
-    start(_start), state(_state) {}
+    offset(_offset), state(_state) {}
 
   /**
    * Render an airspace box to the canvas
@@ -85,17 +85,13 @@ public:
 
   /**
    * Renders the AbstractAirspace on the canvas
-   * @param as AbstractAirspace to render
+   * @param item the airspace and its cached intersections
    */
-  void Render(const AbstractAirspace &as) const;
-
-  void Visit(ConstAirspacePtr as) noexcept override {
-    Render(*as);
-  }
+  void Render(const CrossSectionCache::Airspace &item) const;
 };
 
 inline void
-AirspaceIntersectionVisitorSlice::RenderBox(const PixelRect rc,
+AirspaceSliceRenderer::RenderBox(const PixelRect rc,
                                             AirspaceClass type) const
 {
   if (AirspacePreviewRenderer::PrepareFill(canvas, type, airspace_look,
@@ -140,14 +136,11 @@ AirspaceIntersectionVisitorSlice::RenderBox(const PixelRect rc,
 }
 
 inline void
-AirspaceIntersectionVisitorSlice::Render(const AbstractAirspace &as) const
+AirspaceSliceRenderer::Render(const CrossSectionCache::Airspace &item) const
 {
+  const AbstractAirspace &as = *item.airspace;
   AirspaceClass type = as.GetType();
 
-  // No intersections for this airspace
-  if (intersections.empty())
-    return;
-
   if (!IsAirspaceTypeVisible(as, settings))
     return;
 
@@ -161,18 +154,18 @@ AirspaceIntersectionVisitorSlice::Render(const AbstractAirspace &as) const
 
   int min_x = canvas.GetWidth(), max_x = 0;
 
+  const double x_max = chart.GetXMax();
+
   // Iterate through the intersections
-  for (const auto &i : intersections) {
-    const GeoPoint &p_start = i.first;
-    const GeoPoint &p_end = i.second;
+  for (const auto &i : item.ranges) {
+    const double left = i.first - offset, right = i.second - offset;
 
-    rcd.left = chart.ScreenX(start.Distance(p_start));
+    // the cached ranges may extend beyond the CrossSection
+    if (right <= 0 || left >= x_max)
+      continue;
 
-    // only one edge found, next edge must be beyond screen
-    if (p_start == p_end)
-      rcd.right = chart.ScreenX(chart.GetXMax());
-    else
-      rcd.right = chart.ScreenX(start.Distance(p_end));
+    rcd.left = chart.ScreenX(std::max(left, 0.));
+    rcd.right = chart.ScreenX(std::min(right, x_max));
 
     if (rcd.left < min_x)
       min_x = rcd.left;
@@ -208,15 +201,14 @@ AirspaceIntersectionVisitorSlice::Render(const AbstractAirspace &as) const
 
 void
 AirspaceXSRenderer::Draw(Canvas &canvas, const ChartRenderer &chart,
-                         const Airspaces &database, const GeoPoint &start,
-                         const GeoVector &vec, const AircraftState &state) const
+                         const std::vector<CrossSectionCache::Airspace> &airspaces,
+                         double offset, const AircraftState &state) const
 {
   canvas.Select(*look.name_font);
 
-  // Create IntersectionVisitor to render to the canvas
-  AirspaceIntersectionVisitorSlice ivisitor(
-      canvas, chart, settings, look, start, state);
+  AirspaceSliceRenderer renderer(canvas, chart, settings, look,
+                                 offset, state);
 
-  // Call visitor with intersecting airspaces
-  database.VisitIntersecting(start, vec.EndPoint(start), true, ivisitor);
+  for (const auto &i : airspaces)
+    renderer.Render(i);
 }
@@ -24,14 +24,14 @@
 #ifndef AIRSPACE_CROSS_SECTION_RENDERER_HPP
 #define AIRSPACE_CROSS_SECTION_RENDERER_HPP
 
+#include "CrossSectionCache.hpp"
 #include "Renderer/AirspaceRendererSettings.hpp"
 
+#include <vector>
+
 struct AirspaceLook;
 class Canvas;
 class ChartRenderer;
-class Airspaces;
-struct GeoPoint;
-struct GeoVector;
 struct AircraftState;
 
 /**
@@ -46,9 +46,13 @@ class AirspaceXSRenderer
 public:
   AirspaceXSRenderer(const AirspaceLook &_look): look(_look) {}
 
+  /**
+   * @param offset the distance of the left edge of the chart along
+   * the reference line of the #CrossSectionCache
+   */
   void Draw(Canvas &canvas, const ChartRenderer &chart,
-            const Airspaces &database,
-            const GeoPoint &start, const GeoVector &vec,
+            const std::vector<CrossSectionCache::Airspace> &airspaces,
+            double offset,
             const AircraftState &state) const;
 
   void SetSettings(const AirspaceRendererSettings &_settings) {
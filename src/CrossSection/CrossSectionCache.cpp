@@ -0,0 +1,209 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "CrossSectionCache.hpp"
+#include "Terrain/RasterTerrain.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "Engine/Airspace/AirspaceIntersectionVisitor.hpp"
+#include "Geo/GeoVector.hpp"
+
+#include <cmath>
+
+namespace {
+
+/**
+ * Collects the intersections of all airspaces with a line, as
+ * distances along the reference line.
+ */
+class AirspaceCollector final : public AirspaceIntersectionVisitor {
+  std::vector<CrossSectionCache::Airspace> &airspaces;
+
+  const GeoPoint start;
+  const double start_distance, end_distance;
+
+public:
+  AirspaceCollector(std::vector<CrossSectionCache::Airspace> &_airspaces,
+                    const GeoPoint &_start,
+                    double _start_distance, double _end_distance) noexcept
+    :airspaces(_airspaces), start(_start),
+     start_distance(_start_distance), end_distance(_end_distance) {}
+
+  void Visit(ConstAirspacePtr as) noexcept override {
+    if (intersections.empty())
+      return;
+
+    auto &item = airspaces.emplace_back();
+    item.airspace = std::move(as);
+
+    for (const auto &i : intersections) {
+      const double a = start_distance + start.Distance(i.first);
+
+      /* only one edge found: the airspace continues beyond the end
+         of the line */
+      const double b = i.first == i.second
+        ? end_distance
+        : start_distance + start.Distance(i.second);
+
+      item.ranges.emplace_back(a, b);
+    }
+  }
+};
+
+} // anonymous namespace
+
+inline GeoPoint
+CrossSectionCache::GetPoint(double distance) const noexcept
+{
+  return GeoVector(distance, bearing).EndPoint(origin);
+}
+
+inline bool
+CrossSectionCache::Locate(const GeoPoint &start, const GeoVector &vec,
+                          double new_spacing) noexcept
+{
+  if (!origin.IsValid() || new_spacing != spacing)
+    return false;
+
+  /* both ends of the cross section must stay within half a sample
+     of the reference line */
+  const double tolerance = spacing / 2;
+
+  const Angle turn = (vec.bearing - bearing).AsDelta();
+  if (turn.cos() <= 0 || vec.distance * fabs(turn.sin()) > tolerance)
+    return false;
+
+  const GeoVector v = origin.DistanceBearing(start);
+  const Angle delta = (v.bearing - bearing).AsDelta();
+  if (v.distance * fabs(delta.sin()) > tolerance)
+    return false;
+
+  offset = v.distance * delta.cos();
+  return offset >= 0;
+}
+
+void
+CrossSectionCache::Update(const GeoPoint &start, const GeoVector &vec,
+                          unsigned n_slices,
+                          const RasterTerrain *_terrain,
+                          const Airspaces *_airspace_database) noexcept
+{
+  assert(n_slices >= 2);
+
+  const double new_spacing = vec.distance / (n_slices - 1);
+  if (!Locate(start, vec, new_spacing)) {
+    /* start a new reference line */
+    origin = start;
+    bearing = vec.bearing;
+    spacing = new_spacing;
+    offset = 0;
+
+    elevations.clear();
+    airspace_end = 0;
+  }
+
+  UpdateTerrain(_terrain, n_slices);
+  UpdateAirspaces(_airspace_database, vec.distance);
+}
+
+void
+CrossSectionCache::UpdateTerrain(const RasterTerrain *_terrain,
+                                 unsigned n_slices) noexcept
+{
+  if (_terrain == nullptr) {
+    terrain = nullptr;
+    elevations.clear();
+    return;
+  }
+
+  if (_terrain != terrain || _terrain->GetSerial() != terrain_serial) {
+    /* new tiles may have been loaded */
+    terrain = _terrain;
+    terrain_serial = _terrain->GetSerial();
+    elevations.clear();
+  }
+
+  /* one more sample than slices, because the cross section start
+     is usually between two samples */
+  const unsigned n = n_slices + 1;
+
+  /* drop the samples behind the aircraft */
+  const int first = (int)std::floor(offset / spacing);
+  const int shift = first - first_sample;
+  if (shift < 0 || shift >= (int)elevations.size())
+    elevations.clear();
+  else
+    elevations.erase(elevations.begin(), elevations.begin() + shift);
+
+  first_sample = first;
+
+  if (elevations.size() > n)
+    elevations.resize(n);
+
+  const unsigned have = elevations.size();
+  if (have == n)
+    return;
+
+  /* look up only the new samples ahead */
+  sample_points.clear();
+  for (unsigned i = have; i < n; ++i)
+    sample_points.push_back(GetPoint((first + int(i)) * spacing));
+
+  elevations.resize(n);
+
+  RasterTerrain::Lease map(*terrain);
+  map->GetHeights({sample_points.data(), sample_points.size()},
+                  elevations.data() + have);
+}
+
+void
+CrossSectionCache::UpdateAirspaces(const Airspaces *_airspace_database,
+                                   double distance) noexcept
+{
+  if (_airspace_database == nullptr) {
+    airspace_database = nullptr;
+    airspaces.clear();
+    airspace_end = 0;
+    return;
+  }
+
+  if (_airspace_database != airspace_database ||
+      _airspace_database->GetSerial() != airspace_serial) {
+    airspace_database = _airspace_database;
+    airspace_serial = _airspace_database->GetSerial();
+    airspace_end = 0;
+  }
+
+  if (airspace_end > airspace_start &&
+      offset >= airspace_start && offset + distance <= airspace_end)
+    return;
+
+  airspace_start = offset;
+  airspace_end = offset + distance * (1 + AIRSPACE_EXTENSION);
+
+  airspaces.clear();
+
+  const GeoPoint a = GetPoint(airspace_start);
+  AirspaceCollector collector(airspaces, a, airspace_start, airspace_end);
+  airspace_database->VisitIntersecting(a, GetPoint(airspace_end), true,
+                                       collector);
+}
@@ -0,0 +1,170 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef CROSS_SECTION_CACHE_HPP
+#define CROSS_SECTION_CACHE_HPP
+
+#include "Terrain/Height.hpp"
+#include "Geo/GeoPoint.hpp"
+#include "Engine/Airspace/Ptr.hpp"
+#include "util/Serial.hpp"
+
+#include <utility>
+#include <vector>
+
+struct GeoVector;
+class RasterTerrain;
+class Airspaces;
+
+/**
+ * Caches the terrain and airspace profile of the cross section.
+ *
+ * Positions are stored as distances along a reference line.  As
+ * long as the aircraft keeps moving along this line, the profile is
+ * only shifted and extended: only the new terrain samples are looked
+ * up, and the airspace intersections (which are queried for a longer
+ * line) are reused.  A turn, a range change or a modified terrain /
+ * airspace database starts a new reference line.
+ */
+class CrossSectionCache {
+public:
+  /**
+   * The horizontal extent of one airspace in the cross section.
+   */
+  struct Airspace {
+    ConstAirspacePtr airspace;
+
+    /**
+     * Pairs of distances along the reference line.
+     */
+    std::vector<std::pair<double, double>> ranges;
+  };
+
+private:
+  /**
+   * The airspace intersections are queried for a line this much
+   * longer than the cross section range, so they remain usable
+   * while the aircraft moves ahead.
+   */
+  static constexpr double AIRSPACE_EXTENSION = 0.5;
+
+  GeoPoint origin = GeoPoint::Invalid();
+  Angle bearing;
+
+  /**
+   * The distance between two terrain samples.
+   */
+  double spacing;
+
+  /**
+   * The distance of the cross section start from #origin.
+   */
+  double offset;
+
+  const RasterTerrain *terrain = nullptr;
+  Serial terrain_serial;
+
+  /**
+   * The sample index of elevations[0]; sample i is at the distance
+   * i*#spacing from #origin.
+   */
+  int first_sample;
+
+  std::vector<TerrainHeight> elevations;
+  std::vector<GeoPoint> sample_points;
+
+  const Airspaces *airspace_database = nullptr;
+  Serial airspace_serial;
+
+  /**
+   * The range of distances covered by #airspaces.  If #airspace_end
+   * is not larger than #airspace_start, nothing is cached.
+   */
+  double airspace_start, airspace_end = 0;
+
+  std::vector<Airspace> airspaces;
+
+public:
+  /**
+   * Update the profile for the given cross section.
+   *
+   * @param n_slices the number of terrain samples in the cross
+   * section
+   */
+  void Update(const GeoPoint &start, const GeoVector &vec,
+              unsigned n_slices,
+              const RasterTerrain *terrain,
+              const Airspaces *airspace_database) noexcept;
+
+  /**
+   * The distance of the cross section start along the reference
+   * line.  Subtract this from the distances in #Airspace::ranges.
+   */
+  double GetOffset() const noexcept {
+    return offset;
+  }
+
+  /**
+   * The terrain samples, starting at GetFirstSampleDistance() and
+   * spaced GetSampleSpacing() apart.  They cover the whole cross
+   * section.  The array is empty if there is no terrain.
+   */
+  const std::vector<TerrainHeight> &GetElevations() const noexcept {
+    return elevations;
+  }
+
+  /**
+   * The distance of the first terrain sample from the cross section
+   * start; this is zero or slightly negative.
+   */
+  double GetFirstSampleDistance() const noexcept {
+    return first_sample * spacing - offset;
+  }
+
+  double GetSampleSpacing() const noexcept {
+    return spacing;
+  }
+
+  const std::vector<Airspace> &GetAirspaces() const noexcept {
+    return airspaces;
+  }
+
+private:
+  GeoPoint GetPoint(double distance) const noexcept;
+
+  /**
+   * Try to locate the cross section on the current reference line.
+   *
+   * @return false if a new reference line must be started
+   */
+  bool Locate(const GeoPoint &start, const GeoVector &vec,
+              double new_spacing) noexcept;
+
+  void UpdateTerrain(const RasterTerrain *terrain,
+                     unsigned n_slices) noexcept;
+
+  void UpdateAirspaces(const Airspaces *airspace_database,
+                       double distance) noexcept;
+};
+
+#endif
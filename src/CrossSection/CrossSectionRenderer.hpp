@@ -27,6 +27,7 @@
 #include "Blackboard/BaseBlackboard.hpp"
 #include "TerrainXSRenderer.hpp"
 #include "AirspaceXSRenderer.hpp"
+#include "CrossSectionCache.hpp"
 #include "Engine/GlideSolvers/GlideSettings.hpp"
 #include "Engine/GlideSolvers/GlidePolar.hpp"
 
@@ -72,6 +73,10 @@ protected:
   /** Range and direction of the CrossSection */
   GeoVector vec{50000, Angle::Zero()};
 
+  /** Terrain and airspace profile, reused while the aircraft moves
+      along a straight line */
+  mutable CrossSectionCache cache;
+
 public:
   /**
    * Constructor. Initializes most class members.
@@ -140,8 +145,6 @@ public:
   }
 
 protected:
-  void UpdateTerrain(TerrainHeight *elevations) const;
-
   void PaintGlide(ChartRenderer &chart) const;
   void PaintAircraft(Canvas &canvas, const ChartRenderer &chart,
                      const PixelRect rc) const;
@@ -28,13 +28,17 @@
 #include "Look/CrossSectionLook.hpp"
 #include "util/StaticArray.hxx"
 
+#include <algorithm>
+
 void
 TerrainXSRenderer::Draw(Canvas &canvas, const ChartRenderer &chart,
-                        const TerrainHeight *elevations) const
+                        const TerrainHeight *elevations, unsigned n,
+                        double first_distance, double spacing) const
 {
   const auto max_distance = chart.GetXMax();
 
-  StaticArray<BulkPixelPoint, CrossSectionRenderer::NUM_SLICES + 2> points;
+  StaticArray<BulkPixelPoint, CrossSectionRenderer::NUM_SLICES + 3> points;
+  assert(n <= CrossSectionRenderer::NUM_SLICES + 1);
 
   canvas.SelectNullPen();
 
@@ -42,10 +46,9 @@ TerrainXSRenderer::Draw(Canvas &canvas, const ChartRenderer &chart,
   double last_distance = 0;
   const double hmin = chart.GetYMin();
 
-  for (unsigned j = 0; j < CrossSectionRenderer::NUM_SLICES; ++j) {
-    const auto distance_factor =
-        double(j) / (CrossSectionRenderer::NUM_SLICES - 1);
-    const auto distance = distance_factor * max_distance;
+  for (unsigned j = 0; j < n; ++j) {
+    const auto distance = std::clamp(first_distance + j * spacing,
+                                     0., max_distance);
 
     const TerrainHeight e = elevations[j];
     const TerrainType type = e.GetType();
@@ -77,7 +80,7 @@ TerrainXSRenderer::Draw(Canvas &canvas, const ChartRenderer &chart,
         points.append() = chart.ToScreen(center_distance, hmin);
       }
 
-      if (j + 1 == CrossSectionRenderer::NUM_SLICES) {
+      if (j + 1 == n) {
         // Close and paint last polygon
         points.append() = chart.ToScreen(distance, h);
         points.append() = chart.ToScreen(distance, hmin);
@@ -41,8 +41,16 @@ class TerrainXSRenderer
 public:
   TerrainXSRenderer(const CrossSectionLook &_look): look(_look) {}
 
+  /**
+   * @param elevations the terrain samples
+   * @param n the number of samples
+   * @param first_distance the distance of the first sample from the
+   * left edge of the chart; may be negative
+   * @param spacing the distance between two samples
+   */
   void Draw(Canvas &canvas, const ChartRenderer &chart,
-            const TerrainHeight *elevations) const;
+            const TerrainHeight *elevations, unsigned n,
+            double first_distance, double spacing) const;
 
 private:
   void DrawPolygon(Canvas &canvas, TerrainType type,
@@ -0,0 +1,57 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#pragma once
+
+#include "io/Reader.hxx"
+
+/**
+ * A #Reader wrapper which calculates a digest of all data passing
+ * through it, so a file can be verified while it is being
+ * consumed, without reading it a second time.
+ */
+template<typename T>
+class DigestReader final : public Reader {
+  Reader &next;
+
+  T state;
+
+public:
+  explicit DigestReader(Reader &_next) noexcept
+    :next(_next) {}
+
+  void Final(void *dest) noexcept {
+    state.Final(dest);
+  }
+
+  auto Final() noexcept {
+    return state.Final();
+  }
+
+  /* virtual methods from class Reader */
+  std::size_t Read(void *data, std::size_t size) override {
+    const std::size_t nbytes = next.Read(data, size);
+    state.Update({data, nbytes});
+    return nbytes;
+  }
+};
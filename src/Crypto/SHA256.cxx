@@ -0,0 +1,249 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "SHA256.hxx"
+
+#ifdef HAVE_SHA256_HARDWARE
+
+#include "util/ByteOrder.hxx"
+
+#include <algorithm>
+
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#ifdef __linux__
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+#endif
+
+alignas(16) static constexpr uint32_t K[64] = {
+  0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+  0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+  0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+  0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+  0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+  0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+  0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+  0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+  0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+  0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+  0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+  0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+  0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
+  0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+  0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+  0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+#if defined(__x86_64__) || defined(__i386__)
+
+bool
+SHA256Hardware::IsAvailable() noexcept
+{
+  static const bool available = [](){
+    unsigned eax, ebx, ecx, edx;
+    return __get_cpuid(1, &eax, &ebx, &ecx, &edx) &&
+      (ecx & bit_SSE4_1) != 0 &&
+      __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) &&
+      (ebx & bit_SHA) != 0;
+  }();
+
+  return available;
+}
+
+[[gnu::target("sha,sse4.1")]]
+static void
+Compress(uint32_t h[8], const std::byte *data, std::size_t n_blocks) noexcept
+{
+  const __m128i byteswap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL,
+                                          0x0405060700010203ULL);
+
+  /* the SHA-NI instructions operate on the state words in the
+     order ABEF/CDGH */
+  __m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&h[0]),
+                                  0xb1);
+  __m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&h[4]),
+                                     0x1b);
+  __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);
+  state1 = _mm_blend_epi16(state1, tmp, 0xf0);
+
+  for (; n_blocks > 0; --n_blocks, data += 64) {
+    const __m128i abef = state0, cdgh = state1;
+
+    __m128i msg[4];
+    for (unsigned i = 0; i < 16; ++i) {
+      __m128i &m = msg[i & 3];
+      if (i < 4)
+        m = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data + i * 16)),
+                             byteswap);
+      else
+        m = _mm_sha256msg2_epu32(_mm_add_epi32(_mm_sha256msg1_epu32(m, msg[(i + 1) & 3]),
+                                               _mm_alignr_epi8(msg[(i + 3) & 3],
+                                                               msg[(i + 2) & 3], 4)),
+                                 msg[(i + 3) & 3]);
+
+      tmp = _mm_add_epi32(m, _mm_load_si128((const __m128i *)&K[i * 4]));
+      state1 = _mm_sha256rnds2_epu32(state1, state0, tmp);
+      state0 = _mm_sha256rnds2_epu32(state0, state1,
+                                     _mm_shuffle_epi32(tmp, 0x0e));
+    }
+
+    state0 = _mm_add_epi32(state0, abef);
+    state1 = _mm_add_epi32(state1, cdgh);
+  }
+
+  tmp = _mm_shuffle_epi32(state0, 0x1b);
+  state1 = _mm_shuffle_epi32(state1, 0xb1);
+  _mm_storeu_si128((__m128i *)&h[0], _mm_blend_epi16(tmp, state1, 0xf0));
+  _mm_storeu_si128((__m128i *)&h[4], _mm_alignr_epi8(state1, tmp, 8));
+}
+
+#elif defined(__aarch64__)
+
+bool
+SHA256Hardware::IsAvailable() noexcept
+{
+#ifdef __APPLE__
+  /* all 64 bit Apple CPUs have the cryptography extensions */
+  return true;
+#elif defined(__linux__)
+  static const bool available = (getauxval(AT_HWCAP) & HWCAP_SHA2) != 0;
+  return available;
+#else
+  return false;
+#endif
+}
+
+#ifdef __clang__
+[[gnu::target("crypto")]]
+#else
+[[gnu::target("+crypto")]]
+#endif
+static void
+Compress(uint32_t h[8], const std::byte *data, std::size_t n_blocks) noexcept
+{
+  uint32x4_t state0 = vld1q_u32(&h[0]), state1 = vld1q_u32(&h[4]);
+
+  for (; n_blocks > 0; --n_blocks, data += 64) {
+    const uint32x4_t abcd = state0, efgh = state1;
+
+    uint32x4_t msg[4];
+    for (unsigned i = 0; i < 4; ++i)
+      msg[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8((const uint8_t *)data + i * 16)));
+
+    for (unsigned i = 0; i < 16; ++i) {
+      uint32x4_t &m = msg[i & 3];
+      const uint32x4_t wk = vaddq_u32(m, vld1q_u32(&K[i * 4]));
+
+      if (i < 12)
+        m = vsha256su1q_u32(vsha256su0q_u32(m, msg[(i + 1) & 3]),
+                            msg[(i + 2) & 3], msg[(i + 3) & 3]);
+
+      const uint32x4_t tmp = state0;
+      state0 = vsha256hq_u32(state0, state1, wk);
+      state1 = vsha256h2q_u32(state1, tmp, wk);
+    }
+
+    state0 = vaddq_u32(state0, abcd);
+    state1 = vaddq_u32(state1, efgh);
+  }
+
+  vst1q_u32(&h[0], state0);
+  vst1q_u32(&h[4], state1);
+}
+
+#endif
+
+void
+SHA256Hardware::Init() noexcept
+{
+  static constexpr uint32_t initial[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+  };
+
+  std::copy_n(initial, 8, h);
+  size = 0;
+}
+
+void
+SHA256Hardware::Update(const void *_data, std::size_t length) noexcept
+{
+  const auto *data = (const std::byte *)_data;
+
+  std::size_t fill = size % sizeof(buffer);
+  size += length;
+
+  if (fill > 0) {
+    /* complete the partial block from the previous call */
+    const std::size_t n = std::min(sizeof(buffer) - fill, length);
+    memcpy(buffer + fill, data, n);
+    data += n;
+    length -= n;
+
+    if (fill + n < sizeof(buffer))
+      return;
+
+    Compress(h, buffer, 1);
+  }
+
+  /* process whole blocks directly from the caller's buffer */
+  const std::size_t n_blocks = length / sizeof(buffer);
+  Compress(h, data, n_blocks);
+  data += n_blocks * sizeof(buffer);
+  length %= sizeof(buffer);
+
+  memcpy(buffer, data, length);
+}
+
+void
+SHA256Hardware::Final(void *out) noexcept
+{
+  const uint64_t n_bits = ToBE64(size * 8);
+
+  std::size_t fill = size % sizeof(buffer);
+  buffer[fill++] = std::byte{0x80};
+
+  if (fill > sizeof(buffer) - sizeof(n_bits)) {
+    std::fill(buffer + fill, std::end(buffer), std::byte{0});
+    Compress(h, buffer, 1);
+    fill = 0;
+  }
+
+  std::fill(buffer + fill, std::end(buffer) - sizeof(n_bits), std::byte{0});
+  memcpy(std::end(buffer) - sizeof(n_bits), &n_bits, sizeof(n_bits));
+  Compress(h, buffer, 1);
+
+  for (auto &i : h)
+    i = ToBE32(i);
+
+  memcpy(out, h, sizeof(h));
+}
+
+#endif
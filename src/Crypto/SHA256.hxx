@@ -35,19 +35,77 @@
 
 #include <array>
 #include <cstddef> // for std::byte
+#include <cstdint>
 
 using SHA256Digest = std::array<std::byte, crypto_hash_sha256_BYTES>;
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__) || defined(__aarch64__))
+#define HAVE_SHA256_HARDWARE
+#endif
+
+#ifdef HAVE_SHA256_HARDWARE
+
+/**
+ * A SHA256 implementation which uses the CPU's SHA instructions
+ * (SHA-NI on x86, the cryptography extensions on ARMv8).  Only
+ * usable if IsAvailable() returns true.
+ */
+class SHA256Hardware {
+	uint32_t h[8];
+	uint64_t size;
+	std::byte buffer[64];
+
+public:
+	/**
+	 * Does this CPU implement the required instructions?
+	 */
+	[[gnu::const]]
+	static bool IsAvailable() noexcept;
+
+	void Init() noexcept;
+	void Update(const void *data, std::size_t length) noexcept;
+	void Final(void *out) noexcept;
+};
+
+#endif
+
+/**
+ * Calculate a SHA256 digest.  If the CPU supports it, this uses
+ * #SHA256Hardware, and falls back to libsodium otherwise.
+ */
 class SHA256State {
-	crypto_hash_sha256_state state;
+#ifdef HAVE_SHA256_HARDWARE
+	union {
+		crypto_hash_sha256_state sodium;
+		SHA256Hardware hardware;
+	};
+
+	const bool use_hardware = SHA256Hardware::IsAvailable();
+#else
+	crypto_hash_sha256_state sodium;
+#endif
 
 public:
 	SHA256State() noexcept {
-		crypto_hash_sha256_init(&state);
+#ifdef HAVE_SHA256_HARDWARE
+		if (use_hardware) {
+			hardware.Init();
+			return;
+		}
+#endif
+
+		crypto_hash_sha256_init(&sodium);
 	}
 
 	void Update(ConstBuffer<void> p) noexcept {
-		crypto_hash_sha256_update(&state,
+#ifdef HAVE_SHA256_HARDWARE
+		if (use_hardware) {
+			hardware.Update(p.data, p.size);
+			return;
+		}
+#endif
+
+		crypto_hash_sha256_update(&sodium,
 					  (const unsigned char *)p.data,
 					  p.size);
 	}
@@ -58,7 +116,14 @@ public:
 	}
 
 	void Final(void *out) noexcept {
-		crypto_hash_sha256_final(&state, (unsigned char *)out);
+#ifdef HAVE_SHA256_HARDWARE
+		if (use_hardware) {
+			hardware.Final(out);
+			return;
+		}
+#endif
+
+		crypto_hash_sha256_final(&sodium, (unsigned char *)out);
 	}
 
 	auto Final() noexcept {
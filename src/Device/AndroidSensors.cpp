@@ -195,6 +195,40 @@ DeviceDescriptor::OnBarometricPressureSensor(float pressure,
   e.Commit();
 }
 
+void
+DeviceDescriptor::OnBarometricPressureSensor(std::span<const int64_t> timestamps,
+                                             std::span<const float> pressures,
+                                             float sensor_noise_variance) noexcept
+{
+  assert(timestamps.size() == pressures.size());
+
+  if (pressures.empty())
+    return;
+
+  /* feed all samples with their own time stamps into the filter, but
+     edit the blackboard (and wake up the MergeThread) only once for
+     the whole batch */
+  for (std::size_t i = 0; i < pressures.size(); ++i) {
+    const SelfTimingKalmanFilter1d::TimePoint time{
+      duration_cast<SelfTimingKalmanFilter1d::Duration>(nanoseconds{timestamps[i]})
+    };
+
+    kalman_filter.Update(pressures[i], sensor_noise_variance, time);
+  }
+
+  const auto e = BeginEdit();
+  NMEAInfo &basic = *e;
+
+  basic.UpdateClock();
+  basic.alive.Update(basic.clock);
+  basic.ProvideNoncompVario(ComputeNoncompVario(kalman_filter.GetXAbs(),
+                                                kalman_filter.GetXVel()));
+  basic.ProvideStaticPressure(
+      AtmosphericPressure::HectoPascal(kalman_filter.GetXAbs()));
+
+  e.Commit();
+}
+
 void
 DeviceDescriptor::OnPressureAltitudeSensor(float altitude) noexcept
 {
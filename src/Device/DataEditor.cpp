@@ -25,12 +25,19 @@ Copyright_License {
 #include "Blackboard/DeviceBlackboard.hpp"
 
 DeviceDataEditor::DeviceDataEditor(DeviceBlackboard &_blackboard,
-                                   std::size_t idx) noexcept
-  :blackboard(_blackboard), lock(blackboard.mutex),
+                                   std::size_t _idx) noexcept
+  :blackboard(_blackboard), lock(blackboard.mutex, blackboard.lock_statistics.device), idx(_idx),
    basic(blackboard.SetRealState(idx)) {}
 
 void
 DeviceDataEditor::Commit() const noexcept
 {
+  CommitDeferred();
   blackboard.ScheduleMerge();
 }
+
+void
+DeviceDataEditor::CommitDeferred() const noexcept
+{
+  blackboard.DeviceUpdated(idx);
+}
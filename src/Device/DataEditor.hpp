@@ -24,6 +24,7 @@ Copyright_License {
 #pragma once
 
 #include "thread/Mutex.hxx"
+#include "thread/LockStatistics.hpp"
 
 class DeviceBlackboard;
 struct NMEAInfo;
@@ -31,7 +32,9 @@ struct NMEAInfo;
 class DeviceDataEditor {
   DeviceBlackboard &blackboard;
 
-  const std::lock_guard<Mutex> lock;
+  const StatisticsLockGuard<Mutex> lock;
+
+  const std::size_t idx;
 
   NMEAInfo &basic;
 
@@ -41,6 +44,13 @@ public:
 
   void Commit() const noexcept;
 
+  /**
+   * Like Commit(), but don't schedule the merge.  The caller is
+   * responsible for calling DeviceBlackboard::ScheduleMerge() later,
+   * e.g. after a batch of modifications.
+   */
+  void CommitDeferred() const noexcept;
+
   NMEAInfo *operator->() const noexcept {
     return &basic;
   }
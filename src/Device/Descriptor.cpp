@@ -26,6 +26,8 @@ Copyright_License {
 #include "Driver.hpp"
 #include "Parser.hpp"
 #include "Util/NMEAWriter.hpp"
+#include "Util/PortOutputThread.hpp"
+#include "Dispatcher.hpp"
 #include "Register.hpp"
 #include "Driver/FLARM/Device.hpp"
 #include "Driver/LX/Internal.hpp"
@@ -35,6 +37,7 @@ Copyright_License {
 #include "Port/DumpPort.hpp"
 #include "NMEA/Info.hpp"
 #include "thread/Mutex.hxx"
+#include "thread/TraceEvents.hpp"
 #include "util/StringAPI.hxx"
 #include "util/ConvertString.hpp"
 #include "util/Exception.hxx"
@@ -46,6 +49,7 @@ Copyright_License {
 #include "Input/InputQueue.hpp"
 #include "LogFile.hpp"
 #include "Job/Job.hpp"
+#include "Audio/VarioGlue.hpp"
 
 #ifdef ANDROID
 #include "java/Object.hxx"
@@ -72,6 +76,7 @@ Copyright_License {
 #endif
 
 #include <cassert>
+#include <utility>
 
 /**
  * This scope class calls DeviceDescriptor::Return() and
@@ -215,6 +220,21 @@ DeviceDescriptor::CancelAsync()
   open_job = nullptr;
 }
 
+void
+DeviceDescriptor::CloseOutputThread() noexcept
+{
+  std::unique_ptr<PortOutputThread> old;
+
+  {
+    const std::lock_guard<Mutex> lock(mutex);
+    old = std::move(output_thread);
+  }
+
+  /* stop the thread outside of the mutex, because it may be blocked
+     in Port::Write() for a while */
+  old.reset();
+}
+
 inline bool
 DeviceDescriptor::OpenOnPort(std::unique_ptr<DumpPort> &&_port, OperationEnvironment &env)
 {
@@ -255,9 +275,16 @@ DeviceDescriptor::OpenOnPort(std::unique_ptr<DumpPort> &&_port, OperationEnviron
   } else
     port->StartRxThread();
 
+  if (driver->IsNMEAOut()) {
+    const std::lock_guard<Mutex> lock(mutex);
+    output_thread = std::make_unique<PortOutputThread>(*port);
+  }
+
   EnableNMEA(env);
 
   if (env.IsCancelled()) {
+    CloseOutputThread();
+
     /* the caller is responsible for freeing the port on error */
     port = nullptr;
     delete device;
@@ -613,6 +640,8 @@ DeviceDescriptor::Close()
   delete second_device;
   second_device = nullptr;
 
+  CloseOutputThread();
+
   port.reset();
 
   has_failed = false;
@@ -828,16 +857,11 @@ DeviceDescriptor::ParseNMEA(const char *line, NMEAInfo &info)
 }
 
 void
-DeviceDescriptor::ForwardLine(const char *line)
+DeviceDescriptor::ForwardData(const char *data, std::size_t size) noexcept
 {
-  /* XXX make this method thread-safe; this method can be called from
-     any thread, and if the Port gets closed, bad things happen */
-
-  if (IsNMEAOut() && port != nullptr) {
-    Port *p = port.get();
-    p->Write(line);
-    p->Write("\r\n");
-  }
+  const std::lock_guard<Mutex> lock(mutex);
+  if (output_thread)
+    output_thread->Write(data, size);
 }
 
 bool
@@ -1273,6 +1297,8 @@ DeviceDescriptor::PortError(const char *msg) noexcept
 bool
 DeviceDescriptor::DataReceived(const void *data, size_t length) noexcept
 {
+  const ScopeTraceEvent trace("DeviceData");
+
   if (monitor != nullptr)
     monitor->DataReceived(data, length);
 
@@ -1281,6 +1307,7 @@ DeviceDescriptor::DataReceived(const void *data, size_t length) noexcept
     auto basic = device_blackboard->LockGetDeviceDataUpdateClock(index);
 
     const ExternalSettings old_settings = basic.settings;
+    const Validity old_vario = basic.total_energy_vario_available;
 
     /* call Device::DataReceived() without holding
        DeviceBlackboard::mutex to avoid blocking all other threads */
@@ -1288,15 +1315,30 @@ DeviceDescriptor::DataReceived(const void *data, size_t length) noexcept
       if (!config.sync_from_device)
         basic.settings = old_settings;
 
+      if (basic.total_energy_vario_available.Modified(old_vario))
+        AudioVarioGlue::FeedDirect(index, basic.total_energy_vario);
+
       device_blackboard->LockSetDeviceDataScheuduleMerge(index, basic);
     }
 
     return true;
   }
 
-  if (!IsNMEAOut())
+  if (!IsNMEAOut()) {
     PortLineSplitter::DataReceived(data, length);
 
+    /* forward all lines of this chunk to the NMEA outputs with one
+       write per output */
+    if (dispatcher != nullptr)
+      dispatcher->Flush();
+
+    /* all lines in this chunk have been parsed; wake up the
+       MergeThread only once for all of them */
+    if (std::exchange(merge_pending, false))
+      device_blackboard->ScheduleMerge(std::exchange(new_fix_pending,
+                                                     false));
+  }
+
   return true;
 }
 
@@ -1308,10 +1350,32 @@ DeviceDescriptor::LineReceived(const char *line) noexcept
   if (dispatcher != nullptr)
     dispatcher->LineReceived(line);
 
-  const auto e = BeginEdit();
-  e->UpdateClock();
-  ParseNMEA(line, *e);
-  e.Commit();
+  bool vario_modified;
+  double vario;
+
+  {
+    const auto e = BeginEdit();
+    e->UpdateClock();
+
+    const Validity old_location = e->location_available;
+    const Validity old_vario = e->total_energy_vario_available;
+    ParseNMEA(line, *e);
+    if (e->location_available.Modified(old_location))
+      new_fix_pending = true;
+
+    vario_modified = e->total_energy_vario_available.Modified(old_vario);
+    vario = e->total_energy_vario;
+
+    /* DataReceived() will schedule the merge after the last line of
+       this chunk */
+    e.CommitDeferred();
+  }
+
+  merge_pending = true;
+
+  /* the audio vario doesn't need to wait for the MergeThread */
+  if (vario_modified)
+    AudioVarioGlue::FeedDirect(index, vario);
 
   return true;
 }
@@ -79,6 +79,8 @@ struct RecordedFlightInfo;
 class OperationEnvironment;
 class OpenDeviceJob;
 class DeviceDataEditor;
+class DeviceDispatcher;
+class PortOutputThread;
 
 class DeviceDescriptor final
   : PortListener,
@@ -141,11 +143,30 @@ class DeviceDescriptor final
    */
   DataHandler *monitor = nullptr;
 
+  /**
+   * Writes lines forwarded from other devices to #port, if this is
+   * a NMEA out port.  Protected by #mutex.
+   */
+  std::unique_ptr<PortOutputThread> output_thread;
+
   /**
    * A handler that will receive all NMEA lines, to dispatch it to
    * other devices.
    */
-  PortLineHandler *dispatcher = nullptr;
+  DeviceDispatcher *dispatcher = nullptr;
+
+  /**
+   * Has LineReceived() modified the #DeviceBlackboard without
+   * scheduling a merge?  DataReceived() schedules one merge for all
+   * lines of a chunk.  Only accessed by the port's thread.
+   */
+  bool merge_pending = false;
+
+  /**
+   * Has one of these lines contained a new GPS fix?  Then the merge
+   * is scheduled without delay.
+   */
+  bool new_fix_pending = false;
 
   /**
    * The device driver used to handle data to/from the device.
@@ -385,6 +406,12 @@ private:
   gcc_nonnull_all
   bool OpenOnPort(std::unique_ptr<DumpPort> &&port, OperationEnvironment &env);
 
+  /**
+   * Stop and delete the #output_thread.  Must be called before the
+   * #port is deleted.
+   */
+  void CloseOutputThread() noexcept;
+
   bool OpenInternalSensors();
 
   bool OpenDroidSoarV2();
@@ -538,14 +565,16 @@ public:
     monitor = _monitor;
   }
 
-  void SetDispatcher(PortLineHandler *_dispatcher) {
+  void SetDispatcher(DeviceDispatcher *_dispatcher) {
     dispatcher = _dispatcher;
   }
 
   /**
-   * Write a line to the device's port if it's a NMEA out port.
+   * Write lines (terminated with CR LF) to the device's port if it's
+   * a NMEA out port.  This never blocks; if the port is stalled, the
+   * data is dropped.  May be called from any thread.
    */
-  void ForwardLine(const char *line);
+  void ForwardData(const char *data, std::size_t size) noexcept;
 
   bool WriteNMEA(const char *line, OperationEnvironment &env);
 #ifdef _UNICODE
@@ -631,6 +660,9 @@ private:
   void OnMagneticFieldSensor(float h_x, float h_y, float h_z) noexcept override;
   void OnBarometricPressureSensor(float pressure,
                                   float sensor_noise_variance) noexcept override;
+  void OnBarometricPressureSensor(std::span<const int64_t> timestamps,
+                                  std::span<const float> pressures,
+                                  float sensor_noise_variance) noexcept override;
   void OnPressureAltitudeSensor(float altitude) noexcept override;
   void OnI2CbaroSensor(int index, int sensorType,
                        AtmosphericPressure pressure) noexcept override;
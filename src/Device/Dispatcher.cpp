@@ -25,9 +25,17 @@ Copyright_License {
 #include "Descriptor.hpp"
 #include "MultipleDevices.hpp"
 
-bool
-DeviceDispatcher::LineReceived(const char *line) noexcept
+/**
+ * Flush the batch early if it grows beyond this size.
+ */
+static constexpr std::size_t MAX_BATCH = 1024;
+
+void
+DeviceDispatcher::Flush() noexcept
 {
+  if (batch.empty())
+    return;
+
   unsigned i = 0;
   for (DeviceDescriptor *device : devices) {
     if (i++ == exclude)
@@ -37,8 +45,20 @@ DeviceDispatcher::LineReceived(const char *line) noexcept
     if (device == nullptr)
       continue;
 
-    device->ForwardLine(line);
+    device->ForwardData(batch.data(), batch.size());
   }
 
+  batch.clear();
+}
+
+bool
+DeviceDispatcher::LineReceived(const char *line) noexcept
+{
+  batch.append(line);
+  batch.append("\r\n");
+
+  if (batch.size() >= MAX_BATCH)
+    Flush();
+
   return true;
 }
@@ -26,10 +26,15 @@ Copyright_License {
 
 #include "Device/Util/LineHandler.hpp"
 
+#include <string>
+
 class MultipleDevices;
 
 /**
  * A #DataHandler that dispatches incoming data to all NMEA outputs.
+ *
+ * Lines are collected until Flush() is called at the end of each
+ * received chunk, and then written to each output at once.
  */
 class DeviceDispatcher final : public PortLineHandler {
   MultipleDevices &devices;
@@ -40,10 +45,22 @@ class DeviceDispatcher final : public PortLineHandler {
    */
   unsigned exclude;
 
+  /**
+   * The lines received since the last Flush(), each terminated with
+   * CR LF.  Only accessed by the port's thread.
+   */
+  std::string batch;
+
 public:
   DeviceDispatcher(MultipleDevices &_devices, unsigned _exclude)
     :devices(_devices), exclude(_exclude) {}
 
+  /**
+   * Forward all lines received since the last call to all NMEA
+   * outputs.
+   */
+  void Flush() noexcept;
+
   /* virtual methods from DataHandler */
   bool LineReceived(const char *line) noexcept override;
 };
@@ -23,6 +23,7 @@ Copyright_License {
 
 #include "Internal.hpp"
 #include "Protocol.hpp"
+#include "Device/Port/Port.hpp"
 #include "Device/RecordedFlight.hpp"
 #include "Operation/Operation.hpp"
 #include "util/ByteOrder.hxx"
@@ -106,6 +107,12 @@ CAI302Device::ReadFlightList(RecordedFlightList &flight_list,
   return true;
 }
 
+/**
+ * How often shall a file data block be requested again after a
+ * transmission error?
+ */
+static constexpr unsigned MAX_BLOCK_RETRIES = 3;
+
 static bool
 DownloadFlightInner(Port &port, const RecordedFlightInfo &flight,
                     Path path, OperationEnvironment &env)
@@ -134,6 +141,18 @@ DownloadFlightInner(Port &port, const RecordedFlightInfo &flight,
   unsigned valid_bytes;
   do {
     int i = UploadFileData(port, true, header, allocated_size, env);
+    for (unsigned retry = 0;
+         i < (int)sizeof(*header) && retry < MAX_BLOCK_RETRIES &&
+           !env.IsCancelled();
+         ++retry) {
+      /* the link has dropped in the middle of the block; discard
+         what's still in transit and ask the CAI302 to retransfer the
+         block, instead of starting all over again */
+      port.FullFlush(env, std::chrono::milliseconds(200),
+                     std::chrono::seconds(2));
+      i = UploadFileData(port, false, header, allocated_size, env);
+    }
+
     if (i < (int)sizeof(*header))
       return false;
 
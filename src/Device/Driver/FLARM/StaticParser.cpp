@@ -134,10 +134,9 @@ ParsePFLAA(NMEAInputLine &line, TrafficList &flarm, TimeStamp clock) noexcept
 
   line.Skip(); /* id type */
 
-  // 5 id, 6 digit hex
-  char id_string[16];
-  line.Read(id_string, 16);
-  traffic.id = FlarmId::Parse(id_string, nullptr);
+  // 5 id, 6 digit hex; parsed in place, strtol() stops at the comma
+  traffic.id = FlarmId::Parse(line.Rest().begin(), nullptr);
+  line.Skip();
 
   Angle track;
   traffic.track_received = ReadBearing(line, track);
@@ -181,14 +180,11 @@ ParsePFLAA(NMEAInputLine &line, TrafficList &flarm, TimeStamp clock) noexcept
 
   FlarmTraffic *flarm_slot = flarm.FindTraffic(traffic.id);
   if (flarm_slot == nullptr) {
-    flarm_slot = flarm.AllocateTraffic();
+    flarm_slot = flarm.AllocateTraffic(traffic.id);
     if (flarm_slot == nullptr)
       // no more slots available
       return;
 
-    flarm_slot->Clear();
-    flarm_slot->id = traffic.id;
-
     flarm.new_traffic.Update(clock);
   }
 
@@ -196,4 +192,5 @@ ParsePFLAA(NMEAInputLine &line, TrafficList &flarm, TimeStamp clock) noexcept
   flarm_slot->valid.Update(clock);
 
   flarm_slot->Update(traffic);
+  flarm.InvalidateGrid();
 }
@@ -203,6 +203,28 @@ IMI::ReadFlightList(Port &port, RecordedFlightList &flight_list,
   return false;
 }
 
+/**
+ * Like FlashRead(), but if the link drops, flush the port and request
+ * the same block again.  Blocks are addressed absolutely, so the
+ * download resumes right where it was interrupted.
+ */
+static bool
+FlashReadRetry(Port &port, void *buffer, unsigned address, unsigned size,
+               OperationEnvironment &env)
+{
+  for (unsigned retry = 0;; ++retry) {
+    try {
+      return IMI::FlashRead(port, buffer, address, size, env);
+    } catch (const std::runtime_error &) {
+      if (retry >= 3 || env.IsCancelled())
+        throw;
+    }
+
+    port.FullFlush(env, std::chrono::milliseconds(200),
+                   std::chrono::seconds(2));
+  }
+}
+
 bool
 IMI::FlightDownload(Port &port, const RecordedFlightInfo &flight_info,
                     Path path, OperationEnvironment &env)
@@ -233,7 +255,8 @@ IMI::FlightDownload(Port &port, const RecordedFlightInfo &flight_info,
     if (fixesToRead > fixesCount)
       fixesToRead = fixesCount;
 
-    if (!FlashRead(port, fixBuffer.get(), address, fixesToRead * sizeof(Fix), env))
+    if (!FlashReadRetry(port, fixBuffer.get(), address,
+                        fixesToRead * sizeof(Fix), env))
       return false;
 
     for (unsigned i = 0; i < fixesToRead; i++) {
@@ -291,6 +291,28 @@ HandleFlightLine(const char *_line, BufferedOutputStream &os,
   return true;
 }
 
+/**
+ * The number of rows requested with one "PLXVC,FLIGHT,R" command.
+ */
+static constexpr unsigned FLIGHT_ROWS_PER_REQUEST = 32;
+
+/**
+ * How often may a request fail in a row (without receiving a single
+ * valid line) before we give up?
+ */
+static constexpr unsigned MAX_FLIGHT_FAILURES = 5;
+
+static unsigned
+NextFlightRange(unsigned start, unsigned row_count)
+{
+  if (row_count == 0)
+    /* request only the first line to learn the length of the file */
+    return 1;
+
+  assert(start <= row_count);
+  return std::min(FLIGHT_ROWS_PER_REQUEST, row_count - start + 1);
+}
+
 static bool
 DownloadFlightInner(Port &port, const char *filename, BufferedOutputStream &os,
                     OperationEnvironment &env)
@@ -298,62 +320,83 @@ DownloadFlightInner(Port &port, const char *filename, BufferedOutputStream &os,
   PortNMEAReader reader(port, env);
   unsigned row_count = 0, i = 1;
 
-  while (true) {
-    /* read up to 32 lines at a time */
-    unsigned nrequest = row_count == 0 ? 1 : 32;
-    if (row_count > 0) {
-      assert(i <= row_count);
-      const unsigned remaining = row_count - i + 1;
-      if (nrequest > remaining)
-        nrequest = remaining;
-    }
+  /* the end (exclusive) of the last requested range; the rows
+     between i and this one are in transit */
+  unsigned requested_end = 1;
 
-    const unsigned start = i;
-    const unsigned end = start + nrequest;
-    unsigned request_retry_count = 0;
+  /* the start of the last requested range */
+  unsigned last_start = 0;
 
-    /* read the requested lines and save to file */
+  /* the start of the range which was requested while another one was
+     still in transit; 0 if there is none */
+  unsigned pipelined_start = 0;
 
-    while (i != end) {
-      if (i == start) {
-        /* send request range to Nano */
-        reader.Flush();
-        if (!RequestFlight(port, filename, start, end, env))
-          return false;
-        request_retry_count++;
-      }
+  /* keep two requests outstanding, so the Nano doesn't have to wait
+     for a round trip after each range; this is disabled as soon as it
+     appears to confuse the logger */
+  bool pipeline = true;
 
-      TimeoutClock timeout(std::chrono::seconds(2));
-      const char *line = reader.ExpectLine("PLXVC,FLIGHT,A,", timeout);
-      if (line == nullptr || !HandleFlightLine(line, os, i, row_count)) {
-        if (request_retry_count > 5)
-          return false;
+  unsigned failures = 0;
 
-        /* Discard data which might still be in-transit, e.g. buffered
-           inside a bluetooth dongle */
-        port.FullFlush(env, std::chrono::milliseconds(200),
-                       std::chrono::seconds(2));
+  while (row_count == 0 || i <= row_count) {
+    if (i == requested_end) {
+      /* nothing in transit: send the next request */
+      reader.Flush();
 
-        /* If we already received parts of the request range correctly break
-           out of the loop to calculate new request range */
-        if (i != start)
-          break;
+      last_start = i;
+      requested_end = i + NextFlightRange(i, row_count);
+      if (!RequestFlight(port, filename, last_start, requested_end, env))
+        return false;
+    }
 
-        /* No valid reply received (i==start) - request same range again */
-      }
+    TimeoutClock timeout(std::chrono::seconds(2));
+    const char *line = reader.ExpectLine("PLXVC,FLIGHT,A,", timeout);
+    if (line == nullptr || !HandleFlightLine(line, os, i, row_count)) {
+      if (env.IsCancelled() || ++failures > MAX_FLIGHT_FAILURES)
+        return false;
+
+      if (pipelined_start != 0 && i <= pipelined_start)
+        /* the pipelined request did not get through; fall back to
+           one request at a time */
+        pipeline = false;
+
+      pipelined_start = 0;
+
+      /* Discard data which might still be in-transit, e.g. buffered
+         inside a bluetooth dongle */
+      port.FullFlush(env, std::chrono::milliseconds(200),
+                     std::chrono::seconds(2));
+
+      /* resume with the first row which was not received yet */
+      requested_end = i;
+      continue;
     }
 
-    if (i > row_count)
-      /* finished successfully */
-      return true;
+    failures = 0;
 
-    if (start == 1)
-      /* configure the range in the first iteration, now that we know
+    if (i == 2)
+      /* configure the range after the first line, now that we know
          the length of the file */
       env.SetProgressRange(row_count);
 
-    env.SetProgressPosition(i - 1);
+    if (i == last_start + 1) {
+      /* the first line of the last range has arrived: the logger is
+         busy with it, so this is a good time to queue the next
+         request */
+      pipelined_start = 0;
+
+      if (pipeline && last_start > 1 && requested_end <= row_count) {
+        last_start = pipelined_start = requested_end;
+        requested_end += NextFlightRange(requested_end, row_count);
+        if (!RequestFlight(port, filename, last_start, requested_end, env))
+          return false;
+      }
+
+      env.SetProgressPosition(i - 1);
+    }
   }
+
+  return true;
 }
 
 bool
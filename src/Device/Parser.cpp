@@ -32,6 +32,9 @@ Copyright_License {
 #include "Driver/FLARM/StaticParser.hpp"
 #include "util/CharUtil.hxx"
 
+#include <cstddef>
+#include <cstdint>
+
 NMEAParser::NMEAParser()
 {
   Reset();
@@ -45,6 +48,33 @@ NMEAParser::Reset()
   last_time = {};
 }
 
+/**
+ * Pack a sentence name of up to 8 characters into an integer, which
+ * can be used in a "switch" statement.  This is a perfect hash: no
+ * two supported names have the same key.  Returns 0 if the name is
+ * too long.
+ */
+static constexpr uint64_t
+SentenceKey(const char *name, std::size_t length) noexcept
+{
+  if (length > 8)
+    return 0;
+
+  uint64_t key = 0;
+  for (std::size_t i = 0; i < length; ++i)
+    key = (key << 8) | (unsigned char)name[i];
+  return key;
+}
+
+static constexpr uint64_t
+SentenceKey(const char *name) noexcept
+{
+  std::size_t length = 0;
+  while (name[length] != 0)
+    ++length;
+  return SentenceKey(name, length);
+}
+
 bool
 NMEAParser::ParseLine(const char *string, NMEAInfo &info)
 {
@@ -58,59 +88,60 @@ NMEAParser::ParseLine(const char *string, NMEAInfo &info)
 
   NMEAInputLine line(string);
 
-  char type[16];
-  line.Read(type, 16);
+  /* look at the sentence name in place, without copying it */
+  const char *type = line.Rest().begin();
+  const std::size_t type_length = line.Skip();
 
-  if (IsAlphaASCII(type[1]) && IsAlphaASCII(type[2])) {
-    if (StringIsEqual(type + 3, "GSA"))
+  if (type_length == 6 && IsAlphaASCII(type[1]) && IsAlphaASCII(type[2])) {
+    switch (SentenceKey(type + 3, 3)) {
+    case SentenceKey("GSA"):
       return GSA(line, info);
 
-    if (StringIsEqual(type + 3, "GLL"))
+    case SentenceKey("GLL"):
       return GLL(line, info);
 
-    if (StringIsEqual(type + 3, "RMC"))
+    case SentenceKey("RMC"):
       return RMC(line, info);
 
-    if (StringIsEqual(type + 3, "GGA"))
+    case SentenceKey("GGA"):
       return GGA(line, info);
 
-    if (StringIsEqual(type + 3, "HDM"))
+    case SentenceKey("HDM"):
       return HDM(line, info);
 
-    if (StringIsEqual(type + 3, "MWV"))
+    case SentenceKey("MWV"):
       return MWV(line, info);
+    }
   }
 
   // if (proprietary sentence) ...
-  if (type[1] == 'P') {
+  if (type_length > 1 && type[1] == 'P') {
+    switch (SentenceKey(type + 1, type_length - 1)) {
     // Airspeed and vario sentence
-    if (StringIsEqual(type + 1, "PTAS1"))
+    case SentenceKey("PTAS1"):
       return PTAS1(line, info);
 
     // FLARM sentences
-    if (StringIsEqual(type + 1, "PFLAE")) {
+    case SentenceKey("PFLAE"):
       ParsePFLAE(line, info.flarm.error, info.clock);
       return true;
-    }
 
-    if (StringIsEqual(type + 1, "PFLAV")) {
+    case SentenceKey("PFLAV"):
       ParsePFLAV(line, info.flarm.version, info.clock);
       return true;
-    }
 
-    if (StringIsEqual(type + 1, "PFLAA")) {
+    case SentenceKey("PFLAA"):
       ParsePFLAA(line, info.flarm.traffic, info.clock);
       return true;
-    }
 
-    if (StringIsEqual(type + 1, "PFLAU")) {
+    case SentenceKey("PFLAU"):
       ParsePFLAU(line, info.flarm.status, info.clock);
       return true;
-    }
 
     // Garmin altitude sentence
-    if (StringIsEqual(type + 1, "PGRMZ"))
+    case SentenceKey("PGRMZ"):
       return RMZ(line, info);
+    }
 
     return false;
   }
@@ -651,7 +682,7 @@ NMEAParser::GGA(NMEAInputLine &line, NMEAInfo &info)
     //
     if (use_geoid && info.location_available) {
       // JMW TODO really need to know the actual device..
-      geoid_separation = EGM96::LookupSeparation(info.location);
+      geoid_separation = geoid_cache.Lookup(info.location);
       info.gps_altitude -= geoid_separation;
     }
   }
@@ -25,6 +25,7 @@ Copyright_License {
 #define XCSOAR_DEVICE_PARSER_HPP
 
 #include "time/Stamp.hpp"
+#include "Geo/Geoid.hpp"
 
 struct NMEAInfo;
 class NMEAInputLine;
@@ -36,6 +37,8 @@ class NMEAParser
 {
   TimeStamp last_time;
 
+  EGM96::SeparationCache geoid_cache;
+
 public:
   bool real;
 
@@ -23,16 +23,14 @@ Copyright_License {
 
 #include "BufferedPort.hpp"
 #include "time/TimeoutClock.hpp"
-
-#include <algorithm>
+#include "util/ScopeExit.hxx"
 
 #include <cassert>
 
 void
 BufferedPort::Flush()
 {
-  std::lock_guard<Mutex> lock(mutex);
-  buffer.Clear();
+  buffer.clear();
 }
 
 bool
@@ -51,7 +49,7 @@ BufferedPort::StartRxThread()
   std::lock_guard<Mutex> lock(mutex);
   if (!running) {
     running = true;
-    buffer.Clear();
+    buffer.clear();
   }
 
   cond.notify_all();
@@ -63,24 +61,29 @@ BufferedPort::Read(void *dest, size_t length)
 {
   assert(!running);
 
-  std::lock_guard<Mutex> lock(mutex);
-
-  auto r = buffer.Read();
-  if (r.size == 0)
+  size_t nbytes = buffer.shift((uint8_t *)dest, length);
+  if (nbytes == 0)
     return -1;
 
-  size_t nbytes = std::min(length, r.size);
-  std::copy_n(r.data, nbytes, (uint8_t *)dest);
-  buffer.Consume(nbytes);
   return nbytes;
 }
 
 Port::WaitResult
 BufferedPort::WaitRead(std::chrono::steady_clock::duration _timeout)
 {
+  if (!buffer.empty())
+    return WaitResult::READY;
+
   TimeoutClock timeout(_timeout);
   std::unique_lock<Mutex> lock(mutex);
 
+  /* announce that we may sleep before checking the buffer again; the
+     fence pairs with the one in DataReceived(), so either we see the
+     new data or DataReceived() sees this flag */
+  waiting.store(true, std::memory_order_relaxed);
+  AtScopeExit(this) { waiting.store(false, std::memory_order_relaxed); };
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
   while (buffer.empty()) {
     if (running)
       return WaitResult::CANCELLED;
@@ -101,23 +104,15 @@ BufferedPort::DataReceived(const void *data, size_t length) noexcept
   if (running) {
     return handler.DataReceived(data, length);
   } else {
-    const uint8_t *p = (const uint8_t *)data;
-
-    std::lock_guard<Mutex> lock(mutex);
-
-    buffer.Shift();
-    auto r = buffer.Write();
-    if (r.size == 0)
-      /* the buffer is already full, discard excess data */
-      return true;
-
-    /* discard excess data */
-    size_t nbytes = std::min(length, r.size);
+    /* if the buffer is full, excess data is discarded */
+    buffer.push((const uint8_t *)data, length);
 
-    std::copy_n(p, nbytes, r.data);
-    buffer.Append(nbytes);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiting.load(std::memory_order_relaxed)) {
+      std::lock_guard<Mutex> lock(mutex);
+      cond.notify_all();
+    }
 
-    cond.notify_all();
     return true;
   }
 }
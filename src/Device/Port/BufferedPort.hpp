@@ -28,8 +28,9 @@ Copyright_License {
 #include "io/DataHandler.hpp"
 #include "thread/Mutex.hxx"
 #include "thread/Cond.hxx"
-#include "util/StaticFifoBuffer.hxx"
+#include "util/LockFreeRingBuffer.hpp"
 
+#include <atomic>
 #include <cstdint>
 
 /**
@@ -37,20 +38,34 @@ Copyright_License {
  * FIFO buffer.  This buffer can be fed from another thread.  Derive
  * from this class and call DataReceived() (or use the DataHandler
  * base class) whenever you get some data from the device.
+ *
+ * The buffer is a lock-free single-producer single-consumer ring:
+ * the receiving thread never waits for the thread which reads from
+ * the port.  The mutex is only needed to sleep in WaitRead().
  */
 class BufferedPort : public Port, protected DataHandler {
   /**
-   * Protects the buffer and the flags.
+   * Protects the flags and serialises #cond.
    */
   Mutex mutex;
 
   /**
    * Emitted by DataReceived() after data has been placed into the
-   * buffer.
+   * buffer, if WaitRead() is waiting for it.
    */
   Cond cond;
 
-  StaticFifoBuffer<uint8_t, 16384> buffer;
+  /**
+   * Filled by DataReceived() (the producer), consumed by Read()
+   * (the consumer).
+   */
+  LockFreeRingBuffer<uint8_t, 16384> buffer;
+
+  /**
+   * Is WaitRead() about to sleep on #cond?  DataReceived() locks the
+   * mutex to signal only if this is set.
+   */
+  std::atomic_bool waiting{false};
 
   bool running = false;
 
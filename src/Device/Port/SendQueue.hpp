@@ -0,0 +1,66 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_DEVICE_SEND_QUEUE_HPP
+#define XCSOAR_DEVICE_SEND_QUEUE_HPP
+
+#include "util/StaticFifoBuffer.hxx"
+
+#include <algorithm>
+#include <cstddef>
+
+/**
+ * A fixed-size queue of bytes waiting to be sent, which accepts a
+ * chunk of data only as a whole.
+ */
+template<std::size_t size>
+class SendQueue : public StaticFifoBuffer<std::byte, size> {
+  using Base = StaticFifoBuffer<std::byte, size>;
+
+public:
+  /**
+   * Append the whole chunk, or nothing if it does not fit.  All free
+   * space counts, including the space before the queued data which
+   * has already been consumed.
+   *
+   * @return false if there was not enough room
+   */
+  bool Push(const std::byte *data, std::size_t length) noexcept {
+    if (length > size - Base::GetAvailable())
+      return false;
+
+    auto w = Base::Write();
+    if (w.size < length) {
+      /* the free space is split; move the queued data to the
+         front */
+      Base::Shift();
+      w = Base::Write();
+    }
+
+    std::copy_n(data, length, w.data);
+    Base::Append(length);
+    return true;
+  }
+};
+
+#endif
@@ -27,12 +27,111 @@ Copyright_License {
 #include "net/UniqueSocketDescriptor.hxx"
 #include "event/Call.hxx"
 
+TCPPort::Client::Client(TCPPort &_port, SocketDescriptor fd) noexcept
+  :port(_port),
+   socket(_port.GetEventLoop(), BIND_THIS_METHOD(OnSocketReady), fd)
+{
+  socket.ScheduleRead();
+}
+
+bool
+TCPPort::Client::Flush() noexcept
+{
+  auto r = output.Read();
+  if (r.empty())
+    return true;
+
+  ssize_t nbytes = socket.GetSocket().Write(r.data, r.size);
+  if (nbytes < 0)
+    return IsSocketErrorSendWouldBlock(GetSocketError());
+
+  output.Consume(nbytes);
+  return true;
+}
+
+bool
+TCPPort::Client::Write(const std::byte *data, std::size_t length) noexcept
+{
+  if (dropped)
+    return false;
+
+  if (output.empty()) {
+    /* fast path: nothing queued, try to send right away */
+    ssize_t nbytes = socket.GetSocket().Write(data, length);
+    if (nbytes < 0) {
+      if (!IsSocketErrorSendWouldBlock(GetSocketError())) {
+        dropped = true;
+        return true;
+      }
+
+      nbytes = 0;
+    }
+
+    data += nbytes;
+    length -= nbytes;
+    if (length == 0)
+      return false;
+  }
+
+  if (!output.Push(data, length))
+    /* the client doesn't keep up; don't let it hold back the
+       others */
+    dropped = true;
+
+  return true;
+}
+
+bool
+TCPPort::Client::Update() noexcept
+{
+  if (dropped)
+    return false;
+
+  if (!output.empty())
+    socket.ScheduleWrite();
+
+  return true;
+}
+
+void
+TCPPort::Client::OnSocketReady(unsigned events) noexcept
+{
+  if (events & SocketEvent::WRITE) {
+    const std::lock_guard lock{port.mutex};
+
+    if (!Flush()) {
+      dropped = true;
+      port.inject_event.Schedule();
+      return;
+    }
+
+    if (output.empty())
+      socket.CancelWrite();
+  }
+
+  if (events & (SocketEvent::READ|SocketEvent::IMPLICIT_FLAGS)) {
+    char input[4096];
+    ssize_t nbytes = socket.GetSocket().Read(input, sizeof(input));
+    if (nbytes < 0 && IsSocketErrorReceiveWouldBlock(GetSocketError()))
+      return;
+
+    if (nbytes <= 0) {
+      /* connection closed or failed; this only affects this
+         client */
+      port.RemoveClient(*this);
+      return;
+    }
+
+    port.DataReceived(input, nbytes);
+  }
+}
+
 TCPPort::TCPPort(EventLoop &event_loop,
                  unsigned port,
                  PortListener *_listener, DataHandler &_handler)
   :BufferedPort(_listener, _handler),
    listener(event_loop, BIND_THIS_METHOD(OnListenerReady)),
-   connection(event_loop, BIND_THIS_METHOD(OnConnectionReady))
+   inject_event(event_loop, BIND_THIS_METHOD(OnInject))
 {
   const IPv4Address address(port);
 
@@ -47,7 +146,7 @@ TCPPort::TCPPort(EventLoop &event_loop,
   if (!s.Bind(address))
     throw MakeSocketError("Failed to bind socket");
 
-  if (!s.Listen(1))
+  if (!s.Listen(MAX_CLIENTS))
     throw MakeSocketError("Failed to listen on socket");
 
   listener.Open(s.Release());
@@ -60,7 +159,13 @@ TCPPort::TCPPort(EventLoop &event_loop,
 TCPPort::~TCPPort()
 {
   BlockingCall(GetEventLoop(), [this](){
-    connection.Close();
+    inject_event.Cancel();
+
+    {
+      const std::lock_guard lock{mutex};
+      clients.clear();
+    }
+
     listener.Close();
   });
 }
@@ -68,7 +173,9 @@ TCPPort::~TCPPort()
 PortState
 TCPPort::GetState() const
 {
-  if (connection.IsDefined())
+  const std::lock_guard lock{mutex};
+
+  if (!clients.empty())
     return PortState::READY;
   else if (listener.IsDefined())
     return PortState::LIMBO;
@@ -79,58 +186,78 @@ TCPPort::GetState() const
 size_t
 TCPPort::Write(const void *data, size_t length)
 {
-  if (!connection.IsDefined())
-    return 0;
+  const std::lock_guard lock{mutex};
 
-  ssize_t nbytes = connection.GetSocket().Write(data, length);
-  if (nbytes < 0)
-    // TODO check EAGAIN?
+  if (clients.empty())
     return 0;
 
-  return nbytes;
+  /* the same buffer goes to all clients */
+  bool wake = false;
+  for (auto &client : clients)
+    wake |= client.Write((const std::byte *)data, length);
+
+  if (wake)
+    inject_event.Schedule();
+
+  return length;
 }
 
 void
-TCPPort::OnListenerReady(unsigned) noexcept
-try {
-  SocketDescriptor s = listener.GetSocket().Accept();
-  if (!s.IsDefined())
-    throw MakeSocketError("Failed to accept");
+TCPPort::RemoveClient(Client &client) noexcept
+{
+  {
+    const std::lock_guard lock{mutex};
+    clients.remove_if([&client](const Client &c){
+      return &c == &client;
+    });
+  }
 
-#ifdef _WIN32
-  const DWORD value = 1000;
-#else
-  const struct timeval value{1, 0};
-#endif
+  StateChanged();
+}
 
-  s.SetOption(SOL_SOCKET, SO_SNDTIMEO, &value, sizeof(value));
+void
+TCPPort::OnInject() noexcept
+{
+  bool removed = false;
 
-  connection.Close();
-  connection.Open(s);
-  connection.ScheduleRead();
-} catch (...) {
-  listener.Close();
-  StateChanged();
-  Error(std::current_exception());
+  {
+    const std::lock_guard lock{mutex};
+    clients.remove_if([&removed](Client &client){
+      if (client.Update())
+        return false;
+
+      removed = true;
+      return true;
+    });
+  }
+
+  if (removed)
+    StateChanged();
 }
 
 void
-TCPPort::OnConnectionReady(unsigned) noexcept
+TCPPort::OnListenerReady(unsigned) noexcept
 try {
-  char input[4096];
-  ssize_t nbytes = connection.GetSocket().Read(input, sizeof(input));
-  if (nbytes < 0)
-    throw MakeSocketError("Failed to receive");
+  UniqueSocketDescriptor s(listener.GetSocket().AcceptNonBlock());
+  if (!s.IsDefined()) {
+    if (IsSocketErrorAcceptWouldBlock(GetSocketError()))
+      return;
 
-  if (nbytes == 0) {
-    connection.Close();
-    StateChanged();
-    return;
+    throw MakeSocketError("Failed to accept");
+  }
+
+  {
+    const std::lock_guard lock{mutex};
+    if (clients.size() >= MAX_CLIENTS)
+      /* too many clients; close the new connection */
+      return;
+
+    clients.emplace_back(*this, s.Release());
   }
 
-  DataReceived(input, nbytes);
+  StateChanged();
 } catch (...) {
-  connection.Close();
+  listener.Close();
   StateChanged();
   Error(std::current_exception());
 }
@@ -25,14 +25,106 @@ Copyright_License {
 #define XCSOAR_DEVICE_TCP_PORT_HPP
 
 #include "BufferedPort.hpp"
+#include "SendQueue.hpp"
 #include "event/SocketEvent.hxx"
+#include "event/InjectEvent.hxx"
+#include "thread/Mutex.hxx"
+
+#include <cstddef>
+#include <list>
 
 /**
- * A TCP listener port class.
+ * A TCP listener port class.  It serves up to #MAX_CLIENTS
+ * connections at a time: everything written to the port is sent to
+ * all of them, and data received from any of them is passed to the
+ * #DataHandler.
+ *
+ * Writes never block.  Data which a client cannot take right now is
+ * queued in a small per-client buffer, and a client whose buffer
+ * overflows is disconnected, so one stalled client never throttles
+ * the others.
  */
 class TCPPort final : public BufferedPort
 {
-  SocketEvent listener, connection;
+  static constexpr unsigned MAX_CLIENTS = 8;
+
+  /**
+   * The size of each client's send queue.
+   */
+  static constexpr std::size_t CLIENT_BUFFER_SIZE = 16384;
+
+  class Client {
+    TCPPort &port;
+
+    SocketEvent socket;
+
+    /**
+     * Data which could not be sent yet.  Protected by
+     * TCPPort::mutex.
+     */
+    SendQueue<CLIENT_BUFFER_SIZE> output;
+
+    /**
+     * Has this client fallen behind (or failed)?  It will be
+     * disconnected by TCPPort::OnInject().  Protected by
+     * TCPPort::mutex.
+     */
+    bool dropped = false;
+
+  public:
+    Client(TCPPort &_port, SocketDescriptor fd) noexcept;
+
+    ~Client() noexcept {
+      socket.Close();
+    }
+
+    Client(const Client &) = delete;
+    Client &operator=(const Client &) = delete;
+
+    /**
+     * Send data to the client or queue it.  The caller must lock
+     * TCPPort::mutex.
+     *
+     * @return true if the #EventLoop needs to take care of this
+     * client (see TCPPort::OnInject())
+     */
+    bool Write(const std::byte *data, std::size_t length) noexcept;
+
+    /**
+     * Called by TCPPort::OnInject() in the #EventLoop thread with
+     * TCPPort::mutex locked.
+     *
+     * @return false if the client shall be disconnected
+     */
+    bool Update() noexcept;
+
+  private:
+    /**
+     * Send as much of #output as possible.  The caller must lock
+     * TCPPort::mutex.
+     *
+     * @return false on error
+     */
+    bool Flush() noexcept;
+
+    void OnSocketReady(unsigned events) noexcept;
+  };
+
+  SocketEvent listener;
+
+  /**
+   * Wakes up the #EventLoop after Write() has queued data or
+   * dropped a client.
+   */
+  InjectEvent inject_event;
+
+  /**
+   * Protects #clients, because Write() may be called from any
+   * thread.
+   */
+  mutable Mutex mutex;
+
+  std::list<Client> clients;
 
 public:
   /**
@@ -58,7 +150,7 @@ public:
   PortState GetState() const override;
 
   bool Drain() override {
-    /* writes are synchronous */
+    /* writes never block; queued data is sent in the background */
     return true;
   }
 
@@ -79,11 +171,13 @@ protected:
 
   void OnListenerReady(unsigned events) noexcept;
 
-  void AsyncRead() {
-    connection.ScheduleRead();
-  }
+private:
+  /**
+   * Disconnect the client.  Must be called in the #EventLoop thread.
+   */
+  void RemoveClient(Client &client) noexcept;
 
-  void OnConnectionReady(unsigned events) noexcept;
+  void OnInject() noexcept;
 };
 
 #endif
@@ -27,6 +27,11 @@ Copyright_License {
 #include "net/SocketError.hxx"
 #include "event/Call.hxx"
 
+#ifdef __linux__
+#include <sys/socket.h>
+#include <errno.h>
+#endif
+
 UDPPort::UDPPort(EventLoop &event_loop,
                  unsigned port,
                  PortListener *_listener, DataHandler &_handler)
@@ -82,6 +87,34 @@ UDPPort::Write(const void *data, size_t length)
 void
 UDPPort::OnSocketReady(unsigned) noexcept
 try {
+#ifdef __linux__
+  /* receive all queued datagrams (up to MAX_DATAGRAMS) with one
+     system call */
+  static constexpr unsigned MAX_DATAGRAMS = 4;
+  char input[MAX_DATAGRAMS][4096];
+  struct iovec iov[MAX_DATAGRAMS];
+  struct mmsghdr msgs[MAX_DATAGRAMS]{};
+
+  for (unsigned i = 0; i < MAX_DATAGRAMS; ++i) {
+    iov[i].iov_base = input[i];
+    iov[i].iov_len = sizeof(input[i]);
+    msgs[i].msg_hdr.msg_iov = &iov[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+  }
+
+  int n = recvmmsg(socket.GetSocket().Get(), msgs, MAX_DATAGRAMS,
+                   MSG_DONTWAIT, nullptr);
+  if (n < 0) {
+    if (errno == EAGAIN || errno == EINTR)
+      return;
+
+    throw MakeSocketError("Failed to receive");
+  }
+
+  for (int i = 0; i < n; ++i)
+    if (msgs[i].msg_len > 0)
+      DataReceived(input[i], msgs[i].msg_len);
+#else
   char input[4096];
   ssize_t nbytes = socket.GetSocket().Read(input, sizeof(input));
   if (nbytes < 0)
@@ -94,6 +127,7 @@ try {
   }
 
   DataReceived(input, nbytes);
+#endif
 } catch (...) {
   socket.Close();
   StateChanged();
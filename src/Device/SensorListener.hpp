@@ -24,6 +24,9 @@ Copyright_License {
 #pragma once
 
 #include <chrono>
+#include <span>
+
+#include <cstdint>
 
 struct GeoPoint;
 class AtmosphericPressure;
@@ -59,6 +62,17 @@ public:
   virtual void OnMagneticFieldSensor(float h_x, float h_y, float h_z) noexcept = 0;
   virtual void OnBarometricPressureSensor(float pressure,
                                           float sensor_noise_variance) noexcept = 0;
+
+  /**
+   * A batch of pressure samples which the sensor has buffered (see
+   * SensorManager.registerListener() with maxReportLatencyUs).
+   *
+   * @param timestamps the time of each sample in nanoseconds, in an
+   * arbitrary monotonic time base
+   */
+  virtual void OnBarometricPressureSensor(std::span<const int64_t> timestamps,
+                                          std::span<const float> pressures,
+                                          float sensor_noise_variance) noexcept = 0;
   virtual void OnPressureAltitudeSensor(float altitude) noexcept = 0;
   virtual void OnI2CbaroSensor(int index, int sensorType,
                                AtmosphericPressure pressure) noexcept = 0;
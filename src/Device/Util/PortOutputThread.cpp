@@ -0,0 +1,93 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "PortOutputThread.hpp"
+#include "Device/Port/Port.hpp"
+
+PortOutputThread::PortOutputThread(Port &_port) noexcept
+  :StandbyThread("PortOutput"), port(_port)
+{
+}
+
+PortOutputThread::~PortOutputThread() noexcept
+{
+  LockStop();
+}
+
+bool
+PortOutputThread::Write(const void *data, std::size_t size) noexcept
+{
+  const auto *p = (const std::byte *)data;
+
+  const std::lock_guard<Mutex> lock(mutex);
+
+  if (queue.size() + size > MAX_QUEUE) {
+    /* the port is stalled; drop complete writes (never parts of
+       them), so the receiver doesn't see mangled lines */
+    ++dropped;
+    return false;
+  }
+
+  queue.insert(queue.end(), p, p + size);
+
+  /* if the thread is busy, it will pick up the new data before it
+     goes back to sleep */
+  if (!IsBusy()) {
+    try {
+      Trigger();
+    } catch (...) {
+      /* failed to launch the thread */
+      queue.clear();
+      ++dropped;
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void
+PortOutputThread::Tick() noexcept
+{
+  while (!queue.empty() && !IsStopped()) {
+    writing.swap(queue);
+
+    {
+      const ScopeUnlock unlock(mutex);
+
+      const std::byte *p = writing.data();
+      std::size_t remaining = writing.size();
+      while (remaining > 0) {
+        const std::size_t nbytes = port.Write(p, remaining);
+        if (nbytes == 0)
+          /* the port has given up; discard this batch */
+          break;
+
+        p += nbytes;
+        remaining -= nbytes;
+      }
+
+      writing.clear();
+    }
+  }
+}
@@ -0,0 +1,94 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_DEVICE_PORT_OUTPUT_THREAD_HPP
+#define XCSOAR_DEVICE_PORT_OUTPUT_THREAD_HPP
+
+#include "thread/StandbyThread.hpp"
+
+#include <cstddef>
+#include <vector>
+
+class Port;
+
+/**
+ * Writes to a #Port in a separate thread, so the caller (usually the
+ * input thread of another device) never blocks on a stalled output,
+ * e.g. a Bluetooth connection which is out of range.
+ *
+ * Everything which has accumulated while the previous write was in
+ * progress is written with one Port::Write() call.  The queue is
+ * bounded: if the port cannot keep up, new data is dropped until
+ * the queue has drained.
+ */
+class PortOutputThread final : private StandbyThread {
+  Port &port;
+
+  /**
+   * Data which has not yet been picked up by the thread.  Protected
+   * by StandbyThread::mutex.
+   */
+  std::vector<std::byte> queue;
+
+  /**
+   * The batch currently being written.  Only used by the thread.
+   */
+  std::vector<std::byte> writing;
+
+  /**
+   * The number of Write() calls whose data was dropped.  Protected by
+   * StandbyThread::mutex.
+   */
+  unsigned dropped = 0;
+
+public:
+  /**
+   * The maximum number of bytes in the queue.
+   */
+  static constexpr std::size_t MAX_QUEUE = 4096;
+
+  explicit PortOutputThread(Port &_port) noexcept;
+
+  /**
+   * Stops the thread.  Queued data is discarded.
+   */
+  ~PortOutputThread() noexcept;
+
+  /**
+   * Queue data for writing.  Never blocks.
+   *
+   * @return false if the queue is full and the data was dropped
+   */
+  bool Write(const void *data, std::size_t size) noexcept;
+
+  unsigned GetDropped() noexcept {
+    const std::lock_guard<Mutex> lock(mutex);
+    return dropped;
+  }
+
+private:
+  /* virtual methods from class StandbyThread */
+  void Tick() noexcept override;
+};
+
+#endif
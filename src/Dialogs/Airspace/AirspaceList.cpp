@@ -64,8 +64,26 @@ class AirspaceListWidget final
     NullBlackboardListener {
   AirspaceFilterWidget &filter_widget;
 
+  /**
+   * The number of #items sorted at a time.  The rest is only sorted
+   * when it scrolls into view, see OnPrepareItems().
+   */
+  static constexpr std::size_t SORT_CHUNK = 32;
+
   AirspaceSelectInfoVector items;
 
+  /**
+   * The filter and location #items was obtained with; needed to sort
+   * more of them.
+   */
+  AirspaceFilterData filter;
+  GeoPoint filter_location;
+
+  /**
+   * The number of #items which are already sorted.
+   */
+  std::size_t n_sorted = 0;
+
   TwoTextRowsRenderer row_renderer;
 
 public:
@@ -97,6 +115,7 @@ public:
   }
 
   /* virtual methods from ListItemRenderer */
+  void OnPrepareItems(unsigned start, unsigned end) noexcept override;
   void OnPaintItem(Canvas &canvas, const PixelRect rc,
                    unsigned idx) noexcept override;
 
@@ -239,9 +258,14 @@ AirspaceListWidget::UpdateList()
   if (dialog_state.distance > 0)
     data.distance = dialog_state.distance;
 
-  items = FilterAirspaces(*airspaces,
-                          CommonInterface::Basic().location,
-                          data);
+  filter_location = CommonInterface::Basic().location;
+  items = FilterAirspaces(*airspaces, filter_location, data, SORT_CHUNK);
+  n_sorted = std::min(items.size(), SORT_CHUNK);
+
+  /* the name prefix points into the filter widget; it is only
+     needed for filtering, not for sorting */
+  filter = data;
+  filter.name_prefix = nullptr;
 
   GetList().SetLength(std::max((size_t)1, items.size()));
   GetList().Invalidate();
@@ -294,6 +318,18 @@ AirspaceListWidget::OnModified(DataField &df) noexcept
   UpdateList();
 }
 
+void
+AirspaceListWidget::OnPrepareItems(unsigned start, unsigned end) noexcept
+{
+  if (end <= n_sorted || n_sorted >= items.size())
+    return;
+
+  const std::size_t n = std::min(items.size(), end + SORT_CHUNK);
+  SortAirspaces(items, n_sorted, n, filter_location,
+                airspaces->GetProjection(), filter);
+  n_sorted = n;
+}
+
 void
 AirspaceListWidget::OnPaintItem(Canvas &canvas, const PixelRect rc,
                                 unsigned i) noexcept
@@ -114,6 +114,19 @@ UpdateAvailable(const FileRepository &repository, const TCHAR *name)
 
   return local_changed < remote_changed;
 }
+
+/**
+ * Enqueue a download of the given file, passing the digest and the
+ * chunk manifest from the repository, so the download can be
+ * verified and an existing file can be updated incrementally.
+ */
+static void
+EnqueueDownload(const AvailableFile &file, Path base) noexcept
+{
+  Net::DownloadManager::Enqueue(file.GetURI(), base,
+                                file.HasHash() ? &file.sha256_hash : nullptr,
+                                file.GetChunksURI());
+}
 #endif
 
 class ManagedFileListWidget
@@ -507,7 +520,7 @@ ManagedFileListWidget::Download()
   if (!base.IsValid())
     return;
 
-  Net::DownloadManager::Enqueue(remote_file.uri.c_str(), Path(base));
+  EnqueueDownload(remote_file, Path(base));
 #endif
 }
 
@@ -582,7 +595,7 @@ ManagedFileListWidget::Add()
   if (!base.IsValid())
     return;
 
-  Net::DownloadManager::Enqueue(remote_file.GetURI(), Path(base));
+  EnqueueDownload(remote_file, Path(base));
 #endif
 }
 
@@ -600,7 +613,7 @@ ManagedFileListWidget::UpdateFiles() {
         if (!base.IsValid())
           return;
 
-        Net::DownloadManager::Enqueue(remote_file->GetURI(), Path(base));
+        EnqueueDownload(*remote_file, Path(base));
       }
     }
   }
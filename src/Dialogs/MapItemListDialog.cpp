@@ -34,6 +34,7 @@ Copyright_License {
 #include "MapWindow/Items/MapItem.hpp"
 #include "MapWindow/Items/List.hpp"
 #include "Renderer/MapItemListRenderer.hpp"
+#include "Renderer/AirspaceListRenderer.hpp"
 #include "Widget/ListWidget.hpp"
 #include "Form/Button.hpp"
 #include "Weather/Features.hpp"
@@ -84,6 +85,13 @@ class MapItemListWidget final
 
   MapItemListRenderer renderer;
 
+  /**
+   * The airspace preview polygons, indexed like #list.  They are
+   * built lazily by OnPrepareItems() when the item scrolls into
+   * view.
+   */
+  std::vector<AirspacePreviewRenderer::Polygon> previews;
+
   Button *settings_button, *details_button, *cancel_button, *goto_button;
   Button *ack_button;
 
@@ -122,6 +130,7 @@ public:
   void Prepare(ContainerWindow &parent, const PixelRect &rc) noexcept override;
 
   /* virtual methods from class List::Handler */
+  void OnPrepareItems(unsigned start, unsigned end) noexcept override;
   void OnPaintItem(Canvas &canvas, const PixelRect rc,
                    unsigned idx) noexcept override;
 
@@ -184,6 +193,7 @@ MapItemListWidget::Prepare(ContainerWindow &parent,
              renderer.CalculateLayout(dialog_look));
 
   GetList().SetLength(list.size());
+  previews.resize(list.size());
   UpdateButtons();
 
   for (unsigned i = 0; i < list.size(); ++i) {
@@ -195,13 +205,29 @@ MapItemListWidget::Prepare(ContainerWindow &parent,
   }
 }
 
+void
+MapItemListWidget::OnPrepareItems(unsigned start, unsigned end) noexcept
+{
+  const unsigned radius =
+    AirspaceListRenderer::GetPreviewRadius(GetList().GetItemHeight());
+
+  for (unsigned i = start; i < end; ++i) {
+    const MapItem &item = *list[i];
+    if (item.type == MapItem::AIRSPACE && previews[i].empty()) {
+      const auto &airspace = *((const AirspaceMapItem &)item).airspace;
+      AirspacePreviewRenderer::BuildPolygon(previews[i], airspace, radius);
+    }
+  }
+}
+
 void
 MapItemListWidget::OnPaintItem(Canvas &canvas, const PixelRect rc,
                                unsigned idx) noexcept
 {
   const MapItem &item = *list[idx];
   renderer.Draw(canvas, rc, item,
-                &CommonInterface::Basic().flarm.traffic);
+                &CommonInterface::Basic().flarm.traffic,
+                &previews[idx]);
 
   if ((settings.item_list.add_arrival_altitude &&
        item.type == MapItem::Type::ARRIVAL_ALTITUDE) ||
@@ -31,6 +31,7 @@ Copyright_License {
 #include "Replay/Replay.hpp"
 #include "Form/DataField/File.hpp"
 #include "Form/DataField/Float.hpp"
+#include "Form/DataField/Integer.hpp"
 #include "Language/Language.hpp"
 
 class ReplayControlWidget final
@@ -38,6 +39,7 @@ class ReplayControlWidget final
   enum Controls {
     FILE,
     RATE,
+    OUTPUT_RATE,
   };
 
 public:
@@ -71,9 +73,9 @@ ReplayControlWidget::Prepare(ContainerWindow &parent,
 {
   auto *file =
     AddFile(_("File"),
-            _("Name of file to replay.  Can be an IGC file (.igc), a raw NMEA log file (.nmea), or if blank, runs the demo."),
+            _("Name of file to replay.  Can be an IGC file (.igc), a raw NMEA log file (.nmea or .nmea.gz), or if blank, runs the demo."),
             nullptr,
-            _T("*.nmea\0*.igc\0"),
+            _T("*.nmea\0*.nmea.gz\0*.igc\0"),
             true);
   ((FileDataField *)file->GetDataField())->SetValue(Path(replay->GetFilename()));
   file->RefreshDisplay();
@@ -82,6 +84,12 @@ ReplayControlWidget::Prepare(ContainerWindow &parent,
            _("Time acceleration of replay. Set to 0 for pause, 1 for normal real-time replay."),
            _T("%.0f x"), _T("%.0f"),
            0, 10, 1, false, replay->GetTimeScale(), this);
+
+  AddInteger(_("Output rate"),
+             _("Number of interpolated fixes per second during IGC replay."),
+             _T("%d Hz"), _T("%d"),
+             1, Replay::MAX_OUTPUT_RATE, 1, replay->GetOutputRate(), this);
+  SetExpertRow(OUTPUT_RATE);
 }
 
 inline void
@@ -112,9 +120,13 @@ ReplayControlWidget::OnFastForwardClicked()
 void
 ReplayControlWidget::OnModified(DataField &_df) noexcept
 {
-  const DataFieldFloat &df = (const DataFieldFloat &)_df;
-
-  replay->SetTimeScale(df.GetValue());
+  if (IsDataField(RATE, _df)) {
+    const DataFieldFloat &df = (const DataFieldFloat &)_df;
+    replay->SetTimeScale(df.GetValue());
+  } else if (IsDataField(OUTPUT_RATE, _df)) {
+    const DataFieldInteger &df = (const DataFieldInteger &)_df;
+    replay->SetOutputRate(df.GetValue());
+  }
 }
 
 void
@@ -27,6 +27,7 @@ Copyright_License {
 #include "Interface.hpp"
 #include "Widget/RowFormWidget.hpp"
 #include "Form/DataField/Float.hpp"
+#include "Form/DataField/Enum.hpp"
 #include "UIGlobals.hpp"
 #include "Audio/Features.hpp"
 #include "Audio/VarioGlue.hpp"
@@ -44,6 +45,8 @@ enum ControlIndex {
   SPACER2,
   DEAD_BAND_MIN,
   DEAD_BAND_MAX,
+  DIRECT_FEED,
+  BUFFER_TIME,
 };
 
 
@@ -122,6 +125,31 @@ AudioVarioConfigPanel::Prepare(ContainerWindow &parent,
   SetExpertRow(DEAD_BAND_MAX);
   DataFieldFloat &db_max = (DataFieldFloat &)GetDataField(DEAD_BAND_MAX);
   db_max.SetFormat(GetUserVerticalSpeedFormat(false, true));
+
+  AddBoolean(_("Direct device feed"),
+             _("Pass the total energy vario of the device straight to the "
+               "audio vario, instead of waiting for the next merge of all "
+               "device data.  The tone reacts faster to fast devices."),
+             settings.direct_feed);
+  SetExpertRow(DIRECT_FEED);
+
+  static constexpr StaticEnumChoice buffer_time_list[] = {
+    { 0, N_("Default") },
+    { 10, _T("10 ms") },
+    { 20, _T("20 ms") },
+    { 30, _T("30 ms") },
+    { 50, _T("50 ms") },
+    { 100, _T("100 ms") },
+    { 200, _T("200 ms") },
+    { 0 }
+  };
+
+  AddEnum(_("Audio buffer"),
+          _("The duration of the audio output buffer.  Shorter buffers "
+            "reduce the delay of the tone, but may cause dropouts on slow "
+            "devices.  This applies to all sounds."),
+          buffer_time_list, settings.buffer_time_ms);
+  SetExpertRow(BUFFER_TIME);
 }
 
 bool
@@ -159,6 +187,12 @@ AudioVarioConfigPanel::Save(bool &changed) noexcept
   changed |= SaveValue(DEAD_BAND_MAX, UnitGroup::VERTICAL_SPEED,
                        ProfileKeys::VarioDeadBandMax, settings.max_dead);
 
+  changed |= SaveValue(DIRECT_FEED, ProfileKeys::VarioDirectFeed,
+                       settings.direct_feed);
+
+  changed |= SaveValue(BUFFER_TIME, ProfileKeys::VarioBufferTime,
+                       settings.buffer_time_ms);
+
   return true;
 }
 
@@ -40,6 +40,7 @@ enum ControlIndex {
   LoggerTimeStepCircling,
   DisableAutoLogger,
   EnableNMEALogger,
+  CompressNMEALogger,
   EnableFlightLogger,
   LoggerID,
 };
@@ -95,6 +96,12 @@ LoggerConfigPanel::Prepare(ContainerWindow &parent,
              logger.enable_nmea_logger);
   SetExpertRow(EnableNMEALogger);
 
+  AddBoolean(_("Compress NMEA log"),
+             _("Write the NMEA log gzip-compressed (.nmea.gz).  This needs "
+               "much less storage, and the file can still be replayed."),
+             logger.compress_nmea_logger);
+  SetExpertRow(CompressNMEALogger);
+
   AddBoolean(_("Log book"), _("Logs each start and landing."),
              logger.enable_flight_logger);
   SetExpertRow(EnableFlightLogger);
@@ -131,6 +138,11 @@ LoggerConfigPanel::Save(bool &changed) noexcept
   if (logger.enable_nmea_logger)
     NMEALogger::enabled = true;
 
+  /* applies to the next NMEA log file */
+  changed |= SaveValue(CompressNMEALogger, ProfileKeys::CompressNMEALogger,
+                       logger.compress_nmea_logger);
+  NMEALogger::compress = logger.compress_nmea_logger;
+
   if (SaveValue(EnableFlightLogger, ProfileKeys::EnableFlightLogger,
                 logger.enable_flight_logger)) {
     changed = true;
@@ -234,5 +234,7 @@ void
 WindSettingsPanel::OnCalculatedUpdate(const MoreData &basic,
                                       const DerivedInfo &calculated)
 {
-  UpdateVector();
+  if (CommonInterface::GetCalculatedSerials()
+      .CheckModified(DerivedSerials::Section::WIND, wind_serial))
+    UpdateVector();
 }
@@ -28,6 +28,8 @@ Copyright_License {
 #include "Form/DataField/Listener.hpp"
 #include "Blackboard/BlackboardListener.hpp"
 
+#include <cstdint>
+
 class Button;
 
 class WindSettingsPanel final
@@ -52,6 +54,12 @@ class WindSettingsPanel final
 
   Button *clear_manual_window;
 
+  /**
+   * The DerivedSerials::Section::WIND serial shown by
+   * UpdateVector().
+   */
+  uint32_t wind_serial = 0;
+
 public:
   enum Buttons {
     /**
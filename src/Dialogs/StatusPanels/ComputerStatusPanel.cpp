@@ -0,0 +1,117 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "ComputerStatusPanel.hpp"
+#include "Computer/GlideComputer.hpp"
+#include "MergeThread.hpp"
+#include "system/MemoryAccounting.hpp"
+#include "Language/Language.hpp"
+#include "util/StaticString.hxx"
+
+/**
+ * Row labels, indexed by ComputerScheduler::Job.
+ */
+static const TCHAR *const job_labels[] = {
+  N_("Air data"),
+  N_("Vertical"),
+  N_("Task"),
+  N_("Route"),
+  N_("Logger"),
+  N_("Task idle"),
+  N_("Contest"),
+  N_("Airspace warnings"),
+};
+
+static_assert(std::size(job_labels) == ComputerScheduler::N_JOBS);
+
+static constexpr double
+ToMilliseconds(std::chrono::microseconds us) noexcept
+{
+  return us.count() / 1000.;
+}
+
+void
+ComputerStatusPanel::Refresh() noexcept
+{
+  const auto timings = glide_computer.GetTimings();
+
+  StaticString<64> buffer;
+  for (unsigned i = 0; i < timings.size(); ++i) {
+    const auto &t = timings[i];
+    if (t.runs == 0) {
+      ClearText(i);
+      continue;
+    }
+
+    buffer.Format(_T("%.1f / %.1f ms, %u deferred"),
+                  ToMilliseconds(t.average),
+                  ToMilliseconds(t.max),
+                  (unsigned)t.deferred);
+    if (MemoryAccounting::enabled)
+      buffer.AppendFormat(_T(", %u allocations"), (unsigned)t.allocations);
+    SetText(i, buffer);
+  }
+
+  if (merge_thread == nullptr)
+    return;
+
+  const auto statistics = merge_thread->GetStatistics();
+
+  unsigned row = timings.size();
+  buffer.Format(_T("%u/s"), statistics.merges_per_second);
+  SetText(row++, buffer);
+
+  for (const auto &l : statistics.latency) {
+    if (l.samples == 0)
+      ClearText(row);
+    else {
+      buffer.Format(_T("%.1f / %.1f ms"),
+                    ToMilliseconds(l.average), ToMilliseconds(l.max));
+      SetText(row, buffer);
+    }
+
+    ++row;
+  }
+}
+
+void
+ComputerStatusPanel::Prepare(ContainerWindow &parent,
+                             const PixelRect &rc) noexcept
+{
+  for (const TCHAR *label : job_labels)
+    AddReadOnly(gettext(label),
+                _("Average and maximum time of this calculation, and how often it was deferred because the calculation cycle took too long or to save power."));
+
+  if (merge_thread == nullptr)
+    return;
+
+  AddReadOnly(_("Merges"),
+              _("How often the data of all devices was merged during the last second."));
+
+  for (unsigned i = 0; i < NUMDEV; ++i) {
+    StaticString<32> label;
+    label.Format(_T("%s %c"), _("Device"), _T('A' + i));
+    AddReadOnly(label,
+                _("Average and maximum time between an update from this device and the merge which picked it up."));
+  }
+}
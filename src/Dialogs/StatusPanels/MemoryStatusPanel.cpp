@@ -0,0 +1,77 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "MemoryStatusPanel.hpp"
+#include "system/MemoryAccounting.hpp"
+#include "Language/Language.hpp"
+#include "util/StaticString.hxx"
+
+/**
+ * Row labels, indexed by MemoryAccounting::Account.
+ */
+static const TCHAR *const account_labels[] = {
+  N_("Terrain"),
+  N_("Topography"),
+  N_("Trace"),
+  N_("Airspaces"),
+  N_("Waypoints"),
+  N_("Text cache"),
+};
+
+static_assert(std::size(account_labels) == MemoryAccounting::N_ACCOUNTS);
+
+void
+MemoryStatusPanel::Refresh() noexcept
+{
+  StaticString<64> buffer;
+  for (unsigned i = 0; i < MemoryAccounting::N_ACCOUNTS; ++i) {
+    const auto usage = MemoryAccounting::Get(MemoryAccounting::Account(i));
+    buffer.Format(_T("%.1f MB, %u objects"),
+                  usage.bytes / (1024. * 1024.),
+                  (unsigned)usage.objects);
+    SetText(i, buffer);
+  }
+}
+
+void
+MemoryStatusPanel::Prepare(ContainerWindow &parent,
+                           const PixelRect &rc) noexcept
+{
+  for (const TCHAR *label : account_labels)
+    AddReadOnly(gettext(label),
+                _("Memory reported by this subsystem, and the number of objects it is made of."));
+}
+
+void
+MemoryStatusPanel::Show(const PixelRect &rc) noexcept
+{
+  StatusPanel::Show(rc);
+  timer.Schedule(std::chrono::seconds(1));
+}
+
+void
+MemoryStatusPanel::Hide() noexcept
+{
+  timer.Cancel();
+  StatusPanel::Hide();
+}
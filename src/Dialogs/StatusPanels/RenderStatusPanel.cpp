@@ -0,0 +1,108 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "RenderStatusPanel.hpp"
+#include "Screen/FrameProfiler.hpp"
+#include "PowerPolicy.hpp"
+#include "Language/Language.hpp"
+#include "util/StaticString.hxx"
+
+/**
+ * Row labels, indexed by FrameProfiler::Stage.
+ */
+static const TCHAR *const stage_labels[] = {
+  N_("Terrain"),
+  N_("Topography"),
+  N_("Airspace"),
+  N_("Task"),
+  N_("Trail"),
+  N_("Traffic"),
+  N_("Waypoints"),
+  N_("Overlays"),
+  N_("Flip"),
+  N_("Total"),
+};
+
+static_assert(std::size(stage_labels) == FrameProfiler::N_STAGES);
+
+static constexpr double
+ToMilliseconds(std::chrono::microseconds us) noexcept
+{
+  return us.count() / 1000.;
+}
+
+void
+RenderStatusPanel::Refresh() noexcept
+{
+  const auto histograms = profiler.GetHistograms();
+
+  StaticString<64> buffer;
+  for (unsigned i = 0; i < histograms.size(); ++i) {
+    const auto &h = histograms[i];
+    if (h.count == 0) {
+      ClearText(i);
+      continue;
+    }
+
+    buffer.Format(_T("%.1f / %.1f / %.1f ms"),
+                  ToMilliseconds(h.GetAverage()),
+                  ToMilliseconds(h.GetPercentile(0.9)),
+                  ToMilliseconds(h.max));
+    SetText(i, buffer);
+  }
+
+  unsigned row = histograms.size();
+
+  switch (power_policy.GetMode()) {
+  case PowerPolicy::Mode::NORMAL:
+    SetText(row, _("Off"));
+    break;
+
+  case PowerPolicy::Mode::BATTERY_LOW:
+    SetText(row, _("Battery low"));
+    break;
+
+  case PowerPolicy::Mode::SCREEN_OFF:
+    SetText(row, _("Screen off"));
+    break;
+  }
+
+  ++row;
+
+  buffer.Format(_T("%u"), power_policy.GetDeferredRedraws());
+  SetText(row, buffer);
+}
+
+void
+RenderStatusPanel::Prepare(ContainerWindow &parent,
+                           const PixelRect &rc) noexcept
+{
+  for (const TCHAR *label : stage_labels)
+    AddReadOnly(gettext(label),
+                _("Average, 90th percentile and maximum time of this render stage."));
+
+  AddReadOnly(_("Power saving"),
+              _("Why the map is redrawn less often, and the terrain with less detail."));
+  AddReadOnly(_("Deferred frames"),
+              _("How many map redraws for new calculation results were skipped to save power."));
+}
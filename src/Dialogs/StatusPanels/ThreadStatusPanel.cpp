@@ -0,0 +1,150 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "ThreadStatusPanel.hpp"
+#include "Blackboard/DeviceBlackboard.hpp"
+#include "Components.hpp"
+#include "Language/Language.hpp"
+#include "util/ConvertString.hpp"
+#include "util/StaticString.hxx"
+
+using std::chrono::microseconds;
+
+static constexpr double
+ToMilliseconds(std::chrono::microseconds us) noexcept
+{
+  return us.count() / 1000.;
+}
+
+static constexpr double
+ToMicroseconds(std::chrono::nanoseconds ns) noexcept
+{
+  return ns.count() / 1000.;
+}
+
+void
+ThreadStatusPanel::Refresh() noexcept
+{
+  std::array<ThreadStatistics::Snapshot, ThreadStatistics::MAX_THREADS> current;
+  const unsigned n = std::min(ThreadStatistics::GetAll(current), n_rows);
+
+  const auto now = std::chrono::steady_clock::now();
+  const bool have_previous = n_previous > 0;
+  const auto interval =
+    std::chrono::duration_cast<microseconds>(now - previous_time);
+
+  StaticString<64> buffer;
+  for (unsigned i = 0; i < n; ++i) {
+    const auto &s = current[i];
+    if (s.cycles == 0) {
+      ClearText(i);
+      continue;
+    }
+
+    /* the share of the last interval this thread was busy; on
+       platforms which can measure CPU time, that is shown instead */
+    double load = 0;
+    if (have_previous && i < n_previous && interval.count() > 0) {
+      const auto &p = previous[i];
+      const auto used = s.cpu.count() > 0
+        ? s.cpu - p.cpu
+        : s.busy - p.busy;
+      load = 100. * used.count() / interval.count();
+    }
+
+    buffer.Format(_T("%.0f%% - %.1f / %.1f / %.1f ms"),
+                  load,
+                  ToMilliseconds(s.GetAverage()),
+                  ToMilliseconds(s.GetPercentile(0.9)),
+                  ToMilliseconds(s.max));
+    SetText(i, buffer);
+  }
+
+  if (device_blackboard != nullptr) {
+    /* same order as the labels in Prepare() */
+    const auto &l = device_blackboard->lock_statistics;
+    const LockStatistics *const locks[] = {
+      &l.device, &l.merge, &l.calculation, &l.ui,
+    };
+
+    unsigned row = n_rows;
+    for (const auto *lock : locks) {
+      const auto s = lock->GetSnapshot();
+      if (s.count > 0) {
+        buffer.Format(_T("%.2f / %.1f us"),
+                      ToMicroseconds(s.GetAverage()),
+                      ToMicroseconds(s.max));
+        SetText(row, buffer);
+      } else
+        ClearText(row);
+
+      ++row;
+    }
+  }
+
+  previous = current;
+  n_previous = n;
+  previous_time = now;
+}
+
+void
+ThreadStatusPanel::Prepare(ContainerWindow &parent,
+                           const PixelRect &rc) noexcept
+{
+  std::array<ThreadStatistics::Snapshot, ThreadStatistics::MAX_THREADS> all;
+  n_rows = ThreadStatistics::GetAll(all);
+
+  for (unsigned i = 0; i < n_rows; ++i) {
+    const UTF8ToWideConverter name(all[i].name);
+    AddReadOnly(name.IsValid() ? name.c_str() : _T("?"),
+                _("CPU load during the last second; average, 90th percentile and maximum duration of one work cycle of this thread."));
+  }
+
+  static constexpr const TCHAR *lock_labels[] = {
+    _T("Lock: devices"),
+    _T("Lock: merge"),
+    _T("Lock: calculation"),
+    _T("Lock: UI"),
+  };
+
+  for (const auto *label : lock_labels)
+    AddReadOnly(label,
+                _("Average and maximum time the device blackboard mutex was held by these threads."));
+}
+
+void
+ThreadStatusPanel::Show(const PixelRect &rc) noexcept
+{
+  /* start a new interval */
+  n_previous = 0;
+
+  StatusPanel::Show(rc);
+  timer.Schedule(std::chrono::seconds(1));
+}
+
+void
+ThreadStatusPanel::Hide() noexcept
+{
+  timer.Cancel();
+  StatusPanel::Hide();
+}
@@ -0,0 +1,70 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_THREAD_STATUS_PANEL_HPP
+#define XCSOAR_THREAD_STATUS_PANEL_HPP
+
+#include "StatusPanel.hpp"
+#include "thread/Statistics.hpp"
+#include "ui/event/PeriodicTimer.hpp"
+
+/**
+ * Shows the #ThreadStatistics of all registered threads, updated
+ * once per second.
+ */
+class ThreadStatusPanel : public StatusPanel {
+  UI::PeriodicTimer timer{[this]{ Refresh(); }};
+
+  /**
+   * The number of rows; threads registered after Prepare() are not
+   * shown.
+   */
+  unsigned n_rows;
+
+  /**
+   * The snapshots of the previous Refresh() call, to calculate the
+   * load during the last interval.
+   */
+  std::array<ThreadStatistics::Snapshot, ThreadStatistics::MAX_THREADS> previous;
+
+  /**
+   * The number of valid elements in #previous; 0 if there was no
+   * Refresh() call since Show().
+   */
+  unsigned n_previous = 0;
+
+  std::chrono::steady_clock::time_point previous_time;
+
+public:
+  using StatusPanel::StatusPanel;
+
+  /* virtual methods from class StatusPanel */
+  void Refresh() noexcept override;
+
+  /* virtual methods from class Widget */
+  void Prepare(ContainerWindow &parent, const PixelRect &rc) noexcept override;
+  void Show(const PixelRect &rc) noexcept override;
+  void Hide() noexcept override;
+};
+
+#endif
@@ -35,7 +35,14 @@ Copyright_License {
 #include "Widget/TwoWidgets.hpp"
 #include "Task/TaskStore.hpp"
 #include "Task/ValidationErrorStrings.hpp"
+#include "Engine/Task/TaskBehaviour.hpp"
+#include "Job/Async.hpp"
+#include "Job/Job.hpp"
+#include "Operation/Operation.hpp"
+#include "Formatter/UserUnits.hpp"
+#include "ui/event/Notify.hpp"
 #include "LocalPath.hpp"
+#include "LogFile.hpp"
 #include "system/FileUtil.hpp"
 #include "Language/Language.hpp"
 #include "Interface.hpp"
@@ -57,6 +64,23 @@ static unsigned task_list_serial;
 class TaskListPanel final
   : public ListWidget {
 
+  /**
+   * Parses all tasks of a #TaskStore in a background thread, so the
+   * list can show their distances and the preview needs no parsing.
+   */
+  class LoadJob final : public Job {
+    TaskStore &store;
+    const TaskBehaviour task_behaviour;
+
+  public:
+    LoadJob(TaskStore &_store, const TaskBehaviour &_task_behaviour) noexcept
+      :store(_store), task_behaviour(_task_behaviour) {}
+
+    void Run(OperationEnvironment &env) override {
+      store.LoadAll(task_behaviour, env);
+    }
+  };
+
   TaskManagerDialog &dialog;
 
   TextRowRenderer row_renderer;
@@ -77,6 +101,11 @@ class TaskListPanel final
   TwoWidgets *two_widgets;
   ButtonPanelWidget *buttons;
 
+  std::unique_ptr<LoadJob> load_job;
+  AsyncJobRunner load_runner;
+  NullOperationEnvironment load_env;
+  UI::Notify load_notify{[this]{ OnLoadNotification(); }};
+
 public:
   TaskListPanel(TaskManagerDialog &_dialog,
                 std::unique_ptr<OrderedTask> &_active_task, bool *_task_modified,
@@ -110,12 +139,23 @@ public:
   void OnMoreClicked();
 
   void Prepare(ContainerWindow &parent, const PixelRect &rc) noexcept override;
+  void Unprepare() noexcept override;
   void Show(const PixelRect &rc) noexcept override;
   void Hide() noexcept override;
 
 protected:
   const OrderedTask *get_cursor_task();
 
+  /**
+   * Scan the data directory again and start loading the tasks in
+   * the background.
+   */
+  void Rescan() noexcept;
+
+  void StartLoading() noexcept;
+  void StopLoading() noexcept;
+  void OnLoadNotification() noexcept;
+
   gcc_pure
   const TCHAR *get_cursor_name();
 
@@ -175,7 +215,65 @@ TaskListPanel::OnPaintItem(Canvas &canvas, const PixelRect rc,
 {
   assert(DrawListIndex <= task_store.Size());
 
-  row_renderer.DrawTextRow(canvas, rc, task_store.GetName(DrawListIndex));
+  PixelRect text_rc = rc;
+  if (const auto *task = task_store.GetLoadedTask(DrawListIndex);
+      task != nullptr && task->TaskSize() > 0) {
+    const auto &stats = task->GetStats();
+    text_rc.right = row_renderer.DrawRightColumn(canvas, rc,
+                                                 FormatUserDistanceSmart(stats.distance_nominal));
+  }
+
+  row_renderer.DrawTextRow(canvas, text_rc,
+                           task_store.GetName(DrawListIndex));
+}
+
+void
+TaskListPanel::Rescan() noexcept
+{
+  StopLoading();
+  task_store.Scan(more);
+  StartLoading();
+}
+
+void
+TaskListPanel::StartLoading() noexcept
+{
+  assert(!load_runner.IsBusy());
+
+  load_job = std::make_unique<LoadJob>(task_store,
+                                       CommonInterface::GetComputerSettings().task);
+  load_runner.Start(load_job.get(), load_env, &load_notify);
+}
+
+void
+TaskListPanel::StopLoading() noexcept
+{
+  if (!load_runner.IsBusy())
+    return;
+
+  load_runner.Cancel();
+
+  try {
+    load_runner.Wait();
+  } catch (...) {
+  }
+
+  load_job.reset();
+}
+
+void
+TaskListPanel::OnLoadNotification() noexcept
+{
+  try {
+    load_runner.Wait();
+  } catch (...) {
+    LogError(std::current_exception());
+  }
+
+  load_job.reset();
+
+  /* show the distances of the tasks which have just been loaded */
+  GetList().Invalidate();
 }
 
 void
@@ -256,7 +354,7 @@ TaskListPanel::DeleteTask()
 
   File::Delete(path);
 
-  task_store.Scan(more);
+  Rescan();
   RefreshView();
 }
 
@@ -304,7 +402,7 @@ TaskListPanel::RenameTask()
   File::Rename(task_store.GetPath(cursor_index),
                AllocatedPath::Build(tasks_path, newname));
 
-  task_store.Scan(more);
+  Rescan();
   RefreshView();
 }
 
@@ -315,7 +413,7 @@ TaskListPanel::OnMoreClicked()
 
   more_button->SetCaption(more ? _("Less") : _("More"));
 
-  task_store.Scan(more);
+  Rescan();
   RefreshView();
 }
 
@@ -334,13 +432,20 @@ TaskListPanel::Prepare(ContainerWindow &parent, const PixelRect &rc) noexcept
   serial = task_list_serial - 1;
 }
 
+void
+TaskListPanel::Unprepare() noexcept
+{
+  StopLoading();
+  ListWidget::Unprepare();
+}
+
 void
 TaskListPanel::Show(const PixelRect &rc) noexcept
 {
   if (serial != task_list_serial) {
     serial = task_list_serial;
     // Scan XCSoarData for available tasks
-    task_store.Scan(more);
+    Rescan();
   }
 
   dialog.ShowTaskView(get_cursor_task());
@@ -405,9 +405,15 @@ TrafficListWidget::UpdateList()
     /* show SkyLines traffic unless this is a FLARM traffic picker
        dialog (from dlgTeamCode) */
     if (buttons != nullptr) {
+      const auto &fused = CommonInterface::Basic().fused_traffic;
       const auto &data = tracking->GetSkyLinesData();
       const std::lock_guard<Mutex> lock(data.mutex);
       for (const auto &i : data.traffic) {
+        /* skip aircraft which are listed as FLARM traffic already */
+        if (const auto *f = fused.FindSkyLines(i.first);
+            f != nullptr && f->source == FusedTraffic::Source::FLARM)
+          continue;
+
         const auto name_i = data.user_names.find(i.first);
         tstring name = name_i != data.user_names.end()
           ? name_i->second
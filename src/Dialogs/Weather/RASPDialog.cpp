@@ -246,6 +246,11 @@ std::unique_ptr<Widget>
 CreateRaspWidget() noexcept
 {
   auto rasp = DataGlobals::GetRasp();
+  if (rasp == nullptr)
+    /* still being scanned in background (or there is no map);
+       show an empty list, the download will then replace it */
+    rasp = std::make_shared<RaspStore>(LocalPath(_T(RASP_FILENAME)));
+
   return std::make_unique<RASPSettingsPanel>(std::move(rasp));
 }
 
@@ -33,9 +33,16 @@ Copyright_License {
 #include "StatusPanels/RulesStatusPanel.hpp"
 #include "StatusPanels/SystemStatusPanel.hpp"
 #include "StatusPanels/TimesStatusPanel.hpp"
+#include "StatusPanels/RenderStatusPanel.hpp"
+#include "StatusPanels/ThreadStatusPanel.hpp"
+#include "StatusPanels/ComputerStatusPanel.hpp"
+#include "StatusPanels/MemoryStatusPanel.hpp"
+#include "system/MemoryAccounting.hpp"
+#include "MapWindow/GlueMapWindow.hpp"
 #include "Components.hpp"
 #include "Engine/Waypoint/Waypoints.hpp"
 #include "Interface.hpp"
+#include "MainWindow.hpp"
 #include "Language/Language.hpp"
 
 static int status_page = 0;
@@ -101,6 +108,27 @@ dlgStatusShowModal(int start_page)
   widget.AddTab(std::make_unique<TimesStatusPanel>(look),
                 _("Times"), TimesIcon);
 
+  if (const auto *map = UIGlobals::GetMap();
+      map != nullptr && CommonInterface::GetMapSettings().frame_profiler)
+    widget.AddTab(std::make_unique<RenderStatusPanel>(look,
+                                                      map->GetFrameProfiler(),
+                                                      CommonInterface::main_window->GetPowerPolicy()),
+                  _("Render"));
+
+  if (CommonInterface::GetMapSettings().frame_profiler)
+    widget.AddTab(std::make_unique<ThreadStatusPanel>(look), _("Threads"));
+
+#ifndef NDEBUG
+  if (glide_computer != nullptr)
+    widget.AddTab(std::make_unique<ComputerStatusPanel>(look,
+                                                        *glide_computer,
+                                                        merge_thread),
+                  _("Computer"));
+#endif
+
+  if (MemoryAccounting::enabled)
+    widget.AddTab(std::make_unique<MemoryStatusPanel>(look), _("Memory"));
+
   /* restore previous page */
 
   if (start_page != -1) {
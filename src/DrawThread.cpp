@@ -27,6 +27,7 @@ Copyright_License {
 
 #include "MapWindow/GlueMapWindow.hpp"
 #include "Hardware/CPU.hpp"
+#include "thread/Statistics.hpp"
 
 /**
  * Main loop of the DrawThread
@@ -36,6 +37,9 @@ DrawThread::Run() noexcept
 {
   SetLowPriority();
 
+  ThreadStatistics *const statistics =
+    ThreadStatistics::Register("DrawThread");
+
   std::unique_lock<Mutex> lock(mutex);
 
   // circle until application is closed
@@ -53,6 +57,8 @@ DrawThread::Run() noexcept
     const ScopeLockCPU cpu;
 #endif
 
+    const ScopeThreadStatistics measure(statistics);
+
     // Get data from the DeviceBlackboard
     map.ExchangeBlackboard();
 
@@ -29,6 +29,7 @@
 #include "AirspaceActivity.hpp"
 #include "Geo/GeoPoint.hpp"
 #include "Geo/SearchPointVector.hpp"
+#include "system/MemoryAccounting.hpp"
 
 #ifdef DO_PRINT
 #include <iostream>
@@ -83,6 +84,9 @@ protected:
 
   AirspaceActivity days_of_operation;
 
+  [[no_unique_address]]
+  MemoryAccounting::Reporter memory_usage{MemoryAccounting::Account::AIRSPACE};
+
 public:
   AbstractAirspace(Shape _shape) noexcept:shape(_shape), active(true) {}
   virtual ~AbstractAirspace() noexcept;
@@ -238,6 +242,10 @@ public:
     days_of_operation = mask;
   }
 
+  AirspaceActivity GetDays() const noexcept {
+    return days_of_operation;
+  }
+
   /**
    * Get type of airspace
    *
@@ -42,6 +42,9 @@ AirspaceCircle::AirspaceCircle(const GeoPoint &loc, const double _radius) noexce
     const GeoPoint p = GeoVector(m_radius * 1.1, angle).EndPoint(m_center);
     m_border.emplace_back(p);
   }
+
+  memory_usage.Update(sizeof(*this)
+                      + m_border.capacity() * sizeof(m_border.front()));
 }
 
 bool
@@ -24,9 +24,11 @@
 #define AIRSPACE_INTERSECT_SORT_HPP
 
 #include "Geo/GeoPoint.hpp"
+#include "util/ThreadLocalPool.hpp"
 
 #include <optional>
 #include <queue>
+#include <vector>
 
 class AbstractAirspace;
 class AirspaceIntersectionVector;
@@ -47,7 +49,10 @@ class AirspaceIntersectSort {
     }
   };
 
-  std::priority_queue<Intersection, std::vector<Intersection>, Rank> m_q;
+  std::priority_queue<Intersection,
+                      std::vector<Intersection,
+                                  ThreadLocalPoolAllocator<Intersection>>,
+                      Rank> m_q;
 
   const GeoPoint& m_start;
   const AbstractAirspace &airspace;
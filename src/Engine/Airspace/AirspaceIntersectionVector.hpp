@@ -24,10 +24,17 @@
 #define AIRSPACE_INTERSECTION_VECTOR_HPP
 
 #include "Geo/GeoPoint.hpp"
+#include "util/ThreadLocalPool.hpp"
 
 #include <vector>
 
+/**
+ * The intersections of a line with an airspace.  These are built and
+ * discarded many times per calculation cycle, therefore they are
+ * allocated from the #ThreadLocalPool.
+ */
 class AirspaceIntersectionVector:
-  public std::vector< std::pair<GeoPoint, GeoPoint> > {};
+  public std::vector<std::pair<GeoPoint, GeoPoint>,
+                     ThreadLocalPoolAllocator<std::pair<GeoPoint, GeoPoint>>> {};
 
 #endif
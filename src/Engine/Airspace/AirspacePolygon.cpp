@@ -23,9 +23,12 @@
 #include "AirspacePolygon.hpp"
 #include "Geo/Flat/FlatProjection.hpp"
 #include "Geo/Flat/FlatRay.hpp"
+#include "Geo/PolygonIntersections.hpp"
 #include "AirspaceIntersectSort.hpp"
 #include "AirspaceIntersectionVector.hpp"
 
+#include <algorithm>
+
 AirspacePolygon::AirspacePolygon(const std::vector<GeoPoint> &pts) noexcept
   :AbstractAirspace(Shape::POLYGON)
 {
@@ -43,6 +46,9 @@ AirspacePolygon::AirspacePolygon(const std::vector<GeoPoint> &pts) noexcept
     m_border.emplace_back(p_start);
 
   is_convex = TriState::UNKNOWN;
+
+  memory_usage.Update(sizeof(*this)
+                      + m_border.capacity() * sizeof(m_border.front()));
 }
 
 const GeoPoint
@@ -86,12 +92,20 @@ AirspacePolygon::Intersects(const GeoPoint &start, const GeoPoint &end,
 
   AirspaceIntersectSort sorter(start, *this);
 
-  for (auto it = m_border.begin(); it + 1 != m_border.end(); ++it) {
-
-    const FlatRay r_seg(it->GetFlatLocation(), (it + 1)->GetFlatLocation());
-    auto t = ray.DistinctIntersection(r_seg);
-    if (t >= 0)
+  /* find the intersecting edges in blocks, and calculate the
+     intersection only for those */
+  const SearchPoint *points = m_border.data();
+  const std::size_t n_edges = m_border.size() - 1;
+  for (std::size_t i = 0; i < n_edges; i += MAX_INTERSECTION_EDGES) {
+    const std::size_t n = std::min(n_edges - i, MAX_INTERSECTION_EDGES);
+    for (uint32_t mask = FindDistinctIntersections(ray, points + i, n);
+         mask != 0; mask &= mask - 1) {
+      const std::size_t j = i + __builtin_ctz(mask);
+      const FlatRay r_seg(points[j].GetFlatLocation(),
+                          points[j + 1].GetFlatLocation());
+      const auto t = ray.DistinctIntersection(r_seg);
       sorter.add(t, projection.Unproject(ray.Parametric(t)));
+    }
   }
 
   return sorter.all();
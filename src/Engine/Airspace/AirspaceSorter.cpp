@@ -3,6 +3,7 @@
 #include "AbstractAirspace.hpp"
 #include "Predicate/AirspacePredicate.hpp"
 #include "Geo/GeoVector.hpp"
+#include "Geo/Math.hpp"
 #include "util/StringAPI.hxx"
 
 #include <algorithm>
@@ -65,8 +66,53 @@ public:
   }
 };
 
+/**
+ * Calculate the vectors to all airspaces in one batch, which is
+ * cheaper than letting the sort comparison calculate them one by
+ * one.
+ */
 static void
-SortByDistance(AirspaceSelectInfoVector &vec, const GeoPoint &location,
+UpdateVectors(AirspaceSelectInfoVector &vec, const GeoPoint &location,
+              const FlatProjection &projection) noexcept
+{
+  std::vector<GeoPoint> closest;
+  closest.reserve(vec.size());
+  for (const auto &i : vec)
+    closest.push_back(i.GetAirspace().ClosestPoint(location, projection));
+
+  std::vector<double> distances(vec.size());
+  std::vector<Angle> bearings(vec.size());
+  DistanceBearing(location, closest, distances, bearings);
+
+  for (std::size_t i = 0; i < vec.size(); ++i)
+    vec[i].SetVector(GeoVector(distances[i], bearings[i]));
+}
+
+/**
+ * Sort the items from #sorted to #n_sorted, assuming the items
+ * before #sorted are already sorted and not greater than the rest.
+ */
+template<typename Compare>
+static void
+PartialSort(AirspaceSelectInfoVector &vec,
+            std::size_t sorted, std::size_t n_sorted,
+            Compare &&compare) noexcept
+{
+  n_sorted = std::min(n_sorted, vec.size());
+  if (sorted >= n_sorted)
+    return;
+
+  if (n_sorted == vec.size())
+    std::sort(vec.begin() + sorted, vec.end(), compare);
+  else
+    std::partial_sort(vec.begin() + sorted, vec.begin() + n_sorted,
+                      vec.end(), compare);
+}
+
+static void
+SortByDistance(AirspaceSelectInfoVector &vec,
+               std::size_t sorted, std::size_t n_sorted,
+               const GeoPoint &location,
                const FlatProjection &projection) noexcept
 {
   auto compare = [&] (const AirspaceSelectInfo &elem1,
@@ -75,11 +121,12 @@ SortByDistance(AirspaceSelectInfoVector &vec, const GeoPoint &location,
            elem2.GetVector(location, projection).distance;
   };
 
-  std::sort(vec.begin(), vec.end(), compare);
+  PartialSort(vec, sorted, n_sorted, compare);
 }
 
 static void
-SortByName(AirspaceSelectInfoVector &vec) noexcept
+SortByName(AirspaceSelectInfoVector &vec,
+           std::size_t sorted, std::size_t n_sorted) noexcept
 {
   auto compare = [&] (const AirspaceSelectInfo &elem1,
                       const AirspaceSelectInfo &elem2) {
@@ -87,12 +134,32 @@ SortByName(AirspaceSelectInfoVector &vec) noexcept
                          elem2.GetAirspace().GetName()) < 0;
   };
 
-  std::sort(vec.begin(), vec.end(), compare);
+  PartialSort(vec, sorted, n_sorted, compare);
+}
+
+[[gnu::pure]]
+static bool
+IsSortedByName(const AirspaceFilterData &filter) noexcept
+{
+  return filter.direction.IsNegative() && filter.distance < 0;
+}
+
+void
+SortAirspaces(AirspaceSelectInfoVector &vec,
+              std::size_t sorted, std::size_t n_sorted,
+              const GeoPoint &location, const FlatProjection &projection,
+              const AirspaceFilterData &filter) noexcept
+{
+  if (IsSortedByName(filter))
+    SortByName(vec, sorted, n_sorted);
+  else
+    SortByDistance(vec, sorted, n_sorted, location, projection);
 }
 
 AirspaceSelectInfoVector
 FilterAirspaces(const Airspaces &airspaces, const GeoPoint &location,
-                const AirspaceFilterData &filter) noexcept
+                const AirspaceFilterData &filter,
+                std::size_t n_sorted) noexcept
 {
   const AirspaceFilterPredicate predicate(location, airspaces.GetProjection(),
                                           filter);
@@ -105,10 +172,12 @@ FilterAirspaces(const Airspaces &airspaces, const GeoPoint &location,
     if (predicate(i.GetAirspace()))
       result.emplace_back(i.GetAirspacePtr());
 
-  if (filter.direction.IsNegative() && filter.distance < 0)
-    SortByName(result);
-  else
-    SortByDistance(result, location, airspaces.GetProjection());
+  /* all vectors are needed for selecting the nearest ones, even if
+     only a few are sorted */
+  if (!IsSortedByName(filter))
+    UpdateVectors(result, location, airspaces.GetProjection());
 
+  SortAirspaces(result, 0, n_sorted, location, airspaces.GetProjection(),
+                filter);
   return result;
 }
@@ -6,6 +6,9 @@
 #include "Airspace/AirspaceClass.hpp"
 
 #include <tchar.h>
+
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
 struct GeoPoint;
@@ -39,6 +42,10 @@ public:
     vec.SetInvalid();
   }
 
+  void SetVector(const GeoVector &_vec) noexcept {
+    vec = _vec;
+  }
+
   [[gnu::pure]]
   const GeoVector &GetVector(const GeoPoint &location,
                              const FlatProjection &projection) const noexcept;
@@ -82,10 +89,30 @@ struct AirspaceFilterData {
  *
  * @param airspaces the airspace database
  * @param location location of aircraft at time of query
+ * @param n_sorted sort only the first this number of items; the
+ * rest follows in unspecified order and may be sorted later with
+ * SortAirspaces()
  */
 [[gnu::pure]]
 AirspaceSelectInfoVector
 FilterAirspaces(const Airspaces &airspaces, const GeoPoint &location,
-                const AirspaceFilterData &filter) noexcept;
+                const AirspaceFilterData &filter,
+                std::size_t n_sorted=SIZE_MAX) noexcept;
+
+/**
+ * Extend the sorted part of a list returned by FilterAirspaces().
+ * This is a partial sort, which costs only O(n log k) for the
+ * additional k items.  The location and the filter must be the
+ * same which were passed to FilterAirspaces().
+ *
+ * @param sorted the number of items which are already sorted
+ * @param n_sorted the number of items which shall be sorted
+ * afterwards
+ */
+void
+SortAirspaces(AirspaceSelectInfoVector &vec,
+              std::size_t sorted, std::size_t n_sorted,
+              const GeoPoint &location, const FlatProjection &projection,
+              const AirspaceFilterData &filter) noexcept;
 
 #endif
@@ -27,9 +27,16 @@
 #include "AirspaceIntersectionVisitor.hpp"
 #include "AirspaceAircraftPerformance.hpp"
 #include "Task/Stats/TaskStats.hpp"
+#include "Geo/Flat/FlatRay.hpp"
 
 #define CRUISE_FILTER_FACT 0.5
 
+/**
+ * The margin [m] added around the look-ahead when the candidate
+ * window is moved.
+ */
+static constexpr double WINDOW_MARGIN = 10000;
+
 AirspaceWarningManager::AirspaceWarningManager(const AirspaceWarningConfig &_config,
                                                const Airspaces &_airspaces)
   :airspaces(_airspaces)
@@ -67,6 +74,52 @@ AirspaceWarningManager::Reset(const AircraftState &state)
   warnings.clear();
   cruise_filter.Reset(state);
   circling_filter.Reset(state);
+
+  candidates.clear();
+  inside.clear();
+  inside_location.SetInvalid();
+  window_valid = false;
+}
+
+void
+AirspaceWarningManager::UpdateWindow(const GeoPoint &location,
+                                     const GeoPoint &end) noexcept
+{
+  const FlatProjection &projection = GetProjection();
+
+  if (window_valid && window_serial == airspaces.GetSerial() &&
+      window.IsInside(projection.ProjectInteger(location)) &&
+      window.IsInside(projection.ProjectInteger(end)))
+    return;
+
+  /* cover twice the look-ahead, so the aircraft can fly for a while
+     before the window needs to be moved again */
+  const double range = 2 * location.Distance(end) + WINDOW_MARGIN;
+
+  window = projection.ProjectSquare(location, range);
+  window_serial = airspaces.GetSerial();
+  window_valid = true;
+
+  candidates.clear();
+  for (const auto &i : airspaces.QueryWithinRange(location, range))
+    candidates.push_back(i);
+}
+
+void
+AirspaceWarningManager::VisitIntersecting(const GeoPoint &location,
+                                          const GeoPoint &end,
+                                          AirspaceIntersectionVisitor &visitor) noexcept
+{
+  UpdateWindow(location, end);
+
+  const FlatProjection &projection = GetProjection();
+  const FlatRay ray(projection.ProjectInteger(location),
+                    projection.ProjectInteger(end));
+
+  for (const auto &i : candidates)
+    if (i.FlatBoundingBox::Intersects(ray) &&
+        visitor.SetIntersections(i.Intersects(location, end, projection)))
+      visitor.Visit(i.GetAirspacePtr());
 }
 
 void 
@@ -137,6 +190,17 @@ AirspaceWarningManager::Update(const AircraftState& state,
   for (auto &w : warnings)
     w.SaveState();
 
+  // find the candidates containing the aircraft, shared by all checks
+  UpdateWindow(state.location, state.location);
+
+  const auto flat_location = GetProjection().ProjectInteger(state.location);
+  inside.clear();
+  for (const auto &i : candidates)
+    if (i.FlatBoundingBox::IsInside(flat_location) &&
+        i.IsInside(state.location))
+      inside.push_back(i.GetAirspacePtr());
+  inside_location = state.location;
+
   // check from strongest to weakest alerts
   UpdateInside(state, glide_polar);
   UpdateGlide(state, glide_polar);
@@ -300,13 +364,12 @@ AirspaceWarningManager::UpdatePredicted(const AircraftState& state,
                                              warning_state, max_time_limit,
                                              ceiling);
 
-  airspaces.VisitIntersecting(state.location, location_predicted, visitor);
+  VisitIntersecting(state.location, location_predicted, visitor);
 
   visitor.SetMode(true);
 
-  for (const auto &i : airspaces.QueryInside(state.location)) {
-    visitor.Visit(i.GetAirspacePtr());
-  }
+  for (const auto &i : inside)
+    visitor.Visit(i);
 
   return visitor.Found();
 }
@@ -394,9 +457,7 @@ AirspaceWarningManager::UpdateInside(const AircraftState& state,
 
   bool found = false;
 
-  for (const auto &i : airspaces.QueryInside(state.location)) {
-    const auto airspace = i.GetAirspacePtr();
-
+  for (const auto &airspace : inside) {
     const AltitudeState &altitude = state;
     if (// ignore inactive airspaces
         !airspace->IsActive() ||
@@ -467,6 +528,18 @@ AirspaceWarningManager::IsActive(const AbstractAirspace &airspace) const noexcep
     !GetAckDay(airspace);
 }
 
+bool
+AirspaceWarningManager::GetInside(const GeoPoint &location,
+                                  std::vector<ConstAirspacePtr> &dest) const noexcept
+{
+  if (!inside_location.IsValid() || inside_location != location ||
+      !window_valid || window_serial != airspaces.GetSerial())
+    return false;
+
+  dest.assign(inside.begin(), inside.end());
+  return true;
+}
+
 void 
 AirspaceWarningManager::AcknowledgeAll()
 {
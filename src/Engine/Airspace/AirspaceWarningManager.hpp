@@ -24,16 +24,21 @@
 
 #include "AirspaceWarning.hpp"
 #include "AirspaceWarningConfig.hpp"
+#include "Airspace.hpp"
 #include "Util/AircraftStateFilter.hpp"
+#include "Geo/Flat/FlatBoundingBox.hpp"
 #include "time/FloatDuration.hxx"
+#include "util/Serial.hpp"
 
 #include <list>
+#include <vector>
 
 class TaskStats;
 class GlidePolar;
 class Airspaces;
 class FlatProjection;
 class AirspaceAircraftPerformance;
+class AirspaceIntersectionVisitor;
 
 /**
  * Class to detect and track airspace warnings
@@ -61,6 +66,41 @@ class AirspaceWarningManager {
 
   AirspaceWarningList warnings;
 
+  /**
+   * The airspaces whose bounding box overlaps #window.  All checks
+   * in Update() are evaluated against this list instead of querying
+   * #airspaces for each of them.  It is only queried again when a
+   * look-ahead vector leaves the window or when #airspaces changes.
+   */
+  std::vector<Airspace> candidates;
+
+  /**
+   * The area covered by #candidates, in the projection of
+   * #airspaces.
+   */
+  FlatBoundingBox window;
+
+  /**
+   * The Airspaces::GetSerial() value #candidates was obtained from.
+   */
+  Serial window_serial;
+
+  /**
+   * Does #window contain valid data?
+   */
+  bool window_valid = false;
+
+  /**
+   * The #candidates which contain the aircraft's location; updated at
+   * the beginning of each Update().
+   */
+  std::vector<AirspacePtr> inside;
+
+  /**
+   * The location #inside was determined for.
+   */
+  GeoPoint inside_location = GeoPoint::Invalid();
+
   /**
    * This number is incremented each time this object is modified.
    */
@@ -261,7 +301,33 @@ public:
   [[gnu::pure]]
   bool IsActive(const AbstractAirspace &airspace) const noexcept;
 
+  /**
+   * Copy the airspaces which contain the given location, as
+   * determined by the last Update() call.  This spares the caller an
+   * Airspaces::QueryInside() call.
+   *
+   * @return false if the last Update() was for a different location
+   * or the airspace database has been modified since; #dest is not
+   * modified then
+   */
+  bool GetInside(const GeoPoint &location,
+                 std::vector<ConstAirspacePtr> &dest) const noexcept;
+
 private:
+  /**
+   * Make sure that #candidates covers the vector from #location to
+   * #end, and query #airspaces again if it does not.
+   */
+  void UpdateWindow(const GeoPoint &location, const GeoPoint &end) noexcept;
+
+  /**
+   * Call the visitor for each candidate which intersects the vector
+   * from #location to #end; the equivalent of
+   * Airspaces::VisitIntersecting().
+   */
+  void VisitIntersecting(const GeoPoint &location, const GeoPoint &end,
+                         AirspaceIntersectionVisitor &visitor) noexcept;
+
   bool UpdateTask(const AircraftState &state, const GlidePolar &glide_polar,
                   const TaskStats &task_stats);
   bool UpdateFilter(const AircraftState& state, const bool circling);
@@ -135,6 +135,18 @@ Airspaces::Add(AirspacePtr airspace) noexcept
   tmp_as.push_back(std::move(airspace));
 }
 
+void
+Airspaces::Merge(Airspaces &&other) noexcept
+{
+  for (const auto &i : other.QueryAll())
+    Add(i.GetAirspacePtr());
+
+  for (auto &i : other.tmp_as)
+    Add(std::move(i));
+
+  other.Clear();
+}
+
 void
 Airspaces::Clear() noexcept
 {
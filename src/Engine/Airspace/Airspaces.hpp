@@ -82,6 +82,13 @@ public:
    */
   void Add(AirspacePtr airspace) noexcept;
 
+  /**
+   * Move all airspaces from another container into this one, leaving
+   * the other one empty.  Its tree doesn't need to be built;
+   * Optimise() must be called on this object afterwards.
+   */
+  void Merge(Airspaces &&other) noexcept;
+
   /**
    * Re-organise the internal airspace tree after inserting/deleting.
    * Should be called after inserting/deleting airspaces prior to performing
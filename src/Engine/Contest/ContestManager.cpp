@@ -21,27 +21,35 @@
  */
 
 #include "ContestManager.hpp"
+#include "thread/ThreadPool.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
 
 ContestManager::ContestManager(const Contest _contest,
-                               const Trace &trace_full,
-                               const Trace &trace_triangle,
-                               const Trace &trace_sprint,
+                               const Trace &_trace_full,
+                               const Trace &_trace_triangle,
+                               const Trace &_trace_sprint,
                                bool predict_triangle) noexcept
   :contest(_contest),
-   olc_sprint(trace_sprint),
-   olc_fai(trace_triangle, predict_triangle),
-   olc_classic(trace_full),
-   olc_league(trace_sprint),
-   dmst_quad(trace_full),
-   xcontest_free(trace_full, false),
-   xcontest_triangle(trace_triangle, predict_triangle, false),
-   dhv_xc_free(trace_full, true),
-   dhv_xc_triangle(trace_triangle, predict_triangle, true),
-   sis_at(trace_full),
-   net_coupe(trace_full),
-   weglide_distance(trace_full),
-   weglide_fai(trace_triangle, predict_triangle),
-   weglide_or(trace_full)
+   trace_full(_trace_full),
+   trace_triangle(_trace_triangle),
+   trace_sprint(_trace_sprint),
+   olc_sprint(_trace_sprint),
+   olc_fai(_trace_triangle, predict_triangle),
+   olc_classic(_trace_full),
+   olc_league(_trace_sprint),
+   dmst_quad(_trace_full),
+   xcontest_free(_trace_full, false),
+   xcontest_triangle(_trace_triangle, predict_triangle, false),
+   dhv_xc_free(_trace_full, true),
+   dhv_xc_triangle(_trace_triangle, predict_triangle, true),
+   sis_at(_trace_full),
+   net_coupe(_trace_full),
+   weglide_distance(_trace_full),
+   weglide_fai(_trace_triangle, predict_triangle),
+   weglide_or(_trace_full)
 {
   Reset();
 }
@@ -64,6 +72,20 @@ ContestManager::SetIncremental(bool incremental) noexcept
   weglide_or.SetIncremental(incremental);
 }
 
+void
+ContestManager::SetTimeBudget(std::chrono::steady_clock::duration time_budget) noexcept
+{
+  olc_sprint.SetTimeBudget(time_budget);
+  olc_classic.SetTimeBudget(time_budget);
+  dmst_quad.SetTimeBudget(time_budget);
+  xcontest_free.SetTimeBudget(time_budget);
+  dhv_xc_free.SetTimeBudget(time_budget);
+  sis_at.SetTimeBudget(time_budget);
+  net_coupe.SetTimeBudget(time_budget);
+  weglide_distance.SetTimeBudget(time_budget);
+  weglide_or.SetTimeBudget(time_budget);
+}
+
 void
 ContestManager::SetPredicted(const TracePoint &predicted) noexcept
 {
@@ -125,6 +147,37 @@ RunContest(AbstractContest &_contest,
   return true;
 }
 
+bool
+ContestManager::RunIndependent(std::initializer_list<AbstractContest *> contests,
+                               bool exhaustive) noexcept
+{
+  const unsigned n = contests.size();
+  assert(n <= ContestStatistics::N);
+
+  std::array<bool, ContestStatistics::N> found{};
+
+  const auto job = [&](unsigned i){
+    found[i] = RunContest(*contests.begin()[i],
+                          stats.result[i], stats.solution[i],
+                          exhaustive);
+  };
+
+  if (thread_pool != nullptr && n > 1) {
+    /* the solvers share the snapshots of the master traces; bring
+       them up to date now, so the solvers only read them */
+    trace_full.GetSnapshot();
+    trace_triangle.GetSnapshot();
+    trace_sprint.GetSnapshot();
+
+    thread_pool->ForEach(n, job);
+  } else {
+    for (unsigned i = 0; i < n; ++i)
+      job(i);
+  }
+
+  return std::find(found.begin(), found.end(), true) != found.end();
+}
+
 bool
 ContestManager::UpdateIdle(bool exhaustive) noexcept
 {
@@ -160,11 +213,7 @@ ContestManager::UpdateIdle(bool exhaustive) noexcept
     break;
 
   case Contest::OLC_PLUS:
-    retval = RunContest(olc_classic, stats.result[0],
-                        stats.solution[0], exhaustive);
-
-    retval |= RunContest(olc_fai, stats.result[1],
-                         stats.solution[1], exhaustive);
+    retval = RunIndependent({&olc_classic, &olc_fai}, exhaustive);
 
     if (retval) {
       olc_plus.Feed(stats.result[0], stats.solution[0],
@@ -182,17 +231,11 @@ ContestManager::UpdateIdle(bool exhaustive) noexcept
     break;
 
   case Contest::XCONTEST:
-    retval = RunContest(xcontest_free, stats.result[0],
-                        stats.solution[0], exhaustive);
-    retval |= RunContest(xcontest_triangle, stats.result[1],
-                         stats.solution[1], exhaustive);
+    retval = RunIndependent({&xcontest_free, &xcontest_triangle}, exhaustive);
     break;
 
   case Contest::DHV_XC:
-    retval = RunContest(dhv_xc_free, stats.result[0],
-                        stats.solution[0], exhaustive);
-    retval |= RunContest(dhv_xc_triangle, stats.result[1],
-                         stats.solution[1], exhaustive);
+    retval = RunIndependent({&dhv_xc_free, &dhv_xc_triangle}, exhaustive);
     break;
 
   case Contest::SIS_AT:
@@ -206,14 +249,8 @@ ContestManager::UpdateIdle(bool exhaustive) noexcept
     break;
 
   case Contest::WEGLIDE_FREE:
-    retval = RunContest(weglide_distance, stats.result[0],
-                        stats.solution[0], exhaustive);
-
-    retval |= RunContest(weglide_fai, stats.result[1],
-                         stats.solution[1], exhaustive);
-
-    retval |= RunContest(weglide_or, stats.result[2],
-                         stats.solution[2], exhaustive);
+    retval = RunIndependent({&weglide_distance, &weglide_fai, &weglide_or},
+                            exhaustive);
 
     if (retval) {
       weglide_free.Feed(stats.result[0], stats.solution[0],
@@ -40,7 +40,11 @@
 #include "Solvers/WeglideOR.hpp"
 #include "ContestStatistics.hpp"
 
+#include <chrono>
+#include <initializer_list>
+
 class Trace;
+class ThreadPool;
 
 /**
  * Special task holder for Online Contest calculations
@@ -53,6 +57,19 @@ class ContestManager
 
   ContestStatistics stats;
 
+  /**
+   * The master traces.  All solvers reading the same #Trace share
+   * its projected #TraceSnapshot (see TraceManager), so each point is
+   * stored and projected only once, no matter how many solvers use
+   * it.
+   */
+  const Trace &trace_full, &trace_triangle, &trace_sprint;
+
+  /**
+   * If set, then independent solvers of one contest run in parallel.
+   */
+  ThreadPool *thread_pool = nullptr;
+
   OLCSprint olc_sprint;
   OLCFAI olc_fai;
   OLCClassic olc_classic;
@@ -93,6 +110,11 @@ public:
 
   void SetIncremental(bool incremental) noexcept;
 
+  /**
+   * @see ContestDijkstra::SetTimeBudget()
+   */
+  void SetTimeBudget(std::chrono::steady_clock::duration time_budget) noexcept;
+
   /**
    * @see ContestDijkstra::SetPredicted()
    */
@@ -104,6 +126,16 @@ public:
 
   void SetHandicap(unsigned handicap) noexcept;
 
+  /**
+   * Run independent solvers (e.g. the free distance and the triangle
+   * of a contest) concurrently in the given #ThreadPool.  Pass
+   * nullptr to run them sequentially in the calling thread.  The
+   * pool must remain valid until it is replaced.
+   */
+  void SetThreadPool(ThreadPool *_thread_pool) noexcept {
+    thread_pool = _thread_pool;
+  }
+
   /**
    * Update internal states (non-essential) for housework,
    * or where functions are slow and would cause loss to real-time performance.
@@ -141,6 +173,16 @@ public:
   const ContestStatistics &GetStats() const noexcept {
     return stats;
   }
+
+private:
+  /**
+   * Run solvers which do not depend on each other; solver i stores
+   * its result in stats.result[i] and stats.solution[i].
+   *
+   * @return true if at least one solver has found a new solution
+   */
+  bool RunIndependent(std::initializer_list<AbstractContest *> contests,
+                      bool exhaustive) noexcept;
 };
 
 #endif
@@ -126,7 +126,13 @@ ContestDijkstra::Solve(bool exhaustive) noexcept
       return SolverResult::FAILED;
   }
 
-  SolverResult result = DistanceGeneral(exhaustive ? 0 - 1 : 25);
+  SolverResult result = exhaustive
+    ? DistanceGeneral()
+    : (time_budget > time_budget.zero()
+       ? DistanceGeneral(std::chrono::steady_clock::now() + time_budget)
+       : DistanceGeneral(25));
+  max_queue_size = std::max(max_queue_size, dijkstra.GetMaxQueueSize());
+
   if (result != SolverResult::INCOMPLETE) {
     if (incremental && continuous)
       /* enable the incremental solver, which considers the existing
@@ -149,6 +155,7 @@ ContestDijkstra::Reset() noexcept
   dijkstra.Clear();
   ClearTrace();
   finished = false;
+  max_queue_size = 0;
 
   AbstractContest::Reset();
 }
@@ -215,7 +222,7 @@ ContestDijkstra::AddStartEdges() noexcept
        destination != end; destination.IncrementPointIndex()) {
     // only add points that are valid for the finish
     if (!incremental ||
-        GetPoint(destination).GetIntegerAltitude() <= max_altitude)
+        GetIntegerAltitude(destination.GetPointIndex()) <= max_altitude)
       LinkStart(destination);
   }
 }
@@ -242,7 +249,8 @@ ContestDijkstra::AddEdges(const ScanTaskPoint origin,
   bool previous_above = false;
   for (const ScanTaskPoint end(destination.GetStageNumber(), n_points);
        destination != end; destination.IncrementPointIndex()) {
-    bool above = GetPoint(destination).GetIntegerAltitude() >= min_altitude;
+    bool above =
+      GetIntegerAltitude(destination.GetPointIndex()) >= min_altitude;
 
     if (above) {
       const unsigned d = weight * CalcEdgeDistance(origin, destination);
@@ -29,6 +29,7 @@ Copyright_License {
 #include "TraceManager.hpp"
 
 #include <cassert>
+#include <chrono>
 
 class Trace;
 
@@ -66,6 +67,17 @@ class ContestDijkstra : public AbstractContest, protected NavDijkstra, public Tr
    */
   ContestTraceVector solution;
 
+  /**
+   * The largest Dijkstra queue size seen since the last Reset().
+   */
+  unsigned max_queue_size = 0;
+
+  /**
+   * How long may one non-exhaustive Solve() call search?  Zero means
+   * a fixed number of steps per call.
+   */
+  std::chrono::steady_clock::duration time_budget{};
+
 protected:
   /**
    * The index of the first finish candidate.  During incremental
@@ -93,6 +105,28 @@ public:
     incremental = _incremental;
   }
 
+  /**
+   * Limit the time spent in one non-exhaustive Solve() call.  When
+   * the budget is used up, the search is suspended and continues
+   * with the next call, which makes the cost of a call independent
+   * of the trace length.
+   *
+   * @param _time_budget the maximum duration of a call; zero runs a
+   * fixed number of steps instead
+   */
+  void SetTimeBudget(std::chrono::steady_clock::duration _time_budget) noexcept {
+    time_budget = _time_budget;
+  }
+
+  /**
+   * Return the largest Dijkstra queue size seen since the last
+   * Reset(), for benchmarking.
+   */
+  [[gnu::pure]]
+  unsigned GetMaxQueueSize() const noexcept {
+    return max_queue_size;
+  }
+
 protected:
   bool IsIncremental() const noexcept {
     return incremental;
@@ -137,7 +171,8 @@ protected:
   [[gnu::pure]]
   unsigned CalcEdgeDistance(const ScanTaskPoint s1,
                             const ScanTaskPoint s2) const noexcept {
-    return GetPoint(s1).FlatDistanceTo(GetPoint(s2));
+    return GetFlatLocation(s1.GetPointIndex())
+      .Distance(GetFlatLocation(s2.GetPointIndex()));
   }
 
   bool Link(const ScanTaskPoint node, const ScanTaskPoint parent,
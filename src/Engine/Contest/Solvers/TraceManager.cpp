@@ -71,7 +71,7 @@ TraceManager::IsMasterUpdated(bool continuous) const noexcept
   if (continuous)
     return false;
 
-  if (trace.empty())
+  if (n_points == 0)
     return true;
 
   /* TODO: disabled check, move it to ContestDijkstra */
@@ -83,7 +83,7 @@ TraceManager::IsMasterUpdated(bool continuous) const noexcept
   const unsigned threshold_distance_trace = trace_master.GetAverageDeltaDistance();
 
   const TracePoint &last_master = trace_master.back();
-  const TracePoint &last_point = *trace.back();
+  const TracePoint &last_point = GetPoint(n_points - 1);
 
   // update trace if time and distance are greater than significance thresholds
 
@@ -96,7 +96,7 @@ TraceManager::ClearTrace() noexcept
 {
   append_serial = modify_serial = Serial();
   trace_dirty = true;
-  trace.clear();
+  snapshot = nullptr;
   n_points = 0;
   predicted = TracePoint::Invalid();
 }
@@ -104,9 +104,8 @@ TraceManager::ClearTrace() noexcept
 void
 TraceManager::UpdateTraceFull() noexcept
 {
-  trace.reserve(trace_master.GetMaxSize());
-  trace_master.GetPoints(trace);
-  n_points = trace.size();
+  snapshot = &trace_master.GetSnapshot();
+  n_points = snapshot->size();
 
   if (n_points > 0 && predicted.IsDefined())
     predicted.Project(trace_master.GetProjection());
@@ -124,11 +123,15 @@ TraceManager::UpdateTraceTail() noexcept
   //assert(incremental == finished || force);
   assert(modify_serial == trace_master.GetModifySerial());
 
-  if (!trace_master.SyncPoints(trace))
+  const TraceSnapshot &s = trace_master.GetSnapshot();
+  assert(s.size() >= n_points);
+
+  if (s.size() == n_points)
     /* no new points */
     return false;
 
-  n_points = trace.size();
+  snapshot = &s;
+  n_points = s.size();
 
   if (n_points > 0 && predicted.IsDefined())
     predicted.Project(trace_master.GetProjection());
@@ -26,7 +26,7 @@ Copyright_License {
 
 #include "util/Serial.hpp"
 #include "Trace/Trace.hpp"
-#include "Trace/Vector.hpp"
+#include "Trace/Snapshot.hpp"
 #include "Trace/Point.hpp"
 
 class TraceManager {
@@ -50,11 +50,13 @@ private:
 
 protected:
   /**
-   * Working trace for solver.  This contains pointers to trace_master
+   * Working trace for solver: the snapshot of trace_master, which is
+   * shared with all other solvers of the same #Trace.  Only the
+   * first #n_points are used.  It contains pointers to trace_master
    * records, which get Invalidated when the trace gets thinned.  Be
    * careful!
    */
-  TracePointerVector trace;
+  const TraceSnapshot *snapshot = nullptr;
 
   /** Number of points in current trace set */
   unsigned n_points;
@@ -102,7 +104,28 @@ protected:
   const TracePoint &GetPoint(unsigned i) const noexcept {
     assert(i < n_points);
 
-    return *trace[i];
+    return snapshot->GetPoint(i);
+  }
+
+  [[gnu::pure]]
+  FlatGeoPoint GetFlatLocation(unsigned i) const noexcept {
+    assert(i < n_points);
+
+    return snapshot->GetFlatLocation(i);
+  }
+
+  [[gnu::pure]]
+  TracePoint::Time GetTime(unsigned i) const noexcept {
+    assert(i < n_points);
+
+    return snapshot->GetTime(i);
+  }
+
+  [[gnu::pure]]
+  int GetIntegerAltitude(unsigned i) const noexcept {
+    assert(i < n_points);
+
+    return snapshot->GetIntegerAltitude(i);
   }
 
   [[gnu::pure]]
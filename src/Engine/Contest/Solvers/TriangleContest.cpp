@@ -77,6 +77,7 @@ TriangleContest::Reset() noexcept
 
   closing_pairs.Clear();
   ClearTrace();
+  searched_points = 0;
 
   ResetBranchAndBound();
   AbstractContest::Reset();
@@ -115,6 +116,7 @@ TriangleContest::UpdateTrace(bool force) noexcept
     is_complete = false;
 
     best_d = 0;
+    searched_points = 0;
 
     closing_pairs.Clear();
     is_closed = FindClosingPairs(0);
@@ -267,8 +269,15 @@ TriangleContest::SolveTriangle(bool exhaustive) noexcept
      * We're currently running in predictive, non-exhaustive mode, so we use
      * one closing pair only (0 -> n_points-1) which allows us to suspend the
      * solver...
+     *
+     * Points are only appended in this mode, and the closing pair
+     * always covers the whole trace, so triangles on points examined
+     * by the last completed run don't need to be searched again.
      */
-    const auto triangle = RunBranchAndBound(0, n_points - 1, best_d, false);
+    const auto triangle = RunBranchAndBound(0, n_points - 1, best_d, false,
+                                            searched_points);
+    if (!running)
+      searched_points = n_points;
 
     if (std::get<3>(triangle) > best_d) {
       // solution is better than best_d
@@ -299,7 +308,7 @@ TriangleContest::SolveTriangle(bool exhaustive) noexcept
 
 std::tuple<unsigned, unsigned, unsigned, unsigned>
 TriangleContest::RunBranchAndBound(unsigned from, unsigned to, unsigned worst_d,
-                                   bool exhaustive) noexcept
+                                   bool exhaustive, unsigned min_tp3) noexcept
 {
   /* Some general information about the branch and bound method can be found here:
    * http://eaton.math.rpi.edu/faculty/Mitchell/papers/leeejem.html
@@ -317,6 +326,10 @@ TriangleContest::RunBranchAndBound(unsigned from, unsigned to, unsigned worst_d,
   if (fastskiprange_flat < worst_d)
     return {0, 0, 0, 0};
 
+  if (!running && std::max(from, min_tp3) > to)
+    /* all points have been searched already */
+    return {0, 0, 0, 0};
+
   bool integral_feasible = false;
   unsigned best_d = 0,
            tp1 = 0,
@@ -335,7 +348,10 @@ TriangleContest::RunBranchAndBound(unsigned from, unsigned to, unsigned worst_d,
     running = true;
 
     // initialize bound-and-branch tree with root node (note: Candidate set interval is [min, max))
-    CandidateSet root_candidates(*this, from, to + 1);
+    const TurnPointRange all(*this, from, to + 1);
+    const CandidateSet root_candidates = min_tp3 > from
+      ? CandidateSet(all, all, TurnPointRange(*this, min_tp3, to + 1))
+      : CandidateSet(all);
     if (root_candidates.IsFeasible(validator) &&
         root_candidates.df_max >= worst_d)
       branch_and_bound.emplace(root_candidates.df_max, root_candidates);
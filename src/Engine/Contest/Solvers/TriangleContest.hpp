@@ -28,6 +28,7 @@
 #include "TraceManager.hpp"
 #include "Trace/Point.hpp"
 #include "Geo/Flat/FlatBoundingBox.hpp"
+#include "util/ThreadLocalPool.hpp"
 
 #include <map>
 
@@ -84,6 +85,15 @@ private:
    */
   unsigned tick_iterations;
 
+  /**
+   * The number of points which have been examined by a completed
+   * predictive search.  No triangle with all turn points below this
+   * index can beat #best_d, therefore the next search only needs to
+   * consider a third turn point among the points appended since.
+   * Reset when the trace is replaced.
+   */
+  unsigned searched_points = 0;
+
   /**
    * Hard limits for number of iterations and tree size.
    */
@@ -150,10 +160,10 @@ private:
     TurnPointRange(const TriangleContest &parent,
                    const unsigned min, const unsigned max) noexcept
       :index_min(min), index_max(max),
-       bounding_box(FlatBoundingBox(parent.GetPoint(min).GetFlatLocation()))
+       bounding_box(FlatBoundingBox(parent.GetFlatLocation(min)))
     {
       for (unsigned i = min + 1; i < max; ++i)
-        bounding_box.Expand(parent.GetPoint(i).GetFlatLocation());
+        bounding_box.Expand(parent.GetFlatLocation(i));
     }
 
     bool operator==(TurnPointRange other) const noexcept {
@@ -260,7 +270,14 @@ private:
     }
   };
 
-  std::multimap<unsigned, CandidateSet> branch_and_bound;
+  /**
+   * The candidate sets which are yet to be examined.  Thousands of
+   * nodes are inserted and erased in each run, therefore they are
+   * allocated from the #ThreadLocalPool.
+   */
+  std::multimap<unsigned, CandidateSet, std::less<unsigned>,
+                ThreadLocalPoolAllocator<std::pair<const unsigned,
+                                                   CandidateSet>>> branch_and_bound;
 
 public:
   TriangleContest(const Trace &_trace,
@@ -275,9 +292,13 @@ protected:
   bool FindClosingPairs(unsigned old_size) noexcept;
   void SolveTriangle(bool exhaustive) noexcept;
 
+  /**
+   * @param min_tp3 the lowest index which shall be considered for
+   * the third turn point; everything below has been searched already
+   */
   std::tuple<unsigned, unsigned, unsigned, unsigned>
   RunBranchAndBound(unsigned from, unsigned to, unsigned best_d,
-                    bool exhaustive) noexcept;
+                    bool exhaustive, unsigned min_tp3 = 0) noexcept;
 
   void UpdateTrace(bool force) noexcept override;
   void ResetBranchAndBound() noexcept;
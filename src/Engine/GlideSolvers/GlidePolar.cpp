@@ -260,6 +260,7 @@ GlidePolar::IsGlidePossible(const GlideState &task) const
   return true;
 }
 
+#if 0
 /**
  * Finds speed to fly for a given MacCready setting
  * Intended to be used temporarily.
@@ -319,13 +320,36 @@ public:
     return Vopt + m_head_wind;
   }
 };
+#endif
 
 double
 GlidePolar::SpeedToFly(const double stf_sink_rate, const double head_wind) const
 {
   assert(IsValid());
+
+#if 0
+  // this method to be used if polar is not parabolic
   GlidePolarSpeedToFly gp_stf(*this, stf_sink_rate, head_wind, Vmin, Vmax);
   return gp_stf.solve(Vmax);
+#else
+  assert(polar.IsValid());
+
+  /* minimise (S(Vg + head_wind) + mc + stf_sink_rate) / Vg over the
+     ground speed Vg; for the parabolic polar, this is
+     a*Vg + const + k/Vg, which has its minimum at sqrt(k/a) */
+  const auto k = polar.a * Square(head_wind) + polar.b * head_wind
+    + polar.c + mc + stf_sink_rate;
+  const auto vg = k > 0 ? sqrt(k / polar.a) : 0.;
+
+  const auto vg_min = std::max(1., Vmin - head_wind);
+  const auto vg_max = Vmax - head_wind;
+  if (vg_max <= vg_min)
+    /* the head wind is so strong that there is hardly any progress
+       over ground; fly as fast as possible */
+    return Vmax;
+
+  return Clamp(vg, vg_min, vg_max) + head_wind;
+#endif
 }
 
 double
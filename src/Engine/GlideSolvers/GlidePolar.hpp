@@ -120,6 +120,8 @@ public:
   GlidePolar(const double _mc, const double _bugs=1,
              const double _ballast=0);
 
+  bool operator==(const GlidePolar &) const noexcept = default;
+
   /**
    * Constructs a GlidePolar object that is invalid.
    */
@@ -33,6 +33,8 @@ struct GlideSettings {
   bool predict_wind_drift;
 
   void SetDefaults();
+
+  bool operator==(const GlideSettings &) const noexcept = default;
 };
 
 #endif
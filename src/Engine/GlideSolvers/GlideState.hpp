@@ -72,6 +72,8 @@ public:
   GlideState(const GeoVector &vector, const double htarget,
              double altitude, const SpeedVector wind);
 
+  bool operator==(const GlideState &) const noexcept = default;
+
   [[gnu::pure]]
   static GlideState Remaining(const TaskPoint &tp,
                               const AircraftState &aircraft,
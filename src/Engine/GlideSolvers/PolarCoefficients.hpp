@@ -32,6 +32,8 @@ struct PolarCoefficients
   constexpr PolarCoefficients(double _a, double _b, double _c) noexcept
     :a(_a), b(_b), c(_c) {}
 
+  constexpr bool operator==(const PolarCoefficients &) const noexcept = default;
+
   /**
    * Construct an invalid object.
    */
@@ -25,15 +25,54 @@ Copyright_License {
 #define DIJKSTRA_HPP
 
 #include "util/ReservablePriorityQueue.hpp"
+#include "util/RadixHeap.hpp"
+
+#include <vector>
 
 #define DIJKSTRA_MINMAX_OFFSET 134217727
 
+/**
+ * A QueueTemplate for #Dijkstra: a binary heap.
+ */
+struct BinaryHeapQueue {
+  template<typename GetKey>
+  struct Rank {
+    template<typename T>
+    [[gnu::pure]]
+    constexpr bool operator()(const T &x, const T &y) const noexcept {
+      return GetKey()(x) > GetKey()(y);
+    }
+  };
+
+  template<typename T, typename GetKey>
+  using Bind = reservable_priority_queue<T, std::vector<T>, Rank<GetKey>>;
+};
+
+/**
+ * A QueueTemplate for #Dijkstra: a #RadixHeap, which is faster
+ * than a binary heap for integer values, because Dijkstra's
+ * algorithm never pushes a value below the current one.
+ */
+struct RadixHeapQueue {
+  template<typename T, typename GetKey>
+  using Bind = RadixHeap<T, GetKey>;
+};
+
 /**
  * Dijkstra search algorithm.
  * Modifications by John Wharington to track optimal solution
  * @see http://en.giswiki.net/wiki/Dijkstra%27s_algorithm
+ *
+ * @param MapTemplate a class with a "Bind" template which maps a
+ * Node to a value; its value_type has the members "first" and
+ * "second", and find() returns a pointer (or nullptr) which must
+ * remain valid until clear()
+ * @param QueueTemplate a class with a "Bind" template which
+ * implements a min-priority queue; see #BinaryHeapQueue and
+ * #RadixHeapQueue
  */
-template<typename Node, typename MapTemplate>
+template<typename Node, typename MapTemplate,
+         typename QueueTemplate=BinaryHeapQueue>
 class Dijkstra
 {
 public:
@@ -48,24 +87,23 @@ public:
   };
 
   typedef typename MapTemplate::template Bind<Edge> EdgeMap;
-  typedef typename EdgeMap::iterator edge_iterator;
-  typedef typename EdgeMap::const_iterator edge_const_iterator;
+  typedef typename EdgeMap::value_type EdgeMapValue;
 
 private:
   struct Value
   {
     unsigned edge_value;
 
-    edge_iterator iterator;
+    const EdgeMapValue *edge;
 
-    constexpr Value(unsigned _edge_value, edge_iterator _iterator) noexcept
-      :edge_value(_edge_value), iterator(_iterator) {}
+    constexpr Value(unsigned _edge_value, const EdgeMapValue *_edge) noexcept
+      :edge_value(_edge_value), edge(_edge) {}
   };
 
-  struct Rank {
+  struct GetValueKey {
     [[gnu::pure]]
-    constexpr bool operator()(const Value &x, const Value &y) const noexcept {
-      return x.edge_value > y.edge_value;
+    constexpr unsigned operator()(const Value &x) const noexcept {
+      return x.edge_value;
     }
   };
 
@@ -78,7 +116,7 @@ private:
   /**
    * A sorted list of all possible node paths, lowest distance first.
    */
-  reservable_priority_queue<Value, std::vector<Value>, Rank> q;
+  typename QueueTemplate::template Bind<Value, GetValueKey> q;
 
   /**
    * The value of the current edge, i.e. the one that was consumed by
@@ -86,6 +124,12 @@ private:
    */
   unsigned current_value;
 
+  /**
+   * The largest number of elements which were in #q since the last
+   * Clear() call.
+   */
+  unsigned max_queue_size = 0;
+
 public:
   /**
    * Default constructor
@@ -105,6 +149,7 @@ public:
     edges.clear();
 
     current_value = 0;
+    max_queue_size = 0;
   }
 
   /**
@@ -136,6 +181,16 @@ public:
     return q.size();
   }
 
+  /**
+   * Return the largest size of the queue since the last Clear() call
+   *
+   * @return Queue size in elements
+   */
+  [[gnu::pure]]
+  unsigned GetMaxQueueSize() const noexcept {
+    return max_queue_size;
+  }
+
   /**
    * Hack to allow incremental / continuous runs, see
    * ContestDijkstra::AddIncrementalEdges().
@@ -150,14 +205,14 @@ public:
    * @return Node for processing
    */
   Node Pop() noexcept {
-    edge_const_iterator cur(q.top().iterator);
-    current_value = cur->second.value;
+    const EdgeMapValue &cur = *q.top().edge;
+    current_value = cur.second.value;
 
     do {
       q.pop();
-    } while (!q.empty() && q.top().iterator->second.value < q.top().edge_value);
+    } while (!q.empty() && q.top().edge->second.value < q.top().edge_value);
 
-    return cur->first;
+    return cur.first;
   }
 
   /**
@@ -182,8 +237,8 @@ public:
   [[gnu::pure]]
   Node GetPredecessor(const Node node) const noexcept {
     // Try to find the given node in the node_parent_map
-    edge_const_iterator it = edges.find(node);
-    if (it == edges.end())
+    const EdgeMapValue *e = edges.find(node);
+    if (e == nullptr)
       // first entry
       // If the node wasn't found
       // -> Return the given node itself
@@ -191,7 +246,7 @@ public:
     else
       // If the node was found
       // -> Return the parent node
-      return it->second.parent;
+      return e->second.parent;
   }
 
   /**
@@ -209,7 +264,9 @@ public:
     q.clear();
 
     for (const auto &i : edges)
-      q.push(Value(i.second.value, i));
+      q.push(Value(i.second.value, &i));
+
+    UpdateMaxQueueSize();
   }
 
 private:
@@ -224,24 +281,30 @@ private:
   bool Push(const Node node, const Node parent,
             unsigned edge_value = 0) noexcept {
     // Try to find the given node n in the EdgeMap
-    edge_iterator it = edges.find(node);
-    if (it == edges.end())
+    EdgeMapValue *e = edges.find(node);
+    if (e == nullptr)
       // first entry
       // If the node wasn't found
       // -> Insert a new node
-      it = edges.insert(std::make_pair(node, Edge(parent, edge_value))).first;
-    else if (it->second.value > edge_value)
+      e = edges.emplace(node, Edge(parent, edge_value)).first;
+    else if (e->second.value > edge_value)
       // If the node was found and the new value is smaller
       // -> Replace the value with the new one
-      it->second = Edge(parent, edge_value);
+      e->second = Edge(parent, edge_value);
     else
       // If the node was found but the new value is higher or equal
       // -> Don't use this new leg
       return false;
 
-    q.push(Value(edge_value, it));
+    q.push(Value(edge_value, e));
+    UpdateMaxQueueSize();
     return true;
   }
+
+  void UpdateMaxQueueSize() noexcept {
+    if (q.size() > max_queue_size)
+      max_queue_size = q.size();
+  }
 };
 
 #endif
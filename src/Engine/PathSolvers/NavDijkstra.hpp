@@ -26,9 +26,10 @@ Copyright_License {
 
 #include "Dijkstra.hpp"
 #include "ScanTaskPoint.hpp"
+#include "ScanTaskPointMap.hpp"
 #include "SolverResult.hpp"
 
-#include <unordered_map>
+#include <chrono>
 #include <cassert>
 
 /**
@@ -43,27 +44,10 @@ class NavDijkstra {
 protected:
   static constexpr unsigned MAX_STAGES = 32;
 
-  struct DijkstraMap {
-    struct Hash {
-      constexpr std::size_t operator()(ScanTaskPoint p) const noexcept {
-        return p.Key();
-      }
-    };
-
-    struct Equal {
-      constexpr std::size_t operator()(ScanTaskPoint a,
-                                       ScanTaskPoint b) const noexcept {
-        return a.Key() == b.Key();
-      }
-    };
-
-    template<typename Value>
-    struct Bind : public std::unordered_map<ScanTaskPoint, Value,
-                                            Hash, Equal> {
-    };
-  };
-
-  typedef ::Dijkstra<ScanTaskPoint, DijkstraMap> Dijkstra;
+  /* the node space is bounded, which allows a dense edge map; the
+     RadixHeapQueue is a bit faster for contest searches, but needs
+     several times the memory of a binary heap */
+  typedef ::Dijkstra<ScanTaskPoint, ScanTaskPointMap> Dijkstra;
 
   Dijkstra dijkstra;
 
@@ -184,6 +168,26 @@ protected:
     return SolverResult::FAILED;
   }
 
+  /**
+   * Iterate search algorithm until the given time is reached.  At
+   * least one step is performed.  An unfinished search may be
+   * continued by calling this method again.
+   *
+   * @param deadline Stop searching after this time
+   *
+   * @return True if algorithm returns a terminal path or no path found
+   */
+  SolverResult DistanceGeneral(std::chrono::steady_clock::time_point deadline) noexcept {
+    SolverResult result;
+
+    do {
+      result = DistanceGeneral(0);
+    } while (result == SolverResult::INCOMPLETE &&
+             std::chrono::steady_clock::now() < deadline);
+
+    return result;
+  }
+
   /**
    * Search the chain for the ScanTaskPoint at the specified stage.
    */
@@ -0,0 +1,250 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef SCAN_TASK_POINT_MAP_HPP
+#define SCAN_TASK_POINT_MAP_HPP
+
+#include "ScanTaskPoint.hpp"
+#include "util/ThreadLocalPool.hpp"
+
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cassert>
+#include <cstdint>
+
+/**
+ * A MapTemplate for #Dijkstra with #ScanTaskPoint keys.  The key
+ * space is bounded (16 bit stage number and point index), and a
+ * search visits most points of each stage, so instead of a hash map,
+ * the values are stored in arrays indexed by stage number and point
+ * index.  Memory is allocated in blocks of consecutive point indices
+ * when they are first used, therefore the address of a value does
+ * not change until clear() is called.
+ *
+ * Temporary copies are made in each incremental contest run, so all
+ * memory comes from the #ThreadLocalPool.
+ */
+struct ScanTaskPointMap {
+  template<typename Value>
+  class Bind {
+  public:
+    struct value_type {
+      ScanTaskPoint first;
+      Value second;
+
+      constexpr value_type(ScanTaskPoint _first,
+                           const Value &_second) noexcept
+        :first(_first), second(_second) {}
+    };
+
+    static_assert(std::is_trivially_destructible_v<value_type>);
+
+  private:
+    static constexpr unsigned BLOCK_BITS = 6;
+    static constexpr unsigned BLOCK_SIZE = 1u << BLOCK_BITS;
+
+    struct Block {
+      /**
+       * Bit i is set if slot i contains a value.
+       */
+      uint_least64_t used = 0;
+
+      alignas(value_type) std::byte slots[BLOCK_SIZE * sizeof(value_type)];
+
+      value_type *GetSlot(unsigned i) noexcept {
+        return std::launder(reinterpret_cast<value_type *>(slots) + i);
+      }
+
+      static void *operator new(std::size_t size) {
+        return ThreadLocalPool::Allocate(size);
+      }
+
+      static void operator delete(void *p, std::size_t size) noexcept {
+        ThreadLocalPool::Deallocate(p, size);
+      }
+    };
+
+    static_assert(BLOCK_SIZE <= 64);
+
+    template<typename T>
+    using Vector = std::vector<T, ThreadLocalPoolAllocator<T>>;
+
+    /**
+     * The blocks of each stage, indexed by point index / BLOCK_SIZE.
+     * Blocks are kept by clear() to be reused.
+     */
+    Vector<Vector<std::unique_ptr<Block>>> stages;
+
+    /**
+     * All values in insertion order, for iteration.
+     */
+    Vector<value_type *> entries;
+
+  public:
+    class const_iterator {
+      typename Vector<value_type *>::const_iterator i;
+
+    public:
+      explicit const_iterator(typename Vector<value_type *>::const_iterator _i) noexcept
+        :i(_i) {}
+
+      const value_type &operator*() const noexcept {
+        return **i;
+      }
+
+      const value_type *operator->() const noexcept {
+        return *i;
+      }
+
+      const_iterator &operator++() noexcept {
+        ++i;
+        return *this;
+      }
+
+      bool operator==(const const_iterator &other) const noexcept {
+        return i == other.i;
+      }
+
+      bool operator!=(const const_iterator &other) const noexcept {
+        return i != other.i;
+      }
+    };
+
+    Bind() = default;
+
+    Bind(const Bind &other) noexcept {
+      *this = other;
+    }
+
+    Bind &operator=(const Bind &other) noexcept {
+      if (this != &other) {
+        clear();
+        for (const value_type *i : other.entries)
+          emplace(i->first, i->second);
+      }
+
+      return *this;
+    }
+
+    bool empty() const noexcept {
+      return entries.empty();
+    }
+
+    std::size_t size() const noexcept {
+      return entries.size();
+    }
+
+    const_iterator begin() const noexcept {
+      return const_iterator(entries.begin());
+    }
+
+    const_iterator end() const noexcept {
+      return const_iterator(entries.end());
+    }
+
+    void clear() noexcept {
+      for (const value_type *i : entries)
+        FindBlock(i->first)->used = 0;
+
+      entries.clear();
+    }
+
+    /**
+     * @return a pointer to the value, or nullptr if there is none
+     */
+    [[gnu::pure]]
+    value_type *find(ScanTaskPoint key) noexcept {
+      Block *block = FindBlock(key);
+      if (block == nullptr)
+        return nullptr;
+
+      const unsigned i = key.GetPointIndex() % BLOCK_SIZE;
+      if ((block->used & (uint_least64_t(1) << i)) == 0)
+        return nullptr;
+
+      return block->GetSlot(i);
+    }
+
+    [[gnu::pure]]
+    const value_type *find(ScanTaskPoint key) const noexcept {
+      return const_cast<Bind *>(this)->find(key);
+    }
+
+    /**
+     * Insert a value if there is none for the given key.
+     *
+     * @return a pointer to the value for the key and true if it was
+     * inserted
+     */
+    std::pair<value_type *, bool> emplace(ScanTaskPoint key,
+                                          const Value &value) noexcept {
+      Block &block = MakeBlock(key);
+
+      const unsigned i = key.GetPointIndex() % BLOCK_SIZE;
+      const uint_least64_t mask = uint_least64_t(1) << i;
+      if (block.used & mask)
+        return {block.GetSlot(i), false};
+
+      block.used |= mask;
+      value_type *p = new(block.GetSlot(i)) value_type(key, value);
+      entries.push_back(p);
+      return {p, true};
+    }
+
+  private:
+    [[gnu::pure]]
+    Block *FindBlock(ScanTaskPoint key) const noexcept {
+      const unsigned stage = key.GetStageNumber();
+      if (stage >= stages.size())
+        return nullptr;
+
+      const auto &blocks = stages[stage];
+      const unsigned b = key.GetPointIndex() / BLOCK_SIZE;
+      if (b >= blocks.size())
+        return nullptr;
+
+      return blocks[b].get();
+    }
+
+    Block &MakeBlock(ScanTaskPoint key) noexcept {
+      const unsigned stage = key.GetStageNumber();
+      if (stage >= stages.size())
+        stages.resize(stage + 1);
+
+      auto &blocks = stages[stage];
+      const unsigned b = key.GetPointIndex() / BLOCK_SIZE;
+      if (b >= blocks.size())
+        blocks.resize(b + 1);
+
+      if (!blocks[b])
+        blocks[b] = std::make_unique<Block>();
+
+      return *blocks[b];
+    }
+  };
+};
+
+#endif
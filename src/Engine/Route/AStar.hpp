@@ -26,7 +26,8 @@ Copyright_License {
 
 #include "util/ReservablePriorityQueue.hpp"
 
-#include <unordered_map>
+#include <algorithm>
+#include <vector>
 
 struct AStarPriorityValue
 {
@@ -74,25 +75,35 @@ template <class Node, class Hash=std::hash<Node>,
           bool m_min=true>
 class AStar
 {
-  typedef std::unordered_map<Node, AStarPriorityValue, Hash, KeyEqual> node_value_map;
+  /**
+   * The state of one node which has been reached.
+   */
+  struct Entry {
+    Node node;
 
-  typedef typename node_value_map::iterator node_value_iterator;
-  typedef typename node_value_map::const_iterator node_value_const_iterator;
+    /**
+     * The predecessor on the best path to this node; the start node
+     * is its own predecessor.
+     */
+    Node parent;
 
-  typedef std::unordered_map<Node, Node, Hash, KeyEqual> node_parent_map;
+    AStarPriorityValue value;
 
-  typedef typename node_parent_map::iterator node_parent_iterator;
-  typedef typename node_parent_map::const_iterator node_parent_const_iterator;
+    Entry(const Node &_node, const Node &_parent,
+          const AStarPriorityValue &_value) noexcept
+      :node(_node), parent(_parent), value(_value) {}
+  };
 
   struct NodeValue {
     AStarPriorityValue priority;
 
-    node_value_iterator iterator;
+    /** index into #entries */
+    unsigned index;
 
     constexpr
     NodeValue(const AStarPriorityValue &_priority,
-              node_value_iterator _iterator) noexcept
-      :priority(_priority), iterator(_iterator) {}
+              unsigned _index) noexcept
+      :priority(_priority), index(_index) {}
   };
 
   struct Rank {
@@ -102,24 +113,28 @@ class AStar
     }
   };
 
+  static constexpr unsigned EMPTY = ~0u;
+
   /**
-   * Stores the value of each node.  It is updated by push(), if a
-   * value lower than the current one is found.
+   * All nodes reached so far.  Entries are only appended, so their
+   * indices remain valid until Clear().  The vector keeps its
+   * capacity, so a new search does not allocate memory again.
    */
-  node_value_map node_values;
+  std::vector<Entry> entries;
 
   /**
-   * Stores the predecessor of each node.  It is maintained by
-   * set_predecessor().
+   * An open-addressing hash table (linear probing) which maps nodes
+   * to indices into #entries, or #EMPTY.  Its size is a power of two
+   * and grows when it becomes half full.
    */
-  node_parent_map node_parents;
+  std::vector<unsigned> table;
 
   /**
    * A sorted list of all possible node paths, lowest distance first.
    */
   reservable_priority_queue<NodeValue, std::vector<NodeValue>, Rank> q;
 
-  node_value_iterator cur;
+  unsigned cur = EMPTY;
 
 public:
   static constexpr unsigned DEFAULT_QUEUE_SIZE = 1024;
@@ -148,7 +163,7 @@ public:
   }
 
   /**
-   * Resets as if constructed afresh
+   * Resets AStar search algorithm
    *
    * @param n Node to start
    */
@@ -157,15 +172,14 @@ public:
     Push(node, node, AStarPriorityValue(0));
   }
 
-  /** Clears the queues */
+  /**
+   * Clears the queues.  The memory is kept for the next search.
+   */
   void Clear() noexcept {
-    // Clear the search queue
     q.clear();
-
-    // Clear the node_parent_map
-    node_parents.clear();
-    // Clear the node_value_map
-    node_values.clear();
+    entries.clear();
+    std::fill(table.begin(), table.end(), EMPTY);
+    cur = EMPTY;
   }
 
   /**
@@ -188,20 +202,29 @@ public:
     return q.size();
   }
 
+  /**
+   * The number of nodes which have been reached so far.
+   */
+  [[gnu::pure]]
+  unsigned GetNodeCount() const noexcept {
+    return entries.size();
+  }
+
   /**
    * Return top element of queue for processing
    *
    * @return Node for processing
    */
-  const Node &Pop() noexcept {
-    cur = q.top().iterator;
+  Node Pop() noexcept {
+    cur = q.top().index;
 
     do { // remove this item
       q.pop();
-    } while (!q.empty() && (q.top().priority > q.top().iterator->second));
+    } while (!q.empty() &&
+             (q.top().priority > entries[q.top().index].value));
     // and all lower rank than this
 
-    return cur->first;
+    return entries[cur].node;
   }
 
   /**
@@ -226,83 +249,107 @@ public:
    */
   [[gnu::pure]]
   Node GetPredecessor(const Node &node) const noexcept {
-    // Try to find the given node in the node_parent_map
-    node_parent_const_iterator it = node_parents.find(node);
-    if (it == node_parents.end())
-      // first entry
+    const unsigned i = Find(node);
+    if (i == EMPTY)
       // If the node wasn't found
       // -> Return the given node itself
       return node;
 
-    // If the node was found
-    // -> Return the parent node
-    return it->second;
+    return entries[i].parent;
   }
 
-  /** Reserve queue size (if available) */
+  /**
+   * Reserve space for this number of nodes (if available).  Call
+   * this before Restart(), because it may resize the hash table.
+   */
   void Reserve(unsigned size) noexcept {
     q.reserve(size);
+    entries.reserve(size);
+
+    if (table.size() < 2 * size)
+      Rehash(2 * size);
   }
 
-  /**
-   * Obtain the value of this node (accumulated distance to this node)
-   * Returns 0 on failure to find the node.
-   */
   [[gnu::pure]]
   AStarPriorityValue GetNodeValue(const Node &node) const noexcept {
-    node_value_const_iterator it = node_values.find(node);
-    if (cur->first == node)
-      return cur->second;
+    if (cur != EMPTY && KeyEqual()(entries[cur].node, node))
+      return entries[cur].value;
 
-    if (it == node_values.end())
+    const unsigned i = Find(node);
+    if (i == EMPTY)
       return AStarPriorityValue(0);
 
-    return it->second;
+    return entries[i].value;
   }
 
 private:
+  [[gnu::pure]]
+  unsigned Find(const Node &node) const noexcept {
+    if (table.empty())
+      return EMPTY;
+
+    const std::size_t mask = table.size() - 1;
+    for (std::size_t slot = Hash()(node) & mask;; slot = (slot + 1) & mask) {
+      const unsigned i = table[slot];
+      if (i == EMPTY || KeyEqual()(entries[i].node, node))
+        return i;
+    }
+  }
+
   /**
-   * Add node to search queue
-   *
-   * @param n Destination node to add
-   * @param pn Previous node
-   * @param e Edge distance (previous to this)
+   * Insert a new entry into the hash table.  The caller must make
+   * sure there is a free slot.
+   */
+  void Insert(unsigned i) noexcept {
+    const std::size_t mask = table.size() - 1;
+    std::size_t slot = Hash()(entries[i].node) & mask;
+    while (table[slot] != EMPTY)
+      slot = (slot + 1) & mask;
+    table[slot] = i;
+  }
+
+  /**
+   * Resize the hash table to at least the given number of slots
+   * (rounded up to a power of two), and re-insert all entries.
    */
+  void Rehash(std::size_t size) noexcept {
+    std::size_t n = 16;
+    while (n < size)
+      n *= 2;
+
+    table.assign(n, EMPTY);
+    for (unsigned i = 0; i < entries.size(); ++i)
+      Insert(i);
+  }
+
   void Push(const Node &node, const Node &parent,
             const AStarPriorityValue &edge_value) noexcept {
-    // Try to find the given node n in the node_value_map
-    node_value_iterator it = node_values.find(node);
-    if (it == node_values.end()) {
+    unsigned i = Find(node);
+    if (i == EMPTY) {
       // first entry
       // If the node wasn't found
-      // -> Insert a new node into the node_value_map
-      it = node_values.insert(std::make_pair(node, edge_value)).first;
-
-      // Remember the parent node
-      SetPredecessor(node, parent);
-    } else if (it->second > edge_value) {
+      // -> Insert a new node
+      i = entries.size();
+      entries.emplace_back(node, parent, edge_value);
+
+      if (2 * entries.size() > table.size())
+        Rehash(2 * table.size());
+      else
+        Insert(i);
+    } else if (entries[i].value > edge_value) {
       // If the node was found and the new value is smaller
       // -> Replace the value with the new one
-      it->second = edge_value;
+      entries[i].value = edge_value;
       // replace, it's bigger
 
       // Remember the new parent node
-      SetPredecessor(node, parent);
+      entries[i].parent = parent;
     } else
       // If the node was found but the value is higher or equal
       // -> Don't use this new leg
       return;
 
-    q.push(NodeValue(edge_value, it));
-  }
-
-  void SetPredecessor(const Node &node, const Node &parent) noexcept {
-    // Try to find the given node in the node_parent_map
-    auto result = node_parents.insert(std::make_pair(node, parent));
-    if (!result.second)
-      // If the node was found
-      // -> Replace the according parent node with the new one
-      result.first->second = parent;
+    q.push(NodeValue(edge_value, i));
   }
 };
 
@@ -60,6 +60,8 @@ struct RoutePlannerConfig
 
   void SetDefaults();
 
+  bool operator==(const RoutePlannerConfig &other) const noexcept = default;
+
   bool IsTerrainEnabled() const {
     return mode == Mode::TERRAIN || mode == Mode::BOTH;
   }
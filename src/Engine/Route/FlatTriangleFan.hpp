@@ -97,6 +97,10 @@ public:
   int GetHeight() const noexcept {
     return height;
   }
+
+  const FlatBoundingBox &GetBoundingBox() const noexcept {
+    return bounding_box;
+  }
 };
 
 #endif
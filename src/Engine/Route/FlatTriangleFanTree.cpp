@@ -24,8 +24,10 @@
 #include "RouteLink.hpp"
 #include "Terrain/RasterMap.hpp"
 #include "ReachFanParms.hpp"
-#include "util/GlobalSliceAllocator.hxx"
 #include "Geo/Flat/FlatProjection.hpp"
+#include "thread/ThreadPool.hpp"
+
+#include <vector>
 
 #define REACH_BUFFER 1
 #define REACH_SWEEP (ROUTEPOLAR_Q1-REACH_BUFFER)
@@ -65,17 +67,26 @@ FlatTriangleFanTree::CalcBB() noexcept
 
 void
 FlatTriangleFanTree::FillReach(const AFlatGeoPoint &origin,
-                               ReachFanParms &parms) noexcept
+                               ReachFanParms &parms,
+                               ThreadPool *thread_pool) noexcept
 {
   gaps_filled = false;
 
   FillReach(origin, 0, ROUTEPOLAR_POINTS, parms);
 
-  for (parms.set_depth = 0; parms.set_depth < REACH_MAX_DEPTH;
-      ++parms.set_depth)
-    if (!FillDepth(origin, parms))
-      // stop searching
-      break;
+  if (thread_pool != nullptr) {
+    /* the root's gaps yield the top-level children; below them, the
+       sectors are independent of each other */
+    parms.set_depth = 0;
+    if (FillDepth(origin, parms) && REACH_MAX_DEPTH > 1)
+      FillChildren(origin, parms, *thread_pool);
+  } else {
+    for (parms.set_depth = 0; parms.set_depth < REACH_MAX_DEPTH;
+         ++parms.set_depth)
+      if (!FillDepth(origin, parms))
+        // stop searching
+        break;
+  }
 
   // this boundingbox update visits the tree recursively
   CalcBB();
@@ -113,6 +124,47 @@ FlatTriangleFanTree::FillDepth(const AFlatGeoPoint &origin,
   return true;
 }
 
+void
+FlatTriangleFanTree::FillChildren(const AFlatGeoPoint &origin,
+                                  ReachFanParms &parms,
+                                  ThreadPool &thread_pool) noexcept
+{
+  const unsigned n = children.size();
+  if (n == 0 || parms.vertex_counter > REACH_MAX_VERTICES ||
+      parms.fan_counter > REACH_MAX_FANS)
+    return;
+
+  std::vector<FlatTriangleFanTree *> items;
+  items.reserve(n);
+  for (auto &child : children)
+    items.push_back(&child);
+
+  /* the limits are checked against the counters, so a job's share
+     of the budget is expressed by its initial counter values */
+  const unsigned vertex_share =
+    (REACH_MAX_VERTICES - parms.vertex_counter) / n;
+  const unsigned fan_share = (REACH_MAX_FANS - parms.fan_counter) / n;
+
+  std::vector<ReachFanParms> job_parms(n, parms);
+  for (auto &i : job_parms) {
+    i.vertex_counter = REACH_MAX_VERTICES - vertex_share;
+    i.fan_counter = REACH_MAX_FANS - fan_share;
+  }
+
+  thread_pool.ForEach(n, [&](unsigned i){
+    ReachFanParms &p = job_parms[i];
+    for (p.set_depth = 1; p.set_depth < REACH_MAX_DEPTH; ++p.set_depth)
+      if (!items[i]->FillDepth(origin, p))
+        break;
+  });
+
+  for (const auto &i : job_parms) {
+    parms.vertex_counter += i.vertex_counter -
+      (REACH_MAX_VERTICES - vertex_share);
+    parms.fan_counter += i.fan_counter - (REACH_MAX_FANS - fan_share);
+  }
+}
+
 bool
 FlatTriangleFanTree::FillReach(const AFlatGeoPoint &origin, const int index_low,
                                const int index_high,
@@ -179,17 +231,31 @@ FlatTriangleFanTree::UpdateTerrainBase(const FlatGeoPoint o,
     return;
   }
 
-  for (const auto &x : vs) {
-    const FlatGeoPoint av = (o + x) * 0.5;
-    const GeoPoint p = parms.projection.Unproject(av);
-    const auto h = parms.terrain->GetHeight(p);
-
-    if (h.IsWater())
-      /* water: assume 0m MSL */
-      parms.terrain_counter++;
-    else if (!h.IsInvalid()) {
-      parms.terrain_counter++;
-      parms.terrain_base += h.GetValue();
+  /* query the terrain in chunks, which is cheaper than looking up
+     each point separately */
+  constexpr std::size_t CHUNK_SIZE = 32;
+  GeoPoint points[CHUNK_SIZE];
+  TerrainHeight heights[CHUNK_SIZE];
+
+  for (auto x = vs.cbegin(), end = vs.cend(); x != end;) {
+    std::size_t n = 0;
+    for (; n < CHUNK_SIZE && x != end; ++n, ++x) {
+      const FlatGeoPoint av = (o + *x) * 0.5;
+      points[n] = parms.projection.Unproject(av);
+    }
+
+    parms.terrain->GetHeights({points, n}, heights);
+
+    for (std::size_t i = 0; i < n; ++i) {
+      const auto h = heights[i];
+
+      if (h.IsWater())
+        /* water: assume 0m MSL */
+        parms.terrain_counter++;
+      else if (!h.IsInvalid()) {
+        parms.terrain_counter++;
+        parms.terrain_base += h.GetValue();
+      }
     }
   }
 
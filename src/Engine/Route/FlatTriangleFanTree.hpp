@@ -24,7 +24,6 @@
 #define FLAT_TRIANGLE_FAN_TREE_HPP
 
 #include "Geo/Flat/FlatBoundingBox.hpp"
-#include "util/SliceAllocator.hxx"
 #include "FlatTriangleFan.hpp"
 
 #include <list>
@@ -34,6 +33,7 @@ struct GeoPoint;
 struct RouteLink;
 struct AFlatGeoPoint;
 struct ReachFanParms;
+class ThreadPool;
 template<typename T> struct ConstBuffer;
 
 class FlatTriangleFanVisitor {
@@ -48,8 +48,9 @@ public:
   static constexpr unsigned REACH_MAX_FANS = 300;
 
 private:
-  typedef std::list<FlatTriangleFanTree,
-                    GlobalSliceAllocator<FlatTriangleFanTree, 128u> > LeafVector;
+  /* not using GlobalSliceAllocator here, because sub-trees may be
+     filled concurrently, see FillChildren() */
+  typedef std::list<FlatTriangleFanTree> LeafVector;
 
   FlatBoundingBox bb_children;
   LeafVector children;
@@ -78,7 +79,24 @@ public:
     return FlatTriangleFan::IsInside(p, IsRoot());
   }
 
-  void FillReach(const AFlatGeoPoint &origin, ReachFanParms &parms) noexcept;
+  /**
+   * @param thread_pool if not nullptr, then the sub-trees of the
+   * top-level children are expanded concurrently in this pool
+   */
+  void FillReach(const AFlatGeoPoint &origin, ReachFanParms &parms,
+                 ThreadPool *thread_pool=nullptr) noexcept;
+
+  /**
+   * Invoke f(fan, parent) on this fan and all of its descendants in
+   * pre-order.  The value returned by f() for a fan is passed as
+   * "parent" to the calls for its children.
+   */
+  template<typename F>
+  void VisitPreOrder(F &f, int parent=-1) const {
+    const int i = f(*this, parent);
+    for (const auto &child : children)
+      child.VisitPreOrder(f, i);
+  }
   void DummyReach(const AFlatGeoPoint &origin) noexcept;
 
   /**
@@ -100,6 +118,15 @@ public:
                  const ReachFanParms &parms) noexcept;
 
   bool FillDepth(const AFlatGeoPoint &origin, ReachFanParms &parms) noexcept;
+
+  /**
+   * Expand the sub-trees of all children below the first level, one
+   * job per child.  Each job gets an equal share of the remaining
+   * vertex and fan budget, so the result does not depend on the
+   * number of threads.
+   */
+  void FillChildren(const AFlatGeoPoint &origin, ReachFanParms &parms,
+                    ThreadPool &thread_pool) noexcept;
   void FillGaps(const AFlatGeoPoint &origin, ReachFanParms &parms) noexcept;
 
   bool CheckGap(const AFlatGeoPoint &n, const RouteLink &e_1,
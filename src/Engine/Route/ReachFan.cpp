@@ -27,17 +27,62 @@
 
 static constexpr int MIN_FLOOR_CLEARANCE = 100;
 
+/**
+ * Reuse a solution only while the aircraft stays this close to its
+ * origin (m).
+ */
+static constexpr double MAX_REUSE_DISTANCE = 1000;
+
+/**
+ * Reuse a solution only while the aircraft has not gained more than
+ * this altitude (m) relative to its origin.
+ */
+static constexpr int MAX_REUSE_GAIN = 30;
+
+/**
+ * Do a full solve after this number of reused solutions, to pick up
+ * terrain tiles which have been loaded meanwhile.
+ */
+static constexpr unsigned MAX_REUSE_COUNT = 6;
+
 void
 ReachFan::Reset() noexcept
 {
   root.Clear();
+  grid.Clear();
   terrain_base = 0;
+  solved_terrain = nullptr;
+  reuse_count = 0;
+}
+
+bool
+ReachFan::CanReuse(const AGeoPoint &origin, const RoutePolars &rpolars,
+                   const RasterMap *terrain) const noexcept
+{
+  if (root.IsEmpty() || root.IsDummy() || terrain != solved_terrain ||
+      reuse_count >= MAX_REUSE_COUNT ||
+      !rpolars.IsReachEquivalent(solved_polars))
+    return false;
+
+  if (origin.Distance(projection.GetCenter()) > MAX_REUSE_DISTANCE)
+    return false;
+
+  const AFlatGeoPoint ao(projection.ProjectInteger(origin), origin.altitude);
+  const int arrival = rpolars.CalcGlideArrival(ao, root.GetOrigin(),
+                                               projection);
+  return arrival >= root.GetHeight() &&
+    arrival <= root.GetHeight() + MAX_REUSE_GAIN;
 }
 
 bool
 ReachFan::Solve(const AGeoPoint origin, const RoutePolars &rpolars,
                 const RasterMap* terrain, const bool do_solve) noexcept
 {
+  if (do_solve && CanReuse(origin, rpolars, terrain)) {
+    ++reuse_count;
+    return true;
+  }
+
   Reset();
 
   // initialise projection
@@ -61,9 +106,12 @@ ReachFan::Solve(const AGeoPoint origin, const RoutePolars &rpolars,
     return false;
   }
 
-  if (do_solve)
-    root.FillReach(ao, parms);
-  else
+  if (do_solve) {
+    root.FillReach(ao, parms, thread_pool);
+    grid.Build(root);
+    solved_polars = rpolars;
+    solved_terrain = terrain;
+  } else
     root.DummyReach(ao);
 
   if (!h.IsInvalid()) {
@@ -110,7 +158,14 @@ ReachFan::FindPositiveArrival(const AGeoPoint dest,
 
   // now calculate turning solution
   result_r.terrain = dest.altitude - 1;
-  result_r.terrain_valid = root.FindPositiveArrival(d, parms, result_r.terrain)
+
+  std::optional<bool> found;
+  if (!grid.IsEmpty())
+    found = grid.FindPositiveArrival(d, parms, result_r.terrain);
+  if (!found)
+    found = root.FindPositiveArrival(d, parms, result_r.terrain);
+
+  result_r.terrain_valid = *found
     ? ReachResult::Validity::VALID
     : ReachResult::Validity::UNREACHABLE;
 
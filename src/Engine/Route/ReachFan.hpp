@@ -25,11 +25,13 @@
 
 #include "Geo/Flat/FlatProjection.hpp"
 #include "FlatTriangleFanTree.hpp"
+#include "RoutePolars.hpp"
+#include "ReachGrid.hpp"
 
 #include <optional>
 
-class RoutePolars;
 class RasterMap;
+class ThreadPool;
 class GeoBounds;
 struct ReachResult;
 
@@ -39,6 +41,26 @@ class ReachFan
   FlatTriangleFanTree root;
   int terrain_base = 0;
 
+  /**
+   * Speeds up FindPositiveArrival(); built after each full solve.
+   */
+  ReachGrid grid;
+
+  /**
+   * The performance model and terrain used for the last full
+   * solution; needed to decide whether it may be reused.
+   */
+  RoutePolars solved_polars;
+  const RasterMap *solved_terrain = nullptr;
+
+  /**
+   * The number of consecutive Solve() calls which have reused the
+   * last full solution.
+   */
+  unsigned reuse_count = 0;
+
+  ThreadPool *thread_pool = nullptr;
+
 public:
   friend class PrintHelper;
 
@@ -52,6 +74,20 @@ public:
 
   void Reset() noexcept;
 
+  /**
+   * Expand the fan's sectors concurrently in the given #ThreadPool.
+   * Pass nullptr to expand them in the calling thread.  The pool
+   * must remain valid until it is replaced.
+   */
+  void SetThreadPool(ThreadPool *_thread_pool) noexcept {
+    thread_pool = _thread_pool;
+  }
+
+  /**
+   * Calculate the reach fan from the specified origin.  If the
+   * previous solution is still a safe (i.e. pessimistic) answer for
+   * the new origin, it is kept and no terrain is scanned.
+   */
   bool Solve(const AGeoPoint origin, const RoutePolars &rpolars,
              const RasterMap *terrain, const bool do_solve = true) noexcept;
 
@@ -65,6 +101,19 @@ public:
   int GetTerrainBase() const noexcept {
     return terrain_base;
   }
+
+private:
+  /**
+   * May the current (full) solution be used for the new origin?
+   * This is the case if the aircraft can glide from the new origin
+   * back to the old one and arrive there at least as high as the
+   * solution was calculated for: everything in the fan is then
+   * reachable via the old origin.  The gain in altitude is limited,
+   * so the solution does not become too pessimistic.
+   */
+  [[gnu::pure]]
+  bool CanReuse(const AGeoPoint &origin, const RoutePolars &rpolars,
+                const RasterMap *terrain) const noexcept;
 };
 
 #endif
@@ -0,0 +1,144 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+#include "ReachGrid.hpp"
+#include "FlatTriangleFanTree.hpp"
+#include "ReachFanParms.hpp"
+#include "util/ThreadLocalPool.hpp"
+
+#include <algorithm>
+
+#include <cassert>
+
+void
+ReachGrid::Build(const FlatTriangleFanTree &root) noexcept
+{
+  Clear();
+
+  struct Fan {
+    const FlatTriangleFanTree *fan;
+    int parent;
+  };
+
+  /* flatten the tree, keeping the pre-order of
+     FlatTriangleFanTree::FindPositiveArrival() */
+  std::vector<Fan, ThreadLocalPoolAllocator<Fan>> fans;
+  auto collect = [&fans](const FlatTriangleFanTree &fan, int parent){
+    fans.push_back({&fan, parent});
+    return int(fans.size() - 1);
+  };
+  root.VisitPreOrder(collect);
+
+  bounds = root.GetBoundingBox();
+  for (const auto &i : fans)
+    bounds.Merge(i.fan->GetBoundingBox());
+
+  cell_width = (bounds.GetRight() - bounds.GetLeft()) / SIZE + 1;
+  cell_height = (bounds.GetTop() - bounds.GetBottom()) / SIZE + 1;
+
+  offsets.reserve(SIZE * SIZE + 1);
+
+  /* index of each fan within the current cell's candidates, or -1 */
+  std::vector<int, ThreadLocalPoolAllocator<int>> local(fans.size());
+
+  for (unsigned y = 0; y < SIZE; ++y) {
+    for (unsigned x = 0; x < SIZE; ++x) {
+      const FlatGeoPoint ll(bounds.GetLeft() + x * cell_width,
+                            bounds.GetBottom() + y * cell_height);
+      const FlatBoundingBox cell(ll, FlatGeoPoint(ll.x + cell_width - 1,
+                                                  ll.y + cell_height - 1));
+
+      const unsigned begin = candidates.size();
+      offsets.push_back(begin);
+
+      for (unsigned i = 0; i < fans.size(); ++i) {
+        if (!fans[i].fan->GetBoundingBox().Overlaps(cell)) {
+          local[i] = -1;
+          continue;
+        }
+
+        int parent = fans[i].parent;
+        while (parent >= 0 && local[parent] < 0)
+          parent = fans[parent].parent;
+
+        local[i] = candidates.size() - begin;
+        candidates.push_back({fans[i].fan,
+                              parent >= 0 ? local[parent] : -1});
+      }
+    }
+  }
+
+  offsets.push_back(candidates.size());
+}
+
+std::optional<bool>
+ReachGrid::FindPositiveArrival(const FlatGeoPoint n,
+                               const ReachFanParms &parms,
+                               int &arrival_height) const noexcept
+{
+  assert(!IsEmpty());
+
+  if (!bounds.IsInside(n))
+    return false;
+
+  const unsigned x = std::min((n.x - bounds.GetLeft()) / cell_width,
+                              SIZE - 1);
+  const unsigned y = std::min((n.y - bounds.GetBottom()) / cell_height,
+                              SIZE - 1);
+  const unsigned i = y * SIZE + x;
+
+  const auto begin = candidates.begin() + offsets[i];
+  const unsigned n_candidates = offsets[i + 1] - offsets[i];
+  if (n_candidates > MAX_CANDIDATES)
+    return std::nullopt;
+
+  /* is the candidate (or one of its ancestors) done, i.e. it
+     contains the point or cannot improve the result?  Its
+     descendants need not be checked then */
+  bool done[MAX_CANDIDATES];
+
+  bool found = false;
+  for (unsigned k = 0; k < n_candidates; ++k) {
+    const Candidate &c = begin[k];
+
+    if ((c.parent >= 0 && done[c.parent]) ||
+        c.fan->GetHeight() < arrival_height) {
+      done[k] = true;
+      continue;
+    }
+
+    done[k] = c.fan->IsInside(n);
+    if (!done[k])
+      continue;
+
+    const int h = parms.rpolars.CalcGlideArrival(c.fan->GetOrigin(), n,
+                                                 parms.projection);
+    if (h > arrival_height) {
+      arrival_height = h;
+      found = true;
+    }
+  }
+
+  return found;
+}
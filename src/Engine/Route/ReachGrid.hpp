@@ -0,0 +1,100 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+#ifndef REACH_GRID_HPP
+#define REACH_GRID_HPP
+
+#include "Geo/Flat/FlatBoundingBox.hpp"
+
+#include <optional>
+#include <vector>
+
+class FlatTriangleFanTree;
+struct ReachFanParms;
+
+/**
+ * A low-resolution raster of a reach fan's footprint.  Each cell
+ * lists the fans whose bounding box overlaps it, so a point lookup
+ * only needs to test those, instead of walking the whole tree.  The
+ * results are the same as FlatTriangleFanTree::FindPositiveArrival().
+ *
+ * The grid refers to the fans of the tree it was built from; it must
+ * be rebuilt or cleared whenever that tree changes.
+ */
+class ReachGrid {
+  /** the number of cells in each direction */
+  static constexpr unsigned SIZE = 32;
+
+  /**
+   * Cells with more candidates than this are looked up in the tree.
+   */
+  static constexpr unsigned MAX_CANDIDATES = 256;
+
+  struct Candidate {
+    const FlatTriangleFanTree *fan;
+
+    /**
+     * The index (within the same cell) of the nearest ancestor which
+     * is a candidate of this cell, or -1.  Ancestors which are not
+     * candidates cannot contain any point of this cell.
+     */
+    int parent;
+  };
+
+  FlatBoundingBox bounds;
+  unsigned cell_width, cell_height;
+
+  /**
+   * The candidates of cell i are candidates[offsets[i]] to
+   * candidates[offsets[i + 1]].  Empty if the grid has not been
+   * built.
+   */
+  std::vector<unsigned> offsets;
+  std::vector<Candidate> candidates;
+
+public:
+  bool IsEmpty() const noexcept {
+    return offsets.empty();
+  }
+
+  void Clear() noexcept {
+    offsets.clear();
+    candidates.clear();
+  }
+
+  void Build(const FlatTriangleFanTree &root) noexcept;
+
+  /**
+   * Look up the best arrival height at the given point, see
+   * FlatTriangleFanTree::FindPositiveArrival().
+   *
+   * @return a positive arrival height was found, or nullopt if the
+   * cell is too crowded and the tree needs to be searched instead
+   */
+  std::optional<bool> FindPositiveArrival(FlatGeoPoint n,
+                                          const ReachFanParms &parms,
+                                          int &arrival_height) const noexcept;
+};
+
+#endif
@@ -24,24 +24,94 @@
 #include "RoutePolar.hpp"
 #include "Geo/Flat/FlatProjection.hpp"
 
+#include <array>
 #include <cassert>
+#include <cmath>
+#include <limits>
 #include <stdlib.h>
 
+/**
+ * A "pseudo angle" of the vector in the range [0,4), counter-clockwise
+ * from the x axis.  It is not linear, but monotonic in the real
+ * angle, and it needs just one division.
+ */
 [[gnu::const]]
-static unsigned
-AngleToIndex(Angle a) noexcept
+static double
+DiamondAngle(double x, double y) noexcept
 {
-  auto i = ROUTEPOLAR_POINTS * (1.25
-                                - a.AsBearing() / Angle::FullCircle());
-  assert(i > 0);
-  return uround(i) % ROUTEPOLAR_POINTS;
+  if (y >= 0)
+    return x >= 0 ? y / (x + y) : 1 - x / (y - x);
+  else
+    return x < 0 ? 2 - y / (-x - y) : 3 + x / (x - y);
 }
 
-[[gnu::const]]
+/**
+ * Lookup table for XYToIndex().  It divides the pseudo angle range
+ * into buckets which are narrow enough to contain at most one
+ * boundary between two #RoutePolar directions.
+ */
+class DirectionTable {
+  static constexpr unsigned N_BUCKETS = 256;
+  static constexpr double BUCKET_WIDTH = 4. / N_BUCKETS;
+
+  struct Bucket {
+    /** The direction index at the start of the bucket */
+    unsigned index;
+
+    /** The pseudo angle where the next index begins */
+    double edge;
+  };
+
+  std::array<Bucket, N_BUCKETS> buckets;
+
+public:
+  DirectionTable() noexcept {
+    /* direction i covers the angles around i*360/ROUTEPOLAR_POINTS
+       degrees; calculate the pseudo angle of each boundary */
+    std::array<double, ROUTEPOLAR_POINTS> edges;
+    for (unsigned i = 0; i < ROUTEPOLAR_POINTS; ++i) {
+      const Angle a = Angle::FullCircle() * ((i + 0.5) / ROUTEPOLAR_POINTS);
+      const auto sc = a.SinCos();
+      edges[i] = DiamondAngle(sc.second, sc.first);
+    }
+
+    unsigned index = 0;
+    for (unsigned b = 0; b < N_BUCKETS; ++b) {
+      const double start = b * BUCKET_WIDTH;
+      while (index < ROUTEPOLAR_POINTS && edges[index] <= start)
+        ++index;
+
+      buckets[b].index = index;
+      buckets[b].edge = index < ROUTEPOLAR_POINTS &&
+        edges[index] < start + BUCKET_WIDTH
+        ? edges[index]
+        : std::numeric_limits<double>::infinity();
+    }
+  }
+
+  [[gnu::pure]]
+  unsigned Lookup(double x, double y) const noexcept {
+    const double d = DiamondAngle(x, y);
+    const Bucket &bucket =
+      buckets[std::min(unsigned(d * (1. / BUCKET_WIDTH)), N_BUCKETS - 1)];
+    const unsigned index = bucket.index + (d >= bucket.edge);
+    assert(index <= ROUTEPOLAR_POINTS);
+    return index % ROUTEPOLAR_POINTS;
+  }
+};
+
+static const DirectionTable direction_table;
+
+/**
+ * Returns the #RoutePolar direction index of the given vector.  This
+ * is called for each link, therefore it uses a lookup table instead
+ * of atan2().
+ */
+[[gnu::pure]]
 static unsigned
 XYToIndex(double x, double y) noexcept
 {
-  return AngleToIndex(Angle::FromXY(y, x));
+  return direction_table.Lookup(x, y);
 }
 
 RouteLink::RouteLink(const RouteLinkBase& _link,
@@ -72,7 +142,7 @@ RouteLink::CalcSpeedups(const FlatProjection &proj) noexcept
   }
 
   polar_index = XYToIndex(dx, dy);
-  d = hypot(dx, dy) * scale;
+  d = std::sqrt(double(dx) * dx + double(dy) * dy) * scale;
   inv_d = 1. / d;
 }
 
@@ -49,6 +49,8 @@ RoutePlanner::Reset() noexcept
   h_min = -1;
   h_max = 0;
   search_hull.clear();
+  polar_state.reset();
+  count_polar_rebuilds = 0;
   ClearReach();
 }
 
@@ -130,11 +132,16 @@ RoutePlanner::Solve(const AGeoPoint &origin, const AGeoPoint &destination,
   count_supressed = 0;
 
   bool retval = false;
+  planner.Reserve(WEIGHTED_SEARCH_NODES);
   planner.Restart(start);
 
   unsigned best_d = UINT_MAX;
 
   while (!planner.IsEmpty()) {
+    if (planner.GetNodeCount() > MAX_SEARCH_NODES)
+      /* give up */
+      break;
+
     const RoutePoint node = planner.Pop();
 
     h_min = std::min(h_min, node.altitude);
@@ -269,11 +276,14 @@ RoutePlanner::LinkCleared(const RouteLink &e) noexcept
   if (!rpolars_route.IsAchievable(e_rem))
     return false;
 
-  const unsigned h = rpolars_route.CalcTime(e_rem);
+  unsigned h = rpolars_route.CalcTime(e_rem);
   if (h == UINT_MAX)
     // not achievable
     return false;
 
+  if (!is_final && planner.GetNodeCount() > WEIGHTED_SEARCH_NODES)
+    h += h / 2;
+
   assert(!(e.first==e.second));
 
   count_dij++;
@@ -281,7 +291,6 @@ RoutePlanner::LinkCleared(const RouteLink &e) noexcept
                        (is_final ? 0 : RoutePolars::RoundTime(h)));
   // add one to tie-break towards lower number of links
 
-  planner.Reserve(planner.DEFAULT_QUEUE_SIZE);
   planner.Link(e.second, e.first, v);
   return true;
 }
@@ -382,6 +391,18 @@ RoutePlanner::UpdatePolar(const GlideSettings &settings,
                           const SpeedVector &wind,
                           const int height_min_working) noexcept
 {
+  const PolarState state{
+    settings, config, task_polar, safety_polar, wind, height_min_working,
+    reach_polar_mode,
+  };
+
+  if (polar_state && *polar_state == state)
+    /* nothing has changed, the tables are still valid */
+    return;
+
+  polar_state = state;
+  ++count_polar_rebuilds;
+
   rpolars_route.SetConfig(config);
   rpolars_route.Initialise(settings, task_polar, wind);
   switch (reach_polar_mode) {
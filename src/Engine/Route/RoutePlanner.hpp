@@ -30,14 +30,19 @@
 #include "Geo/Flat/FlatProjection.hpp"
 #include "Geo/SearchPointVector.hpp"
 #include "ReachFan.hpp"
-
+#include "GlideSolvers/GlidePolar.hpp"
+#include "GlideSolvers/GlideSettings.hpp"
+#include "Geo/SpeedVector.hpp"
+#include "util/ThreadLocalPool.hpp"
+
+#include <deque>
+#include <optional>
+#include <queue>
 #include <utility>
 #include <unordered_set>
 
 #include <limits.h>
 
-class GlidePolar;
-
 /**
  * RoutePlanner is an abstract class for planning paths (routes) through
  * an arbitrary environment, avoiding obstacles of different types.
@@ -117,6 +122,21 @@ protected:
   /** Maxmimum height scanned during solution (m) */
   int h_max;
 
+public:
+  /**
+   * After this number of nodes, the A* heuristic is weighted, which
+   * makes the search greedier: it finds a route (at most 50% slower
+   * than the optimum) much sooner in complex airspace.
+   */
+  static constexpr unsigned WEIGHTED_SEARCH_NODES = 1024;
+
+  /**
+   * Give up after this number of nodes; the route reverts to direct
+   * flight.  This limits the memory and time used by one Solve()
+   * call.
+   */
+  static constexpr unsigned MAX_SEARCH_NODES = 8192;
+
 private:
   /** A* search algorithm */
   AStar<RoutePoint, RoutePointHasher> planner{0};
@@ -127,11 +147,17 @@ private:
    */
   SearchPointVector search_hull;
 
-  typedef std::unordered_set<RouteLinkBase, RouteLinkBaseHasher> RouteLinkSet;
+  /* the links are cleared and rebuilt by each solve() call, so
+     their nodes are allocated from the ThreadLocalPool */
+  typedef std::unordered_set<RouteLinkBase, RouteLinkBaseHasher,
+                             std::equal_to<RouteLinkBase>,
+                             ThreadLocalPoolAllocator<RouteLinkBase>> RouteLinkSet;
 
   /** Links that have been visited during solution */
   RouteLinkSet unique_links{50000};
-  typedef std::queue< RouteLink> RouteLinkQueue;
+  typedef std::queue<RouteLink,
+                     std::deque<RouteLink,
+                                ThreadLocalPoolAllocator<RouteLink>>> RouteLinkQueue;
   /** Link candidates to be processed for intersection tests */
   RouteLinkQueue links;
 
@@ -148,6 +174,27 @@ private:
 
   RoutePlannerConfig::Polar reach_polar_mode = RoutePlannerConfig::Polar::TASK;
 
+  /**
+   * The UpdatePolar() parameters the #RoutePolar tables were last
+   * built from.  Building them takes hundreds of MacCready solutions,
+   * so this is used to skip it while nothing has changed.
+   */
+  struct PolarState {
+    GlideSettings settings;
+    RoutePlannerConfig config;
+    GlidePolar task_polar, safety_polar;
+    SpeedVector wind;
+    int height_min_working;
+    RoutePlannerConfig::Polar reach_polar_mode;
+
+    bool operator==(const PolarState &) const noexcept = default;
+  };
+
+  std::optional<PolarState> polar_state;
+
+  /** Number of #RoutePolar table rebuilds since Reset() */
+  unsigned long count_polar_rebuilds;
+
   mutable unsigned long count_dij;
   mutable unsigned long count_unique;
   mutable unsigned long count_supressed;
@@ -184,6 +231,15 @@ public:
    */
   void ClearReach() noexcept;
 
+  /**
+   * Expand the reach fans concurrently in the given #ThreadPool, see
+   * ReachFan::SetThreadPool().
+   */
+  void SetThreadPool(ThreadPool *thread_pool) noexcept {
+    reach_terrain.SetThreadPool(thread_pool);
+    reach_working.SetThreadPool(thread_pool);
+  }
+
   /**
    * Find the optimal path.  Works in reverse time order, from the
    * origin (where you want to fly to) back to the destination (where you
@@ -253,6 +309,14 @@ public:
                    const SpeedVector &wind,
                    const int height_min_working=0) noexcept;
 
+  /**
+   * Returns the number of times UpdatePolar() had to rebuild the
+   * performance tables since Reset().
+   */
+  unsigned long GetPolarRebuildCount() const noexcept {
+    return count_polar_rebuilds;
+  }
+
   /** Reset the optimiser as if never flown and clear temporary buffers. */
   virtual void Reset() noexcept;
 
@@ -27,6 +27,8 @@
 #include "Geo/Flat/FlatGeoPoint.hpp"
 #include "util/Macros.hpp"
 
+#include <algorithm>
+
 GlideResult
 RoutePolar::SolveTask(const GlideSettings &settings,
                       const GlidePolar& glide_polar,
@@ -58,6 +60,12 @@ RoutePolar::Initialise(const GlideSettings &settings, const GlidePolar& polar,
   }
 }
 
+bool
+RoutePolar::operator==(const RoutePolar &other) const noexcept
+{
+  return std::equal(points, points + ROUTEPOLAR_POINTS, other.points);
+}
+
 static constexpr FlatGeoPoint index_to_point[] = {
   {128, 0},
   {126, 16},
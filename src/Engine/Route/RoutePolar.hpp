@@ -60,6 +60,13 @@ class RoutePolar
 
     RoutePolarPoint() = default;
 
+    [[gnu::pure]]
+    bool operator==(const RoutePolarPoint &other) const noexcept {
+      return valid == other.valid &&
+        (!valid || (slowness == other.slowness &&
+                    gradient == other.gradient));
+    }
+
     RoutePolarPoint(double _slowness, double _gradient)
       :slowness(_slowness), gradient(_gradient), valid(true)
     {
@@ -96,6 +103,9 @@ public:
     return points[index];
   }
 
+  [[gnu::pure]]
+  bool operator==(const RoutePolar &other) const noexcept;
+
   /**
    * Calculate distances normalised to 128 corresponding to direction index
    *
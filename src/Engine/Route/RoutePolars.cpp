@@ -208,6 +208,16 @@ RoutePolars::SetConfig(const RoutePlannerConfig& _config,
     climb_ceiling = INT_MAX;
 }
 
+bool
+RoutePolars::IsReachEquivalent(const RoutePolars &other) const noexcept
+{
+  /* reach is calculated for pure glide only, climb parameters don't
+     matter */
+  return config == other.config &&
+    height_min_working == other.height_min_working &&
+    polar_glide == other.polar_glide;
+}
+
 bool
 RoutePolars::CanClimb() const noexcept
 {
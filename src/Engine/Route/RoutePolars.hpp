@@ -186,6 +186,13 @@ public:
                  int _cruise_alt = INT_MAX,
                  int _ceiling_alt = INT_MAX) noexcept;
 
+  /**
+   * Would a reach fan solved with the other performance model be
+   * identical to one solved with this one, apart from the origin?
+   */
+  [[gnu::pure]]
+  bool IsReachEquivalent(const RoutePolars &other) const noexcept;
+
   /**
    * Check whether the configuration requires intersection tests with airspace.
    *
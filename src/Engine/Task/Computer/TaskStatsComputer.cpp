@@ -29,7 +29,7 @@ TaskStatsComputer::Reset(TaskStats &data)
   total.Reset(data.total);
   current_leg.Reset(data.current_leg);
 
-  data.last_hour.Reset();
+  data.ResetWindows();
   window.Reset();
 
   inst_speed_slow.Design(180, false);
@@ -41,5 +41,5 @@ TaskStatsComputer::Reset(TaskStats &data)
 void
 TaskStatsComputer::ComputeWindow(TimeStamp time, TaskStats &data) noexcept
 {
-  window.Compute(time, data, data.last_hour);
+  window.Compute(time, data);
 }
@@ -24,8 +24,22 @@
 #include "Task/Stats/TaskStats.hpp"
 
 void
-WindowStatsComputer::Compute(TimeStamp time, const TaskStats &task_stats,
-                             WindowStats &stats) noexcept
+WindowStatsComputer::ComputeWindow(std::chrono::seconds width,
+                                   WindowStats &stats) const noexcept
+{
+  const auto delta = travelled_distance.GetDelta(width.count());
+  if (delta.x <= 0) {
+    stats.Reset();
+    return;
+  }
+
+  stats.duration = delta.x;
+  stats.distance = delta.y;
+  stats.speed = stats.distance / stats.duration;
+}
+
+void
+WindowStatsComputer::Compute(TimeStamp time, TaskStats &task_stats) noexcept
 {
   if (!time.IsDefined())
     return;
@@ -33,30 +47,28 @@ WindowStatsComputer::Compute(TimeStamp time, const TaskStats &task_stats,
   if (!task_stats.task_valid || !task_stats.start.task_started ||
       !task_stats.total.travelled.IsDefined()) {
     Reset();
-    stats.Reset();
+    task_stats.ResetWindows();
     return;
   }
 
   if (task_stats.task_finished)
     return;
 
-  const auto dt = minute_clock.Update(time, std::chrono::seconds{59},
-                                      std::chrono::minutes{3});
+  const auto dt = clock.Update(time, std::chrono::seconds{1},
+                               std::chrono::minutes{3});
   if (dt.count() < 0) {
     Reset();
-    stats.Reset();
+    task_stats.ResetWindows();
     return;
   }
 
-  if (dt.count() <= 0)
+  if (dt.count() <= 0 && !travelled_distance.IsEmpty())
     return;
 
   travelled_distance.Push(time.ToDuration().count(),
                           task_stats.total.travelled.GetDistance());
 
-  stats.duration = travelled_distance.GetDeltaXChecked();
-  if (stats.duration > 0) {
-    stats.distance = travelled_distance.GetDeltaY();
-    stats.speed = stats.distance / stats.duration;
-  }
+  ComputeWindow(std::chrono::minutes{10}, task_stats.last_10min);
+  ComputeWindow(std::chrono::minutes{30}, task_stats.last_30min);
+  ComputeWindow(std::chrono::hours{1}, task_stats.last_hour);
 }
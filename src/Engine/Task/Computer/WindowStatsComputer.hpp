@@ -23,25 +23,36 @@
 #ifndef XCSOAR_WINDOW_STATS_COMPUTER_HPP
 #define XCSOAR_WINDOW_STATS_COMPUTER_HPP
 
-#include "Math/DifferentialWindowFilter.hpp"
+#include "Math/SampledWindowFilter.hpp"
 #include "time/DeltaTime.hpp"
 
 struct WindowStats;
 class TaskStats;
 
+/**
+ * Calculates the task speed over the last 10 minutes, 30 minutes and
+ * hour.  The travelled distance is sampled every 10 seconds, which
+ * makes each update O(1) regardless of the window width.
+ */
 class WindowStatsComputer {
-  DifferentialWindowFilter<60> travelled_distance;
+  static constexpr double PERIOD = 10;
+
+  /* one hour plus one sample */
+  SampledWindowFilter<361> travelled_distance{PERIOD};
 
-  DeltaTime minute_clock;
+  DeltaTime clock;
 
 public:
   void Reset() {
     travelled_distance.Clear();
-    minute_clock.Reset();
+    clock.Reset();
   }
 
-  void Compute(TimeStamp time, const TaskStats &task_stats,
-               WindowStats &stats) noexcept;
+  void Compute(TimeStamp time, TaskStats &task_stats) noexcept;
+
+private:
+  void ComputeWindow(std::chrono::seconds width,
+                     WindowStats &stats) const noexcept;
 };
 
 #endif
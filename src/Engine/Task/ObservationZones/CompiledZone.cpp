@@ -0,0 +1,73 @@
+/*
+  Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "CompiledZone.hpp"
+#include "KeyholeZone.hpp"
+#include "AnnularSectorZone.hpp"
+
+void
+CompiledObservationZone::Compile(const ObservationZonePoint &oz) noexcept
+{
+  reference = oz.GetReference();
+
+  switch (oz.GetShape()) {
+  case ObservationZone::Shape::CYLINDER:
+  case ObservationZone::Shape::MAT_CYLINDER:
+    kind = Kind::CYLINDER;
+    radius = ((const CylinderZone &)oz).GetRadius();
+    return;
+
+  case ObservationZone::Shape::LINE:
+    kind = Kind::LINE;
+    break;
+
+  case ObservationZone::Shape::SECTOR:
+  case ObservationZone::Shape::FAI_SECTOR:
+  case ObservationZone::Shape::SYMMETRIC_QUADRANT:
+  case ObservationZone::Shape::BGA_START:
+    kind = Kind::SECTOR;
+    break;
+
+  case ObservationZone::Shape::DAEC_KEYHOLE:
+  case ObservationZone::Shape::BGAFIXEDCOURSE:
+  case ObservationZone::Shape::BGAENHANCEDOPTION:
+  case ObservationZone::Shape::CUSTOM_KEYHOLE:
+    kind = Kind::KEYHOLE;
+    inner_radius = ((const KeyholeZone &)oz).GetInnerRadius();
+    break;
+
+  case ObservationZone::Shape::ANNULAR_SECTOR:
+    kind = Kind::ANNULAR_SECTOR;
+    inner_radius = ((const AnnularSectorZone &)oz).GetInnerRadius();
+    break;
+  }
+
+  const SectorZone &sector = (const SectorZone &)oz;
+  radius = sector.GetRadius();
+  start_radial = sector.GetStartRadial();
+  end_radial = sector.GetEndRadial();
+
+  /* the same tolerance as SectorZone::IsAngleInSector() */
+  full_circle = (end_radial - start_radial).AsBearing()
+    <= Angle::FullCircle() / 512;
+}
@@ -0,0 +1,134 @@
+/*
+  Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_OBSERVATION_ZONE_COMPILED_HPP
+#define XCSOAR_OBSERVATION_ZONE_COMPILED_HPP
+
+#include "Geo/GeoPoint.hpp"
+#include "Geo/GeoVector.hpp"
+
+#include <cstdint>
+
+class ObservationZonePoint;
+
+/**
+ * A copy of the geometry of an #ObservationZonePoint, reduced to one
+ * of a few basic kinds.  It answers IsInSector() and
+ * TransitionConstraint() with a switch instead of virtual calls and
+ * without allocating, which is what the task transition checks need
+ * for each task point on each cycle.
+ *
+ * The results are the same as those of the zone it was compiled
+ * from.
+ */
+class CompiledObservationZone {
+  enum class Kind : uint8_t {
+    /**
+     * Not compiled yet.
+     */
+    NONE,
+
+    CYLINDER,
+    SECTOR,
+    KEYHOLE,
+    ANNULAR_SECTOR,
+
+    /**
+     * A #SECTOR whose transition constraint requires both locations
+     * to be inside its radius.
+     */
+    LINE,
+  };
+
+  Kind kind = Kind::NONE;
+
+  /**
+   * Does the sector cover all directions?
+   */
+  bool full_circle;
+
+  GeoPoint reference;
+
+  double radius, inner_radius;
+
+  Angle start_radial, end_radial;
+
+public:
+  bool IsDefined() const noexcept {
+    return kind != Kind::NONE;
+  }
+
+  void Clear() noexcept {
+    kind = Kind::NONE;
+  }
+
+  void Compile(const ObservationZonePoint &oz) noexcept;
+
+  [[gnu::pure]]
+  bool IsInSector(const GeoPoint &location) const noexcept {
+    switch (kind) {
+    case Kind::NONE:
+      break;
+
+    case Kind::CYLINDER:
+      return reference.Distance(location) <= radius;
+
+    case Kind::SECTOR:
+    case Kind::LINE: {
+      const GeoVector f(reference, location);
+      return f.distance <= radius && IsAngleInSector(f.bearing);
+    }
+
+    case Kind::KEYHOLE: {
+      const GeoVector f(reference, location);
+      return f.distance <= inner_radius ||
+        (f.distance <= radius && IsAngleInSector(f.bearing));
+    }
+
+    case Kind::ANNULAR_SECTOR: {
+      const GeoVector f(reference, location);
+      return f.distance <= radius && f.distance >= inner_radius &&
+        IsAngleInSector(f.bearing);
+    }
+    }
+
+    return false;
+  }
+
+  [[gnu::pure]]
+  bool TransitionConstraint(const GeoPoint &location,
+                            const GeoPoint &last_location) const noexcept {
+    if (kind != Kind::LINE)
+      return true;
+
+    return reference.Distance(location) <= radius &&
+      reference.Distance(last_location) <= radius;
+  }
+
+private:
+  bool IsAngleInSector(Angle bearing) const noexcept {
+    return full_circle || bearing.Between(start_radial, end_radial);
+  }
+};
+
+#endif
@@ -52,6 +52,14 @@ KeyholeZone::ScoreAdjustment() const
   return GetInnerRadius();
 }
 
+bool
+KeyholeZone::Equals(const ObservationZonePoint &other) const
+{
+  const KeyholeZone &z = (const KeyholeZone &)other;
+
+  return SymmetricSectorZone::Equals(other) && inner_radius == z.inner_radius;
+}
+
 bool 
 KeyholeZone::IsInSector(const GeoPoint &location) const
 {
@@ -122,6 +122,7 @@ public:
   double ScoreAdjustment() const override;
 
   /* virtual methods from class ObservationZonePoint */
+  bool Equals(const ObservationZonePoint &other) const override;
   std::unique_ptr<ObservationZonePoint> Clone(const GeoPoint &_reference) const noexcept override {
     return std::unique_ptr<ObservationZonePoint>{new KeyholeZone(*this, _reference)};
   }
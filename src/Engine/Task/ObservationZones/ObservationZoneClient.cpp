@@ -30,12 +30,6 @@ ObservationZoneClient::ObservationZoneClient(std::unique_ptr<ObservationZonePoin
 
 ObservationZoneClient::~ObservationZoneClient() noexcept = default;
 
-bool
-ObservationZoneClient::IsInSector(const GeoPoint &location) const
-{
-  return oz_point->IsInSector(location);
-}
-
 bool
 ObservationZoneClient::CanStartThroughTop() const
 {
@@ -60,17 +54,11 @@ ObservationZoneClient::GetBoundary() const
   return oz_point->GetBoundary();
 }
 
-bool
-ObservationZoneClient::TransitionConstraint(const GeoPoint &location,
-                                            const GeoPoint &last_location) const
-{
-  return oz_point->TransitionConstraint(location, last_location);
-}
-
 void
 ObservationZoneClient::SetLegs(const TaskPoint *previous,
                                const TaskPoint *next)
 {
   oz_point->SetLegs(previous != nullptr ? &previous->GetLocation() : nullptr,
                     next != nullptr ? &next->GetLocation() : nullptr);
+  compiled.Clear();
 }
@@ -23,6 +23,8 @@
 #ifndef OBSERVATIONZONECLIENT_HPP
 #define OBSERVATIONZONECLIENT_HPP
 
+#include "CompiledZone.hpp"
+
 #include <memory>
 
 class ObservationZonePoint;
@@ -36,6 +38,13 @@ struct GeoPoint;
 class ObservationZoneClient {
   std::unique_ptr<ObservationZonePoint> oz_point;
 
+  /**
+   * The geometry of #oz_point for IsInSector() and
+   * TransitionConstraint().  It is compiled lazily and cleared
+   * whenever #oz_point may be modified.
+   */
+  mutable CompiledObservationZone compiled;
+
 public:
   /**
    * Constructor.  Transfers ownership of the OZ to this object.
@@ -51,6 +60,8 @@ public:
    * @return Observation zone
    */
   ObservationZonePoint &GetObservationZone() {
+    /* the caller may modify the zone */
+    compiled.Clear();
     return *oz_point;
   }
 
@@ -58,14 +69,18 @@ public:
     return *oz_point;
   }
 
-  bool IsInSector(const GeoPoint &location) const;
+  bool IsInSector(const GeoPoint &location) const {
+    return GetCompiled().IsInSector(location);
+  }
 
   [[gnu::pure]]
   bool CanStartThroughTop() const;
 
   [[gnu::pure]]
   bool TransitionConstraint(const GeoPoint &location,
-                            const GeoPoint &last_location) const;
+                            const GeoPoint &last_location) const {
+    return GetCompiled().TransitionConstraint(location, last_location);
+  }
 
   [[gnu::pure]]
   OZBoundary GetBoundary() const;
@@ -76,6 +91,13 @@ public:
 
   [[gnu::pure]]
   GeoPoint GetRandomPointInSector(double mag) const;
+
+private:
+  const CompiledObservationZone &GetCompiled() const noexcept {
+    if (!compiled.IsDefined())
+      compiled.Compile(*oz_point);
+    return compiled;
+  }
 };
 
 
@@ -21,6 +21,7 @@
 */
 
 #include "OrderedTask.hpp"
+#include "Progress.hpp"
 #include "Task/TaskEvents.hpp"
 #include "Points/OrderedTaskPoint.hpp"
 #include "Points/StartPoint.hpp"
@@ -33,6 +34,7 @@
 #include "Task/Solvers/TaskBestMc.hpp"
 #include "Task/Solvers/TaskMinTarget.hpp"
 #include "Task/Solvers/TaskGlideRequired.hpp"
+#include "Task/Solvers/LegSolutionCache.hpp"
 #include "Task/Solvers/TaskOptTarget.hpp"
 #include "Task/Visitors/TaskPointVisitor.hpp"
 
@@ -626,7 +628,14 @@ OrderedTask::UpdateIdle(const AircraftState &state,
       TaskOptTarget tot(tps, active_task_point, state,
                         task_behaviour.glide, glide_polar,
                         *ap, task_projection, *taskpoint_start);
-      tot.search(0.5);
+      tot.set_cache(&GetLegSolutionCache());
+      const auto p = tot.search(opt_target_index == active_task_point
+                                ? opt_target_p
+                                : 0.5);
+      if (p >= 0) {
+        opt_target_p = p;
+        opt_target_index = active_task_point;
+      }
     }
     retval = true;
   }
@@ -881,6 +890,67 @@ OrderedTask::SetActiveTaskPoint(unsigned index) noexcept
   force_full_update = true;
 }
 
+OrderedTaskProgress
+OrderedTask::GetProgress() const noexcept
+{
+  OrderedTaskProgress progress;
+  progress.active_task_point = active_task_point;
+  progress.points.reserve(task_points.size());
+
+  for (const auto &tp : task_points) {
+    auto &p = progress.points.emplace_back();
+    p.location = tp->GetLocation();
+    p.entered = tp->GetEnteredState();
+    p.has_exited = tp->HasExited();
+
+    for (const auto &i : tp->GetSampledPoints())
+      p.samples.push_back(i.GetLocation());
+  }
+
+  return progress;
+}
+
+bool
+OrderedTask::RestoreProgress(const OrderedTaskProgress &progress) noexcept
+{
+  if (taskpoint_start == nullptr ||
+      progress.points.size() != task_points.size() ||
+      progress.active_task_point >= task_points.size())
+    return false;
+
+  for (unsigned i = 0; i < task_points.size(); ++i)
+    if (progress.points[i].location != task_points[i]->GetLocation())
+      return false;
+
+  for (unsigned i = 0; i < task_points.size(); ++i) {
+    auto &tp = *task_points[i];
+    const auto &p = progress.points[i];
+    tp.RestoreTransitions(p.entered, p.has_exited);
+    tp.RestoreSamples(p.samples, task_projection);
+  }
+
+  task_advance.SetArmed(false);
+  active_task_point = progress.active_task_point;
+  taskpoint_start->ScanActive(*task_points[active_task_point]);
+
+  /* update the statistics right now; CheckTransitions() would
+     otherwise report the start (and the finish) as a new event */
+  stats.task_finished = taskpoint_finish != nullptr &&
+    taskpoint_finish->HasEntered();
+  stats.start.task_started = TaskStarted();
+
+  if (stats.start.task_started) {
+    const AircraftState start_state = taskpoint_start->GetEnteredState();
+    stats.start.SetStarted(start_state);
+
+    if (taskpoint_finish != nullptr)
+      taskpoint_finish->SetFaiFinishHeight(start_state.altitude - 1000);
+  }
+
+  force_full_update = true;
+  return true;
+}
+
 TaskWaypoint*
 OrderedTask::GetActiveTaskPoint() const noexcept
 {
@@ -913,6 +983,7 @@ OrderedTask::GlideSolutionRemaining(const AircraftState &aircraft,
   TaskMacCreadyRemaining tm(tps.begin(), tps.end(),
                             active_task_point,
                             task_behaviour.glide, polar);
+  tm.set_cache(&GetLegSolutionCache());
   total = tm.glide_solution(aircraft);
   leg = tm.get_active_solution();
 }
@@ -932,6 +1003,7 @@ OrderedTask::GlideSolutionTravelled(const AircraftState &aircraft,
   TaskPointList tps(task_points);
   TaskMacCreadyTravelled tm(tps.begin(), active_task_point,
                             task_behaviour.glide, glide_polar);
+  tm.set_cache(&GetLegSolutionCache());
   total = tm.glide_solution(aircraft);
   leg = tm.get_active_solution();
 }
@@ -958,6 +1030,7 @@ OrderedTask::GlideSolutionPlanned(const AircraftState &aircraft,
   TaskMacCreadyTotal tm(tps.begin(), tps.end(),
                         active_task_point,
                         task_behaviour.glide, glide_polar);
+  tm.set_cache(&GetLegSolutionCache());
   total = tm.glide_solution(aircraft);
   leg = tm.get_active_solution();
 
@@ -972,6 +1045,14 @@ OrderedTask::GlideSolutionPlanned(const AircraftState &aircraft,
     leg_remaining_effective.Reset();
 }
 
+LegSolutionCache &
+OrderedTask::GetLegSolutionCache() const noexcept
+{
+  if (leg_solution_cache == nullptr)
+    leg_solution_cache = std::make_unique<LegSolutionCache>();
+  return *leg_solution_cache;
+}
+
 // Auxiliary glide functions
 
 double
@@ -993,6 +1074,7 @@ OrderedTask::CalcBestMC(const AircraftState &aircraft,
   TaskPointList tps(task_points);
   TaskBestMc bmc(tps, active_task_point, aircraft,
                  task_behaviour.glide, glide_polar);
+  bmc.set_cache(&GetLegSolutionCache());
   return bmc.search(glide_polar.GetMC(), best);
 }
 
@@ -1061,8 +1143,8 @@ OrderedTask::CalcMinTarget(const AircraftState &aircraft,
     TaskMinTarget bmt(tps, active_task_point, aircraft,
                       task_behaviour.glide, glide_polar,
                       t_rem, *taskpoint_start);
-    auto p = bmt.search(0);
-    return p;
+    min_target_p = bmt.search(min_target_p);
+    return min_target_p;
   }
 
   return 0;
@@ -1119,6 +1201,8 @@ OrderedTask::Reset() noexcept
   stats.task_finished = false;
   stats.start.task_started = false;
   task_advance.Reset();
+  min_target_p = 0;
+  opt_target_p = 0.5;
   SetActiveTaskPoint(0);
   UpdateStatsGeometry();
 }
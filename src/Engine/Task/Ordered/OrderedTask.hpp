@@ -42,11 +42,13 @@ class FinishPoint;
 class AbstractTaskFactory;
 class TaskDijkstraMin;
 class TaskDijkstraMax;
+class LegSolutionCache;
 class Waypoints;
 class AATPoint;
 struct FlatBoundingBox;
 class GeoBounds;
 struct TaskSummary;
+struct OrderedTaskProgress;
 struct TaskFactoryConstraints;
 
 /**
@@ -85,6 +87,15 @@ private:
 
   GeoPoint last_min_location;
 
+  /**
+   * Solutions of the previous target optimisation, used as starting
+   * points for the next one in UpdateIdle().  #opt_target_p is only
+   * valid while #opt_target_index equals #active_task_point.
+   */
+  double min_target_p = 0;
+  double opt_target_p = 0.5;
+  unsigned opt_target_index = 0;
+
   TaskFactoryType factory_mode;
   std::unique_ptr<AbstractTaskFactory> active_factory;
   OrderedTaskSettings ordered_settings;
@@ -92,6 +103,12 @@ private:
   std::unique_ptr<TaskDijkstraMin> dijkstra_min;
   std::unique_ptr<TaskDijkstraMax> dijkstra_max;
 
+  /**
+   * Shared by the glide solvers, allocated on demand by
+   * GetLegSolutionCache().
+   */
+  mutable std::unique_ptr<LegSolutionCache> leg_solution_cache;
+
   StaticString<64> name;
 
 public:
@@ -195,6 +212,21 @@ public:
     return *task_points[index];
   }
 
+  /**
+   * Capture the progress along this task, to be restored by
+   * RestoreProgress() after the program has been restarted.
+   */
+  [[gnu::pure]]
+  OrderedTaskProgress GetProgress() const noexcept;
+
+  /**
+   * Restore the progress captured by GetProgress().  Nothing is
+   * changed if it was captured from a different task.
+   *
+   * @return true if the progress was restored
+   */
+  bool RestoreProgress(const OrderedTaskProgress &progress) noexcept;
+
   /**
    * Check if task has a single StartPoint
    *
@@ -451,6 +483,8 @@ private:
 
   double ScanDistanceMax();
 
+  LegSolutionCache &GetLegSolutionCache() const noexcept;
+
   /**
    * Optimise target ranges (for adjustable tasks) to produce an estimated
    * time remaining with the current glide polar, equal to a target value.
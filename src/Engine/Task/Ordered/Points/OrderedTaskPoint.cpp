@@ -47,6 +47,8 @@ OrderedTaskPoint::OrderedTaskPoint(TaskPointType _type,
 {
 }
 
+OrderedTaskPoint::~OrderedTaskPoint() noexcept = default;
+
 void
 OrderedTaskPoint::SetNeighbours(OrderedTaskPoint *_previous,
                                 OrderedTaskPoint *_next) noexcept
@@ -61,6 +63,20 @@ void
 OrderedTaskPoint::UpdateGeometry() noexcept
 {
   SetLegs(tp_previous, tp_next);
+
+  /* the orientation of sectors depends on the legs; if a neighbour
+     has moved, the cached boundary is stale */
+  const GeoPoint previous = tp_previous != nullptr
+    ? tp_previous->GetLocation()
+    : GeoPoint::Invalid();
+  const GeoPoint next = tp_next != nullptr
+    ? tp_next->GetLocation()
+    : GeoPoint::Invalid();
+  if (previous != legs_previous || next != legs_next) {
+    legs_previous = previous;
+    legs_next = next;
+    boundary_zone.reset();
+  }
 }
 
 void
@@ -68,7 +84,19 @@ OrderedTaskPoint::UpdateOZ(const FlatProjection &projection) noexcept
 {
   UpdateGeometry();
 
-  SampledTaskPoint::UpdateOZ(projection, GetBoundary());
+  SampledTaskPoint::UpdateOZ(projection, GetCachedBoundary());
+}
+
+const OZBoundary &
+OrderedTaskPoint::GetCachedBoundary() const noexcept
+{
+  const ObservationZonePoint &oz = GetObservationZone();
+  if (boundary_zone == nullptr || !boundary_zone->Equals(oz)) {
+    boundary = GetBoundary();
+    boundary_zone = oz.Clone();
+  }
+
+  return boundary;
 }
 
 bool
@@ -193,7 +221,7 @@ OrderedTaskPoint::ScanBounds(GeoBounds &bounds) const noexcept
 {
   bounds.Extend(GetLocation());
 
-  for (const auto &i : GetBoundary())
+  for (const auto &i : GetCachedBoundary())
     bounds.Extend(i);
 }
 
@@ -202,7 +230,7 @@ OrderedTaskPoint::UpdateBoundingBox(const FlatProjection &projection) noexcept
 {
   flat_bb = FlatBoundingBox(projection.ProjectInteger(GetLocation()));
 
-  for (const auto &i : GetBoundary())
+  for (const auto &i : GetCachedBoundary())
     flat_bb.Expand(projection.ProjectInteger(i));
 
   flat_bb.ExpandByOne(); // add 1 to fix rounding
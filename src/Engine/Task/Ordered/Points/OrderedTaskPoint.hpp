@@ -28,6 +28,7 @@
 #include "Task/Points/TaskWaypoint.hpp"
 #include "Task/Points/ScoredTaskPoint.hpp"
 #include "Task/ObservationZones/ObservationZoneClient.hpp"
+#include "Task/ObservationZones/Boundary.hpp"
 #include "Geo/Flat/FlatBoundingBox.hpp"
 
 #include <memory>
@@ -74,6 +75,21 @@ private:
   OrderedTaskPoint* tp_previous;
   FlatBoundingBox flat_bb;
 
+  /**
+   * Neighbour locations passed to the last SetLegs() call, or
+   * GeoPoint::Invalid() if there was no neighbour.
+   */
+  GeoPoint legs_previous = GeoPoint::Invalid();
+  GeoPoint legs_next = GeoPoint::Invalid();
+
+  /**
+   * Cached result of GetBoundary(), see GetCachedBoundary().
+   * #boundary_zone is a copy of the observation zone it was
+   * generated from, or nullptr if the cache is stale.
+   */
+  mutable OZBoundary boundary;
+  mutable std::unique_ptr<ObservationZonePoint> boundary_zone;
+
 public:
   /**
    * Constructor.
@@ -91,7 +107,7 @@ public:
                    WaypointPtr &&wp,
                    const bool b_scored) noexcept;
 
-  virtual ~OrderedTaskPoint() noexcept = default;
+  virtual ~OrderedTaskPoint() noexcept;
 
   /* choose TaskPoint's implementation, not SampledTaskPoint's */
   using TaskPoint::GetLocation;
@@ -226,6 +242,12 @@ public:
 
   void UpdateOZ(const FlatProjection &projection) noexcept;
 
+  /**
+   * Like GetBoundary(), but reuses the previous result while neither
+   * the observation zone nor its legs have been modified.
+   */
+  const OZBoundary &GetCachedBoundary() const noexcept;
+
   /**
    * Update the bounding box in flat projected coordinates
    */
@@ -76,7 +76,7 @@ StartPoint::find_best_start(const AircraftState &state,
   /* check which boundary point results in the smallest distance to
      fly */
 
-  const OZBoundary boundary = GetBoundary();
+  const OZBoundary &boundary = GetCachedBoundary();
   assert(!boundary.empty());
 
   const auto end = boundary.end();
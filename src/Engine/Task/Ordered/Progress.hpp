@@ -0,0 +1,60 @@
+/*
+  Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+ */
+
+#ifndef XCSOAR_ORDERED_TASK_PROGRESS_HPP
+#define XCSOAR_ORDERED_TASK_PROGRESS_HPP
+
+#include "Geo/GeoPoint.hpp"
+#include "Navigation/Aircraft.hpp"
+
+#include <vector>
+
+/**
+ * The progress along an #OrderedTask: which task point is active,
+ * and what has been recorded in the observation zones so far.  It
+ * allows continuing a flight after the program was restarted, see
+ * OrderedTask::GetProgress() and OrderedTask::RestoreProgress().
+ */
+struct OrderedTaskProgress {
+  struct Point {
+    /**
+     * The nominal location of the task point; it is used to verify
+     * that the progress is being restored into the same task.
+     */
+    GeoPoint location;
+
+    /** see ScoredTaskPoint::GetEnteredState() */
+    AircraftState entered;
+
+    bool has_exited;
+
+    /** see SampledTaskPoint::GetSampledPoints() */
+    std::vector<GeoPoint> samples;
+  };
+
+  unsigned active_task_point;
+
+  std::vector<Point> points;
+};
+
+#endif
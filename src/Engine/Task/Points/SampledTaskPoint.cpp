@@ -74,6 +74,15 @@ SampledTaskPoint::ClearSampleAllButLast(const AircraftState& ref_last,
   }
 }
 
+void
+SampledTaskPoint::RestoreSamples(const std::vector<GeoPoint> &samples,
+                                 const FlatProjection &projection)
+{
+  sampled_points.clear();
+  for (const auto &i : samples)
+    sampled_points.emplace_back(i, projection);
+}
+
 // BOUNDARY
 
 void
@@ -169,6 +169,13 @@ public:
     return boundary_scored;
   }
 
+  /**
+   * Replace the samples, e.g. with the ones saved by an earlier
+   * instance of this program.
+   */
+  void RestoreSamples(const std::vector<GeoPoint> &samples,
+                      const FlatProjection &projection);
+
 protected:
   void SetPast(bool _past) {
     past = _past;
@@ -109,6 +109,15 @@ public:
                       const AircraftState &ref_last,
                       const FlatProjection &projection);
 
+  /**
+   * Restore the transitions recorded by an earlier instance of this
+   * program.
+   */
+  void RestoreTransitions(const AircraftState &entered, bool exited) {
+    state_entered = entered;
+    has_exited = exited;
+  }
+
   /** Retrieve location to be used for the scored task. */
   [[gnu::pure]]
   const GeoPoint &GetLocationScored() const;
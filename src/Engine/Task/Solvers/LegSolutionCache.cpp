@@ -0,0 +1,60 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+#include "LegSolutionCache.hpp"
+#include "GlideSolvers/MacCready.hpp"
+
+#include <functional>
+
+std::size_t
+LegSolutionCache::Key::Hash::operator()(const Key &key) const noexcept
+{
+  const std::hash<double> h;
+
+  /* the fields which differ between legs and between the iterations
+     of the task solvers */
+  std::size_t result = h(key.state.vector.distance);
+  result = result * 31 + h(key.state.vector.bearing.Native());
+  result = result * 31 + h(key.state.altitude_difference);
+  result = result * 31 + h(key.state.min_arrival_altitude);
+  result = result * 31 + h(key.polar.GetMC());
+  result = result * 31 + h(key.polar.GetCruiseEfficiency());
+  return result;
+}
+
+GlideResult
+LegSolutionCache::Solve(const GlideSettings &settings,
+                        const GlidePolar &polar,
+                        const GlideState &state) noexcept
+{
+  const Key key{state, polar, settings};
+
+  if (const GlideResult *result = cache.Get(key)) {
+    ++hits;
+    return *result;
+  }
+
+  ++misses;
+  return cache.Put(key, MacCready::Solve(settings, polar, state));
+}
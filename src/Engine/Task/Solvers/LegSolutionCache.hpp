@@ -0,0 +1,81 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+#ifndef LEG_SOLUTION_CACHE_HPP
+#define LEG_SOLUTION_CACHE_HPP
+
+#include "GlideSolvers/GlideState.hpp"
+#include "GlideSolvers/GlidePolar.hpp"
+#include "GlideSolvers/GlideSettings.hpp"
+#include "GlideSolvers/GlideResult.hpp"
+#include "util/Cache.hxx"
+
+#include <cstddef>
+
+/**
+ * Remembers recent MacCready::Solve() results.  The task solvers are
+ * created again for each calculation, and most of the task's legs
+ * (all but the one starting at the aircraft) are the same as in the
+ * last one; with this cache, they need not be solved again.
+ *
+ * The key consists of all parameters of MacCready::Solve(), which is
+ * a pure function, therefore entries never need to be invalidated.
+ */
+class LegSolutionCache {
+  struct Key {
+    GlideState state;
+    GlidePolar polar;
+    GlideSettings settings;
+
+    bool operator==(const Key &) const noexcept = default;
+
+    struct Hash {
+      [[gnu::pure]]
+      std::size_t operator()(const Key &key) const noexcept;
+    };
+  };
+
+  Cache<Key, GlideResult, 128, 131, Key::Hash> cache;
+
+  unsigned hits = 0, misses = 0;
+
+public:
+  GlideResult Solve(const GlideSettings &settings, const GlidePolar &polar,
+                    const GlideState &state) noexcept;
+
+  void Clear() noexcept {
+    cache.Clear();
+    hits = misses = 0;
+  }
+
+  unsigned GetHits() const noexcept {
+    return hits;
+  }
+
+  unsigned GetMisses() const noexcept {
+    return misses;
+  }
+};
+
+#endif
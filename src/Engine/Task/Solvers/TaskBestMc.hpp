@@ -86,6 +86,13 @@ public:
 
   bool search(double mc, double &result);
 
+  /**
+   * @see TaskMacCready::set_cache()
+   */
+  void set_cache(LegSolutionCache *cache) noexcept {
+    tm.set_cache(cache);
+  }
+
 private:
 
   /**
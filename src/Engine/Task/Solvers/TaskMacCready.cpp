@@ -22,6 +22,8 @@
 
 #include "TaskMacCready.hpp"
 #include "TaskSolution.hpp"
+#include "LegSolutionCache.hpp"
+#include "GlideSolvers/MacCready.hpp"
 #include "Task/Points/TaskPoint.hpp"
 #include "Navigation/Aircraft.hpp"
 
@@ -83,3 +85,11 @@ TaskMacCready::glide_sink(const AircraftState &aircraft, const double S) const
 
   return acc_gr;
 }
+
+GlideResult
+TaskMacCready::SolveLeg(const GlideState &state) const noexcept
+{
+  return cache != nullptr
+    ? cache->Solve(settings, glide_polar, state)
+    : MacCready::Solve(settings, glide_polar, state);
+}
@@ -31,6 +31,8 @@
 
 struct AircraftState;
 struct GlideSettings;
+struct GlideState;
+class LegSolutionCache;
 class TaskPoint;
 class OrderedTaskPoint;
 
@@ -80,6 +82,11 @@ protected:
    */
   GlidePolar glide_polar;
 
+  /**
+   * If set, leg solutions are looked up here first.
+   */
+  LegSolutionCache *cache = nullptr;
+
 public:
   /**
    * Constructor for ordered task points
@@ -142,6 +149,14 @@ public:
     glide_polar.SetMC(mc);
   };
 
+  /**
+   * Use the specified cache for leg solutions (nullptr disables it).
+   * It must remain valid as long as this object is used.
+   */
+  void set_cache(LegSolutionCache *_cache) noexcept {
+    cache = _cache;
+  }
+
   /**
    * Adjust cruise efficiency of internal glide polar
    *
@@ -163,6 +178,13 @@ public:
     return leg_solutions[active_index];
   }
 
+protected:
+  /**
+   * Solve one leg with the internal glide polar, using the cache if
+   * there is one.
+   */
+  GlideResult SolveLeg(const GlideState &state) const noexcept;
+
 private:
 
   /**
@@ -22,7 +22,6 @@
 
 #include "TaskMacCreadyRemaining.hpp"
 #include "GlideSolvers/GlideState.hpp"
-#include "GlideSolvers/MacCready.hpp"
 #include "Task/Points/TaskPoint.hpp"
 #include "Task/Ordered/Points/AATPoint.hpp"
 
@@ -39,7 +38,7 @@ TaskMacCreadyRemaining::SolvePoint(const TaskPoint &tp,
     /* ignore the travel to the start point */
     gs.vector.distance = 0;
 
-  return MacCready::Solve(settings, glide_polar, gs);
+  return SolveLeg(gs);
 }
 
 
@@ -41,6 +41,12 @@ class StartPoint;
 class TaskMinTarget final : private ZeroFinder {
   static constexpr double TOLERANCE = 0.002;
 
+  /**
+   * Half width of the interval around the previous solution which is
+   * tried before searching the whole range.
+   */
+  static constexpr double WARM_START_WIDTH = 0.05;
+
   TaskMacCreadyRemaining tm;
   GlideResult res;
   const AircraftState &aircraft;
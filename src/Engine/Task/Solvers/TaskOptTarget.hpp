@@ -107,6 +107,13 @@ public:
    */
   virtual double search(double p);
 
+  /**
+   * @see TaskMacCready::set_cache()
+   */
+  void set_cache(LegSolutionCache *cache) noexcept {
+    tm.set_cache(cache);
+  }
+
 private:
   /** Sets target location along isoline */
   void SetTarget(double p);
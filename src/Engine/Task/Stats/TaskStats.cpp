@@ -54,7 +54,7 @@ TaskStats::reset()
   need_to_arm = false;
   flight_mode_final_glide = false;
   start.Reset();
-  last_hour.Reset();
+  ResetWindows();
 }
 
 bool
@@ -101,7 +101,10 @@ public:
 
   StartStats start;
 
-  WindowStats last_hour;
+  /**
+   * Task speed over the last 10 minutes, 30 minutes and hour.
+   */
+  WindowStats last_10min, last_30min, last_hour;
 
   FloatDuration GetEstimatedTotalTime() const noexcept {
     return total.time_elapsed + total.time_remaining_start;
@@ -110,6 +113,12 @@ public:
   /** Reset each element (for incremental speeds). */
   void reset();
 
+  void ResetWindows() noexcept {
+    last_10min.Reset();
+    last_30min.Reset();
+    last_hour.Reset();
+  }
+
   /**
    * Convenience function, determines if remaining task is in final glide
    *
@@ -107,6 +107,13 @@ TaskManager::SetActiveTaskPoint(unsigned index)
     active_task->SetActiveTaskPoint(index);
 }
 
+bool
+TaskManager::RestoreOrderedTaskProgress(const OrderedTaskProgress &progress)
+  noexcept
+{
+  return ordered_task->RestoreProgress(progress);
+}
+
 unsigned
 TaskManager::GetActiveTaskPointIndex() const
 {
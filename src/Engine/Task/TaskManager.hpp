@@ -42,6 +42,7 @@ class OrderedTask;
 class GotoTask;
 class AlternateTask;
 class AlternateList;
+struct OrderedTaskProgress;
 class TaskWaypoint;
 class AbortIntersectionTest;
 struct RangeAndRadial;
@@ -95,6 +96,11 @@ public:
     return *ordered_task;
   }
 
+  /**
+   * @see OrderedTask::RestoreProgress()
+   */
+  bool RestoreOrderedTaskProgress(const OrderedTaskProgress &progress) noexcept;
+
   /**
    * Increments active taskpoint sequence for active task
    *
@@ -22,7 +22,6 @@
 
 #include "AbortTask.hpp"
 #include "AbortIntersectionTest.hpp"
-#include "AlternateList.hpp"
 #include "Navigation/Aircraft.hpp"
 #include "Task/Visitors/TaskPointVisitor.hpp"
 #include "Task/Solvers/TaskSolution.hpp"
@@ -119,7 +118,7 @@ IsReachable(const GlideResult &result, bool final_glide) noexcept
 
 bool
 AbortTask::FillReachable(const AircraftState &state,
-                         AlternateList &approx_waypoints,
+                         CandidateList &approx_waypoints,
                          const GlidePolar &polar, bool only_airfield,
                          bool final_glide, bool safety) noexcept
 {
@@ -129,7 +128,7 @@ AbortTask::FillReachable(const AircraftState &state,
   const AGeoPoint p_start(state.location, state.altitude);
 
   bool found_final_glide = false;
-  AlternateList q;
+  CandidateList q;
   q.reserve(32);
 
   for (auto v = approx_waypoints.begin(); v != approx_waypoints.end();) {
@@ -216,7 +215,7 @@ AbortTask::UpdateSample(const AircraftState &state,
     /* can't work without a polar */
     return false;
 
-  AlternateList approx_waypoints;
+  CandidateList approx_waypoints;
   approx_waypoints.reserve(128);
 
   waypoints.VisitWithinRange(state.location,
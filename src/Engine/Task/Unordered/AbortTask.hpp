@@ -25,6 +25,8 @@
 
 #include "UnorderedTask.hpp"
 #include "UnorderedTaskPoint.hpp"
+#include "AlternatePoint.hpp"
+#include "util/ThreadLocalPool.hpp"
 
 #include <vector>
 
@@ -32,7 +34,6 @@
 
 class Waypoints;
 class AbortIntersectionTest;
-class AlternateList;
 
 /**
  * Abort task provides automatic management of a sorted list of task points
@@ -66,6 +67,13 @@ protected:
   AlternateTaskVector task_points;
 
 private:
+  /**
+   * A temporary list of candidates, built in each UpdateSample()
+   * call, therefore allocated from the #ThreadLocalPool.
+   */
+  using CandidateList = std::vector<AlternatePoint,
+                                    ThreadLocalPoolAllocator<AlternatePoint>>;
+
   /** max number of items in list */
   static constexpr AlternateTaskVector::size_type max_abort = 10;
 
@@ -171,7 +179,7 @@ protected:
    * @return True if a landpoint within final glide was found
    */
   bool FillReachable(const AircraftState &state,
-                     AlternateList &approx_waypoints,
+                     CandidateList &approx_waypoints,
                      const GlidePolar &polar, bool only_airfield,
                      bool final_glide, bool safety) noexcept;
 
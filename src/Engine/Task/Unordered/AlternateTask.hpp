@@ -42,7 +42,7 @@ class AlternateTask final : public AbortTask
       :AlternatePoint(std::move(_waypoint), _solution), delta(_delta) {}
   };
 
-  using DivertVector = std::vector<Divert>;
+  using DivertVector = std::vector<Divert, ThreadLocalPoolAllocator<Divert>>;
 
   /// number of alternates
   static constexpr DivertVector::size_type max_alternates = 6;
@@ -40,16 +40,24 @@ ThermalEncounterCollection::Merge(const ThermalBand& tb)
     return;
   }
 
+  const double old_floor = h_min, old_spacing = dh;
+
   // check for floor lowering with new data
   LowerFloor(tb.GetFloor());
 
   // ensure there's enough room for new data
   CheckExpand(tb, false);
 
+  // the slices below the new data keep their accumulated times,
+  // unless they were moved or decimated
+  const unsigned first = h_min == old_floor && dh == old_spacing
+    ? std::min(GetSliceIndex(tb.GetFloor()), size())
+    : 0;
+
   // insert all items
   MergeUnsafe(tb);
 
-  UpdateTimes();
+  UpdateTimes(first);
 }
 
 inline void
@@ -141,12 +149,19 @@ ThermalEncounterCollection::MergeUnsafe(const ThermalBand& o)
 }
 
 inline void
-ThermalEncounterCollection::UpdateTimes()
+ThermalEncounterCollection::UpdateTimes(unsigned first)
 {
   assert(!empty());
+  assert(first <= size());
+
+  if (first == 0) {
+    slices[0].time = {};
+    first = 1;
+  }
+
   // update accumulated times below slice height
-  FloatDuration t = slices[0].time = {};
-  for (unsigned i=1; i< size(); ++i) {
+  FloatDuration t = slices[first - 1].time;
+  for (unsigned i = first; i < size(); ++i) {
     t += slices[i-1].dt;
     slices[i].time = t;
   }
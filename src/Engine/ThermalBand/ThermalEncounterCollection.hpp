@@ -31,7 +31,13 @@ public:
 private:
   void MergeUnsafe(const ThermalBand& o);
   void LowerFloor(const double new_floor);
-  void UpdateTimes();
+
+  /**
+   * Update the accumulated times of all slices from the given index
+   * upwards.  The slices below it must be unchanged since the last
+   * call.
+   */
+  void UpdateTimes(unsigned first=0);
 };
 
 static_assert(std::is_trivial<ThermalEncounterCollection>::value, "type is not trivial");
@@ -0,0 +1,147 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_TRACE_SNAPSHOT_HPP
+#define XCSOAR_TRACE_SNAPSHOT_HPP
+
+#include "Point.hpp"
+#include "Vector.hpp"
+#include "util/Serial.hpp"
+
+#include <cassert>
+#include <vector>
+
+/**
+ * A read-only copy of all points of a #Trace in chronological order,
+ * with the attributes most often needed by the contest solvers
+ * stored in separate arrays ("structure of arrays").  It is owned by
+ * the #Trace and updated lazily by Trace::GetSnapshot().
+ *
+ * The #TracePoint pointers refer to the #Trace nodes and get
+ * Invalidated when the #Trace gets thinned; compare
+ * Trace::GetModifySerial() with the value obtained when the snapshot
+ * was last read.  Indices remain valid while points are only being
+ * appended.
+ */
+class TraceSnapshot {
+  friend class Trace;
+
+  /**
+   * The Trace::GetModifySerial() value this snapshot was built from.
+   */
+  Serial modify_serial;
+
+  TracePointerVector points;
+
+  std::vector<int> x, y;
+  std::vector<unsigned> time;
+  std::vector<int> altitude;
+  std::vector<float> vario;
+
+public:
+  unsigned size() const noexcept {
+    return points.size();
+  }
+
+  bool empty() const noexcept {
+    return points.empty();
+  }
+
+  const TracePointerVector &GetPoints() const noexcept {
+    return points;
+  }
+
+  const TracePoint &GetPoint(unsigned i) const noexcept {
+    assert(i < size());
+
+    return *points[i];
+  }
+
+  FlatGeoPoint GetFlatLocation(unsigned i) const noexcept {
+    assert(i < size());
+
+    return {x[i], y[i]};
+  }
+
+  const int *GetX() const noexcept {
+    return x.data();
+  }
+
+  const int *GetY() const noexcept {
+    return y.data();
+  }
+
+  TracePoint::Time GetTime(unsigned i) const noexcept {
+    assert(i < size());
+
+    return TracePoint::Time{time[i]};
+  }
+
+  /**
+   * @see TracePoint::GetIntegerAltitude()
+   */
+  int GetIntegerAltitude(unsigned i) const noexcept {
+    assert(i < size());
+
+    return altitude[i];
+  }
+
+  double GetVario(unsigned i) const noexcept {
+    assert(i < size());
+
+    return vario[i];
+  }
+
+private:
+  void Clear() noexcept {
+    points.clear();
+    x.clear();
+    y.clear();
+    time.clear();
+    altitude.clear();
+    vario.clear();
+  }
+
+  void Reserve(std::size_t n) {
+    points.reserve(n);
+    x.reserve(n);
+    y.reserve(n);
+    time.reserve(n);
+    altitude.reserve(n);
+    vario.reserve(n);
+  }
+
+  void Append(const TracePoint &point) {
+    points.push_back(&point);
+
+    const FlatGeoPoint &flat = point.GetFlatLocation();
+    x.push_back(flat.x);
+    y.push_back(flat.y);
+
+    time.push_back(point.GetTime().count());
+    altitude.push_back(point.GetIntegerAltitude());
+    vario.push_back(point.GetVario());
+  }
+};
+
+#endif
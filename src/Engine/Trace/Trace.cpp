@@ -37,6 +37,10 @@ Trace::Trace(const Time _no_thin_time, const Time max_time,
    opt_size((3 * max_size) / 4)
 {
   assert(max_size >= 4);
+
+#ifdef TRACE_HEAP
+  delta_list.reserve(max_size);
+#endif
 }
 
 void
@@ -51,6 +55,7 @@ Trace::clear()
   delta_list.clear();
   chronological_list.clear_and_dispose(MakeDisposer());
   cached_size = 0;
+  memory_usage.Update(0, 0);
 
   assert(cached_size == delta_list.size());
   assert(cached_size == chronological_list.size());
@@ -75,7 +80,11 @@ Trace::GetRecentTime(const Time t) const noexcept
 void
 Trace::UpdateDelta(TraceDelta &td)
 {
+#ifdef TRACE_HEAP
+  assert(delta_list.size() <= cached_size);
+#else
   assert(cached_size == delta_list.size());
+#endif
   assert(cached_size == chronological_list.size());
 
   if (&td == &chronological_list.front() ||
@@ -86,29 +95,48 @@ Trace::UpdateDelta(TraceDelta &td)
   const TraceDelta &previous = *std::prev(ci);
   const TraceDelta &next = *std::next(ci);
 
+#ifdef TRACE_HEAP
+  /* this may be an item which EraseDelta() has taken out of the
+     heap temporarily; update() ignores it */
+  td.Update(previous.point, next.point);
+  delta_list.update(td);
+#else
   delta_list.erase(delta_list.iterator_to(td));
   td.Update(previous.point, next.point);
   delta_list.insert(td);
+#endif
+}
+
+void
+Trace::DisposeDelta(TraceDelta &td) noexcept
+{
+#ifdef TRACE_HEAP
+  delta_list.erase(td);
+  MakeDisposer()(&td);
+#else
+  delta_list.erase_and_dispose(delta_list.iterator_to(td), MakeDisposer());
+#endif
 }
 
 void
-Trace::EraseInside(DeltaList::iterator it)
+Trace::EraseInside(TraceDelta &td)
 {
   assert(cached_size > 0);
+#ifdef TRACE_HEAP
+  assert(delta_list.size() <= cached_size);
+#else
   assert(cached_size == delta_list.size());
+#endif
   assert(cached_size == chronological_list.size());
-  assert(it != delta_list.end());
-
-  const TraceDelta &td = *it;
   assert(!td.IsEdge());
 
   const auto ci = chronological_list.iterator_to(td);
-  TraceDelta &previous = const_cast<TraceDelta &>(*std::prev(ci));
-  TraceDelta &next = const_cast<TraceDelta &>(*std::next(ci));
+  TraceDelta &previous = *std::prev(ci);
+  TraceDelta &next = *std::next(ci);
 
   // now delete the item
-  chronological_list.erase(chronological_list.iterator_to(td));
-  delta_list.erase_and_dispose(it, MakeDisposer());
+  chronological_list.erase(ci);
+  DisposeDelta(td);
   --cached_size;
 
   // and update the deltas
@@ -129,11 +157,32 @@ Trace::EraseDelta(const unsigned target_size, const Time recent) noexcept
 
   const Time recent_time = GetRecentTime(recent);
 
+#ifdef TRACE_HEAP
+  /* the heap can't be iterated in order; instead, suppressed
+     candidates are taken out and inserted again at the end */
+  assert(suppressed.empty());
+
+  while (size() > target_size && !delta_list.empty()) {
+    TraceDelta &td = delta_list.front();
+    if (!td.IsEdge() && td.point.GetTime() < recent_time) {
+      EraseInside(td);
+      modified = true;
+    } else {
+      // suppressed removal, skip it.
+      delta_list.pop_front();
+      suppressed.push_back(&td);
+    }
+  }
+
+  for (TraceDelta *td : suppressed)
+    delta_list.insert(*td);
+  suppressed.clear();
+#else
   auto candidate = delta_list.begin();
   while (size() > target_size) {
-    const TraceDelta &td = *candidate;
+    TraceDelta &td = *candidate;
     if (!td.IsEdge() && td.point.GetTime() < recent_time) {
-      EraseInside(candidate);
+      EraseInside(td);
       candidate = delta_list.begin(); // find new top
       modified = true;
     } else {
@@ -141,6 +190,7 @@ Trace::EraseDelta(const unsigned target_size, const Time recent) noexcept
       // suppressed removal, skip it.
     }
   }
+#endif
 
   return modified;
 }
@@ -156,10 +206,7 @@ Trace::EraseEarlierThan(const Time p_time) noexcept
     auto ci = chronological_list.begin();
     TraceDelta &td = *ci;
     chronological_list.erase(ci);
-
-    auto i = delta_list.find(td);
-    assert(i != delta_list.end());
-    delta_list.erase_and_dispose(i, MakeDisposer());
+    DisposeDelta(td);
 
     --cached_size;
   } while (!empty() && GetFront().point.GetTime() < p_time);
@@ -184,10 +231,7 @@ Trace::EraseLaterThan(const Time min_time) noexcept
     TraceDelta &td = GetBack();
 
     chronological_list.erase(chronological_list.iterator_to(td));
-
-    auto i = delta_list.find(td);
-    assert(i != delta_list.end());
-    delta_list.erase_and_dispose(i, MakeDisposer());
+    DisposeDelta(td);
 
     --cached_size;
   }
@@ -204,12 +248,19 @@ Trace::EraseLaterThan(const Time min_time) noexcept
 void
 Trace::EraseStart(TraceDelta &td)
 {
+#ifdef TRACE_HEAP
+  td.elim_distance = null_delta;
+  td.elim_time = null_time;
+
+  delta_list.update(td);
+#else
   delta_list.erase(delta_list.iterator_to(td));
 
   td.elim_distance = null_delta;
   td.elim_time = null_time;
 
   delta_list.insert(td);
+#endif
 }
 
 void
@@ -263,6 +314,8 @@ Trace::push_back(const TracePoint &point)
     UpdateDelta(*std::prev(chronological_list.iterator_to(*td)));
 
   ++append_serial;
+
+  memory_usage.Update(cached_size * sizeof(TraceDelta), cached_size);
 }
 
 unsigned
@@ -366,69 +419,22 @@ Trace::GetPoints(TracePointVector& iov) const
   std::copy(begin(), end(), std::back_inserter(iov));
 }
 
-template<typename I>
-class PointerIterator {
-  I i;
-
-public:
-  typedef typename I::iterator_category iterator_category;
-  typedef typename I::pointer value_type;
-  typedef typename I::pointer *pointer;
-  typedef value_type &reference;
-  typedef typename I::difference_type difference_type;
-
-  PointerIterator() = default;
-  explicit PointerIterator(I _i):i(_i) {}
-
-  PointerIterator<I> &operator--() {
-    --i;
-    return *this;
-  }
-
-  PointerIterator<I> &operator++() {
-    ++i;
-    return *this;
-  }
-
-  typename I::pointer operator*() {
-    return &*i;
-  }
-
-  bool operator==(const PointerIterator<I> &other) const {
-    return i == other.i;
-  }
-
-  bool operator!=(const PointerIterator<I> &other) const {
-    return i != other.i;
-  }
-};
-
-void
-Trace::GetPoints(TracePointerVector &v) const
-{
-  v.clear();
-  v.reserve(size());
-  std::copy(PointerIterator<decltype(begin())>(begin()),
-            PointerIterator<decltype(end())>(end()),
-            std::back_inserter(v));
-}
-
-bool
-Trace::SyncPoints(TracePointerVector &v) const
+const TraceSnapshot &
+Trace::GetSnapshot() const
 {
-  assert(v.size() <= size());
-
-  if (v.size() == size())
-    /* no news */
-    return false;
+  if (snapshot.modify_serial != modify_serial ||
+      snapshot.size() > size()) {
+    snapshot.Clear();
+    snapshot.Reserve(max_size);
+    snapshot.modify_serial = modify_serial;
+  }
 
-  v.reserve(size());
+  if (snapshot.size() < size())
+    for (auto i = std::prev(end(), size() - snapshot.size()); i != end(); ++i)
+      snapshot.Append(*i);
 
-  PointerIterator<decltype(end())> e(end());
-  std::copy(std::prev(e, size() - v.size()), e,
-            std::back_inserter(v));
-  assert(v.size() == size());
-  return true;
+  assert(snapshot.size() == size());
+  return snapshot;
 }
 
 void
@@ -25,24 +25,33 @@ Copyright_License {
 #define TRACE_HPP
 
 #include "Point.hpp"
+#include "Snapshot.hpp"
 #include "util/NonCopyable.hpp"
 #include "util/Sanitizer.hxx"
 #include "util/SliceAllocator.hxx"
 #include "util/Serial.hpp"
+#ifdef TRACE_HEAP
+#include "util/IntrusiveHeap.hpp"
+#endif
 #include "Geo/Flat/TaskProjection.hpp"
 #include "time/Stamp.hpp"
+#include "system/MemoryAccounting.hpp"
 
 #include <boost/intrusive/list.hpp>
+#ifndef TRACE_HEAP
 #include <boost/intrusive/set.hpp>
+#endif
 
 #include <algorithm>
 #include <cassert>
 #include <type_traits>
+#ifdef TRACE_HEAP
+#include <vector>
+#endif
 
 #include <stdlib.h>
 
 class TracePointVector;
-class TracePointerVector;
 
 /**
  * This class uses a smart thinning algorithm to limit the number of items
@@ -53,13 +62,21 @@ class TracePointerVector;
  * the candidate point removed.  In this version, time differences is also a
  * secondary factor, such that thinning attempts to remove points such that,
  * for equal distance ranking, smaller time step details are removed first.
+ *
+ * The ranking is kept in a binary heap (#IntrusiveHeap).  Building
+ * with TRACE_HEAP=n selects the older balanced tree instead, which
+ * retains exactly the same points, but needs more memory and time.
  */
 class Trace : private NonCopyable
 {
   using Time = TracePoint::Time;
 
   struct TraceDelta
+#ifdef TRACE_HEAP
+    : IntrusiveHeapHook,
+#else
     : boost::intrusive::set_base_hook<boost::intrusive::link_mode<boost::intrusive::normal_link>>,
+#endif
       boost::intrusive::list_base_hook<boost::intrusive::link_mode<boost::intrusive::normal_link>> {
 
     /**
@@ -114,11 +131,9 @@ class Trace : private NonCopyable
 
     TraceDelta(const TracePoint &p_last, const TracePoint &p,
                const TracePoint &p_next)
-      :point(p),
-       elim_time(TimeMetric(p_last, p, p_next)),
-       elim_distance(DistanceMetric(p_last, p, p_next)),
-       delta_distance(p.FlatDistanceTo(p_last))
+      :point(p)
     {
+      Update(p_last, p_next);
       assert(elim_distance != null_delta);
     }
 
@@ -130,9 +145,13 @@ class Trace : private NonCopyable
     }
 
     void Update(const TracePoint &p_last, const TracePoint &p_next) {
-      elim_time = TimeMetric(p_last, point, p_next);
-      elim_distance = DistanceMetric(p_last, point, p_next);
+      /* the distance to the previous point is used by both metrics;
+         calculate it only once */
       delta_distance = point.FlatDistanceTo(p_last);
+      elim_time = TimeMetric(p_last, point, p_next);
+      elim_distance = DistanceMetric(delta_distance,
+                                     point.FlatDistanceTo(p_next),
+                                     p_last.FlatDistanceTo(p_next));
     }
 
     /**
@@ -140,18 +159,16 @@ class Trace : private NonCopyable
      * if this node is removed.  This metric provides for Douglas-Peuker
      * thinning.
      *
-     * @param last Point previous in time to this node
-     * @param node This node
-     * @param next Point succeeding this node
+     * @param d_last distance from the previous point to this node
+     * @param d_next distance from this node to the next point
+     * @param d_rem distance from the previous to the next point
      *
      * @return Distance error if this node is thinned
      */
-    static unsigned DistanceMetric(const TracePoint &last,
-                                   const TracePoint &node,
-                                   const TracePoint &next) {
-      const int d_this = last.FlatDistanceTo(node) + node.FlatDistanceTo(next);
-      const int d_rem = last.FlatDistanceTo(next);
-      return abs(d_this - d_rem);
+    static unsigned DistanceMetric(unsigned d_last, unsigned d_next,
+                                   unsigned d_rem) noexcept {
+      const int d_this = d_last + d_next;
+      return abs(d_this - (int)d_rem);
     }
 
     /**
@@ -172,11 +189,15 @@ class Trace : private NonCopyable
     }
   };
 
+#ifdef TRACE_HEAP
+  using DeltaList = IntrusiveHeap<TraceDelta, TraceDelta::DeltaRankOp>;
+#else
   /* using multiset, not because we need multiple values (we don't),
      but to avoid set's overhead for duplicate elimination */
   typedef boost::intrusive::multiset<TraceDelta,
                                      boost::intrusive::compare<TraceDelta::DeltaRankOp>,
                                      boost::intrusive::constant_time_size<false>> DeltaList;
+#endif
 
   typedef boost::intrusive::list<TraceDelta,
                                  boost::intrusive::constant_time_size<false>> ChronologicalList;
@@ -198,6 +219,14 @@ class Trace : private NonCopyable
   ChronologicalList chronological_list;
   unsigned cached_size;
 
+#ifdef TRACE_HEAP
+  /**
+   * Scratch buffer for EraseDelta().  It is a member so its
+   * allocation is reused by the next thinning pass.
+   */
+  std::vector<TraceDelta *> suppressed;
+#endif
+
   TaskProjection task_projection;
 
   const Time max_time;
@@ -210,6 +239,14 @@ class Trace : private NonCopyable
 
   Serial append_serial, modify_serial;
 
+  /**
+   * A lazily updated copy for the contest solvers, see GetSnapshot().
+   */
+  mutable TraceSnapshot snapshot;
+
+  [[no_unique_address]]
+  MemoryAccounting::Reporter memory_usage{MemoryAccounting::Account::TRACE};
+
   template<typename Alloc>
   struct Disposer {
     Alloc &alloc;
@@ -271,13 +308,18 @@ protected:
 
   /**
    * Erase a non-edge item from delta list and tree, updating
-   * deltas in the process.  This Invalidates the calling iterator.
-   *
-   * @param it Item to erase
-   * @param tree Tree to remove from
+   * deltas in the process.  This Invalidates iterators pointing to
+   * it.
    *
+   * @param td Item to erase
    */
-  void EraseInside(DeltaList::iterator it);
+  void EraseInside(TraceDelta &td);
+
+  /**
+   * Remove the item from the delta list and free it.  It must have
+   * been removed from the chronological list already.
+   */
+  void DisposeDelta(TraceDelta &td) noexcept;
 
   /**
    * Erase elements based on delta metric until the size is
@@ -392,18 +434,15 @@ public:
   void GetPoints(TracePointVector& iov) const;
 
   /**
-   * Retrieve a vector of trace points sorted by time
-   */
-  void GetPoints(TracePointerVector &v) const;
-
-  /**
-   * Update the given #TracePointVector after points were appended to
-   * this object.  This must not be called after thinning has
-   * occurred, see GetModifySerial().
+   * Returns a #TraceSnapshot of all points.  It is updated first if
+   * this object has been modified since the last call: appended
+   * points are copied, and after thinning the whole snapshot is
+   * rebuilt.  The reference may be shared by all consumers.
    *
-   * @return true if new points were added
+   * Since this updates the (mutable) snapshot, it must only be used
+   * by the thread which edits this object.
    */
-  bool SyncPoints(TracePointerVector &v) const;
+  const TraceSnapshot &GetSnapshot() const;
 
   /**
    * Fill the vector with trace points, not before #min_time, minimum
@@ -23,6 +23,12 @@
 #include "Waypoints.hpp"
 #include "util/AllocatedArray.hxx"
 #include "util/StringUtil.hpp"
+#include "util/StringAPI.hxx"
+
+#include <algorithm>
+#include <iterator>
+
+#include <cassert>
 
 static constexpr std::size_t NORMALIZE_BUFFER_SIZE = 4096;
 
@@ -93,6 +99,204 @@ Waypoints::WaypointNameTree::Remove(const WaypointPtr &wp)
   }
 }
 
+/**
+ * Append the normalised name and short name of the waypoint to the
+ * string, in the record format of #WaypointNameIndex.
+ */
+static void
+AppendNameRecord(tstring &dest, const Waypoint &wp)
+{
+  const auto Append = [&dest](const tstring &src){
+    const std::size_t position = dest.size();
+    dest.resize(position + src.length() + 1);
+    NormalizeSearchString(dest.data() + position, src.c_str());
+    dest.resize(position + StringLength(dest.c_str() + position));
+  };
+
+  Append(wp.name);
+
+  if (!wp.shortname.empty()) {
+    dest.push_back(_T(' '));
+    Append(wp.shortname);
+  }
+
+  dest.push_back(_T('\n'));
+}
+
+inline void
+Waypoints::WaypointNameIndex::Add(WaypointPtr wp)
+{
+  assert(!stale);
+
+  entries.push_back({names.size(), wp});
+  AppendNameRecord(names, *wp);
+}
+
+inline void
+Waypoints::WaypointNameIndex::Visit(const TCHAR *normalised,
+                                    const WaypointVisitor &visitor) const
+{
+  assert(!stale);
+
+  const TCHAR *const begin = names.c_str();
+  for (const TCHAR *p = begin;
+       !StringIsEmpty(p) && (p = StringFind(p, normalised)) != nullptr;) {
+    const std::size_t position = p - begin;
+    const auto i = std::upper_bound(entries.begin(), entries.end(), position,
+                                    [](std::size_t value, const Entry &e){
+                                      return value < e.position;
+                                    });
+    assert(i != entries.begin());
+    visitor(std::prev(i)->waypoint);
+
+    /* skip the rest of this record, to visit each waypoint only
+       once */
+    p = StringFind(p, _T('\n'));
+    assert(p != nullptr);
+    ++p;
+  }
+}
+
+/**
+ * Which waypoints does Waypoints::WaypointLOD keep when there is not
+ * enough room?  Higher is more important.
+ */
+[[gnu::pure]]
+static unsigned
+GetDrawImportance(const Waypoint &wp) noexcept
+{
+  if (wp.flags.home)
+    return 5;
+
+  if (wp.flags.watched)
+    return 4;
+
+  if (wp.IsAirport())
+    return 3;
+
+  if (wp.IsLandable())
+    return 2;
+
+  if (wp.IsTurnpoint())
+    return 1;
+
+  return 0;
+}
+
+/**
+ * Integer division rounding towards negative infinity, to get the
+ * cell index of a flat coordinate.
+ */
+static constexpr int
+FloorDiv(long long a, int b) noexcept
+{
+  return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
+
+void
+Waypoints::WaypointLOD::Build(const WaypointTree &tree,
+                              const FlatProjection &projection)
+{
+  Clear();
+
+  /* all waypoints, most important first; the id makes the order
+     deterministic */
+  std::vector<WaypointPtr> ranked(tree.begin(), tree.end());
+  std::sort(ranked.begin(), ranked.end(),
+            [](const WaypointPtr &a, const WaypointPtr &b){
+              const unsigned ia = GetDrawImportance(*a);
+              const unsigned ib = GetDrawImportance(*b);
+              return ia != ib ? ia > ib : a->id < b->id;
+            });
+
+  struct Candidate {
+    int cell_x, cell_y;
+    std::size_t rank;
+  };
+
+  /* indices into "ranked" of the waypoints on the previous level, in
+     ascending order; the most important waypoint of a cell on this
+     level is also the most important one of its (smaller) cell on
+     the previous level, therefore only those need to be looked at */
+  std::vector<std::size_t> current(ranked.size());
+  for (std::size_t i = 0; i < current.size(); ++i)
+    current[i] = i;
+
+  std::vector<Candidate> candidates;
+  double cell_size = MIN_CELL_SIZE;
+  for (auto &level : levels) {
+    level.cell_size = std::max(int(cell_size /
+                                   projection.GetApproximateScale()), 1);
+    cell_size *= 2;
+
+    candidates.clear();
+    for (const std::size_t rank : current) {
+      const FlatGeoPoint &p = ranked[rank]->flat_location;
+      candidates.push_back({FloorDiv(p.x, level.cell_size),
+                            FloorDiv(p.y, level.cell_size),
+                            rank});
+    }
+
+    /* stable sort: within a cell, the most important waypoint comes
+       first */
+    std::stable_sort(candidates.begin(), candidates.end(),
+                     [](const Candidate &a, const Candidate &b){
+                       return a.cell_y != b.cell_y
+                         ? a.cell_y < b.cell_y
+                         : a.cell_x < b.cell_x;
+                     });
+    candidates.erase(std::unique(candidates.begin(), candidates.end(),
+                                 [](const Candidate &a, const Candidate &b){
+                                   return a.cell_x == b.cell_x &&
+                                     a.cell_y == b.cell_y;
+                                 }),
+                     candidates.end());
+
+    level.entries.reserve(candidates.size());
+    current.clear();
+    for (const auto &i : candidates) {
+      level.entries.push_back({i.cell_x, i.cell_y, ranked[i.rank]});
+      current.push_back(i.rank);
+    }
+
+    std::sort(current.begin(), current.end());
+  }
+}
+
+void
+Waypoints::WaypointLOD::Visit(unsigned level_index, FlatGeoPoint center,
+                              unsigned range,
+                              const WaypointVisitor &visitor) const
+{
+  assert(!stale);
+  assert(level_index < N_LEVELS);
+
+  const Level &level = levels[level_index];
+  const int x0 = FloorDiv((long long)center.x - range, level.cell_size);
+  const int x1 = FloorDiv((long long)center.x + range, level.cell_size);
+  const int y0 = FloorDiv((long long)center.y - range, level.cell_size);
+  const int y1 = FloorDiv((long long)center.y + range, level.cell_size);
+  const long long range_squared = (long long)range * range;
+
+  for (int y = y0; y <= y1; ++y) {
+    auto i = std::lower_bound(level.entries.begin(), level.entries.end(),
+                              std::make_pair(y, x0),
+                              [](const Entry &e, std::pair<int, int> cell){
+                                return e.cell_y != cell.first
+                                  ? e.cell_y < cell.first
+                                  : e.cell_x < cell.second;
+                              });
+
+    for (; i != level.entries.end() && i->cell_y == y && i->cell_x <= x1;
+         ++i) {
+      const FlatGeoPoint &p = i->waypoint->flat_location;
+      const long long dx = p.x - center.x, dy = p.y - center.y;
+      if (dx * dx + dy * dy <= range_squared)
+        visitor(i->waypoint);
+    }
+  }
+}
+
 Waypoints::Waypoints()
   :next_id(1),
    home(nullptr)
@@ -102,19 +306,30 @@ Waypoints::Waypoints()
 void
 Waypoints::Optimise()
 {
-  if (waypoint_tree.IsEmpty() || waypoint_tree.HaveBounds())
-    /* empty or already optimised */
-    return;
+  if (name_index.IsStale()) {
+    name_index.Clear();
+    for (const auto &i : waypoint_tree)
+      name_index.Add(i);
+  }
 
-  task_projection.Update();
+  memory_usage.Update(size() * sizeof(Waypoint), size());
 
-  for (auto &i : waypoint_tree) {
-    // TODO: eliminate this const_cast hack
-    Waypoint &w = const_cast<Waypoint &>(*i);
-    w.Project(task_projection);
+  /* unless empty or already optimised */
+  if (!waypoint_tree.IsEmpty() && !waypoint_tree.HaveBounds()) {
+    task_projection.Update();
+
+    for (auto &i : waypoint_tree) {
+      // TODO: eliminate this const_cast hack
+      Waypoint &w = const_cast<Waypoint &>(*i);
+      w.Project(task_projection);
+    }
+
+    waypoint_tree.Optimise();
   }
 
-  waypoint_tree.Optimise();
+  /* the levels are built from the projected locations */
+  if (lod.IsStale())
+    lod.Build(waypoint_tree, task_projection);
 }
 
 void
@@ -137,6 +352,9 @@ Waypoints::Append(WaypointPtr wp)
 
   waypoint_tree.Add(wp);
   name_tree.Add(wp);
+  if (!name_index.IsStale())
+    name_index.Add(wp);
+  lod.Invalidate();
 
   ++serial;
 }
@@ -261,6 +479,65 @@ Waypoints::VisitWithinRange(const GeoPoint &loc, const double range,
   waypoint_tree.VisitWithinRange(point, mrange, visitor);
 }
 
+void
+Waypoints::VisitWithinRange(const GeoPoint &loc, const double range,
+                            const double spacing,
+                            WaypointVisitor visitor) const
+{
+  if (IsEmpty())
+    return; // nothing to do
+
+  if (spacing < WaypointLOD::MIN_CELL_SIZE || lod.IsStale()) {
+    VisitWithinRange(loc, range, std::move(visitor));
+    return;
+  }
+
+  unsigned level = 0;
+  for (double cell_size = WaypointLOD::MIN_CELL_SIZE * 2;
+       cell_size <= spacing && level + 1 < WaypointLOD::N_LEVELS;
+       cell_size *= 2)
+    ++level;
+
+  const FlatGeoPoint flat_location = task_projection.ProjectInteger(loc);
+  const unsigned mrange = task_projection.ProjectRangeInteger(loc, range);
+
+  lod.Visit(level, flat_location, mrange, visitor);
+}
+
+void
+Waypoints::VisitNearest(const GeoPoint &loc, double range,
+                        unsigned max_results, WaypointVisitor visitor) const
+{
+  if (IsEmpty())
+    return; // nothing to do
+
+  const FlatGeoPoint flat_location = task_projection.ProjectInteger(loc);
+  const WaypointTree::Point point(flat_location.x, flat_location.y);
+  const unsigned mrange = task_projection.ProjectRangeInteger(loc, range);
+
+  waypoint_tree.VisitNearest(point, mrange, max_results, visitor);
+}
+
+void
+Waypoints::VisitNearestIf(const GeoPoint &loc, double range,
+                          unsigned max_results,
+                          bool (*predicate)(const Waypoint &),
+                          WaypointVisitor visitor) const
+{
+  if (IsEmpty())
+    return; // nothing to do
+
+  const FlatGeoPoint flat_location = task_projection.ProjectInteger(loc);
+  const WaypointTree::Point point(flat_location.x, flat_location.y);
+  const unsigned mrange = task_projection.ProjectRangeInteger(loc, range);
+
+  waypoint_tree.VisitNearestIf(point, mrange, max_results,
+                               [predicate](const WaypointPtr &ptr){
+                                 return predicate(*ptr);
+                               },
+                               visitor);
+}
+
 void
 Waypoints::VisitNamePrefix(const TCHAR *prefix,
                            WaypointVisitor visitor) const
@@ -268,14 +545,43 @@ Waypoints::VisitNamePrefix(const TCHAR *prefix,
   name_tree.VisitNormalisedPrefix(prefix, visitor);
 }
 
+void
+Waypoints::VisitNameSubstring(const TCHAR *text,
+                              WaypointVisitor visitor) const
+{
+  if (StringLength(text) >= NORMALIZE_BUFFER_SIZE)
+    return;
+
+  TCHAR normalized[NORMALIZE_BUFFER_SIZE];
+  NormalizeSearchString(normalized, text);
+
+  if (!name_index.IsStale()) {
+    name_index.Visit(normalized, visitor);
+    return;
+  }
+
+  /* the index is being rebuilt by the next Optimise() call; until
+     then, scan all waypoints */
+  tstring record;
+  for (const auto &i : waypoint_tree) {
+    record.clear();
+    AppendNameRecord(record, *i);
+    if (StringFind(record.c_str(), normalized) != nullptr)
+      visitor(i);
+  }
+}
+
 void
 Waypoints::Clear()
 {
   ++serial;
   home = nullptr;
   name_tree.Clear();
+  name_index.Clear();
+  lod.Clear();
   waypoint_tree.clear();
   next_id = 1;
+  memory_usage.Update(0, 0);
 }
 
 void
@@ -291,6 +597,8 @@ Waypoints::Erase(WaypointPtr &&wp)
   assert(f.first != waypoint_tree.end());
 
   name_tree.Remove(std::move(wp));
+  name_index.Invalidate();
+  lod.Invalidate();
   waypoint_tree.erase(f.first);
   ++serial;
 }
@@ -305,6 +613,8 @@ Waypoints::EraseUserMarkers()
           home = nullptr;
 
         name_tree.Remove(wp);
+        name_index.Invalidate();
+        lod.Invalidate();
         ++serial;
         return true;
       } else
@@ -318,6 +628,8 @@ Waypoints::Replace(const WaypointPtr &orig, Waypoint &&replacement)
   assert(!waypoint_tree.IsEmpty());
 
   name_tree.Remove(orig);
+  name_index.Invalidate();
+  lod.Invalidate();
 
   replacement.id = orig->id;
 
@@ -330,7 +642,7 @@ Waypoints::Replace(const WaypointPtr &orig, Waypoint &&replacement)
       ScheduleOptimise();
   }
 
-  WaypointPtr new_ptr(new Waypoint(std::move(replacement)));
+  WaypointPtr new_ptr = std::make_shared<Waypoint>(std::move(replacement));
   name_tree.Add(new_ptr);
 
   auto f = waypoint_tree.FindNearestIf(waypoint_tree.GetPosition(orig), 0,
@@ -25,11 +25,15 @@
 #include "util/RadixTree.hpp"
 #include "util/QuadTree.hxx"
 #include "util/Serial.hpp"
+#include "util/tstring.hpp"
 #include "Ptr.hpp"
 #include "Waypoint.hpp"
 #include "Geo/Flat/TaskProjection.hpp"
+#include "system/MemoryAccounting.hpp"
 
+#include <array>
 #include <functional>
+#include <vector>
 
 using WaypointVisitor = std::function<void(const WaypointPtr &)>;
 
@@ -69,6 +73,128 @@ class Waypoints {
     void Remove(const WaypointPtr &wp);
   };
 
+  /**
+   * An index for substring searches on waypoint names.  The
+   * normalised names of all waypoints are stored in one contiguous
+   * string, which can be scanned much faster than the waypoint
+   * objects themselves.
+   */
+  class WaypointNameIndex {
+    struct Entry {
+      /**
+       * The position of this waypoint's record in #names.
+       */
+      std::size_t position;
+
+      WaypointPtr waypoint;
+    };
+
+    /**
+     * One record per waypoint: the normalised name, optionally
+     * followed by a space and the normalised short name, terminated
+     * by a newline.
+     */
+    tstring names;
+
+    std::vector<Entry> entries;
+
+    /**
+     * Has a waypoint been removed or replaced since the index was
+     * built?  Until it is rebuilt, the index is empty and must not be
+     * used.
+     */
+    bool stale = false;
+
+  public:
+    bool IsStale() const noexcept {
+      return stale;
+    }
+
+    void Clear() noexcept {
+      names.clear();
+      entries.clear();
+      stale = false;
+    }
+
+    void Invalidate() noexcept {
+      Clear();
+      stale = true;
+    }
+
+    void Add(WaypointPtr wp);
+    void Visit(const TCHAR *normalised,
+               const WaypointVisitor &visitor) const;
+  };
+
+  /**
+   * Importance-ranked subsets of all waypoints for drawing the map
+   * at small scales ("level of detail").  Level n contains only the
+   * most important waypoint of each square grid cell whose edge is
+   * #MIN_CELL_SIZE meters shifted left by n; therefore each level is
+   * a subset of the previous one.
+   */
+  class WaypointLOD {
+  public:
+    static constexpr unsigned N_LEVELS = 12;
+
+    /**
+     * The cell edge of level 0 [m].
+     */
+    static constexpr double MIN_CELL_SIZE = 500;
+
+  private:
+    struct Entry {
+      int cell_x, cell_y;
+
+      WaypointPtr waypoint;
+    };
+
+    struct Level {
+      /**
+       * The cell edge in flat units.
+       */
+      int cell_size;
+
+      /**
+       * Sorted by row and column.
+       */
+      std::vector<Entry> entries;
+    };
+
+    std::array<Level, N_LEVELS> levels;
+
+    /**
+     * Has a waypoint been added, removed or replaced since the
+     * levels were built?  Until they are rebuilt, they are empty and
+     * must not be used.
+     */
+    bool stale = false;
+
+  public:
+    bool IsStale() const noexcept {
+      return stale;
+    }
+
+    void Clear() noexcept {
+      for (auto &i : levels)
+        i.entries.clear();
+      stale = false;
+    }
+
+    void Invalidate() noexcept {
+      Clear();
+      stale = true;
+    }
+
+    void Build(const WaypointTree &tree, const FlatProjection &projection);
+
+    /**
+     * @param level the level index; must be below #N_LEVELS
+     */
+    void Visit(unsigned level, FlatGeoPoint center, unsigned range,
+               const WaypointVisitor &visitor) const;
+  };
+
   /**
    * This gets incremented each time the object is modified.
    */
@@ -78,10 +204,15 @@ class Waypoints {
 
   WaypointTree waypoint_tree;
   WaypointNameTree name_tree;
+  WaypointNameIndex name_index;
+  WaypointLOD lod;
   TaskProjection task_projection;
 
   WaypointPtr home;
 
+  [[no_unique_address]]
+  MemoryAccounting::Reporter memory_usage{MemoryAccounting::Account::WAYPOINT};
+
 public:
   typedef WaypointTree::const_iterator const_iterator;
 
@@ -118,7 +249,7 @@ public:
    * @param wp Waypoint to add to internal store
    */
   WaypointPtr Append(Waypoint &&wp) {
-    WaypointPtr ptr(new Waypoint(std::move(wp)));
+    auto ptr = std::make_shared<Waypoint>(std::move(wp));
     Append(ptr);
     return ptr;
   }
@@ -299,12 +430,59 @@ public:
   void VisitWithinRange(const GeoPoint &loc, double range,
                         WaypointVisitor visitor) const;
 
+  /**
+   * Like VisitWithinRange(), but skip less important waypoints
+   * (e.g. turnpoints next to an airfield), so the visited waypoints
+   * are roughly the specified distance apart.  This is meant for
+   * drawing the map at small scales.  Waypoints which are home,
+   * watched, airfields or other landables are preferred, in this
+   * order.
+   *
+   * Until Optimise() is called after a modification, this visits
+   * all waypoints within range.
+   *
+   * @param spacing the minimum distance between two visited
+   * waypoints [m]
+   */
+  void VisitWithinRange(const GeoPoint &loc, double range, double spacing,
+                        WaypointVisitor visitor) const;
+
+  /**
+   * Call visitor function on up to #max_results waypoints within
+   * the range, ordered by ascending (flat) distance from the search
+   * location.
+   *
+   * @param loc Location from which to search
+   * @param range Distance in meters of search radius
+   * @param max_results the maximum number of waypoints to visit
+   * @param visitor Visitor to be called on the nearest waypoints
+   */
+  void VisitNearest(const GeoPoint &loc, double range, unsigned max_results,
+                    WaypointVisitor visitor) const;
+
+  /**
+   * Like VisitNearest(), but only waypoints matching the predicate
+   * are considered.
+   */
+  void VisitNearestIf(const GeoPoint &loc, double range,
+                      unsigned max_results,
+                      bool (*predicate)(const Waypoint &),
+                      WaypointVisitor visitor) const;
+
   /**
    * Call visitor function on waypoints with the specified name
    * prefix.
    */
   void VisitNamePrefix(const TCHAR *prefix, WaypointVisitor visitor) const;
 
+  /**
+   * Call visitor function on waypoints whose name or short name
+   * contains the specified text.  Like VisitNamePrefix(), the
+   * comparison ignores case and all characters which are not
+   * alphanumeric.
+   */
+  void VisitNameSubstring(const TCHAR *text, WaypointVisitor visitor) const;
+
   /**
    * Returns a set of possible characters following the specified
    * prefix.
@@ -26,13 +26,50 @@ Copyright_License {
 #include "NMEA/Info.hpp"
 #include "Geo/GeoVector.hpp"
 
+inline const FlarmComputer::CachedName &
+FlarmComputer::LookupName(FlarmId id, TimeStamp now) noexcept
+{
+  auto [i, inserted] = names.try_emplace(id);
+  CachedName &cached = i->second;
+  if (inserted) {
+    const TCHAR *name = FlarmDetails::LookupCallsign(id);
+    if (name != nullptr)
+      cached.name = name;
+  }
+
+  cached.last_seen = now;
+  return cached;
+}
+
+inline void
+FlarmComputer::CleanUpNames(TimeStamp now) noexcept
+{
+  constexpr FloatDuration MAX_AGE = std::chrono::minutes{1};
+
+  for (auto i = names.begin(); i != names.end();)
+    if (!i->second.last_seen.IsDefined() ||
+        now - i->second.last_seen > MAX_AGE)
+      i = names.erase(i);
+    else
+      ++i;
+}
+
 void
 FlarmComputer::Process(FlarmData &flarm, const FlarmData &last_flarm,
                        const NMEAInfo &basic)
 {
   // Cleanup old calculation instances
-  if (basic.time_available)
+  if (basic.time_available) {
     flarm_calculations.CleanUp(basic.time);
+    CleanUpNames(basic.time);
+  }
+
+  // the callsigns may have been modified
+  if (const unsigned serial = FlarmDetails::GetSerial();
+      serial != names_serial) {
+    names.clear();
+    names_serial = serial;
+  }
 
   // if (FLARM data is available)
   if (!flarm.IsDetected())
@@ -65,10 +102,13 @@ FlarmComputer::Process(FlarmData &flarm, const FlarmData &last_flarm,
   for (auto &traffic : flarm.traffic.list) {
     // if we don't know the target's name yet
     if (!traffic.HasName()) {
-      // lookup the name of this target's id
-      const TCHAR *fname = FlarmDetails::LookupCallsign(traffic.id);
-      if (fname != NULL)
-        traffic.name = fname;
+      // lookup the name of this target's id (cached)
+      const auto &cached =
+        LookupName(traffic.id, basic.time_available
+                   ? basic.time
+                   : TimeStamp::Undefined());
+      if (!cached.name.empty())
+        traffic.name = cached.name;
     }
 
     // Calculate distance
@@ -155,4 +195,6 @@ FlarmComputer::Process(FlarmData &flarm, const FlarmData &last_flarm,
         traffic.speed = last_traffic->speed;
     }
   }
+
+  flarm.traffic.UpdateGrid();
 }
@@ -25,6 +25,11 @@ Copyright_License {
 #define XCSOAR_FLARM_COMPUTER_HPP
 
 #include "FLARM/FlarmCalculations.hpp"
+#include "FLARM/FlarmId.hpp"
+#include "time/Stamp.hpp"
+#include "util/StaticString.hxx"
+
+#include <map>
 
 struct FlarmData;
 struct NMEAInfo;
@@ -32,6 +37,28 @@ struct NMEAInfo;
 class FlarmComputer {
   FlarmCalculations flarm_calculations;
 
+  struct CachedName {
+    /**
+     * The callsign, or an empty string if the target is not in any
+     * database.
+     */
+    StaticString<10> name;
+
+    TimeStamp last_seen;
+  };
+
+  /**
+   * The results of FlarmDetails::LookupCallsign(), so the databases
+   * are searched only once for each new target, and not on every
+   * update.
+   */
+  std::map<FlarmId, CachedName> names;
+
+  /**
+   * The FlarmDetails::GetSerial() value #names belongs to.
+   */
+  unsigned names_serial = 0;
+
 public:
   /**
    * Calculates location, altitude, average climb speed and
@@ -39,6 +66,10 @@ public:
    */
   void Process(FlarmData &flarm, const FlarmData &last_flarm,
                const NMEAInfo &basic);
+
+private:
+  const CachedName &LookupName(FlarmId id, TimeStamp now) noexcept;
+  void CleanUpNames(TimeStamp now) noexcept;
 };
 
 #endif
@@ -27,8 +27,11 @@ Copyright_License {
 #include "FLARM/FlarmId.hpp"
 #include "util/StringCompare.hxx"
 
+#include <atomic>
 #include <cassert>
 
+static std::atomic<unsigned> serial;
+
 const FlarmNetRecord *
 FlarmDetails::LookupRecord(FlarmId id)
 {
@@ -62,7 +65,11 @@ FlarmDetails::AddSecondaryItem(FlarmId id, const TCHAR *name)
   assert(id.IsDefined());
   assert(traffic_databases != nullptr);
 
-  return traffic_databases->flarm_names.Set(id, name);
+  if (!traffic_databases->flarm_names.Set(id, name))
+    return false;
+
+  Modified();
+  return true;
 }
 
 unsigned
@@ -75,3 +82,15 @@ FlarmDetails::FindIdsByCallSign(const TCHAR *cn, FlarmId array[],
 
   return traffic_databases->FindIdsByName(cn, array, size);
 }
+
+unsigned
+FlarmDetails::GetSerial() noexcept
+{
+  return serial.load(std::memory_order_relaxed);
+}
+
+void
+FlarmDetails::Modified() noexcept
+{
+  serial.fetch_add(1, std::memory_order_relaxed);
+}
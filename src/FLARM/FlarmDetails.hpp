@@ -69,6 +69,21 @@ namespace FlarmDetails
 
   unsigned
   FindIdsByCallSign(const TCHAR *cn, FlarmId array[], unsigned size);
+
+  /**
+   * Returns a number which changes whenever a callsign may have
+   * changed, e.g. after AddSecondaryItem().  Callers which cache the
+   * results of LookupCallsign() shall discard them then.  This
+   * function is thread-safe.
+   */
+  unsigned
+  GetSerial() noexcept;
+
+  /**
+   * Announce that the databases have been modified or replaced.
+   */
+  void
+  Modified() noexcept;
 }
 
 #endif
@@ -23,7 +23,9 @@ Copyright_License {
 
 #include "FlarmNetDatabase.hpp"
 #include "util/StringUtil.hpp"
+#include "util/StringAPI.hxx"
 
+#include <algorithm>
 #include <cassert>
 
 void
@@ -34,21 +36,89 @@ FlarmNetDatabase::Insert(const FlarmNetRecord &record)
     /* ignore malformed records */
     return;
 
-  map.insert(std::make_pair(id, record));
+  if (!records.empty() && !(records.back().first < id))
+    sorted = false;
+
+  records.emplace_back(id, record);
+}
+
+void
+FlarmNetDatabase::Sort()
+{
+  if (!sorted) {
+    /* stable, so the first of several records with the same id
+       survives */
+    std::stable_sort(records.begin(), records.end(),
+                     [](const auto &a, const auto &b){
+                       return a.first < b.first;
+                     });
+
+    records.erase(std::unique(records.begin(), records.end(),
+                              [](const auto &a, const auto &b){
+                                return a.first == b.first;
+                              }),
+                  records.end());
+
+    sorted = true;
+  }
+
+  records.shrink_to_fit();
+
+  callsign_index.resize(records.size());
+  for (unsigned i = 0; i < records.size(); ++i)
+    callsign_index[i] = i;
+
+  std::stable_sort(callsign_index.begin(), callsign_index.end(),
+                   [this](unsigned a, unsigned b){
+                     return StringCompare(records[a].second.callsign,
+                                          records[b].second.callsign) < 0;
+                   });
 }
 
 const FlarmNetRecord *
-FlarmNetDatabase::FindFirstRecordByCallSign(const TCHAR *cn) const
+FlarmNetDatabase::FindRecordById(FlarmId id) const
 {
-  for (const auto &i : map) {
-    assert(i.first.IsDefined());
+  assert(sorted);
+
+  auto i = std::lower_bound(records.begin(), records.end(), id,
+                            [](const auto &item, FlarmId id){
+                              return item.first < id;
+                            });
+  return i != records.end() && i->first == id
+    ? &i->second
+    : nullptr;
+}
 
-    const FlarmNetRecord &record = i.second;
-    if (StringIsEqual(record.callsign, cn))
-      return &record;
-  }
+std::pair<std::vector<unsigned>::const_iterator,
+          std::vector<unsigned>::const_iterator>
+FlarmNetDatabase::FindCallSign(const TCHAR *cn) const noexcept
+{
+  assert(sorted);
+  assert(callsign_index.size() == records.size());
 
-  return NULL;
+  struct Compare {
+    const RecordVector &records;
+
+    bool operator()(unsigned a, const TCHAR *b) const noexcept {
+      return StringCompare(records[a].second.callsign, b) < 0;
+    }
+
+    bool operator()(const TCHAR *a, unsigned b) const noexcept {
+      return StringCompare(a, records[b].second.callsign) < 0;
+    }
+  };
+
+  return std::equal_range(callsign_index.begin(), callsign_index.end(),
+                          cn, Compare{records});
+}
+
+const FlarmNetRecord *
+FlarmNetDatabase::FindFirstRecordByCallSign(const TCHAR *cn) const
+{
+  const auto range = FindCallSign(cn);
+  return range.first != range.second
+    ? &records[*range.first].second
+    : nullptr;
 }
 
 unsigned
@@ -58,13 +128,9 @@ FlarmNetDatabase::FindRecordsByCallSign(const TCHAR *cn,
 {
   unsigned count = 0;
 
-  for (const auto &i : map) {
-    assert(i.first.IsDefined());
-
-    const FlarmNetRecord &record = i.second;
-    if (StringIsEqual(record.callsign, cn))
-      array[count++] = &record;
-  }
+  const auto range = FindCallSign(cn);
+  for (auto i = range.first; i != range.second && count < size; ++i)
+    array[count++] = &records[*i].second;
 
   return count;
 }
@@ -75,13 +141,9 @@ FlarmNetDatabase::FindIdsByCallSign(const TCHAR *cn, FlarmId array[],
 {
   unsigned count = 0;
 
-  for (const auto &i : map) {
-    assert(i.first.IsDefined());
-
-    const FlarmNetRecord &record = i.second;
-    if (StringIsEqual(record.callsign, cn))
-      array[count++] = i.first;
-  }
+  const auto range = FindCallSign(cn);
+  for (auto i = range.first; i != range.second && count < size; ++i)
+    array[count++] = records[*i].first;
 
   return count;
 }
@@ -28,39 +28,63 @@ Copyright_License {
 #include "FlarmNetRecord.hpp"
 #include "util/Compiler.h"
 
-#include <map>
+#include <utility>
+#include <vector>
 #include <tchar.h>
 
 /**
  * An in-memory representation of the FlarmNet.org database.
+ *
+ * The records are stored in a contiguous array sorted by FLARM id,
+ * which is much smaller than a std::map with its per-node overhead,
+ * and there is an index sorted by callsign.  After inserting all
+ * records, Sort() must be called before looking anything up.
  */
 class FlarmNetDatabase {
-  typedef std::map<FlarmId, FlarmNetRecord> RecordMap;
-  RecordMap map;
+  typedef std::vector<std::pair<FlarmId, FlarmNetRecord>> RecordVector;
+  RecordVector records;
+
+  /**
+   * Indexes into #records, sorted by callsign (and by id within one
+   * callsign).
+   */
+  std::vector<unsigned> callsign_index;
+
+  /**
+   * Is #records sorted, and is #callsign_index up to date?
+   */
+  bool sorted = true;
 
 public:
   bool IsEmpty() const {
-    return map.empty();
+    return records.empty();
   }
 
   void Clear() {
-    map.clear();
+    records.clear();
+    callsign_index.clear();
+    sorted = true;
   }
 
+  /**
+   * Add a record.  If there are several records with the same id,
+   * only the first one is used.  Call Sort() after the last one.
+   */
   void Insert(const FlarmNetRecord &record);
 
+  /**
+   * Sort the records and build the callsign index.  This must be
+   * called after Insert(), before any of the lookup methods.
+   */
+  void Sort();
+
   /**
    * Finds a FLARMNetRecord object based on the given FLARM id
    * @param id FLARM id
    * @return FLARMNetRecord object
    */
   gcc_pure
-  const FlarmNetRecord *FindRecordById(FlarmId id) const {
-    auto i = map.find(id);
-    return i != map.end()
-      ? &i->second
-      : NULL;
-  }
+  const FlarmNetRecord *FindRecordById(FlarmId id) const;
 
   /**
    * Finds a FLARMNetRecord object based on the given Callsign
@@ -76,13 +100,23 @@ public:
   unsigned FindIdsByCallSign(const TCHAR *cn, FlarmId array[],
                              unsigned size) const;
 
-  RecordMap::const_iterator begin() const {
-    return map.begin();
+  RecordVector::const_iterator begin() const {
+    return records.begin();
   }
 
-  RecordMap::const_iterator end() const {
-    return map.end();
+  RecordVector::const_iterator end() const {
+    return records.end();
   }
+
+private:
+  /**
+   * Returns the range of #callsign_index which matches the given
+   * callsign.
+   */
+  gcc_pure
+  std::pair<std::vector<unsigned>::const_iterator,
+            std::vector<unsigned>::const_iterator>
+  FindCallSign(const TCHAR *cn) const noexcept;
 };
 
 #endif
@@ -24,6 +24,7 @@ Copyright_License {
 #include "Glue.hpp"
 #include "Global.hpp"
 #include "TrafficDatabases.hpp"
+#include "FlarmDetails.hpp"
 #include "FlarmNetReader.hpp"
 #include "NameFile.hpp"
 #include "Components.hpp"
@@ -38,6 +39,17 @@ Copyright_License {
 #include "LogFile.hpp"
 #include "Profile/Profile.hpp"
 #include "Profile/ProfileKeys.hpp"
+#include "io/MemoryReader.hxx"
+#include "io/BufferedLineReader.hpp"
+#include "io/async/CoReadFile.hpp"
+#include "io/async/CoRunInThread.hpp"
+#include "io/async/AsioThread.hpp"
+#include "io/async/GlobalAsioThread.hpp"
+#include "co/InjectTask.hxx"
+#include "thread/Mutex.hxx"
+#include "ui/event/Notify.hpp"
+
+#include <optional>
 
 /**
  * Loads the FLARMnet file
@@ -73,6 +85,121 @@ try {
   LogError(std::current_exception());
 }
 
+/**
+ * Reloads the FLARMnet file in the background after the user has
+ * picked a different one: the file is read and parsed without
+ * blocking the UI or the #MergeThread, and the new database is
+ * swapped in by the main thread when it is complete.
+ */
+class FlarmNetReloader final {
+  Co::InjectTask task{asio_thread->GetEventLoop()};
+
+  UI::Notify notify{[this]{ OnNotify(); }};
+
+  /**
+   * The parsed database, waiting to be picked up by OnNotify().
+   * Protected by #mutex.
+   */
+  Mutex mutex;
+  std::optional<FlarmNetDatabase> result;
+
+  /**
+   * Files larger than this are certainly not FLARMnet files.
+   */
+  static constexpr std::size_t MAX_SIZE = 16 * 1024 * 1024;
+
+public:
+  ~FlarmNetReloader() noexcept {
+    Cancel();
+  }
+
+  /**
+   * Start loading the file, cancelling the previous load (if any).
+   */
+  void Start(AllocatedPath &&path) noexcept {
+    Cancel();
+    task.Start(Run(std::move(path)), BIND_THIS_METHOD(OnCompletion));
+  }
+
+  void Cancel() noexcept {
+    task.Cancel();
+    notify.ClearNotification();
+
+    const std::lock_guard lock{mutex};
+    result.reset();
+  }
+
+private:
+  Co::InvokeTask Run(AllocatedPath path);
+
+  /**
+   * Called in the asio thread when the coroutine has finished.
+   */
+  void OnCompletion(std::exception_ptr error) noexcept {
+    if (error)
+      LogError(error, "Failed to load FLARMnet file");
+    else
+      notify.SendNotification();
+  }
+
+  /**
+   * Called in the main thread after a successful load.
+   */
+  void OnNotify() noexcept;
+};
+
+static FlarmNetReloader *flarm_net_reloader;
+
+Co::InvokeTask
+FlarmNetReloader::Run(AllocatedPath path)
+{
+  auto &event_loop = task.GetEventLoop();
+
+  const auto data = co_await CoReadFile(event_loop, std::move(path),
+                                        MAX_SIZE);
+
+  /* parsing may take a while on slow devices, so it doesn't occupy
+     the asio thread either */
+  auto db = co_await CoRunInThread<FlarmNetDatabase>{
+    event_loop,
+    [&data](const std::atomic_bool &){
+      MemoryReader reader{ConstBuffer<std::byte>{data.data(), data.size()}};
+      BufferedLineReader line_reader{reader};
+
+      FlarmNetDatabase db;
+      unsigned num_records = FlarmNetReader::LoadFile(line_reader, db);
+      if (num_records > 0)
+        LogFormat("%u FLARMnet ids found", num_records);
+      return db;
+    },
+  };
+
+  const std::lock_guard lock{mutex};
+  result = std::move(db);
+}
+
+void
+FlarmNetReloader::OnNotify() noexcept
+{
+  std::optional<FlarmNetDatabase> db;
+
+  {
+    const std::lock_guard lock{mutex};
+    db = std::move(result);
+    result.reset();
+  }
+
+  if (!db || traffic_databases == nullptr)
+    return;
+
+  /* only the short swap happens while the MergeThread is
+     suspended */
+  merge_thread->Suspend();
+  traffic_databases->flarm_net = std::move(*db);
+  FlarmDetails::Modified();
+  merge_thread->Resume();
+}
+
 void
 LoadFlarmDatabases()
 {
@@ -85,6 +212,26 @@ LoadFlarmDatabases()
 void
 ReloadFlarmDatabases()
 {
+  if (traffic_databases != nullptr) {
+    /* only the FLARMnet file is configurable; the other databases
+       are up to date */
+    if (flarm_net_reloader == nullptr)
+      flarm_net_reloader = new FlarmNetReloader();
+
+    auto path = Profile::GetPath(ProfileKeys::FlarmFile);
+    if (path == nullptr) {
+      flarm_net_reloader->Cancel();
+
+      merge_thread->Suspend();
+      traffic_databases->flarm_net.Clear();
+      FlarmDetails::Modified();
+      merge_thread->Resume();
+    } else
+      flarm_net_reloader->Start(std::move(path));
+
+    return;
+  }
+
   traffic_databases = new TrafficDatabases();
 
   /* the MergeThread must be suspended, because it reads the FLARM
@@ -95,6 +242,9 @@ ReloadFlarmDatabases()
   LoadFLARMnet(traffic_databases->flarm_net);
   Profile::Load(Profile::map, traffic_databases->flarm_colors);
 
+  /* discard the MergeThread's cached callsigns */
+  FlarmDetails::Modified();
+
   merge_thread->Resume();
 }
 
@@ -131,6 +281,9 @@ SaveFlarmNames()
 void
 DeinitTrafficGlobals()
 {
+  delete flarm_net_reloader;
+  flarm_net_reloader = nullptr;
+
   delete traffic_databases;
   traffic_databases = nullptr;
 }
@@ -23,6 +23,8 @@ Copyright_License {
 
 #include "List.hpp"
 
+#include <algorithm>
+
 const FlarmTraffic *
 TrafficList::FindMaximumAlert() const
 {
@@ -40,3 +42,74 @@ TrafficList::FindMaximumAlert() const
 
   return alert;
 }
+
+void
+TrafficList::UpdateGrid()
+{
+  std::fill_n(grid_head, GRID_SIZE * GRID_SIZE, 0);
+
+  for (unsigned i = 0; i < list.size(); ++i) {
+    const FlarmTraffic &traffic = list[i];
+    const unsigned cell = GridCoordinate(traffic.relative_north) * GRID_SIZE
+      + GridCoordinate(traffic.relative_east);
+
+    grid_next[i] = grid_head[cell];
+    grid_head[cell] = i + 1;
+  }
+
+  grid_valid = true;
+}
+
+const FlarmTraffic *
+TrafficList::FindNearest(double north, double east) const
+{
+  const FlarmTraffic *nearest = nullptr;
+  double nearest_distance = 0;
+
+  auto check = [&](const FlarmTraffic &traffic){
+    const double distance = hypot(traffic.relative_north - north,
+                                  traffic.relative_east - east);
+    if (nearest == nullptr || distance < nearest_distance) {
+      nearest = &traffic;
+      nearest_distance = distance;
+    }
+  };
+
+  if (!grid_valid) {
+    for (const auto &traffic : list)
+      check(traffic);
+    return nearest;
+  }
+
+  const int row = GridCoordinate(north), column = GridCoordinate(east);
+
+  /* targets in cells outside ring "r" are at least r cells away;
+     this bound does not hold if the position itself is beyond the
+     grid */
+  const double limit = GRID_CELL_SIZE * (GRID_SIZE / 2);
+  const bool inside = fabs(north) < limit && fabs(east) < limit;
+
+  for (int r = 0; r < int(GRID_SIZE); ++r) {
+    for (int y = row - r; y <= row + r; ++y) {
+      if (y < 0 || y >= int(GRID_SIZE))
+        continue;
+
+      /* only the ring's border cells; the interior has already been
+         searched */
+      const int step = y == row - r || y == row + r ? 1 : std::max(2 * r, 1);
+      for (int x = column - r; x <= column + r; x += step) {
+        if (x < 0 || x >= int(GRID_SIZE))
+          continue;
+
+        for (unsigned i = grid_head[y * GRID_SIZE + x];
+             i != 0; i = grid_next[i - 1])
+          check(list[i - 1]);
+      }
+    }
+
+    if (inside && nearest != nullptr && nearest_distance <= r * GRID_CELL_SIZE)
+      break;
+  }
+
+  return nearest;
+}
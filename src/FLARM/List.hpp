@@ -28,14 +28,47 @@ Copyright_License {
 #include "NMEA/Validity.hpp"
 #include "util/TrivialArray.hxx"
 
+#include <algorithm>
 #include <type_traits>
 
+#include <math.h>
+#include <stdint.h>
+
 /**
  * This class keeps track of the traffic objects received from a
  * FLARM.
  */
 struct TrafficList {
-  static constexpr size_t MAX_COUNT = 25;
+  /**
+   * The maximum number of targets.  This is large enough for
+   * competition grids and for traffic merged from other sources.
+   * Positions in #list are stored as uint8_t in the index tables
+   * below.
+   */
+  static constexpr size_t MAX_COUNT = 64;
+
+  static constexpr unsigned INDEX_BITS = 7;
+
+  /**
+   * The number of buckets in the hashed #FlarmId index; at least
+   * twice #MAX_COUNT to keep the probe sequences short.
+   */
+  static constexpr unsigned INDEX_SIZE = 1u << INDEX_BITS;
+
+  /**
+   * The number of rows and columns of the spatial grid, which is
+   * centered on the own aircraft.  Targets beyond the grid are
+   * stored in the outermost cells.
+   */
+  static constexpr unsigned GRID_SIZE = 8;
+
+  /**
+   * The edge length of one grid cell [m].
+   */
+  static constexpr double GRID_CELL_SIZE = 2000;
+
+  static_assert(MAX_COUNT < 256, "index tables are uint8_t");
+  static_assert(INDEX_SIZE >= 2 * MAX_COUNT, "index too small");
 
   /**
    * Time stamp of the latest modification to this object.
@@ -50,10 +83,37 @@ struct TrafficList {
   /** Flarm traffic information */
   TrivialArray<FlarmTraffic, MAX_COUNT> list;
 
+  /**
+   * Open addressing hash table mapping #FlarmId to positions in
+   * #list.  Each bucket contains the position plus one; zero means
+   * empty.
+   */
+  uint8_t index[INDEX_SIZE];
+
+  /**
+   * The first target in each grid cell (position in #list plus one;
+   * zero means empty).  Only valid if #grid_valid is set.
+   */
+  uint8_t grid_head[GRID_SIZE * GRID_SIZE];
+
+  /**
+   * The next target in the same grid cell (position plus one; zero
+   * terminates the chain).
+   */
+  uint8_t grid_next[MAX_COUNT];
+
+  /**
+   * Does the spatial grid reflect the current relative positions?
+   * Queries fall back to a linear scan if not.
+   */
+  bool grid_valid;
+
   void Clear() {
     modified.Clear();
     new_traffic.Clear();
     list.clear();
+    std::fill_n(index, INDEX_SIZE, 0);
+    grid_valid = false;
   }
 
   bool IsEmpty() const {
@@ -68,7 +128,7 @@ struct TrafficList {
     // Add unique traffic from 'add' list
     for (auto &traffic : add.list) {
       if (FindTraffic(traffic.id) == nullptr) {
-        FlarmTraffic * new_traffic = AllocateTraffic();
+        FlarmTraffic * new_traffic = AllocateTraffic(traffic.id);
         if (new_traffic == nullptr)
           return;
         *new_traffic = traffic;
@@ -80,9 +140,18 @@ struct TrafficList {
     modified.Expire(clock, std::chrono::minutes(5));
     new_traffic.Expire(clock, std::chrono::minutes(1));
 
-    for (unsigned i = list.size(); i-- > 0;)
-      if (!list[i].Refresh(clock))
+    bool removed = false;
+    for (unsigned i = list.size(); i-- > 0;) {
+      if (!list[i].Refresh(clock)) {
         list.quick_remove(i);
+        removed = true;
+      }
+    }
+
+    if (removed) {
+      RebuildIndex();
+      grid_valid = false;
+    }
   }
 
   unsigned GetActiveTrafficCount() const {
@@ -96,11 +165,8 @@ struct TrafficList {
    * @return the FLARM_TRAFFIC pointer, NULL if not found
    */
   FlarmTraffic *FindTraffic(FlarmId id) {
-    for (auto &traffic : list)
-      if (traffic.id == id)
-        return &traffic;
-
-    return NULL;
+    const int i = FindPosition(id);
+    return i >= 0 ? &list[i] : nullptr;
   }
 
   /**
@@ -110,11 +176,8 @@ struct TrafficList {
    * @return the FLARM_TRAFFIC pointer, NULL if not found
    */
   const FlarmTraffic *FindTraffic(FlarmId id) const {
-    for (const auto &traffic : list)
-      if (traffic.id == id)
-        return &traffic;
-
-    return NULL;
+    const int i = FindPosition(id);
+    return i >= 0 ? &list[i] : nullptr;
   }
 
   /**
@@ -146,14 +209,22 @@ struct TrafficList {
   }
 
   /**
-   * Allocates a new FLARM_TRAFFIC object from the array.
+   * Allocates a new FLARM_TRAFFIC object from the array and adds it
+   * to the index.  The caller must not modify its id.
    *
+   * @param id the FLARM id, which must not be in the list already
    * @return the FLARM_TRAFFIC pointer, NULL if the array is full
    */
-  FlarmTraffic *AllocateTraffic() {
-    return list.full()
-      ? NULL
-      : &list.append();
+  FlarmTraffic *AllocateTraffic(FlarmId id) {
+    if (list.full())
+      return nullptr;
+
+    FlarmTraffic &traffic = list.append();
+    traffic.Clear();
+    traffic.id = id;
+    IndexInsert(list.size() - 1);
+    grid_valid = false;
+    return &traffic;
   }
 
   /**
@@ -197,6 +268,102 @@ struct TrafficList {
   unsigned TrafficIndex(const FlarmTraffic *t) const {
     return t - list.begin();
   }
+
+  /**
+   * Mark the spatial grid stale after the relative position of a
+   * target has changed.
+   */
+  void InvalidateGrid() {
+    grid_valid = false;
+  }
+
+  /**
+   * Sort all targets into the spatial grid according to their
+   * relative position.  Call this after the positions have been
+   * updated.
+   */
+  void UpdateGrid();
+
+  /**
+   * Invoke the visitor for each target within the given distance of
+   * a position relative to the own aircraft.
+   *
+   * @param north the relative position [m]
+   * @param east the relative position [m]
+   * @param radius the search radius [m]
+   */
+  template<typename V>
+  void VisitWithin(double north, double east, double radius,
+                   V &&visitor) const {
+    auto check = [&](const FlarmTraffic &traffic){
+      if (hypot(traffic.relative_north - north,
+                traffic.relative_east - east) <= radius)
+        visitor(traffic);
+    };
+
+    if (!grid_valid) {
+      for (const auto &traffic : list)
+        check(traffic);
+      return;
+    }
+
+    const unsigned min_row = GridCoordinate(north - radius);
+    const unsigned max_row = GridCoordinate(north + radius);
+    const unsigned min_column = GridCoordinate(east - radius);
+    const unsigned max_column = GridCoordinate(east + radius);
+
+    for (unsigned row = min_row; row <= max_row; ++row)
+      for (unsigned column = min_column; column <= max_column; ++column)
+        for (unsigned i = grid_head[row * GRID_SIZE + column];
+             i != 0; i = grid_next[i - 1])
+          check(list[i - 1]);
+  }
+
+  /**
+   * Finds the target nearest to a position relative to the own
+   * aircraft.  Returns NULL if the list is empty.
+   */
+  const FlarmTraffic *FindNearest(double north, double east) const;
+
+private:
+  [[gnu::const]]
+  static unsigned IndexBucket(FlarmId id) {
+    /* Fibonacci hashing spreads the sequential ids of one
+       manufacturer over the table */
+    return (id.Hash() * 2654435761u) >> (32 - INDEX_BITS);
+  }
+
+  int FindPosition(FlarmId id) const {
+    for (unsigned bucket = IndexBucket(id);;
+         bucket = (bucket + 1) % INDEX_SIZE) {
+      const unsigned i = index[bucket];
+      if (i == 0)
+        return -1;
+
+      if (list[i - 1].id == id)
+        return i - 1;
+    }
+  }
+
+  void IndexInsert(unsigned position) {
+    unsigned bucket = IndexBucket(list[position].id);
+    while (index[bucket] != 0)
+      bucket = (bucket + 1) % INDEX_SIZE;
+
+    index[bucket] = position + 1;
+  }
+
+  void RebuildIndex() {
+    std::fill_n(index, INDEX_SIZE, 0);
+    for (unsigned i = 0; i < list.size(); ++i)
+      IndexInsert(i);
+  }
+
+  [[gnu::const]]
+  static unsigned GridCoordinate(double distance) {
+    const int i = (int)floor(distance / GRID_CELL_SIZE) + int(GRID_SIZE / 2);
+    return std::clamp(i, 0, int(GRID_SIZE) - 1);
+  }
 };
 
 static_assert(std::is_trivial<TrafficList>::value, "type is not trivial");
@@ -52,6 +52,21 @@ void FlightStatistics::Reset() {
   vario_cruise_histogram.Reset(-7.5,7.5);
 }
 
+void
+FlightStatistics::CopyFrom(const FlightStatistics &src) noexcept
+{
+  const std::scoped_lock lock{mutex, src.mutex};
+
+  thermal_average = src.thermal_average;
+  altitude = src.altitude;
+  altitude_base = src.altitude_base;
+  altitude_ceiling = src.altitude_ceiling;
+  task_speed = src.task_speed;
+  altitude_terrain = src.altitude_terrain;
+  vario_circling_histogram = src.vario_circling_histogram;
+  vario_cruise_histogram = src.vario_cruise_histogram;
+}
+
 void
 FlightStatistics::StartTask()
 {
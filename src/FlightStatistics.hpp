@@ -62,6 +62,12 @@ public:
                     double vario, bool circling) noexcept;
 
   void Reset();
+
+  /**
+   * Copy all data from another instance.  Both mutexes are locked by
+   * this method.
+   */
+  void CopyFrom(const FlightStatistics &src) noexcept;
 };
 
 #endif
@@ -39,6 +39,7 @@ Copyright_License {
 #ifdef ENABLE_OPENGL
 #include "ui/canvas/opengl/Scope.hpp"
 #include "ui/canvas/opengl/VertexPointer.hpp"
+#include "ui/canvas/opengl/Statistics.hpp"
 #endif
 
 #ifdef ANDROID
@@ -482,8 +483,8 @@ WndForm::OnPaint(Canvas &canvas)
       3, 7, 0, 7, 4, 0,
     };
 
-    glDrawElements(GL_TRIANGLES, ARRAY_SIZE(indices),
-                   GL_UNSIGNED_BYTE, indices);
+    OpenGL::DrawElements(GL_TRIANGLES, ARRAY_SIZE(indices),
+                         GL_UNSIGNED_BYTE, indices);
   }
 #endif
 
@@ -161,6 +161,9 @@ ListControl::DrawItems(Canvas &canvas,
 
   unsigned last_item = std::min(length, end);
 
+  if (item_renderer != nullptr && start < last_item)
+    item_renderer->OnPrepareItems(start, last_item);
+
   const bool focused = !HasCursorKeys() || HasFocus();
 
   for (unsigned i = start; i < last_item; i++) {
@@ -38,6 +38,17 @@ typedef void (*ListItemRendererFunction)(Canvas &canvas, const PixelRect rc,
 
 class ListItemRenderer {
 public:
+  /**
+   * Called before a range of items is painted.  Implementations may
+   * use this to build expensive per-item data lazily, i.e. only for
+   * items which actually scroll into view, instead of building it
+   * for the whole list in advance.
+   *
+   * @param start the index of the first item to be painted
+   * @param end the index after the last item to be painted
+   */
+  virtual void OnPrepareItems(unsigned start, unsigned end) noexcept {}
+
   virtual void OnPaintItem(Canvas &canvas, const PixelRect rc,
                            unsigned idx) noexcept = 0;
 };
@@ -263,11 +263,85 @@ GaugeVario::RenderBackground(Canvas &canvas, const PixelRect &rc) noexcept
   }
 }
 
+GaugeVario::State
+GaugeVario::GetState() const noexcept
+{
+  const auto &settings = Settings();
+  const auto &calculated = Calculated();
+
+  State state{};
+  state.settings = settings;
+  state.unit = Units::current.vertical_speed_unit;
+
+  state.needle = NeedlePos(Basic().brutto_vario);
+  state.sink = NeedlePos(calculated.sink_rate);
+
+  if (settings.show_average_needle)
+    state.average_needle = NeedlePos(calculated.circling
+                                     ? calculated.average
+                                     : calculated.netto_average);
+
+  if (settings.show_thermal_average_needle)
+    state.thermal_average_needle =
+      NeedlePos(calculated.current_thermal.lift_rate);
+
+  state.circling = calculated.circling;
+
+  if (settings.show_average)
+    state.average = iround(Units::ToUserVSpeed(calculated.circling
+                                               ? calculated.average
+                                               : calculated.netto_average) * 10);
+
+  if (settings.show_mc) {
+    state.mc = iround(Units::ToUserVSpeed(GetGlidePolar().GetMC()) * 10);
+    state.auto_mc = GetComputerSettings().task.auto_mc;
+  }
+
+  if (settings.show_gross)
+    state.gross = iround(Clamp(Units::ToUserVSpeed(Basic().brutto_vario),
+                               -99.9, 99.9) * 10);
+
+  if (settings.show_speed_to_fly) {
+    state.speed_to_fly_available = Basic().airspeed_available &&
+      Basic().total_energy_vario_available;
+
+    if (state.speed_to_fly_available && calculated.flight.flying &&
+        (!Basic().gps.simulator || !calculated.circling)) {
+      const double v_diff = Clamp(calculated.V_stf - Basic().indicated_airspeed,
+                                  -DELTA_V_LIMIT, DELTA_V_LIMIT);
+      state.v_diff = iround(v_diff / DELTA_V_STEP);
+    }
+  }
+
+  state.climb_icon = Basic().switch_state.flight_mode ==
+    SwitchState::FlightMode::CIRCLING;
+
+  if (settings.show_ballast)
+    state.ballast = iround(GetGlidePolar().GetBallast() * 100);
+
+  if (settings.show_bugs)
+    state.bugs = iround((1 - GetComputerSettings().polar.bugs) * 100);
+
+  return state;
+}
+
+void
+GaugeVario::InvalidateIfChanged() noexcept
+{
+  if (state_valid && GetState() == painted_state)
+    return;
+
+  Invalidate();
+}
+
 void
 GaugeVario::OnPaintBuffer(Canvas &canvas) noexcept
 {
   const PixelRect rc = GetClientRect();
 
+  painted_state = GetState();
+  state_valid = true;
+
   if (!IsPersistent() || background_dirty) {
     RenderBackground(canvas, rc);
     background_dirty = false;
@@ -425,22 +499,23 @@ GaugeVario::RenderZero(Canvas &canvas) noexcept
 }
 
 int
-GaugeVario::ValueToNeedlePos(double Value) noexcept
+GaugeVario::NeedlePos(double value) noexcept
 {
   constexpr double degrees_per_unit =
     double(GAUGEVARIOSWEEP) / GAUGEVARIORANGE;
 
-  int i;
+  return Clamp(iround(value * degrees_per_unit), int(gmin), int(gmax));
+}
 
+int
+GaugeVario::ValueToNeedlePos(double Value) noexcept
+{
   if (!needle_initialised){
     MakeAllPolygons();
     needle_initialised = true;
   }
 
-
-  i = iround(Value * degrees_per_unit);
-  i = Clamp(i, int(gmin), int(gmax));
-  return i;
+  return NeedlePos(Value);
 }
 
 void
@@ -787,6 +862,7 @@ GaugeVario::OnResize(PixelSize new_size)
   /* trigger reinitialisation */
   background_dirty = true;
   needle_initialised = false;
+  state_valid = false;
 
   average_di.Reset();
   mc_di.Reset();
@@ -110,6 +110,32 @@ class GaugeVario : public AntiFlickerWindow
     }
   };
 
+  /**
+   * Everything the gauge shows, rounded to the displayed precision.
+   * If this has not changed since the last paint, there is nothing
+   * to redraw.
+   */
+  struct State {
+    VarioSettings settings;
+
+    /** needle positions, see ValueToNeedlePos() */
+    int needle, sink, average_needle, thermal_average_needle;
+
+    /** displayed values in 1/10 user units */
+    int average, mc, gross;
+
+    /** speed command in multiples of #DELTA_V_STEP */
+    int v_diff;
+
+    int ballast, bugs;
+
+    Unit unit;
+
+    bool circling, auto_mc, speed_to_fly_available, climb_icon;
+
+    bool operator==(const State &) const noexcept = default;
+  };
+
   const FullBlackboard &blackboard;
 
   const VarioLook &look;
@@ -132,6 +158,13 @@ class GaugeVario : public AntiFlickerWindow
 
   int last_bugs = -1;
 
+  /**
+   * The #State shown by the last OnPaintBuffer() call.  Only valid
+   * if #state_valid is set.
+   */
+  State painted_state;
+  bool state_valid = false;
+
   BulkPixelPoint polys[(gmax * 2 + 1) * 3];
   BulkPixelPoint lines[gmax * 2 + 1];
 
@@ -140,6 +173,12 @@ public:
              ContainerWindow &parent, const VarioLook &look,
              PixelRect rc, const WindowStyle style=WindowStyle()) noexcept;
 
+  /**
+   * Invalidate the window, but only if one of the displayed values
+   * has changed since it was painted last.
+   */
+  void InvalidateIfChanged() noexcept;
+
 protected:
   const MoreData &Basic() const noexcept {
     return blackboard.Basic();
@@ -169,6 +208,9 @@ protected:
   virtual void OnPaintBuffer(Canvas &canvas) noexcept override;
 
 private:
+  [[gnu::pure]]
+  State GetState() const noexcept;
+
   void RenderBackground(Canvas &canvas, const PixelRect &rc) noexcept;
   void RenderZero(Canvas &canvas) noexcept;
   void RenderValue(Canvas &canvas, const LabelValueGeometry &g,
@@ -177,6 +219,8 @@ private:
   void RenderSpeedToFly(Canvas &canvas, int x, int y) noexcept;
   void RenderBallast(Canvas &canvas) noexcept;
   void RenderBugs(Canvas &canvas) noexcept;
+  [[gnu::const]]
+  static int NeedlePos(double value) noexcept;
   int  ValueToNeedlePos(double Value) noexcept;
   void RenderNeedle(Canvas &canvas, int i, bool average, bool clear) noexcept;
   void RenderVarioLine(Canvas &canvas, int i, int sink, bool clear) noexcept;
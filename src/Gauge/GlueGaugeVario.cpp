@@ -48,12 +48,28 @@ void
 GlueGaugeVario::Hide() noexcept
 {
   blackboard.RemoveListener(*this);
+  update_timer.Cancel();
 
   WindowWidget::Hide();
 }
 
+void
+GlueGaugeVario::Update() noexcept
+{
+  update_clock.Update();
+  ((GaugeVario &)GetWindow()).InvalidateIfChanged();
+}
+
 void
 GlueGaugeVario::OnGPSUpdate(const MoreData &basic)
 {
-  ((GaugeVario &)GetWindow()).Invalidate();
+  if (update_timer.IsPending())
+    /* an update is already scheduled */
+    return;
+
+  const auto elapsed = update_clock.Elapsed();
+  if (elapsed.count() < 0 || elapsed >= UPDATE_INTERVAL)
+    Update();
+  else
+    update_timer.Schedule(UPDATE_INTERVAL - elapsed);
 }
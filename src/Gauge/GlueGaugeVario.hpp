@@ -26,6 +26,8 @@ Copyright_License {
 
 #include "Widget/WindowWidget.hpp"
 #include "Blackboard/BlackboardListener.hpp"
+#include "ui/event/Timer.hpp"
+#include "time/PeriodClock.hpp"
 
 struct VarioLook;
 class LiveBlackboard;
@@ -36,9 +38,23 @@ class LiveBlackboard;
  */
 class GlueGaugeVario final
   : public WindowWidget, private NullBlackboardListener {
+  /**
+   * The gauge is updated at most this often, no matter how fast the
+   * vario sends data.
+   */
+  static constexpr std::chrono::steady_clock::duration UPDATE_INTERVAL =
+    std::chrono::milliseconds(200);
+
   LiveBlackboard &blackboard;
   const VarioLook &look;
 
+  PeriodClock update_clock;
+
+  /**
+   * Defers an update which arrived too early after the previous one.
+   */
+  UI::Timer update_timer{[this]{ Update(); }};
+
 public:
   GlueGaugeVario(LiveBlackboard &_blackboard, const VarioLook &_look) noexcept
     :blackboard(_blackboard), look(_look) {}
@@ -48,6 +64,8 @@ public:
   void Hide() noexcept override;
 
 private:
+  void Update() noexcept;
+
   virtual void OnGPSUpdate(const MoreData &basic) override;
 };
 
@@ -59,45 +59,110 @@ ThermalAssistantRenderer::ThermalAssistantRenderer(const ThermalAssistantLook &_
    small(_small),
    direction(Angle::Zero()) {}
 
-void
+/**
+ * The direction of each lift bin on a circle with radius 1, in screen
+ * coordinates before rotation.
+ */
+static const auto &
+GetUnitCircle() noexcept
+{
+  static const auto unit_circle = []{
+    constexpr unsigned n = std::tuple_size<LiftDatabase>();
+    constexpr Angle delta = Angle::FullCircle() / n;
+
+    std::array<FastRotation::Point, n> result;
+    Angle angle = Angle::Zero();
+    for (auto &i : result) {
+      const auto [sine, cosine] = angle.SinCos();
+      i = {cosine, sine};
+      angle += delta;
+    }
+
+    return result;
+  }();
+
+  return unit_circle;
+}
+
+bool
 ThermalAssistantRenderer::Update(const AttitudeState &attitude,
-                               const DerivedInfo &derived)
+                                 const DerivedInfo &derived)
 {
+  const bool changed = derived.circling != circling.circling ||
+    ceil(CalculateMaxLift(derived.lift_database)) !=
+    ceil(CalculateMaxLift(vario.lift_database)) ||
+    (derived.circling &&
+     (attitude.heading != direction ||
+      derived.TurningLeft() != circling.TurningLeft() ||
+      derived.lift_database != vario.lift_database));
+
   direction = attitude.heading;
   circling = (CirclingInfo)derived;
   vario = (VarioInfo)derived;
+
+  return changed;
 }
 
 double
-ThermalAssistantRenderer::CalculateMaxLift() const
+ThermalAssistantRenderer::CalculateMaxLift(const LiftDatabase &lift_database)
+  noexcept
 {
   return std::max(1.,
-                  *std::max_element(vario.lift_database.begin(),
-                                    vario.lift_database.end()));
+                  *std::max_element(lift_database.begin(),
+                                    lift_database.end()));
 }
 
-void
-ThermalAssistantRenderer::CalculateLiftPoints(LiftPoints &lift_points,
-                                              double max_lift) const
+inline Angle
+ThermalAssistantRenderer::GetRotation() const noexcept
 {
-  Angle angle = -direction;
-  constexpr Angle delta = Angle::FullCircle() / unsigned(std::tuple_size<LiftDatabase>());
-
-  for (unsigned i = 0; i < lift_points.size(); i++, angle += delta) {
-    auto sincos = angle.SinCos();
-    double scale = NormalizeLift(vario.lift_database[i], max_lift) * radius;
+  /* when turning right, the circle is mirrored through the middle */
+  Angle rotation = -direction;
+  if (!circling.TurningLeft())
+    rotation += Angle::HalfCircle();
 
-    lift_points[i].x = (int)(sincos.second * scale);
-    lift_points[i].y = (int)(sincos.first * scale);
+  return rotation.AsBearing();
+}
 
-    if (!circling.TurningLeft()) {
-      lift_points[i].x *= -1;
-      lift_points[i].y *= -1;
+void
+ThermalAssistantRenderer::UpdateLiftPoints(double max_lift) noexcept
+{
+  bool radii_changed = false;
+
+  if (max_lift != cached_max_lift || radius != cached_radius) {
+    /* the scale has changed: recalculate all bins */
+    for (unsigned i = 0; i < N_LIFT; ++i)
+      lift_radii[i] = NormalizeLift(vario.lift_database[i], max_lift) * radius;
+
+    cached_lift = vario.lift_database;
+    cached_max_lift = max_lift;
+    cached_radius = radius;
+    radii_changed = true;
+  } else {
+    for (unsigned i = 0; i < N_LIFT; ++i) {
+      if (vario.lift_database[i] != cached_lift[i]) {
+        lift_radii[i] = NormalizeLift(vario.lift_database[i], max_lift) * radius;
+        cached_lift[i] = vario.lift_database[i];
+        radii_changed = true;
+      }
     }
+  }
+
+  const Angle rotation = GetRotation();
+  if (!radii_changed && lift_points_valid &&
+      rotation == projected_rotation && mid == projected_mid)
+    return;
 
-    lift_points[i].x += mid.x;
-    lift_points[i].y += mid.y;
+  const FastRotation r(rotation);
+  const auto &unit_circle = GetUnitCircle();
+  for (unsigned i = 0; i < N_LIFT; ++i) {
+    const auto p = r.Rotate(unit_circle[i]);
+    lift_points[i].x = mid.x + (int)(p.x * lift_radii[i]);
+    lift_points[i].y = mid.y + (int)(p.y * lift_radii[i]);
   }
+
+  projected_rotation = rotation;
+  projected_mid = mid;
+  lift_points_valid = true;
 }
 
 double
@@ -128,10 +193,9 @@ ThermalAssistantRenderer::PaintRadarPlane(Canvas &canvas) const
 }
 
 static void
-DrawCircleLabel(Canvas &canvas, PixelPoint p,
+DrawCircleLabel(Canvas &canvas, PixelPoint p, PixelSize size,
                 BasicStringView<TCHAR> text) noexcept
 {
-  const auto size = canvas.CalcTextSize(text);
   p.x -= size.width / 2;
   p.y -= size.height * 3 / 4;
 
@@ -139,15 +203,30 @@ DrawCircleLabel(Canvas &canvas, PixelPoint p,
 }
 
 static void
-DrawCircleLabelVSpeed(Canvas &canvas, PixelPoint p, double value) noexcept
+DrawCircleLabel(Canvas &canvas, PixelPoint p,
+                BasicStringView<TCHAR> text) noexcept
 {
-  TCHAR buffer[10];
-  FormatUserVerticalSpeed(value, buffer, ARRAY_SIZE(buffer));
-  DrawCircleLabel(canvas, p, buffer);
+  DrawCircleLabel(canvas, p, canvas.CalcTextSize(text), text);
 }
 
 void
-ThermalAssistantRenderer::PaintRadarBackground(Canvas &canvas, double max_lift) const
+ThermalAssistantRenderer::PaintCircleLabel(Canvas &canvas, PixelPoint p,
+                                           CircleLabel &label,
+                                           double value) const
+{
+  if (!label.valid || value != label.value) {
+    FormatUserVerticalSpeed(value, label.text.buffer(),
+                            label.text.capacity());
+    label.size = canvas.CalcTextSize(label.text.c_str());
+    label.value = value;
+    label.valid = true;
+  }
+
+  DrawCircleLabel(canvas, p, label.size, label.text.c_str());
+}
+
+void
+ThermalAssistantRenderer::PaintRadarBackground(Canvas &canvas, double max_lift)
 {
   canvas.SelectHollowBrush();
 
@@ -164,8 +243,10 @@ ThermalAssistantRenderer::PaintRadarBackground(Canvas &canvas, double max_lift)
   canvas.SetBackgroundColor(look.background_color);
   canvas.SetBackgroundOpaque();
 
-  DrawCircleLabelVSpeed(canvas, mid + PixelSize{0u, radius}, max_lift);
-  DrawCircleLabelVSpeed(canvas, mid + PixelSize{0u, radius / 2}, 0);
+  PaintCircleLabel(canvas, mid + PixelSize{0u, radius},
+                   max_lift_label, max_lift);
+  PaintCircleLabel(canvas, mid + PixelSize{0u, radius / 2},
+                   zero_lift_label, 0);
 
   canvas.SetBackgroundTransparent();
 }
@@ -210,12 +291,15 @@ ThermalAssistantRenderer::UpdateLayout(const PixelRect &rc)
 {
   radius = std::min(rc.GetWidth(), rc.GetHeight()) / 2 - padding;
   mid = rc.GetCenter();
+
+  /* the font may have changed */
+  max_lift_label.valid = zero_lift_label.valid = false;
 }
 
 void
 ThermalAssistantRenderer::Paint(Canvas &canvas)
 {
-  double max_lift = ceil(CalculateMaxLift());
+  double max_lift = ceil(CalculateMaxLift(vario.lift_database));
 
   PaintRadarBackground(canvas, max_lift);
   if (!circling.circling) {
@@ -223,8 +307,7 @@ ThermalAssistantRenderer::Paint(Canvas &canvas)
     return;
   }
 
-  LiftPoints lift_points;
-  CalculateLiftPoints(lift_points, max_lift);
+  UpdateLiftPoints(max_lift);
   PaintPoints(canvas, lift_points);
   PaintAdvisor(canvas, lift_points);
 
@@ -26,8 +26,11 @@
 
 #include "NMEA/CirclingInfo.hpp"
 #include "NMEA/VarioInfo.hpp"
+#include "Math/FastRotation.hpp"
 #include "ui/dim/Point.hpp"
+#include "ui/dim/Size.hpp"
 #include "ui/dim/BulkPoint.hpp"
+#include "util/StaticString.hxx"
 
 #include <array>
 
@@ -39,13 +42,25 @@ class Canvas;
 
 class ThermalAssistantRenderer
 {
-  class LiftPoints: public std::array<BulkPixelPoint,
-                                      std::tuple_size<LiftDatabase>::value>
+  static constexpr unsigned N_LIFT = std::tuple_size<LiftDatabase>::value;
+
+  class LiftPoints: public std::array<BulkPixelPoint, N_LIFT>
   {
   public:
     PixelPoint GetAverage() const;
   };
 
+  /**
+   * A circle label whose text and size are only calculated when the
+   * value changes.
+   */
+  struct CircleLabel {
+    StaticString<10> text;
+    PixelSize size;
+    double value;
+    bool valid = false;
+  };
+
 protected:
   const ThermalAssistantLook &look;
 
@@ -68,6 +83,37 @@ protected:
   CirclingInfo circling;
   VarioInfo vario;
 
+  /**
+   * The lift values which #lift_radii was calculated from.
+   */
+  LiftDatabase cached_lift;
+
+  /**
+   * The maximum lift and the circle radius which #lift_radii was
+   * calculated with.  A negative #cached_max_lift means the cache is
+   * empty.
+   */
+  double cached_max_lift = -1;
+  unsigned cached_radius;
+
+  /**
+   * The distance of each lift point from the middle [pixels].  This
+   * is updated only for bins whose lift value has changed.
+   */
+  std::array<double, N_LIFT> lift_radii;
+
+  /**
+   * The screen rotation (heading and turn direction) and the middle
+   * which #lift_points was projected with.
+   */
+  Angle projected_rotation;
+  PixelPoint projected_mid;
+  bool lift_points_valid = false;
+
+  LiftPoints lift_points;
+
+  CircleLabel max_lift_label, zero_lift_label;
+
 public:
   ThermalAssistantRenderer(const ThermalAssistantLook &look,
                            unsigned _padding, bool _small = false);
@@ -81,7 +127,10 @@ public:
     return radius;
   }
 
-  void Update(const AttitudeState &attitude, const DerivedInfo &_derived);
+  /**
+   * @return true if the new data changes the picture
+   */
+  bool Update(const AttitudeState &attitude, const DerivedInfo &_derived);
 
   void UpdateLayout(const PixelRect &rc);
   void Paint(Canvas &canvas);
@@ -99,10 +148,14 @@ protected:
    */
   static double NormalizeLift(double lift, double max_lift);
 
-  void CalculateLiftPoints(LiftPoints &lift_points, double max_lift) const;
-  double CalculateMaxLift() const;
+  Angle GetRotation() const noexcept;
+
+  void UpdateLiftPoints(double max_lift) noexcept;
+  static double CalculateMaxLift(const LiftDatabase &lift_database) noexcept;
   void PaintRadarPlane(Canvas &canvas) const;
-  void PaintRadarBackground(Canvas &canvas, double max_lift) const;
+  void PaintCircleLabel(Canvas &canvas, PixelPoint p,
+                        CircleLabel &label, double value) const;
+  void PaintRadarBackground(Canvas &canvas, double max_lift);
   void PaintPoints(Canvas &canvas, const LiftPoints &lift_points) const;
   void PaintAdvisor(Canvas &canvas, const LiftPoints &lift_points) const;
   void PaintNotCircling(Canvas &canvas) const;
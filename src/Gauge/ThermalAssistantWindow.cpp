@@ -42,8 +42,8 @@ void
 ThermalAssistantWindow::Update(const AttitudeState &attitude,
                                const DerivedInfo &derived)
 {
-  renderer.Update(attitude, derived);
-  Invalidate();
+  if (renderer.Update(attitude, derived))
+    Invalidate();
 }
 
 void
@@ -35,6 +35,8 @@ struct VarioSettings {
   bool show_thermal_average_needle;
 
   void SetDefaults();
+
+  bool operator==(const VarioSettings &) const noexcept = default;
 };
 
 #endif
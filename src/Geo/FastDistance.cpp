@@ -0,0 +1,337 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "FastDistance.hpp"
+#include "GeoPoint.hpp"
+#include "WGS84.hpp"
+#include "Math/Util.hpp"
+
+#include <cassert>
+#include <cmath>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define HAVE_FAST_DISTANCE_SSE2
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+/* NEON on 32 bit ARM lacks double precision vectors */
+#include <arm_neon.h>
+#define HAVE_FAST_DISTANCE_NEON
+#endif
+
+static_assert(sizeof(GeoPoint) == 2 * sizeof(double),
+              "GeoPoint must consist of two plain doubles");
+
+static constexpr double E_SQUARED =
+  WGS84::FLATTENING * (2 - WGS84::FLATTENING);
+
+/**
+ * Radius of curvature in the meridian.
+ */
+[[gnu::const]]
+static double
+MeridianRadius(double sin_lat) noexcept
+{
+  const double w = 1 - E_SQUARED * Square(sin_lat);
+  return WGS84::EQUATOR_RADIUS * (1 - E_SQUARED) / (w * std::sqrt(w));
+}
+
+/**
+ * Radius of curvature in the prime vertical.
+ */
+[[gnu::const]]
+static double
+PrimeVerticalRadius(double sin_lat) noexcept
+{
+  return WGS84::EQUATOR_RADIUS
+    / std::sqrt(1 - E_SQUARED * Square(sin_lat));
+}
+
+namespace {
+
+/**
+ * Terms of the flat-earth approximation which depend only on the
+ * origin.  Cosine and radii at the middle latitude are expanded
+ * around the origin's latitude, so the per-location work is just a
+ * few multiplications and one square root.
+ */
+struct FlatOrigin {
+  double longitude, latitude;
+
+  double cos_lat, sin_lat, half_cos_lat;
+
+  /** meridian radius and its derivative */
+  double m, dm;
+
+  /** prime vertical radius and its derivative */
+  double n, dn;
+
+  explicit FlatOrigin(const GeoPoint &origin) noexcept
+    :longitude(origin.longitude.Radians()),
+     latitude(origin.latitude.Radians()),
+     cos_lat(std::cos(latitude)), sin_lat(std::sin(latitude)),
+     half_cos_lat(cos_lat / 2)
+  {
+    constexpr double delta = 1e-4;
+    const double sin_below = std::sin(latitude - delta);
+    const double sin_above = std::sin(latitude + delta);
+
+    m = MeridianRadius(sin_lat);
+    dm = (MeridianRadius(sin_above) - MeridianRadius(sin_below))
+      / (2 * delta);
+    n = PrimeVerticalRadius(sin_lat);
+    dn = (PrimeVerticalRadius(sin_above) - PrimeVerticalRadius(sin_below))
+      / (2 * delta);
+  }
+
+  /**
+   * Calculate the local east/north offsets (in m) of the given
+   * location.
+   */
+  void Offset(const GeoPoint &p, double &x, double &y) const noexcept {
+    const double dlon = DeltaLongitude(p);
+    const double dlat = p.latitude.Radians() - latitude;
+    const double h = dlat / 2;
+
+    /* cosine of the middle latitude */
+    const double c = cos_lat - sin_lat * h - half_cos_lat * h * h;
+
+    x = dlon * (n + dn * h) * c;
+    y = dlat * (m + dm * h);
+  }
+
+  /**
+   * Calculate the initial bearing to the given location.  The
+   * direction of the flat-earth offset is the mean bearing;
+   * subtract half of the meridian convergence to get the initial
+   * one.
+   */
+  Angle Bearing(const GeoPoint &p) const noexcept {
+    double x, y;
+    Offset(p, x, y);
+    if (x == 0 && y == 0)
+      return Angle::Zero();
+
+    const double dlon = DeltaLongitude(p);
+    const double dlat = p.latitude.Radians() - latitude;
+    const double sin_mid = sin_lat + cos_lat * dlat / 2;
+
+    return (Angle::FromXY(y, x) - Angle::Radians(dlon * sin_mid / 2))
+      .AsBearing();
+  }
+
+private:
+  double DeltaLongitude(const GeoPoint &p) const noexcept {
+    double dlon = p.longitude.Radians() - longitude;
+    if (dlon > M_PI)
+      dlon -= 2 * M_PI;
+    else if (dlon < -M_PI)
+      dlon += 2 * M_PI;
+    return dlon;
+  }
+};
+
+} // anonymous namespace
+
+static void
+FlatDistanceGeneric(const FlatOrigin &o, const GeoPoint *locations,
+                    double *distances, std::size_t n) noexcept
+{
+  for (std::size_t i = 0; i < n; ++i) {
+    double x, y;
+    o.Offset(locations[i], x, y);
+    distances[i] = std::sqrt(x * x + y * y);
+  }
+}
+
+#ifdef HAVE_FAST_DISTANCE_SSE2
+
+static void
+FlatDistanceSSE2(const FlatOrigin &o, const GeoPoint *locations,
+                 double *distances, std::size_t n) noexcept
+{
+  const __m128d longitude = _mm_set1_pd(o.longitude);
+  const __m128d latitude = _mm_set1_pd(o.latitude);
+  const __m128d pi = _mm_set1_pd(M_PI), minus_pi = _mm_set1_pd(-M_PI);
+  const __m128d two_pi = _mm_set1_pd(2 * M_PI);
+  const __m128d half = _mm_set1_pd(0.5);
+  const __m128d cos_lat = _mm_set1_pd(o.cos_lat);
+  const __m128d sin_lat = _mm_set1_pd(o.sin_lat);
+  const __m128d half_cos_lat = _mm_set1_pd(o.half_cos_lat);
+  const __m128d m = _mm_set1_pd(o.m), dm = _mm_set1_pd(o.dm);
+  const __m128d rn = _mm_set1_pd(o.n), dn = _mm_set1_pd(o.dn);
+
+  const double *src = (const double *)locations;
+
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2, src += 4) {
+    /* deinterleave two (longitude, latitude) pairs */
+    const __m128d a = _mm_loadu_pd(src), b = _mm_loadu_pd(src + 2);
+    __m128d dlon = _mm_sub_pd(_mm_unpacklo_pd(a, b), longitude);
+    const __m128d dlat = _mm_sub_pd(_mm_unpackhi_pd(a, b), latitude);
+
+    dlon = _mm_sub_pd(dlon, _mm_and_pd(_mm_cmpgt_pd(dlon, pi), two_pi));
+    dlon = _mm_add_pd(dlon, _mm_and_pd(_mm_cmplt_pd(dlon, minus_pi), two_pi));
+
+    const __m128d h = _mm_mul_pd(dlat, half);
+    const __m128d c = _mm_sub_pd(_mm_sub_pd(cos_lat, _mm_mul_pd(sin_lat, h)),
+                                 _mm_mul_pd(_mm_mul_pd(half_cos_lat, h), h));
+
+    const __m128d x = _mm_mul_pd(_mm_mul_pd(dlon,
+                                            _mm_add_pd(rn, _mm_mul_pd(dn, h))),
+                                 c);
+    const __m128d y = _mm_mul_pd(dlat, _mm_add_pd(m, _mm_mul_pd(dm, h)));
+
+    _mm_storeu_pd(distances + i,
+                  _mm_sqrt_pd(_mm_add_pd(_mm_mul_pd(x, x),
+                                         _mm_mul_pd(y, y))));
+  }
+
+  FlatDistanceGeneric(o, locations + i, distances + i, n - i);
+}
+
+#endif
+
+#ifdef HAVE_FAST_DISTANCE_NEON
+
+static void
+FlatDistanceNEON(const FlatOrigin &o, const GeoPoint *locations,
+                 double *distances, std::size_t n) noexcept
+{
+  const float64x2_t longitude = vdupq_n_f64(o.longitude);
+  const float64x2_t latitude = vdupq_n_f64(o.latitude);
+  const float64x2_t pi = vdupq_n_f64(M_PI), minus_pi = vdupq_n_f64(-M_PI);
+  const float64x2_t two_pi = vdupq_n_f64(2 * M_PI);
+  const float64x2_t half = vdupq_n_f64(0.5);
+  const float64x2_t cos_lat = vdupq_n_f64(o.cos_lat);
+  const float64x2_t sin_lat = vdupq_n_f64(o.sin_lat);
+  const float64x2_t half_cos_lat = vdupq_n_f64(o.half_cos_lat);
+  const float64x2_t m = vdupq_n_f64(o.m), dm = vdupq_n_f64(o.dm);
+  const float64x2_t rn = vdupq_n_f64(o.n), dn = vdupq_n_f64(o.dn);
+  const float64x2_t zero = vdupq_n_f64(0);
+
+  const double *src = (const double *)locations;
+
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2, src += 4) {
+    /* vld2q deinterleaves two (longitude, latitude) pairs */
+    const float64x2x2_t p = vld2q_f64(src);
+    float64x2_t dlon = vsubq_f64(p.val[0], longitude);
+    const float64x2_t dlat = vsubq_f64(p.val[1], latitude);
+
+    dlon = vsubq_f64(dlon, vbslq_f64(vcgtq_f64(dlon, pi), two_pi, zero));
+    dlon = vaddq_f64(dlon, vbslq_f64(vcltq_f64(dlon, minus_pi), two_pi, zero));
+
+    const float64x2_t h = vmulq_f64(dlat, half);
+    const float64x2_t c = vsubq_f64(vsubq_f64(cos_lat, vmulq_f64(sin_lat, h)),
+                                    vmulq_f64(vmulq_f64(half_cos_lat, h), h));
+
+    const float64x2_t x = vmulq_f64(vmulq_f64(dlon,
+                                              vaddq_f64(rn, vmulq_f64(dn, h))),
+                                    c);
+    const float64x2_t y = vmulq_f64(dlat, vaddq_f64(m, vmulq_f64(dm, h)));
+
+    vst1q_f64(distances + i,
+              vsqrtq_f64(vaddq_f64(vmulq_f64(x, x), vmulq_f64(y, y))));
+  }
+
+  FlatDistanceGeneric(o, locations + i, distances + i, n - i);
+}
+
+#endif
+
+static void
+FlatDistance(const FlatOrigin &o, const GeoPoint *locations,
+             double *distances, std::size_t n) noexcept
+{
+#if defined(HAVE_FAST_DISTANCE_SSE2)
+  FlatDistanceSSE2(o, locations, distances, n);
+#elif defined(HAVE_FAST_DISTANCE_NEON)
+  FlatDistanceNEON(o, locations, distances, n);
+#else
+  FlatDistanceGeneric(o, locations, distances, n);
+#endif
+}
+
+/**
+ * Haversine distance on a sphere whose radius is the ellipsoid's
+ * radius of curvature (Euler's formula) at the middle latitude in
+ * the direction of the initial bearing.
+ *
+ * @param bearing_r receives the initial bearing on the sphere
+ */
+[[gnu::pure]]
+static double
+SphereDistanceBearing(const GeoPoint &a, const GeoPoint &b,
+                      Angle &bearing_r) noexcept
+{
+  const auto [sin_dlon, cos_dlon] = (b.longitude - a.longitude).SinCos();
+  const auto [sin_lat1, cos_lat1] = a.latitude.SinCos();
+  const auto [sin_lat2, cos_lat2] = b.latitude.SinCos();
+
+  const double s_lat = (b.latitude - a.latitude).accurate_half_sin();
+  const double s_lon = (b.longitude - a.longitude).accurate_half_sin();
+  const double h = Square(s_lat) + cos_lat1 * cos_lat2 * Square(s_lon);
+
+  const double y = sin_dlon * cos_lat2;
+  const double x = cos_lat1 * sin_lat2 - sin_lat1 * cos_lat2 * cos_dlon;
+  bearing_r = x == 0 && y == 0
+    ? Angle::Zero()
+    : Angle::FromXY(x, y).AsBearing();
+
+  const double sin_mid = std::sin((a.latitude.Radians()
+                                   + b.latitude.Radians()) / 2);
+  const double m = MeridianRadius(sin_mid);
+  const double n = PrimeVerticalRadius(sin_mid);
+
+  const double xy_sq = Square(x) + Square(y);
+  const double radius = xy_sq > 0
+    ? m * n * xy_sq / (n * Square(x) + m * Square(y))
+    : m;
+
+  return 2 * radius * std::asin(std::min(std::sqrt(h), 1.));
+}
+
+void
+FastDistanceBearing(const GeoPoint &origin,
+                    std::span<const GeoPoint> locations,
+                    std::span<double> distances,
+                    std::span<Angle> bearings) noexcept
+{
+  assert(origin.IsValid());
+  assert(distances.size() == locations.size());
+  assert(bearings.empty() || bearings.size() == locations.size());
+
+  const FlatOrigin o(origin);
+
+  FlatDistance(o, locations.data(), distances.data(), locations.size());
+
+  for (std::size_t i = 0; i < locations.size(); ++i) {
+    if (distances[i] > FAST_DISTANCE_FLAT_RANGE) {
+      Angle bearing;
+      distances[i] = SphereDistanceBearing(origin, locations[i], bearing);
+      if (!bearings.empty())
+        bearings[i] = bearing;
+    } else if (!bearings.empty())
+      bearings[i] = o.Bearing(locations[i]);
+  }
+}
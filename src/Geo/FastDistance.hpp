@@ -0,0 +1,71 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*! @file
+ * @brief Fast approximate distances from one origin to many locations
+ *
+ * These functions are meant for loops which need distances to a
+ * large number of locations, e.g. for sorting or filtering.  Short
+ * distances are calculated on a local flat-earth approximation of
+ * the WGS84 ellipsoid (vectorised with SSE2 or NEON where
+ * available), long distances on a sphere with the local Gaussian
+ * radius of curvature.
+ */
+
+#ifndef XCSOAR_GEO_FAST_DISTANCE_HPP
+#define XCSOAR_GEO_FAST_DISTANCE_HPP
+
+#include <span>
+
+struct GeoPoint;
+class Angle;
+
+/**
+ * Distances up to this value (in m) are calculated with the
+ * flat-earth approximation.
+ */
+static constexpr double FAST_DISTANCE_FLAT_RANGE = 50000;
+
+/**
+ * Calculates approximate distances and bearings from one origin to
+ * many locations.
+ *
+ * Compared with the WGS84 geodesic between latitudes -80 and 80
+ * degrees, the relative distance error is below 0.0001 up to
+ * #FAST_DISTANCE_FLAT_RANGE (bearing error below 0.02 degrees),
+ * below 0.0003 up to 1000 km and below 0.006 beyond that (bearing
+ * error below 0.3 degrees).  Note that DistanceBearing() itself may
+ * be off by up to one meter, because its iteration stops early.
+ *
+ * @param distances receives one distance (in m) per location; must
+ * have the same size as #locations
+ * @param bearings receives one bearing per location; may be empty if
+ * the caller is not interested in bearings
+ */
+void
+FastDistanceBearing(const GeoPoint &origin,
+                    std::span<const GeoPoint> locations,
+                    std::span<double> distances,
+                    std::span<Angle> bearings={}) noexcept;
+
+#endif
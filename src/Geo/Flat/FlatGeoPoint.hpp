@@ -25,6 +25,7 @@
 
 #include "Math/Util.hpp"
 #include "Math/Point2D.hpp"
+#include "Math/FastMath.hpp"
 
 #include <type_traits>
 
@@ -43,7 +44,9 @@ struct FlatGeoPoint : IntPoint2D {
    * @return Distance in projected units
    */
   [[gnu::pure]]
-  unsigned Distance(const FlatGeoPoint &sp) const noexcept;
+  unsigned Distance(const FlatGeoPoint &sp) const noexcept {
+    return ihypot(x - sp.x, y - sp.y);
+  }
 
   /**
    * Find squared distance from one point to another
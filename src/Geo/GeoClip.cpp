@@ -23,6 +23,7 @@ Copyright_License {
 
 #include "Geo/GeoClip.hpp"
 
+#include <algorithm>
 #include <cassert>
 
 [[gnu::const]]
@@ -401,6 +402,39 @@ ClipPolygonLatitude(const Angle south, const Angle north, GeoPoint *dest,
   return dest_length;
 }
 
+/**
+ * The bounding box of imported vertices.  It is calculated on the
+ * raw radian values, which allows the compiler to use branch-free
+ * min/max instructions.
+ */
+struct ImportedBounds {
+  double west, east, south, north;
+
+  explicit ImportedBounds(const GeoPoint &pt) noexcept
+    :west(pt.longitude.Native()), east(west),
+     south(pt.latitude.Native()), north(south) {}
+
+  void Extend(const GeoPoint &pt) noexcept {
+    const double longitude = pt.longitude.Native();
+    const double latitude = pt.latitude.Native();
+    west = std::min(west, longitude);
+    east = std::max(east, longitude);
+    south = std::min(south, latitude);
+    north = std::max(north, latitude);
+  }
+};
+
+inline Angle
+GeoClip::ImportLongitudeFast(Angle l) const noexcept
+{
+  /* shortcut for the common case which doesn't need the (out-of-line)
+     Angle::AsDelta() call */
+  const Angle delta = l - GetWest();
+  return delta > -Angle::HalfCircle() && delta <= Angle::HalfCircle()
+    ? delta
+    : delta.AsDelta();
+}
+
 unsigned
 GeoClip::ClipPolygon(GeoPoint *dest,
                      const GeoPoint *src, unsigned src_length) const
@@ -408,21 +442,57 @@ GeoClip::ClipPolygon(GeoPoint *dest,
   if (src_length < 3)
     return 0;
 
+  /* import all vertices and calculate their bounding box in one
+     pass; this determines which of the two clipping stages are
+     needed at all */
   GeoPoint *imported = dest + src_length * 2;
-  for (unsigned i = 0; i < src_length; ++i)
-    imported[i] = ImportPoint(src[i]);
+  imported[0] = GeoPoint(ImportLongitudeFast(src[0].longitude),
+                         src[0].latitude);
+  ImportedBounds bounds(imported[0]);
+  for (unsigned i = 1; i < src_length; ++i) {
+    imported[i] = GeoPoint(ImportLongitudeFast(src[i].longitude),
+                           src[i].latitude);
+    bounds.Extend(imported[i]);
+  }
 
-  GeoPoint *first_stage = dest + src_length;
-  unsigned n = ClipPolygonLongitude(Angle::Zero(), width,
-                                    first_stage, imported, src_length);
-  if (n < 3)
-    return 0;
+  const double clip_east = width.Native();
+  const double clip_south = GetSouth().Native();
+  const double clip_north = GetNorth().Native();
 
-  n = ClipPolygonLatitude(GetSouth(), GetNorth(), dest, first_stage, n);
-  if (n < 3)
+  if (bounds.east < 0 || bounds.west > clip_east ||
+      bounds.north < clip_south || bounds.south > clip_north)
+    /* completely outside */
     return 0;
 
+  const bool clip_longitude = bounds.west < 0 || bounds.east > clip_east;
+  const bool clip_latitude = bounds.south < clip_south ||
+    bounds.north > clip_north;
+
+  const GeoPoint *result = imported;
+  unsigned n = src_length;
+
+  if (clip_longitude) {
+    GeoPoint *first_stage = dest + src_length;
+    n = ClipPolygonLongitude(Angle::Zero(), width,
+                             first_stage, result, n);
+    if (n < 3)
+      return 0;
+
+    result = first_stage;
+  }
+
+  if (clip_latitude) {
+    n = ClipPolygonLatitude(GetSouth(), GetNorth(), dest, result, n);
+    if (n < 3)
+      return 0;
+
+    result = dest;
+  }
+
+  /* this loop may move vertices from the end of the buffer to the
+     front, but the source index is always greater or equal to the
+     destination index */
   for (unsigned i = 0; i < n; ++i)
-    dest[i] = ExportPoint(dest[i]);
+    dest[i] = ExportPoint(result[i]);
   return n;
 }
@@ -51,6 +51,13 @@ protected:
     return (l - GetWest()).AsDelta();
   }
 
+  /**
+   * Same as ImportLongitude(), but with an inline fast path for
+   * values which need no normalisation.
+   */
+  [[gnu::pure]]
+  Angle ImportLongitudeFast(Angle l) const noexcept;
+
   [[gnu::pure]]
   GeoPoint ImportPoint(GeoPoint pt) const {
     return GeoPoint(ImportLongitude(pt.longitude), pt.latitude);
@@ -75,6 +82,15 @@ protected:
                       const GeoPoint &next) const;
 
 public:
+  /**
+   * Is the given rectangle completely inside the bounds?  Shapes
+   * within such a rectangle do not need to be clipped at all.
+   */
+  [[gnu::pure]]
+  bool IsInside(const GeoBounds &interior) const noexcept {
+    return GeoBounds::IsInside(interior);
+  }
+
   /**
    * Makes sure that the line does not exceed the bounds.  This method
    * is not designed to perform strict clipping, it is just here to
@@ -91,7 +107,10 @@ public:
    * here to avoid integer overflows in the graphics drivers.
    *
    * The implementation is a specialization of the Sutherland-Hodgman
-   * algorithm, with only horizontal and vertical bound lines.
+   * algorithm, with only horizontal and vertical bound lines.  A
+   * bounding box of all vertices is calculated first; polygons
+   * which are completely inside or outside skip the clipping stages,
+   * and so does each axis which the polygon does not cross.
    *
    * @param dest a GeoPoint array with enough space for three times
    * src_length
@@ -50,6 +50,8 @@ struct GeoVector {
   GeoVector(double _distance, Angle _bearing)
     :distance(_distance), bearing(_bearing) {}
 
+  constexpr bool operator==(const GeoVector &) const noexcept = default;
+
   /**
    * Constructor given start and end location.  
    * Computes Distance/Bearing internally. 
@@ -29,26 +29,63 @@ Copyright_License {
 
 #include "Geoid.hpp"
 #include "Geo/GeoPoint.hpp"
-#include "Math/Util.hpp"
 
+#include <algorithm>
 #include <cstdint>
 
-#define EGM96SIZE 16200
+/**
+ * The grid has 90 rows (90 degrees north to 88 degrees south) and
+ * 180 columns (0 to 358 degrees east) with a spacing of 2 degrees.
+ * Each value is the separation in meters plus 127.
+ */
+static constexpr int EGM96_ROWS = 90, EGM96_COLUMNS = 180;
 
 extern "C" const uint8_t egm96s_dem[];
 
+static inline int
+GetGridValue(int row, int column) noexcept
+{
+  return (int)egm96s_dem[row * EGM96_COLUMNS + column] - 127;
+}
+
 double
-EGM96::LookupSeparation(const GeoPoint &pt)
+EGM96::SeparationCache::Lookup(const GeoPoint &pt) noexcept
 {
-  int ilat, ilon;
-  ilat = iround((Angle::QuarterCircle() - pt.latitude).Half().Degrees());
-  ilon = iround(pt.longitude.AsBearing().Half().Degrees());
+  /* position in grid units */
+  double y = (Angle::QuarterCircle() - pt.latitude).Half().Degrees();
+  double x = pt.longitude.AsBearing().Half().Degrees();
+
+  /* south of the last row (88 degrees south), use its values */
+  y = std::clamp(y, 0., double(EGM96_ROWS - 1));
+
+  int new_row = std::min((int)y, EGM96_ROWS - 2);
+  int new_column = (int)x % EGM96_COLUMNS;
 
-  int offset = ilat * 180 + ilon;
-  if (offset >= EGM96SIZE)
-    return 0;
-  if (offset < 0)
-    return 0;
+  if (new_row != row || new_column != column) {
+    row = new_row;
+    column = new_column;
 
-  return (int)egm96s_dem[offset] - 127;
+    /* the eastern neighbour wraps around at the antimeridian */
+    const int east = (column + 1) % EGM96_COLUMNS;
+    const int v01 = GetGridValue(row, east);
+    const int v10 = GetGridValue(row + 1, column);
+    const int v11 = GetGridValue(row + 1, east);
+
+    v00 = GetGridValue(row, column);
+    a = v01 - v00;
+    b = v10 - v00;
+    c = v11 - v10 - v01 + v00;
+  }
+
+  x -= column;
+  y -= row;
+
+  return v00 + a * x + b * y + c * x * y;
+}
+
+double
+EGM96::LookupSeparation(const GeoPoint &pt)
+{
+  SeparationCache cache;
+  return cache.Lookup(pt);
 }
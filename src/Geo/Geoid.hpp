@@ -37,6 +37,34 @@ namespace EGM96
    */
   [[gnu::pure]]
   double LookupSeparation(const GeoPoint &pt);
+
+  /**
+   * Remembers the grid cell of the last lookup together with its
+   * bilinear interpolation coefficients.  Consecutive fixes are
+   * nearly always in the same 2 degree cell, so a lookup costs only
+   * a few arithmetic operations.
+   *
+   * This class is not thread-safe; each user owns an instance.
+   */
+  class SeparationCache {
+    /**
+     * The grid position of the cell's north-west corner; -1 if no
+     * cell has been loaded yet.
+     */
+    int row = -1, column = -1;
+
+    /**
+     * The separation is v00 + a*x + b*y + c*x*y, where x and y are
+     * the position within the cell (0..1) eastwards and southwards.
+     */
+    double v00, a, b, c;
+
+  public:
+    /**
+     * Like LookupSeparation(), but reuses the previous cell.
+     */
+    double Lookup(const GeoPoint &pt) noexcept;
+  };
 }
 
 #endif
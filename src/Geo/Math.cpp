@@ -157,18 +157,29 @@ Middle(const GeoPoint &a, const GeoPoint &b) noexcept
   return IntermediatePoint(a, b, distance / 2);
 }
 
-void
-DistanceBearing(const GeoPoint &loc1, const GeoPoint &loc2,
+/**
+ * The sine and cosine of the "reduced latitude" of a location on the
+ * WGS84 ellipsoid.
+ */
+struct ReducedLatitude {
+  double sin_u, cos_u;
+
+  explicit ReducedLatitude(Angle latitude) noexcept {
+    const auto u = atan((1 - FLATTENING) * latitude.tan());
+    sin_u = sin(u);
+    cos_u = cos(u);
+  }
+};
+
+static void
+DistanceBearing(const GeoPoint &loc1, const ReducedLatitude &r1,
+                const GeoPoint &loc2, const ReducedLatitude &r2,
                 double *distance, Angle *bearing) noexcept
 {
   const auto lon21 = loc2.longitude - loc1.longitude;
 
-  auto u1 = atan((1 - FLATTENING) * loc1.latitude.tan()),
-    u2 = atan((1 - FLATTENING) * loc2.latitude.tan());
-
-  auto sinu1 = sin(u1), cosu1 = cos(u1);
-
-  auto sinu2 = sin(u2), cosu2 = cos(u2);
+  const auto sinu1 = r1.sin_u, cosu1 = r1.cos_u;
+  const auto sinu2 = r2.sin_u, cosu2 = r2.cos_u;
 
   auto lambda = lon21.Radians(), lambda_p = Angle::FullCircle().Radians();
 
@@ -239,6 +250,32 @@ DistanceBearing(const GeoPoint &loc1, const GeoPoint &loc2,
       cosu1 * sinu2 - sinu1 * cosu2 * cos(lambda))).AsBearing();
 }
 
+void
+DistanceBearing(const GeoPoint &loc1, const GeoPoint &loc2,
+                double *distance, Angle *bearing) noexcept
+{
+  DistanceBearing(loc1, ReducedLatitude(loc1.latitude),
+                  loc2, ReducedLatitude(loc2.latitude),
+                  distance, bearing);
+}
+
+void
+DistanceBearing(const GeoPoint &origin, std::span<const GeoPoint> locations,
+                std::span<double> distances,
+                std::span<Angle> bearings) noexcept
+{
+  assert(distances.empty() || distances.size() == locations.size());
+  assert(bearings.empty() || bearings.size() == locations.size());
+
+  const ReducedLatitude r1(origin.latitude);
+
+  for (std::size_t i = 0; i < locations.size(); ++i)
+    DistanceBearing(origin, r1,
+                    locations[i], ReducedLatitude(locations[i].latitude),
+                    distances.empty() ? nullptr : &distances[i],
+                    bearings.empty() ? nullptr : &bearings[i]);
+}
+
 double
 ProjectedDistance(const GeoPoint &loc1, const GeoPoint &loc2,
                   const GeoPoint &loc3) noexcept
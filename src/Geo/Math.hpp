@@ -31,6 +31,8 @@ Copyright_License {
 #ifndef XCSOAR_GEO_MATH_HPP
 #define XCSOAR_GEO_MATH_HPP
 
+#include <span>
+
 struct GeoPoint;
 class Angle;
 
@@ -46,6 +48,22 @@ void
 DistanceBearing(const GeoPoint &loc1, const GeoPoint &loc2,
                 double *distance, Angle *bearing) noexcept;
 
+/**
+ * Calculates the distances and bearings from one origin to many
+ * locations.  The results are exactly the same as calling
+ * DistanceBearing() for each location, but the terms which depend
+ * only on the origin are calculated only once.
+ *
+ * @param distances receives one distance per location; may be empty
+ * if the caller is not interested in distances
+ * @param bearings receives one bearing per location; may be empty if
+ * the caller is not interested in bearings
+ */
+void
+DistanceBearing(const GeoPoint &origin, std::span<const GeoPoint> locations,
+                std::span<double> distances,
+                std::span<Angle> bearings) noexcept;
+
 /**
  * Calculates the distance between two locations
  * @param loc1 Location 1
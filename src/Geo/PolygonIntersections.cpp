@@ -0,0 +1,205 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "PolygonIntersections.hpp"
+#include "SearchPoint.hpp"
+#include "Flat/FlatRay.hpp"
+
+#include <cassert>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define HAVE_POLYGON_INTERSECTIONS_SSE2
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+/* NEON on 32 bit ARM lacks double precision vectors */
+#include <arm_neon.h>
+#define HAVE_POLYGON_INTERSECTIONS_NEON
+#endif
+
+uint32_t
+FindDistinctIntersectionsGeneric(const FlatRay &ray, const SearchPoint *points,
+                                 std::size_t n_edges) noexcept
+{
+  assert(n_edges <= MAX_INTERSECTION_EDGES);
+
+  uint32_t mask = 0;
+  for (std::size_t i = 0; i < n_edges; ++i) {
+    const FlatRay edge(points[i].GetFlatLocation(),
+                       points[i + 1].GetFlatLocation());
+    if (ray.DistinctIntersection(edge) >= 0)
+      mask |= uint32_t(1) << i;
+  }
+
+  return mask;
+}
+
+/*
+ * The vectorised implementations below evaluate the conditions of
+ * FlatRay::IntersectsRatio() and FlatRay::DistinctIntersection() for
+ * two edges per iteration without branches:
+ *
+ *   s = ray x edge, f = delta x edge, u = delta x ray
+ *   hit = f*s > 0 && |f| < |s| && (u >= 0) == (s > 0) && |u| <= |s|
+ *
+ * (The asymmetric test for u reproduces the sgn() macro in
+ * FlatRay.cpp, which treats zero as positive.)
+ *
+ * The integer coordinates are converted to double precision.  The
+ * cross products of projected coordinates are far below 2^53, so
+ * they are calculated exactly, and the result is identical to the
+ * integer implementation.
+ */
+
+#ifdef HAVE_POLYGON_INTERSECTIONS_SSE2
+
+/**
+ * Load a flat location as a (x, y) double vector.
+ */
+static inline __m128d
+LoadFlatLocation(const SearchPoint &p) noexcept
+{
+  const auto &f = p.GetFlatLocation();
+  return _mm_cvtepi32_pd(_mm_loadl_epi64((const __m128i *)(const void *)&f));
+}
+
+static uint32_t
+FindDistinctIntersectionsSSE2(const FlatRay &ray, const SearchPoint *points,
+                              std::size_t n_edges) noexcept
+{
+  const __m128d rx = _mm_set1_pd(ray.point.x), ry = _mm_set1_pd(ray.point.y);
+  const __m128d vx = _mm_set1_pd(ray.vector.x), vy = _mm_set1_pd(ray.vector.y);
+  const __m128d zero = _mm_setzero_pd();
+  const __m128d sign_mask = _mm_set1_pd(-0.);
+
+  uint32_t mask = 0;
+  std::size_t i = 0;
+
+  __m128d a = LoadFlatLocation(points[0]);
+  for (; i + 2 <= n_edges; i += 2) {
+    const __m128d b = LoadFlatLocation(points[i + 1]);
+    const __m128d c = LoadFlatLocation(points[i + 2]);
+
+    const __m128d x0 = _mm_unpacklo_pd(a, b), y0 = _mm_unpackhi_pd(a, b);
+    const __m128d x1 = _mm_unpacklo_pd(b, c), y1 = _mm_unpackhi_pd(b, c);
+    a = c;
+
+    const __m128d ex = _mm_sub_pd(x1, x0), ey = _mm_sub_pd(y1, y0);
+    const __m128d dx = _mm_sub_pd(x0, rx), dy = _mm_sub_pd(y0, ry);
+
+    const __m128d s = _mm_sub_pd(_mm_mul_pd(vx, ey), _mm_mul_pd(ex, vy));
+    const __m128d f = _mm_sub_pd(_mm_mul_pd(dx, ey), _mm_mul_pd(ex, dy));
+    const __m128d u = _mm_sub_pd(_mm_mul_pd(dx, vy), _mm_mul_pd(vx, dy));
+
+    const __m128d abs_s = _mm_andnot_pd(sign_mask, s);
+
+    __m128d hit = _mm_cmpgt_pd(_mm_mul_pd(f, s), zero);
+    hit = _mm_and_pd(hit, _mm_cmplt_pd(_mm_andnot_pd(sign_mask, f), abs_s));
+    hit = _mm_andnot_pd(_mm_xor_pd(_mm_cmpge_pd(u, zero),
+                                   _mm_cmpgt_pd(s, zero)), hit);
+    hit = _mm_and_pd(hit, _mm_cmple_pd(_mm_andnot_pd(sign_mask, u), abs_s));
+
+    /* f*s > 0 implies s != 0 */
+    mask |= uint32_t(_mm_movemask_pd(hit)) << i;
+  }
+
+  if (i < n_edges)
+    mask |= FindDistinctIntersectionsGeneric(ray, points + i,
+                                             n_edges - i) << i;
+
+  return mask;
+}
+
+#endif
+
+#ifdef HAVE_POLYGON_INTERSECTIONS_NEON
+
+static inline float64x2_t
+LoadFlatLocation(const SearchPoint &p) noexcept
+{
+  const auto &f = p.GetFlatLocation();
+  return vcvtq_f64_s64(vmovl_s32(vld1_s32(&f.x)));
+}
+
+static uint32_t
+FindDistinctIntersectionsNEON(const FlatRay &ray, const SearchPoint *points,
+                              std::size_t n_edges) noexcept
+{
+  const float64x2_t rx = vdupq_n_f64(ray.point.x), ry = vdupq_n_f64(ray.point.y);
+  const float64x2_t vx = vdupq_n_f64(ray.vector.x), vy = vdupq_n_f64(ray.vector.y);
+  const float64x2_t zero = vdupq_n_f64(0);
+
+  uint32_t mask = 0;
+  std::size_t i = 0;
+
+  float64x2_t a = LoadFlatLocation(points[0]);
+  for (; i + 2 <= n_edges; i += 2) {
+    const float64x2_t b = LoadFlatLocation(points[i + 1]);
+    const float64x2_t c = LoadFlatLocation(points[i + 2]);
+
+    const float64x2_t x0 = vzip1q_f64(a, b), y0 = vzip2q_f64(a, b);
+    const float64x2_t x1 = vzip1q_f64(b, c), y1 = vzip2q_f64(b, c);
+    a = c;
+
+    const float64x2_t ex = vsubq_f64(x1, x0), ey = vsubq_f64(y1, y0);
+    const float64x2_t dx = vsubq_f64(x0, rx), dy = vsubq_f64(y0, ry);
+
+    const float64x2_t s = vsubq_f64(vmulq_f64(vx, ey), vmulq_f64(ex, vy));
+    const float64x2_t f = vsubq_f64(vmulq_f64(dx, ey), vmulq_f64(ex, dy));
+    const float64x2_t u = vsubq_f64(vmulq_f64(dx, vy), vmulq_f64(vx, dy));
+
+    const float64x2_t abs_s = vabsq_f64(s);
+
+    uint64x2_t hit = vcgtq_f64(vmulq_f64(f, s), zero);
+    hit = vandq_u64(hit, vcltq_f64(vabsq_f64(f), abs_s));
+    hit = vbicq_u64(hit, veorq_u64(vcgeq_f64(u, zero),
+                                   vcgtq_f64(s, zero)));
+    hit = vandq_u64(hit, vcleq_f64(vabsq_f64(u), abs_s));
+
+    /* f*s > 0 implies s != 0 */
+    mask |= uint32_t(vgetq_lane_u64(hit, 0) & 1) << i;
+    mask |= uint32_t(vgetq_lane_u64(hit, 1) & 1) << (i + 1);
+  }
+
+  if (i < n_edges)
+    mask |= FindDistinctIntersectionsGeneric(ray, points + i,
+                                             n_edges - i) << i;
+
+  return mask;
+}
+
+#endif
+
+uint32_t
+FindDistinctIntersections(const FlatRay &ray, const SearchPoint *points,
+                          std::size_t n_edges) noexcept
+{
+  assert(n_edges <= MAX_INTERSECTION_EDGES);
+
+#if defined(HAVE_POLYGON_INTERSECTIONS_SSE2)
+  return FindDistinctIntersectionsSSE2(ray, points, n_edges);
+#elif defined(HAVE_POLYGON_INTERSECTIONS_NEON)
+  return FindDistinctIntersectionsNEON(ray, points, n_edges);
+#else
+  return FindDistinctIntersectionsGeneric(ray, points, n_edges);
+#endif
+}
@@ -0,0 +1,66 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_GEO_POLYGON_INTERSECTIONS_HPP
+#define XCSOAR_GEO_POLYGON_INTERSECTIONS_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+class FlatRay;
+class SearchPoint;
+
+/**
+ * The maximum number of edges which can be passed to
+ * FindDistinctIntersections().
+ */
+static constexpr std::size_t MAX_INTERSECTION_EDGES = 32;
+
+/**
+ * Determine which edges of a polyline have a distinct intersection
+ * with the given ray, i.e. for which
+ * ray.DistinctIntersection(edge) does not return a negative value.
+ *
+ * This function uses SSE2 or NEON if available.  The result is
+ * identical to FindDistinctIntersectionsGeneric().
+ *
+ * @param points the polyline; edge i is from points[i] to points[i+1]
+ * @param n_edges the number of edges (up to #MAX_INTERSECTION_EDGES);
+ * #points must contain one more element
+ * @return a bit mask; bit i is set if edge i intersects
+ */
+[[gnu::pure]]
+uint32_t
+FindDistinctIntersections(const FlatRay &ray, const SearchPoint *points,
+                          std::size_t n_edges) noexcept;
+
+/**
+ * Portable implementation of FindDistinctIntersections() which
+ * processes one edge at a time.
+ */
+[[gnu::pure]]
+uint32_t
+FindDistinctIntersectionsGeneric(const FlatRay &ray, const SearchPoint *points,
+                                 std::size_t n_edges) noexcept;
+
+#endif
@@ -73,6 +73,8 @@ struct SpeedVector {
     return SpeedVector(Angle::Zero(), 0);
   }
 
+  constexpr bool operator==(const SpeedVector &) const noexcept = default;
+
   /**
    * Returns true if the norm of the vector is zero.
    */
@@ -29,9 +29,30 @@ Copyright_License {
 #include <cstdint>
 
 struct IGCExtension {
+  /**
+   * The extensions known by IGCParseFix().  The code is resolved
+   * once by IGCParseExtensions(), so parsing a "B" record does not
+   * need to compare strings.
+   */
+  enum class Type : uint8_t {
+    UNKNOWN,
+    ENL,
+    RPM,
+    HDM,
+    HDT,
+    TRM,
+    TRT,
+    GSP,
+    IAS,
+    TAS,
+    SIU,
+  };
+
   uint16_t start, finish;
 
   char code[4];
+
+  Type type;
 };
 
 struct IGCExtensions : public TrivialArray<IGCExtension, 16> {
@@ -0,0 +1,86 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "IGCFileParser.hpp"
+#include "IGCParser.hpp"
+#include "IGCExtensions.hpp"
+#include "system/FileMapping.hpp"
+#include "system/Path.hpp"
+
+#include <algorithm>
+
+/**
+ * Lines longer than this are truncated; they cannot be "B" records
+ * anyway.
+ */
+static constexpr size_t MAX_LINE_LENGTH = 255;
+
+std::vector<IGCFix>
+IGCParseFixes(std::string_view contents)
+{
+  std::vector<IGCFix> fixes;
+
+  /* a "B" record with a few extensions has about 50 bytes; this is
+     a good guess for avoiding most reallocations */
+  fixes.reserve(contents.size() / 48);
+
+  IGCExtensions extensions;
+  extensions.clear();
+
+  IGCFix fix;
+
+  /* IGCParseFix() needs a null-terminated string, but the input is
+     not; copy each interesting line into this small buffer */
+  char line[MAX_LINE_LENGTH + 1];
+
+  while (!contents.empty()) {
+    const auto eol = contents.find('\n');
+    auto src = contents.substr(0, eol);
+    contents.remove_prefix(eol == contents.npos ? contents.size() : eol + 1);
+
+    if (!src.empty() && src.back() == '\r')
+      src.remove_suffix(1);
+
+    if (src.empty() || (src.front() != 'B' && src.front() != 'I'))
+      continue;
+
+    const size_t length = std::min(src.size(), MAX_LINE_LENGTH);
+    *std::copy_n(src.data(), length, line) = '\0';
+
+    if (line[0] == 'B') {
+      if (IGCParseFix(line, extensions, fix))
+        fixes.push_back(fix);
+    } else
+      IGCParseExtensions(line, extensions);
+  }
+
+  return fixes;
+}
+
+std::vector<IGCFix>
+IGCParseFixes(Path path)
+{
+  const FileMapping mapping(path);
+  return IGCParseFixes(std::string_view((const char *)mapping.data(),
+                                        mapping.size()));
+}
@@ -0,0 +1,54 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_IGC_FILE_PARSER_HPP
+#define XCSOAR_IGC_FILE_PARSER_HPP
+
+#include "IGCFix.hpp"
+
+#include <string_view>
+#include <vector>
+
+class Path;
+
+/**
+ * Parse all "B" records of an IGC file which is completely in
+ * memory.  "I" records are evaluated for the extensions of the
+ * following fixes; all other records are ignored.
+ *
+ * Unlike #IgcReplay, this returns fixes without a valid GPS position,
+ * too; check IGCFix::gps_valid.
+ */
+std::vector<IGCFix>
+IGCParseFixes(std::string_view contents);
+
+/**
+ * Map the specified IGC file into memory and parse all "B" records,
+ * see IGCParseFixes(std::string_view).
+ *
+ * Throws on I/O error.
+ */
+std::vector<IGCFix>
+IGCParseFixes(Path path);
+
+#endif
@@ -32,7 +32,9 @@ Copyright_License {
 #include "util/StringAPI.hxx"
 #include "util/StringCompare.hxx"
 
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 /**
  * Character table for base-36.
@@ -131,6 +133,35 @@ CheckThreeAlphaNumeric(const char *src)
     IsAlphaNumericASCII(src[2]);
 }
 
+[[gnu::pure]]
+static IGCExtension::Type
+ParseExtensionType(const char *code) noexcept
+{
+  using Type = IGCExtension::Type;
+
+  static constexpr struct {
+    char code[4];
+    Type type;
+  } types[] = {
+    { "ENL", Type::ENL },
+    { "RPM", Type::RPM },
+    { "HDM", Type::HDM },
+    { "HDT", Type::HDT },
+    { "TRM", Type::TRM },
+    { "TRT", Type::TRT },
+    { "GSP", Type::GSP },
+    { "IAS", Type::IAS },
+    { "TAS", Type::TAS },
+    { "SIU", Type::SIU },
+  };
+
+  for (const auto &i : types)
+    if (StringIsEqual(code, i.code))
+      return i.type;
+
+  return Type::UNKNOWN;
+}
+
 bool
 IGCParseExtensions(const char *buffer, IGCExtensions &extensions)
 {
@@ -169,6 +200,7 @@ IGCParseExtensions(const char *buffer, IGCExtensions &extensions)
     x.finish = finish;
     memcpy(x.code, buffer, 3);
     x.code[3] = 0;
+    x.type = ParseExtensionType(x.code);
 
     buffer += 3;
   }
@@ -226,46 +258,148 @@ ParseExtensionValueN(const char *p, const char *end, size_t n,
     value_r = value;
 }
 
-bool
-IGCParseFix(const char *buffer, const IGCExtensions &extensions, IGCFix &fix)
+/**
+ * Parse a fixed-width decimal number.  All #n characters are
+ * converted without exiting early, and the caller must ensure that
+ * they are readable (i.e. the string is not shorter).
+ *
+ * @return false if one of the characters is not a digit
+ */
+static constexpr bool
+ParseFixedDigits(const char *p, unsigned n, unsigned &value_r) noexcept
 {
-  if (*buffer != 'B')
-    return false;
+  unsigned value = 0;
+  bool valid = true;
+
+  for (unsigned i = 0; i < n; ++i) {
+    const unsigned digit = unsigned((unsigned char)p[i]) - '0';
+    valid &= digit <= 9;
+    value = value * 10 + digit;
+  }
+
+  value_r = value;
+  return valid;
+}
+
+/**
+ * Like ParseFixedDigits(), but allows a minus sign instead of the
+ * first digit, like "%05d" does for the altitudes of a "B" record.
+ */
+static constexpr bool
+ParseFixedSigned(const char *p, unsigned n, int &value_r) noexcept
+{
+  const bool negative = *p == '-';
 
-  BrokenTime time;
-  if (!IGCParseTime(buffer + 1, time))
+  unsigned value;
+  if (!ParseFixedDigits(p + negative, n - negative, value))
     return false;
 
-  char valid_char;
-  int gps_altitude, pressure_altitude;
+  value_r = negative ? -int(value) : int(value);
+  return true;
+}
+
+/**
+ * The fields of a "B" record before validation.
+ */
+struct RawIGCFix {
+  unsigned hour, minute, second;
+  unsigned lat_degrees, lat_minutes, lon_degrees, lon_minutes;
+  char lat_char, lon_char, valid_char;
+  int pressure_altitude, gps_altitude;
+};
+
+/**
+ * The minimum length of a "B" record (without extensions).
+ */
+static constexpr size_t IGC_FIX_LENGTH = 35;
 
-  if (sscanf(buffer + 24, "%c%05d%05d",
-             &valid_char, &pressure_altitude, &gps_altitude) != 3)
+/**
+ * Decode the fixed-width fields of a "B" record from a line which is
+ * at least #IGC_FIX_LENGTH characters long.
+ *
+ * @return false if the line is not in the strict fixed-width format,
+ * and the (slow) generic parser needs to be used
+ */
+static bool
+DecodeFixedWidthFix(const char *line, RawIGCFix &raw) noexcept
+{
+  /* the results of the conversions are combined with "&" (not
+     "&&") deliberately: there is no need to skip work on the rare
+     error path */
+  const bool valid =
+    ParseFixedDigits(line + 1, 2, raw.hour) &
+    ParseFixedDigits(line + 3, 2, raw.minute) &
+    ParseFixedDigits(line + 5, 2, raw.second) &
+    ParseFixedDigits(line + 7, 2, raw.lat_degrees) &
+    ParseFixedDigits(line + 9, 5, raw.lat_minutes) &
+    ParseFixedDigits(line + 15, 3, raw.lon_degrees) &
+    ParseFixedDigits(line + 18, 5, raw.lon_minutes) &
+    ParseFixedSigned(line + 25, 5, raw.pressure_altitude) &
+    ParseFixedSigned(line + 30, 5, raw.gps_altitude);
+
+  raw.lat_char = line[14];
+  raw.lon_char = line[23];
+  raw.valid_char = line[24];
+  return valid;
+}
+
+/**
+ * The generic (sscanf() based) fallback for DecodeFixedWidthFix(),
+ * which tolerates deviations such as blanks.
+ */
+static bool
+DecodeGenericFix(const char *line, RawIGCFix &raw) noexcept
+{
+  return sscanf(line + 1, "%02u%02u%02u",
+                &raw.hour, &raw.minute, &raw.second) == 3 &&
+    sscanf(line + 24, "%c%05d%05d", &raw.valid_char,
+           &raw.pressure_altitude, &raw.gps_altitude) == 3 &&
+    sscanf(line + 7, "%02u%05u%c%03u%05u%c",
+           &raw.lat_degrees, &raw.lat_minutes, &raw.lat_char,
+           &raw.lon_degrees, &raw.lon_minutes, &raw.lon_char) == 6;
+}
+
+static bool
+MakeLocation(unsigned lat_degrees, unsigned lat_minutes, char lat_char,
+             unsigned lon_degrees, unsigned lon_minutes, char lon_char,
+             GeoPoint &location) noexcept
+{
+  if (lat_degrees >= 90 || lat_minutes >= 60000 ||
+      (lat_char != 'N' && lat_char != 'S'))
     return false;
 
-  if (valid_char == 'A')
-    fix.gps_valid = true;
-  else if (valid_char == 'V')
-    fix.gps_valid = false;
-  else
+  if (lon_degrees >= 180 || lon_minutes >= 60000 ||
+      (lon_char != 'E' && lon_char != 'W'))
     return false;
 
-  fix.gps_altitude = gps_altitude;
-  fix.pressure_altitude = pressure_altitude;
+  location.latitude = Angle::Degrees(lat_degrees +
+                                     lat_minutes / 60000.);
+  if (lat_char == 'S')
+    location.latitude.Flip();
 
-  if (!IGCParseLocation(buffer + 7, fix.location))
-    return false;
+  location.longitude = Angle::Degrees(lon_degrees +
+                                      lon_minutes / 60000.);
+  if (lon_char == 'W')
+    location.longitude.Flip();
 
-  fix.time = time;
+  return true;
+}
+
+static void
+ParseExtensions(const char *buffer, size_t line_length,
+                const IGCExtensions &extensions, IGCFix &fix) noexcept
+{
+  using Type = IGCExtension::Type;
 
   fix.ClearExtensions();
 
-  const size_t line_length = strlen(buffer);
-  for (auto i = extensions.begin(), end = extensions.end(); i != end; ++i) {
-    const IGCExtension &extension = *i;
+  for (const IGCExtension &extension : extensions) {
     assert(extension.start > 0);
     assert(extension.finish >= extension.start);
 
+    if (extension.type == Type::UNKNOWN)
+      continue;
+
     if (extension.finish > line_length)
       /* exceeds the input line length */
       continue;
@@ -273,70 +407,131 @@ IGCParseFix(const char *buffer, const IGCExtensions &extensions, IGCFix &fix)
     const char *start = buffer + extension.start - 1;
     const char *finish = buffer + extension.finish;
 
-    if (StringIsEqual(extension.code, "ENL"))
+    switch (extension.type) {
+    case Type::UNKNOWN:
+      break;
+
+    case Type::ENL:
       ParseExtensionValue(start, finish, fix.enl);
-    else if (StringIsEqual(extension.code, "RPM"))
+      break;
+
+    case Type::RPM:
       ParseExtensionValue(start, finish, fix.rpm);
-    else if (StringIsEqual(extension.code, "HDM"))
+      break;
+
+    case Type::HDM:
       ParseExtensionValue(start, finish, fix.hdm);
-    else if (StringIsEqual(extension.code, "HDT"))
+      break;
+
+    case Type::HDT:
       ParseExtensionValue(start, finish, fix.hdt);
-    else if (StringIsEqual(extension.code, "TRM"))
+      break;
+
+    case Type::TRM:
       ParseExtensionValue(start, finish, fix.trm);
-    else if (StringIsEqual(extension.code, "TRT"))
+      break;
+
+    case Type::TRT:
       ParseExtensionValue(start, finish, fix.trt);
-    else if (StringIsEqual(extension.code, "GSP"))
+      break;
+
+    case Type::GSP:
       ParseExtensionValueN(start, finish, 3, fix.gsp);
-    else if (StringIsEqual(extension.code, "IAS"))
+      break;
+
+    case Type::IAS:
       ParseExtensionValueN(start, finish, 3, fix.ias);
-    else if (StringIsEqual(extension.code, "TAS"))
+      break;
+
+    case Type::TAS:
       ParseExtensionValueN(start, finish, 3, fix.tas);
-    else if (StringIsEqual(extension.code, "SIU"))
+      break;
+
+    case Type::SIU:
       ParseExtensionValue(start, finish, fix.siu);
+      break;
+    }
   }
-
-  return true;
 }
 
 bool
-IGCParseLocation(const char *buffer, GeoPoint &location)
+IGCParseFix(const char *buffer, const IGCExtensions &extensions, IGCFix &fix)
 {
-  unsigned lat_degrees, lat_minutes, lon_degrees, lon_minutes;
-  char lat_char, lon_char;
-
-  if (sscanf(buffer, "%02u%05u%c%03u%05u%c",
-             &lat_degrees, &lat_minutes, &lat_char,
-             &lon_degrees, &lon_minutes, &lon_char) != 6)
+  if (*buffer != 'B')
     return false;
 
-  if (lat_degrees >= 90 || lat_minutes >= 60000 ||
-      (lat_char != 'N' && lat_char != 'S'))
+  const size_t line_length = strlen(buffer);
+
+  RawIGCFix raw;
+  if (line_length < IGC_FIX_LENGTH || !DecodeFixedWidthFix(buffer, raw)) {
+    if (!DecodeGenericFix(buffer, raw))
+      return false;
+  }
+
+  const BrokenTime time(raw.hour, raw.minute, raw.second);
+  if (!time.IsPlausible())
     return false;
 
-  if (lon_degrees >= 180 || lon_minutes >= 60000 ||
-      (lon_char != 'E' && lon_char != 'W'))
+  if (raw.valid_char == 'A')
+    fix.gps_valid = true;
+  else if (raw.valid_char == 'V')
+    fix.gps_valid = false;
+  else
     return false;
 
-  location.latitude = Angle::Degrees(lat_degrees +
-                                     lat_minutes / 60000.);
-  if (lat_char == 'S')
-    location.latitude.Flip();
+  fix.gps_altitude = raw.gps_altitude;
+  fix.pressure_altitude = raw.pressure_altitude;
 
-  location.longitude = Angle::Degrees(lon_degrees +
-                                      lon_minutes / 60000.);
-  if (lon_char == 'W')
-    location.longitude.Flip();
+  if (!MakeLocation(raw.lat_degrees, raw.lat_minutes, raw.lat_char,
+                    raw.lon_degrees, raw.lon_minutes, raw.lon_char,
+                    fix.location))
+    return false;
+
+  fix.time = time;
 
+  ParseExtensions(buffer, line_length, extensions, fix);
   return true;
 }
 
+bool
+IGCParseLocation(const char *buffer, GeoPoint &location)
+{
+  unsigned lat_degrees, lat_minutes, lon_degrees, lon_minutes;
+  char lat_char, lon_char;
+
+  if (strnlen(buffer, 17) == 17 &&
+      (ParseFixedDigits(buffer, 2, lat_degrees) &
+       ParseFixedDigits(buffer + 2, 5, lat_minutes) &
+       ParseFixedDigits(buffer + 8, 3, lon_degrees) &
+       ParseFixedDigits(buffer + 11, 5, lon_minutes))) {
+    lat_char = buffer[7];
+    lon_char = buffer[16];
+  } else {
+    /* not strictly fixed-width; let sscanf() have a go */
+    if (sscanf(buffer, "%02u%05u%c%03u%05u%c",
+               &lat_degrees, &lat_minutes, &lat_char,
+               &lon_degrees, &lon_minutes, &lon_char) != 6)
+      return false;
+  }
+
+  return MakeLocation(lat_degrees, lat_minutes, lat_char,
+                      lon_degrees, lon_minutes, lon_char,
+                      location);
+}
+
 bool
 IGCParseTime(const char *buffer, BrokenTime &time)
 {
   unsigned hour, minute, second;
 
-  if (sscanf(buffer, "%02u%02u%02u", &hour, &minute, &second) != 3)
-    return false;
+  if (strnlen(buffer, 6) < 6 ||
+      !(ParseFixedDigits(buffer, 2, hour) &
+        ParseFixedDigits(buffer + 2, 2, minute) &
+        ParseFixedDigits(buffer + 4, 2, second))) {
+    /* not strictly fixed-width; let sscanf() have a go */
+    if (sscanf(buffer, "%02u%02u%02u", &hour, &minute, &second) != 3)
+      return false;
+  }
 
   time = BrokenTime(hour, minute, second);
   return time.IsPlausible();
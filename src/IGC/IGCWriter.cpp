@@ -31,11 +31,19 @@ Copyright_License {
 #include <cassert>
 
 IGCWriter::IGCWriter(Path path)
-  :file(path,
+  :file(std::in_place, path,
         /* we use CREATE_VISIBLE here so the user can recover partial
            IGC files after a crash/battery failure/etc. */
         FileOutputStream::Mode::CREATE_VISIBLE),
-   buffered(file)
+   buffered(*file)
+{
+  fix.Clear();
+
+  grecord.Initialize();
+}
+
+IGCWriter::IGCWriter(OutputStream &os)
+  :buffered(os)
 {
   fix.Clear();
 
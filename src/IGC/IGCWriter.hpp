@@ -29,6 +29,8 @@ Copyright_License {
 #include "io/FileOutputStream.hxx"
 #include "io/BufferedOutputStream.hxx"
 
+#include <optional>
+
 #include <tchar.h>
 
 class Path;
@@ -42,7 +44,12 @@ class IGCWriter {
     MAX_IGC_BUFF = 255,
   };
 
-  FileOutputStream file;
+  /**
+   * The file opened by the #Path constructor; empty if the caller
+   * provided its own #OutputStream.
+   */
+  std::optional<FileOutputStream> file;
+
   BufferedOutputStream buffered;
 
   GRecord grecord;
@@ -57,6 +64,15 @@ public:
    */
   explicit IGCWriter(Path path);
 
+  /**
+   * Write to the specified #OutputStream, which must remain valid
+   * until this object is destroyed.
+   */
+  explicit IGCWriter(OutputStream &os);
+
+  /**
+   * Pass all buffered lines to the #OutputStream.
+   */
   void Flush() {
     buffered.Flush();
   }
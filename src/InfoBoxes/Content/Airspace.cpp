@@ -29,12 +29,19 @@ Copyright_License {
 #include "Computer/GlideComputer.hpp"
 #include "Airspace/NearestAirspace.hpp"
 
+/**
+ * Shared by all "nearest airspace horizontal" InfoBoxes; they are
+ * only updated by the main thread.
+ */
+static NearestAirspaceTracker nearest_horizontal;
+
 void
 UpdateInfoBoxNearestAirspaceHorizontal(InfoBoxData &data) noexcept
 {
-  NearestAirspace nearest = NearestAirspace::FindHorizontal(CommonInterface::Basic(),
-                                                            glide_computer->GetAirspaceWarnings(),
-                                                            airspace_database);
+  NearestAirspace nearest =
+    nearest_horizontal.FindHorizontal(CommonInterface::Basic(),
+                                      glide_computer->GetAirspaceWarnings(),
+                                      airspace_database);
   if (!nearest.IsDefined()) {
     data.SetInvalid();
     return;
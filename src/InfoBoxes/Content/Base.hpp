@@ -39,8 +39,42 @@ public:
     ibkRight = 2
   };
 
+  /**
+   * Bit flags describing the data an InfoBox content is computed
+   * from; see GetDependencies().
+   */
+  enum Dependency : unsigned {
+    /**
+     * Sensor data, i.e. CommonInterface::Basic().
+     */
+    DEPENDS_BASIC = 0x1,
+
+    /**
+     * Results of the calculation thread, i.e.
+     * CommonInterface::Calculated() and the task manager.
+     */
+    DEPENDS_CALCULATED = 0x2,
+
+    /**
+     * The computer and user interface settings.
+     */
+    DEPENDS_SETTINGS = 0x4,
+
+    DEPENDS_ALL = ~0u,
+  };
+
   virtual ~InfoBoxContent() noexcept;
 
+  /**
+   * Which data does Update() use?  The #InfoBoxManager skips the
+   * Update() call if none of it has changed.  The default is to
+   * depend on everything.
+   */
+  [[gnu::pure]]
+  virtual unsigned GetDependencies() const noexcept {
+    return DEPENDS_ALL;
+  }
+
   virtual void Update(InfoBoxData &data) noexcept = 0;
   virtual bool HandleKey(const InfoBoxKeyCodes keycode) noexcept;
 
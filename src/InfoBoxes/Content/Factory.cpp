@@ -1107,6 +1107,22 @@ static constexpr MetaData meta_data[] = {
     UpdateInfoBoxHeartRate,
   },
 
+  // TASK_SPEED_10_MIN
+  {
+    N_("Speed task last 10 minutes"),
+    N_("V Task 10m"),
+    N_("Average cross country speed while on current task over the last 10 minutes, not compensated for altitude."),
+    UpdateInfoBoxTaskSpeed10Min,
+  },
+
+  // TASK_SPEED_30_MIN
+  {
+    N_("Speed task last 30 minutes"),
+    N_("V Task 30m"),
+    N_("Average cross country speed while on current task over the last 30 minutes, not compensated for altitude."),
+    UpdateInfoBoxTaskSpeed30Min,
+  },
+
 };
 
 static_assert(ARRAY_SIZE(meta_data) == NUM_TYPES,
@@ -29,6 +29,10 @@ Copyright_License {
 class InfoBoxContentActiveRadioFrequency : public InfoBoxContent
 {
 public:
+  unsigned GetDependencies() const noexcept override {
+    return DEPENDS_SETTINGS;
+  }
+
   const InfoBoxPanel *GetDialogContent() noexcept override;
   void Update(InfoBoxData &data) noexcept override;
 };
@@ -36,6 +40,10 @@ public:
 class InfoBoxContentStandbyRadioFrequency : public InfoBoxContent
 {
 public:
+  unsigned GetDependencies() const noexcept override {
+    return DEPENDS_SETTINGS;
+  }
+
   const InfoBoxPanel *GetDialogContent() noexcept override;
   void Update(InfoBoxData &data) noexcept override;
 };
@@ -499,11 +499,10 @@ UpdateInfoBoxTaskSpeedInstant(InfoBoxData &data) noexcept
   data.SetCommentFromTaskSpeed(task_stats.inst_speed_slow, false);
 }
 
-void
-UpdateInfoBoxTaskSpeedHour(InfoBoxData &data) noexcept
+static void
+UpdateInfoBoxTaskSpeedWindow(InfoBoxData &data,
+                             const WindowStats &window) noexcept
 {
-  const WindowStats &window =
-    CommonInterface::Calculated().task_stats.last_hour;
   if (window.duration < 0) {
     data.SetInvalid();
     return;
@@ -513,6 +512,27 @@ UpdateInfoBoxTaskSpeedHour(InfoBoxData &data) noexcept
   data.SetValueFromTaskSpeed(window.speed);
 }
 
+void
+UpdateInfoBoxTaskSpeedHour(InfoBoxData &data) noexcept
+{
+  const TaskStats &task_stats = CommonInterface::Calculated().task_stats;
+  UpdateInfoBoxTaskSpeedWindow(data, task_stats.last_hour);
+}
+
+void
+UpdateInfoBoxTaskSpeed10Min(InfoBoxData &data) noexcept
+{
+  const TaskStats &task_stats = CommonInterface::Calculated().task_stats;
+  UpdateInfoBoxTaskSpeedWindow(data, task_stats.last_10min);
+}
+
+void
+UpdateInfoBoxTaskSpeed30Min(InfoBoxData &data) noexcept
+{
+  const TaskStats &task_stats = CommonInterface::Calculated().task_stats;
+  UpdateInfoBoxTaskSpeedWindow(data, task_stats.last_30min);
+}
+
 void
 UpdateInfoBoxFinalGR(InfoBoxData &data) noexcept
 {
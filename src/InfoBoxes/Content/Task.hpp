@@ -104,6 +104,12 @@ UpdateInfoBoxTaskSpeedInstant(InfoBoxData &data) noexcept;
 void
 UpdateInfoBoxTaskSpeedHour(InfoBoxData &data) noexcept;
 
+void
+UpdateInfoBoxTaskSpeed10Min(InfoBoxData &data) noexcept;
+
+void
+UpdateInfoBoxTaskSpeed30Min(InfoBoxData &data) noexcept;
+
 void
 UpdateInfoBoxTaskAATime(InfoBoxData &data) noexcept;
 
@@ -286,8 +286,6 @@ InfoBoxContentClimbPercent::OnCustomPaint(Canvas &canvas, const PixelRect &rc)no
 void
 InfoBoxContentClimbPercent::Update(InfoBoxData &data) noexcept
 {
-  const auto &basic = CommonInterface::Basic();
-
-  // TODO: use an appropriate digest
-  data.SetCustom(basic.location_available.ToInteger());
+  data.SetCustom(CommonInterface::GetCalculatedSerials()
+                 .Get(DerivedSerials::Section::CIRCLING));
 }
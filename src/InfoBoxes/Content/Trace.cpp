@@ -224,6 +224,6 @@ InfoBoxContentTaskProgress::OnCustomPaint(Canvas &canvas,
 void
 InfoBoxContentTaskProgress::Update(InfoBoxData &data) noexcept
 {
-  // TODO: use an appropriate digest
-  data.SetCustom(CommonInterface::Basic().location_available.ToInteger());
+  data.SetCustom(CommonInterface::GetCalculatedSerials()
+                 .Get(DerivedSerials::Section::COMMON_STATS));
 }
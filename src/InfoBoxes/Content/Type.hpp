@@ -173,6 +173,9 @@ namespace InfoBoxFactory
 
     e_HeartRate,
 
+    TASK_SPEED_10_MIN,
+    TASK_SPEED_30_MIN,
+
     e_NUM_TYPES /* Last item */
   };
 
@@ -53,6 +53,12 @@ InfoBoxDrawIfDirty() noexcept;
 } // namespace InfoBoxManager
 
 static bool infoboxes_dirty = false;
+
+/**
+ * The InfoBoxContent::Dependency flags passed to SetDirty() since the
+ * last update.
+ */
+static unsigned dirty_dependencies = 0;
 static bool infoboxes_hidden = false;
 
 static InfoBoxWindow *infoboxes[InfoBoxSettings::Panel::MAX_CONTENTS];
@@ -113,7 +119,7 @@ InfoBoxManager::DisplayInfoBox() noexcept
       DisplayTypeLast[i] = DisplayType;
     }
 
-    infoboxes[i]->UpdateContent();
+    infoboxes[i]->UpdateContent(dirty_dependencies);
   }
 
   first = false;
@@ -130,13 +136,15 @@ InfoBoxManager::InfoBoxDrawIfDirty() noexcept
       !CommonInterface::GetUIState().screen_blanked) {
     DisplayInfoBox();
     infoboxes_dirty = false;
+    dirty_dependencies = 0;
   }
 }
 
 void
-InfoBoxManager::SetDirty() noexcept
+InfoBoxManager::SetDirty(unsigned changed) noexcept
 {
   infoboxes_dirty = true;
+  dirty_dependencies |= changed;
 }
 
 void
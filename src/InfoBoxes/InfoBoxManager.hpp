@@ -24,6 +24,8 @@ Copyright_License {
 #ifndef XCSOAR_INFO_BOX_MANAGER_HPP
 #define XCSOAR_INFO_BOX_MANAGER_HPP
 
+#include "InfoBoxes/Content/Base.hpp"
+
 struct InfoBoxLook;
 class ContainerWindow;
 
@@ -37,8 +39,15 @@ extern InfoBoxLayout::Layout layout;
 void
 ProcessTimer() noexcept;
 
+/**
+ * Schedule an update of the InfoBoxes with the next ProcessTimer()
+ * call.
+ *
+ * @param changed the InfoBoxContent::Dependency flags which have
+ * changed; only InfoBoxes depending on one of them are updated
+ */
 void
-SetDirty() noexcept;
+SetDirty(unsigned changed=InfoBoxContent::DEPENDS_ALL) noexcept;
 
 void
 Create(ContainerWindow &parent, const InfoBoxLayout::Layout &layout,
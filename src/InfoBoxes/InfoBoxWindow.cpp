@@ -229,17 +229,24 @@ InfoBoxWindow::SetContentProvider(std::unique_ptr<InfoBoxContent> _content)
 {
   content = std::move(_content);
   ++content_serial;
+  content_updated = false;
 
   data.SetInvalid();
   Invalidate();
 }
 
 void
-InfoBoxWindow::UpdateContent()
+InfoBoxWindow::UpdateContent(unsigned changed)
 {
   if (!content)
     return;
 
+  if (content_updated && (content->GetDependencies() & changed) == 0)
+    /* nothing this content shows has changed */
+    return;
+
+  content_updated = true;
+
   InfoBoxData old = data;
   content->Update(data);
   data.content_serial = content_serial;
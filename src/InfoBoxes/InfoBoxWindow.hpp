@@ -53,6 +53,12 @@ class InfoBoxWindow : public LazyPaintWindow
    */
   unsigned content_serial;
 
+  /**
+   * Has UpdateContent() been called since the #content was
+   * installed?  Until then, its dependencies are ignored.
+   */
+  bool content_updated = false;
+
   InfoBoxData data;
 
   bool dragging = false;
@@ -132,7 +138,15 @@ public:
   }
 
   void SetContentProvider(std::unique_ptr<InfoBoxContent> _content);
-  void UpdateContent();
+  /**
+   * Let the #content update the #data and invalidate the parts of the
+   * window which have changed.
+   *
+   * @param changed the InfoBoxContent::Dependency flags which have
+   * changed since the last call; the update is skipped if the
+   * #content does not depend on any of them
+   */
+  void UpdateContent(unsigned changed=InfoBoxContent::DEPENDS_ALL);
 
 private:
   void SetPressed(bool _pressed) {
@@ -152,6 +152,7 @@ void eventChecklist(const TCHAR *misc);
 void eventClearAirspaceWarnings(const TCHAR *misc);
 void eventClearStatusMessages(const TCHAR *misc);
 void eventLogger(const TCHAR *misc);
+void eventTrace(const TCHAR *misc);
 void eventMacCready(const TCHAR *misc);
 void eventMainMenu(const TCHAR *misc);
 void eventMarkLocation(const TCHAR *misc);
@@ -74,6 +74,10 @@ doc/html/advanced/input/ALL		http://xcsoar.sourceforge.net/advanced/input/
 #include "Language/Language.hpp"
 #include "Logger/Logger.hpp"
 #include "Logger/NMEALogger.hpp"
+#include "TraceFile.hpp"
+#include "LocalPath.hpp"
+#include "system/Path.hpp"
+#include "thread/TraceEvents.hpp"
 #include "Waypoint/Waypoints.hpp"
 #include "Waypoint/Factory.hpp"
 #include "Waypoint/WaypointGlue.hpp"
@@ -493,6 +497,43 @@ InputEvents::eventLogger(const TCHAR *misc)
     logger->LoggerNote(misc + 4);
 }
 
+// Trace
+// Records the timings of threads and render stages, to be analysed
+// with chrome://tracing or https://ui.perfetto.dev/
+//  on: starts recording (discarding old events)
+//  off: stops recording and writes the events to trace.json
+//  toggle: switches between "on" and "off"
+//  dump: writes the events recorded so far to trace.json
+void
+InputEvents::eventTrace(const TCHAR *misc)
+{
+  const bool was_enabled = TraceEvents::IsEnabled();
+
+  if (StringIsEqual(misc, _T("on")) ||
+      (StringIsEqual(misc, _T("toggle")) && !was_enabled)) {
+    TraceEvents::Clear();
+    TraceEvents::SetEnabled(true);
+    Message::AddMessage(_("Trace on"));
+    return;
+  }
+
+  if (StringIsEqual(misc, _T("off")) || StringIsEqual(misc, _T("toggle")))
+    TraceEvents::SetEnabled(false);
+  else if (!StringIsEqual(misc, _T("dump")))
+    return;
+
+  const auto path = LocalPath(_T("trace.json"));
+
+  try {
+    WriteTraceFile(path);
+  } catch (...) {
+    ShowError(std::current_exception(), _("Trace"));
+    return;
+  }
+
+  Message::AddMessage(_("Trace written"), path.c_str());
+}
+
 // RepeatStatusMessage
 // Repeats the last status message.  If pressed repeatedly, will
 // repeat previous status messages
@@ -75,6 +75,16 @@ namespace CommonInterface {
     return Private::blackboard.Calculated();
   }
 
+  /**
+   * Returns the per-section change counters of Calculated()
+   */
+  gcc_const
+  static inline const DerivedSerials &GetCalculatedSerials() {
+    assert(InMainThread());
+
+    return Private::blackboard.GetCalculatedSerials();
+  }
+
   gcc_const
   static inline const SystemSettings &GetSystemSettings() {
     assert(InMainThread());
@@ -27,8 +27,17 @@ Copyright_License {
 void
 JobThread::Start()
 {
-  Thread::Start();
+  /* set this before starting the thread, because the notification
+     may arrive before Thread::Start() returns if the caller is not
+     the main thread */
   was_running = true;
+
+  try {
+    Thread::Start();
+  } catch (...) {
+    was_running = false;
+    throw;
+  }
 }
 
 void
@@ -33,8 +33,7 @@ Copyright_License {
 #include "Screen/Layout.hpp"
 #include "Renderer/FlightListRenderer.hpp"
 #include "FlightInfo.hpp"
-#include "Logger/FlightParser.hpp"
-#include "io/FileLineReader.hpp"
+#include "Logger/FlightIndex.hpp"
 #include "Resources.hpp"
 #include "Model.hpp"
 #include "Hardware/Battery.hpp"
@@ -100,13 +99,14 @@ DrawBanner(Canvas &canvas, PixelRect &rc)
 static void
 DrawFlights(Canvas &canvas, const PixelRect &rc)
 try {
-  FileLineReaderA file(Path("/mnt/onboard/XCSoarData/flights.log"));
+  FlightIndex index;
+  index.Update(Path("/mnt/onboard/XCSoarData/flights.log"),
+               Path("/mnt/onboard/XCSoarData/flights.log.idx"));
 
   FlightListRenderer renderer(normal_font, bold_font);
 
-  FlightParser parser(file);
-  FlightInfo flight;
-  while (parser.Read(flight))
+  /* only the most recent flights fit on the screen */
+  for (const auto &flight : index.GetPage(0, FlightListRenderer::MAX_FLIGHTS))
     renderer.AddFlight(flight);
 
   renderer.Draw(canvas, rc);
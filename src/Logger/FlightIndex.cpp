@@ -0,0 +1,271 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "FlightIndex.hpp"
+#include "FlightParser.hpp"
+#include "io/FileReader.hxx"
+#include "io/FileLineReader.hpp"
+#include "io/FileOutputStream.hxx"
+#include "io/BufferedOutputStream.hxx"
+#include "time/BrokenDateTime.hpp"
+#include "system/Path.hpp"
+
+#include <algorithm>
+
+/**
+ * The index file is a sequence of these fixed-size entries in host
+ * byte order.  All entries after the last #CHECKPOINT are ignored, so
+ * an interrupted update does not corrupt the index.
+ */
+struct FlightIndexEntry {
+  enum Type : uint32_t {
+    /** the first entry; #a is #MAGIC */
+    HEADER = 1,
+
+    /** a flight: #a is the date, #b the start and end time */
+    FLIGHT = 2,
+
+    /** like #FLIGHT, but replaces the previous flight */
+    REPLACE_LAST = 3,
+
+    /** #b is the size of the log file parsed so far */
+    CHECKPOINT = 4,
+  };
+
+  /** identifies the file format and version */
+  static constexpr uint32_t MAGIC = 0x46584931;
+
+  uint32_t type;
+  uint32_t a;
+  uint64_t b;
+};
+
+static_assert(sizeof(FlightIndexEntry) == 16);
+
+static constexpr uint32_t
+PackDate(const BrokenDate &d) noexcept
+{
+  return uint32_t(d.year) << 16 | uint32_t(d.month) << 8 | d.day;
+}
+
+static BrokenDate
+UnpackDate(uint32_t value) noexcept
+{
+  return BrokenDate(value >> 16, (value >> 8) & 0xff, value & 0xff);
+}
+
+static constexpr uint64_t
+PackTime(const BrokenTime &t) noexcept
+{
+  return uint64_t(t.hour) << 16 | uint64_t(t.minute) << 8 | t.second;
+}
+
+static BrokenTime
+UnpackTime(uint64_t value) noexcept
+{
+  return BrokenTime((value >> 16) & 0xff, (value >> 8) & 0xff, value & 0xff);
+}
+
+static FlightIndexEntry
+MakeEntry(FlightIndexEntry::Type type, const FlightInfo &flight) noexcept
+{
+  return {
+    type,
+    PackDate(flight.date),
+    PackTime(flight.start_time) << 24 | PackTime(flight.end_time),
+  };
+}
+
+static FlightInfo
+ToFlightInfo(const FlightIndexEntry &entry) noexcept
+{
+  FlightInfo flight{};
+  flight.date = UnpackDate(entry.a);
+  flight.start_time = UnpackTime(entry.b >> 24);
+  flight.end_time = UnpackTime(entry.b);
+  return flight;
+}
+
+/**
+ * Does the first flight of a newly parsed part of the log complete
+ * the last flight of the index?  This happens when the log ended
+ * after a "start" line, and the "landing" line was appended later.
+ * It mimics what #FlightParser does with the whole log.
+ */
+[[gnu::pure]]
+static bool
+IsContinuation(const FlightInfo &last, const FlightInfo &next) noexcept
+{
+  if (!last.date.IsPlausible() || !last.start_time.IsPlausible() ||
+      last.end_time.IsPlausible())
+    return false;
+
+  if (next.start_time.IsPlausible() || !next.date.IsPlausible() ||
+      !next.end_time.IsPlausible())
+    return false;
+
+  const auto duration = BrokenDateTime(next.date, next.end_time) -
+    BrokenDateTime(last.date, last.start_time);
+  return duration.count() >= 0 && duration <= std::chrono::hours{14};
+}
+
+bool
+FlightIndex::Load(Path index_path) noexcept
+try {
+  flights.clear();
+  log_size = 0;
+
+  FileReader file(index_path);
+
+  const uint64_t size = file.GetSize();
+  if (size == 0 || size % sizeof(FlightIndexEntry) != 0)
+    return false;
+
+  std::vector<FlightIndexEntry> entries(size / sizeof(FlightIndexEntry));
+
+  std::size_t position = 0;
+  const std::size_t total = entries.size() * sizeof(FlightIndexEntry);
+  while (position < total) {
+    std::size_t nbytes = file.Read((std::byte *)entries.data() + position,
+                                   total - position);
+    if (nbytes == 0)
+      return false;
+
+    position += nbytes;
+  }
+
+  if (entries.front().type != FlightIndexEntry::HEADER ||
+      entries.front().a != FlightIndexEntry::MAGIC)
+    return false;
+
+  /* the state as of the most recent checkpoint */
+  std::size_t committed_flights = 0;
+  bool committed = false;
+
+  for (auto i = std::next(entries.begin()); i != entries.end(); ++i) {
+    switch (i->type) {
+    case FlightIndexEntry::FLIGHT:
+      flights.push_back(ToFlightInfo(*i));
+      break;
+
+    case FlightIndexEntry::REPLACE_LAST:
+      if (flights.empty())
+        return false;
+
+      flights.back() = ToFlightInfo(*i);
+      break;
+
+    case FlightIndexEntry::CHECKPOINT:
+      committed_flights = flights.size();
+      log_size = i->b;
+      committed = std::next(i) == entries.end();
+      break;
+
+    default:
+      return false;
+    }
+  }
+
+  /* entries after the last checkpoint (from an interrupted update)
+     would get in the way of appending; rebuild the index then */
+  if (!committed) {
+    flights.resize(committed_flights);
+    return false;
+  }
+
+  return true;
+} catch (...) {
+  flights.clear();
+  log_size = 0;
+  return false;
+}
+
+void
+FlightIndex::Update(Path log_path, Path index_path)
+{
+  const bool loaded = Load(index_path);
+
+  FileLineReaderA reader(log_path);
+
+  const bool rebuild = !loaded || reader.GetSize() < long(log_size);
+  if (rebuild) {
+    /* the log was truncated or replaced, or there is no usable
+       index: parse the whole log */
+    flights.clear();
+    log_size = 0;
+  } else if (uint64_t(reader.GetSize()) == log_size)
+    /* nothing new */
+    return;
+
+  reader.Seek(log_size);
+
+  std::vector<FlightIndexEntry> entries;
+  if (rebuild)
+    entries.push_back({FlightIndexEntry::HEADER, FlightIndexEntry::MAGIC, 0});
+
+  FlightParser parser(reader);
+  FlightInfo flight;
+  bool first = true;
+  while (parser.Read(flight)) {
+    if (first && !flights.empty() && IsContinuation(flights.back(), flight)) {
+      flights.back().end_time = flight.end_time;
+      entries.push_back(MakeEntry(FlightIndexEntry::REPLACE_LAST,
+                                  flights.back()));
+    } else {
+      flights.push_back(flight);
+      entries.push_back(MakeEntry(FlightIndexEntry::FLIGHT, flight));
+    }
+
+    first = false;
+  }
+
+  /* the position after the last line which was read, not the size
+     obtained above: the log may have grown in the meantime */
+  log_size = reader.Tell();
+  entries.push_back({FlightIndexEntry::CHECKPOINT, 0, log_size});
+
+  try {
+    FileOutputStream file(index_path,
+                          rebuild
+                          ? FileOutputStream::Mode::CREATE
+                          : FileOutputStream::Mode::APPEND_EXISTING);
+    file.Write(entries.data(), entries.size() * sizeof(entries.front()));
+    file.Commit();
+  } catch (...) {
+    /* the index is only a cache; next time, the log will be parsed
+       again */
+  }
+}
+
+ConstBuffer<FlightInfo>
+FlightIndex::GetPage(unsigned page, unsigned page_size) const noexcept
+{
+  const std::size_t n = flights.size();
+  const std::size_t skip = std::size_t(page) * page_size;
+  if (page_size == 0 || skip >= n)
+    return nullptr;
+
+  const std::size_t end = n - skip;
+  const std::size_t begin = end > page_size ? end - page_size : 0;
+  return {flights.data() + begin, end - begin};
+}
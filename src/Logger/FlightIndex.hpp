@@ -0,0 +1,93 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_FLIGHT_INDEX_HPP
+#define XCSOAR_FLIGHT_INDEX_HPP
+
+#include "FlightInfo.hpp"
+#include "util/ConstBuffer.hxx"
+
+#include <cstdint>
+#include <vector>
+
+class Path;
+
+/**
+ * The list of flights found in a #FlightLogger file, backed by an
+ * append-only index file next to it.
+ *
+ * Update() loads the index and parses only the part of the log
+ * which was appended since the last update, so the flight list is
+ * available instantly even with years of history.  The result is
+ * the same as parsing the whole log with #FlightParser.
+ */
+class FlightIndex {
+  std::vector<FlightInfo> flights;
+
+  /**
+   * The size of the log file which has been parsed into #flights.
+   */
+  uint64_t log_size = 0;
+
+public:
+  /**
+   * Bring the list up to date with the log file, and append the new
+   * flights to the index file.  A missing, corrupt or outdated index
+   * file is rebuilt.  Failure to write the index file is ignored,
+   * it is only a cache.
+   *
+   * Throws on error (i.e. if the log file cannot be read).
+   */
+  void Update(Path log_path, Path index_path);
+
+  bool empty() const noexcept {
+    return flights.empty();
+  }
+
+  std::size_t size() const noexcept {
+    return flights.size();
+  }
+
+  /**
+   * All flights, oldest first.
+   */
+  ConstBuffer<FlightInfo> GetFlights() const noexcept {
+    return {flights.data(), flights.size()};
+  }
+
+  /**
+   * Returns one page of flights (oldest first within the page).
+   * Page 0 contains the most recent flights.
+   */
+  [[gnu::pure]]
+  ConstBuffer<FlightInfo> GetPage(unsigned page,
+                                  unsigned page_size) const noexcept;
+
+private:
+  /**
+   * @return false if the index file is missing or unusable
+   */
+  bool Load(Path index_path) noexcept;
+};
+
+#endif
@@ -68,27 +68,45 @@ GRecord::AppendRecordToBuffer(const char *in)
 }
 
 /**
+ * Copy the characters which are part of the G record calculation.
+ *
  * @param ignore_comma if true, then the comma is ignored, even though
  * it's a valid IGC character
+ * @return the end of the source string or the position where the
+ * destination buffer became full
  */
-static void
-AppendIGCString(MD5 &md5, const char *s, bool ignore_comma)
+static const char *
+FilterIGCString(const char *s, char *dest, char *dest_end,
+                char *&dest_r, bool ignore_comma) noexcept
 {
-  while (*s != '\0') {
-    const char ch = *s++;
+  for (; *s != '\0' && dest != dest_end; ++s) {
+    const char ch = *s;
     if (ignore_comma && ch == ',')
       continue;
 
     if (IsValidIGCChar(ch))
-      md5.Append(ch);
+      *dest++ = ch;
   }
+
+  dest_r = dest;
+  return s;
 }
 
 void
 GRecord::AppendStringToBuffer(const char *in)
 {
-  for (auto &i : md5)
-    AppendIGCString(i, in, ignore_comma);
+  /* filter the line only once, and pass whole chunks to all MD5
+     instances */
+  char buffer[256];
+
+  while (*in != '\0') {
+    char *end;
+    in = FilterIGCString(in, buffer, buffer + sizeof(buffer), end,
+                         ignore_comma);
+
+    for (auto &i : md5)
+      i.Append(buffer, end - buffer);
+  }
 }
 
 void
@@ -142,6 +160,20 @@ GRecord::LoadFileToBuffer(Path path)
     AppendRecordToBuffer(line);
 }
 
+/**
+ * Append the contents of a G record line to the digest buffer.
+ */
+static void
+AppendGRecordLine(const char *line, char *output, size_t &length,
+                  size_t max_length)
+{
+  for (const char *p = line + 1; *p != '\0'; ++p) {
+    output[length++] = *p;
+    if (length >= max_length)
+      throw std::runtime_error("G record too large");
+  }
+}
+
 void
 GRecord::WriteTo(BufferedOutputStream &writer) const
 {
@@ -175,32 +207,33 @@ GRecord::ReadGRecordFromFile(Path path,
 {
   FileLineReaderA reader(path);
 
-  unsigned int digest_length = 0;
+  size_t digest_length = 0;
   char *data;
-  while ((data = reader.ReadLine()) != nullptr) {
-    if (data[0] != 'G')
-      continue;
-
-    for (const char *p = data + 1; *p != '\0'; ++p) {
-      output[digest_length++] = *p;
-      if (digest_length >= max_length)
-        throw std::runtime_error("G record too large");
-    }
-  }
+  while ((data = reader.ReadLine()) != nullptr)
+    if (data[0] == 'G')
+      AppendGRecordLine(data, output, digest_length, max_length);
 
   output[digest_length] = '\0';
 }
 
 void
-GRecord::VerifyGRecordInFile(Path path)
+GRecord::Verify(NLineReader &reader)
 {
-  // assumes FileName member is set
-  // Load File into Buffer (assume name is already set)
-  LoadFileToBuffer(path);
-
-  // load Existing Digest "old"
+  /* a single pass: the G record lines are collected while all other
+     lines are fed into the digest */
   char old_g_record[DIGEST_LENGTH + 1];
-  ReadGRecordFromFile(path, old_g_record, ARRAY_SIZE(old_g_record));
+  size_t old_length = 0;
+
+  char *line;
+  while ((line = reader.ReadLine()) != nullptr) {
+    if (line[0] == 'G')
+      AppendGRecordLine(line, old_g_record, old_length,
+                        ARRAY_SIZE(old_g_record));
+    else
+      AppendRecordToBuffer(line);
+  }
+
+  old_g_record[old_length] = '\0';
 
   // recalculate digest from buffer
   FinalizeBuffer();
@@ -211,3 +244,10 @@ GRecord::VerifyGRecordInFile(Path path)
   if (strcmp(old_g_record, new_g_record) != 0)
     throw std::runtime_error("Invalid G record");
 }
+
+void
+GRecord::VerifyGRecordInFile(Path path)
+{
+  FileLineReaderA reader(path);
+  Verify(reader);
+}
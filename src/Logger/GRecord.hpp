@@ -29,6 +29,7 @@
 
 class Path;
 class BufferedOutputStream;
+class NLineReader;
 
 class GRecord
 {
@@ -95,6 +96,14 @@ public:
   static void ReadGRecordFromFile(Path path,
                                   char *buffer, size_t max_length);
 
+  /**
+   * Verify the G record of an IGC file, reading it line by line in
+   * one pass.
+   *
+   * Throws std::runtime_errror on error.
+   */
+  void Verify(NLineReader &reader);
+
   /**
    * Throws std::runtime_errror on error.
    */
@@ -22,6 +22,7 @@
 */
 
 #include "Logger/LoggerImpl.hpp"
+#include "Logger/LoggerOutputThread.hpp"
 #include "Logger/Settings.hpp"
 #include "LogFile.hpp"
 #include "LocalPath.hpp"
@@ -85,17 +86,19 @@ LoggerImpl::StopLogger(const NMEAInfo &gps_info)
   if (writer == nullptr)
     return;
 
-  writer->Flush();
-
   if (!simulator)
     writer->Sign();
 
   writer->Flush();
 
+  /* wait until the IGC file is complete on the storage device */
+  output->Flush();
+
   LogFormat(_T("Logger stopped: %s"), filename.c_str());
 
   // Logger off
   writer.reset();
+  output.reset();
 
   pre_takeoff_buffer.clear();
 }
@@ -240,8 +243,11 @@ LoggerImpl::StartLogger(const NMEAInfo &gps_info,
   frecord.Reset();
 
   try {
-    writer = std::make_unique<IGCWriter>(filename);
+    output = std::make_unique<LoggerOutputThread>(filename, SYNC_INTERVAL);
+    writer = std::make_unique<IGCWriter>(*output);
   } catch (...) {
+    writer.reset();
+    output.reset();
     LogError(std::current_exception());
     return false;
   }
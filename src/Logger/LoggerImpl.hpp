@@ -31,6 +31,7 @@ Copyright_License {
 #include "system/Path.hpp"
 #include "util/OverwritingRingBuffer.hpp"
 
+#include <chrono>
 #include <memory>
 
 #include <tchar.h>
@@ -39,6 +40,7 @@ struct NMEAInfo;
 struct LoggerSettings;
 struct Declaration;
 class IGCWriter;
+class LoggerOutputThread;
 
 /**
  * Implementation of logger
@@ -51,6 +53,14 @@ public:
     PRETAKEOFF_BUFFER_MAX = 60,
   };
 
+  /**
+   * How often is the IGC file synced to the storage device while
+   * logging?  Records are written by the #LoggerOutputThread
+   * immediately, but syncing may take a long time on slow SD cards.
+   */
+  static constexpr std::chrono::steady_clock::duration SYNC_INTERVAL =
+    std::chrono::seconds{30};
+
   /** Buffer for points recorded before takeoff */
   struct PreTakeoffBuffer
   {
@@ -95,6 +105,13 @@ public:
 
 private:
   AllocatedPath filename;
+
+  /**
+   * Writes the IGC file in a separate thread.  Must be declared
+   * before #writer, which writes into it.
+   */
+  std::unique_ptr<LoggerOutputThread> output;
+
   std::unique_ptr<IGCWriter> writer;
 
   OverwritingRingBuffer<PreTakeoffBuffer, PRETAKEOFF_BUFFER_MAX> pre_takeoff_buffer;
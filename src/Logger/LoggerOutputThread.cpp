@@ -0,0 +1,139 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "LoggerOutputThread.hpp"
+#include "system/Path.hpp"
+
+LoggerOutputThread::LoggerOutputThread(Path path,
+                                       Clock::duration _sync_interval)
+  :StandbyThread("IGCWriter"),
+   /* we use CREATE_VISIBLE here so the user can recover partial
+      IGC files after a crash/battery failure/etc. */
+   file(path, FileOutputStream::Mode::CREATE_VISIBLE),
+   sync_interval(_sync_interval),
+   last_sync(Clock::now())
+{
+}
+
+LoggerOutputThread::~LoggerOutputThread() noexcept
+{
+  LockStop();
+}
+
+void
+LoggerOutputThread::Flush()
+{
+  std::unique_lock<Mutex> lock(mutex);
+
+  if (error)
+    std::rethrow_exception(error);
+
+  sync_requested = true;
+  idle.store(false, std::memory_order_relaxed);
+  Trigger();
+  WaitDone(lock);
+
+  if (error)
+    std::rethrow_exception(error);
+}
+
+void
+LoggerOutputThread::Write(const void *data, size_t size)
+{
+  const auto *p = (const std::byte *)data;
+
+  while (true) {
+    const std::size_t n = queue.push(p, size);
+    p += n;
+    size -= n;
+
+    /* pairs with the fence in Tick(): either the thread sees the new
+       data before going to sleep, or we see #idle */
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (size == 0 && !idle.load(std::memory_order_relaxed) &&
+        !failed.load(std::memory_order_relaxed))
+      return;
+
+    std::unique_lock<Mutex> lock(mutex);
+
+    if (error)
+      std::rethrow_exception(error);
+
+    idle.store(false, std::memory_order_relaxed);
+    Trigger();
+
+    if (size == 0)
+      return;
+
+    /* the queue is full; wait for the thread to make room */
+    WaitDone(lock);
+  }
+}
+
+void
+LoggerOutputThread::Tick() noexcept
+{
+  while (!error) {
+    const auto now = Clock::now();
+    const bool sync = sync_requested || now - last_sync >= sync_interval;
+    sync_requested = false;
+
+    std::exception_ptr e;
+
+    {
+      const ScopeUnlock unlock(mutex);
+
+      try {
+        /* write everything which has accumulated so far (two
+           chunks if the data wraps around the end of the ring) */
+        for (auto r = queue.Read(); !r.empty(); r = queue.Read()) {
+          file.Write(r.data, r.size);
+          queue.Consume(r.size);
+        }
+
+        if (sync)
+          file.Sync();
+      } catch (...) {
+        e = std::current_exception();
+      }
+    }
+
+    if (e) {
+      error = std::move(e);
+      failed.store(true, std::memory_order_relaxed);
+    } else if (sync)
+      last_sync = now;
+
+    if (sync_requested)
+      continue;
+
+    /* go to sleep unless Write() has appended more data meanwhile */
+    idle.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (queue.empty())
+      break;
+
+    idle.store(false, std::memory_order_relaxed);
+  }
+}
@@ -0,0 +1,126 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_LOGGER_OUTPUT_THREAD_HPP
+#define XCSOAR_LOGGER_OUTPUT_THREAD_HPP
+
+#include "thread/StandbyThread.hpp"
+#include "io/OutputStream.hxx"
+#include "io/FileOutputStream.hxx"
+#include "util/LockFreeRingBuffer.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+
+class Path;
+
+/**
+ * An #OutputStream which writes to a file in a separate thread, so
+ * the caller (the calculation thread) never blocks on slow storage.
+ *
+ * Data passed to Write() is appended to a lock-free queue; the
+ * thread writes everything that has accumulated, and syncs the file
+ * to the storage device at most once per sync interval.  Flush()
+ * waits until all queued data has been written and synced.
+ *
+ * Write() locks the mutex only to wake up the idle thread, to report
+ * an error or if the queue is full.  Write() and Flush() must be
+ * called from the same thread.
+ *
+ * Errors which occur in the thread are rethrown by the next Write()
+ * or Flush() call.
+ */
+class LoggerOutputThread final : public OutputStream, private StandbyThread {
+  using Clock = std::chrono::steady_clock;
+
+  FileOutputStream file;
+
+  const Clock::duration sync_interval;
+
+  /**
+   * Data which has not yet been written by the thread.  Write() is
+   * the producer, Tick() the consumer.
+   */
+  LockFreeRingBuffer<std::byte, 65536> queue;
+
+  /**
+   * Has the thread found the queue empty and is about to go to
+   * sleep (or was never started)?  Write() triggers the thread only
+   * if this is set.
+   */
+  std::atomic_bool idle{true};
+
+  /**
+   * Set when #error is set, so Write() can check for errors without
+   * locking the mutex.
+   */
+  std::atomic_bool failed{false};
+
+  /**
+   * The last time the file was synced.  Only used by the thread.
+   */
+  Clock::time_point last_sync;
+
+  /**
+   * Was a sync requested by Flush()?  Protected by
+   * StandbyThread::mutex.
+   */
+  bool sync_requested = false;
+
+  /**
+   * The error which occurred in the thread.  Protected by
+   * StandbyThread::mutex.
+   */
+  std::exception_ptr error;
+
+public:
+  /**
+   * Throws on error.
+   */
+  LoggerOutputThread(Path path, Clock::duration _sync_interval);
+
+  /**
+   * Stops the thread.  Data which was not flushed with Flush() may
+   * be lost.
+   */
+  ~LoggerOutputThread() noexcept;
+
+  /**
+   * Wait until all queued data has been written and synced to the
+   * storage device.
+   *
+   * Throws on error.
+   */
+  void Flush();
+
+  /* virtual methods from class OutputStream */
+  void Write(const void *data, size_t size) override;
+
+private:
+  /* virtual methods from class StandbyThread */
+  void Tick() noexcept override;
+};
+
+#endif
@@ -23,38 +23,101 @@ Copyright_License {
 
 #include "Logger/NMEALogger.hpp"
 #include "io/TextWriter.hpp"
+#include "io/FileOutputStream.hxx"
+#include "io/GzipOutputStream.hxx"
+#include "io/BufferedOutputStream.hxx"
 #include "LocalPath.hpp"
+#include "LogFile.hpp"
 #include "time/BrokenDateTime.hpp"
 #include "thread/Mutex.hxx"
 #include "system/Path.hpp"
 #include "util/StaticString.hxx"
 
+#include <memory>
+
 namespace NMEALogger
 {
+  /**
+   * Writes a gzip-compressed log file.  The lines are collected in a
+   * #BufferedOutputStream, so zlib only sees large chunks.
+   */
+  class CompressedWriter {
+    FileOutputStream file;
+    GzipOutputStream gzip;
+    BufferedOutputStream buffered;
+
+  public:
+    /**
+     * Throws on error.
+     */
+    explicit CompressedWriter(Path path)
+      /* visible, so a partial file can be recovered after a crash */
+      :file(path, FileOutputStream::Mode::CREATE_VISIBLE),
+       gzip(file), buffered(gzip) {}
+
+    void WriteLine(const char *line) {
+      buffered.Write(line);
+      buffered.Write('\n');
+    }
+
+    void Finish() {
+      buffered.Flush();
+      gzip.Finish();
+      file.Commit();
+    }
+  };
+
   static Mutex mutex;
   static TextWriter *writer;
+  static std::unique_ptr<CompressedWriter> compressed_writer;
 
   bool enabled = false;
+  bool compress = false;
 
   static bool Start();
+  static bool StartCompressed(Path logs_path, BrokenDateTime dt);
+}
+
+bool
+NMEALogger::StartCompressed(Path logs_path, BrokenDateTime dt)
+{
+  StaticString<64> name;
+  name.Format(_T("%04u-%02u-%02u_%02u-%02u.nmea.gz"),
+              dt.year, dt.month, dt.day,
+              dt.hour, dt.minute);
+
+  try {
+    compressed_writer =
+      std::make_unique<CompressedWriter>(AllocatedPath::Build(logs_path,
+                                                              name));
+    return true;
+  } catch (...) {
+    LogError(std::current_exception());
+    /* don't retry with every line */
+    enabled = false;
+    return false;
+  }
 }
 
 bool
 NMEALogger::Start()
 {
-  if (writer != nullptr)
+  if (writer != nullptr || compressed_writer != nullptr)
     return true;
 
   BrokenDateTime dt = BrokenDateTime::NowUTC();
   assert(dt.IsPlausible());
 
+  const auto logs_path = MakeLocalPath(_T("logs"));
+
+  if (compress)
+    return StartCompressed(logs_path, dt);
+
   StaticString<64> name;
   name.Format(_T("%04u-%02u-%02u_%02u-%02u.nmea"),
               dt.year, dt.month, dt.day,
               dt.hour, dt.minute);
 
-  const auto logs_path = MakeLocalPath(_T("logs"));
-
   const auto path = AllocatedPath::Build(logs_path, name);
   writer = new TextWriter(path, false);
   if (writer == nullptr)
@@ -72,7 +135,19 @@ NMEALogger::Start()
 void
 NMEALogger::Shutdown()
 {
+  std::lock_guard<Mutex> lock(mutex);
+
   delete writer;
+
+  if (compressed_writer != nullptr) {
+    try {
+      compressed_writer->Finish();
+    } catch (...) {
+      LogError(std::current_exception());
+    }
+
+    compressed_writer.reset();
+  }
 }
 
 void
@@ -82,6 +157,17 @@ NMEALogger::Log(const char *text)
     return;
 
   std::lock_guard<Mutex> lock(mutex);
-  if (Start())
+  if (!Start())
+    return;
+
+  if (compressed_writer != nullptr) {
+    try {
+      compressed_writer->WriteLine(text);
+    } catch (...) {
+      LogError(std::current_exception());
+      compressed_writer.reset();
+      enabled = false;
+    }
+  } else
     writer->WriteLine(text);
 }
@@ -28,6 +28,12 @@ namespace NMEALogger
 {
   extern bool enabled;
 
+  /**
+   * Write a gzip-compressed file (.nmea.gz)?  This is only applied
+   * when a new log file is created.
+   */
+  extern bool compress;
+
   void Shutdown();
 
   /**
@@ -38,4 +38,5 @@ LoggerSettings::SetDefaults()
   enable_flight_logger = false;
 
   enable_nmea_logger = false;
+  compress_nmea_logger = false;
 }
@@ -42,6 +42,11 @@ struct LoggerSettings {
    */
   bool enable_nmea_logger;
 
+  /**
+   * Write the #NMEALogger file gzip-compressed?
+   */
+  bool compress_nmea_logger;
+
   /** Logger interval in cruise mode */
   std::chrono::duration<unsigned> time_step_cruise;
 
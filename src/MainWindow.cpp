@@ -34,6 +34,8 @@ Copyright_License {
 #include "Dialogs/Airspace/AirspaceWarningDialog.hpp"
 #include "Audio/Sound.hpp"
 #include "Components.hpp"
+#include "CalculationThread.hpp"
+#include "Startup.hpp"
 #include "ProcessTimer.hpp"
 #include "LogFile.hpp"
 #include "Gauge/GaugeFLARM.hpp"
@@ -700,6 +702,9 @@ MainWindow::LateInitialise() noexcept
        properly only if the main event loop runs */
     devices->Open(env);
   }
+
+  /* the first map frame has been drawn; now load the rest */
+  LateStartup();
 }
 
 void
@@ -730,7 +735,31 @@ MainWindow::RunTimer() noexcept
     }
   }
 
-  battery_timer.Process();
+  battery_timer.Process(power_policy);
+  ApplyPowerPolicy();
+}
+
+void
+MainWindow::ApplyPowerPolicy() noexcept
+{
+  const bool saving = power_policy.IsSaving();
+  const bool screen_off =
+    power_policy.GetMode() == PowerPolicy::Mode::SCREEN_OFF;
+
+  UIState &state = CommonInterface::SetUIState();
+  if (saving == state.power_saving && screen_off == state.screen_blanked)
+    return;
+
+  state.power_saving = saving;
+  state.screen_blanked = screen_off;
+
+  if (calculation_thread != nullptr)
+    calculation_thread->SetPowerSaving(saving);
+
+  if (map != nullptr) {
+    map->SetUIState(state);
+    map->FullRedraw();
+  }
 }
 
 void
@@ -778,6 +807,28 @@ MainWindow::OnClose() noexcept
   return true;
 }
 
+#ifdef ANDROID
+
+void
+MainWindow::OnPause() noexcept
+{
+  power_policy.SetScreenOff(true);
+  ApplyPowerPolicy();
+
+  SingleWindow::OnPause();
+}
+
+void
+MainWindow::OnResume() noexcept
+{
+  power_policy.SetScreenOff(false);
+  ApplyPowerPolicy();
+
+  SingleWindow::OnResume();
+}
+
+#endif
+
 void
 MainWindow::OnPaint(Canvas &canvas)
 {
@@ -849,7 +900,11 @@ MainWindow::SetUIState(const UIState &ui_state) noexcept
 {
   if (map != nullptr) {
     map->SetUIState(ui_state);
-    map->FullRedraw();
+
+    /* while saving power, new calculation results are not drawn
+       immediately */
+    if (power_policy.CheckRedraw())
+      map->FullRedraw();
   }
 }
 
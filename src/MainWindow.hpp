@@ -28,6 +28,7 @@ Copyright_License {
 #include "ui/event/PeriodicTimer.hpp"
 #include "ui/event/Notify.hpp"
 #include "BatteryTimer.hpp"
+#include "PowerPolicy.hpp"
 #include "Widget/ManagedWidget.hpp"
 #include "UIUtil/GestureManager.hpp"
 
@@ -121,6 +122,8 @@ private:
 
   BatteryTimer battery_timer;
 
+  PowerPolicy power_policy;
+
   PixelRect map_rect;
   bool FullScreen = false;
 
@@ -304,6 +307,10 @@ public:
   void SetMapSettings(const MapSettings &settings_map) noexcept;
   void SetUIState(const UIState &ui_state) noexcept;
 
+  const PowerPolicy &GetPowerPolicy() const noexcept {
+    return power_policy;
+  }
+
   /**
    * Returns the map even if it is not active.  May return nullptr if
    * there is no map.
@@ -387,6 +394,12 @@ private:
 
   void RunTimer() noexcept;
 
+  /**
+   * Pass the current #PowerPolicy decision to the calculation
+   * thread and to the map (via #UIState).
+   */
+  void ApplyPowerPolicy() noexcept;
+
   void OnGpsNotify() noexcept;
   void OnCalculatedNotify() noexcept;
   void OnRestorePageNotify() noexcept;
@@ -408,6 +421,11 @@ protected:
 
   /* virtual methods from class TopWindow */
   virtual bool OnClose() noexcept override;
+
+#ifdef ANDROID
+  void OnPause() noexcept override;
+  void OnResume() noexcept override;
+#endif
 };
 
 #endif
@@ -67,6 +67,7 @@ MapSettings::SetDefaults()
   vario_bar_enabled = false;
   show_fai_triangle_areas = false;
   skylines_traffic_map_mode = DisplaySkyLinesTrafficMapMode::SYMBOL;
+  frame_profiler = false;
 
   trail.SetDefaults();
   item_list.SetDefaults();
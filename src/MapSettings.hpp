@@ -198,6 +198,12 @@ struct MapSettings {
    */
   DisplaySkyLinesTrafficMapMode skylines_traffic_map_mode;
 
+  /**
+   * Collect render stage timings (see #FrameProfiler), show them in
+   * the status dialog and write them to the log file.
+   */
+  bool frame_profiler;
+
   FAITriangleSettings fai_triangle_settings;
 
   TrailSettings trail;
@@ -28,6 +28,7 @@ Copyright_License {
 #include "time/PeriodClock.hpp"
 #include "UIUtil/TrackingGestureManager.hpp"
 #include "UIUtil/KineticManager.hpp"
+#include "UIUtil/MotionPredictor.hpp"
 #include "Renderer/ThermalBandRenderer.hpp"
 #include "Renderer/FinalGlideBarRenderer.hpp"
 #include "Renderer/VarioBarRenderer.hpp"
@@ -67,6 +68,17 @@ class GlueMapWindow : public MapWindow {
 
   TerrainThread *terrain_thread = nullptr;
 
+  /**
+   * Limits how often the task is queried for terrain prefetching.
+   */
+  PeriodClock prefetch_task_clock;
+
+  /**
+   * The task point after the active one, for terrain prefetching.
+   * Obtained from the #TaskManager every few seconds.
+   */
+  GeoPoint prefetch_next_task_point = GeoPoint::Invalid();
+
   PeriodClock mouse_down_clock;
 
   enum DragMode {
@@ -96,6 +108,18 @@ class GlueMapWindow : public MapWindow {
   UI::PeriodicTimer kinetic_timer{[this]{ OnKineticTimer(); }};
 #endif
 
+  /**
+   * While panning, the projection is updated at most once per
+   * frame.  This is the most recent pointer position which has not
+   * yet been applied, and #pan_timer applies it at the next frame.
+   * After a predicted position was applied, #pan_timer also applies
+   * the real one once the pointer has come to rest.
+   */
+  PixelPoint pan_position;
+  PeriodClock pan_clock;
+  MotionPredictor pan_predictor;
+  UI::Timer pan_timer{[this]{ OnPanTimer(); }};
+
   /** flag to indicate if the MapItemList should be shown on mouse up */
   bool arm_mapitem_list = false;
 
@@ -261,6 +285,12 @@ private:
    */
   void UpdateScreenBounds();
 
+  /**
+   * Tell the #TerrainThread which areas will probably become visible
+   * soon: ahead of the aircraft and around the next task points.
+   */
+  void UpdateTerrainPrefetch();
+
   void UpdateScreenAngle();
   void UpdateProjection();
 
@@ -298,6 +328,30 @@ protected:
 private:
   void OnMapItemTimer() noexcept;
 
+  /**
+   * Start a new pan movement at the specified pointer position.
+   */
+  void BeginPan(PixelPoint p) noexcept;
+
+  /**
+   * Move the map so the drag start point is below the specified
+   * pointer position.
+   */
+  void ApplyPan(PixelPoint p) noexcept;
+
+  /**
+   * Apply the predicted pointer position (see #pan_predictor).
+   */
+  void ApplyPredictedPan() noexcept;
+
+  /**
+   * Apply the specified final pointer position immediately, without
+   * prediction.
+   */
+  void FlushPan(PixelPoint p) noexcept;
+
+  void OnPanTimer() noexcept;
+
 #ifdef ENABLE_OPENGL
   void OnKineticTimer() noexcept;
 #endif
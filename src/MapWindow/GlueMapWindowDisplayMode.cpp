@@ -25,6 +25,11 @@ Copyright_License {
 #include "Terrain/RasterTerrain.hpp"
 #include "Topography/Thread.hpp"
 #include "Terrain/Thread.hpp"
+#include "Task/ProtectedTaskManager.hpp"
+#include "Engine/Task/TaskManager.hpp"
+#include "Engine/Task/Ordered/OrderedTask.hpp"
+#include "Engine/Task/Ordered/Points/OrderedTaskPoint.hpp"
+#include "Geo/GeoVector.hpp"
 #include "Interface.hpp"
 #include "Profile/Profile.hpp"
 #include "Screen/Layout.hpp"
@@ -122,8 +127,47 @@ GlueMapWindow::UpdateScreenBounds()
      it's used by other calculations, therefore don't check if terrain
      display is enabled */
   if (terrain_thread != nullptr &&
-      visible_projection.IsValid())
+      visible_projection.IsValid()) {
     terrain_thread->Trigger(visible_projection);
+    UpdateTerrainPrefetch();
+  }
+}
+
+void
+GlueMapWindow::UpdateTerrainPrefetch()
+{
+  const MoreData &basic = CommonInterface::Basic();
+  const DerivedInfo &calculated = CommonInterface::Calculated();
+
+  StaticArray<GeoPoint, TerrainThread::MAX_PREFETCH> prefetch;
+
+  /* the area the aircraft will be in after one and three minutes */
+  if (basic.location_available && basic.track_available &&
+      basic.MovementDetected()) {
+    for (const unsigned seconds : {60u, 180u})
+      prefetch.append(GeoVector(basic.ground_speed * seconds, basic.track)
+                      .EndPoint(basic.location));
+  }
+
+  /* the active task point and the one after it */
+  if (calculated.task_stats.task_valid &&
+      calculated.task_stats.current_leg.location_remaining.IsValid())
+    prefetch.append(calculated.task_stats.current_leg.location_remaining);
+
+  if (task != nullptr &&
+      prefetch_task_clock.CheckUpdate(std::chrono::seconds(10))) {
+    ProtectedTaskManager::Lease lease(*task);
+    const unsigned next = lease->GetActiveTaskPointIndex() + 1;
+    prefetch_next_task_point =
+      lease->GetMode() == TaskType::ORDERED && next < lease->TaskSize()
+      ? lease->GetOrderedTask().GetTaskPoint(next).GetLocationRemaining()
+      : GeoPoint::Invalid();
+  }
+
+  if (prefetch_next_task_point.IsValid() && !prefetch.full())
+    prefetch.append(prefetch_next_task_point);
+
+  terrain_thread->SetPrefetch({prefetch.begin(), prefetch.size()});
 }
 
 void
@@ -44,6 +44,27 @@ Copyright_License {
 #include <SDL_keyboard.h>
 #endif
 
+/**
+ * The minimum interval between two projection updates while
+ * panning.  Software rendering is much slower than OpenGL, and
+ * there's no point in moving the map faster than it can be drawn.
+ */
+#ifdef ENABLE_OPENGL
+static constexpr std::chrono::milliseconds PAN_FRAME_INTERVAL{16};
+#else
+static constexpr std::chrono::milliseconds PAN_FRAME_INTERVAL{40};
+#endif
+
+/**
+ * Extrapolate the pointer position to the time the frame becomes
+ * visible, so the map appears to stick to the finger.
+ */
+static PixelPoint
+PredictPan(const MotionPredictor &predictor) noexcept
+{
+  return predictor.Predict(PAN_FRAME_INTERVAL, Layout::Scale(16));
+}
+
 void
 GlueMapWindow::OnCreate()
 {
@@ -64,6 +85,7 @@ GlueMapWindow::OnDestroy()
 #endif
 
   map_item_timer.Cancel();
+  pan_timer.Cancel();
 
   MapWindow::OnDestroy();
 }
@@ -98,10 +120,18 @@ GlueMapWindow::OnMouseMove(PixelPoint p, unsigned keys)
   case DRAG_MULTI_TOUCH_PAN:
 #endif
   case DRAG_PAN:
-    SetLocation(drag_projection.GetGeoLocation()
-                + drag_start_geopoint
-                - drag_projection.ScreenToGeo(p));
-    QuickRedraw();
+    pan_position = p;
+    pan_predictor.Update(p);
+
+    /* the event queue coalesces motion events, but they may still
+       arrive faster than the map can be drawn; defer this one to the
+       next frame */
+    if (pan_clock.CheckUpdate(PAN_FRAME_INTERVAL))
+      ApplyPredictedPan();
+    else
+      /* this replaces a pending ApplyPredictedPan() follow-up,
+         which would fire later */
+      pan_timer.Schedule(PAN_FRAME_INTERVAL - pan_clock.Elapsed());
 
 #ifdef ENABLE_OPENGL
     kinetic_x.MouseMove(p.x);
@@ -184,6 +214,7 @@ GlueMapWindow::OnMouseDown(PixelPoint p)
   case FOLLOW_PAN:
     drag_mode = DRAG_PAN;
     drag_projection = visible_projection;
+    BeginPan(p);
 
 #ifdef ENABLE_OPENGL
     kinetic_x.MouseDown(p.x);
@@ -234,12 +265,15 @@ GlueMapWindow::OnMouseUp(PixelPoint p)
 
 #ifdef HAVE_MULTI_TOUCH
   case DRAG_MULTI_TOUCH_PAN:
+    FlushPan(pan_position);
     follow_mode = FOLLOW_SELF;
     ::PanTo(visible_projection.GetGeoScreenCenter());
     return true;
 #endif
 
   case DRAG_PAN:
+    FlushPan(p);
+
 #ifndef ENABLE_OPENGL
     /* allow the use of the stretched last buffer for the next two
        redraws */
@@ -336,6 +370,7 @@ GlueMapWindow::OnMultiTouchDown()
   drag_mode = DRAG_MULTI_TOUCH_PAN;
   drag_projection = visible_projection;
   follow_mode = FOLLOW_PAN;
+  BeginPan(drag_start);
   return true;
 }
 
@@ -386,6 +421,7 @@ GlueMapWindow::OnCancelMode()
 #endif
 
   map_item_timer.Cancel();
+  pan_timer.Cancel();
 }
 
 void
@@ -431,6 +467,61 @@ GlueMapWindow::OnMapItemTimer() noexcept
   ShowMapItems(drag_start_geopoint, false);
 }
 
+void
+GlueMapWindow::BeginPan(PixelPoint p) noexcept
+{
+  pan_timer.Cancel();
+  pan_position = p;
+  pan_predictor.Reset(p);
+  pan_clock.Reset();
+}
+
+void
+GlueMapWindow::ApplyPan(PixelPoint p) noexcept
+{
+  SetLocation(drag_projection.GetGeoLocation()
+              + drag_start_geopoint
+              - drag_projection.ScreenToGeo(p));
+  QuickRedraw();
+}
+
+void
+GlueMapWindow::ApplyPredictedPan() noexcept
+{
+  const PixelPoint p = PredictPan(pan_predictor);
+  ApplyPan(p);
+
+  if (p != pan_position)
+    /* if the pointer stops without being released, no further
+       event arrives; apply the real position as soon as the
+       predictor considers the pointer stationary */
+    pan_timer.Schedule(MotionPredictor::REST_INTERVAL);
+}
+
+void
+GlueMapWindow::FlushPan(PixelPoint p) noexcept
+{
+  pan_timer.Cancel();
+  ApplyPan(p);
+}
+
+void
+GlueMapWindow::OnPanTimer() noexcept
+{
+  switch (drag_mode) {
+#ifdef HAVE_MULTI_TOUCH
+  case DRAG_MULTI_TOUCH_PAN:
+#endif
+  case DRAG_PAN:
+    pan_clock.Update();
+    ApplyPredictedPan();
+    break;
+
+  default:
+    break;
+  }
+}
+
 #ifdef ENABLE_OPENGL
 
 void
@@ -458,6 +549,7 @@ GlueMapWindow::Render(Canvas &canvas, const PixelRect &rc)
 
   if (IsNearSelf()) {
     draw_sw.Mark("DrawGlueMisc");
+    frame_profiler.Mark(FrameProfiler::Stage::OVERLAYS);
     if (GetMapSettings().show_thermal_profile)
       DrawThermalBand(canvas, rc);
     DrawStallRatio(canvas, rc);
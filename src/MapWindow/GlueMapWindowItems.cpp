@@ -86,7 +86,10 @@ GlueMapWindow::ShowMapItems(const GeoPoint &location,
     builder.AddWeatherStations(*noaa_store);
 #endif
 
-  builder.AddTraffic(basic.flarm.traffic);
+  builder.AddTraffic(basic.flarm.traffic,
+                     basic.location_available
+                     ? basic.location
+                     : GeoPoint::Invalid());
 
 #ifdef HAVE_SKYLINES_TRACKING
   builder.AddSkyLinesTraffic();
@@ -103,9 +103,14 @@ MapItemListBuilder::AddSelfIfNear(const GeoPoint &self, Angle bearing)
 void
 MapItemListBuilder::AddWaypoints(const Waypoints &waypoints)
 {
-  waypoints.VisitWithinRange(location, range, [&list=list](const auto &w){
-    if (!list.full())
-      list.append(new WaypointMapItem(w));
+  if (list.full())
+    return;
+
+  /* if there are more waypoints in range than the list can hold,
+     show the nearest ones */
+  waypoints.VisitNearest(location, range, list.capacity() - list.size(),
+                         [&list=list](const auto &w){
+    list.append(new WaypointMapItem(w));
   });
 }
 
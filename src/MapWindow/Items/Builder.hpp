@@ -64,7 +64,11 @@ public:
                           const AirspaceRendererSettings &renderer_settings,
                           const MoreData &basic, const DerivedInfo &calculated);
   void AddTaskOZs(const ProtectedTaskManager &task);
-  void AddTraffic(const TrafficList &flarm);
+  /**
+   * @param aircraft the own location, which is the origin of the
+   * relative traffic positions; may be invalid
+   */
+  void AddTraffic(const TrafficList &flarm, const GeoPoint &aircraft);
   void AddSkyLinesTraffic();
   void AddThermals(const ThermalLocatorInfo &thermals,
                    const MoreData &basic, const DerivedInfo &calculated);
@@ -26,22 +26,38 @@ Copyright_License {
 #include "List.hpp"
 #include "FLARM/List.hpp"
 #include "FLARM/Friends.hpp"
+#include "Geo/GeoVector.hpp"
 #include "Tracking/SkyLines/Data.hpp"
 #include "Tracking/TrackingGlue.hpp"
 #include "Components.hpp"
 
 void
-MapItemListBuilder::AddTraffic(const TrafficList &flarm)
+MapItemListBuilder::AddTraffic(const TrafficList &flarm,
+                               const GeoPoint &aircraft)
 {
-  for (const auto &t : flarm.list) {
+  auto add = [this](const FlarmTraffic &t){
     if (list.full())
-      break;
+      return;
 
     if (location.DistanceS(t.location) < range) {
       auto color = FlarmFriends::GetFriendColor(t.id);
       list.append(new TrafficMapItem(t.id, color));
     }
+  };
+
+  if (!aircraft.IsValid()) {
+    for (const auto &t : flarm.list)
+      add(t);
+    return;
   }
+
+  /* look up candidates in the spatial grid; the margin covers the
+     difference between the relative positions and the geodesic
+     distance checked above */
+  const GeoVector vec = aircraft.DistanceBearing(location);
+  flarm.VisitWithin(vec.distance * vec.bearing.cos(),
+                    vec.distance * vec.bearing.sin(),
+                    range * 1.1 + 100, add);
 }
 
 void
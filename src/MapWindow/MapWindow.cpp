@@ -75,6 +75,9 @@ void
 MapWindow::FlushCaches()
 {
   background.Flush();
+#ifndef ENABLE_OPENGL
+  ground_cache.Invalidate();
+#endif
   if (rasp_renderer)
     rasp_renderer->Flush();
   airspace_renderer.Flush();
@@ -132,6 +135,9 @@ MapWindow::OnPaintBuffer(Canvas &canvas) noexcept
   unsigned render_generation = ui_generation;
 #endif
 
+  frame_profiler.SetEnabled(GetMapSettings().frame_profiler);
+  frame_profiler.Begin(FrameProfiler::Stage::OVERLAYS);
+
 #ifdef ENABLE_OPENGL
   GLCanvasScissor scissor(canvas);
 #endif
@@ -139,6 +145,7 @@ MapWindow::OnPaintBuffer(Canvas &canvas) noexcept
   // Render the moving map
   Render(canvas, GetClientRect());
   draw_sw.Finish();
+  frame_profiler.Finish();
 
 #ifndef ENABLE_OPENGL
   /* save the generation number which was active when rendering had
@@ -153,6 +160,10 @@ MapWindow::SetTopography(TopographyStore *_topography)
 {
   topography = _topography;
 
+#ifndef ENABLE_OPENGL
+  ground_cache.Invalidate();
+#endif
+
   delete topography_renderer;
   topography_renderer = topography != nullptr
     ? new CachedTopographyRenderer(*topography, look.topography)
@@ -164,6 +175,10 @@ MapWindow::SetTerrain(RasterTerrain *_terrain)
 {
   terrain = _terrain;
   background.SetTerrain(_terrain);
+
+#ifndef ENABLE_OPENGL
+  ground_cache.Invalidate();
+#endif
 }
 
 void
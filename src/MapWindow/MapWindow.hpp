@@ -32,11 +32,15 @@ Copyright_License {
 #endif
 #include "Renderer/LabelBlock.hpp"
 #include "Screen/StopWatch.hpp"
+#include "Screen/FrameProfiler.hpp"
 #include "MapWindowBlackboard.hpp"
 #include "Renderer/AirspaceLabelRenderer.hpp"
 #include "Renderer/BackgroundRenderer.hpp"
 #include "Renderer/WaypointRenderer.hpp"
 #include "Renderer/TrailRenderer.hpp"
+#include "Renderer/TransparentRendererCache.hpp"
+#include "Terrain/TerrainSettings.hpp"
+#include "util/Serial.hpp"
 #include "util/Compiler.h"
 #include "Weather/Features.hpp"
 #include "Tracking/SkyLines/Features.hpp"
@@ -174,6 +178,36 @@ protected:
    * zooming and panning, to give instant visual feedback.
    */
   unsigned scale_buffer = 0;
+
+  /**
+   * The inputs of #ground_cache, apart from the projection.
+   */
+  struct GroundCacheKey {
+    Serial terrain_serial;
+    unsigned topography_serial;
+    TerrainRendererSettings terrain_settings;
+    Angle shading_angle;
+    bool topography_enabled;
+
+    [[gnu::pure]]
+    bool Compare(const GroundCacheKey &other) const noexcept {
+      return terrain_serial == other.terrain_serial &&
+        topography_serial == other.topography_serial &&
+        terrain_settings == other.terrain_settings &&
+        shading_angle.CompareRoughly(other.shading_angle) &&
+        topography_enabled == other.topography_enabled;
+    }
+  };
+
+  /**
+   * The terrain and the topography composed into one opaque buffer.
+   * These layers change only when the map is moved by at least one
+   * pixel, so the buffer can be reused for frames in which only
+   * other items (e.g. traffic) have changed, saving a stretched and
+   * a transparent full-screen copy.
+   */
+  TransparentRendererCache ground_cache;
+  GroundCacheKey ground_cache_key;
 #endif
 
   /**
@@ -182,6 +216,12 @@ protected:
    */
   ScreenStopWatch draw_sw;
 
+  /**
+   * Collects render stage timings if MapSettings::frame_profiler is
+   * enabled.
+   */
+  FrameProfiler frame_profiler;
+
   friend class DrawThread;
 
 public:
@@ -189,6 +229,10 @@ public:
             const TrafficLook &traffic_look);
   virtual ~MapWindow();
 
+  const FrameProfiler &GetFrameProfiler() const noexcept {
+    return frame_profiler;
+  }
+
   /**
    * Is the rendered map following the user's aircraft (i.e. near it)?
    */
@@ -347,6 +391,12 @@ private:
 
   void RenderRasp(Canvas &canvas);
 
+  /**
+   * Renders terrain, RASP and topography, from #ground_cache if
+   * possible.
+   */
+  void RenderGround(Canvas &canvas);
+
   void RenderTerrainAbove(Canvas &canvas, bool working);
 
   /**
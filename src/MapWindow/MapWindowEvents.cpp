@@ -93,9 +93,12 @@ MapWindow::OnPaint(Canvas &canvas)
 #ifdef ENABLE_OPENGL
   DoubleBufferWindow::OnPaint(canvas);
 #else /* !ENABLE_OPENGL */
-  if (buffer_generation == ui_generation)
+  if (buffer_generation == ui_generation) {
+    const auto start = std::chrono::steady_clock::now();
     DoubleBufferWindow::OnPaint(canvas);
-  else if (scale_buffer > 0 && visible_projection.IsValid() &&
+    frame_profiler.Add(FrameProfiler::Stage::FLIP,
+                       std::chrono::steady_clock::now() - start);
+  } else if (scale_buffer > 0 && visible_projection.IsValid() &&
            buffer_projection.IsValid()) {
     /* while zooming/panning, project the current buffer into the
        Canvas */
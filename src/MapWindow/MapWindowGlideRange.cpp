@@ -29,6 +29,7 @@ Copyright_License {
 #ifdef ENABLE_OPENGL
 #include "ui/canvas/opengl/Scope.hpp"
 #include "ui/canvas/opengl/VertexPointer.hpp"
+#include "ui/canvas/opengl/Statistics.hpp"
 #include "ui/canvas/opengl/Triangulate.hpp"
 #endif
 
@@ -64,12 +65,12 @@ struct ProjectedFan {
     for (unsigned i = 0; i < idx_count; ++i)
       triangle_buffer[i] += start;
 
-    glDrawElements(GL_TRIANGLES, idx_count, GL_UNSIGNED_SHORT,
-                   triangle_buffer.begin());
+    OpenGL::DrawElements(GL_TRIANGLES, idx_count, GL_UNSIGNED_SHORT,
+                         triangle_buffer.begin());
   }
 
   void DrawOutline(unsigned start) const {
-    glDrawArrays(GL_LINE_LOOP, start, size);
+    OpenGL::DrawArrays(GL_LINE_LOOP, start, size);
   }
 #else
   void DrawFill(Canvas &canvas, const BulkPixelPoint *points) const {
@@ -27,6 +27,8 @@ Copyright_License {
 #include "Weather/Rasp/RaspRenderer.hpp"
 #include "Weather/Rasp/RaspCache.hpp"
 #include "Topography/CachedTopographyRenderer.hpp"
+#include "Topography/TopographyStore.hpp"
+#include "Terrain/RasterTerrain.hpp"
 #include "Renderer/AircraftRenderer.hpp"
 #include "Renderer/WaveRenderer.hpp"
 #include "Operation/Operation.hpp"
@@ -46,8 +48,7 @@ MapWindow::RenderTrackBearing(Canvas &canvas, const PixelPoint aircraft_pos)
 inline void
 MapWindow::RenderTerrain(Canvas &canvas)
 {
-  background.SetShadingAngle(render_projection, GetMapSettings().terrain,
-                             Calculated());
+  background.SetPowerSaving(GetUIState().power_saving);
   background.Draw(canvas, render_projection, GetMapSettings().terrain);
 }
 
@@ -95,6 +96,56 @@ MapWindow::RenderTopography(Canvas &canvas)
     topography_renderer->Draw(canvas, render_projection);
 }
 
+void
+MapWindow::RenderGround(Canvas &canvas)
+{
+  background.SetShadingAngle(render_projection, GetMapSettings().terrain,
+                             Calculated());
+
+#ifndef ENABLE_OPENGL
+  /* RASP has its own time-dependent state, and is not cached */
+  if (rasp_store == nullptr || GetUIState().weather.map < 0) {
+    const GroundCacheKey key{
+      terrain != nullptr ? terrain->GetSerial() : Serial{},
+      topography != nullptr ? topography->GetSerial() : 0,
+      GetMapSettings().terrain,
+      background.GetShadingAngle(),
+      GetMapSettings().topography_enabled,
+    };
+
+    if (!key.Compare(ground_cache_key) ||
+        !ground_cache.Check(render_projection)) {
+      ground_cache_key = key;
+
+      Canvas &buffer = ground_cache.Begin(canvas, render_projection);
+
+      frame_profiler.Mark(FrameProfiler::Stage::TERRAIN);
+      RenderTerrain(buffer);
+
+      frame_profiler.Mark(FrameProfiler::Stage::TOPOGRAPHY);
+      RenderTopography(buffer);
+
+      ground_cache.Commit(canvas, render_projection);
+    }
+
+    ground_cache.CopyTo(canvas, render_projection);
+    return;
+  }
+
+  ground_cache.Invalidate();
+#endif
+
+  frame_profiler.Mark(FrameProfiler::Stage::TERRAIN);
+  RenderTerrain(canvas);
+
+  draw_sw.Mark("RenderRasp");
+  RenderRasp(canvas);
+
+  draw_sw.Mark("RenderTopography");
+  frame_profiler.Mark(FrameProfiler::Stage::TOPOGRAPHY);
+  RenderTopography(canvas);
+}
+
 inline void
 MapWindow::RenderTopographyLabels(Canvas &canvas)
 {
@@ -210,15 +261,10 @@ MapWindow::Render(Canvas &canvas, const PixelRect &rc)
 
   // Render terrain, groundline and topography
   draw_sw.Mark("RenderTerrain");
-  RenderTerrain(canvas);
-
-  draw_sw.Mark("RenderRasp");
-  RenderRasp(canvas);
-
-  draw_sw.Mark("RenderTopography");
-  RenderTopography(canvas);
+  RenderGround(canvas);
 
   draw_sw.Mark("RenderOverlays");
+  frame_profiler.Mark(FrameProfiler::Stage::OVERLAYS);
   RenderOverlays(canvas);
 
   draw_sw.Mark("DrawNOAAStations");
@@ -227,31 +273,37 @@ MapWindow::Render(Canvas &canvas, const PixelRect &rc)
   //////////////////////////////////////////////// glide range info
 
   draw_sw.Mark("RenderFinalGlideShading");
+  frame_profiler.Mark(FrameProfiler::Stage::TERRAIN);
   RenderFinalGlideShading(canvas);
 
   //////////////////////////////////////////////// airspace
 
   // Render airspace
   draw_sw.Mark("RenderAirspace");
+  frame_profiler.Mark(FrameProfiler::Stage::AIRSPACE);
   RenderAirspace(canvas);
 
   //////////////////////////////////////////////// task
 
   // Render task, waypoints
   draw_sw.Mark("DrawContest");
+  frame_profiler.Mark(FrameProfiler::Stage::TASK);
   DrawContest(canvas);
 
   draw_sw.Mark("DrawTask");
   DrawTask(canvas);
 
   draw_sw.Mark("DrawWaypoints");
+  frame_profiler.Mark(FrameProfiler::Stage::WAYPOINTS);
   DrawWaypoints(canvas);
 
   //////////////////////////////////////////////// aircraft level items
   // Render the snail trail
+  frame_profiler.Mark(FrameProfiler::Stage::TRAIL);
   if (basic.location_available)
     RenderTrail(canvas, aircraft_pos);
 
+  frame_profiler.Mark(FrameProfiler::Stage::OVERLAYS);
   DrawWaves(canvas);
 
   // Render estimate of thermal location
@@ -260,11 +312,13 @@ MapWindow::Render(Canvas &canvas, const PixelRect &rc)
   //////////////////////////////////////////////// text items
   // Render topography on top of airspace, to keep the text readable
   draw_sw.Mark("RenderTopographyLabels");
+  frame_profiler.Mark(FrameProfiler::Stage::TOPOGRAPHY);
   RenderTopographyLabels(canvas);
 
   //////////////////////////////////////////////// navigation overlays
   // Render glide through terrain range
   draw_sw.Mark("RenderGlide");
+  frame_profiler.Mark(FrameProfiler::Stage::OVERLAYS);
   RenderGlide(canvas);
 
   draw_sw.Mark("RenderMisc1");
@@ -287,6 +341,7 @@ MapWindow::Render(Canvas &canvas, const PixelRect &rc)
 
   //////////////////////////////////////////////// traffic
   // Draw traffic
+  frame_profiler.Mark(FrameProfiler::Stage::TRAFFIC);
 
 #ifdef HAVE_SKYLINES_TRACKING
   DrawSkyLinesTraffic(canvas);
@@ -301,6 +356,7 @@ MapWindow::Render(Canvas &canvas, const PixelRect &rc)
     DrawFLARMTraffic(canvas, aircraft_pos);
 
   //////////////////////////////////////////////// own aircraft
+  frame_profiler.Mark(FrameProfiler::Stage::OVERLAYS);
   // Finally, draw you!
   if (basic.location_available)
     AircraftRenderer::Draw(canvas, GetMapSettings(), look.aircraft,
@@ -309,5 +365,6 @@ MapWindow::Render(Canvas &canvas, const PixelRect &rc)
 
   //////////////////////////////////////////////// important overlays
   // Draw intersections on top of aircraft
+  frame_profiler.Mark(FrameProfiler::Stage::AIRSPACE);
   airspace_renderer.DrawIntersections(canvas, render_projection);
 }
@@ -29,7 +29,7 @@ Copyright_License {
 #include "Renderer/TextInBox.hpp"
 #include "Renderer/TrafficRenderer.hpp"
 #include "FLARM/Friends.hpp"
-#include "Tracking/SkyLines/Data.hpp"
+#include "Math/Util.hpp"
 #include "util/StringCompare.hxx"
 
 /**
@@ -143,8 +143,14 @@ MapWindow::DrawGLinkTraffic(Canvas &canvas,
 
   canvas.Select(*traffic_look.font);
 
+  const FusedTrafficList &fused = basic.fused_traffic;
+
   // Circle through the GliderLink targets
   for (const auto &traf : traffic.list) {
+    // Skip targets which are already drawn as FLARM traffic
+    if (const auto *f = fused.FindGliderLink(traf.id);
+        f != nullptr && f->source == FusedTraffic::Source::FLARM)
+      continue;
 
     // Save the location of the target
     GeoPoint target_loc = traf.location;
@@ -230,24 +236,23 @@ MapWindow::DrawTeammate(Canvas &canvas) const
 void
 MapWindow::DrawSkyLinesTraffic(Canvas &canvas) const
 {
-  if (DisplaySkyLinesTrafficMapMode::OFF == GetMapSettings().skylines_traffic_map_mode ||
-      skylines_data == nullptr)
+  if (DisplaySkyLinesTrafficMapMode::OFF == GetMapSettings().skylines_traffic_map_mode)
     return;
 
   canvas.Select(*traffic_look.font);
 
-  std::lock_guard<Mutex> lock(skylines_data->mutex);
-  for (auto &i : skylines_data->traffic) {
-    if (auto p = render_projection.GeoToScreenIfVisible(i.second.location)) {
+  /* the fused list contains the extrapolated SkyLines positions and
+     the user names; targets which are also received by FLARM or
+     GliderLink are drawn by DrawFLARMTraffic() / DrawGLinkTraffic() */
+  for (const auto &i : Basic().fused_traffic.list) {
+    if (i.source != FusedTraffic::Source::SKYLINES)
+      continue;
+
+    if (auto p = render_projection.GeoToScreenIfVisible(i.location)) {
       traffic_look.teammate_icon.Draw(canvas, *p);
       if (DisplaySkyLinesTrafficMapMode::SYMBOL_NAME == GetMapSettings().skylines_traffic_map_mode) {
-        const auto name_i = skylines_data->user_names.find(i.first);
-        const TCHAR *name = name_i != skylines_data->user_names.end()
-          ? name_i->second.c_str()
-          : _T("");
-
         StaticString<128> buffer;
-        buffer.Format(_T("%s [%um]"), name, i.second.altitude);
+        buffer.Format(_T("%s [%um]"), i.name.c_str(), iround(i.altitude));
 
         TextInBoxMode mode;
         mode.shape = LabelShape::OUTLINED;
@@ -27,6 +27,7 @@ Copyright_License {
 #include "ui/canvas/opengl/Scope.hpp"
 #include "ui/canvas/opengl/ConstantAlpha.hpp"
 #include "ui/canvas/opengl/VertexPointer.hpp"
+#include "ui/canvas/opengl/Statistics.hpp"
 #include "Projection/WindowProjection.hpp"
 #include "Math/Point2D.hpp"
 #include "Math/Quadrilateral.hpp"
@@ -186,7 +187,7 @@ MapOverlayBitmap::Draw(Canvas &canvas,
       vertices[i] = projection.GeoToScreen(v);
     }
 
-    glDrawArrays(GL_TRIANGLE_FAN, 0, n);
+    OpenGL::DrawArrays(GL_TRIANGLE_FAN, 0, n);
   }
 
   glDisableVertexAttribArray(OpenGL::Attribute::TEXCOORD);
@@ -26,17 +26,20 @@
 #include "util/StaticArray.hxx"
 
 #include <numeric>
+#include <span>
 #include <cassert>
 
 /**
  * Average/bucket filter.  When filter is full, can return samples
+ *
+ * @param T the floating point type of the samples
  */
-template<unsigned max>
+template<unsigned max, typename T=double>
 class AvFilter 
 {
 protected:
   /** Values stored */
-  StaticArray<double, max> x;
+  StaticArray<T, max> x;
 
 public:
   unsigned capacity() const {
@@ -50,23 +53,37 @@ public:
    *
    * @return True if buffer is full
    */
-  bool Update(const double x0) {
+  bool Update(const T x0) {
     if (!x.full())
       x.append(x0);
 
     return x.full();
   }
 
+  /**
+   * Add a series of samples, e.g. a buffer of samples received from
+   * a device.  Samples which do not fit are discarded.
+   *
+   * @return True if buffer is full
+   */
+  bool Update(std::span<const T> samples) {
+    for (const T i : samples)
+      if (Update(i))
+        break;
+
+    return x.full();
+  }
+
   /**
    * Calculate average from samples
    *
    * @return Average value in buffer
    */
   [[gnu::pure]]
-  double Average() const {
+  T Average() const {
     assert(!x.empty());
 
-    return std::accumulate(x.begin(), x.end(), 0.0) / x.size();
+    return std::accumulate(x.begin(), x.end(), T(0)) / x.size();
   }
 
   /**
@@ -34,8 +34,11 @@ ConvexFilter::UpdateConvex(double x, double y, int csign) noexcept
 
   // check pruning of previous points
 
-  while (GetCount() > 2) {
-    const unsigned n = GetCount();
+  /* merged slots (see XYDataStore::Compact()) cannot be removed, so
+     pruning stops there */
+  while (GetSlots().size > 2 &&
+         GetSlots().size - 2 >= GetMergedSlots()) {
+    const unsigned n = GetSlots().size;
     const auto &next = GetSlots()[n - 1];
     const auto &prev = GetSlots()[n - 3];
     const double m = (next.y-prev.y)/(next.x-prev.x);
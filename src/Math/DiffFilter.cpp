@@ -23,20 +23,43 @@
 #include "DiffFilter.hpp"
 #include "Constants.hpp"
 
+#include <algorithm>
+#include <cassert>
+
+template<typename T>
 void
-DiffFilter::Reset(const double x0, const double y0) noexcept
+BasicDiffFilter<T>::Reset(const T x0, const T y0) noexcept
 {
   for (unsigned i = 0; i < x.size(); i++)
     x[i] = x0 - y0 * i;
 }
 
-double
-DiffFilter::Update(const double x0) noexcept
+template<typename T>
+T
+BasicDiffFilter<T>::Update(const T x0) noexcept
 {
   std::copy_backward(x.cbegin(), std::prev(x.cend()), x.end());
   x.front() = x0;
 
   /// @note not sure why need to divide by pi/2 here
-  return ((x.back() - x.front()) / 16 + x[2] - x[4]) / M_PI_2;
+  return ((x.back() - x.front()) / 16 + x[2] - x[4]) / T(M_PI_2);
+}
+
+template<typename T>
+T
+BasicDiffFilter<T>::Update(std::span<const T> samples) noexcept
+{
+  assert(!samples.empty());
+
+  /* only the last 7 samples affect the filter state */
+  if (samples.size() > x.size())
+    samples = samples.last(x.size());
+
+  T y = 0;
+  for (const T i : samples)
+    y = Update(i);
+  return y;
 }
 
+template class BasicDiffFilter<double>;
+template class BasicDiffFilter<float>;
@@ -24,28 +24,33 @@
 #define DIFF_FILTER_HPP
 
 #include <array>
+#include <span>
 
 /**
  * Differentiating low-pass IIR filter
  * @see http://www.dsprelated.com/showarticle/35.php
+ *
+ * @param T the floating point type of the samples; instantiated for
+ * double and float
  */
-class DiffFilter 
+template<typename T>
+class BasicDiffFilter
 {
-  std::array<double, 7> x;
+  std::array<T, 7> x;
 
 public:
   /**
    * Non-initialising default constructor.  To initialise this
    * instance, call Reset().
    */
-  DiffFilter() noexcept = default;
+  BasicDiffFilter() noexcept = default;
 
   /**
    * Constructor.  Initialises as if fed x_default continuously.
    *
    * @param x_default Default value of input
    */
-  DiffFilter(const double x_default) noexcept
+  BasicDiffFilter(const T x_default) noexcept
   {
     Reset(x_default);
   }
@@ -58,7 +63,15 @@ public:
    *
    * @return Filter output value
    */
-  double Update(double x0) noexcept;
+  T Update(T x0) noexcept;
+
+  /**
+   * Feed a series of input samples, e.g. a buffer of samples received
+   * from a device.  The span must not be empty.
+   *
+   * @return the filter output value after the last sample
+   */
+  T Update(std::span<const T> samples) noexcept;
 
   /**
    * Resets filter as if fed value to produce y0
@@ -66,8 +79,13 @@ public:
    * @param x0 Steady state value of filter input
    * @param y0 Desired value of differentiated output
    */
-  void Reset(double x0=0, double y0=0) noexcept;
+  void Reset(T x0=0, T y0=0) noexcept;
 };
 
+extern template class BasicDiffFilter<double>;
+extern template class BasicDiffFilter<float>;
+
+using DiffFilter = BasicDiffFilter<double>;
+
 
 #endif
@@ -22,7 +22,6 @@ Copyright_License {
 */
 
 #include "FastMath.hpp"
-#include "MathTables.h"
 
 #include <math.h>
 
@@ -38,6 +37,8 @@ compare_squared(int a, int b, int c) noexcept
   return 0;
 }
 
+#if !defined(__i386__) && !defined(__x86_64__)
+
 /**
  * Calculates the square root of val
  *
@@ -48,10 +49,6 @@ compare_squared(int a, int b, int c) noexcept
 unsigned
 isqrt4(unsigned val) noexcept
 {
-#if defined(__i386__) || defined(__x86_64__)
-  /* x86 FPUs are extremely fast */
-  return (unsigned)sqrt((double)val);
-#else
   unsigned int temp, g = 0;
 
   if (val >= 0x40000000) {
@@ -88,13 +85,6 @@ isqrt4(unsigned val) noexcept
     g++;
 
   return g;
-#endif
 }
 
-double
-thermal_recency_fn(unsigned x) noexcept
-{
-  return x < THERMALRECENCY_SIZE
-    ? THERMALRECENCY[x]
-    : 0.;
-}
+#endif
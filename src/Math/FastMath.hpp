@@ -35,14 +35,30 @@ Copyright_License {
 int
 compare_squared(int a, int b, int c) noexcept;
 
+#if defined(__i386__) || defined(__x86_64__)
+
+#include <math.h>
+
+/**
+ * Calculates the square root of val.  Inline on x86, because its FPU
+ * is extremely fast, and so the compiler can vectorise loops using
+ * it.
+ */
 [[gnu::const]]
-double
-thermal_recency_fn(unsigned x) noexcept;
+static inline unsigned
+isqrt4(unsigned val) noexcept
+{
+  return (unsigned)sqrt((double)val);
+}
+
+#else
 
 [[gnu::const]]
 unsigned
 isqrt4(unsigned val) noexcept;
 
+#endif
+
 [[gnu::const]]
 static inline unsigned
 ihypot(int x, int y) noexcept
@@ -86,6 +86,14 @@ public:
   FastIntegerRotation(Angle angle) noexcept
     :cost(angle.ifastcosine()), sint(angle.ifastsine()) {}
 
+  constexpr int GetCosine() const noexcept {
+    return cost;
+  }
+
+  constexpr int GetSine() const noexcept {
+    return sint;
+  }
+
   void Scale(int multiply, int divide=1) noexcept {
     cost = cost * multiply / divide;
     sint = sint * multiply / divide;
@@ -22,4 +22,105 @@ Copyright_License {
 */
 
 #include "FastTrig.hpp"
-#include "MathTables.h"
+
+/*
+ * The tables are generated at compile time.  std::sin() is not
+ * constexpr, therefore the samples are calculated with a Taylor
+ * series; the symmetry of the sine keeps its argument below pi/4,
+ * where 13 terms are more than enough for double precision.
+ */
+
+static constexpr double
+TaylorSine(double x) noexcept
+{
+  double term = x, sum = x;
+  for (unsigned n = 1; n <= 13; ++n) {
+    term *= -x * x / ((2 * n) * (2 * n + 1));
+    sum += term;
+  }
+
+  return sum;
+}
+
+static constexpr double
+TaylorCosine(double x) noexcept
+{
+  double term = 1, sum = 1;
+  for (unsigned n = 1; n <= 13; ++n) {
+    term *= -x * x / ((2 * n - 1) * (2 * n));
+    sum += term;
+  }
+
+  return sum;
+}
+
+/**
+ * Calculate sin(2*pi*i/n) for 0 <= i <= n/4.
+ */
+static constexpr double
+QuadrantSine(unsigned i, unsigned n) noexcept
+{
+  const unsigned quarter = n / 4;
+  return 2 * i <= quarter
+    ? TaylorSine(i * M_2PI / n)
+    : TaylorCosine((quarter - i) * M_2PI / n);
+}
+
+/**
+ * Calculate sin(2*pi*i/n) for 0 <= i < n, where n is a multiple of
+ * 4.
+ */
+static constexpr double
+SampleSine(unsigned i, unsigned n) noexcept
+{
+  const unsigned quarter = n / 4;
+  const unsigned r = i % quarter;
+
+  switch (i / quarter) {
+  case 0:
+    return QuadrantSine(r, n);
+
+  case 1:
+    return QuadrantSine(quarter - r, n);
+
+  case 2:
+    return -QuadrantSine(r, n);
+
+  default:
+    return -QuadrantSine(quarter - r, n);
+  }
+}
+
+/**
+ * Round to the nearest integer, halfway cases away from zero (like
+ * lround(), which is not constexpr).
+ */
+static constexpr short
+RoundToShort(double x) noexcept
+{
+  return short(x >= 0 ? x + 0.5 : x - 0.5);
+}
+
+static constexpr auto
+GenerateIntSineTable() noexcept
+{
+  std::array<short, INT_ANGLE_RANGE> table{};
+  for (unsigned i = 0; i < INT_ANGLE_RANGE; ++i)
+    table[i] = RoundToShort(SampleSine(i, INT_ANGLE_RANGE) * 1024);
+  return table;
+}
+
+static constexpr auto
+GenerateFastSineTable() noexcept
+{
+  std::array<float, INT_ANGLE_RANGE> table{};
+  for (unsigned i = 0; i < INT_ANGLE_RANGE; ++i)
+    table[i] = SampleSine(i, INT_ANGLE_RANGE);
+  return table;
+}
+
+constinit const std::array<short, INT_ANGLE_RANGE> ISINETABLE =
+  GenerateIntSineTable();
+
+constinit const std::array<float, INT_ANGLE_RANGE> FAST_SINE_TABLE =
+  GenerateFastSineTable();
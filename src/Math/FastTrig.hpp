@@ -26,16 +26,24 @@ Copyright_License {
 
 #include "Constants.hpp"
 
+#include <array>
+
 static constexpr unsigned INT_ANGLE_RANGE = 4096;
 static constexpr unsigned INT_ANGLE_MASK = INT_ANGLE_RANGE - 1;
 static constexpr unsigned INT_QUARTER_CIRCLE = INT_ANGLE_RANGE / 4;
 
 static constexpr double INT_ANGLE_MULT = INT_ANGLE_RANGE / M_2PI;
 
-extern const double SINETABLE[INT_ANGLE_RANGE];
-extern const double INVCOSINETABLE[INT_ANGLE_RANGE];
+/**
+ * sin(x)*1024 (rounded) for each integer angle.
+ */
+extern const std::array<short, INT_ANGLE_RANGE> ISINETABLE;
 
-extern const short ISINETABLE[INT_ANGLE_RANGE];
+/**
+ * sin(x) for each integer angle.  Single precision is much finer
+ * than the angle resolution, and halves the size of the table.
+ */
+extern const std::array<float, INT_ANGLE_RANGE> FAST_SINE_TABLE;
 
 constexpr unsigned
 NormalizeIntAngle(unsigned angle) noexcept
@@ -79,12 +87,6 @@ IntAngleToRadians(unsigned angle) noexcept
   return angle / INT_ANGLE_MULT;
 }
 
-[[gnu::const]]
-static inline double
-invfastcosine(double x) noexcept
-{
-  return INVCOSINETABLE[NATIVE_TO_INT(x)];
-}
 
 [[gnu::const]]
 static inline int
@@ -104,14 +106,29 @@ ifastcosine(double x) noexcept
 static inline double
 fastsine(double x) noexcept
 {
-  return SINETABLE[NATIVE_TO_INT(x)];
+  return FAST_SINE_TABLE[NATIVE_TO_INT(x)];
 }
 
 [[gnu::const]]
 static inline double
 fastcosine(double x) noexcept
 {
-  return SINETABLE[NATIVE_TO_INT_COS(x)];
+  return FAST_SINE_TABLE[NATIVE_TO_INT_COS(x)];
+}
+
+[[gnu::const]]
+static inline double
+invfastcosine(double x) noexcept
+{
+  double c = fastcosine(x);
+
+  /* avoid division by zero */
+  if (c >= 0 && c < 1.0e-8)
+    c = 1.0e-8;
+  else if (c < 0 && c > -1.0e-8)
+    c = -1.0e-8;
+
+  return 1. / c;
 }
 
 #endif
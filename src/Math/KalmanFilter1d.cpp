@@ -18,22 +18,25 @@
   along with this program; if not, write to the Free Software
   Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 }
-*/
+ */
+
 
 #include "KalmanFilter1d.hpp"
 #include "Util.hpp"
 
 #include <cassert>
 
-KalmanFilter1d::KalmanFilter1d(const double var_x_accel) noexcept
+template<typename T>
+BasicKalmanFilter1d<T>::BasicKalmanFilter1d(const T var_x_accel) noexcept
   :var_x_accel_(var_x_accel)
 {
   Reset();
 }
 
+template<typename T>
 void
-KalmanFilter1d::Reset(const double x_abs_value,
-                      const double x_vel_value) noexcept
+BasicKalmanFilter1d<T>::Reset(const T x_abs_value,
+                              const T x_vel_value) noexcept
 {
   x_abs_ = x_abs_value;
   x_vel_ = x_vel_value;
@@ -42,27 +45,46 @@ KalmanFilter1d::Reset(const double x_abs_value,
   p_vel_vel_ = var_x_accel_;
 }
 
-void
-KalmanFilter1d::Update(const double z_abs, const double var_z_abs,
-                       const double dt) noexcept
+template<typename T>
+inline typename BasicKalmanFilter1d<T>::Prediction
+BasicKalmanFilter1d<T>::MakePrediction(const T dt) const noexcept
 {
-  // Some abbreviated constants to make the code line up nicely:
-  static constexpr double F1 = 1;
-
   // Validity checks. TODO: more?
   assert(dt > 0);
 
+  // The acceleration noise mixed into the state covariance.
+  const auto dt2 = Square(dt);
+  const auto dt3 = dt * dt2;
+  const auto dt4 = Square(dt2);
+
+  Prediction p;
+  p.dt = dt;
+  p.dt2 = dt2;
+  p.q_abs_abs = var_x_accel_ * dt4 / 4;
+  p.q_abs_vel = var_x_accel_ * dt3 / 2;
+  p.q_vel_vel = var_x_accel_ * dt2;
+  return p;
+}
+
+template<typename T>
+inline void
+BasicKalmanFilter1d<T>::Update(const T z_abs, const T var_z_abs,
+                               const Prediction &prediction) noexcept
+{
+  // Some abbreviated constants to make the code line up nicely:
+  static constexpr T F1 = 1;
+
+  const T dt = prediction.dt;
+
   // Note: math is not optimized by hand. Let the compiler sort it out.
   // Predict step.
   // Update state estimate.
   x_abs_ += x_vel_ * dt;
   // Update state covariance. The last term mixes in acceleration noise.
-  const auto dt2 = Square(dt);
-  const auto dt3 = dt * dt2;
-  const auto dt4 = Square(dt2);
-  p_abs_abs_ += 2 * dt * p_abs_vel_ + dt2 * p_vel_vel_ + var_x_accel_ * dt4 / 4;
-  p_abs_vel_ += dt * p_vel_vel_ + var_x_accel_ * dt3 / 2;
-  p_vel_vel_ += var_x_accel_ * dt2;
+  p_abs_abs_ += 2 * dt * p_abs_vel_ + prediction.dt2 * p_vel_vel_ +
+    prediction.q_abs_abs;
+  p_abs_vel_ += dt * p_vel_vel_ + prediction.q_abs_vel;
+  p_vel_vel_ += prediction.q_vel_vel;
 
   // Update step.
   const auto y = z_abs - x_abs_;  // Innovation.
@@ -77,3 +99,24 @@ KalmanFilter1d::Update(const double z_abs, const double var_z_abs,
   p_abs_vel_ -= p_abs_vel_*k_abs;
   p_abs_abs_ -= p_abs_abs_*k_abs;
 }
+
+template<typename T>
+void
+BasicKalmanFilter1d<T>::Update(const T z_abs, const T var_z_abs,
+                               const T dt) noexcept
+{
+  Update(z_abs, var_z_abs, MakePrediction(dt));
+}
+
+template<typename T>
+void
+BasicKalmanFilter1d<T>::Update(std::span<const T> z_abs, const T var_z_abs,
+                               const T dt) noexcept
+{
+  const auto prediction = MakePrediction(dt);
+  for (const T z : z_abs)
+    Update(z, var_z_abs, prediction);
+}
+
+template class BasicKalmanFilter1d<double>;
+template class BasicKalmanFilter1d<float>;
@@ -20,9 +20,12 @@
 }
  */
 
+
 #ifndef XCSOAR_KALMAN_FILTER_1D_HPP
 #define XCSOAR_KALMAN_FILTER_1D_HPP
 
+#include <span>
+
 /**
  * A Kalman filter that estimates a one-dimensional quantity "x" and
  * its rate of change. Observations are of the one-dimensional
@@ -35,26 +38,39 @@
  *   http://en.wikipedia.org/w/index.php?title=Kalman_filter&oldid=484054295
  * This implementation is devised from public domain code available here:
  *   https://code.google.com/p/pressure-altimeter/
+ *
+ * @param T the floating point type of the state; instantiated for
+ * double and float
  */
-class KalmanFilter1d {
+template<typename T>
+class BasicKalmanFilter1d {
   // The state we are tracking, namely:
-  double x_abs_;  // The absolute quantity x.
-  double x_vel_;  // The rate of change of x, in x units per second squared.
+  T x_abs_;  // The absolute quantity x.
+  T x_vel_;  // The rate of change of x, in x units per second squared.
 
   // Covariance matrix for the state.
-  double p_abs_abs_;
-  double p_abs_vel_;
-  double p_vel_vel_;
+  T p_abs_abs_;
+  T p_abs_vel_;
+  T p_vel_vel_;
 
   // The variance of the acceleration noise input to the system model, in units
   // per second squared.
-  double var_x_accel_;
+  T var_x_accel_;
+
+  /**
+   * The coefficients of the predict step, which depend only on the
+   * interval and on #var_x_accel_.
+   */
+  struct Prediction {
+    T dt, dt2;
+    T q_abs_abs, q_abs_vel, q_vel_vel;
+  };
 
  public:
   // Constructors: the first allows you to supply the variance of the
   // acceleration noise input to the system model in x units per second squared;
   // the second constructor assumes a variance of 1.0.
-  explicit KalmanFilter1d(double var_x_accel=1) noexcept;
+  explicit BasicKalmanFilter1d(T var_x_accel=1) noexcept;
 
   // The following three methods reset the filter. All of them assign a huge
   // variance to the tracked absolute quantity and a var_x_accel_ variance to
@@ -64,13 +80,13 @@ class KalmanFilter1d {
   //
   // NOTE: "x_abs_value" is meant to connote the value of the absolute quantity
   // x, not the absolute value of x.
-  void Reset(double x_abs_value=0, double x_vel_value=0) noexcept;
+  void Reset(T x_abs_value=0, T x_vel_value=0) noexcept;
 
   /**
    * Sets the variance of the acceleration noise input to the system model in
    * x units per second squared.
    */
-  void SetAccelerationVariance(double var_x_accel) noexcept {
+  void SetAccelerationVariance(T var_x_accel) noexcept {
     var_x_accel_ = var_x_accel;
   }
 
@@ -81,14 +97,31 @@ class KalmanFilter1d {
    * greater than 0; for the first measurement after a Reset(), it's
    * safe to use 1.0.
    */
-  void Update(double z_abs, double var_z_abs, double dt) noexcept;
+  void Update(T z_abs, T var_z_abs, T dt) noexcept;
+
+  /**
+   * Like Update(), but for a series of measurements taken at a
+   * constant interval, e.g. a buffer of samples received from a
+   * device.  The result is the same as calling Update() for each
+   * one, but the predict step coefficients are calculated only once.
+   */
+  void Update(std::span<const T> z_abs, T var_z_abs, T dt) noexcept;
 
   // Getters for the state and its covariance.
-  double GetXAbs() const noexcept { return x_abs_; }
-  double GetXVel() const noexcept { return x_vel_; }
-  double GetCovAbsAbs() const noexcept { return p_abs_abs_; }
-  double GetCovAbsVel() const noexcept { return p_abs_vel_; }
-  double GetCovVelVel() const noexcept { return p_vel_vel_; }
+  T GetXAbs() const noexcept { return x_abs_; }
+  T GetXVel() const noexcept { return x_vel_; }
+  T GetCovAbsAbs() const noexcept { return p_abs_abs_; }
+  T GetCovAbsVel() const noexcept { return p_abs_vel_; }
+  T GetCovVelVel() const noexcept { return p_vel_vel_; }
+
+private:
+  Prediction MakePrediction(T dt) const noexcept;
+  void Update(T z_abs, T var_z_abs, const Prediction &prediction) noexcept;
 };
 
+extern template class BasicKalmanFilter1d<double>;
+extern template class BasicKalmanFilter1d<float>;
+
+using KalmanFilter1d = BasicKalmanFilter1d<double>;
+
 #endif
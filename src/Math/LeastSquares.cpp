@@ -168,7 +168,12 @@ LeastSquares::Add(double x, double y, double weight) noexcept
 void
 LeastSquares::Remove(const unsigned i) noexcept
 {
-  assert(i < GetCount());
+  assert(i < GetSlots().size);
+
+  /* a merged slot is the centroid of several points; subtracting its
+     squares would not undo what those points added to sum_xxw and
+     sum_xyw */
+  assert(i >= GetMergedSlots());
 
   const auto &pt = GetSlots()[i];
   // Remove weighted point
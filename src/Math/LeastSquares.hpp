@@ -218,6 +218,9 @@ protected:
    * Remove data point to the values.
    * This updates the least squares statistics but not x/y min/max.
    * If weights aren't stored, this assumes weight = 1
+   *
+   * @param i the index in GetSlots(); must not be a merged slot
+   * (see GetMergedSlots())
    */
   void Remove(unsigned i) noexcept;
 
@@ -0,0 +1,201 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_SAMPLED_WINDOW_FILTER_HPP
+#define XCSOAR_SAMPLED_WINDOW_FILTER_HPP
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+
+/**
+ * Records a cumulative value (e.g. the distance travelled on the
+ * task) at a fixed X period, and calculates its change over a window
+ * of arbitrary width ending at the newest sample.  Unlike
+ * #DifferentialWindowFilter, the window width is chosen by the
+ * caller, and one object can answer questions like "what was the
+ * average task speed over the last 10 minutes, and over the last
+ * hour?"
+ *
+ * Each Push() and each query costs O(1); the window start is
+ * interpolated linearly between the two surrounding samples.  Memory
+ * usage is fixed; the widest possible window is (N-1) periods.
+ */
+template<unsigned N>
+class SampledWindowFilter {
+  static_assert(N >= 2);
+
+  /**
+   * The Y values at the grid points, which are #period apart.
+   */
+  std::array<double, N> samples;
+
+  double period;
+
+  /**
+   * The index of the newest grid sample in #samples.
+   */
+  unsigned newest;
+
+  /**
+   * The number of valid grid samples.  Zero means this object is
+   * empty.
+   */
+  unsigned count = 0;
+
+  /**
+   * The X value of the newest grid sample.
+   */
+  double newest_x;
+
+  /**
+   * The most recent sample passed to Push(); it is usually between
+   * two grid points.
+   */
+  double current_x, current_y;
+
+public:
+  struct Delta {
+    double x, y;
+  };
+
+  explicit constexpr SampledWindowFilter(double _period) noexcept
+    :period(_period) {
+    assert(period > 0);
+  }
+
+  static constexpr unsigned GetCapacity() noexcept {
+    return N;
+  }
+
+  constexpr double GetPeriod() const noexcept {
+    return period;
+  }
+
+  /**
+   * Returns the widest window this object can answer.
+   */
+  constexpr double GetMaxWidth() const noexcept {
+    return (N - 1) * period;
+  }
+
+  void Clear() noexcept {
+    count = 0;
+  }
+
+  bool IsEmpty() const noexcept {
+    return count == 0;
+  }
+
+  double GetLastX() const noexcept {
+    assert(!IsEmpty());
+    return current_x;
+  }
+
+  /**
+   * Returns the X value of the oldest sample still available.
+   */
+  double GetFirstX() const noexcept {
+    assert(!IsEmpty());
+    return newest_x - (count - 1) * period;
+  }
+
+  /**
+   * Add a new sample.  X must not be smaller than the previous one.
+   * The grid points between the previous and this sample are filled
+   * by linear interpolation; after a gap wider than the capacity, the
+   * filter starts over.
+   */
+  void Push(double x, double y) noexcept {
+    if (IsEmpty() || x - current_x > GetMaxWidth()) {
+      samples[0] = y;
+      newest = 0;
+      count = 1;
+      newest_x = current_x = x;
+      current_y = y;
+      return;
+    }
+
+    assert(x >= current_x);
+
+    for (double grid_x = newest_x + period; grid_x <= x;
+         grid_x += period) {
+      newest = (newest + 1) % N;
+      if (count < N)
+        ++count;
+
+      newest_x = grid_x;
+      samples[newest] = x > current_x
+        ? current_y + (y - current_y) * (grid_x - current_x) / (x - current_x)
+        : y;
+    }
+
+    current_x = x;
+    current_y = y;
+  }
+
+  /**
+   * Calculate the change of X and Y over the window of the specified
+   * width ending at the newest sample.  If less history is
+   * available, then the window is clipped, and the returned X delta
+   * is smaller than the width.  Must not be called on an empty
+   * object.
+   */
+  [[gnu::pure]]
+  Delta GetDelta(double width) const noexcept {
+    assert(!IsEmpty());
+    assert(width >= 0);
+
+    const double start_x = std::max(current_x - width, GetFirstX());
+
+    double start_y;
+    if (start_x >= newest_x) {
+      /* the window starts after the newest grid point */
+      start_y = current_x > newest_x
+        ? samples[newest] + (current_y - samples[newest])
+          * (start_x - newest_x) / (current_x - newest_x)
+        : current_y;
+    } else {
+      const double offset = (newest_x - start_x) / period;
+      const unsigned k = std::min((unsigned)offset, count - 1);
+      const double y1 = GetSample(k);
+      start_y = k + 1 < count
+        ? y1 + (GetSample(k + 1) - y1) * (offset - k)
+        : y1;
+    }
+
+    return {current_x - start_x, current_y - start_y};
+  }
+
+private:
+  /**
+   * Returns the grid sample which is the specified number of periods
+   * older than the newest one.
+   */
+  double GetSample(unsigned age) const noexcept {
+    assert(age < count);
+    return samples[(newest + N - age) % N];
+  }
+};
+
+#endif
@@ -75,7 +75,16 @@ public:
    * filter resetting automatically for updates separated by large
    * time intervals as described above.
    */
-  void Update(double z_abs, double var_z_abs) noexcept;
+  void Update(double z_abs, double var_z_abs) noexcept {
+    Update(z_abs, var_z_abs, Clock::now());
+  }
+
+  /**
+   * Like Update(), but with the time the measurement was taken
+   * instead of the current time.  This is used for samples which were
+   * buffered before they were delivered.
+   */
+  void Update(double z_abs, double var_z_abs, TimePoint time) noexcept;
 
   // Remaining methods are identical to their counterparts in KalmanFilter1d.
 
@@ -27,9 +27,11 @@
 
 /**
  * Average/window filter.  
+ *
+ * @param T the floating point type of the samples
  */
-template<unsigned max>
-class WindowFilter : public AvFilter<max>
+template<unsigned max, typename T=double>
+class WindowFilter : public AvFilter<max, T>
 {
   unsigned i = 0;
 
@@ -42,24 +44,40 @@ public:
    * @return True if buffer is full
    *
    */
-  bool Update(const double x0) {
+  bool Update(const T x0) {
     auto &x = this->x;
 
     assert(i < x.capacity());
 
     if (!x.full())
-      return AvFilter<max>::Update(x0);
+      return AvFilter<max, T>::Update(x0);
 
     x[i] = x0;
     i = (i + 1) % x.capacity();
     return x.full();
   }
 
+  /**
+   * Add a series of samples, e.g. a buffer of samples received from
+   * a device.  Only the last #max samples remain in the window.
+   *
+   * @return True if buffer is full
+   */
+  bool Update(std::span<const T> samples) {
+    if (samples.size() > max)
+      samples = samples.last(max);
+
+    for (const T x0 : samples)
+      Update(x0);
+
+    return this->x.full();
+  }
+
   /**
    * Resets filter (zero samples)
    */
   void Reset() {
-    AvFilter<max>::Reset();
+    AvFilter<max, T>::Reset();
     i = 0;
   }
 };
@@ -27,6 +27,7 @@ void
 XYDataStore::StoreReset() noexcept
 {
   sum_n = 0;
+  n_merged = 0;
   sum_xw = 0.;
   sum_yw = 0.;
   sum_weights = 0.;
@@ -50,9 +51,10 @@ XYDataStore::StoreAdd(double x, double y, double weight) noexcept
     x_min = x;
 
   // Add point
-  // TODO code: really should have a circular buffer here
-  if (!slots.full())
-    slots.append() = Slot(x, y, weight);
+  if (slots.full())
+    Compact();
+
+  slots.append() = Slot(x, y, weight);
 
   ++sum_n;
 
@@ -63,10 +65,43 @@ XYDataStore::StoreAdd(double x, double y, double weight) noexcept
   sum_yw += y * weight;
 }
 
+void
+XYDataStore::Compact() noexcept
+{
+  const unsigned n = slots.size();
+  const unsigned n_merge = (n / 2) & ~1u;
+
+  unsigned dest = 0;
+  for (unsigned i = 0; i < n_merge; i += 2) {
+    const Slot &a = slots[i], &b = slots[i + 1];
+
+#ifdef LEASTSQS_WEIGHT_STORE
+    const double weight = a.weight + b.weight;
+    slots[dest++] = weight > 0
+      ? Slot((a.x * a.weight + b.x * b.weight) / weight,
+             (a.y * a.weight + b.y * b.weight) / weight,
+             weight)
+      : Slot((a.x + b.x) / 2, (a.y + b.y) / 2, 0);
+#else
+    slots[dest++] = Slot((a.x + b.x) / 2, (a.y + b.y) / 2, 1);
+#endif
+  }
+
+  /* the newer half keeps its full resolution */
+  for (unsigned i = n_merge; i < n; ++i)
+    slots[dest++] = slots[i];
+
+  slots.shrink(dest);
+
+  /* previously merged slots in the newer half stay merged */
+  n_merged = n_merge / 2 + (n_merged > n_merge ? n_merged - n_merge : 0);
+}
+
 void
 XYDataStore::StoreRemove(const unsigned i) noexcept
 {
-  assert(i< sum_n);
+  assert(i < slots.size());
+  assert(i >= n_merged);
   const auto &pt = slots[i];
 
   // Remove weighted point
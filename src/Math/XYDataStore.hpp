@@ -47,6 +47,12 @@ private:
 
   unsigned sum_n;
 
+  /**
+   * The number of slots at the beginning of #slots which were
+   * merged by Compact().
+   */
+  unsigned n_merged;
+
   struct Slot {
     double x, y;
 
@@ -64,6 +70,17 @@ private:
     {}
   };
 
+  /**
+   * The stored points.  When this is full, the older half is merged
+   * pairwise (see Compact()), so old data gets a lower resolution
+   * while the memory usage stays constant.  Therefore, this may
+   * contain fewer slots than GetCount().
+   *
+   * The summary statistics are updated incrementally from the
+   * samples, not from the slots.  A merged slot does not carry the
+   * second moments of its samples, so it must not be removed (see
+   * StoreRemove()); this keeps the statistics exact.
+   */
   TrivialArray<Slot, 1000> slots;
 
 public:
@@ -79,6 +96,14 @@ public:
     return sum_n;
   }
 
+  /**
+   * The number of slots at the beginning of GetSlots() which were
+   * merged from several points; they cannot be removed.
+   */
+  constexpr unsigned GetMergedSlots() const noexcept {
+    return n_merged;
+  }
+
   /**
    * Reset the store.
    */
@@ -122,9 +147,19 @@ protected:
   /**
    * Remove data point to the values.
    * If weights aren't stored, this assumes weight = 1
+   *
+   * @param i the index in GetSlots(); must not be a merged slot
+   * (see GetMergedSlots())
    */
   void StoreRemove(const unsigned i) noexcept;
 
+private:
+  /**
+   * Make room for new points by merging each pair of slots in the
+   * older half into one slot at their weighted average.
+   */
+  void Compact() noexcept;
+
 };
 
 static_assert(std::is_trivial<XYDataStore>::value, "type is not trivial");
@@ -21,6 +21,7 @@
  */
 #include "ZeroFinder.hpp"
 
+#include <algorithm>
 #include <limits>
 
 #include <math.h>
@@ -129,26 +130,41 @@ double
 ZeroFinder::find_zero(const double xstart) noexcept
 {
   if ((xmin<=xstart) || (xstart<=xmax) ||
-      (f(xstart)> sqrt_epsilon))
-    return find_zero_actual(xstart);
+      (f(xstart)> sqrt_epsilon)) {
+    const auto fa = f(xmin);
+    return find_zero_actual(xmin, fa, xmax, f(xmax));
+  }
   return xstart;
 }
 
+double
+ZeroFinder::find_zero_near(const double xstart, const double width) noexcept
+{
+  const auto a = std::max(xmin, xstart - width);
+  const auto b = std::min(xmax, xstart + width);
+  if (a < b) {
+    const auto fa = f(a);
+    const auto fb = f(b);
+    if ((fa <= 0) != (fb <= 0))
+      /* the sign changes, so there is a zero in [a,b] */
+      return find_zero_actual(a, fa, b, fb);
+  }
+
+  const auto fa = f(xmin);
+  return find_zero_actual(xmin, fa, xmax, f(xmax));
+}
+
 inline double
-ZeroFinder::find_zero_actual(const double xstart) noexcept
+ZeroFinder::find_zero_actual(double a, double fa,
+                             double b, double fb) noexcept
 {
-  double a, b, c; // Abscissae, descr. see above
-  double fa; // f(a)
-  double fb; // f(b)
+  double c; // Abscissae, descr. see above
   double fc; // f(c)
 
   bool b_best = true; // b is best and last called
 
-  c = a = xmin;  
-  fc = fa = f(a);  
-
-  b = xmax;  
-  fb = f(b);
+  c = a;
+  fc = fa;
 
   // Main iteration loop
   for (;;) {
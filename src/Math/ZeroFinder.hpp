@@ -75,6 +75,20 @@ public:
   [[gnu::pure]]
   double find_zero(double xstart) noexcept;
 
+  /**
+   * Like find_zero(), but search the interval [xstart-width,
+   * xstart+width] first.  This is useful if xstart is the solution
+   * of a previous, similar search: if the zero has not moved far,
+   * the search needs only a few iterations.  If the interval
+   * contains no zero, the whole range is searched.
+   *
+   * @param xstart Initial guess of x
+   * @param width Half width of the interval around xstart
+   *
+   * @return x value of best solution
+   */
+  double find_zero_near(double xstart, double width) noexcept;
+
   /**
    * Find value of x that minimises f(x)
    * Method used is a variant of a bisector search.
@@ -88,8 +102,12 @@ public:
   double find_min(double xstart) noexcept;
 
 private:
+  /**
+   * Search a zero in the interval [a,b], given the function values
+   * at both ends.  The last call to f() must have been f(b).
+   */
   [[gnu::pure]]
-  double find_zero_actual(double xstart) noexcept;
+  double find_zero_actual(double a, double fa, double b, double fb) noexcept;
 
   [[gnu::pure]]
   double find_min_actual(double xstart) noexcept;
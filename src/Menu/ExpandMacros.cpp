@@ -43,6 +43,7 @@ Copyright_License {
 #include "util/Macros.hpp"
 #include "net/http/Features.hpp"
 #include "UIState.hpp"
+#include "thread/TraceEvents.hpp"
 
 #include <stdlib.h>
 
@@ -312,6 +313,8 @@ LookupMacro(const TCHAR *name, bool &invalid)
     return logger != nullptr && logger->IsLoggerActive()
       ? _("Stop")
       : _("Start");
+  } else if (StringIsEqual(name, _T("TraceToggleActionName"))) {
+    return TraceEvents::IsEnabled() ? _("Stop") : _("Start");
   } else if (StringIsEqual(name, _T("SnailTrailToggleName"))) {
     switch (GetMapSettings().trail.length) {
     case TrailSettings::Length::OFF:
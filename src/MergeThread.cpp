@@ -28,19 +28,31 @@ Copyright_License {
 #include "NMEA/MoreData.hpp"
 #include "Audio/VarioGlue.hpp"
 #include "Device/MultipleDevices.hpp"
+#include "thread/TraceEvents.hpp"
+
+#include <algorithm>
+
+using namespace std::chrono;
+
+/**
+ * The time between the first DeviceBlackboard::ScheduleMerge() call
+ * and the merge.  Updates from other devices arriving in this window
+ * are merged together.  A new GPS fix skips this delay.
+ */
+static constexpr auto MERGE_DELAY = milliseconds{10};
 
 MergeThread::MergeThread(DeviceBlackboard &_device_blackboard)
   :WorkerThread("MergeThread",
 #ifdef KOBO
                 /* throttle more on the Kobo, because the EPaper
                    screen cannot be updated that often */
-                std::chrono::milliseconds{450},
-                std::chrono::milliseconds{100},
+                milliseconds{450},
+                milliseconds{100},
 #else
-                std::chrono::milliseconds{50},
-                std::chrono::milliseconds{20},
+                milliseconds{50},
+                milliseconds{20},
 #endif
-                std::chrono::milliseconds{10}),
+                MERGE_DELAY),
    device_blackboard(_device_blackboard)
 {
   last_fix.Reset();
@@ -64,6 +76,54 @@ MergeThread::Process()
 
   flarm_computer.Process(device_blackboard.SetBasic().flarm,
                          last_fix.flarm, basic);
+
+  traffic_fusion.Process(device_blackboard.SetMoreData().fused_traffic,
+                         basic, skylines_data);
+}
+
+void
+MergeThread::SetSkyLinesData(const SkyLinesTracking::Data *data) noexcept
+{
+  const std::lock_guard<Mutex> lock(device_blackboard.mutex);
+  skylines_data = data;
+}
+
+MergeThread::Statistics
+MergeThread::GetStatistics() const noexcept
+{
+  const std::lock_guard<Mutex> lock(device_blackboard.mutex);
+  return statistics;
+}
+
+inline void
+MergeThread::UpdateStatistics(Clock::time_point now) noexcept
+{
+  if (now - merge_window_start >= seconds{1}) {
+    statistics.merges_per_second = merge_window_count;
+    merge_window_start = now;
+    merge_window_count = 0;
+  }
+
+  ++merge_window_count;
+
+  for (unsigned i = 0; i < NUMDEV; ++i) {
+    auto &update_time = device_blackboard.update_time[i];
+    if (update_time == Clock::time_point{})
+      continue;
+
+    const auto latency = duration_cast<microseconds>(now - update_time);
+    update_time = {};
+
+    auto &l = statistics.latency[i];
+    l.max = std::max(l.max, latency);
+
+    /* exponential moving average over roughly the last 8 updates */
+    l.average = l.samples == 0
+      ? latency
+      : l.average + (latency - l.average) / 8;
+
+    ++l.samples;
+  }
 }
 
 void
@@ -74,19 +134,21 @@ MergeThread::Tick() noexcept
 #ifdef HAVE_PCM_PLAYER
   bool vario_available;
   double vario;
+  int vario_device;
 #endif
 
   {
-    std::lock_guard<Mutex> lock(device_blackboard.mutex);
+    const StatisticsLockGuard<Mutex> lock(device_blackboard.mutex,
+                                          device_blackboard.lock_statistics.merge);
 
-    Process();
+    {
+      const ScopeTraceEvent trace("Merge");
+      Process();
+    }
+    UpdateStatistics(Clock::now());
 
     const MoreData &basic = device_blackboard.Basic();
 
-    /* call Driver::OnSensorUpdate() on all devices */
-    if (devices != nullptr)
-      devices->NotifySensorUpdate(basic);
-
     /* trigger update if gps has become available or dropped out */
     gps_updated = last_any.location_available != basic.location_available;
 
@@ -99,6 +161,7 @@ MergeThread::Tick() noexcept
 #ifdef HAVE_PCM_PLAYER
     vario_available = basic.brutto_vario_available;
     vario = vario_available ? basic.brutto_vario : 0;
+    vario_device = device_blackboard.FindTotalEnergyVarioDevice();
 #endif
 
     /* update last_any in every iteration */
@@ -111,11 +174,21 @@ MergeThread::Tick() noexcept
       last_fix = basic;
   }
 
+  /* call Driver::OnSensorUpdate() on all devices; this uses our
+     private copy, so no driver code runs while the blackboard mutex
+     is held */
+  if (devices != nullptr)
+    devices->NotifySensorUpdate(last_any);
+
 #ifdef HAVE_PCM_PLAYER
-  if (vario_available)
-    AudioVarioGlue::SetValue(vario);
-  else
-    AudioVarioGlue::NoValue();
+  /* skip this if the device feeds the synthesiser directly, see
+     DeviceDescriptor::LineReceived() */
+  if (!AudioVarioGlue::SetDirectSource(vario_device)) {
+    if (vario_available)
+      AudioVarioGlue::SetValue(vario);
+    else
+      AudioVarioGlue::NoValue();
+  }
 #endif
 
   if (gps_updated)
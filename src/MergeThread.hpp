@@ -27,7 +27,13 @@ Copyright_License {
 #include "thread/WorkerThread.hpp"
 #include "Computer/BasicComputer.hpp"
 #include "FLARM/FlarmComputer.hpp"
+#include "Computer/TrafficFusion.hpp"
 #include "NMEA/MoreData.hpp"
+#include "Device/Features.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
 
 class DeviceBlackboard;
 
@@ -36,6 +42,29 @@ class DeviceBlackboard;
  * it and runs a number of cheap calculations.
  */
 class MergeThread final : public WorkerThread {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  struct Statistics {
+    /**
+     * The number of merges during the last full second.
+     */
+    unsigned merges_per_second;
+
+    /**
+     * The time between a device update and the merge which
+     * picked it up.
+     */
+    struct Latency {
+      std::chrono::microseconds average, max;
+
+      uint32_t samples;
+    };
+
+    std::array<Latency, NUMDEV> latency;
+  };
+
+private:
   DeviceBlackboard &device_blackboard;
 
   /**
@@ -52,6 +81,25 @@ class MergeThread final : public WorkerThread {
 
   BasicComputer computer;
   FlarmComputer flarm_computer;
+  TrafficFusion traffic_fusion;
+
+  /**
+   * The SkyLines traffic to be merged into MoreData::fused_traffic,
+   * or nullptr.  Protected by DeviceBlackboard::mutex.
+   */
+  const SkyLinesTracking::Data *skylines_data = nullptr;
+
+  /**
+   * Protected by DeviceBlackboard::mutex.
+   */
+  Statistics statistics{};
+
+  /**
+   * The start of the current one-second window for
+   * Statistics::merges_per_second, and the number of merges in it.
+   */
+  Clock::time_point merge_window_start;
+  unsigned merge_window_count = 0;
 
 public:
   MergeThread(DeviceBlackboard &_device_blackboard);
@@ -74,9 +122,27 @@ public:
     SetLowPriority();
   }
 
+  /**
+   * Returns a copy of the statistics for displaying them.  Locks the
+   * #DeviceBlackboard.
+   */
+  Statistics GetStatistics() const noexcept;
+
+  /**
+   * Set the SkyLines traffic source for the traffic fusion.  Locks
+   * the #DeviceBlackboard.
+   */
+  void SetSkyLinesData(const SkyLinesTracking::Data *data) noexcept;
+
 private:
   void Process();
 
+  /**
+   * Update the statistics after a merge.  Caller must lock the
+   * #DeviceBlackboard.
+   */
+  void UpdateStatistics(Clock::time_point now) noexcept;
+
 protected:
   void Tick() noexcept override;
 };
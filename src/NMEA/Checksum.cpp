@@ -34,7 +34,24 @@ VerifyNMEAChecksum(const char *p)
 {
   assert(p != NULL);
 
-  const char *asterisk = strrchr(p, '*');
+  /* skip the dollar sign at the beginning (the exclamation mark is
+     used by CAI302 */
+  if (*p == '$' || *p == '!')
+    ++p;
+
+  /* calculate the checksum while looking for the (last) asterisk, so
+     the line is scanned only once */
+  uint8_t CalcCheckSum = 0, checksum = 0;
+  const char *asterisk = NULL;
+  for (; *p != 0; ++p) {
+    if (*p == '*') {
+      asterisk = p;
+      CalcCheckSum = checksum;
+    }
+
+    checksum ^= *p;
+  }
+
   if (asterisk == NULL)
     return false;
 
@@ -45,7 +62,6 @@ VerifyNMEAChecksum(const char *p)
     return false;
 
   uint8_t ReadCheckSum = (unsigned char)ReadCheckSum2;
-  uint8_t CalcCheckSum = NMEAChecksum(p, asterisk - p);
 
   return CalcCheckSum == ReadCheckSum;
 }
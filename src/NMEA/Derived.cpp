@@ -96,6 +96,7 @@ DerivedInfo::Reset()
   airspace_warnings.Clear();
 
   planned_route.clear();
+  landable_reach.Clear();
 }
 
 void
@@ -45,6 +45,7 @@ Copyright_License {
 #include "Atmosphere/Pressure.hpp"
 #include "Engine/Route/Route.hpp"
 #include "Computer/WaveResult.hpp"
+#include "Computer/LandableReach.hpp"
 
 #include <type_traits>
 
@@ -250,6 +251,9 @@ struct DerivedInfo:
   /** Route plan for current leg avoiding airspace */
   StaticRoute planned_route;
 
+  /** Terrain reach of the nearest landables */
+  LandableReach landable_reach;
+
   /**
    * Thermal value of next leg that is equivalent (gives the same average
    * speed) to the current MacCready setting. A negative value should be
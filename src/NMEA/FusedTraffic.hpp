@@ -0,0 +1,158 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_FUSED_TRAFFIC_HPP
+#define XCSOAR_FUSED_TRAFFIC_HPP
+
+#include "FLARM/FlarmId.hpp"
+#include "GliderLink/GliderLinkId.hpp"
+#include "Geo/GeoPoint.hpp"
+#include "NMEA/Validity.hpp"
+#include "util/StaticString.hxx"
+#include "util/TrivialArray.hxx"
+
+#include <type_traits>
+
+#include <stdint.h>
+
+/**
+ * One aircraft reported by one or more traffic sources.  The
+ * position is extrapolated to the time of the merge.
+ */
+struct FusedTraffic {
+  enum class Source : uint8_t {
+    FLARM,
+    GLIDER_LINK,
+    SKYLINES,
+  };
+
+  /**
+   * The source whose data is used; this is the most accurate one of
+   * all sources which report this aircraft.
+   */
+  Source source;
+
+  /**
+   * A bit mask of all sources which report this aircraft, see
+   * HasSource().
+   */
+  uint8_t sources;
+
+  bool altitude_available;
+
+  /**
+   * Are #track and #speed known?
+   */
+  bool velocity_available;
+
+  /**
+   * The ids in the sources which report this aircraft; only the ones
+   * whose bit is set in #sources are valid.
+   */
+  FlarmId flarm_id;
+  GliderLinkId glider_link_id;
+  uint32_t skylines_id;
+
+  GeoPoint location;
+
+  /** Altitude above MSL [m] */
+  double altitude;
+
+  Angle track;
+
+  /** Ground speed [m/s] */
+  double speed;
+
+  /**
+   * The age of the source report at the time of the merge [s].
+   */
+  double age;
+
+  StaticString<16> name;
+
+  static constexpr uint8_t ToMask(Source source) {
+    return 1u << unsigned(source);
+  }
+
+  constexpr bool HasSource(Source _source) const {
+    return sources & ToMask(_source);
+  }
+};
+
+static_assert(std::is_trivial<FusedTraffic>::value, "type is not trivial");
+
+/**
+ * All traffic from FLARM, GliderLink and SkyLines in one list, with
+ * duplicates removed.  It is rebuilt by #TrafficFusion on every
+ * merge.
+ */
+struct FusedTrafficList {
+  static constexpr size_t MAX_COUNT = 96;
+
+  /**
+   * Time stamp of the latest update.
+   */
+  Validity modified;
+
+  TrivialArray<FusedTraffic, MAX_COUNT> list;
+
+  void Clear() {
+    modified.Clear();
+    list.clear();
+  }
+
+  bool IsEmpty() const {
+    return list.empty();
+  }
+
+  const FusedTraffic *FindFlarm(FlarmId id) const {
+    for (const auto &traffic : list)
+      if (traffic.HasSource(FusedTraffic::Source::FLARM) &&
+          traffic.flarm_id == id)
+        return &traffic;
+
+    return nullptr;
+  }
+
+  const FusedTraffic *FindGliderLink(GliderLinkId id) const {
+    for (const auto &traffic : list)
+      if (traffic.HasSource(FusedTraffic::Source::GLIDER_LINK) &&
+          traffic.glider_link_id == id)
+        return &traffic;
+
+    return nullptr;
+  }
+
+  const FusedTraffic *FindSkyLines(uint32_t id) const {
+    for (const auto &traffic : list)
+      if (traffic.HasSource(FusedTraffic::Source::SKYLINES) &&
+          traffic.skylines_id == id)
+        return &traffic;
+
+    return nullptr;
+  }
+};
+
+static_assert(std::is_trivial<FusedTrafficList>::value, "type is not trivial");
+
+#endif
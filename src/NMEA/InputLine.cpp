@@ -23,12 +23,19 @@ Copyright_License {
 
 #include "NMEA/InputLine.hpp"
 
-#include <string.h>
-
-NMEAInputLine::NMEAInputLine(const char* line):
-  CSVLine(line)
+/**
+ * Find the asterisk which starts the checksum, or the end of the
+ * line, whichever comes first.
+ */
+[[gnu::pure]]
+static const char *
+FindEnd(const char *p) noexcept
 {
-  const char* asterisk = strchr(line, '*');
-  if (asterisk != NULL)
-    end = asterisk;
+  while (*p != 0 && *p != '*')
+    ++p;
+
+  return p;
 }
+
+NMEAInputLine::NMEAInputLine(const char *line) noexcept
+  :CSVLine(line, FindEnd(line)) {}
@@ -29,9 +29,12 @@ Copyright_License {
 /**
  * A helper class which can dissect a NMEA input line.
  */
+/**
+ * A #CSVLine which ends at the asterisk (i.e. before the checksum).
+ */
 class NMEAInputLine: public CSVLine {
 public:
-  NMEAInputLine(const char* line);
+  explicit NMEAInputLine(const char *line) noexcept;
 };
 
 #endif
@@ -38,5 +38,10 @@ MoreData::Reset()
   brutto_vario = 0;
   brutto_vario_available.Clear();
 
+  speed_samples.Clear();
+  heading_turn_rate_available.Clear();
+
+  fused_traffic.Clear();
+
   NMEAInfo::Reset();
 }
@@ -25,6 +25,8 @@ Copyright_License {
 #define XCSOAR_MORE_DATA_HPP
 
 #include "NMEA/Info.hpp"
+#include "NMEA/SpeedSamples.hpp"
+#include "NMEA/FusedTraffic.hpp"
 
 #include <type_traits>
 
@@ -59,6 +61,26 @@ struct MoreData : public NMEAInfo {
 
   Validity brutto_vario_available;
 
+  /**
+   * Recent ground speed / airspeed pairs for the wind EKF.
+   */
+  SpeedSamples speed_samples;
+
+  /**
+   * The turn rate derived from the heading of a compass (see
+   * AttitudeState::heading_available).  It is evaluated by
+   * #BasicComputer at the rate of the device, which is usually much
+   * higher than the GPS rate, and is already smoothed.
+   */
+  Angle heading_turn_rate;
+  Validity heading_turn_rate_available;
+
+  /**
+   * The traffic from all sources, with duplicates removed.  It is
+   * maintained by #TrafficFusion.
+   */
+  FusedTrafficList fused_traffic;
+
   void Reset();
 
   bool NavAltitudeAvailable() const {
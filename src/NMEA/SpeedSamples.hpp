@@ -0,0 +1,115 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_SPEED_SAMPLES_HPP
+#define XCSOAR_SPEED_SAMPLES_HPP
+
+#include "NMEA/Validity.hpp"
+#include "time/Stamp.hpp"
+
+#include <array>
+#include <type_traits>
+
+#include <cassert>
+
+/**
+ * A short history of ground velocity / true airspeed pairs.  It is
+ * filled by #BasicComputer inside #MergeThread at the rate of the
+ * instruments, and consumed by #WindEKFGlue in the (much slower)
+ * #CalculationThread, so samples arriving between two calculation
+ * cycles are not lost.
+ */
+struct SpeedSamples {
+  static constexpr unsigned CAPACITY = 32;
+
+  struct Sample {
+    TimeStamp time;
+
+    /**
+     * Ground velocity east and north [m/s].
+     */
+    float ground_velocity[2];
+
+    /**
+     * True airspeed [m/s].
+     */
+    float true_airspeed;
+  };
+
+  std::array<Sample, CAPACITY> samples;
+
+  /**
+   * The index of the oldest sample in #samples.
+   */
+  unsigned head;
+
+  /**
+   * The number of valid samples.
+   */
+  unsigned size;
+
+  /**
+   * The speed validities of the newest sample, used to check if
+   * updated values are available.
+   */
+  Validity last_ground_speed_available, last_airspeed_available;
+
+  void Clear() noexcept {
+    head = size = 0;
+    last_ground_speed_available.Clear();
+    last_airspeed_available.Clear();
+  }
+
+  constexpr bool empty() const noexcept {
+    return size == 0;
+  }
+
+  /**
+   * Returns the sample with the given age index (0 is the oldest).
+   */
+  constexpr const Sample &operator[](unsigned i) const noexcept {
+    assert(i < size);
+    return samples[(head + i) % CAPACITY];
+  }
+
+  constexpr const Sample &back() const noexcept {
+    return (*this)[size - 1];
+  }
+
+  /**
+   * Append a new sample, overwriting the oldest one if the buffer is
+   * full.
+   */
+  Sample &Append() noexcept {
+    if (size < CAPACITY)
+      return samples[(head + size++) % CAPACITY];
+
+    Sample &s = samples[head];
+    head = (head + 1) % CAPACITY;
+    return s;
+  }
+};
+
+static_assert(std::is_trivial<SpeedSamples>::value, "type is not trivial");
+
+#endif
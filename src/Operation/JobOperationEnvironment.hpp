@@ -0,0 +1,74 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_JOB_OPERATION_HPP
+#define XCSOAR_JOB_OPERATION_HPP
+
+#include "Operation.hpp"
+#include "util/tstring.hpp"
+
+#include <thread>
+
+/**
+ * An #OperationEnvironment for a job which may run in a worker
+ * thread (e.g. a #ThreadPool job).  Text and progress are forwarded
+ * only from the thread which has constructed this object, because
+ * the real #OperationEnvironment is not thread-safe.  The first
+ * error message is kept; call ForwardError() after the job has
+ * finished.
+ */
+class JobOperationEnvironment final : public NullOperationEnvironment {
+  OperationEnvironment &main;
+  std::thread::id main_thread;
+
+  tstring error;
+
+public:
+  explicit JobOperationEnvironment(OperationEnvironment &_main) noexcept
+    :main(_main), main_thread(std::this_thread::get_id()) {}
+
+  bool HasError() const noexcept {
+    return !error.empty();
+  }
+
+  /**
+   * Pass the error message (if any) to the real
+   * #OperationEnvironment.  Must be called from the constructing
+   * thread after the job has finished.
+   */
+  void ForwardError() noexcept;
+
+private:
+  bool IsMainThread() const noexcept {
+    return std::this_thread::get_id() == main_thread;
+  }
+
+public:
+  /* virtual methods from class OperationEnvironment */
+  void SetErrorMessage(const TCHAR *text) noexcept override;
+  void SetText(const TCHAR *text) noexcept override;
+  void SetProgressRange(unsigned range) noexcept override;
+  void SetProgressPosition(unsigned position) noexcept override;
+};
+
+#endif
@@ -0,0 +1,53 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "PowerPolicy.hpp"
+#include "Hardware/PowerInfo.hpp"
+
+void
+PowerPolicy::Update(const Power::Info &info) noexcept
+{
+  battery_low = info.external.status == Power::ExternalInfo::Status::OFF &&
+    info.battery.remaining_percent &&
+    *info.battery.remaining_percent < BATTERY_THRESHOLD;
+}
+
+bool
+PowerPolicy::CheckRedraw() noexcept
+{
+  switch (GetMode()) {
+  case Mode::NORMAL:
+    return true;
+
+  case Mode::BATTERY_LOW:
+    if (last_redraw.CheckUpdate(REDRAW_INTERVAL))
+      return true;
+    break;
+
+  case Mode::SCREEN_OFF:
+    break;
+  }
+
+  ++deferred_redraws;
+  return false;
+}
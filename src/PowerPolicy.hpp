@@ -0,0 +1,105 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_POWER_POLICY_HPP
+#define XCSOAR_POWER_POLICY_HPP
+
+#include "time/PeriodClock.hpp"
+
+#include <chrono>
+
+namespace Power { struct Info; }
+
+/**
+ * Decides whether XCSoar shall save power, i.e. redraw the map less
+ * often, defer expensive non-critical calculations and reduce the
+ * terrain quality.  This happens when running on battery with a low
+ * charge, and while the screen is off.
+ *
+ * All methods must be called from the main thread.
+ */
+class PowerPolicy {
+public:
+  enum class Mode {
+    NORMAL,
+    BATTERY_LOW,
+    SCREEN_OFF,
+  };
+
+  /**
+   * Save power when running on battery below this charge [%].
+   */
+  static constexpr unsigned BATTERY_THRESHOLD = 30;
+
+  /**
+   * While saving power, the map is redrawn for new calculation
+   * results only with this interval.
+   */
+  static constexpr auto REDRAW_INTERVAL = std::chrono::seconds(1);
+
+private:
+  bool battery_low = false;
+  bool screen_off = false;
+
+  PeriodClock last_redraw;
+
+  /**
+   * The number of map redraws skipped by CheckRedraw().
+   */
+  unsigned deferred_redraws = 0;
+
+public:
+  /**
+   * Update the battery state.  Called periodically by #BatteryTimer.
+   */
+  void Update(const Power::Info &info) noexcept;
+
+  void SetScreenOff(bool _screen_off) noexcept {
+    screen_off = _screen_off;
+  }
+
+  Mode GetMode() const noexcept {
+    if (screen_off)
+      return Mode::SCREEN_OFF;
+    else if (battery_low)
+      return Mode::BATTERY_LOW;
+    else
+      return Mode::NORMAL;
+  }
+
+  bool IsSaving() const noexcept {
+    return GetMode() != Mode::NORMAL;
+  }
+
+  /**
+   * New calculation results have arrived.  Shall the map be redrawn
+   * now?  If not, the redraw is counted as deferred.
+   */
+  bool CheckRedraw() noexcept;
+
+  unsigned GetDeferredRedraws() const noexcept {
+    return deferred_redraws;
+  }
+};
+
+#endif
@@ -146,6 +146,8 @@ Profile::Load(const ProfileMap &map, MapSettings &settings)
   map.Get(ProfileKeys::EnableVarioBar,
           settings.vario_bar_enabled);
 
+  map.Get(ProfileKeys::FrameProfiler, settings.frame_profiler);
+
   Load(map, settings.trail);
   Load(map, settings.item_list);
 }
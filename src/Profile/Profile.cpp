@@ -34,15 +34,80 @@ Copyright_License {
 #include "util/tstring.hpp"
 #include "system/FileUtil.hpp"
 #include "system/Path.hpp"
+#include "thread/StandbyThread.hpp"
 
 #include <windef.h> /* for MAX_PATH */
 #include <cassert>
+#include <memory>
+#include <optional>
+#include <utility>
 
 #define XCSPROFILE "default.prf"
 #define OLDXCSPROFILE "xcsoar-registry.prf"
 
 static AllocatedPath startProfileFile = nullptr;
 
+/**
+ * Writes profile snapshots in a separate thread, because writing to
+ * slow flash storage would block the user interface.  Requests which
+ * arrive while the thread is still writing are coalesced: only the
+ * most recent snapshot gets written afterwards.
+ */
+class ProfileSaveThread final : public StandbyThread {
+  /**
+   * The snapshot which has not been written yet.  Protected by
+   * StandbyThread::mutex.
+   */
+  std::optional<ProfileMap> snapshot;
+  AllocatedPath path = nullptr;
+
+public:
+  ProfileSaveThread() noexcept:StandbyThread("ProfileSave") {}
+
+  ~ProfileSaveThread() noexcept {
+    Flush();
+  }
+
+  /**
+   * Throws if the thread could not be started.
+   */
+  void Save(const ProfileMap &map, Path _path) {
+    const std::lock_guard<Mutex> lock(mutex);
+    snapshot = map;
+    path = _path;
+    Trigger();
+  }
+
+  /**
+   * Write the pending snapshot (if any) and stop the thread.
+   */
+  void Flush() noexcept {
+    std::unique_lock<Mutex> lock(mutex);
+    WaitDone(lock);
+    Stop();
+  }
+
+private:
+  /* virtual methods from class StandbyThread */
+  void Tick() noexcept override {
+    while (snapshot) {
+      const ProfileMap map = std::move(*snapshot);
+      snapshot.reset();
+      const AllocatedPath p = std::exchange(path, nullptr);
+
+      const ScopeUnlock unlock(mutex);
+      try {
+        LogFormat(_T("Saving profile to %s"), p.c_str());
+        Profile::SaveFile(map, p);
+      } catch (...) {
+        LogError(std::current_exception(), "Failed to save profile");
+      }
+    }
+  }
+};
+
+static std::unique_ptr<ProfileSaveThread> save_thread;
+
 Path
 Profile::GetPath()
 {
@@ -83,12 +148,22 @@ Profile::Save() noexcept
   assert(startProfileFile != nullptr);
 
   try {
-    SaveFile(startProfileFile);
+    if (!save_thread)
+      save_thread = std::make_unique<ProfileSaveThread>();
+
+    save_thread->Save(map, startProfileFile);
   } catch (...) {
     LogError(std::current_exception(), "Failed to save profile");
   }
 }
 
+void
+Profile::Flush() noexcept
+{
+  if (save_thread)
+    save_thread->Flush();
+}
+
 void
 Profile::SaveFile(Path path)
 {
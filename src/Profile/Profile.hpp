@@ -52,11 +52,17 @@ namespace Profile
   void LoadFile(Path path);
 
   /**
-   * Saves the profile into the profile files
+   * Saves the profile into the profile files.  The file is written
+   * by a background thread; call Flush() to wait for it.
    *
    * Errors will be caught and logged.
    */
   void Save() noexcept;
+
+  /**
+   * Wait until all pending Save() calls have been written.
+   */
+  void Flush() noexcept;
   /**
    * Saves the profile into the given profile file
    */
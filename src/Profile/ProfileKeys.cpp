@@ -206,11 +206,13 @@ const char EnableFinalGlideBarMC0[] = "EnableFinalGlideBarMC0";
 const char FinalGlideBarDisplayMode[] = "FinalGlideBarDisplayMode";
 const char EnableVarioBar[] = "EnableVarioBar";
 const char ShowFAITriangleAreas[] = "ShowFAITriangleAreas";
+const char FrameProfiler[] = "FrameProfiler";
 const char FAITriangleThreshold[] = "FAITriangleThreshold";
 const char AutoLogger[] = "AutoLogger";
 const char DisableAutoLogger[] = "DisableAutoLogger";
 const char EnableFlightLogger[] = "EnableFlightLogger";
 const char EnableNMEALogger[] = "EnableNMEALogger";
+const char CompressNMEALogger[] = "CompressNMEALogger";
 const char MapFile[] = "MapFile"; // pL
 const char BallastSecsToEmpty[] = "BallastSecsToEmpty";
 const char DialogFont[] = "DialogFont";
@@ -286,6 +288,8 @@ const char VarioMaxPeriod[] = "VarioMaxPeriod";
 const char VarioDeadBandEnabled[] = "VarioDeadBandEnabled";
 const char VarioDeadBandMin[] = "VarioDeadBandMin";
 const char VarioDeadBandMax[] = "VarioDeadBandMax";
+const char VarioDirectFeed[] = "VarioDirectFeed";
+const char VarioBufferTime[] = "VarioBufferTime";
 
 const char PagesDistinctZoom[] = "PagesDistinctZoom";
 
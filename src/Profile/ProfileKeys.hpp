@@ -202,11 +202,13 @@ extern const char EnableFinalGlideBarMC0[];
 extern const char FinalGlideBarDisplayMode[];
 extern const char EnableVarioBar[];
 extern const char ShowFAITriangleAreas[];
+extern const char FrameProfiler[];
 extern const char FAITriangleThreshold[];
 extern const char AutoLogger[];
 extern const char DisableAutoLogger[];
 extern const char EnableFlightLogger[];
 extern const char EnableNMEALogger[];
+extern const char CompressNMEALogger[];
 extern const char MapFile[];
 extern const char BallastSecsToEmpty[];
 extern const char AccelerometerZero[];
@@ -284,6 +286,8 @@ extern const char VarioMaxPeriod[];
 extern const char VarioDeadBandEnabled[];
 extern const char VarioDeadBandMin[];
 extern const char VarioDeadBandMax[];
+extern const char VarioDirectFeed[];
+extern const char VarioBufferTime[];
 
 extern const char PagesDistinctZoom[];
 
@@ -103,6 +103,9 @@ Profile::Load(const ProfileMap &map, VarioSoundSettings &settings)
 
   map.Get(ProfileKeys::VarioDeadBandMin, settings.min_dead);
   map.Get(ProfileKeys::VarioDeadBandMax, settings.max_dead);
+
+  map.Get(ProfileKeys::VarioDirectFeed, settings.direct_feed);
+  map.Get(ProfileKeys::VarioBufferTime, settings.buffer_time_ms);
 }
 
 void
@@ -59,6 +59,12 @@ MapWindowProjection::WaypointInScaleFilter(const Waypoint &way_point) const noex
   return (GetMapScale() <= (way_point.IsLandable() ? 20000 : 10000));
 }
 
+bool
+MapWindowProjection::AnyWaypointInScaleFilter() const noexcept
+{
+  return GetMapScale() <= 20000;
+}
+
 double
 MapWindowProjection::CalculateMapScale(unsigned scale) const noexcept
 {
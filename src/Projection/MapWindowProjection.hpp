@@ -57,6 +57,13 @@ public:
   [[gnu::pure]]
   bool WaypointInScaleFilter(const Waypoint &way_point) const noexcept;
 
+  /**
+   * Can WaypointInScaleFilter() return true for any waypoint at the
+   * current map scale?
+   */
+  [[gnu::pure]]
+  bool AnyWaypointInScaleFilter() const noexcept;
+
 private:
   double LimitMapScale(double value) const noexcept;
 
@@ -27,6 +27,90 @@ Copyright_License {
 
 #include <algorithm>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define HAVE_PROJECTION_SSE2
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+/* NEON on 32 bit ARM lacks double precision vectors */
+#include <arm_neon.h>
+#define HAVE_PROJECTION_NEON
+#endif
+
+/**
+ * The number of points converted in one chunk by the batch
+ * GeoToScreen() method; the intermediate values live on the stack.
+ */
+static constexpr std::size_t GEO_TO_SCREEN_CHUNK = 64;
+
+#ifdef HAVE_PROJECTION_SSE2
+
+/**
+ * Multiply four 32 bit integers, keeping the lower 32 bits of each
+ * product.  This is _mm_mullo_epi32() from SSE4.1, emulated with
+ * SSE2.
+ */
+static inline __m128i
+MultiplyLow32(__m128i a, __m128i b) noexcept
+{
+  const __m128i even = _mm_mul_epu32(a, b);
+  const __m128i odd = _mm_mul_epu32(_mm_srli_si128(a, 4),
+                                    _mm_srli_si128(b, 4));
+  return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                            _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+/**
+ * Truncate four doubles to 32 bit integers.
+ */
+static inline __m128i
+Truncate(__m128d lo, __m128d hi) noexcept
+{
+  return _mm_unpacklo_epi64(_mm_cvttpd_epi32(lo), _mm_cvttpd_epi32(hi));
+}
+
+static inline __m128i
+Truncate(const double *a) noexcept
+{
+  return Truncate(_mm_loadu_pd(a), _mm_loadu_pd(a + 2));
+}
+
+/**
+ * Calculate a*b for four pairs of doubles and truncate the products
+ * to 32 bit integers.
+ */
+static inline __m128i
+MultiplyTruncate(const double *a, const double *b) noexcept
+{
+  return Truncate(_mm_mul_pd(_mm_loadu_pd(a), _mm_loadu_pd(b)),
+                  _mm_mul_pd(_mm_loadu_pd(a + 2), _mm_loadu_pd(b + 2)));
+}
+
+#endif
+
+#ifdef HAVE_PROJECTION_NEON
+
+static inline int32x4_t
+Truncate(float64x2_t lo, float64x2_t hi) noexcept
+{
+  return vcombine_s32(vmovn_s64(vcvtq_s64_f64(lo)),
+                      vmovn_s64(vcvtq_s64_f64(hi)));
+}
+
+static inline int32x4_t
+Truncate(const double *a) noexcept
+{
+  return Truncate(vld1q_f64(a), vld1q_f64(a + 2));
+}
+
+static inline int32x4_t
+MultiplyTruncate(const double *a, const double *b) noexcept
+{
+  return Truncate(vmulq_f64(vld1q_f64(a), vld1q_f64(b)),
+                  vmulq_f64(vld1q_f64(a + 2), vld1q_f64(b + 2)));
+}
+
+#endif
+
 Projection::Projection() noexcept
 {
   SetScale(1);
@@ -73,6 +157,114 @@ Projection::GeoToScreen(const GeoPoint &g) const noexcept
   return sc;
 }
 
+void
+Projection::GeoToScreen(std::span<const GeoPoint> src,
+                        std::span<PixelPoint> dest) const noexcept
+{
+  assert(IsValid());
+  assert(src.size() == dest.size());
+
+  static_assert(sizeof(PixelPoint) == 2 * sizeof(int));
+
+  /* the pixel values before truncation; the operands are multiplied
+     in the same order as in the scalar GeoToScreen(), so the results
+     are bit-identical */
+  double x[GEO_TO_SCREEN_CHUNK], y[GEO_TO_SCREEN_CHUNK];
+  double cosine[GEO_TO_SCREEN_CHUNK];
+
+  while (!src.empty()) {
+    const std::size_t n = std::min(src.size(), GEO_TO_SCREEN_CHUNK);
+
+    /* the normalisation and the table lookup cannot be vectorised;
+       this is "geo_location - src[i]", but with an inline fast path
+       for the common case which does not need Angle::AsDelta() (its
+       special case for subnormals makes no difference after
+       truncation to pixels) */
+    for (std::size_t i = 0; i < n; ++i) {
+      Angle longitude = geo_location.longitude - src[i].longitude;
+      if (!(longitude > -Angle::HalfCircle() &&
+            longitude <= Angle::HalfCircle()))
+        longitude = longitude.AsDelta();
+
+      const Angle latitude =
+        std::clamp(geo_location.latitude - src[i].latitude,
+                   -Angle::QuarterCircle(), Angle::QuarterCircle());
+
+      x[i] = AngleToPixels(longitude);
+      y[i] = AngleToPixels(latitude);
+      cosine[i] = src[i].latitude.fastcosine();
+    }
+
+    std::size_t i = 0;
+
+#ifdef HAVE_PROJECTION_SSE2
+    const __m128i cost = _mm_set1_epi32(screen_rotation.GetCosine());
+    const __m128i sint = _mm_set1_epi32(screen_rotation.GetSine());
+    const __m128i half = _mm_set1_epi32(FastIntegerRotation::HALF);
+    const __m128i origin_x = _mm_set1_epi32(screen_origin.x);
+    const __m128i origin_y = _mm_set1_epi32(screen_origin.y);
+
+    for (; i + 4 <= n; i += 4) {
+      const __m128i px = MultiplyTruncate(cosine + i, x + i);
+      const __m128i py = Truncate(y + i);
+
+      const __m128i rx =
+        _mm_srai_epi32(_mm_add_epi32(_mm_sub_epi32(MultiplyLow32(px, cost),
+                                                   MultiplyLow32(py, sint)),
+                                     half),
+                       FastIntegerRotation::SHIFT);
+      const __m128i ry =
+        _mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(MultiplyLow32(py, cost),
+                                                   MultiplyLow32(px, sint)),
+                                     half),
+                       FastIntegerRotation::SHIFT);
+
+      const __m128i sx = _mm_sub_epi32(origin_x, rx);
+      const __m128i sy = _mm_add_epi32(origin_y, ry);
+
+      auto *d = (__m128i *)(void *)&dest[i];
+      _mm_storeu_si128(d, _mm_unpacklo_epi32(sx, sy));
+      _mm_storeu_si128(d + 1, _mm_unpackhi_epi32(sx, sy));
+    }
+#elif defined(HAVE_PROJECTION_NEON)
+    const int cost = screen_rotation.GetCosine();
+    const int sint = screen_rotation.GetSine();
+    const int32x4_t half = vdupq_n_s32(FastIntegerRotation::HALF);
+    const int32x4_t origin_x = vdupq_n_s32(screen_origin.x);
+    const int32x4_t origin_y = vdupq_n_s32(screen_origin.y);
+
+    for (; i + 4 <= n; i += 4) {
+      const int32x4_t px = MultiplyTruncate(cosine + i, x + i);
+      const int32x4_t py = Truncate(y + i);
+
+      const int32x4_t rx =
+        vshrq_n_s32(vaddq_s32(vmlsq_n_s32(vmulq_n_s32(px, cost), py, sint),
+                              half),
+                    FastIntegerRotation::SHIFT);
+      const int32x4_t ry =
+        vshrq_n_s32(vaddq_s32(vmlaq_n_s32(vmulq_n_s32(py, cost), px, sint),
+                              half),
+                    FastIntegerRotation::SHIFT);
+
+      int32x4x2_t result;
+      result.val[0] = vsubq_s32(origin_x, rx);
+      result.val[1] = vaddq_s32(origin_y, ry);
+      vst2q_s32((int32_t *)(void *)&dest[i], result);
+    }
+#endif
+
+    /* the remaining points (or all of them if there is no SIMD) */
+    for (; i < n; ++i) {
+      const auto p =
+        screen_rotation.Rotate(PixelPoint(int(cosine[i] * x[i]), int(y[i])));
+      dest[i] = {screen_origin.x - p.x, screen_origin.y + p.y};
+    }
+
+    src = src.subspan(n);
+    dest = dest.subspan(n);
+  }
+}
+
 void
 Projection::SetScale(const double _scale) noexcept
 {
@@ -29,7 +29,10 @@ Copyright_License {
 #include "Math/Util.hpp"
 #include "ui/dim/Point.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <iterator>
+#include <span>
 
 /**
  * This is a class that can be used for converting geographical into screen
@@ -140,6 +143,36 @@ public:
   [[gnu::pure]]
   PixelPoint GeoToScreen(const GeoPoint &g) const noexcept;
 
+  /**
+   * Converts many GeoPoints to screen coordinates.  The results are
+   * exactly the same as calling GeoToScreen() for each point, but
+   * the loop invariants are hoisted and the scaling/rotation is
+   * vectorised where the CPU supports it.
+   *
+   * @param dest an array with the same size as #src
+   */
+  void GeoToScreen(std::span<const GeoPoint> src,
+                   std::span<PixelPoint> dest) const noexcept;
+
+  /**
+   * Same as above, but writes to a different point type (e.g.
+   * #BulkPixelPoint).
+   */
+  template<typename P>
+  void GeoToScreen(std::span<const GeoPoint> src,
+                   std::span<P> dest) const noexcept {
+    assert(src.size() == dest.size());
+
+    PixelPoint buffer[64];
+    auto o = dest.begin();
+    while (!src.empty()) {
+      const std::size_t n = std::min(src.size(), std::size(buffer));
+      GeoToScreen(src.first(n), std::span{buffer, n});
+      o = std::copy_n(buffer, n, o);
+      src = src.subspan(n);
+    }
+  }
+
   /**
    * Returns the origin/rotation center in screen coordinates
    * @return The origin/rotation center in screen coordinates
@@ -35,9 +35,14 @@ Copyright_License {
 bool global_running;
 
 void
-TriggerMergeThread()
+TriggerMergeThread(bool urgent)
 {
-  if (merge_thread != nullptr)
+  if (merge_thread == nullptr)
+    return;
+
+  if (urgent)
+    merge_thread->TriggerUrgent();
+  else
     merge_thread->Trigger();
 }
 
@@ -27,9 +27,12 @@ Copyright_License {
 /**
  * Notify the #MergeThread that new data has arrived in the
  * #DeviceBlackboard.
+ *
+ * @param urgent true if a new GPS fix has arrived; this skips the
+ * delay which groups consecutive updates into one merge
  */
 void
-TriggerMergeThread();
+TriggerMergeThread(bool urgent=false);
 
 void TriggerGPSUpdate();
 
@@ -21,24 +21,21 @@ Copyright_License {
 }
 */
 
-#include <algorithm>
 #include "AirspaceLabelList.hpp"
+#include "Engine/Airspace/AbstractAirspace.hpp"
 #include "Engine/Airspace/AirspaceWarningConfig.hpp"
 
-class AirspaceLabelListCompare {
-  const AirspaceWarningConfig &config;
+#include <algorithm>
 
+class AirspaceLabelListCompare {
 public:
-  AirspaceLabelListCompare(const AirspaceWarningConfig &_config)
-    :config(_config) {}
-
-  bool operator() (const AirspaceLabelList::Label &label1,
-                   const AirspaceLabelList::Label &label2) {
-    bool en1 = config.IsClassEnabled(label1.cls);
-    bool en2 = config.IsClassEnabled(label2.cls);
+  bool operator() (const AirspaceLabelList::Label *label1,
+                   const AirspaceLabelList::Label *label2) const noexcept {
+    bool en1 = label1->enabled;
+    bool en2 = label2->enabled;
 
     if(en1 == en2)
-      return AirspaceAltitude::SortHighest(label2.base, label1.base);
+      return AirspaceAltitude::SortHighest(label2->base, label1->base);
     else if(en1)
       return false;
     else
@@ -47,22 +44,71 @@ public:
 };
 
 void
-AirspaceLabelList::Add(const GeoPoint &pos, AirspaceClass cls, 
-                       const AirspaceAltitude &base, const AirspaceAltitude &top)
+AirspaceLabelList::Add(const AbstractAirspace &airspace,
+                       const AirspaceWarningConfig &config) noexcept
 {
-  if (labels.full())
-    return;
+  auto i = labels.find(&airspace);
+  if (i == labels.end()) {
+    if (labels.size() >= MAX_LABELS)
+      return;
+
+    i = labels.try_emplace(&airspace).first;
+
+    auto &label = i->second;
+    label.cls = airspace.GetType();
+    label.pos = airspace.GetCenter();
+    label.base = airspace.GetBase();
+    label.top = airspace.GetTop();
+    label.enabled = config.IsClassEnabled(label.cls);
+    dirty = true;
+  } else {
+    auto &label = i->second;
 
-  auto &label = labels.append();
-  label.cls = cls;
-  label.pos = pos;
-  label.base = base;
-  label.top = top;
+    /* the sort key may change with the QNH or the warning
+       configuration */
+    const bool enabled = config.IsClassEnabled(label.cls);
+    const auto &base = airspace.GetBase();
+    if (enabled != label.enabled || base.altitude != label.base.altitude) {
+      label.enabled = enabled;
+      label.base = base;
+      label.top = airspace.GetTop();
+      label.measured = false;
+      dirty = true;
+    }
+  }
+
+  i->second.generation = generation;
 }
 
 void
-AirspaceLabelList::Sort(const AirspaceWarningConfig &config)
+AirspaceLabelList::EndUpdate() noexcept
 {
-  AirspaceLabelListCompare compare(config);
-  std::sort(labels.begin(), labels.end(), compare);
+  for (auto i = labels.begin(); i != labels.end();) {
+    if (i->second.generation != generation) {
+      i = labels.erase(i);
+      dirty = true;
+    } else
+      ++i;
+  }
+
+  if (!dirty)
+    return;
+
+  dirty = false;
+
+  sorted.clear();
+  sorted.reserve(labels.size());
+  for (auto &i : labels)
+    sorted.push_back(&i.second);
+
+  /* a stable order for labels with the same sort key, to avoid
+     flicker where they overlap */
+  std::sort(sorted.begin(), sorted.end(),
+            [](const Label *a, const Label *b){
+              if (AirspaceLabelListCompare()(a, b))
+                return true;
+              if (AirspaceLabelListCompare()(b, a))
+                return false;
+              return a < b;
+            });
 }
@@ -27,44 +27,118 @@ Copyright_License {
 #include "Engine/Airspace/AirspaceAltitude.hpp"
 #include "Engine/Airspace/AirspaceClass.hpp"
 #include "Geo/GeoPoint.hpp"
+#include "ui/dim/Size.hpp"
 #include "util/NonCopyable.hpp"
-#include "util/StaticArray.hxx"
+#include "util/StaticString.hxx"
 
-struct AirspaceWarningConfig;
+#include <unordered_map>
+#include <vector>
 
+struct AirspaceWarningConfig;
+class AbstractAirspace;
+
+/**
+ * The airspace labels on the map.  The list is kept between frames,
+ * keyed by airspace: only airspaces which enter or leave the view
+ * are added or removed, and the drawing order is recalculated only
+ * after such a change.
+ *
+ * To update the list, call BeginUpdate(), then Add() for each
+ * visible airspace, then EndUpdate().
+ */
 class AirspaceLabelList : private NonCopyable {
 public:
+  static constexpr unsigned MAX_LABELS = 512;
+
   struct Label {
     GeoPoint pos;
     AirspaceClass cls;
     AirspaceAltitude base;
     AirspaceAltitude top;
+
+    /**
+     * Is the airspace class enabled in the warning configuration?
+     * This is part of the drawing order.
+     */
+    bool enabled;
+
+    /**
+     * Have #top_text, #base_text and their sizes been calculated?
+     */
+    bool measured = false;
+
+    /**
+     * The update generation which has last seen this airspace.
+     */
+    unsigned generation;
+
+    StaticString<32> top_text, base_text;
+    PixelSize top_size, base_size;
   };
 
-protected:
-  StaticArray<Label, 512u> labels;
+private:
+  std::unordered_map<const AbstractAirspace *, Label> labels;
+
+  /**
+   * Pointers into #labels in drawing order.
+   */
+  std::vector<Label *> sorted;
+
+  unsigned generation = 0;
+
+  /**
+   * Has a label been added or removed, or has its sort key changed
+   * since #sorted was calculated?
+   */
+  bool dirty = false;
 
 public:
-  AirspaceLabelList() {}
+  void BeginUpdate() noexcept {
+    ++generation;
+  }
+
+  /**
+   * Mark the specified airspace as visible.  Its label is created if
+   * it was not visible in the previous update.
+   */
+  void Add(const AbstractAirspace &airspace,
+           const AirspaceWarningConfig &config) noexcept;
 
-  void Add(const GeoPoint &pos, AirspaceClass cls, const AirspaceAltitude &base,
-           const AirspaceAltitude &top);
-  void Sort(const AirspaceWarningConfig &config);
+  /**
+   * Remove the labels of all airspaces which were not passed to
+   * Add() since BeginUpdate(), and sort the list if it has changed.
+   */
+  void EndUpdate() noexcept;
 
-  void Clear() {
+  void Clear() noexcept {
     labels.clear();
+    sorted.clear();
+    dirty = false;
   }
 
-  auto begin() const noexcept {
-    return labels.begin();
+  /**
+   * Discard the formatted texts, e.g. because the font or the units
+   * have changed.
+   */
+  void ClearText() noexcept {
+    for (auto &i : labels)
+      i.second.measured = false;
   }
 
-  auto end() const noexcept {
-    return labels.end();
+  std::size_t size() const noexcept {
+    return sorted.size();
   }
 
-  const Label &operator[](unsigned i) const {
-    return labels[i];
+  /**
+   * Iterate over pointers to the labels in drawing order.  The
+   * caller may store the formatted texts in them.
+   */
+  auto begin() const noexcept {
+    return sorted.begin();
+  }
+
+  auto end() const noexcept {
+    return sorted.end();
   }
 };
 
@@ -31,10 +31,10 @@ Copyright_License {
 #include "Airspace/AirspaceVisibility.hpp"
 #include "Airspace/AirspaceWarningCopy.hpp"
 #include "Formatter/AirspaceFormatter.hpp"
+#include "Units/Units.hpp"
 #include "NMEA/Aircraft.hpp"
 #include "ui/canvas/Canvas.hpp"
 #include "Screen/Layout.hpp"
-#include "Sizes.h"
 
 class AirspaceMapVisible
 {
@@ -96,69 +96,88 @@ AirspaceLabelRenderer::DrawInternal(Canvas &canvas,
                                     AirspacePredicate visible,
                                     const AirspaceWarningConfig &config)
 {
-  AirspaceLabelList labels;
+  if (settings.label_selection != AirspaceRendererSettings::LabelSelection::ALL)
+    return;
+
+  if (labels_serial != airspaces->GetSerial()) {
+    /* the database has changed; the cached airspace pointers may be
+       dangling */
+    labels.Clear();
+    labels_serial = airspaces->GetSerial();
+  }
+
+  labels.BeginUpdate();
   for (const auto &i : airspaces->QueryWithinRange(projection.GetGeoScreenCenter(),
                                                    projection.GetScreenDistanceMeters())) {
     const AbstractAirspace &airspace = i.GetAirspace();
     if (visible(airspace))
-      labels.Add(airspace.GetCenter(), airspace.GetType(), airspace.GetBase(),
-                 airspace.GetTop());
+      labels.Add(airspace, config);
+  }
+
+  labels.EndUpdate();
+
+  if (look.name_font->GetHeight() != labels_font_height ||
+      Units::GetUserAltitudeUnit() != labels_altitude_unit) {
+    labels.ClearText();
+    labels_font_height = look.name_font->GetHeight();
+    labels_altitude_unit = Units::GetUserAltitudeUnit();
   }
 
-  if(settings.label_selection == AirspaceRendererSettings::LabelSelection::ALL)
-  {
-    labels.Sort(config);
-
-    // default paint settings
-    canvas.SetTextColor(look.label_text_color);
-    canvas.Select(*look.name_font);
-    canvas.Select(look.label_pen);
-    canvas.Select(look.label_brush);
-    canvas.SetBackgroundTransparent();
-
-    // draw
-    TCHAR topText[NAME_SIZE + 1];
-    TCHAR baseText[NAME_SIZE + 1];
-
-    for (const auto &label : labels) {
-      // size of text
-      AirspaceFormatter::FormatAltitudeShort(topText, label.top, false);
-      PixelSize topSize = canvas.CalcTextSize(topText);
-      AirspaceFormatter::FormatAltitudeShort(baseText, label.base, false);
-      PixelSize baseSize = canvas.CalcTextSize(baseText);
-      const unsigned labelWidth =
-        std::max(topSize.width, baseSize.width) + 2 * Layout::GetTextPadding();
-      const unsigned labelHeight = topSize.height + baseSize.height;
-
-      // box
-      const auto pos = projection.GeoToScreen(label.pos);
-      PixelRect rect;
-      rect.left = pos.x - labelWidth / 2;
-      rect.top = pos.y;
-      rect.right = rect.left + labelWidth;
-      rect.bottom = rect.top + labelHeight;
-      canvas.DrawRectangle(rect);
+  // default paint settings
+  canvas.SetTextColor(look.label_text_color);
+  canvas.Select(*look.name_font);
+  canvas.Select(look.label_pen);
+  canvas.Select(look.label_brush);
+  canvas.SetBackgroundTransparent();
+
+  for (auto *i : labels) {
+    auto &label = *i;
+
+    // size of text
+    if (!label.measured) {
+      AirspaceFormatter::FormatAltitudeShort(label.top_text.buffer(),
+                                             label.top, false);
+      label.top_size = canvas.CalcTextSize(label.top_text.c_str());
+      AirspaceFormatter::FormatAltitudeShort(label.base_text.buffer(),
+                                             label.base, false);
+      label.base_size = canvas.CalcTextSize(label.base_text.c_str());
+      label.measured = true;
+    }
+
+    const PixelSize topSize = label.top_size;
+    const PixelSize baseSize = label.base_size;
+    const unsigned labelWidth =
+      std::max(topSize.width, baseSize.width) + 2 * Layout::GetTextPadding();
+    const unsigned labelHeight = topSize.height + baseSize.height;
+
+    // box
+    const auto pos = projection.GeoToScreen(label.pos);
+    PixelRect rect;
+    rect.left = pos.x - labelWidth / 2;
+    rect.top = pos.y;
+    rect.right = rect.left + labelWidth;
+    rect.bottom = rect.top + labelHeight;
+    canvas.DrawRectangle(rect);
 
 #ifdef USE_GDI
-      canvas.DrawLine(rect.left + Layout::GetTextPadding(),
-                      rect.top + labelHeight / 2,
-                      rect.right - Layout::GetTextPadding(),
-                      rect.top + labelHeight / 2);
+    canvas.DrawLine(rect.left + Layout::GetTextPadding(),
+                    rect.top + labelHeight / 2,
+                    rect.right - Layout::GetTextPadding(),
+                    rect.top + labelHeight / 2);
 #else
-      canvas.DrawHLine(rect.left + Layout::GetTextPadding(),
-                       rect.right - Layout::GetTextPadding(),
-                       rect.top + labelHeight / 2, look.label_pen.GetColor());
+    canvas.DrawHLine(rect.left + Layout::GetTextPadding(),
+                     rect.right - Layout::GetTextPadding(),
+                     rect.top + labelHeight / 2, look.label_pen.GetColor());
 #endif
 
-      // top text
-      canvas.DrawText(rect.GetTopRight().At(-int(Layout::GetTextPadding() + topSize.width),
-                                            0),
-                      topText);
+    // top text
+    canvas.DrawText(rect.GetTopRight().At(-int(Layout::GetTextPadding() + topSize.width),
+                                          0),
+                    label.top_text.c_str());
 
-      // base text
-      canvas.DrawText(rect.GetBottomRight().At(-int(Layout::GetTextPadding() + baseSize.width),
-                                               -(int)baseSize.height),
-                      baseText);
-    }
+    // base text
+    canvas.DrawText(rect.GetBottomRight().At(-int(Layout::GetTextPadding() + baseSize.width),
+                                             -(int)baseSize.height),
+                    label.base_text.c_str());
   }
 }
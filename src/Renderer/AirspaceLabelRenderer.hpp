@@ -24,7 +24,10 @@ Copyright_License {
 #ifndef XCSOAR_AIRSPACE_LABEL_RENDERER_HPP
 #define XCSOAR_AIRSPACE_LABEL_RENDERER_HPP
 
+#include "AirspaceLabelList.hpp"
 #include "Engine/Airspace/Predicate/AirspacePredicate.hpp"
+#include "Units/Unit.hpp"
+#include "util/Serial.hpp"
 #include "util/StaticArray.hxx"
 #include "Geo/GeoPoint.hpp"
 
@@ -52,6 +55,16 @@ class AirspaceLabelRenderer
 
   StaticArray<GeoPoint,32> intersections;
 
+  /**
+   * The labels of the previous frame.  They are updated
+   * incrementally; this is flushed when the airspace database or
+   * (for the texts) the font or the altitude unit changes.
+   */
+  AirspaceLabelList labels;
+  Serial labels_serial;
+  unsigned labels_font_height = 0;
+  Unit labels_altitude_unit = Unit::UNDEFINED;
+
 #ifndef ENABLE_OPENGL
   /**
    * This object caches the airspace fill.  This avoids drawing it
@@ -78,6 +91,7 @@ public:
 
   void SetAirspaces(const Airspaces *_airspaces) {
     airspaces = _airspaces;
+    labels.Clear();
   }
 
   void SetAirspaceWarnings(const ProtectedAirspaceWarningManager *_warning_manager) {
@@ -87,6 +101,7 @@ public:
   void Clear() {
     airspaces = nullptr;
     warning_manager = nullptr;
+    labels.Clear();
   }
 
 private:
@@ -33,22 +33,33 @@ Copyright_License {
 #include "Geo/GeoVector.hpp"
 #include "util/StaticString.hxx"
 
+unsigned
+AirspaceListRenderer::GetPreviewRadius(unsigned line_height) noexcept
+{
+  return line_height / 2 - Layout::GetTextPadding();
+}
+
 static void
 Draw(Canvas &canvas, PixelRect rc,
      const AbstractAirspace &airspace,
      const TCHAR *comment,
      const TwoTextRowsRenderer &row_renderer,
      const AirspaceLook &look,
-     const AirspaceRendererSettings &renderer_settings)
+     const AirspaceRendererSettings &renderer_settings,
+     const AirspacePreviewRenderer::Polygon *preview=nullptr)
 {
   const unsigned padding = Layout::GetTextPadding();
   const unsigned line_height = rc.GetHeight();
 
   const PixelPoint pt(rc.left + line_height / 2,
                       rc.top + line_height / 2);
-  const unsigned radius = line_height / 2 - padding;
-  AirspacePreviewRenderer::Draw(canvas, airspace, pt, radius,
-                                renderer_settings, look);
+  const unsigned radius = AirspaceListRenderer::GetPreviewRadius(line_height);
+  if (preview != nullptr)
+    AirspacePreviewRenderer::Draw(canvas, airspace, pt, radius, *preview,
+                                  renderer_settings, look);
+  else
+    AirspacePreviewRenderer::Draw(canvas, airspace, pt, radius,
+                                  renderer_settings, look);
 
   rc.left += line_height + padding;
 
@@ -75,10 +86,11 @@ AirspaceListRenderer::Draw(Canvas &canvas, const PixelRect rc,
                            const AbstractAirspace &airspace,
                            const TwoTextRowsRenderer &row_renderer,
                            const AirspaceLook &look,
-                           const AirspaceRendererSettings &renderer_settings)
+                           const AirspaceRendererSettings &renderer_settings,
+                           const AirspacePreviewRenderer::Polygon *preview)
 {
   ::Draw(canvas, rc, airspace, AirspaceFormatter::GetClass(airspace),
-         row_renderer, look, renderer_settings);
+         row_renderer, look, renderer_settings, preview);
 }
 
 void
@@ -24,6 +24,8 @@ Copyright_License {
 #ifndef XCSOAR_AIRSPACE_LIST_RENDERER_HPP
 #define XCSOAR_AIRSPACE_LIST_RENDERER_HPP
 
+#include "Renderer/AirspacePreviewRenderer.hpp"
+
 class Canvas;
 class AbstractAirspace;
 class TwoTextRowsRenderer;
@@ -34,15 +36,26 @@ struct AirspaceRendererSettings;
 
 namespace AirspaceListRenderer
 {
+  /**
+   * Returns the radius of the airspace preview drawn in a list item
+   * of the given height.
+   */
+  [[gnu::const]]
+  unsigned GetPreviewRadius(unsigned line_height) noexcept;
+
   /**
    * Draws an airspace list item.
    *
    * Comment is e.g. "Class C"
+   *
+   * @param preview the preview polygon built with the radius
+   * returned by GetPreviewRadius(); nullptr to project it now
    */
   void Draw(Canvas &canvas, const PixelRect rc, const AbstractAirspace &airspace,
             const TwoTextRowsRenderer &row_renderer,
             const AirspaceLook &look,
-            const AirspaceRendererSettings &renderer_settings);
+            const AirspaceRendererSettings &renderer_settings,
+            const AirspacePreviewRenderer::Polygon *preview=nullptr);
 
   /**
    * Draws an airspace list item.
@@ -35,8 +35,7 @@ Copyright_License {
 
 static void
 GetPolygonPoints(std::vector<BulkPixelPoint> &pts,
-                 const AirspacePolygon &airspace,
-                 const PixelPoint pt, unsigned radius)
+                 const AirspacePolygon &airspace, unsigned radius)
 {
   GeoBounds bounds = airspace.GetGeoBounds();
   GeoPoint center = bounds.GetCenter();
@@ -48,7 +47,7 @@ GetPolygonPoints(std::vector<BulkPixelPoint> &pts,
 
   WindowProjection projection;
   projection.SetScreenSize({radius * 2, radius * 2});
-  projection.SetScreenOrigin(pt.x, pt.y);
+  projection.SetScreenOrigin(0, 0);
   projection.SetGeoLocation(center);
   projection.SetScale(radius * 2 / geo_size);
   projection.SetScreenAngle(Angle::Zero());
@@ -56,9 +55,16 @@ GetPolygonPoints(std::vector<BulkPixelPoint> &pts,
 
   const SearchPointVector &border = airspace.GetPoints();
 
+  pts.clear();
   pts.reserve(border.size());
-  for (auto it = border.begin(), it_end = border.end(); it != it_end; ++it)
-    pts.push_back(projection.GeoToScreen(it->GetLocation()));
+  for (auto it = border.begin(), it_end = border.end(); it != it_end; ++it) {
+    const BulkPixelPoint p = projection.GeoToScreen(it->GetLocation());
+
+    /* a preview is only a few dozen pixels wide; most vertices of a
+       detailed border fall onto the same pixel as their predecessor */
+    if (pts.empty() || p.x != pts.back().x || p.y != pts.back().y)
+      pts.push_back(p);
+  }
 }
 
 bool
@@ -141,19 +147,48 @@ DrawShape(Canvas &canvas, AbstractAirspace::Shape shape, const PixelPoint pt,
     canvas.DrawPolygon(&pts[0], (unsigned)pts.size());
 }
 
+void
+AirspacePreviewRenderer::BuildPolygon(Polygon &dest,
+                                      const AbstractAirspace &airspace,
+                                      unsigned radius) noexcept
+{
+  if (airspace.GetShape() == AbstractAirspace::Shape::POLYGON &&
+      !IsAncientHardware())
+    GetPolygonPoints(dest, (const AirspacePolygon &)airspace, radius);
+}
+
 void
 AirspacePreviewRenderer::Draw(Canvas &canvas, const AbstractAirspace &airspace,
                               const PixelPoint pt, unsigned radius,
                               const AirspaceRendererSettings &settings,
                               const AirspaceLook &look)
+{
+  Polygon polygon;
+  BuildPolygon(polygon, airspace, radius);
+  Draw(canvas, airspace, pt, radius, polygon, settings, look);
+}
+
+void
+AirspacePreviewRenderer::Draw(Canvas &canvas, const AbstractAirspace &airspace,
+                              const PixelPoint pt, unsigned radius,
+                              const Polygon &polygon,
+                              const AirspaceRendererSettings &settings,
+                              const AirspaceLook &look)
 {
   AbstractAirspace::Shape shape = airspace.GetShape();
   AirspaceClass type = airspace.GetType();
 
   // Container for storing the points of a polygon airspace
   std::vector<BulkPixelPoint> pts;
-  if (shape == AbstractAirspace::Shape::POLYGON && !IsAncientHardware())
-    GetPolygonPoints(pts, (const AirspacePolygon &)airspace, pt, radius);
+  if (shape == AbstractAirspace::Shape::POLYGON && !IsAncientHardware()) {
+    pts.reserve(polygon.size());
+    for (const auto &p : polygon) {
+      BulkPixelPoint q = p;
+      q.x += pt.x;
+      q.y += pt.y;
+      pts.push_back(q);
+    }
+  }
 
   if (PrepareFill(canvas, type, look, settings)) {
     DrawShape(canvas, shape, pt, radius, pts);
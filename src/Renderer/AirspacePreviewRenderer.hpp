@@ -25,6 +25,9 @@ Copyright_License {
 #define XCSOAR_AIRSPACE_PREVIEW_RENDERER_HPP
 
 #include "Engine/Airspace/AirspaceClass.hpp"
+#include "ui/dim/BulkPoint.hpp"
+
+#include <vector>
 
 struct PixelPoint;
 class Canvas;
@@ -44,11 +47,36 @@ namespace AirspacePreviewRenderer
                       const AirspaceLook &look,
                       const AirspaceRendererSettings &settings);
 
+  /**
+   * The outline of a polygon airspace, projected to a preview of a
+   * given radius around (0,0).  Projecting a large polygon is
+   * expensive, therefore lists may build it once (when the item
+   * scrolls into view) and reuse it for each repaint.
+   */
+  using Polygon = std::vector<BulkPixelPoint>;
+
+  /**
+   * Project the outline of the given airspace for Draw().  Does
+   * nothing if the airspace is not a polygon.
+   */
+  void BuildPolygon(Polygon &dest, const AbstractAirspace &airspace,
+                    unsigned radius) noexcept;
+
   /** Draw a scaled preview of the given airspace */
   void Draw(Canvas &canvas, const AbstractAirspace &airspace,
             const PixelPoint pt, unsigned radius,
             const AirspaceRendererSettings &settings,
             const AirspaceLook &look);
+
+  /**
+   * Draw a scaled preview of the given airspace, using a #Polygon
+   * which was built by BuildPolygon() with the same radius.
+   */
+  void Draw(Canvas &canvas, const AbstractAirspace &airspace,
+            const PixelPoint pt, unsigned radius,
+            const Polygon &polygon,
+            const AirspaceRendererSettings &settings,
+            const AirspaceLook &look);
 }
 
 #endif
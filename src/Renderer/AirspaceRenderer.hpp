@@ -28,7 +28,9 @@ Copyright_License {
 #include "util/StaticArray.hxx"
 #include "Geo/GeoPoint.hpp"
 
-#ifndef ENABLE_OPENGL
+#ifdef ENABLE_OPENGL
+#include "AirspaceVertexCache.hpp"
+#else
 #include "TransparentRendererCache.hpp"
 #endif
 
@@ -52,7 +54,13 @@ class AirspaceRenderer
 
   StaticArray<GeoPoint,32> intersections;
 
-#ifndef ENABLE_OPENGL
+#ifdef ENABLE_OPENGL
+  /**
+   * The polygon vertices in OpenGL buffers; they are projected by
+   * the vertex shader.
+   */
+  AirspaceVertexCache vertex_cache;
+#else
   /**
    * This object caches the airspace fill.  This avoids drawing it
    * again and again each frame when nothing has changed.
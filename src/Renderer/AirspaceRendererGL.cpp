@@ -25,6 +25,7 @@ Copyright_License {
 
 #include "AirspaceRenderer.hpp"
 #include "AirspaceRendererSettings.hpp"
+#include "AirspaceVertexCache.hpp"
 #include "Projection/WindowProjection.hpp"
 #include "ui/canvas/Canvas.hpp"
 #include "MapWindow/MapCanvas.hpp"
@@ -42,15 +43,24 @@ class AirspaceVisitorRenderer final
   const AirspaceLook &look;
   const AirspaceWarningCopy &warning_manager;
   const AirspaceRendererSettings &settings;
+  const AirspaceVertexCache &vertex_cache;
+
+  /**
+   * The cached vertices of the current polygon; nullptr if it was
+   * prepared with MapCanvas::PreparePolygon().
+   */
+  const AirspaceVertexCache::Shape *shape;
 
 public:
   AirspaceVisitorRenderer(Canvas &_canvas, const WindowProjection &_projection,
                           const AirspaceLook &_look,
                           const AirspaceWarningCopy &_warnings,
-                          const AirspaceRendererSettings &_settings)
+                          const AirspaceRendererSettings &_settings,
+                          const AirspaceVertexCache &_vertex_cache)
     :MapCanvas(_canvas, _projection,
                _projection.GetScreenBounds().Scale(1.1)),
-     look(_look), warning_manager(_warnings), settings(_settings)
+     look(_look), warning_manager(_warnings), settings(_settings),
+     vertex_cache(_vertex_cache)
   {
     glStencilMask(0xff);
     glClear(GL_STENCIL_BUFFER_BIT);
@@ -100,7 +110,8 @@ private:
   }
 
   void VisitPolygon(const AirspacePolygon &airspace) {
-    if (!PreparePolygon(airspace.GetPoints()))
+    shape = vertex_cache.Find(airspace);
+    if (shape == nullptr && !PreparePolygon(airspace.GetPoints()))
       return;
 
     const AirspaceClassRendererSettings &class_settings =
@@ -119,7 +130,7 @@ private:
       if (!fill_airspace) {
         // set stencil for filling (bit 0)
         SetFillStencil();
-        DrawPrepared();
+        DrawShape();
         glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
       }
 
@@ -127,20 +138,20 @@ private:
       {
         SetupInterior(airspace, !fill_airspace);
         const GLEnable<GL_BLEND> blend;
-        DrawPrepared();
+        DrawShape();
       }
 
       if (!fill_airspace) {
         // clear fill stencil (bit 0)
         ClearFillStencil();
-        DrawPrepared();
+        DrawShape();
         glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
       }
     }
 
     // draw outline
     if (SetupOutline(airspace))
-      DrawPrepared();
+      DrawShape();
   }
 
 public:
@@ -157,6 +168,13 @@ public:
   }
 
 private:
+  void DrawShape() {
+    if (shape != nullptr)
+      vertex_cache.Draw(canvas, *shape);
+    else
+      DrawPrepared();
+  }
+
   bool SetupOutline(const AbstractAirspace &airspace) {
     AirspaceClass type = airspace.GetType();
 
@@ -220,15 +238,24 @@ class AirspaceFillRenderer final
   const AirspaceLook &look;
   const AirspaceWarningCopy &warning_manager;
   const AirspaceRendererSettings &settings;
+  const AirspaceVertexCache &vertex_cache;
+
+  /**
+   * The cached vertices of the current polygon; nullptr if it was
+   * prepared with MapCanvas::PreparePolygon().
+   */
+  const AirspaceVertexCache::Shape *shape;
 
 public:
   AirspaceFillRenderer(Canvas &_canvas, const WindowProjection &_projection,
                        const AirspaceLook &_look,
                        const AirspaceWarningCopy &_warnings,
-                       const AirspaceRendererSettings &_settings)
+                       const AirspaceRendererSettings &_settings,
+                       const AirspaceVertexCache &_vertex_cache)
     :MapCanvas(_canvas, _projection,
                _projection.GetScreenBounds().Scale(1.1)),
-     look(_look), warning_manager(_warnings), settings(_settings)
+     look(_look), warning_manager(_warnings), settings(_settings),
+     vertex_cache(_vertex_cache)
   {
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
   }
@@ -249,18 +276,19 @@ private:
   }
 
   void VisitPolygon(const AirspacePolygon &airspace) {
-    if (!PreparePolygon(airspace.GetPoints()))
+    shape = vertex_cache.Find(airspace);
+    if (shape == nullptr && !PreparePolygon(airspace.GetPoints()))
       return;
 
     if (!warning_manager.IsAcked(airspace) && SetupInterior(airspace)) {
       // fill interior without overpainting any previous outlines
       GLEnable<GL_BLEND> blend;
-      DrawPrepared();
+      DrawShape();
     }
 
     // draw outline
     if (SetupOutline(airspace))
-      DrawPrepared();
+      DrawShape();
   }
 
 public:
@@ -277,6 +305,13 @@ public:
   }
 
 private:
+  void DrawShape() {
+    if (shape != nullptr)
+      vertex_cache.Draw(canvas, *shape);
+    else
+      DrawPrepared();
+  }
+
   bool SetupOutline(const AbstractAirspace &airspace) {
     AirspaceClass type = airspace.GetType();
 
@@ -313,20 +348,25 @@ AirspaceRenderer::DrawInternal(Canvas &canvas,
                                const AirspaceWarningCopy &awc,
                                const AirspacePredicate &visible)
 {
+  vertex_cache.Update(*airspaces);
+  vertex_cache.SetProjection(projection);
+
   const auto range =
     airspaces->QueryWithinRange(projection.GetGeoScreenCenter(),
                                 projection.GetScreenDistanceMeters());
 
   if (settings.fill_mode == AirspaceRendererSettings::FillMode::ALL ||
       settings.fill_mode == AirspaceRendererSettings::FillMode::NONE) {
-    AirspaceFillRenderer renderer(canvas, projection, look, awc, settings);
+    AirspaceFillRenderer renderer(canvas, projection, look, awc, settings,
+                                  vertex_cache);
     for (const auto &i : range) {
       const AbstractAirspace &airspace = i.GetAirspace();
       if (visible(airspace))
         renderer.Visit(airspace);
     }
   } else {
-    AirspaceVisitorRenderer renderer(canvas, projection, look, awc, settings);
+    AirspaceVisitorRenderer renderer(canvas, projection, look, awc, settings,
+                                     vertex_cache);
     for (const auto &i : range) {
       const AbstractAirspace &airspace = i.GetAirspace();
       if (visible(airspace))
@@ -0,0 +1,137 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifdef ENABLE_OPENGL
+
+#include "AirspaceVertexCache.hpp"
+#include "Airspace/Airspaces.hpp"
+#include "Airspace/AirspacePolygon.hpp"
+#include "Projection/WindowProjection.hpp"
+#include "ui/canvas/Canvas.hpp"
+#include "ui/canvas/opengl/Buffer.hpp"
+#include "ui/canvas/opengl/Geo.hpp"
+#include "ui/canvas/opengl/Triangulate.hpp"
+#include "Math/Point2D.hpp"
+
+#include <vector>
+
+AirspaceVertexCache::~AirspaceVertexCache() noexcept
+{
+  delete index_buffer;
+  delete vertex_buffer;
+}
+
+void
+AirspaceVertexCache::Update(const Airspaces &_airspaces) noexcept
+{
+  if (vertex_buffer == nullptr) {
+    vertex_buffer = new GLArrayBuffer();
+    index_buffer = new GLElementArrayBuffer();
+  } else if (&_airspaces == airspaces && _airspaces.GetSerial() == serial)
+    return;
+
+  airspaces = &_airspaces;
+  serial = _airspaces.GetSerial();
+
+  shapes.clear();
+
+  /* the projection center of the airspace database is close to all
+     airspaces, which keeps the float coordinates precise */
+  reference = _airspaces.GetProjection().IsValid()
+    ? _airspaces.GetProjection().GetCenter()
+    : GeoPoint::Zero();
+
+  std::vector<FloatPoint2D> vertices;
+  std::vector<GLushort> indices;
+
+  for (const auto &i : _airspaces.QueryAll()) {
+    const AbstractAirspace &airspace = i.GetAirspace();
+    if (airspace.GetShape() != AbstractAirspace::Shape::POLYGON)
+      continue;
+
+    const auto &points = airspace.GetPoints();
+    const unsigned n = points.size();
+    if (n < 3 || n >= 0x10000)
+      /* too large for GLushort indices; drawn by the CPU path */
+      continue;
+
+    Shape shape;
+    shape.vertex_offset = vertices.size();
+    shape.n_vertices = n;
+    shape.index_offset = indices.size();
+
+    for (const auto &p : points) {
+      const GeoPoint relative = p.GetLocation() - reference;
+      vertices.emplace_back(float(relative.longitude.Native()),
+                            float(relative.latitude.Native()));
+    }
+
+    indices.resize(shape.index_offset + 3 * (n - 2));
+    shape.n_indices =
+      PolygonToTriangles(vertices.data() + shape.vertex_offset, n,
+                         indices.data() + shape.index_offset, 0);
+    indices.resize(shape.index_offset + shape.n_indices);
+
+    shapes.emplace(&airspace, shape);
+  }
+
+  vertex_buffer->Load(vertices.size() * sizeof(vertices.front()),
+                      vertices.data());
+
+  index_buffer->Bind();
+  GLElementArrayBuffer::Data(indices.size() * sizeof(indices.front()),
+                             indices.data());
+  GLElementArrayBuffer::Unbind();
+}
+
+void
+AirspaceVertexCache::SetProjection(const WindowProjection &projection) noexcept
+{
+  modelview = ToGLM(projection, reference);
+}
+
+const AirspaceVertexCache::Shape *
+AirspaceVertexCache::Find(const AirspacePolygon &airspace) const noexcept
+{
+  const auto i = shapes.find(&airspace);
+  return i != shapes.end() ? &i->second : nullptr;
+}
+
+void
+AirspaceVertexCache::Draw(Canvas &canvas, const Shape &shape) const noexcept
+{
+  const FloatPoint2D *const vertices = nullptr;
+  const GLushort *const indices = nullptr;
+
+  vertex_buffer->Bind();
+  index_buffer->Bind();
+
+  canvas.DrawPolygonBuffer(modelview,
+                           vertices + shape.vertex_offset, shape.n_vertices,
+                           indices + shape.index_offset, shape.n_indices);
+
+  GLElementArrayBuffer::Unbind();
+  GLArrayBuffer::Unbind();
+}
+
+#endif /* ENABLE_OPENGL */
@@ -0,0 +1,117 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_AIRSPACE_VERTEX_CACHE_HPP
+#define XCSOAR_AIRSPACE_VERTEX_CACHE_HPP
+
+#include "util/Serial.hpp"
+#include "Geo/GeoPoint.hpp"
+
+#include <glm/mat4x4.hpp>
+
+#include <unordered_map>
+
+class Airspaces;
+class AbstractAirspace;
+class AirspacePolygon;
+class Canvas;
+class WindowProjection;
+class GLArrayBuffer;
+class GLElementArrayBuffer;
+
+/**
+ * Keeps the vertices of all #AirspacePolygon objects of an
+ * #Airspaces instance in OpenGL buffers, in geographic coordinates
+ * relative to a reference point.  The vertex shader projects them
+ * to the screen, so panning and zooming doesn't need to touch them;
+ * the buffers are rebuilt only when the airspace set changes.
+ */
+class AirspaceVertexCache {
+public:
+  struct Shape {
+    /**
+     * The offset of the first vertex in #vertex_buffer.
+     */
+    unsigned vertex_offset;
+    unsigned n_vertices;
+
+    /**
+     * The offset of the first triangle index in #index_buffer.
+     * Indices are relative to #vertex_offset.
+     */
+    unsigned index_offset;
+    unsigned n_indices;
+  };
+
+private:
+  GLArrayBuffer *vertex_buffer = nullptr;
+  GLElementArrayBuffer *index_buffer = nullptr;
+
+  const Airspaces *airspaces = nullptr;
+  Serial serial;
+
+  GeoPoint reference;
+
+  std::unordered_map<const AbstractAirspace *, Shape> shapes;
+
+  /**
+   * The modelview matrix for the current frame, see SetProjection().
+   */
+  glm::mat4 modelview;
+
+public:
+  AirspaceVertexCache() noexcept = default;
+  ~AirspaceVertexCache() noexcept;
+
+  AirspaceVertexCache(const AirspaceVertexCache &) = delete;
+  AirspaceVertexCache &operator=(const AirspaceVertexCache &) = delete;
+
+  /**
+   * Rebuild the buffers if the given #Airspaces instance or its
+   * contents have changed since the last call.
+   */
+  void Update(const Airspaces &airspaces) noexcept;
+
+  /**
+   * Calculate the modelview matrix for drawing with the given
+   * projection.
+   */
+  void SetProjection(const WindowProjection &projection) noexcept;
+
+  /**
+   * Look up the given polygon in the buffers.
+   *
+   * @return nullptr if the polygon is not cached (e.g. because it is
+   * too large for 16 bit indices)
+   */
+  [[gnu::pure]]
+  const Shape *Find(const AirspacePolygon &airspace) const noexcept;
+
+  /**
+   * Draw the shape with the pen and brush currently selected in the
+   * #Canvas.
+   */
+  void Draw(Canvas &canvas, const Shape &shape) const noexcept;
+};
+
+#endif
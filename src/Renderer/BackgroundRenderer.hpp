@@ -44,6 +44,7 @@ class BackgroundRenderer {
   const RasterTerrain *terrain = nullptr;
   std::unique_ptr<TerrainRenderer> renderer;
   Angle shading_angle = DEFAULT_SHADING_ANGLE;
+  bool power_saving = false;
 
 public:
   BackgroundRenderer();
@@ -62,8 +63,19 @@ public:
   void SetShadingAngle(const WindowProjection &projection,
                        const TerrainRendererSettings &settings,
                        const DerivedInfo &calculated);
+
+  Angle GetShadingAngle() const noexcept {
+    return shading_angle;
+  }
   void SetTerrain(const RasterTerrain *terrain);
 
+  /**
+   * @see TerrainRenderer::SetPowerSaving()
+   */
+  void SetPowerSaving(bool _power_saving) {
+    power_saving = _power_saving;
+  }
+
 private:
   void SetShadingAngle(const WindowProjection& proj, Angle angle);
 };
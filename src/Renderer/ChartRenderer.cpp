@@ -32,6 +32,7 @@ Copyright_License {
 #include "util/TruncateString.hpp"
 #include "util/ConstBuffer.hxx"
 
+#include <algorithm>
 #include <cassert>
 
 #ifdef ENABLE_OPENGL
@@ -356,11 +357,65 @@ ChartRenderer::DrawBarChart(const XYDataStore &lsdata) noexcept
   }
 }
 
+/**
+ * Collapse each run of consecutive points in the same pixel column
+ * (pixel row if #swap is set) to the first point, the two extremes
+ * and the last point.  The polyline looks the same, but the number
+ * of vertices is bounded by the chart size instead of the number of
+ * samples.
+ *
+ * @return the new end
+ */
+static BulkPixelPoint *
+DecimateColumns(BulkPixelPoint *begin, BulkPixelPoint *end,
+                bool swap) noexcept
+{
+  const auto column = [swap](const BulkPixelPoint &p){
+    return swap ? p.y : p.x;
+  };
+
+  const auto less_value = [swap](const BulkPixelPoint &a,
+                                 const BulkPixelPoint &b){
+    return swap ? a.x < b.x : a.y < b.y;
+  };
+
+  BulkPixelPoint *dest = begin;
+  for (BulkPixelPoint *i = begin; i != end;) {
+    const auto c = column(*i);
+    BulkPixelPoint *run_end = std::find_if(i + 1, end,
+                                           [&](const BulkPixelPoint &p){
+                                             return column(p) != c;
+                                           });
+
+    if (run_end - i <= 4) {
+      while (i != run_end)
+        *dest++ = *i++;
+      continue;
+    }
+
+    const auto [lo, hi] = std::minmax_element(i, run_end, less_value);
+    const BulkPixelPoint first = *i, last = run_end[-1];
+    BulkPixelPoint a = *lo, b = *hi;
+    if (hi < lo)
+      std::swap(a, b);
+
+    *dest++ = first;
+    *dest++ = a;
+    *dest++ = b;
+    *dest++ = last;
+    i = run_end;
+  }
+
+  return dest;
+}
+
 template<typename T>
 static BulkPixelPoint *
 PrepareLineGraph(BulkPixelPoint *p, ConstBuffer<T> src,
                  const ChartRenderer &chart, bool swap) noexcept
 {
+  BulkPixelPoint *const begin = p;
+
   if (swap) {
     for (const auto &i : src)
       *p++ = chart.ToScreen(i.y, i.x);
@@ -369,7 +424,7 @@ PrepareLineGraph(BulkPixelPoint *p, ConstBuffer<T> src,
       *p++ = chart.ToScreen(i.x, i.y);
   }
 
-  return p;
+  return DecimateColumns(begin, p, swap);
 }
 
 template<typename T>
@@ -398,14 +453,10 @@ void
 ChartRenderer::DrawFilledLineGraph(ConstBuffer<DoublePoint2D> src,
                                    bool swap) noexcept
 {
-  const unsigned n = src.size + 2;
-  auto *points = point_buffer.get(n);
+  auto *points = point_buffer.get(src.size + 2);
+  auto *p = PrepareFilledLineGraph(points, src, *this, swap);
 
-  [[maybe_unused]] auto *p =
-    PrepareFilledLineGraph(points, src, *this, swap);
-  assert(p == points + n);
-
-  canvas.DrawPolygon(points, n);
+  canvas.DrawPolygon(points, p - points);
 }
 
 void
@@ -414,15 +465,11 @@ ChartRenderer::DrawLineGraph(ConstBuffer<DoublePoint2D> src,
 {
   assert(src.size >= 2);
 
-  const unsigned n = src.size;
-  auto *points = point_buffer.get(n);
-
-  [[maybe_unused]] auto *p =
-    PrepareLineGraph(points, src, *this, swap);
-  assert(p == points + n);
+  auto *points = point_buffer.get(src.size);
+  auto *p = PrepareLineGraph(points, src, *this, swap);
 
   canvas.Select(pen);
-  canvas.DrawPolyline(points, n);
+  canvas.DrawPolyline(points, p - points);
 }
 
 void
@@ -439,14 +486,10 @@ ChartRenderer::DrawFilledLineGraph(const XYDataStore &lsdata,
   const auto slots = lsdata.GetSlots();
   assert(slots.size >= 2);
 
-  const unsigned n = slots.size + 2;
-  auto *points = point_buffer.get(n);
+  auto *points = point_buffer.get(slots.size + 2);
+  auto *p = PrepareFilledLineGraph(points, slots, *this, swap);
 
-  [[maybe_unused]] auto *p =
-    PrepareFilledLineGraph(points, slots, *this, swap);
-  assert(p == points + n);
-
-  canvas.DrawPolygon(points, n);
+  canvas.DrawPolygon(points, p - points);
 }
 
 void
@@ -456,15 +499,11 @@ ChartRenderer::DrawLineGraph(const XYDataStore &lsdata, const Pen &pen,
   const auto slots = lsdata.GetSlots();
   assert(slots.size >= 2);
 
-  const unsigned n = slots.size;
-  auto *points = point_buffer.get(n);
-
-  [[maybe_unused]] auto *p =
-    PrepareLineGraph(points, slots, *this, swap);
-  assert(p == points + n);
+  auto *points = point_buffer.get(slots.size);
+  auto *p = PrepareLineGraph(points, slots, *this, swap);
 
   canvas.Select(pen);
-  canvas.DrawPolyline(points, n);
+  canvas.DrawPolyline(points, p - points);
 }
 
 void
@@ -23,24 +23,92 @@ Copyright_License {
 
 #include "FAITriangleAreaRenderer.hpp"
 #include "Engine/Task/Shapes/FAITriangleArea.hpp"
+#include "Engine/Task/Shapes/FAITriangleSettings.hpp"
 #include "Geo/GeoPoint.hpp"
 #include "Geo/GeoClip.hpp"
 #include "Projection/WindowProjection.hpp"
 #include "ui/canvas/Canvas.hpp"
+#include "thread/Mutex.hxx"
+#include "util/Cache.hxx"
+#include "util/StaticArray.hxx"
+
+#include <functional>
+
+namespace {
+
+struct FAISectorKey {
+  GeoPoint pt1, pt2;
+  bool reverse;
+  FAITriangleSettings::Threshold threshold;
+
+  FAISectorKey(const GeoPoint &_pt1, const GeoPoint &_pt2, bool _reverse,
+               const FAITriangleSettings &settings) noexcept
+    :pt1(_pt1), pt2(_pt2), reverse(_reverse),
+     threshold(settings.threshold) {}
+
+  constexpr bool operator==(const FAISectorKey &other) const noexcept {
+    return pt1 == other.pt1 && pt2 == other.pt2 &&
+      reverse == other.reverse && threshold == other.threshold;
+  }
+
+  struct Hash {
+    [[gnu::pure]]
+    std::size_t operator()(const FAISectorKey &key) const noexcept {
+      const std::hash<double> h;
+      return h(key.pt1.latitude.Native()) ^
+        (h(key.pt1.longitude.Native()) * 3u) ^
+        (h(key.pt2.latitude.Native()) * 7u) ^
+        (h(key.pt2.longitude.Native()) * 11u) ^
+        (std::size_t(key.reverse) << 1) ^
+        std::size_t(key.threshold);
+    }
+  };
+};
+
+using FAISector = StaticArray<GeoPoint, FAI_TRIANGLE_SECTOR_MAX>;
+
+}
+
+/**
+ * Generated FAI sectors in geographic coordinates.  They depend only
+ * on the two task points, which change rarely, but generating them
+ * is expensive (see BenchmarkFAITriangleSector), so they are not
+ * regenerated for every frame.  A task edit changes the key, and the
+ * old sectors fall out of the cache eventually.
+ *
+ * Both the map (draw thread) and the task dialogs (main thread) draw
+ * FAI sectors; #fai_sector_mutex protects the cache.
+ */
+static Cache<FAISectorKey, FAISector, 16u, 31u,
+             FAISectorKey::Hash> fai_sector_cache;
+static Mutex fai_sector_mutex;
 
 void
 RenderFAISector(Canvas &canvas, const WindowProjection &projection,
                 const GeoPoint &pt1, const GeoPoint &pt2,
                 bool reverse, const FAITriangleSettings &settings)
 {
-  GeoPoint geo_points[FAI_TRIANGLE_SECTOR_MAX];
-  GeoPoint *geo_end = GenerateFAITriangleArea(geo_points, pt1, pt2,
-                                              reverse, settings);
-
-  GeoPoint clipped[FAI_TRIANGLE_SECTOR_MAX * 3],
-    *clipped_end = clipped +
-    GeoClip(projection.GetScreenBounds().Scale(1.1))
-    .ClipPolygon(clipped, geo_points, geo_end - geo_points);
+  const FAISectorKey key(pt1, pt2, reverse, settings);
+
+  GeoPoint clipped[FAI_TRIANGLE_SECTOR_MAX * 3], *clipped_end;
+
+  {
+    const std::lock_guard<Mutex> lock(fai_sector_mutex);
+
+    const FAISector *sector = fai_sector_cache.Get(key);
+    if (sector == nullptr) {
+      FAISector geo_points;
+      GeoPoint *geo_end = GenerateFAITriangleArea(geo_points.data(),
+                                                  pt1, pt2,
+                                                  reverse, settings);
+      geo_points.resize(geo_end - geo_points.data());
+      sector = &fai_sector_cache.Put(key, geo_points);
+    }
+
+    clipped_end = clipped +
+      GeoClip(projection.GetScreenBounds().Scale(1.1))
+      .ClipPolygon(clipped, sector->data(), sector->size());
+  }
 
   BulkPixelPoint points[FAI_TRIANGLE_SECTOR_MAX], *p = points;
   for (GeoPoint *geo_i = clipped; geo_i != clipped_end;)
@@ -22,7 +22,6 @@ Copyright_License {
 */
 
 #include "GeoBitmapRenderer.hpp"
-#include "ui/canvas/RawBitmap.hpp"
 #include "Geo/GeoBounds.hpp"
 #include "Projection/Projection.hpp"
 
@@ -30,14 +29,13 @@ Copyright_License {
 #include "ui/canvas/opengl/Texture.hpp"
 #include "ui/canvas/opengl/Scope.hpp"
 #include "ui/canvas/opengl/VertexPointer.hpp"
-#include "ui/canvas/opengl/Shaders.hpp"
-#include "ui/canvas/opengl/Program.hpp"
+#include "ui/canvas/opengl/Statistics.hpp"
 #include "ui/dim/BulkPoint.hpp"
 
 void
-DrawGeoBitmap(const RawBitmap &bitmap, PixelSize bitmap_size,
-              const GeoBounds &bounds,
-              const Projection &projection)
+DrawGeoTexture(const GLTexture &texture, PixelSize texture_size,
+               const GeoBounds &bounds,
+               const Projection &projection)
 {
   assert(bounds.IsValid());
 
@@ -50,11 +48,10 @@ DrawGeoBitmap(const RawBitmap &bitmap, PixelSize bitmap_size,
 
   const ScopeVertexPointer vp(vertices);
 
-  const GLTexture &texture = bitmap.BindAndGetTexture();
   const PixelSize allocated = texture.GetAllocatedSize();
 
-  const GLfloat src_x = 0, src_y = 0, src_width = bitmap_size.width,
-    src_height = bitmap_size.height;
+  const GLfloat src_x = 0, src_y = 0, src_width = texture_size.width,
+    src_height = texture_size.height;
 
   GLfloat x0 = src_x / allocated.width;
   GLfloat y0 = src_y / allocated.height;
@@ -68,15 +65,13 @@ DrawGeoBitmap(const RawBitmap &bitmap, PixelSize bitmap_size,
     x1, y1,
   };
 
-  OpenGL::texture_shader->Use();
   glEnableVertexAttribArray(OpenGL::Attribute::TEXCOORD);
   glVertexAttribPointer(OpenGL::Attribute::TEXCOORD, 2, GL_FLOAT, GL_FALSE,
                         0, coord);
 
-  glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+  OpenGL::DrawArrays(GL_TRIANGLE_STRIP, 0, 4);
 
   glDisableVertexAttribArray(OpenGL::Attribute::TEXCOORD);
-  OpenGL::solid_shader->Use();
 }
 
 #endif
@@ -25,24 +25,27 @@ Copyright_License {
 #define XCSOAR_GEO_BITMAP_RENDERER_HPP
 
 struct PixelSize;
-class RawBitmap;
 class GeoBounds;
 class Projection;
 
 #ifdef ENABLE_OPENGL
 
+class GLTexture;
+
 /**
- * Draw an opaque georeferenced bitmap to the current OpenGL context.
+ * Draw a georeferenced texture to the current OpenGL context.  The
+ * caller is responsible for binding the texture and for selecting a
+ * shader which uses #OpenGL::Attribute::TEXCOORD.
  *
- * @param bitmap_size use this size instead of #GLTexture::GetSize()
- * @param bounds #RawBitmap's geo reference
+ * @param texture_size use this size instead of #GLTexture::GetSize()
+ * @param bounds the texture's geo reference
  * @param project a projection used to translate GeoPoints to screen
  * coordinates
  */
 void
-DrawGeoBitmap(const RawBitmap &bitmap, PixelSize bitmap_size,
-              const GeoBounds &bounds,
-              const Projection &projection);
+DrawGeoTexture(const GLTexture &texture, PixelSize texture_size,
+               const GeoBounds &bounds,
+               const Projection &projection);
 
 #endif
 
@@ -28,6 +28,7 @@ Copyright_License {
 
 #include "ui/canvas/opengl/Scissor.hpp"
 #include "ui/canvas/opengl/VertexPointer.hpp"
+#include "ui/canvas/opengl/Statistics.hpp"
 #include "util/Macros.hpp"
 
 #include <algorithm>
@@ -70,6 +71,6 @@ DrawGlassBackground(Canvas &canvas, const PixelRect &rc, Color color)
   static_assert(ARRAY_SIZE(vertices) == ARRAY_SIZE(colors),
                 "Array size mismatch");
 
-  glDrawArrays(GL_TRIANGLE_STRIP, 0, ARRAY_SIZE(vertices));
+  OpenGL::DrawArrays(GL_TRIANGLE_STRIP, 0, ARRAY_SIZE(vertices));
 #endif
 }
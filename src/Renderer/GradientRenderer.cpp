@@ -27,6 +27,7 @@ Copyright_License {
 #if defined(EYE_CANDY) && defined(ENABLE_OPENGL)
 
 #include "ui/canvas/opengl/VertexPointer.hpp"
+#include "ui/canvas/opengl/Statistics.hpp"
 #include "util/Macros.hpp"
 
 #endif
@@ -57,7 +58,7 @@ DrawVerticalGradient(Canvas &canvas, const PixelRect &rc,
   static_assert(ARRAY_SIZE(vertices) == ARRAY_SIZE(colors),
                 "Array size mismatch");
 
-  glDrawArrays(GL_TRIANGLE_STRIP, 0, ARRAY_SIZE(vertices));
+  OpenGL::DrawArrays(GL_TRIANGLE_STRIP, 0, ARRAY_SIZE(vertices));
 #else
   canvas.DrawFilledRectangle(rc, fallback_color);
 #endif
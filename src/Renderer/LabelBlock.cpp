@@ -23,41 +23,47 @@ Copyright_License {
 
 #include "LabelBlock.hpp"
 
-inline bool
-LabelBlock::Bucket::Check(const PixelRect rc) const noexcept
-{
-  for (auto i = blocks.begin(), end = blocks.end(); i != end; ++i)
-    if (i->OverlapsWith(rc))
-      return false;
+#include <algorithm>
 
-  return true;
+static constexpr unsigned
+ToCell(int position, unsigned shift, unsigned count) noexcept
+{
+  return std::clamp(position >> shift, 0, int(count - 1));
 }
 
 void
 LabelBlock::reset() noexcept
 {
-  for (auto &i : buckets)
-    i.Clear();
+  if (blocks.empty())
+    return;
+
+  blocks.clear();
+
+  for (auto &row : cells)
+    for (auto &cell : row)
+      cell.clear();
 }
 
 bool
 LabelBlock::check(const PixelRect rc) noexcept
 {
-  unsigned top = rc.top >> BUCKET_SHIFT;
-  unsigned bottom = rc.bottom >> BUCKET_SHIFT;
-
-  if (top >= BUCKET_COUNT)
-    top = BUCKET_COUNT - 1;
+  const unsigned left = ToCell(rc.left, CELL_SHIFT, COLUMNS);
+  const unsigned right = ToCell(rc.right, CELL_SHIFT, COLUMNS);
+  const unsigned top = ToCell(rc.top, CELL_SHIFT, ROWS);
+  const unsigned bottom = ToCell(rc.bottom, CELL_SHIFT, ROWS);
 
-  if (bottom < BUCKET_COUNT && !buckets[bottom].Check(rc))
-    return false;
+  for (unsigned y = top; y <= bottom; ++y)
+    for (unsigned x = left; x <= right; ++x)
+      for (const unsigned i : cells[y][x])
+        if (blocks[i].OverlapsWith(rc))
+          return false;
 
-  if (top < bottom && !buckets[top].Check(rc))
-    return false;
+  const unsigned index = blocks.size();
+  blocks.push_back(rc);
 
-  buckets[top].Add(rc);
-  if (bottom < BUCKET_COUNT && top != bottom)
-    buckets[bottom].Add(rc);
+  for (unsigned y = top; y <= bottom; ++y)
+    for (unsigned x = left; x <= right; ++x)
+      cells[y][x].push_back(index);
 
   return true;
 }
@@ -25,50 +25,51 @@ Copyright_License {
 #define SCREEN_LABELBLOCK_HPP
 
 #include "ui/dim/Rect.hpp"
-#include "util/StaticArray.hxx"
+
+#include <vector>
 
 /**
  * Simple code to prevent text writing over map city names.
+ *
+ * The screen is divided into a uniform grid of square cells; each
+ * cell knows the rectangles which overlap it, so a new rectangle
+ * only needs to be compared with the labels in its neighbourhood.
+ * The allocations are kept across reset() calls.
  */
 class LabelBlock {
 #if defined(HAVE_GLES)
   /* embedded (Android or Windows CE) */
+  static constexpr unsigned SCREEN_WIDTH = 2048;
   static constexpr unsigned SCREEN_HEIGHT = 2048;
-  static constexpr unsigned BUCKET_SIZE = 64;
 #else
   /* desktop, screen may be huge, lots of memory */
+  static constexpr unsigned SCREEN_WIDTH = 4096;
   static constexpr unsigned SCREEN_HEIGHT = 4096;
-  static constexpr unsigned BUCKET_SIZE = 64;
 #endif
-  static constexpr unsigned BUCKET_SHIFT = 7;
-  static constexpr unsigned BUCKET_HEIGHT = 1 << BUCKET_SHIFT;
-  static constexpr unsigned BUCKET_COUNT = SCREEN_HEIGHT / BUCKET_HEIGHT;
+  static constexpr unsigned CELL_SHIFT = 7;
+  static constexpr unsigned CELL_SIZE = 1 << CELL_SHIFT;
+  static constexpr unsigned COLUMNS = SCREEN_WIDTH / CELL_SIZE;
+  static constexpr unsigned ROWS = SCREEN_HEIGHT / CELL_SIZE;
 
   /**
-   * A bucket is responsible for hit tests in one horizontal section
-   * of the screen.
+   * All rectangles which were added since the last reset().
    */
-  class Bucket {
-    typedef StaticArray<PixelRect, BUCKET_SIZE> BlockArray;
-    BlockArray blocks;
-
-  public:
-    void Clear() noexcept {
-      blocks.clear();
-    }
-
-    [[gnu::pure]]
-    bool Check(const PixelRect rc) const noexcept;
-
-    void Add(const PixelRect rc) noexcept {
-      if (!blocks.full())
-        blocks.append(rc);
-    }
-  };
+  std::vector<PixelRect> blocks;
 
-  Bucket buckets[BUCKET_COUNT];
+  /**
+   * For each cell, the indices of all #blocks which overlap it.
+   * Rectangles beyond the screen size are assigned to the border
+   * cells.
+   */
+  std::vector<unsigned> cells[ROWS][COLUMNS];
 
 public:
+  /**
+   * Check whether the rectangle overlaps with one which was added
+   * before, and if not, add it.
+   *
+   * @return true if the rectangle was free and has been added
+   */
   bool check(const PixelRect rc) noexcept;
   void reset() noexcept;
 };
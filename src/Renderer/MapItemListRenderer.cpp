@@ -218,10 +218,11 @@ Draw(Canvas &canvas, const PixelRect rc,
      const AirspaceMapItem &item,
      const TwoTextRowsRenderer &row_renderer,
      const AirspaceLook &look,
-     const AirspaceRendererSettings &renderer_settings)
+     const AirspaceRendererSettings &renderer_settings,
+     const AirspacePreviewRenderer::Polygon *preview)
 {
   AirspaceListRenderer::Draw(canvas, rc, *item.airspace, row_renderer, look,
-                             renderer_settings);
+                             renderer_settings, preview);
 }
 
 static void
@@ -449,7 +450,8 @@ Draw(Canvas &canvas, PixelRect rc,
 void
 MapItemListRenderer::Draw(Canvas &canvas, const PixelRect rc,
                           const MapItem &item,
-                          const TrafficList *traffic_list)
+                          const TrafficList *traffic_list,
+                          const AirspacePreviewRenderer::Polygon *airspace_preview)
 {
   switch (item.type) {
   case MapItem::LOCATION:
@@ -466,7 +468,7 @@ MapItemListRenderer::Draw(Canvas &canvas, const PixelRect rc,
   case MapItem::AIRSPACE:
     ::Draw(canvas, rc, (const AirspaceMapItem &)item,
            row_renderer, look.airspace,
-           settings.airspace);
+           settings.airspace, airspace_preview);
     break;
   case MapItem::WAYPOINT:
     ::Draw(canvas, rc, (const WaypointMapItem &)item,
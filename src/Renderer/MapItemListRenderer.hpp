@@ -26,6 +26,7 @@ Copyright_License {
 
 #include "time/RoughTime.hpp"
 #include "Renderer/TwoTextRowsRenderer.hpp"
+#include "Renderer/AirspacePreviewRenderer.hpp"
 
 struct PixelRect;
 class Canvas;
@@ -58,8 +59,13 @@ public:
 
   unsigned CalculateLayout(const DialogLook &dialog_look);
 
+  /**
+   * @param airspace_preview the preview polygon of an airspace item,
+   * see AirspaceListRenderer::Draw()
+   */
   void Draw(Canvas &canvas, const PixelRect rc, const MapItem &item,
-            const TrafficList *traffic_list=nullptr);
+            const TrafficList *traffic_list=nullptr,
+            const AirspacePreviewRenderer::Polygon *airspace_preview=nullptr);
 };
 
 #endif
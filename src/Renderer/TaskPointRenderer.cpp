@@ -176,17 +176,19 @@ TaskPointRenderer::DrawIsoline(const AATPoint &tp)
   if (m_proj.GeoToScreenDistance(start.DistanceS(end)) <= 2)
     return;
 
-  BulkPixelPoint screen[21];
-  screen[0] = m_proj.GeoToScreen(start);
-  screen[20] = m_proj.GeoToScreen(end);
+  GeoPoint locations[21];
+  locations[0] = start;
+  locations[20] = end;
 
   for (unsigned i = 1; i < 20; ++i) {
     constexpr double twentieth = 1.0 / 20.0;
     auto t = i * twentieth;
-    GeoPoint ga = seg.Parametric(t);
-    screen[i] = m_proj.GeoToScreen(ga);
+    locations[i] = seg.Parametric(t);
   }
 
+  BulkPixelPoint screen[21];
+  m_proj.GeoToScreen(locations, std::span{screen});
+
   canvas.Select(task_look.isoline_pen);
   canvas.SetBackgroundTransparent();
   canvas.DrawPolyline(screen, 21);
@@ -38,6 +38,7 @@ Copyright_License {
 bool
 TrailRenderer::LoadTrace(const TraceComputer &trace_computer)
 {
+  trace_cached = false;
   trace.clear();
   trace_computer.LockedCopyTo(trace);
   return !trace.empty();
@@ -45,14 +46,44 @@ TrailRenderer::LoadTrace(const TraceComputer &trace_computer)
 
 bool
 TrailRenderer::LoadTrace(const TraceComputer &trace_computer,
-                         TimeStamp min_time,
+                         TimeStamp _min_time,
                          const WindowProjection &projection)
 {
-  trace.clear();
-  trace_computer.LockedCopyTo(trace,
-                              min_time.Cast<std::chrono::duration<unsigned>>(),
-                              projection.GetGeoScreenCenter(),
-                              projection.DistancePixelsToMeters(3));
+  const auto min_time = _min_time.Cast<TracePoint::Time>();
+  const double resolution = projection.DistancePixelsToMeters(3);
+
+  const std::lock_guard<Mutex> lock(trace_computer);
+  const Trace &full = trace_computer.GetFull();
+
+  if (!trace_cached || full.GetModifySerial() != trace_modify_serial ||
+      resolution != trace_resolution || min_time < trace_min_time) {
+    /* the old points have changed: start from scratch */
+    trace.clear();
+    full.GetPoints(trace, min_time, projection.GetGeoScreenCenter(),
+                   resolution);
+  } else {
+    /* the trace has (at most) grown: remove the points which are
+       now too old, and append the new ones */
+    trace.erase(trace.begin(),
+                std::find_if(trace.begin(), trace.end(),
+                             [min_time](const TracePoint &i){
+                               return i.GetTime() >= min_time;
+                             }));
+
+    if (full.GetAppendSerial() != trace_append_serial)
+      full.GetPoints(trace,
+                     trace.empty()
+                     ? min_time
+                     : trace.back().GetTime() + TracePoint::Time{1},
+                     projection.GetGeoScreenCenter(), resolution);
+  }
+
+  trace_modify_serial = full.GetModifySerial();
+  trace_append_serial = full.GetAppendSerial();
+  trace_min_time = min_time;
+  trace_resolution = resolution;
+  trace_cached = true;
+
   return !trace.empty();
 }
 
@@ -144,20 +175,34 @@ TrailRenderer::Draw(Canvas &canvas, const TraceComputer &trace_computer,
 
   const GeoBounds bounds = projection.GetScreenBounds().Scale(4);
 
+  /* project all points in one batch; those outside of the MapWindow
+     are converted, too, but they are skipped below */
+  const unsigned n = trace.size();
+  locations.GrowDiscard(n);
+  std::transform(trace.begin(), trace.end(), locations.begin(),
+                 [&](const TracePoint &i){
+                   return enable_traildrift
+                     ? i.GetLocation().Parametric(traildrift,
+                                                  i.CalculateDrift(basic.time))
+                     : i.GetLocation();
+                 });
+
+  const BulkPixelPoint *screen = Prepare(n);
+  projection.GeoToScreen({locations.begin(), n}, std::span{points.begin(), n});
+
+  const GeoPoint *location = locations.begin();
+
   PixelPoint last_point(0, 0);
   bool last_valid = false;
-  for (auto it = trace.begin(), end = trace.end(); it != end; ++it) {
-    const GeoPoint gp = enable_traildrift
-      ? it->GetLocation().Parametric(traildrift,
-                                     it->CalculateDrift(basic.time))
-      : it->GetLocation();
-    if (!bounds.IsInside(gp)) {
+  for (auto it = trace.begin(), end = trace.end(); it != end;
+       ++it, ++location, ++screen) {
+    if (!bounds.IsInside(*location)) {
       /* the point is outside of the MapWindow; don't paint it */
       last_valid = false;
       continue;
     }
 
-    auto pt = projection.GeoToScreen(gp);
+    const PixelPoint pt = *screen;
 
     if (last_valid) {
       if (settings.type == TrailSettings::Type::ALTITUDE) {
@@ -249,8 +294,10 @@ TrailRenderer::DrawTraceVector(Canvas &canvas, const Projection &projection,
   const unsigned n = trace.size();
   auto *p = Prepare(n);
 
-  for (const auto &i : trace)
-    *p++ = projection.GeoToScreen(i.GetLocation());
+  locations.GrowDiscard(n);
+  std::transform(trace.begin(), trace.end(), locations.begin(),
+                 [](const auto &i){ return i.GetLocation(); });
+  projection.GeoToScreen({locations.begin(), n}, std::span{p, n});
 
   DrawPreparedPolyline(canvas, n);
 }
@@ -278,8 +325,10 @@ TrailRenderer::DrawTraceVector(Canvas &canvas, const Projection &projection,
   const unsigned n = trace.size();
   auto *p = Prepare(n);
 
-  for (const auto &i : trace)
-    *p++ = projection.GeoToScreen(i.GetLocation());
+  locations.GrowDiscard(n);
+  std::transform(trace.begin(), trace.end(), locations.begin(),
+                 [](const auto &i){ return i.GetLocation(); });
+  projection.GeoToScreen({locations.begin(), n}, std::span{p, n});
 
   DrawPreparedPolyline(canvas, n);
 }
@@ -28,6 +28,7 @@ Copyright_License {
 #include "Engine/Trace/Point.hpp"
 #include "Engine/Trace/Vector.hpp"
 #include "time/Stamp.hpp"
+#include "util/Serial.hpp"
 
 struct PixelPoint;
 struct BulkPixelPoint;
@@ -53,6 +54,28 @@ class TrailRenderer {
   TracePointVector trace;
   AllocatedArray<BulkPixelPoint> points;
 
+  /**
+   * The locations of the points to be drawn, gathered from #trace
+   * for the batch Projection::GeoToScreen().
+   */
+  AllocatedArray<GeoPoint> locations;
+
+  /**
+   * The #Trace serials and parameters of the filtered LoadTrace()
+   * call which produced #trace.  They allow the next call to append
+   * only the points which were added since then, instead of copying
+   * the whole trace again.
+   */
+  Serial trace_modify_serial, trace_append_serial;
+  TracePoint::Time trace_min_time;
+  double trace_resolution;
+
+  /**
+   * Is #trace the result of the filtered LoadTrace() described by
+   * the attributes above?
+   */
+  bool trace_cached = false;
+
 public:
   TrailRenderer(const TrailLook &_look):look(_look) {}
 
@@ -62,7 +85,9 @@ public:
   bool LoadTrace(const TraceComputer &trace_computer);
 
   /**
-   * Load a filtered trace into this object.
+   * Load a filtered trace into this object.  If the trace has only
+   * grown since the previous call with the same resolution, only the
+   * new points are copied.
    */
   bool LoadTrace(const TraceComputer &trace_computer,
                  TimeStamp min_time,
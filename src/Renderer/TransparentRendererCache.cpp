@@ -67,6 +67,16 @@ TransparentRendererCache::Commit(Canvas &canvas,
   empty = false;
 }
 
+void
+TransparentRendererCache::CopyTo(Canvas &canvas,
+                                 const WindowProjection &projection) const
+{
+  if (empty)
+    return;
+
+  canvas.Copy({0, 0}, projection.GetScreenSize(), buffer, {0, 0});
+}
+
 void
 TransparentRendererCache::CopyAndTo(Canvas &canvas,
                                     const WindowProjection &projection) const
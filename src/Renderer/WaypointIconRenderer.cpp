@@ -116,6 +116,15 @@ DrawLandableRunway(Canvas &canvas, const PixelPoint &pt,
 }
 
 
+inline void
+WaypointIconRenderer::DrawIcon(const MaskedIcon &icon, const PixelPoint &point)
+{
+  if (batch != nullptr)
+    batch->Draw(icon, point);
+  else
+    icon.Draw(canvas, point);
+}
+
 void
 WaypointIconRenderer::DrawLandable(const Waypoint &waypoint,
                                    const PixelPoint &point,
@@ -138,7 +147,7 @@ WaypointIconRenderer::DrawLandable(const Waypoint &waypoint,
         ? &look.airport_unreachable_icon
         : &look.field_unreachable_icon;
 
-    icon->Draw(canvas, point);
+    DrawIcon(*icon, point);
     return;
   }
 
@@ -210,5 +219,5 @@ WaypointIconRenderer::Draw(const Waypoint &waypoint, const PixelPoint &point,
     DrawLandable(waypoint, point, reachable);
   else
     // non landable turnpoint
-    GetWaypointIcon(look, waypoint, small_icons, in_task).Draw(canvas, point);
+    DrawIcon(GetWaypointIcon(look, waypoint, small_icons, in_task), point);
 }
@@ -31,12 +31,21 @@ struct WaypointRendererSettings;
 struct WaypointLook;
 class Canvas;
 struct Waypoint;
+class MaskedIcon;
+class MaskedIconBatch;
 
 class WaypointIconRenderer
 {
   const WaypointRendererSettings &settings;
   const WaypointLook &look;
   Canvas &canvas;
+
+  /**
+   * If set, icons are collected here instead of being drawn
+   * immediately.
+   */
+  MaskedIconBatch *batch;
+
   bool small_icons;
   Angle screen_rotation;
 
@@ -52,15 +61,18 @@ public:
   WaypointIconRenderer(const WaypointRendererSettings &_settings,
                        const WaypointLook &_look,
                        Canvas &_canvas, bool _small_icons = false,
-                       Angle _screen_rotation = Angle::Zero())
+                       Angle _screen_rotation = Angle::Zero(),
+                       MaskedIconBatch *_batch = nullptr)
     :settings(_settings), look(_look),
-     canvas(_canvas), small_icons(_small_icons),
+     canvas(_canvas), batch(_batch), small_icons(_small_icons),
      screen_rotation(_screen_rotation) {}
 
   void Draw(const Waypoint &waypoint, const PixelPoint &point,
             Reachability reachable = Unreachable, bool in_task = false);
 
 private:
+  void DrawIcon(const MaskedIcon &icon, const PixelPoint &point);
+
   void DrawLandable(const Waypoint &waypoint, const PixelPoint &point,
                     Reachability reachable = Unreachable);
 };
@@ -41,6 +41,7 @@ Copyright_License {
 #include "Task/ProtectedTaskManager.hpp"
 #include "Task/ProtectedRoutePlanner.hpp"
 #include "ui/canvas/Canvas.hpp"
+#include "ui/canvas/Icon.hpp"
 #include "Units/Units.hpp"
 #include "util/TruncateString.hpp"
 #include "util/StaticArray.hxx"
@@ -49,8 +50,10 @@ Copyright_License {
 #include "NMEA/Derived.hpp"
 #include "Engine/Route/ReachResult.hpp"
 #include "Look/WaypointLook.hpp"
+#include "Screen/Layout.hpp"
 
 #include <cassert>
+#include <optional>
 #include <stdio.h>
 
 /**
@@ -125,6 +128,19 @@ struct VisibleWaypoint {
     if (!CalculateRouteArrival(route_planner, task_behaviour))
       return;
 
+    UpdateReachability(task_behaviour);
+  }
+
+  /**
+   * Use the reach which was calculated by the #RouteComputer.
+   */
+  void SetReach(const ReachResult &_reach,
+                const TaskBehaviour &task_behaviour) {
+    reach = _reach;
+    UpdateReachability(task_behaviour);
+  }
+
+  void UpdateReachability(const TaskBehaviour &task_behaviour) {
     if (!reach.IsReachableDirect())
       reachable = WaypointRenderer::Unreachable;
     else if (task_behaviour.route_planner.IsReachEnabled() &&
@@ -136,9 +152,10 @@ struct VisibleWaypoint {
 
   void DrawSymbol(const struct WaypointRendererSettings &settings,
                   const WaypointLook &look,
-                  Canvas &canvas, bool small_icons, Angle screen_rotation) const {
+                  Canvas &canvas, MaskedIconBatch &batch,
+                  bool small_icons, Angle screen_rotation) const {
     WaypointIconRenderer wir(settings, look,
-                             canvas, small_icons, screen_rotation);
+                             canvas, small_icons, screen_rotation, &batch);
     wir.Draw(*waypoint, point, (WaypointIconRenderer::Reachability)reachable,
              in_task);
   }
@@ -153,6 +170,8 @@ class WaypointVisitorMap final
   const TaskBehaviour &task_behaviour;
   const MoreData &basic;
 
+  WaypointRenderer::TitleCache &title_cache;
+
   TCHAR altitude_unit[4];
   bool task_valid;
 
@@ -173,10 +192,11 @@ public:
                      const WaypointRendererSettings &_settings,
                      const WaypointLook &_look,
                      const TaskBehaviour &_task_behaviour,
-                     const MoreData &_basic)
+                     const MoreData &_basic,
+                     WaypointRenderer::TitleCache &_title_cache)
     :projection(_projection),
      settings(_settings), look(_look), task_behaviour(_task_behaviour),
-     basic(_basic),
+     basic(_basic), title_cache(_title_cache),
      task_valid(false),
      labels(projection.GetScreenRect())
   {
@@ -185,8 +205,8 @@ public:
 
 
 protected:
-  void FormatTitle(TCHAR *buffer, size_t buffer_size,
-                   const Waypoint &way_point) const {
+  void FormatTitleUncached(TCHAR *buffer, size_t buffer_size,
+                           const Waypoint &way_point) const {
     buffer[0] = _T('\0');
 
     switch (settings.display_text_type) {
@@ -228,6 +248,21 @@ protected:
     }
   }
 
+  void FormatTitle(TCHAR *buffer, size_t buffer_size,
+                   const Waypoint &way_point) const {
+    auto &titles = title_cache.titles;
+    if (auto i = titles.find(way_point.id); i != titles.end()) {
+      CopyTruncateString(buffer, buffer_size, i->second.c_str());
+      return;
+    }
+
+    FormatTitleUncached(buffer, buffer_size, way_point);
+
+    if (titles.size() >= title_cache.MAX_SIZE)
+      title_cache.Clear();
+    titles.emplace(way_point.id, buffer);
+  }
+
   void FormatLabel(TCHAR *buffer, size_t buffer_size,
                    const Waypoint &way_point,
                    WaypointRenderer::Reachability reachable,
@@ -307,11 +342,12 @@ protected:
     StringFormatUnsafe(buffer + length, _T("%d%s"), uah_glide, altitude_unit);
   }
 
-  void DrawWaypoint(Canvas &canvas, const VisibleWaypoint &vwp) {
+  void DrawWaypoint(Canvas &canvas, MaskedIconBatch &batch,
+                    const VisibleWaypoint &vwp) {
     const Waypoint &way_point = *vwp.waypoint;
     bool watchedWaypoint = way_point.flags.watched;
 
-    vwp.DrawSymbol(settings, look, canvas,
+    vwp.DrawSymbol(settings, look, canvas, batch,
                    projection.GetMapScale() > 4000,
                    projection.GetScreenAngle());
 
@@ -411,14 +447,25 @@ public:
     task_valid = true;
   }
 
-  void CalculateRoute(const ProtectedRoutePlanner &route_planner) {
-    const ProtectedRoutePlanner::Lease lease(route_planner);
+  void CalculateRoute(const ProtectedRoutePlanner &route_planner,
+                      const LandableReach &landable_reach) {
+    /* locked only if a waypoint is missing in the precomputed table */
+    std::optional<ProtectedRoutePlanner::Lease> lease;
 
     for (VisibleWaypoint &vwp : waypoints) {
       const Waypoint &way_point = *vwp.waypoint;
+      if (!way_point.IsLandable() && !way_point.flags.watched)
+        continue;
 
-      if (way_point.IsLandable() || way_point.flags.watched)
-        vwp.CalculateReachability(lease, task_behaviour);
+      if (const auto *reach = landable_reach.Find(way_point)) {
+        vwp.SetReach(*reach, task_behaviour);
+        continue;
+      }
+
+      if (!lease)
+        lease.emplace(route_planner);
+
+      vwp.CalculateReachability(*lease, task_behaviour);
     }
   }
 
@@ -448,14 +495,18 @@ public:
                  const TaskBehaviour &task_behaviour,
                  const DerivedInfo &calculated) {
     if (route_planner != nullptr && !route_planner->IsTerrainReachEmpty())
-      CalculateRoute(*route_planner);
+      CalculateRoute(*route_planner, calculated.landable_reach);
     else
       CalculateDirect(polar_settings, task_behaviour, calculated);
   }
 
   void Draw(Canvas &canvas) {
+    /* all icons come from the icon atlas; submit them in one batch
+       instead of one draw call per waypoint */
+    MaskedIconBatch batch(canvas);
+
     for (const VisibleWaypoint &vwp : waypoints)
-      DrawWaypoint(canvas, vwp);
+      DrawWaypoint(canvas, batch, vwp);
   }
 };
 
@@ -487,7 +538,15 @@ WaypointRenderer::render(Canvas &canvas, LabelBlock &label_block,
   if (way_points == nullptr || way_points->IsEmpty())
     return;
 
-  WaypointVisitorMap v(projection, settings, look, task_behaviour, basic);
+  if (title_cache.serial != way_points->GetSerial() ||
+      title_cache.display_text_type != unsigned(settings.display_text_type)) {
+    title_cache.Clear();
+    title_cache.serial = way_points->GetSerial();
+    title_cache.display_text_type = unsigned(settings.display_text_type);
+  }
+
+  WaypointVisitorMap v(projection, settings, look, task_behaviour, basic,
+                       title_cache);
 
   if (task != nullptr) {
     ProtectedTaskManager::Lease task_manager(*task);
@@ -504,9 +563,18 @@ WaypointRenderer::render(Canvas &canvas, LabelBlock &label_block,
       atask->AcceptTaskPointVisitor(v);
   }
 
-  way_points->VisitWithinRange(projection.GetGeoScreenCenter(),
-                               projection.GetScreenDistanceMeters(),
-                               [&v](const auto &w){ v.Add(w); });
+  /* zoomed out that far, WaypointInScaleFilter() would reject all
+     waypoints anyway; don't bother visiting them */
+  if (projection.AnyWaypointInScaleFilter()) {
+    /* skip waypoints whose icons would overlap a more important
+       one */
+    const double spacing = projection.DistancePixelsToMeters(Layout::Scale(8));
+
+    way_points->VisitWithinRange(projection.GetGeoScreenCenter(),
+                                 projection.GetScreenDistanceMeters(),
+                                 spacing,
+                                 [&v](const auto &w){ v.Add(w); });
+  }
 
   v.Calculate(route_planner, polar_settings, task_behaviour, calculated);
 
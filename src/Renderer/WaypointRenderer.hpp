@@ -25,6 +25,10 @@ Copyright_License {
 #define XCSOAR_WAY_POINT_RENDERER_HPP
 
 #include "util/NonCopyable.hpp"
+#include "util/Serial.hpp"
+#include "util/tstring.hpp"
+
+#include <unordered_map>
 
 struct WaypointRendererSettings;
 struct WaypointLook;
@@ -47,6 +51,42 @@ class WaypointRenderer : private NonCopyable {
 
   const WaypointLook &look;
 
+public:
+  /**
+   * Remembers the formatted title of each waypoint, because it
+   * usually does not change from one frame to the next.
+   */
+  struct TitleCache {
+    /**
+     * Limit the memory usage when panning over a large waypoint
+     * file; the cache is flushed when this size is reached.
+     */
+    static constexpr std::size_t MAX_SIZE = 4096;
+
+    /**
+     * The #Waypoints serial the titles were formatted for.
+     */
+    Serial serial;
+
+    /**
+     * The WaypointRendererSettings::DisplayTextType the titles were
+     * formatted with.
+     */
+    unsigned display_text_type = 0;
+
+    /**
+     * Maps Waypoint::id to the title.
+     */
+    std::unordered_map<unsigned, tstring> titles;
+
+    void Clear() noexcept {
+      titles.clear();
+    }
+  };
+
+private:
+  TitleCache title_cache;
+
 public:
   enum Reachability
   {
@@ -62,6 +102,7 @@ public:
 
   void set_way_points(const Waypoints *_way_points) {
     way_points = _way_points;
+    title_cache.Clear();
   }
 
   void render(Canvas &canvas, LabelBlock &label_block,
@@ -153,6 +153,66 @@ public:
     return r;
   }
 
+  /**
+   * Interpolate #n samples at #start, #start + #step, ... in one
+   * call.  This is cheaper than calling Interpolate() #n times: the
+   * four control points are combined into the polynomial
+   * coefficients of all channels only once, and then each sample is
+   * a Horner evaluation.
+   */
+  void
+  InterpolateSegment(TimeStamp start, FloatDuration step,
+                     Record *dest, unsigned n) const noexcept
+  {
+    assert(Ready());
+    assert(p[2].time > p[1].time);
+
+    /* the basis matrix, see Interpolate() */
+    const double t = time.count();
+    const double m[4][4] = {
+      { 0, 1, 0, 0 },
+      { -t, 0, t, 0 },
+      { 2 * t, t - 3, 3 - 2 * t, -t },
+      { -t, 2 - t, t - 2, t },
+    };
+
+    enum { LATITUDE, LONGITUDE, GPS_ALTITUDE, BARO_ALTITUDE, N_CHANNELS };
+
+    double control[4][N_CHANNELS];
+    for (unsigned j = 0; j < 4; ++j) {
+      control[j][LATITUDE] = p[j].location.latitude.Native();
+      control[j][LONGITUDE] = p[j].location.longitude.Native();
+      control[j][GPS_ALTITUDE] = p[j].gps_altitude;
+      control[j][BARO_ALTITUDE] = p[j].baro_altitude;
+    }
+
+    /* a[k][channel] is the coefficient of u^k */
+    double a[4][N_CHANNELS] = {};
+    for (unsigned k = 0; k < 4; ++k)
+      for (unsigned j = 0; j < 4; ++j)
+        for (unsigned c = 0; c < N_CHANNELS; ++c)
+          a[k][c] += m[k][j] * control[j][c];
+
+    const double duration = (p[2].time - p[1].time).count();
+    const double u0 = (start - p[1].time).count() / duration;
+    const double du = step.count() / duration;
+
+    for (unsigned i = 0; i < n; ++i) {
+      const double u = u0 + i * du;
+
+      double v[N_CHANNELS];
+      for (unsigned c = 0; c < N_CHANNELS; ++c)
+        v[c] = ((a[3][c] * u + a[2][c]) * u + a[1][c]) * u + a[0][c];
+
+      Record &r = dest[i];
+      r.location.latitude = Angle::Native(v[LATITUDE]);
+      r.location.longitude = Angle::Native(v[LONGITUDE]);
+      r.gps_altitude = v[GPS_ALTITUDE];
+      r.baro_altitude = v[BARO_ALTITUDE];
+      r.time = start + step * i;
+    }
+  }
+
   TimeStamp GetMinTime() const noexcept {
     assert(Ready());
 
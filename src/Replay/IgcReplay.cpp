@@ -24,20 +24,37 @@
 #include "Replay/IgcReplay.hpp"
 #include "IGC/IGCParser.hpp"
 #include "IGC/IGCFix.hpp"
-#include "io/LineReader.hpp"
+#include "io/FileLineReader.hpp"
 #include "NMEA/Info.hpp"
 #include "Units/System.hpp"
 
+#include <cassert>
+
 IgcReplay::IgcReplay(std::unique_ptr<NLineReader> &&_reader)
   :reader(std::move(_reader))
 {
   extensions.clear();
 }
 
+IgcReplay::IgcReplay(std::unique_ptr<FileLineReaderA> &&_reader)
+  :IgcReplay(std::unique_ptr<NLineReader>(std::move(_reader)))
+{
+  file_reader = static_cast<FileLineReaderA *>(reader.get());
+}
+
 IgcReplay::~IgcReplay()
 {
 }
 
+void
+IgcReplay::Seek(off_t offset, const IGCExtensions &_extensions)
+{
+  assert(IsSeekable());
+
+  file_reader->Seek(offset);
+  extensions = _extensions;
+}
+
 inline bool
 IgcReplay::ScanBuffer(const char *buffer, IGCFix &fix, NMEAInfo &basic)
 {
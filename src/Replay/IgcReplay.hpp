@@ -29,19 +29,42 @@ Copyright_License {
 
 #include <memory>
 
+#include <sys/types.h>
+
 class NLineReader;
+class FileLineReaderA;
 struct IGCFix;
 
 class IgcReplay: public AbstractReplay
 {
   std::unique_ptr<NLineReader> reader;
 
+  /**
+   * The same object as #reader if it is seekable, nullptr otherwise.
+   */
+  FileLineReaderA *file_reader = nullptr;
+
   IGCExtensions extensions;
 
 public:
   IgcReplay(std::unique_ptr<NLineReader> &&_reader);
+  IgcReplay(std::unique_ptr<FileLineReaderA> &&_reader);
   ~IgcReplay() override;
 
+  bool IsSeekable() const noexcept {
+    return file_reader != nullptr;
+  }
+
+  /**
+   * Continue reading at the specified file offset (the beginning of
+   * a "B" record), e.g. from an #IgcReplayIndex checkpoint.
+   *
+   * Throws on error.
+   *
+   * @param _extensions the "I" record in effect at this offset
+   */
+  void Seek(off_t offset, const IGCExtensions &_extensions);
+
   bool Update(NMEAInfo &data) override;
 
 private:
@@ -0,0 +1,123 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "IgcReplayIndex.hpp"
+#include "IGC/IGCParser.hpp"
+#include "IGC/IGCFix.hpp"
+#include "system/FileMapping.hpp"
+#include "LogFile.hpp"
+
+#include <algorithm>
+#include <string_view>
+
+IgcReplayIndex::IgcReplayIndex(Path _path)
+  :Thread("IgcReplayIndex"), path(_path)
+{
+  Start();
+}
+
+IgcReplayIndex::~IgcReplayIndex() noexcept
+{
+  cancel = true;
+  Join();
+}
+
+std::optional<IgcReplayIndex::Checkpoint>
+IgcReplayIndex::Find(TimeStamp time) const noexcept
+{
+  const std::lock_guard<Mutex> lock(mutex);
+
+  auto i = std::upper_bound(checkpoints.begin(), checkpoints.end(), time,
+                            [](TimeStamp t, const Checkpoint &c){
+                              return t < c.time;
+                            });
+  if (i == checkpoints.begin())
+    return std::nullopt;
+
+  return *std::prev(i);
+}
+
+inline void
+IgcReplayIndex::Scan()
+{
+  const FileMapping mapping(path);
+  const std::string_view contents((const char *)mapping.data(),
+                                  mapping.size());
+
+  IGCExtensions extensions;
+  extensions.clear();
+
+  TimeStamp next_checkpoint = TimeStamp::Undefined();
+
+  /* IGCParseFix() needs a null-terminated string */
+  char line[256];
+
+  for (std::size_t offset = 0; offset < contents.size() && !cancel;) {
+    const std::size_t eol = contents.find('\n', offset);
+    const std::size_t end = eol == contents.npos ? contents.size() : eol;
+    const std::size_t line_offset = std::exchange(offset, end + 1);
+
+    const char first = contents[line_offset];
+    if (first != 'B' && first != 'I')
+      continue;
+
+    const std::size_t length = std::min(end - line_offset, sizeof(line) - 1);
+    *std::copy_n(contents.data() + line_offset, length, line) = '\0';
+
+    if (first == 'I') {
+      IGCParseExtensions(line, extensions);
+      continue;
+    }
+
+    IGCFix fix;
+    if (!IGCParseFix(line, extensions, fix) || !fix.gps_valid)
+      continue;
+
+    const TimeStamp time{fix.time.DurationSinceMidnight()};
+    if (next_checkpoint.IsDefined() && time < next_checkpoint) {
+      if (time < next_checkpoint - INTERVAL)
+        /* time warp (midnight wraparound?); checkpoints after this
+           would be ambiguous */
+        break;
+
+      continue;
+    }
+
+    next_checkpoint = time + INTERVAL;
+
+    const std::lock_guard<Mutex> lock(mutex);
+    checkpoints.push_back({time, line_offset, extensions});
+  }
+}
+
+void
+IgcReplayIndex::Run() noexcept
+{
+  SetIdlePriority();
+
+  try {
+    Scan();
+  } catch (...) {
+    LogError(std::current_exception(), "Failed to index the IGC file");
+  }
+}
@@ -0,0 +1,104 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_IGC_REPLAY_INDEX_HPP
+#define XCSOAR_IGC_REPLAY_INDEX_HPP
+
+#include "IGC/IGCExtensions.hpp"
+#include "thread/Thread.hpp"
+#include "thread/Mutex.hxx"
+#include "system/Path.hpp"
+#include "time/Stamp.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+/**
+ * Scans an IGC file in a background thread and records periodic
+ * checkpoints, which allow #IgcReplay to continue at an arbitrary
+ * position without parsing all fixes in between.
+ *
+ * Checkpoints become available while the thread is still scanning.
+ */
+class IgcReplayIndex final : private Thread {
+public:
+  /**
+   * The distance between two checkpoints (in IGC time).
+   */
+  static constexpr FloatDuration INTERVAL = std::chrono::minutes{5};
+
+  struct Checkpoint {
+    /**
+     * The time of the first fix at #offset.
+     */
+    TimeStamp time;
+
+    /**
+     * The file offset of the "B" record.
+     */
+    uint64_t offset;
+
+    /**
+     * The "I" record which was in effect at #offset.
+     */
+    IGCExtensions extensions;
+  };
+
+private:
+  const AllocatedPath path;
+
+  mutable Mutex mutex;
+
+  /**
+   * Sorted by time.  Protected by #mutex.
+   */
+  std::vector<Checkpoint> checkpoints;
+
+  std::atomic_bool cancel{false};
+
+public:
+  /**
+   * Start scanning the specified file.
+   *
+   * Throws on error.
+   */
+  explicit IgcReplayIndex(Path _path);
+
+  ~IgcReplayIndex() noexcept;
+
+  /**
+   * Find the last checkpoint at or before the specified time.
+   */
+  [[gnu::pure]]
+  std::optional<Checkpoint> Find(TimeStamp time) const noexcept;
+
+private:
+  void Scan();
+
+  /* virtual methods from class Thread */
+  void Run() noexcept override;
+};
+
+#endif
@@ -23,13 +23,16 @@
 
 #include "Replay.hpp"
 #include "IgcReplay.hpp"
+#include "IgcReplayIndex.hpp"
 #include "NmeaReplay.hpp"
 #include "DemoReplayGlue.hpp"
 #include "io/FileLineReader.hpp"
+#include "io/GunzipLineReader.hpp"
 #include "Blackboard/DeviceBlackboard.hpp"
 #include "Logger/Logger.hpp"
 #include "Components.hpp"
 #include "Interface.hpp"
+#include "LogFile.hpp"
 #include "CatmullRomInterpolator.hpp"
 #include "time/Cast.hxx"
 #include "util/Clamp.hpp"
@@ -46,6 +49,9 @@ Replay::Stop()
 
   timer.Cancel();
 
+  delete index;
+  index = nullptr;
+
   delete replay;
   replay = nullptr;
 
@@ -76,8 +82,16 @@ Replay::Start(Path _path)
 
     cli = new CatmullRomInterpolator(FloatDuration{0.98});
     cli->Reset();
+
+    try {
+      index = new IgcReplayIndex(path);
+    } catch (...) {
+      /* not fatal; fast-forward will just be slower */
+      LogError(std::current_exception(), "Failed to index the IGC file");
+    }
   } else {
-    replay = new NmeaReplay(std::make_unique<FileLineReaderA>(path),
+    /* NMEA logs may be gzip-compressed (see NMEALogger) */
+    replay = new NmeaReplay(OpenFileLineReaderA(path),
                             CommonInterface::GetSystemSettings().devices[0]);
   }
 
@@ -91,6 +105,62 @@ Replay::Start(Path _path)
   timer.Schedule(std::chrono::milliseconds(100));
 }
 
+TimeStamp
+Replay::SeekCheckpoint(TimeStamp destination) noexcept
+{
+  if (index == nullptr)
+    return TimeStamp::Undefined();
+
+  const auto checkpoint = index->Find(destination);
+  if (!checkpoint ||
+      /* replaying from the current position is faster */
+      (checkpoint->time <= virtual_time && destination >= virtual_time))
+    return TimeStamp::Undefined();
+
+  try {
+    static_cast<IgcReplay *>(replay)->Seek(checkpoint->offset,
+                                            checkpoint->extensions);
+  } catch (...) {
+    LogError(std::current_exception(), "Failed to seek the IGC file");
+    return TimeStamp::Undefined();
+  }
+
+  /* start over as if the replay had just begun at the checkpoint; the
+     date from the previous records is kept */
+  next_data.time_available.Clear();
+  cli->Reset();
+  return checkpoint->time;
+}
+
+bool
+Replay::FastForward(FloatDuration delta_s) noexcept
+{
+  if (!IsActive())
+    return false;
+
+  if (!virtual_time.IsDefined()) {
+    fast_forward = TimeStamp{delta_s};
+    return false;
+  }
+
+  const TimeStamp destination = virtual_time + delta_s;
+
+  const TimeStamp checkpoint = SeekCheckpoint(destination);
+  if (checkpoint.IsDefined()) {
+    /* the virtual time is reinitialised from the checkpoint's fix;
+       the rest is replayed as usual */
+    virtual_time = TimeStamp::Undefined();
+    fast_forward = TimeStamp{destination - checkpoint};
+    return true;
+  }
+
+  if (destination < virtual_time)
+    return false;
+
+  fast_forward = destination;
+  return true;
+}
+
 bool
 Replay::Update()
 {
@@ -230,7 +300,7 @@ Replay::OnTimer()
   else if (!virtual_time.IsDefined() || !next_data.time_available)
     schedule = std::chrono::milliseconds(500);
   else if (cli != nullptr)
-    schedule = std::chrono::seconds(1);
+    schedule = std::chrono::steady_clock::duration(std::chrono::seconds(1)) / output_rate;
   else {
     constexpr std::chrono::steady_clock::duration lower = std::chrono::milliseconds(100);
     constexpr std::chrono::steady_clock::duration upper = std::chrono::seconds(3);
@@ -29,21 +29,41 @@ Copyright_License {
 #include "time/PeriodClock.hpp"
 #include "time/Stamp.hpp"
 #include "system/Path.hpp"
+#include "util/Clamp.hpp"
 
 class Logger;
 class ProtectedTaskManager;
 class AbstractReplay;
+class IgcReplay;
+class IgcReplayIndex;
 class CatmullRomInterpolator;
 class Error;
 
 class Replay final
 {
+public:
+  static constexpr unsigned MAX_OUTPUT_RATE = 20;
+
+private:
   UI::Timer timer{[this]{ OnTimer(); }};
 
   double time_scale;
 
+  /**
+   * How many interpolated fixes per second (of wall-clock time) are
+   * generated during IGC replay?
+   */
+  unsigned output_rate = 1;
+
   AbstractReplay *replay;
 
+  /**
+   * Checkpoints of the IGC file being replayed; nullptr if this is
+   * not an IGC replay.  They allow FastForward() to skip most of the
+   * fixes.
+   */
+  IgcReplayIndex *index = nullptr;
+
   Logger *logger;
   ProtectedTaskManager &task_manager;
 
@@ -114,29 +134,45 @@ public:
     time_scale = _time_scale;
   }
 
+  unsigned GetOutputRate() const noexcept {
+    return output_rate;
+  }
+
+  /**
+   * Set the number of interpolated fixes per second during IGC
+   * replay (1 to #MAX_OUTPUT_RATE).  NMEA replay always runs at the
+   * rate of the input file.
+   */
+  void SetOutputRate(unsigned _output_rate) noexcept {
+    output_rate = Clamp(_output_rate, 1U, MAX_OUTPUT_RATE);
+  }
+
   /**
    * Start fast-forwarding the replay by the specified number of
    * seconds.  This replays the given amount of time from the input
    * time as quickly as possible.  Returns false if unable to fast forward.
+   *
+   * During IGC replay, this first jumps to the nearest checkpoint
+   * (see #IgcReplayIndex) before the destination, which may also be
+   * in the past.  The fixes which are skipped this way are not seen
+   * by the glide computer.
    */
-  bool FastForward(FloatDuration delta_s) noexcept {
-    if (!IsActive())
-      return false;
-
-    if (virtual_time.IsDefined()) {
-      fast_forward = virtual_time + delta_s;
-      return true;
-    } else {
-      fast_forward = TimeStamp{delta_s};
-      return false;
-    }
-  }
+  bool FastForward(FloatDuration delta_s) noexcept;
 
   TimeStamp GetVirtualTime() const noexcept {
     return virtual_time;
   }
 
 private:
+  /**
+   * Jump to the last checkpoint before the specified time, if that
+   * is worth it.
+   *
+   * @return the time of the checkpoint, or TimeStamp::Undefined() if
+   * the replay continues at the current position
+   */
+  TimeStamp SeekCheckpoint(TimeStamp destination) noexcept;
+
   void OnTimer();
 };
 
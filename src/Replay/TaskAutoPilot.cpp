@@ -125,7 +125,7 @@ TaskAutoPilot::GetHeadingDeviation()
   auto noise_mag = acstate == Climb
     ? parms.bearing_noise / 2.
     : parms.bearing_noise;
-  auto r = (2 * rand() / RAND_MAX) - 1;
+  const double r = 2. * rand() / RAND_MAX - 1;
   auto deviation = heading_filter.Update(noise_mag * r);
   return Angle::Degrees(deviation).AsDelta();
 }
@@ -60,6 +60,13 @@ struct AvailableFile {
   */
   std::array<std::byte, 32> sha256_hash;
 
+  /**
+   * Absolute HTTP URI of a chunk manifest (see Net::ChunkManifest)
+   * which allows updating an existing copy incrementally.  Empty if
+   * the repository does not provide one.
+   */
+  std::string chunks_uri;
+
   bool IsEmpty() const {
     return name.empty();
   }
@@ -84,6 +91,7 @@ struct AvailableFile {
     type = FileType::UNKNOWN;
     update_date = BrokenDate::Invalid();
     sha256_hash.fill(std::byte{0});
+    chunks_uri.clear();
   }
 
   const char *GetName() const {
@@ -97,6 +105,13 @@ struct AvailableFile {
   const char *GetArea() const {
     return area;
   }
+
+  /**
+   * @return the chunk manifest URI or nullptr if there is none
+   */
+  const char *GetChunksURI() const {
+    return chunks_uri.empty() ? nullptr : chunks_uri.c_str();
+  }
 };
 
 #endif
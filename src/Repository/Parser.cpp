@@ -108,6 +108,8 @@ ParseFileRepository(FileRepository &repository, NLineReader &reader)
       int year, month, day;
       if (sscanf(value, "%04u-%02u-%02u", &year, &month, &day) == 3)
         file.update_date = BrokenDate(year, month, day);
+    } else if (StringIsEqual(name, "chunks")) {
+      file.chunks_uri.assign(value);
     } else if (StringIsEqual(name, "sha256")) {
       try {
         file.sha256_hash = ParseHexString<32>(std::string_view(value));
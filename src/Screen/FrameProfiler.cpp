@@ -0,0 +1,177 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "FrameProfiler.hpp"
+#include "LogFile.hpp"
+
+#include <algorithm>
+#include <bit>
+
+using std::chrono::microseconds;
+
+void
+FrameProfiler::Histogram::Clear() noexcept
+{
+  slots.fill(0);
+  count = 0;
+  total = max = {};
+}
+
+void
+FrameProfiler::Histogram::Add(microseconds duration) noexcept
+{
+  const uint64_t us = std::max<int64_t>(duration.count(), 0);
+  const unsigned slot = std::min<unsigned>(std::bit_width(us >> 6),
+                                           N_SLOTS - 1);
+  ++slots[slot];
+  ++count;
+  total += duration;
+  max = std::max(max, duration);
+}
+
+microseconds
+FrameProfiler::Histogram::GetPercentile(double fraction) const noexcept
+{
+  if (count == 0)
+    return {};
+
+  const uint32_t n = std::max<uint32_t>(count * fraction, 1);
+
+  uint32_t sum = 0;
+  for (unsigned i = 0; i + 1 < N_SLOTS; ++i) {
+    sum += slots[i];
+    if (sum >= n)
+      return std::min(microseconds{64 << i}, max);
+  }
+
+  return max;
+}
+
+void
+FrameProfiler::SetEnabled(bool _enabled) noexcept
+{
+  if (_enabled == enabled)
+    return;
+
+  const std::lock_guard<Mutex> lock(mutex);
+  enabled = _enabled;
+  Clear();
+}
+
+void
+FrameProfiler::Clear() noexcept
+{
+  for (auto &i : histograms)
+    i.Clear();
+}
+
+void
+FrameProfiler::Finish() noexcept
+{
+  if (tracing) {
+    TraceEvents::End();
+    tracing = false;
+  }
+
+  if (!enabled)
+    return;
+
+  const auto now = std::chrono::steady_clock::now();
+  frame[unsigned(current)] += now - stage_start;
+  frame[unsigned(Stage::TOTAL)] = now - frame_start;
+
+  const std::lock_guard<Mutex> lock(mutex);
+
+  for (unsigned i = 0; i < N_STAGES; ++i)
+    if (i != unsigned(Stage::FLIP))
+      histograms[i].Add(std::chrono::duration_cast<microseconds>(frame[i]));
+
+  if (histograms[unsigned(Stage::TOTAL)].count >= LOG_INTERVAL) {
+    Log();
+    Clear();
+  }
+}
+
+void
+FrameProfiler::Add(Stage stage, Duration duration) noexcept
+{
+  const std::lock_guard<Mutex> lock(mutex);
+  if (enabled)
+    histograms[unsigned(stage)].Add(std::chrono::duration_cast<microseconds>(duration));
+}
+
+const char *
+FrameProfiler::GetStageName(Stage stage) noexcept
+{
+  switch (stage) {
+  case Stage::TERRAIN:
+    return "Terrain";
+
+  case Stage::TOPOGRAPHY:
+    return "Topography";
+
+  case Stage::AIRSPACE:
+    return "Airspace";
+
+  case Stage::TASK:
+    return "Task";
+
+  case Stage::TRAIL:
+    return "Trail";
+
+  case Stage::TRAFFIC:
+    return "Traffic";
+
+  case Stage::WAYPOINTS:
+    return "Waypoints";
+
+  case Stage::OVERLAYS:
+    return "Overlays";
+
+  case Stage::FLIP:
+    return "Flip";
+
+  case Stage::TOTAL:
+  case Stage::COUNT:
+    break;
+  }
+
+  return "Total";
+}
+
+void
+FrameProfiler::Log() const noexcept
+{
+  for (unsigned i = 0; i < N_STAGES; ++i) {
+    const Histogram &h = histograms[i];
+    if (h.count == 0)
+      continue;
+
+    LogFormat("FrameProfiler '%s': n=%u avg=%lu p50=%lu p90=%lu max=%lu us",
+              GetStageName(Stage(i)), (unsigned)h.count,
+              (unsigned long)h.GetAverage().count(),
+              (unsigned long)h.GetPercentile(0.5).count(),
+              (unsigned long)h.GetPercentile(0.9).count(),
+              (unsigned long)h.max.count());
+  }
+}
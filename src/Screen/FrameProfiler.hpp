@@ -0,0 +1,228 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_SCREEN_FRAME_PROFILER_HPP
+#define XCSOAR_SCREEN_FRAME_PROFILER_HPP
+
+#include "thread/Mutex.hxx"
+#include "thread/TraceEvents.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * Collects the time spent in each stage of rendering the map into
+ * histograms.  Unlike #ScreenStopWatch, this is available in release
+ * builds; it is a cheap no-op while disabled.
+ *
+ * Like #ScreenStopWatch, the draw thread calls Mark() at the start of
+ * each stage (a stage may be entered several times per frame) and
+ * Finish() at the end of the frame.  No glFinish() is done, so on
+ * OpenGL, the numbers are the CPU time of issuing the commands.
+ *
+ * While #TraceEvents is enabled, each stage is also recorded as a
+ * trace event, even if the profiler itself is disabled.
+ */
+class FrameProfiler {
+public:
+  enum class Stage : uint8_t {
+    TERRAIN,
+    TOPOGRAPHY,
+    AIRSPACE,
+    TASK,
+    TRAIL,
+    TRAFFIC,
+    WAYPOINTS,
+    OVERLAYS,
+
+    /**
+     * Copying the finished buffer to the screen.  This is measured
+     * outside of the frame with Add().
+     */
+    FLIP,
+
+    /**
+     * The total of one frame, i.e. all stages except #FLIP.
+     */
+    TOTAL,
+
+    COUNT
+  };
+
+  static constexpr unsigned N_STAGES = unsigned(Stage::COUNT);
+
+  /**
+   * Slot 0 counts durations below 64 microseconds, each following
+   * slot covers twice the range of the previous one; the last one
+   * contains everything above 1 second.
+   */
+  static constexpr unsigned N_SLOTS = 16;
+
+  using Duration = std::chrono::steady_clock::duration;
+
+  struct Histogram {
+    std::array<uint32_t, N_SLOTS> slots;
+
+    uint32_t count;
+
+    std::chrono::microseconds total, max;
+
+    void Clear() noexcept;
+    void Add(std::chrono::microseconds duration) noexcept;
+
+    /**
+     * Returns the upper bound of the slot containing the given
+     * fraction of all samples (e.g. 0.9 for the 90th percentile).
+     */
+    [[gnu::pure]]
+    std::chrono::microseconds GetPercentile(double fraction) const noexcept;
+
+    [[gnu::pure]]
+    std::chrono::microseconds GetAverage() const noexcept {
+      return count > 0 ? total / count : std::chrono::microseconds{};
+    }
+  };
+
+  using Histograms = std::array<Histogram, N_STAGES>;
+
+  /**
+   * Write the histograms to the log file after this number of
+   * frames, and start over.
+   */
+  static constexpr unsigned LOG_INTERVAL = 1000;
+
+private:
+  bool enabled = false;
+
+  /**
+   * Are trace events being recorded for the current frame?  Only
+   * used by the draw thread.
+   */
+  bool tracing = false;
+
+  /**
+   * The stage which is currently being measured; only used by the
+   * draw thread.
+   */
+  Stage current;
+
+  std::chrono::steady_clock::time_point frame_start, stage_start;
+
+  /**
+   * The durations of the current frame; only used by the draw
+   * thread.
+   */
+  std::array<Duration, N_STAGES> frame;
+
+  /**
+   * Protects #histograms.
+   */
+  mutable Mutex mutex;
+
+  Histograms histograms;
+
+public:
+  FrameProfiler() noexcept {
+    Clear();
+  }
+
+  bool IsEnabled() const noexcept {
+    return enabled;
+  }
+
+  /**
+   * Enable or disable the profiler; disabling discards all
+   * histograms.  Must be called by the draw thread outside of a
+   * frame.
+   */
+  void SetEnabled(bool _enabled) noexcept;
+
+  /**
+   * A new frame begins with the given stage.
+   */
+  void Begin(Stage stage) noexcept {
+    tracing = TraceEvents::IsEnabled() &&
+      TraceEvents::Begin(GetStageName(stage));
+
+    if (!enabled)
+      return;
+
+    frame.fill(Duration::zero());
+    current = stage;
+    frame_start = stage_start = std::chrono::steady_clock::now();
+  }
+
+  /**
+   * Switch to another stage.
+   */
+  void Mark(Stage stage) noexcept {
+    if (tracing) {
+      TraceEvents::End();
+      tracing = TraceEvents::Begin(GetStageName(stage));
+    }
+
+    if (!enabled)
+      return;
+
+    const auto now = std::chrono::steady_clock::now();
+    frame[unsigned(current)] += now - stage_start;
+    current = stage;
+    stage_start = now;
+  }
+
+  /**
+   * The frame is complete; add its stage durations to the
+   * histograms.
+   */
+  void Finish() noexcept;
+
+  /**
+   * Add a single duration which was measured outside of a frame
+   * (e.g. #Stage::FLIP).  May be called from any thread.
+   */
+  void Add(Stage stage, Duration duration) noexcept;
+
+  /**
+   * Returns a copy of the histograms for displaying them.  May be
+   * called from any thread.
+   */
+  Histograms GetHistograms() const noexcept {
+    const std::lock_guard<Mutex> lock(mutex);
+    return histograms;
+  }
+
+  [[gnu::const]]
+  static const char *GetStageName(Stage stage) noexcept;
+
+private:
+  void Clear() noexcept;
+
+  /**
+   * Write all histograms to the log file.  The caller must hold the
+   * mutex.
+   */
+  void Log() const noexcept;
+};
+
+#endif
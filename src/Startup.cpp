@@ -63,12 +63,16 @@ Copyright_License {
 #include "Computer/GlideComputer.hpp"
 #include "Computer/GlideComputerInterface.hpp"
 #include "Computer/Events.hpp"
+#include "Computer/FlightSnapshot.hpp"
 #include "Monitor/AllMonitors.hpp"
 #include "MergeThread.hpp"
 #include "CalculationThread.hpp"
 #include "Replay/Replay.hpp"
 #include "LocalPath.hpp"
+#include "system/FileUtil.hpp"
+#include "ui/canvas/custom/ResourceImageCache.hpp"
 #include "io/FileCache.hpp"
+#include "thread/ThreadPool.hpp"
 #include "io/async/AsioThread.hpp"
 #include "io/async/GlobalAsioThread.hpp"
 #include "net/http/Init.hpp"
@@ -92,6 +96,10 @@ Copyright_License {
 #include "Operation/VerboseOperationEnvironment.hpp"
 #include "Operation/PluggableOperationEnvironment.hpp"
 #include "Operation/SubOperationEnvironment.hpp"
+#include "Operation/JobOperationEnvironment.hpp"
+#include "Job/Job.hpp"
+#include "Job/Async.hpp"
+#include "ui/event/Notify.hpp"
 #include "Widget/ProgressWidget.hpp"
 #include "PageActions.hpp"
 #include "Weather/Features.hpp"
@@ -109,6 +117,10 @@ Copyright_License {
 
 #include "util/ScopeExit.hxx"
 
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
 #ifdef ENABLE_OPENGL
 #include "ui/canvas/opengl/Globals.hpp"
 #include "ui/canvas/opengl/Dynamic.hpp"
@@ -126,6 +138,19 @@ static GlideComputerEvents *glide_computer_events;
 static AllMonitors *all_monitors;
 static GlideComputerTaskEvents *task_events;
 
+/**
+ * Log how long a startup step took, to find out where startup time
+ * is spent on slow devices.
+ */
+static void
+LogStartupTime(const char *what,
+               std::chrono::steady_clock::duration duration) noexcept
+{
+  const auto ms =
+    std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+  LogFormat("Startup: %s took %u ms", what, unsigned(ms.count()));
+}
+
 static bool
 LoadProfile()
 {
@@ -142,22 +167,115 @@ LoadProfile()
   return true;
 }
 
+/**
+ * Scans the RASP file in a separate thread and passes the store to
+ * the map when it is done.
+ */
+class AsyncRaspLoader final : Job {
+  std::shared_ptr<RaspStore> rasp;
+
+  NullOperationEnvironment env;
+  AsyncJobRunner async;
+  UI::Notify notify{[this]{ OnScanned(); }};
+
+public:
+  explicit AsyncRaspLoader(AllocatedPath &&path) noexcept
+    :rasp(std::make_shared<RaspStore>(std::move(path))) {
+    async.Start(this, env, &notify);
+  }
+
+  ~AsyncRaspLoader() noexcept {
+    if (async.IsBusy()) {
+      async.Cancel();
+      try {
+        async.Wait();
+      } catch (...) {
+      }
+    }
+  }
+
+private:
+  void OnScanned() noexcept {
+    try {
+      async.Wait();
+    } catch (...) {
+      LogError(std::current_exception(), "RASP scan failed");
+      return;
+    }
+
+    /* the user may have downloaded a new file meanwhile */
+    if (DataGlobals::GetRasp() == nullptr)
+      DataGlobals::SetRasp(std::move(rasp));
+  }
+
+  /* virtual methods from class Job */
+  void Run(OperationEnvironment &) override {
+    rasp->ScanAll();
+  }
+};
+
+static AsyncRaspLoader *rasp_loader;
+
+#if !defined(USE_GDI) && !defined(ANDROID)
+
+static AllocatedPath
+GetResourceImageCachePath() noexcept
+{
+  return AllocatedPath::Build(GetCachePath(), _T("images.cache"));
+}
+
 static void
-AfterStartup()
+InitialiseResourceImageCache() noexcept
+try {
+  ResourceImageCache::Initialise(GetResourceImageCachePath());
+} catch (...) {
+  LogError(std::current_exception(), "Failed to load image cache");
+}
+
+static void
+DeinitialiseResourceImageCache() noexcept
 {
   try {
-    const auto lua_path = LocalPath(_T("lua"));
-    Lua::StartFile(AllocatedPath::Build(lua_path, _T("init.lua")));
+    Directory::Create(GetCachePath());
+    ResourceImageCache::Save();
   } catch (...) {
-      LogError(std::current_exception());
+    LogError(std::current_exception(), "Failed to save image cache");
   }
 
-  if (is_simulator()) {
-    InputEvents::processGlideComputer(GCE_STARTUP_SIMULATOR);
-  } else {
-    InputEvents::processGlideComputer(GCE_STARTUP_REAL);
-  }
+  ResourceImageCache::Deinitialise();
+}
+
+#endif
+
+static AllocatedPath
+GetFlightSnapshotPath() noexcept
+{
+  return LocalPath(_T("flight.snapshot"));
+}
 
+/**
+ * If the program was restarted during a flight (e.g. after a crash),
+ * continue that flight from the last #FlightSnapshot.
+ */
+static void
+RestoreFlightSnapshot() noexcept
+try {
+  /* allocated on the heap because it is too large for the stack */
+  const auto snapshot = std::make_unique<FlightSnapshot>();
+  if (!snapshot->Load(GetFlightSnapshotPath(), std::chrono::minutes(30)) ||
+      !snapshot->flight.flying)
+    return;
+
+  ScopeSuspendAllThreads suspend;
+  glide_computer->LoadSnapshot(*snapshot);
+  LogFormat("Restored flight snapshot");
+} catch (...) {
+  LogError(std::current_exception(), "Failed to load flight snapshot");
+}
+
+static void
+AfterStartup()
+{
   const auto defaultTask = LoadDefaultTask(CommonInterface::GetComputerSettings().task,
                                            &way_points);
   if (defaultTask) {
@@ -170,6 +288,10 @@ AfterStartup()
     protected_task_manager->TaskCommit(*defaultTask);
   }
 
+  /* after the default task has been loaded, so its progress can be
+     restored, too */
+  RestoreFlightSnapshot();
+
   task_manager->Resume();
 
   InfoBoxManager::SetDirty();
@@ -177,6 +299,25 @@ AfterStartup()
   ForceCalculation();
 }
 
+void
+LateStartup() noexcept
+{
+  rasp_loader = new AsyncRaspLoader(LocalPath(_T(RASP_FILENAME)));
+
+  try {
+    const auto lua_path = LocalPath(_T("lua"));
+    Lua::StartFile(AllocatedPath::Build(lua_path, _T("init.lua")));
+  } catch (...) {
+      LogError(std::current_exception());
+  }
+
+  if (is_simulator()) {
+    InputEvents::processGlideComputer(GCE_STARTUP_SIMULATOR);
+  } else {
+    InputEvents::processGlideComputer(GCE_STARTUP_REAL);
+  }
+}
+
 void
 MainWindow::LoadTerrain() noexcept
 {
@@ -230,6 +371,8 @@ try {
 bool
 Startup()
 {
+  const auto startup_time = std::chrono::steady_clock::now();
+
   VerboseOperationEnvironment operation;
   operation.SetProgressRange(1024);
 
@@ -237,6 +380,11 @@ Startup()
   Net::DownloadManager::Initialise();
 #endif
 
+#if !defined(USE_GDI) && !defined(ANDROID)
+  /* before creating the main window, which loads the first icons */
+  InitialiseResourceImageCache();
+#endif
+
   // Creates the main window
 
   UI::TopWindowStyle style;
@@ -384,23 +532,85 @@ Startup()
                          CommonInterface::SetComputerSettings(), gp);
   task_manager->SetGlidePolar(gp);
 
-  // Read the topography file(s)
+  /* the topography, the waypoint/airfield info files and the
+     airspace files are independent of each other; read them in
+     parallel (the latter two only need the terrain, which has been
+     set up above) */
   topography = new TopographyStore();
-  {
-    SubOperationEnvironment sub_env(operation, 0, 256);
-    LoadConfiguredTopography(*topography, sub_env);
-  }
 
-  // Read the waypoint files
   {
-    SubOperationEnvironment sub_env(operation, 256, 512);
-    WaypointGlue::LoadWaypoints(way_points, terrain, sub_env);
-  }
+    static constexpr unsigned N_JOBS = 3;
+    static constexpr const char *job_names[N_JOBS] = {
+      "waypoints", "airspace", "topography",
+    };
+
+    JobOperationEnvironment job_operation[N_JOBS] = {
+      JobOperationEnvironment(operation),
+      JobOperationEnvironment(operation),
+      JobOperationEnvironment(operation),
+    };
+
+    std::chrono::steady_clock::duration job_duration[N_JOBS];
+
+    const auto load = [&](unsigned i) noexcept {
+      const auto start = std::chrono::steady_clock::now();
+      auto &env = job_operation[i];
+
+      switch (i) {
+      case 0:
+        // Read the waypoint files
+        {
+          SubOperationEnvironment sub_env(env, 256, 512);
+          WaypointGlue::LoadWaypoints(way_points, terrain, file_cache,
+                                      sub_env);
+        }
+
+        // Read and parse the airfield info file
+        {
+          SubOperationEnvironment sub_env(env, 512, 768);
+          WaypointDetails::ReadFileFromProfile(way_points, sub_env);
+        }
+        break;
+
+      case 1:
+        // Reads the airspace files
+        {
+          SubOperationEnvironment sub_env(env, 768, 1024);
+          ReadAirspace(airspace_database, terrain, file_cache,
+                       computer_settings.pressure, sub_env);
+        }
+        break;
+
+      case 2:
+        // Read the topography file(s)
+        {
+          SubOperationEnvironment sub_env(env, 0, 256);
+          LoadConfiguredTopography(*topography, file_cache, sub_env);
+        }
+        break;
+      }
+
+      job_duration[i] = std::chrono::steady_clock::now() - start;
+    };
+
+    const auto start = std::chrono::steady_clock::now();
+
+    if (const unsigned n_threads = std::min(std::thread::hardware_concurrency(),
+                                            N_JOBS);
+        n_threads > 1) {
+      ThreadPool pool(n_threads);
+      pool.ForEach(N_JOBS, load);
+    } else {
+      for (unsigned i = 0; i < N_JOBS; ++i)
+        load(i);
+    }
 
-  // Read and parse the airfield info file
-  {
-    SubOperationEnvironment sub_env(operation, 512, 768);
-    WaypointDetails::ReadFileFromProfile(way_points, sub_env);
+    LogStartupTime("data files", std::chrono::steady_clock::now() - start);
+    for (unsigned i = 0; i < N_JOBS; ++i)
+      LogStartupTime(job_names[i], job_duration[i]);
+
+    for (auto &i : job_operation)
+      i.ForwardError();
   }
 
   // Set the home waypoint
@@ -413,18 +623,6 @@ Startup()
   device_blackboard->Merge();
   CommonInterface::ReadBlackboardBasic(device_blackboard->Basic());
 
-  // Scan for weather forecast
-  LogFormat("RASP load");
-  auto rasp = std::make_shared<RaspStore>(LocalPath(_T(RASP_FILENAME)));
-  rasp->ScanAll();
-
-  // Reads the airspace files
-  {
-    SubOperationEnvironment sub_env(operation, 768, 1024);
-    ReadAirspace(airspace_database, terrain, computer_settings.pressure,
-                 sub_env);
-  }
-
   {
     const AircraftState aircraft_state =
       ToAircraftState(device_blackboard->Basic(),
@@ -468,7 +666,6 @@ Startup()
 
     map_window->SetTopography(topography);
     map_window->SetTerrain(terrain);
-    map_window->SetRasp(rasp);
 
 #ifdef HAVE_NOAA
     map_window->SetNOAAStore(noaa_store);
@@ -492,6 +689,7 @@ Startup()
 
   // Create the calculation thread
   CreateCalculationThread();
+  calculation_thread->SetSnapshotPath(GetFlightSnapshotPath());
 
   // Find unique ID of this PDA
   ReadAssetNumber();
@@ -510,6 +708,8 @@ Startup()
   if (computer_settings.logger.enable_nmea_logger)
     NMEALogger::enabled = true;
 
+  NMEALogger::compress = computer_settings.logger.compress_nmea_logger;
+
   LogFormat("ProgramStarted");
 
   // Give focus to the map
@@ -528,6 +728,8 @@ Startup()
 #ifdef HAVE_SKYLINES_TRACKING
   if (map_window != nullptr)
     map_window->SetSkyLinesData(&tracking->GetSkyLinesData());
+
+  merge_thread->SetSkyLinesData(&tracking->GetSkyLinesData());
 #endif
 #endif
 
@@ -540,6 +742,8 @@ Startup()
 
   main_window->FinishStartup();
 
+  LogStartupTime("total", std::chrono::steady_clock::now() - startup_time);
+
   return true;
 }
 
@@ -561,6 +765,9 @@ Shutdown()
 
   Lua::StopAllBackground();
 
+  delete rasp_loader;
+  rasp_loader = nullptr;
+
   // Turn off all displays
   global_running = false;
 
@@ -586,6 +793,7 @@ Shutdown()
   // Save settings to profile
   operation.SetText(_("Shutdown, saving profile..."));
   Profile::Save();
+  Profile::Flush();
 
   operation.SetText(_("Shutdown, please wait..."));
 
@@ -620,6 +828,11 @@ Shutdown()
     calculation_thread = nullptr;
   }
 
+  /* the flight snapshot is only useful for continuing a flight; keep
+     it if XCSoar was closed in the air */
+  if (!CommonInterface::Calculated().flight.flying)
+    File::Delete(GetFlightSnapshotPath());
+
   //  Wait for the drawing thread to finish
 #ifndef ENABLE_OPENGL
   LogFormat("Waiting for draw thread");
@@ -724,6 +937,10 @@ Shutdown()
   delete main_window;
   CommonInterface::main_window = nullptr;
 
+#if !defined(USE_GDI) && !defined(ANDROID)
+  DeinitialiseResourceImageCache();
+#endif
+
   CloseLanguageFile();
 
   Display::RestoreOrientation();
@@ -27,6 +27,14 @@ Copyright_License {
 bool
 Startup();
 
+/**
+ * Start the subsystems which are not needed for the first map frame
+ * (the RASP scan, Lua scripts).  Called by the #MainWindow once the
+ * main event loop runs.
+ */
+void
+LateStartup() noexcept;
+
 void
 Shutdown();
 
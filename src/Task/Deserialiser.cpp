@@ -284,8 +284,8 @@ Deserialise(OrderedTaskSettings &data, const ConstDataNode &node)
 
 }
 
-static TaskFactoryType
-GetTaskFactoryType(const ConstDataNode &node)
+TaskFactoryType
+GetTaskFactoryType(const ConstDataNode &node) noexcept
 {
   const TCHAR *type = node.GetAttribute(_T("type"));
   if (type == nullptr)
@@ -22,9 +22,19 @@
 #ifndef DESERIALISER_HPP
 #define DESERIALISER_HPP
 
+#include <cstdint>
+
 class ConstDataNode;
 class Waypoints;
 class OrderedTask;
+enum class TaskFactoryType : uint8_t;
+
+/**
+ * Determine the task type from the "type" attribute of a task node.
+ */
+[[gnu::pure]]
+TaskFactoryType
+GetTaskFactoryType(const ConstDataNode &node) noexcept;
 
 void
 LoadTask(OrderedTask &task, const ConstDataNode &node,
@@ -55,3 +55,15 @@ LoadTask(Path path, const TaskBehaviour &task_behaviour,
   // Return the parsed task
   return task;
 }
+
+TaskFactoryType
+LoadTaskType(Path path)
+{
+  const auto xml_root = XML::ParseFileRoot(path);
+  const ConstDataNodeXML root(xml_root);
+
+  if (!StringIsEqual(root.GetName(), _T("Task")))
+    throw std::runtime_error("Invalid task file");
+
+  return GetTaskFactoryType(root);
+}
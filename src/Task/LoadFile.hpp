@@ -23,12 +23,14 @@
 #ifndef TASK_LOAD_FILE_HPP
 #define TASK_LOAD_FILE_HPP
 
+#include <cstdint>
 #include <memory>
 
 class Path;
 class OrderedTask;
 class Waypoints;
 struct TaskBehaviour;
+enum class TaskFactoryType : uint8_t;
 
 /**
  * Throws on error.
@@ -37,4 +39,14 @@ std::unique_ptr<OrderedTask>
 LoadTask(Path path, const TaskBehaviour &task_behaviour,
          const Waypoints *waypoints=nullptr);
 
+/**
+ * Determine the type of the task in the given file.  Only the root
+ * element is parsed; the turn points are skipped, which makes this
+ * much cheaper than LoadTask() when listing many task files.
+ *
+ * Throws on error.
+ */
+TaskFactoryType
+LoadTaskType(Path path);
+
 #endif
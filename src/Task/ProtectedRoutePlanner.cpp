@@ -50,7 +50,8 @@ ProtectedRoutePlanner::SolveRoute(const AGeoPoint &dest,
                                   const int h_ceiling)
 {
   ExclusiveLease lease(*this);
-  lease->Synchronise(airspaces, warnings, dest, start);
+  if (config.IsAirspaceEnabled())
+    lease->Synchronise(airspaces, warnings, dest, start);
   lease->Solve(dest, start, config, h_ceiling);
 }
 
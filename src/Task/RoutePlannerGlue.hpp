@@ -61,6 +61,10 @@ public:
     planner.ClearReach();
   }
 
+  void SetThreadPool(ThreadPool *thread_pool) noexcept {
+    planner.SetThreadPool(thread_pool);
+  }
+
   void Reset() {
     planner.Reset();
   }
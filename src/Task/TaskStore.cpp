@@ -30,9 +30,12 @@ Copyright_License {
 #include "LocalPath.hpp"
 #include "Language/Language.hpp"
 #include "LogFile.hpp"
+#include "Operation/Operation.hpp"
+#include "thread/ThreadPool.hpp"
 
 #include <algorithm>
 #include <memory>
+#include <thread>
 
 class TaskFileVisitor: public File::Visitor
 {
@@ -52,6 +55,7 @@ public:
       return;
 
     const auto list = task_file->GetList();
+    const auto mtime = File::GetLastModification(path);
 
     // Count the tasks in the task file
     unsigned count = list.size();
@@ -71,7 +75,7 @@ public:
       }
 
       // Add the task to the TaskStore
-      store.emplace_back(path, name.empty() ? path.c_str() : name, i);
+      store.emplace_back(path, name.empty() ? path.c_str() : name, i, mtime);
     }
   } catch (...) {
     LogError(std::current_exception());
@@ -88,7 +92,10 @@ TaskStore::Clear()
 void
 TaskStore::Scan(bool extra)
 {
-  Clear();
+  /* keep the old items, to be able to reuse the tasks which have
+     already been parsed */
+  ItemVector old = std::move(store);
+  store.clear();
 
   // scan files
   TaskFileVisitor tfv(store);
@@ -100,26 +107,33 @@ TaskStore::Scan(bool extra)
   }
 
   std::sort(store.begin(), store.end());
+
+  /* both vectors are sorted by name, which allows a binary search */
+  for (auto &item : store) {
+    for (auto i = std::lower_bound(old.begin(), old.end(), item);
+         i != old.end() && i->task_name == item.task_name; ++i) {
+      if (i->task != nullptr && i->IsSame(item)) {
+        item.task = std::move(i->task);
+        break;
+      }
+    }
+  }
 }
 
 TaskStore::Item::~Item() noexcept = default;
 
-const OrderedTask *
-TaskStore::Item::GetTask(const TaskBehaviour &task_behaviour) noexcept
-{
+std::unique_ptr<OrderedTask>
+TaskStore::Item::Load(const TaskBehaviour &task_behaviour) const noexcept
+try {
+  auto task = TaskFile::GetTask(filename, task_behaviour,
+                                &way_points, task_index);
   if (task != nullptr)
-    return task.get();
-
-  if (valid)
-    task = TaskFile::GetTask(filename, task_behaviour,
-                             &way_points, task_index);
-
-  if (task == nullptr)
-    valid = false;
-  else
     task->UpdateGeometry();
 
-  return task.get();
+  return task;
+} catch (...) {
+  LogError(std::current_exception());
+  return nullptr;
 }
 
 const TCHAR *
@@ -137,5 +151,43 @@ TaskStore::GetPath(unsigned index) const
 const OrderedTask *
 TaskStore::GetTask(unsigned index, const TaskBehaviour &task_behaviour)
 {
-  return store[index].GetTask(task_behaviour);
+  Item &item = store[index];
+
+  {
+    const std::lock_guard<Mutex> lock(mutex);
+    if (item.task != nullptr || !item.valid)
+      return item.task.get();
+  }
+
+  /* parse without holding the lock; if LoadAll() has loaded this
+     item meanwhile, our copy is discarded */
+  auto task = item.Load(task_behaviour);
+
+  const std::lock_guard<Mutex> lock(mutex);
+  if (item.task == nullptr) {
+    if (task == nullptr)
+      item.valid = false;
+    else
+      item.task = std::move(task);
+  }
+
+  return item.task.get();
+}
+
+const OrderedTask *
+TaskStore::GetLoadedTask(unsigned index) const noexcept
+{
+  const std::lock_guard<Mutex> lock(mutex);
+  return store[index].task.get();
+}
+
+void
+TaskStore::LoadAll(const TaskBehaviour &task_behaviour,
+                   OperationEnvironment &env) noexcept
+{
+  ThreadPool pool(std::thread::hardware_concurrency());
+  pool.ForEach(store.size(), [&](unsigned i) noexcept {
+    if (!env.IsCancelled())
+      GetTask(i, task_behaviour);
+  });
 }
@@ -25,13 +25,16 @@ Copyright_License {
 #define TASK_STORE_HPP
 
 #include "system/Path.hpp"
+#include "thread/Mutex.hxx"
 #include "util/tstring.hpp"
 
+#include <chrono>
 #include <memory>
 #include <vector>
 
 struct TaskBehaviour;
 class OrderedTask;
+class OperationEnvironment;
 
 /**
  * Class to load multiple tasks on demand, e.g. for browsing
@@ -44,15 +47,34 @@ public:
     tstring task_name;
     AllocatedPath filename;
     unsigned task_index;
+
+    /**
+     * The modification time of the file when it was scanned.  A
+     * parsed #task is reused by the next Scan() only if this has not
+     * changed.
+     */
+    std::chrono::system_clock::time_point mtime;
+
+    /**
+     * The parsed task, or nullptr if it has not been loaded yet (or
+     * if loading has failed).  Protected by TaskStore::mutex.
+     */
     std::unique_ptr<OrderedTask> task;
+
+    /**
+     * False if loading this task has failed.  Protected by
+     * TaskStore::mutex.
+     */
     bool valid;
 
     Item(Path the_filename,
          tstring::const_pointer _task_name,
-         unsigned _task_index = 0)
+         unsigned _task_index = 0,
+         std::chrono::system_clock::time_point _mtime={})
       :task_name(_task_name),
        filename(the_filename),
        task_index(_task_index),
+       mtime(_mtime),
        valid(true) {}
 
     ~Item() noexcept;
@@ -70,7 +92,22 @@ public:
       return filename;
     }
 
-    const OrderedTask *GetTask(const TaskBehaviour &task_behaviour) noexcept;
+    /**
+     * Parse the task file.  This does not modify the #Item and may be
+     * called from any thread.
+     *
+     * @return the task or nullptr on error
+     */
+    std::unique_ptr<OrderedTask> Load(const TaskBehaviour &task_behaviour) const noexcept;
+
+    /**
+     * Is this the same task in an unmodified file?
+     */
+    [[gnu::pure]]
+    bool IsSame(const Item &other) const noexcept {
+      return task_index == other.task_index && mtime == other.mtime &&
+        filename == other.filename;
+    }
 
     [[gnu::pure]]
     bool operator<(const TaskStore::Item &other) const {
@@ -81,6 +118,13 @@ public:
   typedef std::vector<TaskStore::Item> ItemVector;
 
 private:
+  /**
+   * Protects Item::task and Item::valid, which may be filled by
+   * LoadAll() in another thread.  The #store vector itself must not
+   * be modified while LoadAll() runs.
+   */
+  mutable Mutex mutex;
+
   /**
    * Internal task storage
    */
@@ -88,7 +132,9 @@ private:
 
 public:
   /**
-   * Scan the XCSoarData folder for .tsk files and add them to the TaskStore
+   * Scan the XCSoarData folder for .tsk files and add them to the
+   * TaskStore.  Tasks which have already been parsed are kept if
+   * their file has not been modified since.
    *
    * @param extra scan all "extra" (non-XCSoar) task files, e.g. *.cup
    * and task declarations from *.igc
@@ -134,6 +180,23 @@ public:
    */
   const OrderedTask *GetTask(unsigned index,
                              const TaskBehaviour &task_behaviour);
+
+  /**
+   * Return the task defined by the given index if it has already been
+   * parsed, but do not parse it.
+   */
+  [[gnu::pure]]
+  const OrderedTask *GetLoadedTask(unsigned index) const noexcept;
+
+  /**
+   * Parse all tasks which have not been loaded yet, distributing
+   * the files over a #ThreadPool.  This may be called from a
+   * background thread while the main thread calls GetTask() and
+   * GetLoadedTask(), but Scan() and Clear() must not be called until
+   * it has returned.
+   */
+  void LoadAll(const TaskBehaviour &task_behaviour,
+               OperationEnvironment &env) noexcept;
 };
 
 #endif
@@ -0,0 +1,261 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "ContourLines.hpp"
+#include "Height.hpp"
+#include "RasterTraits.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <array>
+#include <unordered_map>
+
+namespace {
+
+/**
+ * One line segment within a grid cell, connecting the contour
+ * crossings on two of the cell's edges.
+ */
+struct Segment {
+  /**
+   * Identifies the edges (including the contour level), see
+   * MakeEdgeKey().  Two segments sharing an edge key are joined.
+   */
+  std::array<uint64_t, 2> edges;
+
+  std::array<RasterLocation, 2> points;
+};
+
+static constexpr uint32_t NONE = UINT32_MAX;
+
+}
+
+static constexpr int
+FloorDiv(int a, int b) noexcept
+{
+  return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
+
+/**
+ * @param vertical false for the edge from (x,y) to (x+1,y), true
+ * for the edge from (x,y) to (x,y+1)
+ */
+static constexpr uint64_t
+MakeEdgeKey(int level, unsigned x, unsigned y, bool vertical) noexcept
+{
+  return (uint64_t(level + 0x8000) << 44) | (uint64_t(y) << 23) |
+    (uint64_t(x) << 1) | vertical;
+}
+
+/**
+ * Calculate the fine raster location where the contour at #value
+ * crosses the edge from #a to #b.
+ */
+static RasterLocation
+Interpolate(RasterLocation origin, unsigned x, unsigned y, bool vertical,
+            int a, int b, int value) noexcept
+{
+  const unsigned t = (value - a) * int(1u << RasterTraits::SUBPIXEL_BITS) / (b - a);
+
+  RasterLocation p((origin.x + x) << RasterTraits::SUBPIXEL_BITS,
+                   (origin.y + y) << RasterTraits::SUBPIXEL_BITS);
+  if (vertical)
+    p.y += t;
+  else
+    p.x += t;
+  return p;
+}
+
+void
+ContourLines::Append(const ContourLines &src)
+{
+  const uint32_t offset = points.size();
+  points.insert(points.end(), src.points.begin(), src.points.end());
+
+  for (const uint32_t end : src.ends)
+    ends.push_back(offset + end);
+}
+
+void
+ContourLines::Generate(const TerrainHeight *heights,
+                       unsigned width, unsigned height,
+                       RasterLocation origin, unsigned _interval)
+{
+  assert(_interval > 0);
+
+  Reset(_interval);
+
+  if (width < 2 || height < 2)
+    return;
+
+  const int step = interval;
+
+  std::vector<Segment> segments;
+
+  for (unsigned y = 0; y + 1 < height; ++y) {
+    const TerrainHeight *row = heights + y * width;
+
+    for (unsigned x = 0; x + 1 < width; ++x) {
+      /* the corners, clockwise from the top left */
+      const TerrainHeight c[4] = {
+        row[x], row[x + 1], row[x + width + 1], row[x + width],
+      };
+
+      if (c[0].IsSpecial() || c[1].IsSpecial() ||
+          c[2].IsSpecial() || c[3].IsSpecial())
+        continue;
+
+      const int h[4] = {
+        c[0].GetValue(), c[1].GetValue(), c[2].GetValue(), c[3].GetValue(),
+      };
+
+      const int lo = std::min({h[0], h[1], h[2], h[3]});
+      const int hi = std::max({h[0], h[1], h[2], h[3]});
+
+      /* all levels with lo < level <= hi cross this cell */
+      for (int level = FloorDiv(lo, step) + 1,
+             last = FloorDiv(hi, step);
+           level <= last; ++level) {
+        const int value = level * step;
+
+        const unsigned index = (h[0] >= value) | (h[1] >= value) << 1 |
+          (h[2] >= value) << 2 | (h[3] >= value) << 3;
+
+        /* the edges (top, right, bottom, left) and their crossings;
+           each edge is interpolated in the same direction as by
+           the neighbouring cell */
+        const auto edge = [&](unsigned i) -> std::pair<uint64_t, RasterLocation> {
+          switch (i) {
+          case 0:
+            return {MakeEdgeKey(level, x, y, false),
+                    Interpolate(origin, x, y, false, h[0], h[1], value)};
+          case 1:
+            return {MakeEdgeKey(level, x + 1, y, true),
+                    Interpolate(origin, x + 1, y, true, h[1], h[2], value)};
+          case 2:
+            return {MakeEdgeKey(level, x, y + 1, false),
+                    Interpolate(origin, x, y + 1, false, h[3], h[2], value)};
+          default:
+            return {MakeEdgeKey(level, x, y, true),
+                    Interpolate(origin, x, y, true, h[0], h[3], value)};
+          }
+        };
+
+        const auto add = [&](unsigned a, unsigned b){
+          const auto ea = edge(a), eb = edge(b);
+          segments.push_back({{ea.first, eb.first}, {ea.second, eb.second}});
+        };
+
+        if (index == 5 || index == 10) {
+          /* saddle: the cell center decides which corners are
+             connected */
+          const bool center = h[0] + h[1] + h[2] + h[3] >= 4 * value;
+          if ((index == 5) == center) {
+            add(0, 1);
+            add(2, 3);
+          } else {
+            add(3, 0);
+            add(1, 2);
+          }
+        } else {
+          /* exactly two edges have corners on different sides */
+          unsigned crossed[2], n = 0;
+          for (unsigned i = 0; i < 4; ++i) {
+            const bool a = index & (1u << i);
+            const bool b = index & (1u << ((i + 1) % 4));
+            if (a != b)
+              crossed[n++] = i;
+          }
+
+          assert(n == 2);
+          add(crossed[0], crossed[1]);
+        }
+      }
+    }
+  }
+
+  /* join the segments to polylines */
+
+  std::unordered_map<uint64_t, std::array<uint32_t, 2>> by_edge;
+  by_edge.reserve(segments.size() * 2);
+
+  for (uint32_t i = 0; i < segments.size(); ++i) {
+    for (const uint64_t key : segments[i].edges) {
+      auto &slot = by_edge.try_emplace(key, std::array<uint32_t, 2>{NONE, NONE})
+        .first->second;
+      slot[slot[0] == NONE ? 0 : 1] = i;
+    }
+  }
+
+  std::vector<bool> used(segments.size(), false);
+
+  /**
+   * Find the next unused segment after #current sharing the edge
+   * #key, and return its other edge and point.
+   */
+  const auto next = [&](uint32_t &current, uint64_t &key,
+                        RasterLocation &point) -> bool {
+    const auto &slot = by_edge.find(key)->second;
+    const uint32_t other = slot[0] == current ? slot[1] : slot[0];
+    if (other == NONE || used[other])
+      return false;
+
+    used[other] = true;
+    current = other;
+
+    const Segment &s = segments[other];
+    const unsigned far = s.edges[0] == key ? 1 : 0;
+    key = s.edges[far];
+    point = s.points[far];
+    return true;
+  };
+
+  std::vector<RasterLocation> backward;
+
+  for (uint32_t i = 0; i < segments.size(); ++i) {
+    if (used[i])
+      continue;
+
+    used[i] = true;
+
+    const Segment &s = segments[i];
+    RasterLocation point;
+
+    backward.clear();
+    uint32_t current = i;
+    uint64_t key = s.edges[0];
+    while (next(current, key, point))
+      backward.push_back(point);
+
+    points.insert(points.end(), backward.rbegin(), backward.rend());
+    points.push_back(s.points[0]);
+    points.push_back(s.points[1]);
+
+    current = i;
+    key = s.edges[1];
+    while (next(current, key, point))
+      points.push_back(point);
+
+    ends.push_back(points.size());
+  }
+}
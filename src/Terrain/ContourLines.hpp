@@ -0,0 +1,121 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_TERRAIN_CONTOUR_LINES_HPP
+#define XCSOAR_TERRAIN_CONTOUR_LINES_HPP
+
+#include "RasterLocation.hpp"
+#include "util/ConstBuffer.hxx"
+
+#include <cstdint>
+#include <vector>
+
+class TerrainHeight;
+
+/**
+ * Contour lines extracted from a grid of terrain heights, stored as
+ * polylines in fine raster coordinates (see
+ * RasterProjection::UnprojectFine()).
+ */
+class ContourLines {
+  /**
+   * The contour interval [m] these lines were generated for; 0 if
+   * Generate() has not been called yet.
+   */
+  unsigned interval = 0;
+
+  std::vector<RasterLocation> points;
+
+  /**
+   * The end offset of each polyline within #points.
+   */
+  std::vector<uint32_t> ends;
+
+public:
+  unsigned GetInterval() const noexcept {
+    return interval;
+  }
+
+  bool empty() const noexcept {
+    return ends.empty();
+  }
+
+  std::size_t GetPointCount() const noexcept {
+    return points.size();
+  }
+
+  std::size_t GetLineCount() const noexcept {
+    return ends.size();
+  }
+
+  /**
+   * Discard all lines and free the memory.
+   */
+  void Clear() noexcept {
+    interval = 0;
+    points = {};
+    ends = {};
+  }
+
+  /**
+   * Discard all lines, but keep the memory for reuse.
+   */
+  void Reset(unsigned _interval) noexcept {
+    interval = _interval;
+    points.clear();
+    ends.clear();
+  }
+
+  /**
+   * Append all lines of another object.
+   */
+  void Append(const ContourLines &src);
+
+  /**
+   * Replace the contents with contour lines extracted from the given
+   * height grid with the marching squares algorithm.  Cells with a
+   * special corner (water or invalid) are skipped.
+   *
+   * @param heights a row-major array of width*height samples
+   * @param origin the raster location of the first sample
+   * @param interval the contour interval [m]
+   */
+  void Generate(const TerrainHeight *heights,
+                unsigned width, unsigned height,
+                RasterLocation origin, unsigned interval);
+
+  /**
+   * Invoke the function for each polyline, passing a
+   * ConstBuffer<RasterLocation>.
+   */
+  template<typename F>
+  void ForEach(F &&f) const {
+    uint32_t start = 0;
+    for (const uint32_t end : ends) {
+      f(ConstBuffer<RasterLocation>(points.data() + start, end - start));
+      start = end;
+    }
+  }
+};
+
+#endif
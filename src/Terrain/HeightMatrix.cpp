@@ -27,11 +27,83 @@ Copyright_License {
 #ifdef ENABLE_OPENGL
 #include "Geo/GeoBounds.hpp"
 #else
+#include "Scroll.hpp"
 #include "Projection/WindowProjection.hpp"
 #endif
 
+#include "thread/ThreadPool.hpp"
+#include "thread/Mutex.hxx"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+
 #include <cassert>
 
+/**
+ * Runtime switch for ParallelRows(); enabled by default on
+ * multi-core machines.
+ */
+static std::atomic<bool> fill_parallel{std::thread::hardware_concurrency() > 1};
+
+static Mutex fill_pool_mutex;
+static std::unique_ptr<ThreadPool> fill_pool;
+
+void
+HeightMatrix::SetParallel(bool enable) noexcept
+{
+  fill_parallel.store(enable, std::memory_order_relaxed);
+}
+
+/**
+ * Returns the shared #ThreadPool, creating it on the first call.
+ * Returns nullptr if multi-threaded filling is disabled.
+ */
+static ThreadPool *
+GetFillPool() noexcept
+{
+  if (!fill_parallel.load(std::memory_order_relaxed))
+    return nullptr;
+
+  const std::lock_guard<Mutex> lock(fill_pool_mutex);
+  if (!fill_pool)
+    fill_pool = std::make_unique<ThreadPool>(std::thread::hardware_concurrency());
+
+  return fill_pool.get();
+}
+
+/**
+ * Invoke f(y) for each row in [top, bottom), splitting the range into
+ * bands which are processed by the #ThreadPool.  The rows are
+ * independent, because the #RasterMap is only read.
+ */
+template<typename F>
+static void
+ParallelRows(int top, int bottom, F &&f) noexcept
+{
+  const unsigned n_rows = bottom > top ? bottom - top : 0;
+
+  ThreadPool *const pool = GetFillPool();
+  if (pool == nullptr || n_rows < 2) {
+    for (int y = top; y < bottom; ++y)
+      f(y);
+    return;
+  }
+
+  /* a few more bands than threads balances load, because bands
+     outside the map are much faster than others */
+  const unsigned n_bands =
+    std::min(n_rows, 4 * pool->GetConcurrency());
+
+  pool->ForEach(n_bands, [top, n_rows, n_bands, &f](unsigned i){
+    const int band_top = top + i * n_rows / n_bands;
+    const int band_bottom = top + (i + 1) * n_rows / n_bands;
+    for (int y = band_top; y < band_bottom; ++y)
+      f(y);
+  });
+}
+
 void
 HeightMatrix::SetSize(size_t _size)
 {
@@ -66,13 +138,12 @@ HeightMatrix::Fill(const RasterMap &map, const GeoBounds &bounds,
   SetSize(width, height);
 
   const Angle delta_y = bounds.GetHeight() / height;
-  Angle latitude = bounds.GetNorth();
-  for (auto p = data.begin(), end = p + width * height;
-       p != end; p += width, latitude -= delta_y) {
+  ParallelRows(0, height, [&](int y){
+    const Angle latitude = bounds.GetNorth() - delta_y * y;
     map.ScanLine(GeoPoint(bounds.GetWest(), latitude),
                  GeoPoint(bounds.GetEast(), latitude),
-                 p, width, interpolate);
-  }
+                 data.begin() + y * width, width, interpolate);
+  });
 }
 
 #else
@@ -86,13 +157,42 @@ HeightMatrix::Fill(const RasterMap &map, const WindowProjection &projection,
   SetSize((screen_size.width + quantisation_pixels - 1) / quantisation_pixels,
           (screen_size.height + quantisation_pixels - 1) / quantisation_pixels);
 
-  auto p = data.begin();
-  for (unsigned y = 0; y < screen_size.height;
-       y += quantisation_pixels, p += width) {
-    map.ScanLine(projection.ScreenToGeo({0, (int)y}),
-                 projection.ScreenToGeo({(int)screen_size.width, (int)y}),
-                 p, width, interpolate);
-  }
+  FillArea(map, projection, quantisation_pixels,
+           PixelRect(PixelSize(width, height)), interpolate);
+}
+
+void
+HeightMatrix::FillArea(const RasterMap &map,
+                       const WindowProjection &projection,
+                       unsigned quantisation_pixels, const PixelRect &area,
+                       bool interpolate)
+{
+  assert(area.left >= 0);
+  assert(area.top >= 0);
+  assert(area.right <= (int)width);
+  assert(area.bottom <= (int)height);
+
+  if (area.left >= area.right)
+    return;
+
+  /* the samples are placed exactly quantisation_pixels apart in both
+     directions, so a scrolled matrix lines up with a new one */
+  const int q = quantisation_pixels;
+  const int x1 = area.left * q, x2 = area.right * q;
+  const unsigned n = area.right - area.left;
+
+  ParallelRows(area.top, area.bottom, [&](int y){
+    map.ScanLine(projection.ScreenToGeo({x1, y * q}),
+                 projection.ScreenToGeo({x2, y * q}),
+                 data.begin() + y * width + area.left, n, interpolate);
+  });
+}
+
+void
+HeightMatrix::Scroll(int dx, int dy) noexcept
+{
+  ScrollRows([this](int y){ return data.begin() + y * width; },
+             width, height, dx, dy);
 }
 
 #endif
@@ -33,6 +33,7 @@ class RasterMap;
 class GeoBounds;
 #else
 class WindowProjection;
+struct PixelRect;
 #endif
 
 class HeightMatrix {
@@ -51,6 +52,13 @@ protected:
   void SetSize(unsigned width, unsigned height, unsigned quantisation_pixels);
 
 public:
+  /**
+   * Enable or disable filling the matrix with multiple threads.  The
+   * rows are split into bands which are filled in parallel by a small
+   * thread pool; the caller blocks until all of them are done.
+   */
+  static void SetParallel(bool enable) noexcept;
+
 #ifdef ENABLE_OPENGL
   /**
    * Copy values from the #RasterMap to the buffer, north-up only.
@@ -63,6 +71,23 @@ public:
    */
   void Fill(const RasterMap &map, const WindowProjection &map_projection,
             unsigned quantisation_pixels, bool interpolate);
+
+  /**
+   * Copy values from the #RasterMap to the given rectangle of the
+   * buffer (in cells), without changing its size.  The cell
+   * coordinates are relative to the same screen grid as Fill().
+   */
+  void FillArea(const RasterMap &map, const WindowProjection &map_projection,
+                unsigned quantisation_pixels, const PixelRect &area,
+                bool interpolate);
+
+  /**
+   * Move the existing values by the given number of cells: after
+   * this call, the cell (x, y) contains the value which was
+   * previously at (x+dx, y+dy).  The newly exposed cells must be
+   * filled with FillArea() afterwards.
+   */
+  void Scroll(int dx, int dy) noexcept;
 #endif
 
   unsigned GetWidth() const {
@@ -24,14 +24,40 @@ Copyright_License {
 #include "RasterTileCache.hpp"
 #include "Terrain/RasterLocation.hpp"
 
-#include <stdlib.h>
 #include <algorithm>
+#include <cassert>
+
+#include <stdlib.h>
 
 //#define DEBUG_TILE
 #ifdef DEBUG_TILE
 #include <stdio.h>
 #endif
 
+inline RasterTileCache::TileSpan
+RasterTileCache::GetTileSpan(RasterLocation p, int sx, int sy) const noexcept
+{
+  assert(IsInside(p));
+
+  const unsigned tx = p.x / tile_size.x, ty = p.y / tile_size.y;
+  const RasterTile &tile = tiles.Get(tx, ty);
+
+  TileSpan span;
+  span.start = RasterLocation(tx * tile_size.x, ty * tile_size.y);
+  span.end = RasterLocation(std::min(span.start.x + tile_size.x, size.x),
+                            std::min(span.start.y + tile_size.y, size.y));
+
+  /* each line step moves by one pixel towards the far edges of the
+     area, either horizontally or vertically */
+  span.max_steps =
+    (sx > 0 ? span.end.x - 1 - p.x : (sx < 0 ? p.x - span.start.x : 0)) +
+    (sy > 0 ? span.end.y - 1 - p.y : (sy < 0 ? p.y - span.start.y : 0));
+
+  span.max_height = tile.GetMaxHeight();
+  span.loaded = tile.IsLoaded();
+  return span;
+}
+
 bool
 RasterTileCache::FirstIntersection(const SignedRasterLocation origin,
                                    const SignedRasterLocation destination,
@@ -105,13 +131,47 @@ RasterTileCache::FirstIntersection(const SignedRasterLocation origin,
   printf("# fint width %d height %d\n", width, height);
 #endif
 
+  // aircraft height after the given number of steps, if not intersecting
+  const auto glide_height = [&](int steps){
+    const int h = ((steps * slope_fact) >> RASTER_SLOPE_FACT) + h_origin;
+    return can_climb ? std::min(h, h_dest) : h;
+  };
+
+  // early exit if the whole path is above the highest terrain
+  if (std::min(glide_height(0), glide_height(max_steps)) >= max_height + h_safety &&
+      std::max(glide_height(0), glide_height(max_steps)) <= h_ceiling)
+    return false;
+
   // location of last point within ceiling limit that doesnt intersect
   RasterLocation last_clear_location = location;
   int last_clear_h = h_origin;
 
+  /* the tile which was checked last; if "clear_step" is non-zero,
+     the path is known to be above its terrain */
+  TileSpan tile_span;
+  unsigned clear_step = 0;
+
   while (true) {
 
-    if (!step_counter) {
+    if (!step_counter && !intersect_counter &&
+        !tile_span.IsInside(location) && IsInside(location)) {
+      /* if the path stays above the highest terrain of this tile, the
+         following samples within it need no lookup */
+      tile_span = GetTileSpan(location, dx ? sx : 0, dy ? sy : 0);
+      const int h1 = glide_height(total_steps);
+      const int h2 = glide_height(total_steps + tile_span.max_steps);
+      clear_step = std::min(h1, h2) >= tile_span.max_height + h_safety &&
+        std::max(h1, h2) <= h_ceiling
+        ? (tile_span.loaded ? step_fine : step_coarse)
+        : 0;
+    }
+
+    if (!step_counter && !intersect_counter && clear_step > 0 &&
+        tile_span.IsInside(location)) {
+      step_counter = clear_step;
+      last_clear_location = location;
+      last_clear_h = glide_height(total_steps);
+    } else if (!step_counter) {
 
       if (!IsInside(location))
         break; // outside bounds
@@ -24,6 +24,7 @@ Copyright_License {
 #include "Loader.hpp"
 #include "RasterTileCache.hpp"
 #include "RasterProjection.hpp"
+#include "TileStore.hpp"
 #include "ZzipStream.hpp"
 #include "WorldFile.hpp"
 #include "Operation/Operation.hpp"
@@ -177,9 +178,13 @@ TerrainLoader::PutTileData(unsigned index,
                            RasterLocation start, RasterLocation end,
                            const struct jas_matrix &m)
 {
-  if (scan_overview)
+  if (scan_overview) {
     raster_tile_cache.PutOverviewTile(index, start, end, m);
 
+    if (tile_store_writer != nullptr)
+      tile_store_writer->PutTile(index, m);
+  }
+
   if (scan_tiles) {
     const std::lock_guard<SharedMutex> lock(mutex);
     raster_tile_cache.PutTileData(index, m);
@@ -248,9 +253,9 @@ LoadJPG2000(jas_stream_t *in, void *loader)
 }
 
 inline void
-TerrainLoader::LoadJPG2000(struct zzip_dir *dir, const char *path)
+TerrainLoader::LoadJPG2000(ZipArchive &archive, const char *path)
 {
-  const auto in = OpenJasperZzipStream(dir, path);
+  const auto in = OpenJasperZzipStream(archive, path);
   AtScopeExit(in) { jas_stream_close(in); };
   env.SetProgressRange(jas_stream_length(in) / 65536);
   ::LoadJPG2000(in, this);
@@ -258,12 +263,12 @@ TerrainLoader::LoadJPG2000(struct zzip_dir *dir, const char *path)
 
 static bool
 LoadWorldFile(RasterTileCache &tile_cache,
-              struct zzip_dir *dir, const char *path)
+              ZipArchive &archive, const char *path)
 {
   if (path == nullptr)
     return false;
 
-  const auto new_bounds = LoadWorldFile(dir, path, tile_cache.GetSize().x,
+  const auto new_bounds = LoadWorldFile(archive, path, tile_cache.GetSize().x,
                                         tile_cache.GetSize().y);
   bool success = new_bounds.IsValid();
   if (success)
@@ -272,7 +277,7 @@ LoadWorldFile(RasterTileCache &tile_cache,
 }
 
 inline void
-TerrainLoader::LoadOverview(struct zzip_dir *dir,
+TerrainLoader::LoadOverview(ZipArchive &archive,
                             const char *path, const char *world_file)
 {
   assert(scan_overview);
@@ -280,15 +285,17 @@ TerrainLoader::LoadOverview(struct zzip_dir *dir,
   raster_tile_cache.Reset();
 
   try {
-    LoadJPG2000(dir, path);
+    LoadJPG2000(archive, path);
 
     /* if we loaded the JPG2000 file successfully, but no bounds were
        obtained from there, try to load the world file "terrain.j2w" */
     if (!raster_tile_cache.bounds.IsValid() &&
-        !LoadWorldFile(raster_tile_cache, dir, world_file))
+        !LoadWorldFile(raster_tile_cache, archive, world_file))
       /* that failed: without bounds, we can't do anything; give up,
          discard the whole file */
       throw std::runtime_error("No bounds found");
+
+    raster_tile_cache.UpdateMaxHeights();
   } catch (...) {
     raster_tile_cache.Reset();
     throw;
@@ -296,22 +303,53 @@ TerrainLoader::LoadOverview(struct zzip_dir *dir,
 }
 
 void
-LoadTerrainOverview(struct zzip_dir *dir,
+LoadTerrainOverview(ZipArchive &archive,
                     const char *path, const char *world_file,
                     RasterTileCache &raster_tile_cache,
                     bool all,
-                    OperationEnvironment &env)
+                    OperationEnvironment &env,
+                    TerrainTileStoreWriter *tile_store_writer)
 {
   /* fake a mutex - we don't need it for LoadTerrainOverview() */
   SharedMutex mutex;
 
-  TerrainLoader loader(mutex, raster_tile_cache, true, all, env);
-  loader.LoadOverview(dir, path, world_file);
+  TerrainLoader loader(mutex, raster_tile_cache, true, all, env,
+                       tile_store_writer);
+  loader.LoadOverview(archive, path, world_file);
+}
+
+inline bool
+TerrainLoader::LoadTileStore(const TerrainTileStore &tile_store) noexcept
+{
+  bool missing = false;
+
+  for (const unsigned i : raster_tile_cache.request_tiles) {
+    auto &tile = raster_tile_cache.tiles.GetLinear(i);
+    if (!tile.IsRequested())
+      continue;
+
+    const auto *src = tile_store.Get(i, tile.size);
+    if (src == nullptr) {
+      /* not in the store; fall back to the JPEG2000 decoder */
+      missing = true;
+      continue;
+    }
+
+    const std::lock_guard<SharedMutex> lock(mutex);
+    raster_tile_cache.PutTileData(i, src);
+
+    /* don't let the JPEG2000 decoder load it again */
+    tile.ClearRequest();
+  }
+
+  return missing;
 }
 
 inline void
-TerrainLoader::UpdateTiles(struct zzip_dir *dir, const char *path,
-                           SignedRasterLocation p, unsigned radius)
+TerrainLoader::UpdateTiles(ZipArchive &archive, const char *path,
+                           SignedRasterLocation p, unsigned radius,
+                           const TerrainTileStore *tile_store,
+                           ConstBuffer<RasterTileCache::PrefetchArea> prefetch)
 {
   assert(!scan_overview);
 
@@ -320,37 +358,46 @@ TerrainLoader::UpdateTiles(struct zzip_dir *dir, const char *path,
        RasterTileCache::PollTiles() calls RasterTile::Unload() */
     const std::lock_guard<SharedMutex> lock(mutex);
 
-    if (!raster_tile_cache.PollTiles(p, radius))
+    if (!raster_tile_cache.PollTiles(p, radius, prefetch))
       /* nothing to do */
       return;
   }
 
   AtScopeExit(this) { raster_tile_cache.FinishTileUpdate(); };
-  LoadJPG2000(dir, path);
+
+  if (tile_store != nullptr && !LoadTileStore(*tile_store))
+    /* all tiles were loaded from the store */
+    return;
+
+  LoadJPG2000(archive, path);
 }
 
 void
-UpdateTerrainTiles(struct zzip_dir *dir, const char *path,
+UpdateTerrainTiles(ZipArchive &archive, const char *path,
                    RasterTileCache &raster_tile_cache, SharedMutex &mutex,
-                   SignedRasterLocation p, unsigned radius)
+                   SignedRasterLocation p, unsigned radius,
+                   const TerrainTileStore *tile_store,
+                   ConstBuffer<RasterTileCache::PrefetchArea> prefetch)
 {
   if (!raster_tile_cache.IsValid())
     return;
 
   NullOperationEnvironment env;
   TerrainLoader loader(mutex, raster_tile_cache, false, true, env);
-  loader.UpdateTiles(dir, path, p, radius);
+  loader.UpdateTiles(archive, path, p, radius, tile_store, prefetch);
 }
 
 void
-UpdateTerrainTiles(struct zzip_dir *dir, const char *path,
+UpdateTerrainTiles(ZipArchive &archive, const char *path,
                    RasterTileCache &raster_tile_cache, SharedMutex &mutex,
                    const RasterProjection &projection,
-                   const GeoPoint &location, double radius)
+                   const GeoPoint &location, double radius,
+                   const TerrainTileStore *tile_store)
 {
   const auto raster_location = projection.ProjectCoarse(location);
 
-  UpdateTerrainTiles(dir, path, raster_tile_cache, mutex,
+  UpdateTerrainTiles(archive, path, raster_tile_cache, mutex,
                      raster_location,
-                     projection.DistancePixelsCoarse(radius));
+                     projection.DistancePixelsCoarse(radius),
+                     tile_store);
 }
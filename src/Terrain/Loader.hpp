@@ -25,15 +25,18 @@ Copyright_License {
 #define XCSOAR_TERRAIN_LOADER_HPP
 
 #include "RasterLocation.hpp"
+#include "RasterTileCache.hpp"
 #include "thread/SharedMutex.hpp"
+#include "util/ConstBuffer.hxx"
 
 #include <cstdint>
 
-struct zzip_dir;
+class ZipArchive;
 struct GeoPoint;
-class RasterTileCache;
 class RasterProjection;
 class OperationEnvironment;
+class TerrainTileStore;
+class TerrainTileStoreWriter;
 
 class TerrainLoader {
   SharedMutex &mutex;
@@ -44,6 +47,12 @@ class TerrainLoader {
 
   OperationEnvironment &env;
 
+  /**
+   * If not nullptr, then all tiles decoded while scanning the
+   * overview are copied to this #TerrainTileStore file.
+   */
+  TerrainTileStoreWriter *const tile_store_writer;
+
   /**
    * The number of remaining segments after the current one.
    */
@@ -52,23 +61,27 @@ class TerrainLoader {
 public:
   TerrainLoader(SharedMutex &_mutex, RasterTileCache &_rtc,
                 bool _scan_overview, bool _scan_all,
-                OperationEnvironment &_env)
+                OperationEnvironment &_env,
+                TerrainTileStoreWriter *_tile_store_writer=nullptr)
     :mutex(_mutex), raster_tile_cache(_rtc),
      scan_overview(_scan_overview),
      scan_tiles(!_scan_overview || _scan_all),
-     env(_env) {}
+     env(_env),
+     tile_store_writer(_tile_store_writer) {}
 
   /**
    * Throws on error.
    */
-  void LoadOverview(struct zzip_dir *dir,
+  void LoadOverview(ZipArchive &archive,
                     const char *path, const char *world_file);
 
   /**
    * Throws on error.
    */
-  void UpdateTiles(struct zzip_dir *dir, const char *path,
-                   SignedRasterLocation p, unsigned radius);
+  void UpdateTiles(ZipArchive &archive, const char *path,
+                   SignedRasterLocation p, unsigned radius,
+                   const TerrainTileStore *tile_store=nullptr,
+                   ConstBuffer<RasterTileCache::PrefetchArea> prefetch=nullptr);
 
   /* callback methods for libjasper (via jas_rtc.cpp) */
 
@@ -91,7 +104,16 @@ private:
   /**
    * Throws on error.
    */
-  void LoadJPG2000(struct zzip_dir *dir, const char *path);
+  void LoadJPG2000(ZipArchive &archive, const char *path);
+
+  /**
+   * Copy all requested tiles from the #TerrainTileStore.
+   *
+   * @return true if there are requested tiles which are not
+   * available in the #TerrainTileStore and need to be decoded from
+   * the JPEG2000 file
+   */
+  bool LoadTileStore(const TerrainTileStore &tile_store) noexcept;
 
   void ParseBounds(const char *data);
 };
@@ -102,53 +124,69 @@ private:
  * @param all load not only overview, but all tiles?  On large files,
  * this is a very expensive operation.  This option was designed for
  * small RASP files only.
+ * @param tile_store_writer if not nullptr, then all decoded tiles are
+ * copied to this #TerrainTileStore file
  */
 void
-LoadTerrainOverview(struct zzip_dir *dir,
+LoadTerrainOverview(ZipArchive &archive,
                     const char *path, const char *world_file,
                     RasterTileCache &raster_tile_cache,
                     bool all,
-                    OperationEnvironment &env);
+                    OperationEnvironment &env,
+                    TerrainTileStoreWriter *tile_store_writer=nullptr);
 
 static inline void
-LoadTerrainOverview(struct zzip_dir *dir,
+LoadTerrainOverview(ZipArchive &archive,
                     RasterTileCache &tile_cache,
-                    OperationEnvironment &env)
+                    OperationEnvironment &env,
+                    TerrainTileStoreWriter *tile_store_writer=nullptr)
 {
-  LoadTerrainOverview(dir, "terrain.jp2", "terrain.j2w",
-                      tile_cache, false, env);
+  LoadTerrainOverview(archive, "terrain.jp2", "terrain.j2w",
+                      tile_cache, false, env, tile_store_writer);
 }
 
 /**
  * Throws on error.
+ *
+ * @param tile_store if not nullptr, then tiles are copied from this
+ * #TerrainTileStore instead of being decoded from the JPEG2000 file
+ * @param prefetch additional areas which are loaded with a lower
+ * priority than the visible area
  */
 void
-UpdateTerrainTiles(struct zzip_dir *dir, const char *path,
+UpdateTerrainTiles(ZipArchive &archive, const char *path,
                    RasterTileCache &raster_tile_cache, SharedMutex &mutex,
-                   SignedRasterLocation p, unsigned radius);
+                   SignedRasterLocation p, unsigned radius,
+                   const TerrainTileStore *tile_store=nullptr,
+                   ConstBuffer<RasterTileCache::PrefetchArea> prefetch=nullptr);
 
 static inline void
-UpdateTerrainTiles(struct zzip_dir *dir,
+UpdateTerrainTiles(ZipArchive &archive,
                    RasterTileCache &tile_cache, SharedMutex &mutex,
-                   SignedRasterLocation p, unsigned radius)
+                   SignedRasterLocation p, unsigned radius,
+                   const TerrainTileStore *tile_store=nullptr,
+                   ConstBuffer<RasterTileCache::PrefetchArea> prefetch=nullptr)
 {
-  UpdateTerrainTiles(dir, "terrain.jp2", tile_cache, mutex, p, radius);
+  UpdateTerrainTiles(archive, "terrain.jp2", tile_cache, mutex, p, radius,
+                     tile_store, prefetch);
 }
 
 void
-UpdateTerrainTiles(struct zzip_dir *dir, const char *path,
+UpdateTerrainTiles(ZipArchive &archive, const char *path,
                    RasterTileCache &raster_tile_cache, SharedMutex &mutex,
                    const RasterProjection &projection,
-                   const GeoPoint &location, double radius);
+                   const GeoPoint &location, double radius,
+                   const TerrainTileStore *tile_store=nullptr);
 
 static inline void
-UpdateTerrainTiles(struct zzip_dir *dir,
+UpdateTerrainTiles(ZipArchive &archive,
                    RasterTileCache &tile_cache, SharedMutex &mutex,
                    const RasterProjection &projection,
-                   const GeoPoint &location, double radius)
+                   const GeoPoint &location, double radius,
+                   const TerrainTileStore *tile_store=nullptr)
 {
-  UpdateTerrainTiles(dir, "terrain.jp2", tile_cache, mutex,
-                     projection, location, radius);
+  UpdateTerrainTiles(archive, "terrain.jp2", tile_cache, mutex,
+                     projection, location, radius, tile_store);
 }
 
 #endif
@@ -259,6 +259,28 @@ RasterBuffer::ScanLineChecked(RasterLocation a, RasterLocation b,
   ScanLine(a, b, buffer, size, interpolate);
 }
 
+int
+RasterBuffer::GetMaxHeight(RasterLocation start,
+                           RasterLocation end) const noexcept
+{
+  assert(end.x <= GetSize().x);
+  assert(end.y <= GetSize().y);
+
+  int result = 0;
+  for (unsigned y = start.y; y < end.y; ++y) {
+    const TerrainHeight *row = data.GetPointerAt(start.x, y);
+    for (unsigned x = start.x; x < end.x; ++x) {
+      const TerrainHeight h = *row++;
+      if (h.IsInvalid())
+        return INT16_MAX;
+
+      result = std::max(result, int(h.GetValueOr0()));
+    }
+  }
+
+  return result;
+}
+
 TerrainHeight
 RasterBuffer::GetMaximum() const noexcept
 {
@@ -105,6 +105,18 @@ public:
 
   gcc_pure
   TerrainHeight GetMaximum() const noexcept;
+
+  /**
+   * Determine the maximum of TerrainHeight::GetValueOr0() within the
+   * given rectangle.
+   *
+   * @param start the top-left corner (inclusive)
+   * @param end the bottom-right corner (exclusive)
+   * @return the maximum height, or INT16_MAX if the rectangle
+   * contains an invalid value
+   */
+  gcc_pure
+  int GetMaxHeight(RasterLocation start, RasterLocation end) const noexcept;
 };
 
 #endif
@@ -48,6 +48,41 @@ RasterMap::GetHeight(const GeoPoint &location) const noexcept
   return raster_tile_cache.GetHeight(pt);
 }
 
+void
+RasterMap::GetHeights(ConstBuffer<GeoPoint> points,
+                      TerrainHeight *buffer) const noexcept
+{
+  /* project in chunks, to avoid allocating a temporary array for
+     the raster locations */
+  constexpr std::size_t CHUNK_SIZE = 64;
+  RasterLocation chunk[CHUNK_SIZE];
+
+  while (!points.empty()) {
+    const std::size_t n = std::min(points.size, CHUNK_SIZE);
+    for (std::size_t i = 0; i < n; ++i)
+      chunk[i] = projection.ProjectCoarse(points[i]);
+
+    raster_tile_cache.GetHeights({chunk, n}, buffer);
+
+    points.skip_front(n);
+    buffer += n;
+  }
+}
+
+void
+RasterMap::GetContours(const GeoBounds &bounds, unsigned interval,
+                       ContourLines &dest) const noexcept
+{
+  const auto nw = projection.ProjectCoarse(bounds.GetNorthWest());
+  const auto se = projection.ProjectCoarse(bounds.GetSouthEast());
+  if (se.x < 0 || se.y < 0)
+    return;
+
+  const RasterLocation start(std::max(nw.x, 0), std::max(nw.y, 0));
+  const RasterLocation end(se.x + 1, se.y + 1);
+  raster_tile_cache.GetContours(start, end, interval, dest);
+}
+
 TerrainHeight
 RasterMap::GetInterpolatedHeight(const GeoPoint &location) const noexcept
 {
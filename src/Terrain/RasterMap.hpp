@@ -110,12 +110,32 @@ public:
   [[gnu::pure]]
   TerrainHeight GetHeight(const GeoPoint &location) const noexcept;
 
+  /**
+   * Determine the non-interpolated heights at many locations, filling
+   * the buffer with one value per location.  This is equivalent to
+   * calling GetHeight() for each of them, but faster, because the
+   * tile lookup is shared by nearby locations.
+   *
+   * @param buffer an array of points.size elements
+   */
+  void GetHeights(ConstBuffer<GeoPoint> points,
+                  TerrainHeight *buffer) const noexcept;
+
   /**
    * Determine the interpolated height at the specified location.
    */
   [[gnu::pure]]
   TerrainHeight GetInterpolatedHeight(const GeoPoint &location) const noexcept;
 
+  /**
+   * Collect the (cached) contour lines of all loaded tiles
+   * intersecting the given area.
+   *
+   * @see RasterTileCache::GetContours()
+   */
+  void GetContours(const GeoBounds &bounds, unsigned interval,
+                   ContourLines &dest) const noexcept;
+
   /**
    * Scan a straight line and fill the buffer with the specified
    * number of samples along the line.
@@ -23,6 +23,8 @@ Copyright_License {
 
 #include "Terrain/RasterRenderer.hpp"
 #include "Terrain/RasterMap.hpp"
+#include "Terrain/SlopeShading.hpp"
+#include "Terrain/Scroll.hpp"
 #include "Math/Constants.hpp"
 #include "util/Clamp.hpp"
 #include "Screen/Layout.hpp"
@@ -34,9 +36,33 @@ Copyright_License {
 #include "Asset.hpp"
 #include "ui/event/Idle.hpp"
 
+#ifdef ENABLE_OPENGL
+#include "ui/canvas/opengl/Texture.hpp"
+#include "ui/canvas/opengl/Shaders.hpp"
+#include "ui/canvas/opengl/Program.hpp"
+#endif
+
 #include <cassert>
 #include <cstdint>
 
+/**
+ * The sun vector for slope shading, scaled to 255.
+ */
+struct SunVector {
+  int x, y, z;
+
+  SunVector(int brightness, const Angle azimuth) noexcept {
+    const Angle fudgeelevation = Angle::Degrees(10) +
+      Angle::Degrees(80.0 / 255.0) * brightness;
+
+    x = (int)(255 * fudgeelevation.fastcosine() * -azimuth.fastsine());
+    y = (int)(255 * fudgeelevation.fastcosine() * -azimuth.fastcosine());
+    z = (int)(255 * fudgeelevation.fastsine());
+  }
+};
+
+#ifndef ENABLE_OPENGL
+
 /**
  * Interpolate between x and y with i/128, i.e. i/(1 << 7).
  *
@@ -52,7 +78,6 @@ MIX(unsigned x, unsigned y, unsigned i)
 /**
  * Shade the given color according to the illumination value.
  *
- * illum = 64: Contour, mixed with 50% brown
  * illum < 0:  Shadow, mixed with up to 50% dark blue
  * illum > 0:  Highlight, mixed with up to 25% yellow
  * illum = 0:  No shading
@@ -61,12 +86,7 @@ gcc_const
 inline RawColor
 TerrainShading(const int illum, RGB8Color color)
 {
-  if (illum == -64) {
-    // brown color mixed in for contours
-    return RawColor(MIX(100, color.Red(), 64),
-                    MIX(70, color.Green(), 64),
-                    MIX(26, color.Blue(), 64));
-  } else if (illum < 0) {
+  if (illum < 0) {
     // shadow to blue
     int x = std::min(63, -illum);
     return RawColor(MIX(0, color.Red(), x),
@@ -82,22 +102,7 @@ TerrainShading(const int illum, RGB8Color color)
     return RawColor(color.Red(), color.Green(), color.Blue());
 }
 
-gcc_const
-static unsigned
-ContourInterval(const unsigned h, const unsigned contour_height_scale)
-{
-  return std::min(254u, h >> contour_height_scale);
-}
-
-gcc_const
-static unsigned
-ContourInterval(const TerrainHeight h, const unsigned contour_height_scale)
-{
-  if (gcc_unlikely(h.IsSpecial()) || h.GetValue() <= 0)
-    return 0;
-
-  return ContourInterval(h.GetValue(), contour_height_scale);
-}
+#endif
 
 RasterRenderer::RasterRenderer()
 {
@@ -110,18 +115,26 @@ RasterRenderer::RasterRenderer()
 
 RasterRenderer::~RasterRenderer()
 {
+#ifdef ENABLE_OPENGL
+  delete ramp_texture;
+  delete height_texture;
+  delete[] height_buffer;
+#else
   delete[] color_table;
   delete image;
-  delete[] contour_column_base;
+  delete[] slope_row;
+#endif
 }
 
 #ifdef ENABLE_OPENGL
 
 gcc_pure
 static unsigned
-GetQuantisation()
+GetQuantisation(bool power_saving)
 {
-  if (IsUserIdle(2000))
+  if (power_saving)
+    return Layout::FastScale(2);
+  else if (IsUserIdle(2000))
     /* full terrain resolution when the user is idle */
     return 1;
   else if (IsUserIdle(1000))
@@ -134,23 +147,33 @@ GetQuantisation()
 }
 
 bool
-RasterRenderer::UpdateQuantisation()
+RasterRenderer::UpdateQuantisation(bool power_saving)
 {
-  quantisation_pixels = GetQuantisation();
+  quantisation_pixels = GetQuantisation(power_saving);
   return quantisation_pixels < last_quantisation_pixels;
 }
 
-const GLTexture &
-RasterRenderer::BindAndGetTexture() const
+#endif
+
+unsigned
+RasterRenderer::GetHeightSlopeFactor() const noexcept
 {
-  return image->BindAndGetTexture();
+  return Clamp((unsigned)pixel_size, 1u,
+               /* this upper limit avoids integer overflows in the "mag"
+                  formula; it effectively limits "dd2" so calculating its
+                  square will not overflow */
+               8192u / (quantisation_effective * quantisation_effective));
 }
 
-#endif
-
 void
-RasterRenderer::ScanMap(const RasterMap &map, const WindowProjection &projection)
+RasterRenderer::ScanMap(const RasterMap &map, const WindowProjection &projection,
+                        bool may_scroll)
 {
+#ifndef ENABLE_OPENGL
+  const unsigned old_quantisation_effective = quantisation_effective;
+  const unsigned old_pixel_size = pixel_size;
+#endif
+
   // Coordinates of the MapWindow center
   const auto p = projection.GetScreenCenter();
   // GeoPoint corresponding to the MapWindow center
@@ -193,78 +216,354 @@ RasterRenderer::ScanMap(const RasterMap &map, const WindowProjection &projection
                      true);
 
   last_quantisation_pixels = quantisation_pixels;
+  height_texture_dirty = true;
 #else
-  height_matrix.Fill(map, projection, quantisation_pixels, true);
+  /* scrolling is only possible if the shading parameters which
+     depend on the map scale are unchanged */
+  scrolled = may_scroll &&
+    quantisation_effective == old_quantisation_effective &&
+    (unsigned)pixel_size == old_pixel_size &&
+    ScrollMap(map, projection);
+
+  if (!scrolled)
+    height_matrix.Fill(map, projection, quantisation_pixels, true);
+
+  last_projection = projection;
 #endif
 }
 
+#ifdef ENABLE_OPENGL
+
+/**
+ * Encode a height value for #OpenGL::terrain_shader: 0 is "invalid",
+ * 1 is water, all other values are the height plus 2 (negative
+ * heights are clipped to 0, like GenerateImage() does on the CPU).
+ */
+gcc_const
+static unsigned
+EncodeTerrainHeight(const TerrainHeight h) noexcept
+{
+  if (h.IsInvalid())
+    return 0;
+
+  if (h.IsSpecial())
+    return 1;
+
+  return std::max(0, (int)h.GetValue()) + 2;
+}
+
+/**
+ * Returns the width of the #RasterRenderer::height_texture buffer,
+ * rounded up so each row is aligned at 4 bytes (the default
+ * GL_UNPACK_ALIGNMENT).
+ */
+static constexpr unsigned
+CorrectedHeightTextureWidth(unsigned width) noexcept
+{
+  return (width + 1) & ~1u;
+}
+
+void
+RasterRenderer::UploadHeightMatrix() noexcept
+{
+  const unsigned width = height_matrix.GetWidth();
+  const unsigned height = height_matrix.GetHeight();
+  const unsigned corrected_width = CorrectedHeightTextureWidth(width);
+
+  if (height_texture == nullptr ||
+      corrected_width > height_texture->GetWidth() ||
+      height > height_texture->GetHeight()) {
+    delete height_texture;
+    delete[] height_buffer;
+
+    const PixelSize size(corrected_width, height);
+    height_buffer = new uint8_t[size.width * size.height * 2];
+    height_texture = new GLTexture(GL_LUMINANCE_ALPHA, size,
+                                   GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE,
+                                   height_buffer);
+
+    /* interpolating between heights would corrupt the encoding */
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  } else
+    height_texture->Bind();
+
+  /* low byte in the luminance channel, high byte in the alpha
+     channel */
+  uint8_t *p = height_buffer;
+  for (unsigned y = 0; y < height; ++y) {
+    const auto *src = height_matrix.GetRow(y);
+    for (unsigned x = 0; x < width; ++x) {
+      const unsigned e = EncodeTerrainHeight(src[x]);
+      *p++ = e;
+      *p++ = e >> 8;
+    }
+
+    /* repeat the last column in the padding */
+    if (width < corrected_width) {
+      p[0] = p[-2];
+      p[1] = p[-1];
+      p += 2;
+    }
+  }
+
+  glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, corrected_width, height,
+                  GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE, height_buffer);
+
+  height_texture_dirty = false;
+}
+
+void
+RasterRenderer::UploadColorRamp() noexcept
+{
+  static_assert(sizeof(ramp_colors) == 256 * 3, "RGB8Color is not packed");
+
+  if (ramp_texture == nullptr) {
+    ramp_texture = new GLTexture(GL_RGB, PixelSize(256, 1),
+                                 GL_RGB, GL_UNSIGNED_BYTE, ramp_colors);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  } else {
+    ramp_texture->Bind();
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 256, 1,
+                    GL_RGB, GL_UNSIGNED_BYTE, ramp_colors);
+  }
+
+  ramp_texture_dirty = false;
+}
+
+void
+RasterRenderer::GenerateImage(bool do_shading,
+                              unsigned height_scale,
+                              int contrast, int brightness,
+                              const Angle sunazimuth)
+{
+  if (quantisation_effective == 0)
+    do_shading = false;
+
+  /* the image is rendered by OpenGL::terrain_shader in Draw(); all
+     that's left to do here is uploading new heights and choosing the
+     shader parameters */
+
+  if (height_texture_dirty)
+    UploadHeightMatrix();
+
+  if (ramp_texture_dirty)
+    UploadColorRamp();
+
+  shader_parameters.height_factor = 1.f / (1u << height_scale);
+
+  if (do_shading) {
+    const SunVector sun(brightness, sunazimuth);
+    shader_parameters.sun[0] = sun.x;
+    shader_parameters.sun[1] = sun.y;
+    shader_parameters.sun[2] = sun.z;
+    shader_parameters.contrast = contrast;
+    shader_parameters.slope_factor =
+      GetHeightSlopeFactor() * 2 * quantisation_effective;
+    shader_parameters.step = quantisation_effective;
+  } else
+    shader_parameters.contrast = 0;
+}
+
+#else
+
 void
 RasterRenderer::GenerateImage(bool do_shading,
                               unsigned height_scale,
                               int contrast, int brightness,
-                              const Angle sunazimuth,
-                              bool do_contour)
+                              const Angle sunazimuth)
 {
+  const bool was_scrolled = scrolled;
+  scrolled = false;
+
   if (image == nullptr ||
       height_matrix.GetWidth() > image->GetWidth() ||
       height_matrix.GetHeight() > image->GetHeight()) {
     delete image;
     image = new RawBitmap(height_matrix.GetWidth(), height_matrix.GetHeight());
 
-    delete[] contour_column_base;
-    contour_column_base = new unsigned char[height_matrix.GetWidth()];
+    delete[] slope_row;
+    slope_row = new int8_t[height_matrix.GetWidth()];
+
+    image_valid = false;
   }
 
-  if (quantisation_effective == 0) {
+  if (quantisation_effective == 0)
     do_shading = false;
-    do_contour = false;
+
+  const ImageParameters parameters{
+    do_shading, height_scale, contrast, brightness, sunazimuth,
+  };
+
+  if (was_scrolled && image_valid && parameters == last_image) {
+    ScrollImage(height_scale, contrast, brightness, sunazimuth);
+    image->SetDirty();
+    return;
   }
 
-  const unsigned contour_height_scale = do_contour? height_scale * 2 : 16;
+  last_image = parameters;
+  image_valid = true;
+
+  GenerateImageArea(do_shading, height_scale, contrast, brightness,
+                    sunazimuth,
+                    PixelRect(PixelSize(height_matrix.GetWidth(),
+                                        height_matrix.GetHeight())));
+
+  image->SetDirty();
+}
 
-  ContourStart(contour_height_scale);
+void
+RasterRenderer::GenerateImageArea(bool do_shading, unsigned height_scale,
+                                  int contrast, int brightness,
+                                  const Angle sunazimuth,
+                                  const PixelRect &area)
+{
+  if (area.left >= area.right || area.top >= area.bottom)
+    return;
 
   if (do_shading)
     GenerateSlopeImage(height_scale, contrast, brightness,
-                       sunazimuth, contour_height_scale);
+                       sunazimuth, area);
   else
-    GenerateUnshadedImage(height_scale, contour_height_scale);
+    GenerateUnshadedImage(height_scale, area);
+}
 
-  image->SetDirty();
+bool
+RasterRenderer::ScrollMap(const RasterMap &map,
+                          const WindowProjection &projection) noexcept
+{
+  if (!last_projection.IsValid() ||
+      projection.GetScreenSize() != last_projection.GetScreenSize() ||
+      projection.GetScale() != last_projection.GetScale() ||
+      projection.GetScreenAngle() != last_projection.GetScreenAngle())
+    return false;
+
+  /* find out where the new screen corners were on the old screen;
+     this must be the same offset for all corners, or else the
+     projection has changed in a way that can't be scrolled (e.g. the
+     longitude scale after a large latitude change) */
+
+  const PixelSize size = projection.GetScreenSize();
+  const PixelPoint corners[] = {
+    {0, 0},
+    {int(size.width), 0},
+    {0, int(size.height)},
+    {int(size.width), int(size.height)},
+  };
+
+  const PixelPoint offset =
+    last_projection.GeoToScreen(projection.ScreenToGeo(corners[0])) -
+    corners[0];
+  for (const auto &i : corners) {
+    const PixelPoint delta =
+      last_projection.GeoToScreen(projection.ScreenToGeo(i)) - i;
+    if (std::abs(delta.x - offset.x) > 1 ||
+        std::abs(delta.y - offset.y) > 1)
+      return false;
+  }
+
+  /* only whole cells can be reused */
+  const int q = quantisation_pixels;
+  if (offset.x % q != 0 || offset.y % q != 0)
+    return false;
+
+  const int dx = offset.x / q, dy = offset.y / q;
+  const int width = height_matrix.GetWidth();
+  const int height = height_matrix.GetHeight();
+  if (std::abs(dx) >= width || std::abs(dy) >= height)
+    return false;
+
+  height_matrix.Scroll(dx, dy);
+
+  /* fill the newly exposed rows and columns */
+  const PixelRect rows = dy > 0
+    ? PixelRect(0, height - dy, width, height)
+    : PixelRect(0, 0, width, -dy);
+  const int column_top = rows.top == 0 ? rows.bottom : 0;
+  const int column_bottom = rows.top == 0 ? height : rows.top;
+  const PixelRect columns = dx > 0
+    ? PixelRect(width - dx, column_top, width, column_bottom)
+    : PixelRect(0, column_top, -dx, column_bottom);
+
+  if (dy != 0)
+    height_matrix.FillArea(map, projection, quantisation_pixels, rows, true);
+  if (dx != 0)
+    height_matrix.FillArea(map, projection, quantisation_pixels, columns,
+                           true);
+
+  scroll_x = dx;
+  scroll_y = dy;
+  return true;
+}
+
+void
+RasterRenderer::ScrollImage(unsigned height_scale,
+                            int contrast, int brightness,
+                            const Angle sunazimuth)
+{
+  const int width = height_matrix.GetWidth();
+  const int height = height_matrix.GetHeight();
+  const int dx = scroll_x, dy = scroll_y;
+
+  ScrollRows([this](int y){ return image->GetRow(y); },
+             width, height, dx, dy);
+
+  /* regenerate the exposed area, plus a margin next to the old
+     edges, because the slope calculations there were
+     done without the neighbours which are now available; the
+     opposite edges need to be regenerated as well, because they
+     have lost their neighbours */
+  const int margin = std::max(quantisation_effective, 1u);
+  const bool do_shading = last_image.do_shading;
+
+  const auto generate = [&](const PixelRect &area){
+    GenerateImageArea(do_shading, height_scale, contrast, brightness,
+                      sunazimuth, area);
+  };
+
+  if (dy != 0) {
+    const int exposed = std::min(std::abs(dy) + margin, height);
+    const int opposite = std::min(margin, height);
+    if (dy > 0) {
+      generate(PixelRect(0, height - exposed, width, height));
+      generate(PixelRect(0, 0, width, opposite));
+    } else {
+      generate(PixelRect(0, 0, width, exposed));
+      generate(PixelRect(0, height - opposite, width, height));
+    }
+  }
+
+  if (dx != 0) {
+    const int exposed = std::min(std::abs(dx) + margin, width);
+    const int opposite = std::min(margin, width);
+    if (dx > 0) {
+      generate(PixelRect(width - exposed, 0, width, height));
+      generate(PixelRect(0, 0, opposite, height));
+    } else {
+      generate(PixelRect(0, 0, exposed, height));
+      generate(PixelRect(width - opposite, 0, width, height));
+    }
+  }
 }
 
 void
 RasterRenderer::GenerateUnshadedImage(unsigned height_scale,
-                                      const unsigned contour_height_scale)
+                                      const PixelRect &area)
 {
-  const auto *src = height_matrix.GetData();
   const RawColor *oColorBuf = color_table + 64 * 256;
-  RawColor *dest = image->GetTopRow();
-
-  for (unsigned y = height_matrix.GetHeight(); y > 0; --y) {
-    RawColor *p = dest;
-    dest = image->GetNextRow(dest);
 
-    unsigned contour_row_base = ContourInterval(*src, contour_height_scale);
-    unsigned char *contour_this_column_base = contour_column_base;
+  for (unsigned y = area.top; y < (unsigned)area.bottom; ++y) {
+    const auto *row = height_matrix.GetRow(y);
+    const auto *src = row + area.left;
+    RawColor *p = image->GetRow(y) + area.left;
 
-    for (unsigned x = height_matrix.GetWidth(); x > 0; --x) {
+    for (unsigned x = area.left; x < (unsigned)area.right; ++x) {
       const auto e = *src++;
       if (gcc_likely(!e.IsSpecial())) {
         unsigned h = std::max(0, (int)e.GetValue());
-
-        const unsigned contour_interval =
-          ContourInterval(h, contour_height_scale);
-
         h = std::min(254u, h >> height_scale);
-        if (gcc_unlikely((contour_interval != contour_row_base)
-                         || (contour_interval != *contour_this_column_base))) {
-
-          *p++ = oColorBuf[(int)h - 64 * 256];
-          *contour_this_column_base = contour_row_base = contour_interval;
-        } else {
-          *p++ = oColorBuf[h];
-        }
+        *p++ = oColorBuf[h];
       } else if (e.IsWater()) {
         // we're in the water, so look up the color for water
         *p++ = oColorBuf[255];
@@ -272,32 +571,10 @@ RasterRenderer::GenerateUnshadedImage(unsigned height_scale,
         /* outside the terrain file bounds: white background */
         *p++ = RawColor(0xff, 0xff, 0xff);
       }
-      contour_this_column_base++;
-
     }
   }
 }
 
-/**
- * Clip the difference between two adjacent terrain height values to
- * sane bounds.  This works around integer overflows in the
- * GenerateSlopeImage() formula when the map file is broken, avoiding
- * the sqrt() call with a negative argument.
- */
-gcc_const
-static int
-ClipHeightDelta(int d)
-{
-  return Clamp(d, -512, 512);
-}
-
-gcc_const
-static int
-ClipHeightDelta(TerrainHeight a, TerrainHeight b)
-{
-  return ClipHeightDelta(a.GetValue() - b.GetValue());
-}
-
 // JMW: if zoomed right in (e.g. one unit is larger than terrain
 // grid), then increase the step size to be equal to the terrain
 // grid for purposes of calculating slope, to avoid shading problems
@@ -307,7 +584,7 @@ void
 RasterRenderer::GenerateSlopeImage(unsigned height_scale,
                                    int contrast,
                                    const int sx, const int sy, const int sz,
-                                   const unsigned contour_height_scale)
+                                   const PixelRect &area)
 {
   assert(quantisation_effective > 0);
 
@@ -317,19 +594,19 @@ RasterRenderer::GenerateSlopeImage(unsigned height_scale,
   border.right = height_matrix.GetWidth() - quantisation_effective;
   border.bottom = height_matrix.GetHeight() - quantisation_effective;
 
-  const unsigned height_slope_factor =
-    Clamp((unsigned)pixel_size, 1u,
-          /* this upper limit avoids integer overflows in the "mag"
-             formula; it effectively limits "dd2" so calculating its
-             square will not overflow */
-          8192u / (quantisation_effective * quantisation_effective));
+  const SlopeShadingParameters parameters{
+    sx, sy, sz, contrast, GetHeightSlopeFactor(),
+  };
 
-  const auto *src = height_matrix.GetData();
   const RawColor *oColorBuf = color_table + 64 * 256;
 
-  RawColor *dest = image->GetTopRow();
+  /* the columns which are far enough from the left and right edges
+     to use the full step size; their illumination is calculated for
+     the whole row at once */
+  const int inner_left = std::max(area.left, border.left);
+  const int inner_right = std::min(area.right, border.right);
 
-  for (unsigned y = 0; y < height_matrix.GetHeight(); ++y) {
+  for (unsigned y = area.top; y < (unsigned)area.bottom; ++y) {
     const unsigned row_plus_index = y < (unsigned)border.bottom
       ? quantisation_effective
       : height_matrix.GetHeight() - 1 - y;
@@ -341,20 +618,26 @@ RasterRenderer::GenerateSlopeImage(unsigned height_scale,
 
     const unsigned p31 = row_plus_index + row_minus_index;
 
-    RawColor *p = dest;
-    dest = image->GetNextRow(dest);
-
-    unsigned contour_row_base = ContourInterval(*src, contour_height_scale);
-    unsigned char *contour_this_column_base = contour_column_base;
+    const auto *row = height_matrix.GetRow(y);
+    const auto *src = row + area.left;
+    RawColor *p = image->GetRow(y) + area.left;
+
+    if (inner_left < inner_right) {
+      const auto *inner = row + inner_left;
+      CalculateSlopeShadingRow(slope_row + inner_left,
+                               inner - row_minus_offset,
+                               inner + row_plus_offset,
+                               inner - quantisation_effective,
+                               inner + quantisation_effective,
+                               inner_right - inner_left,
+                               2 * quantisation_effective, p31,
+                               parameters);
+    }
 
-    for (unsigned x = 0; x < height_matrix.GetWidth(); ++x, ++src) {
+    for (unsigned x = area.left; x < (unsigned)area.right; ++x, ++src) {
       const auto e = *src;
       if (gcc_likely(!e.IsSpecial())) {
         unsigned h = std::max(0, (int)e.GetValue());
-
-        const unsigned contour_interval =
-          ContourInterval(h, contour_height_scale);
-
         h = std::min(254u, h >> height_scale);
 
         // no need to calculate slope if undefined height or sea level
@@ -390,37 +673,23 @@ RasterRenderer::GenerateSlopeImage(unsigned height_scale,
           /* some "special" terrain value surrounding us (water or
              invalid), skip slope calculation */
           *p++ = oColorBuf[h];
-          contour_this_column_base++;
           continue;
         }
 
-        if (gcc_unlikely((contour_interval != contour_row_base)
-                         || (contour_interval != *contour_this_column_base))) {
+        int sindex;
+        if (gcc_likely(x >= (unsigned)border.left &&
+                       x < (unsigned)border.right)) {
+          sindex = slope_row[x];
+        } else {
+          const int p32 = ClipHeightDelta(h_above, h_below);
+          const int p22 = ClipHeightDelta(h_right, h_left);
 
-          *contour_this_column_base++ = contour_row_base = contour_interval;
-          *p++ = oColorBuf[int(h) - 64 * 256];
-          continue;
+          const unsigned p20 = column_plus_index + column_minus_index;
+
+          sindex = CalculateSlopeShading(p22, p32, p20, p31, parameters);
         }
 
-        const int p32 = ClipHeightDelta(h_above, h_below);
-        const int p22 = ClipHeightDelta(h_right, h_left);
-
-        const unsigned p20 = column_plus_index + column_minus_index;
-
-        const int dd0 = p22 * int(p31);
-        const int dd1 = int(p20) * p32;
-        const unsigned dd2 = p20 * p31 * height_slope_factor;
-        const int num = (int(dd2) * sz + dd0 * sx + dd1 * sy);
-        const unsigned square_mag = dd0 * dd0 + dd1 * dd1 + dd2 * dd2;
-        const unsigned mag = (unsigned)sqrt(square_mag);
-        /* this is a workaround for a SIGFPE (division by zero)
-           observed by our users on some Android devices (e.g. Nexus
-           7), even though we did our best to make sure that the
-           integer arithmetics above can't overflow */
-        /* TODO: debug this problem and replace this workaround */
-        const int sval = num / int(mag|1);
-        const int sindex = (sval - sz) * contrast / 128;
-        *p++ = oColorBuf[int(h) + 256 * Clamp(sindex, -63, 63)];
+        *p++ = oColorBuf[int(h) + 256 * sindex];
       } else if (e.IsWater()) {
         // we're in the water, so look up the color for water
         *p++ = oColorBuf[255];
@@ -428,8 +697,6 @@ RasterRenderer::GenerateSlopeImage(unsigned height_scale,
         /* outside the terrain file bounds: white background */
         *p++ = RawColor(0xff, 0xff, 0xff);
       }
-      contour_this_column_base++;
-
     }
   }
 }
@@ -438,26 +705,37 @@ void
 RasterRenderer::GenerateSlopeImage(unsigned height_scale,
                                    int contrast, int brightness,
                                    const Angle sunazimuth,
-                                   const unsigned contour_height_scale)
+                                   const PixelRect &area)
 {
-  const Angle fudgeelevation = Angle::Degrees(10) +
-    Angle::Degrees(80.0 / 255.0) * brightness;
-
-  const int sx = (int)(255 * fudgeelevation.fastcosine() * -sunazimuth.fastsine());
-  const int sy = (int)(255 * fudgeelevation.fastcosine() * -sunazimuth.fastcosine());
-  const int sz = (int)(255 * fudgeelevation.fastsine());
+  const SunVector sun(brightness, sunazimuth);
 
   GenerateSlopeImage(height_scale, contrast,
-                     sx, sy, sz, contour_height_scale);
+                     sun.x, sun.y, sun.z, area);
 }
 
+#endif
+
 void
 RasterRenderer::PrepareColorTable(const ColorRamp *color_ramp, bool do_water,
                                   unsigned height_scale, int interp_levels)
 {
+#ifdef ENABLE_OPENGL
+  for (unsigned i = 0; i < 255; i++)
+    ramp_colors[i] = ColorRampLookup(i << height_scale, color_ramp,
+                                     NUM_COLOR_RAMP_LEVELS, interp_levels);
+
+  ramp_colors[255] = do_water
+    /* water colours */
+    ? RGB8Color(85, 160, 255)
+    : RGB8Color(255, 255, 255);
+
+  ramp_texture_dirty = true;
+#else
   if (color_table == nullptr)
     color_table = new RawColor[256 * 128];
 
+  image_valid = false;
+
   for (int i = 0; i < 256; i++) {
     for (int mag = -64; mag < 64; mag++) {
       RawColor color;
@@ -483,16 +761,7 @@ RasterRenderer::PrepareColorTable(const ColorRamp *color_ramp, bool do_water,
       color_table[i + (mag + 64) * 256] = color;
     }
   }
-}
-
-void
-RasterRenderer::ContourStart(const unsigned contour_height_scale)
-{
-  // initialise column to first row
-  const auto *src = height_matrix.GetData();
-  unsigned char *col_base = contour_column_base;
-  for (unsigned x = height_matrix.GetWidth(); x > 0; --x)
-    *col_base++ = ContourInterval(*src++, contour_height_scale);
+#endif
 }
 
 void
@@ -501,15 +770,75 @@ RasterRenderer::Draw(Canvas &canvas,
                      bool transparent_white) const
 {
 #ifdef ENABLE_OPENGL
-  if (bounds.IsValid() && bounds.Overlaps(projection.GetScreenBounds()))
-    DrawGeoBitmap(*image,
-                  PixelSize(height_matrix.GetWidth(),
-                            height_matrix.GetHeight()),
-                  bounds,
-                  projection);
+  if (height_texture == nullptr || ramp_texture == nullptr ||
+      !bounds.IsValid() || !bounds.Overlaps(projection.GetScreenBounds()))
+    return;
+
+  const PixelSize allocated = height_texture->GetAllocatedSize();
+  const GLfloat texel_x = 1.f / allocated.width;
+  const GLfloat texel_y = 1.f / allocated.height;
+  const auto &p = shader_parameters;
+
+  OpenGL::terrain_shader->Use();
+  glUniform1f(OpenGL::terrain_height_factor, p.height_factor);
+  glUniform1f(OpenGL::terrain_contrast, p.contrast);
+
+  if (p.contrast > 0) {
+    glUniform2f(OpenGL::terrain_slope_step,
+                p.step * texel_x, p.step * texel_y);
+    glUniform3f(OpenGL::terrain_sun, p.sun[0], p.sun[1], p.sun[2]);
+    glUniform1f(OpenGL::terrain_slope_factor, p.slope_factor);
+  }
+
+  glActiveTexture(GL_TEXTURE1);
+  ramp_texture->Bind();
+  glActiveTexture(GL_TEXTURE0);
+
+  DrawGeoTexture(*height_texture,
+                 PixelSize(height_matrix.GetWidth(),
+                           height_matrix.GetHeight()),
+                 bounds,
+                 projection);
+
+  OpenGL::solid_shader->Use();
 #else
-  image->StretchTo({height_matrix.GetWidth(), height_matrix.GetHeight()},
-                   canvas, projection.GetScreenSize(),
+  const PixelSize src_size(height_matrix.GetWidth(),
+                           height_matrix.GetHeight());
+
+#ifdef USE_MEMORY_CANVAS
+  if (last_projection.IsValid() &&
+      (projection.GetScreenAngle() != last_projection.GetScreenAngle() ||
+       projection.GetScreenSize() != last_projection.GetScreenSize())) {
+    /* the image was rendered with a different (e.g. north-up)
+       projection; rotate it into the screen by mapping three screen
+       corners to image cells */
+    const PixelSize size = projection.GetScreenSize();
+    const PixelSize last_size = last_projection.GetScreenSize();
+    const double fx = 65536. * src_size.width / last_size.width;
+    const double fy = 65536. * src_size.height / last_size.height;
+
+    const auto ToImage = [&](PixelPoint p){
+      const auto q = last_projection.GeoToScreen(projection.ScreenToGeo(p));
+      return DoublePoint2D(q.x * fx, q.y * fy);
+    };
+
+    const auto top_left = ToImage({0, 0});
+    const auto top_right = ToImage({int(size.width), 0});
+    const auto bottom_left = ToImage({0, int(size.height)});
+
+    const IntPoint2D step_x((top_right.x - top_left.x) / size.width,
+                            (top_right.y - top_left.y) / size.width);
+    const IntPoint2D step_y((bottom_left.x - top_left.x) / size.height,
+                            (bottom_left.y - top_left.y) / size.height);
+
+    image->TransformTo(src_size, canvas,
+                       IntPoint2D(top_left.x, top_left.y), step_x, step_y,
+                       transparent_white);
+    return;
+  }
+#endif
+
+  image->StretchTo(src_size, canvas, projection.GetScreenSize(),
                    transparent_white);
 #endif
 }
@@ -25,9 +25,16 @@ Copyright_License {
 #define XCSOAR_RASTER_RENDERER_HPP
 
 #include "Terrain/HeightMatrix.hpp"
+#include "util/Compiler.h"
+
+#include <cstdint>
 
 #ifdef ENABLE_OPENGL
 #include "Geo/GeoBounds.hpp"
+#include "ui/canvas/PortableColor.hpp"
+#else
+#include "Projection/WindowProjection.hpp"
+#include "Math/Angle.hpp"
 #endif
 
 #define NUM_COLOR_RAMP_LEVELS 13
@@ -37,6 +44,7 @@ class Canvas;
 class RasterMap;
 class WindowProjection;
 class RawBitmap;
+struct PixelRect;
 struct RawColor;
 struct ColorRamp;
 
@@ -60,7 +68,7 @@ class RasterRenderer {
    * Step size used for slope calculations.  Slope shading is disabled
    * when this attribute is 0.
    */
-  unsigned quantisation_effective;
+  unsigned quantisation_effective = 0;
 
 #ifdef ENABLE_OPENGL
   /**
@@ -69,16 +77,111 @@ class RasterRenderer {
    * texture has to be redrawn.
    */
   GeoBounds bounds = GeoBounds::Invalid();
+#else
+  /**
+   * The projection used in the last ScanMap() call.  It is used to
+   * check whether the next frame can be obtained by scrolling.
+   */
+  WindowProjection last_projection;
+
+  /**
+   * The number of cells the last ScanMap() call has scrolled the
+   * #HeightMatrix by.  Only valid if #scrolled is set.
+   */
+  int scroll_x, scroll_y;
+
+  /**
+   * Has the last ScanMap() call scrolled the #HeightMatrix instead
+   * of filling it completely?  GenerateImage() may then scroll the
+   * image, too.
+   */
+  bool scrolled = false;
+
+  /**
+   * Does #image contain the result of the last GenerateImage() call
+   * with #last_image?
+   */
+  bool image_valid = false;
+
+  struct ImageParameters {
+    bool do_shading;
+    unsigned height_scale;
+    int contrast, brightness;
+    Angle sunazimuth;
+
+    bool operator==(const ImageParameters &other) const noexcept {
+      return do_shading == other.do_shading &&
+        height_scale == other.height_scale &&
+        contrast == other.contrast && brightness == other.brightness &&
+        sunazimuth == other.sunazimuth;
+    }
+  };
+
+  ImageParameters last_image;
 #endif
 
   HeightMatrix height_matrix;
-  RawBitmap *image = nullptr;
 
-  unsigned char *contour_column_base = nullptr;
+#ifdef ENABLE_OPENGL
+  /**
+   * The #HeightMatrix for #OpenGL::terrain_shader, which renders the
+   * image in Draw().  It is uploaded by GenerateImage() after
+   * ScanMap() has refilled the #HeightMatrix.
+   */
+  GLTexture *height_texture = nullptr;
+
+  /**
+   * Scratch buffer for uploading #height_texture.
+   */
+  uint8_t *height_buffer = nullptr;
+
+  /**
+   * The colors prepared by PrepareColorTable() in a 256x1 texture.
+   */
+  GLTexture *ramp_texture = nullptr;
+
+  /**
+   * The unshaded color of each height index; the last one is
+   * water.
+   */
+  RGB8Color ramp_colors[256];
+
+  bool height_texture_dirty = false, ramp_texture_dirty = false;
+
+  /**
+   * The #OpenGL::terrain_shader uniforms determined by the last
+   * GenerateImage() call.
+   */
+  struct ShaderParameters {
+    float height_factor;
+
+    /**
+     * The slope shading contrast; 0 disables slope shading, and
+     * the following attributes are undefined.
+     */
+    float contrast;
+
+    float sun[3];
+    float slope_factor;
+
+    /**
+     * The slope sample distance in #HeightMatrix cells.
+     */
+    float step;
+  } shader_parameters;
+#else
+  RawBitmap *image = nullptr;
 
-  double pixel_size;
+  /**
+   * Scratch buffer for the illumination indices of one row, see
+   * CalculateSlopeShadingRow().
+   */
+  int8_t *slope_row = nullptr;
 
   RawColor *color_table = nullptr;
+#endif
+
+  double pixel_size = 0;
 
 public:
   RasterRenderer();
@@ -99,24 +202,29 @@ public:
     return height_matrix.GetHeight();
   }
 
-#ifdef ENABLE_OPENGL
   void Invalidate() {
+#ifdef ENABLE_OPENGL
     bounds.SetInvalid();
+#else
+    last_projection = WindowProjection();
+    image_valid = false;
+#endif
   }
 
+#ifdef ENABLE_OPENGL
+
   /**
    * Calculate a new #quantisation_pixels value.
    *
+   * @param power_saving never use the full resolution
    * @return true if the new #quantisation_pixels value is smaller
    * than the previous one (redraw needed)
    */
-  bool UpdateQuantisation();
+  bool UpdateQuantisation(bool power_saving=false);
 
   const GeoBounds &GetBounds() const {
     return bounds;
   }
-
-  const GLTexture &BindAndGetTexture() const;
 #endif
 
   /**
@@ -129,37 +237,67 @@ public:
 
   /**
    * Scan the map and fill the height matrix.
+   *
+   * @param may_scroll true if the #RasterMap has not been modified
+   * since the previous call; if the projection has only been moved
+   * by whole cells, the previous values are then reused and only the
+   * newly exposed cells are scanned (not implemented on OpenGL)
    */
-  void ScanMap(const RasterMap &map, const WindowProjection &projection);
+  void ScanMap(const RasterMap &map, const WindowProjection &projection,
+               bool may_scroll=false);
 
   /**
    * Convert the height matrix into the image.
+   *
+   * On OpenGL, this only uploads the height matrix (if it was
+   * modified) and chooses the shader parameters; the image is
+   * rendered by the GPU in Draw().
    */
   void GenerateImage(bool do_shading,
                      unsigned height_scale, int contrast, int brightness,
-                     const Angle sunazimuth,
-                     bool do_contour);
+                     const Angle sunazimuth);
 
+#ifndef ENABLE_OPENGL
   const RawBitmap &GetImage() const {
     return *image;
   }
+#endif
 
   void Draw(Canvas &canvas, const WindowProjection &projection,
             bool transparent_white=false) const;
 
 protected:
+  /**
+   * The factor applied to the height differences for slope shading,
+   * depending on the map scale.
+   */
+  gcc_pure
+  unsigned GetHeightSlopeFactor() const noexcept;
+
+#ifdef ENABLE_OPENGL
+  void UploadHeightMatrix() noexcept;
+  void UploadColorRamp() noexcept;
+#else
+  /**
+   * Convert a rectangle of the height matrix into the image.
+   */
+  void GenerateImageArea(bool do_shading, unsigned height_scale,
+                         int contrast, int brightness,
+                         const Angle sunazimuth,
+                         const PixelRect &area);
+
   /**
    * Convert the height matrix into the image, without shading.
    */
   void GenerateUnshadedImage(unsigned height_scale,
-                             const unsigned contour_height_scale);
+                             const PixelRect &area);
 
   /**
    * Convert the height matrix into the image, with slope shading.
    */
   void GenerateSlopeImage(unsigned height_scale, int contrast,
                           const int sx, const int sy, const int sz,
-                          const unsigned contour_height_scale);
+                          const PixelRect &area);
 
   /**
    * Convert the height matrix into the image, with slope shading.
@@ -167,11 +305,26 @@ protected:
   void GenerateSlopeImage(unsigned height_scale,
                           int contrast, int brightness,
                           const Angle sunazimuth,
-                          const unsigned contour_height_scale);
+                          const PixelRect &area);
 
 private:
+  /**
+   * Attempt to obtain the new #HeightMatrix by scrolling the old one.
+   *
+   * @return true on success, false if the matrix needs to be filled
+   * completely
+   */
+  bool ScrollMap(const RasterMap &map,
+                 const WindowProjection &projection) noexcept;
 
-  void ContourStart(const unsigned contour_height_scale);
+  /**
+   * Scroll the image like ScrollMap() did with the #HeightMatrix and
+   * regenerate the exposed parts.
+   */
+  void ScrollImage(unsigned height_scale,
+                   int contrast, int brightness,
+                   const Angle sunazimuth);
+#endif
 };
 
 #endif
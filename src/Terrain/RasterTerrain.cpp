@@ -23,10 +23,13 @@ Copyright_License {
 
 #include "RasterTerrain.hpp"
 #include "Loader.hpp"
+#include "TileStore.hpp"
 #include "Profile/Profile.hpp"
 #include "io/ZipArchive.hpp"
 #include "io/FileCache.hpp"
 #include "io/FileOutputStream.hxx"
+#include "system/FileMapping.hpp"
+#include "system/SystemMemory.hpp"
 #include "io/BufferedOutputStream.hxx"
 #include "io/Reader.hxx"
 #include "io/BufferedReader.hxx"
@@ -36,6 +39,13 @@ Copyright_License {
 #include "LogFile.hpp"
 
 static const TCHAR *const terrain_cache_name = _T("terrain");
+static const TCHAR *const terrain_tiles_cache_name = _T("terrain-tiles");
+
+RasterTerrain::RasterTerrain(ZipArchive &&_archive) noexcept
+  :Guard<RasterMap>(map), archive(std::move(_archive)),
+   base_tile_budget(map.GetTileCache().GetTileBudget()) {}
+
+RasterTerrain::~RasterTerrain() noexcept = default;
 
 inline bool
 RasterTerrain::LoadCache(FileCache &cache, Path path)
@@ -59,21 +69,97 @@ RasterTerrain::SaveCache(FileCache &cache, Path path) const
   os->Commit();
 }
 
+inline void
+RasterTerrain::OpenTileStore(FileCache &cache, Path path)
+{
+  auto mapping = cache.Map(terrain_tiles_cache_name, path);
+  if (!mapping)
+    return;
+
+  tile_store = std::make_unique<TerrainTileStore>(std::move(mapping),
+                                                  FileCache::GetHeaderSize(),
+                                                  map.GetTileCache());
+}
+
+inline void
+RasterTerrain::LoadOverview(FileCache &cache, Path path,
+                            OperationEnvironment &operation)
+{
+  std::unique_ptr<FileOutputStream> os;
+  try {
+    os = cache.Save(terrain_tiles_cache_name, path);
+  } catch (...) {
+    LogError(std::current_exception(), "Failed to create terrain tile store");
+  }
+
+  if (!os) {
+    LoadTerrainOverview(archive, map.GetTileCache(), operation);
+    return;
+  }
+
+  BufferedOutputStream bos(*os);
+  TerrainTileStoreWriter writer(bos);
+  LoadTerrainOverview(archive, map.GetTileCache(), operation, &writer);
+
+  try {
+    if (!writer.Finish(map.GetTileCache()))
+      /* incomplete; the FileOutputStream destructor discards it */
+      return;
+
+    bos.Flush();
+    os->Commit();
+    os.reset();
+
+    OpenTileStore(cache, path);
+  } catch (...) {
+    LogError(std::current_exception(), "Failed to save terrain tile store");
+  }
+}
+
+/**
+ * Log the time it took to load the terrain overview, to compare the
+ * startup time on different devices.
+ */
+static void
+LogOverviewTime(const char *how, const PeriodClock &clock) noexcept
+{
+  using namespace std::chrono;
+  const auto ms = duration_cast<milliseconds>(clock.Elapsed()).count();
+  LogFormat("Terrain overview %s in %u ms", how, unsigned(ms));
+}
+
 inline void
 RasterTerrain::Load(Path path, FileCache *cache,
                     OperationEnvironment &operation)
 {
+  PeriodClock clock;
+  clock.Update();
+
   try {
-    if (LoadCache(cache, path))
+    if (LoadCache(cache, path)) {
+      try {
+        OpenTileStore(*cache, path);
+      } catch (...) {
+        LogError(std::current_exception(),
+                 "Failed to open terrain tile store");
+      }
+
+      LogOverviewTime("loaded from cache", clock);
       return;
+    }
   } catch (...) {
     LogError(std::current_exception(), "Failed to load terrain cache");
   }
 
-  LoadTerrainOverview(archive.get(), map.GetTileCache(), operation);
+  if (cache != nullptr)
+    LoadOverview(*cache, path, operation);
+  else
+    LoadTerrainOverview(archive, map.GetTileCache(), operation);
 
   map.UpdateProjection();
 
+  LogOverviewTime("decoded", clock);
+
   if (cache != nullptr) {
     try {
       SaveCache(*cache, path);
@@ -89,6 +175,12 @@ RasterTerrain::OpenTerrain(FileCache *cache, Path path,
 {
   auto rt = std::make_unique<RasterTerrain>(ZipArchive{path});
   rt->Load(path, cache, operation);
+
+  auto &tile_cache = rt->map.GetTileCache();
+  rt->base_tile_budget = tile_cache.CalcTileBudget(SystemAvailableMemory());
+  tile_cache.SetTileBudget(rt->base_tile_budget);
+  LogFormat("Terrain tile budget: %u", tile_cache.GetTileBudget());
+
   return rt;
 }
 
@@ -105,16 +197,77 @@ try {
   return nullptr;
 }
 
+inline void
+RasterTerrain::UpdateTileBudget() noexcept
+{
+  if (!memory_pressure_clock.CheckUpdate(std::chrono::seconds(10)))
+    return;
+
+  auto &tile_cache = map.GetTileCache();
+
+  unsigned budget = base_tile_budget;
+  switch (SystemMemoryPressure()) {
+  case MemoryPressure::NONE:
+    break;
+
+  case MemoryPressure::MODERATE:
+    budget /= 2;
+    break;
+
+  case MemoryPressure::CRITICAL:
+    budget = 0;
+    break;
+  }
+
+  const unsigned old_budget = tile_cache.GetTileBudget();
+  tile_cache.SetTileBudget(budget);
+  if (tile_cache.GetTileBudget() != old_budget)
+    LogFormat("Terrain tile budget: %u", tile_cache.GetTileBudget());
+}
+
+inline void
+RasterTerrain::LogTileStatistics() noexcept
+{
+  if (!statistics_clock.CheckUpdate(std::chrono::minutes(1)))
+    return;
+
+  const auto &statistics = map.GetTileCache().GetStatistics();
+  const unsigned loaded = statistics.loaded - last_statistics.loaded;
+  const unsigned evicted = statistics.evicted - last_statistics.evicted;
+  last_statistics = statistics;
+
+  if (loaded > 0 || evicted > 0)
+    LogFormat("Terrain tiles per minute: %u loaded, %u evicted",
+              loaded, evicted);
+}
+
 bool
-RasterTerrain::UpdateTiles(const GeoPoint &location, double radius) noexcept
+RasterTerrain::UpdateTiles(const GeoPoint &location, double radius,
+                           ConstBuffer<GeoPoint> prefetch) noexcept
 {
   auto &tile_cache = map.GetTileCache();
   if (!tile_cache.IsValid())
     return false;
 
+  UpdateTileBudget();
+  LogTileStatistics();
+
+  const auto &projection = map.GetProjection();
+  const unsigned raster_radius = projection.DistancePixelsCoarse(radius);
+
+  StaticArray<RasterTileCache::PrefetchArea, 8> prefetch_areas;
+  for (const auto &i : prefetch) {
+    if (prefetch_areas.full())
+      break;
+
+    prefetch_areas.append({projection.ProjectCoarse(i), raster_radius});
+  }
+
   try {
-    UpdateTerrainTiles(archive.get(), tile_cache, mutex,
-                       map.GetProjection(), location, radius);
+    UpdateTerrainTiles(archive, tile_cache, mutex,
+                       projection.ProjectCoarse(location), raster_radius,
+                       tile_store.get(),
+                       {prefetch_areas.begin(), prefetch_areas.size()});
   } catch (...) {
     LogError(std::current_exception(), "Failed to update terrain tiles");
   }
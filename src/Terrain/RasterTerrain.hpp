@@ -29,11 +29,14 @@ Copyright_License {
 #include "thread/Guard.hpp"
 #include "system/Path.hpp"
 #include "io/ZipArchive.hpp"
+#include "time/PeriodClock.hpp"
+#include "util/ConstBuffer.hxx"
 
 #include <memory>
 
 class FileCache;
 class OperationEnvironment;
+class TerrainTileStore;
 
 /**
  * Class to manage raster terrain database, potentially with caching
@@ -50,12 +53,33 @@ private:
 
   RasterMap map;
 
+  /**
+   * The pre-decoded tiles from the #FileCache.  If this is nullptr,
+   * then tiles are decoded from the JPEG2000 file.
+   */
+  std::unique_ptr<TerrainTileStore> tile_store;
+
+  /**
+   * The tile budget calculated from the available memory at startup.
+   * It gets reduced temporarily under memory pressure.
+   */
+  unsigned base_tile_budget;
+
+  PeriodClock memory_pressure_clock;
+
+  /**
+   * Used to log the tile statistics once per minute.
+   */
+  PeriodClock statistics_clock;
+  RasterTileCache::TileStatistics last_statistics;
+
 public:
   /**
    * Constructor.  Returns uninitialised object.
    */
-  explicit RasterTerrain(ZipArchive &&_archive) noexcept
-    :Guard<RasterMap>(map), archive(std::move(_archive)) {}
+  explicit RasterTerrain(ZipArchive &&_archive) noexcept;
+
+  ~RasterTerrain() noexcept;
 
   const Serial &GetSerial() const noexcept {
     return map.GetSerial();
@@ -85,9 +109,12 @@ public:
   }
 
   /**
+   * @param prefetch additional locations which are loaded with a
+   * lower priority (using the same radius)
    * @return true if the method shall be called again
    */
-  bool UpdateTiles(const GeoPoint &location, double radius) noexcept;
+  bool UpdateTiles(const GeoPoint &location, double radius,
+                   ConstBuffer<GeoPoint> prefetch=nullptr) noexcept;
 
 private:
   /**
@@ -107,6 +134,27 @@ private:
    */
   void SaveCache(FileCache &cache, Path path) const;
 
+  /**
+   * Throws on error.
+   */
+  void OpenTileStore(FileCache &cache, Path path);
+
+  /**
+   * Adjust the tile budget to the current memory pressure.
+   */
+  void UpdateTileBudget() noexcept;
+
+  void LogTileStatistics() noexcept;
+
+  /**
+   * Load the overview from the JPEG2000 file and generate a
+   * #TerrainTileStore file at the same time.
+   *
+   * Throws on error.
+   */
+  void LoadOverview(FileCache &cache, Path path,
+                    OperationEnvironment &operation);
+
   /**
    * Throws on error.
    */
@@ -67,6 +67,21 @@ RasterTile::CopyFrom(const struct jas_matrix &m) noexcept
     for (unsigned i = 0; i < width; ++i)
       *dest++ = TerrainHeight(src[i]);
   }
+
+  max_height = buffer.GetMaxHeight({0, 0}, size);
+  contours.Clear();
+}
+
+void
+RasterTile::CopyFrom(const TerrainHeight *src) noexcept
+{
+  if (!IsDefined())
+    return;
+
+  buffer.Resize(size);
+  std::copy_n(src, size.Area(), buffer.GetData());
+  max_height = buffer.GetMaxHeight({0, 0}, size);
+  contours.Clear();
 }
 
 TerrainHeight
@@ -133,3 +148,18 @@ RasterTile::VisibilityChanged(IntPoint2D view,
   request = false;
   return CheckTileVisibility(view, view_radius);
 }
+
+bool
+RasterTile::CheckPrefetch(IntPoint2D center, unsigned radius,
+                          unsigned penalty) noexcept
+{
+  if (!IsDefined())
+    return false;
+
+  const unsigned d = CalcDistanceTo(center);
+  if (d > radius)
+    return false;
+
+  distance = std::min(distance, d + penalty);
+  return true;
+}
@@ -27,6 +27,7 @@ Copyright_License {
 #include "RasterTraits.hpp"
 #include "RasterLocation.hpp"
 #include "RasterBuffer.hpp"
+#include "ContourLines.hpp"
 
 struct jas_matrix;
 class BufferedOutputStream;
@@ -48,8 +49,27 @@ public:
 
   bool request;
 
+  /**
+   * The maximum height of the fine data (see
+   * RasterBuffer::GetMaxHeight()), valid only if the tile is loaded.
+   */
+  int16_t max_height = INT16_MAX;
+
+  /**
+   * The maximum height of the overview within this tile's area.  This
+   * is used while the fine data is not loaded.
+   */
+  int16_t overview_max_height = INT16_MAX;
+
   RasterBuffer buffer;
 
+  /**
+   * The contour lines extracted from #buffer, generated on demand
+   * by RasterTileCache::GetContours().  Protected by
+   * RasterTileCache::contour_mutex.
+   */
+  mutable ContourLines contours;
+
 public:
   RasterTile() noexcept = default;
 
@@ -100,14 +120,32 @@ public:
 
   void Unload() noexcept {
     buffer.Reset();
+    contours.Clear();
   }
 
   bool IsLoaded() const noexcept {
     return buffer.IsDefined();
   }
 
+  /**
+   * Returns an upper bound for the heights returned by
+   * RasterTileCache::GetFieldDirect() within this tile (see
+   * TerrainHeight::GetValueOr0()), or INT16_MAX if it contains
+   * invalid values.
+   */
+  int GetMaxHeight() const noexcept {
+    return IsLoaded() ? max_height : overview_max_height;
+  }
+
   void CopyFrom(const struct jas_matrix &m) noexcept;
 
+  /**
+   * Copy already decoded data (e.g. from a #TerrainTileStore).
+   *
+   * @param src an array of size.x*size.y samples
+   */
+  void CopyFrom(const TerrainHeight *src) noexcept;
+
   /**
    * Determine the non-interpolated height at the specified pixel
    * location.
@@ -133,6 +171,18 @@ public:
 
   bool VisibilityChanged(IntPoint2D view, unsigned view_radius) noexcept;
 
+  /**
+   * Check whether this tile is within a prefetch area (see
+   * RasterTileCache::PrefetchArea).  Must be called after
+   * VisibilityChanged().  If yes, then the distance is updated, with
+   * the given penalty added, so the tile gets a lower priority than
+   * the visible ones.
+   *
+   * @return true if the tile is within the prefetch area
+   */
+  bool CheckPrefetch(IntPoint2D center, unsigned radius,
+                     unsigned penalty) noexcept;
+
   void ScanLine(RasterLocation a, RasterLocation b,
                 TerrainHeight *dest, unsigned dest_size,
                 bool interpolate) const noexcept {
@@ -25,6 +25,7 @@ Copyright_License {
 #include "Math/Angle.hpp"
 #include "io/BufferedOutputStream.hxx"
 #include "io/BufferedReader.hxx"
+#include "util/CRC.hpp"
 
 extern "C" {
 #include "jasper/jas_seq.h"
@@ -85,6 +86,23 @@ RasterTileCache::PutTileData(unsigned index,
     return;
 
   tile.CopyFrom(m);
+  InvalidateNeighbourContours(index);
+  max_height = std::max(max_height, int(tile.max_height));
+  ++statistics.loaded;
+}
+
+void
+RasterTileCache::PutTileData(unsigned index,
+                             const TerrainHeight *src) noexcept
+{
+  auto &tile = tiles.GetLinear(index);
+  if (!tile.IsRequested())
+    return;
+
+  tile.CopyFrom(src);
+  InvalidateNeighbourContours(index);
+  max_height = std::max(max_height, int(tile.max_height));
+  ++statistics.loaded;
 }
 
 struct RTDistanceSort {
@@ -102,7 +120,8 @@ struct RTDistanceSort {
 };
 
 bool
-RasterTileCache::PollTiles(SignedRasterLocation p, unsigned radius) noexcept
+RasterTileCache::PollTiles(SignedRasterLocation p, unsigned radius,
+                           ConstBuffer<PrefetchArea> prefetch) noexcept
 {
   /* tiles are usually 256 pixels wide; with a radius smaller than
      that, the (optimized) tile distance calculations may fail;
@@ -114,32 +133,47 @@ RasterTileCache::PollTiles(SignedRasterLocation p, unsigned radius) noexcept
    * Maximum number of tiles loaded at a time, to reduce system load
    * peaks.
    */
-  constexpr unsigned MAX_ACTIVATE = MAX_ACTIVE_TILES > 32
+  const unsigned MAX_ACTIVATE = max_active_tiles > 32
     ? 16
-    : MAX_ACTIVE_TILES / 2;
+    : max_active_tiles / 2;
 
   /* query all tiles; all tiles which are either in range or already
      loaded are added to RequestTiles */
 
   request_tiles.clear();
-  for (int i = tiles.GetSize() - 1; i >= 0 && !request_tiles.full(); --i)
-    if (tiles.GetLinear(i).VisibilityChanged(p, radius))
-      request_tiles.append(i);
+  for (int i = tiles.GetSize() - 1; i >= 0 && !request_tiles.full(); --i) {
+    RasterTile &tile = tiles.GetLinear(i);
+    bool wanted = tile.VisibilityChanged(p, radius);
 
-  /* reduce if there are too many */
+    /* prefetched tiles are sorted behind all visible tiles */
+    for (const auto &area : prefetch)
+      if (tile.CheckPrefetch(area.center, area.radius + 256, radius))
+        wanted = true;
 
-  if (request_tiles.size() > MAX_ACTIVE_TILES) {
-    /* sort by distance */
+    if (wanted)
+      request_tiles.append(i);
+  }
+
+  if (request_tiles.size() > max_active_tiles || !prefetch.empty()) {
+    /* sort by distance; this makes sure that the visible tiles get
+       loaded (and kept) first */
     const RTDistanceSort sort(*this);
     std::sort(request_tiles.begin(), request_tiles.end(), sort);
+  }
 
+  /* reduce if there are too many */
+
+  if (request_tiles.size() > max_active_tiles) {
     /* dispose all tiles which are out of range */
-    for (unsigned i = MAX_ACTIVE_TILES; i < request_tiles.size(); ++i) {
+    for (unsigned i = max_active_tiles; i < request_tiles.size(); ++i) {
       RasterTile &tile = tiles.GetLinear(request_tiles[i]);
-      tile.Unload();
+      if (tile.IsLoaded()) {
+        tile.Unload();
+        ++statistics.evicted;
+      }
     }
 
-    request_tiles.shrink(MAX_ACTIVE_TILES);
+    request_tiles.shrink(max_active_tiles);
   }
 
   /* fill ActiveTiles and request new tiles */
@@ -178,6 +212,125 @@ RasterTileCache::GetHeight(RasterLocation p) const noexcept
   return overview.GetInterpolated(p << (RasterTraits::SUBPIXEL_BITS - RasterTraits::OVERVIEW_BITS));
 }
 
+void
+RasterTileCache::GetHeights(ConstBuffer<RasterLocation> points,
+                            TerrainHeight *buffer) const noexcept
+{
+  /* the pixel range covered by the current tile; it is empty
+     initially, to force a lookup for the first location */
+  RasterLocation tile_start{0, 0}, tile_end{0, 0};
+  const RasterTile *tile = nullptr;
+
+  for (const RasterLocation p : points) {
+    if (p.x >= size.x || p.y >= size.y) {
+      // outside overall bounds
+      *buffer++ = TerrainHeight::Invalid();
+      continue;
+    }
+
+    if (p.x < tile_start.x || p.x >= tile_end.x ||
+        p.y < tile_start.y || p.y >= tile_end.y) {
+      const unsigned tx = p.x / tile_size.x, ty = p.y / tile_size.y;
+      tile_start = RasterLocation(tx * tile_size.x, ty * tile_size.y);
+      tile_end = RasterLocation(tile_start.x + tile_size.x,
+                                tile_start.y + tile_size.y);
+
+      tile = &tiles.Get(tx, ty);
+      if (!tile->IsLoaded())
+        tile = nullptr;
+    }
+
+    *buffer++ = tile != nullptr
+      ? tile->GetHeight(p)
+      // still not found, so go to overview
+      : overview.GetInterpolated(p << (RasterTraits::SUBPIXEL_BITS - RasterTraits::OVERVIEW_BITS));
+  }
+}
+
+void
+RasterTileCache::GenerateContours(const RasterTile &tile,
+                                  unsigned interval) const noexcept
+{
+  assert(tile.IsLoaded());
+
+  /* one extra column and row from the right and bottom neighbours
+     (if loaded), so there are no gaps between the tiles' lines */
+  const unsigned width = tile.size.x + 1, height = tile.size.y + 1;
+
+  const auto fine_height = [this](RasterLocation p) noexcept {
+    if (!IsInside(p))
+      return TerrainHeight::Invalid();
+
+    const RasterTile &t = tiles.Get(p.x / tile_size.x, p.y / tile_size.y);
+    return t.IsLoaded() ? t.GetHeight(p) : TerrainHeight::Invalid();
+  };
+
+  contour_heights.resize(std::size_t(width) * height);
+
+  auto *dest = contour_heights.data();
+  for (unsigned y = 0; y < tile.size.y; ++y) {
+    dest = std::copy_n(tile.buffer.GetDataAt({0, y}), tile.size.x, dest);
+    *dest++ = fine_height({tile.end.x, tile.start.y + y});
+  }
+
+  for (unsigned x = 0; x < width; ++x)
+    *dest++ = fine_height({tile.start.x + x, tile.end.y});
+
+  tile.contours.Generate(contour_heights.data(), width, height,
+                         tile.start, interval);
+}
+
+void
+RasterTileCache::GetContours(RasterLocation start, RasterLocation end,
+                             unsigned interval,
+                             ContourLines &dest) const noexcept
+{
+  assert(interval > 0);
+
+  if (tile_size.x == 0 || tile_size.y == 0)
+    return;
+
+  end.x = std::min(end.x, size.x);
+  end.y = std::min(end.y, size.y);
+  if (start.x >= end.x || start.y >= end.y)
+    return;
+
+  const unsigned tx_end = (end.x - 1) / tile_size.x + 1;
+  const unsigned ty_end = (end.y - 1) / tile_size.y + 1;
+
+  const std::lock_guard lock{contour_mutex};
+
+  for (unsigned ty = start.y / tile_size.y; ty < ty_end; ++ty) {
+    for (unsigned tx = start.x / tile_size.x; tx < tx_end; ++tx) {
+      const RasterTile &tile = tiles.Get(tx, ty);
+      if (!tile.IsLoaded())
+        continue;
+
+      if (tile.contours.GetInterval() != interval)
+        GenerateContours(tile, interval);
+
+      dest.Append(tile.contours);
+    }
+  }
+}
+
+void
+RasterTileCache::InvalidateNeighbourContours(unsigned index) noexcept
+{
+  const unsigned tx = index % tiles.GetWidth();
+  const unsigned ty = index / tiles.GetWidth();
+
+  /* the tiles to the left and above have used this tile's first
+     column or row; the tile diagonally above left its first
+     sample */
+  if (tx > 0)
+    tiles.Get(tx - 1, ty).contours.Clear();
+  if (ty > 0)
+    tiles.Get(tx, ty - 1).contours.Clear();
+  if (tx > 0 && ty > 0)
+    tiles.Get(tx - 1, ty - 1).contours.Clear();
+}
+
 TerrainHeight
 RasterTileCache::GetInterpolatedHeight(RasterLocation l) const noexcept
 {
@@ -227,6 +380,26 @@ RasterTileCache::SetLatLonBounds(double _lon_min, double _lon_max,
                               std::min(lat_min, lat_max)));
 }
 
+void
+RasterTileCache::SetTileBudget(unsigned n) noexcept
+{
+  max_active_tiles = std::clamp(n, MIN_ACTIVE_TILES, MAX_RTC_TILES);
+}
+
+unsigned
+RasterTileCache::CalcTileBudget(std::size_t available_memory) const noexcept
+{
+  if (available_memory == 0 || tile_size.x == 0 || tile_size.y == 0)
+    return DEFAULT_ACTIVE_TILES;
+
+  const std::size_t tile_bytes = std::size_t(tile_size.x) * tile_size.y
+    * sizeof(TerrainHeight);
+
+  /* claim one eighth of the available memory */
+  const std::size_t n = available_memory / 8 / tile_bytes;
+  return std::clamp<std::size_t>(n, MIN_ACTIVE_TILES, MAX_RTC_TILES);
+}
+
 void
 RasterTileCache::Reset() noexcept
 {
@@ -235,9 +408,12 @@ RasterTileCache::Reset() noexcept
   segments.clear();
 
   overview.Reset();
+  max_height = INT16_MAX;
 
   for (auto &i : tiles)
     i.Unload();
+
+  UpdateMemoryUsage();
 }
 
 const RasterTileCache::MarkerSegmentInfo *
@@ -263,17 +439,74 @@ RasterTileCache::FinishTileUpdate() noexcept
   }
 
   ++serial;
+
+  UpdateMemoryUsage();
 }
 
 void
-RasterTileCache::SaveCache(BufferedOutputStream &os) const
+RasterTileCache::UpdateMemoryUsage() noexcept
 {
-  if (!IsValid())
-    throw std::runtime_error("Terrain invalid");
+  if constexpr (!MemoryAccounting::enabled)
+    return;
 
-  assert(bounds.IsValid());
+  unsigned n_loaded = 0;
+  for (const auto &tile : tiles)
+    if (tile.IsLoaded())
+      ++n_loaded;
 
-  /* save metadata */
+  const std::size_t tile_bytes = std::size_t(tile_size.x) * tile_size.y
+    * sizeof(TerrainHeight);
+
+  memory_usage.Update(overview.GetSize().Area() * sizeof(TerrainHeight)
+                      + n_loaded * tile_bytes,
+                      n_loaded);
+}
+
+void
+RasterTileCache::UpdateMaxHeights() noexcept
+{
+  max_height = 0;
+
+  if (!overview.IsDefined()) {
+    max_height = INT16_MAX;
+    return;
+  }
+
+  const auto overview_size = overview.GetSize();
+
+  for (unsigned ty = 0; ty < tiles.GetHeight(); ++ty) {
+    for (unsigned tx = 0; tx < tiles.GetWidth(); ++tx) {
+      RasterTile &tile = tiles.Get(tx, ty);
+
+      /* the pixel area which GetFieldDirect() maps to this tile */
+      const RasterLocation start(tx * tile_size.x, ty * tile_size.y);
+      const RasterLocation end(std::min(start.x + tile_size.x, size.x),
+                               std::min(start.y + tile_size.y, size.y));
+
+      int h = 0;
+      if (start.x < end.x && start.y < end.y) {
+        const RasterLocation o_end(std::min(((end.x - 1) >> RasterTraits::OVERVIEW_BITS) + 1,
+                                            overview_size.x),
+                                   std::min(((end.y - 1) >> RasterTraits::OVERVIEW_BITS) + 1,
+                                            overview_size.y));
+        h = overview.GetMaxHeight(start >> RasterTraits::OVERVIEW_BITS,
+                                  o_end);
+      }
+
+      tile.overview_max_height = h;
+
+      max_height = std::max(max_height, h);
+      if (tile.IsLoaded())
+        max_height = std::max(max_height, int(tile.max_height));
+    }
+  }
+
+  UpdateMemoryUsage();
+}
+
+RasterTileCache::CacheHeader
+RasterTileCache::MakeCacheHeader() const noexcept
+{
   CacheHeader header;
 
   /* zero-fill all implicit padding bytes (to make valgrind happy) */
@@ -285,7 +518,52 @@ RasterTileCache::SaveCache(BufferedOutputStream &os) const
   header.n_tiles = {tiles.GetWidth(), tiles.GetHeight()};
   header.num_marker_segments = segments.size();
   header.bounds = bounds;
+  return header;
+}
+
+bool
+RasterTileCache::CheckCacheHeader(const CacheHeader &header) const noexcept
+{
+  return header.version == CacheHeader::VERSION &&
+    header.size == size &&
+    header.tile_size == tile_size &&
+    header.n_tiles.x == tiles.GetWidth() &&
+    header.n_tiles.y == tiles.GetHeight() &&
+    header.num_marker_segments == segments.size();
+}
+
+uint16_t
+RasterTileCache::CalcCacheChecksum() const noexcept
+{
+  const CacheHeader header = MakeCacheHeader();
+  uint16_t crc = UpdateCRC16CCITT(&header, sizeof(header), 0);
+  crc = UpdateCRC16CCITT(segments.begin(),
+                         sizeof(*segments.begin()) * segments.size(), crc);
 
+  for (unsigned i = 0; i < tiles.GetSize(); ++i) {
+    const auto &tile = tiles.GetLinear(i);
+    if (tile.IsDefined()) {
+      crc = UpdateCRC16CCITT(&i, sizeof(i), crc);
+      crc = UpdateCRC16CCITT(&tile.start, sizeof(tile.start), crc);
+      crc = UpdateCRC16CCITT(&tile.end, sizeof(tile.end), crc);
+    }
+  }
+
+  const size_t overview_size = overview.GetSize().Area();
+  return UpdateCRC16CCITT(overview.GetData(),
+                          sizeof(*overview.GetData()) * overview_size, crc);
+}
+
+void
+RasterTileCache::SaveCache(BufferedOutputStream &os) const
+{
+  if (!IsValid())
+    throw std::runtime_error("Terrain invalid");
+
+  assert(bounds.IsValid());
+
+  /* save metadata */
+  const CacheHeader header = MakeCacheHeader();
   os.Write(&header, sizeof(header));
   os.Write(segments.begin(), sizeof(*segments.begin()) * segments.size());
 
@@ -305,6 +583,10 @@ RasterTileCache::SaveCache(BufferedOutputStream &os) const
   /* save overview */
   size_t overview_size = overview.GetSize().Area();
   os.Write(overview.GetData(), sizeof(*overview.GetData()) * overview_size);
+
+  /* save checksum */
+  const uint16_t crc = CalcCacheChecksum();
+  os.Write(&crc, sizeof(crc));
 }
 
 void
@@ -359,4 +641,12 @@ RasterTileCache::LoadCache(BufferedReader &r)
       overview.GetData(),
       sizeof(*overview.GetData()) * overview_size,
     });
+
+  /* verify checksum */
+  uint16_t crc;
+  r.ReadFull({&crc, sizeof(crc)});
+  if (crc != CalcCacheChecksum())
+    throw std::runtime_error("Terrain cache checksum mismatch");
+
+  UpdateMaxHeights();
 }
@@ -29,10 +29,15 @@ Copyright_License {
 #include "RasterLocation.hpp"
 #include "Geo/GeoBounds.hpp"
 #include "util/StaticArray.hxx"
+#include "util/ConstBuffer.hxx"
 #include "util/Serial.hpp"
+#include "system/MemoryAccounting.hpp"
+#include "thread/Mutex.hxx"
 
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
+#include <vector>
 
 #define RASTER_SLOPE_FACT 12
 
@@ -45,16 +50,22 @@ class RasterTileCache {
   static constexpr unsigned MAX_RTC_TILES = 4096;
 
   /**
-   * The maximum number of tiles which are loaded at a time.  This
-   * must be limited because the amount of memory is finite.
+   * The default number of tiles which are loaded at a time, used
+   * until SetTileBudget() is called.
    */
 #if defined(ANDROID)
-  static constexpr unsigned MAX_ACTIVE_TILES = 128;
+  static constexpr unsigned DEFAULT_ACTIVE_TILES = 128;
 #else
   // desktop: use a lot of memory
-  static constexpr unsigned MAX_ACTIVE_TILES = 512;
+  static constexpr unsigned DEFAULT_ACTIVE_TILES = 512;
 #endif
 
+  /**
+   * The lower limit for SetTileBudget().  Below this, the screen
+   * cannot be covered with fine tiles.
+   */
+  static constexpr unsigned MIN_ACTIVE_TILES = 32;
+
   /**
    * Target number of steps in intersection searches; total distance
    * is shifted by this number of bits
@@ -64,6 +75,8 @@ class RasterTileCache {
 protected:
   friend struct RTDistanceSort;
   friend class TerrainLoader;
+  friend class TerrainTileStore;
+  friend class TerrainTileStoreWriter;
 
   struct MarkerSegmentInfo {
     static constexpr uint16_t NO_TILE = (uint16_t)-1;
@@ -95,8 +108,19 @@ protected:
     }
   };
 
+public:
+  /**
+   * An area whose tiles shall be loaded with a lower priority than
+   * the visible area, because it is likely to become visible soon.
+   */
+  struct PrefetchArea {
+    SignedRasterLocation center;
+    unsigned radius;
+  };
+
+protected:
   struct CacheHeader {
-    static constexpr unsigned VERSION = 0xb;
+    static constexpr unsigned VERSION = 0xc;
 
     unsigned version;
     UnsignedPoint2D size;
@@ -108,6 +132,32 @@ protected:
 
   bool dirty;
 
+  /**
+   * The maximum number of tiles which are loaded at a time.  This
+   * must be limited because the amount of memory is finite.
+   */
+  unsigned max_active_tiles = DEFAULT_ACTIVE_TILES;
+
+public:
+  /**
+   * Counters for tuning the tile budget.
+   */
+  struct TileStatistics {
+    /**
+     * The number of tiles which were loaded.
+     */
+    unsigned loaded = 0;
+
+    /**
+     * The number of loaded tiles which were discarded to stay within
+     * the tile budget.
+     */
+    unsigned evicted = 0;
+  };
+
+protected:
+  TileStatistics statistics;
+
   /**
    * This serial gets updated each time the tiles get loaded or
    * discarded.
@@ -119,6 +169,15 @@ protected:
 
   RasterBuffer overview;
   RasterLocation size;
+
+  /**
+   * An upper bound for all heights returned by GetFieldDirect() (see
+   * TerrainHeight::GetValueOr0()), or INT16_MAX if unknown.  This is
+   * the coarse level of the maximum height pyramid, the fine level
+   * is RasterTile::GetMaxHeight().  It may be larger than necessary
+   * after tiles have been unloaded.
+   */
+  int max_height;
   RasterLocation overview_size_fine;
 
   GeoBounds bounds;
@@ -132,6 +191,22 @@ protected:
    */
   StaticArray<uint16_t, MAX_RTC_TILES> request_tiles;
 
+  /**
+   * Protects RasterTile::contours, which are generated lazily while
+   * the map is only locked for reading (possibly by several threads
+   * at a time).
+   */
+  mutable Mutex contour_mutex;
+
+  /**
+   * Scratch buffer for GenerateContours().  Protected by
+   * #contour_mutex.
+   */
+  mutable std::vector<TerrainHeight> contour_heights;
+
+  [[no_unique_address]]
+  MemoryAccounting::Reporter memory_usage{MemoryAccounting::Account::TERRAIN};
+
 public:
   RasterTileCache() noexcept {
     Reset();
@@ -170,6 +245,20 @@ public:
   gcc_pure
   TerrainHeight GetInterpolatedHeight(RasterLocation p) const noexcept;
 
+  /**
+   * Determine the non-interpolated heights at many pixel locations.
+   * This is equivalent to calling GetHeight() for each of them, but
+   * the tile is only looked up again when a location leaves the
+   * current one, which is much cheaper for nearby locations.
+   *
+   * @param points the pixel positions within the map; may be out of
+   * range
+   * @param buffer an array of points.size elements which receives the
+   * heights
+   */
+  void GetHeights(ConstBuffer<RasterLocation> points,
+                  TerrainHeight *buffer) const noexcept;
+
   /**
    * Scan a straight line and fill the buffer with the specified
    * number of samples along the line.
@@ -181,6 +270,22 @@ public:
                 TerrainHeight *buffer, unsigned size,
                 bool interpolate) const noexcept;
 
+  /**
+   * Collect the contour lines of all loaded tiles which intersect
+   * the given pixel area.  Each tile's lines are extracted only once
+   * per contour interval and cached until the tile gets unloaded.
+   *
+   * This method is thread-safe; the caller only needs to lock the
+   * map for reading.
+   *
+   * @param start the top left pixel of the area
+   * @param end the bottom right pixel of the area (exclusive)
+   * @param interval the contour interval [m]
+   * @param dest the lines are appended here
+   */
+  void GetContours(RasterLocation start, RasterLocation end,
+                   unsigned interval, ContourLines &dest) const noexcept;
+
   bool FirstIntersection(SignedRasterLocation origin,
                          SignedRasterLocation destination,
                          int h_origin,
@@ -209,6 +314,82 @@ private:
   gcc_pure
   std::pair<TerrainHeight, bool> GetFieldDirect(RasterLocation p) const noexcept;
 
+  /**
+   * The part of a line search within one tile.  This is used to skip
+   * terrain lookups while the line is above the tile's highest
+   * terrain.
+   */
+  struct TileSpan {
+    /**
+     * The pixel area which GetFieldDirect() maps to the tile.
+     */
+    RasterLocation start{0, 0}, end{0, 0};
+
+    /**
+     * An upper bound for the number of line steps until the line
+     * leaves the area.
+     */
+    unsigned max_steps;
+
+    /**
+     * See RasterTile::GetMaxHeight().
+     */
+    int max_height;
+
+    /**
+     * Is the tile loaded, i.e. does GetFieldDirect() return fine
+     * data?
+     */
+    bool loaded;
+
+    constexpr bool IsInside(RasterLocation p) const noexcept {
+      return p.x >= start.x && p.x < end.x &&
+        p.y >= start.y && p.y < end.y;
+    }
+  };
+
+  /**
+   * Fill RasterTile::contours of the given (loaded) tile.  The
+   * caller must lock #contour_mutex.
+   */
+  void GenerateContours(const RasterTile &tile,
+                        unsigned interval) const noexcept;
+
+  /**
+   * Discard the contour lines of the tiles whose lines touch the
+   * given tile, after it has been loaded.
+   */
+  void InvalidateNeighbourContours(unsigned index) noexcept;
+
+  /**
+   * Look up the tile containing the given location.
+   *
+   * @param sx the line's horizontal direction (1, -1 or 0)
+   * @param sy the line's vertical direction (1, -1 or 0)
+   */
+  gcc_pure
+  TileSpan GetTileSpan(RasterLocation p, int sx, int sy) const noexcept;
+
+  /**
+   * Generate a #CacheHeader describing the current dimensions.
+   */
+  gcc_pure
+  CacheHeader MakeCacheHeader() const noexcept;
+
+  /**
+   * Does the given #CacheHeader (e.g. from a #TerrainTileStore)
+   * match the current dimensions?
+   */
+  gcc_pure
+  bool CheckCacheHeader(const CacheHeader &header) const noexcept;
+
+  /**
+   * Calculate a checksum of the state stored by SaveCache(), to
+   * detect corrupt cache files.
+   */
+  gcc_pure
+  uint16_t CalcCacheChecksum() const noexcept;
+
 public:
   /**
    * Throws on error.
@@ -239,6 +420,32 @@ public:
 
   void Reset() noexcept;
 
+  unsigned GetTileBudget() const noexcept {
+    return max_active_tiles;
+  }
+
+  /**
+   * Change the maximum number of tiles which are loaded at a time.
+   * The value is clipped to a sane range.  If it is smaller than
+   * the current number of loaded tiles, the next PollTiles() call
+   * discards the most distant ones.
+   */
+  void SetTileBudget(unsigned n) noexcept;
+
+  /**
+   * Calculate a tile budget for the given amount of memory, based
+   * on the tile size of this map.  Only a fraction of the available
+   * memory is claimed, leaving room for the rest of the process.
+   *
+   * @param available_memory the number of bytes or 0 if unknown
+   */
+  [[gnu::pure]]
+  unsigned CalcTileBudget(std::size_t available_memory) const noexcept;
+
+  const TileStatistics &GetStatistics() const noexcept {
+    return statistics;
+  }
+
   const GeoBounds &GetBounds() const noexcept {
     assert(bounds.IsValid());
 
@@ -272,12 +479,40 @@ public:
                        RasterLocation start, RasterLocation end,
                        const struct jas_matrix &m) noexcept;
 
-  bool PollTiles(SignedRasterLocation p, unsigned radius) noexcept;
+  /**
+   * Determine which tiles shall be loaded and which can be
+   * discarded, and mark the tiles to be loaded as "requested".
+   *
+   * @param p the center of the visible area
+   * @param prefetch additional areas which are loaded when all
+   * visible tiles are loaded already
+   * @return true if at least one tile needs to be loaded
+   */
+  bool PollTiles(SignedRasterLocation p, unsigned radius,
+                 ConstBuffer<PrefetchArea> prefetch=nullptr) noexcept;
 
   void PutTileData(unsigned index, const struct jas_matrix &m) noexcept;
 
+  /**
+   * Like PutTileData(), but copy already decoded data (from a
+   * #TerrainTileStore).
+   */
+  void PutTileData(unsigned index, const TerrainHeight *src) noexcept;
+
   void FinishTileUpdate() noexcept;
 
+  /**
+   * Report the size of the overview and the loaded tiles to
+   * #MemoryAccounting.
+   */
+  void UpdateMemoryUsage() noexcept;
+
+  /**
+   * Calculate the maximum overview height of each tile and of the
+   * whole map.  Call this after the overview has been loaded.
+   */
+  void UpdateMaxHeights() noexcept;
+
 public:
   TerrainHeight GetMaxElevation() const noexcept {
     return overview.GetMaximum();
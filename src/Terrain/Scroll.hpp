@@ -0,0 +1,71 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_TERRAIN_SCROLL_HPP
+#define XCSOAR_TERRAIN_SCROLL_HPP
+
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+
+/**
+ * Move the contents of a two-dimensional buffer: after this call,
+ * the cell (x, y) contains the value which was previously at
+ * (x+dx, y+dy).  Cells without a previous value keep their old
+ * contents, the caller is responsible for filling them.
+ *
+ * @param get_row a function returning a pointer to the given row
+ */
+template<typename GetRow>
+static inline void
+ScrollRows(GetRow &&get_row, unsigned width, unsigned height,
+           int dx, int dy) noexcept
+{
+  assert(unsigned(std::abs(dx)) < width);
+  assert(unsigned(std::abs(dy)) < height);
+
+  const unsigned n = width - std::abs(dx);
+
+  auto move_row = [&](int y){
+    auto *dest = get_row(y);
+    const auto *src = get_row(y + dy);
+    if (dx >= 0)
+      src += dx;
+    else
+      dest -= dx;
+
+    std::memmove(dest, src, n * sizeof(*dest));
+  };
+
+  /* choose the direction so no row is overwritten before it has
+     been moved */
+  if (dy >= 0) {
+    for (int y = 0; y + dy < int(height); ++y)
+      move_row(y);
+  } else {
+    for (int y = height - 1; y + dy >= 0; --y)
+      move_row(y);
+  }
+}
+
+#endif
@@ -0,0 +1,336 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "SlopeShading.hpp"
+
+#include <cassert>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define HAVE_SLOPE_SHADING_SSE2
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+/* NEON on 32 bit ARM lacks double precision vectors, which are
+   needed for the bit-exact sqrt() and integer division */
+#include <arm_neon.h>
+#define HAVE_SLOPE_SHADING_NEON
+#endif
+
+static_assert(sizeof(TerrainHeight) == sizeof(int16_t),
+              "TerrainHeight must be a plain 16 bit integer");
+
+void
+CalculateSlopeShadingRowGeneric(int8_t *gcc_restrict dest,
+                                const TerrainHeight *above,
+                                const TerrainHeight *below,
+                                const TerrainHeight *left,
+                                const TerrainHeight *right,
+                                unsigned n, unsigned p20, unsigned p31,
+                                const SlopeShadingParameters &p) noexcept
+{
+  for (unsigned i = 0; i < n; ++i)
+    dest[i] = CalculateSlopeShading(ClipHeightDelta(right[i], left[i]),
+                                    ClipHeightDelta(above[i], below[i]),
+                                    p20, p31, p);
+}
+
+/*
+ * The vectorised implementations below evaluate the same formula as
+ * CalculateSlopeShading(), taking advantage of its value ranges:
+ *
+ * - the clipped deltas and the products dd0, dd1 fit into 16 bit
+ *   (512 * 63 < 32768)
+ * - dd2 is constant for the whole row, so its terms are precalculated
+ * - dd0*dd0 + dd1*dd1 fits into a signed 32 bit integer
+ *
+ * The square root and the divisions are performed with double
+ * precision, which is exact for these integer ranges (the quotients
+ * are small, so truncation never rounds across an integer).
+ */
+
+#ifdef HAVE_SLOPE_SHADING_SSE2
+
+/**
+ * Calculate the final illumination index for two pixels.
+ *
+ * @return two 32 bit integers in the lower half
+ */
+gcc_always_inline
+static inline __m128i
+FinishSlopeShading2(__m128d num, __m128d square_mag, __m128d sz,
+                    __m128d contrast) noexcept
+{
+  __m128i mag = _mm_cvttpd_epi32(_mm_sqrt_pd(square_mag));
+  mag = _mm_or_si128(mag, _mm_set1_epi32(1));
+
+  const __m128i sval = _mm_cvttpd_epi32(_mm_div_pd(num,
+                                                   _mm_cvtepi32_pd(mag)));
+
+  /* dividing by 128 is exact in double precision, and truncating
+     rounds towards zero, just like the integer division */
+  return _mm_cvttpd_epi32(_mm_mul_pd(_mm_sub_pd(_mm_cvtepi32_pd(sval), sz),
+                                     contrast));
+}
+
+/**
+ * Calculate the illumination index for four pixels.
+ */
+gcc_always_inline
+static inline __m128i
+FinishSlopeShading4(__m128i num, __m128i square_mag_01, __m128d dd2_square,
+                    __m128d sz, __m128d contrast) noexcept
+{
+  const __m128i num_hi = _mm_shuffle_epi32(num, _MM_SHUFFLE(1, 0, 3, 2));
+  const __m128i sq_hi = _mm_shuffle_epi32(square_mag_01,
+                                          _MM_SHUFFLE(1, 0, 3, 2));
+
+  const __m128i lo =
+    FinishSlopeShading2(_mm_cvtepi32_pd(num),
+                        _mm_add_pd(_mm_cvtepi32_pd(square_mag_01),
+                                   dd2_square),
+                        sz, contrast);
+  const __m128i hi =
+    FinishSlopeShading2(_mm_cvtepi32_pd(num_hi),
+                        _mm_add_pd(_mm_cvtepi32_pd(sq_hi), dd2_square),
+                        sz, contrast);
+  return _mm_unpacklo_epi64(lo, hi);
+}
+
+gcc_always_inline
+static inline __m128i
+LoadHeights8(const TerrainHeight *p) noexcept
+{
+  return _mm_loadu_si128((const __m128i *)(const void *)p);
+}
+
+gcc_always_inline
+static inline __m128i
+ClipHeightDelta8(__m128i a, __m128i b) noexcept
+{
+  /* saturation doesn't change the result, because the limits are
+     far beyond the clipping range */
+  const __m128i d = _mm_subs_epi16(a, b);
+  return _mm_max_epi16(_mm_min_epi16(d, _mm_set1_epi16(512)),
+                       _mm_set1_epi16(-512));
+}
+
+static unsigned
+CalculateSlopeShadingRowSSE2(int8_t *gcc_restrict dest,
+                             const TerrainHeight *above,
+                             const TerrainHeight *below,
+                             const TerrainHeight *left,
+                             const TerrainHeight *right,
+                             unsigned n, unsigned p20, unsigned p31,
+                             const SlopeShadingParameters &p) noexcept
+{
+  const unsigned dd2 = p20 * p31 * p.height_slope_factor;
+
+  const __m128i v_p20 = _mm_set1_epi16(p20);
+  const __m128i v_p31 = _mm_set1_epi16(p31);
+  const __m128i v_sxy = _mm_setr_epi16(p.sx, p.sy, p.sx, p.sy,
+                                       p.sx, p.sy, p.sx, p.sy);
+  const __m128i v_dd2_sz = _mm_set1_epi32(int(dd2) * p.sz);
+  const __m128d v_dd2_square = _mm_set1_pd(double(dd2) * double(dd2));
+  const __m128d v_sz = _mm_set1_pd(p.sz);
+  const __m128d v_contrast = _mm_set1_pd(p.contrast / 128.);
+  const __m128i v_min = _mm_set1_epi16(-63), v_max = _mm_set1_epi16(63);
+
+  unsigned i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const __m128i p22 = ClipHeightDelta8(LoadHeights8(right + i),
+                                         LoadHeights8(left + i));
+    const __m128i p32 = ClipHeightDelta8(LoadHeights8(above + i),
+                                         LoadHeights8(below + i));
+
+    const __m128i dd0 = _mm_mullo_epi16(p22, v_p31);
+    const __m128i dd1 = _mm_mullo_epi16(p32, v_p20);
+
+    /* interleave dd0 and dd1, so _mm_madd_epi16() can calculate
+       both dot products for four pixels at a time */
+    const __m128i dd01_lo = _mm_unpacklo_epi16(dd0, dd1);
+    const __m128i dd01_hi = _mm_unpackhi_epi16(dd0, dd1);
+
+    const __m128i num_lo = _mm_add_epi32(_mm_madd_epi16(dd01_lo, v_sxy),
+                                         v_dd2_sz);
+    const __m128i num_hi = _mm_add_epi32(_mm_madd_epi16(dd01_hi, v_sxy),
+                                         v_dd2_sz);
+
+    const __m128i r_lo =
+      FinishSlopeShading4(num_lo, _mm_madd_epi16(dd01_lo, dd01_lo),
+                          v_dd2_square, v_sz, v_contrast);
+    const __m128i r_hi =
+      FinishSlopeShading4(num_hi, _mm_madd_epi16(dd01_hi, dd01_hi),
+                          v_dd2_square, v_sz, v_contrast);
+
+    __m128i r = _mm_packs_epi32(r_lo, r_hi);
+    r = _mm_max_epi16(_mm_min_epi16(r, v_max), v_min);
+    _mm_storel_epi64((__m128i *)(void *)(dest + i), _mm_packs_epi16(r, r));
+  }
+
+  return i;
+}
+
+#endif
+
+#ifdef HAVE_SLOPE_SHADING_NEON
+
+/**
+ * Calculate the final illumination index for two pixels.
+ */
+gcc_always_inline
+static inline int32x2_t
+FinishSlopeShading2(int32x2_t num, int32x2_t square_mag_01,
+                    float64x2_t dd2_square,
+                    float64x2_t sz, float64x2_t contrast) noexcept
+{
+  const float64x2_t square_mag =
+    vaddq_f64(vcvtq_f64_s64(vmovl_s32(square_mag_01)), dd2_square);
+
+  int32x2_t mag = vmovn_s64(vcvtq_s64_f64(vsqrtq_f64(square_mag)));
+  mag = vorr_s32(mag, vdup_n_s32(1));
+
+  const float64x2_t sval =
+    vcvtq_f64_s64(vcvtq_s64_f64(vdivq_f64(vcvtq_f64_s64(vmovl_s32(num)),
+                                          vcvtq_f64_s64(vmovl_s32(mag)))));
+
+  /* dividing by 128 is exact in double precision, and truncating
+     rounds towards zero, just like the integer division */
+  return vmovn_s64(vcvtq_s64_f64(vmulq_f64(vsubq_f64(sval, sz), contrast)));
+}
+
+gcc_always_inline
+static inline int32x4_t
+FinishSlopeShading4(int32x4_t num, int32x4_t square_mag_01,
+                    float64x2_t dd2_square,
+                    float64x2_t sz, float64x2_t contrast) noexcept
+{
+  return vcombine_s32(FinishSlopeShading2(vget_low_s32(num),
+                                          vget_low_s32(square_mag_01),
+                                          dd2_square, sz, contrast),
+                      FinishSlopeShading2(vget_high_s32(num),
+                                          vget_high_s32(square_mag_01),
+                                          dd2_square, sz, contrast));
+}
+
+gcc_always_inline
+static inline int16x8_t
+LoadHeights8(const TerrainHeight *p) noexcept
+{
+  return vld1q_s16((const int16_t *)(const void *)p);
+}
+
+gcc_always_inline
+static inline int16x8_t
+ClipHeightDelta8(int16x8_t a, int16x8_t b) noexcept
+{
+  /* saturation doesn't change the result, because the limits are
+     far beyond the clipping range */
+  const int16x8_t d = vqsubq_s16(a, b);
+  return vmaxq_s16(vminq_s16(d, vdupq_n_s16(512)), vdupq_n_s16(-512));
+}
+
+static unsigned
+CalculateSlopeShadingRowNEON(int8_t *gcc_restrict dest,
+                             const TerrainHeight *above,
+                             const TerrainHeight *below,
+                             const TerrainHeight *left,
+                             const TerrainHeight *right,
+                             unsigned n, unsigned p20, unsigned p31,
+                             const SlopeShadingParameters &p) noexcept
+{
+  const unsigned dd2 = p20 * p31 * p.height_slope_factor;
+
+  const int16x8_t v_p20 = vdupq_n_s16(p20);
+  const int16x8_t v_p31 = vdupq_n_s16(p31);
+  const int16x4_t v_sx = vdup_n_s16(p.sx), v_sy = vdup_n_s16(p.sy);
+  const int32x4_t v_dd2_sz = vdupq_n_s32(int(dd2) * p.sz);
+  const float64x2_t v_dd2_square = vdupq_n_f64(double(dd2) * double(dd2));
+  const float64x2_t v_sz = vdupq_n_f64(p.sz);
+  const float64x2_t v_contrast = vdupq_n_f64(p.contrast / 128.);
+  const int16x8_t v_min = vdupq_n_s16(-63), v_max = vdupq_n_s16(63);
+
+  unsigned i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const int16x8_t p22 = ClipHeightDelta8(LoadHeights8(right + i),
+                                           LoadHeights8(left + i));
+    const int16x8_t p32 = ClipHeightDelta8(LoadHeights8(above + i),
+                                           LoadHeights8(below + i));
+
+    const int16x8_t dd0 = vmulq_s16(p22, v_p31);
+    const int16x8_t dd1 = vmulq_s16(p32, v_p20);
+
+    const int16x4_t dd0_lo = vget_low_s16(dd0), dd0_hi = vget_high_s16(dd0);
+    const int16x4_t dd1_lo = vget_low_s16(dd1), dd1_hi = vget_high_s16(dd1);
+
+    const int32x4_t num_lo =
+      vmlal_s16(vmlal_s16(v_dd2_sz, dd0_lo, v_sx), dd1_lo, v_sy);
+    const int32x4_t num_hi =
+      vmlal_s16(vmlal_s16(v_dd2_sz, dd0_hi, v_sx), dd1_hi, v_sy);
+
+    const int32x4_t sq_lo =
+      vmlal_s16(vmull_s16(dd0_lo, dd0_lo), dd1_lo, dd1_lo);
+    const int32x4_t sq_hi =
+      vmlal_s16(vmull_s16(dd0_hi, dd0_hi), dd1_hi, dd1_hi);
+
+    const int32x4_t r_lo = FinishSlopeShading4(num_lo, sq_lo, v_dd2_square,
+                                               v_sz, v_contrast);
+    const int32x4_t r_hi = FinishSlopeShading4(num_hi, sq_hi, v_dd2_square,
+                                               v_sz, v_contrast);
+
+    int16x8_t r = vcombine_s16(vqmovn_s32(r_lo), vqmovn_s32(r_hi));
+    r = vmaxq_s16(vminq_s16(r, v_max), v_min);
+    vst1_s8(dest + i, vqmovn_s16(r));
+  }
+
+  return i;
+}
+
+#endif
+
+void
+CalculateSlopeShadingRow(int8_t *gcc_restrict dest,
+                         const TerrainHeight *above,
+                         const TerrainHeight *below,
+                         const TerrainHeight *left,
+                         const TerrainHeight *right,
+                         unsigned n, unsigned p20, unsigned p31,
+                         const SlopeShadingParameters &p) noexcept
+{
+  assert(p20 < 64);
+  assert(p31 < 64);
+
+  unsigned i = 0;
+
+#if defined(HAVE_SLOPE_SHADING_SSE2)
+  i = CalculateSlopeShadingRowSSE2(dest, above, below, left, right,
+                                   n, p20, p31, p);
+#elif defined(HAVE_SLOPE_SHADING_NEON)
+  i = CalculateSlopeShadingRowNEON(dest, above, below, left, right,
+                                   n, p20, p31, p);
+#endif
+
+  /* the remaining pixels (or all of them, if there are no vector
+     instructions) */
+  CalculateSlopeShadingRowGeneric(dest + i, above + i, below + i,
+                                  left + i, right + i,
+                                  n - i, p20, p31, p);
+}
@@ -0,0 +1,140 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_TERRAIN_SLOPE_SHADING_HPP
+#define XCSOAR_TERRAIN_SLOPE_SHADING_HPP
+
+#include "Height.hpp"
+#include "util/Clamp.hpp"
+#include "util/Compiler.h"
+
+#include <cstdint>
+#include <cmath>
+
+/**
+ * Parameters for the slope shading formula which are constant for
+ * the whole image.
+ */
+struct SlopeShadingParameters {
+  /**
+   * The sun vector, scaled to 255.
+   */
+  int sx, sy, sz;
+
+  int contrast;
+
+  unsigned height_slope_factor;
+};
+
+/**
+ * Clip the difference between two adjacent terrain height values to
+ * sane bounds.  This works around integer overflows in the slope
+ * shading formula when the map file is broken, avoiding the sqrt()
+ * call with a negative argument.
+ */
+gcc_const
+static inline int
+ClipHeightDelta(int d) noexcept
+{
+  return Clamp(d, -512, 512);
+}
+
+gcc_const
+static inline int
+ClipHeightDelta(TerrainHeight a, TerrainHeight b) noexcept
+{
+  return ClipHeightDelta(a.GetValue() - b.GetValue());
+}
+
+/**
+ * Calculate the illumination index of one pixel.
+ *
+ * @param p22 the clipped height difference in X direction
+ * @param p32 the clipped height difference in Y direction
+ * @param p20 the distance between the two X samples
+ * @param p31 the distance between the two Y samples
+ * @return the illumination index (-63..63)
+ */
+gcc_const
+static inline int
+CalculateSlopeShading(int p22, int p32, unsigned p20, unsigned p31,
+                      const SlopeShadingParameters &p) noexcept
+{
+  const int dd0 = p22 * int(p31);
+  const int dd1 = int(p20) * p32;
+  const unsigned dd2 = p20 * p31 * p.height_slope_factor;
+  const int num = (int(dd2) * p.sz + dd0 * p.sx + dd1 * p.sy);
+  const unsigned square_mag = dd0 * dd0 + dd1 * dd1 + dd2 * dd2;
+  const unsigned mag = (unsigned)sqrt(square_mag);
+  /* this is a workaround for a SIGFPE (division by zero)
+     observed by our users on some Android devices (e.g. Nexus
+     7), even though we did our best to make sure that the
+     integer arithmetics above can't overflow */
+  /* TODO: debug this problem and replace this workaround */
+  const int sval = num / int(mag|1);
+  const int sindex = (sval - p.sz) * p.contrast / 128;
+  return Clamp(sindex, -63, 63);
+}
+
+/**
+ * Calculate the illumination index for a horizontal run of pixels
+ * which all have the same sample distances.  "Special" height
+ * values are not checked; the caller is responsible for ignoring
+ * the results for those pixels.
+ *
+ * This function uses SSE2 or NEON if available.  The result is
+ * identical to calling CalculateSlopeShading() for each pixel.
+ *
+ * @param dest the destination buffer (n elements)
+ * @param above the first sample in the row above
+ * @param below the first sample in the row below
+ * @param left the first sample in the left column
+ * @param right the first sample in the right column
+ * @param n the number of pixels
+ * @param p20 the distance between the two X samples (below 64)
+ * @param p31 the distance between the two Y samples (below 64)
+ */
+void
+CalculateSlopeShadingRow(int8_t *gcc_restrict dest,
+                         const TerrainHeight *above,
+                         const TerrainHeight *below,
+                         const TerrainHeight *left,
+                         const TerrainHeight *right,
+                         unsigned n, unsigned p20, unsigned p31,
+                         const SlopeShadingParameters &p) noexcept;
+
+/**
+ * Portable implementation of CalculateSlopeShadingRow() which
+ * doesn't use vector instructions.  This is the reference for the
+ * optimised implementations.
+ */
+void
+CalculateSlopeShadingRowGeneric(int8_t *gcc_restrict dest,
+                                const TerrainHeight *above,
+                                const TerrainHeight *below,
+                                const TerrainHeight *left,
+                                const TerrainHeight *right,
+                                unsigned n, unsigned p20, unsigned p31,
+                                const SlopeShadingParameters &p) noexcept;
+
+#endif
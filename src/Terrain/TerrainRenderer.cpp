@@ -24,10 +24,14 @@ Copyright_License {
 #include "Terrain/TerrainRenderer.hpp"
 #include "Terrain/RasterTerrain.hpp"
 #include "ui/canvas/Ramp.hpp"
+#include "ui/canvas/Canvas.hpp"
+#include "ui/canvas/Pen.hpp"
 #include "Projection/WindowProjection.hpp"
 #include "util/Macros.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 
 static constexpr ColorRamp terrain_colors[][NUM_COLOR_RAMP_LEVELS] = {
   {
@@ -297,13 +301,61 @@ IsLargeSizeDifference(const GeoBounds &a, const GeoBounds &b)
 }
 #endif
 
+/**
+ * The height difference between two contour lines [m].
+ */
+static constexpr unsigned CONTOUR_INTERVAL = 256;
+
+/**
+ * Returns the projection which the terrain image shall be rendered
+ * with.
+ *
+ * A rotated map (e.g. track up) is rendered north-up into a square
+ * which covers the screen at any rotation around the projection
+ * origin, and the image is rotated when it is drawn (by the GPU or
+ * with Canvas::StretchAffine()).  This way, heading changes don't
+ * require scanning the map again.
+ */
+static WindowProjection
+GetImageProjection(const WindowProjection &projection) noexcept
+{
+#if defined(ENABLE_OPENGL) || defined(USE_MEMORY_CANVAS)
+  if (projection.GetScreenAngle() == Angle::Zero())
+    return projection;
+
+  /* the distance between the origin and the farthest screen corner */
+  const PixelSize size = projection.GetScreenSize();
+  const PixelPoint origin = projection.GetScreenOrigin();
+  const int dx = std::max(origin.x, int(size.width) - origin.x);
+  const int dy = std::max(origin.y, int(size.height) - origin.y);
+  const int radius = (int)std::ceil(std::hypot(dx, dy));
+
+  WindowProjection result = projection;
+  result.SetScreenAngle(Angle::Zero());
+  result.SetScreenSize(PixelSize(2 * radius, 2 * radius));
+  result.SetScreenOrigin(radius, radius);
+  result.UpdateScreenBounds();
+  return result;
+#else
+  return projection;
+#endif
+}
+
 bool
 TerrainRenderer::Generate(const WindowProjection &map_projection,
                           const Angle sunazimuth)
 {
+  const WindowProjection projection = GetImageProjection(map_projection);
+
+  const bool do_contour = settings.contours != Contours::OFF;
+
+  /* contours have just been enabled or disabled */
+  const bool update_contours =
+    do_contour != (contours.GetInterval() != 0);
+
 #ifdef ENABLE_OPENGL
   const GeoBounds &old_bounds = raster_renderer.GetBounds();
-  GeoBounds new_bounds = map_projection.GetScreenBounds();
+  GeoBounds new_bounds = projection.GetScreenBounds();
   assert(new_bounds.IsValid());
 
   {
@@ -313,24 +365,37 @@ TerrainRenderer::Generate(const WindowProjection &map_projection,
       return false;
   }
 
-  if (old_bounds.IsValid() && old_bounds.IsInside(new_bounds) &&
-      !IsLargeSizeDifference(old_bounds, new_bounds) &&
-      terrain_serial == terrain.GetSerial() &&
-      sunazimuth.CompareRoughly(last_sun_azimuth) &&
-      !raster_renderer.UpdateQuantisation())
+  /* the image is rendered by a shader from the height matrix, so
+     it only needs to be scanned again if it doesn't cover the screen
+     or has insufficient resolution; all other changes are cheap */
+  const bool scan = !old_bounds.IsValid() ||
+    !old_bounds.IsInside(new_bounds) ||
+    IsLargeSizeDifference(old_bounds, new_bounds) ||
+    terrain_serial != terrain.GetSerial() ||
+    raster_renderer.UpdateQuantisation(power_saving);
+
+  if (!scan && !update_contours &&
+      sunazimuth.CompareRoughly(last_sun_azimuth))
     /* no change since previous frame */
     return true;
 
 #else
-  if (compare_projection.Compare(map_projection) &&
+  if (compare_projection.Compare(projection) &&
       terrain_serial == terrain.GetSerial() &&
+      !update_contours &&
       sunazimuth.CompareRoughly(last_sun_azimuth))
     /* no change since previous frame */
     return true;
 
-  compare_projection = CompareProjection(map_projection);
+  compare_projection = CompareProjection(projection);
+
+  const bool scan = true;
 #endif
 
+  /* if the terrain hasn't changed, RasterRenderer may reuse the
+     previous frame's data after the map was panned */
+  const bool may_scroll = terrain_serial == terrain.GetSerial();
+
   terrain_serial = terrain.GetSerial();
 
   last_sun_azimuth = sunazimuth;
@@ -339,10 +404,8 @@ TerrainRenderer::Generate(const WindowProjection &map_projection,
   const unsigned height_scale = 4;
   const int interp_levels = 2;
   const bool is_terrain = true;
-  const bool do_shading = is_terrain &&
+  const bool do_shading = is_terrain && !power_saving &&
                           settings.slope_shading != SlopeShading::OFF;
-  const bool do_contour = is_terrain &&
-                          settings.contours != Contours::OFF;
 
   const ColorRamp *const color_ramp = &terrain_colors[settings.ramp][0];
   if (color_ramp != last_color_ramp) {
@@ -351,14 +414,90 @@ TerrainRenderer::Generate(const WindowProjection &map_projection,
     last_color_ramp = color_ramp;
   }
 
-  {
+  if (scan || update_contours) {
     RasterTerrain::Lease map(terrain);
-    raster_renderer.ScanMap(map, map_projection);
+
+    if (scan)
+      raster_renderer.ScanMap(map, projection, may_scroll);
+
+    if (do_contour)
+#ifdef ENABLE_OPENGL
+      UpdateContours(map, raster_renderer.GetBounds());
+#else
+      UpdateContours(map, projection.GetScreenBounds());
+#endif
+    else
+      contours.Clear();
   }
 
+  /* contours are drawn as vectors by Draw(), not into the image */
   raster_renderer.GenerateImage(do_shading, height_scale,
                                 settings.contrast, settings.brightness,
-                                sunazimuth,
-                                do_contour);
+                                sunazimuth);
   return true;
 }
+
+void
+TerrainRenderer::UpdateContours(const RasterMap &map,
+                                const GeoBounds &bounds)
+{
+  contours.Reset(CONTOUR_INTERVAL);
+  contour_projection = map.GetProjection();
+
+  if (bounds.IsValid())
+    map.GetContours(bounds, CONTOUR_INTERVAL, contours);
+}
+
+void
+TerrainRenderer::Draw(Canvas &canvas,
+                      const WindowProjection &projection) const
+{
+  raster_renderer.Draw(canvas, projection);
+
+  if (!contours.empty())
+    DrawContours(canvas, projection);
+}
+
+void
+TerrainRenderer::DrawContours(Canvas &canvas,
+                              const WindowProjection &projection) const
+{
+  const Pen pen(1, Color(0x80, 0x60, 0x40));
+  canvas.Select(pen);
+
+  const PixelSize screen_size = projection.GetScreenSize();
+
+  contours.ForEach([&](ConstBuffer<RasterLocation> line){
+    contour_geo.resize(line.size);
+    std::transform(line.begin(), line.end(), contour_geo.begin(),
+                   [this](RasterLocation p){
+                     return contour_projection.UnprojectFine(p);
+                   });
+
+    contour_screen.resize(line.size);
+    projection.GeoToScreen(std::span<const GeoPoint>{contour_geo},
+                           std::span<BulkPixelPoint>{contour_screen});
+
+    /* drop points which fall onto the previous pixel, and skip lines
+       which are completely outside of the screen */
+    auto o = contour_screen.begin();
+    int min_x = o->x, max_x = o->x, min_y = o->y, max_y = o->y;
+    for (auto i = std::next(o); i != contour_screen.end(); ++i) {
+      if (i->x == o->x && i->y == o->y)
+        continue;
+
+      *++o = *i;
+      min_x = std::min<int>(min_x, o->x);
+      max_x = std::max<int>(max_x, o->x);
+      min_y = std::min<int>(min_y, o->y);
+      max_y = std::max<int>(max_y, o->y);
+    }
+
+    const unsigned n = std::distance(contour_screen.begin(), o) + 1;
+    if (n < 2 || max_x < 0 || max_y < 0 ||
+        min_x >= int(screen_size.width) || min_y >= int(screen_size.height))
+      return;
+
+    canvas.DrawPolyline(contour_screen.data(), n);
+  });
+}
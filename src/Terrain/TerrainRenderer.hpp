@@ -25,8 +25,14 @@ Copyright_License {
 #define XCSOAR_TERRAIN_RENDERER_HPP
 
 #include "RasterRenderer.hpp"
+#include "ContourLines.hpp"
+#include "RasterProjection.hpp"
 #include "util/Serial.hpp"
 #include "Terrain/TerrainSettings.hpp"
+#include "ui/dim/BulkPoint.hpp"
+#include "Geo/GeoPoint.hpp"
+
+#include <vector>
 
 #ifndef ENABLE_OPENGL
 #include "Projection/CompareProjection.hpp"
@@ -35,6 +41,8 @@ Copyright_License {
 class Canvas;
 class WindowProjection;
 class RasterTerrain;
+class RasterMap;
+class GeoBounds;
 struct ColorRamp;
 
 class TerrainRenderer {
@@ -53,8 +61,33 @@ protected:
 
   const ColorRamp *last_color_ramp = nullptr;
 
+  /**
+   * @see SetPowerSaving()
+   */
+  bool power_saving = false;
+
   RasterRenderer raster_renderer;
 
+  /**
+   * The contour lines of the area covered by the last ScanMap()
+   * call, copied from the #RasterTileCache (which extracts them only
+   * once per tile).  They are drawn as vectors by Draw(), so they
+   * stay crisp at every zoom level.  Empty (with interval 0) if
+   * contours are disabled.
+   */
+  ContourLines contours;
+
+  /**
+   * The projection of #contours to geographic coordinates.
+   */
+  RasterProjection contour_projection;
+
+  /**
+   * Scratch buffers for Draw().
+   */
+  mutable std::vector<GeoPoint> contour_geo;
+  mutable std::vector<BulkPixelPoint> contour_screen;
+
 public:
   TerrainRenderer(const RasterTerrain &_terrain);
   ~TerrainRenderer() {}
@@ -70,7 +103,9 @@ public:
     raster_renderer.Invalidate();
 #else
     compare_projection.Clear();
+    raster_renderer.Invalidate();
 #endif
+    contours.Clear();
   }
 
 public:
@@ -82,6 +117,18 @@ public:
     settings = _settings;
   }
 
+  /**
+   * Reduce the terrain quality to save power: no slope shading and
+   * (on OpenGL) never the full resolution.
+   */
+  void SetPowerSaving(bool _power_saving) {
+    if (_power_saving == power_saving)
+      return;
+
+    power_saving = _power_saving;
+    Flush();
+  }
+
   /**
    * @return true if an image has been renderered and Draw() may be
    * called
@@ -89,9 +136,16 @@ public:
   bool Generate(const WindowProjection &map_projection,
                 const Angle sunazimuth);
 
-  void Draw(Canvas &canvas, const WindowProjection &projection) const {
-    raster_renderer.Draw(canvas, projection);
-  }
+  void Draw(Canvas &canvas, const WindowProjection &projection) const;
+
+private:
+  /**
+   * Copy the contour lines of the given area from the map.
+   */
+  void UpdateContours(const RasterMap &map, const GeoBounds &bounds);
+
+  void DrawContours(Canvas &canvas,
+                    const WindowProjection &projection) const;
 };
 
 #endif
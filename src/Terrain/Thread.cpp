@@ -49,6 +49,72 @@ TerrainThread::Trigger(const WindowProjection &projection)
   StandbyThread::Trigger();
 }
 
+/**
+ * Are both lists (nearly) equal?
+ */
+[[gnu::pure]]
+static bool
+IsSamePrefetch(ConstBuffer<GeoPoint> a, ConstBuffer<GeoPoint> b) noexcept
+{
+  if (a.size != b.size)
+    return false;
+
+  for (std::size_t i = 0; i < a.size; ++i)
+    if (a[i].DistanceS(b[i]) >= 1000)
+      return false;
+
+  return true;
+}
+
+void
+TerrainThread::SetPrefetch(ConstBuffer<GeoPoint> locations)
+{
+  if (locations.size > MAX_PREFETCH)
+    locations.size = MAX_PREFETCH;
+
+  const std::lock_guard<Mutex> lock(mutex);
+
+  if (IsSamePrefetch(locations, {next_prefetch.begin(), next_prefetch.size()}))
+    return;
+
+  next_prefetch.clear();
+  for (const auto &i : locations)
+    next_prefetch.append(i);
+
+  if (IsSamePrefetch(locations, {last_prefetch.begin(), last_prefetch.size()}))
+    /* already loaded */
+    return;
+
+  if (next_center.IsValid())
+    StandbyThread::Trigger();
+}
+
+inline void
+TerrainThread::Prefetch() noexcept
+{
+  if (next_prefetch.empty() || !last_center.IsValid() ||
+      IsSamePrefetch({next_prefetch.begin(), next_prefetch.size()},
+                     {last_prefetch.begin(), last_prefetch.size()}))
+    return;
+
+  const auto prefetch = next_prefetch;
+  const GeoPoint center = last_center;
+  const auto radius = last_radius;
+
+  bool again = true;
+
+  /* stop as soon as there is a new Trigger() call, because the
+     visible area is more important */
+  while (again && !IsStopped() && !IsPending()) {
+    const ScopeUnlock unlock(mutex);
+    again = terrain.UpdateTiles(center, radius,
+                                {prefetch.begin(), prefetch.size()});
+  }
+
+  if (!again)
+    last_prefetch = prefetch;
+}
+
 void
 TerrainThread::Tick() noexcept
 {
@@ -68,6 +134,9 @@ TerrainThread::Tick() noexcept
     last_radius = radius;
   }
 
+  if (!again && !IsPending())
+    Prefetch();
+
   /* notify the client */
   if (callback) {
     const ScopeUnlock unlock(mutex);
@@ -26,6 +26,8 @@ Copyright_License {
 
 #include "thread/StandbyThread.hpp"
 #include "Geo/GeoPoint.hpp"
+#include "util/StaticArray.hxx"
+#include "util/ConstBuffer.hxx"
 
 #include <functional>
 
@@ -36,6 +38,10 @@ class WindowProjection;
  * A thread that loads topography files asynchronously.
  */
 class TerrainThread final : private StandbyThread {
+public:
+  static constexpr unsigned MAX_PREFETCH = 4;
+
+private:
   RasterTerrain &terrain;
 
   const std::function<void()> callback;
@@ -46,6 +52,18 @@ class TerrainThread final : private StandbyThread {
   GeoPoint next_center;
   double next_radius;
 
+  /**
+   * Locations which are likely to become visible soon.  Tiles around
+   * them are loaded with a lower priority after all visible tiles
+   * have been loaded.
+   */
+  StaticArray<GeoPoint, MAX_PREFETCH> next_prefetch;
+
+  /**
+   * The prefetch locations which have been loaded completely.
+   */
+  StaticArray<GeoPoint, MAX_PREFETCH> last_prefetch;
+
 public:
   TerrainThread(RasterTerrain &_terrain, std::function<void()> &&_callback);
 
@@ -53,7 +71,17 @@ public:
 
   void Trigger(const WindowProjection &projection);
 
+  /**
+   * Specify locations where terrain will probably be needed soon
+   * (e.g. ahead of the aircraft).  The tiles around them are loaded
+   * in the idle time of this thread, with the screen radius of the
+   * last Trigger() call.
+   */
+  void SetPrefetch(ConstBuffer<GeoPoint> locations);
+
 private:
+  void Prefetch() noexcept;
+
   /* virtual methods from class StandbyThread*/
   void Tick() noexcept override;
 };
@@ -0,0 +1,182 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "TileStore.hpp"
+#include "RasterTileCache.hpp"
+#include "system/FileMapping.hpp"
+#include "io/BufferedOutputStream.hxx"
+
+extern "C" {
+#include "jasper/jas_seq.h"
+}
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+#include <string.h>
+
+/**
+ * Refuse to generate files larger than this (in #TerrainHeight
+ * units), because FileMapping doesn't support more than 1 GB.
+ */
+static constexpr uint32_t MAX_SAMPLES = 256 * 1024 * 1024;
+
+TerrainTileStore::TerrainTileStore(std::unique_ptr<FileMapping> &&_mapping,
+                                   std::size_t header_size,
+                                   const RasterTileCache &cache)
+  :mapping(std::move(_mapping))
+{
+  const std::size_t file_size = mapping->size();
+  if (file_size < header_size + sizeof(Trailer) +
+      sizeof(RasterTileCache::CacheHeader) ||
+      header_size % sizeof(TerrainHeight) != 0)
+    throw std::runtime_error("Terrain tile store too small");
+
+  Trailer trailer;
+  memcpy(&trailer, mapping->at(file_size - sizeof(trailer)),
+         sizeof(trailer));
+  if (trailer.magic != Trailer::MAGIC ||
+      trailer.version != Trailer::VERSION)
+    throw std::runtime_error("Wrong terrain tile store version");
+
+  const std::size_t header_offset = file_size - sizeof(trailer)
+    - sizeof(RasterTileCache::CacheHeader);
+
+  RasterTileCache::CacheHeader header;
+  memcpy(&header, mapping->at(header_offset), sizeof(header));
+  if (!cache.CheckCacheHeader(header) ||
+      trailer.n_tiles != cache.tiles.GetSize())
+    throw std::runtime_error("Terrain tile store does not match terrain");
+
+  const std::size_t index_size = sizeof(TileEntry) * trailer.n_tiles;
+  if (header_offset < header_size + index_size)
+    throw std::runtime_error("Malformed terrain tile store index");
+
+  const std::size_t index_offset = header_offset - index_size;
+  index.resize(trailer.n_tiles);
+  memcpy(index.data(), mapping->at(index_offset), index_size);
+
+  const std::size_t payload_samples =
+    (index_offset - header_size) / sizeof(TerrainHeight);
+  for (const auto &i : index)
+    if (i.IsDefined() &&
+        std::size_t(i.offset) + std::size_t(i.width) * i.height
+        > payload_samples)
+      throw std::runtime_error("Malformed terrain tile store index");
+
+  payload = (const TerrainHeight *)mapping->at(header_size);
+}
+
+TerrainTileStore::~TerrainTileStore() noexcept = default;
+
+const TerrainHeight *
+TerrainTileStore::Get(unsigned i, RasterLocation size) const noexcept
+{
+  if (i >= index.size())
+    return nullptr;
+
+  const auto &entry = index[i];
+  if (!entry.IsDefined() ||
+      entry.width != size.x || entry.height != size.y)
+    return nullptr;
+
+  return payload + entry.offset;
+}
+
+void
+TerrainTileStoreWriter::PutTile(unsigned i,
+                                const struct jas_matrix &m) noexcept
+try {
+  if (!complete)
+    return;
+
+  const unsigned width = m.numcols_, height = m.numrows_;
+  if (width == 0 || height == 0)
+    return;
+
+  if (width > 0xffff || height > 0xffff ||
+      width * height > MAX_SAMPLES - position) {
+    /* too large; give up */
+    complete = false;
+    return;
+  }
+
+  if (i >= index.size())
+    index.resize(i + 1, TerrainTileStore::TileEntry{0, 0, 0});
+
+  auto &entry = index[i];
+  entry.offset = position;
+  entry.width = width;
+  entry.height = height;
+
+  TerrainHeight row[0x400];
+
+  for (unsigned y = 0; y != height; ++y) {
+    const jas_seqent_t *gcc_restrict src = m.rows_[y];
+
+    for (unsigned x = 0; x < width;) {
+      const unsigned n = std::min(width - x, unsigned(std::size(row)));
+      for (unsigned j = 0; j < n; ++j)
+        row[j] = TerrainHeight(src[x + j]);
+
+      os.Write(row, sizeof(row[0]) * n);
+      x += n;
+    }
+  }
+
+  position += width * height;
+} catch (...) {
+  /* I/O error: discard the whole file */
+  complete = false;
+}
+
+bool
+TerrainTileStoreWriter::Finish(const RasterTileCache &cache)
+{
+  if (!complete || !cache.IsValid())
+    return false;
+
+  const unsigned n_tiles = cache.tiles.GetSize();
+
+  /* every defined tile must have been stored */
+  for (unsigned i = 0; i < n_tiles; ++i)
+    if (cache.tiles.GetLinear(i).IsDefined() &&
+        (i >= index.size() || !index[i].IsDefined()))
+      return false;
+
+  index.resize(n_tiles, TerrainTileStore::TileEntry{0, 0, 0});
+  os.Write(index.data(), sizeof(index.front()) * index.size());
+
+  const auto header = cache.MakeCacheHeader();
+  os.Write(&header, sizeof(header));
+
+  TerrainTileStore::Trailer trailer;
+  memset(&trailer, 0, sizeof(trailer));
+  trailer.magic = TerrainTileStore::Trailer::MAGIC;
+  trailer.version = TerrainTileStore::Trailer::VERSION;
+  trailer.n_tiles = n_tiles;
+  os.Write(&trailer, sizeof(trailer));
+
+  return true;
+}
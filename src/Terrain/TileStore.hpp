@@ -0,0 +1,154 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_TERRAIN_TILE_STORE_HPP
+#define XCSOAR_TERRAIN_TILE_STORE_HPP
+
+#include "Height.hpp"
+#include "RasterLocation.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+struct jas_matrix;
+class FileMapping;
+class BufferedOutputStream;
+class RasterTileCache;
+
+/**
+ * A file which contains all terrain tiles in decoded (uncompressed)
+ * form.  It is generated while the JPEG2000 overview gets scanned
+ * (which decodes all tiles anyway) and stored in the #FileCache.
+ * Later, the file is mapped into memory, and loading a tile is only
+ * a copy from the page cache instead of a JPEG2000 decoder run.
+ *
+ * File layout (after the #FileCache header): the raw #TerrainHeight
+ * samples of all tiles, followed by the tile index, the
+ * #RasterTileCache::CacheHeader and the #Trailer.
+ */
+class TerrainTileStore {
+public:
+  struct TileEntry {
+    /**
+     * The position of the first sample within the payload, in
+     * #TerrainHeight units.
+     */
+    uint32_t offset;
+
+    /**
+     * The dimensions of this tile; zero if the tile is not stored.
+     */
+    uint16_t width, height;
+
+    constexpr bool IsDefined() const noexcept {
+      return width > 0 && height > 0;
+    }
+  };
+
+  struct Trailer {
+    static constexpr uint32_t MAGIC = 0x7e5a11e5;
+    static constexpr uint32_t VERSION = 1;
+
+    uint32_t magic;
+    uint32_t version;
+
+    /**
+     * The number of #TileEntry items before the cache header.
+     */
+    uint32_t n_tiles;
+
+    uint32_t reserved;
+  };
+
+private:
+  std::unique_ptr<FileMapping> mapping;
+
+  const TerrainHeight *payload;
+
+  std::vector<TileEntry> index;
+
+public:
+  /**
+   * Throws on error (malformed file or mismatch with the
+   * #RasterTileCache).
+   */
+  TerrainTileStore(std::unique_ptr<FileMapping> &&_mapping,
+                   std::size_t header_size,
+                   const RasterTileCache &cache);
+
+  ~TerrainTileStore() noexcept;
+
+  TerrainTileStore(const TerrainTileStore &) = delete;
+  TerrainTileStore &operator=(const TerrainTileStore &) = delete;
+
+  /**
+   * Look up a tile.
+   *
+   * @return a pointer to width*height samples (row by row) or nullptr
+   * if the tile is not stored
+   */
+  [[gnu::pure]]
+  const TerrainHeight *Get(unsigned i, RasterLocation size) const noexcept;
+};
+
+/**
+ * Generates a #TerrainTileStore file.
+ */
+class TerrainTileStoreWriter {
+  BufferedOutputStream &os;
+
+  std::vector<TerrainTileStore::TileEntry> index;
+
+  /**
+   * The current position in #TerrainHeight units.
+   */
+  uint32_t position = 0;
+
+  /**
+   * Set to false as soon as a tile could not be stored; the file
+   * must not be committed then.
+   */
+  bool complete = true;
+
+public:
+  explicit TerrainTileStoreWriter(BufferedOutputStream &_os) noexcept
+    :os(_os) {}
+
+  /**
+   * Append the samples of a decoded tile.  This is called from
+   * within the JPEG2000 decoder, therefore it must not throw; errors
+   * only mark the file as incomplete.
+   */
+  void PutTile(unsigned i, const struct jas_matrix &m) noexcept;
+
+  /**
+   * Write the index and the header.  Throws on I/O error.
+   *
+   * @return false if not all tiles have been stored and the file
+   * should be discarded
+   */
+  bool Finish(const RasterTileCache &cache);
+};
+
+#endif
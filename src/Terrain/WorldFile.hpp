@@ -24,11 +24,11 @@ Copyright_License {
 #ifndef XCSOAR_TERRAIN_WORLD_FILE_HPP
 #define XCSOAR_TERRAIN_WORLD_FILE_HPP
 
-struct zzip_dir;
+class ZipArchive;
 class GeoBounds;
 
 GeoBounds
-LoadWorldFile(struct zzip_dir *dir, const char *path,
+LoadWorldFile(ZipArchive &archive, const char *path,
               unsigned width, unsigned height);
 
 #endif
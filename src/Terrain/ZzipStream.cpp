@@ -22,10 +22,77 @@ Copyright_License {
 */
 
 #include "ZzipStream.hpp"
+#include "io/ZipArchive.hpp"
 #include "util/RuntimeError.hxx"
 
 #include <zzip/util.h>
 
+#include <algorithm>
+
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * The state of a stream reading an uncompressed member directly from
+ * the archive's memory mapping.
+ */
+struct MappedStream {
+  ConstBuffer<char> data;
+  std::size_t position = 0;
+
+  explicit MappedStream(ConstBuffer<void> _data) noexcept
+    :data(ConstBuffer<char>::FromVoid(_data)) {}
+};
+
+static int
+jas_mapped_read(jas_stream_obj_t *obj, char *buf, unsigned cnt)
+{
+  auto &s = *(MappedStream *)obj;
+
+  const std::size_t n = std::min<std::size_t>(cnt,
+                                              s.data.size - s.position);
+  memcpy(buf, s.data.data + s.position, n);
+  s.position += n;
+  return n;
+}
+
+static long
+jas_mapped_seek(jas_stream_obj_t *obj, long offset, int origin)
+{
+  auto &s = *(MappedStream *)obj;
+
+  long new_position;
+  switch (origin) {
+  case SEEK_SET:
+    new_position = offset;
+    break;
+
+  case SEEK_CUR:
+    new_position = s.position + offset;
+    break;
+
+  case SEEK_END:
+    new_position = s.data.size + offset;
+    break;
+
+  default:
+    return -1;
+  }
+
+  if (new_position < 0 || std::size_t(new_position) > s.data.size)
+    return -1;
+
+  s.position = new_position;
+  return new_position;
+}
+
+static int
+jas_mapped_close(jas_stream_obj_t *obj)
+{
+  delete (MappedStream *)obj;
+  return 0;
+}
+
 static int
 jas_zzip_read(jas_stream_obj_t *obj, char *buf, unsigned cnt)
 {
@@ -63,10 +130,38 @@ static constexpr jas_stream_ops_t zzip_stream_ops = {
   jas_zzip_close
 };
 
+static constexpr jas_stream_ops_t mapped_stream_ops = {
+  jas_mapped_read,
+  jas_zzip_write,
+  jas_mapped_seek,
+  jas_mapped_close
+};
+
+static jas_stream_t *
+OpenJasperMappedStream(ConstBuffer<void> data)
+{
+  jas_stream_t *stream = jas_stream_create();
+  if (stream == nullptr)
+    throw std::runtime_error("jas_stream_create() failed");
+
+  stream->openmode_ = JAS_STREAM_READ|JAS_STREAM_BINARY;
+  stream->obj_ = new MappedStream(data);
+  stream->ops_ = const_cast<jas_stream_ops_t *>(&mapped_stream_ops);
+
+  /* still use full buffering, because libjasper's unbuffered mode
+     would call jas_mapped_read() for each single byte */
+  jas_stream_initbuf(stream, JAS_STREAM_FULLBUF, 0, 0);
+
+  return stream;
+}
+
 jas_stream_t *
-OpenJasperZzipStream(struct zzip_dir *dir, const char *path)
+OpenJasperZzipStream(ZipArchive &archive, const char *path)
 {
-  const auto f = zzip_open_rb(dir, path);
+  if (const auto stored = archive.GetStored(path); !stored.IsNull())
+    return OpenJasperMappedStream(stored);
+
+  const auto f = zzip_open_rb(archive.get(), path);
   if (f == nullptr)
     throw FormatRuntimeError("Failed to open '%s' from map file", path);
 
@@ -26,12 +26,17 @@ Copyright_License {
 
 #include "jasper/jas_stream.h"
 
-struct zzip_dir;
+class ZipArchive;
 
 /**
+ * Open a member of the ZIP archive as a libjasper stream.  If the
+ * member is stored without compression, it is read directly from the
+ * archive's memory mapping; the #ZipArchive must then outlive the
+ * stream.
+ *
  * Throws on error.
  */
 jas_stream_t *
-OpenJasperZzipStream(struct zzip_dir *dir, const char *path);
+OpenJasperZzipStream(ZipArchive &archive, const char *path);
 
 #endif
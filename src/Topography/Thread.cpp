@@ -24,12 +24,15 @@ Copyright_License {
 #include "Thread.hpp"
 #include "TopographyStore.hpp"
 
+#include <thread>
+
 TopographyThread::TopographyThread(TopographyStore &_store,
                                    std::function<void()> &&_callback)
   :StandbyThread("Topography"),
    store(_store),
    callback(std::move(_callback)),
-   last_bounds(GeoBounds::Invalid()) {}
+   last_bounds(GeoBounds::Invalid()),
+   pool(std::thread::hardware_concurrency()) {}
 
 TopographyThread::~TopographyThread()
 {
@@ -73,7 +76,7 @@ TopographyThread::Tick() noexcept
     const WindowProjection projection = next_projection;
 
     const ScopeUnlock unlock(mutex);
-    again = store.ScanVisibility(projection, 1) > 0;
+    again = store.ScanVisibility(projection, pool) > 0;
   }
 
   /* notify the client that we have updated the topography cache */
@@ -25,6 +25,7 @@ Copyright_License {
 #define XCSOAR_TOPOGRAPHY_THREAD_HPP
 
 #include "thread/StandbyThread.hpp"
+#include "thread/ThreadPool.hpp"
 #include "Projection/WindowProjection.hpp"
 #include "Geo/GeoBounds.hpp"
 
@@ -45,6 +46,11 @@ class TopographyThread final : private StandbyThread {
   GeoBounds last_bounds;
   double scale_threshold;
 
+  /**
+   * Updates the files of the #TopographyStore in parallel.
+   */
+  ThreadPool pool;
+
 public:
   TopographyThread(TopographyStore &_store, std::function<void()> &&_callback);
   ~TopographyThread();
@@ -97,6 +97,9 @@ TopographyFile::ClearCache()
   }
 
   first = nullptr;
+
+  /* make sure no stale ShapeList::last_used matches */
+  ++generation;
 }
 
 static XShape *
@@ -143,45 +146,55 @@ TopographyFile::Update(const WindowProjection &map_projection)
 
   assert(file.status != nullptr);
 
+  const unsigned previous = generation++;
+  last_update = {0, 0};
+
   // Iterate through the shapefile entries
   const ShapeList **current = &first;
   auto it = shapes.begin();
   for (int i = 0; i < file.numshapes; ++i, ++it) {
     if (!msGetBit(file.status, i)) {
       // If the shape is outside the bounds
-      // delete the shape from the cache
-      if (it->shape != nullptr) {
+      // remove the shape from the list
+      if (it->shape == nullptr)
+        continue;
+
+      if (it->last_used == previous) {
         assert(*current == it);
 
         /* remove from linked list (protected) */
-        {
-          const std::lock_guard<Mutex> lock(mutex);
-          *current = it->next;
-          ++serial;
-        }
-
-        /* now it's unreachable, and we can delete the XShape without
-           holding a lock */
+        const std::lock_guard<Mutex> lock(mutex);
+        *current = it->next;
+        ++serial;
+      }
+
+      if (generation - it->last_used > RETAIN_GENERATIONS) {
+        /* it has been unreachable for a while, and we can delete
+           the XShape without holding a lock */
         delete it->shape;
         it->shape = nullptr;
+        ++last_update.evicted;
       }
     } else {
       // is inside the bounds
       if (it->shape == nullptr) {
-        assert(*current != it);
-
         // shape isn't cached yet -> cache the shape
         it->shape = LoadShape(&file, center, i, label_field);
+        ++last_update.loaded;
+      }
+
+      if (it->last_used != previous) {
+        assert(*current != it);
+
         it->next = *current;
 
         /* insert into linked list (protected) */
-        {
-          const std::lock_guard<Mutex> lock(mutex);
-          *current = it;
-          ++serial;
-        }
+        const std::lock_guard<Mutex> lock(mutex);
+        *current = it;
+        ++serial;
       }
 
+      it->last_used = generation;
       current = &it->next;
     }
   }
@@ -201,6 +214,7 @@ TopographyFile::LoadAll()
     if (it->shape == nullptr)
       // shape isn't cached yet -> cache the shape
       it->shape = LoadShape(&file, center, i, label_field);
+    it->last_used = generation;
     // update list pointer
     *current = it;
     current = &it->next;
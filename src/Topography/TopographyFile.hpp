@@ -49,15 +49,53 @@ class TopographyFile {
 
     const XShape *shape;
 
+    /**
+     * The #generation in which this shape was last inside the cache
+     * bounds.  The shape is linked into the list exactly if this
+     * equals the current #generation.
+     */
+    unsigned last_used;
+
     ShapeList() {}
-    ShapeList(const XShape *_shape):shape(_shape) {}
+    ShapeList(const XShape *_shape):shape(_shape), last_used(0) {}
   };
 
+  /**
+   * The number of Update() calls after which a shape which has left
+   * the cache bounds gets deleted.  Until then, it stays in memory
+   * (but not in the list), so panning back and forth does not reload
+   * it from the shapefile each time.
+   */
+  static constexpr unsigned RETAIN_GENERATIONS = 4;
+
   /**
    * This gets incremented by Update().
    */
   Serial serial;
 
+  /**
+   * Incremented each time Update() rescans the shapefile and by
+   * ClearCache().  Starts at 1, because 0 is the "never used" value
+   * of ShapeList::last_used.
+   */
+  unsigned generation = 1;
+
+public:
+  struct UpdateCounters {
+    /**
+     * The number of shapes which were loaded from the shapefile.
+     */
+    unsigned loaded;
+
+    /**
+     * The number of shapes which were deleted from the cache.
+     */
+    unsigned evicted;
+  };
+
+private:
+  UpdateCounters last_update{0, 0};
+
   zzip_dir *const dir;
 
   shapefileObj file;
@@ -182,6 +220,14 @@ public:
     return serial;
   }
 
+  /**
+   * Returns what the last cache rescan by Update() did.  For
+   * profiling.
+   */
+  const UpdateCounters &GetLastUpdateCounters() const {
+    return last_update;
+  }
+
   const GeoPoint &GetCenter() const {
     return center;
   }
@@ -190,6 +236,14 @@ public:
     return shapes.empty();
   }
 
+  /**
+   * Is this file read from a ZIP archive?  All files of a map share
+   * one #zzip_dir.
+   */
+  bool IsArchived() const {
+    return dir != nullptr;
+  }
+
   bool IsVisible(double map_scale) const {
     return map_scale <= scale_threshold;
   }
@@ -38,6 +38,7 @@ Copyright_License {
 
 #ifdef ENABLE_OPENGL
 #include "ui/canvas/opengl/VertexPointer.hpp"
+#include "ui/canvas/opengl/Statistics.hpp"
 #include "ui/canvas/opengl/Buffer.hpp"
 #include "ui/canvas/opengl/Dynamic.hpp"
 #include "ui/canvas/opengl/Geo.hpp"
@@ -52,6 +53,31 @@ Copyright_License {
 #include <numeric>
 #include <set>
 
+#ifdef ENABLE_OPENGL
+
+/**
+ * The indices of all visible polygons which are drawn with a single
+ * glMultiDrawElements() call, concatenated in one GPU buffer.  They
+ * are only rebuilt when the visible shapes, the array buffer or the
+ * thinning level change, not on every redraw.
+ */
+struct TopographyFileRenderer::PolygonBuffer {
+  GLElementArrayBuffer buffer;
+
+  std::vector<GLsizei> counts;
+
+  /**
+   * Byte offsets into #buffer.
+   */
+  std::vector<const GLvoid *> offsets;
+
+  unsigned level;
+
+  bool dirty = true;
+};
+
+#endif
+
 TopographyFileRenderer::TopographyFileRenderer(const TopographyFile &_file,
                                                const TopographyLook &_look) noexcept
   :file(_file), look(_look),
@@ -70,6 +96,7 @@ TopographyFileRenderer::TopographyFileRenderer(const TopographyFile &_file,
 TopographyFileRenderer::~TopographyFileRenderer() noexcept
 {
 #ifdef ENABLE_OPENGL
+  delete polygon_buffer;
   delete array_buffer;
 #endif
 }
@@ -85,6 +112,10 @@ TopographyFileRenderer::UpdateVisibleShapes(const WindowProjection &projection)
 
   visible_serial = file.GetSerial();
   visible_bounds = projection.GetScreenBounds().Scale(1.2);
+#ifdef ENABLE_OPENGL
+  if (polygon_buffer != nullptr)
+    polygon_buffer->dirty = true;
+#endif
   visible_shapes.clear();
   visible_points.clear();
   visible_labels.clear();
@@ -129,6 +160,10 @@ TopographyFileRenderer::UpdateArrayBuffer() noexcept
 
   array_buffer_serial = file.GetSerial();
 
+  /* the shape offsets are going to change */
+  if (polygon_buffer != nullptr)
+    polygon_buffer->dirty = true;
+
   unsigned n = 0;
   for (auto &shape : file) {
     shape.SetOffset(n);
@@ -214,6 +249,7 @@ TopographyFileRenderer::Paint(Canvas &canvas,
 #else // !ENABLE_OPENGL
   const GeoClip clip(projection.GetScreenBounds().Scale(1.1));
   AllocatedArray<GeoPoint> geo_points;
+  AllocatedArray<PixelPoint> screen_points;
 
   int iskip = file.GetSkipSteps(map_scale);
 #endif
@@ -222,8 +258,21 @@ TopographyFileRenderer::Paint(Canvas &canvas,
   ScopeVertexPointer vp;
 
 #ifdef GL_EXT_multi_draw_arrays
-  std::vector<GLsizei> polygon_counts;
-  std::vector<GLshort> polygon_indices;
+  const bool multi_draw = GLExt::HaveMultiDrawElements();
+  if (multi_draw) {
+    if (polygon_buffer == nullptr)
+      polygon_buffer = new PolygonBuffer();
+    else if (polygon_buffer->level != level)
+      polygon_buffer->dirty = true;
+
+    if (polygon_buffer->dirty) {
+      polygon_buffer->counts.clear();
+      polygon_buffer->level = level;
+    }
+  }
+
+  /* only filled if the #polygon_buffer is being rebuilt */
+  std::vector<GLushort> polygon_indices;
 #endif
 #endif
 
@@ -252,13 +301,13 @@ TopographyFileRenderer::Paint(Canvas &canvas,
             (indices = shape.GetIndices(level, min_distance)).indices == nullptr) {
           unsigned offset = 0;
           for (unsigned n : lines) {
-            glDrawArrays(GL_LINE_STRIP, offset, n);
+            OpenGL::DrawArrays(GL_LINE_STRIP, offset, n);
             offset += n;
           }
         } else {
           for (unsigned n : ConstBuffer<GLushort>(indices.count, lines.size)) {
-            glDrawElements(GL_LINE_STRIP, n, GL_UNSIGNED_SHORT,
-                           indices.indices);
+            OpenGL::DrawElements(GL_LINE_STRIP, n, GL_UNSIGNED_SHORT,
+                                 indices.indices);
             indices.indices += n;
           }
         }
@@ -266,12 +315,16 @@ TopographyFileRenderer::Paint(Canvas &canvas,
         for (unsigned msize : lines) {
         shape_renderer.Begin(msize);
 
-        const GeoPoint *end = points + msize - 1;
-        for (; points < end; ++points)
-          shape_renderer.AddPointIfDistant(projection.GeoToScreen(*points));
+        screen_points.GrowDiscard(msize);
+        projection.GeoToScreen({points, msize},
+                               {screen_points.begin(), msize});
+        points += msize;
+
+        for (unsigned i = 0; i + 1 < msize; ++i)
+          shape_renderer.AddPointIfDistant(screen_points[i]);
 
         // make sure we always draw the last point
-        shape_renderer.AddPoint(projection.GeoToScreen(*points));
+        shape_renderer.AddPoint(screen_points[msize - 1]);
 
         shape_renderer.FinishPolyline(canvas);
       }
@@ -287,51 +340,65 @@ TopographyFileRenderer::Paint(Canvas &canvas,
 
 #ifdef GL_EXT_multi_draw_arrays
         const unsigned offset = shape.GetOffset();
-        if (GLExt::HaveMultiDrawElements() && offset + n < 0x10000) {
+        if (multi_draw && offset + n < 0x10000) {
           /* postpone, draw many polygons with a single
              glMultiDrawElements() call */
-          polygon_counts.push_back(n);
-          const size_t size = polygon_indices.size();
-          polygon_indices.resize(size + n, offset);
-          for (unsigned i = 0; i < n; ++i)
-            polygon_indices[size + i] += triangles.indices[i];
+          if (polygon_buffer->dirty) {
+            polygon_buffer->counts.push_back(n);
+            const size_t size = polygon_indices.size();
+            polygon_indices.resize(size + n, offset);
+            for (unsigned i = 0; i < n; ++i)
+              polygon_indices[size + i] += triangles.indices[i];
+          }
           break;
         }
 #endif
 
         vp.Update(GL_FLOAT, points);
-        glDrawElements(GL_TRIANGLE_STRIP, n, GL_UNSIGNED_SHORT,
-                       triangles.indices);
+        OpenGL::DrawElements(GL_TRIANGLE_STRIP, n, GL_UNSIGNED_SHORT,
+                             triangles.indices);
       }
 #else // !ENABLE_OPENGL
       {
+        /* shapes which are completely on the screen don't need to be
+           clipped */
+        const bool inside = clip.IsInside(shape.get_bounds());
+
         const GeoPoint *src = &points[0];
         for (const unsigned n : lines) {
+          const GeoPoint *polygon = src;
           unsigned msize = n / iskip;
+          src += n;
 
-          /* copy all polygon points into the geo_points array and
-             clip them, to avoid integer overflows (as PixelPoint may
-             store only 16 bit integers on some platforms) */
+          if (!inside || iskip > 1) {
+            /* copy all polygon points into the geo_points array and
+               clip them, to avoid integer overflows (as PixelPoint
+               may store only 16 bit integers on some platforms) */
 
-          geo_points.GrowDiscard(msize * 3);
-          for (unsigned i = 0; i < msize; ++i)
-            geo_points[i] = src[i * iskip];
+            geo_points.GrowDiscard(msize * 3);
+            for (unsigned i = 0; i < msize; ++i)
+              geo_points[i] = polygon[i * iskip];
+
+            polygon = geo_points.begin();
+
+            if (!inside)
+              msize = clip.ClipPolygon(geo_points.begin(),
+                                       geo_points.begin(), msize);
+          }
 
-          msize = clip.ClipPolygon(geo_points.begin(),
-                                   geo_points.begin(), msize);
           if (msize < 3)
             continue;
 
           shape_renderer.Begin(msize);
 
-          for (unsigned i = 0; i < msize; ++i) {
-            GeoPoint g = geo_points[i];
-            shape_renderer.AddPointIfDistant(projection.GeoToScreen(g));
-          }
+          screen_points.GrowDiscard(msize);
+          projection.GeoToScreen({polygon, msize},
+                                 {screen_points.begin(), msize});
 
-          shape_renderer.FinishPolygon(canvas);
+          for (unsigned i = 0; i < msize; ++i)
+            shape_renderer.AddPointIfDistant(screen_points[i]);
 
-          src += n;
+          shape_renderer.FinishPolygon(canvas);
         }
       }
 #endif
@@ -341,22 +408,33 @@ TopographyFileRenderer::Paint(Canvas &canvas,
 #ifdef ENABLE_OPENGL
 
 #ifdef GL_EXT_multi_draw_arrays
-  if (!polygon_indices.empty()) {
-    assert(GLExt::HaveMultiDrawElements());
-
-    std::vector<const GLshort *> polygon_pointers;
-    unsigned i = 0;
-    for (auto count : polygon_counts) {
-      polygon_pointers.push_back(polygon_indices.data() + i);
-      i += count;
+  if (multi_draw) {
+    if (polygon_buffer->dirty) {
+      polygon_buffer->buffer.Load(polygon_indices.size() * sizeof(GLushort),
+                                  polygon_indices.data());
+
+      polygon_buffer->offsets.clear();
+      std::size_t offset = 0;
+      for (auto count : polygon_buffer->counts) {
+        polygon_buffer->offsets.push_back((const GLvoid *)offset);
+        offset += count * sizeof(GLushort);
+      }
+
+      polygon_buffer->dirty = false;
     }
 
-    vp.Update(GL_FLOAT, nullptr);
+    if (!polygon_buffer->counts.empty()) {
+      polygon_buffer->buffer.Bind();
+      vp.Update(GL_FLOAT, nullptr);
 
-    GLExt::MultiDrawElements(GL_TRIANGLE_STRIP, polygon_counts.data(),
-                             GL_UNSIGNED_SHORT,
-                             (const GLvoid **)polygon_pointers.data(),
-                             polygon_counts.size());
+      GLExt::MultiDrawElements(GL_TRIANGLE_STRIP,
+                               polygon_buffer->counts.data(),
+                               GL_UNSIGNED_SHORT,
+                               (const GLvoid **)polygon_buffer->offsets.data(),
+                               polygon_buffer->counts.size());
+
+      GLElementArrayBuffer::Unbind();
+    }
   }
 #endif
 
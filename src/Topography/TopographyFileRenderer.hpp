@@ -77,6 +77,14 @@ class TopographyFileRenderer final
 #ifdef ENABLE_OPENGL
   GLArrayBuffer *array_buffer;
   Serial array_buffer_serial;
+
+  struct PolygonBuffer;
+
+  /**
+   * The merged polygon indices for glMultiDrawElements(); allocated
+   * on the first Paint() call.
+   */
+  PolygonBuffer *polygon_buffer = nullptr;
 #endif
 
 public:
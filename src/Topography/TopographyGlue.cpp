@@ -27,24 +27,159 @@ Copyright_License {
 #include "Profile/Profile.hpp"
 #include "LogFile.hpp"
 #include "Operation/Operation.hpp"
-#include "io/MapFile.hpp"
+#include "LocalPath.hpp"
+#include "io/FileCache.hpp"
+#include "io/FileOutputStream.hxx"
 #include "io/ZipArchive.hpp"
 #include "io/ZipLineReader.hpp"
+#include "io/ZipReader.hpp"
+#include "system/ConvertPathName.hpp"
+#include "system/FileUtil.hpp"
+#include "system/Path.hpp"
+#include "util/ScopeExit.hxx"
+#include "util/StringAPI.hxx"
+#include "util/StringCompare.hxx"
+
+#include <zzip/zzip.h>
+
+#include <cstddef>
+
+static constexpr const TCHAR *UNPACKED_CACHE_NAME = _T("topography-unpacked");
+
+/**
+ * Is this one of the files which shapelib accesses randomly?
+ */
+[[gnu::pure]]
+static bool
+IsShapeFile(const char *name) noexcept
+{
+  return StringEndsWithIgnoreCase(name, ".shp") ||
+    StringEndsWithIgnoreCase(name, ".shx") ||
+    StringEndsWithIgnoreCase(name, ".dbf") ||
+    StringEndsWithIgnoreCase(name, ".qix");
+}
+
+/**
+ * Does the ZIP file contain compressed shape files?  zzip can seek
+ * backwards in those only by inflating again from the beginning,
+ * which makes every TopographyFile::Update() very slow.
+ */
+static bool
+HasCompressedShapeFiles(struct zzip_dir *dir) noexcept
+{
+  zzip_rewinddir(dir);
+  AtScopeExit(dir) { zzip_rewinddir(dir); };
+
+  ZZIP_DIRENT e;
+  while (zzip_dir_read(dir, &e))
+    if (e.d_compr != 0 && IsShapeFile(e.d_name))
+      return true;
+
+  return false;
+}
+
+static void
+DeleteFiles(Path directory) noexcept
+{
+  struct Visitor final : File::Visitor {
+    void Visit(Path path, [[maybe_unused]] Path filename) override {
+      File::Delete(path);
+    }
+  } visitor;
+
+  Directory::VisitFiles(directory, visitor);
+}
+
+/**
+ * Extract all shape files from the root of the ZIP file into the
+ * given directory.
+ *
+ * Throws on error.
+ */
+static void
+ExtractShapeFiles(struct zzip_dir *dir, Path directory)
+{
+  zzip_rewinddir(dir);
+  AtScopeExit(dir) { zzip_rewinddir(dir); };
+
+  ZZIP_DIRENT e;
+  while (zzip_dir_read(dir, &e)) {
+    if (!IsShapeFile(e.d_name) || StringFind(e.d_name, '/') != nullptr)
+      continue;
+
+    ZipReader reader(dir, e.d_name);
+    FileOutputStream file(AllocatedPath::Build(directory,
+                                               PathName(e.d_name)));
+
+    std::byte buffer[16384];
+    std::size_t nbytes;
+    while ((nbytes = reader.Read(buffer, sizeof(buffer))) > 0)
+      file.Write(buffer, nbytes);
+
+    file.Commit();
+  }
+}
+
+/**
+ * Make sure that the shape files of the map file are available
+ * unpacked in a cache directory, where shapelib can read them with
+ * pread() instead of inflating them again for each update.  The
+ * #FileCache entry marks the unpacked files as complete and belonging
+ * to this version of the map file.
+ *
+ * Throws on error.
+ *
+ * @return the directory containing the unpacked files or nullptr if
+ * the map file does not need to be unpacked
+ */
+static AllocatedPath
+UnpackShapeFiles(struct zzip_dir *dir, Path map_path, FileCache &cache)
+{
+  if (!HasCompressedShapeFiles(dir))
+    return nullptr;
+
+  auto directory = MakeCacheDirectory(_T("topography"));
+  if (cache.Load(UNPACKED_CACHE_NAME, map_path))
+    return directory;
+
+  LogFormat("Unpacking topography");
+
+  cache.Flush(UNPACKED_CACHE_NAME);
+  DeleteFiles(directory);
+  ExtractShapeFiles(dir, directory);
+  cache.Save(UNPACKED_CACHE_NAME, map_path)->Commit();
+
+  return directory;
+}
 
 /**
  * Load topography from the map file (ZIP), load the other files from
  * the same ZIP file.
  */
 static bool
-LoadConfiguredTopographyZip(TopographyStore &store,
+LoadConfiguredTopographyZip(TopographyStore &store, FileCache *cache,
                             OperationEnvironment &operation)
 try {
-  auto archive = OpenMapFile();
-  if (!archive)
+  const auto map_path = Profile::GetPath(ProfileKeys::MapFile);
+  if (map_path == nullptr)
     return false;
 
-  ZipLineReaderA reader(archive->get(), "topology.tpl");
-  store.Load(operation, reader, nullptr, archive->get());
+  ZipArchive archive(map_path);
+
+  AllocatedPath directory = nullptr;
+  if (cache != nullptr) {
+    try {
+      directory = UnpackShapeFiles(archive.get(), map_path, *cache);
+    } catch (...) {
+      LogError(std::current_exception(), "Failed to unpack topography");
+    }
+  }
+
+  ZipLineReaderA reader(archive, "topology.tpl");
+  if (directory != nullptr)
+    store.Load(operation, reader, directory.c_str(), nullptr);
+  else
+    store.Load(operation, reader, nullptr, archive.get());
   return true;
 } catch (...) {
   LogError(std::current_exception(), "No topography in map file");
@@ -52,11 +187,11 @@ try {
 }
 
 bool
-LoadConfiguredTopography(TopographyStore &store,
+LoadConfiguredTopography(TopographyStore &store, FileCache *cache,
                          OperationEnvironment &operation)
 {
   LogFormat("Loading Topography File...");
   operation.SetText(_("Loading Topography File..."));
 
-  return LoadConfiguredTopographyZip(store, operation);
+  return LoadConfiguredTopographyZip(store, cache, operation);
 }
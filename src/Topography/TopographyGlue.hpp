@@ -25,10 +25,17 @@ Copyright_License {
 #define TOPOGRAPHY_GLUE_H
 
 class TopographyStore;
+class FileCache;
 class OperationEnvironment;
 
+/**
+ * Load the topography of the configured map file.
+ *
+ * @param cache if not nullptr, then compressed shape files are
+ * unpacked into the cache directory on first use
+ */
 bool
-LoadConfiguredTopography(TopographyStore &store,
+LoadConfiguredTopography(TopographyStore &store, FileCache *cache,
                          OperationEnvironment &operation);
 
 #endif
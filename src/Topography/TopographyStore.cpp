@@ -28,6 +28,7 @@ Copyright_License {
 #include "util/ConvertString.hpp"
 #include "io/LineReader.hpp"
 #include "Operation/Operation.hpp"
+#include "thread/ThreadPool.hpp"
 #include "Compatibility/path.h"
 #include "Asset.hpp"
 #include "Resources.hpp"
@@ -127,6 +128,39 @@ TopographyStore::ScanVisibility(const WindowProjection &m_projection,
   return num_updated;
 }
 
+unsigned
+TopographyStore::ScanVisibility(const WindowProjection &m_projection,
+                                ThreadPool &pool)
+{
+  /* job 0 updates all files inside the ZIP archive; each other job
+     updates one plain file */
+  StaticArray<TopographyFile *, MAXTOPOGRAPHY> archived, plain;
+  for (auto *file : files) {
+    if (file->IsArchived())
+      archived.push_back(file);
+    else
+      plain.push_back(file);
+  }
+
+  unsigned updated[MAXTOPOGRAPHY + 1];
+  pool.ForEach(plain.size() + 1, [&](unsigned i){
+    if (i == 0) {
+      updated[0] = 0;
+      for (auto *file : archived)
+        if (file->Update(m_projection))
+          ++updated[0];
+    } else
+      updated[i] = plain[i - 1]->Update(m_projection);
+  });
+
+  unsigned num_updated = 0;
+  for (unsigned i = 0; i <= plain.size(); ++i)
+    num_updated += updated[i];
+
+  serial += num_updated;
+  return num_updated;
+}
+
 void
 TopographyStore::LoadAll()
 {
@@ -32,6 +32,7 @@ Copyright_License {
 
 class WindowProjection;
 class TopographyFile;
+class ThreadPool;
 class NLineReader;
 class OperationEnvironment;
 struct zzip_dir;
@@ -86,6 +87,17 @@ public:
   unsigned ScanVisibility(const WindowProjection &m_projection,
                           unsigned max_update=1024);
 
+  /**
+   * Update all files, distributing them over the #ThreadPool.  Files
+   * which read from the same ZIP archive are updated one after
+   * another in one job, because a #zzip_dir must not be used by two
+   * threads at a time.
+   *
+   * @return the number of files which were updated
+   */
+  unsigned ScanVisibility(const WindowProjection &m_projection,
+                          ThreadPool &pool);
+
   /**
    * Load all shapes of all files into memory.  For debugging
    * purposes.
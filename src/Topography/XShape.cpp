@@ -156,6 +156,8 @@ XShape::XShape(shapefileObj *shpfile, const GeoPoint &file_center, int i,
     const char *src = msDBFReadStringAttribute(shpfile->hDBF, i, label_field);
     label = ImportLabel(src);
   }
+
+  memory_usage.Update(sizeof(*this) + (p - points) * sizeof(*points));
 }
 
 XShape::~XShape() noexcept
@@ -170,6 +172,28 @@ XShape::~XShape() noexcept
 
 #ifdef ENABLE_OPENGL
 
+/**
+ * Move the first #size elements of the buffer to a new allocation
+ * which has exactly this size.  Thinning usually leaves a large part
+ * of the worst-case allocation unused, and with up to
+ * #THINNING_LEVELS index buffers per shape, the indices can need
+ * more memory than the points.
+ */
+static uint16_t *
+ShrinkIndexBuffer(uint16_t *buffer, std::size_t size,
+                  std::size_t allocated) noexcept
+{
+  assert(size <= allocated);
+
+  if (size == allocated)
+    return buffer;
+
+  uint16_t *result = new uint16_t[size];
+  std::copy_n(buffer, size, result);
+  delete[] buffer;
+  return result;
+}
+
 bool
 XShape::BuildIndices(unsigned thinning_level, ShapeScalar min_distance) noexcept
 {
@@ -184,9 +208,9 @@ XShape::BuildIndices(unsigned thinning_level, ShapeScalar min_distance) noexcept
   if (type == MS_SHAPE_LINE) {
     if (num_points <= 2)
       return false;  // line cannot be simplified, so don't create indices
-    index_count[thinning_level] = idx_count =
-      new GLushort[num_lines + num_points];
-    indices[thinning_level] = idx = idx_count + num_lines;
+    const std::size_t allocated = num_lines + num_points;
+    uint16_t *const buffer = idx_count = new GLushort[allocated];
+    idx = idx_count + num_lines;
 
     const uint16_t *end_l = lines + num_lines;
     const ShapePoint *p = points;
@@ -211,12 +235,15 @@ XShape::BuildIndices(unsigned thinning_level, ShapeScalar min_distance) noexcept
       p++; i++;
       *idx_count++ = idx - after_first_idx + 1;
     }
-    // TODO: free memory saved by thinning (use malloc/realloc or some class?)
+
+    index_count[thinning_level] =
+      ShrinkIndexBuffer(buffer, idx - buffer, allocated);
+    indices[thinning_level] = index_count[thinning_level] + num_lines;
     return true;
   } else if (type == MS_SHAPE_POLYGON) {
-    index_count[thinning_level] = idx_count =
-      new GLushort[1 + 3*(num_points-2) + 2*(num_lines-1)];
-    indices[thinning_level] = idx = idx_count + 1;
+    const std::size_t allocated = 1 + 3*(num_points-2) + 2*(num_lines-1);
+    idx_count = new GLushort[allocated];
+    idx = idx_count + 1;
 
     *idx_count = 0;
     const ShapePoint *pt = points;
@@ -233,7 +260,10 @@ XShape::BuildIndices(unsigned thinning_level, ShapeScalar min_distance) noexcept
       pt += lines[i];
     }
     *idx_count = TriangleToStrip(idx, *idx_count, num_points, num_lines);
-    // TODO: free memory saved by thinning (use malloc/realloc or some class?)
+
+    index_count[thinning_level] =
+      ShrinkIndexBuffer(idx_count, 1 + *idx_count, allocated);
+    indices[thinning_level] = index_count[thinning_level] + 1;
     return true;
   } else {
     gcc_unreachable();
@@ -28,6 +28,7 @@ Copyright_License {
 #include "util/ConstBuffer.hxx"
 #include "util/AllocatedString.hxx"
 #include "Geo/GeoBounds.hpp"
+#include "system/MemoryAccounting.hpp"
 #include "shapelib/mapserver.h"
 #include "shapelib/mapshape.h"
 #ifdef ENABLE_OPENGL
@@ -91,6 +92,9 @@ class XShape {
 
   BasicAllocatedString<TCHAR> label;
 
+  [[no_unique_address]]
+  MemoryAccounting::Reporter memory_usage{MemoryAccounting::Account::TOPOGRAPHY};
+
 public:
   XShape(shapefileObj *shpfile, const GeoPoint &file_center, int i,
          int label_field=-1);
@@ -0,0 +1,106 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "TraceFile.hpp"
+#include "thread/TraceEvents.hpp"
+#include "io/FileOutputStream.hxx"
+#include "io/BufferedOutputStream.hxx"
+#include "system/Path.hpp"
+
+#include <algorithm>
+
+/**
+ * Write a JSON string.  All names are string literals or thread
+ * names, therefore characters which would need escaping are simply
+ * replaced.
+ */
+static void
+WriteString(BufferedOutputStream &os, const char *s)
+{
+  os.Write('"');
+  for (; *s != 0; ++s) {
+    const char ch = *s;
+    os.Write(ch == '"' || ch == '\\' || (unsigned char)ch < 0x20 ? '_' : ch);
+  }
+  os.Write('"');
+}
+
+static void
+WriteThread(BufferedOutputStream &os, const TraceEvents::Thread &thread,
+            std::chrono::microseconds origin)
+{
+  os.Format(",\n{\"ph\":\"M\",\"pid\":1,\"tid\":%u,"
+            "\"name\":\"thread_name\",\"args\":{\"name\":",
+            thread.id);
+  WriteString(os, thread.name);
+  os.Write("}}");
+
+  /* the ring buffer may have lost the "begin" event of a slice, and
+     slices may have been closed after tracing was disabled; skip
+     "end" events which have no matching "begin" */
+  unsigned depth = 0;
+
+  for (const auto &event : thread.events) {
+    if (event.begin)
+      ++depth;
+    else if (depth > 0)
+      --depth;
+    else
+      continue;
+
+    os.Format(",\n{\"ph\":\"%c\",\"pid\":1,\"tid\":%u,\"ts\":%llu",
+              event.begin ? 'B' : 'E', thread.id,
+              (unsigned long long)(event.time - origin).count());
+    if (event.begin) {
+      os.Write(",\"name\":");
+      WriteString(os, event.name);
+    }
+    os.Write('}');
+  }
+}
+
+void
+WriteTraceFile(Path path)
+{
+  const auto threads = TraceEvents::Collect();
+
+  std::chrono::microseconds origin = std::chrono::microseconds::max();
+  for (const auto &thread : threads)
+    for (const auto &event : thread.events)
+      origin = std::min(origin, event.time);
+
+  FileOutputStream file(path);
+  BufferedOutputStream os(file);
+
+  os.Write("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"
+           "{\"ph\":\"M\",\"pid\":1,\"name\":\"process_name\","
+           "\"args\":{\"name\":\"XCSoar\"}}");
+
+  for (const auto &thread : threads)
+    WriteThread(os, thread, origin);
+
+  os.Write("\n]}\n");
+
+  os.Flush();
+  file.Commit();
+}
@@ -39,6 +39,11 @@ Copyright_License {
 
 namespace LiveTrack24 {
 
+/**
+ * The maximum duration of a tracking request in seconds.
+ */
+static constexpr long REQUEST_TIMEOUT = 30;
+
 Co::Task<UserID>
 Client::GetUserID(const TCHAR *username, const TCHAR *password)
 {
@@ -168,6 +173,9 @@ Client::SendRequest(CurlEasy easy)
   Curl::Setup(easy);
   easy.SetFailOnError();
 
+  /* don't let a stalled request hold up the queued positions */
+  easy.SetTimeout(REQUEST_TIMEOUT);
+
   const auto _response = co_await Curl::CoRequest(curl, std::move(easy));
   StringView response{std::string_view{_response.body}};
   if (response.StartsWith("OK"))
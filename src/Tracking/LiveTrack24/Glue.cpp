@@ -25,6 +25,7 @@ Copyright_License {
 #include "NMEA/MoreData.hpp"
 #include "NMEA/Derived.hpp"
 #include "Units/System.hpp"
+#include "time/BrokenDateTime.hpp"
 #include "Operation/Operation.hpp"
 #include "LogFile.hpp"
 #include "co/Task.hxx"
@@ -97,31 +98,59 @@ Glue::OnTimer(const MoreData &basic, const DerivedInfo &calculated)
     /* later */
     return;
 
-  if (inject_task)
-    /* still running, skip this submission */
-    return;
-
-  date_time = basic.date_time_utc;
+  BrokenDateTime date_time = basic.date_time_utc;
   if (!date_time.IsDatePlausible())
     /* use "today" if the GPS didn't provide a date */
     (BrokenDate &)date_time = BrokenDate::TodayUTC();
 
-  location = basic.location;
+  Position position;
+  position.timestamp = date_time.ToTimePoint();
+  position.location = basic.location;
   /* XXX use nav_altitude? */
-  altitude = basic.NavAltitudeAvailable() && basic.nav_altitude > 0
+  position.altitude = basic.NavAltitudeAvailable() && basic.nav_altitude > 0
     ? (unsigned)basic.nav_altitude
     : 0u;
-  ground_speed = basic.ground_speed_available
+  position.ground_speed = basic.ground_speed_available
     ? (unsigned)Units::ToUserUnit(basic.ground_speed, Unit::KILOMETER_PER_HOUR)
     : 0u;
-  track = basic.track_available
+  position.track = basic.track_available
     ? basic.track
     : Angle::Zero();
 
-  last_flying = flying;
-  flying = calculated.flight.flying;
+  bool start;
+
+  {
+    const std::lock_guard<Mutex> lock(mutex);
+
+    if (calculated.flight.flying)
+      Push(position);
+    else if (flying)
+      landed = true;
 
-  inject_task.Start(Tick(settings), BIND_THIS_METHOD(OnCompletion));
+    flying = calculated.flight.flying;
+    start = !queue.empty() || landed;
+  }
+
+  if (start && !inject_task)
+    /* if a submission is still running, it will pick up the new
+       position from the queue; the timer is never blocked by a slow
+       request */
+    inject_task.Start(Tick(settings), BIND_THIS_METHOD(OnCompletion));
+}
+
+void
+Glue::Push(const Position &position) noexcept
+{
+  if (queue.size() >= MAX_QUEUE) {
+    /* drop every other position, but never the front item, which
+       may be in transit right now */
+    std::size_t j = 1;
+    for (std::size_t i = 2; i < queue.size(); i += 2)
+      queue[j++] = queue[i];
+    queue.resize(j);
+  }
+
+  queue.push_back(position);
 }
 
 Co::InvokeTask
@@ -129,59 +158,95 @@ Glue::Tick(Settings settings)
 {
   assert(settings.enabled);
 
-  if (!flying) {
-    if (last_flying && state.HasSession()) {
-      /* landing: end tracking session */
-      co_await client.EndTracking(state.session_id, state.packet_id);
-      state.ResetSession();
-      last_timestamp = {};
-    }
+  /* HTTP requests go through the global CURLM handle, which keeps
+     the connection to the server alive between requests; a backlog
+     after a coverage gap is therefore submitted back-to-back over
+     one connection */
 
-    /* don't track if not flying */
-    co_return;
-  }
+  while (true) {
+    Position position;
 
-  const auto current_timestamp = date_time.ToTimePoint();
+    {
+      const std::lock_guard<Mutex> lock(mutex);
+      if (queue.empty())
+        break;
 
-  if (state.HasSession() &&
-      current_timestamp + std::chrono::minutes(1) < last_timestamp) {
-    /* time warp: create a new session */
-    const auto old_state = state;
-    state.ResetSession();
-    co_await client.EndTracking(old_state.session_id, old_state.packet_id);
-  }
-
-  last_timestamp = current_timestamp;
+      position = queue.front();
+    }
 
-  if (!state.HasSession()) {
-    UserID user_id = 0;
-    if (!settings.username.empty() && !settings.password.empty())
-      user_id = co_await client.GetUserID(settings.username, settings.password);
+    if (state.HasSession() &&
+        position.timestamp + std::chrono::minutes(1) < last_timestamp) {
+      /* time warp: create a new session */
+      const auto old_state = state;
+      state.ResetSession();
+      co_await client.EndTracking(old_state.session_id, old_state.packet_id);
+    }
 
-    if (user_id == 0) {
-      settings.username.clear();
-      settings.password.clear();
-      state.session_id = GenerateSessionID();
-    } else {
-      state.session_id = GenerateSessionID(user_id);
+    if (!state.HasSession()) {
+      UserID user_id = 0;
+      if (!settings.username.empty() && !settings.password.empty())
+        user_id = co_await client.GetUserID(settings.username, settings.password);
+
+      if (user_id == 0) {
+        settings.username.clear();
+        settings.password.clear();
+        state.session_id = GenerateSessionID();
+      } else {
+        state.session_id = GenerateSessionID(user_id);
+      }
+
+      try {
+        co_await client.StartTracking(state.session_id, settings.username,
+                                      settings.password, settings.interval,
+                                      MapVehicleTypeToLivetrack24(settings.vehicleType),
+                                      settings.vehicle_name);
+      } catch (...) {
+        state.ResetSession();
+        throw;
+      }
+
+      state.packet_id = 2;
     }
 
     try {
-      co_await client.StartTracking(state.session_id, settings.username,
-                                    settings.password, settings.interval,
-                                    MapVehicleTypeToLivetrack24(settings.vehicleType),
-                                    settings.vehicle_name);
+      co_await client.SendPosition(state.session_id, state.packet_id,
+                                   position.location, position.altitude,
+                                   position.ground_speed, position.track,
+                                   position.timestamp);
     } catch (...) {
-      state.ResetSession();
+      /* keep the position for the next attempt, unless it has
+         failed too often */
+      const std::lock_guard<Mutex> lock(mutex);
+      if (++front_failures >= MAX_ATTEMPTS && !queue.empty()) {
+        queue.pop_front();
+        front_failures = 0;
+      }
+
       throw;
     }
 
-    state.packet_id = 2;
+    ++state.packet_id;
+    last_timestamp = position.timestamp;
+
+    const std::lock_guard<Mutex> lock(mutex);
+    queue.pop_front();
+    front_failures = 0;
   }
 
-  co_await client.SendPosition(state.session_id, state.packet_id++,
-                               location, altitude, ground_speed, track,
-                               current_timestamp);
+  bool end;
+
+  {
+    const std::lock_guard<Mutex> lock(mutex);
+    end = landed;
+    landed = false;
+  }
+
+  if (end && state.HasSession()) {
+    /* landing: end tracking session */
+    co_await client.EndTracking(state.session_id, state.packet_id);
+    state.ResetSession();
+    last_timestamp = {};
+  }
 }
 
 void
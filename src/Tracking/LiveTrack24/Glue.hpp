@@ -29,7 +29,10 @@ Copyright_License {
 #include "time/PeriodClock.hpp"
 #include "Geo/GeoPoint.hpp"
 #include "co/InjectTask.hxx"
-#include "time/BrokenDateTime.hpp"
+#include "thread/Mutex.hxx"
+
+#include <cstddef>
+#include <deque>
 
 struct MoreData;
 struct DerivedInfo;
@@ -66,12 +69,51 @@ class Glue final {
    */
   std::chrono::system_clock::time_point last_timestamp{};
 
-  BrokenDateTime date_time;
-  GeoPoint location;
-  unsigned altitude;
-  unsigned ground_speed;
-  Angle track;
-  bool flying = false, last_flying;
+  struct Position {
+    std::chrono::system_clock::time_point timestamp;
+    GeoPoint location;
+    unsigned altitude;
+    unsigned ground_speed;
+    Angle track;
+  };
+
+  /**
+   * The maximum number of positions in #queue.  When it is full,
+   * every other queued position is dropped, i.e. the backlog keeps
+   * covering the whole gap at a lower resolution.
+   */
+  static constexpr std::size_t MAX_QUEUE = 64;
+
+  /**
+   * Give up a position after this number of failed attempts, so a
+   * position which the server rejects does not block the queue.
+   */
+  static constexpr unsigned MAX_ATTEMPTS = 3;
+
+  /**
+   * Protects #queue, #front_failures, #flying, #landed.
+   */
+  Mutex mutex;
+
+  /**
+   * Positions which have not been submitted yet, oldest first.  The
+   * front item is removed only after the server has accepted it.
+   */
+  std::deque<Position> queue;
+
+  /**
+   * The number of failed attempts to submit the front item of
+   * #queue.
+   */
+  unsigned front_failures = 0;
+
+  bool flying = false;
+
+  /**
+   * Has the aircraft landed since the last Tick()?  Then the
+   * tracking session shall be ended.
+   */
+  bool landed = false;
 
   Co::InjectTask inject_task;
 
@@ -82,6 +124,14 @@ public:
   void OnTimer(const MoreData &basic, const DerivedInfo &calculated);
 
 protected:
+  /**
+   * Add a position to the #queue.  Caller must lock the mutex.
+   */
+  void Push(const Position &position) noexcept;
+
+  /**
+   * Submit all queued positions, one after the other.
+   */
   Co::InvokeTask Tick(Settings settings);
   void OnCompletion(std::exception_ptr error) noexcept;
 };
@@ -230,7 +230,7 @@ SkyLinesTracking::MakeThermalRequest(uint64_t key)
 
 SkyLinesTracking::TrafficRequestPacket
 SkyLinesTracking::MakeTrafficRequest(uint64_t key, bool followees, bool club,
-                                     bool near)
+                                     bool near, bool delta)
 {
   assert(key != 0);
 
@@ -241,7 +241,8 @@ SkyLinesTracking::MakeTrafficRequest(uint64_t key, bool followees, bool club,
   packet.header.key = ToBE64(key);
   packet.flags = ToBE32((followees ? packet.FLAG_FOLLOWEES : 0)
                         | (club ? packet.FLAG_CLUB : 0)
-                        | (near ? packet.FLAG_NEAR : 0));
+                        | (near ? packet.FLAG_NEAR : 0)
+                        | (delta ? packet.FLAG_DELTA : 0));
   packet.reserved = 0;
 
   packet.header.crc = ToBE16(UpdateCRC16CCITT(&packet, sizeof(packet), 0));
@@ -83,7 +83,8 @@ MakeThermalRequest(uint64_t key);
 
 gcc_const
 TrafficRequestPacket
-MakeTrafficRequest(uint64_t key, bool followees, bool club, bool near);
+MakeTrafficRequest(uint64_t key, bool followees, bool club, bool near,
+                   bool delta);
 
 gcc_const
 UserNameRequestPacket
@@ -36,8 +36,11 @@ Copyright_License {
 #include "util/UTF8.hpp"
 #include "util/ConvertString.hpp"
 
+#include <algorithm>
 #include <string>
 
+#include <string.h>
+
 void
 SkyLinesTracking::Client::Open(Cares::Channel &cares, const char *server)
 {
@@ -58,6 +61,8 @@ SkyLinesTracking::Client::Open(SocketAddress _address)
   Close();
 
   address = _address;
+  fix_batch_supported = false;
+  last_ack_id = -1;
 
   {
     const std::lock_guard<Mutex> lock(mutex);
@@ -103,6 +108,41 @@ SkyLinesTracking::Client::SendFix(const NMEAInfo &basic)
   SendPacket(ToFix(key, basic));
 }
 
+bool
+SkyLinesTracking::Client::SendFixBatch(uint16_t id,
+                                       const FixPacket *fixes, unsigned n)
+{
+  assert(key != 0);
+  assert(n > 0);
+  assert(n <= FixBatchPacket::MAX_FIXES);
+
+  struct {
+    FixBatchPacket header;
+    uint8_t fixes[FixBatchPacket::MAX_FIXES * FixBatchPacket::FIX_SIZE];
+  } data;
+
+  data.header.header.magic = ToBE32(MAGIC);
+  data.header.header.crc = 0;
+  data.header.header.type = ToBE16(Type::FIX_BATCH);
+  data.header.header.key = ToBE64(key);
+  data.header.id = ToBE16(id);
+  data.header.reserved = 0;
+  data.header.fix_count = n;
+  data.header.reserved2 = 0;
+
+  /* strip the header from each FixPacket */
+  for (unsigned i = 0; i < n; ++i)
+    memcpy(data.fixes + i * FixBatchPacket::FIX_SIZE,
+           (const uint8_t *)&fixes[i] + sizeof(fixes[i].header),
+           FixBatchPacket::FIX_SIZE);
+
+  const size_t size = sizeof(data.header) + n * FixBatchPacket::FIX_SIZE;
+  data.header.header.crc = ToBE16(UpdateCRC16CCITT(&data, size, 0));
+
+  const std::lock_guard<Mutex> lock(mutex);
+  return socket.Write(&data, size, address) == ssize_t(size);
+}
+
 void
 SkyLinesTracking::Client::SendPing(uint16_t id)
 {
@@ -137,11 +177,11 @@ SkyLinesTracking::Client::SendThermalRequest()
 
 void
 SkyLinesTracking::Client::SendTrafficRequest(bool followees, bool club,
-                                             bool near_)
+                                             bool near_, bool delta)
 {
   assert(key != 0);
 
-  SendPacket(MakeTrafficRequest(key, followees, club, near_));
+  SendPacket(MakeTrafficRequest(key, followees, club, near_, delta));
 }
 
 void
@@ -173,6 +213,41 @@ SkyLinesTracking::Client::OnTrafficReceived(const TrafficResponsePacket &packet,
                        (int16_t)FromBE16(traffic.altitude));
 }
 
+inline void
+SkyLinesTracking::Client::OnTrafficDeltaReceived(const TrafficDeltaResponsePacket &packet,
+                                                 size_t length)
+{
+  if (length < sizeof(packet))
+    return;
+
+  const unsigned n = packet.traffic_count;
+  const ConstBuffer<TrafficDeltaResponsePacket::Traffic>
+    list((const TrafficDeltaResponsePacket::Traffic *)(&packet + 1), n);
+
+  if (length != sizeof(packet) + n * sizeof(list.front()))
+    return;
+
+  const int32_t reference_latitude = FromBE32(packet.reference.latitude);
+  const int32_t reference_longitude = FromBE32(packet.reference.longitude);
+  const uint32_t time = FromBE32(packet.time);
+
+  for (const auto &traffic : list) {
+    const int32_t latitude = reference_latitude +
+      (int16_t)FromBE16(traffic.latitude) * TrafficDeltaResponsePacket::UNIT;
+    const int32_t longitude = reference_longitude +
+      (int16_t)FromBE16(traffic.longitude) * TrafficDeltaResponsePacket::UNIT;
+
+    ::GeoPoint location(Angle::Degrees(longitude / 1000000.),
+                        Angle::Degrees(latitude / 1000000.));
+    location.Normalize();
+
+    handler->OnTraffic(FromBE32(traffic.pilot_id),
+                       time - std::min(time, FromBE16(traffic.age) * 1000u),
+                       location,
+                       (int16_t)FromBE16(traffic.altitude));
+  }
+}
+
 inline void
 SkyLinesTracking::Client::OnUserNameReceived(const UserNameResponsePacket &packet,
                                              size_t length)
@@ -244,6 +319,7 @@ SkyLinesTracking::Client::OnDatagramReceived(void *data, size_t length)
 
   const ACKPacket &ack = *(const ACKPacket *)data;
   const TrafficResponsePacket &traffic = *(const TrafficResponsePacket *)data;
+  const auto &traffic_delta = *(const TrafficDeltaResponsePacket *)data;
   const UserNameResponsePacket &user_name =
     *(const UserNameResponsePacket *)data;
   const auto &wave = *(const WaveResponsePacket *)data;
@@ -252,6 +328,7 @@ SkyLinesTracking::Client::OnDatagramReceived(void *data, size_t length)
   switch ((Type)FromBE16(header.type)) {
   case PING:
   case FIX:
+  case FIX_BATCH:
   case TRAFFIC_REQUEST:
   case USER_NAME_REQUEST:
   case WAVE_SUBMIT:
@@ -261,14 +338,23 @@ SkyLinesTracking::Client::OnDatagramReceived(void *data, size_t length)
     break;
 
   case ACK:
-    if (length >= sizeof(ack))
+    if (length >= sizeof(ack)) {
+      if (ack.flags & ToBE32(ACKPacket::FLAG_FIX_BATCH))
+        fix_batch_supported = true;
+      last_ack_id = FromBE16(ack.id);
+
       handler->OnAck(FromBE16(ack.id));
+    }
     break;
 
   case TRAFFIC_RESPONSE:
     OnTrafficReceived(traffic, length);
     break;
 
+  case TRAFFIC_DELTA_RESPONSE:
+    OnTrafficDeltaReceived(traffic_delta, length);
+    break;
+
   case USER_NAME_RESPONSE:
     OnUserNameReceived(user_name, length);
     break;
@@ -32,6 +32,7 @@ Copyright_License {
 #include "util/Cancellable.hxx"
 #include "util/Compiler.h"
 
+#include <atomic>
 #include <cstdint>
 #include <optional>
 
@@ -42,7 +43,9 @@ namespace Cares { class Channel; }
 
 namespace SkyLinesTracking {
 
+struct FixPacket;
 struct TrafficResponsePacket;
+struct TrafficDeltaResponsePacket;
 struct UserNameResponsePacket;
 struct WaveResponsePacket;
 struct ThermalResponsePacket;
@@ -64,6 +67,16 @@ class Client final : Cares::SimpleHandler {
   UniqueSocketDescriptor socket;
   SocketEvent socket_event;
 
+  /**
+   * Has the server announced #ACKPacket::FLAG_FIX_BATCH?
+   */
+  std::atomic_bool fix_batch_supported{false};
+
+  /**
+   * The id of the most recently received #ACK, or -1 if none.
+   */
+  std::atomic_int last_ack_id{-1};
+
 public:
   explicit Client(EventLoop &event_loop,
                   Handler *_handler=nullptr)
@@ -117,21 +130,54 @@ public:
   }
 
   void SendFix(const NMEAInfo &basic);
+
+  /**
+   * Send several fixes in one #FIX_BATCH datagram.  Only call this
+   * if SupportsFixBatch() returns true.
+   *
+   * @param n the number of fixes; at most
+   * #FixBatchPacket::MAX_FIXES
+   */
+  bool SendFixBatch(uint16_t id, const FixPacket *fixes, unsigned n);
+
   void SendPing(uint16_t id);
 
+  /**
+   * Does the server understand #FIX_BATCH?  This is only known after
+   * it has acknowledged a #PING.
+   */
+  bool SupportsFixBatch() const noexcept {
+    return fix_batch_supported.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Returns the id of the most recently received #ACK, or -1 if
+   * there was none.
+   */
+  int GetLastAckId() const noexcept {
+    return last_ack_id.load(std::memory_order_relaxed);
+  }
+
   void SendThermal(uint32_t time,
                    ::GeoPoint bottom_location, int bottom_altitude,
                    ::GeoPoint top_location, int top_altitude,
                    double lift);
   void SendThermalRequest();
 
-  void SendTrafficRequest(bool followees, bool club, bool near_);
+  /**
+   * @param delta announce support for #TRAFFIC_DELTA_RESPONSE, see
+   * #TrafficRequestPacket::FLAG_DELTA
+   */
+  void SendTrafficRequest(bool followees, bool club, bool near_,
+                          bool delta=false);
   void SendUserNameRequest(uint32_t user_id);
 
 private:
   void InternalClose() noexcept;
 
   void OnTrafficReceived(const TrafficResponsePacket &packet, size_t length);
+  void OnTrafficDeltaReceived(const TrafficDeltaResponsePacket &packet,
+                              size_t length);
   void OnUserNameReceived(const UserNameResponsePacket &packet,
                           size_t length);
   void OnWaveReceived(const WaveResponsePacket &packet, size_t length);
@@ -25,6 +25,7 @@ Copyright_License {
 #define XCSOAR_TRACKING_SKYLINES_TRAFFIC_HPP
 
 #include "Geo/GeoPoint.hpp"
+#include "Computer/WaveStore.hpp"
 #include "thread/Mutex.hxx"
 #include "util/tstring.hpp"
 #include "util/Compiler.h"
@@ -100,7 +101,11 @@ struct Data {
    */
   std::map<uint32_t, tstring> user_names;
 
-  std::list<Wave> waves;
+  /**
+   * Waves received from the server; a hard-coded upper limit
+   * discards the oldest ones.
+   */
+  WaveStore<Wave, 64> waves;
 
   std::list<Thermal> thermals;
 
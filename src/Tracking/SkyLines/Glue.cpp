@@ -37,6 +37,25 @@ using namespace std::chrono;
 
 static constexpr auto CLOUD_INTERVAL = minutes(1);
 
+/**
+ * How often to ask the server whether it understands #FIX_BATCH?
+ */
+static constexpr auto FIX_BATCH_PROBE_INTERVAL = minutes(10);
+
+/**
+ * A #FIX_BATCH which has not been acknowledged after this duration
+ * is considered lost, and its fixes will be sent again.
+ */
+static constexpr auto FIX_BATCH_ACK_TIMEOUT = seconds(20);
+
+/**
+ * The batch interval after the first lost #FIX_BATCH; it doubles
+ * with every further loss.
+ */
+static constexpr auto MIN_LOSSY_BATCH_INTERVAL = seconds(30);
+
+static constexpr auto MAX_BATCH_INTERVAL = minutes(5);
+
 SkyLinesTracking::Glue::Glue(EventLoop &event_loop,
                              Handler *_handler)
   :client(event_loop, _handler),
@@ -93,6 +112,14 @@ SkyLinesTracking::Glue::SendFixes(const NMEAInfo &basic)
     return;
   }
 
+  if (client.SupportsFixBatch()) {
+    SendFixBatches(basic);
+    return;
+  }
+
+  if (probe_clock.CheckAdvance(basic.clock, FIX_BATCH_PROBE_INTERVAL))
+    client.SendPing(next_packet_id++);
+
   if (queue != nullptr) {
     /* send queued fix packets, 8 at a time */
     unsigned n = 8;
@@ -113,6 +140,61 @@ SkyLinesTracking::Glue::SendFixes(const NMEAInfo &basic)
     client.SendFix(basic);
 }
 
+inline void
+SkyLinesTracking::Glue::SendFixBatches(const NMEAInfo &basic)
+{
+  if (pending_batch_id >= 0) {
+    if (client.GetLastAckId() == pending_batch_id) {
+      /* the server has received the batch: the link is good, send
+         more often */
+      pending_batch_id = -1;
+      if (queue != nullptr)
+        queue->PopBatch();
+
+      batch_interval = std::max(batch_interval / 2, interval);
+    } else if (basic.clock < pending_batch_time ||
+               basic.clock >= pending_batch_time + FIX_BATCH_ACK_TIMEOUT) {
+      /* the batch or its ACK was lost; keep the fixes and send them
+         again later, together with more fixes */
+      pending_batch_id = -1;
+
+      batch_interval = std::min(std::max(batch_interval * 2,
+                                         duration_cast<steady_clock::duration>(MIN_LOSSY_BATCH_INTERVAL)),
+                                duration_cast<steady_clock::duration>(MAX_BATCH_INTERVAL));
+    }
+  }
+
+  if (clock.CheckAdvance(basic.time, interval)) {
+    /* all fixes go through the queue and stay there until the server
+       acknowledges them */
+    if (queue == nullptr)
+      queue = new Queue();
+    queue->Push(ToFix(client.GetKey(), basic), 0);
+  }
+
+  if (queue == nullptr || pending_batch_id >= 0)
+    return;
+
+  if (queue->IsEmpty()) {
+    delete queue;
+    queue = nullptr;
+    return;
+  }
+
+  /* a backlog (e.g. after being offline) is sent as fast as the
+     server acknowledges it */
+  const bool backlog = queue->GetSize() >= FixBatchPacket::MAX_FIXES;
+  if (!batch_clock.CheckAdvance(basic.clock, batch_interval) && !backlog)
+    return;
+
+  FixPacket fixes[FixBatchPacket::MAX_FIXES];
+  const unsigned n = queue->PeekBatch(fixes, FixBatchPacket::MAX_FIXES);
+
+  pending_batch_id = next_packet_id++;
+  pending_batch_time = basic.clock;
+  client.SendFixBatch(pending_batch_id, fixes, n);
+}
+
 void
 SkyLinesTracking::Glue::SendCloudFix(const NMEAInfo &basic,
                                      const DerivedInfo &calculated)
@@ -176,7 +258,7 @@ SkyLinesTracking::Glue::Tick(const NMEAInfo &basic,
 
     if (traffic_enabled &&
         traffic_clock.CheckAdvance(basic.clock, minutes(1)))
-      client.SendTrafficRequest(true, true, near_traffic_enabled);
+      client.SendTrafficRequest(true, true, near_traffic_enabled, true);
   }
 
   if (cloud_client.IsConnected()) {
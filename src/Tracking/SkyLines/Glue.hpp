@@ -52,6 +52,37 @@ class Glue {
 
   Queue *queue = nullptr;
 
+  /**
+   * The id of the next #PING or #FIX_BATCH packet.
+   */
+  uint16_t next_packet_id = 1;
+
+  /**
+   * Send a #PING from time to time to find out whether the server
+   * understands #FIX_BATCH.
+   */
+  GPSClock probe_clock;
+
+  /**
+   * The id of the #FIX_BATCH which has been sent but not yet
+   * acknowledged, or -1 if there is none.
+   */
+  int pending_batch_id = -1;
+
+  /**
+   * When was #pending_batch_id sent?  (#NMEAInfo::clock)
+   */
+  TimeStamp pending_batch_time;
+
+  /**
+   * The minimum time between two #FIX_BATCH packets.  It grows while
+   * batches are not acknowledged (i.e. the link is poor), which packs
+   * more fixes into each datagram, and shrinks back to the tracking
+   * interval while the link is good.
+   */
+  std::chrono::steady_clock::duration batch_interval{};
+  GPSClock batch_clock;
+
   Client cloud_client;
   GPSClock cloud_clock;
 
@@ -74,6 +105,7 @@ private:
   bool IsConnected() const;
 
   void SendFixes(const NMEAInfo &basic);
+  void SendFixBatches(const NMEAInfo &basic);
   void SendCloudFix(const NMEAInfo &basic, const DerivedInfo &calculated);
 };
 
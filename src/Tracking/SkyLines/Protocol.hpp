@@ -101,6 +101,16 @@ enum Type {
    * @see #ThermalResponsePacket
    */
   THERMAL_RESPONSE = 13,
+
+  /**
+   * @see #TrafficDeltaResponsePacket
+   */
+  TRAFFIC_DELTA_RESPONSE = 14,
+
+  /**
+   * @see #FixBatchPacket
+   */
+  FIX_BATCH = 15,
 };
 
 /**
@@ -176,6 +186,12 @@ struct ACKPacket {
    */
   static const uint32_t FLAG_BAD_KEY = 0x1;
 
+  /**
+   * The server understands #FIX_BATCH.  Clients may send a #PING to
+   * find out.
+   */
+  static const uint32_t FLAG_FIX_BATCH = 0x2;
+
   Header header;
 
   /**
@@ -271,6 +287,56 @@ struct FixPacket {
 static_assert(sizeof(FixPacket) == 48, "Wrong struct size");
 #endif
 
+/**
+ * Several fixes in one datagram, to reduce the per-datagram overhead
+ * on metered links.  Only send this to servers which have announced
+ * support with #ACKPacket::FLAG_FIX_BATCH.  The server acknowledges
+ * with an #ACK which copies the #id, so the client can keep the
+ * fixes until they are confirmed.
+ */
+struct FixBatchPacket {
+  /**
+   * The size of one fix record: a #FixPacket without its #Header.
+   */
+  static const unsigned FIX_SIZE = sizeof(FixPacket) - sizeof(Header);
+
+  /**
+   * The maximum number of fixes in one packet, which keeps the
+   * datagram well below the common MTU.
+   */
+  static const unsigned MAX_FIXES = 32;
+
+  Header header;
+
+  /**
+   * An arbitrary number chosen by the client, usually a sequence
+   * number.
+   */
+  uint16_t id;
+
+  /**
+   * Reserved for future use.  Set to zero.
+   */
+  uint8_t reserved;
+
+  /**
+   * The number of fix records following this struct.
+   */
+  uint8_t fix_count;
+
+  /**
+   * Reserved for future use.  Set to zero.
+   */
+  uint32_t reserved2;
+
+  /* followed by a number of #FixPacket instances without #Header,
+     see #FIX_SIZE */
+};
+
+#ifdef __cplusplus
+static_assert(sizeof(FixBatchPacket) == 24, "Wrong struct size");
+#endif
+
 /**
  * The client requests traffic information.
  */
@@ -294,6 +360,15 @@ struct TrafficRequestPacket {
    */
   static const uint32_t FLAG_NEAR = 0x4;
 
+  /**
+   * The client understands #TRAFFIC_DELTA_RESPONSE.  The server may
+   * then omit traffic which has not changed since the previous
+   * response to this client, and may push new locations until the
+   * request expires.  Servers which do not know this flag send
+   * #TRAFFIC_RESPONSE as usual.
+   */
+  static const uint32_t FLAG_DELTA = 0x8;
+
   Header header;
 
   uint32_t flags;
@@ -370,6 +445,74 @@ struct TrafficResponsePacket {
 static_assert(sizeof(TrafficRequestPacket) == 24, "Wrong struct size");
 #endif
 
+/**
+ * A compact variant of #TrafficResponsePacket, sent only to clients
+ * which have set #TrafficRequestPacket::FLAG_DELTA.  Locations are
+ * quantised offsets from a reference location (usually the
+ * receiving client's own location), which halves the record size.
+ * Traffic which is too far away from the reference is sent in a
+ * #TrafficResponsePacket instead.
+ */
+struct TrafficDeltaResponsePacket {
+  /**
+   * The unit of #Traffic::latitude and #Traffic::longitude in
+   * micro-degrees (about 5.5 m at the equator).  The maximum offset
+   * is about 1.6 degrees.
+   */
+  static const int32_t UNIT = 50;
+
+  struct Traffic {
+    uint32_t pilot_id;
+
+    /**
+     * The location relative to #reference in #UNIT.
+     */
+    int16_t latitude, longitude;
+
+    int16_t altitude;
+
+    /**
+     * The age of this information in seconds, relative to #time.
+     */
+    uint16_t age;
+  };
+
+#ifdef __cplusplus
+  static_assert(sizeof(Traffic) == 12, "Wrong struct size");
+#endif
+
+  Header header;
+
+  /**
+   * Reserved for future use.
+   */
+  uint16_t reserved;
+
+  /**
+   * Reserved for future use.
+   */
+  uint8_t reserved2;
+
+  /**
+   * The number of #Traffic instances following this struct.
+   */
+  uint8_t traffic_count;
+
+  /**
+   * Millisecond of day (UTC).  The time stamp of each #Traffic is
+   * this value minus its #Traffic::age.
+   */
+  uint32_t time;
+
+  GeoPoint reference;
+
+  /* followed by a number of #Traffic instances */
+};
+
+#ifdef __cplusplus
+static_assert(sizeof(TrafficDeltaResponsePacket) == 32, "Wrong struct size");
+#endif
+
 /**
  * The client requests the name of a user.
  */
@@ -26,32 +26,68 @@ Copyright_License {
 
 #include "Protocol.hpp"
 #include "util/OverwritingRingBuffer.hpp"
+#include "util/ByteOrder.hxx"
 
+#include <cassert>
 #include <cstdint>
 
 namespace SkyLinesTracking {
 
 /**
  * This class stores FixPacket elements while the data connection is
- * offline, so we can post it as soon as we're back online.
+ * offline, so we can post it as soon as we're back online.  With a
+ * server which understands #FIX_BATCH, it also holds fixes until
+ * their batch has been acknowledged.
  */
 class Queue {
+public:
   /**
    * Don't queue any faster than this number of milliseconds.
    */
   static constexpr unsigned MIN_PERIOD_MS = 25000;
 
-  OverwritingRingBuffer<FixPacket, 256> queue;
+private:
+  using Buffer = OverwritingRingBuffer<FixPacket, 256>;
+  Buffer queue;
+
+  /**
+   * The number of items in #queue.
+   */
+  unsigned size = 0;
+
+  /**
+   * The number of items at the front of #queue which have been
+   * returned by PeekBatch() and not yet removed by PopBatch().
+   */
+  unsigned n_batch = 0;
 
 public:
   bool IsEmpty() const {
     return queue.empty();
   }
 
-  void Push(const FixPacket &packet) {
-    if (!IsEmpty() && (packet.time > queue.last().time &&
-                       queue.last().time + MIN_PERIOD_MS < packet.time))
-      return;
+  unsigned GetSize() const {
+    return size;
+  }
+
+  /**
+   * @param min_period_ms don't queue any faster than this number
+   * of milliseconds
+   */
+  void Push(const FixPacket &packet, unsigned min_period_ms=MIN_PERIOD_MS) {
+    if (!IsEmpty()) {
+      const uint32_t time = FromBE32(packet.time);
+      const uint32_t last_time = FromBE32(queue.last().time);
+      if (time >= last_time && time < last_time + min_period_ms)
+        return;
+    }
+
+    if (size == Buffer::capacity() - 1) {
+      /* the oldest item will be overwritten */
+      if (n_batch > 0)
+        --n_batch;
+    } else
+      ++size;
 
     queue.push(packet);
   }
@@ -61,8 +97,41 @@ public:
   }
 
   const FixPacket &Pop() {
+    assert(size > 0);
+    --size;
+    if (n_batch > 0)
+      --n_batch;
+
     return queue.shift();
   }
+
+  /**
+   * Copy up to #max of the oldest items, and remember them for
+   * PopBatch().
+   *
+   * @return the number of items copied
+   */
+  unsigned PeekBatch(FixPacket *dest, unsigned max) {
+    unsigned n = 0;
+    for (const auto &i : queue) {
+      if (n == max)
+        break;
+
+      dest[n++] = i;
+    }
+
+    n_batch = n;
+    return n;
+  }
+
+  /**
+   * Remove the items returned by the most recent PeekBatch() call,
+   * unless they have already been removed.
+   */
+  void PopBatch() {
+    while (n_batch > 0)
+      Pop();
+  }
 };
 
 } /* namespace SkyLinesTracking */
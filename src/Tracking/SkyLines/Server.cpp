@@ -30,6 +30,8 @@ Copyright_License {
 #include "net/UniqueSocketDescriptor.hxx"
 #include "util/CRC.hpp"
 
+#include <string.h>
+
 static UniqueSocketDescriptor
 CreateBindUDP(SocketAddress address)
 {
@@ -59,21 +61,123 @@ Server::~Server()
 }
 
 void
-Server::SendBuffer(SocketAddress address, ConstBuffer<void> buffer) noexcept
+Server::SendNow(SocketAddress address, ConstBuffer<void> buffer) noexcept
 {
+  ++statistics.send_calls;
+
   try {
-    ssize_t nbytes = socket.GetSocket().Write(buffer.data, buffer.size);
+    ssize_t nbytes = socket.GetSocket().Write(buffer.data, buffer.size,
+                                              address);
     if (nbytes < 0)
       throw MakeSocketError("Failed to send");
+
+    ++statistics.sent_datagrams;
   } catch (...) {
     OnSendError(address, std::current_exception());
   }
 }
 
+#ifdef __linux__
+
+inline void
+Server::Batch::Prepare(unsigned i, std::size_t size) noexcept
+{
+  iov[i].iov_base = buffers[i].data();
+  iov[i].iov_len = size;
+
+  msgs[i] = {};
+  msgs[i].msg_hdr.msg_iov = &iov[i];
+  msgs[i].msg_hdr.msg_iovlen = 1;
+  msgs[i].msg_hdr.msg_name = (struct sockaddr *)addresses[i];
+  msgs[i].msg_hdr.msg_namelen = addresses[i].GetCapacity();
+}
+
+void
+Server::FlushSendBatch() noexcept
+{
+  unsigned i = 0;
+  while (i < n_send) {
+    ++statistics.send_calls;
+
+    int n = sendmmsg(socket.GetSocket().Get(), &send_batch.msgs[i],
+                     n_send - i, MSG_DONTWAIT);
+    if (n > 0) {
+      statistics.sent_datagrams += n;
+      i += n;
+    } else {
+      /* report the datagram which failed and skip it */
+      OnSendError(send_batch.addresses[i],
+                  std::make_exception_ptr(MakeSocketError("Failed to send")));
+      ++i;
+    }
+  }
+
+  n_send = 0;
+}
+
+#endif
+
+void
+Server::SendBuffer(SocketAddress address, ConstBuffer<void> buffer) noexcept
+{
+#ifdef __linux__
+  if (batching && buffer.size <= MAX_DATAGRAM_SIZE) {
+    if (n_send == MAX_BATCH)
+      FlushSendBatch();
+
+    const unsigned i = n_send++;
+    memcpy(send_batch.buffers[i].data(), buffer.data, buffer.size);
+    send_batch.addresses[i] = address;
+    send_batch.Prepare(i, buffer.size);
+    send_batch.msgs[i].msg_hdr.msg_namelen = address.GetSize();
+    return;
+  }
+#endif
+
+  SendNow(address, buffer);
+}
+
 void
 Server::OnPing(const Client &client, unsigned id)
 {
-  SendPacket(client.address, MakeAck(client.key, id, 0));
+  SendPacket(client.address,
+             MakeAck(client.key, id, ACKPacket::FLAG_FIX_BATCH));
+}
+
+inline void
+Server::OnFixReceived(const Client &client, const FixPacket &fix)
+{
+  OnFix(client,
+        ImportTimeMs(fix.time),
+        fix.flags & ToBE32(FixPacket::FLAG_LOCATION)
+        ? ImportGeoPoint(fix.location)
+        : ::GeoPoint::Invalid(),
+        fix.flags & ToBE32(FixPacket::FLAG_ALTITUDE)
+        ? (int16_t)FromBE16(fix.altitude)
+        : -1);
+}
+
+inline void
+Server::OnFixBatchReceived(const Client &client,
+                           const FixBatchPacket &batch, size_t length)
+{
+  const unsigned n = batch.fix_count;
+  if (length != sizeof(batch) + n * FixBatchPacket::FIX_SIZE)
+    return;
+
+  const auto *src = (const uint8_t *)(&batch + 1);
+  for (unsigned i = 0; i < n; ++i, src += FixBatchPacket::FIX_SIZE) {
+    /* the records are not aligned; copy each one to a FixPacket */
+    FixPacket fix;
+    memcpy((uint8_t *)&fix + sizeof(fix.header), src,
+           FixBatchPacket::FIX_SIZE);
+    OnFixReceived(client, fix);
+  }
+
+  /* confirm reception, so the client can discard these fixes */
+  SendPacket(client.address,
+             MakeAck(client.key, FromBE16(batch.id),
+                     ACKPacket::FLAG_FIX_BATCH));
 }
 
 inline void
@@ -95,6 +199,7 @@ Server::OnDatagramReceived(Client &&client,
 
   const auto &ping = *(const PingPacket *)data;
   const auto &fix = *(const FixPacket *)data;
+  const auto &fix_batch = *(const FixBatchPacket *)data;
   const auto &traffic = *(const TrafficRequestPacket *)data;
   const auto &user_name = *(const UserNameRequestPacket *)data;
   const auto &wave = ((const WaveSubmitPacket *)data)->wave;
@@ -112,14 +217,14 @@ Server::OnDatagramReceived(Client &&client,
     if (length < sizeof(fix))
       return;
 
-    OnFix(client,
-          ImportTimeMs(fix.time),
-          fix.flags & ToBE32(FixPacket::FLAG_LOCATION)
-          ? ImportGeoPoint(fix.location)
-          : ::GeoPoint::Invalid(),
-          fix.flags & ToBE32(FixPacket::FLAG_ALTITUDE)
-          ? (int16_t)FromBE16(fix.altitude)
-          : -1);
+    OnFixReceived(client, fix);
+    break;
+
+  case FIX_BATCH:
+    if (length < sizeof(fix_batch))
+      return;
+
+    OnFixBatchReceived(client, fix_batch, length);
     break;
 
   case TRAFFIC_REQUEST:
@@ -127,7 +232,8 @@ Server::OnDatagramReceived(Client &&client,
       return;
 
     OnTrafficRequest(client,
-                     traffic.flags & ToBE32(TrafficRequestPacket::FLAG_NEAR));
+                     traffic.flags & ToBE32(TrafficRequestPacket::FLAG_NEAR),
+                     traffic.flags & ToBE32(TrafficRequestPacket::FLAG_DELTA));
     break;
 
   case USER_NAME_REQUEST:
@@ -173,6 +279,7 @@ Server::OnDatagramReceived(Client &&client,
 
   case ACK:
   case TRAFFIC_RESPONSE:
+  case TRAFFIC_DELTA_RESPONSE:
   case USER_NAME_RESPONSE:
   case WAVE_RESPONSE:
   case THERMAL_RESPONSE:
@@ -184,8 +291,44 @@ Server::OnDatagramReceived(Client &&client,
 void
 Server::OnSocketReady(unsigned) noexcept
 try {
-  // TODO: use recvmmsg() on Linux
+#ifdef __linux__
+  for (unsigned i = 0; i < MAX_BATCH; ++i)
+    receive_batch.Prepare(i, MAX_DATAGRAM_SIZE);
+
+  ++statistics.receive_calls;
 
+  int n = recvmmsg(socket.GetSocket().Get(), receive_batch.msgs.data(),
+                   MAX_BATCH, MSG_DONTWAIT, nullptr);
+  if (n < 0) {
+    if (errno == EAGAIN || errno == EINTR)
+      return;
+
+    throw MakeSocketError("Failed to receive");
+  }
+
+  statistics.received_datagrams += n;
+
+  /* responses generated while handling this batch are sent with one
+     sendmmsg() call */
+  batching = true;
+
+  for (int i = 0; i < n; ++i) {
+    const auto &hdr = receive_batch.msgs[i].msg_hdr;
+    if (hdr.msg_namelen == 0)
+      continue;
+
+    receive_batch.addresses[i].SetSize(hdr.msg_namelen);
+
+    Client client;
+    client.address = receive_batch.addresses[i];
+
+    OnDatagramReceived(std::move(client), receive_batch.buffers[i].data(),
+                       receive_batch.msgs[i].msg_len);
+  }
+
+  batching = false;
+  FlushSendBatch();
+#else
   Client client;
   socklen_t address_size = sizeof(client.address);
   char buffer[4096];
@@ -196,11 +339,20 @@ try {
   if (nbytes < 0)
     throw MakeSocketError("Failed to receive");
 
+  ++statistics.receive_calls;
+  ++statistics.received_datagrams;
+
   client.address.SetSize(address_size);
   // TODO: set client.key
 
   OnDatagramReceived(std::move(client), buffer, nbytes);
+#endif
 } catch (...) {
+#ifdef __linux__
+  batching = false;
+  n_send = 0;
+#endif
+
   socket.Close();
   OnError(std::current_exception());
 }
@@ -33,10 +33,19 @@ Copyright_License {
 
 #include <cstdint>
 
+#ifdef __linux__
+#include <array>
+
+#include <sys/socket.h>
+#endif
+
 struct GeoPoint;
 
 namespace SkyLinesTracking {
 
+struct FixPacket;
+struct FixBatchPacket;
+
 /**
  * A server for the SkyLines live tracking protocol.
  *
@@ -52,6 +61,52 @@ public:
     uint64_t key;
   };
 
+  /**
+   * Counters which allow monitoring the socket throughput.
+   */
+  struct Statistics {
+    uint64_t received_datagrams = 0, receive_calls = 0;
+    uint64_t sent_datagrams = 0, send_calls = 0;
+  };
+
+private:
+  Statistics statistics;
+
+#ifdef __linux__
+  /**
+   * The maximum number of datagrams received or sent with one
+   * recvmmsg() / sendmmsg() call.
+   */
+  static constexpr unsigned MAX_BATCH = 32;
+
+  static constexpr std::size_t MAX_DATAGRAM_SIZE = 2048;
+
+  /**
+   * Preallocated buffers for recvmmsg() and sendmmsg().
+   */
+  struct Batch {
+    std::array<std::array<char, MAX_DATAGRAM_SIZE>, MAX_BATCH> buffers;
+    std::array<StaticSocketAddress, MAX_BATCH> addresses;
+    std::array<struct iovec, MAX_BATCH> iov;
+    std::array<struct mmsghdr, MAX_BATCH> msgs;
+
+    void Prepare(unsigned i, std::size_t size) noexcept;
+  };
+
+  Batch receive_batch, send_batch;
+
+  /**
+   * The number of queued datagrams in #send_batch.
+   */
+  unsigned n_send = 0;
+
+  /**
+   * Is OnSocketReady() handling received datagrams right now?  While
+   * this is set, SendBuffer() queues datagrams in #send_batch.
+   */
+  bool batching = false;
+#endif
+
 public:
   Server(EventLoop &event_loop, SocketAddress server_address);
 
@@ -71,6 +126,10 @@ public:
     return socket.GetEventLoop();
   }
 
+  const Statistics &GetStatistics() const noexcept {
+    return statistics;
+  }
+
   void SendBuffer(SocketAddress address, ConstBuffer<void> buffer) noexcept;
 
   template<typename P>
@@ -79,6 +138,19 @@ public:
   }
 
 private:
+  void SendNow(SocketAddress address, ConstBuffer<void> buffer) noexcept;
+
+#ifdef __linux__
+  /**
+   * Send all datagrams queued in #send_batch.
+   */
+  void FlushSendBatch() noexcept;
+#endif
+
+  void OnFixReceived(const Client &client, const FixPacket &fix);
+  void OnFixBatchReceived(const Client &client,
+                          const FixBatchPacket &batch,
+                          size_t length);
   void OnDatagramReceived(Client &&client, void *data, size_t length);
   void OnSocketReady(unsigned events) noexcept;
 
@@ -89,7 +161,11 @@ protected:
                      std::chrono::milliseconds time_of_day,
                      const ::GeoPoint &location, int altitude) {}
 
-  virtual void OnTrafficRequest(const Client &client, bool near) {}
+  /**
+   * @param delta the client understands #TRAFFIC_DELTA_RESPONSE
+   */
+  virtual void OnTrafficRequest(const Client &client, bool near,
+                                bool delta) {}
 
   virtual void OnUserNameRequest(const Client &client, uint32_t user_id) {}
 
@@ -84,16 +84,23 @@ void
 TrackingGlue::OnWave(unsigned time_of_day_ms,
                      const GeoPoint &a, const GeoPoint &b)
 {
+  const SkyLinesTracking::Data::Wave wave(SkyLinesTracking::Data::Time{time_of_day_ms},
+                                         a, b);
+
   const std::lock_guard<Mutex> lock(skylines_data.mutex);
 
-  /* garbage collection - hard-coded upper limit */
-  auto n = skylines_data.waves.size();
-  while (n-- >= 64)
-    skylines_data.waves.pop_front();
+  /* the server sends the same waves with each response; refresh an
+     existing item instead of adding a duplicate */
+  if (skylines_data.waves.FindNear(a, b, [&wave](auto &i){
+        if (i.a != wave.a || i.b != wave.b)
+          return false;
 
-  // TODO: replace existing item?
-  skylines_data.waves.emplace_back(SkyLinesTracking::Data::Time{time_of_day_ms},
-                                   a, b);
+        i.time_of_day = wave.time_of_day;
+        return true;
+      }))
+    return;
+
+  skylines_data.waves.Add(wave);
 }
 
 void
@@ -49,8 +49,14 @@ UIReceiveSensorData()
    * (if the location is available the CalculationThread will send the
    * Command::CALCULATED_UPDATE message which will update them)
    */
-  if (modified || !CommonInterface::Basic().location_available) {
-    InfoBoxManager::SetDirty();
+  unsigned changed = 0;
+  if (modified)
+    changed |= InfoBoxContent::DEPENDS_SETTINGS;
+  if (!CommonInterface::Basic().location_available)
+    changed |= InfoBoxContent::DEPENDS_BASIC;
+
+  if (changed != 0) {
+    InfoBoxManager::SetDirty(changed);
     InfoBoxManager::ProcessTimer();
   }
 }
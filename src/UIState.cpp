@@ -27,6 +27,7 @@ void
 UIState::Clear()
 {
   screen_blanked = false;
+  power_saving = false;
   force_display_mode = DisplayMode::NONE;
   display_mode = DisplayMode::NONE;
   auxiliary_enabled = false;
@@ -34,12 +34,17 @@ Copyright_License {
  */
 struct UIState {
   /**
-   * Is the display currently blanked?
-   *
-   * TODO: unimplemented
+   * Is the display currently blanked?  This is set while the screen
+   * is off (e.g. the Android activity is paused).
    */
   bool screen_blanked;
 
+  /**
+   * Shall the map save power, e.g. by rendering the terrain with
+   * less detail?  See #PowerPolicy.
+   */
+  bool power_saving;
+
   /**
    * The display mode forced by the user.  If not NONE, it overrides
    * the automatic display mode.
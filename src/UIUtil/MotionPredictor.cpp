@@ -0,0 +1,78 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "MotionPredictor.hpp"
+#include "time/Cast.hxx"
+
+#include <algorithm>
+
+/**
+ * Moves closer than this are accumulated, because the time delta
+ * would be too inaccurate for a velocity estimate.
+ */
+static constexpr std::chrono::milliseconds MIN_SAMPLE_INTERVAL{8};
+
+void
+MotionPredictor::Reset(PixelPoint p) noexcept
+{
+  position = sample = p;
+  vx = vy = 0;
+  clock.Update();
+}
+
+void
+MotionPredictor::Update(PixelPoint p) noexcept
+{
+  position = p;
+
+  const auto dt = clock.Elapsed();
+  if (dt < MIN_SAMPLE_INTERVAL)
+    return;
+
+  clock.Update();
+
+  if (dt > REST_INTERVAL) {
+    /* the pointer has rested; start over */
+    vx = vy = 0;
+  } else {
+    /* exponential smoothing dampens the jitter of touch screens */
+    const double s = ToFloatSeconds(dt);
+    vx = (vx + (p.x - sample.x) / s) / 2;
+    vy = (vy + (p.y - sample.y) / s) / 2;
+  }
+
+  sample = p;
+}
+
+PixelPoint
+MotionPredictor::Predict(FloatDuration lead, int max_distance) const noexcept
+{
+  const auto age = clock.Elapsed();
+  if (age < FloatDuration{} || age >= REST_INTERVAL)
+    return position;
+
+  const double t = ToFloatSeconds(lead);
+  const int dx = std::clamp(int(vx * t), -max_distance, max_distance);
+  const int dy = std::clamp(int(vy * t), -max_distance, max_distance);
+  return position + PixelPoint(dx, dy);
+}
@@ -0,0 +1,75 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_MOTION_PREDICTOR_HPP
+#define XCSOAR_MOTION_PREDICTOR_HPP
+
+#include "ui/dim/Point.hpp"
+#include "time/PeriodClock.hpp"
+#include "time/FloatDuration.hxx"
+
+#include <chrono>
+
+/**
+ * Estimates the velocity of a dragging pointer and extrapolates its
+ * position a short time into the future.  This hides part of the
+ * latency between the input device and the display, which is
+ * noticeable on slow devices while panning the map.
+ */
+class MotionPredictor {
+public:
+  /**
+   * If the pointer has not moved for this long, it is considered
+   * stationary and no prediction is made.
+   */
+  static constexpr std::chrono::milliseconds REST_INTERVAL{100};
+
+private:
+  /** Position of the most recent update */
+  PixelPoint position;
+
+  /** Position of the most recent velocity sample */
+  PixelPoint sample;
+
+  /** Smoothed velocity [pixels per second] */
+  double vx, vy;
+
+  PeriodClock clock;
+
+public:
+  /** Needs to be called when the movement starts */
+  void Reset(PixelPoint p) noexcept;
+
+  /** Needs to be called on every mouse move event */
+  void Update(PixelPoint p) noexcept;
+
+  /**
+   * Returns the expected position after the specified duration,
+   * starting at the most recent update.  The prediction is limited
+   * to #max_distance pixels on each axis, and is disabled when the
+   * pointer has not moved recently.
+   */
+  PixelPoint Predict(FloatDuration lead, int max_distance) const noexcept;
+};
+
+#endif
@@ -121,7 +121,8 @@ SettingsLeave(const UISettings &old_ui_settings)
 
   if (WaypointFileChanged || AirfieldFileChanged) {
     // re-load waypoints
-    WaypointGlue::LoadWaypoints(way_points, terrain, operation);
+    WaypointGlue::LoadWaypoints(way_points, terrain, file_cache,
+                                operation);
     WaypointDetails::ReadFileFromProfile(way_points, operation);
   }
 
@@ -147,7 +148,7 @@ SettingsLeave(const UISettings &old_ui_settings)
   if (TopographyFileChanged) {
     main_window.SetTopography(nullptr);
     topography->Reset();
-    LoadConfiguredTopography(*topography, operation);
+    LoadConfiguredTopography(*topography, file_cache, operation);
     main_window.SetTopography(topography);
   }
 
@@ -159,7 +160,7 @@ SettingsLeave(const UISettings &old_ui_settings)
       glide_computer->ClearAirspaces();
 
     airspace_database.Clear();
-    ReadAirspace(airspace_database, terrain,
+    ReadAirspace(airspace_database, terrain, file_cache,
                  CommonInterface::GetComputerSettings().pressure,
                  operation);
   }
@@ -26,6 +26,9 @@
 bool
 WaypointFactory::FallbackElevation(Waypoint &waypoint) const
 {
+  if (fallback_elevation_used != nullptr)
+    *fallback_elevation_used = true;
+
   if (terrain != nullptr) {
     // Load waypoint altitude from terrain
     const auto h = terrain->GetTerrainHeight(waypoint.location);
@@ -37,11 +37,26 @@ class WaypointFactory {
   WaypointOrigin origin;
   const RasterTerrain *terrain;
 
+  /**
+   * If not nullptr, then this flag is set whenever
+   * FallbackElevation() is called.
+   */
+  bool *fallback_elevation_used = nullptr;
+
 public:
   explicit WaypointFactory(WaypointOrigin _origin,
                            const RasterTerrain *_terrain=nullptr)
     :origin(_origin), terrain(_terrain) {}
 
+  /**
+   * Remember in the specified flag whether FallbackElevation() was
+   * called, i.e. whether the result depends on the terrain.  The
+   * flag is shared by all copies of this object.
+   */
+  void SetFallbackElevationFlag(bool &flag) noexcept {
+    fallback_elevation_used = &flag;
+  }
+
   Waypoint Create(const GeoPoint &location) const {
     Waypoint w(location);
     w.origin = origin;
@@ -0,0 +1,230 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "WaypointCache.hpp"
+#include "Engine/Waypoint/Waypoints.hpp"
+#include "io/FileCache.hpp"
+#include "io/CacheFile.hpp"
+#include "io/FileOutputStream.hxx"
+#include "io/BufferedOutputStream.hxx"
+#include "system/FileMapping.hpp"
+#include "system/Path.hpp"
+#include "util/StringAPI.hxx"
+
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <string.h>
+
+/**
+ * The payload header, written after the #FileCache header.  It is
+ * followed by the original path (without null terminator) and
+ * #n_waypoints records.  A CRC16 of everything after the #FileCache
+ * header concludes the file.
+ */
+struct WaypointCacheHeader {
+  static constexpr uint32_t VERSION = 1;
+
+  uint32_t version;
+  uint32_t path_length;
+  uint32_t n_waypoints;
+};
+
+/**
+ * One waypoint.  It is followed by the short name, name, comment and
+ * details (without null terminators) and then by the embedded and
+ * external file names, each prefixed with its length.
+ */
+struct WaypointCacheRecord {
+  GeoPoint location;
+  double elevation;
+
+  uint32_t original_id;
+
+  uint32_t shortname_length, name_length, comment_length, details_length;
+  uint32_t n_files_embed, n_files_external;
+
+  Runway runway;
+  RadioFrequency radio_frequency;
+
+  Waypoint::Type type;
+  Waypoint::Flags flags;
+  WaypointOrigin origin;
+};
+
+static_assert(std::is_trivially_copyable_v<WaypointCacheRecord>);
+
+static void
+WriteFiles(CacheFileWriter &w, const std::forward_list<tstring> &files)
+{
+  for (const auto &i : files) {
+    w.WriteT(uint32_t(i.length()));
+    w.WriteString(i.data(), i.length());
+  }
+}
+
+static void
+WriteWaypoint(CacheFileWriter &w, const Waypoint &waypoint)
+{
+  WaypointCacheRecord record;
+
+  /* zero-fill all implicit padding bytes, they are part of the
+     checksum */
+  memset(static_cast<void *>(&record), 0, sizeof(record));
+
+  record.location = waypoint.location;
+  record.elevation = waypoint.elevation;
+  record.original_id = waypoint.original_id;
+  record.shortname_length = waypoint.shortname.length();
+  record.name_length = waypoint.name.length();
+  record.comment_length = waypoint.comment.length();
+  record.details_length = waypoint.details.length();
+  record.n_files_embed = std::distance(waypoint.files_embed.begin(),
+                                       waypoint.files_embed.end());
+#ifdef HAVE_RUN_FILE
+  record.n_files_external = std::distance(waypoint.files_external.begin(),
+                                          waypoint.files_external.end());
+#endif
+  record.runway = waypoint.runway;
+  record.radio_frequency = waypoint.radio_frequency;
+  record.type = waypoint.type;
+  record.flags = waypoint.flags;
+  record.origin = waypoint.origin;
+
+  w.WriteT(record);
+  w.WriteString(waypoint.shortname.data(), record.shortname_length);
+  w.WriteString(waypoint.name.data(), record.name_length);
+  w.WriteString(waypoint.comment.data(), record.comment_length);
+  w.WriteString(waypoint.details.data(), record.details_length);
+  WriteFiles(w, waypoint.files_embed);
+#ifdef HAVE_RUN_FILE
+  WriteFiles(w, waypoint.files_external);
+#endif
+}
+
+static void
+ReadFiles(CacheFileReader &r, std::forward_list<tstring> &files,
+          unsigned n)
+{
+  auto position = files.before_begin();
+  for (unsigned i = 0; i < n; ++i)
+    position = files.emplace_after(position,
+                                   r.ReadString(r.ReadT<uint32_t>()));
+}
+
+static Waypoint
+ReadWaypoint(CacheFileReader &r)
+{
+  const auto record = r.ReadT<WaypointCacheRecord>();
+  if (!record.location.IsValid() ||
+      record.type > Waypoint::Type::MARKER)
+    throw std::runtime_error("Malformed waypoint cache");
+
+  Waypoint waypoint(record.location);
+  waypoint.elevation = record.elevation;
+  waypoint.original_id = record.original_id;
+  waypoint.runway = record.runway;
+  waypoint.radio_frequency = record.radio_frequency;
+  waypoint.type = record.type;
+  waypoint.flags = record.flags;
+  waypoint.origin = record.origin;
+  waypoint.shortname = r.ReadString(record.shortname_length);
+  waypoint.name = r.ReadString(record.name_length);
+  waypoint.comment = r.ReadString(record.comment_length);
+  waypoint.details = r.ReadString(record.details_length);
+  ReadFiles(r, waypoint.files_embed, record.n_files_embed);
+
+#ifdef HAVE_RUN_FILE
+  ReadFiles(r, waypoint.files_external, record.n_files_external);
+#else
+  if (record.n_files_external > 0)
+    throw std::runtime_error("Malformed waypoint cache");
+#endif
+
+  return waypoint;
+}
+
+bool
+LoadWaypointCache(Waypoints &waypoints, FileCache &cache,
+                  const TCHAR *name, Path path)
+{
+  const auto mapping = cache.Map(name, path);
+  if (!mapping)
+    return false;
+
+  auto r = CacheFileReader::FromMapping(*mapping);
+
+  const auto header = r.ReadT<WaypointCacheHeader>();
+  if (header.version != WaypointCacheHeader::VERSION)
+    return false;
+
+  /* the cache entry may have been written for a different file which
+     happens to have the same modification time and size */
+  if (r.ReadString(header.path_length) != path.c_str())
+    return false;
+
+  if (header.n_waypoints > r.GetRemaining() / sizeof(WaypointCacheRecord))
+    throw std::runtime_error("Malformed waypoint cache");
+
+  std::vector<Waypoint> loaded;
+  loaded.reserve(header.n_waypoints);
+  for (unsigned i = 0; i < header.n_waypoints; ++i)
+    loaded.emplace_back(ReadWaypoint(r));
+
+  if (r.GetRemaining() > 0)
+    throw std::runtime_error("Malformed waypoint cache");
+
+  for (auto &i : loaded)
+    waypoints.Append(std::move(i));
+
+  return true;
+}
+
+void
+SaveWaypointCache(std::span<const WaypointPtr> waypoints, FileCache &cache,
+                  const TCHAR *name, Path path)
+{
+  const TCHAR *path_string = path.c_str();
+
+  WaypointCacheHeader header;
+  header.version = WaypointCacheHeader::VERSION;
+  header.path_length = StringLength(path_string);
+  header.n_waypoints = waypoints.size();
+
+  auto os = cache.Save(name, path);
+  BufferedOutputStream bos(*os);
+  CacheFileWriter w(bos);
+
+  w.WriteT(header);
+  w.WriteString(path_string, header.path_length);
+
+  for (const auto &i : waypoints)
+    WriteWaypoint(w, *i);
+
+  w.WriteChecksum();
+
+  bos.Flush();
+  os->Commit();
+}
@@ -0,0 +1,65 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_WAYPOINT_CACHE_HPP
+#define XCSOAR_WAYPOINT_CACHE_HPP
+
+#include "Engine/Waypoint/Ptr.hpp"
+
+#include <span>
+
+#include <tchar.h>
+
+class Path;
+class FileCache;
+class Waypoints;
+
+/**
+ * Load the waypoints which were parsed from the specified file from
+ * the cache.  They are appended to #waypoints in their original
+ * order, but Waypoints::Optimise() is not called.  Nothing is added
+ * if the cache entry is incomplete or corrupt.
+ *
+ * Throws on error.
+ *
+ * @param name the name of the cache entry
+ * @param path the original waypoint file; the cache entry is only
+ * used if it still matches this file's modification time and size
+ * @return false if there is no valid cache entry
+ */
+bool
+LoadWaypointCache(Waypoints &waypoints, FileCache &cache,
+                  const TCHAR *name, Path path);
+
+/**
+ * Save the specified waypoints (in the order in which they shall be
+ * appended when loading) to the cache, keyed on the original
+ * waypoint file.
+ *
+ * Throws on error.
+ */
+void
+SaveWaypointCache(std::span<const WaypointPtr> waypoints, FileCache &cache,
+                  const TCHAR *name, Path path);
+
+#endif
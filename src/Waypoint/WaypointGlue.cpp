@@ -32,8 +32,75 @@ Copyright_License {
 #include "LocalPath.hpp"
 #include "Operation/Operation.hpp"
 #include "system/Path.hpp"
-#include "io/MapFile.hpp"
 #include "io/ZipArchive.hpp"
+#include "WaypointCache.hpp"
+
+#include <algorithm>
+#include <vector>
+
+static bool
+LoadCache(Waypoints &waypoints, FileCache *cache, const TCHAR *cache_name,
+          Path path) noexcept
+try {
+  return cache != nullptr &&
+    LoadWaypointCache(waypoints, *cache, cache_name, path);
+} catch (...) {
+  LogError(std::current_exception(), "Failed to load waypoint cache");
+  return false;
+}
+
+/**
+ * Load the waypoints from the cache; if that fails, parse them with
+ * the specified function and update the cache.  The cache is not
+ * updated if a waypoint's elevation was looked up in the terrain,
+ * because that depends on more than the waypoint file.
+ *
+ * @param path the file the cache entry is keyed on
+ * @param parse a function which parses the waypoints into the given
+ * #Waypoints object using the given #WaypointFactory
+ */
+template<typename F>
+static bool
+ReadWaypoints(Waypoints &waypoints, Path path,
+              FileCache *cache, const TCHAR *cache_name,
+              WaypointOrigin origin, const RasterTerrain *terrain,
+              F &&parse)
+{
+  if (LoadCache(waypoints, cache, cache_name, path))
+    return true;
+
+  WaypointFactory factory(origin, terrain);
+
+  if (cache == nullptr)
+    return parse(waypoints, factory);
+
+  bool fallback_elevation_used = false;
+  factory.SetFallbackElevationFlag(fallback_elevation_used);
+
+  Waypoints parsed;
+  const bool success = parse(parsed, factory);
+
+  /* restore the order in which the parser has appended them */
+  std::vector<WaypointPtr> list(parsed.begin(), parsed.end());
+  std::sort(list.begin(), list.end(), [](const auto &a, const auto &b){
+    return a->id < b->id;
+  });
+
+  parsed.Clear();
+
+  if (success && !fallback_elevation_used) {
+    try {
+      SaveWaypointCache(list, *cache, cache_name, path);
+    } catch (...) {
+      LogError(std::current_exception(), "Failed to save waypoint cache");
+    }
+  }
+
+  for (auto &i : list)
+    waypoints.Append(std::move(i));
+
+  return success;
+}
 
 static bool
 LoadWaypointFile(Waypoints &waypoints, Path path,
@@ -54,11 +121,15 @@ LoadWaypointFile(Waypoints &waypoints, Path path,
 static bool
 LoadWaypointFile(Waypoints &waypoints, Path path,
                  WaypointOrigin origin,
-                 const RasterTerrain *terrain, OperationEnvironment &operation)
+                 const RasterTerrain *terrain,
+                 FileCache *cache, const TCHAR *cache_name,
+                 OperationEnvironment &operation)
 {
-  if (!ReadWaypointFile(path, waypoints,
-                        WaypointFactory(origin, terrain),
-                        operation)) {
+  if (!ReadWaypoints(waypoints, path, cache, cache_name, origin, terrain,
+                     [path, &operation](Waypoints &w,
+                                        const WaypointFactory &factory){
+                       return ReadWaypointFile(path, w, factory, operation);
+                     })) {
     LogFormat(_T("Failed to read waypoint file: %s"), path.c_str());
     return false;
   }
@@ -66,15 +137,27 @@ LoadWaypointFile(Waypoints &waypoints, Path path,
   return true;
 }
 
+/**
+ * Load a waypoint file from the map file.
+ *
+ * @param map_path the path of the map file, which the cache entry
+ * is keyed on
+ */
 static bool
-LoadWaypointFile(Waypoints &waypoints, struct zzip_dir *dir, const char *path,
+LoadWaypointFile(Waypoints &waypoints, Path map_path,
+                 ZipArchive &archive, const char *path,
                  WaypointFileType file_type,
                  WaypointOrigin origin,
-                 const RasterTerrain *terrain, OperationEnvironment &operation)
+                 const RasterTerrain *terrain,
+                 FileCache *cache, const TCHAR *cache_name,
+                 OperationEnvironment &operation)
 {
-  if (!ReadWaypointFile(dir, path, file_type, waypoints,
-                        WaypointFactory(origin, terrain),
-                        operation)) {
+  if (!ReadWaypoints(waypoints, map_path, cache, cache_name, origin, terrain,
+                     [=, &archive, &operation](Waypoints &w,
+                                               const WaypointFactory &factory){
+                       return ReadWaypointFile(archive, path, file_type, w,
+                                               factory, operation);
+                     })) {
     LogFormat("Failed to read waypoint file: %s", path);
     return false;
   }
@@ -85,6 +168,7 @@ LoadWaypointFile(Waypoints &waypoints, struct zzip_dir *dir, const char *path,
 bool
 WaypointGlue::LoadWaypoints(Waypoints &way_points,
                             const RasterTerrain *terrain,
+                            FileCache *cache,
                             OperationEnvironment &operation)
 {
   LogFormat("ReadWaypoints");
@@ -103,35 +187,40 @@ WaypointGlue::LoadWaypoints(Waypoints &way_points,
   auto path = Profile::GetPath(ProfileKeys::WaypointFile);
   if (path != nullptr)
     found |= LoadWaypointFile(way_points, path, WaypointOrigin::PRIMARY,
-                              terrain, operation);
+                              terrain, cache, _T("waypoint"), operation);
 
   // ### SECOND FILE ###
   path = Profile::GetPath(ProfileKeys::AdditionalWaypointFile);
   if (path != nullptr)
     found |= LoadWaypointFile(way_points, path, WaypointOrigin::ADDITIONAL,
-                              terrain, operation);
+                              terrain, cache, _T("waypoint-additional"), operation);
 
   // ### WATCHED WAYPOINT/THIRD FILE ###
   path = Profile::GetPath(ProfileKeys::WatchedWaypointFile);
   if (path != nullptr)
     found |= LoadWaypointFile(way_points, path, WaypointOrigin::WATCHED,
-                              terrain, operation);
+                              terrain, cache, _T("waypoint-watched"), operation);
 
   // ### MAP/FOURTH FILE ###
 
   // If no waypoint file found yet
   if (!found) {
     try {
-      if (auto archive = OpenMapFile()) {
-        found |= LoadWaypointFile(way_points, archive->get(), "waypoints.xcw",
+      if (const auto map_path = Profile::GetPath(ProfileKeys::MapFile);
+          map_path != nullptr) {
+        ZipArchive archive(map_path);
+
+        found |= LoadWaypointFile(way_points, map_path,
+                                  archive, "waypoints.xcw",
                                   WaypointFileType::WINPILOT,
-                                  WaypointOrigin::MAP,
-                                  terrain, operation);
+                                  WaypointOrigin::MAP, terrain,
+                                  cache, _T("waypoint-map-xcw"), operation);
 
-        found |= LoadWaypointFile(way_points, archive->get(), "waypoints.cup",
+        found |= LoadWaypointFile(way_points, map_path,
+                                  archive, "waypoints.cup",
                                   WaypointFileType::SEEYOU,
-                                  WaypointOrigin::MAP,
-                                  terrain, operation);
+                                  WaypointOrigin::MAP, terrain,
+                                  cache, _T("waypoint-map-cup"), operation);
       }
     } catch (...) {
       LogError(std::current_exception(),
@@ -23,6 +23,7 @@ Copyright_License {
 
 #include "WaypointList.hpp"
 #include "Waypoint/Waypoint.hpp"
+#include "Geo/Math.hpp"
 
 #include <algorithm>
 
@@ -60,5 +61,19 @@ public:
 void
 WaypointList::SortByDistance(const GeoPoint &location) noexcept
 {
+  /* calculate all vectors in one batch instead of letting the
+     comparison calculate them one by one */
+  std::vector<GeoPoint> locations;
+  locations.reserve(size());
+  for (const auto &i : *this)
+    locations.push_back(i.waypoint->location);
+
+  std::vector<double> distances(size());
+  std::vector<Angle> bearings(size());
+  DistanceBearing(location, locations, distances, bearings);
+
+  for (std::size_t i = 0; i < size(); ++i)
+    (*this)[i].SetVector(GeoVector(distances[i], bearings[i]));
+
   std::sort(begin(), end(), WaypointDistanceCompare(location));
 }
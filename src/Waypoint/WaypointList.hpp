@@ -47,6 +47,10 @@ public:
 
   void ResetVector() noexcept;
 
+  void SetVector(const GeoVector &_vec) noexcept {
+    vec = _vec;
+  }
+
   [[gnu::pure]]
   const GeoVector &GetVector(const GeoPoint &location) const noexcept;
 };
@@ -89,7 +89,7 @@ ReadWaypointFile(Path path, Waypoints &way_points,
 }
 
 bool
-ReadWaypointFile(struct zzip_dir *dir, const char *path,
+ReadWaypointFile(ZipArchive &archive, const char *path,
                  WaypointFileType file_type, Waypoints &way_points,
                  WaypointFactory factory, OperationEnvironment &operation)
 try {
@@ -98,7 +98,7 @@ try {
   if (!reader)
     return false;
 
-  ZipLineReader line_reader(dir, path, Charset::AUTO);
+  ZipLineReader line_reader(archive, path, Charset::AUTO);
   reader->Parse(way_points, line_reader, operation);
   return true;
 } catch (...) {
@@ -28,7 +28,7 @@ Copyright_License {
 #include <cstdint>
 
 enum class WaypointFileType: uint8_t;
-struct zzip_dir;
+class ZipArchive;
 class Path;
 class Waypoints;
 class WaypointFactory;
@@ -44,7 +44,7 @@ ReadWaypointFile(Path path, Waypoints &way_points,
                  WaypointFactory factory, OperationEnvironment &operation);
 
 bool
-ReadWaypointFile(struct zzip_dir *dir, const char *path,
+ReadWaypointFile(ZipArchive &archive, const char *path,
                  WaypointFileType file_type, Waypoints &way_points,
                  WaypointFactory factory, OperationEnvironment &operation);
 
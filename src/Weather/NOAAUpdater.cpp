@@ -27,6 +27,8 @@ Copyright_License {
 #include "co/Task.hxx"
 #include "LogFile.hpp"
 
+#include <vector>
+
 Co::Task<bool>
 NOAAUpdater::Update(NOAAStore::Item &item,
                     CurlGlobal &curl, ProgressListener &progress) noexcept
@@ -56,13 +58,31 @@ NOAAUpdater::Update(NOAAStore::Item &item,
   co_return metar_downloaded && taf_downloaded;
 }
 
+/**
+ * Wrap NOAAUpdater::Update() in an "eager" task, which starts the
+ * downloads right away instead of waiting to be awaited.
+ */
+static Co::EagerTask<bool>
+StartUpdate(NOAAStore::Item &item,
+            CurlGlobal &curl, ProgressListener &progress) noexcept
+{
+  co_return co_await NOAAUpdater::Update(item, curl, progress);
+}
+
 Co::Task<bool>
 NOAAUpdater::Update(NOAAStore &store, CurlGlobal &curl,
                     ProgressListener &progress) noexcept
 {
-  bool result = true;
+  /* start all stations at once; the requests share the connections
+     of the CurlGlobal, which limits the number of connections per
+     host */
+  std::vector<Co::EagerTask<bool>> tasks;
   for (auto &i : store)
-    result = co_await Update(i, curl, progress) && result;
+    tasks.emplace_back(StartUpdate(i, curl, progress));
+
+  bool result = true;
+  for (auto &i : tasks)
+    result = co_await i && result;
 
   co_return result;
 }
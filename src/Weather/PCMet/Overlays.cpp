@@ -151,15 +151,20 @@ PCMet::DownloadOverlay(const OverlayInfo &info, BrokenDateTime now_utc,
   auto path = AllocatedPath::Build(cache_path,
                                    UTF8ToWideConverter(url.c_str() + sizeof(PCMET_FTP)));
 
-  {
+  /* the file name does not contain the date; a copy which was
+     written after the start of the current forecast run belongs to
+     this run, and can be used without asking the server */
+  const auto run_start =
+    BrokenDateTime(now_utc.GetDate(), BrokenTime(run_hour, 0)).ToTimePoint();
+  if (File::GetLastModification(path) < run_start) {
     const WideToUTF8Converter username(settings.ftp_credentials.username);
     const WideToUTF8Converter password(settings.ftp_credentials.password);
 
-    const auto ignored_response = co_await
-      Net::CoDownloadToFile(curl, url,
-                            username, password,
-                            path, nullptr,
-                            progress);
+    /* overlays of the same forecast run rarely change; don't
+       transfer them again if the cached copy is up to date */
+    co_await Net::CoDownloadToFileIfModified(curl, url,
+                                             username, password,
+                                             path, progress);
   }
 
   BrokenDateTime run_time(now_utc.GetDate(), BrokenTime(run_hour, 0));
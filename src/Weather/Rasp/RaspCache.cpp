@@ -28,11 +28,132 @@ Copyright_License {
 #include "Language/Language.hpp"
 #include "system/Path.hpp"
 #include "io/ZipArchive.hpp"
+#include "Operation/Operation.hpp"
+#include "thread/StandbyThread.hpp"
+#include "util/StaticArray.hxx"
 #include "LogFile.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <windef.h> // for MAX_PATH
 
+/**
+ * Load the specified RASP map from the archive.
+ *
+ * @return the new map or nullptr on error
+ */
+static std::shared_ptr<RasterMap>
+LoadRaspMap(const RaspStore &store, unsigned parameter, unsigned time_index,
+            OperationEnvironment &operation) noexcept
+{
+  auto archive = store.OpenArchive();
+  if (!archive)
+    return nullptr;
+
+  char new_name[MAX_PATH];
+  store.NarrowWeatherFilename(new_name, Path(store.GetItemInfo(parameter).name),
+                              time_index);
+
+  auto new_map = std::make_shared<RasterMap>();
+  try {
+    LoadTerrainOverview(*archive, new_name, nullptr,
+                        new_map->GetTileCache(),
+                        true, operation);
+  } catch (...) {
+    LogError(std::current_exception(), "Failed to load RASP file");
+    return nullptr;
+  }
+
+  new_map->UpdateProjection();
+  return new_map;
+}
+
+/**
+ * Decodes RASP maps of time slots which are likely to be selected
+ * soon.  The results are collected by RaspCache::Reload().
+ */
+class RaspPrefetchThread final : public StandbyThread {
+  const RaspStore &store;
+  const unsigned parameter;
+
+  struct Slot {
+    unsigned time_index;
+    std::shared_ptr<RasterMap> map;
+  };
+
+  /**
+   * Time indexes which shall be decoded.  Protected by
+   * StandbyThread::mutex.
+   */
+  StaticArray<unsigned, 2> requests;
+
+  /**
+   * Decoded maps which have not yet been collected.  Protected by
+   * StandbyThread::mutex.
+   */
+  StaticArray<Slot, 2> done;
+
+public:
+  RaspPrefetchThread(const RaspStore &_store, unsigned _parameter) noexcept
+    :StandbyThread("RaspPrefetch"), store(_store), parameter(_parameter) {}
+
+  ~RaspPrefetchThread() noexcept {
+    LockStop();
+  }
+
+  using StandbyThread::LockWaitDone;
+
+  /**
+   * Replace the pending requests.
+   */
+  void LockRequest(const StaticArray<unsigned, 2> &_requests) {
+    const std::lock_guard<Mutex> lock(mutex);
+    requests = _requests;
+
+    /* discard results which will not be collected (TrivialArray
+       does not destruct removed items) */
+    for (auto &i : done)
+      i.map.reset();
+    done.clear();
+
+    if (!requests.empty())
+      Trigger();
+  }
+
+  /**
+   * Pass all decoded maps to the given function and forget them.
+   */
+  template<typename F>
+  void LockCollect(F &&f) {
+    const std::lock_guard<Mutex> lock(mutex);
+    for (auto &i : done)
+      f(i.time_index, std::move(i.map));
+    done.clear();
+  }
+
+private:
+  /* virtual methods from class StandbyThread */
+  void Tick() noexcept override {
+    SetIdlePriority();
+
+    while (!requests.empty() && !IsStopped()) {
+      const unsigned time_index = requests.front();
+      requests.remove(0);
+
+      std::shared_ptr<RasterMap> map;
+
+      {
+        const ScopeUnlock unlock(mutex);
+        NullOperationEnvironment operation;
+        map = LoadRaspMap(store, parameter, time_index, operation);
+      }
+
+      if (map != nullptr && !done.full())
+        done.append({time_index, std::move(map)});
+    }
+  }
+};
+
 RaspCache::RaspCache(const RaspStore &_store, unsigned _parameter) noexcept
   :store(_store), parameter(_parameter) {}
 
@@ -80,6 +201,54 @@ RaspCache::IsInside(GeoPoint p) const
   return map != nullptr && map->IsInside(p);
 }
 
+void
+RaspCache::CollectPrefetched() noexcept
+{
+  if (prefetch == nullptr)
+    return;
+
+  prefetch->LockCollect([this](unsigned time_index,
+                           std::shared_ptr<RasterMap> &&new_map){
+    slots.PutOrReplace(time_index, std::move(new_map));
+  });
+}
+
+void
+RaspCache::PrefetchAdjacent(unsigned time_index) noexcept
+{
+  StaticArray<unsigned, 2> requests;
+
+  /* the next available time slot has precedence, because scrubbing
+     forward through the forecast is the most common case */
+  for (unsigned i = time_index + 1; i < RaspStore::MAX_WEATHER_TIMES; ++i) {
+    if (store.IsTimeAvailable(parameter, i)) {
+      if (slots.Get(i) == nullptr)
+        requests.append(i);
+      break;
+    }
+  }
+
+  for (unsigned i = time_index; i-- > 0;) {
+    if (store.IsTimeAvailable(parameter, i)) {
+      if (slots.Get(i) == nullptr)
+        requests.append(i);
+      break;
+    }
+  }
+
+  if (requests.empty() && prefetch == nullptr)
+    return;
+
+  if (prefetch == nullptr)
+    prefetch = std::make_unique<RaspPrefetchThread>(store, parameter);
+
+  try {
+    prefetch->LockRequest(requests);
+  } catch (...) {
+    LogError(std::current_exception(), "Failed to start RASP prefetch thread");
+  }
+}
+
 void
 RaspCache::Reload(BrokenTime time_local, OperationEnvironment &operation)
 {
@@ -105,27 +274,24 @@ RaspCache::Reload(BrokenTime time_local, OperationEnvironment &operation)
   if (effective_time == RaspStore::MAX_WEATHER_TIMES)
     return;
 
-  map.reset();
-
-  auto archive = store.OpenArchive();
-  if (!archive)
-    return;
-
-  char new_name[MAX_PATH];
-  store.NarrowWeatherFilename(new_name, Path(store.GetItemInfo(parameter).name),
-                              effective_time);
+  CollectPrefetched();
 
-  auto new_map = std::make_unique<RasterMap>();
-  try {
-    LoadTerrainOverview(archive->get(), new_name, nullptr,
-                        new_map->GetTileCache(),
-                        true, operation);
-  } catch (...) {
-    LogError(std::current_exception(), "Failed to load RASP file");
-    return;
+  auto *slot = slots.Get(effective_time);
+  if (slot == nullptr && prefetch != nullptr) {
+    /* the background thread may be decoding this time slot right
+       now; waiting for it is cheaper than decoding it twice */
+    prefetch->LockWaitDone();
+    CollectPrefetched();
+    slot = slots.Get(effective_time);
   }
 
-  new_map->UpdateProjection();
+  if (slot != nullptr) {
+    map = *slot;
+  } else {
+    map = LoadRaspMap(store, parameter, effective_time, operation);
+    if (map != nullptr)
+      slots.Put(effective_time, map);
+  }
 
-  map = std::move(new_map);
+  PrefetchAdjacent(effective_time);
 }
@@ -24,6 +24,8 @@ Copyright_License {
 #ifndef XCSOAR_WEATHER_RASP_CACHE_HPP
 #define XCSOAR_WEATHER_RASP_CACHE_HPP
 
+#include "util/Cache.hxx"
+
 #include <memory>
 
 #include <tchar.h>
@@ -33,10 +35,16 @@ struct GeoPoint;
 class RaspStore;
 class RasterMap;
 class OperationEnvironment;
+class RaspPrefetchThread;
 
 /**
  * Class to manage the raster weather map, to be loaded/selected from
  * a #RaspStore instance.
+ *
+ * Recently used time slots are kept in a small LRU cache, and the
+ * time slots adjacent to the current one are decoded in a background
+ * thread, so stepping through the forecast hour by hour does not need
+ * to wait for the decoder.
  */
 class RaspCache {
   const RaspStore &store;
@@ -46,7 +54,19 @@ class RaspCache {
   unsigned time = 0;
   unsigned last_time = 0;
 
-  std::unique_ptr<RasterMap> map;
+  /**
+   * The map being displayed.  It is shared with #slots, but may
+   * outlive its cache entry.
+   */
+  std::shared_ptr<RasterMap> map;
+
+  /**
+   * Decoded maps of recently used time slots, indexed by the
+   * #RaspStore time index.
+   */
+  Cache<unsigned, std::shared_ptr<RasterMap>, 4, 7> slots;
+
+  std::unique_ptr<RaspPrefetchThread> prefetch;
 
 public:
   RaspCache(const RaspStore &_store, unsigned _parameter) noexcept;
@@ -100,6 +120,18 @@ public:
    * Sets the current time index.
    */
   void SetTime(BrokenTime t);
+
+private:
+  /**
+   * Move the maps finished by the #RaspPrefetchThread to #slots.
+   */
+  void CollectPrefetched() noexcept;
+
+  /**
+   * Ask the #RaspPrefetchThread to decode the time slots adjacent to
+   * the specified one which are not cached already.
+   */
+  void PrefetchAdjacent(unsigned time_index) noexcept;
 };
 
 #endif
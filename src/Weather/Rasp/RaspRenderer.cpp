@@ -69,6 +69,6 @@ RaspRenderer::Generate(const WindowProjection &projection,
 
   raster_renderer.GenerateImage(false, height_scale,
                                 settings.contrast, settings.brightness,
-                                Angle::Zero(), false);
+                                Angle::Zero());
   return true;
 }
@@ -30,6 +30,7 @@ Copyright_License {
 #include "LocalPath.hpp"
 #include "Version.hpp"
 #include "LogFile.hpp"
+#include "TraceFile.hpp"
 #include "CommandLine.hpp"
 #include "MainWindow.hpp"
 #include "Interface.hpp"
@@ -44,6 +45,8 @@ Copyright_License {
 #include "Audio/GlobalPCMResourcePlayer.hpp"
 #include "Audio/GlobalVolumeController.hpp"
 #include "system/Args.hpp"
+#include "system/ConvertPathName.hpp"
+#include "thread/TraceEvents.hpp"
 #include "io/async/GlobalAsioThread.hpp"
 #include "io/async/AsioThread.hpp"
 #include "util/PrintException.hxx"
@@ -86,6 +89,9 @@ static const char *const Usage = "\n"
 #endif
 #ifdef _WIN32
   "  -console        open debug output console\n"
+#endif
+#ifdef HAVE_CMDLINE_TRACE
+  "  -trace=FILE     record thread timings to FILE (Chrome trace format)\n"
 #endif
   ;
 
@@ -161,6 +167,11 @@ WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance,
     CommandLine::Parse(args);
   }
 
+#ifdef HAVE_CMDLINE_TRACE
+  if (CommandLine::trace_path != nullptr)
+    TraceEvents::SetEnabled(true);
+#endif
+
   int ret;
 
   try {
@@ -170,6 +181,16 @@ WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance,
     ret = EXIT_FAILURE;
   }
 
+#ifdef HAVE_CMDLINE_TRACE
+  if (CommandLine::trace_path != nullptr) {
+    try {
+      WriteTraceFile(PathName(CommandLine::trace_path));
+    } catch (...) {
+      PrintException(std::current_exception());
+    }
+  }
+#endif
+
 #if defined(__APPLE__) && TARGET_OS_IPHONE
   /* For some reason, the app process does not exit on iOS, but a black
    * screen remains, if the process is not explicitly terminated */
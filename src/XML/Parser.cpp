@@ -32,20 +32,47 @@
 #include "util/StringAPI.hxx"
 #include "util/StringStrip.hxx"
 #include "util/NumberParser.hpp"
+#include "util/tstring.hpp"
 #include "io/FileLineReader.hpp"
 
 #include <stdexcept>
+#include <vector>
 
 #include <cassert>
 
 namespace XML {
   /** Main structure used for parsing XML. */
   struct Parser {
+    Handler &handler;
     const TCHAR *lpXML;
-    unsigned nIndex;
-    const TCHAR *lpEndTag;
-    size_t cbEndTag;
-    bool nFirst;
+    unsigned nIndex = 0;
+    const TCHAR *lpEndTag = nullptr;
+    size_t cbEndTag = 0;
+    bool nFirst = true;
+
+    /**
+     * Set when Handler::OnStartElement() has asked to stop parsing.
+     */
+    bool stopped = false;
+
+    /**
+     * A scratch buffer for FromXMLString(), reused for all attribute
+     * values and text nodes.
+     */
+    tstring buffer;
+
+    Parser(Handler &_handler, const TCHAR *xml)
+      :handler(_handler), lpXML(xml) {}
+  };
+
+  /**
+   * The element which is currently being parsed.  The name points
+   * into the source string.
+   */
+  struct Element {
+    const TCHAR *name;
+    size_t name_length;
+    bool is_declaration;
   };
 
   /** Enumeration used to decipher what type a token is. */
@@ -92,7 +119,7 @@ namespace XML {
   GetNextToken(Parser *pXML);
 
   static void
-  ParseXMLElement(XMLNode &node, Parser *pXML);
+  ParseXMLElement(const Element &element, Parser *pXML);
 }
 
 /**
@@ -104,38 +131,35 @@ namespace XML {
  *
  * @param ss string
  * @param lo length of string
- * @return new allocated string converted from xml
+ * @param d the destination buffer (its old contents are discarded)
+ * @return false if the string contains an invalid entity
  */
-static TCHAR *
-FromXMLString(const TCHAR *ss, size_t lo)
+static bool
+FromXMLString(const TCHAR *ss, size_t lo, tstring &d)
 {
   assert(ss != nullptr);
 
   const TCHAR *end = ss + lo;
 
-  /* allocate a buffer with the size of the input string; we know for
-     sure that this is enough, because resolving entities can only
-     shrink the string, but never grows */
-  TCHAR *d = (TCHAR *)malloc((lo + 1) * sizeof(*d));
-  assert(d);
-  TCHAR *result = d;
+  d.clear();
+
   while (ss < end && *ss) {
     if (*ss == _T('&')) {
       ss++;
       if (StringIsEqualIgnoreCase(ss, _T("lt;" ), 3)) {
-        *(d++) = _T('<' );
+        d.push_back(_T('<' ));
         ss += 3;
       } else if (StringIsEqualIgnoreCase(ss, _T("gt;" ), 3)) {
-        *(d++) = _T('>' );
+        d.push_back(_T('>' ));
         ss += 3;
       } else if (StringIsEqualIgnoreCase(ss, _T("amp;" ), 4)) {
-        *(d++) = _T('&' );
+        d.push_back(_T('&' ));
         ss += 4;
       } else if (StringIsEqualIgnoreCase(ss, _T("apos;"), 5)) {
-        *(d++) = _T('\'');
+        d.push_back(_T('\''));
         ss += 5;
       } else if (StringIsEqualIgnoreCase(ss, _T("quot;"), 5)) {
-        *(d++) = _T('"' );
+        d.push_back(_T('"' ));
         ss += 5;
       } else if (*ss == '#') {
         /* number entity */
@@ -144,47 +168,41 @@ FromXMLString(const TCHAR *ss, size_t lo)
 
         TCHAR *endptr;
         unsigned i = ParseUnsigned(ss, &endptr, 10);
-        if (endptr == ss || endptr >= end || *endptr != ';') {
-          free(result);
-          return nullptr;
-        }
+        if (endptr == ss || endptr >= end || *endptr != ';')
+          return false;
 
         // XXX convert to UTF-8 if !_UNICODE
         TCHAR ch = (TCHAR)i;
         if (ch == 0)
           ch = ' ';
 
-        *d++ = ch;
+        d.push_back(ch);
         ss = endptr + 1;
       } else {
-        free(result);
-        return nullptr;
+        return false;
       }
     } else {
-      *(d++) = *ss;
-      ss++;
+      /* copy the whole run up to the next entity at once */
+      const TCHAR *run = ss;
+      while (ss < end && *ss && *ss != _T('&'))
+        ++ss;
+
+      d.append(run, ss);
     }
   }
-  *d = 0;
 
-  /* shrink the memory allocation just in case we allocated too
-     much */
-  d = (TCHAR *)realloc(result, (d + 1 - result) * sizeof(*d));
-  if (d != nullptr)
-    result = d;
-
-  return result;
+  return true;
 }
 
 gcc_pure
 static bool
-CompareTagName(const TCHAR *cclose, const TCHAR *copen)
+CompareTagName(const XML::Element &element, const TCHAR *copen)
 {
-  assert(cclose != nullptr);
+  assert(element.name != nullptr);
   assert(copen != nullptr);
 
-  size_t l = _tcslen(cclose);
-  if (!StringIsEqualIgnoreCase(cclose, copen, l))
+  const size_t l = element.name_length;
+  if (!StringIsEqualIgnoreCase(element.name, copen, l))
     return false;
 
   const TCHAR c = copen[l];
@@ -416,19 +434,22 @@ XML::GetNextToken(Parser *pXML)
  * Recursively parse an XML element.
  */
 static void
-XML::ParseXMLElement(XMLNode &node, Parser *pXML)
+XML::ParseXMLElement(const Element &element, Parser *pXML)
 {
   bool is_declaration;
   const TCHAR *text = nullptr;
-  XMLNode *pNew;
   enum Status status; // inside or outside a tag
   enum Attrib attrib = eAttribName;
 
-  /* the name of the attribute that is currently being */
-  tstring attribute_name;
+  /* the name of the attribute that is currently being parsed; it
+     points into the source string */
+  const TCHAR *attribute_name = nullptr;
+  size_t attribute_name_length = 0;
 
   assert(pXML);
 
+  Handler &handler = pXML->handler;
+
   // If this is the first call to the function
   if (pXML->nFirst) {
     // Assume we are outside of a tag definition
@@ -471,7 +492,7 @@ XML::ParseXMLElement(XMLNode &node, Parser *pXML)
         // If we have node text then add this to the element
         if (text != nullptr) {
           size_t length = StripRight(text, token.pStr - text);
-          node.AddText(text, length);
+          handler.OnText(text, length);
           text = nullptr;
         }
 
@@ -483,44 +504,39 @@ XML::ParseXMLElement(XMLNode &node, Parser *pXML)
         if (token.type != eTokenText)
           throw std::runtime_error("Missing start tag name");
 
-        // If the name of the new element differs from the name of
-        // the current element we need to add the new element to
-        // the current one and recurse
-        pNew = &node.AddChild(token.pStr, token.length,
-                              is_declaration);
-
-        while (true) {
-          // Callself to process the new node.  If we return
-          // FALSE this means we dont have any more
-          // processing to do...
-
-          ParseXMLElement(*pNew, pXML);
-
-          // If the call to recurse this function
-          // evented in a end tag specified in XML then
-          // we need to unwind the calls to this
-          // function until we find the appropriate node
-          // (the element name and end tag name must
-          // match)
-          if (pXML->cbEndTag) {
-            // If we are back at the root node then we
-            // have an unmatched end tag
-            if (node.GetName() == nullptr)
-              throw std::runtime_error("Unmatched end tag");
-
-            // If the end tag matches the name of this
-            // element then we only need to unwind
-            // once more...
-
-            if (CompareTagName(node.GetName(), pXML->lpEndTag)) {
-              pXML->cbEndTag = 0;
-            }
+        // Report the new element to the handler and recurse
+        if (!handler.OnStartElement(token.pStr, token.length,
+                                    is_declaration)) {
+          pXML->stopped = true;
+          return;
+        }
 
-            return;
-          } else {
-            // If we didn't have a new element to create
-            break;
+        {
+          const Element child{token.pStr, token.length, is_declaration};
+          ParseXMLElement(child, pXML);
+        }
+
+        if (pXML->stopped)
+          return;
+
+        handler.OnEndElement();
+
+        // If the call to recurse this function
+        // evented in a end tag specified in XML then
+        // we need to unwind the calls to this
+        // function until we find the appropriate node
+        // (the element name and end tag name must
+        // match)
+        if (pXML->cbEndTag) {
+          // If the end tag matches the name of this
+          // element then we only need to unwind
+          // once more...
+
+          if (CompareTagName(element, pXML->lpEndTag)) {
+            pXML->cbEndTag = 0;
           }
+
+          return;
         }
         break;
 
@@ -530,12 +546,10 @@ XML::ParseXMLElement(XMLNode &node, Parser *pXML)
         // If we have node text then add this to the element
         if (text != nullptr) {
           size_t length = StripRight(text, token.pStr - text);
-          TCHAR *text2 = FromXMLString(text, length);
-          if (text2 == nullptr)
+          if (!FromXMLString(text, length, pXML->buffer))
             throw std::runtime_error("Unexpected token found");
 
-          node.AddText(text2);
-          free(text2);
+          handler.OnText(pXML->buffer.data(), pXML->buffer.length());
           text = nullptr;
         }
 
@@ -553,7 +567,7 @@ XML::ParseXMLElement(XMLNode &node, Parser *pXML)
         // We need to return to the previous caller.  If the name
         // of the tag cannot be found we need to keep returning to
         // caller until we find a match
-        if (!CompareTagName(node.GetName(), token.pStr)) {
+        if (!CompareTagName(element, token.pStr)) {
           pXML->lpEndTag = token.pStr;
           pXML->cbEndTag = token.length;
         }
@@ -584,7 +598,8 @@ XML::ParseXMLElement(XMLNode &node, Parser *pXML)
         case eTokenText:
           // Cache the token then indicate that we are next to
           // look for the equals
-          attribute_name.assign(token.pStr, token.length);
+          attribute_name = token.pStr;
+          attribute_name_length = token.length;
           attrib = eAttribEquals;
           break;
 
@@ -620,27 +635,31 @@ XML::ParseXMLElement(XMLNode &node, Parser *pXML)
           // Eg.  'Attribute AnotherAttribute'
         case eTokenText:
           // Add the unvalued attribute to the list
-          node.AddAttribute(std::move(attribute_name), _T(""), 0);
+          handler.OnAttribute(attribute_name, attribute_name_length,
+                              _T(""), 0);
           // Cache the token then indicate.  We are next to
           // look for the equals attribute
-          attribute_name.assign(token.pStr, token.length);
+          attribute_name = token.pStr;
+          attribute_name_length = token.length;
           break;
 
           // If we found a closing tag 'Attribute >' or a short hand
           // closing tag 'Attribute />'
         case eTokenShortHandClose:
         case eTokenCloseTag:
-          assert(!attribute_name.empty());
+          assert(attribute_name_length > 0);
 
           // If we are a declaration element '<?' then we need
           // to remove extra closing '?' if it exists
-          if (node.IsDeclaration() && attribute_name.back() == _T('?')) {
-            attribute_name.pop_back();
+          if (element.is_declaration &&
+              attribute_name[attribute_name_length - 1] == _T('?')) {
+            --attribute_name_length;
           }
 
-          if (!attribute_name.empty())
+          if (attribute_name_length > 0)
             // Add the unvalued attribute to the list
-            node.AddAttribute(std::move(attribute_name), _T(""), 0);
+            handler.OnAttribute(attribute_name, attribute_name_length,
+                                _T(""), 0);
 
           // If this is the end of the tag then return to the caller
           if (token.type == eTokenShortHandClose)
@@ -680,7 +699,8 @@ XML::ParseXMLElement(XMLNode &node, Parser *pXML)
         case eTokenQuotedText:
           // If we are a declaration element '<?' then we need
           // to remove extra closing '?' if it exists
-          if (node.IsDeclaration() && (token.pStr[token.length - 1]) == _T('?')) {
+          if (element.is_declaration &&
+              token.pStr[token.length - 1] == _T('?')) {
             token.length--;
           }
 
@@ -690,17 +710,13 @@ XML::ParseXMLElement(XMLNode &node, Parser *pXML)
             token.length -= 2;
           }
 
-          assert(!attribute_name.empty());
+          assert(attribute_name_length > 0);
 
-          {
-            TCHAR *value = FromXMLString(token.pStr, token.length);
-            if (value == nullptr)
-              throw std::runtime_error("Unexpected token found");
+          if (!FromXMLString(token.pStr, token.length, pXML->buffer))
+            throw std::runtime_error("Unexpected token found");
 
-            node.AddAttribute(std::move(attribute_name),
-                              value, _tcslen(value));
-            free(value);
-          }
+          handler.OnAttribute(attribute_name, attribute_name_length,
+                              pXML->buffer.data(), pXML->buffer.length());
 
           // Indicate we are searching for a new attribute
           attrib = eAttribName;
@@ -722,27 +738,72 @@ XML::ParseXMLElement(XMLNode &node, Parser *pXML)
   }
 }
 
-/**
- * Parses the given XML String and returns the main XMLNode
- * @param xml_string XML String
- * @param tag (?)
- * @param pResults XMLResult object to write in on error or success
- * @return The main XMLNode or empty XMLNode on error
- */
-XMLNode
-XML::ParseString(const TCHAR *xml_string)
+void
+XML::Parse(const TCHAR *xml_string, Handler &handler)
 {
   assert(xml_string != nullptr);
 
-  XMLNode xnode = XMLNode::Null();
-  Parser xml = { nullptr, 0, nullptr, 0, true, };
+  Parser xml(handler, xml_string);
 
-  xml.lpXML = xml_string;
+  const Element document{_T(""), 0, false};
+  ParseXMLElement(document, &xml);
+}
 
-  // Fill the XMLNode xnode with the parsed data of xml
-  // note: xnode is now the document node, not the main XMLNode
-  ParseXMLElement(xnode, &xml);
+namespace XML {
+
+/**
+ * A #Handler which builds a #XMLNode tree.
+ */
+class TreeBuilder final : public Handler {
+  std::vector<XMLNode *> stack;
+
+  /**
+   * Stop at the first child of the main node?
+   */
+  const bool root_only;
+
+public:
+  TreeBuilder(XMLNode &document, bool _root_only=false)
+    :root_only(_root_only) {
+    stack.reserve(16);
+    stack.push_back(&document);
+  }
+
+  /* virtual methods from class Handler */
+  bool OnStartElement(const TCHAR *name, size_t name_length,
+                      bool is_declaration) override {
+    if (root_only && stack.size() > 1 && !stack.back()->IsDeclaration())
+      return false;
+
+    stack.push_back(&stack.back()->AddChild(name, name_length,
+                                            is_declaration));
+    return true;
+  }
 
+  void OnAttribute(const TCHAR *name, size_t name_length,
+                   const TCHAR *value, size_t value_length) override {
+    stack.back()->AddAttribute(name, name_length, value, value_length);
+  }
+
+  void OnText(const TCHAR *text, size_t length) override {
+    stack.back()->AddText(text, length);
+  }
+
+  void OnEndElement() override {
+    assert(stack.size() > 1);
+    stack.pop_back();
+  }
+};
+
+}
+
+/**
+ * Obtain the main node from the document node built by
+ * #TreeBuilder.
+ */
+static XMLNode
+GetMainNode(XMLNode &&xnode)
+{
   // If the document node does not have childnodes
   XMLNode *child = xnode.GetFirstChild();
   if (child == nullptr)
@@ -764,7 +825,24 @@ XML::ParseString(const TCHAR *xml_string)
   }
 
   // Return the node (empty, main or child of main that equals tag)
-  return xnode;
+  return std::move(xnode);
+}
+
+/**
+ * Parses the given XML String and returns the main XMLNode
+ * @param xml_string XML String
+ * @return The main XMLNode
+ */
+XMLNode
+XML::ParseString(const TCHAR *xml_string)
+{
+  // Fill the XMLNode xnode with the parsed data of xml
+  // note: xnode is now the document node, not the main XMLNode
+  XMLNode xnode = XMLNode::Null();
+  TreeBuilder builder(xnode);
+  Parse(xml_string, builder);
+
+  return GetMainNode(std::move(xnode));
 }
 
 static tstring
@@ -787,10 +865,10 @@ ReadTextFile(Path path)
   while ((line = reader.ReadLine()) != nullptr) {
     if (buffer.length() > 65536)
       /* too long */
-      std::runtime_error("File is too large");
+      throw std::runtime_error("File is too large");
 
     buffer.append(line);
-    buffer.append(_T("\n"));
+    buffer.push_back(_T('\n'));
   }
 
   return buffer;
@@ -800,8 +878,7 @@ ReadTextFile(Path path)
 * Opens the file given by the filepath and returns the main node.
 * (Includes error handling)
  * @param filename Filepath to the XML file to parse
- * @param tag (?)
- * @return The main XMLNode or an empty node on error
+ * @return The main XMLNode
  */
 XMLNode
 XML::ParseFile(Path filename)
@@ -809,3 +886,15 @@ XML::ParseFile(Path filename)
   const auto buffer = ReadTextFile(filename);
   return ParseString(buffer.c_str());
 }
+
+XMLNode
+XML::ParseFileRoot(Path filename)
+{
+  const auto buffer = ReadTextFile(filename);
+
+  XMLNode xnode = XMLNode::Null();
+  TreeBuilder builder(xnode, true);
+  Parse(buffer.c_str(), builder);
+
+  return GetMainNode(std::move(xnode));
+}
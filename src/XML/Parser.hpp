@@ -29,12 +29,49 @@
 #ifndef XCSOAR_XML_PARSER_HPP
 #define XCSOAR_XML_PARSER_HPP
 
+#include <cstddef>
+
 #include <tchar.h>
 
 class XMLNode;
 class Path;
 
 namespace XML {
+  /**
+   * Receives the events of the streaming parser (see Parse()).  The
+   * strings passed to these methods are not null-terminated, and they
+   * are only valid during the call.
+   */
+  class Handler {
+  public:
+    /**
+     * A new element was opened; the following OnAttribute() calls
+     * belong to it.
+     *
+     * @return false to stop parsing
+     */
+    virtual bool OnStartElement(const TCHAR *name, std::size_t name_length,
+                                bool is_declaration) = 0;
+
+    virtual void OnAttribute(const TCHAR *name, std::size_t name_length,
+                             const TCHAR *value, std::size_t value_length) = 0;
+
+    virtual void OnText(const TCHAR *text, std::size_t length) = 0;
+
+    /**
+     * The most recently opened element was closed.
+     */
+    virtual void OnEndElement() = 0;
+  };
+
+  /**
+   * Parse the given XML string without building a node tree, and pass
+   * all elements to the #Handler.
+   *
+   * Throws on error.
+   */
+  void Parse(const TCHAR *xml_string, Handler &handler);
+
   /**
    * Throws on error.
    */
@@ -44,6 +81,15 @@ namespace XML {
    * Throws on error.
    */
   XMLNode ParseFile(Path path);
+
+  /**
+   * Like ParseFile(), but return only the main node with its
+   * attributes; parsing stops at its first child element.  This is
+   * useful for obtaining metadata from a file cheaply.
+   *
+   * Throws on error.
+   */
+  XMLNode ParseFileRoot(Path path);
 }
 
 #endif
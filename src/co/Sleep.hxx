@@ -0,0 +1,78 @@
+/*
+  Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#pragma once
+
+#include "Compat.hxx"
+#include "event/CoarseTimerEvent.hxx"
+
+namespace Co {
+
+/**
+ * An awaitable which resumes the coroutine after the given duration.
+ * Destroying it (e.g. by cancelling the coroutine) cancels the timer.
+ *
+ * Usage: co_await Co::Sleep{event_loop, std::chrono::seconds{10}};
+ */
+class Sleep final {
+	CoarseTimerEvent timer;
+
+	std::coroutine_handle<> continuation;
+
+	bool ready = false;
+
+public:
+	Sleep(EventLoop &event_loop, Event::Duration d) noexcept
+		:timer(event_loop, BIND_THIS_METHOD(OnTimer))
+	{
+		timer.Schedule(d);
+	}
+
+	auto operator co_await() noexcept {
+		struct Awaitable final {
+			Sleep &sleep;
+
+			bool await_ready() const noexcept {
+				return sleep.ready;
+			}
+
+			void await_suspend(std::coroutine_handle<> _continuation) const noexcept {
+				sleep.continuation = _continuation;
+			}
+
+			void await_resume() const noexcept {}
+		};
+
+		return Awaitable{*this};
+	}
+
+private:
+	void OnTimer() noexcept {
+		ready = true;
+
+		if (continuation)
+			continuation.resume();
+	}
+};
+
+} // namespace Co
@@ -0,0 +1,224 @@
+/*
+ * Copyright 2007-2021 CM4all GmbH
+ * All rights reserved.
+ *
+ * author: Max Kellermann <mk@cm4all.com>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the
+ * distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * FOUNDATION OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "FineTimerWheel.hxx"
+#include "FineTimerEvent.hxx"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+
+#include <cassert>
+
+inline void
+FineTimerWheel::Level::Add(std::size_t i, FineTimerEvent &t) noexcept
+{
+	slots[i].push_back(t);
+	bitmap[i / 64] |= uint_least64_t(1) << (i % 64);
+}
+
+inline FineTimerWheel::List
+FineTimerWheel::Level::Take(std::size_t i) noexcept
+{
+	bitmap[i / 64] &= ~(uint_least64_t(1) << (i % 64));
+	return std::move(slots[i]);
+}
+
+inline std::size_t
+FineTimerWheel::Level::FindNext(const std::size_t start) const noexcept
+{
+	for (std::size_t n = 0; n < N_SLOTS;) {
+		const std::size_t i = (start + n) % N_SLOTS;
+		const auto w = bitmap[i / 64] >> (i % 64);
+		if (w == 0) {
+			/* skip the rest of this word */
+			n += 64 - i % 64;
+			continue;
+		}
+
+		const std::size_t skip = std::countr_zero(w);
+		if (n + skip >= N_SLOTS)
+			/* wrapped around to bits we have already
+			   checked */
+			break;
+
+		const std::size_t j = i + skip;
+		if (!slots[j].empty())
+			return n + skip;
+
+		/* all timers in this slot have been canceled */
+		bitmap[j / 64] &= ~(uint_least64_t(1) << (j % 64));
+		n += skip + 1;
+	}
+
+	return N_SLOTS;
+}
+
+FineTimerWheel::FineTimerWheel() noexcept
+	:current(ToTick(Event::Clock::now())) {}
+
+FineTimerWheel::~FineTimerWheel() noexcept
+{
+	assert(IsEmpty());
+}
+
+bool
+FineTimerWheel::IsEmpty() const noexcept
+{
+	return ready.empty() &&
+		std::all_of(levels.begin(), levels.end(), [](const auto &level){
+			return std::all_of(level.slots.begin(),
+					   level.slots.end(),
+					   [](const auto &list){
+						   return list.empty();
+					   });
+		});
+}
+
+void
+FineTimerWheel::Place(FineTimerEvent &t) noexcept
+{
+	/* timers which were scheduled before the last Run() call but
+	   are due before "current" are invoked by the next tick */
+	Tick due = std::max(ToDueTick(t.GetDue()), current);
+
+	Tick delta = due - current;
+	if (delta > MAX_DELTA) {
+		due = current + MAX_DELTA;
+		delta = MAX_DELTA;
+	}
+
+	unsigned level = 0;
+	while (delta >= Tick(N_SLOTS) << (LEVEL_BITS * level))
+		++level;
+
+	assert(level < N_LEVELS);
+
+	levels[level].Add((due >> (LEVEL_BITS * level)) % N_SLOTS, t);
+}
+
+void
+FineTimerWheel::Insert(FineTimerEvent &t, Event::TimePoint now) noexcept
+{
+	if (t.GetDue() <= now)
+		/* if this timer is already due, insert it into the
+		   "ready" list to be invoked without delay */
+		ready.push_back(t);
+	else
+		Place(t);
+}
+
+inline void
+FineTimerWheel::Cascade() noexcept
+{
+	for (unsigned level = 1; level < N_LEVELS; ++level) {
+		const unsigned shift = LEVEL_BITS * level;
+		if (current % (Tick(1) << shift) != 0)
+			/* not at the start of a slot of this level
+			   (and therefore of any higher level) */
+			break;
+
+		auto tmp = levels[level].Take((current >> shift) % N_SLOTS);
+		tmp.clear_and_dispose([this](auto *t){
+			Place(*t);
+		});
+	}
+}
+
+FineTimerWheel::Tick
+FineTimerWheel::GetNextTick() const noexcept
+{
+	Tick result = std::numeric_limits<Tick>::max();
+
+	if (const auto n = levels[0].FindNext(current % N_SLOTS);
+	    n < N_SLOTS)
+		result = current + n;
+
+	for (unsigned level = 1; level < N_LEVELS; ++level) {
+		const unsigned shift = LEVEL_BITS * level;
+
+		/* the first slot of this level which has not been
+		   cascaded yet; if "current" is exactly at a slot
+		   start, that slot is still pending */
+		const Tick slot = (current + (Tick(1) << shift) - 1) >> shift;
+		if ((slot << shift) >= result)
+			/* nothing on this level or above can be
+			   earlier */
+			break;
+
+		if (const auto n = levels[level].FindNext(slot % N_SLOTS);
+		    n < N_SLOTS)
+			result = std::min(result, (slot + n) << shift);
+	}
+
+	return result;
+}
+
+Event::Duration
+FineTimerWheel::Run(const Event::TimePoint now) noexcept
+{
+	/* invoke the "ready" list unconditionally */
+	ready.clear_and_dispose([&](auto *t){
+		t->Run();
+	});
+
+	const Tick now_tick = ToTick(now);
+
+	while (true) {
+		const Tick next = GetNextTick();
+		if (next > now_tick) {
+			/* nothing happens until "next"; skip all empty
+			   ticks */
+			if (now_tick >= current)
+				current = now_tick + 1;
+
+			if (next == std::numeric_limits<Tick>::max())
+				return Event::Duration(-1);
+
+			return Event::TimePoint(next * RESOLUTION) - now;
+		}
+
+		current = next;
+		Cascade();
+
+		/* all timers in this level 0 slot are due exactly at
+		   this tick; move them to a temporary list to avoid
+		   problems with canceled timers while we traverse
+		   the list */
+		auto tmp = levels[0].Take(current % N_SLOTS);
+		++current;
+
+		tmp.clear_and_dispose([](auto *t){
+			t->Run();
+		});
+	}
+}
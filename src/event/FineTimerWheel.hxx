@@ -0,0 +1,173 @@
+/*
+ * Copyright 2007-2021 CM4all GmbH
+ * All rights reserved.
+ *
+ * author: Max Kellermann <mk@cm4all.com>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the
+ * distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * FOUNDATION OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "Chrono.hxx"
+#include "util/IntrusiveList.hxx"
+
+#include <array>
+#include <cstdint>
+
+class FineTimerEvent;
+
+/**
+ * A hierarchical timer wheel for #FineTimerEvent instances.
+ *
+ * Time is divided into ticks of #RESOLUTION.  Level 0 has one slot
+ * per tick for the next #N_SLOTS ticks; each higher level has slots
+ * which are #N_SLOTS times as wide as the ones of the level below.
+ * When time reaches the start of a slot of a higher level, its
+ * timers are redistributed ("cascaded") to the lower levels.
+ * Inserting and canceling a timer are O(1), and each timer is moved
+ * at most once per level.
+ */
+class FineTimerWheel final {
+	static constexpr Event::Duration RESOLUTION = std::chrono::milliseconds(1);
+
+	static constexpr unsigned LEVEL_BITS = 8;
+	static constexpr std::size_t N_SLOTS = std::size_t(1) << LEVEL_BITS;
+	static constexpr unsigned N_LEVELS = 4;
+
+	/**
+	 * A point in time measured in #RESOLUTION units.
+	 */
+	using Tick = uint_least64_t;
+
+	/**
+	 * Timers scheduled further into the future are parked in
+	 * the last slot the wheel can represent; they will be
+	 * cascaded back into the highest level until they are
+	 * close enough.
+	 */
+	static constexpr Tick MAX_DELTA =
+		(Tick(1) << (LEVEL_BITS * N_LEVELS)) - 1;
+
+	using List = IntrusiveList<FineTimerEvent>;
+
+	struct Level {
+		std::array<List, N_SLOTS> slots;
+
+		/**
+		 * One bit per slot which is set when a timer is
+		 * added.  Canceled timers unlink themselves without
+		 * clearing it, so a set bit means the slot "may" be
+		 * non-empty; stale bits are cleared by FindNext().
+		 */
+		mutable std::array<uint_least64_t, N_SLOTS / 64> bitmap{};
+
+		void Add(std::size_t i, FineTimerEvent &t) noexcept;
+
+		/**
+		 * Remove all timers from the given slot.
+		 */
+		List Take(std::size_t i) noexcept;
+
+		/**
+		 * Find the next non-empty slot, starting at index
+		 * #start and wrapping around.
+		 *
+		 * @return the distance from #start or #N_SLOTS if
+		 * this level is empty
+		 */
+		std::size_t FindNext(std::size_t start) const noexcept;
+	};
+
+	std::array<Level, N_LEVELS> levels;
+
+	/**
+	 * A list of timers which are already ready.  This can happen
+	 * if they are scheduled with a zero duration or scheduled in
+	 * the past.
+	 */
+	List ready;
+
+	/**
+	 * The next tick which has not yet been processed by Run().
+	 */
+	Tick current;
+
+public:
+	FineTimerWheel() noexcept;
+	~FineTimerWheel() noexcept;
+
+	FineTimerWheel(const FineTimerWheel &other) = delete;
+	FineTimerWheel &operator=(const FineTimerWheel &other) = delete;
+
+	[[gnu::pure]]
+	bool IsEmpty() const noexcept;
+
+	void Insert(FineTimerEvent &t, Event::TimePoint now) noexcept;
+
+	/**
+	 * Invoke all expired #FineTimerEvent instances and return the
+	 * duration until the next timer expires.  Returns a negative
+	 * duration if there is no timeout.
+	 */
+	Event::Duration Run(Event::TimePoint now) noexcept;
+
+private:
+	static constexpr Tick ToTick(Event::TimePoint t) noexcept {
+		return Tick(t.time_since_epoch() / RESOLUTION);
+	}
+
+	/**
+	 * Round the due time up to the next tick, so a timer is
+	 * never invoked early.
+	 */
+	static constexpr Tick ToDueTick(Event::TimePoint t) noexcept {
+		const auto d = t.time_since_epoch();
+		return Tick(d / RESOLUTION) +
+			(d % RESOLUTION != Event::Duration::zero());
+	}
+
+	/**
+	 * Add the timer to the slot which matches its due tick.
+	 */
+	void Place(FineTimerEvent &t) noexcept;
+
+	/**
+	 * Redistribute the timers of all higher-level slots which
+	 * begin at #current.
+	 */
+	void Cascade() noexcept;
+
+	/**
+	 * Determine the earliest tick (not before #current) at which
+	 * a timer becomes due or a non-empty slot needs to be
+	 * cascaded.
+	 *
+	 * @return the tick or max() if the wheel is empty
+	 */
+	[[gnu::pure]]
+	Tick GetNextTick() const noexcept;
+};
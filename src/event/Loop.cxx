@@ -154,7 +154,7 @@ EventLoop::Insert(FineTimerEvent &t) noexcept
 {
 	assert(IsInside());
 
-	timers.Insert(t);
+	timers.Insert(t, SteadyNow());
 	again = true;
 }
 
@@ -22,7 +22,7 @@
 
 #include "Chrono.hxx"
 #include "TimerWheel.hxx"
-#include "TimerList.hxx"
+#include "FineTimerWheel.hxx"
 #include "Backend.hxx"
 #include "SocketEvent.hxx"
 #include "event/Features.h"
@@ -66,7 +66,7 @@ class EventLoop final
 #endif
 
 	TimerWheel coarse_timers;
-	TimerList timers;
+	FineTimerWheel timers;
 
 	using DeferList = IntrusiveList<DeferEvent>;
 
@@ -43,6 +43,14 @@ BufferedReader::Fill(bool need_more)
 		return !need_more;
 
 	auto w = buffer.Write();
+	if (w.size < buffer.GetCapacity() / 4 &&
+	    buffer.GetAvailable() <= buffer.GetCapacity() / 2) {
+		/* only a small gap is left at the tail: move the
+		   data to the front instead of issuing a tiny read */
+		buffer.WantWrite(buffer.GetCapacity() / 2);
+		w = buffer.Write();
+	}
+
 	if (w.empty()) {
 		if (buffer.GetCapacity() >= MAX_SIZE)
 			return !need_more;
@@ -105,8 +113,12 @@ BufferedReader::ReadFull(WritableBuffer<void> _dest)
 char *
 BufferedReader::ReadLine()
 {
+	/* the number of bytes already scanned for a newline; this
+	   avoids scanning long lines again after each Fill() */
+	std::size_t skip = 0;
+
 	do {
-		char *line = ReadBufferedLine(buffer);
+		char *line = ReadBufferedLine(buffer, skip);
 		if (line != nullptr) {
 			++line_number;
 			return line;
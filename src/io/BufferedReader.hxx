@@ -49,7 +49,7 @@ class BufferedReader {
 
 public:
 	explicit BufferedReader(Reader &_reader) noexcept
-		:reader(_reader), buffer(16384) {}
+		:reader(_reader), buffer(65536) {}
 
 	/**
 	 * Reset the internal state.  Should be called after rewinding
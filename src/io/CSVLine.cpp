@@ -23,10 +23,12 @@ Copyright_License {
 
 #include "CSVLine.hpp"
 #include "util/StringAPI.hxx"
+#include "util/CharUtil.hxx"
 
 #include <algorithm>
 
 #include <cassert>
+#include <cstdint>
 #include <stdlib.h>
 
 static const char *
@@ -41,8 +43,10 @@ CSVLine::CSVLine(const char *line):
 size_t
 CSVLine::Skip()
 {
-  const char* _seperator = strchr(data, ',');
-  if (_seperator != nullptr && _seperator < end) {
+  /* don't look beyond the end of the line (e.g. into the NMEA
+     checksum) */
+  const char *_seperator = std::find(data, end, ',');
+  if (_seperator != end) {
     size_t length = _seperator - data;
     data = _seperator + 1;
     return length;
@@ -126,9 +130,70 @@ CSVLine::Read(double default_value)
   return default_value;
 }
 
+/**
+ * Parse a plain decimal number ("-12.5") without calling strtod(),
+ * which is surprisingly expensive.  The result is exact, because
+ * both the digits and the power of ten are exactly representable,
+ * and the division is correctly rounded.
+ *
+ * @return a pointer to the end of the number, or nullptr if the
+ * string is not in this simple format (the caller shall then fall
+ * back to strtod())
+ */
+static const char *
+ParseSimpleDecimal(const char *p, const char *end, double &value_r) noexcept
+{
+  bool negative = false;
+  if (p < end && (*p == '-' || *p == '+')) {
+    negative = *p == '-';
+    ++p;
+  }
+
+  constexpr unsigned MAX_DIGITS = 15;
+
+  uint_least64_t mantissa = 0;
+  unsigned n_digits = 0, n_fraction = 0;
+  bool dot = false;
+
+  for (; p < end; ++p) {
+    if (IsDigitASCII(*p)) {
+      if (++n_digits > MAX_DIGITS)
+        return nullptr;
+
+      mantissa = mantissa * 10 + (*p - '0');
+      if (dot)
+        ++n_fraction;
+    } else if (*p == '.' && !dot)
+      dot = true;
+    else if (*p == ',')
+      break;
+    else
+      /* exponent, hex, "inf", garbage: let strtod() decide */
+      return nullptr;
+  }
+
+  if (n_digits == 0)
+    return nullptr;
+
+  static constexpr double powers_of_ten[MAX_DIGITS + 1] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7,
+    1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+  };
+
+  double value = double(mantissa) / powers_of_ten[n_fraction];
+  value_r = negative ? -value : value;
+  return p;
+}
+
 bool
 CSVLine::ReadChecked(double &value_r)
 {
+  /* fast path for the common case */
+  if (const char *p = ParseSimpleDecimal(data, end, value_r)) {
+    data = p < end ? p + 1 : end;
+    return true;
+  }
+
   char *endptr;
   double value = strtod(data, &endptr);
   assert(endptr >= data && endptr <= end);
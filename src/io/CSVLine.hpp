@@ -38,6 +38,9 @@ protected:
 public:
   CSVLine(const char *line);
 
+  CSVLine(const char *_data, const char *_end) noexcept
+    :data(_data), end(_end) {}
+
   Range<const char *> Rest() const {
     return Range<const char *>(data, end);
   }
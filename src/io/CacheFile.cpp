@@ -0,0 +1,53 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "CacheFile.hpp"
+#include "FileCache.hpp"
+#include "system/FileMapping.hpp"
+
+CacheFileReader
+CacheFileReader::FromChecksummed(const std::byte *data, std::size_t size)
+{
+  if (size < sizeof(uint16_t))
+    throw std::runtime_error("Truncated cache file");
+
+  size -= sizeof(uint16_t);
+
+  uint16_t crc;
+  memcpy(&crc, data + size, sizeof(crc));
+  if (UpdateCRC16CCITT(data, size, 0) != crc)
+    throw std::runtime_error("Cache file checksum mismatch");
+
+  return {data, size};
+}
+
+CacheFileReader
+CacheFileReader::FromMapping(const FileMapping &mapping)
+{
+  const std::size_t header_size = FileCache::GetHeaderSize();
+  if (mapping.size() < header_size)
+    throw std::runtime_error("Truncated cache file");
+
+  return FromChecksummed((const std::byte *)mapping.at(header_size),
+                         mapping.size() - header_size);
+}
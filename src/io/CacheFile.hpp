@@ -0,0 +1,139 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_IO_CACHE_FILE_HPP
+#define XCSOAR_IO_CACHE_FILE_HPP
+
+#include "BufferedOutputStream.hxx"
+#include "util/CRC.hpp"
+#include "util/tstring.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+#include <string.h>
+#include <tchar.h>
+
+class FileMapping;
+
+/**
+ * Writes the payload of a #FileCache entry to a
+ * #BufferedOutputStream and calculates the checksum of everything
+ * that was written.  Call WriteChecksum() at the end.
+ */
+class CacheFileWriter {
+  BufferedOutputStream &os;
+  uint16_t crc = 0;
+
+public:
+  explicit CacheFileWriter(BufferedOutputStream &_os) noexcept
+    :os(_os) {}
+
+  void Write(const void *data, std::size_t size) {
+    os.Write(data, size);
+    crc = UpdateCRC16CCITT(data, size, crc);
+  }
+
+  template<typename T>
+  void WriteT(const T &value) {
+    Write(&value, sizeof(value));
+  }
+
+  void WriteString(const TCHAR *s, std::size_t length) {
+    Write(s, length * sizeof(*s));
+  }
+
+  /**
+   * Conclude the payload with the CRC16 of everything written so
+   * far.
+   */
+  void WriteChecksum() {
+    os.Write(&crc, sizeof(crc));
+  }
+};
+
+/**
+ * Reads the payload of a mapped #FileCache entry.  The mapping may
+ * not be aligned for the types stored in it, therefore all values
+ * are copied out.
+ */
+class CacheFileReader {
+  const std::byte *p;
+  const std::byte *const end;
+
+public:
+  CacheFileReader(const std::byte *_p, std::size_t size) noexcept
+    :p(_p), end(_p + size) {}
+
+  /**
+   * Verify the checksum written by CacheFileWriter::WriteChecksum()
+   * and construct a reader for the payload, which begins after the
+   * #FileCache header.
+   *
+   * Throws on error.
+   */
+  static CacheFileReader FromMapping(const FileMapping &mapping);
+
+  /**
+   * Verify the checksum written by CacheFileWriter::WriteChecksum()
+   * at the end of the given buffer and construct a reader for what
+   * precedes it.
+   *
+   * Throws on error.
+   */
+  static CacheFileReader FromChecksummed(const std::byte *data,
+                                         std::size_t size);
+
+  std::size_t GetRemaining() const noexcept {
+    return end - p;
+  }
+
+  const std::byte *Read(std::size_t size) {
+    if (size > GetRemaining())
+      throw std::runtime_error("Truncated cache file");
+
+    const std::byte *result = p;
+    p += size;
+    return result;
+  }
+
+  template<typename T>
+  T ReadT() {
+    T value;
+    memcpy(&value, Read(sizeof(value)), sizeof(value));
+    return value;
+  }
+
+  tstring ReadString(std::size_t length) {
+    if (length > GetRemaining() / sizeof(TCHAR))
+      throw std::runtime_error("Truncated cache file");
+
+    tstring value(length, TCHAR{});
+    memcpy(value.data(), Read(length * sizeof(TCHAR)),
+           length * sizeof(TCHAR));
+    return value;
+  }
+};
+
+#endif
@@ -72,7 +72,7 @@ try {
   if (!archive)
     return nullptr;
 
-  return std::make_unique<ZipLineReaderA>(archive->get(), in_map_file);
+  return std::make_unique<ZipLineReaderA>(*archive, in_map_file);
 } catch (...) {
   LogError(std::current_exception());
   return nullptr;
@@ -25,6 +25,7 @@ Copyright_License {
 #include "FileReader.hxx"
 #include "FileOutputStream.hxx"
 #include "system/FileUtil.hpp"
+#include "system/FileMapping.hpp"
 
 #ifdef _WIN32
 #include "time/FileTime.hxx"
@@ -90,6 +91,33 @@ GetRegularFileInfo(Path path, FileInfo &info)
 #endif
 }
 
+/**
+ * Check whether the specified cache file is not older than the
+ * original file.  Deletes the cache file if it is stale.
+ *
+ * @return false if the cache file is missing or stale
+ */
+static bool
+CheckCacheFileInfo(Path original_path, Path path, FileInfo &original_info)
+{
+  if (!GetRegularFileInfo(original_path, original_info))
+    return false;
+
+  FileInfo cached_info;
+  if (!GetRegularFileInfo(path, cached_info))
+    return false;
+
+  /* if the original file is newer than the cache, discard the cache -
+     unless the system clock is skewed (origina file's modification
+     time is in the future) */
+  if (original_info.mtime > cached_info.mtime && !original_info.IsFuture()) {
+    File::Delete(path);
+    return false;
+  }
+
+  return true;
+}
+
 FileCache::FileCache(AllocatedPath &&_cache_path)
   :cache_path(std::move(_cache_path)) {}
 
@@ -102,23 +130,11 @@ FileCache::Flush(const TCHAR *name)
 std::unique_ptr<Reader>
 FileCache::Load(const TCHAR *name, Path original_path) noexcept
 {
-  FileInfo original_info;
-  if (!GetRegularFileInfo(original_path, original_info))
-    return nullptr;
-
   const auto path = MakeCachePath(name);
 
-  FileInfo cached_info;
-  if (!GetRegularFileInfo(path, cached_info))
-    return nullptr;
-
-  /* if the original file is newer than the cache, discard the cache -
-     unless the system clock is skewed (origina file's modification
-     time is in the future) */
-  if (original_info.mtime > cached_info.mtime && !original_info.IsFuture()) {
-    File::Delete(path);
+  FileInfo original_info;
+  if (!CheckCacheFileInfo(original_path, path, original_info))
     return nullptr;
-  }
 
   try {
     auto r = std::make_unique<FileReader>(path);
@@ -139,6 +155,42 @@ FileCache::Load(const TCHAR *name, Path original_path) noexcept
   return nullptr;
 }
 
+std::unique_ptr<FileMapping>
+FileCache::Map(const TCHAR *name, Path original_path) noexcept
+{
+  const auto path = MakeCachePath(name);
+
+  FileInfo original_info;
+  if (!CheckCacheFileInfo(original_path, path, original_info))
+    return nullptr;
+
+  try {
+    auto m = std::make_unique<FileMapping>(path);
+
+    if (m->size() >= GetHeaderSize()) {
+      unsigned magic;
+      struct FileInfo old_info;
+
+      memcpy(&magic, m->data(), sizeof(magic));
+      memcpy(&old_info, m->at(sizeof(magic)), sizeof(old_info));
+
+      if (magic == FILE_CACHE_MAGIC &&
+          old_info == original_info)
+        return m;
+    }
+  } catch (...) {
+  }
+
+  File::Delete(path);
+  return nullptr;
+}
+
+std::size_t
+FileCache::GetHeaderSize() noexcept
+{
+  return sizeof(FILE_CACHE_MAGIC) + sizeof(FileInfo);
+}
+
 std::unique_ptr<FileOutputStream>
 FileCache::Save(const TCHAR *name, Path original_path)
 {
@@ -26,6 +26,7 @@ Copyright_License {
 
 #include "system/Path.hpp"
 
+#include <cstddef>
 #include <memory>
 
 #include <stdio.h>
@@ -33,6 +34,7 @@ Copyright_License {
 
 class Reader;
 class FileOutputStream;
+class FileMapping;
 
 class FileCache {
   AllocatedPath cache_path;
@@ -54,6 +56,22 @@ public:
    */
   std::unique_ptr<Reader> Load(const TCHAR *name, Path original_path) noexcept;
 
+  /**
+   * Like Load(), but map the whole cache file into memory.  The
+   * payload begins at offset GetHeaderSize().
+   *
+   * Returns nullptr on error.
+   */
+  std::unique_ptr<FileMapping> Map(const TCHAR *name,
+                                   Path original_path) noexcept;
+
+  /**
+   * The size of the header which is written by Save() in front of
+   * the payload.
+   */
+  [[gnu::const]]
+  static std::size_t GetHeaderSize() noexcept;
+
   /**
    * Throws on error.
    */
@@ -51,6 +51,17 @@ public:
     buffered.Reset();
   }
 
+  /**
+   * Continue reading at the specified file offset, which should be
+   * the beginning of a line.
+   *
+   * Throws on error.
+   */
+  void Seek(off_t offset) {
+    file.Seek(offset);
+    buffered.Reset();
+  }
+
 public:
   /* virtual methods from class NLineReader */
   char *ReadLine() override;
@@ -137,6 +137,16 @@ FileOutputStream::Write(const void *data, size_t size)
 				      GetPath().c_str());
 }
 
+void
+FileOutputStream::Sync()
+{
+	assert(IsDefined());
+
+	if (!FlushFileBuffers(handle))
+		throw FormatLastError("Failed to sync %s",
+				      GetPath().c_str());
+}
+
 void
 FileOutputStream::Commit()
 {
@@ -247,6 +257,20 @@ FileOutputStream::Write(const void *data, size_t size)
 				  GetPath().c_str());
 }
 
+void
+FileOutputStream::Sync()
+{
+	assert(IsDefined());
+
+#ifdef __linux__
+	const int result = fdatasync(fd.Get());
+#else
+	const int result = fsync(fd.Get());
+#endif
+	if (result < 0)
+		throw FormatErrno("Failed to sync %s", GetPath().c_str());
+}
+
 void
 FileOutputStream::Commit()
 {
@@ -139,6 +139,14 @@ public:
 	/* virtual methods from class OutputStream */
 	void Write(const void *data, size_t size) override;
 
+	/**
+	 * Flush all data written so far to the storage device
+	 * (fsync()).
+	 *
+	 * Throws on error.
+	 */
+	void Sync();
+
 	void Commit();
 	void Cancel() noexcept;
 
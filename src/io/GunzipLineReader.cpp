@@ -0,0 +1,68 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "GunzipLineReader.hpp"
+#include "FileLineReader.hpp"
+#include "FileReader.hxx"
+#include "GunzipReader.hxx"
+#include "BufferedReader.hxx"
+#include "system/Path.hpp"
+
+namespace {
+
+/**
+ * Like #FileLineReaderA, but decompresses a gzip file.
+ */
+class GunzipFileLineReaderA final : public NLineReader {
+  FileReader file;
+  GunzipReader gunzip;
+  BufferedReader buffered;
+
+public:
+  explicit GunzipFileLineReaderA(Path path)
+    :file(path), gunzip(file), buffered(gunzip) {}
+
+  /* virtual methods from class NLineReader */
+  char *ReadLine() override {
+    return buffered.ReadLine();
+  }
+
+  long GetSize() const override {
+    return file.GetSize();
+  }
+
+  long Tell() const override {
+    return file.GetPosition();
+  }
+};
+
+} // anonymous namespace
+
+std::unique_ptr<NLineReader>
+OpenFileLineReaderA(Path path)
+{
+  if (path.MatchesExtension(_T(".gz")))
+    return std::make_unique<GunzipFileLineReaderA>(path);
+
+  return std::make_unique<FileLineReaderA>(path);
+}
@@ -1,8 +1,5 @@
 /*
- * Copyright 2007-2021 CM4all GmbH
- * All rights reserved.
- *
- * author: Max Kellermann <mk@cm4all.com>
+ * Copyright 2014-2021 Max Kellermann <max.kellermann@gmail.com>
  *
  * Redistribution and use in source and binary forms, with or without
  * modification, are permitted provided that the following conditions
@@ -30,62 +27,44 @@
  * OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
-#include "Loop.hxx"
-#include "FineTimerEvent.hxx"
+#ifndef GZIP_OUTPUT_STREAM_HXX
+#define GZIP_OUTPUT_STREAM_HXX
 
-#ifdef NO_BOOST
-#include <algorithm>
-#endif
+#include "OutputStream.hxx"
 
-constexpr bool
-TimerList::Compare::operator()(const FineTimerEvent &a,
-			       const FineTimerEvent &b) const noexcept
-{
-	return a.due < b.due;
-}
+#include <zlib.h>
 
-TimerList::TimerList() = default;
+/**
+ * A filter that compresses data written to it using zlib, forwarding
+ * compressed data in the "gzip" format.
+ *
+ * Don't forget to call Finish()!
+ */
+class GzipOutputStream final : public OutputStream {
+	OutputStream &next;
 
-TimerList::~TimerList() noexcept
-{
-	assert(timers.empty());
-}
+	z_stream z;
 
-void
-TimerList::Insert(FineTimerEvent &t) noexcept
-{
-#ifdef NO_BOOST
-	auto i = std::find_if(timers.begin(), timers.end(), [due = t.GetDue()](const auto &other){
-		return other.GetDue() >= due;
-	});
+public:
+	/**
+	 * Construct the filter.
+	 *
+	 * Throws on error.
+	 */
+	explicit GzipOutputStream(OutputStream &_next);
 
-	timers.insert(i, t);
-#else
-	timers.insert(t);
-#endif
-}
+	~GzipOutputStream() noexcept {
+		deflateEnd(&z);
+	}
 
-Event::Duration
-TimerList::Run(const Event::TimePoint now) noexcept
-{
-	while (true) {
-		auto i = timers.begin();
-		if (i == timers.end())
-			break;
+	/**
+	 * Finish the file and write all data remaining in zlib's
+	 * output buffer.
+	 */
+	void Finish();
 
-		auto &t = *i;
-		const auto timeout = t.due - now;
-		if (timeout > timeout.zero())
-			return timeout;
+	/* virtual methods from class OutputStream */
+	void Write(const void *data, std::size_t size) override;
+};
 
-#ifdef NO_BOOST
-		t.Cancel();
-#else
-		timers.erase(i);
 #endif
-
-		t.Run();
-	}
-
-	return Event::Duration(-1);
-}
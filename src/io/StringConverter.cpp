@@ -24,7 +24,9 @@ Copyright_License {
 #include "StringConverter.hpp"
 #include "util/Compiler.h"
 #include "util/UTF8.hpp"
+#include "util/StringView.hxx"
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <stdexcept>
@@ -51,6 +53,21 @@ StringConverter::Convert(char *narrow)
 {
   assert(narrow != nullptr);
 
+  std::size_t narrow_length = strlen(narrow);
+  if (IsPlainASCII({narrow, narrow_length})) {
+    /* fast path: plain ASCII needs no conversion, no matter which
+       charset was selected (and it cannot contain a byte order
+       mark) */
+#ifdef _UNICODE
+    TCHAR *t = tbuffer.get(narrow_length + 1);
+    assert(t != nullptr);
+    std::copy_n(narrow, narrow_length + 1, t);
+    return t;
+#else
+    return narrow;
+#endif
+  }
+
   // Check if there is byte order mark in front
   if (charset == Charset::AUTO || charset == Charset::UTF8) {
     char *p = SkipByteOrderMark(narrow);
@@ -67,7 +84,8 @@ StringConverter::Convert(char *narrow)
     charset = Charset::ISO_LATIN_1;
 
 #ifdef _UNICODE
-  size_t narrow_length = strlen(narrow);
+  /* the byte order mark may have been skipped */
+  narrow_length = strlen(narrow);
 
   TCHAR *t = tbuffer.get(narrow_length + 1);
   assert(t != nullptr);
@@ -100,7 +118,7 @@ StringConverter::Convert(char *narrow)
     const char *utf8;
 
   case Charset::ISO_LATIN_1:
-    buffer_size = strlen(narrow) * 2 + 1;
+    buffer_size = narrow_length * 2 + 1;
     utf8 = Latin1ToUTF8(narrow, tbuffer.get(buffer_size), buffer_size);
     if (utf8 == nullptr)
       throw std::runtime_error("Latin-1 to UTF-8 conversion failed");
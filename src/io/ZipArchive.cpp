@@ -23,16 +23,94 @@ Copyright_License {
 
 #include "ZipArchive.hpp"
 #include "system/ConvertPathName.hpp"
+#include "system/FileMapping.hpp"
+#include "util/ByteOrder.hxx"
 #include "util/RuntimeError.hxx"
 
 #include <zzip/zzip.h>
 
+#include <utility>
+
+namespace {
+
+/**
+ * The "end of central directory record".
+ */
+struct EndOfCentralDirectory {
+  static constexpr uint32_t SIGNATURE = 0x06054b50;
+
+  PackedLE32 signature;
+  PackedLE16 disk_number, cd_disk_number;
+  PackedLE16 disk_entries, total_entries;
+  PackedLE32 cd_size, cd_offset;
+  PackedLE16 comment_length;
+};
+
+static_assert(sizeof(EndOfCentralDirectory) == 22);
+
+/**
+ * A "central directory file header"; it is followed by the file
+ * name, the extra field and the file comment.
+ */
+struct CentralFileHeader {
+  static constexpr uint32_t SIGNATURE = 0x02014b50;
+
+  PackedLE32 signature;
+  PackedLE16 version_made_by, version_needed;
+  PackedLE16 flags, method;
+  PackedLE16 mtime, mdate;
+  PackedLE32 crc32, compressed_size, size;
+  PackedLE16 name_length, extra_length, comment_length;
+  PackedLE16 disk_number, internal_attributes;
+  PackedLE32 external_attributes;
+  PackedLE32 header_offset;
+};
+
+static_assert(sizeof(CentralFileHeader) == 46);
+
+/**
+ * A "local file header"; it is followed by the file name, the extra
+ * field and the file data.
+ */
+struct LocalFileHeader {
+  static constexpr uint32_t SIGNATURE = 0x04034b50;
+
+  PackedLE32 signature;
+  PackedLE16 version_needed;
+  PackedLE16 flags, method;
+  PackedLE16 mtime, mdate;
+  PackedLE32 crc32, compressed_size, size;
+  PackedLE16 name_length, extra_length;
+};
+
+static_assert(sizeof(LocalFileHeader) == 30);
+
+/**
+ * General purpose flag: the member is encrypted.
+ */
+static constexpr uint16_t FLAG_ENCRYPTED = 0x1;
+
+}
+
 ZipArchive::ZipArchive(Path path)
   :dir(zzip_dir_open(NarrowPathName(path), nullptr))
 {
   if (dir == nullptr)
     throw FormatRuntimeError("Failed to open ZIP archive %s",
                              (const char *)NarrowPathName(path));
+
+  try {
+    /* don't read ahead: map files can be large, and usually only
+       small portions of the terrain are accessed */
+    mapping = std::make_unique<FileMapping>(path, false);
+  } catch (...) {
+    /* not fatal: zziplib will be used for all accesses */
+  }
+
+  if (mapping && !LoadIndex()) {
+    entries.clear();
+    mapping.reset();
+  }
 }
 
 ZipArchive::~ZipArchive() noexcept
@@ -41,13 +119,137 @@ ZipArchive::~ZipArchive() noexcept
     zzip_dir_close(dir);
 }
 
+ZipArchive::ZipArchive(ZipArchive &&src) noexcept
+  :dir(std::exchange(src.dir, nullptr)),
+   mapping(std::move(src.mapping)),
+   entries(std::move(src.entries)) {}
+
+ZipArchive &
+ZipArchive::operator=(ZipArchive &&src) noexcept
+{
+  std::swap(dir, src.dir);
+  std::swap(mapping, src.mapping);
+  std::swap(entries, src.entries);
+  return *this;
+}
+
+bool
+ZipArchive::LoadIndex() noexcept
+{
+  const auto *const base = (const std::byte *)mapping->data();
+  const std::size_t size = mapping->size();
+
+  if (size < sizeof(EndOfCentralDirectory))
+    return false;
+
+  /* search the end of central directory record backwards; it may be
+     followed by a comment of up to 64 kB */
+  const EndOfCentralDirectory *eocd = nullptr;
+  const std::size_t last = size - sizeof(*eocd);
+  const std::size_t first = last > 0xffff ? last - 0xffff : 0;
+  for (std::size_t i = last + 1; i-- > first;) {
+    const auto &e = *(const EndOfCentralDirectory *)(base + i);
+    if (e.signature == EndOfCentralDirectory::SIGNATURE &&
+        i + sizeof(e) + e.comment_length == size) {
+      eocd = &e;
+      break;
+    }
+  }
+
+  if (eocd == nullptr)
+    return false;
+
+  const std::size_t eocd_offset = (const std::byte *)eocd - base;
+  const std::size_t cd_offset = eocd->cd_offset;
+  const std::size_t cd_size = eocd->cd_size;
+  const unsigned n_entries = eocd->total_entries;
+
+  /* ZIP64 archives and multi-disk archives are not supported */
+  if (n_entries == 0xffff || eocd->cd_offset == 0xffffffff ||
+      eocd->disk_number != 0 || eocd->cd_disk_number != 0 ||
+      cd_size > eocd_offset || cd_offset > eocd_offset - cd_size)
+    return false;
+
+  entries.reserve(n_entries);
+
+  const std::byte *p = base + cd_offset;
+  const std::byte *const end = p + cd_size;
+  for (unsigned i = 0; i < n_entries; ++i) {
+    if (std::size_t(end - p) < sizeof(CentralFileHeader))
+      return false;
+
+    const auto &h = *(const CentralFileHeader *)p;
+    if (h.signature != CentralFileHeader::SIGNATURE)
+      return false;
+
+    const std::size_t record_size = sizeof(h) + h.name_length +
+      h.extra_length + h.comment_length;
+    if (std::size_t(end - p) < record_size)
+      return false;
+
+    Entry entry;
+    entry.header_offset = h.header_offset;
+    entry.compressed_size = h.compressed_size;
+    entry.size = h.size;
+    entry.method = (h.flags & FLAG_ENCRYPTED) != 0
+      /* mark encrypted members as "compressed", because they
+         can't be accessed directly */
+      ? 0xffff
+      : uint16_t(h.method);
+
+    /* like zziplib, the first entry with a given name wins */
+    entries.emplace(std::string((const char *)(p + sizeof(h)),
+                                h.name_length),
+                    entry);
+
+    p += record_size;
+  }
+
+  return true;
+}
+
 bool
 ZipArchive::Exists(const char *name) const noexcept
 {
+  if (mapping)
+    return entries.find(name) != entries.end();
+
   ZZIP_STAT st;
   return zzip_dir_stat(dir, name, &st, 0) == 0;
 }
 
+ConstBuffer<void>
+ZipArchive::GetStored(const char *name) const noexcept
+{
+  if (!mapping)
+    return nullptr;
+
+  const auto i = entries.find(name);
+  if (i == entries.end())
+    return nullptr;
+
+  const Entry &entry = i->second;
+  if (entry.method != 0 || entry.compressed_size != entry.size)
+    return nullptr;
+
+  const std::size_t size = mapping->size();
+  const std::size_t header_offset = entry.header_offset;
+  if (header_offset > size ||
+      size - header_offset < sizeof(LocalFileHeader))
+    return nullptr;
+
+  const auto &h = *(const LocalFileHeader *)mapping->at(header_offset);
+  if (h.signature != LocalFileHeader::SIGNATURE)
+    return nullptr;
+
+  const std::size_t data_offset = header_offset + sizeof(h) +
+    h.name_length + h.extra_length;
+  if (data_offset > size || size - data_offset < entry.size)
+    return nullptr;
+
+  return {mapping->at(data_offset), entry.size};
+}
+
 std::string
 ZipArchive::NextName() noexcept
 {
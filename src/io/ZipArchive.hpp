@@ -24,19 +24,56 @@ Copyright_License {
 #ifndef XCSOAR_IO_ZIP_ARCHIVE_HPP
 #define XCSOAR_IO_ZIP_ARCHIVE_HPP
 
-#include <algorithm>
+#include "util/ConstBuffer.hxx"
+
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <cstddef>
+#include <cstdint>
 
 class Path;
+class FileMapping;
 
 /**
  * A handle to z ZIP archive file.  It is a OO wrapper for struct
  * zzip_dir.
+ *
+ * If possible, the whole file is mapped into memory, and the central
+ * directory is parsed once into a hash table.  This allows looking
+ * up members in constant time, and members which are stored without
+ * compression can be accessed directly in the mapping (see
+ * GetStored()), bypassing zziplib.
  */
 class ZipArchive {
   struct zzip_dir *dir = nullptr;
 
+  /**
+   * The archive file mapped into memory.  This is nullptr if mapping
+   * has failed; all accesses go through zziplib then.
+   */
+  std::unique_ptr<FileMapping> mapping;
+
+  struct Entry {
+    /**
+     * The offset of the "local file header" within the file.
+     */
+    uint32_t header_offset;
+
+    uint32_t compressed_size, size;
+
+    /**
+     * The compression method; 0 means "stored".
+     */
+    uint16_t method;
+  };
+
+  /**
+   * An index of all members found in the central directory.  It is
+   * only populated if #mapping is available.
+   */
+  std::unordered_map<std::string, Entry> entries;
+
 public:
   /**
    * Open a ZIP archive.  Throws std::runtime_error on error.
@@ -44,14 +81,8 @@ public:
   explicit ZipArchive(Path path);
   ~ZipArchive() noexcept;
 
-  ZipArchive(ZipArchive &&src) noexcept:dir(src.dir) {
-    src.dir = nullptr;
-  }
-
-  ZipArchive &operator=(ZipArchive &&src) noexcept {
-    std::swap(dir, src.dir);
-    return *this;
-  }
+  ZipArchive(ZipArchive &&src) noexcept;
+  ZipArchive &operator=(ZipArchive &&src) noexcept;
 
   struct zzip_dir *get() noexcept {
     return dir;
@@ -60,12 +91,33 @@ public:
   [[gnu::pure]]
   bool Exists(const char *name) const noexcept;
 
+  /**
+   * Obtain the contents of a member which is stored without
+   * compression, directly from the memory mapping.  The returned
+   * buffer is valid as long as this object exists.
+   *
+   * @return the member's contents or nullptr if the member does not
+   * exist, if it is compressed or if the archive could not be mapped
+   * into memory (use #ZipReader then)
+   */
+  [[gnu::pure]]
+  ConstBuffer<void> GetStored(const char *name) const noexcept;
+
   /**
    * Obtain the next directory entry name.  Can be used to iterate
    * over all files in the archive.  Returns an empty string after the
    * last entry.
    */
   std::string NextName() noexcept;
+
+private:
+  /**
+   * Parse the central directory from #mapping and fill #entries.
+   *
+   * @return false if the archive is malformed or uses features not
+   * supported by this parser (e.g. ZIP64)
+   */
+  bool LoadIndex() noexcept;
 };
 
 #endif
@@ -34,6 +34,9 @@ protected:
 
   WithZipReader(struct zzip_dir *dir, const char *path)
     :zip(dir, path) {}
+
+  WithZipReader(ZipArchive &archive, const char *path)
+    :zip(archive, path) {}
 };
 
 /**
@@ -45,6 +48,9 @@ public:
   ZipLineReaderA(struct zzip_dir *dir, const char *path)
     :WithZipReader(dir, path), BufferedLineReader(zip) {}
 
+  ZipLineReaderA(ZipArchive &archive, const char *path)
+    :WithZipReader(archive, path), BufferedLineReader(zip) {}
+
 public:
   /* virtual methods from class NLineReader */
   long GetSize() const override;
@@ -59,6 +65,11 @@ public:
   ZipLineReader(struct zzip_dir *dir, const char *path,
                 Charset cs=Charset::UTF8)
     :ConvertLineReader(std::make_unique<ZipLineReaderA>(dir, path), cs) {}
+
+  ZipLineReader(ZipArchive &archive, const char *path,
+                Charset cs=Charset::UTF8)
+    :ConvertLineReader(std::make_unique<ZipLineReaderA>(archive, path),
+                       cs) {}
 };
 
 #endif
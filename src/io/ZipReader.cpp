@@ -22,16 +22,20 @@ Copyright_License {
 */
 
 #include "ZipReader.hpp"
+#include "ZipArchive.hpp"
 
 #include <zzip/util.h>
 
+#include <algorithm>
 #include <stdexcept>
 
 #include <stdio.h>
+#include <string.h>
 
-ZipReader::ZipReader(struct zzip_dir *dir, const char *path)
-  :file(zzip_open_rb(dir, path))
+static struct zzip_file *
+OpenZipFile(struct zzip_dir *dir, const char *path)
 {
+  auto *file = zzip_open_rb(dir, path);
   if (file == nullptr) {
     /* TODO: re-enable zziplib's error reporting, and improve this
        error message */
@@ -40,8 +44,17 @@ ZipReader::ZipReader(struct zzip_dir *dir, const char *path)
              "Failed to open '%s' from ZIP file", path);
     throw std::runtime_error(msg);
   }
+
+  return file;
 }
 
+ZipReader::ZipReader(struct zzip_dir *dir, const char *path)
+  :stored(nullptr), file(OpenZipFile(dir, path)) {}
+
+ZipReader::ZipReader(ZipArchive &archive, const char *path)
+  :stored(archive.GetStored(path)),
+   file(stored.IsNull() ? OpenZipFile(archive.get(), path) : nullptr) {}
+
 ZipReader::~ZipReader()
 {
   if (file != nullptr)
@@ -51,6 +64,9 @@ ZipReader::~ZipReader()
 uint64_t
 ZipReader::GetSize() const
 {
+  if (file == nullptr)
+    return stored.size;
+
   ZZIP_STAT st;
   return zzip_file_stat(file, &st) >= 0
     ? st.st_size
@@ -60,12 +76,22 @@ ZipReader::GetSize() const
 uint64_t
 ZipReader::GetPosition() const
 {
+  if (file == nullptr)
+    return position;
+
   return zzip_tell(file);
 }
 
 std::size_t
 ZipReader::Read(void *data, std::size_t size)
 {
+  if (file == nullptr) {
+    size = std::min(size, stored.size - position);
+    memcpy(data, (const std::byte *)stored.data + position, size);
+    position += size;
+    return size;
+  }
+
   zzip_ssize_t nbytes = zzip_file_read(file, data, size);
   if (nbytes < 0)
     throw std::runtime_error("Failed to read from ZIP file");
@@ -25,21 +25,41 @@ Copyright_License {
 #define XCSOAR_IO_ZIP_READER_HPP
 
 #include "Reader.hxx"
+#include "util/ConstBuffer.hxx"
 
 #include <cstdint>
 
 struct zzip_file;
 struct zzip_dir;
+class ZipArchive;
 
 class ZipReader final : public Reader {
+  /**
+   * If the member is stored without compression and the archive is
+   * mapped into memory, then this points to the member's contents,
+   * and #file is nullptr.
+   */
+  const ConstBuffer<void> stored;
+
   struct zzip_file *const file;
 
+  std::size_t position = 0;
+
 public:
   /**
    * Throws std::runtime_errror on error.
    */
   ZipReader(struct zzip_dir *dir, const char *path);
 
+  /**
+   * Open a member of the given #ZipArchive.  Uncompressed members
+   * are read directly from the archive's memory mapping, if
+   * available.
+   *
+   * Throws std::runtime_errror on error.
+   */
+  ZipReader(ZipArchive &archive, const char *path);
+
   virtual ~ZipReader();
 
   gcc_pure
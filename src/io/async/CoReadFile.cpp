@@ -0,0 +1,72 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "CoReadFile.hpp"
+#include "CoRunInThread.hpp"
+#include "io/FileReader.hxx"
+
+#include <stdexcept>
+
+static constexpr std::size_t CHUNK_SIZE = 64 * 1024;
+
+static AllocatedArray<std::byte>
+ReadFile(Path path, std::size_t max_size, const std::atomic_bool &cancel)
+{
+  FileReader file(path);
+
+  const uint64_t size = file.GetSize();
+  if (size > max_size)
+    throw std::runtime_error("File is too large");
+
+  AllocatedArray<std::byte> buffer(size);
+
+  std::size_t position = 0;
+  while (position < size) {
+    if (cancel)
+      /* nobody will look at the result */
+      break;
+
+    const std::size_t nbytes =
+      file.Read(buffer.data() + position,
+                std::min<std::size_t>(size - position, CHUNK_SIZE));
+    if (nbytes == 0)
+      /* the file has been truncated meanwhile */
+      break;
+
+    position += nbytes;
+  }
+
+  buffer.SetSize(position);
+  return buffer;
+}
+
+Co::Task<AllocatedArray<std::byte>>
+CoReadFile(EventLoop &event_loop, AllocatedPath path, std::size_t max_size)
+{
+  co_return co_await CoRunInThread<AllocatedArray<std::byte>>{
+    event_loop,
+    [&path, max_size](const std::atomic_bool &cancel){
+      return ReadFile(path, max_size, cancel);
+    },
+  };
+}
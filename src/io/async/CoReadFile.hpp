@@ -0,0 +1,46 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_CO_READ_FILE_HPP
+#define XCSOAR_CO_READ_FILE_HPP
+
+#include "co/Task.hxx"
+#include "system/Path.hpp"
+#include "util/AllocatedArray.hxx"
+
+#include <cstddef>
+
+class EventLoop;
+
+/**
+ * Read the whole file into memory, without blocking the
+ * #EventLoop: the file is read in a helper thread, and the coroutine
+ * is resumed in the #EventLoop thread when it is done.  Cancelling
+ * the coroutine stops the read after the current chunk.
+ *
+ * Throws on I/O error or if the file is larger than #max_size.
+ */
+Co::Task<AllocatedArray<std::byte>>
+CoReadFile(EventLoop &event_loop, AllocatedPath path, std::size_t max_size);
+
+#endif
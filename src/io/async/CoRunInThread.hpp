@@ -0,0 +1,138 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_CO_RUN_IN_THREAD_HPP
+#define XCSOAR_CO_RUN_IN_THREAD_HPP
+
+#include "event/InjectEvent.hxx"
+#include "thread/Thread.hpp"
+#include "util/BindMethod.hxx"
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <optional>
+
+/**
+ * An awaitable which runs a blocking function (e.g. reading and
+ * parsing a file) in a new thread, and resumes the awaiting
+ * coroutine in the #EventLoop thread when the function has
+ * finished.  Its return value becomes the result of the "co_await"
+ * expression; an exception it throws is rethrown there.
+ *
+ * If the awaiting coroutine is destroyed before that (i.e. it gets
+ * cancelled), the function's cancellation flag is set and the
+ * destructor waits for the thread to exit.  Long-running functions
+ * should therefore check the flag now and then.
+ *
+ * This object must be awaited and destroyed in the #EventLoop
+ * thread.
+ */
+template<typename T>
+class CoRunInThread final {
+public:
+  using Function = std::function<T(const std::atomic_bool &cancel)>;
+
+private:
+  class Worker final : public Thread {
+    CoRunInThread &parent;
+
+  public:
+    explicit Worker(CoRunInThread &_parent) noexcept
+      :Thread("CoRunInThread"), parent(_parent) {}
+
+  protected:
+    void Run() noexcept override {
+      parent.Work();
+    }
+  };
+
+  InjectEvent inject_event;
+
+  Function function;
+
+  Worker worker{*this};
+
+  std::atomic_bool cancel{false};
+
+  std::optional<T> value;
+  std::exception_ptr error;
+
+  std::coroutine_handle<> continuation;
+
+public:
+  CoRunInThread(EventLoop &event_loop, Function &&_function) noexcept
+    :inject_event(event_loop, BIND_THIS_METHOD(OnInject)),
+     function(std::move(_function)) {}
+
+  ~CoRunInThread() noexcept {
+    if (worker.IsDefined()) {
+      cancel = true;
+      worker.Join();
+    }
+
+    /* the InjectEvent destructor cancels a pending OnInject() call,
+       which is safe now that the worker has exited */
+  }
+
+  CoRunInThread(const CoRunInThread &) = delete;
+  CoRunInThread &operator=(const CoRunInThread &) = delete;
+
+  bool await_ready() const noexcept {
+    return false;
+  }
+
+  /**
+   * Throws if the thread cannot be started.
+   */
+  void await_suspend(std::coroutine_handle<> _continuation) {
+    continuation = _continuation;
+    worker.Start();
+  }
+
+  T await_resume() {
+    if (error)
+      std::rethrow_exception(error);
+
+    return std::move(*value);
+  }
+
+private:
+  void Work() noexcept {
+    try {
+      value.emplace(function(cancel));
+    } catch (...) {
+      error = std::current_exception();
+    }
+
+    inject_event.Schedule();
+  }
+
+  void OnInject() noexcept {
+    worker.Join();
+    continuation.resume();
+  }
+};
+
+#endif
@@ -0,0 +1,176 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Writer.hxx"
+
+#include <algorithm>
+#include <charconv>
+
+#include <stdio.h>
+#include <string.h>
+
+namespace Json {
+
+static constexpr bool
+NeedsEscape(char ch) noexcept
+{
+  return (unsigned char)ch < 0x20 || ch == '"' || ch == '\\';
+}
+
+static void
+WriteEscaped(BufferedOutputStream &os, char ch)
+{
+  switch (ch) {
+  case '"':
+    os.Write("\\\"");
+    break;
+
+  case '\\':
+    os.Write("\\\\");
+    break;
+
+  case '\n':
+    os.Write("\\n");
+    break;
+
+  case '\r':
+    os.Write("\\r");
+    break;
+
+  case '\t':
+    os.Write("\\t");
+    break;
+
+  default:
+    os.Format("\\u%04x", (unsigned char)ch);
+    break;
+  }
+}
+
+void
+WriteString(BufferedOutputStream &os, std::string_view s)
+{
+  os.Write('"');
+
+  /* copy runs of characters which need no escaping in one call */
+  const char *run = s.data();
+  for (const char &ch : s) {
+    if (!NeedsEscape(ch))
+      continue;
+
+    os.Write(run, &ch - run);
+    WriteEscaped(os, ch);
+    run = &ch + 1;
+  }
+
+  os.Write(run, s.data() + s.size() - run);
+  os.Write('"');
+}
+
+void
+WriteValue(BufferedOutputStream &os, bool value)
+{
+  os.Write(value ? "true" : "false");
+}
+
+template<typename T>
+static void
+WriteNumber(BufferedOutputStream &os, T value)
+{
+  char buffer[32];
+  const auto result = std::to_chars(buffer, std::end(buffer), value);
+  os.Write(buffer, result.ptr - buffer);
+}
+
+void
+WriteValue(BufferedOutputStream &os, int64_t value)
+{
+  WriteNumber(os, value);
+}
+
+void
+WriteValue(BufferedOutputStream &os, uint64_t value)
+{
+  WriteNumber(os, value);
+}
+
+/**
+ * Like std::isfinite(), but inspects the bits, because -ffast-math
+ * lets the compiler assume that std::isfinite() is always true.
+ */
+static bool
+IsFinite(double value) noexcept
+{
+  constexpr uint64_t exponent_mask = 0x7ff0000000000000ULL;
+
+  uint64_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return (bits & exponent_mask) != exponent_mask;
+}
+
+void
+WriteValue(BufferedOutputStream &os, double value)
+{
+  if (!IsFinite(value)) {
+    os.Write("null");
+    return;
+  }
+
+#ifdef __cpp_lib_to_chars
+  /* the shortest representation which round-trips */
+  WriteNumber(os, value);
+#else
+  char buffer[32];
+  int length = snprintf(buffer, sizeof(buffer), "%.17g", value);
+  os.Write(buffer, length);
+#endif
+}
+
+BufferedOutputStream &
+ObjectWriter::Key(std::string_view key)
+{
+  /* assemble separator, key and colon in one buffer to keep the
+     number of BufferedOutputStream calls low */
+  char buffer[64];
+  if (key.size() + 4 <= sizeof(buffer)) {
+    char *p = buffer;
+    if (!first)
+      *p++ = ',';
+    *p++ = '"';
+    p = std::copy(key.begin(), key.end(), p);
+    *p++ = '"';
+    *p++ = ':';
+    os.Write(buffer, p - buffer);
+  } else {
+    if (!first)
+      os.Write(',');
+    os.Write('"');
+    os.Write(key.data(), key.size());
+    os.Write("\":");
+  }
+
+  first = false;
+  return os;
+}
+
+} // namespace Json
@@ -0,0 +1,169 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_JSON_WRITER_HXX
+#define XCSOAR_JSON_WRITER_HXX
+
+#include "io/BufferedOutputStream.hxx"
+
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+/*
+ * A streaming JSON writer which emits compact JSON directly into a
+ * #BufferedOutputStream, without building a document in memory.
+ * Unlike the Boost.JSON DOM, it does not allocate.
+ */
+namespace Json {
+
+/**
+ * Write a JSON string literal, escaping special characters.
+ */
+void
+WriteString(BufferedOutputStream &os, std::string_view s);
+
+void
+WriteValue(BufferedOutputStream &os, bool value);
+
+void
+WriteValue(BufferedOutputStream &os, int64_t value);
+
+void
+WriteValue(BufferedOutputStream &os, uint64_t value);
+
+/**
+ * Write a floating point number.  Since JSON cannot represent
+ * infinity and NaN, those are written as "null".
+ */
+void
+WriteValue(BufferedOutputStream &os, double value);
+
+inline void
+WriteValue(BufferedOutputStream &os, std::string_view value)
+{
+  WriteString(os, value);
+}
+
+inline void
+WriteValue(BufferedOutputStream &os, const char *value)
+{
+  WriteString(os, value);
+}
+
+template<typename T>
+std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>>
+WriteValue(BufferedOutputStream &os, T value)
+{
+  if constexpr (std::is_signed_v<T>)
+    WriteValue(os, int64_t(value));
+  else
+    WriteValue(os, uint64_t(value));
+}
+
+inline void
+WriteValue(BufferedOutputStream &os, float value)
+{
+  WriteValue(os, double(value));
+}
+
+/**
+ * Writes a JSON object member by member.  Keys are written
+ * verbatim; they must not contain characters which need escaping.
+ *
+ * The object must be closed explicitly with End().
+ */
+class ObjectWriter {
+  BufferedOutputStream &os;
+  bool first = true;
+
+public:
+  explicit ObjectWriter(BufferedOutputStream &_os)
+    :os(_os) {
+    os.Write('{');
+  }
+
+  ObjectWriter(const ObjectWriter &) = delete;
+  ObjectWriter &operator=(const ObjectWriter &) = delete;
+
+  /**
+   * Write the key of a member whose value will be written by the
+   * caller, e.g. a nested #ObjectWriter.
+   */
+  BufferedOutputStream &Key(std::string_view key);
+
+  template<typename T>
+  void Add(std::string_view key, T value) {
+    WriteValue(Key(key), value);
+  }
+
+  void AddNull(std::string_view key) {
+    Key(key).Write("null");
+  }
+
+  void End() {
+    os.Write('}');
+  }
+};
+
+/**
+ * Writes a JSON array element by element.  The array must be closed
+ * explicitly with End().
+ */
+class ArrayWriter {
+  BufferedOutputStream &os;
+  bool first = true;
+
+public:
+  explicit ArrayWriter(BufferedOutputStream &_os)
+    :os(_os) {
+    os.Write('[');
+  }
+
+  ArrayWriter(const ArrayWriter &) = delete;
+  ArrayWriter &operator=(const ArrayWriter &) = delete;
+
+  /**
+   * Prepare for writing the next element, which will be written by
+   * the caller, e.g. a nested #ObjectWriter.
+   */
+  BufferedOutputStream &Next() {
+    if (!first)
+      os.Write(',');
+    first = false;
+    return os;
+  }
+
+  template<typename T>
+  void Add(T value) {
+    WriteValue(Next(), value);
+  }
+
+  void End() {
+    os.Write(']');
+  }
+};
+
+} // namespace Json
+
+#endif
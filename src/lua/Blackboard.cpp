@@ -25,9 +25,22 @@ Copyright_License {
 #include "Geo.hpp"
 #include "MetaTable.hxx"
 #include "Util.hxx"
+#include "Class.hxx"
+#include "Value.hxx"
+#include "Error.hxx"
+#include "Catch.hpp"
+#include "Persistent.hpp"
 #include "util/StringAPI.hxx"
+#include "ui/event/Timer.hpp"
+#include "Blackboard/BlackboardListener.hpp"
 #include "Interface.hpp"
 
+extern "C" {
+#include <lauxlib.h>
+}
+
+#include <iterator>
+
 namespace Lua {
 
 template<typename V>
@@ -40,69 +53,336 @@ static void PushOptional(lua_State *L, bool available, V &&value) {
 
 }
 
-static int
-l_blackboard_index(lua_State *L)
-{
-  const auto &basic = CommonInterface::Basic();
+struct BlackboardField {
+  const char *name;
+  void (*push)(lua_State *L, const MoreData &basic);
+};
 
-  const char *name = lua_tostring(L, 2);
-  if (name == nullptr)
-    return 0;
-  else if (StringIsEqual(name, "location"))
+static constexpr BlackboardField blackboard_fields[] = {
+  {"location", [](lua_State *L, const MoreData &basic){
     Lua::PushOptional(L, basic.location_available, basic.location);
-  else if (StringIsEqual(name, "altitude"))
+  }},
+  {"altitude", [](lua_State *L, const MoreData &basic){
     Lua::PushOptional(L, basic.NavAltitudeAvailable(), basic.nav_altitude);
-  else if (StringIsEqual(name, "track"))
+  }},
+  {"track", [](lua_State *L, const MoreData &basic){
     Lua::PushOptional(L, basic.track_available, basic.track);
-  else if (StringIsEqual(name, "ground_speed"))
+  }},
+  {"ground_speed", [](lua_State *L, const MoreData &basic){
     Lua::PushOptional(L, basic.ground_speed_available, basic.ground_speed);
-  else if (StringIsEqual(name, "air_speed"))
+  }},
+  {"air_speed", [](lua_State *L, const MoreData &basic){
     Lua::PushOptional(L, basic.airspeed_available, basic.true_airspeed);
-  else if (StringIsEqual(name, "bank_angle"))
-    Lua::PushOptional(L, basic.attitude.IsBankAngleUseable(), basic.attitude.bank_angle);
-  else if (StringIsEqual(name, "pitch_angle"))
-    Lua::PushOptional(L, basic.attitude.IsPitchAngleUseable(), basic.attitude.pitch_angle); 
-  else if (StringIsEqual(name, "heading"))
-    Lua::PushOptional(L, basic.attitude.IsHeadingUseable(), basic.attitude.heading);
-  else if (StringIsEqual(name, "g_load"))
-    Lua::PushOptional(L, basic.acceleration.available, basic.acceleration.g_load);
-  else if (StringIsEqual(name, "static_pressure"))
-    Lua::PushOptional(L, basic.static_pressure_available, basic.static_pressure.GetPascal());
-  else if (StringIsEqual(name, "pitot_pressure"))
-    Lua::PushOptional(L, basic.pitot_pressure_available, basic.pitot_pressure.GetPascal());
-  else if (StringIsEqual(name, "dynamic_pressure"))
-    Lua::PushOptional(L, basic.dyn_pressure_available, basic.dyn_pressure.GetPascal());
-  else if (StringIsEqual(name, "temperature"))
+  }},
+  {"bank_angle", [](lua_State *L, const MoreData &basic){
+    Lua::PushOptional(L, basic.attitude.IsBankAngleUseable(),
+                      basic.attitude.bank_angle);
+  }},
+  {"pitch_angle", [](lua_State *L, const MoreData &basic){
+    Lua::PushOptional(L, basic.attitude.IsPitchAngleUseable(),
+                      basic.attitude.pitch_angle);
+  }},
+  {"heading", [](lua_State *L, const MoreData &basic){
+    Lua::PushOptional(L, basic.attitude.IsHeadingUseable(),
+                      basic.attitude.heading);
+  }},
+  {"g_load", [](lua_State *L, const MoreData &basic){
+    Lua::PushOptional(L, basic.acceleration.available,
+                      basic.acceleration.g_load);
+  }},
+  {"static_pressure", [](lua_State *L, const MoreData &basic){
+    Lua::PushOptional(L, basic.static_pressure_available,
+                      basic.static_pressure.GetPascal());
+  }},
+  {"pitot_pressure", [](lua_State *L, const MoreData &basic){
+    Lua::PushOptional(L, basic.pitot_pressure_available,
+                      basic.pitot_pressure.GetPascal());
+  }},
+  {"dynamic_pressure", [](lua_State *L, const MoreData &basic){
+    Lua::PushOptional(L, basic.dyn_pressure_available,
+                      basic.dyn_pressure.GetPascal());
+  }},
+  {"temperature", [](lua_State *L, const MoreData &basic){
     Lua::PushOptional(L, basic.temperature_available,
                       basic.temperature.ToKelvin());
-  else if (StringIsEqual(name, "humidity"))
+  }},
+  {"humidity", [](lua_State *L, const MoreData &basic){
     Lua::PushOptional(L, basic.humidity_available, basic.humidity);
-  else if (StringIsEqual(name, "voltage"))
+  }},
+  {"voltage", [](lua_State *L, const MoreData &basic){
     Lua::PushOptional(L, basic.voltage_available, basic.voltage);
-  else if (StringIsEqual(name, "battery_level"))
+  }},
+  {"battery_level", [](lua_State *L, const MoreData &basic){
     Lua::PushOptional(L, basic.battery_level_available, basic.battery_level);
-  else if (StringIsEqual(name, "noncomp_vario"))
+  }},
+  {"noncomp_vario", [](lua_State *L, const MoreData &basic){
     Lua::PushOptional(L, basic.noncomp_vario_available, basic.noncomp_vario);
-  else if (StringIsEqual(name, "total_energy_vario"))
-    Lua::PushOptional(L, basic.total_energy_vario_available, basic.total_energy_vario);
-  else if (StringIsEqual(name, "netto_vario"))
+  }},
+  {"total_energy_vario", [](lua_State *L, const MoreData &basic){
+    Lua::PushOptional(L, basic.total_energy_vario_available,
+                      basic.total_energy_vario);
+  }},
+  {"netto_vario", [](lua_State *L, const MoreData &basic){
     Lua::PushOptional(L, basic.netto_vario_available, basic.netto_vario);
-  else
+  }},
+};
+
+static int
+l_blackboard_index(lua_State *L)
+{
+  const char *name = lua_tostring(L, 2);
+  if (name == nullptr)
     return 0;
 
+  for (const auto &i : blackboard_fields) {
+    if (StringIsEqual(name, i.name)) {
+      i.push(L, CommonInterface::Basic());
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+/**
+ * Push a new table containing all #blackboard_fields.
+ */
+static void
+PushBlackboardTable(lua_State *L, const MoreData &basic)
+{
+  lua_createtable(L, 0, std::size(blackboard_fields));
+
+  for (const auto &i : blackboard_fields) {
+    i.push(L, basic);
+    lua_setfield(L, -2, i.name);
+  }
+}
+
+/**
+ * Caches the table returned by xcsoar.blackboard.snapshot() and
+ * invokes the functions registered with
+ * xcsoar.blackboard.subscribe().  There is at most one instance per
+ * Lua state; it is created by the first call to one of these and
+ * lives until lua_close().
+ */
+class LuaBlackboardListener final : public NullBlackboardListener {
+  lua_State *const L;
+
+  /**
+   * The cached snapshot table; nil if it needs to be rebuilt.
+   */
+  Lua::Value snapshot;
+
+  /**
+   * A table with the subscribed functions as keys.
+   */
+  Lua::Value subscribers;
+
+  unsigned n_subscribers = 0;
+
+  /**
+   * Invokes the subscribers after LiveBlackboard has finished
+   * calling its listeners, because they may not be modified from
+   * within that loop.
+   */
+  UI::Timer notify_timer{[this]{ OnNotify(); }};
+
+public:
+  static constexpr const char *registry_key = "xcsoar.blackboard.listener";
+
+  explicit LuaBlackboardListener(lua_State *_L) noexcept
+    :L(_L), snapshot(L), subscribers(L) {
+    const Lua::ScopeCheckStack check_stack(L);
+
+    lua_newtable(L);
+    subscribers.Set(Lua::RelativeStackIndex{-1});
+    lua_pop(L, 1);
+
+    CommonInterface::AddListener(*this);
+  }
+
+  ~LuaBlackboardListener() noexcept {
+    CommonInterface::RemoveListener(*this);
+  }
+
+  /**
+   * Push the snapshot table, and build it if the blackboard has
+   * been updated since the last call.
+   */
+  void PushSnapshot() noexcept {
+    const Lua::ScopeCheckStack check_stack(L, 1);
+
+    snapshot.Push();
+    if (!lua_isnil(L, -1))
+      return;
+
+    lua_pop(L, 1);
+    PushBlackboardTable(L, CommonInterface::Basic());
+    snapshot.Set(Lua::RelativeStackIndex{-1});
+  }
+
+  void Subscribe(int callback_idx) noexcept {
+    if (SetSubscriber(callback_idx, true) && n_subscribers++ == 0)
+      Lua::AddPersistent(L, this);
+  }
+
+  void Unsubscribe(int callback_idx) noexcept {
+    if (SetSubscriber(callback_idx, false) && --n_subscribers == 0) {
+      notify_timer.Cancel();
+      Lua::RemovePersistent(L, this);
+    }
+  }
+
+private:
+  /**
+   * Add or remove a function in the #subscribers table.
+   *
+   * @return true if the table was modified
+   */
+  bool SetSubscriber(int callback_idx, bool value) noexcept {
+    const Lua::ScopeCheckStack check_stack(L);
+
+    subscribers.Push();
+    lua_pushvalue(L, callback_idx);
+    lua_rawget(L, -2);
+    const bool modified = lua_isnil(L, -1) == value;
+    lua_pop(L, 1);
+
+    if (modified) {
+      lua_pushvalue(L, callback_idx);
+      if (value)
+        lua_pushboolean(L, true);
+      else
+        lua_pushnil(L);
+      lua_rawset(L, -3);
+    }
+
+    lua_pop(L, 1); // pop subscribers
+    return modified;
+  }
+
+  void OnNotify() noexcept {
+    {
+      const Lua::ScopeCheckStack check_stack(L);
+
+      /* copy the subscribers to an array, because the callbacks may
+         subscribe or unsubscribe */
+      lua_createtable(L, n_subscribers, 0);
+      subscribers.Push();
+      int n = 0;
+      lua_pushnil(L);
+      while (lua_next(L, -2)) {
+        lua_pop(L, 1); // pop value
+        lua_pushvalue(L, -1);
+        lua_rawseti(L, -4, ++n);
+      }
+      lua_pop(L, 1); // pop subscribers
+
+      PushSnapshot();
+
+      for (int i = 1; i <= n; ++i) {
+        lua_rawgeti(L, -2, i);
+        lua_pushvalue(L, -2);
+        if (lua_pcall(L, 1, 0, 0))
+          Lua::ThrowError(L, Lua::PopError(L));
+      }
+
+      lua_pop(L, 2); // pop snapshot and array
+    }
+
+    /* this may close the Lua state and delete this object */
+    Lua::CheckPersistent(L);
+  }
+
+  /* virtual methods from class BlackboardListener */
+  void OnGPSUpdate(const MoreData &) override {
+    snapshot.Set(nullptr);
+  }
+
+  void OnCalculatedUpdate(const MoreData &,
+                          const DerivedInfo &) override {
+    snapshot.Set(nullptr);
+
+    if (n_subscribers > 0)
+      notify_timer.Schedule({});
+  }
+};
+
+static constexpr char lua_blackboard_listener_class[] =
+  "xcsoar.blackboard_listener";
+using LuaBlackboardListenerClass =
+  Lua::Class<LuaBlackboardListener, lua_blackboard_listener_class>;
+
+static LuaBlackboardListener &
+GetBlackboardListener(lua_State *L)
+{
+  auto *listener = (LuaBlackboardListener *)
+    Lua::GetRegistryLightUserData(L, LuaBlackboardListener::registry_key);
+  if (listener == nullptr) {
+    /* the registry owns the new instance */
+    listener = LuaBlackboardListenerClass::New(L, L);
+    Lua::SetRegistry(L, LuaBlackboardListener::registry_key,
+                     Lua::RelativeStackIndex{-1});
+    lua_pop(L, 1);
+  }
+
+  return *listener;
+}
+
+static int
+l_blackboard_snapshot(lua_State *L)
+{
+  if (lua_gettop(L) != 0)
+    return luaL_error(L, "Invalid parameters");
+
+  GetBlackboardListener(L).PushSnapshot();
   return 1;
 }
 
+static int
+l_blackboard_subscribe(lua_State *L)
+{
+  if (lua_gettop(L) != 1)
+    return luaL_error(L, "Invalid parameters");
+
+  luaL_checktype(L, 1, LUA_TFUNCTION);
+
+  GetBlackboardListener(L).Subscribe(1);
+  return 0;
+}
+
+static int
+l_blackboard_unsubscribe(lua_State *L)
+{
+  if (lua_gettop(L) != 1)
+    return luaL_error(L, "Invalid parameters");
+
+  luaL_checktype(L, 1, LUA_TFUNCTION);
+
+  GetBlackboardListener(L).Unsubscribe(1);
+  return 0;
+}
+
+static constexpr struct luaL_Reg blackboard_funcs[] = {
+  {"snapshot", l_blackboard_snapshot},
+  {"subscribe", l_blackboard_subscribe},
+  {"unsubscribe", l_blackboard_unsubscribe},
+  {nullptr, nullptr}
+};
+
 void
 Lua::InitBlackboard(lua_State *L)
 {
   lua_getglobal(L, "xcsoar");
 
-  lua_newtable(L);
+  luaL_newlib(L, blackboard_funcs);
 
   MakeIndexMetaTableFor(L, RelativeStackIndex{-1}, l_blackboard_index);
 
   lua_setfield(L, -2, "blackboard");
 
   lua_pop(L, 1);
+
+  LuaBlackboardListenerClass::Register(L);
+  lua_pop(L, 1);
 }
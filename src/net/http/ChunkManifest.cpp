@@ -0,0 +1,94 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "ChunkManifest.hpp"
+#include "io/LineReader.hpp"
+#include "util/HexString.hpp"
+#include "util/NumberParser.hpp"
+#include "util/StringAPI.hxx"
+#include "util/StringStrip.hxx"
+
+#include <string.h>
+
+namespace Net {
+
+/**
+ * Splits a line of the form `name = value`.
+ *
+ * @return a pointer to the value, or nullptr if the line is malformed
+ */
+static const char *
+ParseLine(char *line) noexcept
+{
+  char *separator = strchr(line, '=');
+  if (separator == nullptr)
+    return nullptr;
+
+  char *p = StripRight(line, separator);
+  if (p == line)
+    return nullptr;
+
+  *p = 0;
+
+  char *value = const_cast<char *>(StripLeft(separator + 1));
+  StripRight(value);
+  return value;
+}
+
+bool
+ParseChunkManifest(ChunkManifest &manifest, NLineReader &reader)
+{
+  manifest = {};
+
+  char *line;
+  while ((line = reader.ReadLine()) != nullptr) {
+    line = const_cast<char *>(StripLeft(line));
+    if (*line == 0 || *line == '#')
+      continue;
+
+    const char *name = line, *value = ParseLine(line);
+    if (value == nullptr)
+      return false;
+
+    char *endptr;
+    if (StringIsEqual(name, "size")) {
+      manifest.size = ParseUint64(value, &endptr);
+      if (endptr == value || *endptr != 0)
+        return false;
+    } else if (StringIsEqual(name, "chunk_size")) {
+      manifest.chunk_size = ParseUnsigned(value, &endptr);
+      if (endptr == value || *endptr != 0)
+        return false;
+    } else if (StringIsEqual(name, "chunk")) {
+      try {
+        manifest.chunks.push_back(ParseHexString<32>(std::string_view(value)));
+      } catch (const std::invalid_argument &) {
+        return false;
+      }
+    }
+  }
+
+  return manifest.IsValid();
+}
+
+} // namespace Net
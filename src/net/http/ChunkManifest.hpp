@@ -0,0 +1,93 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class NLineReader;
+
+namespace Net {
+
+/**
+ * Describes a file as a sequence of fixed-size chunks, each
+ * identified by the SHA256 digest of its contents.  A server can
+ * publish this next to a large file; a client which has an older
+ * version of the file then needs to download only the chunks which
+ * it does not have already (see CoDownloadDelta()).
+ *
+ * The text format consists of "name = value" lines:
+ *
+ *     size = 123456789
+ *     chunk_size = 1048576
+ *     chunk = 9f86d081884c7d659a2feaa0c55ad015a3bf4f1b2b0b822cd15d6c15b0f00a08
+ *     chunk = ...
+ *
+ * There is one "chunk" line per chunk, in file order; all chunks
+ * except for the last one have exactly "chunk_size" bytes.
+ */
+struct ChunkManifest {
+  /**
+   * Larger chunks are rejected, because a whole chunk is kept in
+   * memory while it is being processed.
+   */
+  static constexpr uint32_t MAX_CHUNK_SIZE = 64 * 1024 * 1024;
+
+  uint64_t size = 0;
+  uint32_t chunk_size = 0;
+
+  std::vector<std::array<std::byte, 32>> chunks;
+
+  /**
+   * Is the chunk size acceptable, and is the number of chunks
+   * consistent with the file size?
+   */
+  bool IsValid() const noexcept {
+    return chunk_size > 0 && chunk_size <= MAX_CHUNK_SIZE &&
+      chunks.size() == (size + chunk_size - 1) / chunk_size;
+  }
+
+  uint64_t GetChunkOffset(std::size_t i) const noexcept {
+    return uint64_t(i) * chunk_size;
+  }
+
+  std::size_t GetChunkSize(std::size_t i) const noexcept {
+    const uint64_t offset = GetChunkOffset(i);
+    return size - offset < chunk_size
+      ? std::size_t(size - offset)
+      : std::size_t(chunk_size);
+  }
+};
+
+/**
+ * Parse a chunk manifest.
+ *
+ * @return false on error (malformed or inconsistent manifest)
+ */
+bool
+ParseChunkManifest(ChunkManifest &manifest, NLineReader &reader);
+
+} // namespace Net
@@ -0,0 +1,276 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "CoDownloadDelta.hpp"
+#include "ChunkManifest.hpp"
+#include "Setup.hxx"
+#include "CoRequest.hxx"
+#include "Operation/ProgressListener.hpp"
+#include "io/FileReader.hxx"
+#include "io/FileOutputStream.hxx"
+#include "io/MemoryReader.hxx"
+#include "io/BufferedLineReader.hpp"
+#include "Crypto/SHA256.hxx"
+#include "Crypto/DigestOutputStream.hxx"
+
+#include <deque>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <cassert>
+#include <cinttypes>
+#include <stdio.h>
+
+namespace Net {
+
+/**
+ * The maximum number of range requests running at the same time.
+ */
+static constexpr std::size_t MAX_PARALLEL_REQUESTS = 4;
+
+/**
+ * Adjacent missing chunks are merged into one range request up to
+ * this size.
+ */
+static constexpr uint64_t MAX_RANGE_SIZE = 4 * 1024 * 1024;
+
+/**
+ * A contiguous sequence of chunks which is not available in the old
+ * file.
+ */
+struct MissingRange {
+  std::size_t first_chunk, n_chunks;
+  uint64_t offset, size;
+};
+
+static Co::EagerTask<std::string>
+CoGet(CurlGlobal &curl, const char *url)
+{
+  CurlEasy easy{url};
+  Curl::Setup(easy);
+  easy.SetFailOnError();
+
+  auto response = co_await Curl::CoRequest(curl, std::move(easy));
+  co_return std::move(response.body);
+}
+
+static Co::EagerTask<std::string>
+CoGetRange(CurlGlobal &curl, const char *url, uint64_t offset, uint64_t size)
+{
+  assert(size > 0);
+
+  CurlEasy easy{url};
+  Curl::Setup(easy);
+  easy.SetFailOnError();
+
+  char range[64];
+  snprintf(range, sizeof(range), "%" PRIu64 "-%" PRIu64,
+           offset, offset + size - 1);
+  easy.SetOption(CURLOPT_RANGE, range);
+
+  auto response = co_await Curl::CoRequest(curl, std::move(easy));
+
+  /* a server which ignores the "Range" header replies "200 OK"
+     with the whole file */
+  if (response.status != 206 || response.body.size() != size)
+    throw std::runtime_error("Server does not support range requests");
+
+  co_return std::move(response.body);
+}
+
+/**
+ * Read as many bytes as possible, i.e. until the buffer is full or
+ * the end of the file has been reached.
+ */
+static std::size_t
+ReadFull(FileReader &reader, std::byte *data, std::size_t size)
+{
+  std::size_t total = 0;
+  while (total < size) {
+    std::size_t nbytes = reader.Read(data + total, size - total);
+    if (nbytes == 0)
+      break;
+
+    total += nbytes;
+  }
+
+  return total;
+}
+
+static ChunkManifest
+ParseManifest(const std::string &body)
+{
+  MemoryReader reader({(const std::byte *)body.data(), body.size()});
+  BufferedLineReader line_reader(reader);
+
+  ChunkManifest manifest;
+  if (!ParseChunkManifest(manifest, line_reader))
+    throw std::runtime_error("Malformed chunk manifest");
+
+  return manifest;
+}
+
+/**
+ * Calculate the digest of each chunk of the old file.
+ *
+ * @return a map from digest to file offset
+ */
+static std::map<SHA256Digest, uint64_t>
+IndexChunks(FileReader &file, std::size_t chunk_size,
+            std::vector<std::byte> &buffer)
+{
+  std::map<SHA256Digest, uint64_t> chunks;
+
+  uint64_t offset = 0;
+  while (true) {
+    const std::size_t nbytes = ReadFull(file, buffer.data(), chunk_size);
+    if (nbytes == 0)
+      break;
+
+    SHA256State state;
+    state.Update({buffer.data(), nbytes});
+    chunks.emplace(state.Final(), offset);
+
+    if (nbytes < chunk_size)
+      break;
+
+    offset += nbytes;
+  }
+
+  return chunks;
+}
+
+Co::Task<void>
+CoDownloadDelta(CurlGlobal &curl, const char *url, const char *manifest_url,
+                Path old_path, Path path,
+                const std::array<std::byte, 32> *sha256,
+                ProgressListener &progress)
+{
+  assert(url != nullptr);
+  assert(manifest_url != nullptr);
+  assert(old_path != nullptr);
+  assert(path != nullptr);
+
+  const auto manifest = ParseManifest(co_await CoGet(curl, manifest_url));
+  const std::size_t n_chunks = manifest.chunks.size();
+
+  std::vector<std::byte> buffer(manifest.chunk_size);
+
+  FileReader old_file(old_path);
+  const auto old_chunks = IndexChunks(old_file, manifest.chunk_size, buffer);
+
+  /* for each chunk, find its offset in the old file (or -1 if it
+     must be downloaded), and merge the missing ones into ranges */
+  std::vector<int64_t> old_offsets(n_chunks, -1);
+  std::vector<MissingRange> missing;
+  uint64_t download_size = 0;
+
+  for (std::size_t i = 0; i < n_chunks; ++i) {
+    if (auto j = old_chunks.find(manifest.chunks[i]); j != old_chunks.end()) {
+      old_offsets[i] = j->second;
+      continue;
+    }
+
+    const uint64_t size = manifest.GetChunkSize(i);
+    download_size += size;
+
+    if (!missing.empty() &&
+        missing.back().first_chunk + missing.back().n_chunks == i &&
+        missing.back().size + size <= MAX_RANGE_SIZE) {
+      ++missing.back().n_chunks;
+      missing.back().size += size;
+    } else
+      missing.push_back({i, 1, manifest.GetChunkOffset(i), size});
+  }
+
+  progress.SetProgressRange(download_size);
+
+  FileOutputStream file(path);
+  DigestOutputStream<SHA256State> digest(file);
+
+  /* the range requests which are currently running, in file
+     order; up to #MAX_PARALLEL_REQUESTS are kept in flight while
+     the file is being written sequentially */
+  std::deque<Co::EagerTask<std::string>> pending;
+  std::size_t next_request = 0;
+
+  uint64_t downloaded = 0;
+
+  std::size_t next_missing = 0;
+  for (std::size_t i = 0; i < n_chunks;) {
+    while (pending.size() < MAX_PARALLEL_REQUESTS &&
+           next_request < missing.size()) {
+      const auto &r = missing[next_request++];
+      pending.push_back(CoGetRange(curl, url, r.offset, r.size));
+    }
+
+    if (old_offsets[i] >= 0) {
+      /* copy this chunk from the old file */
+      const std::size_t size = manifest.GetChunkSize(i);
+      old_file.Seek(old_offsets[i]);
+      if (ReadFull(old_file, buffer.data(), size) != size)
+        throw std::runtime_error("Old file is truncated");
+
+      digest.Write(buffer.data(), size);
+      ++i;
+      continue;
+    }
+
+    assert(next_missing < missing.size());
+    const auto &r = missing[next_missing++];
+    assert(r.first_chunk == i);
+
+    assert(!pending.empty());
+    const std::string data = co_await pending.front();
+    pending.pop_front();
+
+    /* verify each chunk before writing it */
+    const std::byte *p = (const std::byte *)data.data();
+    for (std::size_t j = 0; j < r.n_chunks; ++j) {
+      const std::size_t size = manifest.GetChunkSize(i + j);
+
+      SHA256State state;
+      state.Update({p, size});
+      if (state.Final() != manifest.chunks[i + j])
+        throw std::runtime_error("Chunk checksum mismatch");
+
+      p += size;
+    }
+
+    digest.Write(data.data(), data.size());
+
+    downloaded += data.size();
+    progress.SetProgressPosition(downloaded);
+
+    i += r.n_chunks;
+  }
+
+  if (sha256 != nullptr && digest.Final() != *sha256)
+    throw std::runtime_error("Checksum mismatch");
+
+  file.Commit();
+}
+
+} // namespace Net
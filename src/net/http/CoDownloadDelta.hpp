@@ -0,0 +1,61 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#pragma once
+
+#include "co/Task.hxx"
+#include "system/Path.hpp"
+
+#include <array>
+#include <cstddef> // for std::byte
+
+class CurlGlobal;
+class ProgressListener;
+
+namespace Net {
+
+/**
+ * Download a new version of a file, reusing the parts of an old
+ * version which are still valid.  The chunk manifest (see
+ * #ChunkManifest) at #manifest_url describes the new version.  Chunks
+ * whose digest is found in the old file are copied from there, and
+ * all others are downloaded from #url with HTTP range requests,
+ * several of them in parallel.  Each downloaded chunk is verified
+ * against the manifest.
+ *
+ * Throws on error, e.g. if the server does not support range
+ * requests; the caller may then fall back to CoDownloadToFile().
+ *
+ * @param old_path the existing (old) version of the file
+ * @param path the file to be written; must not be #old_path
+ * @param sha256 if not nullptr, then this is the expected SHA256
+ * digest of the new file, which is verified while it is being
+ * written
+ */
+Co::Task<void>
+CoDownloadDelta(CurlGlobal &curl, const char *url, const char *manifest_url,
+                Path old_path, Path path,
+                const std::array<std::byte, 32> *sha256,
+                ProgressListener &progress);
+
+} // namespace Net
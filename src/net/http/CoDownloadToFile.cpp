@@ -26,6 +26,7 @@ Copyright_License {
 #include "Progress.hpp"
 #include "CoStreamRequest.hxx"
 #include "io/FileOutputStream.hxx"
+#include "system/FileUtil.hpp"
 #include "Crypto/SHA256.hxx"
 #include "Crypto/DigestOutputStream.hxx"
 
@@ -34,6 +35,15 @@ Copyright_License {
 
 namespace Net {
 
+static void
+SetCredentials(CurlEasy &easy, const char *username, const char *password)
+{
+  if (username != nullptr)
+    easy.SetOption(CURLOPT_USERNAME, username);
+  if (password != nullptr)
+    easy.SetOption(CURLOPT_PASSWORD, password);
+}
+
 Co::EagerTask<Curl::CoResponse>
 CoDownloadToFile(CurlGlobal &curl, const char *url,
                  const char *username, const char *password,
@@ -54,11 +64,7 @@ CoDownloadToFile(CurlGlobal &curl, const char *url,
   Curl::Setup(easy);
   const Net::ProgressAdapter progress_adapter{easy, progress};
   easy.SetFailOnError();
-
-  if (username != nullptr)
-    easy.SetOption(CURLOPT_USERNAME, username);
-  if (password != nullptr)
-    easy.SetOption(CURLOPT_PASSWORD, password);
+  SetCredentials(easy, username, password);
 
   auto response = co_await Curl::CoStreamRequest(curl, std::move(easy), *os);
   file.Commit();
@@ -69,4 +75,42 @@ CoDownloadToFile(CurlGlobal &curl, const char *url,
   co_return response;
 }
 
+Co::EagerTask<bool>
+CoDownloadToFileIfModified(CurlGlobal &curl, const char *url,
+                           const char *username, const char *password,
+                           Path path, ProgressListener &progress)
+{
+  assert(url != nullptr);
+  assert(path != nullptr);
+
+  const auto last_modification = File::GetLastModification(path);
+  const bool conditional =
+    last_modification != std::chrono::system_clock::time_point{};
+
+  FileOutputStream file(path);
+
+  CurlEasy easy{url};
+  Curl::Setup(easy);
+  const Net::ProgressAdapter progress_adapter{easy, progress};
+  easy.SetFailOnError();
+  SetCredentials(easy, username, password);
+
+  if (conditional) {
+    easy.SetOption(CURLOPT_TIMECONDITION, long(CURL_TIMECOND_IFMODSINCE));
+    easy.SetOption(CURLOPT_TIMEVALUE,
+                   long(std::chrono::system_clock::to_time_t(last_modification)));
+  }
+
+  co_await Curl::CoStreamRequest(curl, std::move(easy), file);
+
+  if (conditional && file.Tell() == 0) {
+    /* not modified: discard the empty temporary file */
+    file.Cancel();
+    co_return false;
+  }
+
+  file.Commit();
+  co_return true;
+}
+
 } // namespace Net
@@ -45,4 +45,21 @@ CoDownloadToFile(CurlGlobal &curl, const char *url,
                  Path path, std::array<std::byte, 32> *sha256,
                  ProgressListener &progress);
 
+/**
+ * Like CoDownloadToFile(), but if the file exists already, ask the
+ * server to send it only if it has been modified since the file's
+ * modification time ("If-Modified-Since" for HTTP, "MDTM" for FTP).
+ * An empty response to such a request is treated as "not modified",
+ * and the existing file is kept.
+ *
+ * Throws on error.
+ *
+ * @return true if the file has been (re)written, false if the
+ * existing file is still up to date
+ */
+Co::EagerTask<bool>
+CoDownloadToFileIfModified(CurlGlobal &curl, const char *url,
+                           const char *username, const char *password,
+                           Path path, ProgressListener &progress);
+
 } // namespace Net
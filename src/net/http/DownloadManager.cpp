@@ -94,7 +94,9 @@ Net::DownloadManager::Enumerate(DownloadListener &listener) noexcept
 }
 
 void
-Net::DownloadManager::Enqueue(const char *uri, Path relative_path) noexcept
+Net::DownloadManager::Enqueue(const char *uri, Path relative_path,
+                              const std::array<std::byte, 32> *,
+                              const char *) noexcept
 {
   assert(download_manager != nullptr);
 
@@ -114,15 +116,19 @@ Net::DownloadManager::Cancel(Path relative_path) noexcept
 #include "Global.hxx"
 #include "Init.hpp"
 #include "CoDownloadToFile.hpp"
+#include "CoDownloadDelta.hpp"
 #include "Operation/ProgressListener.hpp"
 #include "LocalPath.hpp"
 #include "thread/Mutex.hxx"
 #include "co/InjectTask.hxx"
 #include "io/FileTransaction.hpp"
+#include "system/FileUtil.hpp"
 
 #include <string>
 #include <list>
 #include <algorithm>
+#include <optional>
+#include <stdexcept>
 
 #include <string.h>
 
@@ -132,12 +138,28 @@ class DownloadManagerThread final
     std::string uri;
     AllocatedPath path_relative;
 
+    /**
+     * The expected SHA256 digest of the file, if known.
+     */
+    std::optional<std::array<std::byte, 32>> sha256;
+
+    /**
+     * The URI of the chunk manifest; empty if there is none.
+     */
+    std::string chunks_uri;
+
     Item(const Item &other) = delete;
 
     Item(Item &&other) noexcept = default;
 
-    Item(const char *_uri, Path _path_relative) noexcept
-      :uri(_uri), path_relative(_path_relative) {}
+    Item(const char *_uri, Path _path_relative,
+         const std::array<std::byte, 32> *_sha256,
+         const char *_chunks_uri) noexcept
+      :uri(_uri), path_relative(_path_relative),
+       chunks_uri(_chunks_uri != nullptr ? _chunks_uri : "") {
+      if (_sha256 != nullptr)
+        sha256 = *_sha256;
+    }
 
     Item &operator=(const Item &other) = delete;
 
@@ -193,8 +215,10 @@ public:
     }
   }
 
-  void Enqueue(const char *uri, Path path_relative) noexcept {
-    queue.emplace_back(uri, path_relative);
+  void Enqueue(const char *uri, Path path_relative,
+               const std::array<std::byte, 32> *sha256,
+               const char *chunks_uri) noexcept {
+    queue.emplace_back(uri, path_relative, sha256, chunks_uri);
 
     for (auto *listener : listeners)
       listener->OnDownloadAdded(path_relative, -1, -1);
@@ -245,14 +269,42 @@ private:
 static Co::InvokeTask
 DownloadToFileTransaction(CurlGlobal &curl,
                           const char *url, AllocatedPath path,
-                          std::array<std::byte, 32> *sha256,
+                          std::optional<std::array<std::byte, 32>> expected_sha256,
+                          std::string chunks_uri,
                           ProgressListener &progress)
 {
   FileTransaction transaction(path);
+
+  if (!chunks_uri.empty() && File::Exists(path)) {
+    /* try to update the existing file incrementally */
+    bool success = false;
+
+    try {
+      co_await Net::CoDownloadDelta(curl, url, chunks_uri.c_str(),
+                                    path, transaction.GetTemporaryPath(),
+                                    expected_sha256 ? &*expected_sha256 : nullptr,
+                                    progress);
+      success = true;
+    } catch (...) {
+      LogError(std::current_exception(),
+               "Incremental download failed, downloading the whole file");
+    }
+
+    if (success) {
+      transaction.Commit();
+      co_return;
+    }
+  }
+
+  std::array<std::byte, 32> sha256;
   const auto ignored_response = co_await
     Net::CoDownloadToFile(curl, url, nullptr, nullptr,
                           transaction.GetTemporaryPath(),
-                          sha256, progress);
+                          expected_sha256 ? &sha256 : nullptr, progress);
+
+  if (expected_sha256 && sha256 != *expected_sha256)
+    throw std::runtime_error("Checksum mismatch");
+
   transaction.Commit();
 }
 
@@ -269,7 +321,8 @@ DownloadManagerThread::Start() noexcept
 
   task.Start(DownloadToFileTransaction(*Net::curl, item.uri.c_str(),
                                        LocalPath(item.path_relative.c_str()),
-                                       nullptr, *this),
+                                       item.sha256, item.chunks_uri,
+                                       *this),
              BIND_THIS_METHOD(OnCompletion));
 }
 
@@ -354,11 +407,13 @@ Net::DownloadManager::Enumerate(DownloadListener &listener) noexcept
 }
 
 void
-Net::DownloadManager::Enqueue(const char *uri, Path relative_path) noexcept
+Net::DownloadManager::Enqueue(const char *uri, Path relative_path,
+                              const std::array<std::byte, 32> *sha256,
+                              const char *chunks_uri) noexcept
 {
   assert(thread != nullptr);
 
-  thread->Enqueue(uri, relative_path);
+  thread->Enqueue(uri, relative_path, sha256, chunks_uri);
 }
 
 void
@@ -26,6 +26,8 @@ Copyright_License {
 
 #include "Features.hpp"
 
+#include <array>
+#include <cstddef> // for std::byte
 #include <cstdint>
 #include <exception>
 
@@ -80,7 +82,17 @@ void RemoveListener(DownloadListener &listener) noexcept;
  */
 void Enumerate(DownloadListener &listener) noexcept;
 
-void Enqueue(const char *uri, Path relative_path) noexcept;
+/**
+ * @param sha256 if not nullptr, then this is the expected SHA256
+ * digest of the file; the download fails if it does not match
+ * @param chunks_uri if not nullptr, then this is the URI of a chunk
+ * manifest (see #ChunkManifest) which allows updating an existing
+ * file by downloading only the chunks which have changed; this is
+ * ignored by the Android implementation
+ */
+void Enqueue(const char *uri, Path relative_path,
+             const std::array<std::byte, 32> *sha256=nullptr,
+             const char *chunks_uri=nullptr) noexcept;
 
 /**
  * Cancel the download.  The download may however be already
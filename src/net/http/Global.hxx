@@ -54,6 +54,11 @@ public:
 		return timeout_event.GetEventLoop();
 	}
 
+	template<typename T>
+	void SetOption(CURLMoption option, T value) {
+		multi.SetOption(option, value);
+	}
+
 	void Add(CurlRequest &r);
 	void Remove(CurlRequest &r) noexcept;
 
@@ -34,6 +34,11 @@ Net::Initialise(EventLoop &event_loop)
   curl_global_init(CURL_GLOBAL_WIN32);
 
   curl = new CurlGlobal(event_loop);
+
+  /* parallel requests to the same server (e.g. a batch of METAR
+     downloads) are queued by CURL and reuse these connections,
+     instead of opening one connection per request */
+  curl->SetOption(CURLMOPT_MAX_HOST_CONNECTIONS, 4L);
 }
 
 void
@@ -38,7 +38,7 @@ Copyright_License {
 #include <fileapi.h>
 #endif
 
-FileMapping::FileMapping(Path path)
+FileMapping::FileMapping(Path path, [[maybe_unused]] bool will_need)
 {
 #ifdef HAVE_POSIX
   auto fd = OpenReadOnly(path.c_str());
@@ -58,10 +58,13 @@ FileMapping::FileMapping(Path path)
   m_size = (size_t)st.st_size;
 
   m_data = mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd.Get(), 0);
-  if (m_data == nullptr)
+  if (m_data == MAP_FAILED) {
+    m_data = nullptr;
     throw FormatErrno("Failed to map %s", path.c_str());
+  }
 
-  madvise(m_data, m_size, MADV_WILLNEED);
+  if (will_need)
+    madvise(m_data, m_size, MADV_WILLNEED);
 #else /* !HAVE_POSIX */
   hFile = ::CreateFile(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
                        nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
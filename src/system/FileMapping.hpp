@@ -46,8 +46,12 @@ class FileMapping {
 public:
   /**
    * Throws on error.
+   *
+   * @param will_need announce to the kernel that the whole file will
+   * be accessed soon, to start reading it ahead; pass false for large
+   * files of which only small portions will be used
    */
-  FileMapping(Path path);
+  FileMapping(Path path, bool will_need=true);
 
   ~FileMapping() noexcept;
 
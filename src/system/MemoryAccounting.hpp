@@ -0,0 +1,204 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_SYSTEM_MEMORY_ACCOUNTING_HPP
+#define XCSOAR_SYSTEM_MEMORY_ACCOUNTING_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Counters for the memory owned by the big subsystems, to find out
+ * where the memory goes on devices with little RAM.  They are only
+ * compiled with the macro MEMORY_ACCOUNTING (MEMORY_ACCOUNTING=y on
+ * the make command line); without it, everything in this namespace
+ * is a no-op.
+ *
+ * The counters are a static registry of relaxed atomics, so they may
+ * be updated and read from any thread.  Subsystems do not count each
+ * allocation; they report their size at coarse points, usually with
+ * a #Reporter.
+ */
+namespace MemoryAccounting {
+
+enum class Account : uint8_t {
+  /** terrain tiles and the overview */
+  TERRAIN,
+
+  /** loaded topography shapes */
+  TOPOGRAPHY,
+
+  /** points of all #Trace instances */
+  TRACE,
+
+  /** airspace objects */
+  AIRSPACE,
+
+  /** waypoints in a #Waypoints container */
+  WAYPOINT,
+
+  /** rendered text bitmaps */
+  TEXT_CACHE,
+
+  COUNT
+};
+
+static constexpr unsigned N_ACCOUNTS = unsigned(Account::COUNT);
+
+struct Usage {
+  std::size_t bytes, objects;
+};
+
+#ifdef MEMORY_ACCOUNTING
+
+static constexpr bool enabled = true;
+
+struct Counter {
+  std::atomic<std::size_t> bytes{0}, objects{0};
+};
+
+inline std::array<Counter, N_ACCOUNTS> counters;
+
+/**
+ * The number of allocations done by the current thread.  It is
+ * incremented by the operator new replacement in AllocationHook.cpp,
+ * which is only linked into the main program.
+ */
+inline thread_local std::size_t thread_allocations = 0;
+
+#else
+
+static constexpr bool enabled = false;
+
+#endif
+
+inline void
+Add([[maybe_unused]] Account account, [[maybe_unused]] std::size_t bytes,
+    [[maybe_unused]] std::size_t objects=1) noexcept
+{
+#ifdef MEMORY_ACCOUNTING
+  auto &c = counters[unsigned(account)];
+  c.bytes.fetch_add(bytes, std::memory_order_relaxed);
+  c.objects.fetch_add(objects, std::memory_order_relaxed);
+#endif
+}
+
+inline void
+Remove([[maybe_unused]] Account account, [[maybe_unused]] std::size_t bytes,
+       [[maybe_unused]] std::size_t objects=1) noexcept
+{
+#ifdef MEMORY_ACCOUNTING
+  auto &c = counters[unsigned(account)];
+  c.bytes.fetch_sub(bytes, std::memory_order_relaxed);
+  c.objects.fetch_sub(objects, std::memory_order_relaxed);
+#endif
+}
+
+inline Usage
+Get([[maybe_unused]] Account account) noexcept
+{
+#ifdef MEMORY_ACCOUNTING
+  const auto &c = counters[unsigned(account)];
+  return {
+    c.bytes.load(std::memory_order_relaxed),
+    c.objects.load(std::memory_order_relaxed),
+  };
+#else
+  return {0, 0};
+#endif
+}
+
+/**
+ * Returns the number of allocations done by the current thread so
+ * far.  Call it before and after a piece of code to count its
+ * allocations.  Always zero unless the allocation hook is linked.
+ */
+inline std::size_t
+GetThreadAllocations() noexcept
+{
+#ifdef MEMORY_ACCOUNTING
+  return thread_allocations;
+#else
+  return 0;
+#endif
+}
+
+/**
+ * The amount of memory reported by one object.  Call Update()
+ * whenever its size has changed noticeably; the destructor removes
+ * it from the account.  A copy starts with nothing reported, and a
+ * move transfers the report.
+ */
+class Reporter {
+#ifdef MEMORY_ACCOUNTING
+  Account account;
+  std::size_t bytes = 0, objects = 0;
+#endif
+
+public:
+  explicit constexpr Reporter([[maybe_unused]] Account _account) noexcept
+#ifdef MEMORY_ACCOUNTING
+    :account(_account)
+#endif
+  {}
+
+#ifdef MEMORY_ACCOUNTING
+  Reporter(const Reporter &src) noexcept
+    :account(src.account) {}
+
+  Reporter(Reporter &&src) noexcept
+    :account(src.account), bytes(src.bytes), objects(src.objects) {
+    src.bytes = src.objects = 0;
+  }
+
+  ~Reporter() noexcept {
+    Remove(account, bytes, objects);
+  }
+
+  Reporter &operator=(const Reporter &) noexcept {
+    return *this;
+  }
+
+  Reporter &operator=(Reporter &&src) noexcept {
+    Update(src.bytes, src.objects);
+    src.Update(0, 0);
+    return *this;
+  }
+#endif
+
+  void Update([[maybe_unused]] std::size_t _bytes,
+              [[maybe_unused]] std::size_t _objects=1) noexcept {
+#ifdef MEMORY_ACCOUNTING
+    Add(account, _bytes, _objects);
+    Remove(account, bytes, objects);
+    bytes = _bytes;
+    objects = _objects;
+#endif
+  }
+};
+
+} // namespace MemoryAccounting
+
+#endif
@@ -0,0 +1,171 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "SystemMemory.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+
+#include <stdio.h>
+
+#ifdef _WIN32
+#include <sysinfoapi.h>
+#endif
+
+/**
+ * Reports are ignored after this duration, because the operating
+ * system doesn't tell us when the pressure is over.
+ */
+static constexpr std::chrono::steady_clock::duration REPORT_TIMEOUT =
+  std::chrono::minutes(1);
+
+static std::atomic<MemoryPressure> reported_pressure{MemoryPressure::NONE};
+static std::atomic<std::chrono::steady_clock::rep> reported_time{0};
+
+void
+ReportMemoryPressure(MemoryPressure pressure) noexcept
+{
+  reported_time.store(std::chrono::steady_clock::now().time_since_epoch().count(),
+                      std::memory_order_relaxed);
+  reported_pressure.store(pressure, std::memory_order_relaxed);
+}
+
+static MemoryPressure
+GetReportedMemoryPressure() noexcept
+{
+  const MemoryPressure pressure =
+    reported_pressure.load(std::memory_order_relaxed);
+  if (pressure == MemoryPressure::NONE)
+    return pressure;
+
+  const std::chrono::steady_clock::time_point time{
+    std::chrono::steady_clock::duration{reported_time.load(std::memory_order_relaxed)},
+  };
+
+  if (std::chrono::steady_clock::now() - time > REPORT_TIMEOUT)
+    return MemoryPressure::NONE;
+
+  return pressure;
+}
+
+#ifdef __linux__
+
+#include "system/FileUtil.hpp"
+#include "system/Path.hpp"
+
+std::size_t
+SystemAvailableMemory() noexcept
+{
+  FILE *file = fopen("/proc/meminfo", "r");
+  if (file == nullptr)
+    return 0;
+
+  std::size_t result = 0;
+
+  char line[256];
+  while (fgets(line, sizeof(line), file) != nullptr) {
+    unsigned long kb;
+    if (sscanf(line, "MemAvailable: %lu kB", &kb) == 1) {
+      result = std::size_t(kb) * 1024;
+      break;
+    }
+
+    /* fallback for kernels older than 3.14 */
+    if (sscanf(line, "MemFree: %lu kB", &kb) == 1)
+      result = std::size_t(kb) * 1024;
+  }
+
+  fclose(file);
+  return result;
+}
+
+/**
+ * Obtain the "some avg10" value from /proc/pressure/memory, i.e. the
+ * percentage of time in the last 10 seconds in which at least one
+ * task was stalled waiting for memory.
+ *
+ * @return the percentage or a negative value on error
+ */
+static double
+ReadMemoryPSI() noexcept
+{
+  char buffer[256];
+  if (!File::ReadString(Path("/proc/pressure/memory"),
+                        buffer, sizeof(buffer)))
+    return -1;
+
+  double avg10;
+  if (sscanf(buffer, "some avg10=%lf", &avg10) != 1)
+    return -1;
+
+  return avg10;
+}
+
+static MemoryPressure
+LinuxMemoryPressure() noexcept
+{
+  const double psi = ReadMemoryPSI();
+  if (psi >= 40)
+    return MemoryPressure::CRITICAL;
+  else if (psi >= 10)
+    return MemoryPressure::MODERATE;
+  else
+    return MemoryPressure::NONE;
+}
+
+#elif defined(_WIN32)
+
+std::size_t
+SystemAvailableMemory() noexcept
+{
+  MEMORYSTATUSEX status;
+  status.dwLength = sizeof(status);
+  if (!GlobalMemoryStatusEx(&status))
+    return 0;
+
+  return std::size_t(std::min<DWORDLONG>(status.ullAvailPhys,
+                                         SIZE_MAX));
+}
+
+#else
+
+std::size_t
+SystemAvailableMemory() noexcept
+{
+  return 0;
+}
+
+#endif
+
+MemoryPressure
+SystemMemoryPressure() noexcept
+{
+  MemoryPressure pressure = GetReportedMemoryPressure();
+
+#ifdef __linux__
+  pressure = std::max(pressure, LinuxMemoryPressure());
+#endif
+
+  return pressure;
+}
@@ -0,0 +1,70 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * How badly does the operating system need memory back?
+ */
+enum class MemoryPressure : uint8_t {
+  NONE,
+
+  /**
+   * The system is running low on memory; caches should be reduced.
+   */
+  MODERATE,
+
+  /**
+   * The system is about to kill processes; release everything that
+   * can be reloaded later.
+   */
+  CRITICAL,
+};
+
+/**
+ * Determine the amount of memory which is available to new
+ * allocations without swapping.
+ *
+ * @return the number of bytes or 0 if unknown
+ */
+std::size_t
+SystemAvailableMemory() noexcept;
+
+/**
+ * Determine the current memory pressure.  On Linux, this is obtained
+ * from the kernel's pressure stall information (PSI); on Android,
+ * the value reported by ReportMemoryPressure() is taken into account.
+ */
+MemoryPressure
+SystemMemoryPressure() noexcept;
+
+/**
+ * Report a memory pressure level received from the operating system
+ * (e.g. Android's onTrimMemory()).  The report expires after one
+ * minute.  This may be called from any thread.
+ */
+void
+ReportMemoryPressure(MemoryPressure pressure) noexcept;
@@ -0,0 +1,113 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_THREAD_LOCK_STATISTICS_HPP
+#define XCSOAR_THREAD_LOCK_STATISTICS_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+/**
+ * Lock-free counters describing how long a mutex was held: the
+ * number of lock scopes, their total and their maximum duration.
+ * Unlike #ThreadStatistics, this reads only the steady clock and
+ * keeps nanoseconds, because most lock scopes are copies which take
+ * far less than one microsecond.
+ */
+class LockStatistics {
+public:
+  using Duration = std::chrono::nanoseconds;
+
+  struct Snapshot {
+    uint64_t count;
+
+    Duration total, max;
+
+    [[gnu::pure]]
+    Duration GetAverage() const noexcept {
+      return count > 0 ? Duration(total.count() / count) : Duration{};
+    }
+  };
+
+private:
+  std::atomic<uint64_t> count{0}, total_ns{0}, max_ns{0};
+
+public:
+  /**
+   * Record one lock scope.
+   */
+  void Add(Duration duration) noexcept {
+    const uint64_t ns = duration.count();
+
+    count.fetch_add(1, std::memory_order_relaxed);
+    total_ns.fetch_add(ns, std::memory_order_relaxed);
+
+    uint64_t old_max = max_ns.load(std::memory_order_relaxed);
+    while (ns > old_max &&
+           !max_ns.compare_exchange_weak(old_max, ns,
+                                         std::memory_order_relaxed))
+      ;
+  }
+
+  /**
+   * Obtain a copy of the counters.  They are read one by one, so
+   * they may be slightly inconsistent while a thread records.
+   */
+  [[gnu::pure]]
+  Snapshot GetSnapshot() const noexcept {
+    return {
+      count.load(std::memory_order_relaxed),
+      Duration(total_ns.load(std::memory_order_relaxed)),
+      Duration(max_ns.load(std::memory_order_relaxed)),
+    };
+  }
+};
+
+/**
+ * A std::lock_guard replacement which records the time the mutex
+ * was held in a #LockStatistics object.
+ */
+template<typename M>
+class StatisticsLockGuard {
+  LockStatistics &statistics;
+
+  const std::lock_guard<M> lock;
+
+  const std::chrono::steady_clock::time_point start;
+
+public:
+  StatisticsLockGuard(M &mutex, LockStatistics &_statistics) noexcept
+    :statistics(_statistics), lock(mutex),
+     start(std::chrono::steady_clock::now()) {}
+
+  ~StatisticsLockGuard() noexcept {
+    statistics.Add(std::chrono::steady_clock::now() - start);
+  }
+
+  StatisticsLockGuard(const StatisticsLockGuard &) = delete;
+  StatisticsLockGuard &operator=(const StatisticsLockGuard &) = delete;
+};
+
+#endif
@@ -22,9 +22,10 @@ Copyright_License {
 */
 
 #include "thread/StandbyThread.hpp"
+#include "thread/Statistics.hpp"
 
 StandbyThread::StandbyThread(const char *_name)
-  :Thread(_name) {}
+  :Thread(_name), statistics(ThreadStatistics::Register(_name)) {}
 
 StandbyThread::~StandbyThread()
 {
@@ -108,7 +109,12 @@ StandbyThread::Run() noexcept
       /* there's work to do */
       pending = false;
       busy = true;
-      Tick();
+
+      {
+        const ScopeThreadStatistics measure(statistics);
+        Tick();
+      }
+
       busy = false;
       TriggerDone();
     }
@@ -29,6 +29,8 @@ Copyright_License {
 #include "thread/Mutex.hxx"
 #include "Cond.hxx"
 
+class ThreadStatistics;
+
 /**
  * A thread which waits for work in background.  It is similar to
  * #WorkerThread, but more light-weight and provides a mutex for
@@ -67,6 +69,11 @@ private:
    */
   bool stop = false;
 
+  /**
+   * Each Tick() is recorded here (if not nullptr).
+   */
+  ThreadStatistics *const statistics;
+
 public:
   explicit StandbyThread(const char *_name);
 
@@ -121,6 +128,17 @@ protected:
     return pending || busy;
   }
 
+  /**
+   * Has Trigger() been called while Tick() is running?  Tick()
+   * implementations may use this to abort low-priority work early.
+   *
+   * Caller must lock the mutex.
+   */
+  gcc_pure
+  bool IsPending() const {
+    return pending;
+  }
+
   /**
    * Was the thread asked to stop?  The Tick() implementation should
    * use this to check whether to cancel the operation.
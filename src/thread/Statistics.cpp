@@ -0,0 +1,167 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Statistics.hpp"
+#include "TraceEvents.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#ifdef HAVE_POSIX
+#include <time.h>
+#endif
+
+using std::chrono::microseconds;
+
+static std::array<ThreadStatistics, ThreadStatistics::MAX_THREADS> registry;
+
+/**
+ * The number of #registry slots which have been claimed.
+ */
+static std::atomic<unsigned> n_registered{0};
+
+ThreadStatistics *
+ThreadStatistics::Register(const char *name) noexcept
+{
+  const unsigned n = std::min(n_registered.load(std::memory_order_acquire),
+                              MAX_THREADS);
+  for (unsigned i = 0; i < n; ++i) {
+    const char *other = registry[i].GetName();
+    if (other != nullptr && std::strcmp(other, name) == 0)
+      return &registry[i];
+  }
+
+  const unsigned i = n_registered.fetch_add(1, std::memory_order_acq_rel);
+  if (i >= MAX_THREADS)
+    return nullptr;
+
+  registry[i].name.store(name, std::memory_order_release);
+  return &registry[i];
+}
+
+unsigned
+ThreadStatistics::GetAll(std::array<Snapshot, MAX_THREADS> &dest) noexcept
+{
+  const unsigned n = std::min(n_registered.load(std::memory_order_acquire),
+                              MAX_THREADS);
+
+  unsigned result = 0;
+  for (unsigned i = 0; i < n; ++i)
+    /* skip slots which were claimed, but whose name has not been
+       published yet */
+    if (registry[i].GetName() != nullptr)
+      dest[result++] = registry[i].GetSnapshot();
+
+  return result;
+}
+
+void
+ThreadStatistics::Add(microseconds duration, microseconds cpu) noexcept
+{
+  const uint64_t us = std::max<int64_t>(duration.count(), 0);
+  const unsigned slot = std::min<unsigned>(std::bit_width(us >> 6),
+                                           N_SLOTS - 1);
+
+  slots[slot].fetch_add(1, std::memory_order_relaxed);
+  cycles.fetch_add(1, std::memory_order_relaxed);
+  busy_us.fetch_add(us, std::memory_order_relaxed);
+  cpu_us.fetch_add(std::max<int64_t>(cpu.count(), 0),
+                   std::memory_order_relaxed);
+
+  /* threads sharing a name may update concurrently */
+  const uint32_t us32 = std::min<uint64_t>(us, UINT32_MAX);
+  uint32_t old_max = max_us.load(std::memory_order_relaxed);
+  while (us32 > old_max &&
+         !max_us.compare_exchange_weak(old_max, us32,
+                                       std::memory_order_relaxed)) {}
+}
+
+ThreadStatistics::Snapshot
+ThreadStatistics::GetSnapshot() const noexcept
+{
+  Snapshot s;
+  s.name = GetName();
+  for (unsigned i = 0; i < N_SLOTS; ++i)
+    s.slots[i] = slots[i].load(std::memory_order_relaxed);
+  s.cycles = cycles.load(std::memory_order_relaxed);
+  s.busy = microseconds(busy_us.load(std::memory_order_relaxed));
+  s.cpu = microseconds(cpu_us.load(std::memory_order_relaxed));
+  s.max = microseconds(max_us.load(std::memory_order_relaxed));
+  return s;
+}
+
+microseconds
+ThreadStatistics::Snapshot::GetPercentile(double fraction) const noexcept
+{
+  if (cycles == 0)
+    return {};
+
+  /* the counters are not read atomically as a whole, so the slots
+     may not add up to #cycles exactly */
+  const uint32_t n = std::max<uint32_t>(cycles * fraction, 1);
+
+  uint32_t sum = 0;
+  for (unsigned i = 0; i + 1 < N_SLOTS; ++i) {
+    sum += slots[i];
+    if (sum >= n)
+      return std::min(microseconds{64 << i}, max);
+  }
+
+  return max;
+}
+
+static microseconds
+GetThreadCPUTime() noexcept
+{
+#if defined(HAVE_POSIX) && defined(CLOCK_THREAD_CPUTIME_ID)
+  struct timespec ts;
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0)
+    return std::chrono::duration_cast<microseconds>(std::chrono::seconds(ts.tv_sec)) +
+      std::chrono::duration_cast<microseconds>(std::chrono::nanoseconds(ts.tv_nsec));
+#endif
+
+  return {};
+}
+
+ScopeThreadStatistics::ScopeThreadStatistics(ThreadStatistics *_statistics) noexcept
+  :statistics(_statistics),
+   start_time(std::chrono::steady_clock::now()),
+   start_cpu(statistics != nullptr ? GetThreadCPUTime() : microseconds{})
+{
+  if (statistics != nullptr && TraceEvents::IsEnabled())
+    traced = TraceEvents::Begin(statistics->GetName());
+}
+
+ScopeThreadStatistics::~ScopeThreadStatistics() noexcept
+{
+  if (traced)
+    TraceEvents::End();
+
+  if (statistics == nullptr)
+    return;
+
+  const auto duration = std::chrono::steady_clock::now() - start_time;
+  statistics->Add(std::chrono::duration_cast<microseconds>(duration),
+                  GetThreadCPUTime() - start_cpu);
+}
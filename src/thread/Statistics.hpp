@@ -0,0 +1,156 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_THREAD_STATISTICS_HPP
+#define XCSOAR_THREAD_STATISTICS_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * Lock-free counters describing the work done by one thread: the
+ * number of cycles (e.g. WorkerThread::Tick() calls), their duration
+ * and the CPU time they consumed.  Threads record into it with
+ * relaxed atomic operations, so this is cheap enough to be always
+ * enabled; readers take a #Snapshot from any thread.
+ *
+ * Instances live in a static registry (see Register()) and are never
+ * freed, so pointers remain valid even after the thread has exited.
+ */
+class ThreadStatistics {
+public:
+  /**
+   * Slot 0 counts cycles below 64 microseconds, each following slot
+   * covers twice the range of the previous one; the last one
+   * contains everything above 1 second (like #FrameProfiler).
+   */
+  static constexpr unsigned N_SLOTS = 16;
+
+  /**
+   * The maximum number of threads in the registry.
+   */
+  static constexpr unsigned MAX_THREADS = 16;
+
+  struct Snapshot {
+    const char *name;
+
+    std::array<uint32_t, N_SLOTS> slots;
+
+    uint32_t cycles;
+
+    /**
+     * The wall-clock time spent in all cycles.
+     */
+    std::chrono::microseconds busy;
+
+    /**
+     * The CPU time consumed by all cycles; zero if the platform
+     * cannot measure it.
+     */
+    std::chrono::microseconds cpu;
+
+    std::chrono::microseconds max;
+
+    /**
+     * Returns the upper bound of the slot containing the given
+     * fraction of all cycles (e.g. 0.9 for the 90th percentile).
+     */
+    [[gnu::pure]]
+    std::chrono::microseconds GetPercentile(double fraction) const noexcept;
+
+    [[gnu::pure]]
+    std::chrono::microseconds GetAverage() const noexcept {
+      return cycles > 0 ? busy / cycles : std::chrono::microseconds{};
+    }
+  };
+
+private:
+  std::atomic<const char *> name{nullptr};
+
+  std::array<std::atomic<uint32_t>, N_SLOTS> slots{};
+
+  std::atomic<uint32_t> cycles{0}, max_us{0};
+
+  std::atomic<uint64_t> busy_us{0}, cpu_us{0};
+
+public:
+  /**
+   * Look up the statistics object for the given thread name, and
+   * create one if there is none yet.  Threads which share a name
+   * share one object.
+   *
+   * @param name a string literal
+   * @return nullptr if the registry is full
+   */
+  static ThreadStatistics *Register(const char *name) noexcept;
+
+  /**
+   * Copy the statistics of all registered threads into the given
+   * buffer.
+   *
+   * @return the number of snapshots
+   */
+  static unsigned GetAll(std::array<Snapshot, MAX_THREADS> &dest) noexcept;
+
+  const char *GetName() const noexcept {
+    return name.load(std::memory_order_acquire);
+  }
+
+  /**
+   * Record one cycle.
+   */
+  void Add(std::chrono::microseconds duration,
+           std::chrono::microseconds cpu) noexcept;
+
+  [[gnu::pure]]
+  Snapshot GetSnapshot() const noexcept;
+};
+
+/**
+ * Measures one cycle of the calling thread and records it in a
+ * #ThreadStatistics object (if not nullptr).  While #TraceEvents is
+ * enabled, the cycle is also recorded as a trace event.
+ */
+class ScopeThreadStatistics {
+  ThreadStatistics *const statistics;
+
+  /**
+   * Was a trace event begun by the constructor?
+   */
+  bool traced = false;
+
+  const std::chrono::steady_clock::time_point start_time;
+
+  const std::chrono::microseconds start_cpu;
+
+public:
+  explicit ScopeThreadStatistics(ThreadStatistics *_statistics) noexcept;
+  ~ScopeThreadStatistics() noexcept;
+
+  ScopeThreadStatistics(const ScopeThreadStatistics &) = delete;
+  ScopeThreadStatistics &operator=(const ScopeThreadStatistics &) = delete;
+};
+
+#endif
@@ -0,0 +1,117 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+
+void
+ThreadPool::Worker::Run() noexcept
+{
+  std::unique_lock<Mutex> lock(pool.mutex);
+
+  while (true) {
+    pool.work_cond.wait(lock, [this]{
+      return pool.stop || pool.next_job < pool.n_jobs;
+    });
+
+    if (pool.stop)
+      break;
+
+    pool.RunJobs(lock);
+  }
+}
+
+ThreadPool::ThreadPool(unsigned n_threads) noexcept
+{
+  const unsigned n = std::min(n_threads > 0 ? n_threads - 1 : 0,
+                              MAX_WORKERS);
+
+  for (unsigned i = 0; i < n; ++i) {
+    auto worker = std::make_unique<Worker>(*this);
+
+    try {
+      worker->Start();
+    } catch (...) {
+      /* continue with fewer threads */
+      break;
+    }
+
+    workers[n_workers++] = std::move(worker);
+  }
+}
+
+ThreadPool::~ThreadPool() noexcept
+{
+  {
+    const std::lock_guard<Mutex> lock(mutex);
+    stop = true;
+    work_cond.notify_all();
+  }
+
+  for (unsigned i = 0; i < n_workers; ++i)
+    workers[i]->Join();
+}
+
+inline void
+ThreadPool::RunJobs(std::unique_lock<Mutex> &lock) noexcept
+{
+  while (next_job < n_jobs) {
+    const unsigned i = next_job++;
+    const Function f = function;
+    const void *const ctx = context;
+
+    lock.unlock();
+    f(ctx, i);
+    lock.lock();
+
+    if (++n_finished == n_jobs)
+      done_cond.notify_all();
+  }
+}
+
+void
+ThreadPool::ForEach(unsigned n, Function f, const void *ctx) noexcept
+{
+  std::unique_lock<Mutex> batch_lock(batch_mutex, std::try_to_lock);
+  if (!batch_lock.owns_lock() || n_workers == 0 || n < 2) {
+    for (unsigned i = 0; i < n; ++i)
+      f(ctx, i);
+    return;
+  }
+
+  std::unique_lock<Mutex> lock(mutex);
+  function = f;
+  context = ctx;
+  next_job = 0;
+  n_jobs = n;
+  n_finished = 0;
+  work_cond.notify_all();
+
+  RunJobs(lock);
+
+  done_cond.wait(lock, [this]{ return n_finished == n_jobs; });
+
+  function = nullptr;
+  n_jobs = next_job = n_finished = 0;
+}
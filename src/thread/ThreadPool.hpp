@@ -0,0 +1,133 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_THREAD_POOL_HPP
+#define XCSOAR_THREAD_POOL_HPP
+
+#include "thread/Thread.hpp"
+#include "thread/Mutex.hxx"
+#include "thread/Cond.hxx"
+
+#include <memory>
+
+/**
+ * A small pool of threads which run independent jobs of one batch in
+ * parallel.  The calling thread participates, and ForEach() returns
+ * only after all jobs have finished.  This is meant for splitting
+ * CPU-bound work (e.g. rows of an image) across all cores.
+ */
+class ThreadPool {
+  static constexpr unsigned MAX_WORKERS = 7;
+
+  class Worker final : public Thread {
+    ThreadPool &pool;
+
+  public:
+    explicit Worker(ThreadPool &_pool) noexcept
+      :Thread("ThreadPool"), pool(_pool) {}
+
+  protected:
+    void Run() noexcept override;
+  };
+
+  using Function = void (*)(const void *ctx, unsigned i) noexcept;
+
+  /**
+   * Serialises ForEach() calls from different threads.
+   */
+  Mutex batch_mutex;
+
+  /**
+   * Protects all attributes below.
+   */
+  Mutex mutex;
+
+  /**
+   * Signalled when a new batch is available or the pool is being
+   * stopped.
+   */
+  Cond work_cond;
+
+  /**
+   * Signalled when the last job of a batch has finished.
+   */
+  Cond done_cond;
+
+  Function function = nullptr;
+  const void *context;
+
+  unsigned next_job = 0, n_jobs = 0, n_finished = 0;
+
+  bool stop = false;
+
+  std::unique_ptr<Worker> workers[MAX_WORKERS];
+  unsigned n_workers = 0;
+
+public:
+  /**
+   * Start the worker threads.  If a thread cannot be started, the
+   * pool uses fewer threads.
+   *
+   * @param n_threads the number of threads which shall run jobs,
+   * including the calling thread
+   */
+  explicit ThreadPool(unsigned n_threads) noexcept;
+  ~ThreadPool() noexcept;
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  /**
+   * The number of threads running jobs, including the calling
+   * thread.
+   */
+  unsigned GetConcurrency() const noexcept {
+    return n_workers + 1;
+  }
+
+  /**
+   * Invoke f(i) for each i in [0, n) and wait for completion.  The
+   * function may be called concurrently from different threads.  If
+   * another thread is already running a batch, all jobs are run in
+   * the calling thread.
+   *
+   * The function is shared by all threads, so it is invoked as const.
+   */
+  template<typename F>
+  void ForEach(unsigned n, const F &f) noexcept {
+    ForEach(n, [](const void *ctx, unsigned i) noexcept {
+      (*static_cast<const F *>(ctx))(i);
+    }, static_cast<const void *>(&f));
+  }
+
+private:
+  void ForEach(unsigned n, Function f, const void *ctx) noexcept;
+
+  /**
+   * Run jobs of the current batch until there are none left.  The
+   * caller must hold the mutex.
+   */
+  void RunJobs(std::unique_lock<Mutex> &lock) noexcept;
+};
+
+#endif
@@ -0,0 +1,309 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "TraceEvents.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstring>
+
+#ifdef __linux__
+#include <sys/prctl.h>
+#elif defined(__APPLE__)
+#include <pthread.h>
+#endif
+
+namespace TraceEvents {
+
+std::atomic<bool> enabled{false};
+
+namespace {
+
+struct Slot {
+  std::atomic<const char *> name;
+
+  /**
+   * The time stamp in microseconds shifted left by one bit; the
+   * lowest bit is set for "begin" events.
+   */
+  std::atomic<uint64_t> stamp;
+};
+
+/**
+ * The ring buffer of one thread.  Only the owning thread writes
+ * events; readers detect overwritten slots by checking #pending
+ * after copying (like a sequence lock).
+ */
+struct Buffer {
+  enum class State : uint8_t {
+    /**
+     * This buffer has never been used.
+     */
+    UNUSED,
+
+    /**
+     * A thread is claiming this buffer and initialising it; its
+     * contents must not be read yet.
+     */
+    CLAIMING,
+
+    /**
+     * A thread is recording into this buffer.
+     */
+    USED,
+
+    /**
+     * The owning thread has exited; its events are kept until
+     * another thread claims the buffer.
+     */
+    RELEASED,
+  };
+
+  std::atomic<State> state{State::UNUSED};
+
+  char name[16];
+
+  /**
+   * The number of events written so far.
+   */
+  std::atomic<uint64_t> head{0};
+
+  /**
+   * The number of events which have been written or are being
+   * written right now.  Updated before the slot is modified.
+   */
+  std::atomic<uint64_t> pending{0};
+
+  /**
+   * Events before this index are obsolete, because they were
+   * cleared or belong to a thread which has exited.
+   */
+  std::atomic<uint64_t> base{0};
+
+  std::array<Slot, BUFFER_SIZE> slots;
+
+  bool Claim(State expected) noexcept;
+
+  void Push(const char *event_name, bool begin) noexcept {
+    using namespace std::chrono;
+    const auto now =
+      duration_cast<microseconds>(steady_clock::now().time_since_epoch());
+
+    const uint64_t h = head.load(std::memory_order_relaxed);
+    pending.store(h + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    Slot &slot = slots[h % BUFFER_SIZE];
+    slot.name.store(event_name, std::memory_order_relaxed);
+    slot.stamp.store((uint64_t(now.count()) << 1) | begin,
+                     std::memory_order_relaxed);
+
+    head.store(h + 1, std::memory_order_release);
+  }
+
+  void Copy(Thread &dest) const;
+};
+
+}
+
+static std::array<Buffer, MAX_THREADS> buffers;
+
+static void
+GetCurrentThreadName(char *buffer, std::size_t size) noexcept
+{
+  *buffer = 0;
+
+#ifdef __linux__
+  char tmp[16];
+  if (prctl(PR_GET_NAME, tmp) == 0) {
+    tmp[sizeof(tmp) - 1] = 0;
+    strncpy(buffer, tmp, size - 1);
+    buffer[size - 1] = 0;
+  }
+#elif defined(__APPLE__)
+  pthread_getname_np(pthread_self(), buffer, size);
+#endif
+
+  if (*buffer == 0)
+    strncpy(buffer, "thread", size);
+}
+
+inline bool
+Buffer::Claim(State expected) noexcept
+{
+  if (!state.compare_exchange_strong(expected, State::CLAIMING,
+                                     std::memory_order_acquire))
+    return false;
+
+  GetCurrentThreadName(name, sizeof(name));
+  base.store(head.load(std::memory_order_relaxed),
+             std::memory_order_relaxed);
+
+  /* publish the name and the base to Collect() */
+  state.store(State::USED, std::memory_order_release);
+  return true;
+}
+
+static Buffer *
+ClaimBuffer() noexcept
+{
+  /* prefer buffers which have never been used, to preserve the
+     events of threads which have exited */
+  for (auto state : {Buffer::State::UNUSED, Buffer::State::RELEASED})
+    for (auto &buffer : buffers)
+      if (buffer.Claim(state))
+        return &buffer;
+
+  return nullptr;
+}
+
+namespace {
+
+/**
+ * Owns the calling thread's buffer and releases it when the thread
+ * exits.
+ */
+struct ThreadBuffer {
+  Buffer *buffer = nullptr;
+
+  /**
+   * Has ClaimBuffer() failed?  Then don't try again.
+   */
+  bool failed = false;
+
+  ~ThreadBuffer() noexcept {
+    if (buffer != nullptr)
+      buffer->state.store(Buffer::State::RELEASED,
+                          std::memory_order_release);
+  }
+
+  Buffer *Get() noexcept {
+    if (buffer == nullptr && !failed) {
+      buffer = ClaimBuffer();
+      failed = buffer == nullptr;
+    }
+
+    return buffer;
+  }
+};
+
+}
+
+static thread_local ThreadBuffer thread_buffer;
+
+void
+SetEnabled(bool _enabled) noexcept
+{
+  enabled.store(_enabled, std::memory_order_relaxed);
+}
+
+void
+Clear() noexcept
+{
+  for (auto &buffer : buffers)
+    buffer.base.store(buffer.head.load(std::memory_order_acquire),
+                      std::memory_order_release);
+}
+
+bool
+Begin(const char *name) noexcept
+{
+  if (!IsEnabled())
+    return false;
+
+  Buffer *buffer = thread_buffer.Get();
+  if (buffer == nullptr)
+    return false;
+
+  buffer->Push(name, true);
+  return true;
+}
+
+void
+End() noexcept
+{
+  /* Begin() has claimed the buffer */
+  Buffer *buffer = thread_buffer.buffer;
+  assert(buffer != nullptr);
+
+  buffer->Push(nullptr, false);
+}
+
+void
+Buffer::Copy(Thread &dest) const
+{
+  std::memcpy(dest.name, name, sizeof(dest.name));
+  dest.name[sizeof(dest.name) - 1] = 0;
+
+  const uint64_t end = head.load(std::memory_order_acquire);
+  uint64_t start = std::max(base.load(std::memory_order_acquire),
+                            end > BUFFER_SIZE ? end - BUFFER_SIZE : 0);
+  if (start >= end)
+    return;
+
+  dest.events.reserve(end - start);
+  for (uint64_t i = start; i < end; ++i) {
+    const Slot &slot = slots[i % BUFFER_SIZE];
+    const uint64_t stamp = slot.stamp.load(std::memory_order_relaxed);
+    dest.events.push_back({
+      slot.name.load(std::memory_order_relaxed),
+      std::chrono::microseconds(stamp >> 1),
+      (stamp & 1) != 0,
+    });
+  }
+
+  /* discard the slots which the owner may have overwritten while we
+     were copying */
+  std::atomic_thread_fence(std::memory_order_acquire);
+  const uint64_t written = pending.load(std::memory_order_relaxed);
+  if (written > start + BUFFER_SIZE)
+    dest.events.erase(dest.events.begin(),
+                      dest.events.begin() +
+                      std::min<uint64_t>(written - BUFFER_SIZE - start,
+                                         dest.events.size()));
+}
+
+std::vector<Thread>
+Collect()
+{
+  std::vector<Thread> result;
+
+  for (unsigned i = 0; i < MAX_THREADS; ++i) {
+    const Buffer &buffer = buffers[i];
+    const auto state = buffer.state.load(std::memory_order_acquire);
+    if (state == Buffer::State::UNUSED || state == Buffer::State::CLAIMING)
+      continue;
+
+    Thread &thread = result.emplace_back();
+    thread.id = i + 1;
+    buffer.Copy(thread);
+
+    if (thread.events.empty())
+      result.pop_back();
+  }
+
+  return result;
+}
+
+} // namespace TraceEvents
@@ -0,0 +1,138 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_THREAD_TRACE_EVENTS_HPP
+#define XCSOAR_THREAD_TRACE_EVENTS_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+/**
+ * A recorder for begin/end events of the calling thread, for offline
+ * analysis of stalls (see WriteTraceFile()).  Each thread writes into
+ * its own fixed-size ring buffer without locking; once it is full,
+ * the oldest events are overwritten.  While disabled, recording costs
+ * only one relaxed atomic load.
+ */
+namespace TraceEvents {
+
+/**
+ * The number of events kept per thread.
+ */
+static constexpr unsigned BUFFER_SIZE = 8192;
+
+/**
+ * The maximum number of threads which can record events.
+ */
+static constexpr unsigned MAX_THREADS = 32;
+
+extern std::atomic<bool> enabled;
+
+static inline bool
+IsEnabled() noexcept
+{
+  return enabled.load(std::memory_order_relaxed);
+}
+
+void
+SetEnabled(bool _enabled) noexcept;
+
+/**
+ * Discard all recorded events.  Events which are recorded
+ * concurrently may survive.
+ */
+void
+Clear() noexcept;
+
+/**
+ * Record the beginning of a slice.  Does nothing while disabled.
+ *
+ * @param name a string literal
+ * @return true if the event was recorded; only then must the slice
+ * be closed with End()
+ */
+bool
+Begin(const char *name) noexcept;
+
+/**
+ * Record the end of the slice which was started last.  Must be
+ * called only after a Begin() call which returned true.  Unlike
+ * Begin(), this is recorded even while disabled, so slices which
+ * were open while tracing was switched off are still closed.
+ */
+void
+End() noexcept;
+
+struct Event {
+  const char *name;
+
+  /**
+   * The time since the epoch of std::chrono::steady_clock.
+   */
+  std::chrono::microseconds time;
+
+  bool begin;
+};
+
+struct Thread {
+  /**
+   * A small number identifying the buffer; threads which exited may
+   * share it with threads created later.
+   */
+  unsigned id;
+
+  char name[16];
+
+  std::vector<Event> events;
+};
+
+/**
+ * Copy the events of all threads.  May be called from any thread.
+ */
+std::vector<Thread>
+Collect();
+
+} // namespace TraceEvents
+
+/**
+ * Records a slice covering the lifetime of this object.
+ */
+class ScopeTraceEvent {
+  const bool active;
+
+public:
+  explicit ScopeTraceEvent(const char *name) noexcept
+    :active(TraceEvents::IsEnabled() && TraceEvents::Begin(name)) {}
+
+  ~ScopeTraceEvent() noexcept {
+    if (active)
+      TraceEvents::End();
+  }
+
+  ScopeTraceEvent(const ScopeTraceEvent &) = delete;
+  ScopeTraceEvent &operator=(const ScopeTraceEvent &) = delete;
+};
+
+#endif
@@ -22,6 +22,7 @@ Copyright_License {
 */
 
 #include "thread/WorkerThread.hpp"
+#include "thread/Statistics.hpp"
 #include "time/PeriodClock.hpp"
 
 WorkerThread::WorkerThread(const char *_name,
@@ -30,7 +31,8 @@ WorkerThread::WorkerThread(const char *_name,
   :SuspensibleThread(_name),
    period_min(_period_min),
    idle_min(_idle_min),
-   delay(_delay)
+   delay(_delay),
+   statistics(ThreadStatistics::Register(_name))
 {
 }
 
@@ -55,15 +57,20 @@ WorkerThread::Run() noexcept
     }
 
     /* got the "stop" trigger? */
-    if (delay.count() > 0
-        ? _WaitForStopped(lock, delay)
-        : _CheckStoppedOrSuspended(lock))
+    if (delay.count() > 0 && !urgent_flag) {
+      delaying = true;
+      const bool stopped = _WaitForStopped(lock, delay);
+      delaying = false;
+      if (stopped)
+        break;
+    } else if (_CheckStoppedOrSuspended(lock))
       break;
 
     if (!trigger_flag)
       continue;
 
     trigger_flag = false;
+    urgent_flag = false;
 
     {
       const ScopeUnlock unlock(mutex);
@@ -72,6 +79,7 @@ WorkerThread::Run() noexcept
       if (period_min.count() > 0)
         clock.Update();
 
+      const ScopeThreadStatistics measure(statistics);
       Tick();
     }
 
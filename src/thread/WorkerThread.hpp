@@ -26,6 +26,8 @@ Copyright_License {
 
 #include "thread/SuspensibleThread.hpp"
 
+class ThreadStatistics;
+
 /**
  * A thread which performs regular work in background.
  */
@@ -35,8 +37,24 @@ class WorkerThread : public SuspensibleThread {
   Cond trigger_cond;
   bool trigger_flag = false;
 
+  /**
+   * Shall the pending Tick() be run without the artificial delay?
+   * See TriggerUrgent().
+   */
+  bool urgent_flag = false;
+
+  /**
+   * Is the thread currently waiting for the artificial delay?
+   */
+  bool delaying = false;
+
   const Duration period_min, idle_min, delay;
 
+  /**
+   * Each Tick() is recorded here (if not nullptr).
+   */
+  ThreadStatistics *const statistics;
+
 public:
   /**
    * @param period_min the minimum duration of one period [ms].  If
@@ -63,6 +81,21 @@ public:
     }
   }
 
+  /**
+   * Like Trigger(), but skip the artificial delay (if one was
+   * configured), even if a Trigger() call is already waiting for it.
+   * The rate limit (period_min and idle_min) still applies.
+   */
+  void TriggerUrgent() noexcept {
+    const std::lock_guard<Mutex> lock(mutex);
+    urgent_flag = true;
+    if (!trigger_flag) {
+      trigger_flag = true;
+      trigger_cond.notify_one();
+    } else if (delaying)
+      command_trigger.notify_one();
+  }
+
   /**
    * Suspend execution until Resume() is called.
    */
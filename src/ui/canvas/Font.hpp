@@ -85,6 +85,16 @@ public:
    */
   static void Initialise();
   static void Deinitialise() noexcept;
+
+  /**
+   * Lookup counters of the glyph cache shared by all fonts.
+   */
+  struct GlyphCacheStatistics {
+    unsigned hits = 0, misses = 0;
+  };
+
+  [[gnu::pure]]
+  static GlyphCacheStatistics GetGlyphCacheStatistics() noexcept;
 #endif
 
 public:
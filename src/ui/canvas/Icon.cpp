@@ -27,10 +27,19 @@ Copyright_License {
 
 #ifdef ENABLE_OPENGL
 #include "opengl/Texture.hpp"
+#include "opengl/TextureAtlas.hpp"
 #include "opengl/Scope.hpp"
+#include "opengl/VertexPointer.hpp"
+#include "opengl/Statistics.hpp"
 
 #include "opengl/Shaders.hpp"
 #include "opengl/Program.hpp"
+
+#ifndef ANDROID
+#include "ResourceLoader.hpp"
+#include "custom/ResourceImageCache.hpp"
+#include "custom/UncompressedImage.hpp"
+#endif
 #endif
 
 #include <algorithm>
@@ -57,12 +66,47 @@ IconStretchInteger(unsigned source_dpi) noexcept
 
 #endif
 
+#ifdef ENABLE_OPENGL
+
+/**
+ * Try to load the icon into the shared icon atlas.
+ */
+inline bool
+MaskedIcon::LoadAtlas(ResourceId id)
+{
+#ifdef ANDROID
+  /* Android decodes resources to textures in Java; there is no
+     UncompressedImage to copy into the atlas */
+  (void)id;
+  return false;
+#else
+  const ResourceLoader::Data data = ResourceLoader::Load(id);
+  if (data.IsNull())
+    return false;
+
+  auto &atlas = OpenGL::GetIconAtlas();
+  auto rect = atlas.Find(data.data);
+  if (!rect) {
+    const auto image = ResourceImageCache::Load(data);
+    rect = atlas.Add(data.data, image);
+    if (!rect)
+      return false;
+  }
+
+  bitmap.Reset();
+  texture = &atlas.GetTexture();
+  texture_rect = *rect;
+  return true;
+#endif
+}
+
+#endif
+
 void
 MaskedIcon::LoadResource(ResourceId id, ResourceId big_id, bool center)
 {
 #ifdef ENABLE_OPENGL
   unsigned stretch = 1024;
-#endif
 
   if (Layout::ScaleEnabled()) {
     unsigned source_dpi = 96;
@@ -71,24 +115,41 @@ MaskedIcon::LoadResource(ResourceId id, ResourceId big_id, bool center)
       source_dpi = 192;
     }
 
-#ifdef ENABLE_OPENGL
     stretch = IconStretchFixed10(source_dpi);
+  }
+
+  if (!LoadAtlas(id)) {
     bitmap.Load(id);
-    bitmap.EnableInterpolation();
+    if (Layout::ScaleEnabled())
+      bitmap.EnableInterpolation();
+
+    texture = bitmap.GetNative();
+    texture_rect = PixelRect(bitmap.GetSize());
+  }
 #else
+  if (Layout::ScaleEnabled()) {
+    unsigned source_dpi = 96;
+    if (big_id.IsDefined()) {
+      id = big_id;
+      source_dpi = 192;
+    }
+
     bitmap.LoadStretch(id, IconStretchInteger(source_dpi));
-#endif
   } else
     bitmap.Load(id);
+#endif
 
   assert(IsDefined());
 
-  size = bitmap.GetSize();
 #ifdef ENABLE_OPENGL
+  size = texture_rect.GetSize();
+
   /* let the GPU stretch on-the-fly */
   size.width = size.width * stretch >> 10;
   size.height = size.height * stretch >> 10;
 #else
+  size = bitmap.GetSize();
+
   /* left half is mask, right half is icon */
   size.width /= 2;
 #endif
@@ -114,9 +175,8 @@ MaskedIcon::Draw(Canvas &canvas, PixelPoint p) const noexcept
 
   const ScopeAlphaBlend alpha_blend;
 
-  GLTexture &texture = *bitmap.GetNative();
-  texture.Bind();
-  texture.Draw(PixelRect(p, size), texture.GetRect());
+  texture->Bind();
+  texture->Draw(PixelRect(p, size), texture_rect);
 #else
 
 #ifdef USE_GDI
@@ -144,9 +204,8 @@ MaskedIcon::Draw(Canvas &canvas, const PixelRect &rc, bool inverse) const noexce
 
   const ScopeAlphaBlend alpha_blend;
 
-  GLTexture &texture = *bitmap.GetNative();
-  texture.Bind();
-  texture.Draw(PixelRect(position, size), texture.GetRect());
+  texture->Bind();
+  texture->Draw(PixelRect(position, size), texture_rect);
 #else
   if (inverse) // black background
     canvas.CopyNotOr(position, size, bitmap, {(int)size.width, 0});
@@ -156,3 +215,77 @@ MaskedIcon::Draw(Canvas &canvas, const PixelRect &rc, bool inverse) const noexce
 #endif
 
 }
+
+void
+MaskedIconBatch::Draw(const MaskedIcon &icon, PixelPoint p) noexcept
+{
+#ifdef ENABLE_OPENGL
+  assert(icon.IsDefined());
+
+  if (icon.texture != texture) {
+    Flush();
+    texture = icon.texture;
+  }
+
+  p -= icon.origin;
+
+  const PixelRect dest(p, icon.size);
+  const BulkPixelPoint top_left = dest.GetTopLeft();
+  const BulkPixelPoint top_right = dest.GetTopRight();
+  const BulkPixelPoint bottom_left = dest.GetBottomLeft();
+  const BulkPixelPoint bottom_right = dest.GetBottomRight();
+
+  /* two triangles per icon, because GL_TRIANGLE_STRIP cannot
+     describe disjoint quads */
+  vertices.insert(vertices.end(), {
+      top_left, top_right, bottom_left,
+      top_right, bottom_right, bottom_left,
+    });
+
+  const PixelSize allocated = texture->GetAllocatedSize();
+  const PixelRect &src = icon.texture_rect;
+  GLfloat x0 = (GLfloat)src.left / allocated.width;
+  GLfloat y0 = (GLfloat)src.top / allocated.height;
+  GLfloat x1 = (GLfloat)src.right / allocated.width;
+  GLfloat y1 = (GLfloat)src.bottom / allocated.height;
+  if (texture->IsFlipped())
+    std::swap(y0, y1);
+
+  coords.insert(coords.end(), {
+      x0, y0, x1, y0, x0, y1,
+      x1, y0, x1, y1, x0, y1,
+    });
+#else
+  icon.Draw(canvas, p);
+#endif
+}
+
+#ifdef ENABLE_OPENGL
+
+void
+MaskedIconBatch::Flush() noexcept
+{
+  if (vertices.empty())
+    return;
+
+  OpenGL::texture_shader->Use();
+
+  const ScopeAlphaBlend alpha_blend;
+
+  texture->Bind();
+
+  const ScopeVertexPointer vp(vertices.data());
+
+  glEnableVertexAttribArray(OpenGL::Attribute::TEXCOORD);
+  glVertexAttribPointer(OpenGL::Attribute::TEXCOORD, 2, GL_FLOAT, GL_FALSE,
+                        0, coords.data());
+
+  OpenGL::DrawArrays(GL_TRIANGLES, 0, vertices.size());
+
+  glDisableVertexAttribArray(OpenGL::Attribute::TEXCOORD);
+
+  vertices.clear();
+  coords.clear();
+}
+
+#endif
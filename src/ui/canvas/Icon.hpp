@@ -29,6 +29,14 @@ Copyright_License {
 #include "ui/dim/Size.hpp"
 #include "ResourceId.hpp"
 
+#ifdef ENABLE_OPENGL
+#include "ui/dim/Rect.hpp"
+#include "ui/dim/BulkPoint.hpp"
+#include "ui/opengl/System.hpp"
+
+#include <vector>
+#endif
+
 struct PixelRect;
 class Canvas;
 
@@ -36,9 +44,28 @@ class Canvas;
  * An icon with a mask which marks transparent pixels.
  */
 class MaskedIcon {
+  friend class MaskedIconBatch;
+
 protected:
+  /**
+   * The bitmap owned by this icon.  On OpenGL, it is only used if the
+   * icon did not fit into the shared icon atlas.
+   */
   Bitmap bitmap;
 
+#ifdef ENABLE_OPENGL
+  /**
+   * The texture containing this icon: either the shared icon atlas or
+   * the one owned by #bitmap.
+   */
+  GLTexture *texture = nullptr;
+
+  /**
+   * The position of this icon within #texture.
+   */
+  PixelRect texture_rect;
+#endif
+
   PixelSize size;
 
   PixelPoint origin;
@@ -49,7 +76,11 @@ public:
   }
 
   bool IsDefined() const noexcept {
+#ifdef ENABLE_OPENGL
+    return texture != nullptr;
+#else
     return bitmap.IsDefined();
+#endif
   }
 
   void LoadResource(ResourceId id, ResourceId big_id = ResourceId::Null(),
@@ -57,11 +88,58 @@ public:
 
   void Reset() noexcept {
     bitmap.Reset();
+#ifdef ENABLE_OPENGL
+    texture = nullptr;
+#endif
   }
 
   void Draw(Canvas &canvas, PixelPoint p) const noexcept;
 
   void Draw(Canvas &canvas, const PixelRect &rc, bool inverse) const noexcept;
+
+#ifdef ENABLE_OPENGL
+private:
+  bool LoadAtlas(ResourceId id);
+#endif
+};
+
+/**
+ * Draws many icons at once.  On OpenGL, consecutive icons from the
+ * same texture (usually the shared icon atlas) are submitted with
+ * one draw call when Flush() is called or when the texture changes;
+ * elsewhere, each icon is drawn immediately.
+ *
+ * Icons drawn this way may end up on top of other things drawn on
+ * the #Canvas before Flush().
+ */
+class MaskedIconBatch {
+  [[maybe_unused]] Canvas &canvas;
+
+#ifdef ENABLE_OPENGL
+  GLTexture *texture = nullptr;
+
+  std::vector<BulkPixelPoint> vertices;
+  std::vector<GLfloat> coords;
+#endif
+
+public:
+  explicit MaskedIconBatch(Canvas &_canvas) noexcept
+    :canvas(_canvas) {}
+
+  ~MaskedIconBatch() noexcept {
+    Flush();
+  }
+
+  MaskedIconBatch(const MaskedIconBatch &) = delete;
+  MaskedIconBatch &operator=(const MaskedIconBatch &) = delete;
+
+  void Draw(const MaskedIcon &icon, PixelPoint p) noexcept;
+
+#ifdef ENABLE_OPENGL
+  void Flush() noexcept;
+#else
+  void Flush() noexcept {}
+#endif
 };
 
 #endif
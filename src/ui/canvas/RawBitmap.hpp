@@ -14,6 +14,10 @@
 #include "PortableColor.hpp"
 #include "util/ByteOrder.hxx"
 
+#ifdef USE_MEMORY_CANVAS
+#include "Math/Point2D.hpp"
+#endif
+
 #ifdef ENABLE_OPENGL
 #include "ui/opengl/Features.hpp"
 #endif
@@ -169,6 +173,18 @@ public:
 #endif
   }
 
+  /**
+   * Returns a pointer to the row with the given index, counting from
+   * the top.
+   */
+  RawColor *GetRow(unsigned y) {
+#ifndef USE_GDI
+    return GetBuffer() + y * corrected_width;
+#else
+    return GetBuffer() + (height - 1 - y) * corrected_width;
+#endif
+  }
+
   void SetDirty() {
 #ifdef ENABLE_OPENGL
     dirty = true;
@@ -213,6 +229,19 @@ public:
   void StretchTo(PixelSize src_size,
                  Canvas &dest_canvas, PixelSize dest_size,
                  bool transparent_white=false) const;
+
+#ifdef USE_MEMORY_CANVAS
+  /**
+   * Fill the whole canvas with an affinely transformed (e.g. rotated)
+   * portion of this bitmap, see Canvas::StretchAffine().
+   *
+   * @param src_size the size of the portion at the top left corner
+   * which is used
+   */
+  void TransformTo(PixelSize src_size, Canvas &dest_canvas,
+                   IntPoint2D origin, IntPoint2D step_x, IntPoint2D step_y,
+                   bool transparent_white=false) const;
+#endif
 };
 
 #endif // !defined(AFX_STSCREENBUFFER_H__22D62F5D_32E2_4785_B3D9_2341C11F84A3__INCLUDED_)
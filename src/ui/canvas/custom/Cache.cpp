@@ -28,6 +28,7 @@ Copyright_License {
 #include "util/StringAPI.hxx"
 #include "util/StringView.hxx"
 #include "util/TStringView.hxx"
+#include "system/MemoryAccounting.hpp"
 
 #ifdef ENABLE_OPENGL
 #include "ui/canvas/opengl/Texture.hpp"
@@ -126,6 +127,9 @@ struct RenderedText {
   PixelSize size;
 #endif
 
+  [[no_unique_address]]
+  MemoryAccounting::Reporter memory_usage{MemoryAccounting::Account::TEXT_CACHE};
+
   RenderedText(const RenderedText &other) = delete;
 
 #ifdef ENABLE_OPENGL
@@ -136,14 +140,19 @@ struct RenderedText {
                            buffer))
   {
     glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    UpdateMemoryUsage();
   }
 #elif defined(ANDROID)
   RenderedText(int id, PixelSize size, PixelSize allocated_size) noexcept
-    :texture(new GLTexture(id, size, allocated_size)) {}
+    :texture(new GLTexture(id, size, allocated_size)) {
+    UpdateMemoryUsage();
+  }
 #endif
 #else
   RenderedText(PixelSize _size, std::unique_ptr<uint8_t[]> &&_data) noexcept
-    :data(std::move(_data)), size(_size) {}
+    :data(std::move(_data)), size(_size) {
+    UpdateMemoryUsage();
+  }
 #endif
 
   RenderedText &operator=(const RenderedText &other) = delete;
@@ -167,6 +176,13 @@ struct RenderedText {
     return size;
 #endif
   }
+
+private:
+  void UpdateMemoryUsage() noexcept {
+    /* one byte per pixel (alpha only) */
+    const PixelSize s = GetSize();
+    memory_usage.Update(std::size_t(s.width) * s.height);
+  }
 };
 
 #ifndef ENABLE_OPENGL
@@ -180,6 +196,8 @@ static Mutex text_cache_mutex;
 static Cache<TextCacheKey, PixelSize, 1024u, 701u, TextCacheKey::Hash> size_cache;
 static Cache<TextCacheKey, RenderedText, 256u, 211u, TextCacheKey::Hash> text_cache;
 
+static TextCache::Statistics statistics;
+
 PixelSize
 TextCache::GetSize(const Font &font, StringView text) noexcept
 {
@@ -189,8 +207,12 @@ TextCache::GetSize(const Font &font, StringView text) noexcept
 
   TextCacheKey key(font, text);
   const PixelSize *cached = size_cache.Get(key);
-  if (cached != nullptr)
+  if (cached != nullptr) {
+    ++statistics.size_hits;
     return *cached;
+  }
+
+  ++statistics.size_misses;
 
 #ifdef UNICODE
   PixelSize size = font.TextSize(UTF8ToWideConverter(text));
@@ -241,8 +263,12 @@ TextCache::Get(const Font &font, StringView text) noexcept
 #endif
 
   const RenderedText *cached = text_cache.Get(key);
-  if (cached != nullptr)
+  if (cached != nullptr) {
+    ++statistics.text_hits;
     return *cached;
+  }
+
+  ++statistics.text_misses;
 
   /* render the text into a OpenGL texture */
 
@@ -287,6 +313,16 @@ TextCache::Get(const Font &font, StringView text) noexcept
   return result;
 }
 
+TextCache::Statistics
+TextCache::GetStatistics() noexcept
+{
+#ifndef ENABLE_OPENGL
+  const std::lock_guard<Mutex> lock(text_cache_mutex);
+#endif
+
+  return statistics;
+}
+
 void
 TextCache::Flush() noexcept
 {
@@ -67,6 +67,18 @@ LookupSize(const Font &font, StringView text) noexcept;
 Result
 Get(const Font &font, StringView text) noexcept;
 
+/**
+ * Lookup counters of the caches behind GetSize() and Get().
+ */
+struct Statistics {
+  unsigned size_hits = 0, size_misses = 0;
+  unsigned text_hits = 0, text_misses = 0;
+};
+
+[[gnu::pure]]
+Statistics
+GetStatistics() noexcept;
+
 void
 Flush() noexcept;
 
@@ -28,6 +28,13 @@ Copyright_License {
 
 #ifdef USE_GEOTIFF
 #include "LibTiff.hpp"
+#include "system/FileUtil.hpp"
+#include "io/FileReader.hxx"
+#include "io/FileOutputStream.hxx"
+#include "LogFile.hpp"
+
+#include <cstring>
+#include <memory>
 #endif
 
 #include <stdexcept>
@@ -38,13 +45,138 @@ Copyright_License {
 #pragma GCC diagnostic ignored "-Wsuggest-attribute=noreturn"
 #endif
 
+#ifdef USE_GEOTIFF
+
+/**
+ * Header of a file which caches a decoded GeoTIFF image, followed by
+ * the raw pixels, which can be passed to Bitmap::Load() (and thus to
+ * the GPU) without decoding.  The file is only valid on the machine
+ * which wrote it.
+ */
+struct DecodedGeoImageHeader {
+  static constexpr uint32_t MAGIC = 0x58434749; // "XCGI"
+
+  uint32_t magic;
+  uint8_t format;
+  uint8_t flipped;
+  uint8_t reserved[2];
+  uint32_t pitch, width, height;
+  GeoQuadrilateral bounds;
+};
+
+static AllocatedPath
+DecodedGeoImagePath(Path path) noexcept
+{
+  return path + _T(".decoded");
+}
+
+static void
+ReadFull(FileReader &r, void *dest, std::size_t size)
+{
+  auto *p = (std::byte *)dest;
+  while (size > 0) {
+    std::size_t nbytes = r.Read(p, size);
+    if (nbytes == 0)
+      throw std::runtime_error("Premature end of file");
+
+    p += nbytes;
+    size -= nbytes;
+  }
+}
+
+/**
+ * Load a decoded image written by SaveDecodedGeoImage().
+ *
+ * Throws on error.
+ */
+static std::pair<UncompressedImage, GeoQuadrilateral>
+LoadDecodedGeoImage(Path path)
+{
+  FileReader r(path);
+
+  DecodedGeoImageHeader header;
+  ReadFull(r, &header, sizeof(header));
+  if (header.magic != DecodedGeoImageHeader::MAGIC ||
+      header.format == uint8_t(UncompressedImage::Format::INVALID) ||
+      header.format > uint8_t(UncompressedImage::Format::GRAY) ||
+      header.height == 0 ||
+      r.GetSize() != sizeof(header) + uint64_t(header.pitch) * header.height)
+    throw std::runtime_error("Malformed decoded image file");
+
+  const std::size_t size = std::size_t(header.pitch) * header.height;
+  auto data = std::make_unique<uint8_t[]>(size);
+  ReadFull(r, data.get(), size);
+
+  return {
+    UncompressedImage(UncompressedImage::Format(header.format),
+                      header.pitch, header.width, header.height,
+                      std::move(data), header.flipped),
+    header.bounds,
+  };
+}
+
+/**
+ * Throws on error.
+ */
+static void
+SaveDecodedGeoImage(Path path, const UncompressedImage &image,
+                    const GeoQuadrilateral &bounds)
+{
+  DecodedGeoImageHeader header;
+  memset(&header, 0, sizeof(header));
+  header.magic = DecodedGeoImageHeader::MAGIC;
+  header.format = uint8_t(image.GetFormat());
+  header.flipped = image.IsFlipped();
+  header.pitch = image.GetPitch();
+  header.width = image.GetWidth();
+  header.height = image.GetHeight();
+  header.bounds = bounds;
+
+  FileOutputStream file(path);
+  file.Write(&header, sizeof(header));
+  file.Write(image.GetData(), std::size_t(image.GetPitch()) * image.GetHeight());
+  file.Commit();
+}
+
+/**
+ * Load a GeoTIFF file, preferably from the decoded copy next to it,
+ * which is (re)created if it is missing or older than the GeoTIFF.
+ *
+ * Throws on error.
+ */
+static std::pair<UncompressedImage, GeoQuadrilateral>
+LoadCachedGeoTiff(Path path)
+{
+  const auto decoded_path = DecodedGeoImagePath(path);
+  if (File::GetLastModification(decoded_path) >=
+      File::GetLastModification(path)) {
+    try {
+      return LoadDecodedGeoImage(decoded_path);
+    } catch (...) {
+      /* ignore the broken cache file and decode the GeoTIFF */
+    }
+  }
+
+  auto result = LoadGeoTiff(path);
+
+  try {
+    SaveDecodedGeoImage(decoded_path, result.first, result.second);
+  } catch (...) {
+    LogError(std::current_exception(), "Failed to cache decoded image");
+  }
+
+  return result;
+}
+
+#endif
+
 GeoQuadrilateral
 Bitmap::LoadGeoFile(Path path)
 {
 #ifdef USE_GEOTIFF
   if (path.MatchesExtension(_T(".tif")) ||
       path.MatchesExtension(_T(".tiff"))) {
-    auto result = LoadGeoTiff(path);
+    auto result = LoadCachedGeoTiff(path);
     if (!Load(std::move(result.first)))
       throw std::runtime_error("Failed to use geo image file");
 
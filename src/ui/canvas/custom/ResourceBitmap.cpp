@@ -22,6 +22,8 @@ Copyright_License {
 */
 
 #include "ui/canvas/Bitmap.hpp"
+#include "ResourceImageCache.hpp"
+#include "UncompressedImage.hpp"
 #include "Screen/Debug.hpp"
 #include "ResourceLoader.hpp"
 #include "ResourceId.hpp"
@@ -53,7 +55,8 @@ Bitmap::Load(ResourceId id, Type type)
   if (data.IsNull())
     return false;
 
-  return Load(data, type);
+  auto uncompressed = ResourceImageCache::Load(data);
+  return uncompressed.IsDefined() && Load(std::move(uncompressed), type);
 }
 
 #ifdef USE_MEMORY_CANVAS
@@ -0,0 +1,295 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "ResourceImageCache.hpp"
+#include "UncompressedImage.hpp"
+#include "io/CacheFile.hpp"
+#include "io/FileOutputStream.hxx"
+#include "io/BufferedOutputStream.hxx"
+#include "system/FileMapping.hpp"
+#include "system/FileUtil.hpp"
+#include "system/Path.hpp"
+#include "thread/Mutex.hxx"
+#include "util/ConstBuffer.hxx"
+
+#ifdef ENABLE_COREGRAPHICS
+#include "../apple/ImageDecoder.hpp"
+#else
+#include "LibPNG.hpp"
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+
+#include <string.h>
+
+/**
+ * Images larger than this (in bytes) are not cached; they are not
+ * icons.
+ */
+static constexpr std::size_t MAX_IMAGE_BYTES = 256 * 256 * 4;
+
+struct ResourceImageCacheHeader {
+  static constexpr uint32_t MAGIC = 0x43494358; // "XCIC"
+  static constexpr uint32_t VERSION = 1;
+
+  uint32_t magic;
+  uint32_t version;
+  uint32_t n_images;
+};
+
+/**
+ * One image.  It is followed by pitch*height bytes of pixel data.
+ */
+struct ResourceImageCacheRecord {
+  uint64_t hash;
+  uint32_t png_size;
+  uint32_t width, height, pitch;
+  UncompressedImage::Format format;
+  bool flipped;
+};
+
+static_assert(std::is_trivially_copyable_v<ResourceImageCacheRecord>);
+
+struct CachedImage {
+  uint32_t png_size;
+
+  /**
+   * Was this image requested since the cache was initialised?
+   * Images which were not are dropped when the file is rewritten.
+   */
+  bool used;
+
+  UncompressedImage image;
+};
+
+static Mutex mutex;
+static AllocatedPath cache_path = nullptr;
+static std::unordered_map<uint64_t, CachedImage> images;
+
+/**
+ * Were images added since the file was loaded?
+ */
+static bool modified;
+
+/**
+ * 64 bit FNV-1a; it is good enough to detect changed resources and
+ * much cheaper than decoding.
+ */
+[[gnu::pure]]
+static uint64_t
+HashBuffer(ConstBuffer<void> buffer) noexcept
+{
+  const auto *p = (const uint8_t *)buffer.data;
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (std::size_t i = 0; i < buffer.size; ++i) {
+    hash ^= p[i];
+    hash *= 0x100000001b3ULL;
+  }
+
+  return hash;
+}
+
+static constexpr unsigned
+GetBytesPerPixel(UncompressedImage::Format format) noexcept
+{
+  switch (format) {
+  case UncompressedImage::Format::GRAY:
+    return 1;
+
+  case UncompressedImage::Format::RGB:
+    return 3;
+
+  case UncompressedImage::Format::RGBA:
+    return 4;
+
+  case UncompressedImage::Format::INVALID:
+    break;
+  }
+
+  return 0;
+}
+
+static UncompressedImage
+CopyImage(const UncompressedImage &src)
+{
+  const std::size_t size = std::size_t(src.GetPitch()) * src.GetHeight();
+  auto data = std::make_unique<uint8_t[]>(size);
+  memcpy(data.get(), src.GetData(), size);
+  return UncompressedImage(src.GetFormat(), src.GetPitch(),
+                           src.GetWidth(), src.GetHeight(),
+                           std::move(data), src.IsFlipped());
+}
+
+static void
+LoadFile(Path path)
+{
+  if (!File::Exists(path))
+    return;
+
+  const FileMapping mapping(path);
+  auto r = CacheFileReader::FromChecksummed((const std::byte *)mapping.data(),
+                                            mapping.size());
+
+  const auto header = r.ReadT<ResourceImageCacheHeader>();
+  if (header.magic != ResourceImageCacheHeader::MAGIC ||
+      header.version != ResourceImageCacheHeader::VERSION)
+    return;
+
+  for (unsigned i = 0; i < header.n_images; ++i) {
+    const auto record = r.ReadT<ResourceImageCacheRecord>();
+    const unsigned bpp = GetBytesPerPixel(record.format);
+    const std::size_t size = std::size_t(record.pitch) * record.height;
+    if (bpp == 0 || record.width == 0 || record.height == 0 ||
+        record.pitch < record.width * bpp || size > MAX_IMAGE_BYTES)
+      throw std::runtime_error("Malformed image cache");
+
+    auto data = std::make_unique<uint8_t[]>(size);
+    memcpy(data.get(), r.Read(size), size);
+
+    images.try_emplace(record.hash,
+                       CachedImage{
+                         record.png_size, false,
+                         UncompressedImage(record.format, record.pitch,
+                                           record.width, record.height,
+                                           std::move(data), record.flipped),
+                       });
+  }
+
+  if (r.GetRemaining() > 0)
+    throw std::runtime_error("Malformed image cache");
+}
+
+void
+ResourceImageCache::Initialise(Path path)
+{
+  const std::lock_guard<Mutex> lock(mutex);
+
+  cache_path = path;
+  images.clear();
+  modified = false;
+
+  try {
+    LoadFile(path);
+  } catch (...) {
+    images.clear();
+    throw;
+  }
+}
+
+void
+ResourceImageCache::Save()
+{
+  const std::lock_guard<Mutex> lock(mutex);
+
+  if (cache_path == nullptr)
+    return;
+
+  unsigned n_used = 0;
+  for (const auto &[hash, i] : images)
+    if (i.used)
+      ++n_used;
+
+  if (!modified && n_used == images.size())
+    return;
+
+  ResourceImageCacheHeader header;
+  header.magic = ResourceImageCacheHeader::MAGIC;
+  header.version = ResourceImageCacheHeader::VERSION;
+  header.n_images = n_used;
+
+  FileOutputStream fos(cache_path);
+  BufferedOutputStream bos(fos);
+  CacheFileWriter w(bos);
+
+  w.WriteT(header);
+
+  for (const auto &[hash, i] : images) {
+    if (!i.used)
+      continue;
+
+    ResourceImageCacheRecord record;
+
+    /* zero-fill all implicit padding bytes, they are part of the
+       checksum */
+    memset(static_cast<void *>(&record), 0, sizeof(record));
+
+    record.hash = hash;
+    record.png_size = i.png_size;
+    record.width = i.image.GetWidth();
+    record.height = i.image.GetHeight();
+    record.pitch = i.image.GetPitch();
+    record.format = i.image.GetFormat();
+    record.flipped = i.image.IsFlipped();
+
+    w.WriteT(record);
+    w.Write(i.image.GetData(), std::size_t(record.pitch) * record.height);
+  }
+
+  w.WriteChecksum();
+
+  bos.Flush();
+  fos.Commit();
+
+  modified = false;
+}
+
+void
+ResourceImageCache::Deinitialise() noexcept
+{
+  const std::lock_guard<Mutex> lock(mutex);
+
+  cache_path = nullptr;
+  images.clear();
+}
+
+UncompressedImage
+ResourceImageCache::Load(ConstBuffer<void> png)
+{
+  const std::lock_guard<Mutex> lock(mutex);
+
+  if (cache_path == nullptr)
+    return LoadPNG(png.data, png.size);
+
+  const uint64_t hash = HashBuffer(png);
+  if (auto i = images.find(hash);
+      i != images.end() && i->second.png_size == png.size) {
+    i->second.used = true;
+    return CopyImage(i->second.image);
+  }
+
+  auto image = LoadPNG(png.data, png.size);
+  if (image.IsDefined() &&
+      std::size_t(image.GetPitch()) * image.GetHeight() <= MAX_IMAGE_BYTES) {
+    images.insert_or_assign(hash,
+                            CachedImage{uint32_t(png.size), true,
+                                        CopyImage(image)});
+    modified = true;
+  }
+
+  return image;
+}
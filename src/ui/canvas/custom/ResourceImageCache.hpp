@@ -0,0 +1,80 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_RESOURCE_IMAGE_CACHE_HPP
+#define XCSOAR_RESOURCE_IMAGE_CACHE_HPP
+
+class Path;
+class UncompressedImage;
+template<typename T> struct ConstBuffer;
+
+/**
+ * A persistent cache of decoded PNG resources.  Decoding all icons
+ * is a noticeable part of the startup time on slow devices; with
+ * this cache, only their raw pixels are copied from a file which was
+ * written during the previous run.
+ *
+ * Entries are keyed on a hash of the compressed data, therefore a
+ * new program version with different resources does not need to
+ * invalidate the cache explicitly.  Only small images (i.e. icons)
+ * are cached.
+ */
+namespace ResourceImageCache {
+
+/**
+ * Load the cache file (if it exists) and enable the cache.  Without
+ * this call, Load() just decodes.
+ *
+ * Throws on error; the cache is enabled nonetheless, but it starts
+ * empty.
+ */
+void
+Initialise(Path path);
+
+/**
+ * Write the cache file if it is out of date: i.e. if images were
+ * decoded which were not in the cache or if cached images were not
+ * used.
+ *
+ * Throws on error.
+ */
+void
+Save();
+
+/**
+ * Disable the cache and free all memory.
+ */
+void
+Deinitialise() noexcept;
+
+/**
+ * Decode the specified PNG image, or copy it from the cache.
+ *
+ * Throws on error.
+ */
+UncompressedImage
+Load(ConstBuffer<void> png);
+
+} // namespace ResourceImageCache
+
+#endif
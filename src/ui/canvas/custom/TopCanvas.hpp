@@ -76,6 +76,13 @@ struct _XDisplay;
 #include "../memory/Dither.hpp"
 #endif
 
+#if defined(KOBO) && defined(GREYSCALE)
+/* defined if TopCanvas::Flip() submits only the changed part of the
+   screen to the E-ink controller */
+#define USE_EPD_DAMAGE
+#include "util/AllocatedArray.hxx"
+#endif
+
 #include <cstdint>
 
 #ifdef SOFTWARE_ROTATE_DISPLAY
@@ -196,6 +203,28 @@ class TopCanvas
   bool frame_sync = false;
 #endif
 
+#ifdef USE_EPD_DAMAGE
+  /**
+   * The converted frame being composed by Flip().  It is compared
+   * with #epd_previous_frame to find the region which needs to be
+   * refreshed.  Not used while dithering: Dither::DitherGreyscaleIncremental()
+   * updates #epd_previous_frame in place and reports the changed
+   * region itself.
+   */
+  AllocatedArray<uint8_t> epd_frame;
+
+  /**
+   * The frame which was last copied to the frame buffer.
+   */
+  AllocatedArray<uint8_t> epd_previous_frame;
+
+  /**
+   * If true, the next Flip() refreshes the whole screen, because
+   * #epd_previous_frame is not known to match the screen contents.
+   */
+  bool epd_force_full = true;
+#endif
+
 public:
 #ifndef ANDROID
   ~TopCanvas() {
@@ -304,6 +333,11 @@ public:
 
   void SetEnableDither(bool _enable_dither) {
     enable_dither = _enable_dither;
+#ifdef USE_EPD_DAMAGE
+    /* the waveform depends on this flag; redraw everything with the
+       new one */
+    epd_force_full = true;
+#endif
   }
 #endif
 
@@ -328,6 +362,10 @@ private:
 
   void InitialiseTTY();
   void DeinitialiseTTY();
+
+#ifdef USE_EPD_DAMAGE
+  void AllocateEPDFrames() noexcept;
+#endif
 };
 
 #endif
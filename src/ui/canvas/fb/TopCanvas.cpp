@@ -35,6 +35,7 @@ Copyright_License {
 
 #if defined(KOBO) && defined(USE_FB)
 #include "Kobo/Model.hpp"
+#include "ui/dim/Rect.hpp"
 #include "mxcfb.h"
 #endif
 
@@ -83,6 +84,67 @@ GetSize(const struct fb_var_screeninfo &vinfo)
 
 #endif
 
+#ifdef USE_EPD_DAMAGE
+
+/**
+ * Find the bounding rectangle of all pixels which differ between the
+ * two 8 bit frames.  Returns an empty rectangle if they are equal.
+ */
+[[gnu::pure]]
+static PixelRect
+FindChangedRect(const uint8_t *a, const uint8_t *b,
+                unsigned width, unsigned height) noexcept
+{
+  int top = -1, bottom = -1;
+  unsigned left = width, right = 0;
+
+  for (unsigned y = 0; y < height; ++y, a += width, b += width) {
+    if (memcmp(a, b, width) == 0)
+      continue;
+
+    if (top < 0)
+      top = y;
+    bottom = y + 1;
+
+    /* the row differs, so both loops terminate */
+    unsigned l = 0;
+    while (a[l] == b[l])
+      ++l;
+
+    unsigned r = width;
+    while (a[r - 1] == b[r - 1])
+      --r;
+
+    left = std::min(left, l);
+    right = std::max(right, r);
+  }
+
+  if (top < 0)
+    return PixelRect(0, 0, 0, 0);
+
+  return PixelRect(left, top, right, bottom);
+}
+
+/**
+ * Copy a rectangle of the 8 bit frame to the frame buffer.
+ */
+static void
+CopyRect(uint8_t *dest, unsigned dest_pitch,
+         const uint8_t *src, unsigned src_pitch,
+         const PixelRect &rect) noexcept
+{
+  const unsigned width = rect.GetWidth();
+
+  dest += rect.top * dest_pitch + rect.left;
+  src += rect.top * src_pitch + rect.left;
+
+  for (int y = rect.top; y < rect.bottom;
+       ++y, dest += dest_pitch, src += src_pitch)
+    memcpy(dest, src, width);
+}
+
+#endif
+
 void
 TopCanvas::Destroy()
 {
@@ -214,8 +276,25 @@ TopCanvas::Create(PixelSize new_size,
 #endif
 
   buffer.Allocate(new_size.width, new_size.height);
+
+#ifdef USE_EPD_DAMAGE
+  AllocateEPDFrames();
+#endif
+}
+
+#ifdef USE_EPD_DAMAGE
+
+void
+TopCanvas::AllocateEPDFrames() noexcept
+{
+  const std::size_t n_pixels = std::size_t(buffer.width) * buffer.height;
+  epd_frame.ResizeDiscard(n_pixels);
+  epd_previous_frame.ResizeDiscard(n_pixels);
+  epd_force_full = true;
 }
 
+#endif
+
 #ifdef USE_FB
 
 inline PixelSize
@@ -253,6 +332,11 @@ TopCanvas::CheckResize(const PixelSize new_native_size)
 
   buffer.Free();
   buffer.Allocate(new_size.width, new_size.height);
+
+#ifdef USE_EPD_DAMAGE
+  AllocateEPDFrames();
+#endif
+
   return true;
 }
 
@@ -272,7 +356,53 @@ TopCanvas::Flip()
 {
 #ifdef USE_FB
 
-#ifdef GREYSCALE
+#ifdef USE_EPD_DAMAGE
+  /* convert into a private copy first, and submit only the region
+     which differs from the previous frame; E-ink refreshes are slow,
+     and their duration grows with the refreshed area */
+  const unsigned width = buffer.width, height = buffer.height;
+
+  PixelRect dirty;
+
+#ifdef DITHER
+  if (enable_dither) {
+    /* dither only the rows affected by changes, directly into the
+       previous frame, which tells us which pixels have changed */
+    dirty = dither.DitherGreyscaleIncremental((const uint8_t *)buffer.data,
+                                              buffer.pitch,
+                                              epd_previous_frame.data(),
+                                              width, width, height,
+                                              epd_force_full);
+    if (epd_force_full)
+      dirty = PixelRect(PixelSize(width, height));
+  } else {
+#endif
+    CopyFromGreyscale(
+#ifdef DITHER
+                      dither,
+#endif
+                      enable_dither,
+                      epd_frame.data(), width, 1,
+                      buffer);
+
+    dirty = epd_force_full
+      ? PixelRect(PixelSize(width, height))
+      : FindChangedRect(epd_frame.data(), epd_previous_frame.data(),
+                        width, height);
+    std::swap(epd_frame, epd_previous_frame);
+#ifdef DITHER
+  }
+#endif
+
+  if (dirty.IsEmpty())
+    /* nothing has changed */
+    return;
+
+  epd_force_full = false;
+
+  CopyRect((uint8_t *)map, map_pitch, epd_previous_frame.data(), width,
+           dirty);
+#elif defined(GREYSCALE)
   CopyFromGreyscale(
 #ifdef DITHER
                     dither,
@@ -288,6 +418,10 @@ TopCanvas::Flip()
 
 
 #ifdef KOBO
+#ifndef USE_EPD_DAMAGE
+  const PixelRect dirty(PixelSize(buffer.width, buffer.height));
+#endif
+
   if (frame_sync)
     Wait();
 
@@ -295,7 +429,8 @@ TopCanvas::Flip()
 
   struct mxcfb_update_data epd_update_data = {
     {
-      0, 0, buffer.width, buffer.height
+      uint32_t(dirty.top), uint32_t(dirty.left),
+      dirty.GetWidth(), dirty.GetHeight()
     },
 
     uint32_t(enable_dither &&
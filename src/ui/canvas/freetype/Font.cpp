@@ -29,6 +29,7 @@ Copyright_License {
 #include "Init.hpp"
 #include "Asset.hpp"
 #include "system/Path.hpp"
+#include "util/Cache.hxx"
 
 #ifndef ENABLE_OPENGL
 #include "thread/Mutex.hxx"
@@ -48,6 +49,7 @@ Copyright_License {
 #include FT_FREETYPE_H
 
 #include <algorithm>
+#include <memory>
 
 #include <cassert>
 #include <cstdint>
@@ -94,6 +96,64 @@ FT_CEIL(FT_Long x) noexcept
   return FT_FLOOR(x + 63);
 }
 
+/**
+ * A character of a #FT_Face which was looked up by ForEachGlyph().
+ * The metrics are kept in pixels; the coverage bitmap (one byte
+ * per pixel) is rendered only when the glyph is actually drawn.
+ */
+struct CachedGlyph {
+  /**
+   * The glyph index; 0 if the font has no glyph for this character.
+   */
+  FT_UInt index;
+
+  int bearing_x, bearing_y;
+  unsigned width, advance;
+
+  std::unique_ptr<uint8_t[]> bitmap;
+  unsigned bitmap_width = 0, bitmap_rows = 0;
+  bool rendered = false;
+
+  explicit CachedGlyph(FT_UInt _index) noexcept
+    :index(_index), bearing_x(0), bearing_y(0), width(0), advance(0) {}
+
+  CachedGlyph(FT_UInt _index, const FT_Glyph_Metrics &metrics) noexcept
+    :index(_index),
+     bearing_x(FT_FLOOR(metrics.horiBearingX)),
+     bearing_y(FT_FLOOR(metrics.horiBearingY)),
+     width(FT_CEIL(metrics.width)),
+     advance(FT_CEIL(metrics.horiAdvance)) {}
+
+  CachedGlyph(CachedGlyph &&) noexcept = default;
+  CachedGlyph &operator=(CachedGlyph &&) noexcept = default;
+};
+
+struct GlyphCacheKey {
+  FT_Face face;
+  unsigned ch;
+
+  constexpr bool operator==(const GlyphCacheKey &other) const noexcept {
+    return face == other.face && ch == other.ch;
+  }
+
+  struct Hash {
+    [[gnu::pure]]
+    std::size_t operator()(const GlyphCacheKey &key) const noexcept {
+      return (std::size_t)(const void *)key.face ^ (key.ch * 31u);
+    }
+  };
+};
+
+/**
+ * Glyphs shared by all #Font instances, so repeated text does not
+ * need to be loaded by libfreetype again.  Protected by
+ * #freetype_mutex.
+ */
+static Cache<GlyphCacheKey, CachedGlyph, 1024u, 701u,
+             GlyphCacheKey::Hash> glyph_cache;
+
+static Font::GlyphCacheStatistics glyph_cache_statistics;
+
 [[gnu::pure]]
 static unsigned
 NextChar(TStringView &s) noexcept
@@ -130,9 +190,22 @@ Font::Initialise()
 void
 Font::Deinitialise() noexcept
 {
+  glyph_cache.Clear();
+  glyph_cache_statistics = {};
+
   FreeType::Deinitialise();
 }
 
+Font::GlyphCacheStatistics
+Font::GetGlyphCacheStatistics() noexcept
+{
+#ifndef ENABLE_OPENGL
+  const std::lock_guard<Mutex> lock(freetype_mutex);
+#endif
+
+  return glyph_cache_statistics;
+}
+
 [[gnu::pure]]
 static unsigned
 GetCapitalHeight(FT_Face face) noexcept
@@ -226,6 +299,18 @@ Font::Destroy() noexcept
 
   assert(IsScreenInitialized());
 
+  {
+#ifndef ENABLE_OPENGL
+    const std::lock_guard<Mutex> lock(freetype_mutex);
+#endif
+
+    /* the FT_Face pointer may be reused by the next font */
+    glyph_cache.RemoveIf([this](const GlyphCacheKey &key,
+                                const CachedGlyph &){
+      return key.face == face;
+    });
+  }
+
   ::FT_Done_Face(face);
   face = nullptr;
 }
@@ -245,6 +330,29 @@ ForEachChar(TStringView text, F &&f)
   }
 }
 
+/**
+ * Look up a character in the #glyph_cache, loading it with
+ * libfreetype on a miss.  The caller must hold #freetype_mutex.
+ */
+static CachedGlyph &
+GetGlyph(const FT_Face face, unsigned ch) noexcept
+{
+  const GlyphCacheKey key{face, ch};
+  CachedGlyph *cached = glyph_cache.Get(key);
+  if (cached != nullptr) {
+    ++glyph_cache_statistics.hits;
+    return *cached;
+  }
+
+  ++glyph_cache_statistics.misses;
+
+  const FT_UInt i = FT_Get_Char_Index(face, ch);
+  if (i == 0 || FT_Load_Glyph(face, i, load_flags) != 0)
+    return glyph_cache.Put(key, CachedGlyph(0));
+
+  return glyph_cache.Put(key, CachedGlyph(i, face->glyph->metrics));
+}
+
 template<typename T, typename F>
 static void
 ForEachGlyph(const FT_Face face, unsigned ascent_height, T &&text,
@@ -262,17 +370,11 @@ ForEachGlyph(const FT_Face face, unsigned ascent_height, T &&text,
   ForEachChar(std::forward<T>(text),
               [face, ascent_height, &f, use_kerning,
                &x, &prev_index](unsigned ch){
-      const FT_UInt i = FT_Get_Char_Index(face, ch);
+      CachedGlyph &glyph = GetGlyph(face, ch);
+      const FT_UInt i = glyph.index;
       if (i == 0)
         return;
 
-      const FT_Error error = FT_Load_Glyph(face, i, load_flags);
-      if (error)
-        return;
-
-      const FT_GlyphSlot glyph = face->glyph;
-      const FT_Glyph_Metrics &metrics = glyph->metrics;
-
       if (use_kerning) {
         if (prev_index != 0 && i != 0) {
           FT_Vector delta;
@@ -284,11 +386,11 @@ ForEachGlyph(const FT_Face face, unsigned ascent_height, T &&text,
         prev_index = i;
       }
 
-      f(x + FT_FLOOR(metrics.horiBearingX),
-        ascent_height - FT_FLOOR(metrics.horiBearingY),
+      f(x + glyph.bearing_x,
+        ascent_height - glyph.bearing_y,
         glyph);
 
-      x += FT_CEIL(metrics.horiAdvance);
+      x += glyph.advance;
     });
 }
 
@@ -298,10 +400,9 @@ Font::TextSize(TStringView text) const noexcept
   int maxx = 0;
 
   ForEachGlyph(face, ascent_height, text,
-               [&maxx](int x, int y, const FT_GlyphSlot glyph){
-      const FT_Glyph_Metrics &metrics = glyph->metrics;
-      const int glyph_minx = FT_FLOOR(metrics.horiBearingX);
-      const int glyph_maxx = glyph_minx + FT_CEIL(metrics.width);
+               [&maxx](int x, int y, const CachedGlyph &glyph){
+      const int glyph_minx = glyph.bearing_x;
+      const int glyph_maxx = glyph_minx + glyph.width;
 
       int z = x + glyph_maxx;
       if (z > maxx)
@@ -321,12 +422,9 @@ MixLine(uint8_t *dest, const uint8_t *src, size_t n) noexcept
 
 static void
 RenderGlyph(uint8_t *buffer, unsigned buffer_width, unsigned buffer_height,
-            const FT_Bitmap &bitmap, int x, int y) noexcept
+            const uint8_t *src, int width, int height, int pitch,
+            int x, int y) noexcept
 {
-  const uint8_t *src = (const uint8_t *)bitmap.buffer;
-  int width = bitmap.width, height = bitmap.rows;
-  int pitch = bitmap.pitch;
-
   if (x < 0) {
     src -= x;
     width += x;
@@ -369,36 +467,53 @@ ConvertMono(unsigned char *dest, const unsigned char *src, unsigned n) noexcept
     *dest++ = (*src & i) ? 0xff : 0x00;
 }
 
+/**
+ * Render the glyph with libfreetype and store its coverage bitmap
+ * in the #CachedGlyph.  The caller must hold #freetype_mutex.
+ */
 static void
-ConvertMono(FT_Bitmap &dest, const FT_Bitmap &src) noexcept
+RenderCachedGlyph(FT_Face face, CachedGlyph &glyph) noexcept
 {
-  dest = src;
-  dest.pitch = dest.width;
-  dest.buffer = new unsigned char[dest.pitch * dest.rows];
-
-  unsigned char *d = dest.buffer, *s = src.buffer;
-  for (unsigned y = 0; y < unsigned(dest.rows);
-       ++y, d += dest.pitch, s += src.pitch)
-    ConvertMono(d, s, dest.width);
+  glyph.rendered = true;
+
+  if (FT_Load_Glyph(face, glyph.index, load_flags) != 0 ||
+      FT_Render_Glyph(face->glyph, render_mode) != 0)
+    return;
+
+  const FT_Bitmap &src = face->glyph->bitmap;
+  const unsigned width = src.width, rows = src.rows;
+  if (width == 0 || rows == 0)
+    return;
+
+  glyph.bitmap.reset(new uint8_t[width * rows]);
+  glyph.bitmap_width = width;
+  glyph.bitmap_rows = rows;
+
+  uint8_t *d = glyph.bitmap.get();
+  const unsigned char *s = src.buffer;
+  for (unsigned y = 0; y < rows; ++y, d += width, s += src.pitch) {
+    if (IsMono())
+      /* with anti-aliasing disabled, FreeType writes each pixel in
+         one bit; convert it to 1 byte per pixel */
+      ConvertMono(d, s, width);
+    else
+      std::copy_n(s, width, d);
+  }
 }
 
 static void
 RenderGlyph(uint8_t *buffer, size_t width, size_t height,
-            FT_GlyphSlot glyph, int x, int y) noexcept
+            FT_Face face, CachedGlyph &glyph, int x, int y) noexcept
 {
-  FT_Error error = FT_Render_Glyph(glyph, render_mode);
-  if (error)
+  if (!glyph.rendered)
+    RenderCachedGlyph(face, glyph);
+
+  if (glyph.bitmap == nullptr)
     return;
 
-  if (IsMono()) {
-    /* with anti-aliasing disabled, FreeType writes each pixel in one
-       bit; hack: convert it to 1 byte per pixel and then render it */
-    FT_Bitmap bitmap;
-    ConvertMono(bitmap, glyph->bitmap);
-    RenderGlyph(buffer, width, height, bitmap, x, y);
-    delete[] bitmap.buffer;
-  } else
-    RenderGlyph(buffer, width, height, glyph->bitmap, x, y);
+  RenderGlyph(buffer, width, height, glyph.bitmap.get(),
+              glyph.bitmap_width, glyph.bitmap_rows, glyph.bitmap_width,
+              x, y);
 }
 
 void
@@ -408,9 +523,10 @@ Font::Render(TStringView text, const PixelSize size,
   uint8_t *buffer = (uint8_t *)_buffer;
   std::fill_n(buffer, BufferSize(size), 0);
 
+  const FT_Face face = this->face;
   ForEachGlyph(face, ascent_height, text,
-               [size, buffer](int x, int y, const FT_GlyphSlot glyph){
-      RenderGlyph(buffer, size.width, size.height, glyph,
+               [face, size, buffer](int x, int y, CachedGlyph &glyph){
+      RenderGlyph(buffer, size.width, size.height, face, glyph,
                   x, y);
     });
 }
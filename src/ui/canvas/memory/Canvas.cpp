@@ -456,6 +456,23 @@ Canvas::StretchTransparentWhite(PixelPoint dest_position, PixelSize dest_size,
                         operations);
 }
 
+void
+Canvas::StretchAffine(ConstImageBuffer src, IntPoint2D origin,
+                      IntPoint2D step_x, IntPoint2D step_y,
+                      bool transparent_white) noexcept
+{
+  SDLRasterCanvas canvas(buffer);
+
+  if (transparent_white) {
+    TransparentPixelOperations<ActivePixelTraits> operations(canvas.Import(COLOR_WHITE));
+    canvas.TransformRectangle(src.data, src.pitch, {src.width, src.height},
+                              origin, step_x, step_y,
+                              operations);
+  } else
+    canvas.TransformRectangle(src.data, src.pitch, {src.width, src.height},
+                              origin, step_x, step_y);
+}
+
 void
 Canvas::StretchNot(const Bitmap &_src)
 {
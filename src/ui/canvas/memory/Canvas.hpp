@@ -340,6 +340,16 @@ public:
 
   void StretchNot(const Bitmap &src);
 
+  /**
+   * Fill the whole canvas from an affinely transformed (e.g. rotated)
+   * image, see RasterCanvas::TransformRectangle().
+   *
+   * @param transparent_white skip white source pixels
+   */
+  void StretchAffine(ConstImageBuffer src, IntPoint2D origin,
+                     IntPoint2D step_x, IntPoint2D step_y,
+                     bool transparent_white=false) noexcept;
+
   void Stretch(PixelPoint dest_position, PixelSize dest_size,
                ConstImageBuffer src,
                PixelPoint src_position, PixelSize src_size) noexcept;
@@ -25,9 +25,49 @@ Copyright_License {
 
 #include <algorithm>
 
+#include <string.h>
+
 // Code adapted from imx.60 linux kernel EPD driver by Daiyu Ko <dko@freescale.com>
 //
 
+inline void
+Dither::DitherRow(const uint8_t *gcc_restrict src,
+                  uint8_t *gcc_restrict dest, unsigned width,
+                  ErrorDistType *gcc_restrict err_dist_l0,
+                  ErrorDistType *gcc_restrict err_dist_l1) noexcept
+{
+  int e0 = *err_dist_l0++;
+  int e1 = *err_dist_l1;
+
+  /* scan the line and convert the Y8 to BW */
+  for (unsigned column = 0; column < width; ++column) {
+    ErrorDistType bwPix = e0 + src[column];
+
+    uint8_t color = 0;
+    if (bwPix >= 128) {
+      --color;
+      bwPix -= 255;
+    }
+
+    dest[column] = color;
+
+    /* modify the error distribution buffer */
+
+    // SIERRA LITE
+    bwPix >>= 1;
+
+    e0 = *err_dist_l0 + bwPix;
+    *err_dist_l0++ = e0;
+
+    bwPix >>= 1;
+
+    *err_dist_l1++ = e1 + bwPix;
+    e1 = bwPix;
+  }
+
+  *err_dist_l1 = e1;
+}
+
 void
 Dither::DitherGreyscale(const uint8_t *gcc_restrict src,
                         unsigned src_pitch,
@@ -46,38 +86,119 @@ Dither::DitherGreyscale(const uint8_t *gcc_restrict src,
     ErrorDistType *gcc_restrict err_dist_l1 =
       error_dist_buffer + ((height & 1) ? 0 : width_2);
 
-    int e0 = *err_dist_l0++;
-    int e1 = *err_dist_l1;
+    DitherRow(src, dest, width, err_dist_l0, err_dist_l1);
+
+    src += src_pitch;
+    dest += dest_pitch;
+  }
+}
 
-    /* scan the line and convert the Y8 to BW */
-    for (unsigned column = 0; column < width; ++column) {
-      ErrorDistType bwPix = e0 + src[column];
+PixelRect
+Dither::DitherGreyscaleIncremental(const uint8_t *gcc_restrict src,
+                                   unsigned src_pitch,
+                                   uint8_t *gcc_restrict dest,
+                                   unsigned dest_pitch,
+                                   unsigned width, unsigned height,
+                                   bool reset) noexcept
+{
+  const unsigned width_2 = width + 2;
+  const unsigned state_size = width_2 * 2u;
+
+  if (width != previous_width || height != previous_height) {
+    previous_width = width;
+    previous_height = height;
+    previous_src.ResizeDiscard(width * height);
+    checkpoints.ResizeDiscard((height + CHECKPOINT_INTERVAL - 1)
+                              / CHECKPOINT_INTERVAL * state_size);
+    line.ResizeDiscard(width);
+    reset = true;
+  }
 
-      uint8_t color = 0;
-      if (bwPix >= 128) {
-        --color;
-        bwPix -= 255;
-      }
+  /* find the rows which have changed since the previous call */
 
-      dest[column] = color;
+  unsigned top = 0, bottom = height;
+  if (!reset) {
+    while (top < height &&
+           memcmp(src + top * src_pitch,
+                  previous_src.data() + top * width, width) == 0)
+      ++top;
 
-      /* modify the error distribution buffer */
+    if (top == height)
+      /* nothing has changed */
+      return PixelRect(0, 0, 0, 0);
 
-      // SIERRA LITE
-      bwPix >>= 1;
+    while (memcmp(src + (bottom - 1) * src_pitch,
+                  previous_src.data() + (bottom - 1) * width, width) == 0)
+      --bottom;
+  }
 
-      e0 = *err_dist_l0 + bwPix;
-      *err_dist_l0++ = e0;
+  /* load the error distribution at the checkpoint above the first
+     changed row; the rows above it will not change */
 
-      bwPix >>= 1;
+  allocated_error_dist_buffer.GrowDiscard(state_size);
+  ErrorDistType *const error_dist_buffer = allocated_error_dist_buffer.begin();
 
-      *err_dist_l1++ = e1 + bwPix;
-      e1 = bwPix;
+  unsigned y = top / CHECKPOINT_INTERVAL * CHECKPOINT_INTERVAL;
+  if (y == 0)
+    std::fill_n(error_dist_buffer, state_size, 0);
+  else
+    std::copy_n(checkpoints.data() + y / CHECKPOINT_INTERVAL * state_size,
+                state_size, error_dist_buffer);
+
+  int dirty_top = -1, dirty_bottom = -1;
+  unsigned dirty_left = width, dirty_right = 0;
+
+  for (; y < height; ++y) {
+    if (y % CHECKPOINT_INTERVAL == 0) {
+      ErrorDistType *checkpoint =
+        checkpoints.data() + y / CHECKPOINT_INTERVAL * state_size;
+
+      if (!reset && y >= bottom &&
+          std::equal(error_dist_buffer, error_dist_buffer + state_size,
+                     checkpoint))
+        /* same error distribution and same source pixels as in the
+           previous frame: the rest of the frame is unchanged */
+        break;
+
+      std::copy_n(error_dist_buffer, state_size, checkpoint);
     }
 
-    *err_dist_l1 = e1;
+    /* the same row parity as in DitherGreyscale() */
+    const unsigned remaining = height - y;
+    ErrorDistType *gcc_restrict err_dist_l0 =
+      error_dist_buffer + ((remaining & 1) ? width_2 : 0) + 1;
+    ErrorDistType *gcc_restrict err_dist_l1 =
+      error_dist_buffer + ((remaining & 1) ? 0 : width_2);
+
+    const uint8_t *src_row = src + y * src_pitch;
+    DitherRow(src_row, line.data(), width, err_dist_l0, err_dist_l1);
+    std::copy_n(src_row, width, previous_src.data() + y * width);
 
-    src += src_pitch;
-    dest += dest_pitch;
+    uint8_t *dest_row = dest + y * dest_pitch;
+    const uint8_t *new_row = line.data();
+    if (memcmp(dest_row, new_row, width) == 0)
+      continue;
+
+    /* the row differs, so both loops terminate */
+    unsigned l = 0;
+    while (dest_row[l] == new_row[l])
+      ++l;
+
+    unsigned r = width;
+    while (dest_row[r - 1] == new_row[r - 1])
+      --r;
+
+    std::copy(new_row + l, new_row + r, dest_row + l);
+
+    if (dirty_top < 0)
+      dirty_top = y;
+    dirty_bottom = y + 1;
+    dirty_left = std::min(dirty_left, l);
+    dirty_right = std::max(dirty_right, r);
   }
+
+  if (dirty_top < 0)
+    return PixelRect(0, 0, 0, 0);
+
+  return PixelRect(dirty_left, dirty_top, dirty_right, dirty_bottom);
 }
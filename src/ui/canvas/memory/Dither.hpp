@@ -24,6 +24,7 @@ Copyright_License {
 #ifndef XCSOAR_SCREEN_DITHER_HPP
 #define XCSOAR_SCREEN_DITHER_HPP
 
+#include "ui/dim/Rect.hpp"
 #include "util/AllocatedArray.hxx"
 #include "util/Compiler.h"
 
@@ -34,12 +35,53 @@ class Dither {
 
   AllocatedArray<ErrorDistType> allocated_error_dist_buffer;
 
+  /**
+   * DitherGreyscaleIncremental() saves the error distribution state
+   * every this many rows.
+   */
+  static constexpr unsigned CHECKPOINT_INTERVAL = 32;
+
+  /**
+   * State of DitherGreyscaleIncremental(): a copy of the previous
+   * source frame, the error distribution checkpoints of the
+   * previous run and one output line.
+   */
+  AllocatedArray<uint8_t> previous_src;
+  AllocatedArray<ErrorDistType> checkpoints;
+  AllocatedArray<uint8_t> line;
+  unsigned previous_width = 0, previous_height = 0;
+
 public:
   void DitherGreyscale(const uint8_t *gcc_restrict src,
                        unsigned src_pitch,
                        uint8_t *gcc_restrict dest,
                        unsigned dest_pitch,
                        unsigned width, unsigned height) noexcept;
+
+  /**
+   * Like DitherGreyscale(), but #dest must still contain the result
+   * of the previous call.  Only the rows affected by source changes
+   * since then are recalculated: dithering starts at the checkpoint
+   * above the first changed row, and stops below the last changed
+   * row as soon as the error distribution matches the previous
+   * frame's.  The result is identical to DitherGreyscale().
+   *
+   * @param reset true if #dest does not contain the previous result
+   * (e.g. on the first call)
+   * @return the rectangle of #dest pixels which were modified
+   */
+  PixelRect DitherGreyscaleIncremental(const uint8_t *gcc_restrict src,
+                                       unsigned src_pitch,
+                                       uint8_t *gcc_restrict dest,
+                                       unsigned dest_pitch,
+                                       unsigned width, unsigned height,
+                                       bool reset) noexcept;
+
+private:
+  static void DitherRow(const uint8_t *gcc_restrict src,
+                        uint8_t *gcc_restrict dest, unsigned width,
+                        ErrorDistType *gcc_restrict err_dist_l0,
+                        ErrorDistType *gcc_restrict err_dist_l1) noexcept;
 };
 
 #endif
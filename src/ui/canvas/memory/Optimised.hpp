@@ -30,7 +30,9 @@ Copyright_License {
 #include "NEON.hpp"
 #endif
 
-#ifdef __MMX__
+#ifdef __SSE2__
+#include "SSE2.hpp"
+#elif defined(__MMX__)
 #include "MMX.hpp"
 #endif
 
@@ -115,6 +117,46 @@ struct TransparentPixelOperations<GreyscalePixelTraits>
 
 #endif
 
+#ifdef __SSE2__
+
+template<>
+struct BitOrPixelOperations<GreyscalePixelTraits>
+  : SelectOptimisedPixelOperations<SSE2BitOrPixelOperations, 16,
+                                   PortableBitOrPixelOperations<GreyscalePixelTraits>> {
+};
+
+template<>
+struct TransparentPixelOperations<GreyscalePixelTraits>
+  : public SelectOptimisedPixelOperations<SSE2TransparentPixelOperations, 16,
+                                          PortableTransparentPixelOperations<GreyscalePixelTraits>> {
+  typedef typename PixelTraits::color_type color_type;
+
+  explicit TransparentPixelOperations(const color_type key)
+    :SelectOptimisedPixelOperations(key) {}
+};
+
+#ifndef GREYSCALE
+
+template<>
+struct BitOrPixelOperations<BGRAPixelTraits>
+  : SelectOptimisedPixelOperations<SSE2BitOrPixelOperations, 4,
+                                   PortableBitOrPixelOperations<BGRAPixelTraits>> {
+};
+
+template<>
+struct TransparentPixelOperations<BGRAPixelTraits>
+  : public SelectOptimisedPixelOperations<SSE2TransparentPixelOperations, 4,
+                                          PortableTransparentPixelOperations<BGRAPixelTraits>> {
+  typedef typename PixelTraits::color_type color_type;
+
+  explicit TransparentPixelOperations(const color_type key)
+    :SelectOptimisedPixelOperations(key) {}
+};
+
+#endif /* !GREYSCALE */
+
+#endif
+
 template<typename PixelTraits>
 class AlphaPixelOperations
   : public PortableAlphaPixelOperations<PixelTraits> {
@@ -136,7 +178,31 @@ public:
 
 #endif
 
-#ifdef __MMX__
+#ifdef __SSE2__
+
+template<>
+class AlphaPixelOperations<GreyscalePixelTraits>
+  : public SelectOptimisedPixelOperations<SSE2AlphaPixelOperations, 16,
+                                          PortableAlphaPixelOperations<GreyscalePixelTraits>> {
+public:
+  explicit constexpr AlphaPixelOperations(const uint8_t alpha)
+    :SelectOptimisedPixelOperations(alpha) {}
+};
+
+#ifndef GREYSCALE
+
+template<>
+class AlphaPixelOperations<BGRAPixelTraits>
+  : public SelectOptimisedPixelOperations<SSE2AlphaPixelOperations, 4,
+                                          PortableAlphaPixelOperations<BGRAPixelTraits>> {
+public:
+  explicit constexpr AlphaPixelOperations(const uint8_t alpha)
+    :SelectOptimisedPixelOperations(alpha) {}
+};
+
+#endif /* !GREYSCALE */
+
+#elif defined(__MMX__)
 
 template<>
 class AlphaPixelOperations<GreyscalePixelTraits>
@@ -28,10 +28,13 @@ Copyright_License {
 #include "Bresenham.hpp"
 #include "Murphy.hpp"
 #include "ui/dim/Point.hpp"
+#include "ui/dim/Size.hpp"
 #include "util/AllocatedArray.hxx"
 #include "util/Compiler.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
 
 /*
   line_masks:
@@ -916,6 +919,87 @@ public:
                    src, src_pitch, src_size,
                    GetPixelTraits());
   }
+
+private:
+  static constexpr int64_t FloorDiv(int64_t n, int64_t d) noexcept {
+    int64_t q = n / d;
+    if (n % d != 0 && (n < 0) != (d < 0))
+      --q;
+    return q;
+  }
+
+  /**
+   * Intersect the span [x0, x1) with the values of x where
+   * 0 <= a + b * x < limit.
+   */
+  static constexpr void ClipAffineSpan(int64_t a, int64_t b, int64_t limit,
+                                       int &x0, int &x1) noexcept {
+    if (b == 0) {
+      if (a < 0 || a >= limit)
+        x1 = x0;
+      return;
+    }
+
+    int64_t first, last;
+    if (b > 0) {
+      first = -FloorDiv(a, b);
+      last = FloorDiv(limit - 1 - a, b);
+    } else {
+      first = -FloorDiv(limit - 1 - a, -b);
+      last = FloorDiv(a, -b);
+    }
+
+    x0 = std::max<int64_t>(x0, first);
+    x1 = std::min<int64_t>(x1, last + 1);
+  }
+
+public:
+  /**
+   * Fill the whole buffer from an affinely transformed (e.g. rotated)
+   * source image: the pixel (x, y) is read from the source at
+   * origin + x * step_x + y * step_y, all in 16.16 fixed point
+   * source pixels.  Destination pixels which map outside of the
+   * source are not modified.
+   *
+   * The source range of each row is clipped in advance, so the inner
+   * loop only needs two additions per pixel.
+   */
+  template<typename PixelOperations, typename SPT=PixelTraits>
+  void TransformRectangle(typename SPT::const_rpointer src, unsigned src_pitch,
+                          PixelSize src_size,
+                          IntPoint2D origin,
+                          IntPoint2D step_x, IntPoint2D step_y,
+                          PixelOperations operations) noexcept {
+    const int64_t limit_x = int64_t(src_size.width) << 16;
+    const int64_t limit_y = int64_t(src_size.height) << 16;
+
+    rpointer dest = At(0, 0);
+    for (unsigned y = 0; y < buffer.height; ++y,
+           dest = PixelTraits::NextRow(dest, buffer.pitch, 1)) {
+      const int64_t row_x = origin.x + int64_t(step_y.x) * y;
+      const int64_t row_y = origin.y + int64_t(step_y.y) * y;
+
+      int x0 = 0, x1 = buffer.width;
+      ClipAffineSpan(row_x, step_x.x, limit_x, x0, x1);
+      ClipAffineSpan(row_y, step_x.y, limit_y, x0, x1);
+
+      int sx = int(row_x + int64_t(step_x.x) * x0);
+      int sy = int(row_y + int64_t(step_x.y) * x0);
+      for (int x = x0; x < x1; ++x, sx += step_x.x, sy += step_x.y)
+        operations.WritePixel(PixelTraits::Next(dest, x),
+                              SPT::ReadPixel(SPT::At(src, src_pitch,
+                                                     sx >> 16, sy >> 16)));
+    }
+  }
+
+  void TransformRectangle(const_rpointer src, unsigned src_pitch,
+                          PixelSize src_size,
+                          IntPoint2D origin,
+                          IntPoint2D step_x, IntPoint2D step_y) noexcept {
+    TransformRectangle(src, src_pitch, src_size,
+                       origin, step_x, step_y,
+                       GetPixelTraits());
+  }
 };
 
 #endif
@@ -59,3 +59,18 @@ RawBitmap::StretchTo(PixelSize src_size,
     dest_canvas.Stretch({0, 0}, dest_size,
                         src, {0, 0}, src_size);
 }
+
+void
+RawBitmap::TransformTo(PixelSize src_size, Canvas &dest_canvas,
+                       IntPoint2D origin, IntPoint2D step_x, IntPoint2D step_y,
+                       bool transparent_white) const
+{
+  assert(src_size.width <= width);
+  assert(src_size.height <= height);
+
+  ConstImageBuffer<ActivePixelTraits> src(ActivePixelTraits::const_pointer(GetBuffer()),
+                                          corrected_width * sizeof(*GetBuffer()),
+                                          src_size.width, src_size.height);
+
+  dest_canvas.StretchAffine(src, origin, step_x, step_y, transparent_white);
+}
@@ -0,0 +1,218 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_SCREEN_SSE2_HPP
+#define XCSOAR_SCREEN_SSE2_HPP
+
+#include "ui/canvas/PortableColor.hpp"
+
+#ifndef __SSE2__
+#error SSE2 required
+#endif
+
+#include <emmintrin.h>
+
+#include <string.h>
+
+#if CLANG_OR_GCC_VERSION(4,8)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wcast-align"
+#endif
+
+/**
+ * Implementation of BitOrPixelOperations using Intel SSE2
+ * instructions.
+ */
+class SSE2BitOrPixelOperations {
+public:
+  gcc_flatten
+  void CopyPixels(uint8_t *gcc_restrict p,
+                  const uint8_t *gcc_restrict q, unsigned n) const {
+    for (unsigned i = 0; i < n / 16; ++i, p += 16, q += 16) {
+      __m128i pv = _mm_loadu_si128((const __m128i *)p);
+      __m128i qv = _mm_loadu_si128((const __m128i *)q);
+      _mm_storeu_si128((__m128i *)p, _mm_or_si128(pv, qv));
+    }
+  }
+
+  void CopyPixels(Luminosity8 *p, const Luminosity8 *q, unsigned n) const {
+    CopyPixels((uint8_t *)p, (const uint8_t *)q, n);
+  }
+
+  void CopyPixels(BGRA8Color *p, const BGRA8Color *q, unsigned n) const {
+    CopyPixels((uint8_t *)p, (const uint8_t *)q, n * 4);
+  }
+};
+
+/**
+ * Implementation of TransparentPixelOperations using Intel SSE2
+ * instructions.
+ */
+class SSE2TransparentPixelOperations {
+  __m128i key;
+
+public:
+  explicit SSE2TransparentPixelOperations(Luminosity8 _key)
+    :key(_mm_set1_epi8(_key.GetLuminosity())) {}
+
+  explicit SSE2TransparentPixelOperations(BGRA8Color _key)
+    :key(_mm_set1_epi32(ToInteger(_key))) {}
+
+  gcc_always_inline
+  static __m128i Blend(__m128i p, __m128i q, __m128i mask) {
+    /* keep the destination where the source matches the key */
+    return _mm_or_si128(_mm_and_si128(mask, p), _mm_andnot_si128(mask, q));
+  }
+
+  gcc_flatten
+  void CopyPixels(Luminosity8 *gcc_restrict p,
+                  const Luminosity8 *gcc_restrict q, unsigned n) const {
+    __m128i *p2 = (__m128i *)p;
+    const __m128i *q2 = (const __m128i *)q;
+
+    for (unsigned i = 0; i < n / 16; ++i) {
+      __m128i pv = _mm_loadu_si128(p2 + i);
+      __m128i qv = _mm_loadu_si128(q2 + i);
+      _mm_storeu_si128(p2 + i, Blend(pv, qv, _mm_cmpeq_epi8(qv, key)));
+    }
+  }
+
+  gcc_flatten
+  void CopyPixels(BGRA8Color *gcc_restrict p,
+                  const BGRA8Color *gcc_restrict q, unsigned n) const {
+    __m128i *p2 = (__m128i *)p;
+    const __m128i *q2 = (const __m128i *)q;
+
+    for (unsigned i = 0; i < n / 4; ++i) {
+      __m128i pv = _mm_loadu_si128(p2 + i);
+      __m128i qv = _mm_loadu_si128(q2 + i);
+      _mm_storeu_si128(p2 + i, Blend(pv, qv, _mm_cmpeq_epi32(qv, key)));
+    }
+  }
+
+private:
+  static int ToInteger(BGRA8Color c) {
+    int i;
+    static_assert(sizeof(c) == sizeof(i), "Wrong BGRA8Color size");
+    memcpy(&i, &c, sizeof(i));
+    return i;
+  }
+};
+
+/**
+ * Implementation of AlphaPixelOperations using Intel SSE2
+ * instructions.  This produces the same results as
+ * #MMXAlphaPixelOperations, but processes 16 bytes at a time.
+ */
+class SSE2AlphaPixelOperations {
+  uint8_t alpha;
+
+public:
+  constexpr SSE2AlphaPixelOperations(uint8_t _alpha):alpha(_alpha) {}
+
+  gcc_hot gcc_always_inline
+  static __m128i FillPixel(__m128i x, __m128i v_alpha, __m128i v_color) {
+    x = _mm_mullo_epi16(x, v_alpha);
+    x = _mm_add_epi16(x, v_color);
+    return _mm_srli_epi16(x, 8);
+  }
+
+  gcc_hot gcc_flatten gcc_nonnull_all
+  void FillPixels(uint8_t *p, unsigned n, __m128i v_color) const {
+    const __m128i v_alpha = _mm_set1_epi16(alpha ^ 0xff);
+    const __m128i zero = _mm_setzero_si128();
+
+    __m128i *p2 = (__m128i *)p;
+
+    for (unsigned i = 0; i < n / 16; ++i) {
+      __m128i x = _mm_loadu_si128(p2 + i);
+
+      __m128i lo = FillPixel(_mm_unpacklo_epi8(x, zero), v_alpha, v_color);
+      __m128i hi = FillPixel(_mm_unpackhi_epi8(x, zero), v_alpha, v_color);
+
+      _mm_storeu_si128(p2 + i, _mm_packus_epi16(lo, hi));
+    }
+  }
+
+  gcc_hot
+  void FillPixels(Luminosity8 *p, unsigned n, Luminosity8 c) const {
+    FillPixels((uint8_t *)p, n,
+               _mm_set1_epi16(c.GetLuminosity() * alpha));
+  }
+
+  gcc_hot
+  void FillPixels(BGRA8Color *p, unsigned n, BGRA8Color c) const {
+    __m128i v_alpha = _mm_set1_epi16(alpha);
+    __m128i v_color = _mm_setr_epi16(c.Blue(), c.Green(), c.Red(), c.Alpha(),
+                                     c.Blue(), c.Green(), c.Red(), c.Alpha());
+
+    FillPixels((uint8_t *)p, n * 4, _mm_mullo_epi16(v_color, v_alpha));
+  }
+
+  gcc_hot gcc_always_inline
+  static __m128i AlphaBlend8(__m128i p, __m128i q,
+                             __m128i alpha, __m128i inverse_alpha) {
+    p = _mm_mullo_epi16(p, inverse_alpha);
+    q = _mm_mullo_epi16(q, alpha);
+    return _mm_srli_epi16(_mm_add_epi16(p, q), 8);
+  }
+
+  gcc_flatten
+  void CopyPixels(uint8_t *gcc_restrict p,
+                  const uint8_t *gcc_restrict q, unsigned n) const {
+    const __m128i v_alpha = _mm_set1_epi16(alpha);
+    const __m128i inverse_alpha = _mm_set1_epi16(alpha ^ 0xff);
+    const __m128i zero = _mm_setzero_si128();
+
+    __m128i *p2 = (__m128i *)p;
+    const __m128i *q2 = (const __m128i *)q;
+
+    for (unsigned i = 0; i < n / 16; ++i) {
+      __m128i pv = _mm_loadu_si128(p2 + i), qv = _mm_loadu_si128(q2 + i);
+
+      __m128i lo = AlphaBlend8(_mm_unpacklo_epi8(pv, zero),
+                               _mm_unpacklo_epi8(qv, zero),
+                               v_alpha, inverse_alpha);
+
+      __m128i hi = AlphaBlend8(_mm_unpackhi_epi8(pv, zero),
+                               _mm_unpackhi_epi8(qv, zero),
+                               v_alpha, inverse_alpha);
+
+      _mm_storeu_si128(p2 + i, _mm_packus_epi16(lo, hi));
+    }
+  }
+
+  void CopyPixels(Luminosity8 *p, const Luminosity8 *q, unsigned n) const {
+    CopyPixels((uint8_t *)p, (const uint8_t *)q, n);
+  }
+
+  void CopyPixels(BGRA8Color *p, const BGRA8Color *q, unsigned n) const {
+    CopyPixels((uint8_t *)p, (const uint8_t *)q, n * 4);
+  }
+};
+
+#if CLANG_OR_GCC_VERSION(4,8)
+#pragma GCC diagnostic pop
+#endif
+
+#endif
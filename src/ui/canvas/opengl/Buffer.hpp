@@ -147,4 +147,8 @@ public:
 class GLArrayBuffer : public GLBuffer<GL_ARRAY_BUFFER, GL_STATIC_DRAW> {
 };
 
+class GLElementArrayBuffer
+  : public GLBuffer<GL_ELEMENT_ARRAY_BUFFER, GL_STATIC_DRAW> {
+};
+
 #endif
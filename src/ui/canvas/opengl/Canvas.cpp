@@ -28,6 +28,7 @@ Copyright_License {
 #include "Scope.hpp"
 #include "VertexArray.hpp"
 #include "Shapes.hpp"
+#include "Statistics.hpp"
 #include "Buffer.hpp"
 #include "VertexPointer.hpp"
 #include "ExactPixelPoint.hpp"
@@ -119,7 +120,7 @@ Canvas::DrawFilledRectangle(PixelRect r, const Color color) noexcept
   };
 
   const ScopeVertexPointer vp(vertices);
-  glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+  OpenGL::DrawArrays(GL_TRIANGLE_STRIP, 0, 4);
 }
 
 void
@@ -136,7 +137,7 @@ Canvas::DrawOutlineRectangleGL(PixelRect r) noexcept
   };
 
   const ScopeVertexPointer vp(vertices);
-  glDrawArrays(GL_LINE_LOOP, 0, 4);
+  OpenGL::DrawArrays(GL_LINE_LOOP, 0, 4);
 }
 
 void
@@ -163,7 +164,7 @@ Canvas::DrawPolyline(const BulkPixelPoint *points, unsigned num_points)
   pen.Bind();
 
   const ScopeVertexPointer vp(points);
-  glDrawArrays(GL_LINE_STRIP, 0, num_points);
+  OpenGL::DrawArrays(GL_LINE_STRIP, 0, num_points);
 
   pen.Unbind();
 }
@@ -185,21 +186,21 @@ Canvas::DrawPolygon(const BulkPixelPoint *points, unsigned num_points)
     unsigned idx_count = PolygonToTriangles(points, num_points,
                                             triangle_buffer);
     if (idx_count > 0)
-      glDrawElements(GL_TRIANGLES, idx_count, GL_UNSIGNED_SHORT,
-                     triangle_buffer.begin());
+      OpenGL::DrawElements(GL_TRIANGLES, idx_count, GL_UNSIGNED_SHORT,
+                           triangle_buffer.begin());
   }
 
   if (IsPenOverBrush()) {
     pen.Bind();
 
     if (pen.GetWidth() <= 2) {
-      glDrawArrays(GL_LINE_LOOP, 0, num_points);
+      OpenGL::DrawArrays(GL_LINE_LOOP, 0, num_points);
     } else {
       unsigned vertices = LineToTriangles(points, num_points, vertex_buffer,
                                           pen.GetWidth(), true);
       if (vertices > 0) {
         vp.Update(vertex_buffer.begin());
-        glDrawArrays(GL_TRIANGLE_STRIP, 0, vertices);
+        OpenGL::DrawArrays(GL_TRIANGLE_STRIP, 0, vertices);
       }
     }
 
@@ -207,6 +208,36 @@ Canvas::DrawPolygon(const BulkPixelPoint *points, unsigned num_points)
   }
 }
 
+void
+Canvas::DrawPolygonBuffer(const glm::mat4 &modelview,
+                          const FloatPoint2D *points, unsigned num_points,
+                          const GLushort *indices,
+                          unsigned num_indices) noexcept
+{
+  if (brush.IsHollow() && !pen.IsDefined())
+    return;
+
+  OpenGL::solid_shader->Use();
+  glUniformMatrix4fv(OpenGL::solid_modelview, 1, GL_FALSE,
+                     glm::value_ptr(modelview));
+
+  ScopeVertexPointer vp(points);
+
+  if (!brush.IsHollow() && num_indices > 0) {
+    brush.Bind();
+    OpenGL::DrawElements(GL_TRIANGLES, num_indices, GL_UNSIGNED_SHORT, indices);
+  }
+
+  if (IsPenOverBrush()) {
+    pen.Bind();
+    OpenGL::DrawArrays(GL_LINE_LOOP, 0, num_points);
+    pen.Unbind();
+  }
+
+  glUniformMatrix4fv(OpenGL::solid_modelview, 1, GL_FALSE,
+                     glm::value_ptr(glm::mat4(1)));
+}
+
 void
 Canvas::DrawTriangleFan(const BulkPixelPoint *points, unsigned num_points)
 {
@@ -219,20 +250,20 @@ Canvas::DrawTriangleFan(const BulkPixelPoint *points, unsigned num_points)
 
   if (!brush.IsHollow() && num_points >= 3) {
     brush.Bind();
-    glDrawArrays(GL_TRIANGLE_FAN, 0, num_points);
+    OpenGL::DrawArrays(GL_TRIANGLE_FAN, 0, num_points);
   }
 
   if (IsPenOverBrush()) {
     pen.Bind();
 
     if (pen.GetWidth() <= 2) {
-      glDrawArrays(GL_LINE_LOOP, 0, num_points);
+      OpenGL::DrawArrays(GL_LINE_LOOP, 0, num_points);
     } else {
       unsigned vertices = LineToTriangles(points, num_points, vertex_buffer,
                                           pen.GetWidth(), true);
       if (vertices > 0) {
         vp.Update(vertex_buffer.begin());
-        glDrawArrays(GL_TRIANGLE_STRIP, 0, vertices);
+        OpenGL::DrawArrays(GL_TRIANGLE_STRIP, 0, vertices);
       }
     }
 
@@ -251,7 +282,7 @@ Canvas::DrawHLine(int x1, int x2, int y, Color color)
   };
 
   const ScopeVertexPointer vp(v);
-  glDrawArrays(GL_LINE_STRIP, 0, ARRAY_SIZE(v));
+  OpenGL::DrawArrays(GL_LINE_STRIP, 0, ARRAY_SIZE(v));
 }
 
 void
@@ -263,7 +294,7 @@ Canvas::DrawLine(PixelPoint a, PixelPoint b) noexcept
 
   const BulkPixelPoint v[] = { a, b };
   const ScopeVertexPointer vp(v);
-  glDrawArrays(GL_LINE_STRIP, 0, ARRAY_SIZE(v));
+  OpenGL::DrawArrays(GL_LINE_STRIP, 0, ARRAY_SIZE(v));
 
   pen.Unbind();
 }
@@ -277,7 +308,7 @@ Canvas::DrawExactLine(PixelPoint a, PixelPoint b) noexcept
 
   const ExactPixelPoint v[] = { a, b };
   const ScopeVertexPointer vp(v);
-  glDrawArrays(GL_LINE_STRIP, 0, ARRAY_SIZE(v));
+  OpenGL::DrawArrays(GL_LINE_STRIP, 0, ARRAY_SIZE(v));
 
   pen.Unbind();
 }
@@ -299,11 +330,11 @@ Canvas::DrawLinePiece(const PixelPoint a, const PixelPoint b)
                                          false, true);
     if (strip_len > 0) {
       const ScopeVertexPointer vp(vertex_buffer.begin());
-      glDrawArrays(GL_TRIANGLE_STRIP, 0, strip_len);
+      OpenGL::DrawArrays(GL_TRIANGLE_STRIP, 0, strip_len);
     }
   } else {
     const ScopeVertexPointer vp(v);
-    glDrawArrays(GL_LINE_STRIP, 0, 2);
+    OpenGL::DrawArrays(GL_LINE_STRIP, 0, 2);
   }
 
   pen.Unbind();
@@ -318,7 +349,7 @@ Canvas::DrawTwoLines(PixelPoint a, PixelPoint b, PixelPoint c) noexcept
 
   const BulkPixelPoint v[] = { a, b, c };
   const ScopeVertexPointer vp(v);
-  glDrawArrays(GL_LINE_STRIP, 0, ARRAY_SIZE(v));
+  OpenGL::DrawArrays(GL_LINE_STRIP, 0, ARRAY_SIZE(v));
 
   pen.Unbind();
 }
@@ -332,7 +363,7 @@ Canvas::DrawTwoLinesExact(PixelPoint a, PixelPoint b, PixelPoint c) noexcept
 
   const ExactPixelPoint v[] = { a, b, c };
   const ScopeVertexPointer vp(v);
-  glDrawArrays(GL_LINE_STRIP, 0, ARRAY_SIZE(v));
+  OpenGL::DrawArrays(GL_LINE_STRIP, 0, ARRAY_SIZE(v));
 
   pen.Unbind();
 }
@@ -350,11 +381,11 @@ Canvas::DrawCircle(PixelPoint center, unsigned radius) noexcept
     if (!brush.IsHollow()) {
       vertices.BindInnerCircle(vp);
       brush.Bind();
-      glDrawArrays(GL_TRIANGLE_FAN, 0, vertices.CIRCLE_SIZE);
+      OpenGL::DrawArrays(GL_TRIANGLE_FAN, 0, vertices.CIRCLE_SIZE);
     }
     vertices.Bind(vp);
     pen.Bind();
-    glDrawArrays(GL_TRIANGLE_STRIP, 0, vertices.SIZE);
+    OpenGL::DrawArrays(GL_TRIANGLE_STRIP, 0, vertices.SIZE);
     pen.Unbind();
   } else {
     auto &buffer = radius < 16
@@ -377,12 +408,12 @@ Canvas::DrawCircle(PixelPoint center, unsigned radius) noexcept
 
     if (!brush.IsHollow()) {
       brush.Bind();
-      glDrawArrays(GL_TRIANGLE_FAN, 0, n);
+      OpenGL::DrawArrays(GL_TRIANGLE_FAN, 0, n);
     }
 
     if (IsPenOverBrush()) {
       pen.Bind();
-      glDrawArrays(GL_LINE_LOOP, 0, n);
+      OpenGL::DrawArrays(GL_LINE_LOOP, 0, n);
       pen.Unbind();
     }
 
@@ -470,11 +501,11 @@ Canvas::DrawAnnulus(PixelPoint center,
     vertices.Bind(vp);
 
     if (istart > iend) {
-      glDrawArrays(GL_TRIANGLE_STRIP, istart,
-                   GLDonutVertices::MAX_ANGLE - istart + 2);
-      glDrawArrays(GL_TRIANGLE_STRIP, 0, iend + 2);
+      OpenGL::DrawArrays(GL_TRIANGLE_STRIP, istart,
+                         GLDonutVertices::MAX_ANGLE - istart + 2);
+      OpenGL::DrawArrays(GL_TRIANGLE_STRIP, 0, iend + 2);
     } else {
-      glDrawArrays(GL_TRIANGLE_STRIP, istart, iend - istart + 2);
+      OpenGL::DrawArrays(GL_TRIANGLE_STRIP, istart, iend - istart + 2);
     }
   }
 
@@ -485,8 +516,8 @@ Canvas::DrawAnnulus(PixelPoint center,
       if (brush.IsHollow())
         vertices.Bind(vp);
 
-      glDrawArrays(GL_LINE_STRIP, istart, 2);
-      glDrawArrays(GL_LINE_STRIP, iend, 2);
+      OpenGL::DrawArrays(GL_LINE_STRIP, istart, 2);
+      OpenGL::DrawArrays(GL_LINE_STRIP, iend, 2);
     }
 
     const unsigned pstart = istart / 2;
@@ -494,20 +525,20 @@ Canvas::DrawAnnulus(PixelPoint center,
 
     vertices.BindInnerCircle(vp);
     if (pstart < pend) {
-      glDrawArrays(GL_LINE_STRIP, pstart, pend - pstart + 1);
+      OpenGL::DrawArrays(GL_LINE_STRIP, pstart, pend - pstart + 1);
     } else {
-      glDrawArrays(GL_LINE_STRIP, pstart,
-                   GLDonutVertices::CIRCLE_SIZE - pstart + 1);
-      glDrawArrays(GL_LINE_STRIP, 0, pend + 1);
+      OpenGL::DrawArrays(GL_LINE_STRIP, pstart,
+                         GLDonutVertices::CIRCLE_SIZE - pstart + 1);
+      OpenGL::DrawArrays(GL_LINE_STRIP, 0, pend + 1);
     }
 
     vertices.BindOuterCircle(vp);
     if (pstart < pend) {
-      glDrawArrays(GL_LINE_STRIP, pstart, pend - pstart + 1);
+      OpenGL::DrawArrays(GL_LINE_STRIP, pstart, pend - pstart + 1);
     } else {
-      glDrawArrays(GL_LINE_STRIP, pstart,
-                   GLDonutVertices::CIRCLE_SIZE - pstart + 1);
-      glDrawArrays(GL_LINE_STRIP, 0, pend + 1);
+      OpenGL::DrawArrays(GL_LINE_STRIP, pstart,
+                         GLDonutVertices::CIRCLE_SIZE - pstart + 1);
+      OpenGL::DrawArrays(GL_LINE_STRIP, 0, pend + 1);
     }
 
     pen.Unbind();
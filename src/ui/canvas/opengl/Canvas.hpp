@@ -35,6 +35,8 @@ Copyright_License {
 #include "util/Compiler.h"
 #include "util/StringView.hxx"
 
+#include <glm/fwd.hpp>
+
 #include <tchar.h>
 
 
@@ -52,6 +54,7 @@ Copyright_License {
 class Angle;
 class Bitmap;
 class GLTexture;
+struct FloatPoint2D;
 template<class T> class AllocatedArray;
 
 /**
@@ -259,6 +262,22 @@ public:
 
   void DrawPolygon(const BulkPixelPoint *points, unsigned num_points);
 
+  /**
+   * Draw a polygon from vertices in the currently bound
+   * #GLArrayBuffer, transformed with the given modelview matrix.
+   * The fill uses the triangle indices (GL_TRIANGLES) in the
+   * currently bound #GLElementArrayBuffer.  The outline is a
+   * GL_LINE_LOOP of the pen width, because LineToTriangles() works
+   * only on screen coordinates.
+   *
+   * @param points the vertex offset in the array buffer
+   * @param indices the index offset in the element array buffer
+   */
+  void DrawPolygonBuffer(const glm::mat4 &modelview,
+                         const FloatPoint2D *points, unsigned num_points,
+                         const GLushort *indices,
+                         unsigned num_indices) noexcept;
+
   /**
    * Draw a triangle fan (GL_TRIANGLE_FAN).  The first point is the
    * origin of the fan.
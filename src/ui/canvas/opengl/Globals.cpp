@@ -22,6 +22,7 @@ Copyright_License {
 */
 
 #include "Globals.hpp"
+#include "Statistics.hpp"
 #include "Debug.hpp"
 #include "ui/dim/Point.hpp"
 
@@ -47,6 +48,10 @@ PixelPoint translate;
 
 glm::mat4 projection_matrix;
 
+DrawStatistics draw_statistics;
+
+GLuint current_program = 0;
+
 #ifndef NDEBUG
 pthread_t thread;
 #endif
@@ -26,6 +26,7 @@ Copyright_License {
 #include "Extension.hpp"
 #include "Globals.hpp"
 #include "Shapes.hpp"
+#include "TextureAtlas.hpp"
 #include "Function.hpp"
 #include "Dynamic.hpp"
 #include "FBO.hpp"
@@ -152,6 +153,9 @@ OpenGL::SetupContext()
 {
   texture_non_power_of_two = SupportsNonPowerOfTwoTextures();
 
+  /* a new context has no program bound */
+  current_program = 0;
+
 #ifdef ANDROID
   native_view->SetTexturePowerOfTwo(texture_non_power_of_two);
 #endif
@@ -277,5 +281,7 @@ OpenGL::Deinitialise() noexcept
 
   DeinitShapes();
 
+  DeinitIconAtlas();
+
   TextCache::Flush();
 }
@@ -24,6 +24,7 @@ Copyright_License {
 #ifndef XCSOAR_SCREEN_OPENGL_PROGRAM_HPP
 #define XCSOAR_SCREEN_OPENGL_PROGRAM_HPP
 
+#include "Statistics.hpp"
 #include "ui/opengl/System.hpp"
 
 /**
@@ -87,6 +88,9 @@ public:
   GLProgram &operator=(const GLProgram &) = delete;
 
   ~GLProgram() noexcept {
+    if (OpenGL::current_program == id)
+      OpenGL::current_program = 0;
+
     glDeleteProgram(id);
   }
 
@@ -125,6 +129,13 @@ public:
   }
 
   void Use() noexcept {
+    /* most canvas primitives use the same shader; skip the
+       redundant state change */
+    if (OpenGL::current_program == id)
+      return;
+
+    OpenGL::current_program = id;
+    ++OpenGL::draw_statistics.program_changes;
     glUseProgram(id);
   }
 
@@ -48,14 +48,26 @@ GLProgram *combine_texture_shader;
 GLint combine_texture_projection, combine_texture_texture,
   combine_texture_translate;
 
+GLProgram *terrain_shader;
+GLint terrain_projection, terrain_texture, terrain_translate,
+  terrain_ramp, terrain_slope_step, terrain_height_factor,
+  terrain_sun, terrain_contrast, terrain_slope_factor;
+
 } // namespace OpenGL
 
 #ifdef HAVE_GLES
 #define GLSL_VERSION
 #define GLSL_PRECISION "precision mediump float;\n"
+#define GLSL_HIGH_PRECISION \
+  "#ifdef GL_FRAGMENT_PRECISION_HIGH\n" \
+  "precision highp float;\n" \
+  "#else\n" \
+  "precision mediump float;\n" \
+  "#endif\n"
 #else
 #define GLSL_VERSION "#version 120\n"
 #define GLSL_PRECISION
+#define GLSL_HIGH_PRECISION
 #endif
 
 static constexpr char solid_vertex_shader[] =
@@ -154,6 +166,85 @@ static constexpr char combine_texture_fragment_shader[] =
     }
 )glsl";
 
+static const char *const terrain_vertex_shader = texture_vertex_shader;
+static constexpr char terrain_fragment_shader[] =
+  GLSL_VERSION
+  GLSL_HIGH_PRECISION
+  R"glsl(
+    uniform sampler2D texture;
+    uniform sampler2D ramp;
+    uniform vec2 slope_step;
+    uniform float height_factor;
+    uniform vec3 sun;
+    uniform float contrast;
+    uniform float slope_factor;
+    varying vec2 texcoordvar;
+
+    /* see EncodeTerrainHeight(): 0 is invalid, 1 is water */
+    float height_at(vec2 p) {
+      vec4 v = texture2D(texture, p);
+      return floor(v.r * 255. + .5) + floor(v.a * 255. + .5) * 256.;
+    }
+
+    /* round towards zero like integer division */
+    float trunc(float x) {
+      return x < 0. ? ceil(x) : floor(x);
+    }
+
+    /* interpolate between the given 8 bit color and the color with
+       i/128, like MIX() in RasterRenderer.cpp */
+    vec3 shade(vec3 target, vec3 color, float i) {
+      return floor((target * i + floor(color * 255. + .5) * (128. - i))
+                   / 128.) / 255.;
+    }
+
+    void main() {
+      float e = height_at(texcoordvar);
+      if (e < .5) {
+        gl_FragColor = vec4(1.);
+        return;
+      }
+
+      if (e < 1.5) {
+        gl_FragColor = texture2D(ramp, vec2(255.5 / 256., .5));
+        return;
+      }
+
+      float h = e - 2.;
+      float index = min(254., floor(h * height_factor));
+      vec3 color = texture2D(ramp, vec2((index + .5) / 256., .5)).rgb;
+
+      if (contrast > 0.) {
+        float e_l = height_at(texcoordvar - vec2(slope_step.x, 0.));
+        float e_r = height_at(texcoordvar + vec2(slope_step.x, 0.));
+        float e_a = height_at(texcoordvar - vec2(0., slope_step.y));
+        float e_b = height_at(texcoordvar + vec2(0., slope_step.y));
+
+        if (min(min(e_l, e_r), min(e_a, e_b)) > 1.5) {
+          /* the same formula as CalculateSlopeShading(), normalised
+             to avoid overflows with medium precision */
+          vec3 n = normalize(vec3(clamp(e_r - e_l, -512., 512.),
+                                  clamp(e_b - e_a, -512., 512.),
+                                  slope_factor));
+          float illum = clamp(trunc((trunc(dot(n, sun)) - sun.z)
+                                    * contrast / 128.),
+                              -63., 63.);
+
+          /* see TerrainShading() */
+          if (illum < 0.)
+            /* shadow to blue */
+            color = shade(vec3(0., 0., 64.), color, min(63., -illum));
+          else
+            /* highlight to yellow */
+            color = shade(vec3(255., 255., 16.), color,
+                          min(32., floor(illum / 2.)));
+        }
+      }
+
+      gl_FragColor = vec4(color, 1.);
+    }
+)glsl";
+
 static void
 CompileAttachShader(GLProgram &program, GLenum type, const char *code)
 {
@@ -262,11 +353,34 @@ OpenGL::InitShaders()
 
   combine_texture_shader->Use();
   glUniform1i(combine_texture_texture, 0);
+
+  terrain_shader = CompileProgram(terrain_vertex_shader,
+                                  terrain_fragment_shader);
+  terrain_shader->BindAttribLocation(Attribute::POSITION, "position");
+  terrain_shader->BindAttribLocation(Attribute::TEXCOORD, "texcoord");
+  LinkProgram(*terrain_shader);
+
+  terrain_projection = terrain_shader->GetUniformLocation("projection");
+  terrain_texture = terrain_shader->GetUniformLocation("texture");
+  terrain_translate = terrain_shader->GetUniformLocation("translate");
+  terrain_ramp = terrain_shader->GetUniformLocation("ramp");
+  terrain_slope_step = terrain_shader->GetUniformLocation("slope_step");
+  terrain_height_factor =
+    terrain_shader->GetUniformLocation("height_factor");
+  terrain_sun = terrain_shader->GetUniformLocation("sun");
+  terrain_contrast = terrain_shader->GetUniformLocation("contrast");
+  terrain_slope_factor = terrain_shader->GetUniformLocation("slope_factor");
+
+  terrain_shader->Use();
+  glUniform1i(terrain_texture, 0);
+  glUniform1i(terrain_ramp, 1);
 }
 
 void
 OpenGL::DeinitShaders() noexcept
 {
+  delete terrain_shader;
+  terrain_shader = nullptr;
   delete combine_texture_shader;
   combine_texture_shader = nullptr;
   delete alpha_shader;
@@ -301,6 +415,10 @@ OpenGL::UpdateShaderProjectionMatrix() noexcept
   combine_texture_shader->Use();
   glUniformMatrix4fv(combine_texture_projection, 1, GL_FALSE,
                      glm::value_ptr(projection_matrix));
+
+  terrain_shader->Use();
+  glUniformMatrix4fv(terrain_projection, 1, GL_FALSE,
+                     glm::value_ptr(projection_matrix));
 }
 
 void
@@ -322,4 +440,7 @@ OpenGL::UpdateShaderTranslate() noexcept
 
   combine_texture_shader->Use();
   glUniform2f(combine_texture_translate, t.x, t.y);
+
+  terrain_shader->Use();
+  glUniform2f(terrain_translate, t.x, t.y);
 }
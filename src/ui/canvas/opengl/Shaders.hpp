@@ -62,6 +62,16 @@ extern GLProgram *combine_texture_shader;
 extern GLint combine_texture_projection, combine_texture_texture,
   combine_texture_translate;
 
+/**
+ * A shader that renders terrain from a height texture (see
+ * #RasterRenderer): color ramp lookup in the texture unit 1 and
+ * slope shading.
+ */
+extern GLProgram *terrain_shader;
+extern GLint terrain_projection, terrain_texture, terrain_translate,
+  terrain_ramp, terrain_slope_step, terrain_height_factor,
+  terrain_sun, terrain_contrast, terrain_slope_factor;
+
 /**
  * Throws on error.
  */
@@ -0,0 +1,86 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_SCREEN_OPENGL_STATISTICS_HPP
+#define XCSOAR_SCREEN_OPENGL_STATISTICS_HPP
+
+#include "ui/opengl/System.hpp"
+
+namespace OpenGL {
+
+/**
+ * Counters of the GL commands issued by XCSoar, for profiling.  They
+ * only grow; take the difference of two copies to measure a frame.
+ */
+struct DrawStatistics {
+  /**
+   * Number of glDrawArrays() and glDrawElements() calls.
+   */
+  unsigned draw_calls = 0;
+
+  /**
+   * Number of glUseProgram() calls.  Redundant calls are skipped by
+   * GLProgram::Use() and not counted.
+   */
+  unsigned program_changes = 0;
+
+  /**
+   * Number of glBindTexture() calls.
+   */
+  unsigned texture_binds = 0;
+
+  constexpr DrawStatistics operator-(const DrawStatistics &other) const noexcept {
+    return {
+      draw_calls - other.draw_calls,
+      program_changes - other.program_changes,
+      texture_binds - other.texture_binds,
+    };
+  }
+};
+
+extern DrawStatistics draw_statistics;
+
+/**
+ * The program which was last passed to glUseProgram() by
+ * GLProgram::Use(); 0 if unknown.
+ */
+extern GLuint current_program;
+
+static inline void
+DrawArrays(GLenum mode, GLint first, GLsizei count) noexcept
+{
+  ++draw_statistics.draw_calls;
+  glDrawArrays(mode, first, count);
+}
+
+static inline void
+DrawElements(GLenum mode, GLsizei count, GLenum type,
+             const GLvoid *indices) noexcept
+{
+  ++draw_statistics.draw_calls;
+  glDrawElements(mode, count, type, indices);
+}
+
+} // namespace OpenGL
+
+#endif
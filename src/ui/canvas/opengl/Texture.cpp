@@ -25,6 +25,7 @@ Copyright_License {
 #include "Globals.hpp"
 #include "ui/opengl/Features.hpp"
 #include "VertexPointer.hpp"
+#include "Statistics.hpp"
 #include "ui/dim/BulkPoint.hpp"
 #include "Asset.hpp"
 #include "Scope.hpp"
@@ -182,7 +183,7 @@ GLTexture::Draw(PixelRect dest, PixelRect src) const noexcept
   glVertexAttribPointer(OpenGL::Attribute::TEXCOORD, 2, GL_FLOAT, GL_FALSE,
                         0, coord);
 
-  glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+  OpenGL::DrawArrays(GL_TRIANGLE_STRIP, 0, 4);
 
   glDisableVertexAttribArray(OpenGL::Attribute::TEXCOORD);
 }
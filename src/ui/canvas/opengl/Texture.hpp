@@ -28,6 +28,7 @@ Copyright_License {
 #include "ui/opengl/System.hpp"
 #include "ui/dim/Rect.hpp"
 #include "FBO.hpp"
+#include "Statistics.hpp"
 #include "Asset.hpp"
 
 #include <cassert>
@@ -136,6 +137,7 @@ protected:
 
 public:
   void Bind() noexcept {
+    ++OpenGL::draw_statistics.texture_binds;
     glBindTexture(GL_TEXTURE_2D, id);
   }
 
@@ -0,0 +1,161 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "TextureAtlas.hpp"
+#include "ui/canvas/custom/UncompressedImage.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+
+#include <string.h>
+
+/**
+ * Convert an image to tightly packed RGBA, the only format the atlas
+ * texture has.
+ */
+static std::unique_ptr<uint8_t[]>
+ToRGBA(const UncompressedImage &image) noexcept
+{
+  const unsigned width = image.GetWidth(), height = image.GetHeight();
+  auto result = std::make_unique<uint8_t[]>(width * height * 4);
+
+  uint8_t *dest = result.get();
+  for (unsigned y = 0; y < height; ++y) {
+    const auto *src = (const uint8_t *)image.GetData() + y * image.GetPitch();
+
+    switch (image.GetFormat()) {
+    case UncompressedImage::Format::GRAY:
+      for (unsigned x = 0; x < width; ++x, dest += 4) {
+        dest[0] = dest[1] = dest[2] = src[x];
+        dest[3] = 0xff;
+      }
+      break;
+
+    case UncompressedImage::Format::RGB:
+      for (unsigned x = 0; x < width; ++x, dest += 4, src += 3) {
+        dest[0] = src[0];
+        dest[1] = src[1];
+        dest[2] = src[2];
+        dest[3] = 0xff;
+      }
+      break;
+
+    case UncompressedImage::Format::RGBA:
+      memcpy(dest, src, width * 4);
+      dest += width * 4;
+      break;
+
+    case UncompressedImage::Format::INVALID:
+      return nullptr;
+    }
+  }
+
+  return result;
+}
+
+/**
+ * Create the atlas texture, initialised with transparent pixels.
+ */
+static GLTexture
+MakeAtlasTexture(unsigned size) noexcept
+{
+  const auto zero = std::make_unique<uint8_t[]>(size * size * 4);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  return GLTexture(GL_RGBA, {size, size}, GL_RGBA, GL_UNSIGNED_BYTE,
+                   zero.get());
+}
+
+TextureAtlas::TextureAtlas() noexcept
+  :texture(MakeAtlasTexture(SIZE))
+{
+  /* icons are often stretched by the GPU; the padding keeps the
+     interpolation within each image */
+  GLTexture::EnableInterpolation();
+}
+
+std::optional<PixelRect>
+TextureAtlas::Find(const void *key) const noexcept
+{
+  for (const auto &i : items)
+    if (i.key == key)
+      return i.rect;
+
+  return std::nullopt;
+}
+
+std::optional<PixelRect>
+TextureAtlas::Add(const void *key, const UncompressedImage &image) noexcept
+{
+  const unsigned width = image.GetWidth(), height = image.GetHeight();
+  if (!image.IsDefined() || image.IsFlipped() ||
+      width == 0 || height == 0 ||
+      width > MAX_IMAGE_SIZE || height > MAX_IMAGE_SIZE)
+    return std::nullopt;
+
+  if (shelf_x + width + PADDING > SIZE) {
+    /* start a new shelf */
+    shelf_top += shelf_height;
+    shelf_height = 0;
+    shelf_x = 0;
+  }
+
+  if (shelf_top + height + PADDING > SIZE)
+    return std::nullopt;
+
+  const auto rgba = ToRGBA(image);
+  if (!rgba)
+    return std::nullopt;
+
+  const PixelRect rect(PixelPoint(shelf_x, shelf_top),
+                       PixelSize(width, height));
+
+  texture.Bind();
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  glTexSubImage2D(GL_TEXTURE_2D, 0, rect.left, rect.top, width, height,
+                  GL_RGBA, GL_UNSIGNED_BYTE, rgba.get());
+
+  shelf_x += width + PADDING;
+  shelf_height = std::max(shelf_height, height + PADDING);
+
+  items.push_back({key, rect});
+  return rect;
+}
+
+static TextureAtlas *icon_atlas;
+
+TextureAtlas &
+OpenGL::GetIconAtlas() noexcept
+{
+  if (icon_atlas == nullptr)
+    icon_atlas = new TextureAtlas();
+
+  return *icon_atlas;
+}
+
+void
+OpenGL::DeinitIconAtlas() noexcept
+{
+  delete icon_atlas;
+  icon_atlas = nullptr;
+}
@@ -0,0 +1,109 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_SCREEN_OPENGL_TEXTURE_ATLAS_HPP
+#define XCSOAR_SCREEN_OPENGL_TEXTURE_ATLAS_HPP
+
+#include "Texture.hpp"
+#include "ui/dim/Rect.hpp"
+
+#include <optional>
+#include <vector>
+
+class UncompressedImage;
+
+/**
+ * A big RGBA texture which contains many small images, so they can
+ * be drawn one after another (or in one batch) without switching
+ * textures.  Images are placed on "shelves", i.e. rows as high as
+ * their highest image; space is never freed.
+ */
+class TextureAtlas {
+  static constexpr unsigned SIZE = 1024;
+
+  /**
+   * Transparent pixels between two images, so interpolation does
+   * not bleed into the neighbour.
+   */
+  static constexpr unsigned PADDING = 1;
+
+  /**
+   * Larger images are not accepted; they would waste too much
+   * space.
+   */
+  static constexpr unsigned MAX_IMAGE_SIZE = 256;
+
+  GLTexture texture;
+
+  struct Item {
+    const void *key;
+    PixelRect rect;
+  };
+
+  std::vector<Item> items;
+
+  unsigned shelf_top = 0, shelf_height = 0, shelf_x = 0;
+
+public:
+  TextureAtlas() noexcept;
+
+  TextureAtlas(const TextureAtlas &) = delete;
+  TextureAtlas &operator=(const TextureAtlas &) = delete;
+
+  GLTexture &GetTexture() noexcept {
+    return texture;
+  }
+
+  /**
+   * Look up an image which was added with the given key.
+   */
+  [[gnu::pure]]
+  std::optional<PixelRect> Find(const void *key) const noexcept;
+
+  /**
+   * Copy an image into the atlas.
+   *
+   * @param key an arbitrary pointer which identifies the image for
+   * Find(), e.g. the address of its compressed source data
+   * @return the position within the texture or std::nullopt if the
+   * atlas is full or the image is not suitable
+   */
+  std::optional<PixelRect> Add(const void *key,
+                               const UncompressedImage &image) noexcept;
+};
+
+namespace OpenGL {
+
+/**
+ * Returns the atlas for all #MaskedIcon instances.  It is created on
+ * the first call.
+ */
+TextureAtlas &
+GetIconAtlas() noexcept;
+
+void
+DeinitIconAtlas() noexcept;
+
+} // namespace OpenGL
+
+#endif
@@ -32,6 +32,14 @@ EventQueue::Push(const Event &event)
   if (quit)
     return;
 
+  if (event.type == Event::MOUSE_MOTION && !events.empty() &&
+      events.back().type == Event::MOUSE_MOTION) {
+    /* coalesce consecutive motion events: only the most recent
+       pointer position matters */
+    events.back() = event;
+    return;
+  }
+
   events.push(event);
   cond.notify_one();
 }
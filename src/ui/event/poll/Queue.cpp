@@ -44,7 +44,16 @@ void
 EventQueue::Push(const Event &event)
 {
   std::lock_guard<Mutex> lock(mutex);
-  events.push(event);
+
+  if (event.type == Event::MOUSE_MOTION && !events.empty() &&
+      events.back().type == Event::MOUSE_MOTION)
+    /* coalesce consecutive motion events: only the most recent
+       pointer position matters, and the receiver would redraw for
+       each stale one */
+    events.back() = event;
+  else
+    events.push(event);
+
   WakeUp();
 }
 
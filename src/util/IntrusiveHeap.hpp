@@ -0,0 +1,204 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_INTRUSIVE_HEAP_HPP
+#define XCSOAR_INTRUSIVE_HEAP_HPP
+
+#include <vector>
+#include <cassert>
+
+/**
+ * A hook which allows an object to be stored in an #IntrusiveHeap.
+ * It stores the object's current position in the heap array, which
+ * allows erasing and repositioning arbitrary items in O(log n).
+ */
+class IntrusiveHeapHook {
+  template<typename T, typename Compare> friend class IntrusiveHeap;
+
+  static constexpr unsigned NOT_LINKED = ~0u;
+
+  unsigned heap_index = NOT_LINKED;
+
+public:
+  bool is_linked() const noexcept {
+    return heap_index != NOT_LINKED;
+  }
+};
+
+/**
+ * A binary min-heap of pointers to objects derived from
+ * #IntrusiveHeapHook, ordered by #Compare.  Unlike
+ * std::priority_queue, items can be erased or repositioned after
+ * their key has changed.  The pointers are kept in one contiguous
+ * array, so this needs much less memory than a balanced tree.
+ *
+ * The heap does not own the items.
+ */
+template<typename T, typename Compare>
+class IntrusiveHeap {
+  std::vector<T *> items;
+
+  Compare compare;
+
+public:
+  using size_type = typename std::vector<T *>::size_type;
+
+  void reserve(size_type n) {
+    items.reserve(n);
+  }
+
+  bool empty() const noexcept {
+    return items.empty();
+  }
+
+  size_type size() const noexcept {
+    return items.size();
+  }
+
+  void clear() noexcept {
+    for (T *t : items)
+      static_cast<IntrusiveHeapHook &>(*t).heap_index =
+        IntrusiveHeapHook::NOT_LINKED;
+    items.clear();
+  }
+
+  /**
+   * Returns the smallest item.
+   */
+  T &front() const noexcept {
+    assert(!empty());
+
+    return *items.front();
+  }
+
+  /**
+   * Add an item.  Allocates memory unless reserve() has been called
+   * with a large enough size.
+   */
+  void insert(T &t) {
+    assert(!GetHook(t).is_linked());
+
+    items.push_back(&t);
+    SiftUp(items.size() - 1);
+  }
+
+  /**
+   * Remove the given item, which must be in this heap.
+   */
+  void erase(T &t) noexcept {
+    const unsigned i = GetHook(t).heap_index;
+    assert(i < items.size());
+    assert(items[i] == &t);
+
+    GetHook(t).heap_index = IntrusiveHeapHook::NOT_LINKED;
+
+    T *const last = items.back();
+    items.pop_back();
+    if (last == &t)
+      return;
+
+    Place(i, *last);
+    Reposition(i);
+  }
+
+  /**
+   * Remove the smallest item.
+   */
+  void pop_front() noexcept {
+    erase(front());
+  }
+
+  /**
+   * Restore the heap order after the key of the given item has been
+   * modified.  Does nothing if the item is not in this heap.
+   */
+  void update(T &t) noexcept {
+    if (GetHook(t).is_linked())
+      Reposition(GetHook(t).heap_index);
+  }
+
+private:
+  static IntrusiveHeapHook &GetHook(T &t) noexcept {
+    return static_cast<IntrusiveHeapHook &>(t);
+  }
+
+  bool Less(unsigned a, unsigned b) const noexcept {
+    return compare(*items[a], *items[b]);
+  }
+
+  void Place(unsigned i, T &t) noexcept {
+    items[i] = &t;
+    GetHook(t).heap_index = i;
+  }
+
+  void Swap(unsigned a, unsigned b) noexcept {
+    T &t = *items[a];
+    Place(a, *items[b]);
+    Place(b, t);
+  }
+
+  void SiftUp(unsigned i) noexcept {
+    T &t = *items[i];
+
+    while (i > 0) {
+      const unsigned parent = (i - 1) / 2;
+      if (!compare(t, *items[parent]))
+        break;
+
+      Place(i, *items[parent]);
+      i = parent;
+    }
+
+    Place(i, t);
+  }
+
+  void SiftDown(unsigned i) noexcept {
+    const unsigned n = items.size();
+
+    while (true) {
+      unsigned smallest = i;
+      const unsigned left = 2 * i + 1, right = left + 1;
+
+      if (left < n && Less(left, smallest))
+        smallest = left;
+
+      if (right < n && Less(right, smallest))
+        smallest = right;
+
+      if (smallest == i)
+        break;
+
+      Swap(i, smallest);
+      i = smallest;
+    }
+  }
+
+  void Reposition(unsigned i) noexcept {
+    if (i > 0 && Less(i, (i - 1) / 2))
+      SiftUp(i);
+    else
+      SiftDown(i);
+  }
+};
+
+#endif
@@ -0,0 +1,345 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_LOCK_FREE_RING_BUFFER_HPP
+#define XCSOAR_LOCK_FREE_RING_BUFFER_HPP
+
+#include "ConstBuffer.hxx"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * A fixed-size ring buffer which passes items from exactly one
+ * producer thread to exactly one consumer thread without a lock.
+ * push() fails (or writes less) when the buffer is full.
+ *
+ * The two indices grow monotonically and are masked on access, so
+ * all #size slots are usable.  Each index is written only by its
+ * owner and lives in its own cache line.
+ *
+ * empty(), GetSize(), shift(), Read(), Consume() and clear() may
+ * only be called by the consumer; push() only by the producer.
+ *
+ * @param size the number of slots; must be a power of two
+ */
+template<typename T, std::size_t size>
+class LockFreeRingBuffer {
+  static_assert(size > 0 && (size & (size - 1)) == 0,
+                "size must be a power of two");
+  static_assert(std::is_trivially_copyable_v<T>,
+                "items are copied with plain assignment");
+
+  static constexpr std::size_t CACHE_LINE = 64;
+
+  /**
+   * The number of items ever pushed.  Written only by the producer.
+   */
+  alignas(CACHE_LINE) std::atomic<std::size_t> write_index{0};
+
+  /**
+   * The number of items ever shifted.  Written only by the consumer.
+   */
+  alignas(CACHE_LINE) std::atomic<std::size_t> read_index{0};
+
+  alignas(CACHE_LINE) T data[size];
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+  static constexpr size_type capacity() noexcept {
+    return size;
+  }
+
+  bool empty() const noexcept {
+    return read_index.load(std::memory_order_relaxed) ==
+      write_index.load(std::memory_order_acquire);
+  }
+
+  /**
+   * Returns the number of items which can be shifted right now.
+   */
+  size_type GetSize() const noexcept {
+    return write_index.load(std::memory_order_acquire) -
+      read_index.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Discard all items which have been pushed so far.
+   */
+  void clear() noexcept {
+    read_index.store(write_index.load(std::memory_order_acquire),
+                     std::memory_order_release);
+  }
+
+  /**
+   * @return false if the buffer is full
+   */
+  bool push(const T &value) noexcept {
+    return push(&value, 1) > 0;
+  }
+
+  /**
+   * Append as many of the given items as there is room for.
+   *
+   * @return the number of items which were appended
+   */
+  size_type push(const T *src, size_type n) noexcept {
+    const size_type w = write_index.load(std::memory_order_relaxed);
+    const size_type r = read_index.load(std::memory_order_acquire);
+    assert(w - r <= size);
+
+    n = std::min(n, size - (w - r));
+    Copy(data, w, src, n);
+
+    write_index.store(w + n, std::memory_order_release);
+    return n;
+  }
+
+  /**
+   * Remove the oldest item.
+   *
+   * @return false if the buffer is empty
+   */
+  bool shift(T &value) noexcept {
+    return shift(&value, 1) > 0;
+  }
+
+  /**
+   * Remove up to #n of the oldest items.
+   *
+   * @return the number of items which were copied to #dest
+   */
+  size_type shift(T *dest, size_type n) noexcept {
+    const size_type r = read_index.load(std::memory_order_relaxed);
+    const size_type w = write_index.load(std::memory_order_acquire);
+    assert(w - r <= size);
+
+    n = std::min(n, w - r);
+    Copy(dest, data, r, n);
+
+    read_index.store(r + n, std::memory_order_release);
+    return n;
+  }
+
+  /**
+   * Returns the oldest items which are contiguous in memory, so the
+   * consumer can use them in place.  When you are finished, call
+   * Consume().
+   */
+  ConstBuffer<T> Read() const noexcept {
+    const size_type r = read_index.load(std::memory_order_relaxed);
+    const size_type w = write_index.load(std::memory_order_acquire);
+    const size_type offset = r & (size - 1);
+    return {data + offset, std::min(w - r, size - offset)};
+  }
+
+  /**
+   * Remove items which were obtained with Read().
+   */
+  void Consume(size_type n) noexcept {
+    const size_type r = read_index.load(std::memory_order_relaxed);
+    assert(n <= write_index.load(std::memory_order_relaxed) - r);
+    read_index.store(r + n, std::memory_order_release);
+  }
+
+private:
+  /**
+   * Copy #n items into the ring, starting at (unmasked) index #i.
+   */
+  static void Copy(T *ring, size_type i, const T *src, size_type n) noexcept {
+    const size_type offset = i & (size - 1);
+    const size_type first = std::min(n, size - offset);
+    std::copy_n(src, first, ring + offset);
+    std::copy_n(src + first, n - first, ring);
+  }
+
+  /**
+   * Copy #n items out of the ring, starting at (unmasked) index #i.
+   */
+  static void Copy(T *dest, const T *ring, size_type i,
+                   size_type n) noexcept {
+    const size_type offset = i & (size - 1);
+    const size_type first = std::min(n, size - offset);
+    std::copy_n(ring + offset, first, dest);
+    std::copy_n(ring, n - first, dest + first);
+  }
+};
+
+/**
+ * Like #LockFreeRingBuffer, but push() never fails: when the buffer
+ * is full, the oldest item is overwritten, like
+ * #OverwritingRingBuffer.  This suits "latest value wins" handoffs
+ * where the producer must never wait for the consumer.
+ *
+ * The producer cannot move the consumer's index, so the consumer
+ * detects overwritten items itself: before copying a slot it skips
+ * items which have already been overwritten, and after copying it
+ * checks (like a sequence lock) whether the producer has started to
+ * overwrite the slot meanwhile, and if so, discards the copy and
+ * retries.  A torn copy is therefore never returned.
+ *
+ * Because the producer may write a slot while the consumer copies
+ * it, the slots are not plain T objects but arrays of atomic words
+ * which are accessed with relaxed loads and stores; this requires T
+ * to be trivially copyable.
+ *
+ * @param size the number of slots; must be a power of two
+ */
+template<typename T, std::size_t size>
+class LockFreeOverwritingRingBuffer {
+  static_assert(size > 0 && (size & (size - 1)) == 0,
+                "size must be a power of two");
+  static_assert(std::is_trivially_copyable_v<T>,
+                "items are copied word by word");
+
+  static constexpr std::size_t CACHE_LINE = 64;
+
+  using Word = std::size_t;
+  static constexpr std::size_t N_WORDS =
+    (sizeof(T) + sizeof(Word) - 1) / sizeof(Word);
+
+  /**
+   * One item, split into words which may be accessed concurrently.
+   */
+  struct Slot {
+    std::atomic<Word> words[N_WORDS];
+
+    void Store(const T &value) noexcept {
+      Word tmp[N_WORDS]{};
+      std::memcpy(tmp, &value, sizeof(value));
+      for (std::size_t i = 0; i < N_WORDS; ++i)
+        words[i].store(tmp[i], std::memory_order_relaxed);
+    }
+
+    void Load(T &value) const noexcept {
+      Word tmp[N_WORDS];
+      for (std::size_t i = 0; i < N_WORDS; ++i)
+        tmp[i] = words[i].load(std::memory_order_relaxed);
+      std::memcpy(&value, tmp, sizeof(value));
+    }
+  };
+
+  /**
+   * The number of items the producer has begun to write.  This is
+   * incremented before the slot is written.
+   */
+  alignas(CACHE_LINE) std::atomic<std::size_t> reserve_index{0};
+
+  /**
+   * The number of items the producer has finished writing.
+   */
+  std::atomic<std::size_t> write_index{0};
+
+  /**
+   * The number of items the consumer has shifted or skipped.
+   * Accessed only by the consumer.
+   */
+  alignas(CACHE_LINE) std::size_t read_index = 0;
+
+  alignas(CACHE_LINE) Slot data[size];
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+  static constexpr size_type capacity() noexcept {
+    return size;
+  }
+
+  bool empty() const noexcept {
+    return read_index == write_index.load(std::memory_order_acquire);
+  }
+
+  /**
+   * Discard all items which have been pushed so far.
+   */
+  void clear() noexcept {
+    read_index = write_index.load(std::memory_order_acquire);
+  }
+
+  void push(const T &value) noexcept {
+    const size_type w = write_index.load(std::memory_order_relaxed);
+
+    reserve_index.store(w + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    data[w & (size - 1)].Store(value);
+
+    write_index.store(w + 1, std::memory_order_release);
+  }
+
+  /**
+   * Remove the oldest item which has not been overwritten yet.
+   *
+   * @return false if the buffer is empty
+   */
+  bool shift(T &value) noexcept {
+    while (true) {
+      const size_type w = write_index.load(std::memory_order_acquire);
+      if (read_index == w)
+        return false;
+
+      if (w - read_index > size)
+        /* the producer has overtaken us; skip the lost items */
+        read_index = w - size;
+
+      data[read_index & (size - 1)].Load(value);
+
+      std::atomic_thread_fence(std::memory_order_acquire);
+      const size_type reserved =
+        reserve_index.load(std::memory_order_relaxed);
+
+      /* the slot is overwritten by item number read_index+size,
+         which is reserved as reserve_index=read_index+size+1 */
+      if (reserved <= read_index + size) {
+        ++read_index;
+        return true;
+      }
+
+      /* the slot was overwritten while we were copying it; retry
+         with the next item which is still intact */
+    }
+  }
+
+  /**
+   * Discard all pending items except the newest one, and return it.
+   *
+   * @return false if the buffer is empty
+   */
+  bool shift_latest(T &value) noexcept {
+    const size_type w = write_index.load(std::memory_order_acquire);
+    if (read_index == w)
+      return false;
+
+    read_index = w - 1;
+    return shift(value);
+  }
+};
+
+#endif
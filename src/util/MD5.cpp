@@ -26,6 +26,7 @@
 
 #include <algorithm>
 #include <stdio.h>
+#include <string.h>
 
 static constexpr uint32_t k[64] = {
   // k[i] := floor(abs(sin(i)) * (2 pow 32))
@@ -133,8 +134,29 @@ MD5::Append(const void *data, size_t length)
 {
   const uint8_t *i = (const uint8_t *)data, *const end = i + length;
 
-  while (i != end)
-    Append(*i++);
+  unsigned position = unsigned(message_length) % ARRAY_SIZE(buff512bits);
+  message_length += length;
+
+  if (position > 0) {
+    /* fill up the partial block from the previous call */
+    const size_t n = std::min(size_t(ARRAY_SIZE(buff512bits) - position),
+                              length);
+    std::copy_n(i, n, buff512bits + position);
+    i += n;
+    position += n;
+
+    if (position < ARRAY_SIZE(buff512bits))
+      return;
+
+    Process512(buff512bits);
+  }
+
+  /* process whole blocks directly from the caller's buffer */
+  for (; size_t(end - i) >= ARRAY_SIZE(buff512bits);
+       i += ARRAY_SIZE(buff512bits))
+    Process512(i);
+
+  std::copy(i, end, buff512bits);
 }
 
 /**
@@ -196,9 +218,11 @@ MD5::Process512(const uint8_t *s512in)
 
   // copy the 64 chars into the 16 uint32_ts
   uint32_t w[16];
-  const uint32_t *s512_32 = (const uint32_t *)(const void *)s512in;
+  /* memcpy() because the input may be unaligned; it may point into
+     the caller's buffer (see Append()) */
+  memcpy(w, s512in, sizeof(w));
   for (int j = 0; j < 16; j++)
-    w[j] = ToLE32(s512_32[j]);
+    w[j] = ToLE32(w[j]);
 
   // Initialize hash value for this chunk:
   uint32_t a = state.a, b = state.b, c = state.c, d = state.d;
@@ -33,9 +33,11 @@
 
 #include "Compiler.h"
 
+#include <algorithm>
 #include <utility>
 #include <limits>
 #include <memory>
+#include <vector>
 
 #include <cassert>
 
@@ -468,6 +470,74 @@ protected:
 		}
 	};
 
+	/**
+	 * A bounded max-heap which collects the nearest Leaf objects for
+	 * VisitNearestIf().  The farthest one is on top; once the heap is
+	 * full, its distance limits the remaining search.
+	 */
+	class NearestHeap {
+		struct Item {
+			const Leaf *leaf;
+			distance_type square_distance;
+
+			constexpr
+			bool operator<(const Item &other) const noexcept {
+				return square_distance < other.square_distance;
+			}
+		};
+
+		std::vector<Item> items;
+		const std::size_t max_size;
+		distance_type square_range;
+
+	public:
+		NearestHeap(std::size_t _max_size, distance_type _square_range)
+			:max_size(_max_size), square_range(_square_range) {
+			assert(max_size > 0);
+
+			items.reserve(max_size);
+		}
+
+		constexpr
+		distance_type GetSquareRange() const noexcept {
+			return square_range;
+		}
+
+		void Add(const Leaf &leaf, distance_type square_distance) noexcept {
+			if (items.size() == max_size) {
+				if (square_distance >= square_range)
+					return;
+
+				/* replace the farthest one */
+				std::pop_heap(items.begin(), items.end());
+				items.back() = {&leaf, square_distance};
+			} else {
+				if (square_distance > square_range)
+					return;
+
+				/* no reallocation, the capacity has been reserved */
+				items.push_back({&leaf, square_distance});
+			}
+
+			std::push_heap(items.begin(), items.end());
+
+			if (items.size() == max_size)
+				square_range = items.front().square_distance;
+		}
+
+		/**
+		 * Sort the heap by ascending distance and invoke the visitor on
+		 * each value.
+		 */
+		template<class V>
+		void Visit(V &visitor) {
+			std::sort_heap(items.begin(), items.end());
+
+			for (const auto &i : items)
+				visitor((const T &)i.leaf->value);
+		}
+	};
+
 	struct QuadBucket;
 	using BucketAllocator = typename std::allocator_traits<Alloc>::template rebind_alloc<QuadBucket>;
 
@@ -766,6 +836,23 @@ protected:
 			else
 				leaves.VisitWithinRange(location, square_range, visitor);
 		}
+
+		template<class P>
+		void CollectNearestIf(const Rectangle &bounds, const Point location,
+				      NearestHeap &heap,
+				      const P &predicate) const noexcept {
+			if (!bounds.IsWithinSquareRange(location, heap.GetSquareRange()))
+				return;
+
+			if (IsSplitted()) {
+				children->CollectNearestIf(bounds, location, heap, predicate);
+				return;
+			}
+
+			for (const Leaf *i = leaves.head; i != nullptr; i = i->next)
+				if (predicate(i->value))
+					heap.Add(*i, i->SquareDistanceTo(location));
+		}
 	};
 
 	struct QuadBucket {
@@ -912,6 +999,37 @@ protected:
 			buckets[3].VisitWithinRange(GetBottomRight(bounds, middle),
 						    location, square_range, visitor);
 		}
+
+		template<class P>
+		void CollectNearestIf(const Rectangle &bounds, const Point location,
+				      NearestHeap &heap,
+				      const P &predicate) const noexcept {
+			const Point middle = bounds.GetMiddle();
+			const Rectangle child_bounds[N] = {
+				GetTopLeft(bounds, middle),
+				GetTopRight(bounds, middle),
+				GetBottomLeft(bounds, middle),
+				GetBottomRight(bounds, middle),
+			};
+
+			/* visit the nearest child bucket first; this fills the heap
+			   with near values early, and the farther buckets can then
+			   be skipped */
+			distance_type square_distance[N];
+			unsigned order[N];
+			for (unsigned i = 0; i < N; ++i) {
+				square_distance[i] = child_bounds[i].SquareDistanceTo(location);
+				order[i] = i;
+			}
+
+			std::sort(order, order + N, [&square_distance](unsigned a, unsigned b){
+				return square_distance[a] < square_distance[b];
+			});
+
+			for (const unsigned i : order)
+				buckets[i].CollectNearestIf(child_bounds[i], location, heap,
+							    predicate);
+		}
 	};
 
 	/**
@@ -1413,6 +1531,30 @@ public:
 			      V &visitor) const {
 		VisitWithinRange(GetPosition(value), range, visitor);
 	}
+
+	/**
+	 * Visit up to #max_results values within the range which match
+	 * the predicate, nearest first.  Unlike VisitWithinRange(), this
+	 * does not visit all values in range; buckets farther away than
+	 * the farthest result collected so far are skipped.
+	 */
+	template<class P, class V>
+	void VisitNearestIf(const Point location, distance_type range,
+			    std::size_t max_results,
+			    const P &predicate, V &&visitor) const {
+		if (max_results == 0 || IsEmpty())
+			return;
+
+		NearestHeap heap(max_results, Square(range));
+		root.CollectNearestIf(bounds, location, heap, predicate);
+		heap.Visit(visitor);
+	}
+
+	template<class V>
+	void VisitNearest(const Point location, distance_type range,
+			  std::size_t max_results, V &&visitor) const {
+		VisitNearestIf(location, range, max_results, AlwaysTrue(), visitor);
+	}
 };
 
 #endif
@@ -0,0 +1,183 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_RADIX_HEAP_HPP
+#define XCSOAR_RADIX_HEAP_HPP
+
+#include <array>
+#include <vector>
+#include <cassert>
+#include <cstddef>
+
+/**
+ * A min-priority queue for items with unsigned integer keys, for
+ * "monotone" uses like Dijkstra's algorithm, where no item is pushed
+ * with a key below that of the last popped item.  Items are stored
+ * in buckets by the highest bit in which their key differs from the
+ * last popped key, so push() is O(1) and pop() is amortised
+ * O(log C), with C being the key range.
+ *
+ * Pushing a key below the last popped one is allowed, but it
+ * redistributes all items in O(n).
+ *
+ * Each bucket keeps its capacity, so with a wide key range and many
+ * items, this needs more memory than a binary heap.
+ *
+ * @param GetKey a function object which returns the key of an item
+ */
+template<typename T, typename GetKey>
+class RadixHeap {
+  static constexpr unsigned N_BUCKETS = sizeof(unsigned) * 8 + 1;
+
+  /**
+   * Bucket 0 contains the items with a key equal to #last; bucket i
+   * contains the items whose key differs from #last in bit i-1, but
+   * not in any higher bit.
+   */
+  std::array<std::vector<T>, N_BUCKETS> buckets;
+
+  /**
+   * The key of the last popped item; no item in the heap has a lower
+   * key.
+   */
+  unsigned last = 0;
+
+  std::size_t n = 0;
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+  bool empty() const noexcept {
+    return n == 0;
+  }
+
+  size_type size() const noexcept {
+    return n;
+  }
+
+  void clear() noexcept {
+    for (auto &bucket : buckets)
+      bucket.clear();
+
+    last = 0;
+    n = 0;
+  }
+
+  void reserve(size_type capacity) noexcept {
+    buckets.front().reserve(capacity);
+  }
+
+  void push(const T &item) noexcept {
+    const unsigned key = GetKey()(item);
+    if (key < last)
+      /* rebase to zero, so a series of such pushes (without pop()
+         calls in between) costs only one redistribution */
+      Rebase(0);
+
+    buckets[FindBucket(key)].push_back(item);
+    ++n;
+  }
+
+  /**
+   * Returns the item with the lowest key.  This is not const,
+   * because it may move items to other buckets.
+   */
+  const T &top() noexcept {
+    assert(!empty());
+
+    if (buckets.front().empty())
+      Refill();
+
+    return buckets.front().back();
+  }
+
+  void pop() noexcept {
+    assert(!empty());
+
+    if (buckets.front().empty())
+      Refill();
+
+    buckets.front().pop_back();
+    --n;
+  }
+
+private:
+  unsigned FindBucket(unsigned key) const noexcept {
+    assert(key >= last);
+
+    const unsigned diff = key ^ last;
+    return diff == 0
+      ? 0
+      : sizeof(unsigned) * 8 - __builtin_clz(diff);
+  }
+
+  /**
+   * Move the lowest items to bucket 0, after it has run empty.
+   */
+  void Refill() noexcept {
+    assert(buckets.front().empty());
+
+    unsigned i = 1;
+    while (buckets[i].empty()) {
+      ++i;
+      assert(i < N_BUCKETS);
+    }
+
+    auto &bucket = buckets[i];
+
+    unsigned min = GetKey()(bucket.front());
+    for (const auto &item : bucket) {
+      const unsigned key = GetKey()(item);
+      if (key < min)
+        min = key;
+    }
+
+    /* all items of this bucket move to lower buckets */
+    last = min;
+    for (const auto &item : bucket)
+      buckets[FindBucket(GetKey()(item))].push_back(item);
+
+    bucket.clear();
+  }
+
+  /**
+   * Redistribute all items relative to a new (lower) #last key.
+   */
+  void Rebase(unsigned new_last) noexcept {
+    assert(new_last <= last);
+
+    std::vector<T> items;
+    items.reserve(n);
+    for (auto &bucket : buckets) {
+      items.insert(items.end(), bucket.begin(), bucket.end());
+      bucket.clear();
+    }
+
+    last = new_last;
+    for (const auto &item : items)
+      buckets[FindBucket(GetKey()(item))].push_back(item);
+  }
+};
+
+#endif
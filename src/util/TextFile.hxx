@@ -30,16 +30,35 @@
 #ifndef TEXT_FILE_HXX
 #define TEXT_FILE_HXX
 
+#include <cstddef>
 #include <cstring>
 
+/**
+ * Read and consume one line from the buffer, and null-terminate it.
+ *
+ * @param skip the number of bytes at the beginning of the buffer
+ * which are already known to contain no newline character (e.g. from
+ * a previous call which returned nullptr); it is updated when no
+ * complete line was found, allowing the caller to resume after
+ * refilling the buffer without scanning the same data again
+ * @return the line or nullptr if there is no complete line
+ */
 template<typename B>
 char *
-ReadBufferedLine(B &buffer)
+ReadBufferedLine(B &buffer, std::size_t &skip)
 {
 	auto r = buffer.Read();
-	char *newline = reinterpret_cast<char*>(std::memchr(r.data, '\n', r.size));
-	if (newline == nullptr)
+	if (skip > r.size)
+		skip = 0;
+
+	char *newline = reinterpret_cast<char*>(std::memchr(r.data + skip, '\n',
+							    r.size - skip));
+	if (newline == nullptr) {
+		skip = r.size;
 		return nullptr;
+	}
+
+	skip = 0;
 
 	buffer.Consume(newline + 1 - r.data);
 
@@ -49,4 +68,12 @@ ReadBufferedLine(B &buffer)
 	return r.data;
 }
 
+template<typename B>
+char *
+ReadBufferedLine(B &buffer)
+{
+	std::size_t skip = 0;
+	return ReadBufferedLine(buffer, skip);
+}
+
 #endif
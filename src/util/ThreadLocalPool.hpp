@@ -0,0 +1,187 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_THREAD_LOCAL_POOL_HPP
+#define XCSOAR_THREAD_LOCAL_POOL_HPP
+
+#include "Sanitizer.hxx"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <new>
+
+/**
+ * A per-thread cache of freed memory blocks, for containers which are
+ * built and destroyed over and over by the same thread (e.g. in each
+ * calculation cycle).  Sizes are rounded up to a power of two; freed
+ * blocks go to a free list of the current thread and are handed out
+ * again by the next allocation of that size class, so the steady
+ * state does not touch the global heap.
+ *
+ * Each block is allocated individually from the global heap, so a
+ * block may be freed by a different thread: it just moves to that
+ * thread's cache.  Each free list is capped at #MAX_CACHED_BYTES; the
+ * cache is released when its thread exits.
+ *
+ * With AddressSanitizer, everything is forwarded to the global heap,
+ * to avoid hiding memory errors.
+ */
+class ThreadLocalPool {
+  static constexpr unsigned MIN_SHIFT = 4, MAX_SHIFT = 16;
+  static constexpr unsigned N_CLASSES = MAX_SHIFT - MIN_SHIFT + 1;
+
+  /**
+   * The maximum number of bytes kept in each free list.
+   */
+  static constexpr std::size_t MAX_CACHED_BYTES = 256 * 1024;
+
+  struct FreeBlock {
+    FreeBlock *next;
+  };
+
+  struct SizeClass {
+    FreeBlock *head;
+    std::size_t n_cached;
+  };
+
+  /**
+   * The free lists of one thread.  This is trivially destructible,
+   * so it remains usable while other thread_local and static objects
+   * are destroyed.  Being thread_local, it is zero-initialised.
+   */
+  struct State {
+    std::array<SizeClass, N_CLASSES> classes;
+
+    /**
+     * Set by ~Releaser(); from then on, freed blocks are not cached.
+     */
+    bool released;
+  };
+
+  /**
+   * Frees the cached blocks when the thread exits.
+   */
+  struct Releaser {
+    ~Releaser() noexcept {
+      for (auto &c : state.classes) {
+        while (c.head != nullptr) {
+          FreeBlock *block = c.head;
+          c.head = block->next;
+          ::operator delete(block);
+        }
+
+        c.n_cached = 0;
+      }
+
+      state.released = true;
+    }
+  };
+
+  static inline thread_local State state;
+  static inline thread_local Releaser releaser;
+
+  static constexpr bool IsPooled(std::size_t size) noexcept {
+    return !HaveAddressSanitizer() && size <= (std::size_t(1) << MAX_SHIFT);
+  }
+
+  static constexpr unsigned GetClass(std::size_t size) noexcept {
+    return size <= (std::size_t(1) << MIN_SHIFT)
+      ? 0
+      : std::bit_width(size - 1) - MIN_SHIFT;
+  }
+
+  static constexpr std::size_t GetClassSize(unsigned c) noexcept {
+    return std::size_t(1) << (c + MIN_SHIFT);
+  }
+
+public:
+  static void *Allocate(std::size_t size) {
+    if (!IsPooled(size))
+      return ::operator new(size);
+
+    const unsigned i = GetClass(size);
+    SizeClass &c = state.classes[i];
+    if (c.head == nullptr)
+      return ::operator new(GetClassSize(i));
+
+    FreeBlock *block = c.head;
+    c.head = block->next;
+    --c.n_cached;
+    return block;
+  }
+
+  static void Deallocate(void *p, std::size_t size) noexcept {
+    if (!IsPooled(size)) {
+      ::operator delete(p);
+      return;
+    }
+
+    const unsigned i = GetClass(size);
+    SizeClass &c = state.classes[i];
+    if (state.released || c.n_cached * GetClassSize(i) >= MAX_CACHED_BYTES) {
+      ::operator delete(p);
+      return;
+    }
+
+    /* odr-use the Releaser, so its destructor gets registered for
+       this thread */
+    (void)&releaser;
+
+    FreeBlock *block = ::new(p) FreeBlock{c.head};
+    c.head = block;
+    ++c.n_cached;
+  }
+};
+
+/**
+ * A standard allocator which allocates from the #ThreadLocalPool.
+ * It is stateless, so all instances compare equal and containers
+ * may be moved and swapped freely, even between threads.
+ */
+template<typename T>
+class ThreadLocalPoolAllocator {
+public:
+  using value_type = T;
+
+  ThreadLocalPoolAllocator() noexcept = default;
+
+  template<typename U>
+  constexpr ThreadLocalPoolAllocator(const ThreadLocalPoolAllocator<U> &) noexcept {}
+
+  T *allocate(std::size_t n) {
+    static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+    return static_cast<T *>(ThreadLocalPool::Allocate(n * sizeof(T)));
+  }
+
+  void deallocate(T *p, std::size_t n) noexcept {
+    ThreadLocalPool::Deallocate(p, n * sizeof(T));
+  }
+
+  template<typename U>
+  constexpr bool operator==(const ThreadLocalPoolAllocator<U> &) const noexcept {
+    return true;
+  }
+};
+
+#endif
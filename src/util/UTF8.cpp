@@ -29,6 +29,8 @@ Copyright_License {
 #include <algorithm>
 
 #include <cassert>
+#include <cstdint>
+#include <cstring>
 
 /**
  * Is this a leading byte that is followed by 1 continuation byte?
@@ -120,6 +122,36 @@ MakeContinuation(unsigned char value) noexcept
   return 0x80 | (value & 0x3f);
 }
 
+bool
+IsPlainASCII(StringView s) noexcept
+{
+  const char *p = s.data;
+  std::size_t n = s.size;
+
+  /* check 32 bytes per iteration; the compiler can vectorise this
+     loop, and there is no early exit inside a block */
+  constexpr uint64_t HIGH_BITS = 0x8080808080808080ULL;
+  for (; n >= 32; p += 32, n -= 32) {
+    uint64_t words[4];
+    memcpy(words, p, sizeof(words));
+    if (((words[0] | words[1] | words[2] | words[3]) & HIGH_BITS) != 0)
+      return false;
+  }
+
+  for (; n >= 8; p += 8, n -= 8) {
+    uint64_t word;
+    memcpy(&word, p, sizeof(word));
+    if ((word & HIGH_BITS) != 0)
+      return false;
+  }
+
+  for (; n > 0; ++p, --n)
+    if (!IsASCII(*p))
+      return false;
+
+  return true;
+}
+
 bool
 ValidateUTF8(const char *p) noexcept
 {
@@ -29,6 +29,18 @@ Copyright_License {
 
 struct StringView;
 
+/**
+ * Does this string consist only of 7 bit ASCII characters?  Such a
+ * string is valid UTF-8 and ISO-Latin-1 at the same time, and does
+ * not need any conversion.
+ *
+ * This checks many bytes at a time and is much faster than
+ * ValidateUTF8() on long strings.
+ */
+[[gnu::pure]]
+bool
+IsPlainASCII(StringView p) noexcept;
+
 /**
  * Is this a valid UTF-8 string?
  */
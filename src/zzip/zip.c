@@ -896,6 +896,16 @@ zzip_dir_read(ZZIP_DIR * dir, ZZIP_DIRENT * d)
     return 1;
 }
 
+/** => zzip_dir_open
+ * resets the read-pointer of the dir-argument to the first entry.
+ */
+void
+zzip_rewinddir(ZZIP_DIR * dir)
+{
+    if (dir)
+        dir->hdr = dir->hdr0;
+}
+
 /*
  * Local variables:
  * c-file-style: "stroustrup"
@@ -0,0 +1,95 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "AllocationCounter.hpp"
+
+#include <cstdlib>
+#include <new>
+
+static std::size_t live_bytes, peak_bytes;
+static std::size_t n_allocations;
+
+/* each block is prefixed with its size */
+static constexpr std::size_t HEADER_SIZE = 2 * sizeof(std::size_t);
+
+void *
+operator new(std::size_t size)
+{
+  auto *p = static_cast<std::size_t *>(malloc(HEADER_SIZE + size));
+  if (p == nullptr)
+    throw std::bad_alloc();
+
+  *p = size;
+  ++n_allocations;
+  live_bytes += size;
+  if (live_bytes > peak_bytes)
+    peak_bytes = live_bytes;
+
+  return reinterpret_cast<char *>(p) + HEADER_SIZE;
+}
+
+void
+operator delete(void *p) noexcept
+{
+  if (p == nullptr)
+    return;
+
+  auto *h = reinterpret_cast<std::size_t *>(static_cast<char *>(p)
+                                            - HEADER_SIZE);
+  live_bytes -= *h;
+  free(h);
+}
+
+void
+operator delete(void *p, std::size_t) noexcept
+{
+  operator delete(p);
+}
+
+namespace AllocationCounter {
+
+std::size_t
+GetLiveBytes() noexcept
+{
+  return live_bytes;
+}
+
+std::size_t
+GetPeakBytes() noexcept
+{
+  return peak_bytes;
+}
+
+std::size_t
+GetAllocations() noexcept
+{
+  return n_allocations;
+}
+
+void
+ResetPeak() noexcept
+{
+  peak_bytes = live_bytes;
+}
+
+} // namespace AllocationCounter
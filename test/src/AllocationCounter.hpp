@@ -0,0 +1,68 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_ALLOCATION_COUNTER_HPP
+#define XCSOAR_ALLOCATION_COUNTER_HPP
+
+#include <cstddef>
+
+/**
+ * Linking AllocationCounter.cpp into a program replaces the global
+ * operator new and operator delete with versions which count the
+ * number of bytes on the heap.  This is used by benchmark programs
+ * to measure the memory used by a data structure, and the number of
+ * allocations done by an algorithm.
+ */
+namespace AllocationCounter {
+
+/**
+ * Returns the number of bytes currently allocated.
+ */
+[[gnu::pure]]
+std::size_t
+GetLiveBytes() noexcept;
+
+/**
+ * Returns the largest number of bytes allocated at a time since the
+ * last ResetPeak() call.
+ */
+[[gnu::pure]]
+std::size_t
+GetPeakBytes() noexcept;
+
+/**
+ * Returns the number of allocations since the program was started.
+ */
+[[gnu::pure]]
+std::size_t
+GetAllocations() noexcept;
+
+/**
+ * Start a new peak measurement at the current number of bytes.
+ */
+void
+ResetPeak() noexcept;
+
+} // namespace AllocationCounter
+
+#endif
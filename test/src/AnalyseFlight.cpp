@@ -34,9 +34,26 @@
 #include "FlightPhaseJSON.hpp"
 #include "Computer/Settings.hpp"
 #include "util/StringCompare.hxx"
+#include "util/Exception.hxx"
+#include "DebugReplayIGC.hpp"
+#include "system/PathName.hpp"
+
+#include <boost/json/serialize.hpp>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
 
 using namespace std::chrono;
 
+struct AnalyseOptions {
+  unsigned full_max_points = 512,
+           triangle_max_points = 1024,
+           sprint_max_points = 64;
+};
+
 struct Result {
   BrokenDateTime takeoff_time, release_time, landing_time;
   GeoPoint takeoff_location, release_location, landing_location;
@@ -52,9 +69,23 @@ struct Result {
   }
 };
 
+/**
+ * The state of the analysis of one flight.  Each flight gets its own
+ * instance, so several flights can be analysed in parallel.
+ */
+struct FlightAnalysis {
+  CirclingComputer circling_computer;
+  FlightPhaseDetector flight_phase_detector;
+
+  Trace full_trace, triangle_trace, sprint_trace;
+
+  Result result;
 
-static CirclingComputer circling_computer;
-static FlightPhaseDetector flight_phase_detector;
+  explicit FlightAnalysis(const AnalyseOptions &options)
+    :full_trace({}, Trace::null_time, options.full_max_points),
+     triangle_trace({}, Trace::null_time, options.triangle_max_points),
+     sprint_trace({}, minutes{150}, options.sprint_max_points) {}
+};
 
 static void
 Update(const MoreData &basic, const FlyingState &state,
@@ -88,7 +119,8 @@ Update(const MoreData &basic, const DerivedInfo &calculated,
 }
 
 static void
-ComputeCircling(DebugReplay &replay, const CirclingSettings &circling_settings)
+ComputeCircling(CirclingComputer &circling_computer,
+                DebugReplay &replay, const CirclingSettings &circling_settings)
 {
   circling_computer.TurnRate(replay.SetCalculated(),
                              replay.Basic(),
@@ -115,9 +147,14 @@ Finish(const MoreData &basic, const DerivedInfo &calculated,
 }
 
 static void
-Run(DebugReplay &replay, Result &result,
-    Trace &full_trace, Trace &triangle_trace, Trace &sprint_trace)
+Run(DebugReplay &replay, FlightAnalysis &analysis)
 {
+  Result &result = analysis.result;
+  FlightPhaseDetector &flight_phase_detector = analysis.flight_phase_detector;
+  Trace &full_trace = analysis.full_trace;
+  Trace &triangle_trace = analysis.triangle_trace;
+  Trace &sprint_trace = analysis.sprint_trace;
+
   CirclingSettings circling_settings;
   circling_settings.SetDefaults();
 
@@ -128,7 +165,7 @@ Run(DebugReplay &replay, Result &result,
   constexpr Angle max_latitude_change = Angle::Degrees(1);
 
   while (replay.Next()) {
-    ComputeCircling(replay, circling_settings);
+    ComputeCircling(analysis.circling_computer, replay, circling_settings);
 
     const MoreData &basic = replay.Basic();
 
@@ -320,18 +357,104 @@ WriteContests(const ContestStatistics &olc_plus,
   return object;
 }
 
+/**
+ * Replay the whole flight as fast as possible and write the results
+ * to the given JSON object.
+ */
+static void
+AnalyseFlight(DebugReplay &replay, const AnalyseOptions &options,
+              boost::json::object &root)
+{
+  /* the traces are large; allocate them on the heap */
+  const auto analysis = std::make_unique<FlightAnalysis>(options);
+
+  Run(replay, *analysis);
+
+  const ContestStatistics olc_plus =
+    SolveContest(Contest::OLC_PLUS, analysis->full_trace,
+                 analysis->triangle_trace, analysis->sprint_trace);
+  const ContestStatistics dmst =
+    SolveContest(Contest::DMST, analysis->full_trace,
+                 analysis->triangle_trace, analysis->sprint_trace);
+
+  const FlightPhaseDetector &flight_phase_detector =
+    analysis->flight_phase_detector;
+
+  WriteResult(root, analysis->result);
+  root.emplace("phases", WritePhaseList(flight_phase_detector.GetPhases()));
+  root.emplace("performance",
+               WritePerformanceStats(flight_phase_detector.GetTotals()));
+  root.emplace("contests", WriteContests(olc_plus, dmst));
+}
+
+/**
+ * Analyse one IGC file of a batch.  Errors are reported in the
+ * "error" attribute instead of aborting the whole batch.
+ *
+ * @return the serialized JSON object (one line)
+ */
+static std::string
+AnalyseFile(Path path, const AnalyseOptions &options)
+{
+  boost::json::object root;
+  root.emplace("file", path.ToUTF8());
+
+  try {
+    const std::unique_ptr<DebugReplay> replay(DebugReplayIGC::Create(path));
+    AnalyseFlight(*replay, options, root);
+  } catch (...) {
+    root.emplace("error", GetFullMessage(std::current_exception()));
+  }
+
+  return boost::json::serialize(root);
+}
+
+/**
+ * Analyse many IGC files in parallel, with one #DebugReplay and one
+ * #FlightAnalysis per file.  For each file, one line of JSON is
+ * printed, in the order of the command line.
+ */
+static void
+RunBatch(const std::vector<AllocatedPath> &files, unsigned n_jobs,
+         const AnalyseOptions &options)
+{
+  std::vector<std::string> results(files.size());
+  std::atomic_size_t next{0};
+
+  const auto worker = [&]{
+    for (std::size_t i; (i = next.fetch_add(1)) < files.size();)
+      results[i] = AnalyseFile(files[i], options);
+  };
+
+  n_jobs = std::min<std::size_t>(n_jobs, files.size());
+
+  std::vector<std::thread> threads;
+  threads.reserve(n_jobs);
+  for (unsigned i = 0; i < n_jobs; ++i)
+    threads.emplace_back(worker);
+
+  for (auto &i : threads)
+    i.join();
+
+  for (const auto &i : results) {
+    fputs(i.c_str(), stdout);
+    fputc('\n', stdout);
+  }
+}
+
 int main(int argc, char **argv)
 {
-  unsigned full_max_points = 512,
-           triangle_max_points = 1024,
-           sprint_max_points = 64;
+  AnalyseOptions options;
+  unsigned n_jobs = std::max(std::thread::hardware_concurrency(), 1u);
 
   Args args(argc, argv,
             "[options] DRIVER FILE\n"
+            "       [options] FILE1.igc FILE2.igc ...\n"
             "Options:\n"
             "  --full-points=512        Maximum number of full trace points (default = 512)\n"
             "  --triangle-points=1024   Maximum number of triangle trace points (default = 1024)\n"
-            "  --sprint-points=64       Maximum number of sprint trace points (default = 64)");
+            "  --sprint-points=64       Maximum number of sprint trace points (default = 64)\n"
+            "  --jobs=N                 Number of IGC files analysed in parallel (default = number of CPUs)");
 
   const char *arg;
   while ((arg = args.PeekNext()) != nullptr && *arg == '-') {
@@ -341,7 +464,7 @@ int main(int argc, char **argv)
     if ((value = StringAfterPrefix(arg, "--full-points=")) != nullptr) {
       unsigned _points = strtol(value, NULL, 10);
       if (_points > 0)
-        full_max_points = _points;
+        options.full_max_points = _points;
       else {
         fputs("The start parameter could not be parsed correctly.\n", stderr);
         args.UsageError();
@@ -350,7 +473,7 @@ int main(int argc, char **argv)
     } else if ((value = StringAfterPrefix(arg, "--triangle-points=")) != nullptr) {
       unsigned _points = strtol(value, NULL, 10);
       if (_points > 0)
-        triangle_max_points = _points;
+        options.triangle_max_points = _points;
       else {
         fputs("The start parameter could not be parsed correctly.\n", stderr);
         args.UsageError();
@@ -359,47 +482,53 @@ int main(int argc, char **argv)
     } else if ((value = StringAfterPrefix(arg, "--sprint-points=")) != nullptr) {
       unsigned _points = strtol(value, NULL, 10);
       if (_points > 0)
-        sprint_max_points = _points;
+        options.sprint_max_points = _points;
       else {
         fputs("The start parameter could not be parsed correctly.\n", stderr);
         args.UsageError();
       }
 
+    } else if ((value = StringAfterPrefix(arg, "--jobs=")) != nullptr) {
+      unsigned _jobs = strtol(value, NULL, 10);
+      if (_jobs > 0)
+        n_jobs = _jobs;
+      else {
+        fputs("The jobs parameter could not be parsed correctly.\n", stderr);
+        args.UsageError();
+      }
+
     } else {
       args.UsageError();
     }
   }
 
-  DebugReplay *replay = CreateDebugReplay(args);
-  if (replay == NULL)
-    return EXIT_FAILURE;
-
-  args.ExpectEnd();
+  DebugReplay *replay;
 
-  static Trace full_trace({}, Trace::null_time, full_max_points);
-  static Trace triangle_trace({}, Trace::null_time, triangle_max_points);
-  static Trace sprint_trace({}, minutes{150}, sprint_max_points);
-
-  Result result;
-  Run(*replay, result, full_trace, triangle_trace, sprint_trace);
-  delete replay;
+  if (!args.IsEmpty() && MatchesExtension(args.PeekNext(), ".igc")) {
+    std::vector<AllocatedPath> files;
+    while (!args.IsEmpty())
+      files.emplace_back(args.ExpectNextPath());
 
-  const ContestStatistics olc_plus = SolveContest(Contest::OLC_PLUS, full_trace, triangle_trace, sprint_trace);
-  const ContestStatistics dmst = SolveContest(Contest::DMST, full_trace, triangle_trace, sprint_trace);
+    if (files.size() > 1) {
+      RunBatch(files, n_jobs, options);
+      return EXIT_SUCCESS;
+    }
 
-  StdioOutputStream os(stdout);
+    replay = DebugReplayIGC::Create(files.front());
+  } else {
+    replay = CreateDebugReplay(args);
+    if (replay == NULL)
+      return EXIT_FAILURE;
 
-  {
-    boost::json::object root;
+    args.ExpectEnd();
+  }
 
-    WriteResult(root, result);
-    root.emplace("phases", WritePhaseList(flight_phase_detector.GetPhases()));
-    root.emplace("performance",
-                 WritePerformanceStats(flight_phase_detector.GetTotals()));
-    root.emplace("contests", WriteContests(olc_plus, dmst));
+  boost::json::object root;
+  AnalyseFlight(*replay, options, root);
+  delete replay;
 
-    Json::Serialize(os, root);
-  }
+  StdioOutputStream os(stdout);
+  Json::Serialize(os, root);
 
   return EXIT_SUCCESS;
 }
@@ -0,0 +1,184 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Measure the edge intersection kernel used by
+ * AirspacePolygon::Intersects() on the polygons of an airspace file,
+ * comparing the optimised implementation with the generic one.
+ */
+
+#include "Airspace/AirspaceParser.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "Engine/Airspace/AbstractAirspace.hpp"
+#include "Geo/PolygonIntersections.hpp"
+#include "Geo/Flat/FlatRay.hpp"
+#include "Geo/GeoBounds.hpp"
+#include "Geo/GeoVector.hpp"
+#include "Operation/Operation.hpp"
+#include "system/Args.hpp"
+#include "io/FileLineReader.hpp"
+#include "util/PrintException.hxx"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include <stdio.h>
+
+using IntersectionsFunction = decltype(&FindDistinctIntersectionsGeneric);
+
+/**
+ * The number of random rays per polygon.
+ */
+static constexpr unsigned SAMPLES = 64;
+
+/**
+ * The maximum length of the random rays [m], similar to the
+ * look-ahead of the airspace warnings.
+ */
+static constexpr double MAX_RAY_LENGTH = 20000;
+
+static constexpr unsigned ITERATIONS = 20;
+
+struct Sample {
+  const SearchPointVector *border;
+  FlatRay ray;
+};
+
+/**
+ * Iterate over all edges in blocks, just like
+ * AirspacePolygon::Intersects().
+ */
+static unsigned
+CountIntersections(IntersectionsFunction f, const std::vector<Sample> &samples)
+{
+  unsigned n = 0;
+  for (const auto &i : samples) {
+    const SearchPoint *points = i.border->data();
+    const std::size_t n_edges = i.border->size() - 1;
+    for (std::size_t j = 0; j < n_edges; j += MAX_INTERSECTION_EDGES) {
+      const std::size_t n_block = std::min(n_edges - j,
+                                           MAX_INTERSECTION_EDGES);
+      /* the returned masks are summed up to detect mismatches */
+      n += f(i.ray, points + j, n_block) * (j + 1);
+    }
+  }
+  return n;
+}
+
+template<typename F>
+static double
+Measure(F &&f, unsigned &result)
+{
+  const auto start = std::chrono::steady_clock::now();
+  for (unsigned i = 0; i < ITERATIONS; ++i)
+    result = f();
+  const std::chrono::duration<double, std::milli> duration =
+    std::chrono::steady_clock::now() - start;
+  return duration.count() / ITERATIONS;
+}
+
+static void
+Run(const char *name, const std::vector<Sample> &samples)
+{
+  unsigned expected, actual;
+
+  const double generic = Measure([&]{
+    return CountIntersections(FindDistinctIntersectionsGeneric, samples);
+  }, expected);
+  const double optimised = Measure([&]{
+    return CountIntersections(FindDistinctIntersections, samples);
+  }, actual);
+
+  printf("%-6s generic %8.3f ms  optimised %8.3f ms  speedup %.1fx%s\n",
+         name, generic, optimised, generic / optimised,
+         expected == actual ? "" : "  MISMATCH");
+}
+
+int main(int argc, char **argv)
+try {
+  Args args(argc, argv, "PATH");
+  const auto path = args.ExpectNextPath();
+  args.ExpectEnd();
+
+  FileLineReader reader(path, Charset::AUTO);
+
+  Airspaces airspaces;
+  NullOperationEnvironment operation;
+  if (!ParseAirspaceFile(airspaces, reader, operation)) {
+    fprintf(stderr, "Failed to parse input file\n");
+    return EXIT_FAILURE;
+  }
+
+  airspaces.Optimise();
+
+  const FlatProjection &projection = airspaces.GetProjection();
+
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<double> distribution(-0.25, 1.25);
+  std::uniform_real_distribution<double> length_distribution(0, MAX_RAY_LENGTH);
+  std::uniform_real_distribution<double> bearing_distribution(0, 360);
+
+  /* random points and rays starting in and around each polygon's
+     bounding box */
+  std::vector<Sample> all, large;
+  for (const auto &i : airspaces.QueryAll()) {
+    const AbstractAirspace &airspace = i.GetAirspace();
+    if (airspace.GetShape() != AbstractAirspace::Shape::POLYGON)
+      continue;
+
+    const auto &border = airspace.GetPoints();
+    const GeoBounds bounds = airspace.GetGeoBounds();
+    const auto random_point = [&]{
+      return GeoPoint(bounds.GetWest() +
+                      (bounds.GetEast() - bounds.GetWest()) * distribution(rng),
+                      bounds.GetSouth() +
+                      (bounds.GetNorth() - bounds.GetSouth()) * distribution(rng));
+    };
+
+    for (unsigned j = 0; j < SAMPLES; ++j) {
+      const GeoPoint a = random_point();
+      const GeoPoint b =
+        GeoVector(length_distribution(rng),
+                  Angle::Degrees(bearing_distribution(rng))).EndPoint(a);
+      const Sample sample{&border,
+        FlatRay(projection.ProjectInteger(a), projection.ProjectInteger(b))};
+      all.push_back(sample);
+      if (border.size() >= 500)
+        large.push_back(sample);
+    }
+  }
+
+  printf("%zu polygons, %zu with at least 500 vertices\n",
+         all.size() / SAMPLES, large.size() / SAMPLES);
+
+  Run("all", all);
+  if (!large.empty())
+    Run(">=500", large);
+
+  return EXIT_SUCCESS;
+} catch (const std::runtime_error &e) {
+  PrintException(e);
+  return EXIT_FAILURE;
+}
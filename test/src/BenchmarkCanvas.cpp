@@ -0,0 +1,284 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Measure the memory canvas primitives (fills, blends, polygons and
+ * lines) in both pixel formats.  The SIMD implementations selected by
+ * Optimised.hpp are compared with the portable ones, and each
+ * mismatching pixel is reported.
+ */
+
+#include "ui/canvas/memory/PixelTraits.hpp"
+#include "ui/canvas/memory/Optimised.hpp"
+#include "ui/canvas/memory/RasterCanvas.hpp"
+#include "ui/canvas/memory/Dither.hpp"
+
+#include <chrono>
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+static constexpr unsigned WIDTH = 800, HEIGHT = 480;
+static constexpr unsigned ITERATIONS = 200;
+
+template<typename PixelTraits>
+struct Screen {
+  using color_type = typename PixelTraits::color_type;
+
+  WritableImageBuffer<PixelTraits> buffer;
+
+  Screen() noexcept {
+    buffer.Allocate(WIDTH, HEIGHT);
+    Clear();
+  }
+
+  ~Screen() noexcept {
+    buffer.Free();
+  }
+
+  Screen(const Screen &) = delete;
+  Screen &operator=(const Screen &) = delete;
+
+  /**
+   * Fill the buffer with a deterministic pattern.
+   */
+  void Clear() noexcept {
+    auto *p = (uint8_t *)buffer.data;
+    for (unsigned i = 0, n = buffer.pitch * buffer.height; i < n; ++i)
+      p[i] = uint8_t(i * 7 + (i >> 9));
+  }
+
+  /**
+   * Count the pixels whose color channels differ by more than the
+   * given tolerance.  The alpha channel is ignored, because the
+   * portable BGRA implementations leave it alone.
+   */
+  unsigned CountMismatches(const Screen &other,
+                           int tolerance) const noexcept {
+    unsigned n = 0;
+    for (unsigned y = 0; y < HEIGHT; ++y) {
+      for (unsigned x = 0; x < WIDTH; ++x) {
+        bool mismatch = false;
+        PixelTraits::TransformChannels(PixelTraits::ReadPixel(buffer.At(x, y)),
+                                       PixelTraits::ReadPixel(other.buffer.At(x, y)),
+                                       [&mismatch, tolerance](uint8_t a,
+                                                              uint8_t b){
+            if (abs(int(a) - int(b)) > tolerance)
+              mismatch = true;
+            return a;
+          });
+
+        if (mismatch)
+          ++n;
+      }
+    }
+
+    return n;
+  }
+};
+
+template<typename F>
+static void
+Measure(const char *name, unsigned pixels, F &&f) noexcept
+{
+  const auto start = std::chrono::steady_clock::now();
+  for (unsigned i = 0; i < ITERATIONS; ++i)
+    f(i);
+  const std::chrono::duration<double> duration =
+    std::chrono::steady_clock::now() - start;
+
+  printf("  %-20s %8.1f Mpixel/s\n", name,
+         double(pixels) * ITERATIONS / duration.count() / 1e6);
+}
+
+template<typename Optimised, typename Portable, typename PixelTraits>
+static void
+Compare(const char *name, Screen<PixelTraits> &a, Screen<PixelTraits> &b,
+        const Screen<PixelTraits> &src,
+        Optimised optimised, Portable portable,
+        int tolerance=0) noexcept
+{
+  a.Clear();
+  b.Clear();
+
+  RasterCanvas<PixelTraits> ca(a.buffer), cb(b.buffer);
+
+  /* odd offsets and widths to exercise the portable remainder */
+  ca.CopyRectangle(3, 5, WIDTH - 7, HEIGHT - 9,
+                   src.buffer.data, src.buffer.pitch, optimised);
+  cb.CopyRectangle(3, 5, WIDTH - 7, HEIGHT - 9,
+                   src.buffer.data, src.buffer.pitch, portable);
+
+  const unsigned mismatches = a.CountMismatches(b, tolerance);
+  if (mismatches > 0)
+    printf("  %s: %u pixels differ from the portable implementation\n",
+         name, mismatches);
+}
+
+template<typename PixelTraits>
+static void
+Run(const char *format, typename PixelTraits::color_type color,
+    typename PixelTraits::color_type key) noexcept
+{
+  printf("%s\n", format);
+
+  Screen<PixelTraits> screen, src, a, b;
+  RasterCanvas<PixelTraits> canvas(screen.buffer);
+
+  /* make some source pixels match the color key */
+  RasterCanvas<PixelTraits> src_canvas(src.buffer);
+  for (unsigned x = 0; x < WIDTH; x += 3)
+    src_canvas.FillRectangle(x, 0, x + 1, HEIGHT, key);
+
+  const auto src_data = src.buffer.data;
+  const auto src_pitch = src.buffer.pitch;
+
+  Measure("fill", WIDTH * HEIGHT, [&](unsigned){
+      canvas.FillRectangle(0, 0, WIDTH, HEIGHT, color);
+    });
+
+  Measure("alpha fill", WIDTH * HEIGHT, [&](unsigned){
+      canvas.FillRectangle(0, 0, WIDTH, HEIGHT, color,
+                           AlphaPixelOperations<PixelTraits>(0x80));
+    });
+
+  Measure("alpha copy", WIDTH * HEIGHT, [&](unsigned){
+      canvas.CopyRectangle(0, 0, WIDTH, HEIGHT, src_data, src_pitch,
+                           AlphaPixelOperations<PixelTraits>(0x80));
+    });
+
+  Measure("transparent copy", WIDTH * HEIGHT, [&](unsigned){
+      canvas.CopyRectangle(0, 0, WIDTH, HEIGHT, src_data, src_pitch,
+                           TransparentPixelOperations<PixelTraits>(key));
+    });
+
+  Measure("bit-or copy", WIDTH * HEIGHT, [&](unsigned){
+      canvas.CopyRectangle(0, 0, WIDTH, HEIGHT, src_data, src_pitch,
+                           BitOrPixelOperations<PixelTraits>());
+    });
+
+  /* a star-shaped polygon covering roughly 40% of the screen */
+  static constexpr unsigned N_POLYGON = 16;
+  PixelPoint polygon[N_POLYGON];
+  for (unsigned i = 0; i < N_POLYGON; ++i) {
+    const int r = i % 2 ? HEIGHT / 2 : HEIGHT / 4;
+    static constexpr int dx[] = {0, 38, 70, 92, 100, 92, 70, 38,
+                                 0, -38, -70, -92, -100, -92, -70, -38};
+    static constexpr int dy[] = {100, 92, 70, 38, 0, -38, -70, -92,
+                                 -100, -92, -70, -38, 0, 38, 70, 92};
+    polygon[i] = PixelPoint(WIDTH / 2 + r * dx[i] / 100,
+                            HEIGHT / 2 + r * dy[i] / 100);
+  }
+
+  Measure("alpha polygon", WIDTH * HEIGHT * 2 / 5, [&](unsigned){
+      canvas.FillPolygon(polygon, N_POLYGON, color,
+                         AlphaPixelOperations<PixelTraits>(0x80));
+    });
+
+  /* 100 lines, each about WIDTH pixels long */
+  Measure("lines", 100 * WIDTH, [&](unsigned i){
+      for (unsigned j = 0; j < 100; ++j)
+        canvas.DrawLine(0, (i + j) % HEIGHT, WIDTH - 1, (j * 5) % HEIGHT,
+                        color);
+    });
+
+  Measure("thick lines", 100 * WIDTH * 3, [&](unsigned i){
+      unsigned mask_position = 0;
+      for (unsigned j = 0; j < 100; ++j)
+        canvas.DrawThickLine(0, (i + j) % HEIGHT,
+                             WIDTH - 1, (j * 5) % HEIGHT,
+                             3, color, -1, mask_position);
+    });
+
+  /* the SIMD implementations round differently */
+  Compare("alpha copy", a, b, src,
+          AlphaPixelOperations<PixelTraits>(0x50),
+          PortableAlphaPixelOperations<PixelTraits>(0x50), 1);
+  Compare("transparent copy", a, b, src,
+          TransparentPixelOperations<PixelTraits>(key),
+          PortableTransparentPixelOperations<PixelTraits>(key));
+  Compare("bit-or copy", a, b, src,
+          BitOrPixelOperations<PixelTraits>(),
+          PortableBitOrPixelOperations<PixelTraits>());
+}
+
+/**
+ * Dither a frame with a small moving rectangle, once completely and
+ * once incrementally, and verify that both results are identical.
+ */
+static void
+RunDither() noexcept
+{
+  printf("dither\n");
+
+  Screen<GreyscalePixelTraits> screen;
+  RasterCanvas<GreyscalePixelTraits> canvas(screen.buffer);
+
+  const auto *src = (const uint8_t *)screen.buffer.data;
+  const unsigned src_pitch = screen.buffer.pitch;
+
+  AllocatedArray<uint8_t> full(WIDTH * HEIGHT),
+    incremental(WIDTH * HEIGHT);
+
+  Dither full_dither, incremental_dither;
+  incremental_dither.DitherGreyscaleIncremental(src, src_pitch,
+                                                incremental.data(), WIDTH,
+                                                WIDTH, HEIGHT, true);
+
+  const auto move = [&](unsigned i){
+    const unsigned x = (i * 13) % (WIDTH - 40);
+    const unsigned y = (i * 29) % (HEIGHT - 20);
+    canvas.FillRectangle(x, y, x + 40, y + 20, Luminosity8(i * 5));
+  };
+
+  Measure("full", WIDTH * HEIGHT, [&](unsigned i){
+      move(i);
+      full_dither.DitherGreyscale(src, src_pitch, full.data(), WIDTH,
+                                  WIDTH, HEIGHT);
+    });
+
+  screen.Clear();
+  incremental_dither.DitherGreyscaleIncremental(src, src_pitch,
+                                                incremental.data(), WIDTH,
+                                                WIDTH, HEIGHT, false);
+
+  Measure("incremental", WIDTH * HEIGHT, [&](unsigned i){
+      move(i);
+      incremental_dither.DitherGreyscaleIncremental(src, src_pitch,
+                                                    incremental.data(), WIDTH,
+                                                    WIDTH, HEIGHT, false);
+    });
+
+  if (memcmp(full.data(), incremental.data(), WIDTH * HEIGHT) != 0)
+    printf("  incremental dithering differs from full dithering\n");
+}
+
+int main(int argc, char **argv)
+{
+  Run<GreyscalePixelTraits>("greyscale", Luminosity8(0x40), Luminosity8(0x23));
+  Run<BGRAPixelTraits>("BGRA", BGRA8Color(0x20, 0x40, 0x80, 0xff),
+                       BGRA8Color(0x23, 0x2a, 0x31, 0x38));
+  RunDither();
+  return 0;
+}
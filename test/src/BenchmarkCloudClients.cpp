@@ -0,0 +1,89 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Measure CloudClientContainer with 50000 gliders moving over central
+ * Europe, each submitting one fix every 5 seconds.  Every fix is
+ * followed by a traffic query, like in the xcsoar-cloud-server.
+ */
+
+#include "Cloud/Client.hpp"
+#include "Geo/GeoVector.hpp"
+#include "net/IPv4Address.hxx"
+
+#include <chrono>
+#include <random>
+
+#include <stdio.h>
+
+static constexpr unsigned N_CLIENTS = 50000;
+static constexpr unsigned FIX_INTERVAL = 5; // seconds
+static constexpr unsigned SIMULATED_SECONDS = 20;
+static constexpr double SPEED = 30; // m/s
+static constexpr double TRAFFIC_RANGE = 50000;
+
+struct Glider {
+  GeoPoint location;
+  Angle bearing;
+};
+
+int main(int argc, char **argv)
+{
+  static Glider gliders[N_CLIENTS];
+  static CloudClientContainer clients;
+
+  const IPv4Address address(127, 0, 0, 1, 5597);
+
+  /* fixed seed, so all runs simulate the same flights */
+  std::minstd_rand rng{42};
+  for (unsigned i = 0; i < N_CLIENTS; ++i) {
+    auto &g = gliders[i];
+    g.location = GeoPoint(Angle::Degrees(0 + rng() % 2000 / 100.),
+                          Angle::Degrees(44 + rng() % 1000 / 100.));
+    g.bearing = Angle::Degrees(rng() % 360);
+    clients.Make(address, i + 1, g.location, 1000);
+  }
+
+  unsigned long n_fixes = 0, n_results = 0;
+
+  const auto start = std::chrono::steady_clock::now();
+  for (unsigned t = 0; t < SIMULATED_SECONDS; ++t) {
+    /* each second, one fifth of the gliders submits a fix */
+    for (unsigned i = t % FIX_INTERVAL; i < N_CLIENTS; i += FIX_INTERVAL) {
+      auto &g = gliders[i];
+      g.location = GeoVector(SPEED * FIX_INTERVAL, g.bearing)
+        .EndPoint(g.location);
+
+      clients.Make(address, i + 1, g.location, 1000);
+      n_results += clients.QueryWithinRange(g.location, TRAFFIC_RANGE).size();
+      ++n_fixes;
+    }
+  }
+  const std::chrono::duration<double> duration =
+    std::chrono::steady_clock::now() - start;
+
+  printf("%lu fixes, %.0f fixes per second, %.1f clients per query\n",
+         n_fixes, n_fixes / duration.count(), double(n_results) / n_fixes);
+
+  return 0;
+}
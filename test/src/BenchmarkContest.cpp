@@ -0,0 +1,283 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Replay a directory of IGC files through each contest solver, both
+ * incrementally (like ContestComputer does in flight) and
+ * exhaustively (like the final analysis after landing).  Prints one
+ * tab-separated line per file, solver and mode with the total and
+ * the longest per-call wall time, the peak heap usage, the largest
+ * Dijkstra queue and the result, so the output of two releases can
+ * be compared with diff or a spreadsheet.  The optional second
+ * argument sets the ContestDijkstra time budget of the incremental
+ * runs.
+ *
+ * The composite contests (OLC League, OLC Plus, WeGlide Free) are
+ * not listed; they only combine the results of the solvers below.
+ */
+
+#include "system/Args.hpp"
+#include "system/FileUtil.hpp"
+#include "system/Path.hpp"
+#include "DebugReplayIGC.hpp"
+#include "AllocationCounter.hpp"
+#include "Engine/Trace/Trace.hpp"
+#include "Engine/Contest/Solvers/ContestDijkstra.hpp"
+#include "Engine/Contest/Solvers/OLCSprint.hpp"
+#include "Engine/Contest/Solvers/OLCFAI.hpp"
+#include "Engine/Contest/Solvers/OLCClassic.hpp"
+#include "Engine/Contest/Solvers/DMStQuad.hpp"
+#include "Engine/Contest/Solvers/XContestFree.hpp"
+#include "Engine/Contest/Solvers/XContestTriangle.hpp"
+#include "Engine/Contest/Solvers/OLCSISAT.hpp"
+#include "Engine/Contest/Solvers/NetCoupe.hpp"
+#include "Engine/Contest/Solvers/WeglideDistance.hpp"
+#include "Engine/Contest/Solvers/WeglideFAI.hpp"
+#include "Engine/Contest/Solvers/WeglideOR.hpp"
+#include "util/PrintException.hxx"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace std::chrono;
+
+/**
+ * The traces fed to the solvers, configured like the ones in
+ * #TraceComputer.
+ */
+struct Traces {
+  Trace full{minutes{2}, Trace::null_time, 1024};
+  Trace triangle{{}, Trace::null_time, 256};
+  Trace sprint{{}, minutes{150}, 128};
+
+  void push_back(const TracePoint &point) noexcept {
+    full.push_back(point);
+    triangle.push_back(point);
+    sprint.push_back(point);
+  }
+};
+
+/**
+ * Construct a solver.  In incremental mode, it is set up like
+ * #ContestComputer does, i.e. with a predicted triangle closure.
+ */
+typedef std::unique_ptr<AbstractContest> (*SolverFactory)(const Traces &traces,
+                                                          bool incremental);
+
+template<typename T, typename... A>
+static std::unique_ptr<AbstractContest>
+MakeSolver(bool incremental, A&&... args)
+{
+  auto solver = std::make_unique<T>(std::forward<A>(args)...);
+  solver->SetIncremental(incremental);
+  solver->Reset();
+  return solver;
+}
+
+static constexpr struct {
+  const char *name;
+  SolverFactory factory;
+
+  /**
+   * Does the solver only work in flight?  OLC Sprint always finishes
+   * at the last fix, so there is nothing to search after landing.
+   */
+  bool online_only = false;
+} solvers[] = {
+  { "olc_sprint", [](const Traces &t, bool i) {
+    return MakeSolver<OLCSprint>(i, t.sprint);
+  }, true },
+  { "olc_fai", [](const Traces &t, bool i) {
+    return MakeSolver<OLCFAI>(i, t.triangle, i);
+  } },
+  { "olc_classic", [](const Traces &t, bool i) {
+    return MakeSolver<OLCClassic>(i, t.full);
+  } },
+  { "dmst", [](const Traces &t, bool i) {
+    return MakeSolver<DMStQuad>(i, t.full);
+  } },
+  { "xcontest_free", [](const Traces &t, bool i) {
+    return MakeSolver<XContestFree>(i, t.full, false);
+  } },
+  { "xcontest_triangle", [](const Traces &t, bool i) {
+    return MakeSolver<XContestTriangle>(i, t.triangle, i, false);
+  } },
+  { "dhv_xc_free", [](const Traces &t, bool i) {
+    return MakeSolver<XContestFree>(i, t.full, true);
+  } },
+  { "dhv_xc_triangle", [](const Traces &t, bool i) {
+    return MakeSolver<XContestTriangle>(i, t.triangle, i, true);
+  } },
+  { "sis_at", [](const Traces &t, bool i) {
+    return MakeSolver<OLCSISAT>(i, t.full);
+  } },
+  { "netcoupe", [](const Traces &t, bool i) {
+    return MakeSolver<NetCoupe>(i, t.full);
+  } },
+  { "weglide_distance", [](const Traces &t, bool i) {
+    return MakeSolver<WeglideDistance>(i, t.full);
+  } },
+  { "weglide_fai", [](const Traces &t, bool i) {
+    return MakeSolver<WeglideFAI>(i, t.triangle, i);
+  } },
+  { "weglide_or", [](const Traces &t, bool i) {
+    return MakeSolver<WeglideOR>(i, t.full);
+  } },
+};
+
+/**
+ * Load the fixes of an IGC file, starting at the release (if one is
+ * detected), like RunContestAnalysis does.
+ */
+static std::vector<TracePoint>
+LoadFlight(Path path)
+{
+  std::unique_ptr<DebugReplay> replay(DebugReplayIGC::Create(path));
+  if (!replay)
+    return {};
+
+  std::vector<TracePoint> points;
+  bool released = false;
+
+  while (replay->Next()) {
+    const MoreData &basic = replay->Basic();
+    if (!basic.time_available || !basic.location_available ||
+        !basic.NavAltitudeAvailable())
+      continue;
+
+    const auto &release_time = replay->Calculated().flight.release_time;
+    if (!released && release_time.IsDefined()) {
+      released = true;
+
+      const auto release = release_time.Cast<TracePoint::Time>();
+      points.erase(std::remove_if(points.begin(), points.end(),
+                                  [release](const TracePoint &p){
+                                    return p.GetTime() < release;
+                                  }),
+                   points.end());
+    }
+
+    points.emplace_back(basic);
+  }
+
+  return points;
+}
+
+/**
+ * The ContestDijkstra time budget for incremental runs; zero for the
+ * default fixed number of steps.
+ */
+static steady_clock::duration time_budget{};
+
+static void
+Run(const char *flight, const char *name, SolverFactory factory,
+    const std::vector<TracePoint> &points, bool incremental)
+{
+  const std::size_t base = AllocationCounter::GetLiveBytes();
+  AllocationCounter::ResetPeak();
+
+  duration<double, std::milli> elapsed{}, max_call{};
+
+  {
+    Traces traces;
+    auto solver = factory(traces, incremental);
+
+    if (incremental) {
+      if (auto *dijkstra = dynamic_cast<ContestDijkstra *>(solver.get()))
+        dijkstra->SetTimeBudget(time_budget);
+
+      /* one solver step per fix, like ContestComputer */
+      for (const auto &point : points) {
+        traces.push_back(point);
+
+        const auto start = steady_clock::now();
+        solver->Solve(false);
+        const duration<double, std::milli> call = steady_clock::now() - start;
+        elapsed += call;
+        max_call = std::max(max_call, call);
+      }
+    } else {
+      for (const auto &point : points)
+        traces.push_back(point);
+
+      const auto start = steady_clock::now();
+      solver->Solve(true);
+      max_call = elapsed = steady_clock::now() - start;
+    }
+
+    const auto *dijkstra = dynamic_cast<const ContestDijkstra *>(solver.get());
+    const ContestResult &result = solver->GetBestResult();
+
+    printf("%s\t%s\t%s\t%zu\t%.3f\t%.3f\t%zu\t%u\t%.3f\t%.0f\n",
+           flight, name, incremental ? "incremental" : "exhaustive",
+           points.size(), elapsed.count(), max_call.count(),
+           AllocationCounter::GetPeakBytes() - base,
+           dijkstra != nullptr ? dijkstra->GetMaxQueueSize() : 0,
+           result.score, result.distance);
+  }
+}
+
+class FlightVisitor final : public File::Visitor {
+public:
+  void Visit(Path path, Path filename) override {
+    const auto points = LoadFlight(path);
+    if (points.empty())
+      return;
+
+    const std::string flight = filename.ToUTF8();
+    for (const auto &solver : solvers) {
+      Run(flight.c_str(), solver.name, solver.factory, points, true);
+      if (!solver.online_only)
+        Run(flight.c_str(), solver.name, solver.factory, points, false);
+    }
+
+    fflush(stdout);
+  }
+};
+
+int main(int argc, char **argv)
+try {
+  Args args(argc, argv, "DIRECTORY [BUDGET_MS]");
+  const auto directory = args.ExpectNextPath();
+  if (!args.IsEmpty())
+    time_budget = duration_cast<steady_clock::duration>
+      (duration<double, std::milli>(strtod(args.GetNext(), nullptr)));
+  args.ExpectEnd();
+
+  printf("# file\tsolver\tmode\tpoints\ttime_ms\tmax_call_ms\tpeak_bytes"
+         "\tmax_queue"
+         "\tscore\tdistance_m\n");
+
+  FlightVisitor visitor;
+  Directory::VisitSpecificFiles(directory, _T("*.igc"), visitor);
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
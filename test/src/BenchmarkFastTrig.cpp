@@ -0,0 +1,106 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Compare fastsine() (4096 floats) with std::sin() and with the
+ * lookup in a table of 4096 doubles which was used before.
+ */
+
+#include "Math/FastTrig.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <stdio.h>
+
+using Clock = std::chrono::steady_clock;
+
+static double
+NanosecondsPer(Clock::duration d, unsigned long n) noexcept
+{
+  return std::chrono::duration<double, std::nano>(d).count() / n;
+}
+
+static double nearest_table[INT_ANGLE_RANGE];
+
+static double
+NearestSine(double x) noexcept
+{
+  return nearest_table[NATIVE_TO_INT(x)];
+}
+
+template<typename F>
+static double
+MaxError(F &&f) noexcept
+{
+  double error = 0;
+  for (double x = -2 * M_PI; x < 2 * M_PI; x += 1e-5)
+    error = std::max(error, std::fabs(f(x) - std::sin(x)));
+  return error;
+}
+
+template<typename F>
+static double
+Benchmark(const char *name, const std::vector<double> &angles, F &&f,
+          double max_error, std::size_t table_size)
+{
+  constexpr unsigned n_rounds = 1000;
+
+  double sum = 0;
+  const auto start = Clock::now();
+  for (unsigned r = 0; r < n_rounds; ++r)
+    for (double x : angles)
+      sum += f(x);
+
+  printf("%s: %.2f ns, max error %.3g, table %u bytes\n", name,
+         NanosecondsPer(Clock::now() - start, angles.size() * n_rounds),
+         max_error, unsigned(table_size));
+  return sum;
+}
+
+int
+main(int argc, char **argv)
+{
+  for (unsigned i = 0; i < INT_ANGLE_RANGE; ++i)
+    nearest_table[i] = std::sin(IntAngleToRadians(i));
+
+  std::vector<double> angles;
+  std::minstd_rand rng;
+  std::uniform_real_distribution<double> distribution(-2 * M_PI, 2 * M_PI);
+  for (unsigned i = 0; i < 100000; ++i)
+    angles.push_back(distribution(rng));
+
+  double sum = 0;
+  sum += Benchmark("std::sin", angles, [](double x){ return std::sin(x); },
+                   0, 0);
+  sum += Benchmark("nearest (4096 doubles)", angles, NearestSine,
+                   MaxError(NearestSine), sizeof(nearest_table));
+  sum += Benchmark("fastsine", angles, fastsine,
+                   MaxError(fastsine), sizeof(FAST_SINE_TABLE));
+
+  /* prevent gcc from optimizing everything away */
+  return sum == 0.12345;
+}
@@ -0,0 +1,160 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Measure scheduling, canceling and invoking large numbers of
+ * #FineTimerEvent instances, like a busy xcsoar-cloud-server with
+ * per-client timeouts.
+ */
+
+#include "event/Loop.hxx"
+#include "event/FineTimerEvent.hxx"
+
+#include <chrono>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * All timers of the last phase are scheduled within this duration.
+ */
+static constexpr unsigned FIRE_SPREAD_MS = 100;
+
+/**
+ * The range of durations used for the schedule/cancel phases.
+ */
+static constexpr unsigned SCHEDULE_SPREAD_MS = 10 * 60 * 1000;
+
+using Clock = std::chrono::steady_clock;
+
+static double
+NanosecondsPer(Clock::duration d, unsigned n) noexcept
+{
+  return std::chrono::duration<double, std::nano>(d).count() / n;
+}
+
+class Benchmark {
+  EventLoop &loop;
+
+  struct Timer {
+    Benchmark &benchmark;
+    FineTimerEvent event;
+
+    Timer(EventLoop &_loop, Benchmark &_benchmark) noexcept
+      :benchmark(_benchmark), event(_loop, BIND_THIS_METHOD(OnTimer)) {}
+
+    void OnTimer() noexcept {
+      benchmark.OnTimer();
+    }
+  };
+
+  std::vector<std::unique_ptr<Timer>> timers;
+
+  FineTimerEvent start_event;
+
+  unsigned n_fired = 0;
+
+  Clock::time_point fire_start;
+
+public:
+  Benchmark(EventLoop &_loop, unsigned n) noexcept
+    :loop(_loop), start_event(loop, BIND_THIS_METHOD(OnStart))
+  {
+    timers.reserve(n);
+    for (unsigned i = 0; i < n; ++i)
+      timers.emplace_back(std::make_unique<Timer>(loop, *this));
+  }
+
+  void Run() noexcept {
+    start_event.Schedule(std::chrono::milliseconds(0));
+    loop.Run();
+  }
+
+private:
+  template<typename F>
+  Clock::duration Measure(F &&f) noexcept {
+    const auto start = Clock::now();
+    for (auto &t : timers)
+      f(t->event);
+    return Clock::now() - start;
+  }
+
+  void OnStart() noexcept {
+    const unsigned n = timers.size();
+    /* fixed seed, so all runs schedule the same timers */
+    std::minstd_rand rng{42};
+
+    const auto schedule = Measure([&](FineTimerEvent &e){
+      e.Schedule(std::chrono::milliseconds(rng() % SCHEDULE_SPREAD_MS));
+    });
+
+    const auto reschedule = Measure([&](FineTimerEvent &e){
+      e.Schedule(std::chrono::milliseconds(rng() % SCHEDULE_SPREAD_MS));
+    });
+
+    const auto cancel = Measure([](FineTimerEvent &e){
+      e.Cancel();
+    });
+
+    printf("%7u timers: schedule %6.1f ns, reschedule %6.1f ns, cancel %6.1f ns",
+           n,
+           NanosecondsPer(schedule, n),
+           NanosecondsPer(reschedule, n),
+           NanosecondsPer(cancel, n));
+    fflush(stdout);
+
+    /* now let all of them expire */
+    Measure([&](FineTimerEvent &e){
+      e.Schedule(std::chrono::milliseconds(1 + rng() % FIRE_SPREAD_MS));
+    });
+
+    /* the due times are relative to the cached loop time */
+    fire_start = loop.SteadyNow();
+  }
+
+  void OnTimer() noexcept {
+    if (++n_fired < timers.size())
+      return;
+
+    const auto elapsed = Clock::now() - fire_start;
+    printf(", fired all after %.1f ms (%u ms spread)\n",
+           std::chrono::duration<double, std::milli>(elapsed).count(),
+           FIRE_SPREAD_MS);
+
+    loop.Break();
+  }
+};
+
+int main(int argc, char **argv)
+{
+  for (unsigned n : {1000, 10000, 100000}) {
+    EventLoop loop;
+    Benchmark benchmark(loop, n);
+    benchmark.Run();
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,358 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Replay an IGC file through a complete #GlideComputer with terrain,
+ * airspace, waypoints and an AAT task, and measure the cost of each
+ * fix: the wall time of ProcessGPS() plus ProcessIdle(), the time of
+ * each sub-computer (as measured by #ComputerScheduler) and the
+ * number of heap allocations.  Prints the mean, the 99th percentile
+ * and the maximum of each, so the output of two builds can be
+ * compared with diff.
+ *
+ * The waypoints and the task are generated around the first fix,
+ * therefore the same input files always produce the same workload.
+ * The reference data set is in test/data:
+ *
+ *   BenchmarkGlideComputer 9crx3101.igc benalla9.xcm AirspaceAus-DAA.txt
+ */
+
+#include "system/Args.hpp"
+#include "DebugReplayIGC.hpp"
+#include "AllocationCounter.hpp"
+#include "Terrain/RasterTerrain.hpp"
+#include "Airspace/AirspaceParser.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "Engine/Waypoint/Waypoints.hpp"
+#include "Engine/Task/TaskManager.hpp"
+#include "Engine/Task/Ordered/OrderedTask.hpp"
+#include "Engine/Task/Ordered/Points/StartPoint.hpp"
+#include "Engine/Task/Ordered/Points/IntermediatePoint.hpp"
+#include "Engine/Task/Ordered/Points/FinishPoint.hpp"
+#include "Engine/Task/ObservationZones/CylinderZone.hpp"
+#include "Engine/Task/Factory/AbstractTaskFactory.hpp"
+#include "Computer/GlideComputer.hpp"
+#include "Computer/GlideComputerInterface.hpp"
+#include "Computer/Settings.hpp"
+#include "Task/ProtectedTaskManager.hpp"
+#include "Geo/Math.hpp"
+#include "io/FileLineReader.hpp"
+#include "Operation/ConsoleOperationEnvironment.hpp"
+#include "util/PrintException.hxx"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* fake symbols: */
+
+#include "Computer/ConditionMonitor/ConditionMonitors.hpp"
+#include "Input/InputQueue.hpp"
+#include "Logger/Logger.hpp"
+
+void
+ConditionMonitorsUpdate(const NMEAInfo &basic, const DerivedInfo &calculated,
+                        const ComputerSettings &settings)
+{
+}
+
+bool InputEvents::processGlideComputer(unsigned) { return false; }
+
+void Logger::LogStartEvent(const NMEAInfo &gps_info) {}
+void Logger::LogFinishEvent(const NMEAInfo &gps_info) {}
+void Logger::LogPoint(const NMEAInfo &gps_info) {}
+
+/* done with fake symbols. */
+
+using namespace std::chrono;
+
+/**
+ * The number of generated waypoints, every fourth of them landable.
+ */
+static constexpr unsigned N_WAYPOINTS = 400;
+
+/**
+ * The generated waypoints are spread over a disc with this radius
+ * [m] around the first fix.
+ */
+static constexpr double WAYPOINT_RADIUS = 150000;
+
+/**
+ * Load terrain tiles around the aircraft every this number of fixes,
+ * like the #TerrainThread does in the background.  This is not
+ * included in the measurement.
+ */
+static constexpr unsigned TERRAIN_UPDATE_INTERVAL = 30;
+
+static const char *const job_names[] = {
+  "air_data",
+  "vertical",
+  "task",
+  "route",
+  "log",
+  "task_idle",
+  "contest",
+  "warning",
+};
+
+static_assert(std::size(job_names) == ComputerScheduler::N_JOBS);
+
+/**
+ * Generate waypoints on a sunflower pattern, which covers the disc
+ * evenly without the regularity of a grid.
+ */
+static void
+GenerateWaypoints(Waypoints &waypoints, const GeoPoint &center,
+                  const RasterTerrain *terrain)
+{
+  const Angle golden_angle = Angle::Degrees(137.50776);
+
+  for (unsigned i = 0; i < N_WAYPOINTS; ++i) {
+    const double distance = WAYPOINT_RADIUS * sqrt((i + 0.5) / N_WAYPOINTS);
+    Waypoint wp = waypoints.Create(FindLatitudeLongitude(center,
+                                                         golden_angle * i,
+                                                         distance));
+    wp.name = _T("WP");
+    wp.flags.turn_point = true;
+    if (i % 4 == 0)
+      wp.type = Waypoint::Type::AIRFIELD;
+
+    wp.elevation = terrain != nullptr
+      ? terrain->GetTerrainHeight(wp.location).GetValueOr0()
+      : 0;
+
+    waypoints.Append(std::move(wp));
+  }
+
+  waypoints.Optimise();
+}
+
+static void
+SetRadius(OrderedTaskPoint &tp, double radius)
+{
+  auto &oz = tp.GetObservationZone();
+  if (oz.GetShape() == ObservationZone::Shape::CYLINDER)
+    ((CylinderZone &)oz).SetRadius(radius);
+}
+
+/**
+ * Build an AAT task: start and finish at the waypoint nearest to the
+ * first fix, and three large areas around it.
+ */
+static std::unique_ptr<OrderedTask>
+CreateAATTask(const Waypoints &waypoints, const GeoPoint &center,
+              const TaskBehaviour &task_behaviour)
+{
+  auto task = std::make_unique<OrderedTask>(task_behaviour);
+  task->SetFactory(TaskFactoryType::AAT);
+  AbstractTaskFactory &factory = task->GetFactory();
+
+  const auto home = waypoints.GetNearest(center, 20000);
+  if (!home)
+    return nullptr;
+
+  factory.Append(*factory.CreateStart(TaskPointFactoryType::START_LINE,
+                                      WaypointPtr(home)), false);
+
+  for (const double bearing : {0., 120., 240.}) {
+    const auto wp = waypoints.GetNearest(FindLatitudeLongitude(center,
+                                                               Angle::Degrees(bearing),
+                                                               60000),
+                                         20000);
+    if (!wp)
+      return nullptr;
+
+    auto tp = factory.CreateIntermediate(TaskPointFactoryType::AAT_CYLINDER,
+                                         WaypointPtr(wp));
+    SetRadius(*tp, 20000);
+    factory.Append(*tp, false);
+  }
+
+  factory.Append(*factory.CreateFinish(TaskPointFactoryType::FINISH_LINE,
+                                       WaypointPtr(home)), false);
+
+  task->UpdateGeometry();
+  if (IsError(task->CheckTask()))
+    return nullptr;
+
+  return task;
+}
+
+/**
+ * Collects one value per fix.
+ */
+class Samples {
+  std::vector<double> values;
+
+public:
+  void push_back(double value) noexcept {
+    values.push_back(value);
+  }
+
+  void Print(const char *name, const char *unit) noexcept {
+    if (values.empty())
+      return;
+
+    double sum = 0;
+    for (double v : values)
+      sum += v;
+
+    std::sort(values.begin(), values.end());
+    const double p99 = values[(values.size() - 1) * 99 / 100];
+
+    printf("%-12s %8zu %10.2f %10.2f %10.2f %s\n",
+           name, values.size(), sum / values.size(), p99, values.back(),
+           unit);
+  }
+};
+
+static void
+Run(DebugReplay &replay, GlideComputer &glide_computer,
+    RasterTerrain *terrain)
+{
+  Samples cycle, allocations;
+  std::array<Samples, ComputerScheduler::N_JOBS> jobs;
+
+  auto last_timings = glide_computer.GetTimings();
+
+  unsigned n = 0;
+  while (replay.Next()) {
+    const MoreData &basic = replay.Basic();
+
+    if (terrain != nullptr && basic.location_available &&
+        n++ % TERRAIN_UPDATE_INTERVAL == 0)
+      while (terrain->UpdateTiles(basic.location, 50000)) {}
+
+    glide_computer.ReadBlackboard(basic);
+
+    const std::size_t allocations_before = AllocationCounter::GetAllocations();
+    const auto start = steady_clock::now();
+
+    glide_computer.ProcessGPS();
+    glide_computer.ProcessIdle();
+
+    const duration<double, std::micro> elapsed = steady_clock::now() - start;
+    cycle.push_back(elapsed.count());
+    allocations.push_back(AllocationCounter::GetAllocations()
+                          - allocations_before);
+
+    /* a job's "last" timing is new if its run counter was bumped */
+    const auto timings = glide_computer.GetTimings();
+    for (unsigned i = 0; i < timings.size(); ++i)
+      if (timings[i].runs != last_timings[i].runs)
+        jobs[i].push_back(timings[i].last.count());
+    last_timings = timings;
+  }
+
+  printf("%-12s %8s %10s %10s %10s\n", "", "fixes", "mean", "p99", "max");
+  cycle.Print("cycle", "us");
+  for (unsigned i = 0; i < jobs.size(); ++i)
+    jobs[i].Print(job_names[i], "us");
+  allocations.Print("allocations", "");
+}
+
+int
+main(int argc, char **argv)
+try {
+  Args args(argc, argv, "FILE.igc TERRAIN.xcm AIRSPACE.txt");
+  const auto igc_path = args.ExpectNextPath();
+  const auto terrain_path = args.ExpectNextPath();
+  const auto airspace_path = args.ExpectNextPath();
+  args.ExpectEnd();
+
+  ConsoleOperationEnvironment operation;
+
+  const auto terrain = RasterTerrain::OpenTerrain(nullptr, terrain_path,
+                                                  operation);
+
+  Airspaces airspaces;
+  {
+    FileLineReader reader(airspace_path, Charset::AUTO);
+    if (!ParseAirspaceFile(airspaces, reader, operation)) {
+      fprintf(stderr, "Failed to parse airspace file\n");
+      return EXIT_FAILURE;
+    }
+  }
+
+  airspaces.Optimise();
+
+  /* the first fix is the center of the generated waypoints and of
+     the task; the replay is started again from the beginning below */
+  std::unique_ptr<DebugReplay> replay(DebugReplayIGC::Create(igc_path));
+  if (!replay)
+    return EXIT_FAILURE;
+
+  GeoPoint center = GeoPoint::Invalid();
+  while (replay->Next())
+    if (replay->Basic().location_available) {
+      center = replay->Basic().location;
+      break;
+    }
+
+  if (!center.IsValid()) {
+    fprintf(stderr, "No GPS fix\n");
+    return EXIT_FAILURE;
+  }
+
+  replay.reset(DebugReplayIGC::Create(igc_path));
+
+  Waypoints waypoints;
+  GenerateWaypoints(waypoints, center, terrain.get());
+
+  ComputerSettings settings;
+  settings.SetDefaults();
+  settings.polar.glide_polar_task = GlidePolar(1);
+  settings.contest.enable = true;
+
+  TaskManager task_manager(settings.task, waypoints);
+  task_manager.SetGlidePolar(settings.polar.glide_polar_task);
+
+  GlideComputerTaskEvents task_events;
+  task_manager.SetTaskEvents(task_events);
+
+  ProtectedTaskManager protected_task_manager(task_manager, settings.task);
+
+  const auto task = CreateAATTask(waypoints, center, settings.task);
+  if (!task) {
+    fprintf(stderr, "Failed to create the task\n");
+    return EXIT_FAILURE;
+  }
+
+  protected_task_manager.TaskCommit(*task);
+
+  GlideComputer glide_computer(settings, waypoints, airspaces,
+                               protected_task_manager, task_events);
+  glide_computer.SetTerrain(terrain.get());
+  glide_computer.Initialise();
+
+  Run(*replay, glide_computer, terrain.get());
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,197 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Measure how many telemetry records per second can be exported as
+ * JSON: with the streaming writer, and for comparison by building a
+ * Boost.JSON document for each record and serialising it.
+ */
+
+#include "TelemetryJSON.hpp"
+#include "NMEA/MoreData.hpp"
+#include "NMEA/Derived.hpp"
+#include "Formatter/TimeFormatter.hpp"
+#include "io/OutputStream.hxx"
+#include "io/BufferedOutputStream.hxx"
+
+#include <boost/json.hpp>
+
+#include <chrono>
+
+#include <stdio.h>
+
+static constexpr unsigned N_RECORDS = 200000;
+static constexpr unsigned ITERATIONS = 5;
+
+/**
+ * An #OutputStream which discards all data, counting the bytes.
+ */
+class NullOutputStream final : public OutputStream {
+public:
+  std::size_t size = 0;
+
+  void Write(const void *, std::size_t _size) override {
+    size += _size;
+  }
+};
+
+static boost::json::object
+MakeGeoPoint(const GeoPoint &location)
+{
+  return {
+    {"longitude", location.longitude.Degrees()},
+    {"latitude", location.latitude.Degrees()},
+  };
+}
+
+/**
+ * The Boost.JSON equivalent of WriteTelemetryJSON().
+ */
+static boost::json::object
+MakeTelemetryDOM(const MoreData &basic, const DerivedInfo &calculated)
+{
+  boost::json::object object;
+
+  object.emplace("time", basic.time.ToDuration().count());
+
+  char buffer[32];
+  FormatISO8601(buffer, basic.date_time_utc);
+  object.emplace("date_time", buffer);
+
+  object.emplace("location", MakeGeoPoint(basic.location));
+  object.emplace("gps_altitude", basic.gps_altitude);
+  object.emplace("baro_altitude", basic.baro_altitude);
+  object.emplace("track", basic.track.Degrees());
+  object.emplace("ground_speed", basic.ground_speed);
+  object.emplace("indicated_airspeed", basic.indicated_airspeed);
+  object.emplace("true_airspeed", basic.true_airspeed);
+  object.emplace("vario", basic.brutto_vario);
+  object.emplace("netto_vario", basic.netto_vario);
+  object.emplace("altitude_agl", calculated.altitude_agl);
+  object.emplace("wind", boost::json::object{
+      {"bearing", calculated.wind.bearing.Degrees()},
+      {"speed", calculated.wind.norm},
+    });
+  object.emplace("flying", calculated.flight.flying);
+  object.emplace("circling", calculated.circling);
+  return object;
+}
+
+/**
+ * Advance the simulated flight by one second.
+ */
+static void
+Step(MoreData &basic, DerivedInfo &calculated, unsigned i) noexcept
+{
+  const TimeStamp time{FloatDuration(36000. + i)};
+
+  basic.time = time;
+  basic.time_available.Update(time);
+  basic.date_time_utc = BrokenDateTime(2021, 7, 1, 10 + i / 3600 % 14,
+                                       i / 60 % 60, i % 60);
+
+  basic.location = GeoPoint(Angle::Degrees(7.5 + i * 1e-4),
+                            Angle::Degrees(51.2 + i * 0.7e-4));
+  basic.location_available.Update(time);
+
+  basic.gps_altitude = 1200 + (i % 300) * 1.37;
+  basic.gps_altitude_available.Update(time);
+  basic.baro_altitude = basic.gps_altitude - 13.25;
+  basic.baro_altitude_available.Update(time);
+
+  basic.track = Angle::Degrees((i * 7) % 360);
+  basic.track_available.Update(time);
+  basic.ground_speed = 25 + (i % 17) * 0.31;
+  basic.ground_speed_available.Update(time);
+
+  basic.indicated_airspeed = 27.8 + (i % 11) * 0.1;
+  basic.true_airspeed = basic.indicated_airspeed * 1.06;
+  basic.airspeed_available.Update(time);
+
+  basic.brutto_vario = (int(i % 41) - 20) * 0.13;
+  basic.brutto_vario_available.Update(time);
+  basic.netto_vario = basic.brutto_vario + 0.7;
+  basic.netto_vario_available.Update(time);
+
+  calculated.altitude_agl = basic.gps_altitude - 312;
+  calculated.altitude_agl_valid = true;
+
+  calculated.wind = SpeedVector(Angle::Degrees(270 + i % 20), 4.2);
+  calculated.wind_available.Update(time);
+
+  calculated.flight.flying = true;
+  calculated.circling = (i / 30) % 2 == 0;
+}
+
+template<typename F>
+static void
+Measure(const char *name, F &&f)
+{
+  static MoreData basic;
+  static DerivedInfo calculated;
+  basic.Reset();
+  calculated.Reset();
+
+  double best = 0;
+  std::size_t size = 0;
+
+  for (unsigned i = 0; i < ITERATIONS; ++i) {
+    NullOutputStream nos;
+    BufferedOutputStream bos(nos);
+
+    const auto start = std::chrono::steady_clock::now();
+    for (unsigned j = 0; j < N_RECORDS; ++j) {
+      Step(basic, calculated, j);
+      f(bos, basic, calculated);
+      bos.Write('\n');
+    }
+    bos.Flush();
+    const std::chrono::duration<double> duration =
+      std::chrono::steady_clock::now() - start;
+
+    if (i == 0 || duration.count() < best)
+      best = duration.count();
+    size = nos.size;
+  }
+
+  printf("%-8s %10.0f records/s  %8.1f MB/s  %5.1f bytes/record\n",
+         name, N_RECORDS / best, size / best / 1e6,
+         double(size) / N_RECORDS);
+}
+
+int main(int argc, char **argv)
+{
+  Measure("stream", [](BufferedOutputStream &os, const MoreData &basic,
+                       const DerivedInfo &calculated){
+    WriteTelemetryJSON(os, basic, calculated);
+  });
+
+  Measure("dom", [](BufferedOutputStream &os, const MoreData &basic,
+                    const DerivedInfo &calculated){
+    const boost::json::value value = MakeTelemetryDOM(basic, calculated);
+    const auto s = boost::json::serialize(value);
+    os.Write(s.data(), s.size());
+  });
+
+  return 0;
+}
@@ -0,0 +1,73 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Measure LabelBlock with 5000 labels of typical sizes, randomly
+ * scattered over a full HD screen.
+ */
+
+#include "Renderer/LabelBlock.hpp"
+
+#include <chrono>
+#include <random>
+
+#include <stdio.h>
+
+static constexpr PixelSize screen_size{1920, 1080};
+static constexpr unsigned N_LABELS = 5000;
+static constexpr unsigned FRAMES = 200;
+
+int main(int argc, char **argv)
+{
+  static PixelRect labels[N_LABELS];
+
+  /* fixed seed, so all runs place the same labels */
+  std::minstd_rand rng{42};
+  for (auto &rc : labels) {
+    const unsigned width = 40 + rng() % 160;
+    const unsigned height = 14 + rng() % 12;
+    const int x = rng() % (screen_size.width - width);
+    const int y = rng() % (screen_size.height - height);
+    rc = PixelRect(PixelPoint(x, y), PixelSize(width, height));
+  }
+
+  LabelBlock label_block;
+  unsigned placed = 0;
+
+  const auto start = std::chrono::steady_clock::now();
+  for (unsigned frame = 0; frame < FRAMES; ++frame) {
+    label_block.reset();
+
+    placed = 0;
+    for (const auto &rc : labels)
+      if (label_block.check(rc))
+        ++placed;
+  }
+  const std::chrono::duration<double, std::milli> duration =
+    std::chrono::steady_clock::now() - start;
+
+  printf("%u of %u labels placed, %.3f ms per frame\n",
+         placed, N_LABELS, duration.count() / FRAMES);
+
+  return 0;
+}
@@ -0,0 +1,141 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Measure the throughput of the line reader on a (large) waypoint or
+ * airspace file: splitting lines only, splitting and charset
+ * conversion, and the full parser.  Waypoint files are recognised by
+ * their file name extension; everything else is parsed as an airspace
+ * file.
+ */
+
+#include "Waypoint/WaypointReader.hpp"
+#include "Waypoint/WaypointFileType.hpp"
+#include "Waypoint/Factory.hpp"
+#include "Waypoint/Waypoints.hpp"
+#include "Airspace/AirspaceParser.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "Operation/Operation.hpp"
+#include "system/Args.hpp"
+#include "io/FileLineReader.hpp"
+#include "util/PrintException.hxx"
+
+#include <chrono>
+#include <stdexcept>
+
+#include <stdio.h>
+
+static constexpr unsigned ITERATIONS = 5;
+
+struct Result {
+  /**
+   * The number of lines or parsed objects.
+   */
+  unsigned items = 0;
+
+  std::size_t bytes = 0;
+};
+
+template<typename F>
+static void
+Measure(const char *name, F &&f)
+{
+  double best = 0;
+  Result result;
+
+  for (unsigned i = 0; i < ITERATIONS; ++i) {
+    const auto start = std::chrono::steady_clock::now();
+    result = f();
+    const std::chrono::duration<double, std::milli> duration =
+      std::chrono::steady_clock::now() - start;
+    if (i == 0 || duration.count() < best)
+      best = duration.count();
+  }
+
+  printf("%-8s %8.2f ms  %8.1f MB/s  %u items\n",
+         name, best, result.bytes / (best * 1000.), result.items);
+}
+
+template<typename R>
+static Result
+ReadAllLines(R &reader)
+{
+  Result result;
+  result.bytes = reader.GetSize();
+
+  while (reader.ReadLine() != nullptr)
+    ++result.items;
+
+  return result;
+}
+
+int main(int argc, char **argv)
+try {
+  Args args(argc, argv, "PATH");
+  const auto path = args.ExpectNextPath();
+  args.ExpectEnd();
+
+  Measure("split", [&]{
+    FileLineReaderA reader(path);
+    return ReadAllLines(reader);
+  });
+
+  Measure("convert", [&]{
+    FileLineReader reader(path, Charset::AUTO);
+    return ReadAllLines(reader);
+  });
+
+  const auto file_type = DetermineWaypointFileType(path);
+
+  Measure("parse", [&]{
+    NullOperationEnvironment operation;
+    FileLineReader reader(path, Charset::AUTO);
+
+    Result result;
+    result.bytes = reader.GetSize();
+
+    if (file_type != WaypointFileType::UNKNOWN) {
+      Waypoints way_points;
+      if (!ReadWaypointFile(path, file_type, way_points,
+                            WaypointFactory(WaypointOrigin::NONE),
+                            operation))
+        throw std::runtime_error("Failed to parse waypoint file");
+
+      result.items = way_points.size();
+    } else {
+      Airspaces airspaces;
+      if (!ParseAirspaceFile(airspaces, reader, operation))
+        throw std::runtime_error("Failed to parse airspace file");
+
+      airspaces.Optimise();
+      result.items = airspaces.GetSize();
+    }
+
+    return result;
+  });
+
+  return EXIT_SUCCESS;
+} catch (const std::runtime_error &e) {
+  PrintException(e);
+  return EXIT_FAILURE;
+}
@@ -23,6 +23,14 @@ Copyright_License {
 
 #include "Projection/Projection.hpp"
 #include "Screen/Layout.hpp"
+#include "Geo/Math.hpp"
+#include "Geo/FastDistance.hpp"
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include <stdio.h>
 
 unsigned Layout::scale_1024 = 1024;
 
@@ -36,14 +44,25 @@ public:
   }
 };
 
-int main(int argc, char **argv)
+using Clock = std::chrono::steady_clock;
+
+static double
+NanosecondsPer(Clock::duration d, unsigned long n) noexcept
+{
+  return std::chrono::duration<double, std::nano>(d).count() / n;
+}
+
+static long
+BenchmarkGeoToScreen()
 {
   TestProjection projection;
 
   GeoPoint gp = GeoPoint(Angle::Degrees(7.7061111111111114),
                          Angle::Degrees(51.051944444444445));
   long x = 0, y = 0;
-  for (unsigned i = 64 * 1024 * 1024; i-- > 0;) {
+  const auto start = Clock::now();
+  constexpr unsigned n = 64 * 1024 * 1024;
+  for (unsigned i = n; i-- > 0;) {
     auto rp = projection.GeoToScreen(gp);
 
     /* prevent gcc from optimizing this loop away */
@@ -51,5 +70,119 @@ int main(int argc, char **argv)
     y += rp.y;
   }
 
+  printf("GeoToScreen: %.1f ns\n", NanosecondsPer(Clock::now() - start, n));
+
   return x + y;
 }
+
+/**
+ * Compare the scalar GeoToScreen() loop with the batch version, with
+ * a 1000 point polyline around the screen center.
+ */
+static long
+BenchmarkGeoToScreenBatch()
+{
+  TestProjection projection;
+  projection.SetScreenAngle(Angle::Degrees(37));
+
+  constexpr unsigned n_points = 1000, n_rounds = 20000;
+
+  std::vector<GeoPoint> points;
+  points.reserve(n_points);
+  for (unsigned i = 0; i < n_points; ++i)
+    points.emplace_back(Angle::Degrees(7.7 + (i % 37) * 0.001),
+                        Angle::Degrees(51.05 + (i % 41) * 0.001));
+
+  std::vector<PixelPoint> screen(n_points);
+  long sum = 0;
+
+  auto start = Clock::now();
+  for (unsigned r = 0; r < n_rounds; ++r) {
+    for (unsigned i = 0; i < n_points; ++i)
+      screen[i] = projection.GeoToScreen(points[i]);
+    sum += screen.back().x;
+  }
+  printf("GeoToScreen (loop): %.1f ns\n",
+         NanosecondsPer(Clock::now() - start, n_points * n_rounds));
+
+  start = Clock::now();
+  for (unsigned r = 0; r < n_rounds; ++r) {
+    projection.GeoToScreen(points, screen);
+    sum += screen.back().x;
+  }
+  printf("GeoToScreen (batch): %.1f ns\n",
+         NanosecondsPer(Clock::now() - start, n_points * n_rounds));
+
+  return sum;
+}
+
+/**
+ * Compare the scalar geodesic functions with the batch versions,
+ * with 10000 points scattered around the origin.
+ *
+ * @param range the maximum latitude/longitude offset [m]
+ */
+static double
+BenchmarkDistanceBearing(const char *name, double range)
+{
+  const GeoPoint origin(Angle::Degrees(7.7061111111111114),
+                        Angle::Degrees(51.051944444444445));
+
+  constexpr unsigned n_points = 10000, n_rounds = 20;
+
+  std::vector<GeoPoint> points;
+  points.reserve(n_points);
+  std::minstd_rand rng;
+  std::uniform_real_distribution<double> distribution(-range, range);
+  for (unsigned i = 0; i < n_points; ++i) {
+    const double dx = distribution(rng);
+    const double dy = distribution(rng);
+    points.emplace_back(origin.longitude + Angle::Degrees(dx / 70000),
+                        origin.latitude + Angle::Degrees(dy / 111000));
+  }
+
+  std::vector<double> distances(n_points);
+  std::vector<Angle> bearings(n_points);
+  double sum = 0;
+
+  auto start = Clock::now();
+  for (unsigned r = 0; r < n_rounds; ++r)
+    for (unsigned i = 0; i < n_points; ++i)
+      DistanceBearing(origin, points[i], &distances[i], &bearings[i]);
+  printf("%s DistanceBearing: %.1f ns\n", name,
+         NanosecondsPer(Clock::now() - start, n_points * n_rounds));
+  sum += distances.back();
+
+  start = Clock::now();
+  for (unsigned r = 0; r < n_rounds; ++r)
+    DistanceBearing(origin, points, distances, bearings);
+  printf("%s DistanceBearing (batch): %.1f ns\n", name,
+         NanosecondsPer(Clock::now() - start, n_points * n_rounds));
+  sum += distances.back();
+
+  start = Clock::now();
+  for (unsigned r = 0; r < n_rounds; ++r)
+    FastDistanceBearing(origin, points, distances, bearings);
+  printf("%s FastDistanceBearing: %.1f ns\n", name,
+         NanosecondsPer(Clock::now() - start, n_points * n_rounds));
+  sum += distances.back();
+
+  start = Clock::now();
+  for (unsigned r = 0; r < n_rounds; ++r)
+    FastDistanceBearing(origin, points, distances);
+  printf("%s FastDistanceBearing (distance only): %.1f ns\n", name,
+         NanosecondsPer(Clock::now() - start, n_points * n_rounds));
+  sum += distances.back();
+
+  return sum;
+}
+
+int main(int argc, char **argv)
+{
+  const long result = BenchmarkGeoToScreen() + BenchmarkGeoToScreenBatch();
+  const double sum = BenchmarkDistanceBearing("40 km:", 40000) +
+    BenchmarkDistanceBearing("300 km:", 300000);
+
+  /* prevent gcc from optimizing everything away */
+  return (result + long(sum)) & 1;
+}
@@ -0,0 +1,135 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Pass bytes from a producer thread to a consumer thread, like a
+ * port's receive thread and the device thread, once through a
+ * #StaticFifoBuffer protected by a mutex (the old #BufferedPort) and
+ * once through a #LockFreeRingBuffer.  The producer's worst-case
+ * time per chunk shows how long the receive thread can be blocked.
+ */
+
+#include "util/LockFreeRingBuffer.hpp"
+#include "util/StaticFifoBuffer.hxx"
+#include "thread/Mutex.hxx"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+#include <stdio.h>
+
+using Clock = std::chrono::steady_clock;
+
+static constexpr std::size_t CHUNK_SIZE = 64, READ_SIZE = 256;
+static constexpr std::size_t TOTAL = 64 * 1024 * 1024;
+
+class MutexFifo {
+  Mutex mutex;
+  StaticFifoBuffer<uint8_t, 16384> buffer;
+
+public:
+  std::size_t Push(const uint8_t *src, std::size_t n) noexcept {
+    const std::lock_guard<Mutex> lock(mutex);
+    buffer.Shift();
+    auto w = buffer.Write();
+    n = std::min(n, w.size);
+    std::copy_n(src, n, w.data);
+    buffer.Append(n);
+    return n;
+  }
+
+  std::size_t Shift(uint8_t *dest, std::size_t n) noexcept {
+    const std::lock_guard<Mutex> lock(mutex);
+    auto r = buffer.Read();
+    n = std::min(n, r.size);
+    std::copy_n(r.data, n, dest);
+    buffer.Consume(n);
+    return n;
+  }
+};
+
+class LockFreeFifo {
+  LockFreeRingBuffer<uint8_t, 16384> buffer;
+
+public:
+  std::size_t Push(const uint8_t *src, std::size_t n) noexcept {
+    return buffer.push(src, n);
+  }
+
+  std::size_t Shift(uint8_t *dest, std::size_t n) noexcept {
+    return buffer.shift(dest, n);
+  }
+};
+
+template<typename F>
+static void
+Run(const char *name)
+{
+  F fifo;
+  Clock::duration max_push{};
+
+  const auto start = Clock::now();
+
+  std::thread producer([&fifo, &max_push]{
+    uint8_t chunk[CHUNK_SIZE];
+    for (std::size_t total = 0; total < TOTAL;) {
+      memset(chunk, uint8_t(total), sizeof(chunk));
+
+      const auto t = Clock::now();
+      const std::size_t n = fifo.Push(chunk, sizeof(chunk));
+      max_push = std::max(max_push, Clock::now() - t);
+
+      total += n;
+      if (n == 0)
+        /* full; let the consumer run (this matters on one CPU) */
+        std::this_thread::yield();
+    }
+  });
+
+  uint8_t buffer[READ_SIZE];
+  for (std::size_t total = 0; total < TOTAL;) {
+    const std::size_t n = fifo.Shift(buffer, sizeof(buffer));
+    total += n;
+    if (n == 0)
+      std::this_thread::yield();
+  }
+
+  producer.join();
+
+  const std::chrono::duration<double> elapsed = Clock::now() - start;
+  printf("%-10s %8.1f MB/s  max push %8.1f us\n", name,
+         TOTAL / elapsed.count() / (1024 * 1024),
+         std::chrono::duration<double, std::micro>(max_push).count());
+}
+
+int
+main(int argc, char **argv)
+{
+  Run<MutexFifo>("mutex");
+  Run<LockFreeFifo>("lock-free");
+  return 0;
+}
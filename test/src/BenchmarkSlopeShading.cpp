@@ -0,0 +1,158 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Measure the slope shading kernel on a real terrain file at several
+ * screen resolutions, comparing the optimised implementation with
+ * the generic one.
+ */
+
+#include "Terrain/RasterMap.hpp"
+#include "Terrain/HeightMatrix.hpp"
+#include "Terrain/SlopeShading.hpp"
+#include "Terrain/Loader.hpp"
+#include "Operation/ConsoleOperationEnvironment.hpp"
+#include "Projection/WindowProjection.hpp"
+#include "Screen/Layout.hpp"
+#include "system/Args.hpp"
+#include "io/ZipArchive.hpp"
+#include "util/PrintException.hxx"
+
+#include <chrono>
+#include <memory>
+
+#include <stdio.h>
+#include <string.h>
+
+unsigned Layout::scale_1024 = 1024;
+
+using SlopeShadingRowFunction = decltype(&CalculateSlopeShadingRow);
+
+static constexpr unsigned QUANTISATION = 1;
+
+/**
+ * Shade all rows of the matrix, similar to
+ * RasterRenderer::GenerateSlopeImage().
+ */
+static void
+ShadeMatrix(SlopeShadingRowFunction f, const HeightMatrix &matrix,
+            int8_t *dest, const SlopeShadingParameters &p)
+{
+  const unsigned width = matrix.GetWidth();
+  const unsigned n = width - 2 * QUANTISATION;
+  const auto *src = matrix.GetData() + width;
+
+  for (unsigned y = 1; y + 1 < matrix.GetHeight(); ++y, src += width) {
+    const auto *inner = src + QUANTISATION;
+    dest += width;
+    f(dest + QUANTISATION, inner - width, inner + width,
+      inner - QUANTISATION, inner + QUANTISATION,
+      n, 2 * QUANTISATION, 2, p);
+  }
+}
+
+static double
+Measure(SlopeShadingRowFunction f, const HeightMatrix &matrix,
+        int8_t *dest, const SlopeShadingParameters &p, unsigned iterations)
+{
+  const auto start = std::chrono::steady_clock::now();
+  for (unsigned i = 0; i < iterations; ++i)
+    ShadeMatrix(f, matrix, dest, p);
+  const std::chrono::duration<double, std::milli> duration =
+    std::chrono::steady_clock::now() - start;
+  return duration.count() / iterations;
+}
+
+int main(int argc, char **argv)
+try {
+  Args args(argc, argv, "PATH");
+  const auto map_path = args.ExpectNextPath();
+  args.ExpectEnd();
+
+  ZipArchive archive(map_path);
+
+  RasterMap map;
+
+  {
+    ConsoleOperationEnvironment operation;
+    LoadTerrainOverview(archive, map.GetTileCache(), operation);
+  }
+
+  map.UpdateProjection();
+
+  SharedMutex mutex;
+  do {
+    UpdateTerrainTiles(archive, map.GetTileCache(), mutex,
+                       map.GetProjection(),
+                       map.GetMapCenter(), 50000);
+  } while (map.IsDirty());
+
+  static constexpr PixelSize resolutions[] = {
+    { 320, 240 },
+    { 640, 480 },
+    { 1024, 600 },
+    { 1920, 1080 },
+  };
+
+  /* typical values for a sun azimuth of 45 degrees */
+  const SlopeShadingParameters p{-180, -180, 44, 64, 100};
+
+  static constexpr unsigned ITERATIONS = 50;
+
+  for (const auto size : resolutions) {
+    WindowProjection projection;
+    projection.SetScreenSize(size);
+    projection.SetScaleFromRadius(20000);
+    projection.SetGeoLocation(map.GetMapCenter());
+    projection.SetScreenOrigin(size.width / 2, size.height / 2);
+    projection.UpdateScreenBounds();
+
+    HeightMatrix matrix;
+#ifdef ENABLE_OPENGL
+    matrix.Fill(map, projection.GetScreenBounds(),
+                size.width, size.height, true);
+#else
+    matrix.Fill(map, projection, 1, true);
+#endif
+
+    const std::size_t n_pixels = matrix.GetWidth() * matrix.GetHeight();
+    const std::unique_ptr<int8_t[]> expected(new int8_t[n_pixels]());
+    const std::unique_ptr<int8_t[]> actual(new int8_t[n_pixels]());
+
+    const double generic = Measure(CalculateSlopeShadingRowGeneric, matrix,
+                                   expected.get(), p, ITERATIONS);
+    const double optimised = Measure(CalculateSlopeShadingRow, matrix,
+                                     actual.get(), p, ITERATIONS);
+
+    printf("%4ux%-4u generic %7.3f ms  optimised %7.3f ms  speedup %.1fx%s\n",
+           matrix.GetWidth(), matrix.GetHeight(),
+           generic, optimised, generic / optimised,
+           memcmp(expected.get(), actual.get(), n_pixels) == 0
+           ? "" : "  MISMATCH");
+  }
+
+  return EXIT_SUCCESS;
+} catch (const std::runtime_error &e) {
+  PrintException(e);
+  return EXIT_FAILURE;
+}
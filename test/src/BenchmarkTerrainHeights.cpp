@@ -0,0 +1,118 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Measure RasterMap::GetHeights() on a real terrain file, comparing
+ * it with one RasterMap::GetHeight() call per location.  The
+ * locations are placed on rays around the map center, similar to the
+ * reach calculation.
+ */
+
+#include "Terrain/RasterMap.hpp"
+#include "Terrain/Loader.hpp"
+#include "Operation/ConsoleOperationEnvironment.hpp"
+#include "Geo/Math.hpp"
+#include "system/Args.hpp"
+#include "io/ZipArchive.hpp"
+#include "util/PrintException.hxx"
+
+#include <chrono>
+#include <vector>
+
+#include <stdio.h>
+#include <string.h>
+
+static constexpr unsigned ITERATIONS = 20;
+
+template<typename F>
+static double
+Measure(F &&f)
+{
+  const auto start = std::chrono::steady_clock::now();
+  for (unsigned i = 0; i < ITERATIONS; ++i)
+    f();
+  const std::chrono::duration<double, std::milli> duration =
+    std::chrono::steady_clock::now() - start;
+  return duration.count() / ITERATIONS;
+}
+
+int main(int argc, char **argv)
+try {
+  Args args(argc, argv, "PATH");
+  const auto map_path = args.ExpectNextPath();
+  args.ExpectEnd();
+
+  ZipArchive archive(map_path);
+
+  RasterMap map;
+
+  {
+    ConsoleOperationEnvironment operation;
+    LoadTerrainOverview(archive, map.GetTileCache(), operation);
+  }
+
+  map.UpdateProjection();
+
+  SharedMutex mutex;
+  do {
+    UpdateTerrainTiles(archive, map.GetTileCache(), mutex,
+                       map.GetProjection(),
+                       map.GetMapCenter(), 50000);
+  } while (map.IsDirty());
+
+  static constexpr unsigned N_RAYS = 512, N_SAMPLES = 1024;
+  static constexpr double RADIUS = 40000;
+
+  std::vector<GeoPoint> points;
+  points.reserve(N_RAYS * N_SAMPLES);
+  for (unsigned i = 0; i < N_RAYS; ++i) {
+    const Angle bearing = Angle::FullCircle() * i / N_RAYS;
+    for (unsigned j = 0; j < N_SAMPLES; ++j)
+      points.push_back(FindLatitudeLongitude(map.GetMapCenter(), bearing,
+                                             RADIUS * j / N_SAMPLES));
+  }
+
+  const std::size_t n = points.size();
+  std::vector<TerrainHeight> expected(n, TerrainHeight::Invalid());
+  std::vector<TerrainHeight> actual(n, TerrainHeight::Invalid());
+
+  const double single = Measure([&]{
+    for (std::size_t i = 0; i < n; ++i)
+      expected[i] = map.GetHeight(points[i]);
+  });
+
+  const double batch = Measure([&]{
+    map.GetHeights({points.data(), n}, actual.data());
+  });
+
+  printf("%zu points  single %7.3f ms  batch %7.3f ms  speedup %.1fx%s\n",
+         n, single, batch, single / batch,
+         memcmp(expected.data(), actual.data(),
+                n * sizeof(TerrainHeight)) == 0
+         ? "" : "  MISMATCH");
+
+  return EXIT_SUCCESS;
+} catch (const std::runtime_error &e) {
+  PrintException(e);
+  return EXIT_FAILURE;
+}
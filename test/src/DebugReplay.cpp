@@ -26,7 +26,12 @@ Copyright_License {
 #include "DebugReplayNMEA.hpp"
 #include "system/Args.hpp"
 #include "system/PathName.hpp"
+#include "system/ConvertPathName.hpp"
 #include "Computer/Settings.hpp"
+#include "TraceFile.hpp"
+#include "thread/TraceEvents.hpp"
+#include "util/PrintException.hxx"
+#include "util/StringCompare.hxx"
 
 DebugReplay::DebugReplay()
   :glide_polar(1)
@@ -44,12 +49,23 @@ DebugReplay::DebugReplay()
 
 DebugReplay::~DebugReplay()
 {
+  if (trace_path != nullptr) {
+    try {
+      WriteTraceFile(trace_path);
+    } catch (...) {
+      PrintException(std::current_exception());
+    }
+  }
 }
 
 void
 DebugReplay::Compute()
 {
+  const ScopeTraceEvent trace("Compute");
+
   computed_basic.Reset();
+  /* the sample history must survive the reset */
+  computed_basic.speed_samples = last_basic.speed_samples;
   (NMEAInfo &)computed_basic = raw_basic;
   wrap_clock.Normalise(computed_basic);
 
@@ -68,6 +84,12 @@ CreateDebugReplay(Args &args)
 {
   DebugReplay *replay;
 
+  const char *trace = nullptr;
+  if (!args.IsEmpty() && StringStartsWith(args.PeekNext(), "--trace=")) {
+    trace = args.GetNext() + 8;
+    TraceEvents::SetEnabled(true);
+  }
+
   if (!args.IsEmpty() && MatchesExtension(args.PeekNext(), ".igc")) {
     replay = DebugReplayIGC::Create(args.ExpectNextPath());
   } else {
@@ -76,5 +98,8 @@ CreateDebugReplay(Args &args)
     replay = DebugReplayNMEA::Create(input_file, driver_name);
   }
 
+  if (replay != nullptr && trace != nullptr)
+    replay->SetTracePath(AllocatedPath(PathName(trace)));
+
   return replay;
 }
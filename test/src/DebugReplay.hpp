@@ -31,6 +31,7 @@ Copyright_License {
 #include "Engine/GlideSolvers/GlidePolar.hpp"
 #include "time/WrapClock.hpp"
 #include "system/Args.hpp"
+#include "system/Path.hpp"
 #include "Atmosphere/Pressure.hpp"
 
 
@@ -62,6 +63,12 @@ protected:
 
   AtmosphericPressure qnh;
 
+  /**
+   * If set, then trace events are recorded and written to this file
+   * by the destructor.
+   */
+  AllocatedPath trace_path;
+
 public:
   DebugReplay();
   virtual ~DebugReplay();
@@ -99,10 +106,19 @@ public:
     qnh = _qnh;
   }
 
+  void SetTracePath(AllocatedPath &&_trace_path) noexcept {
+    trace_path = std::move(_trace_path);
+  }
+
 protected:
   void Compute();
 };
 
+/**
+ * Create a #DebugReplay from the command line: either an IGC file or
+ * a driver name followed by a NMEA file.  An optional leading
+ * "--trace=FILE" enables #TraceEvents.
+ */
 DebugReplay *
 CreateDebugReplay(Args &args);
 
@@ -29,10 +29,10 @@ Copyright_License {
 
 class DebugReplayFile : public DebugReplay {
 protected:
-  FileLineReaderA *reader;
+  NLineReader *reader;
 
 public:
-  DebugReplayFile(FileLineReaderA *_reader)
+  DebugReplayFile(NLineReader *_reader)
     : reader(_reader) {
   }
 
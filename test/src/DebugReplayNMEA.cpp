@@ -23,6 +23,7 @@ Copyright_License {
 
 #include "DebugReplayNMEA.hpp"
 #include "io/FileLineReader.hpp"
+#include "io/GunzipLineReader.hpp"
 #include "Device/Driver.hpp"
 #include "Device/Register.hpp"
 #include "Device/Port/NullPort.hpp"
@@ -32,7 +33,7 @@ Copyright_License {
 static DeviceConfig config;
 static NullPort port;
 
-DebugReplayNMEA::DebugReplayNMEA(FileLineReaderA *_reader,
+DebugReplayNMEA::DebugReplayNMEA(NLineReader *_reader,
                                  const DeviceRegister *driver)
   :DebugReplayFile(_reader),
    device(driver->CreateOnPort != NULL
@@ -51,8 +52,9 @@ DebugReplayNMEA::Create(Path input_file, const tstring &driver_name)
     return nullptr;
   }
 
-  FileLineReaderA *reader = new FileLineReaderA(input_file);
-  return new DebugReplayNMEA(reader, driver);
+  /* this also accepts gzip-compressed logs (see NMEALogger) */
+  auto reader = OpenFileLineReaderA(input_file);
+  return new DebugReplayNMEA(reader.release(), driver);
 }
 
 
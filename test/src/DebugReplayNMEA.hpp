@@ -30,7 +30,7 @@ Copyright_License {
 
 #include <memory>
 
-class FileLineReaderA;
+class NLineReader;
 class Device;
 struct DeviceRegister;
 
@@ -43,7 +43,7 @@ class DebugReplayNMEA : public DebugReplayFile {
   ReplayClock clock;
 
 private:
-  DebugReplayNMEA(FileLineReaderA *_reader, const DeviceRegister *driver);
+  DebugReplayNMEA(NLineReader *_reader, const DeviceRegister *driver);
 
 public:
   virtual bool Next();
@@ -35,8 +35,7 @@ int main(int argc, char **argv)
   FlarmNetDatabase database;
   FlarmNetReader::LoadFile(path, database);
 
-  for (auto i = database.begin(), end = database.end(); i != end; ++i) {
-    const FlarmNetRecord &record = i->second;
+  for (const auto &[id, record] : database) {
 
     _tprintf(_T("%s\t%s\t%s\t%s\n"),
              record.id.c_str(), record.pilot.c_str(),
@@ -39,7 +39,7 @@ try {
 
   ZipArchive archive(zip_path);
 
-  ZipLineReader reader(archive.get(), filename);
+  ZipLineReader reader(archive, filename);
 
   TCHAR *line;
   while ((line = reader.ReadLine()) != NULL)
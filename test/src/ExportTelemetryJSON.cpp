@@ -0,0 +1,55 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Replay a flight and export the telemetry stream as JSON, one
+ * object per line.
+ */
+
+#include "TelemetryJSON.hpp"
+#include "system/Args.hpp"
+#include "DebugReplay.hpp"
+#include "io/StdioOutputStream.hxx"
+#include "io/BufferedOutputStream.hxx"
+
+#include <memory>
+
+int main(int argc, char **argv)
+{
+  Args args(argc, argv, "DRIVER FILE");
+  std::unique_ptr<DebugReplay> replay(CreateDebugReplay(args));
+  if (!replay)
+    return EXIT_FAILURE;
+
+  args.ExpectEnd();
+
+  StdioOutputStream sos(stdout);
+  WithBufferedOutputStream(sos, [&](BufferedOutputStream &os){
+    while (replay->Next()) {
+      WriteTelemetryJSON(os, replay->Basic(), replay->Calculated());
+      os.Write('\n');
+    }
+  });
+
+  return EXIT_SUCCESS;
+}
@@ -29,3 +29,9 @@ EGM96::LookupSeparation(const GeoPoint &)
 {
   return 0;
 }
+
+double
+EGM96::SeparationCache::Lookup(const GeoPoint &) noexcept
+{
+  return 0;
+}
@@ -50,7 +50,7 @@ try {
 
   {
     ConsoleOperationEnvironment operation;
-    LoadTerrainOverview(archive.get(), rtc, operation);
+    LoadTerrainOverview(archive, rtc, operation);
   }
 
   GeoBounds bounds = rtc.GetBounds();
@@ -62,7 +62,7 @@ try {
 
   SharedMutex mutex;
   do {
-    UpdateTerrainTiles(archive.get(), rtc, mutex,
+    UpdateTerrainTiles(archive, rtc, mutex,
                        SignedRasterLocation(rtc.GetSize().x / 2,
                                             rtc.GetSize().y / 2),
                        1000);
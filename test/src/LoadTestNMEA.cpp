@@ -0,0 +1,597 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * A load test for the NMEA input pipeline.  It emulates any number of
+ * devices concurrently, each sending its sentences to its own
+ * UDPPort.  The receiving side does what DeviceDescriptor and
+ * DeviceBlackboard do: it splits lines, parses them into a per-device
+ * NMEAInfo and merges all devices after each received chunk.
+ *
+ * The program reports the latency from the arrival of a datagram at
+ * the Port until the merged NMEAInfo containing it is published, and
+ * the CPU time spent per sentence.  Use it to find out how many
+ * devices a given piece of hardware can take.
+ *
+ * Example: LoadTestNMEA 30 gps:10 flarm:2:2 vario:20
+ */
+
+#include "Device/Port/UDPPort.hpp"
+#include "Device/Parser.hpp"
+#include "Device/Util/LineSplitter.hpp"
+#include "NMEA/Info.hpp"
+#include "NMEA/Checksum.hpp"
+#include "system/Args.hpp"
+#include "thread/Cond.hxx"
+#include "thread/Mutex.hxx"
+#include "thread/Statistics.hpp"
+#include "io/async/GlobalAsioThread.hpp"
+#include "io/async/AsioThread.hpp"
+#include "net/IPv4Address.hxx"
+#include "net/UniqueSocketDescriptor.hxx"
+#include "net/SocketError.hxx"
+#include "util/PrintException.hxx"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+
+using std::chrono::steady_clock;
+
+/**
+ * The UDP port of the first emulated device; the others follow.
+ */
+static constexpr unsigned FIRST_PORT = 10110;
+
+/**
+ * The number of targets reported by each emulated FLARM.
+ */
+static constexpr unsigned FLARM_TARGETS = 50;
+
+/**
+ * Datagrams are filled with complete lines up to this size.
+ */
+static constexpr std::size_t MAX_DATAGRAM = 1400;
+
+enum class DeviceType {
+  GPS,
+  FLARM,
+  VARIO,
+};
+
+struct DeviceSpec {
+  DeviceType type;
+  unsigned rate;
+};
+
+/**
+ * Receives the datagrams of all emulated devices, merges their data
+ * and measures the latency.
+ */
+class Blackboard {
+  Mutex mutex;
+  Cond cond;
+
+  std::vector<NMEAInfo> per_device;
+
+  NMEAInfo basic;
+
+  struct Chunk {
+    steady_clock::time_point arrival;
+    unsigned n_sentences;
+  };
+
+  /**
+   * Chunks which were parsed but not yet merged.
+   */
+  std::vector<Chunk> pending;
+
+  /**
+   * The latency of each sentence in microseconds.  Only accessed by
+   * the merge thread.
+   */
+  std::vector<unsigned> latencies;
+
+  unsigned n_merges = 0;
+
+  bool quit = false;
+
+  ThreadStatistics &merge_statistics;
+
+  std::thread thread;
+
+public:
+  explicit Blackboard(unsigned n_devices)
+    :per_device(n_devices),
+     merge_statistics(*ThreadStatistics::Register("merge")) {
+    for (auto &i : per_device)
+      i.Reset();
+
+    basic.Reset();
+    latencies.reserve(1 << 20);
+    thread = std::thread([this](){ Run(); });
+  }
+
+  ~Blackboard() noexcept {
+    Stop();
+  }
+
+  void Stop() noexcept {
+    if (!thread.joinable())
+      return;
+
+    {
+      const std::lock_guard<Mutex> lock(mutex);
+      quit = true;
+      cond.notify_one();
+    }
+
+    thread.join();
+  }
+
+  Mutex &GetMutex() noexcept {
+    return mutex;
+  }
+
+  NMEAInfo &GetDeviceData(unsigned i) noexcept {
+    return per_device[i];
+  }
+
+  /**
+   * All lines of a chunk have been parsed; schedule a merge, like
+   * DeviceBlackboard::ScheduleMerge().
+   */
+  void ScheduleMerge(steady_clock::time_point arrival,
+                     unsigned n_sentences) noexcept {
+    const std::lock_guard<Mutex> lock(mutex);
+    pending.push_back({arrival, n_sentences});
+    cond.notify_one();
+  }
+
+  unsigned GetMergeCount() const noexcept {
+    return n_merges;
+  }
+
+  /**
+   * Call only after Stop().
+   */
+  std::vector<unsigned> &GetLatencies() noexcept {
+    return latencies;
+  }
+
+private:
+  /**
+   * Like DeviceBlackboard::Merge().
+   */
+  void Merge() noexcept {
+    NMEAInfo real_data;
+    real_data.Reset();
+
+    for (auto &i : per_device) {
+      if (!i.alive)
+        continue;
+
+      i.UpdateClock();
+      i.Expire();
+      real_data.Complement(i);
+    }
+
+    basic = real_data;
+  }
+
+  void Run() noexcept {
+    std::vector<Chunk> merged;
+
+    std::unique_lock<Mutex> lock(mutex);
+    while (true) {
+      cond.wait(lock, [this]{ return quit || !pending.empty(); });
+      if (quit)
+        break;
+
+      {
+        ScopeThreadStatistics scope(&merge_statistics);
+        Merge();
+      }
+
+      ++n_merges;
+      merged.swap(pending);
+      lock.unlock();
+
+      /* the merged NMEAInfo is published now */
+      const auto now = steady_clock::now();
+      for (const auto &chunk : merged) {
+        const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(now - chunk.arrival);
+        latencies.insert(latencies.end(), chunk.n_sentences,
+                         latency.count());
+      }
+
+      merged.clear();
+      lock.lock();
+    }
+  }
+};
+
+/**
+ * The receiving end of one emulated device.
+ */
+class Receiver final : public PortLineSplitter {
+  Blackboard &blackboard;
+  const unsigned index;
+
+  NMEAParser parser;
+
+  ThreadStatistics &parse_statistics;
+
+  std::unique_ptr<UDPPort> port;
+
+  unsigned n_lines = 0;
+
+public:
+  std::atomic<unsigned> n_sentences{0}, n_parsed{0};
+
+  Receiver(EventLoop &event_loop, Blackboard &_blackboard, unsigned _index)
+    :blackboard(_blackboard), index(_index),
+     parse_statistics(*ThreadStatistics::Register("parse")),
+     port(new UDPPort(event_loop, FIRST_PORT + index, nullptr, *this)) {
+    port->StartRxThread();
+  }
+
+  void Close() noexcept {
+    port.reset();
+  }
+
+  /* virtual methods from class DataHandler */
+  bool DataReceived(const void *data, size_t length) noexcept override {
+    const auto arrival = steady_clock::now();
+
+    {
+      ScopeThreadStatistics scope(&parse_statistics);
+      n_lines = 0;
+      PortLineSplitter::DataReceived(data, length);
+    }
+
+    n_sentences += n_lines;
+
+    if (n_lines > 0)
+      blackboard.ScheduleMerge(arrival, n_lines);
+
+    return true;
+  }
+
+protected:
+  /* virtual methods from class PortLineHandler */
+  bool LineReceived(const char *line) noexcept override {
+    ++n_lines;
+
+    /* like DeviceDescriptor::LineReceived(), which locks the
+       blackboard for each line */
+    const std::lock_guard<Mutex> lock(blackboard.GetMutex());
+    NMEAInfo &info = blackboard.GetDeviceData(index);
+    info.UpdateClock();
+    if (parser.ParseLine(line, info)) {
+      info.alive.Update(info.clock);
+      ++n_parsed;
+    }
+
+    return true;
+  }
+};
+
+/**
+ * Generates the sentences of one device at a fixed rate and sends
+ * them to its Receiver.
+ */
+class Emulator {
+  const DeviceSpec spec;
+  const unsigned index;
+
+  UniqueSocketDescriptor socket;
+  const IPv4Address destination;
+
+  std::string datagram;
+
+  std::thread thread;
+
+public:
+  unsigned n_sentences = 0, n_datagrams = 0;
+
+  Emulator(const DeviceSpec &_spec, unsigned _index)
+    :spec(_spec), index(_index),
+     destination(127, 0, 0, 1, FIRST_PORT + index) {
+    if (!socket.Create(AF_INET, SOCK_DGRAM, 0))
+      throw MakeSocketError("Failed to create socket");
+  }
+
+  void Start(steady_clock::time_point end) {
+    thread = std::thread([this, end](){ Run(end); });
+  }
+
+  void Join() {
+    thread.join();
+  }
+
+private:
+  void Flush() noexcept {
+    if (datagram.empty())
+      return;
+
+    if (socket.Write(datagram.data(), datagram.size(), destination) > 0)
+      ++n_datagrams;
+
+    datagram.clear();
+  }
+
+  void Send(char *sentence) noexcept {
+    AppendNMEAChecksum(sentence);
+    strcat(sentence, "\r\n");
+
+    const std::size_t length = strlen(sentence);
+    if (datagram.size() + length > MAX_DATAGRAM)
+      Flush();
+
+    datagram.append(sentence, length);
+    ++n_sentences;
+  }
+
+  void SendGPS(unsigned tick) noexcept {
+    const double t = double(tick) / spec.rate;
+    const unsigned hundredths = unsigned(t * 100) % (24 * 3600 * 100);
+    const unsigned hh = hundredths / 360000, mm = hundredths / 6000 % 60;
+    const double ss = (hundredths % 6000) / 100.;
+
+    /* fly eastwards with 100 km/h */
+    const double longitude_minutes = 7 * 60 + t * 0.0151;
+
+    char buffer[256];
+    snprintf(buffer, sizeof(buffer),
+             "$GPRMC,%02u%02u%05.2f,A,5100.0000,N,%03u%07.4f,E,54.0,90.0,150726,,,A",
+             hh, mm, ss,
+             unsigned(longitude_minutes / 60), fmod(longitude_minutes, 60));
+    Send(buffer);
+
+    snprintf(buffer, sizeof(buffer),
+             "$GPGGA,%02u%02u%05.2f,5100.0000,N,%03u%07.4f,E,1,08,1.0,1500.0,M,48.0,M,,",
+             hh, mm, ss,
+             unsigned(longitude_minutes / 60), fmod(longitude_minutes, 60));
+    Send(buffer);
+  }
+
+  void SendFLARM(unsigned tick) noexcept {
+    char buffer[256];
+    snprintf(buffer, sizeof(buffer), "$PFLAU,%u,1,2,1,0,,0,,",
+             FLARM_TARGETS);
+    Send(buffer);
+
+    for (unsigned i = 0; i < FLARM_TARGETS; ++i) {
+      /* the targets circle around us */
+      const double angle = (i * 360. / FLARM_TARGETS + tick) * M_PI / 180;
+      const int distance = 500 + 50 * i;
+
+      snprintf(buffer, sizeof(buffer),
+               "$PFLAA,0,%d,%d,%d,2,%06X,%u,,30,1.5,1",
+               int(distance * cos(angle)), int(distance * sin(angle)),
+               int(i % 20) * 10 - 100,
+               0xd00000 + index * 0x100 + i,
+               (i * 7 + tick) % 360);
+      Send(buffer);
+    }
+  }
+
+  void SendVario(unsigned tick) noexcept {
+    /* a sine wave between -5 and +5 knots */
+    const int vario = 200 + int(50 * sin(tick * 0.1));
+
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "$PTAS1,%03d,%03d,%05u,%03u",
+             vario, vario, 2000 + 4920, 55u);
+    Send(buffer);
+  }
+
+  void Run(steady_clock::time_point end) noexcept {
+    const auto interval = std::chrono::duration_cast<steady_clock::duration>(std::chrono::duration<double>(1. / spec.rate));
+
+    auto next = steady_clock::now();
+    for (unsigned tick = 0; next < end; ++tick, next += interval) {
+      std::this_thread::sleep_until(next);
+
+      switch (spec.type) {
+      case DeviceType::GPS:
+        SendGPS(tick);
+        break;
+
+      case DeviceType::FLARM:
+        SendFLARM(tick);
+        break;
+
+      case DeviceType::VARIO:
+        SendVario(tick);
+        break;
+      }
+
+      Flush();
+    }
+  }
+};
+
+static DeviceSpec
+ParseDeviceSpec(const char *s, unsigned &count)
+{
+  DeviceSpec spec;
+  const char *colon = strchr(s, ':');
+  const std::size_t length = colon != nullptr ? colon - s : strlen(s);
+
+  if (length == 3 && memcmp(s, "gps", 3) == 0) {
+    spec.type = DeviceType::GPS;
+    spec.rate = 10;
+  } else if (length == 5 && memcmp(s, "flarm", 5) == 0) {
+    spec.type = DeviceType::FLARM;
+    spec.rate = 2;
+  } else if (length == 5 && memcmp(s, "vario", 5) == 0) {
+    spec.type = DeviceType::VARIO;
+    spec.rate = 20;
+  } else {
+    fprintf(stderr, "Unknown device type: %s\n", s);
+    exit(EXIT_FAILURE);
+  }
+
+  count = 1;
+
+  if (colon != nullptr) {
+    char *endptr;
+    spec.rate = strtoul(colon + 1, &endptr, 10);
+    if (*endptr == ':')
+      count = strtoul(endptr + 1, &endptr, 10);
+
+    if (*endptr != 0 || spec.rate == 0 || spec.rate > 1000 || count == 0) {
+      fprintf(stderr, "Malformed device: %s\n", s);
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  return spec;
+}
+
+static unsigned
+GetPercentile(const std::vector<unsigned> &sorted, double fraction) noexcept
+{
+  if (sorted.empty())
+    return 0;
+
+  return sorted[std::min<std::size_t>(sorted.size() * fraction,
+                                      sorted.size() - 1)];
+}
+
+static double
+GetProcessCPUTime() noexcept
+{
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) < 0)
+    return 0;
+
+  return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec +
+    (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+int
+main(int argc, char **argv)
+try {
+  Args args(argc, argv,
+            "SECONDS DEVICE...\n\n"
+            "DEVICE is TYPE[:HZ[:COUNT]], TYPE is one of:\n"
+            "\tgps    RMC+GGA, default 10 Hz\n"
+            "\tflarm  PFLAU+50 PFLAA, default 2 Hz\n"
+            "\tvario  PTAS1, default 20 Hz");
+  const int seconds = args.ExpectNextInt();
+  if (seconds <= 0)
+    args.UsageError();
+
+  std::vector<DeviceSpec> specs;
+  do {
+    unsigned count;
+    const DeviceSpec spec = ParseDeviceSpec(args.ExpectNext(), count);
+    specs.insert(specs.end(), count, spec);
+  } while (!args.IsEmpty());
+
+  ScopeGlobalAsioThread global_asio_thread;
+
+  Blackboard blackboard(specs.size());
+
+  std::vector<std::unique_ptr<Receiver>> receivers;
+  std::vector<std::unique_ptr<Emulator>> emulators;
+  for (unsigned i = 0; i < specs.size(); ++i) {
+    receivers.emplace_back(new Receiver(*asio_thread, blackboard, i));
+    emulators.emplace_back(new Emulator(specs[i], i));
+  }
+
+  const double start_cpu = GetProcessCPUTime();
+  const auto end = steady_clock::now() + std::chrono::seconds(seconds);
+  for (auto &i : emulators)
+    i->Start(end);
+
+  for (auto &i : emulators)
+    i->Join();
+
+  /* wait for the last datagrams in flight */
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+  for (auto &i : receivers)
+    i->Close();
+
+  blackboard.Stop();
+
+  const double cpu = GetProcessCPUTime() - start_cpu;
+
+  unsigned long n_sent = 0, n_datagrams = 0, n_received = 0, n_parsed = 0;
+  for (const auto &i : emulators) {
+    n_sent += i->n_sentences;
+    n_datagrams += i->n_datagrams;
+  }
+
+  for (const auto &i : receivers) {
+    n_received += i->n_sentences;
+    n_parsed += i->n_parsed;
+  }
+
+  printf("%zu devices, %d seconds\n", specs.size(), seconds);
+  printf("sentences: %lu sent in %lu datagrams, %lu received (%.0f/s), %lu parsed\n",
+         n_sent, n_datagrams, n_received, double(n_received) / seconds,
+         n_parsed);
+  printf("merges: %u\n", blackboard.GetMergeCount());
+
+  auto &latencies = blackboard.GetLatencies();
+  std::sort(latencies.begin(), latencies.end());
+  if (!latencies.empty())
+    printf("latency [us]: min %u, median %u, 90%% %u, 99%% %u, max %u\n",
+           latencies.front(),
+           GetPercentile(latencies, 0.5),
+           GetPercentile(latencies, 0.9),
+           GetPercentile(latencies, 0.99),
+           latencies.back());
+
+  const auto parse = ThreadStatistics::Register("parse")->GetSnapshot();
+  const auto merge = ThreadStatistics::Register("merge")->GetSnapshot();
+  if (n_received > 0)
+    printf("CPU per sentence [us]: parse %.2f, merge %.2f\n",
+           double(parse.cpu.count()) / n_received,
+           double(merge.cpu.count()) / n_received);
+
+  printf("CPU per merge [us]: %.2f\n",
+         merge.cycles > 0 ? double(merge.cpu.count()) / merge.cycles : 0.);
+  printf("process CPU (including the emulators): %.2f s (%.1f%%)\n",
+         cpu, 100 * cpu / seconds);
+
+  return EXIT_SUCCESS;
+} catch (const std::exception &exception) {
+  PrintException(exception);
+  return EXIT_FAILURE;
+}
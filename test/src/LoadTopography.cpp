@@ -71,7 +71,7 @@ try {
 
   ZipArchive archive(path);
 
-  ZipLineReaderA reader(archive.get(), "topology.tpl");
+  ZipLineReaderA reader(archive, "topology.tpl");
 
   TopographyStore topography;
 
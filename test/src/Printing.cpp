@@ -140,6 +140,7 @@ void PrintHelper::print_route(RoutePlanner& r)
   printf("#   airspace queries %d\n", (int)r.count_airspace);
   printf("#   terrain queries %d\n", (int)r.count_terrain);
   printf("#   supressed %d\n", (int)r.count_supressed);
+  printf("#   polar rebuilds %d\n", (int)r.count_polar_rebuilds);
 }
 
 #include "Route/ReachFan.hpp"
@@ -21,20 +21,150 @@ Copyright_License {
 }
 */
 
+/*
+ * Parse an airspace file and measure the time needed for parsing,
+ * for building the spatial index and for range and intersection
+ * queries around every airspace, and for visibility checks of the
+ * whole database.  If a cache directory is given,
+ * the airspaces are also saved to and loaded from an airspace cache.
+ */
+
 #include "Airspace/AirspaceParser.hpp"
+#include "Airspace/AirspaceCache.hpp"
+#include "Airspace/AirspaceVisibility.hpp"
+#include "Airspace/AirspaceComputerSettings.hpp"
+#include "Renderer/AirspaceRendererSettings.hpp"
 #include "Engine/Airspace/Airspaces.hpp"
+#include "Engine/Airspace/AbstractAirspace.hpp"
+#include "Engine/Navigation/Aircraft.hpp"
 #include "system/Args.hpp"
 #include "io/FileLineReader.hpp"
+#include "io/FileCache.hpp"
 #include "Operation/ConsoleOperationEnvironment.hpp"
 #include "util/PrintException.hxx"
 
+#include <chrono>
+#include <iterator>
+#include <vector>
+
 #include <stdio.h>
 #include <tchar.h>
 
+using namespace std::chrono;
+
+/**
+ * The radius of the range queries [m].
+ */
+static constexpr double QUERY_RANGE = 20000;
+
+static double
+ElapsedMilliseconds(steady_clock::time_point start) noexcept
+{
+  return duration<double, std::milli>(steady_clock::now() - start).count();
+}
+
+static void
+RunQueries(const Airspaces &airspaces)
+{
+  std::vector<GeoPoint> locations;
+  for (const auto &i : airspaces.QueryAll())
+    locations.push_back(i.GetAirspace().GetReferenceLocation());
+
+  if (locations.size() < 2)
+    return;
+
+  auto start = steady_clock::now();
+  unsigned n_range = 0;
+  for (const auto &location : locations) {
+    const auto range = airspaces.QueryWithinRange(location, QUERY_RANGE);
+    n_range += std::distance(range.begin(), range.end());
+  }
+
+  printf("%zu range queries: %u results, %.2f ms\n",
+         locations.size(), n_range, ElapsedMilliseconds(start));
+
+  start = steady_clock::now();
+  unsigned n_intersecting = 0;
+  for (auto i = std::next(locations.begin()); i != locations.end(); ++i) {
+    const auto range = airspaces.QueryIntersecting(*std::prev(i), *i);
+    n_intersecting += std::distance(range.begin(), range.end());
+  }
+
+  printf("%zu intersection queries: %u results, %.2f ms\n",
+         locations.size() - 1, n_intersecting, ElapsedMilliseconds(start));
+}
+
+static void
+RunVisibility(const Airspaces &airspaces)
+{
+  AirspaceComputerSettings computer_settings;
+  computer_settings.SetDefaults();
+
+  AirspaceRendererSettings renderer_settings;
+  renderer_settings.SetDefaults();
+
+  AltitudeState state;
+  state.altitude = 1500;
+  state.altitude_agl = 1000;
+
+  auto start = steady_clock::now();
+  unsigned n = 0;
+  for ([[maybe_unused]] const auto &i : airspaces.QueryAll())
+    ++n;
+
+  printf("iterate: %u airspaces, %.2f ms\n", n, ElapsedMilliseconds(start));
+
+  static constexpr AirspaceDisplayMode modes[] = {
+    AirspaceDisplayMode::ALLON,
+    AirspaceDisplayMode::CLIP,
+    AirspaceDisplayMode::AUTO,
+  };
+
+  for (const auto mode : modes) {
+    renderer_settings.altitude_mode = mode;
+    const auto visible = AirspaceVisiblePredicate(computer_settings,
+                                                  renderer_settings, state);
+
+    start = steady_clock::now();
+    unsigned n_visible = 0;
+    for (const auto &i : airspaces.QueryAll())
+      if (visible(i.GetAirspace()))
+        ++n_visible;
+
+    printf("visibility mode %u: %u visible, %.2f ms\n",
+           unsigned(mode), n_visible, ElapsedMilliseconds(start));
+  }
+}
+
+static void
+RunCache(const Airspaces &airspaces, Path path, Path cache_path)
+{
+  FileCache cache{AllocatedPath(cache_path)};
+
+  auto start = steady_clock::now();
+  SaveAirspaceCache(airspaces, cache, _T("airspace"), path);
+  printf("save cache: %.2f ms\n", ElapsedMilliseconds(start));
+
+  Airspaces loaded;
+  start = steady_clock::now();
+  if (!LoadAirspaceCache(loaded, cache, _T("airspace"), path))
+    throw std::runtime_error("Failed to load the airspace cache");
+
+  printf("load cache: %.2f ms\n", ElapsedMilliseconds(start));
+
+  start = steady_clock::now();
+  loaded.Optimise();
+  printf("optimise: %u airspaces, %.2f ms\n",
+         loaded.GetSize(), ElapsedMilliseconds(start));
+}
+
 int main(int argc, char **argv)
 try {
-  Args args(argc, argv, "PATH");
+  Args args(argc, argv, "PATH [CACHEDIR]");
   const auto path = args.ExpectNextPath();
+  AllocatedPath cache_path = nullptr;
+  if (!args.IsEmpty())
+    cache_path = args.ExpectNextPath();
   args.ExpectEnd();
 
   FileLineReader reader(path, Charset::AUTO);
@@ -42,12 +172,24 @@ try {
   Airspaces airspaces;
 
   ConsoleOperationEnvironment operation;
+  auto start = steady_clock::now();
   if (!ParseAirspaceFile(airspaces, reader, operation)) {
     fprintf(stderr, "Failed to parse input file\n");
     return 1;
   }
 
+  printf("parse: %.2f ms\n", ElapsedMilliseconds(start));
+
+  start = steady_clock::now();
   airspaces.Optimise();
+  printf("optimise: %u airspaces, %.2f ms\n",
+         airspaces.GetSize(), ElapsedMilliseconds(start));
+
+  RunQueries(airspaces);
+  RunVisibility(airspaces);
+
+  if (cache_path != nullptr)
+    RunCache(airspaces, path, cache_path);
 
   printf("OK\n");
 
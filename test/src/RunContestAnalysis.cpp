@@ -25,6 +25,7 @@
 #include "Printing.hpp"
 #include "system/Args.hpp"
 #include "DebugReplay.hpp"
+#include "thread/ThreadPool.hpp"
 
 #include <cassert>
 #include <stdio.h>
@@ -178,7 +179,16 @@ int main(int argc, char **argv)
 
   args.ExpectEnd();
 
+  /* run the independent solvers in parallel, like ContestComputer */
+  ThreadPool thread_pool(3);
+  for (ContestManager *i : {&olc_plus, &xcontest, &weglide_free})
+    i->SetThreadPool(&thread_pool);
+
   int result = TestContest(*replay);
   delete replay;
+
+  for (ContestManager *i : {&olc_plus, &xcontest, &weglide_free})
+    i->SetThreadPool(nullptr);
+
   return result;
 }
@@ -0,0 +1,572 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Simulate a fleet of gliders flying tasks in one process: each
+ * aircraft has its own #TaskAutoPilot, #AircraftSim, #TaskManager and
+ * a complete #GlideComputer, while the terrain, the airspaces and the
+ * waypoints are loaded only once and shared by all of them.  The
+ * aircraft are stepped in batches on a #ThreadPool.  At the end, the
+ * number of flights and the task speeds are printed per task file,
+ * which allows regression-testing the task logic with many flights.
+ *
+ * The shared databases are read-only while the batches run; the few
+ * places where a #GlideComputer writes to them are avoided:
+ *
+ * - the airspace QNH and activity are set by the first step of each
+ *   aircraft, which runs serially; all aircraft use the same settings
+ *   and the same (simulated) day, so later steps never change them
+ *
+ * - the route planner does not avoid airspaces, because that stores
+ *   clearance polygons in the shared airspace objects
+ *
+ * - terrain tiles are loaded before the simulation starts
+ *
+ * The autopilot uses rand(), therefore the results of several runs
+ * differ slightly.
+ */
+
+#include "Replay/DemoReplay.hpp"
+#include "Replay/TaskAccessor.hpp"
+#include "Task/TaskFile.hpp"
+#include "Task/ProtectedTaskManager.hpp"
+#include "Terrain/RasterTerrain.hpp"
+#include "Airspace/AirspaceParser.hpp"
+#include "Waypoint/WaypointReader.hpp"
+#include "Waypoint/Factory.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "Engine/Waypoint/Waypoints.hpp"
+#include "Engine/Task/TaskManager.hpp"
+#include "Engine/Task/Ordered/OrderedTask.hpp"
+#include "Computer/GlideComputer.hpp"
+#include "Computer/GlideComputerInterface.hpp"
+#include "Computer/BasicComputer.hpp"
+#include "Computer/Settings.hpp"
+#include "Geo/GeoBounds.hpp"
+#include "io/FileLineReader.hpp"
+#include "thread/ThreadPool.hpp"
+#include "system/Args.hpp"
+#include "system/Path.hpp"
+#include "Operation/ConsoleOperationEnvironment.hpp"
+#include "util/NumberParser.hpp"
+#include "util/StringCompare.hxx"
+#include "util/PrintException.hxx"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* fake symbols: */
+
+#include "Computer/ConditionMonitor/ConditionMonitors.hpp"
+#include "Input/InputQueue.hpp"
+#include "Logger/Logger.hpp"
+
+void
+ConditionMonitorsUpdate(const NMEAInfo &basic, const DerivedInfo &calculated,
+                        const ComputerSettings &settings)
+{
+}
+
+bool InputEvents::processGlideComputer(unsigned) { return false; }
+
+void Logger::LogStartEvent(const NMEAInfo &gps_info) {}
+void Logger::LogFinishEvent(const NMEAInfo &gps_info) {}
+void Logger::LogPoint(const NMEAInfo &gps_info) {}
+
+/* done with fake symbols. */
+
+using namespace std::chrono;
+
+struct FleetSettings {
+  unsigned n_aircraft = 100;
+
+  unsigned n_threads = std::max(std::thread::hardware_concurrency(), 1U);
+
+  /**
+   * The simulated time per aircraft.
+   */
+  seconds duration = hours(5);
+
+  const char *terrain_path = nullptr;
+  const char *airspace_path = nullptr;
+  const char *waypoint_path = nullptr;
+};
+
+/**
+ * Each job of the #ThreadPool advances one aircraft by this number of
+ * simulated seconds.
+ */
+static constexpr unsigned BATCH_SECONDS = 60;
+
+/**
+ * Flights which take longer than this are restarted (e.g. when the
+ * autopilot never finishes an AAT).
+ */
+static constexpr FloatDuration MAX_FLIGHT_TIME = hours(10);
+
+/**
+ * The terrain tiles within this distance [m] of the task area are
+ * loaded before the simulation starts.
+ */
+static constexpr double TERRAIN_MARGIN = 50000;
+
+struct TaskResult {
+  unsigned flights = 0, finished = 0;
+
+  /**
+   * Task speeds [m/s] of the finished flights.
+   */
+  double speed_sum = 0, speed_min = 0, speed_max = 0;
+
+  void AddFinished(double speed) noexcept {
+    if (finished == 0 || speed < speed_min)
+      speed_min = speed;
+    if (finished == 0 || speed > speed_max)
+      speed_max = speed;
+
+    ++finished;
+    speed_sum += speed;
+  }
+
+  void Append(const TaskResult &other) noexcept {
+    flights += other.flights;
+
+    if (other.finished > 0) {
+      if (finished == 0 || other.speed_min < speed_min)
+        speed_min = other.speed_min;
+      if (finished == 0 || other.speed_max > speed_max)
+        speed_max = other.speed_max;
+    }
+
+    finished += other.finished;
+    speed_sum += other.speed_sum;
+  }
+};
+
+/**
+ * One simulated glider with its own task manager and glide computer.
+ * All methods are called by one thread at a time.
+ */
+class SimulatedAircraft final : DemoReplay {
+  const OrderedTask &task;
+
+  const ComputerSettings &settings;
+
+  TaskManager task_manager;
+  ProtectedTaskManager protected_task_manager;
+  GlideComputerTaskEvents task_events;
+  GlideComputer glide_computer;
+
+  BasicComputer basic_computer;
+  MoreData basic, last_basic;
+
+  /**
+   * The results of this aircraft's flights.
+   */
+  TaskResult result;
+
+  seconds simulated{};
+
+public:
+  SimulatedAircraft(const OrderedTask &_task,
+                    const ComputerSettings &_settings,
+                    const Waypoints &waypoints, Airspaces &airspaces,
+                    RasterTerrain *terrain, double speed_factor) noexcept;
+
+  SimulatedAircraft(const SimulatedAircraft &) = delete;
+  SimulatedAircraft &operator=(const SimulatedAircraft &) = delete;
+
+  const TaskResult &GetResult() const noexcept {
+    return result;
+  }
+
+  seconds GetSimulated() const noexcept {
+    return simulated;
+  }
+
+  /**
+   * Advance the simulation by the given number of seconds.
+   */
+  void Run(unsigned n_seconds) noexcept {
+    for (unsigned i = 0; i < n_seconds; ++i)
+      Step();
+  }
+
+private:
+  void StartFlight() noexcept;
+  void FinishFlight() noexcept;
+  void Compute() noexcept;
+  void Step() noexcept;
+};
+
+SimulatedAircraft::SimulatedAircraft(const OrderedTask &_task,
+                                     const ComputerSettings &_settings,
+                                     const Waypoints &waypoints,
+                                     Airspaces &airspaces,
+                                     RasterTerrain *terrain,
+                                     double speed_factor) noexcept
+  :task(_task), settings(_settings),
+   task_manager(settings.task, waypoints),
+   protected_task_manager(task_manager, settings.task),
+   glide_computer(settings, waypoints, airspaces,
+                  protected_task_manager, task_events)
+{
+  task_manager.SetGlidePolar(settings.polar.glide_polar_task);
+  task_manager.SetTaskEvents(task_events);
+
+  glide_computer.ReadComputerSettings(settings);
+  glide_computer.SetTerrain(terrain);
+
+  /* the aircraft are already simulated in parallel; this avoids a
+     private reach thread pool per aircraft */
+  glide_computer.SetReachThreadPool(nullptr);
+
+  glide_computer.Initialise();
+
+  autopilot.SetSpeedFactor(speed_factor);
+
+  StartFlight();
+}
+
+void
+SimulatedAircraft::StartFlight() noexcept
+{
+  glide_computer.ResetFlight(true);
+  basic.Reset();
+  last_basic.Reset();
+
+  ProtectedTaskManager::ExclusiveLease lease(protected_task_manager);
+  lease->Reset();
+  lease->Commit(task);
+
+  const TaskAccessor ta(lease, 0);
+  DemoReplay::Start(ta, task.GetTaskPoint(0).GetLocation());
+
+  ++result.flights;
+}
+
+void
+SimulatedAircraft::FinishFlight() noexcept
+{
+  const TaskStats &stats = glide_computer.Calculated().ordered_task_stats;
+  if (stats.task_finished)
+    result.AddFinished(stats.total.travelled.GetSpeed());
+}
+
+/**
+ * Feed the state of the #AircraftSim through the #BasicComputer and
+ * the #GlideComputer, like the calculation thread does with GPS data.
+ */
+inline void
+SimulatedAircraft::Compute() noexcept
+{
+  const AircraftState &s = aircraft.GetState();
+
+  basic.Reset();
+  /* the sample history must survive the reset */
+  basic.speed_samples = last_basic.speed_samples;
+
+  basic.clock = s.time;
+  basic.alive.Update(basic.clock);
+  basic.ProvideTime(s.time);
+  basic.location = s.location;
+  basic.location_available.Update(basic.clock);
+  basic.ground_speed = s.ground_speed;
+  basic.ground_speed_available.Update(basic.clock);
+  basic.track = s.track;
+  basic.track_available.Update(basic.clock);
+  basic.gps_altitude = s.altitude;
+  basic.gps_altitude_available.Update(basic.clock);
+  basic.ProvidePressureAltitude(s.altitude);
+  basic.ProvideBaroAltitudeTrue(s.altitude);
+  basic.gps.real = false;
+  basic.gps.replay = true;
+  basic.gps.simulator = false;
+
+  basic_computer.Fill(basic, settings);
+  basic_computer.Compute(basic, last_basic, last_basic,
+                         glide_computer.Calculated());
+
+  glide_computer.ReadBlackboard(basic);
+  glide_computer.ProcessGPS();
+  glide_computer.ProcessIdle();
+
+  last_basic = basic;
+}
+
+void
+SimulatedAircraft::Step() noexcept
+{
+  double floor_alt = 300;
+  const DerivedInfo &calculated = glide_computer.Calculated();
+  if (calculated.terrain_valid)
+    floor_alt += calculated.terrain_altitude;
+
+  bool flying;
+
+  {
+    ProtectedTaskManager::ExclusiveLease lease(protected_task_manager);
+    TaskAccessor ta(lease, floor_alt);
+    flying = DemoReplay::Update(seconds{1}, ta);
+  }
+
+  Compute();
+
+  ++simulated;
+
+  if (!flying || aircraft.GetTime().ToDuration() > MAX_FLIGHT_TIME) {
+    FinishFlight();
+    StartFlight();
+  }
+}
+
+static bool
+ParseOption(const char *arg, FleetSettings &settings)
+{
+  const auto parse_unsigned = [](const char *value, unsigned &n){
+    char *endptr;
+    n = ParseUnsigned(value, &endptr);
+    return endptr != value && *endptr == 0 && n > 0;
+  };
+
+  if (const char *v = StringAfterPrefix(arg, "--aircraft="))
+    return parse_unsigned(v, settings.n_aircraft);
+  else if (const char *v = StringAfterPrefix(arg, "--threads="))
+    return parse_unsigned(v, settings.n_threads);
+  else if (const char *v = StringAfterPrefix(arg, "--duration=")) {
+    unsigned s;
+    if (!parse_unsigned(v, s))
+      return false;
+
+    settings.duration = seconds(s);
+    return true;
+  } else if (const char *v = StringAfterPrefix(arg, "--terrain="))
+    settings.terrain_path = v;
+  else if (const char *v = StringAfterPrefix(arg, "--airspace="))
+    settings.airspace_path = v;
+  else if (const char *v = StringAfterPrefix(arg, "--waypoints="))
+    settings.waypoint_path = v;
+  else
+    return false;
+
+  return true;
+}
+
+/**
+ * Load the terrain tiles covering all tasks.  The tile budget may
+ * limit the resolution of a large area.
+ */
+static void
+LoadTerrainTiles(RasterTerrain &terrain,
+                 const std::vector<std::unique_ptr<OrderedTask>> &tasks)
+{
+  GeoBounds bounds = GeoBounds::Invalid();
+  for (const auto &task : tasks) {
+    for (unsigned i = 0; i < task->TaskSize(); ++i) {
+      const GeoPoint location = task->GetTaskPoint(i).GetLocation();
+      if (bounds.IsValid())
+        bounds.Extend(location);
+      else
+        bounds = GeoBounds(location);
+    }
+  }
+
+  const GeoPoint center = bounds.GetCenter();
+  const double radius = center.Distance(bounds.GetNorthWest())
+    + TERRAIN_MARGIN;
+
+  while (terrain.UpdateTiles(center, radius)) {}
+}
+
+static void
+PrintResult(const char *name, const TaskResult &result)
+{
+  printf("%-32s flights=%u finished=%u", name, result.flights,
+         result.finished);
+  if (result.finished > 0)
+    printf(" speed=%.1f/%.1f/%.1fkm/h",
+           result.speed_min * 3.6,
+           result.speed_sum / result.finished * 3.6,
+           result.speed_max * 3.6);
+  printf("\n");
+}
+
+static constexpr const char *usage =
+  "[OPTIONS] TASKFILE...\n\n"
+  "Options:\n"
+  "  --aircraft=N (100)  --threads=N (all cores)  --duration=S (18000)\n"
+  "  --terrain=FILE.xcm  --airspace=FILE.txt  --waypoints=FILE.cup";
+
+int
+main(int argc, char **argv)
+try {
+  Args args(argc, argv, usage);
+
+  FleetSettings fleet_settings;
+  while (!args.IsEmpty() && StringStartsWith(args.PeekNext(), "--")) {
+    const char *arg = args.GetNext();
+    if (!ParseOption(arg, fleet_settings)) {
+      fprintf(stderr, "Bad option: %s\n", arg);
+      args.UsageError();
+    }
+  }
+
+  ConsoleOperationEnvironment operation;
+
+  ComputerSettings settings;
+  settings.SetDefaults();
+  settings.polar.glide_polar_task = GlidePolar(1);
+
+  /* avoiding airspaces would modify the shared airspace objects */
+  settings.task.route_planner.mode = RoutePlannerConfig::Mode::TERRAIN;
+
+  /* the shared databases */
+
+  std::unique_ptr<RasterTerrain> terrain;
+  if (fleet_settings.terrain_path != nullptr)
+    terrain = RasterTerrain::OpenTerrain(nullptr,
+                                         Path(fleet_settings.terrain_path),
+                                         operation);
+
+  Waypoints waypoints;
+  if (fleet_settings.waypoint_path != nullptr) {
+    if (!ReadWaypointFile(Path(fleet_settings.waypoint_path), waypoints,
+                          WaypointFactory(WaypointOrigin::NONE,
+                                          terrain.get()),
+                          operation)) {
+      fprintf(stderr, "Failed to load waypoints\n");
+      return EXIT_FAILURE;
+    }
+
+    waypoints.Optimise();
+  }
+
+  Airspaces airspaces;
+  if (fleet_settings.airspace_path != nullptr) {
+    FileLineReader reader(Path(fleet_settings.airspace_path),
+                          Charset::AUTO);
+    if (!ParseAirspaceFile(airspaces, reader, operation)) {
+      fprintf(stderr, "Failed to parse airspace file\n");
+      return EXIT_FAILURE;
+    }
+
+    airspaces.Optimise();
+  }
+
+  std::vector<std::unique_ptr<OrderedTask>> tasks;
+  std::vector<const char *> task_names;
+  do {
+    const char *name = args.PeekNext();
+    const auto path = args.ExpectNextPath();
+    auto task = TaskFile::GetTask(path, settings.task,
+                                  waypoints.IsEmpty() ? nullptr : &waypoints,
+                                  0);
+    if (task == nullptr || task->TaskSize() == 0) {
+      fprintf(stderr, "Failed to load task %s\n", path.c_str());
+      return EXIT_FAILURE;
+    }
+
+    task->UpdateGeometry();
+    tasks.emplace_back(std::move(task));
+    task_names.push_back(name);
+  } while (!args.IsEmpty());
+
+  if (terrain) {
+    LoadTerrainTiles(*terrain, tasks);
+    airspaces.SetGroundLevels(*terrain);
+  }
+
+  airspaces.SetFlightLevels(settings.pressure);
+
+  /* the fleet */
+
+  std::vector<std::unique_ptr<SimulatedAircraft>> fleet;
+  fleet.reserve(fleet_settings.n_aircraft);
+  for (unsigned i = 0; i < fleet_settings.n_aircraft; ++i) {
+    /* vary the performance, so the flights differ */
+    const double speed_factor = 0.8 + 0.4 * (i * 37 % 100) / 100.;
+
+    fleet.emplace_back(std::make_unique<SimulatedAircraft>(*tasks[i % tasks.size()],
+                                                           settings,
+                                                           waypoints,
+                                                           airspaces,
+                                                           terrain.get(),
+                                                           speed_factor));
+  }
+
+  ThreadPool thread_pool(fleet_settings.n_threads);
+
+  const auto start_time = steady_clock::now();
+
+  /* the first step may update the shared airspace state (see above),
+     therefore it is not run concurrently */
+  for (auto &aircraft : fleet)
+    aircraft->Run(1);
+
+  for (seconds t{1}; t < fleet_settings.duration;
+       t += seconds{BATCH_SECONDS}) {
+    const unsigned n_seconds =
+      std::min<seconds::rep>(BATCH_SECONDS,
+                             (fleet_settings.duration - t).count());
+
+    thread_pool.ForEach(fleet.size(), [&fleet, n_seconds](unsigned i){
+      fleet[i]->Run(n_seconds);
+    });
+  }
+
+  const duration<double> elapsed = steady_clock::now() - start_time;
+
+  /* report */
+
+  std::vector<TaskResult> results(tasks.size());
+  TaskResult total;
+  seconds simulated{};
+  for (unsigned i = 0; i < fleet.size(); ++i) {
+    results[i % tasks.size()].Append(fleet[i]->GetResult());
+    total.Append(fleet[i]->GetResult());
+    simulated += fleet[i]->GetSimulated();
+  }
+
+  printf("aircraft=%zu threads=%u simulated=%.1fh wall=%.1fs speedup=%.0f\n",
+         fleet.size(), thread_pool.GetConcurrency(),
+         duration<double, std::ratio<3600>>(simulated).count(),
+         elapsed.count(),
+         duration<double>(simulated).count() / elapsed.count());
+
+  for (unsigned i = 0; i < tasks.size(); ++i)
+    PrintResult(task_names[i], results[i]);
+
+  if (tasks.size() > 1)
+    PrintResult("total", total);
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,190 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+/*
+ * Run the flight phase detector on all IGC files of a directory in
+ * parallel, and print one line of JSON per file as soon as it is
+ * finished.  The throughput is printed to stderr at the end.
+ */
+
+#include "FlightPhaseDetector.hpp"
+#include "FlightPhaseJSON.hpp"
+#include "DebugReplayIGC.hpp"
+#include "Computer/CirclingComputer.hpp"
+#include "Computer/Settings.hpp"
+#include "thread/ThreadPool.hpp"
+#include "thread/Mutex.hxx"
+#include "system/Args.hpp"
+#include "system/FileUtil.hpp"
+#include "util/Exception.hxx"
+#include "util/StringCompare.hxx"
+
+#include <boost/json/serialize.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+struct FileList final : File::Visitor {
+  std::vector<AllocatedPath> files;
+
+  void Visit(Path path, Path) override {
+    files.emplace_back(path);
+  }
+};
+
+struct BatchStats {
+  std::atomic_uint flights{0}, failed{0};
+  std::atomic_ulong fixes{0};
+};
+
+/**
+ * Serialises the lines written to stdout.
+ */
+static Mutex output_mutex;
+
+/**
+ * Replay the whole file through the flight phase detector.
+ *
+ * @return the number of fixes
+ */
+static unsigned long
+Run(DebugReplay &replay, FlightPhaseDetector &detector)
+{
+  CirclingSettings circling_settings;
+  circling_settings.SetDefaults();
+
+  CirclingComputer circling_computer;
+
+  unsigned long n_fixes = 0;
+  while (replay.Next()) {
+    circling_computer.TurnRate(replay.SetCalculated(),
+                               replay.Basic(),
+                               replay.Calculated().flight);
+    circling_computer.Turning(replay.SetCalculated(),
+                              replay.Basic(),
+                              replay.Calculated().flight,
+                              circling_settings);
+
+    detector.Update(replay.Basic(), replay.Calculated());
+    ++n_fixes;
+  }
+
+  detector.Finish();
+  return n_fixes;
+}
+
+static void
+AnalyseFile(Path path, BatchStats &stats) noexcept
+{
+  boost::json::object root;
+  root.emplace("file", path.ToUTF8());
+
+  try {
+    const std::unique_ptr<DebugReplay> replay(DebugReplayIGC::Create(path));
+    const auto detector = std::make_unique<FlightPhaseDetector>();
+
+    stats.fixes += Run(*replay, *detector);
+
+    root.emplace("phases", WritePhaseList(detector->GetPhases()));
+    root.emplace("performance",
+                 WritePerformanceStats(detector->GetTotals()));
+    ++stats.flights;
+  } catch (...) {
+    root.emplace("error", GetFullMessage(std::current_exception()));
+    ++stats.failed;
+  }
+
+  const std::string line = boost::json::serialize(root);
+
+  const std::lock_guard<Mutex> lock(output_mutex);
+  fputs(line.c_str(), stdout);
+  fputc('\n', stdout);
+  fflush(stdout);
+}
+
+int main(int argc, char **argv)
+{
+  unsigned n_threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+  Args args(argc, argv,
+            "[options] DIRECTORY\n"
+            "Options:\n"
+            "  --jobs=N    Number of files analysed in parallel (default = number of CPUs)");
+
+  const char *arg;
+  while ((arg = args.PeekNext()) != nullptr && *arg == '-') {
+    args.Skip();
+
+    const char *value;
+    if ((value = StringAfterPrefix(arg, "--jobs=")) != nullptr) {
+      unsigned _jobs = strtol(value, NULL, 10);
+      if (_jobs > 0)
+        n_threads = _jobs;
+      else {
+        fputs("The jobs parameter could not be parsed correctly.\n", stderr);
+        args.UsageError();
+      }
+    } else {
+      args.UsageError();
+    }
+  }
+
+  const auto directory = args.ExpectNextPath();
+  args.ExpectEnd();
+
+  FileList list;
+  Directory::VisitSpecificFiles(directory, "*.igc", list, true);
+
+  const auto start = std::chrono::steady_clock::now();
+
+  BatchStats stats;
+
+  {
+    ThreadPool pool(n_threads);
+    pool.ForEach(list.files.size(), [&list, &stats](unsigned i) noexcept {
+      AnalyseFile(list.files[i], stats);
+    });
+  }
+
+  const std::chrono::duration<double> duration =
+    std::chrono::steady_clock::now() - start;
+  const double seconds = std::max(duration.count(), 1e-6);
+
+  fprintf(stderr,
+          "%u flights (%u failed), %lu fixes in %.2f s: "
+          "%.1f flights/s, %.0f fixes/s\n",
+          stats.flights.load(), stats.failed.load(), stats.fixes.load(),
+          seconds,
+          (stats.flights + stats.failed) / seconds,
+          stats.fixes / seconds);
+
+  return EXIT_SUCCESS;
+}
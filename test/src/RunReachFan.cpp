@@ -0,0 +1,134 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Measure how long the reach fan takes to update while circling in
+ * a thermal and while gliding, the way #RouteComputer triggers it
+ * every few seconds.
+ */
+
+#include "Engine/Route/TerrainRoute.hpp"
+#include "Terrain/RasterMap.hpp"
+#include "Terrain/Loader.hpp"
+#include "Operation/ConsoleOperationEnvironment.hpp"
+#include "GlideSolvers/GlideSettings.hpp"
+#include "GlideSolvers/GlidePolar.hpp"
+#include "Geo/SpeedVector.hpp"
+#include "Geo/GeoVector.hpp"
+#include "system/Args.hpp"
+#include "io/ZipArchive.hpp"
+#include "util/PrintException.hxx"
+
+#include <chrono>
+
+#include <limits.h>
+#include <stdio.h>
+
+/** the interval between two reach updates (s) */
+static constexpr double PERIOD = 5;
+
+static constexpr unsigned N_STEPS = 60;
+
+using Clock = std::chrono::steady_clock;
+
+template<typename F>
+static void
+Measure(const char *name, TerrainRoute &route,
+        const RoutePlannerConfig &config, F &&position)
+{
+  Clock::duration total{}, max{};
+
+  for (unsigned i = 0; i < N_STEPS; ++i) {
+    const AGeoPoint origin = position(i * PERIOD);
+
+    const auto start = Clock::now();
+    route.SolveReachTerrain(origin, config, INT_MAX);
+    const auto duration = Clock::now() - start;
+
+    total += duration;
+    if (duration > max)
+      max = duration;
+  }
+
+  using std::chrono::duration_cast;
+  using std::chrono::microseconds;
+  printf("%s: %u updates, average %lu us, maximum %lu us\n",
+         name, N_STEPS,
+         (unsigned long)duration_cast<microseconds>(total / N_STEPS).count(),
+         (unsigned long)duration_cast<microseconds>(max).count());
+}
+
+int main(int argc, char **argv)
+try {
+  Args args(argc, argv, "PATH");
+  const auto map_path = args.ExpectNextPath();
+  args.ExpectEnd();
+
+  ZipArchive archive(map_path);
+
+  RasterMap map;
+
+  {
+    ConsoleOperationEnvironment operation;
+    LoadTerrainOverview(archive, map.GetTileCache(), operation);
+  }
+
+  map.UpdateProjection();
+
+  SharedMutex mutex;
+  do {
+    UpdateTerrainTiles(archive, map.GetTileCache(), mutex,
+                       map.GetProjection(),
+                       map.GetMapCenter(), 50000);
+  } while (map.IsDirty());
+
+  GlideSettings settings;
+  settings.SetDefaults();
+  RoutePlannerConfig config;
+  config.SetDefaults();
+
+  const GlidePolar polar(1);
+  TerrainRoute route;
+  route.UpdatePolar(settings, config, polar, polar, SpeedVector::Zero());
+  route.SetTerrain(&map);
+
+  const GeoPoint center = map.GetMapCenter();
+  const double base = map.GetHeight(center).GetValueOr0() + 1000;
+
+  /* circling with a radius of 80 m, 25 s per turn, climbing 1.5 m/s */
+  Measure("thermal", route, config, [&](double t){
+    const GeoVector v(80, Angle::FullCircle() * (t / 25));
+    return AGeoPoint(v.EndPoint(center), base + 1.5 * t);
+  });
+
+  /* gliding north at 30 m/s, sinking 1 m/s */
+  Measure("glide", route, config, [&](double t){
+    const GeoVector v(30 * t, Angle::Zero());
+    return AGeoPoint(v.EndPoint(center), base + 500 - t);
+  });
+
+  return EXIT_SUCCESS;
+} catch (const std::runtime_error &e) {
+  PrintException(e);
+  return EXIT_FAILURE;
+}
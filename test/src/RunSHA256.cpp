@@ -22,6 +22,7 @@ Copyright_License {
 */
 
 #include "Crypto/SHA256.hxx"
+#include "Crypto/DigestReader.hxx"
 #include "system/Args.hpp"
 #include "io/FileReader.hxx"
 #include "util/PrintException.hxx"
@@ -29,25 +30,15 @@ Copyright_License {
 #include <stdio.h>
 
 static void
-Feed(Reader &r, SHA256State &state)
+Consume(Reader &r)
 {
   while (true) {
     char buffer[65536];
-    size_t nbytes = r.Read(buffer, sizeof(buffer));
-    if (nbytes == 0)
+    if (r.Read(buffer, sizeof(buffer)) == 0)
       break;
-
-    state.Update({buffer, nbytes});
   }
 }
 
-static void
-Feed(Path path, SHA256State &state)
-{
-  FileReader r(path);
-  Feed(r, state);
-}
-
 static void
 HexPrint(ConstBuffer<void> _b) noexcept
 {
@@ -63,10 +54,11 @@ try {
   const auto path = args.ExpectNextPath();
   args.ExpectEnd();
 
-  SHA256State state;
-  Feed(path, state);
+  FileReader file(path);
+  DigestReader<SHA256State> r(file);
+  Consume(r);
 
-  const auto hash = state.Final();
+  const auto hash = r.Final();
   HexPrint({&hash, sizeof(hash)});
   printf("\n");
 
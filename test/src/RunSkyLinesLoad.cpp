@@ -0,0 +1,914 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Simulate a fleet of gliders flying real tasks (with #TaskAutoPilot
+ * and #AircraftSim) which talk to a SkyLines tracking server such as
+ * xcsoar-cloud-server: they send fixes, pings, traffic requests,
+ * thermal submissions and thermal requests.  Every few seconds, the
+ * response latency percentiles and the packet loss (of pings, which
+ * are the only requests the server must answer) are printed.
+ */
+
+#include "Tracking/SkyLines/Server.hpp"
+#include "Tracking/SkyLines/Protocol.hpp"
+#include "Tracking/SkyLines/Assemble.hpp"
+#include "Replay/TaskAutoPilot.hpp"
+#include "Replay/AircraftSim.hpp"
+#include "Replay/TaskAccessor.hpp"
+#include "Task/TaskFile.hpp"
+#include "Engine/Task/TaskManager.hpp"
+#include "Engine/Task/TaskBehaviour.hpp"
+#include "Engine/Task/Ordered/OrderedTask.hpp"
+#include "Engine/Waypoint/Waypoints.hpp"
+#include "Engine/GlideSolvers/GlidePolar.hpp"
+#include "event/Loop.hxx"
+#include "event/FineTimerEvent.hxx"
+#include "event/SocketEvent.hxx"
+#include "net/Resolver.hxx"
+#include "net/AddressInfo.hxx"
+#include "net/SocketError.hxx"
+#include "net/UniqueSocketDescriptor.hxx"
+#include "system/Args.hpp"
+#include "system/Path.hpp"
+#include "util/ByteOrder.hxx"
+#include "util/CRC.hpp"
+#include "util/NumberParser.hpp"
+#include "util/StringCompare.hxx"
+#include "util/PrintException.hxx"
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+using namespace std::chrono;
+using namespace SkyLinesTracking;
+
+using Clock = steady_clock;
+
+struct LoadSettings {
+  unsigned n_gliders = 1000;
+
+  /**
+   * The number of UDP sockets shared by the gliders.  The server
+   * tells gliders apart by their key, not by their address.
+   */
+  unsigned n_sockets = 16;
+
+  /**
+   * The number of simulated seconds per real second.
+   */
+  unsigned speedup = 1;
+
+  Clock::duration fix_interval = seconds(5);
+  Clock::duration ping_interval = seconds(10);
+  Clock::duration traffic_interval = seconds(60);
+  Clock::duration thermal_interval = seconds(60);
+
+  /**
+   * The gliders are launched one after another during this period.
+   */
+  Clock::duration launch_period = seconds(60);
+
+  Clock::duration duration = minutes(10);
+
+  Clock::duration report_interval = seconds(10);
+};
+
+/**
+ * A ping which has not been answered within this time is considered
+ * lost, and responses to other requests arriving later are not
+ * attributed to the request anymore (the server may legitimately
+ * ignore those).  This is also how long the tool waits for late
+ * responses after the last request was sent.
+ */
+static constexpr Clock::duration REQUEST_TIMEOUT = seconds(3);
+
+/**
+ * The simulation and all requests are processed in this number of
+ * groups, one group per tick.
+ */
+static constexpr unsigned N_GROUPS = 10;
+static constexpr Clock::duration TICK = milliseconds(100);
+
+/**
+ * Flights which take longer than this are restarted (e.g. when the
+ * autopilot never finishes an AAT).
+ */
+static constexpr FloatDuration MAX_FLIGHT_TIME = hours(10);
+
+/**
+ * All keys used by this tool begin with these bits.
+ */
+static constexpr uint64_t KEY_BASE = 0x4c4f414400000000ULL;
+
+static Clock::duration
+RandomFraction(std::minstd_rand &rng, Clock::duration d) noexcept
+{
+  std::uniform_real_distribution<double> fraction;
+  return duration_cast<Clock::duration>(d * fraction(rng));
+}
+
+class LatencyStatistics {
+  std::vector<uint32_t> samples;
+
+public:
+  void Add(Clock::duration d) noexcept {
+    samples.push_back(duration_cast<microseconds>(d).count());
+  }
+
+  void Append(const LatencyStatistics &other) {
+    samples.insert(samples.end(),
+                   other.samples.begin(), other.samples.end());
+  }
+
+  std::size_t size() const noexcept {
+    return samples.size();
+  }
+
+  void clear() noexcept {
+    samples.clear();
+  }
+
+  /**
+   * Print the 50th, 90th and 99th percentile and the maximum in
+   * milliseconds.
+   */
+  void Print(const char *name) {
+    if (samples.empty()) {
+      printf(" %s=-", name);
+      return;
+    }
+
+    const auto percentile = [this](double fraction){
+      auto i = std::next(samples.begin(),
+                         std::min<std::size_t>(samples.size() * fraction,
+                                               samples.size() - 1));
+      std::nth_element(samples.begin(), i, samples.end());
+      return *i / 1000.;
+    };
+
+    const double p50 = percentile(0.5), p90 = percentile(0.9),
+      p99 = percentile(0.99);
+    const double max = *std::max_element(samples.begin(), samples.end())
+      / 1000.;
+
+    printf(" %s=%.1f/%.1f/%.1f/%.1fms", name, p50, p90, p99, max);
+  }
+};
+
+struct LoadStatistics {
+  uint64_t fixes = 0, pings = 0, acks = 0, lost_pings = 0;
+  uint64_t traffic_requests = 0, traffic_responses = 0;
+  uint64_t thermal_submits = 0;
+  uint64_t thermal_requests = 0, thermal_responses = 0;
+  uint64_t send_errors = 0, bad_datagrams = 0;
+
+  LatencyStatistics ping_latency, traffic_latency, thermal_latency;
+
+  void Add(const LoadStatistics &other) {
+    fixes += other.fixes;
+    pings += other.pings;
+    acks += other.acks;
+    lost_pings += other.lost_pings;
+    traffic_requests += other.traffic_requests;
+    traffic_responses += other.traffic_responses;
+    thermal_submits += other.thermal_submits;
+    thermal_requests += other.thermal_requests;
+    thermal_responses += other.thermal_responses;
+    send_errors += other.send_errors;
+    bad_datagrams += other.bad_datagrams;
+    ping_latency.Append(other.ping_latency);
+    traffic_latency.Append(other.traffic_latency);
+    thermal_latency.Append(other.thermal_latency);
+  }
+
+  void Print(const char *prefix, double seconds) {
+    const uint64_t answered_or_lost = acks + lost_pings;
+
+    printf("%s fixes=%.0f/s pings=%llu loss=%.2f%%"
+           " traffic=%llu/%llu thermals=%llu+%llu/%llu errors=%llu",
+           prefix, fixes / seconds,
+           (unsigned long long)pings,
+           answered_or_lost > 0 ? 100. * lost_pings / answered_or_lost : 0.,
+           (unsigned long long)traffic_responses,
+           (unsigned long long)traffic_requests,
+           (unsigned long long)thermal_submits,
+           (unsigned long long)thermal_responses,
+           (unsigned long long)thermal_requests,
+           (unsigned long long)(send_errors + bad_datagrams));
+    ping_latency.Print("ping");
+    traffic_latency.Print("traffic");
+    thermal_latency.Print("thermal");
+    printf("\n");
+  }
+};
+
+class LoadAutoPilot final : public TaskAutoPilot {
+public:
+  using TaskAutoPilot::TaskAutoPilot;
+
+  bool IsClimbing() const noexcept {
+    return acstate == Climb;
+  }
+};
+
+class Connection;
+
+/**
+ * One simulated glider.
+ */
+class Glider {
+  const OrderedTask &task;
+
+  TaskManager task_manager;
+  TaskAccessor accessor{task_manager, 300};
+
+  AutopilotParameters parms;
+  LoadAutoPilot autopilot{parms};
+  AircraftSim aircraft;
+
+  Connection &connection;
+
+  const uint64_t key;
+
+  /**
+   * The wall-clock time of day when the simulation started, to make
+   * the fix time stamps plausible.
+   */
+  const milliseconds time_of_day;
+
+  Clock::time_point next_fix, next_ping, next_traffic, next_thermal;
+
+  /**
+   * When was the pending traffic/thermal request sent?  Only the
+   * first response after a request is considered for the latency.
+   */
+  Clock::time_point traffic_sent, thermal_sent;
+  bool traffic_pending = false, thermal_pending = false;
+
+  struct PendingPing {
+    Clock::time_point sent;
+    uint16_t id;
+    bool pending = false;
+  };
+
+  /**
+   * Pings which were sent recently, indexed by the id modulo the
+   * array size.
+   */
+  std::array<PendingPing, 16> pings;
+
+  uint16_t next_ping_id = 0;
+
+  /**
+   * The bottom of the current climb, if the autopilot is circling.
+   */
+  ::GeoPoint climb_location;
+  double climb_altitude;
+  TimeStamp climb_time;
+  bool climbing = false;
+
+  bool launched = false;
+
+public:
+  Glider(const OrderedTask &_task, const TaskBehaviour &task_behaviour,
+         const Waypoints &waypoints,
+         Connection &_connection, uint64_t _key,
+         milliseconds _time_of_day) noexcept
+    :task(_task), task_manager(task_behaviour, waypoints),
+     connection(_connection), key(_key), time_of_day(_time_of_day) {
+    task_manager.SetGlidePolar(GlidePolar(1));
+  }
+
+  Glider(const Glider &) = delete;
+  Glider &operator=(const Glider &) = delete;
+
+  uint64_t GetKey() const noexcept {
+    return key;
+  }
+
+  void Launch(Clock::time_point now, const LoadSettings &settings,
+              std::minstd_rand &rng) noexcept;
+
+  void Tick(Clock::time_point now, const LoadSettings &settings,
+            LoadStatistics &statistics) noexcept;
+
+  void OnAck(uint16_t id, Clock::time_point now,
+             LoadStatistics &statistics) noexcept;
+
+  void OnTraffic(Clock::time_point now, LoadStatistics &statistics) noexcept {
+    ++statistics.traffic_responses;
+    if (traffic_pending) {
+      traffic_pending = false;
+      statistics.traffic_latency.Add(now - traffic_sent);
+    }
+  }
+
+  void OnThermals(Clock::time_point now,
+                  LoadStatistics &statistics) noexcept {
+    ++statistics.thermal_responses;
+    if (thermal_pending) {
+      thermal_pending = false;
+      statistics.thermal_latency.Add(now - thermal_sent);
+    }
+  }
+
+  /**
+   * Give up waiting for responses to requests sent before the given
+   * time; count unanswered pings as lost.
+   */
+  void ExpireRequests(Clock::time_point before,
+                      LoadStatistics &statistics) noexcept {
+    for (auto &p : pings) {
+      if (p.pending && p.sent < before) {
+        p.pending = false;
+        ++statistics.lost_pings;
+      }
+    }
+
+    if (traffic_sent < before)
+      traffic_pending = false;
+
+    if (thermal_sent < before)
+      thermal_pending = false;
+  }
+
+private:
+  void StartFlight() noexcept;
+  void Step(FloatDuration timestep) noexcept;
+
+  uint32_t GetTimeOfDay() const noexcept {
+    return (time_of_day + duration_cast<milliseconds>(aircraft.GetTime().ToDuration())).count()
+      % (24 * 3600 * 1000);
+  }
+
+  void SendFix(LoadStatistics &statistics) noexcept;
+  void SendPing(Clock::time_point now, LoadStatistics &statistics) noexcept;
+  void SubmitThermal(LoadStatistics &statistics) noexcept;
+};
+
+/**
+ * A UDP socket connected to the server, shared by several gliders.
+ */
+class Connection {
+  SocketEvent socket;
+
+  std::vector<std::unique_ptr<Glider>> &gliders;
+
+  LoadStatistics &statistics;
+
+public:
+  Connection(EventLoop &event_loop, SocketAddress address,
+             std::vector<std::unique_ptr<Glider>> &_gliders,
+             LoadStatistics &_statistics)
+    :socket(event_loop, BIND_THIS_METHOD(OnSocketReady)),
+     gliders(_gliders), statistics(_statistics) {
+    UniqueSocketDescriptor s;
+    if (!s.CreateNonBlock(address.GetFamily(), SOCK_DGRAM, 0))
+      throw MakeSocketError("Failed to create socket");
+
+    if (!s.Connect(address))
+      throw MakeSocketError("Failed to connect socket");
+
+    /* traffic is pushed in bursts; don't let the kernel drop it
+       while the simulation keeps this process busy */
+    const int receive_buffer = 1024 * 1024;
+    s.SetOption(SOL_SOCKET, SO_RCVBUF,
+                &receive_buffer, sizeof(receive_buffer));
+
+    socket.Open(s.Release());
+    socket.ScheduleRead();
+  }
+
+  ~Connection() noexcept {
+    socket.Close();
+  }
+
+  template<typename P>
+  bool Send(const P &packet) noexcept {
+    return socket.GetSocket().Write(&packet, sizeof(packet)) > 0;
+  }
+
+private:
+  void OnDatagramReceived(void *data, std::size_t length,
+                          Clock::time_point now) noexcept;
+  void OnSocketReady(unsigned events) noexcept;
+};
+
+void
+Glider::StartFlight() noexcept
+{
+  task_manager.Reset();
+  task_manager.Commit(task);
+
+  autopilot.SetDefaultLocation(task.GetTaskPoint(0).GetLocation());
+  autopilot.Start(accessor);
+  aircraft.Start(autopilot.location_start, autopilot.location_previous,
+                 parms.start_alt);
+  climbing = false;
+}
+
+void
+Glider::Launch(Clock::time_point now, const LoadSettings &settings,
+               std::minstd_rand &rng) noexcept
+{
+  /* vary the performance, so the fleet spreads out */
+  std::uniform_real_distribution<double> speed_factor(0.8, 1.2);
+  autopilot.SetSpeedFactor(speed_factor(rng));
+  StartFlight();
+
+  /* spread the requests of all gliders evenly */
+  next_fix = now + RandomFraction(rng, settings.fix_interval);
+  next_ping = now + RandomFraction(rng, settings.ping_interval);
+  next_traffic = now + RandomFraction(rng, settings.traffic_interval);
+  next_thermal = now + RandomFraction(rng, settings.thermal_interval);
+
+  launched = true;
+}
+
+inline void
+Glider::Step(FloatDuration timestep) noexcept
+{
+  const AircraftState &state = aircraft.GetState();
+
+  autopilot.UpdateState(accessor, aircraft.GetState(), timestep);
+  aircraft.Update(autopilot.heading, timestep);
+
+  task_manager.Update(state, aircraft.GetLastState());
+  task_manager.UpdateIdle(state);
+
+  if (!autopilot.UpdateAutopilot(accessor, state) ||
+      state.time.ToDuration() > MAX_FLIGHT_TIME)
+    StartFlight();
+}
+
+void
+Glider::SendFix(LoadStatistics &statistics) noexcept
+{
+  const AircraftState &state = aircraft.GetState();
+
+  const auto fix = MakeFix(key,
+                           FixPacket::FLAG_LOCATION |
+                           FixPacket::FLAG_TRACK |
+                           FixPacket::FLAG_GROUND_SPEED |
+                           FixPacket::FLAG_AIRSPEED |
+                           FixPacket::FLAG_ALTITUDE |
+                           FixPacket::FLAG_VARIO,
+                           GetTimeOfDay(),
+                           state.location, state.track,
+                           state.ground_speed, state.true_airspeed,
+                           (int)state.altitude, state.vario, 0);
+  if (connection.Send(fix))
+    ++statistics.fixes;
+  else
+    ++statistics.send_errors;
+}
+
+void
+Glider::SendPing(Clock::time_point now, LoadStatistics &statistics) noexcept
+{
+  const uint16_t id = next_ping_id++;
+  if (!connection.Send(MakePing(key, id))) {
+    ++statistics.send_errors;
+    return;
+  }
+
+  ++statistics.pings;
+
+  auto &p = pings[id % pings.size()];
+  p.sent = now;
+  p.id = id;
+  p.pending = true;
+}
+
+void
+Glider::SubmitThermal(LoadStatistics &statistics) noexcept
+{
+  const AircraftState &state = aircraft.GetState();
+  const double duration = (state.time - climb_time).count();
+  if (duration <= 0 || state.altitude <= climb_altitude)
+    return;
+
+  const auto packet = MakeThermalSubmit(key, GetTimeOfDay(),
+                                        climb_location, (int)climb_altitude,
+                                        state.location, (int)state.altitude,
+                                        (state.altitude - climb_altitude)
+                                        / duration);
+  if (connection.Send(packet))
+    ++statistics.thermal_submits;
+  else
+    ++statistics.send_errors;
+}
+
+void
+Glider::Tick(Clock::time_point now, const LoadSettings &settings,
+             LoadStatistics &statistics) noexcept
+{
+  if (!launched)
+    return;
+
+  /* advance the simulation by the time which has passed since this
+     glider's previous tick, in steps of one second */
+  for (unsigned i = 0; i < settings.speedup; ++i) {
+    Step(seconds(1));
+
+    const AircraftState &state = aircraft.GetState();
+    if (autopilot.IsClimbing() && !climbing) {
+      climbing = true;
+      climb_location = state.location;
+      climb_altitude = state.altitude;
+      climb_time = state.time;
+    } else if (!autopilot.IsClimbing() && climbing) {
+      climbing = false;
+      SubmitThermal(statistics);
+    }
+  }
+
+  ExpireRequests(now - REQUEST_TIMEOUT, statistics);
+
+  if (now >= next_fix) {
+    next_fix += settings.fix_interval;
+    SendFix(statistics);
+  }
+
+  if (now >= next_ping) {
+    next_ping += settings.ping_interval;
+    SendPing(now, statistics);
+  }
+
+  if (now >= next_traffic) {
+    next_traffic += settings.traffic_interval;
+    if (connection.Send(MakeTrafficRequest(key, false, false, true, true))) {
+      ++statistics.traffic_requests;
+      traffic_sent = now;
+      traffic_pending = true;
+    } else
+      ++statistics.send_errors;
+  }
+
+  if (now >= next_thermal) {
+    next_thermal += settings.thermal_interval;
+    if (connection.Send(MakeThermalRequest(key))) {
+      ++statistics.thermal_requests;
+      thermal_sent = now;
+      thermal_pending = true;
+    } else
+      ++statistics.send_errors;
+  }
+}
+
+void
+Glider::OnAck(uint16_t id, Clock::time_point now,
+              LoadStatistics &statistics) noexcept
+{
+  auto &p = pings[id % pings.size()];
+  if (!p.pending || p.id != id)
+    /* unknown or duplicate */
+    return;
+
+  p.pending = false;
+  ++statistics.acks;
+  statistics.ping_latency.Add(now - p.sent);
+}
+
+inline void
+Connection::OnDatagramReceived(void *data, std::size_t length,
+                               Clock::time_point now) noexcept
+{
+  auto &header = *(Header *)data;
+  if (length < sizeof(header) || FromBE32(header.magic) != MAGIC) {
+    ++statistics.bad_datagrams;
+    return;
+  }
+
+  const uint16_t received_crc = FromBE16(header.crc);
+  header.crc = 0;
+  if (received_crc != UpdateCRC16CCITT(data, length, 0)) {
+    ++statistics.bad_datagrams;
+    return;
+  }
+
+  const uint64_t index = FromBE64(header.key) - KEY_BASE;
+  if (index >= gliders.size()) {
+    ++statistics.bad_datagrams;
+    return;
+  }
+
+  Glider &glider = *gliders[index];
+
+  switch ((Type)FromBE16(header.type)) {
+  case ACK:
+    if (length >= sizeof(ACKPacket))
+      glider.OnAck(FromBE16(((const ACKPacket *)data)->id), now, statistics);
+    break;
+
+  case TRAFFIC_RESPONSE:
+  case TRAFFIC_DELTA_RESPONSE:
+    glider.OnTraffic(now, statistics);
+    break;
+
+  case THERMAL_RESPONSE:
+    glider.OnThermals(now, statistics);
+    break;
+
+  default:
+    break;
+  }
+}
+
+void
+Connection::OnSocketReady(unsigned) noexcept
+{
+  const auto now = Clock::now();
+
+  while (true) {
+    alignas(uint64_t) char buffer[4096];
+    ssize_t nbytes = socket.GetSocket().Read(buffer, sizeof(buffer));
+    if (nbytes < 0) {
+      if (!IsSocketErrorReceiveWouldBlock(GetSocketError()))
+        /* e.g. ECONNREFUSED from a previous datagram */
+        ++statistics.send_errors;
+      break;
+    }
+
+    OnDatagramReceived(buffer, nbytes, now);
+  }
+}
+
+class Fleet {
+  EventLoop &event_loop;
+
+  const LoadSettings &settings;
+
+  std::vector<std::unique_ptr<Connection>> connections;
+  std::vector<std::unique_ptr<Glider>> gliders;
+
+  /**
+   * The statistics of the current report interval.
+   */
+  LoadStatistics statistics;
+
+  /**
+   * The statistics of all finished report intervals.
+   */
+  LoadStatistics total;
+
+  FineTimerEvent tick_timer{event_loop, BIND_THIS_METHOD(OnTick)};
+  FineTimerEvent report_timer{event_loop, BIND_THIS_METHOD(OnReport)};
+  FineTimerEvent stop_timer{event_loop, BIND_THIS_METHOD(OnStop)};
+
+  Clock::time_point start_time, report_time;
+
+  unsigned n_launched = 0;
+  unsigned tick = 0;
+
+  /**
+   * Fixed seed, so all runs simulate the same fleet.
+   */
+  std::minstd_rand rng{42};
+
+  bool stopping = false;
+
+public:
+  Fleet(EventLoop &_event_loop, const LoadSettings &_settings,
+        SocketAddress address, const std::vector<OrderedTask *> &tasks,
+        const TaskBehaviour &task_behaviour, const Waypoints &waypoints)
+    :event_loop(_event_loop), settings(_settings) {
+    for (unsigned i = 0; i < settings.n_sockets; ++i)
+      connections.emplace_back(std::make_unique<Connection>(event_loop,
+                                                            address,
+                                                            gliders,
+                                                            statistics));
+
+    const time_t t = time(nullptr);
+    const milliseconds time_of_day = seconds(t % (24 * 3600));
+
+    gliders.reserve(settings.n_gliders);
+    for (unsigned i = 0; i < settings.n_gliders; ++i)
+      gliders.emplace_back(std::make_unique<Glider>(*tasks[i % tasks.size()],
+                                                    task_behaviour, waypoints,
+                                                    *connections[i % connections.size()],
+                                                    KEY_BASE + i,
+                                                    time_of_day));
+  }
+
+  void Start() noexcept {
+    start_time = report_time = Clock::now();
+    tick_timer.Schedule(Clock::duration::zero());
+    report_timer.Schedule(settings.report_interval);
+    stop_timer.Schedule(settings.duration);
+  }
+
+  void PrintSummary() noexcept;
+
+private:
+  void OnTick() noexcept;
+  void OnReport() noexcept;
+  void OnStop() noexcept;
+};
+
+void
+Fleet::OnTick() noexcept
+{
+  const auto now = Clock::now();
+
+  /* launch the gliders which are due by now */
+  const unsigned n_due = settings.launch_period > Clock::duration::zero()
+    ? std::min<uint64_t>(uint64_t((now - start_time) * gliders.size()
+                                  / settings.launch_period) + 1,
+                         gliders.size())
+    : gliders.size();
+  for (; n_launched < n_due; ++n_launched)
+    gliders[n_launched]->Launch(now, settings, rng);
+
+  const unsigned group = tick++ % N_GROUPS;
+  for (unsigned i = group; i < gliders.size(); i += N_GROUPS)
+    gliders[i]->Tick(now, settings, statistics);
+
+  tick_timer.Schedule(TICK);
+}
+
+void
+Fleet::OnReport() noexcept
+{
+  const auto now = Clock::now();
+  const double elapsed = duration<double>(now - report_time).count();
+
+  char prefix[32];
+  snprintf(prefix, sizeof(prefix), "%5.0fs gliders=%u",
+           duration<double>(now - start_time).count(), n_launched);
+  statistics.Print(prefix, elapsed);
+  fflush(stdout);
+
+  total.Add(statistics);
+  statistics = {};
+  report_time = now;
+
+  if (!stopping)
+    report_timer.Schedule(settings.report_interval);
+}
+
+void
+Fleet::OnStop() noexcept
+{
+  if (!stopping) {
+    /* stop sending, and wait for late responses */
+    stopping = true;
+    tick_timer.Cancel();
+    report_timer.Cancel();
+    stop_timer.Schedule(REQUEST_TIMEOUT);
+    return;
+  }
+
+  event_loop.Break();
+}
+
+void
+Fleet::PrintSummary() noexcept
+{
+  /* all requests which are still pending have timed out */
+  const auto now = Clock::now();
+  for (auto &glider : gliders)
+    glider->ExpireRequests(now, statistics);
+
+  total.Add(statistics);
+
+  const double elapsed =
+    duration<double>(now - start_time - REQUEST_TIMEOUT).count();
+  total.Print("total", elapsed);
+}
+
+static bool
+ParseOption(const char *arg, LoadSettings &settings)
+{
+  const auto parse_seconds = [](const char *value, Clock::duration &d){
+    char *endptr;
+    double s = ParseDouble(value, &endptr);
+    if (endptr == value || *endptr != 0 || s < 0)
+      return false;
+
+    d = duration_cast<Clock::duration>(duration<double>(s));
+    return true;
+  };
+
+  const auto parse_unsigned = [](const char *value, unsigned &n){
+    char *endptr;
+    n = ParseUnsigned(value, &endptr);
+    return endptr != value && *endptr == 0 && n > 0;
+  };
+
+  if (const char *v = StringAfterPrefix(arg, "--gliders="))
+    return parse_unsigned(v, settings.n_gliders);
+  else if (const char *v = StringAfterPrefix(arg, "--sockets="))
+    return parse_unsigned(v, settings.n_sockets);
+  else if (const char *v = StringAfterPrefix(arg, "--speedup="))
+    return parse_unsigned(v, settings.speedup);
+  else if (const char *v = StringAfterPrefix(arg, "--fix-interval="))
+    return parse_seconds(v, settings.fix_interval);
+  else if (const char *v = StringAfterPrefix(arg, "--ping-interval="))
+    return parse_seconds(v, settings.ping_interval);
+  else if (const char *v = StringAfterPrefix(arg, "--traffic-interval="))
+    return parse_seconds(v, settings.traffic_interval);
+  else if (const char *v = StringAfterPrefix(arg, "--thermal-interval="))
+    return parse_seconds(v, settings.thermal_interval);
+  else if (const char *v = StringAfterPrefix(arg, "--launch-period="))
+    return parse_seconds(v, settings.launch_period);
+  else if (const char *v = StringAfterPrefix(arg, "--duration="))
+    return parse_seconds(v, settings.duration);
+  else if (const char *v = StringAfterPrefix(arg, "--report-interval="))
+    return parse_seconds(v, settings.report_interval);
+  else
+    return false;
+}
+
+static constexpr const char *usage =
+  "[OPTIONS] HOST[:PORT] TASKFILE...\n\n"
+  "Options (intervals in seconds):\n"
+  "  --gliders=N (1000)  --sockets=N (16)  --speedup=N (1)\n"
+  "  --fix-interval=S (5)  --ping-interval=S (10)\n"
+  "  --traffic-interval=S (60)  --thermal-interval=S (60)\n"
+  "  --launch-period=S (60)  --duration=S (600)  --report-interval=S (10)";
+
+int
+main(int argc, char **argv)
+try {
+  Args args(argc, argv, usage);
+
+  LoadSettings settings;
+  while (!args.IsEmpty() && StringStartsWith(args.PeekNext(), "--")) {
+    const char *arg = args.GetNext();
+    if (!ParseOption(arg, settings)) {
+      fprintf(stderr, "Bad option: %s\n", arg);
+      args.UsageError();
+    }
+  }
+
+  const char *host = args.ExpectNext();
+
+  TaskBehaviour task_behaviour;
+  task_behaviour.SetDefaults();
+
+  /* the waypoints of the task files are not needed */
+  const Waypoints waypoints;
+
+  std::vector<std::unique_ptr<OrderedTask>> tasks;
+  do {
+    const auto path = args.ExpectNextPath();
+    auto task = TaskFile::GetTask(path, task_behaviour, nullptr, 0);
+    if (task == nullptr || task->TaskSize() == 0) {
+      fprintf(stderr, "Failed to load task %s\n", path.c_str());
+      return EXIT_FAILURE;
+    }
+
+    task->UpdateGeometry();
+    tasks.emplace_back(std::move(task));
+  } while (!args.IsEmpty());
+
+  std::vector<OrderedTask *> task_pointers;
+  for (const auto &i : tasks)
+    task_pointers.push_back(i.get());
+
+  const auto address_list = Resolve(host, Server::GetDefaultPort(),
+                                    0, SOCK_DGRAM);
+
+  EventLoop event_loop;
+
+  Fleet fleet(event_loop, settings, address_list.GetBest(), task_pointers,
+              task_behaviour, waypoints);
+  fleet.Start();
+
+  event_loop.Run();
+
+  fleet.PrintSummary();
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
@@ -21,10 +21,63 @@ Copyright_License {
 }
 */
 
+/*
+ * Replay a flight into #Trace objects configured like the ones in
+ * #TraceComputer, and measure the append throughput and the memory
+ * used by each of them.  The checksum of the retained points allows
+ * comparing the results of different build options.
+ */
+
 #include "system/Args.hpp"
 #include "DebugReplay.hpp"
+#include "AllocationCounter.hpp"
 #include "Engine/Trace/Trace.hpp"
 
+#include <chrono>
+#include <vector>
+
+#include <stdio.h>
+
+using namespace std::chrono;
+
+static constexpr unsigned ITERATIONS = 10;
+
+static void
+Run(const char *name, const std::vector<TracePoint> &points,
+    TracePoint::Time no_thin_time, TracePoint::Time max_time,
+    unsigned max_size)
+{
+  duration<double, std::nano> total{};
+  std::size_t memory = 0, peak = 0;
+  unsigned size = 0, checksum = 0;
+
+  for (unsigned i = 0; i < ITERATIONS; ++i) {
+    const std::size_t base = AllocationCounter::GetLiveBytes();
+    AllocationCounter::ResetPeak();
+
+    Trace trace(no_thin_time, max_time, max_size);
+
+    const auto start = steady_clock::now();
+    for (const auto &point : points)
+      trace.push_back(point);
+    total += steady_clock::now() - start;
+
+    memory = AllocationCounter::GetLiveBytes() - base;
+    peak = AllocationCounter::GetPeakBytes() - base;
+    size = trace.size();
+
+    checksum = 0;
+    for (const auto &point : trace)
+      checksum = checksum * 31 + point.GetTime().count();
+  }
+
+  printf("%-8s max_size %5u  retained %5u  %6.1f ns/point  "
+         "memory %7zu bytes (peak %7zu)  checksum %08x\n",
+         name, max_size, size,
+         total.count() / ITERATIONS / points.size(),
+         memory, peak, checksum);
+}
+
 int main(int argc, char **argv)
 {
   Args args(argc, argv, "DRIVER FILE");
@@ -34,14 +87,28 @@ int main(int argc, char **argv)
 
   args.ExpectEnd();
 
-  Trace trace;
+  std::vector<TracePoint> points;
 
   while (replay->Next()) {
     const MoreData &basic = replay->Basic();
     if (basic.time_available && basic.location_available &&
         basic.NavAltitudeAvailable())
-      trace.push_back(TracePoint(basic));
+      points.emplace_back(basic);
   }
 
   delete replay;
+
+  if (points.empty())
+    return EXIT_FAILURE;
+
+  printf("%zu points\n", points.size());
+
+  /* the same settings as TraceComputer */
+  Run("full", points, minutes{2}, Trace::null_time, 1024);
+  Run("contest", points, {}, Trace::null_time, 256);
+  Run("sprint", points, {}, minutes{150}, 128);
+
+  Run("large", points, minutes{2}, Trace::null_time, 16384);
+
+  return EXIT_SUCCESS;
 }
@@ -21,24 +21,78 @@ Copyright_License {
 }
 */
 
+/*
+ * Parse a waypoint file, measure the time needed for parsing and for
+ * building the indexes, and print all waypoints.  If a cache
+ * directory is given, the waypoints are also saved to and loaded from
+ * a waypoint cache.
+ */
+
 #include "Waypoint/WaypointReader.hpp"
+#include "Waypoint/WaypointCache.hpp"
 #include "Waypoint/Factory.hpp"
 #include "Waypoint/Waypoints.hpp"
 #include "system/Args.hpp"
+#include "io/FileCache.hpp"
 #include "Operation/ConsoleOperationEnvironment.hpp"
+#include "util/PrintException.hxx"
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <vector>
 
 #include <stdio.h>
 #include <tchar.h>
 
-int main(int argc, char **argv)
+using namespace std::chrono;
+
+static double
+ElapsedMilliseconds(steady_clock::time_point start) noexcept
 {
-  Args args(argc, argv, "PATH\n");
+  return duration<double, std::milli>(steady_clock::now() - start).count();
+}
+
+static void
+RunCache(const Waypoints &way_points, Path path, Path cache_path)
+{
+  FileCache cache{AllocatedPath(cache_path)};
+
+  std::vector<WaypointPtr> list(way_points.begin(), way_points.end());
+  std::sort(list.begin(), list.end(), [](const auto &a, const auto &b){
+    return a->id < b->id;
+  });
+
+  auto start = steady_clock::now();
+  SaveWaypointCache(list, cache, _T("waypoint"), path);
+  printf("save cache: %.2f ms\n", ElapsedMilliseconds(start));
+
+  Waypoints loaded;
+  start = steady_clock::now();
+  if (!LoadWaypointCache(loaded, cache, _T("waypoint"), path))
+    throw std::runtime_error("Failed to load the waypoint cache");
+
+  printf("load cache: %.2f ms\n", ElapsedMilliseconds(start));
+
+  start = steady_clock::now();
+  loaded.Optimise();
+  printf("optimise: %u waypoints, %.2f ms\n",
+         loaded.size(), ElapsedMilliseconds(start));
+}
+
+int main(int argc, char **argv)
+try {
+  Args args(argc, argv, "PATH [CACHEDIR]");
   const auto path = args.ExpectNextPath();
+  AllocatedPath cache_path = nullptr;
+  if (!args.IsEmpty())
+    cache_path = args.ExpectNextPath();
   args.ExpectEnd();
 
   Waypoints way_points;
 
   ConsoleOperationEnvironment operation;
+  auto start = steady_clock::now();
   if (!ReadWaypointFile(path, way_points,
                         WaypointFactory(WaypointOrigin::NONE),
                         operation)) {
@@ -46,9 +100,16 @@ int main(int argc, char **argv)
     return EXIT_FAILURE;
   }
 
+  printf("parse: %.2f ms\n", ElapsedMilliseconds(start));
+
+  start = steady_clock::now();
   way_points.Optimise();
+  printf("optimise: %.2f ms\n", ElapsedMilliseconds(start));
   printf("Size %d\n", way_points.size());
 
+  if (cache_path != nullptr)
+    RunCache(way_points, path, cache_path);
+
   way_points.VisitNamePrefix(_T(""), [](const auto &p){
     const auto &wp = *p;
     _ftprintf(stdout, _T("%s, %f, %f, %.0fm\n"), wp.name.c_str(),
@@ -58,4 +119,7 @@ int main(int argc, char **argv)
   });
 
   return EXIT_SUCCESS;
+} catch (const std::runtime_error &e) {
+  PrintException(e);
+  return EXIT_FAILURE;
 }
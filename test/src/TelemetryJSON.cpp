@@ -0,0 +1,100 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "TelemetryJSON.hpp"
+#include "NMEA/MoreData.hpp"
+#include "NMEA/Derived.hpp"
+#include "Formatter/TimeFormatter.hpp"
+#include "json/Writer.hxx"
+
+static void
+WriteGeoPoint(BufferedOutputStream &os, const GeoPoint &location)
+{
+  Json::ObjectWriter object(os);
+  object.Add("longitude", location.longitude.Degrees());
+  object.Add("latitude", location.latitude.Degrees());
+  object.End();
+}
+
+static void
+WriteSpeedVector(BufferedOutputStream &os, const SpeedVector &vector)
+{
+  Json::ObjectWriter object(os);
+  object.Add("bearing", vector.bearing.Degrees());
+  object.Add("speed", vector.norm);
+  object.End();
+}
+
+void
+WriteTelemetryJSON(BufferedOutputStream &os,
+                   const MoreData &basic, const DerivedInfo &calculated)
+{
+  Json::ObjectWriter object(os);
+
+  if (basic.time_available) {
+    object.Add("time", basic.time.ToDuration().count());
+
+    if (basic.date_time_utc.IsDatePlausible()) {
+      char buffer[32];
+      FormatISO8601(buffer, basic.date_time_utc);
+      object.Add("date_time", buffer);
+    }
+  }
+
+  if (basic.location_available)
+    WriteGeoPoint(object.Key("location"), basic.location);
+
+  if (basic.gps_altitude_available)
+    object.Add("gps_altitude", basic.gps_altitude);
+
+  if (basic.baro_altitude_available)
+    object.Add("baro_altitude", basic.baro_altitude);
+
+  if (basic.track_available)
+    object.Add("track", basic.track.Degrees());
+
+  if (basic.ground_speed_available)
+    object.Add("ground_speed", basic.ground_speed);
+
+  if (basic.airspeed_available) {
+    object.Add("indicated_airspeed", basic.indicated_airspeed);
+    object.Add("true_airspeed", basic.true_airspeed);
+  }
+
+  if (basic.brutto_vario_available)
+    object.Add("vario", basic.brutto_vario);
+
+  if (basic.netto_vario_available)
+    object.Add("netto_vario", basic.netto_vario);
+
+  if (calculated.altitude_agl_valid)
+    object.Add("altitude_agl", calculated.altitude_agl);
+
+  if (calculated.wind_available)
+    WriteSpeedVector(object.Key("wind"), calculated.wind);
+
+  object.Add("flying", calculated.flight.flying);
+  object.Add("circling", calculated.circling);
+
+  object.End();
+}
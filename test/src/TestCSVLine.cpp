@@ -23,6 +23,7 @@
 #include "io/CSVLine.hpp"
 #include "TestUtil.hpp"
 
+#include <cstdlib>
 #include <cstring>
 #include <string>
 
@@ -97,13 +98,58 @@ Test2()
   ok1(!line.ReadChecked(temp_int) && temp_int == 42);
 }
 
+static void
+Test3()
+{
+  /* a line which ends before the null terminator */
+  const char *data = "1,2,3*4";
+  CSVLine line(data, data + 5);
+
+  ok1(line.Read(-1) == 1);
+  ok1(line.Skip() == 1);
+  ok1(line.Read(-1) == 3);
+  ok1(line.IsEmpty());
+  ok1(line.Skip() == 0);
+}
+
+static void
+TestDecimal()
+{
+  CSVLine line("-12.5,+3,.25,7.,1e3,0x10,-,1234567890123456.5,1x,,0.1");
+
+  double value;
+  ok1(line.ReadChecked(value) && value == -12.5);
+  ok1(line.ReadChecked(value) && value == 3);
+  ok1(line.ReadChecked(value) && value == 0.25);
+  ok1(line.ReadChecked(value) && value == 7);
+
+  /* these are handled by strtod() */
+  ok1(line.ReadChecked(value) && value == 1000);
+  ok1(line.ReadChecked(value) && value == 16);
+  ok1(!line.ReadChecked(value));
+  ok1(line.ReadChecked(value) && value == 1234567890123456.5);
+
+  /* garbage after the number */
+  value = 42;
+  ok1(!line.ReadChecked(value) && value == 42);
+
+  /* empty column */
+  ok1(!line.ReadChecked(value) && value == 42);
+
+  /* same result as strtod() */
+  ok1(line.ReadChecked(value) && value == strtod("0.1", nullptr));
+  ok1(line.IsEmpty());
+}
+
 int
 main(int argc, char **argv)
 {
-  plan_tests(19);
+  plan_tests(36);
 
   Test1();
   Test2();
+  Test3();
+  TestDecimal();
 
   return exit_status();
 }
@@ -0,0 +1,78 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Replay/CatmullRomInterpolator.hpp"
+#include "TestUtil.hpp"
+
+static void
+Feed(CatmullRomInterpolator &cri)
+{
+  const GeoPoint start(Angle::Degrees(7.7), Angle::Degrees(51.05));
+
+  for (unsigned i = 0; i < 4; ++i)
+    cri.Update(TimeStamp{FloatDuration(10 + i)},
+               GeoPoint(start.longitude + Angle::Degrees(0.001 * i * i),
+                        start.latitude + Angle::Degrees(0.002 * i)),
+               500 + 3 * i, 480 + 2 * i * i);
+}
+
+static bool
+Equals(const CatmullRomInterpolator::Record &a,
+       const CatmullRomInterpolator::Record &b)
+{
+  return equals(a.location.longitude, b.location.longitude.Degrees()) &&
+    equals(a.location.latitude, b.location.latitude.Degrees()) &&
+    equals(a.gps_altitude, b.gps_altitude) &&
+    equals(a.baro_altitude, b.baro_altitude) &&
+    a.time == b.time;
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(5);
+
+  CatmullRomInterpolator cri(FloatDuration{0.5});
+  ok1(!cri.Ready());
+  Feed(cri);
+  ok1(cri.Ready());
+
+  /* 10 Hz output over the middle segment */
+  constexpr unsigned N = 10;
+  CatmullRomInterpolator::Record records[N];
+  cri.InterpolateSegment(TimeStamp{FloatDuration(11)}, FloatDuration(0.1),
+                         records, N);
+
+  bool all_equal = true;
+  for (unsigned i = 0; i < N; ++i)
+    all_equal &= Equals(records[i],
+                        cri.Interpolate(TimeStamp{FloatDuration(11 + 0.1 * i)}));
+  ok1(all_equal);
+
+  /* the segment starts and ends at the control points */
+  ok1(equals(records[0].gps_altitude, 503));
+  cri.InterpolateSegment(TimeStamp{FloatDuration(12)}, FloatDuration(0.1),
+                         records, 1);
+  ok1(equals(records[0].baro_altitude, 488));
+
+  return exit_status();
+}
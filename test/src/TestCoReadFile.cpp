@@ -0,0 +1,118 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "io/async/CoReadFile.hpp"
+#include "io/FileReader.hxx"
+#include "event/Loop.hxx"
+#include "co/InvokeTask.hxx"
+#include "system/Path.hpp"
+#include "util/BindMethod.hxx"
+#include "TestUtil.hpp"
+
+#include <cstring>
+
+#include <tchar.h>
+
+static constexpr auto PATH = _T("test/data/flarmnet/data.fln");
+
+class AsyncReader {
+  EventLoop event_loop;
+
+  Co::InvokeTask task;
+
+  std::exception_ptr error;
+
+public:
+  AllocatedArray<std::byte> data;
+
+  bool Read(Path path, std::size_t max_size) {
+    task = Run(path, max_size);
+    task.Start(BIND_THIS_METHOD(OnCompletion));
+    event_loop.Run();
+    return !error;
+  }
+
+  /**
+   * Start reading, and destroy the coroutine right away.
+   */
+  void Cancel(Path path) {
+    task = Run(path, 1024 * 1024);
+    task.Start(BIND_THIS_METHOD(OnCompletion));
+    task = {};
+  }
+
+private:
+  Co::InvokeTask Run(Path path, std::size_t max_size) {
+    data = co_await CoReadFile(event_loop, AllocatedPath{path}, max_size);
+  }
+
+  void OnCompletion(std::exception_ptr _error) noexcept {
+    error = std::move(_error);
+    event_loop.Break();
+  }
+};
+
+static AllocatedArray<std::byte>
+ReadFileSync(Path path)
+{
+  FileReader file(path);
+  AllocatedArray<std::byte> data(file.GetSize());
+  std::size_t position = 0;
+  while (position < data.size())
+    position += file.Read(data.data() + position, data.size() - position);
+  return data;
+}
+
+int main()
+{
+  plan_tests(5);
+
+  const auto expected = ReadFileSync(Path(PATH));
+
+  {
+    AsyncReader reader;
+    ok1(reader.Read(Path(PATH), 1024 * 1024));
+    ok1(reader.data.size() == expected.size() &&
+        memcmp(reader.data.data(), expected.data(), expected.size()) == 0);
+  }
+
+  {
+    /* the file exceeds the size limit */
+    AsyncReader reader;
+    ok1(!reader.Read(Path(PATH), expected.size() - 1));
+  }
+
+  {
+    AsyncReader reader;
+    ok1(!reader.Read(Path(_T("test/data/does_not_exist")), 1024));
+  }
+
+  {
+    /* must not crash or leak the helper thread */
+    AsyncReader reader;
+    reader.Cancel(Path(PATH));
+    ok1(reader.data.size() == 0);
+  }
+
+  return exit_status();
+}
@@ -0,0 +1,115 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Engine/Task/ObservationZones/CompiledZone.hpp"
+#include "Engine/Task/ObservationZones/ObservationZoneClient.hpp"
+#include "Engine/Task/ObservationZones/CylinderZone.hpp"
+#include "Engine/Task/ObservationZones/SectorZone.hpp"
+#include "Engine/Task/ObservationZones/SymmetricSectorZone.hpp"
+#include "Engine/Task/ObservationZones/KeyholeZone.hpp"
+#include "Engine/Task/ObservationZones/LineSectorZone.hpp"
+#include "Engine/Task/ObservationZones/AnnularSectorZone.hpp"
+#include "TestUtil.hpp"
+
+static const GeoPoint center(Angle::Degrees(7), Angle::Degrees(51));
+static const GeoPoint previous(Angle::Degrees(6.5), Angle::Degrees(50.8));
+static const GeoPoint next(Angle::Degrees(7.4), Angle::Degrees(51.3));
+
+/**
+ * Compare the compiled zone with the virtual methods on a grid of
+ * locations around the zone.
+ */
+static bool
+Compare(ObservationZonePoint &oz)
+{
+  oz.SetLegs(&previous, &next);
+
+  CompiledObservationZone compiled;
+  compiled.Compile(oz);
+
+  const GeoPoint last(Angle::Degrees(7.01), Angle::Degrees(51.02));
+
+  for (int y = -40; y <= 40; ++y) {
+    for (int x = -40; x <= 40; ++x) {
+      const GeoPoint location(center.longitude + Angle::Degrees(x * 0.005),
+                              center.latitude + Angle::Degrees(y * 0.003));
+
+      if (compiled.IsInSector(location) != oz.IsInSector(location) ||
+          compiled.TransitionConstraint(location, last) !=
+          oz.TransitionConstraint(location, last))
+        return false;
+    }
+  }
+
+  return true;
+}
+
+static void
+TestClient()
+{
+  ObservationZoneClient client(std::make_unique<CylinderZone>(center, 1000));
+
+  const GeoPoint inside(center.longitude, center.latitude + Angle::Degrees(0.012));
+  ok1(!client.IsInSector(inside));
+
+  /* modifying the zone must invalidate the compiled copy */
+  ((CylinderZone &)client.GetObservationZone()).SetRadius(2000);
+  ok1(client.IsInSector(inside));
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(14);
+
+  CylinderZone cylinder(center, 5000);
+  ok1(Compare(cylinder));
+  ok1(Compare(*CylinderZone::CreateMatCylinderZone(center)));
+
+  SectorZone sector(center, 8000, Angle::Degrees(30), Angle::Degrees(120));
+  ok1(Compare(sector));
+
+  SectorZone wrapping_sector(center, 8000, Angle::Degrees(300),
+                             Angle::Degrees(40));
+  ok1(Compare(wrapping_sector));
+
+  SymmetricSectorZone symmetric(center, 6000);
+  ok1(Compare(symmetric));
+  ok1(Compare(*SymmetricSectorZone::CreateFAISectorZone(center)));
+  ok1(Compare(*SymmetricSectorZone::CreateBGAStartSectorZone(center)));
+
+  ok1(Compare(*KeyholeZone::CreateDAeCKeyholeZone(center)));
+  ok1(Compare(*KeyholeZone::CreateBGAEnhancedOptionZone(center)));
+  ok1(Compare(*KeyholeZone::CreateCustomKeyholeZone(center, 7000,
+                                                    Angle::Degrees(60))));
+
+  LineSectorZone line(center, 6000);
+  ok1(Compare(line));
+
+  AnnularSectorZone annular(center, 9000, Angle::Degrees(200),
+                            Angle::Degrees(350), 3000);
+  ok1(Compare(annular));
+
+  TestClient();
+
+  return exit_status();
+}
@@ -0,0 +1,166 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Terrain/ContourLines.hpp"
+#include "Terrain/Height.hpp"
+#include "Terrain/RasterTraits.hpp"
+#include "TestUtil.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+static constexpr unsigned SIZE = 41;
+static constexpr unsigned CENTER = SIZE / 2;
+
+/**
+ * A cone: 1000 m at the center, sloping down 40 m per pixel to a
+ * plain at 1 m.
+ */
+static void
+FillCone(TerrainHeight *heights)
+{
+  for (unsigned y = 0; y < SIZE; ++y) {
+    for (unsigned x = 0; x < SIZE; ++x) {
+      const double d = std::hypot(double(x) - CENTER, double(y) - CENTER);
+      heights[y * SIZE + x] = TerrainHeight(std::max(int(1000 - 40 * d), 1));
+    }
+  }
+}
+
+static bool
+IsClosed(ConstBuffer<RasterLocation> line)
+{
+  return line.size > 3 && line.front() == line.back();
+}
+
+/**
+ * Check that all points of the line are at the given distance from
+ * the cone's center (with one pixel tolerance).
+ */
+static bool
+IsCircle(ConstBuffer<RasterLocation> line, double radius)
+{
+  for (const auto &p : line) {
+    const double x = double(p.x) / (1 << RasterTraits::SUBPIXEL_BITS);
+    const double y = double(p.y) / (1 << RasterTraits::SUBPIXEL_BITS);
+    const double d = std::hypot(x - CENTER, y - CENTER);
+    if (std::fabs(d - radius) > 1)
+      return false;
+  }
+
+  return true;
+}
+
+static void
+TestCone()
+{
+  TerrainHeight heights[SIZE * SIZE];
+  FillCone(heights);
+
+  ContourLines lines;
+  lines.Generate(heights, SIZE, SIZE, {0, 0}, 256);
+  ok1(lines.GetInterval() == 256);
+
+  /* one closed ring each at 256, 512 and 768 m */
+  ok1(lines.GetLineCount() == 3);
+
+  unsigned closed = 0, circles = 0;
+  lines.ForEach([&](ConstBuffer<RasterLocation> line){
+    if (IsClosed(line))
+      ++closed;
+
+    for (unsigned level = 1; level <= 3; ++level)
+      if (IsCircle(line, (1000 - 256. * level) / 40)) {
+        ++circles;
+        break;
+      }
+  });
+
+  ok1(closed == 3);
+  ok1(circles == 3);
+
+  /* the same lines, moved by the origin */
+  ContourLines moved;
+  moved.Generate(heights, SIZE, SIZE, {100, 200}, 256);
+  ok1(moved.GetPointCount() == lines.GetPointCount());
+
+  ContourLines all;
+  all.Append(lines);
+  all.Append(moved);
+  ok1(all.GetLineCount() == 6);
+  ok1(all.GetPointCount() == 2 * lines.GetPointCount());
+}
+
+static void
+TestSpecial()
+{
+  TerrainHeight heights[SIZE * SIZE];
+  FillCone(heights);
+
+  /* a hole in the outermost ring opens it */
+  heights[CENTER * SIZE + CENTER + 19] = TerrainHeight::Invalid();
+
+  ContourLines lines;
+  lines.Generate(heights, SIZE, SIZE, {0, 0}, 256);
+  ok1(lines.GetLineCount() == 3);
+
+  unsigned closed = 0;
+  lines.ForEach([&](ConstBuffer<RasterLocation> line){
+    if (IsClosed(line))
+      ++closed;
+  });
+  ok1(closed == 2);
+
+  for (auto &h : heights)
+    h = TerrainHeight::Invalid();
+
+  lines.Generate(heights, SIZE, SIZE, {0, 0}, 256);
+  ok1(lines.empty());
+}
+
+static void
+TestSaddle()
+{
+  /* two peaks in opposite corners; the cell center is below the
+     contour, so there are two separate lines */
+  const TerrainHeight heights[4] = {
+    TerrainHeight(300), TerrainHeight(100),
+    TerrainHeight(100), TerrainHeight(300),
+  };
+
+  ContourLines lines;
+  lines.Generate(heights, 2, 2, {0, 0}, 256);
+  ok1(lines.GetLineCount() == 2);
+  ok1(lines.GetPointCount() == 4);
+}
+
+int main()
+{
+  plan_tests(12);
+
+  TestCone();
+  TestSpecial();
+  TestSaddle();
+
+  return exit_status();
+}
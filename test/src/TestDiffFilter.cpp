@@ -28,7 +28,7 @@
 int
 main(int argc, char **argv)
 {
-  plan_tests(192 + 232 + 40);
+  plan_tests(192 + 232 + 40 + 2);
 
   DiffFilter df(0);
 
@@ -76,5 +76,25 @@ main(int argc, char **argv)
       ok1(error < 0.05);
   }
 
+  // Test feeding a batch of samples
+  {
+    double samples[20];
+    for (unsigned i = 0; i < 20; ++i)
+      samples[i] = 3. * i;
+
+    df.Reset();
+    DiffFilter df2(0);
+    double y = 0;
+    for (const double i : samples)
+      y = df.Update(i);
+    ok1(df2.Update(std::span<const double>{samples}) == y);
+
+    BasicDiffFilter<float> df3(0);
+    float samples3[20];
+    for (unsigned i = 0; i < 20; ++i)
+      samples3[i] = 3.f * i;
+    ok1(fabs(df3.Update(std::span<const float>{samples3}) - 3) < 0.11);
+  }
+
   return exit_status();
 }
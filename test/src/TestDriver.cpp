@@ -128,6 +128,16 @@ TestGeneric()
   /* Magnetic Heading bad checksum */
   ok1(!parser.ParseLine("$HCHDM,182.7,M*26", nmea_info));
 
+  /* Magnetic Heading missing checksum */
+  ok1(!parser.ParseLine("$HCHDM,182.7,M", nmea_info));
+
+  /* lower case checksum */
+  ok1(parser.ParseLine("$GPRMC,082311,A,5103.5403,N,00741.5742,E,055.3,022.4,230610,000.3,W*6c",
+                       nmea_info));
+
+  /* unknown sentence */
+  ok1(!parser.ParseLine("$GPXYZ,1*51", nmea_info));
+
   ok1(parser.ParseLine("$WIMWV,12.1,T,10.1,M,A*24", nmea_info));
   ok1(nmea_info.external_wind_available);
   ok1(equals(nmea_info.external_wind.bearing, 12.1));
@@ -1625,7 +1635,7 @@ TestFlightList(const struct DeviceRegister &driver)
 
 int main(int argc, char **argv)
 {
-  plan_tests(839);
+  plan_tests(842);
 
   TestGeneric();
   TestTasman();
@@ -22,8 +22,11 @@
 
 #include "Geo/Math.hpp"
 #include "Geo/SimplifiedMath.hpp"
+#include "Geo/FastDistance.hpp"
 #include "TestUtil.hpp"
 
+#include <vector>
+
 static void
 TestLinearDistance()
 {
@@ -63,9 +66,71 @@ TestLinearDistance()
 
 }
 
+static constexpr GeoPoint batch_origins[] = {
+  { Angle::Degrees(7.7061111111111114), Angle::Degrees(51.051944444444445) },
+  { Angle::Degrees(-60), Angle::Degrees(0) },
+  { Angle::Degrees(172.5), Angle::Degrees(-45) },
+  { Angle::Degrees(179.99), Angle::Degrees(30) },
+  { Angle::Degrees(20), Angle::Degrees(75) },
+};
+
+static void
+TestBatch(const GeoPoint &origin)
+{
+  std::vector<GeoPoint> locations;
+  locations.push_back(origin);
+  for (unsigned bearing = 0; bearing < 360; bearing += 30)
+    for (double distance : {100., 5000., 40000., 300000., 2000000.})
+      locations.push_back(FindLatitudeLongitude(origin,
+                                                Angle::Degrees(bearing),
+                                                distance));
+
+  const std::size_t n = locations.size();
+
+  /* the batch version must return exactly the same values */
+  std::vector<double> distances(n);
+  std::vector<Angle> bearings(n);
+  DistanceBearing(origin, locations, distances, bearings);
+
+  bool equal = true;
+  for (std::size_t i = 0; i < n; ++i) {
+    double distance;
+    Angle bearing;
+    DistanceBearing(origin, locations[i], &distance, &bearing);
+    equal &= distance == distances[i] && bearing == bearings[i];
+  }
+
+  ok1(equal);
+
+  /* the fast version must stay within its documented bounds; allow
+     one meter for the early exit of DistanceBearing() */
+  std::vector<double> fast_distances(n);
+  std::vector<Angle> fast_bearings(n);
+  FastDistanceBearing(origin, locations, fast_distances, fast_bearings);
+
+  bool distances_ok = true, bearings_ok = true;
+  for (std::size_t i = 0; i < n; ++i) {
+    const double exact = distances[i];
+    const double max_error = exact <= FAST_DISTANCE_FLAT_RANGE
+      ? 0.0001
+      : (exact <= 1000000 ? 0.0003 : 0.006);
+    distances_ok &= fabs(fast_distances[i] - exact) <= exact * max_error + 1;
+
+    if (exact > 0) {
+      const Angle max_bearing_error = Angle::Degrees(exact <= FAST_DISTANCE_FLAT_RANGE
+                                                     ? 0.02 : 0.3);
+      bearings_ok &= (fast_bearings[i] - bearings[i]).AsDelta().Absolute()
+        <= max_bearing_error;
+    }
+  }
+
+  ok1(distances_ok);
+  ok1(bearings_ok);
+}
+
 int main(int argc, char **argv)
 {
-  plan_tests(10 + 2 * 36 + 18);
+  plan_tests(10 + 2 * 36 + 18 + 3 * std::size(batch_origins));
 
   const GeoPoint a(Angle::Degrees(7.7061111111111114),
                    Angle::Degrees(51.051944444444445));
@@ -104,5 +169,8 @@ int main(int argc, char **argv)
 
   TestLinearDistance();
 
+  for (const auto &origin : batch_origins)
+    TestBatch(origin);
+
   return exit_status();
 }
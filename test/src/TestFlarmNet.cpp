@@ -27,9 +27,11 @@
 #include "system/Path.hpp"
 #include "TestUtil.hpp"
 
+#include <iterator>
+
 int main(int argc, char **argv)
 {
-  plan_tests(15);
+  plan_tests(22);
 
   FlarmNetDatabase db;
   int count = FlarmNetReader::LoadFile(Path(_T("test/data/flarmnet/data.fln")),
@@ -78,5 +80,32 @@ int main(int argc, char **argv)
   ok1(foundDDA85C);
   ok1(foundDDA896);
 
+  /* the result buffer must not overflow */
+  ok1(db.FindIdsByCallSign(_T("TH"), ids, 1) == 1);
+
+  ok1(db.FindFirstRecordByCallSign(_T("XX")) == nullptr);
+
+  /* records inserted in random order, with a duplicate id */
+  FlarmNetDatabase db2;
+  FlarmNetRecord r;
+  r.id = _T("00000B");
+  r.callsign = _T("B");
+  db2.Insert(r);
+  r.id = _T("00000A");
+  r.callsign = _T("A1");
+  db2.Insert(r);
+  r.callsign = _T("A2");
+  db2.Insert(r);
+  db2.Sort();
+
+  record = db2.FindRecordById(FlarmId::Parse("A", nullptr));
+  ok1(record != nullptr && StringIsEqual(record->callsign, _T("A1")));
+  ok1(db2.FindFirstRecordByCallSign(_T("A2")) == nullptr);
+
+  record = db2.FindFirstRecordByCallSign(_T("B"));
+  ok1(record != nullptr && StringIsEqual(record->id, _T("00000B")));
+  ok1(db2.FindRecordById(FlarmId::Parse("C", nullptr)) == nullptr);
+  ok1(std::distance(db2.begin(), db2.end()) == 2);
+
   return exit_status();
 }
@@ -0,0 +1,135 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+#include "Logger/FlightIndex.hpp"
+#include "Logger/FlightParser.hpp"
+#include "io/FileLineReader.hpp"
+#include "io/FileOutputStream.hxx"
+#include "system/FileUtil.hpp"
+#include "system/Path.hpp"
+#include "TestUtil.hpp"
+#include "util/PrintException.hxx"
+
+#include <string.h>
+
+static const Path log_path(_T("output/test/flights.log"));
+static const Path index_path(_T("output/test/flights.log.idx"));
+
+static void
+Append(const char *text)
+{
+  FileOutputStream file(log_path, FileOutputStream::Mode::APPEND_OR_CREATE);
+  file.Write(text, strlen(text));
+  file.Commit();
+}
+
+static bool
+operator==(const FlightInfo &a, const FlightInfo &b) noexcept
+{
+  return a.date == b.date &&
+    a.start_time == b.start_time && a.end_time == b.end_time;
+}
+
+/**
+ * Compare the index with a #FlightParser run over the whole log.
+ */
+static bool
+MatchesParser(const FlightIndex &index)
+{
+  FileLineReaderA reader(log_path);
+  FlightParser parser(reader);
+
+  const auto flights = index.GetFlights();
+  std::size_t i = 0;
+
+  FlightInfo flight;
+  while (parser.Read(flight))
+    if (i >= flights.size || !(flights[i++] == flight))
+      return false;
+
+  return i == flights.size;
+}
+
+static std::size_t
+Update()
+{
+  FlightIndex index;
+  index.Update(log_path, index_path);
+  ok1(MatchesParser(index));
+  return index.size();
+}
+
+int main(int argc, char **argv)
+try {
+  plan_tests(17);
+
+  File::Delete(log_path);
+  File::Delete(index_path);
+
+  Append("2021-06-01T10:00:00 start\n"
+         "2021-06-01T12:30:00 landing\n");
+  ok1(Update() == 1);
+
+  /* unchanged log: loaded from the index */
+  ok1(Update() == 1);
+
+  /* a flight which has not landed yet */
+  Append("2021-06-02T09:00:00 start\n");
+  ok1(Update() == 2);
+
+  /* ... and its landing completes the indexed flight */
+  Append("2021-06-02T15:00:00 landing\n");
+  ok1(Update() == 2);
+
+  /* a landing too far from the start is a separate entry */
+  Append("2021-06-03T08:00:00 start\n");
+  ok1(Update() == 3);
+  Append("2021-06-04T08:00:00 landing\n"
+         "2021-06-05T11:00:00 start\n"
+         "2021-06-05T11:30:00 landing\n");
+  ok1(Update() == 5);
+
+  /* paging: the most recent flights come first */
+  {
+    FlightIndex index;
+    index.Update(log_path, index_path);
+
+    const auto page0 = index.GetPage(0, 2);
+    ok1(page0.size == 2 && page0.data == index.GetFlights().data + 3);
+
+    const auto page2 = index.GetPage(2, 2);
+    ok1(page2.size == 1 && page2.data == index.GetFlights().data);
+
+    ok1(index.GetPage(3, 2).empty());
+  }
+
+  /* a truncated log rebuilds the index */
+  File::Delete(log_path);
+  Append("2021-07-01T10:00:00 start\n");
+  ok1(Update() == 1);
+
+  return exit_status();
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
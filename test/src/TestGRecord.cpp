@@ -25,8 +25,44 @@
 #include "system/Path.hpp"
 #include "util/PrintException.hxx"
 
+#include <algorithm>
+
 #include <tchar.h>
 #include <stdlib.h>
+#include <string.h>
+
+/**
+ * Verify that MD5::Append() produces the same digest no matter how
+ * the input is split.
+ */
+static void
+CheckMD5Chunks()
+{
+  char data[1000];
+  for (unsigned i = 0; i < sizeof(data); ++i)
+    data[i] = 'A' + i % 26;
+
+  MD5 reference;
+  reference.Initialise();
+  for (char ch : data)
+    reference.Append(ch);
+  reference.Finalize();
+
+  char expected[MD5::DIGEST_LENGTH + 1];
+  reference.GetDigest(expected);
+
+  for (size_t chunk : {1, 7, 63, 64, 65, 200, 1000}) {
+    MD5 md5;
+    md5.Initialise();
+    for (size_t i = 0; i < sizeof(data); i += chunk)
+      md5.Append(data + i, std::min(chunk, sizeof(data) - i));
+    md5.Finalize();
+
+    char digest[MD5::DIGEST_LENGTH + 1];
+    md5.GetDigest(digest);
+    ok1(strcmp(digest, expected) == 0);
+  }
+}
 
 static void
 CheckGRecord(const TCHAR *path)
@@ -39,7 +75,9 @@ CheckGRecord(const TCHAR *path)
 
 int main(int argc, char **argv)
 try {
-  plan_tests(4);
+  plan_tests(11);
+
+  CheckMD5Chunks();
 
   CheckGRecord(_T("test/data/grecord64a.igc"));
   CheckGRecord(_T("test/data/grecord64b.igc"));
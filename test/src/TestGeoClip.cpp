@@ -26,7 +26,7 @@
 #include <stdio.h>
 
 static inline GeoPoint
-make_geo_point(int longitude, int latitude)
+make_geo_point(double longitude, double latitude)
 {
   return GeoPoint(Angle::Degrees(longitude),
                   Angle::Degrees(latitude));
@@ -222,14 +222,56 @@ test_clip_polygon()
     make_geo_point(-5, -50),
   };
   test_clip_polygon(clip, src8, 3, result7, 4);
+
+  /* completely outside (rejected by the bounding box) */
+  const GeoPoint src9[3] = {
+    make_geo_point(7, 4),
+    make_geo_point(9, 4),
+    make_geo_point(8, 2),
+  };
+  test_clip_polygon(clip, src9, 3, NULL, 0);
+
+  /* clipped only at the north border */
+  const GeoPoint src10[3] = {
+    make_geo_point(3, 2),
+    make_geo_point(4, 8),
+    make_geo_point(5, 2),
+  };
+  const GeoPoint result10[4] = {
+    make_geo_point(3, 2),
+    make_geo_point(3.5, 5),
+    make_geo_point(4.5, 5),
+    make_geo_point(5, 2),
+  };
+  test_clip_polygon(clip, src10, 3, result10, 4);
+
+  /* across the antimeridian */
+  GeoClip clip2(GeoBounds(make_geo_point(178, 5), make_geo_point(-178, 1)));
+  const GeoPoint src11[3] = {
+    make_geo_point(179, 4),
+    make_geo_point(-179, 4),
+    make_geo_point(179, 2),
+  };
+  test_clip_polygon(clip2, src11, 3, src11, 3);
+}
+
+static void
+test_is_inside()
+{
+  GeoClip clip(GeoBounds(make_geo_point(2, 5), make_geo_point(6, 1)));
+
+  ok1(clip.IsInside(GeoBounds(make_geo_point(3, 4), make_geo_point(5, 2))));
+  ok1(!clip.IsInside(GeoBounds(make_geo_point(3, 4), make_geo_point(7, 2))));
+  ok1(!clip.IsInside(GeoBounds(make_geo_point(7, 4), make_geo_point(9, 2))));
 }
 
 int main(int argc, char **argv)
 {
-  plan_tests(24);
+  plan_tests(30);
 
   test_clip_line();
   test_clip_polygon();
+  test_is_inside();
 
   return exit_status();
 }
@@ -21,6 +21,7 @@
 */
 
 #include "IGC/IGCParser.hpp"
+#include "IGC/IGCFileParser.hpp"
 #include "IGC/IGCExtensions.hpp"
 #include "IGC/IGCFix.hpp"
 #include "IGC/IGCHeader.hpp"
@@ -77,6 +78,11 @@ TestExtensions()
   ok1(extensions[3].start == 47);
   ok1(extensions[3].finish == 49);
   ok1(strcmp(extensions[3].code, "TRT") == 0);
+
+  ok1(extensions[0].type == IGCExtension::Type::UNKNOWN);
+  ok1(extensions[1].type == IGCExtension::Type::ENL);
+  ok1(extensions[2].type == IGCExtension::Type::GSP);
+  ok1(extensions[3].type == IGCExtension::Type::TRT);
 }
 
 static void
@@ -188,6 +194,56 @@ TestFix()
   ok1(equals(fix.location, -51.05195, -7.70611667));
   ok1(fix.pressure_altitude == 10490);
   ok1(fix.gps_altitude == 7);
+
+  /* negative altitudes */
+  ok1(IGCParseFix("B1122535103117S00742367WA-0049-0007", extensions, fix));
+  ok1(fix.pressure_altitude == -49);
+  ok1(fix.gps_altitude == -7);
+
+  /* not strictly fixed-width, handled by the generic parser */
+  ok1(IGCParseFix("B1122535103117S00742367WA  49   7", extensions, fix));
+  ok1(fix.pressure_altitude == 49);
+  ok1(fix.gps_altitude == 7);
+
+  ok1(IGCParseExtensions("I033638FXA3941ENL4246GSP", extensions));
+  ok1(IGCParseFix("B1122385103117N00742367EA004900048700012300085",
+                  extensions, fix));
+  ok1(fix.enl == 123);
+  ok1(fix.gsp == 0);
+  ok1(fix.trt < 0);
+
+  /* the extension exceeds the line length */
+  ok1(IGCParseFix("B1122385103117N00742367EA00490004870001230", extensions, fix));
+  ok1(fix.enl == 123);
+  ok1(fix.gsp < 0);
+}
+
+static void
+TestParseFixes()
+{
+  ok1(IGCParseFixes(std::string_view{}).empty());
+
+  const auto fixes =
+    IGCParseFixes("AXCSAAA\r\n"
+                  "HFDTE040910\r\n"
+                  "B1122385103117N00742367EA0049000487\r\n"
+                  "I013638ENL\r\n"
+                  "LXCS garbage\r\n"
+                  "B1122435103117N00742367EV0049000487042\r\n"
+                  "B1122X85103117N00742367EA0049000487042\r\n"
+                  "B1122535103117S00742367WA1049000007099");
+
+  ok1(fixes.size() == 3);
+  ok1(fixes[0].time == BrokenTime(11, 22, 38));
+  ok1(fixes[0].gps_valid);
+  ok1(fixes[0].enl < 0);
+  ok1(fixes[1].time == BrokenTime(11, 22, 43));
+  ok1(!fixes[1].gps_valid);
+  ok1(fixes[1].enl == 42);
+  ok1(fixes[2].time == BrokenTime(11, 22, 53));
+  ok1(equals(fixes[2].location, -51.05195, -7.70611667));
+  ok1(fixes[2].pressure_altitude == 10490);
+  ok1(fixes[2].enl == 99);
 }
 
 static void
@@ -270,7 +326,7 @@ TestDeclarationTurnpoint()
 
 int main(int argc, char **argv)
 {
-  plan_tests(148);
+  plan_tests(178);
 
   TestHeader();
   TestDate();
@@ -278,6 +334,7 @@ int main(int argc, char **argv)
   TestExtensions();
   TestFix();
   TestFixTime();
+  TestParseFixes();
   TestDeclarationHeader();
   TestDeclarationTurnpoint();
 
@@ -0,0 +1,111 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "json/Writer.hxx"
+#include "io/OutputStream.hxx"
+#include "TestUtil.hpp"
+
+#include <cmath>
+#include <string>
+
+class StringOutputStream final : public OutputStream {
+public:
+  std::string value;
+
+  void Write(const void *data, std::size_t size) override {
+    value.append((const char *)data, size);
+  }
+};
+
+template<typename F>
+static std::string
+Format(F &&f)
+{
+  StringOutputStream sos;
+  WithBufferedOutputStream(sos, f);
+  return std::move(sos.value);
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(8);
+
+  ok1(Format([](BufferedOutputStream &os){
+    Json::WriteString(os, "plain");
+  }) == "\"plain\"");
+
+  ok1(Format([](BufferedOutputStream &os){
+    Json::WriteString(os, "a\"b\\c\nd\x01");
+  }) == "\"a\\\"b\\\\c\\nd\\u0001\"");
+
+  ok1(Format([](BufferedOutputStream &os){
+    Json::WriteValue(os, -42);
+    os.Write(' ');
+    Json::WriteValue(os, 42u);
+    os.Write(' ');
+    Json::WriteValue(os, true);
+  }) == "-42 42 true");
+
+  ok1(Format([](BufferedOutputStream &os){
+    Json::WriteValue(os, 0.5);
+    os.Write(' ');
+    Json::WriteValue(os, -1234.25);
+  }) == "0.5 -1234.25");
+
+  ok1(Format([](BufferedOutputStream &os){
+    Json::WriteValue(os, NAN);
+    os.Write(' ');
+    Json::WriteValue(os, INFINITY);
+  }) == "null null");
+
+  ok1(Format([](BufferedOutputStream &os){
+    Json::ObjectWriter object(os);
+    object.End();
+  }) == "{}");
+
+  ok1(Format([](BufferedOutputStream &os){
+    Json::ArrayWriter array(os);
+    array.Add(1);
+    array.Add("two");
+    Json::ObjectWriter nested(array.Next());
+    nested.AddNull("three");
+    nested.End();
+    array.End();
+  }) == "[1,\"two\",{\"three\":null}]");
+
+  ok1(Format([](BufferedOutputStream &os){
+    Json::ObjectWriter object(os);
+    object.Add("a", 1);
+    object.Add("b", "x");
+    Json::ArrayWriter array(object.Key("c"));
+    array.Add(2.5);
+    array.Add(false);
+    array.End();
+    object.Add(std::string_view("a_very_long_key_which_does_not_fit_into_the_key_buffer_at_all"),
+               0);
+    object.End();
+  }) == "{\"a\":1,\"b\":\"x\",\"c\":[2.5,false],"
+        "\"a_very_long_key_which_does_not_fit_into_the_key_buffer_at_all\":0}");
+
+  return exit_status();
+}
@@ -0,0 +1,76 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+ */
+
+
+#include "Math/KalmanFilter1d.hpp"
+#include "TestUtil.hpp"
+
+#include <array>
+#include <cmath>
+
+template<typename T>
+static void
+TestRamp(const T slope, const T tolerance)
+{
+  BasicKalmanFilter1d<T> kf(0.01);
+  kf.Reset(100);
+
+  for (unsigned i = 1; i <= 500; ++i)
+    kf.Update(100 + slope * i * T(0.1), T(0.05), T(0.1));
+
+  ok1(std::fabs(kf.GetXVel() - slope) < tolerance);
+  ok1(std::fabs(kf.GetXAbs() - (100 + slope * 50)) < tolerance);
+}
+
+static void
+TestBatch()
+{
+  std::array<double, 40> samples;
+  for (unsigned i = 0; i < samples.size(); ++i)
+    samples[i] = 1000 - 0.02 * i + 0.01 * std::sin(i);
+
+  KalmanFilter1d a(0.3), b(0.3);
+
+  for (const double z : samples)
+    a.Update(z, 0.25, 0.02);
+
+  b.Update(samples, 0.25, 0.02);
+
+  /* the batch must yield exactly the same result */
+  ok1(a.GetXAbs() == b.GetXAbs());
+  ok1(a.GetXVel() == b.GetXVel());
+  ok1(a.GetCovAbsAbs() == b.GetCovAbsAbs());
+  ok1(a.GetCovAbsVel() == b.GetCovAbsVel());
+  ok1(a.GetCovVelVel() == b.GetCovVelVel());
+}
+
+int
+main(int argc, char **argv)
+{
+  plan_tests(2 + 2 + 5);
+
+  TestRamp<double>(-1.5, 0.01);
+  TestRamp<float>(-1.5f, 0.01f);
+  TestBatch();
+
+  return exit_status();
+}
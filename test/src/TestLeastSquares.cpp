@@ -21,6 +21,7 @@
 */
 
 #include "Math/LeastSquares.hpp"
+#include "Math/ConvexFilter.hpp"
 #include "TestUtil.hpp"
 
 #include <stdio.h>
@@ -82,12 +83,91 @@ LSTest1(double w)
   return true;
 }
 
+/**
+ * Add more points than there are slots; the older ones get merged.
+ */
+static void
+TestCompact()
+{
+  LeastSquares ls;
+  ls.Reset();
+
+  constexpr unsigned N = 5000;
+  for (unsigned i = 0; i < N; ++i)
+    ls.Update(i, 2 * i + 1);
+
+  ok1(ls.GetCount() == N);
+  ok1(ls.GetSlots().size <= 1000);
+  ok1(ls.GetSlots().size > 500);
+  ok1(equals(ls.GetGradient(), 2));
+  ok1(equals(ls.GetYAt(0), 1));
+  ok1(equals(ls.GetMaxX(), double(N - 1)));
+
+  /* the newest point is retained, and the merged ones are still on
+     the line and in order */
+  ok1(equals(ls.GetSlots().back().x, double(N - 1)));
+
+  bool on_line = true, ordered = true;
+  double last_x = -1;
+  for (const auto &i : ls.GetSlots()) {
+    on_line &= equals(i.y, 2 * i.x + 1);
+    ordered &= i.x > last_x;
+    last_x = i.x;
+  }
+
+  ok1(on_line);
+  ok1(ordered);
+}
+
+/**
+ * Prune a #ConvexFilter after some of its slots have been merged;
+ * the merged slots must survive, and the statistics must still
+ * describe exactly the points which were not pruned.
+ */
+static void
+TestConvexCompact()
+{
+  ConvexFilter cf;
+  cf.Reset();
+
+  /* a concave curve, nothing gets pruned; this is enough points for
+     one Compact(), with room left for one more */
+  constexpr unsigned N = 1200;
+  for (unsigned i = 0; i < N; ++i)
+    cf.UpdateConvexPositive(i, sqrt(i));
+
+  ok1(cf.GetCount() == N);
+  ok1(cf.GetMergedSlots() > 0);
+
+  /* all points since the first unmerged slot */
+  const unsigned n_merged = cf.GetMergedSlots();
+  const unsigned first_unmerged = cf.GetSlots()[n_merged].x;
+
+  /* this point is above the chord of all previous points, and would
+     prune all of them */
+  cf.UpdateConvexPositive(N, 1000);
+
+  ok1(cf.GetMergedSlots() == n_merged);
+  ok1(cf.GetSlots().size == n_merged + 1);
+
+  LeastSquares ls;
+  ls.Reset();
+  for (unsigned i = 0; i < first_unmerged; ++i)
+    ls.Update(i, sqrt(i));
+  ls.Update(N, 1000);
+
+  ok1(equals(cf.GetGradient(), ls.GetGradient()));
+  ok1(equals(cf.GetAverageY(), ls.GetAverageY()));
+}
+
 int main(int argc, char **argv)
 {
-  plan_tests(2);
+  plan_tests(17);
 
   ok1(LSTest1(1));
   ok1(LSTest1(2));
+  TestCompact();
+  TestConvexCompact();
 
   return exit_status();
 }
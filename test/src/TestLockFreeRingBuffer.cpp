@@ -0,0 +1,165 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "util/LockFreeRingBuffer.hpp"
+#include "TestUtil.hpp"
+
+#include <thread>
+
+static void
+TestSingleThread()
+{
+  LockFreeRingBuffer<unsigned, 4> buffer;
+  ok1(buffer.empty());
+
+  unsigned value;
+  ok1(!buffer.shift(value));
+
+  ok1(buffer.push(1));
+  ok1(!buffer.empty());
+  ok1(buffer.shift(value) && value == 1);
+  ok1(buffer.empty());
+
+  /* all slots are usable */
+  const unsigned src[] = {2, 3, 4, 5, 6};
+  ok1(buffer.push(src, 5) == 4);
+  ok1(buffer.GetSize() == 4);
+  ok1(!buffer.push(7));
+
+  /* Read() returns only the contiguous part */
+  auto r = buffer.Read();
+  ok1(r.size == 3 && r.data[0] == 2);
+  buffer.Consume(1);
+
+  unsigned dest[8];
+  ok1(buffer.shift(dest, 8) == 3);
+  ok1(dest[0] == 3 && dest[1] == 4 && dest[2] == 5);
+  ok1(buffer.empty());
+
+  buffer.push(8);
+  buffer.clear();
+  ok1(buffer.empty());
+}
+
+static void
+TestOverwriting()
+{
+  LockFreeOverwritingRingBuffer<unsigned, 4> buffer;
+  ok1(buffer.empty());
+
+  for (unsigned i = 1; i <= 6; ++i)
+    buffer.push(i);
+
+  /* the two oldest items were overwritten */
+  unsigned value;
+  ok1(buffer.shift(value) && value == 3);
+  ok1(buffer.shift(value) && value == 4);
+
+  buffer.push(7);
+  ok1(buffer.shift_latest(value) && value == 7);
+  ok1(buffer.empty());
+  ok1(!buffer.shift_latest(value));
+}
+
+/**
+ * Pass a sequence of numbers between two threads; the consumer must
+ * see all of them in order.
+ */
+static void
+TestThreads()
+{
+  static constexpr unsigned N = 1000000;
+
+  LockFreeRingBuffer<unsigned, 64> buffer;
+
+  std::thread producer([&buffer]{
+    for (unsigned i = 0; i < N;)
+      if (buffer.push(i))
+        ++i;
+      else
+        std::this_thread::yield();
+  });
+
+  unsigned expected = 0;
+  bool in_order = true;
+  while (expected < N) {
+    unsigned values[16];
+    const std::size_t n = buffer.shift(values, 16);
+    if (n == 0)
+      std::this_thread::yield();
+
+    for (std::size_t i = 0; i < n; ++i)
+      in_order &= values[i] == expected++;
+  }
+
+  producer.join();
+  ok1(in_order);
+  ok1(buffer.empty());
+}
+
+/**
+ * The overwriting consumer may miss items, but it must never see a
+ * torn item or an item older than one it has already seen.
+ */
+static void
+TestOverwritingThreads()
+{
+  struct Item {
+    unsigned a, b;
+  };
+
+  static constexpr unsigned N = 1000000;
+
+  LockFreeOverwritingRingBuffer<Item, 4> buffer;
+
+  std::thread producer([&buffer]{
+    for (unsigned i = 1; i <= N; ++i)
+      buffer.push({i, ~i});
+  });
+
+  unsigned last = 0;
+  bool consistent = true;
+  while (last < N) {
+    Item item;
+    if (buffer.shift(item)) {
+      consistent &= item.b == ~item.a && item.a > last;
+      last = item.a;
+    } else
+      std::this_thread::yield();
+  }
+
+  producer.join();
+  ok1(consistent);
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(23);
+
+  TestSingleThread();
+  TestOverwriting();
+  TestThreads();
+  TestOverwritingThreads();
+
+  return exit_status();
+}
@@ -21,6 +21,7 @@
 */
 
 #include "IGC/IGCWriter.hpp"
+#include "Logger/LoggerOutputThread.hpp"
 #include "system/FileUtil.hpp"
 #include "NMEA/Info.hpp"
 #include "io/FileLineReader.hpp"
@@ -154,9 +155,18 @@ Run(Path path)
   Run(writer);
 }
 
+static void
+RunThreaded(Path path)
+{
+  LoggerOutputThread output(path, std::chrono::seconds{1});
+  IGCWriter writer(output);
+  Run(writer);
+  output.Flush();
+}
+
 int main(int argc, char **argv)
 try {
-  plan_tests(51);
+  plan_tests(102);
 
   const Path path(_T("output/test/test.igc"));
   File::Delete(path);
@@ -169,6 +179,16 @@ try {
   grecord.Initialize();
   grecord.VerifyGRecordInFile(path);
 
+  /* the same through the asynchronous writer thread */
+  File::Delete(path);
+
+  RunThreaded(path);
+
+  CheckTextFile(path, expect);
+
+  grecord.Initialize();
+  grecord.VerifyGRecordInFile(path);
+
   return exit_status();
 } catch (...) {
   PrintException(std::current_exception());
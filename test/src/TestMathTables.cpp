@@ -20,23 +20,65 @@
 }
 */
 
-#include "Math/FastMath.hpp"
-#include "Computer/ThermalLocator.hpp"
+#include "Math/FastTrig.hpp"
 #include "TestUtil.hpp"
 
-static inline double
-thermal_fn(int x)
+#include <algorithm>
+
+#include <math.h>
+
+static void
+TestIntSineTable()
 {
-  return exp((-0.2/ThermalLocator::TLOCATOR_NMAX)*pow((double)x, 1.5));
+  bool equal = true;
+  for (unsigned i = 0; i < INT_ANGLE_RANGE; ++i)
+    if (ISINETABLE[i] != lround(sin(IntAngleToRadians(i)) * 1024))
+      equal = false;
+
+  ok1(equal);
+}
+
+static void
+TestFastSineTable()
+{
+  double error = 0;
+  for (unsigned i = 0; i < INT_ANGLE_RANGE; ++i)
+    error = std::max(error,
+                     fabs(FAST_SINE_TABLE[i] - sin(IntAngleToRadians(i))));
+
+  /* float rounding only */
+  ok1(error < 1e-7);
+}
+
+static void
+TestFastSine()
+{
+  double sine_error = 0, cosine_error = 0, inverse_error = 0;
+  for (double x = -3 * M_PI; x < 3 * M_PI; x += 1e-4) {
+    sine_error = std::max(sine_error, fabs(fastsine(x) - sin(x)));
+    cosine_error = std::max(cosine_error, fabs(fastcosine(x) - cos(x)));
+
+    if (fabs(cos(x)) > 0.1)
+      inverse_error = std::max(inverse_error,
+                               fabs(invfastcosine(x) * cos(x) - 1));
+  }
+
+  /* half the angle resolution */
+  ok1(sine_error < 8e-4);
+  ok1(cosine_error < 8e-4);
+  ok1(inverse_error < 8e-3);
+
+  ok1(fastsine(0) == 0);
+  ok1(fastcosine(0) == 1);
 }
 
 int main(int argc, char **argv)
 {
-  plan_tests(ThermalLocator::TLOCATOR_NMAX);
+  plan_tests(7);
 
-  for (unsigned i = 0; i < ThermalLocator::TLOCATOR_NMAX; ++i)
-    ok1((int)(thermal_fn(i) * 1024 * 1024) ==
-        (int)(thermal_recency_fn(i) * 1024 * 1024));
+  TestIntSineTable();
+  TestFastSineTable();
+  TestFastSine();
 
   return exit_status();
 }
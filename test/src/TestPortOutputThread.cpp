@@ -0,0 +1,107 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Device/Util/PortOutputThread.hpp"
+#include "Device/Port/NullPort.hpp"
+#include "thread/Cond.hxx"
+#include "thread/Mutex.hxx"
+#include "TestUtil.hpp"
+
+#include <string>
+
+/**
+ * A #Port which blocks in Write() until it is released.
+ */
+class StallPort final : public NullPort {
+  Mutex mutex;
+  Cond cond;
+
+  bool stalled = true;
+
+public:
+  std::string received;
+  unsigned n_writes = 0;
+
+  void Release() {
+    const std::lock_guard<Mutex> lock(mutex);
+    stalled = false;
+    cond.notify_all();
+  }
+
+  std::size_t WaitReceived(std::size_t size) {
+    std::unique_lock<Mutex> lock(mutex);
+    cond.wait_for(lock, std::chrono::seconds(5),
+                  [this, size]{ return received.size() >= size; });
+    return received.size();
+  }
+
+  size_t Write(const void *data, size_t length) override {
+    std::unique_lock<Mutex> lock(mutex);
+    cond.wait(lock, [this]{ return !stalled; });
+
+    received.append((const char *)data, length);
+    ++n_writes;
+    cond.notify_all();
+    return length;
+  }
+};
+
+int
+main()
+{
+  plan_tests(8);
+
+  StallPort port;
+
+  {
+    PortOutputThread thread(port);
+
+    /* the first write gets stuck in the port */
+    ok1(thread.Write("$A\r\n", 4));
+
+    /* these accumulate in the queue without blocking the caller */
+    const std::string line(100, 'x');
+    unsigned accepted = 0;
+    for (unsigned i = 0; i < 100; ++i)
+      if (thread.Write(line.data(), line.size()))
+        ++accepted;
+
+    ok1(accepted >= PortOutputThread::MAX_QUEUE / line.size() - 1);
+    ok1(accepted <= PortOutputThread::MAX_QUEUE / line.size());
+    ok1(thread.GetDropped() == 100 - accepted);
+
+    port.Release();
+
+    const std::size_t expected = 4 + accepted * line.size();
+    ok1(port.WaitReceived(expected) == expected);
+    ok1(port.received.compare(0, 4, "$A\r\n") == 0);
+
+    /* the queued lines were written with very few calls */
+    ok1(port.n_writes <= 3);
+
+    /* after draining, new data is accepted again */
+    ok1(thread.Write("$B\r\n", 4));
+  }
+
+  return exit_status();
+}
@@ -23,6 +23,9 @@
 #include "Projection/Projection.hpp"
 #include "TestUtil.hpp"
 
+#include <random>
+#include <vector>
+
 static void
 TestGeoScreenCouple(const Projection prj, const GeoPoint geo,
                     int x, int y)
@@ -46,12 +49,57 @@ test_simple()
                                     Angle::Zero()), 0, 0);
 }
 
+/**
+ * Verify that the batch GeoToScreen() returns exactly the same
+ * results as the scalar one.
+ */
+static void
+test_batch(GeoPoint center, Angle screen_angle)
+{
+  Projection prj;
+  prj.SetScreenOrigin(320, 240);
+  prj.SetScale(640. / (100 * 2));
+  prj.SetScreenAngle(screen_angle);
+  prj.SetGeoLocation(center);
+
+  /* not a multiple of the SIMD width or the chunk size */
+  std::vector<GeoPoint> points;
+  std::minstd_rand rng;
+  std::uniform_real_distribution<double> distribution(-1, 1);
+  for (unsigned i = 0; i < 203; ++i) {
+    const double dx = distribution(rng);
+    const double dy = distribution(rng);
+    points.emplace_back(center.longitude + Angle::Degrees(dx),
+                        center.latitude + Angle::Degrees(dy));
+  }
+
+  std::vector<PixelPoint> screen(points.size());
+  prj.GeoToScreen(points, screen);
+
+  bool equal = true;
+  for (std::size_t i = 0; i < points.size(); ++i)
+    if (screen[i] != prj.GeoToScreen(points[i]))
+      equal = false;
+
+  ok1(equal);
+}
+
 int
 main(int argc, char **argv)
 {
-  plan_tests(4);
+  plan_tests(8);
 
   test_simple();
 
+  const GeoPoint center(Angle::Degrees(7.7061111111111114),
+                        Angle::Degrees(51.051944444444445));
+  test_batch(center, Angle::Zero());
+  test_batch(center, Angle::Degrees(37));
+  test_batch(center, Angle::Degrees(-123));
+
+  /* across the antimeridian */
+  test_batch(GeoPoint(Angle::Degrees(179.8), Angle::Degrees(-41.3)),
+             Angle::Degrees(200));
+
   return exit_status();
 }
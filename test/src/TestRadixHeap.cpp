@@ -0,0 +1,94 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "util/RadixHeap.hpp"
+#include "TestUtil.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+struct Identity {
+  constexpr unsigned operator()(unsigned x) const noexcept {
+    return x;
+  }
+};
+
+int main(int argc, char **argv)
+{
+  plan_tests(12);
+
+  RadixHeap<unsigned, Identity> heap;
+  ok1(heap.empty());
+
+  heap.push(7);
+  heap.push(3);
+  heap.push(0x80000000);
+  heap.push(3);
+  ok1(heap.size() == 4);
+  ok1(heap.top() == 3);
+  heap.pop();
+  ok1(heap.top() == 3);
+  heap.pop();
+
+  /* monotone pushes after pop() */
+  heap.push(5);
+  heap.push(4);
+  ok1(heap.top() == 4);
+  heap.pop();
+  ok1(heap.top() == 5);
+  heap.pop();
+
+  /* a key below the last popped one */
+  heap.push(1);
+  ok1(heap.top() == 1);
+  heap.pop();
+  ok1(heap.top() == 7);
+  heap.pop();
+  ok1(heap.top() == 0x80000000);
+  heap.pop();
+  ok1(heap.empty());
+
+  /* compare with std::sort */
+  std::vector<unsigned> keys, popped;
+  std::minstd_rand rng;
+  for (unsigned i = 0; i < 1000; ++i) {
+    const unsigned key = rng();
+    keys.push_back(key);
+    heap.push(key);
+  }
+
+  while (!heap.empty()) {
+    popped.push_back(heap.top());
+    heap.pop();
+  }
+
+  std::sort(keys.begin(), keys.end());
+  ok1(popped == keys);
+
+  heap.push(42);
+  heap.clear();
+  ok1(heap.empty());
+
+  return exit_status();
+}
@@ -0,0 +1,79 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Math/SampledWindowFilter.hpp"
+#include "TestUtil.hpp"
+
+static bool
+Equals(const SampledWindowFilter<7>::Delta &delta, double x, double y)
+{
+  return equals(delta.x, x) && equals(delta.y, y);
+}
+
+int
+main(int argc, char **argv)
+{
+  plan_tests(16);
+
+  SampledWindowFilter<7> f(10);
+  ok1(f.IsEmpty());
+  ok1(equals(f.GetMaxWidth(), 60));
+
+  /* constant speed 2, sampled irregularly */
+  f.Push(100, 0);
+  ok1(Equals(f.GetDelta(30), 0, 0));
+
+  f.Push(103, 6);
+  f.Push(117, 34);
+  f.Push(125, 50);
+  ok1(equals(f.GetFirstX(), 100));
+  ok1(equals(f.GetLastX(), 125));
+
+  /* clipped to the available history */
+  ok1(Equals(f.GetDelta(60), 25, 50));
+
+  /* windows starting between grid points and after the newest one */
+  ok1(Equals(f.GetDelta(13), 13, 26));
+  ok1(Equals(f.GetDelta(4), 4, 8));
+  ok1(Equals(f.GetDelta(0), 0, 0));
+
+  /* speed 1 from now on; the oldest sample is discarded */
+  f.Push(165, 90);
+  f.Push(175, 100);
+  ok1(equals(f.GetFirstX(), 110));
+  ok1(Equals(f.GetDelta(40), 40, 40));
+
+  /* x=115 was interpolated at speed 2 */
+  ok1(Equals(f.GetDelta(60), 60, 70));
+  ok1(Equals(f.GetDelta(70), 65, 80));
+
+  /* a gap wider than the capacity starts over */
+  f.Push(300, 200);
+  ok1(equals(f.GetFirstX(), 300));
+  ok1(Equals(f.GetDelta(60), 0, 0));
+
+  f.Clear();
+  ok1(f.IsEmpty());
+
+  return exit_status();
+}
@@ -0,0 +1,76 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Device/Port/SendQueue.hpp"
+#include "TestUtil.hpp"
+
+#include <algorithm>
+#include <array>
+
+static constexpr std::size_t SIZE = 64;
+
+/**
+ * Does the queue contain the given two chunks of #data?
+ */
+static bool
+Check(SendQueue<SIZE> &queue, const std::byte *a, std::size_t a_length,
+      const std::byte *b, std::size_t b_length)
+{
+  auto r = queue.Read();
+  return r.size == a_length + b_length &&
+    std::equal(a, a + a_length, r.data) &&
+    std::equal(b, b + b_length, r.data + a_length);
+}
+
+int
+main()
+{
+  plan_tests(9);
+
+  std::array<std::byte, SIZE> data;
+  for (std::size_t i = 0; i < data.size(); ++i)
+    data[i] = std::byte(i);
+
+  SendQueue<SIZE> queue;
+
+  /* fill most of the queue */
+  ok1(queue.Push(data.data(), 48));
+  ok1(queue.Push(data.data() + 48, 8));
+  ok1(!queue.Push(data.data(), 9));
+
+  /* partly drain it; most of the free space is now before the
+     queued data */
+  queue.Consume(40);
+  ok1(Check(queue, data.data() + 40, 16, nullptr, 0));
+
+  /* this fits only after moving the queued data to the front */
+  ok1(queue.Push(data.data(), 32));
+  ok1(Check(queue, data.data() + 40, 16, data.data(), 32));
+
+  /* a chunk which doesn't fit is rejected as a whole */
+  ok1(!queue.Push(data.data(), 17));
+  ok1(queue.Push(data.data(), 16));
+  ok1(queue.IsFull());
+
+  return exit_status();
+}
@@ -0,0 +1,120 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Terrain/SlopeShading.hpp"
+#include "TestUtil.hpp"
+
+#include <random>
+#include <string.h>
+
+static constexpr unsigned WIDTH = 517;
+
+static std::minstd_rand rng;
+
+static TerrainHeight
+RandomHeight()
+{
+  const unsigned kind = rng() % 64;
+  if (kind == 0)
+    return TerrainHeight::Invalid();
+  else if (kind == 1)
+    /* water */
+    return TerrainHeight(-31000);
+  else if (kind == 2)
+    /* broken map files */
+    return TerrainHeight(int16_t(rng()));
+  else
+    return TerrainHeight(int(rng() % 3000) - 100);
+}
+
+static void
+FillRow(TerrainHeight *row)
+{
+  for (unsigned i = 0; i < WIDTH; ++i)
+    row[i] = RandomHeight();
+}
+
+/**
+ * Compare the optimised implementation with the generic one.
+ */
+static bool
+TestRow(unsigned quantisation, unsigned p31,
+        const SlopeShadingParameters &p)
+{
+  TerrainHeight above[WIDTH], below[WIDTH], row[WIDTH];
+  FillRow(above);
+  FillRow(below);
+  FillRow(row);
+
+  const unsigned n = WIDTH - 2 * quantisation;
+
+  int8_t expected[WIDTH], actual[WIDTH];
+  CalculateSlopeShadingRowGeneric(expected, above, below,
+                                  row, row + 2 * quantisation,
+                                  n, 2 * quantisation, p31, p);
+  CalculateSlopeShadingRow(actual, above, below,
+                           row, row + 2 * quantisation,
+                           n, 2 * quantisation, p31, p);
+
+  for (unsigned i = 0; i < n; ++i)
+    if (expected[i] < -63 || expected[i] > 63)
+      return false;
+
+  return memcmp(expected, actual, n) == 0;
+}
+
+static bool
+TestRandom(unsigned quantisation)
+{
+  const SlopeShadingParameters p{
+    int(rng() % 511) - 255,
+    int(rng() % 511) - 255,
+    int(rng() % 212) + 44,
+    int(rng() % 256),
+    1 + unsigned(rng() % (8192 / (quantisation * quantisation))),
+  };
+
+  return TestRow(quantisation, 2 * quantisation, p) &&
+    TestRow(quantisation, quantisation, p) &&
+    TestRow(quantisation, 0, p);
+}
+
+int main(int argc, char **argv)
+{
+  static constexpr unsigned quantisations[] = { 1, 2, 3, 7, 25 };
+
+  plan_tests(std::size(quantisations) + 1);
+
+  for (const unsigned q : quantisations) {
+    bool success = true;
+    for (unsigned i = 0; i < 200 && success; ++i)
+      success = TestRandom(q);
+    ok(success, "quantisation %u", q);
+  }
+
+  /* the largest possible height_slope_factor */
+  const SlopeShadingParameters p{200, -200, 255, 255, 8192};
+  ok1(TestRow(1, 2, p));
+
+  return exit_status();
+}
@@ -22,6 +22,7 @@
 
 #include "TestUtil.hpp"
 #include <stdio.h>
+#include <chrono>
 
 #include "Engine/ThermalBand/ThermalEncounterBand.hpp"
 #include "Engine/ThermalBand/ThermalEncounterCollection.hpp"
@@ -157,11 +158,54 @@ thermal_collection_test(const FloatDuration telapsed,
   ok1(fabs(col.GetSlice(col.size()/2).w_n-we) < w_tol);
 }
 
+/**
+ * Simulate a long flight with many climbs at varying heights, and
+ * check that the incrementally updated collection times still match
+ * the time spent below each slice.
+ */
+static void
+thermal_flight_test(const unsigned num_climbs)
+{
+  ThermalEncounterCollection col;
+  ThermalEncounterBand band;
+  col.Reset();
+
+  TimeStamp t{};
+
+  const auto start = steady_clock::now();
+
+  for (unsigned i = 0; i < num_climbs; ++i) {
+    band.Reset();
+    double h = 500 + (i * 37) % 600;
+    const double w = 0.5 + (i % 7) * 0.5;
+    simulate_climb(band, t, h, FloatDuration(60 + (i * 13) % 240),
+                   FloatDuration{1}, w, w * 0.7);
+    col.Merge(band);
+    t += seconds{300};
+  }
+
+  const auto duration = duration_cast<microseconds>(steady_clock::now() - start);
+  if (verbose)
+    printf("# %u climbs in %lld us\n", num_climbs, (long long)duration.count());
+
+  report(col, "flight");
+  ok1(col.Valid());
+
+  bool times_ok = true;
+  FloatDuration time{};
+  for (unsigned i = 0; i < col.size(); ++i) {
+    if (abs(col.GetSlice(i).time - time) > FloatDuration{1e-6})
+      times_ok = false;
+    time += col.GetSlice(i).dt;
+  }
+
+  ok1(times_ok);
+}
 
 int main(int argc, char** argv) {
   const int num_encounter_tests = 8;
   const int num_collection_tests = 2;
-  plan_tests(7*num_encounter_tests + 9*num_collection_tests);
+  plan_tests(7*num_encounter_tests + 9*num_collection_tests + 2);
 
   // test different thermal strengths
   thermal_encounter_test(FloatDuration{100},FloatDuration{1},1,1);
@@ -187,5 +231,8 @@ int main(int argc, char** argv) {
   // test collection, different strength
   thermal_collection_test(FloatDuration{100},FloatDuration{1},1,0.5);
 
+  // test a long flight with many climbs
+  thermal_flight_test(300);
+
   return exit_status();
 }
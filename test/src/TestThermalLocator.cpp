@@ -0,0 +1,114 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+#include "Computer/ThermalLocator.hpp"
+#include "NMEA/ThermalLocator.hpp"
+#include "Geo/SpeedVector.hpp"
+#include "Geo/Math.hpp"
+#include "TestUtil.hpp"
+
+#include <cmath>
+
+/**
+ * Circle in a thermal which drifts east with a 5 m/s west wind; the
+ * core is 60 m north of the circle center.  Returns the mean distance
+ * between the estimate and the core after the first minute.
+ */
+static double
+CircleInDriftingThermal(double rate)
+{
+  const GeoPoint origin(Angle::Degrees(7), Angle::Degrees(51));
+  const SpeedVector wind(Angle::Degrees(270), 5);
+
+  ThermalLocator locator;
+  locator.Reset();
+
+  ThermalLocatorInfo info;
+  double error = 0;
+  unsigned n = 0;
+
+  for (unsigned i = 0; i < 300 * rate; ++i) {
+    const double t = i / rate;
+    const GeoPoint air = FindLatitudeLongitude(origin, Angle::Degrees(90),
+                                               5 * t);
+    const GeoPoint core = FindLatitudeLongitude(air, Angle::Zero(), 60);
+    const GeoPoint location =
+      FindLatitudeLongitude(air, Angle::FullCircle() * (t / 25), 150);
+    const double w = 3 - location.Distance(core) / 100;
+
+    locator.Process(true, TimeStamp{FloatDuration{1000 + t}},
+                    location, w, wind, info);
+
+    if (i + 1 < ThermalLocator::TLOCATOR_NMIN) {
+      if (info.estimate_valid)
+        return -1;
+    } else if (t > 60) {
+      if (!info.estimate_valid)
+        return -1;
+
+      error += info.estimate_location.Distance(core);
+      ++n;
+    }
+  }
+
+  return error / n;
+}
+
+static void
+TestReset()
+{
+  const GeoPoint location(Angle::Degrees(7), Angle::Degrees(51));
+
+  ThermalLocator locator;
+  locator.Reset();
+
+  ThermalLocatorInfo info;
+  for (unsigned i = 0; i < ThermalLocator::TLOCATOR_NMIN; ++i)
+    locator.Process(true, TimeStamp{FloatDuration{i}}, location, 1,
+                    SpeedVector::Zero(), info);
+  ok1(info.estimate_valid);
+  ok1(equals(info.estimate_location, location));
+
+  /* leaving circling mode discards all samples */
+  locator.Process(false, TimeStamp{FloatDuration{10}}, location, 1,
+                  SpeedVector::Zero(), info);
+  info.estimate_valid = true;
+  locator.Process(true, TimeStamp{FloatDuration{11}}, location, 1,
+                  SpeedVector::Zero(), info);
+  ok1(!info.estimate_valid);
+}
+
+int main()
+{
+  plan_tests(6);
+
+  TestReset();
+
+  /* the estimate must not depend on the sample rate */
+  for (const double rate : {1., 2., 10.}) {
+    const double error = CircleInDriftingThermal(rate);
+    ok1(error >= 0 && error < 50);
+  }
+
+  return exit_status();
+}
@@ -0,0 +1,169 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "thread/TraceEvents.hpp"
+#include "TestUtil.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+static const TraceEvents::Thread *
+FindThread(const std::vector<TraceEvents::Thread> &threads,
+           const char *first_event) noexcept
+{
+  for (const auto &thread : threads)
+    if (!thread.events.empty() && thread.events.front().begin &&
+        std::strcmp(thread.events.front().name, first_event) == 0)
+      return &thread;
+
+  return nullptr;
+}
+
+static bool
+IsOrdered(const std::vector<TraceEvents::Event> &events) noexcept
+{
+  for (std::size_t i = 1; i < events.size(); ++i)
+    if (events[i].time < events[i - 1].time)
+      return false;
+
+  return true;
+}
+
+int
+main()
+{
+  plan_tests(19);
+
+  /* nothing is recorded while disabled */
+  ok1(!TraceEvents::Begin("disabled"));
+  ok1(TraceEvents::Collect().empty());
+
+  TraceEvents::SetEnabled(true);
+
+  {
+    const ScopeTraceEvent outer("outer");
+    TraceEvents::Begin("inner");
+    TraceEvents::End();
+  }
+
+  auto threads = TraceEvents::Collect();
+  ok1(threads.size() == 1);
+  ok1(threads.front().events.size() == 4);
+  ok1(threads.front().events[0].begin &&
+      std::strcmp(threads.front().events[0].name, "outer") == 0);
+  ok1(threads.front().events[1].begin &&
+      std::strcmp(threads.front().events[1].name, "inner") == 0);
+  ok1(!threads.front().events[2].begin && !threads.front().events[3].begin);
+  ok1(IsOrdered(threads.front().events));
+
+  /* the ring buffer keeps only the newest events */
+  TraceEvents::Clear();
+  ok1(TraceEvents::Collect().empty());
+
+  TraceEvents::Begin("first");
+  for (unsigned i = 0; i < TraceEvents::BUFFER_SIZE; ++i) {
+    TraceEvents::Begin("loop");
+    TraceEvents::End();
+  }
+
+  threads = TraceEvents::Collect();
+  ok1(threads.size() == 1);
+  ok1(threads.front().events.size() == TraceEvents::BUFFER_SIZE);
+  ok1(std::strcmp(threads.front().events.front().name, "loop") == 0);
+
+  /* "end" is recorded even after disabling */
+  TraceEvents::SetEnabled(false);
+  TraceEvents::End();
+  ok1(!TraceEvents::Collect().front().events.back().begin);
+
+  /* a slice which began while disabled is not closed after
+     enabling */
+  TraceEvents::Clear();
+  {
+    const ScopeTraceEvent scope("disabled");
+    TraceEvents::SetEnabled(true);
+  }
+  ok1(TraceEvents::Collect().empty());
+
+  /* each thread has its own buffer; events of threads which have
+     exited are kept */
+  std::thread([]{
+    TraceEvents::Begin("worker");
+    TraceEvents::End();
+  }).join();
+
+  TraceEvents::Begin("main");
+  TraceEvents::End();
+
+  threads = TraceEvents::Collect();
+  const auto *worker = FindThread(threads, "worker");
+  const auto *main_thread = FindThread(threads, "main");
+  ok1(worker != nullptr && main_thread != nullptr &&
+      worker->id != main_thread->id);
+
+  /* snapshots taken while another thread is recording are
+     consistent */
+  TraceEvents::Clear();
+
+  std::atomic<bool> stop{false};
+  std::thread writer([&stop]{
+    while (!stop.load(std::memory_order_relaxed)) {
+      TraceEvents::Begin("busy");
+      TraceEvents::End();
+    }
+  });
+
+  bool consistent = true, filled = false;
+  for (unsigned i = 0; i < 100 || !filled; ++i) {
+    threads = TraceEvents::Collect();
+    const auto *busy = FindThread(threads, "busy");
+    if (busy == nullptr)
+      continue;
+
+    filled |= busy->events.size() == TraceEvents::BUFFER_SIZE;
+    consistent &= busy->events.size() <= TraceEvents::BUFFER_SIZE &&
+      IsOrdered(busy->events);
+
+    for (std::size_t j = 0; j < busy->events.size(); ++j) {
+      const auto &event = busy->events[j];
+      consistent &= event.begin == (j % 2 == 0);
+      if (event.begin)
+        consistent &= std::strcmp(event.name, "busy") == 0;
+    }
+  }
+
+  stop = true;
+  writer.join();
+
+  ok1(filled);
+  ok1(consistent);
+
+  TraceEvents::SetEnabled(false);
+  TraceEvents::Begin("disabled");
+  threads = TraceEvents::Collect();
+  ok1(FindThread(threads, "disabled") == nullptr);
+  ok1(!TraceEvents::IsEnabled());
+
+  return exit_status();
+}
@@ -0,0 +1,126 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Computer/TrafficFusion.hpp"
+#include "NMEA/Info.hpp"
+#include "Geo/GeoVector.hpp"
+#include "TestUtil.hpp"
+
+static constexpr GeoPoint home(Angle::Degrees(7), Angle::Degrees(51));
+
+static FlarmTraffic &
+AddFlarm(NMEAInfo &basic, const char *id, const GeoPoint &location,
+         double altitude)
+{
+  FlarmTraffic &traffic =
+    *basic.flarm.traffic.AllocateTraffic(FlarmId::Parse(id, nullptr));
+  traffic.valid.Update(basic.clock);
+  traffic.location_available = true;
+  traffic.location = location;
+  traffic.altitude_available = true;
+  traffic.altitude = altitude;
+  traffic.track = Angle::Zero();
+  traffic.speed = 0;
+  return traffic;
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(12);
+
+  NMEAInfo basic;
+  basic.Reset();
+  basic.clock = TimeStamp{FloatDuration{1000}};
+  basic.time_available.Update(basic.clock);
+  basic.time = TimeStamp{FloatDuration{12 * 3600}};
+
+  /* two gliders thermalling close to each other */
+  const GeoPoint a = GeoVector(1000, Angle::Degrees(90)).EndPoint(home);
+  const GeoPoint b = GeoVector(150, Angle::Degrees(0)).EndPoint(a);
+  AddFlarm(basic, "DD1234", a, 1000);
+  AddFlarm(basic, "DD5678", b, 1050);
+
+  SkyLinesTracking::Data skylines;
+
+  /* the second glider, reported by SkyLines 10 seconds ago while it
+     was flying north at 20 m/s */
+  const GeoPoint b_old = GeoVector(200, Angle::Degrees(180)).EndPoint(b);
+  skylines.traffic[42] = {
+    SkyLinesTracking::Data::Time{(12 * 3600 - 20) * 1000},
+    GeoVector(200, Angle::Degrees(180)).EndPoint(b_old), 1040,
+  };
+  skylines.user_names[42] = _T("Bob");
+
+  /* an aircraft which is only known to SkyLines */
+  const GeoPoint c = GeoVector(20000, Angle::Degrees(0)).EndPoint(home);
+  skylines.traffic[43] = {
+    SkyLinesTracking::Data::Time{(12 * 3600 - 5) * 1000}, c, 1500,
+  };
+
+  /* another one at the same position as the first glider, but much
+     higher */
+  skylines.traffic[44] = {
+    SkyLinesTracking::Data::Time{12 * 3600 * 1000}, a, 2500,
+  };
+
+  TrafficFusion fusion;
+  FusedTrafficList fused;
+  fused.Clear();
+
+  fusion.Process(fused, basic, &skylines);
+  ok1(fused.list.size() == 4);
+
+  /* the next SkyLines fix provides the velocity */
+  skylines.traffic[42] = {
+    SkyLinesTracking::Data::Time{(12 * 3600 - 10) * 1000}, b_old, 1040,
+  };
+
+  fusion.Process(fused, basic, &skylines);
+  ok1(fused.list.size() == 4);
+
+  const FusedTraffic *f = fused.FindSkyLines(42);
+  ok1(f != nullptr);
+  ok1(f->source == FusedTraffic::Source::FLARM);
+  ok1(f->flarm_id == FlarmId::Parse("DD5678", nullptr));
+  ok1(f->HasSource(FusedTraffic::Source::SKYLINES));
+  ok1(StringIsEqual(f->name, _T("Bob")));
+
+  f = fused.FindFlarm(FlarmId::Parse("DD1234", nullptr));
+  ok1(f != nullptr && !f->HasSource(FusedTraffic::Source::SKYLINES));
+
+  f = fused.FindSkyLines(43);
+  ok1(f != nullptr && f->source == FusedTraffic::Source::SKYLINES);
+
+  f = fused.FindSkyLines(44);
+  ok1(f != nullptr && f->source == FusedTraffic::Source::SKYLINES);
+
+  /* without FLARM, the SkyLines position is extrapolated to the
+     present */
+  basic.flarm.traffic.Clear();
+  fusion.Process(fused, basic, &skylines);
+  f = fused.FindSkyLines(42);
+  ok1(f != nullptr && f->velocity_available && f->age > 9);
+  ok1(f != nullptr && f->location.Distance(b) < 20);
+
+  return exit_status();
+}
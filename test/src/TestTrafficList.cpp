@@ -0,0 +1,157 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "FLARM/List.hpp"
+#include "TestUtil.hpp"
+
+#include <math.h>
+#include <stdlib.h>
+
+static FlarmId
+MakeId(unsigned i)
+{
+  char buffer[16];
+  snprintf(buffer, sizeof(buffer), "%06X", 0xDD0000 + i * 3);
+  return FlarmId::Parse(buffer, nullptr);
+}
+
+static void
+TestIndex()
+{
+  TrafficList list;
+  list.Clear();
+
+  const TimeStamp t0{FloatDuration{100}};
+
+  for (unsigned i = 0; i < TrafficList::MAX_COUNT; ++i) {
+    FlarmTraffic *traffic = list.AllocateTraffic(MakeId(i));
+    if (traffic == nullptr)
+      break;
+
+    /* every other target expires early */
+    traffic->valid.Update(i % 2 == 0 ? t0 : t0 + std::chrono::seconds(5));
+  }
+
+  ok1(list.GetActiveTrafficCount() == TrafficList::MAX_COUNT);
+  ok1(list.AllocateTraffic(MakeId(TrafficList::MAX_COUNT)) == nullptr);
+
+  bool found = true;
+  for (unsigned i = 0; i < TrafficList::MAX_COUNT; ++i) {
+    const FlarmTraffic *traffic = list.FindTraffic(MakeId(i));
+    if (traffic == nullptr || !(traffic->id == MakeId(i)))
+      found = false;
+  }
+  ok1(found);
+  ok1(list.FindTraffic(MakeId(TrafficList::MAX_COUNT)) == nullptr);
+
+  list.Expire(t0 + std::chrono::seconds(5));
+  ok1(list.GetActiveTrafficCount() == TrafficList::MAX_COUNT / 2);
+
+  bool consistent = true;
+  for (unsigned i = 0; i < TrafficList::MAX_COUNT; ++i) {
+    const FlarmTraffic *traffic = list.FindTraffic(MakeId(i));
+    if ((traffic != nullptr) != (i % 2 == 1) ||
+        (traffic != nullptr && !(traffic->id == MakeId(i))))
+      consistent = false;
+  }
+  ok1(consistent);
+
+  /* Complement() only adds the missing targets */
+  TrafficList other;
+  other.Clear();
+  for (unsigned i = 0; i < 4; ++i)
+    other.AllocateTraffic(MakeId(i))->valid.Update(t0);
+
+  list.Complement(other);
+  ok1(list.GetActiveTrafficCount() == TrafficList::MAX_COUNT / 2 + 2);
+  ok1(list.FindTraffic(MakeId(0)) != nullptr);
+  ok1(list.FindTraffic(MakeId(2)) != nullptr);
+
+  list.Clear();
+  ok1(list.IsEmpty());
+  ok1(list.FindTraffic(MakeId(1)) == nullptr);
+}
+
+static double
+RandomDistance(double range)
+{
+  return (rand() / (double)RAND_MAX * 2 - 1) * range;
+}
+
+static void
+TestGrid()
+{
+  TrafficList list;
+  list.Clear();
+
+  for (unsigned i = 0; i < TrafficList::MAX_COUNT; ++i) {
+    FlarmTraffic &traffic = *list.AllocateTraffic(MakeId(i));
+    /* some targets are beyond the grid */
+    const double range = i % 8 == 0 ? 40000 : 8000;
+    traffic.relative_north = RandomDistance(range);
+    traffic.relative_east = RandomDistance(range);
+  }
+
+  TrafficList linear = list;
+  list.UpdateGrid();
+
+  bool nearest_ok = true, within_ok = true;
+  for (unsigned i = 0; i < 200; ++i) {
+    const double north = RandomDistance(i % 4 == 0 ? 20000 : 6000);
+    const double east = RandomDistance(i % 4 == 0 ? 20000 : 6000);
+
+    const FlarmTraffic *a = list.FindNearest(north, east);
+    const FlarmTraffic *b = linear.FindNearest(north, east);
+    if (a == nullptr || b == nullptr ||
+        hypot(a->relative_north - north, a->relative_east - east) !=
+        hypot(b->relative_north - north, b->relative_east - east))
+      nearest_ok = false;
+
+    const double radius = rand() % 5000;
+    unsigned n_grid = 0, n_linear = 0;
+    list.VisitWithin(north, east, radius,
+                     [&](const FlarmTraffic &){ ++n_grid; });
+    linear.VisitWithin(north, east, radius,
+                       [&](const FlarmTraffic &){ ++n_linear; });
+    if (n_grid != n_linear)
+      within_ok = false;
+  }
+
+  ok1(nearest_ok);
+  ok1(within_ok);
+
+  TrafficList empty;
+  empty.Clear();
+  empty.UpdateGrid();
+  ok1(empty.FindNearest(0, 0) == nullptr);
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(14);
+
+  TestIndex();
+  TestGrid();
+
+  return exit_status();
+}
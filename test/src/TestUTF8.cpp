@@ -22,6 +22,7 @@
 
 #include "util/UTF8.hpp"
 #include "util/Macros.hpp"
+#include "util/StringView.hxx"
 #include "TestUtil.hpp"
 
 #include <cassert>
@@ -108,6 +109,22 @@ MyValidateUTF8(const char *p)
   }
 }
 
+static const struct {
+  const char *value;
+  bool ascii;
+} plain_ascii[] = {
+  { "", true },
+  { "foo", true },
+  { "\xc3\xbc", false },
+  { "0123456789abcdefghijklmnopqrstuvwxyz0123456789", true },
+  /* non-ASCII character in the tail after the 32 byte blocks */
+  { "0123456789abcdefghijklmnopqrstuvwxyz\xfc", false },
+  /* non-ASCII character inside the first 32 byte block */
+  { "01234\x80" "6789abcdefghijklmnopqrstuvwxyz0123456789", false },
+  /* non-ASCII character in the last byte of a 32 byte block */
+  { "0123456789abcdefghijklmnopqrstu\xff", false },
+};
+
 #ifndef _UNICODE
 
 static constexpr struct {
@@ -153,6 +170,7 @@ int main(int argc, char **argv)
              2 * ARRAY_SIZE(length) +
              4 * ARRAY_SIZE(crop) +
              ARRAY_SIZE(latin1_chars) +
+             ARRAY_SIZE(plain_ascii) +
 #ifndef _UNICODE
              ARRAY_SIZE(truncate_string_tests) +
 #endif
@@ -173,6 +191,9 @@ int main(int argc, char **argv)
     ok1(l.length == MyLengthUTF8(l.value));
   }
 
+  for (const auto &i : plain_ascii)
+    ok1(IsPlainASCII(i.value) == i.ascii);
+
   char buffer[64];
 
   for (auto &l : latin1_chars) {
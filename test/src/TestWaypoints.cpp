@@ -24,7 +24,9 @@
 #include "Geo/GeoVector.hpp"
 #include "test_debug.hpp"
 
+#include <algorithm>
 #include <functional>
+#include <vector>
 
 #include <stdio.h>
 #include <tchar.h>
@@ -157,6 +159,25 @@ TestNamePrefixVisitor(const Waypoints &waypoints)
   TestNamePrefixVisitor(waypoints, _T("Field"), 51 - 8);
 }
 
+static unsigned
+CountNameSubstring(const Waypoints &waypoints, const TCHAR *text)
+{
+  unsigned count = 0;
+  waypoints.VisitNameSubstring(text, [&count](const auto &){ ++count; });
+  return count;
+}
+
+static void
+TestNameSubstringVisitor(const Waypoints &waypoints)
+{
+  ok1(CountNameSubstring(waypoints, _T("")) == 151);
+  ok1(CountNameSubstring(waypoints, _T("xyz")) == 0);
+  ok1(CountNameSubstring(waypoints, _T("field")) == 22 + 51 - 8);
+  ok1(CountNameSubstring(waypoints, _T("#1")) == 71);
+  ok1(CountNameSubstring(waypoints, _T("d 1")) == 28);
+  ok1(CountNameSubstring(waypoints, _T("point #15")) == 1);
+}
+
 class CloserThan
 {
   double distance;
@@ -191,11 +212,84 @@ TestRangeVisitor(const Waypoints &waypoints, const GeoPoint &center)
   TestRangeVisitor(waypoints, center, 1000000, 151);
 }
 
+static unsigned
+CountSpacedWithinRange(const Waypoints &waypoints, const GeoPoint &location,
+                       double distance, double spacing)
+{
+  unsigned count = 0;
+  waypoints.VisitWithinRange(location, distance, spacing,
+                             [&count](const WaypointPtr &){ ++count; });
+  return count;
+}
+
+static void
+TestSpacedRangeVisitor(const Waypoints &waypoints, const GeoPoint &center)
+{
+  /* below the finest level, all waypoints are visited */
+  ok1(CountSpacedWithinRange(waypoints, center, 10500, 100) == 11);
+  ok1(CountSpacedWithinRange(waypoints, center, 1000000, 100) == 151);
+
+  /* coarser spacing visits fewer waypoints, but never more than the
+     full search */
+  const unsigned coarse =
+    CountSpacedWithinRange(waypoints, center, 1000000, 20000);
+  const unsigned coarser =
+    CountSpacedWithinRange(waypoints, center, 1000000, 80000);
+  ok1(coarse > 0 && coarse < 151);
+  ok1(coarser > 0 && coarser <= coarse);
+
+  /* with a coarse spacing, airfields are preferred over other
+     waypoints */
+  unsigned airfields = 0, total = 0;
+  waypoints.VisitWithinRange(center, 1000000, 80000,
+                             [&](const WaypointPtr &wp){
+                               ++total;
+                               if (wp->IsAirport())
+                                 ++airfields;
+                             });
+  ok1(total > 0 && airfields * 2 > total);
+}
+
 static bool
 OriginalIDAbove5(const Waypoint &waypoint) {
   return waypoint.original_id > 5;
 }
 
+static bool
+IsLandable(const Waypoint &waypoint)
+{
+  return waypoint.IsLandable();
+}
+
+static void
+TestNearestVisitor(const Waypoints &waypoints, const GeoPoint &center)
+{
+  std::vector<unsigned> ids;
+  const auto collect = [&ids](const WaypointPtr &wp){
+    ids.push_back(wp->original_id);
+  };
+
+  waypoints.VisitNearest(center, 10500, 5, collect);
+  ok1(ids == std::vector<unsigned>({0, 1, 2, 3, 4}));
+
+  ids.clear();
+  waypoints.VisitNearest(center, 2500, 5, collect);
+  ok1(ids == std::vector<unsigned>({0, 1, 2}));
+
+  ids.clear();
+  waypoints.VisitNearest(center, 10500, 0, collect);
+  ok1(ids.empty());
+
+  ids.clear();
+  waypoints.VisitNearest(center, 1000000, 200, collect);
+  ok1(ids.size() == 151 && ids.front() == 0 && ids.back() == 150 &&
+      std::is_sorted(ids.begin(), ids.end()));
+
+  ids.clear();
+  waypoints.VisitNearestIf(center, 10500, 5, IsLandable, collect);
+  ok1(ids == std::vector<unsigned>({0, 3, 6, 7, 9}));
+}
+
 static void
 TestGetNearest(const Waypoints &waypoints, const GeoPoint &center)
 {
@@ -292,10 +386,19 @@ TestReplace(Waypoints& waypoints, unsigned id)
   Waypoint copy = *wp;
   copy.name = _T("Fred");
   waypoints.Replace(wp, std::move(copy));
+
+  /* Replace() has marked the name index stale; until Optimise()
+     rebuilds it, VisitNameSubstring() falls back to a linear scan,
+     which must already see the new name */
+  if (CountNameSubstring(waypoints, _T("red")) != 1)
+    return false;
+
   waypoints.Optimise();
 
+  /* now the rebuilt index answers the search */
   wp = waypoints.LookupId(id);
-  return wp != NULL && wp->name != oldName && wp->name == _T("Fred");
+  return wp != NULL && wp->name != oldName && wp->name == _T("Fred") &&
+    CountNameSubstring(waypoints, _T("red")) == 1;
 }
 
 int
@@ -304,7 +407,7 @@ main(int argc, char** argv)
   if (!ParseArgs(argc, argv))
     return 0;
 
-  plan_tests(52);
+  plan_tests(68);
 
   Waypoints waypoints;
   GeoPoint center(Angle::Degrees(51.4), Angle::Degrees(7.85));
@@ -318,8 +421,11 @@ main(int argc, char** argv)
 
   TestLookups(waypoints, center);
   TestNamePrefixVisitor(waypoints);
+  TestNameSubstringVisitor(waypoints);
   TestRangeVisitor(waypoints, center);
+  TestSpacedRangeVisitor(waypoints, center);
   TestGetNearest(waypoints, center);
+  TestNearestVisitor(waypoints, center);
   TestIterator(waypoints);
 
   ok(TestCopy(waypoints), "waypoint copy", 0);
@@ -0,0 +1,121 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Computer/Wind/WindEKF.hpp"
+#include "NMEA/SpeedSamples.hpp"
+#include "TestUtil.hpp"
+
+#include <cmath>
+
+static constexpr float WIND[2] = { 3, -4 };
+
+/**
+ * Feed the EKF with a synthetic zig-zag flight at 25 m/s true
+ * airspeed through a constant wind.
+ */
+static void
+Fly(WindEKF &ekf, unsigned n)
+{
+  for (unsigned i = 0; i < n; ++i) {
+    const double heading = 0.6 * std::sin(i * 0.05) + i * 0.01;
+    const float gps_vel[2] = {
+      float(25 * std::sin(heading)) + WIND[0],
+      float(25 * std::cos(heading)) + WIND[1],
+    };
+
+    ekf.Update(25, gps_vel);
+  }
+}
+
+static double
+WindError(const WindEKF &ekf)
+{
+  const float *x = ekf.get_state();
+  return std::hypot(x[0] - WIND[0], x[1] - WIND[1]);
+}
+
+static void
+TestConvergence()
+{
+  WindEKF ekf;
+  ekf.Init();
+  Fly(ekf, 3000);
+  ok1(WindError(ekf) < 0.5);
+  ok1(std::fabs(ekf.get_state()[2] - 1) < 0.01);
+}
+
+static void
+TestFuseWind()
+{
+  WindEKF ekf;
+  ekf.Init();
+
+  const float half[2] = { WIND[0] / 2, WIND[1] / 2 };
+  ekf.FuseWind(WIND, 0.5);
+  ok1(equals(ekf.get_state()[0], half[0]));
+  ok1(equals(ekf.get_state()[1], half[1]));
+
+  ekf.FuseWind(WIND, 1);
+  ok1(equals(ekf.get_state()[0], WIND[0]));
+  ok1(equals(ekf.get_state()[1], WIND[1]));
+
+  /* a seeded filter stays close to the truth, while an unseeded one
+     is still converging */
+  WindEKF unseeded;
+  unseeded.Init();
+
+  Fly(ekf, 20);
+  Fly(unseeded, 20);
+  ok1(WindError(ekf) < 0.5);
+  ok1(WindError(ekf) < WindError(unseeded));
+}
+
+static void
+TestSpeedSamples()
+{
+  SpeedSamples samples;
+  samples.Clear();
+  ok1(samples.empty());
+
+  for (unsigned i = 0; i < SpeedSamples::CAPACITY + 8; ++i) {
+    auto &s = samples.Append();
+    s.time = TimeStamp{FloatDuration{i}};
+    s.ground_velocity[0] = s.ground_velocity[1] = 0;
+    s.true_airspeed = i;
+  }
+
+  ok1(samples.size == SpeedSamples::CAPACITY);
+  ok1(samples[0].time == TimeStamp{FloatDuration{8}});
+  ok1(samples.back().time ==
+      TimeStamp{FloatDuration{SpeedSamples::CAPACITY + 7}});
+}
+
+int main()
+{
+  plan_tests(12);
+
+  TestConvergence();
+  TestFuseWind();
+  TestSpeedSamples();
+
+  return exit_status();
+}
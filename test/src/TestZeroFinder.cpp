@@ -54,7 +54,7 @@ ZeroFinderTest::f(const double x) noexcept
 
 int main(int argc, char **argv)
 {
-  plan_tests(18);
+  plan_tests(22);
 
   ZeroFinderTest zf(-100, 100, 0);
   ok1(equals(zf.find_zero(-150), -1));
@@ -85,5 +85,12 @@ int main(int argc, char **argv)
   ok1(equals(zf4.find_min(1), M_PI));
   ok1(equals(zf4.find_min(140), M_PI));
 
+  // warm start: the zero near the initial guess is found
+  ok1(equals(zf.find_zero_near(2, 1), 2.5));
+  ok1(equals(zf.find_zero_near(-1.2, 0.5), -1));
+  ok1(equals(zf3.find_zero_near(1.5, 0.2), 1.584963));
+  // no zero near the initial guess: fall back to the whole range
+  ok1(equals(zf3.find_zero_near(5, 0.1), 1.584963));
+
   return exit_status();
 }
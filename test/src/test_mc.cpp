@@ -186,6 +186,27 @@ test_stf()
   return true;
 }
 
+/**
+ * The speed to fly must stay within the speed range of the polar,
+ * even in a head wind which is stronger than the maximum speed.
+ */
+static bool
+test_stf_head_wind()
+{
+  GlidePolar polar(1);
+
+  for (double head_wind = -20; head_wind <= 2 * polar.GetVMax();
+       head_wind += 0.5) {
+    for (double S = -10; S <= 10; S += 0.5) {
+      const double V = polar.SpeedToFly(S, head_wind);
+      if (V < polar.GetVMin() - 0.001 || V > polar.GetVMax() + 0.001)
+        return false;
+    }
+  }
+
+  return true;
+}
+
 static bool
 test_mc()
 {
@@ -272,12 +293,13 @@ test_cb()
 
 int main() {
 
-  plan_tests(3);
+  plan_tests(4);
 
   Directory::Create(Path(_T("output/results")));
 
   ok(test_mc(),"mc output",0);
   ok(test_stf(),"mc stf",0);
+  ok(test_stf_head_wind(),"stf head wind",0);
   ok(test_cb(),"cruise bearing",0);
 
   return exit_status();